@@ -11,8 +11,6 @@
 @7
 // Primary constant buffer (with additional material parameters)
 META_CB_BEGIN(0, Data)
-float4x4 WorldMatrix;
-float4x4 InvWorld;
 float4x4 SVPositionToWorld;
 @1META_CB_END
 
@@ -31,6 +29,32 @@ struct MaterialInput
 	float4 SvPosition;
 	float3 PreSkinnedPosition;
 	float3 PreSkinnedNormal;
+	float4x4 WorldMatrix;
+	float PerInstanceRandom;
+};
+
+// Decal instance data (decals using the same material are drawn with instancing)
+struct DecalInstance
+{
+	float4 World0 : ATTRIBUTE0; // Local to world transformation (transposed, 3 rows)
+	float4 World1 : ATTRIBUTE1;
+	float4 World2 : ATTRIBUTE2;
+	float4 InvWorld0 : ATTRIBUTE3; // World to local transformation (transposed, 3 rows)
+	float4 InvWorld1 : ATTRIBUTE4;
+	float4 InvWorld2 : ATTRIBUTE5;
+	float PerInstanceRandom : ATTRIBUTE6;
+};
+
+struct Decal_VS2PS
+{
+	float4 SvPosition : SV_Position;
+	nointerpolation float4 World0 : TEXCOORD0;
+	nointerpolation float4 World1 : TEXCOORD1;
+	nointerpolation float4 World2 : TEXCOORD2;
+	nointerpolation float4 InvWorld0 : TEXCOORD3;
+	nointerpolation float4 InvWorld1 : TEXCOORD4;
+	nointerpolation float4 InvWorld2 : TEXCOORD5;
+	nointerpolation float PerInstanceRandom : TEXCOORD6;
 };
 
 // Transforms a vector from tangent space to world space
@@ -60,21 +84,21 @@ float3 TransformViewVectorToWorld(MaterialInput input, float3 viewVector)
 // Transforms a vector from local space to world space
 float3 TransformLocalVectorToWorld(MaterialInput input, float3 localVector)
 {
-	float3x3 localToWorld = (float3x3)WorldMatrix;
+	float3x3 localToWorld = (float3x3)input.WorldMatrix;
 	return mul(localVector, localToWorld);
 }
 
 // Transforms a vector from local space to world space
 float3 TransformWorldVectorToLocal(MaterialInput input, float3 worldVector)
 {
-	float3x3 localToWorld = (float3x3)WorldMatrix;
+	float3x3 localToWorld = (float3x3)input.WorldMatrix;
 	return mul(localToWorld, worldVector);
 }
 
 // Gets the current object position (supports instancing)
 float3 GetObjectPosition(MaterialInput input)
 {
-	return WorldMatrix[3].xyz;
+	return input.WorldMatrix[3].xyz;
 }
 
 // Gets the current object size
@@ -86,7 +110,7 @@ float3 GetObjectSize(MaterialInput input)
 // Get the current object random value supports instancing)
 float GetPerInstanceRandom(MaterialInput input)
 {
-	return 0;
+	return input.PerInstanceRandom;
 }
 
 // Get the current object LOD transition dither factor (supports instancing)
@@ -119,19 +143,39 @@ Material GetMaterialPS(MaterialInput input)
 // Vertex Shader function for decals rendering
 META_VS(true, FEATURE_LEVEL_ES2)
 META_VS_IN_ELEMENT(POSITION, 0, R32G32B32_FLOAT, 0, 0, PER_VERTEX, 0, true)
-void VS_Decal(in float3 Position : POSITION0, out float4 SvPosition : SV_Position)
+META_VS_IN_ELEMENT(ATTRIBUTE, 0, R32G32B32A32_FLOAT, 3, 0,     PER_INSTANCE, 1, true)
+META_VS_IN_ELEMENT(ATTRIBUTE, 1, R32G32B32A32_FLOAT, 3, ALIGN, PER_INSTANCE, 1, true)
+META_VS_IN_ELEMENT(ATTRIBUTE, 2, R32G32B32A32_FLOAT, 3, ALIGN, PER_INSTANCE, 1, true)
+META_VS_IN_ELEMENT(ATTRIBUTE, 3, R32G32B32A32_FLOAT, 3, ALIGN, PER_INSTANCE, 1, true)
+META_VS_IN_ELEMENT(ATTRIBUTE, 4, R32G32B32A32_FLOAT, 3, ALIGN, PER_INSTANCE, 1, true)
+META_VS_IN_ELEMENT(ATTRIBUTE, 5, R32G32B32A32_FLOAT, 3, ALIGN, PER_INSTANCE, 1, true)
+META_VS_IN_ELEMENT(ATTRIBUTE, 6, R32_FLOAT,          3, ALIGN, PER_INSTANCE, 1, true)
+Decal_VS2PS VS_Decal(in float3 Position : POSITION0, in DecalInstance instance)
 {
+	Decal_VS2PS output;
+
 	// Compute world space vertex position
-	float3 worldPosition = mul(float4(Position.xyz, 1), WorldMatrix).xyz;
+	float4 localPosition = float4(Position.xyz, 1);
+	float3 worldPosition = float3(dot(instance.World0, localPosition), dot(instance.World1, localPosition), dot(instance.World2, localPosition));
 
 	// Compute clip space position
-	SvPosition = mul(float4(worldPosition.xyz, 1), ViewProjectionMatrix);
+	output.SvPosition = mul(float4(worldPosition.xyz, 1), ViewProjectionMatrix);
+
+	// Pass the instance data
+	output.World0 = instance.World0;
+	output.World1 = instance.World1;
+	output.World2 = instance.World2;
+	output.InvWorld0 = instance.InvWorld0;
+	output.InvWorld1 = instance.InvWorld1;
+	output.InvWorld2 = instance.InvWorld2;
+	output.PerInstanceRandom = instance.PerInstanceRandom;
+	return output;
 }
 
 // Pixel Shader function for decals rendering
 META_PS(true, FEATURE_LEVEL_ES2)
 void PS_Decal(
-	in float4 SvPosition : SV_Position
+	in Decal_VS2PS input
 	, out float4 Out0 : SV_Target0
 #if DECAL_BLEND_MODE == DECAL_BLEND_MODE_TRANSLUCENT
 	, out float4 Out1 : SV_Target1
@@ -144,12 +188,13 @@ void PS_Decal(
 #endif
 	)
 {
+	float4 SvPosition = input.SvPosition;
 	float2 screenUV = SvPosition.xy * ScreenSize.zw;
 	SvPosition.z = SAMPLE_RT(DepthBuffer, screenUV).r;
 
 	float4 positionHS = mul(float4(SvPosition.xyz, 1), SVPositionToWorld);
 	float3 positionWS = positionHS.xyz / positionHS.w;
-	float3 positionOS = mul(float4(positionWS, 1), InvWorld).xyz;
+	float3 positionOS = float3(dot(input.InvWorld0, float4(positionWS, 1)), dot(input.InvWorld1, float4(positionWS, 1)), dot(input.InvWorld2, float4(positionWS, 1)));
 
 	clip(0.5 - abs(positionOS.xyz));
 	float2 decalUVs = positionOS.xz + 0.5f;
@@ -160,6 +205,8 @@ void PS_Decal(
 	materialInput.TexCoord = decalUVs;
 	materialInput.TwoSidedSign = 1;
 	materialInput.SvPosition = SvPosition;
+	materialInput.WorldMatrix = transpose(float4x4(input.World0, input.World1, input.World2, float4(0, 0, 0, 1)));
+	materialInput.PerInstanceRandom = input.PerInstanceRandom;
 	
 	// Build tangent to world transformation matrix
 	float3 ddxWp = ddx(positionWS);
@@ -34,7 +34,16 @@ void PS_GBuffer(
 
 	// Get material parameters
 	MaterialInput materialInput = GetMaterialInput(input);
+#if USE_TERRAIN_VIRTUAL_TEXTURE
+	Material material;
+	BRANCH
+	if (UseVirtualTexture())
+		material = SampleVirtualTexture(materialInput);
+	else
+		material = GetMaterialPS(materialInput);
+#else
 	Material material = GetMaterialPS(materialInput);
+#endif
 
 	// Masking
 #if MATERIAL_MASKED
@@ -23,10 +23,19 @@ ExponentialHeightFogData ExponentialHeightFog;
 float3 Dummy2;
 uint LocalLightsCount;
 LightData LocalLights[MAX_LOCAL_LIGHTS];
+uint3 LightsGridSize;
+float LightsGridDepthScale;
+float LightsGridDepthBias;
+float3 Dummy3;
 @3// Forward Shading: Resources
 TextureCube EnvProbe : register(t__SRV__);
 TextureCube SkyLightTexture : register(t__SRV__);
 Texture2DArray DirectionalLightShadowMap : register(t__SRV__);
+#if FEATURE_LEVEL >= FEATURE_LEVEL_SM5
+StructuredBuffer<LightData> LightsGridLights : register(t__SRV__);
+Buffer<uint2> LightsGridClusters : register(t__SRV__);
+Buffer<uint> LightsGridIndices : register(t__SRV__);
+#endif
 @4// Forward Shading: Utilities
 DECLARE_LIGHTSHADOWDATA_ACCESS(DirectionalLightShadow);
 @5// Forward Shading: Shaders
@@ -91,6 +100,26 @@ void PS_Forward(
 	light += GetSkyLightLighting(SkyLight, gBuffer, SkyLightTexture);
 
 	// Calculate lighting from local lights
+#if FEATURE_LEVEL >= FEATURE_LEVEL_SM5
+	BRANCH
+	if (LightsGridSize.z > 0)
+	{
+		// Clustered lights grid
+		float2 screenUV = materialInput.SvPosition.xy * ScreenSize.zw;
+		uint3 clusterCoord;
+		clusterCoord.xy = min(uint2(screenUV * LightsGridSize.xy), LightsGridSize.xy - 1);
+		clusterCoord.z = min((uint)max(log(max(gBuffer.ViewPos.z, 1.0f)) * LightsGridDepthScale + LightsGridDepthBias, 0.0f), LightsGridSize.z - 1);
+		uint2 cluster = LightsGridClusters[(clusterCoord.z * LightsGridSize.y + clusterCoord.y) * LightsGridSize.x + clusterCoord.x];
+		LOOP
+		for (uint clusterLightIndex = 0; clusterLightIndex < cluster.y; clusterLightIndex++)
+		{
+			const LightData localLight = LightsGridLights[LightsGridIndices[cluster.x + clusterLightIndex]];
+			bool isSpotLight = localLight.SpotAngles.x > -2.0f;
+			shadowMask = 1.0f;
+			light += GetLighting(ViewPos, localLight, gBuffer, shadowMask, true, isSpotLight);
+		}
+	}
+#endif
 	LOOP
 	for (uint localLightIndex = 0; localLightIndex < LocalLightsCount; localLightIndex++)
 	{
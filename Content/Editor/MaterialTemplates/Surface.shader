@@ -623,4 +623,18 @@ void PS_QuadOverdraw(float4 svPos : SV_Position, uint primId : SV_PrimitiveID)
 
 #endif
 
+#if _PS_TextureFeedback
+
+// Pixel Shader function for Texture Feedback Pass (records sampled textures mip levels for streaming)
+[earlydepthstencil]
+META_PS(true, FEATURE_LEVEL_SM5)
+void PS_TextureFeedback(PixelInput input)
+{
+	// Evaluate material to write feedback for all sampled textures (UAV writes are not stripped by the shader compiler)
+	MaterialInput materialInput = GetMaterialInput(input);
+	Material material = GetMaterialPS(materialInput);
+}
+
+#endif
+
 @9
@@ -11,6 +11,9 @@
 #define TERRAIN_LAYERS_DATA_SIZE 2
 #define USE_TERRAIN_LAYERS (TERRAIN_LAYERS_DATA_SIZE > 0)
 
+// Enables/disables sampling the pre-composited material from the terrain virtual texture atlas (when drawing distant chunks)
+#define USE_TERRAIN_VIRTUAL_TEXTURE 1
+
 #include "./Flax/Common.hlsl"
 #include "./Flax/MaterialCommon.hlsl"
 #include "./Flax/GBufferCommon.hlsl"
@@ -27,6 +30,10 @@ float TerrainChunkSizeLOD0;
 float4 HeightmapUVScaleBias;
 float4 NeighborLOD;
 float2 OffsetUV;
+float VirtualTextureTexel;
+float HeightmapMipOffset;
+float4 VirtualTextureUV;
+float2 SplatmapMipOffset;
 float2 Dummy0;
 @1META_CB_END
 
@@ -35,6 +42,14 @@ Texture2D Heightmap : register(t0);
 Texture2D Splatmap0 : register(t1);
 Texture2D Splatmap1 : register(t2);
 
+// Terrain virtual texture atlas
+#if USE_TERRAIN_VIRTUAL_TEXTURE
+Texture2D VirtualTextureEmissive : register(t3);
+Texture2D VirtualTextureGBuffer0 : register(t4);
+Texture2D VirtualTextureGBuffer1 : register(t5);
+Texture2D VirtualTextureGBuffer2 : register(t6);
+#endif
+
 // Shader resources
 @2
 // Geometry data passed though the graphics rendering stages up to the pixel shader
@@ -257,6 +272,39 @@ Material GetMaterialPS(MaterialInput input)
 @4
 }
 
+#if USE_TERRAIN_VIRTUAL_TEXTURE
+
+// Checks if the current chunk uses the pre-composited material from the virtual texture
+bool UseVirtualTexture()
+{
+	return VirtualTextureUV.x > 0;
+}
+
+// Gets material properties from the virtual texture atlas (pre-composited material of the chunk)
+Material SampleVirtualTexture(MaterialInput input)
+{
+	float2 uv = input.TexCoord - OffsetUV;
+	uv.y = 1.0f - uv.y;
+	uv = clamp(uv, VirtualTextureTexel, 1.0f - VirtualTextureTexel) * VirtualTextureUV.xy + VirtualTextureUV.zw;
+	float4 gBuffer0 = VirtualTextureGBuffer0.Sample(SamplerLinearClamp, uv);
+	float4 gBuffer1 = VirtualTextureGBuffer1.Sample(SamplerLinearClamp, uv);
+	float4 gBuffer2 = VirtualTextureGBuffer2.Sample(SamplerLinearClamp, uv);
+	Material material = (Material)0;
+	material.Color = gBuffer0.rgb;
+	material.AO = gBuffer0.a;
+	material.WorldNormal = normalize(gBuffer1.rgb * 2 - 1);
+	material.TangentNormal = float3(0, 0, 1);
+	material.Roughness = gBuffer2.r;
+	material.Metalness = gBuffer2.g;
+	material.Specular = gBuffer2.b;
+	material.Emissive = VirtualTextureEmissive.Sample(SamplerLinearClamp, uv).rgb;
+	material.Opacity = 1;
+	material.Mask = input.HolesMask;
+	return material;
+}
+
+#endif
+
 // Calculates LOD value (with fractional part for blending)
 float CalcLOD(float2 xy, float4 morph)
 {
@@ -313,32 +361,32 @@ VertexOutput VS(TerrainVertexInput input)
 	float lodValue = CurrentLOD;
 	float morphAlpha = lodCalculated - CurrentLOD;
 
-	// Sample heightmap
+	// Sample heightmap (offset LOD by the streamed-out mips)
 	float2 heightmapUVs = input.TexCoord * HeightmapUVScaleBias.xy + HeightmapUVScaleBias.zw;
 #if USE_SMOOTH_LOD_TRANSITION
-	float4 heightmapValueThisLOD = Heightmap.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue);
+	float4 heightmapValueThisLOD = Heightmap.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue - HeightmapMipOffset);
 	float2 nextLODPos = round(input.TexCoord * ChunkSizeNextLOD) / ChunkSizeNextLOD;
 	float2 heightmapUVsNextLOD = nextLODPos * HeightmapUVScaleBias.xy + HeightmapUVScaleBias.zw;
-	float4 heightmapValueNextLOD = Heightmap.SampleLevel(SamplerPointClamp, heightmapUVsNextLOD, lodValue + 1);
+	float4 heightmapValueNextLOD = Heightmap.SampleLevel(SamplerPointClamp, heightmapUVsNextLOD, lodValue + 1 - HeightmapMipOffset);
 	float4 heightmapValue = lerp(heightmapValueThisLOD, heightmapValueNextLOD, morphAlpha);
 	bool isHole = max(heightmapValueThisLOD.b + heightmapValueThisLOD.a, heightmapValueNextLOD.b + heightmapValueNextLOD.a) >= 1.9f;
 #if USE_TERRAIN_LAYERS
-	float4 splatmapValueThisLOD = Splatmap0.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue);
-	float4 splatmapValueNextLOD = Splatmap0.SampleLevel(SamplerPointClamp, heightmapUVsNextLOD, lodValue + 1);
+	float4 splatmapValueThisLOD = Splatmap0.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue - SplatmapMipOffset.x);
+	float4 splatmapValueNextLOD = Splatmap0.SampleLevel(SamplerPointClamp, heightmapUVsNextLOD, lodValue + 1 - SplatmapMipOffset.x);
 	float4 splatmap0Value = lerp(splatmapValueThisLOD, splatmapValueNextLOD, morphAlpha);
 #if TERRAIN_LAYERS_DATA_SIZE > 1
-	splatmapValueThisLOD = Splatmap1.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue);
-	splatmapValueNextLOD = Splatmap1.SampleLevel(SamplerPointClamp, heightmapUVsNextLOD, lodValue + 1);
+	splatmapValueThisLOD = Splatmap1.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue - SplatmapMipOffset.y);
+	splatmapValueNextLOD = Splatmap1.SampleLevel(SamplerPointClamp, heightmapUVsNextLOD, lodValue + 1 - SplatmapMipOffset.y);
 	float4 splatmap1Value = lerp(splatmapValueThisLOD, splatmapValueNextLOD, morphAlpha);
 #endif
 #endif
 #else
-	float4 heightmapValue = Heightmap.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue);
+	float4 heightmapValue = Heightmap.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue - HeightmapMipOffset);
 	bool isHole = (heightmapValue.b + heightmapValue.a) >= 1.9f;
 #if USE_TERRAIN_LAYERS
-	float4 splatmap0Value = Splatmap0.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue);
+	float4 splatmap0Value = Splatmap0.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue - SplatmapMipOffset.x);
 #if TERRAIN_LAYERS_DATA_SIZE > 1
-	float4 splatmap1Value = Splatmap1.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue);
+	float4 splatmap1Value = Splatmap1.SampleLevel(SamplerPointClamp, heightmapUVs, lodValue - SplatmapMipOffset.y);
 #endif
 #endif
 #endif
@@ -101,6 +101,7 @@ class EditorAnalyticsService : public EngineService
     EditorAnalyticsService()
         : EngineService(TEXT("Editor Analytics"))
     {
+        ParallelInit = true;
     }
 
     bool Init() override;
@@ -12,7 +12,7 @@ partial class AudioTool
     {
         partial struct Options
         {
-            private bool ShowBtiDepth => Format != AudioFormat.Vorbis;
+            private bool ShowBtiDepth => Format == AudioFormat.Raw;
         }
     }
 }
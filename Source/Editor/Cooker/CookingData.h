@@ -292,6 +292,11 @@ DECLARE_SCRIPTING_TYPE(CookingData);
         /// </summary>
         int32 CookedAssets;
 
+        /// <summary>
+        /// The assets restored from the shared cooking cache (instead of being cooked).
+        /// </summary>
+        int32 SharedCacheAssets;
+
         /// <summary>
         /// The final output content size in MB.
         /// </summary>
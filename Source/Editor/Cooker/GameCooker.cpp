@@ -206,6 +206,7 @@ CookingData::Statistics::Statistics()
 {
     TotalAssets = 0;
     CookedAssets = 0;
+    SharedCacheAssets = 0;
     ContentSizeMB = 0;
 }
 
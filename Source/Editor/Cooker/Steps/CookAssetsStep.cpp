@@ -6,6 +6,7 @@
 #include "Engine/Core/Utilities.h"
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Platform/FileSystem.h"
+#include "Engine/Platform/File.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Content/Asset.h"
 #include "Engine/Content/BinaryAsset.h"
@@ -15,12 +16,16 @@
 #include "Engine/Content/Assets/Shader.h"
 #include "Engine/Content/Assets/Texture.h"
 #include "Engine/Content/Assets/CubeTexture.h"
+#include "Engine/Content/Assets/Model.h"
+#include "Engine/Content/Assets/Animation.h"
 #include "Engine/Render2D/SpriteAtlas.h"
 #include "Engine/Content/Storage/FlaxFile.h"
 #include "Engine/Particles/ParticleEmitter.h"
 #include "Engine/Utilities/Encryption.h"
+#include "Engine/Utilities/Crc.h"
 #include "Engine/Serialization/JsonWriters.h"
 #include "Engine/Serialization/FileWriteStream.h"
+#include "Engine/Serialization/MemoryReadStream.h"
 #include "Engine/Serialization/MemoryWriteStream.h"
 #include "Engine/Core/Config/PlatformSettings.h"
 #include "Engine/Core/Config/GameSettings.h"
@@ -31,12 +36,15 @@
 #include "Engine/Graphics/Shaders/GPUShader.h"
 #include "Engine/Graphics/Textures/TextureData.h"
 #include "Engine/Graphics/Materials/MaterialShader.h"
+#include "Engine/Graphics/Models/MeshCodec.h"
 #include "Engine/Graphics/PixelFormatExtensions.h"
 #include "Engine/Particles/Graph/GPU/ParticleEmitterGraph.GPU.h"
 #include "Engine/Engine/Base/GameBase.h"
 #include "Engine/Engine/Globals.h"
 #include "Engine/Tools/TextureTool/TextureTool.h"
+#include "Engine/Tools/ModelTool/ModelTool.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Scripting/Enums.h"
 #if PLATFORM_TOOLS_WINDOWS
 #include "Engine/Platform/Windows/WindowsPlatformSettings.h"
@@ -49,8 +57,100 @@
 #endif
 #include "FlaxEngine.Gen.h"
 
+// Version of the shared cooking cache data layout (increment it to invalidate all the shared entries)
+#define COOK_SHARED_CACHE_VERSION 1
+
 Dictionary<String, CookAssetsStep::ProcessAssetFunc> CookAssetsStep::AssetProcessors;
 
+namespace
+{
+    // Content hash used to address the shared cooking cache entries (CRC32 and 64-bit FNV-1a of the data along with its size)
+    struct ContentHasher
+    {
+        uint32 Crc = 0;
+        uint64 Fnv = 14695981039346656037ull;
+        uint64 Size = 0;
+
+        void Hash(const void* data, int32 length)
+        {
+            Crc = Crc::MemCrc32(data, length, Crc);
+            const byte* ptr = (const byte*)data;
+            for (int32 i = 0; i < length; i++)
+                Fnv = (Fnv ^ ptr[i]) * 1099511628211ull;
+            Size += length;
+        }
+
+        template<typename T>
+        void Hash(const T& value)
+        {
+            Hash(&value, sizeof(T));
+        }
+
+        void Hash(const StringView& text)
+        {
+            Hash(text.Get(), text.Length() * sizeof(Char));
+            Hash(text.Length());
+        }
+
+        bool HashFile(const StringView& path)
+        {
+            auto file = File::Open(path, FileMode::OpenExisting, FileAccess::Read, FileShare::Read);
+            if (file == nullptr)
+                return true;
+            Array<byte> buffer;
+            buffer.Resize(1024 * 1024);
+            bool failed = false;
+            while (true)
+            {
+                uint32 read = 0;
+                if (file->Read(buffer.Get(), buffer.Count(), &read))
+                {
+                    failed = true;
+                    break;
+                }
+                if (read == 0)
+                    break;
+                Hash(buffer.Get(), (int32)read);
+            }
+            Delete(file);
+            return failed;
+        }
+
+        Guid ToGuid() const
+        {
+            return Guid(Crc, (uint32)Fnv, (uint32)(Fnv >> 32), (uint32)Size);
+        }
+    };
+
+    bool GetFileHash(const StringView& path, Guid& hash)
+    {
+        ContentHasher hasher;
+        if (hasher.HashFile(path))
+            return true;
+        hash = hasher.ToGuid();
+        return false;
+    }
+
+    // Converts the file path into the machine-independent form (relative to the project or engine folder)
+    String ToSharedPath(const String& path)
+    {
+        if (path.StartsWith(Globals::ProjectFolder))
+            return TEXT("$(Project)") + path.Substring(Globals::ProjectFolder.Length());
+        if (path.StartsWith(Globals::StartupFolder))
+            return TEXT("$(Engine)") + path.Substring(Globals::StartupFolder.Length());
+        return path;
+    }
+
+    String FromSharedPath(const String& path)
+    {
+        if (path.StartsWith(TEXT("$(Project)")))
+            return Globals::ProjectFolder + path.Substring(10);
+        if (path.StartsWith(TEXT("$(Engine)")))
+            return Globals::StartupFolder + path.Substring(9);
+        return path;
+    }
+}
+
 void IBuildCache::InvalidateCacheShaders()
 {
     InvalidateCachePerType<Shader>();
@@ -235,6 +335,31 @@ void CookAssetsStep::CacheData::Load(CookingData& data)
         LOG(Info, "{0} option has been modified.", TEXT("ShadersGenerateDebugData"));
         invalidateShaders = true;
     }
+    if (ShadersUsageHash != Settings.Global.ShadersUsageHash)
+    {
+        LOG(Info, "{0} option has been modified.", TEXT("ShadersUsageFile"));
+        invalidateShaders = true;
+    }
+    if (buildSettings->GenerateMeshlets != Settings.Global.GenerateMeshlets)
+    {
+        LOG(Info, "{0} option has been modified.", TEXT("GenerateMeshlets"));
+        InvalidateCachePerType<Model>();
+    }
+    if (buildSettings->CompressMeshes != Settings.Global.CompressMeshes)
+    {
+        LOG(Info, "{0} option has been modified.", TEXT("CompressMeshes"));
+        InvalidateCachePerType<Model>();
+    }
+    if (buildSettings->CompressAnimations != Settings.Global.CompressAnimations)
+    {
+        LOG(Info, "{0} option has been modified.", TEXT("CompressAnimations"));
+        InvalidateCachePerType<Animation>();
+    }
+    if (buildSettings->TextureCompression != Settings.Global.TextureCompression || buildSettings->GPUTextureCompression != Settings.Global.GPUTextureCompression)
+    {
+        LOG(Info, "{0} option has been modified.", TEXT("TextureCompression"));
+        InvalidateCacheTextures();
+    }
 #if PLATFORM_TOOLS_WINDOWS
     if (data.Platform == BuildPlatform::Windows32 || data.Platform == BuildPlatform::Windows64)
     {
@@ -324,6 +449,126 @@ void CookAssetsStep::CacheData::Save(CookingData& data)
     file->WriteInt32(13);
 }
 
+bool CookAssetsStep::CacheData::GetSharedKey(const Guid& id, const StringView& typeName, const StringView& path, Guid& key) const
+{
+    ContentHasher hasher;
+    hasher.Hash(SharedSettingsHash);
+    hasher.Hash(id);
+    hasher.Hash(typeName);
+    if (hasher.HashFile(path))
+        return true;
+    key = hasher.ToGuid();
+    return false;
+}
+
+bool CookAssetsStep::CacheData::TryGetShared(const Guid& key, const Guid& id, const StringView& path)
+{
+    PROFILE_CPU();
+    const String keyName = SharedCacheFolder / key.ToString(Guid::FormatType::N);
+    const String sharedFilePath = keyName + TEXT(".flax");
+    const String manifestPath = keyName + TEXT(".deps");
+    if (!FileSystem::FileExists(manifestPath) || !FileSystem::FileExists(sharedFilePath))
+        return false;
+    auto file = FileReadStream::Open(manifestPath);
+    if (file == nullptr)
+        return false;
+    DeleteMe<FileReadStream> deleteFile(file);
+
+    // Read the manifest and validate the dependant files contents (paths are relative to the project/engine so they can differ between machines)
+    int32 version;
+    file->ReadInt32(&version);
+    if (version != COOK_SHARED_CACHE_VERSION)
+        return false;
+    String typeName;
+    file->ReadString(&typeName);
+    int32 fileDependenciesCount;
+    file->ReadInt32(&fileDependenciesCount);
+    if (Math::IsNotInRange(fileDependenciesCount, 0, 100000) || file->HasError())
+        return false;
+    FileDependenciesList fileDependencies;
+    fileDependencies.Resize(fileDependenciesCount);
+    for (int32 i = 0; i < fileDependenciesCount; i++)
+    {
+        String dependencyPath;
+        file->ReadString(&dependencyPath, 10);
+        Guid dependencyHash, currentHash;
+        file->Read(dependencyHash);
+        if (file->HasError())
+            return false;
+        dependencyPath = FromSharedPath(dependencyPath);
+        if (GetFileHash(dependencyPath, currentHash) || currentHash != dependencyHash)
+            return false;
+        fileDependencies[i] = Pair<String, DateTime>(dependencyPath, FileSystem::GetFileLastEditTime(dependencyPath));
+    }
+
+    // Restore the cooked file into the local cache
+    String cachedFilePath;
+    GetFilePath(id, cachedFilePath);
+    if (FileSystem::CopyFile(cachedFilePath, sharedFilePath))
+    {
+        LOG(Warning, "Failed to copy cooked asset {0} from the shared cache.", id);
+        return false;
+    }
+    auto& entry = Entries[id];
+    entry.ID = id;
+    entry.TypeName = typeName;
+    entry.FileModified = FileSystem::GetFileLastEditTime(path);
+    entry.FileDependencies = MoveTemp(fileDependencies);
+    return true;
+}
+
+void CookAssetsStep::CacheData::StoreShared(const Guid& key, const Guid& id) const
+{
+    PROFILE_CPU();
+    const CacheEntry* entry = Entries.TryGet(id);
+    String cachedFilePath;
+    GetFilePath(id, cachedFilePath);
+    if (entry == nullptr || !FileSystem::FileExists(cachedFilePath))
+        return;
+
+    // Hash the dependant files (the current contents used to cook the asset)
+    Array<Guid> dependencyHashes;
+    dependencyHashes.Resize(entry->FileDependencies.Count());
+    for (int32 i = 0; i < dependencyHashes.Count(); i++)
+    {
+        if (GetFileHash(entry->FileDependencies[i].First, dependencyHashes[i]))
+            return;
+    }
+
+    // Write to the temporary files first and then move them into the destination (other machines might be reading the shared cache at the same time)
+    if (!FileSystem::DirectoryExists(SharedCacheFolder) && FileSystem::CreateDirectory(SharedCacheFolder))
+    {
+        LOG(Warning, "Failed to create shared cooking cache folder {0}.", SharedCacheFolder);
+        return;
+    }
+    const String keyName = SharedCacheFolder / key.ToString(Guid::FormatType::N);
+    const String tmpName = keyName + TEXT(".") + Guid::New().ToString(Guid::FormatType::N);
+    const String sharedFilePath = keyName + TEXT(".flax");
+    const String manifestPath = keyName + TEXT(".deps");
+    {
+        auto file = FileWriteStream::Open(tmpName + TEXT(".deps.tmp"));
+        if (file == nullptr)
+            return;
+        DeleteMe<FileWriteStream> deleteFile(file);
+        file->WriteInt32(COOK_SHARED_CACHE_VERSION);
+        file->WriteString(entry->TypeName);
+        file->WriteInt32(entry->FileDependencies.Count());
+        for (int32 i = 0; i < dependencyHashes.Count(); i++)
+        {
+            file->WriteString(ToSharedPath(entry->FileDependencies[i].First), 10);
+            file->Write(dependencyHashes[i]);
+        }
+    }
+    if (FileSystem::CopyFile(tmpName + TEXT(".flax.tmp"), cachedFilePath) ||
+        FileSystem::MoveFile(sharedFilePath, tmpName + TEXT(".flax.tmp"), true) ||
+        FileSystem::MoveFile(manifestPath, tmpName + TEXT(".deps.tmp"), true))
+    {
+        LOG(Warning, "Failed to store cooked asset {0} in the shared cache.", id);
+        FileSystem::DeleteFile(tmpName + TEXT(".flax.tmp"));
+        FileSystem::DeleteFile(tmpName + TEXT(".deps.tmp"));
+    }
+}
+
 bool CookAssetsStep::ProcessDefaultAsset(AssetCookData& options)
 {
     const auto asBinaryAsset = dynamic_cast<BinaryAsset*>(options.Asset);
@@ -352,8 +597,25 @@ bool CookAssetsStep::ProcessDefaultAsset(AssetCookData& options)
 
         // Store json data in the first chunk
         auto chunk = New<FlaxChunk>();
-        chunk->Flags = FlaxChunkFlags::CompressedLZ4; // Compress json data (internal storage layer will handle it)
-        chunk->Data.Copy((byte*)buffer.GetString(), (int32)buffer.GetSize());
+        chunk->Flags = FlaxChunkFlags::CompressedLZ4HC; // Compress json data (internal storage layer will handle it)
+        if (asJsonAsset->Data->IsArray())
+        {
+            // Use binary document for objects lists (scenes and prefabs) to skip text parsing at runtime and load objects in parallel
+            rapidjson_flax::Document document;
+            document.Parse(buffer.GetString(), buffer.GetSize());
+            if (document.HasParseError())
+            {
+                LOG(Error, "Failed to parse cooked json asset \'{0}\'", options.Asset->ToString());
+                return true;
+            }
+            MemoryWriteStream stream((uint32)buffer.GetSize());
+            JsonParser::WriteBinary(document, stream, "Data");
+            chunk->Data.Copy(stream.GetHandle(), stream.GetPosition());
+        }
+        else
+        {
+            chunk->Data.Copy((byte*)buffer.GetString(), (int32)buffer.GetSize());
+        }
         options.InitData.Header.Chunks[0] = chunk;
 
         return false;
@@ -402,11 +664,7 @@ bool ProcessShaderBase(CookAssetsStep::AssetCookData& data, ShaderAssetBase* ass
     while (sourceLength > 2 && source[sourceLength - 1] == 0)
         sourceLength--;
 
-    // Init shader cache output stream
-    // TODO: reuse MemoryWriteStream per cooking process to reduce dynamic memory allocations
-    MemoryWriteStream cacheStream(32 * 1024);
-
-    // Compile shader source
+    // Shader source compilation options (shared by all target profiles)
     ShaderCompilationOptions options;
     options.TargetName = StringUtils::GetFileNameWithoutExtension(asset->GetPath());
     options.TargetID = asset->GetID();
@@ -415,30 +673,27 @@ bool ProcessShaderBase(CookAssetsStep::AssetCookData& data, ShaderAssetBase* ass
     options.NoOptimize = data.Cache.Settings.Global.ShadersNoOptimize;
     options.GenerateDebugData = data.Cache.Settings.Global.ShadersGenerateDebugData;
     options.TreatWarningsAsErrors = false;
-    options.Output = &cacheStream;
-    Array<String> includes;
+    options.UsedPermutations = data.Cache.ShadersUsage.TryGet(asset->GetID());
+
+    // Collect shader profiles used by a target platform
+    struct ProfileCompilation
+    {
+        ShaderProfile Profile;
+        int32 CacheChunk;
+        const char* PlatformDefine;
+        MemoryWriteStream Output;
+        bool Failed;
+    };
+    ProfileCompilation profiles[4];
+    int32 profilesCount = 0;
 
 #define COMPILE_PROFILE(profile, cacheChunk) \
 	{ \
-		cacheStream.SetPosition(0); \
-		options.Profile = ShaderProfile::profile; \
-		options.Macros.Clear(); \
-		auto& platformDefine = options.Macros.AddOne(); \
-		platformDefine.Name = platformDefineName; \
-		platformDefine.Definition = nullptr; \
-		assetBase->InitCompilationOptions(options); \
-		if (ShadersCompilation::Compile(options)) \
-		{ \
-			data.Data.Error(String::Format(TEXT("Failed to compile shader '{0}' (profile: {1})."), asset->ToString(), ::ToString(options.Profile))); \
-			return true; \
-		} \
-        includes.Clear(); \
-        ShadersCompilation::ExtractShaderIncludes(cacheStream.GetHandle(), cacheStream.GetPosition(), includes); \
-        for (auto& include : includes) \
-            data.FileDependencies.Add(ToPair(include, FileSystem::GetFileLastEditTime(include))); \
-		auto chunk = New<FlaxChunk>(); \
-		chunk->Data.Copy(cacheStream.GetHandle(), cacheStream.GetPosition()); \
-		data.InitData.Header.Chunks[cacheChunk] = chunk; \
+		ASSERT(profilesCount < ARRAY_COUNT(profiles)); \
+		auto& e = profiles[profilesCount++]; \
+		e.Profile = ShaderProfile::profile; \
+		e.CacheChunk = cacheChunk; \
+		e.PlatformDefine = platformDefineName; \
 	}
 
     // Compile for a target platform
@@ -569,6 +824,44 @@ bool ProcessShaderBase(CookAssetsStep::AssetCookData& data, ShaderAssetBase* ass
         return true;
     }
     }
+#undef COMPILE_PROFILE
+
+    // Compile shader source for all profiles in parallel (each compilation uses a separate compiler instance)
+    Function<void(int32)> compileJob = [&](int32 i)
+    {
+        auto& e = profiles[i];
+        ShaderCompilationOptions profileOptions = options;
+        profileOptions.Profile = e.Profile;
+        profileOptions.Output = &e.Output;
+        auto& platformDefine = profileOptions.Macros.AddOne();
+        platformDefine.Name = e.PlatformDefine;
+        platformDefine.Definition = nullptr;
+        assetBase->InitCompilationOptions(profileOptions);
+        e.Failed = ShadersCompilation::Compile(profileOptions);
+    };
+    if (profilesCount > 1)
+        JobSystem::Execute(compileJob, profilesCount);
+    else if (profilesCount == 1)
+        compileJob(0);
+
+    // Gather results
+    Array<String> includes;
+    for (int32 i = 0; i < profilesCount; i++)
+    {
+        auto& e = profiles[i];
+        if (e.Failed)
+        {
+            data.Data.Error(String::Format(TEXT("Failed to compile shader '{0}' (profile: {1})."), asset->ToString(), ::ToString(e.Profile)));
+            return true;
+        }
+        includes.Clear();
+        ShadersCompilation::ExtractShaderIncludes(e.Output.GetHandle(), e.Output.GetPosition(), includes);
+        for (auto& include : includes)
+            data.FileDependencies.Add(ToPair(include, FileSystem::GetFileLastEditTime(include)));
+        auto chunk = New<FlaxChunk>();
+        chunk->Data.Copy(e.Output.GetHandle(), e.Output.GetPosition());
+        data.InitData.Header.Chunks[e.CacheChunk] = chunk;
+    }
 
     // Encrypt source code
     Encryption::EncryptBytes(reinterpret_cast<byte*>(source), sourceLength);
@@ -638,6 +931,131 @@ bool ProcessParticleEmitter(CookAssetsStep::AssetCookData& data)
     return ProcessShaderBase(data, asset);
 }
 
+bool BuildModelMeshlets(CookAssetsStep::AssetCookData& data)
+{
+    const auto asset = static_cast<Model*>(data.Asset);
+    PROFILE_CPU_NAMED("Meshlets");
+
+    // Build meshlets for dense meshes (reorders the mesh indices within the LOD chunks)
+    // #MODEL_DATA_FORMAT_USAGE
+    MemoryWriteStream meshletsStream;
+    meshletsStream.WriteInt32(1); // Version
+    meshletsStream.WriteInt32(asset->LODs.Count());
+    Array<ModelMeshlet> meshlets;
+    int32 meshletsTotal = 0;
+    for (int32 lodIndex = 0; lodIndex < asset->LODs.Count(); lodIndex++)
+    {
+        const auto& lod = asset->LODs[lodIndex];
+        meshletsStream.WriteInt32(lod.Meshes.Count());
+        FlaxChunk* chunk = data.InitData.Header.Chunks[MODEL_LOD_TO_CHUNK_INDEX(lodIndex)];
+        if (!chunk)
+        {
+            LOG(Warning, "Missing data chunk for LOD{0} of model {1}.", lodIndex, asset->ToString());
+            return true;
+        }
+        MemoryReadStream stream(chunk->Get(), chunk->Size());
+        for (int32 meshIndex = 0; meshIndex < lod.Meshes.Count(); meshIndex++)
+        {
+            uint32 vertices;
+            stream.ReadUint32(&vertices);
+            uint32 triangles;
+            stream.ReadUint32(&triangles);
+            const uint32 indicesCount = triangles * 3;
+            const bool use16BitIndexBuffer = indicesCount <= MAX_uint16;
+            const uint32 ibStride = use16BitIndexBuffer ? sizeof(uint16) : sizeof(uint32);
+            auto vb0 = stream.Move<VB0ElementType>(vertices);
+            stream.Move<VB1ElementType>(vertices);
+            if (stream.ReadBool())
+                stream.Move<VB2ElementType>(vertices);
+            auto ib = stream.Move<byte>(indicesCount * ibStride);
+            meshlets.Clear();
+            if (triangles >= MODEL_MESHLETS_MIN_TRIANGLES && ModelTool::BuildMeshlets((const Float3*)vb0, vertices, ib, indicesCount, use16BitIndexBuffer, meshlets))
+            {
+                LOG(Warning, "Failed to build meshlets for mesh {0} of model {1}.", meshIndex, asset->ToString());
+                meshlets.Clear();
+            }
+            meshletsStream.WriteInt32(meshlets.Count());
+            meshletsStream.WriteBytes(meshlets.Get(), meshlets.Count() * sizeof(ModelMeshlet));
+            meshletsTotal += meshlets.Count();
+        }
+    }
+    if (meshletsTotal == 0)
+        return false;
+
+    // Store meshlets within a separate chunk
+    SAFE_DELETE(data.InitData.Header.Chunks[MODEL_MESHLETS_CHUNK_INDEX]);
+    auto chunk = New<FlaxChunk>();
+    chunk->Data.Copy(meshletsStream.GetHandle(), meshletsStream.GetPosition());
+    data.InitData.Header.Chunks[MODEL_MESHLETS_CHUNK_INDEX] = chunk;
+    return false;
+}
+
+bool CompressModelMeshes(CookAssetsStep::AssetCookData& data)
+{
+    const auto asset = static_cast<Model*>(data.Asset);
+    PROFILE_CPU_NAMED("Compress");
+
+    // Encode vertex and index buffers within the LOD chunks (after meshlets building which reorders indices)
+    uint64 srcSize = 0, dstSize = 0;
+    Array<byte> encoded;
+    for (int32 lodIndex = 0; lodIndex < asset->LODs.Count(); lodIndex++)
+    {
+        FlaxChunk* chunk = data.InitData.Header.Chunks[MODEL_LOD_TO_CHUNK_INDEX(lodIndex)];
+        if (!chunk)
+            continue;
+        if (MeshCodec::EncodeModelLOD(chunk->Data, encoded))
+        {
+            LOG(Warning, "Failed to compress LOD{0} meshes of model {1}.", lodIndex, asset->ToString());
+            continue;
+        }
+        srcSize += chunk->Size();
+        dstSize += encoded.Count();
+        chunk->Data.Copy(encoded);
+        chunk->Flags |= FlaxChunkFlags::EncodedMeshData | FlaxChunkFlags::CompressedLZ4HC;
+    }
+    if (dstSize != 0)
+        LOG(Info, "Compressed meshes of model {0}. Size: {1} -> {2}", asset->ToString(), Utilities::BytesToText(srcSize), Utilities::BytesToText(dstSize));
+    return false;
+}
+
+bool ProcessModel(CookAssetsStep::AssetCookData& data)
+{
+    if (CookAssetsStep::ProcessDefaultAsset(data))
+        return true;
+    const auto buildSettings = BuildSettings::Get();
+    if (buildSettings->GenerateMeshlets && BuildModelMeshlets(data))
+        return true;
+    if (buildSettings->CompressMeshes && CompressModelMeshes(data))
+        return true;
+    return false;
+}
+
+bool ProcessAnimation(CookAssetsStep::AssetCookData& data)
+{
+    if (CookAssetsStep::ProcessDefaultAsset(data))
+        return true;
+    if (!BuildSettings::Get()->CompressAnimations)
+        return false;
+    const auto asset = static_cast<Animation*>(data.Asset);
+    PROFILE_CPU_NAMED("Compress");
+    ScopeLock lock(asset->Locker);
+
+    // Compress animation channels
+    CompressedAnimationData compressed;
+    if (compressed.Compress(asset->Data))
+        return false;
+    LOG(Info, "Compressed animation {0}. Frames: {1}, size: {2}", asset->ToString(), compressed.FramesCount, Utilities::BytesToText(compressed.GetMemoryUsage()));
+
+    // Store compressed data within a separate chunk
+    MemoryWriteStream stream;
+    compressed.Save(stream);
+    SAFE_DELETE(data.InitData.Header.Chunks[ANIMATION_COMPRESSED_CHUNK_INDEX]);
+    auto chunk = New<FlaxChunk>();
+    chunk->Data.Copy(stream.GetHandle(), stream.GetPosition());
+    data.InitData.Header.Chunks[ANIMATION_COMPRESSED_CHUNK_INDEX] = chunk;
+    return false;
+}
+
 bool ProcessTextureBase(CookAssetsStep::AssetCookData& data)
 {
     const auto asset = static_cast<TextureBase*>(data.Asset);
@@ -679,8 +1097,16 @@ bool ProcessTextureBase(CookAssetsStep::AssetCookData& data)
 
     if (format != targetFormat)
     {
-        // Convert texture data to the target format
-        if (TextureTool::Convert(textureDataTmp1, *textureData, targetFormat))
+        // Convert texture data to the target format (use compression options from the build settings)
+        const auto buildSettings = BuildSettings::Get();
+        const TextureCompressionQuality prevCompressionQuality = TextureTool::CompressionQuality;
+        const bool prevCompressionUseGPU = TextureTool::CompressionUseGPU;
+        TextureTool::CompressionQuality = buildSettings->TextureCompression;
+        TextureTool::CompressionUseGPU = buildSettings->GPUTextureCompression;
+        const bool failed = TextureTool::Convert(textureDataTmp1, *textureData, targetFormat);
+        TextureTool::CompressionQuality = prevCompressionQuality;
+        TextureTool::CompressionUseGPU = prevCompressionUseGPU;
+        if (failed)
         {
             LOG(Error, "Failed to convert texture {0} from format {1} to {2}", asset->ToString(), ScriptingEnum::ToString(format), ScriptingEnum::ToString(targetFormat));
             return true;
@@ -780,6 +1206,8 @@ CookAssetsStep::CookAssetsStep()
     AssetProcessors.Add(Shader::TypeName, ProcessShader);
     AssetProcessors.Add(ParticleEmitter::TypeName, ProcessParticleEmitter);
     AssetProcessors.Add(Texture::TypeName, ProcessTextureBase);
+    AssetProcessors.Add(Model::TypeName, ProcessModel);
+    AssetProcessors.Add(Animation::TypeName, ProcessAnimation);
     AssetProcessors.Add(CubeTexture::TypeName, ProcessTextureBase);
     AssetProcessors.Add(SpriteAtlas::TypeName, ProcessTextureBase);
 }
@@ -1054,9 +1482,27 @@ bool CookAssetsStep::Perform(CookingData& data)
     AssetsRegistry.Clear();
     AssetPathsMapping.Clear();
 
-    // Load incremental build cache
+    // Load recorded shaders usage for permutations stripping
     CacheData cache;
+    if (buildSettings->ShadersUsageFile.HasChars())
+    {
+        const String shadersUsagePath = Globals::ProjectFolder / buildSettings->ShadersUsageFile;
+        Array<byte> shadersUsageData;
+        if (File::ReadAllBytes(shadersUsagePath, shadersUsageData) || ShaderUsageRecorder::Load(shadersUsagePath, cache.ShadersUsage))
+        {
+            LOG(Warning, "Failed to load shaders usage file {0}. All shader permutations will be included.", shadersUsagePath);
+            cache.ShadersUsage.Clear();
+        }
+        else
+        {
+            cache.ShadersUsageHash = Crc::MemCrc32(shadersUsageData.Get(), shadersUsageData.Count(), 1);
+            LOG(Info, "Using shaders usage file {0} (shaders: {1})", shadersUsagePath, cache.ShadersUsage.Count());
+        }
+    }
+
+    // Load incremental build cache
     cache.Load(data);
+    Platform::MemoryClear(&cache.Settings, sizeof(cache.Settings)); // Padding bytes are hashed and saved
 
     // Update build settings
 #if PLATFORM_TOOLS_WINDOWS
@@ -1084,12 +1530,37 @@ bool CookAssetsStep::Perform(CookingData& data)
     {
         cache.Settings.Global.ShadersNoOptimize = buildSettings->ShadersNoOptimize;
         cache.Settings.Global.ShadersGenerateDebugData = buildSettings->ShadersGenerateDebugData;
+        cache.Settings.Global.ShadersUsageHash = cache.ShadersUsageHash;
+        cache.Settings.Global.GenerateMeshlets = buildSettings->GenerateMeshlets;
+        cache.Settings.Global.CompressAnimations = buildSettings->CompressAnimations;
+        cache.Settings.Global.CompressMeshes = buildSettings->CompressMeshes;
+        cache.Settings.Global.TextureCompression = buildSettings->TextureCompression;
+        cache.Settings.Global.GPUTextureCompression = buildSettings->GPUTextureCompression;
         cache.Settings.Global.StreamingSettingsAssetId = gameSettings->Streaming;
         cache.Settings.Global.ShadersVersion = GPU_SHADER_CACHE_VERSION;
         cache.Settings.Global.MaterialGraphVersion = MATERIAL_GRAPH_VERSION;
         cache.Settings.Global.ParticleGraphVersion = PARTICLE_GPU_GRAPH_VERSION;
     }
 
+    // Setup shared cache (content-addressed so can be used by many machines that build the same project)
+    if (buildSettings->SharedCookCacheFolder.HasChars())
+    {
+        cache.SharedCacheFolder = buildSettings->SharedCookCacheFolder;
+        if (FileSystem::IsRelative(cache.SharedCacheFolder))
+            cache.SharedCacheFolder = Globals::ProjectFolder / cache.SharedCacheFolder;
+        FileSystem::NormalizePath(cache.SharedCacheFolder);
+        ContentHasher hasher;
+        hasher.Hash((int32)COOK_SHARED_CACHE_VERSION);
+        hasher.Hash((int32)FLAXENGINE_VERSION_BUILD);
+        hasher.Hash(data.Platform);
+        hasher.Hash(data.Configuration);
+        hasher.Hash(&cache.Settings, sizeof(cache.Settings));
+        const Array<byte> toolsCache = data.Tools->SaveCache(data, &cache);
+        hasher.Hash(toolsCache.Get(), toolsCache.Count());
+        cache.SharedSettingsHash = hasher.ToGuid();
+        LOG(Info, "Using shared cooking cache {0}", cache.SharedCacheFolder);
+    }
+
     // Note: this step converts all the assets (even the json) into the binary files (FlaxStorage format).
     // Then files cooked files are packed into the packages.
 
@@ -1157,6 +1628,16 @@ bool CookAssetsStep::Perform(CookingData& data)
             }
         }
 
+        // Check if asset has been already cooked by other machine (or the other build with the same settings)
+        Guid sharedKey;
+        const bool useSharedCache = cache.SharedCacheFolder.HasChars() && Content::GetAssetInfo(assetId, assetInfo) && !cache.GetSharedKey(assetId, assetInfo.TypeName, assetInfo.Path, sharedKey);
+        if (useSharedCache && cache.TryGetShared(sharedKey, assetId, assetInfo.Path))
+        {
+            e.Info.TypeName = assetInfo.TypeName;
+            data.Stats.SharedCacheAssets++;
+            continue;
+        }
+
         // Load asset (and keep ref)
         assetRef = Content::LoadAsync<Asset>(assetId);
         if (assetRef == nullptr)
@@ -1173,6 +1654,8 @@ bool CookAssetsStep::Perform(CookingData& data)
             return true;
         }
         data.Stats.CookedAssets++;
+        if (useSharedCache)
+            cache.StoreShared(sharedKey, assetId);
 
         // Auto save build cache after every few cooked assets (reduces next build time if cooking fails later)
         if (data.Stats.CookedAssets % 50 == 0)
@@ -1284,7 +1767,7 @@ bool CookAssetsStep::Perform(CookingData& data)
     BUILD_STEP_CANCEL_CHECK;
 
     // Save assets cache
-    if (AssetsCache::Save(data.DataOutputPath / TEXT("Content/AssetsCache.dat"), AssetsRegistry, AssetPathsMapping, AssetsCacheFlags::RelativePaths))
+    if (AssetsCache::Save(data.DataOutputPath / TEXT("Content/AssetsCache.dat"), AssetsRegistry, AssetPathsMapping, AssetsCacheFlags::RelativePaths | AssetsCacheFlags::PackedTables))
     {
         data.Error(TEXT("Failed to create assets registry."));
         return true;
@@ -1292,6 +1775,8 @@ bool CookAssetsStep::Perform(CookingData& data)
 
     // Print stats
     LOG(Info, "Cooked {0} assets, total assets: {1}, total content packages size: {2} MB", data.Stats.CookedAssets, AssetsRegistry.Count(), data.Stats.ContentSizeMB);
+    if (data.Stats.SharedCacheAssets != 0)
+        LOG(Info, "Restored {0} assets from the shared cooking cache", data.Stats.SharedCacheAssets);
     {
         Array<CookingData::AssetTypeStatistics> assetTypes;
         data.Stats.AssetStats.GetValues(assetTypes);
@@ -9,6 +9,8 @@
 #include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Content/AssetInfo.h"
 #include "Engine/Content/Cache/AssetsCache.h"
+#include "Engine/Graphics/Shaders/Cache/ShaderUsageRecorder.h"
+#include "Engine/Graphics/Textures/Types.h"
 
 class Asset;
 class BinaryAsset;
@@ -97,6 +99,12 @@ class FLAXENGINE_API CookAssetsStep : public GameCooker::BuildStep
             {
                 bool ShadersNoOptimize;
                 bool ShadersGenerateDebugData;
+                uint32 ShadersUsageHash;
+                bool GenerateMeshlets;
+                bool CompressAnimations;
+                bool CompressMeshes;
+                TextureCompressionQuality TextureCompression;
+                bool GPUTextureCompression;
                 Guid StreamingSettingsAssetId;
                 int32 ShadersVersion;
                 int32 MaterialGraphVersion;
@@ -109,6 +117,26 @@ class FLAXENGINE_API CookAssetsStep : public GameCooker::BuildStep
         /// </summary>
         Dictionary<Guid, CacheEntry> Entries;
 
+        /// <summary>
+        /// The recorded shaders usage used to strip the unused shader permutations (empty if not used).
+        /// </summary>
+        ShaderUsageRecorder::UsageData ShadersUsage;
+
+        /// <summary>
+        /// The hash of the current shaders usage file contents (0 if not used).
+        /// </summary>
+        uint32 ShadersUsageHash = 0;
+
+        /// <summary>
+        /// The shared cooked assets cache folder (content-addressed, can be used by many machines). Empty if not used.
+        /// </summary>
+        String SharedCacheFolder;
+
+        /// <summary>
+        /// The hash of the engine version, target platform and cooking options used to build the shared cache keys.
+        /// </summary>
+        Guid SharedSettingsHash;
+
     public:
 
         /// <summary>
@@ -149,6 +177,32 @@ class FLAXENGINE_API CookAssetsStep : public GameCooker::BuildStep
         /// <param name="data">The data.</param>
         void Save(CookingData& data);
 
+        /// <summary>
+        /// Gets the key of the asset in the shared cache (hash of the asset file contents and the cooking settings).
+        /// </summary>
+        /// <param name="id">The asset id.</param>
+        /// <param name="typeName">The asset typename.</param>
+        /// <param name="path">The asset file path.</param>
+        /// <param name="key">The result key.</param>
+        /// <returns>True if failed, otherwise false.</returns>
+        bool GetSharedKey(const Guid& id, const StringView& typeName, const StringView& path, Guid& key) const;
+
+        /// <summary>
+        /// Tries to restore the cooked asset from the shared cache into the local cache (validates the dependant files contents).
+        /// </summary>
+        /// <param name="key">The asset key in the shared cache.</param>
+        /// <param name="id">The asset id.</param>
+        /// <param name="path">The asset file path.</param>
+        /// <returns>True if the asset has been restored and added to the entries, otherwise false.</returns>
+        bool TryGetShared(const Guid& key, const Guid& id, const StringView& path);
+
+        /// <summary>
+        /// Stores the cooked asset from the local cache in the shared cache.
+        /// </summary>
+        /// <param name="key">The asset key in the shared cache.</param>
+        /// <param name="id">The asset id.</param>
+        void StoreShared(const Guid& key, const Guid& id) const;
+
         using IBuildCache::InvalidateCachePerType;
         void InvalidateCachePerType(const StringView& typeName) override;
     };
@@ -334,6 +334,9 @@ bool DeployDataStep::Perform(CookingData& data)
     data.AddRootEngineAsset(TEXT("Shaders/PostProcessing"));
     data.AddRootEngineAsset(TEXT("Shaders/MotionBlur"));
     data.AddRootEngineAsset(TEXT("Shaders/BitonicSort"));
+    data.AddRootEngineAsset(TEXT("Shaders/InstanceCulling"));
+    data.AddRootEngineAsset(TEXT("Shaders/OcclusionCulling"));
+    data.AddRootEngineAsset(TEXT("Shaders/VariableRateShading"));
     data.AddRootEngineAsset(TEXT("Shaders/GPUParticlesSorting"));
     data.AddRootEngineAsset(TEXT("Shaders/GlobalSignDistanceField"));
     data.AddRootEngineAsset(TEXT("Shaders/GI/GlobalSurfaceAtlas"));
@@ -342,6 +345,7 @@ bool DeployDataStep::Perform(CookingData& data)
     data.AddRootEngineAsset(TEXT("Shaders/Reflections"));
     data.AddRootEngineAsset(TEXT("Shaders/Shadows"));
     data.AddRootEngineAsset(TEXT("Shaders/Sky"));
+    data.AddRootEngineAsset(TEXT("Shaders/SplineDeformation"));
     data.AddRootEngineAsset(TEXT("Shaders/SSAO"));
     data.AddRootEngineAsset(TEXT("Shaders/SSR"));
     data.AddRootEngineAsset(TEXT("Shaders/VolumetricFog"));
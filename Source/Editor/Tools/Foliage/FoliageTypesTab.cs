@@ -265,6 +265,52 @@ public bool RandomYaw
                 get => _type.PlacementRandomYaw;
                 set => _type.PlacementRandomYaw = value;
             }
+
+            //
+
+            [EditorOrder(400), EditorDisplay("Procedural", "Terrain Layer"), Limit(-1, 7), Tooltip("The terrain layer index (0-7) that drives the procedural foliage placement (layer weight scales the density). Use -1 to scatter instances over the whole terrain. Used only when foliage uses procedural mode.")]
+            public int ProceduralLayer
+            {
+                get => _type.ProceduralLayer;
+                set
+                {
+                    _type.ProceduralLayer = value;
+                    Foliage.ResetProcedural();
+                }
+            }
+
+            [EditorOrder(410), EditorDisplay("Procedural", "Layer Threshold"), Limit(0, 1, 0.01f), Tooltip("The minimum terrain layer weight (normalized 0-1) required to place the procedural foliage instance.")]
+            public float ProceduralLayerThreshold
+            {
+                get => _type.ProceduralLayerThreshold;
+                set
+                {
+                    _type.ProceduralLayerThreshold = value;
+                    Foliage.ResetProcedural();
+                }
+            }
+
+            [EditorOrder(420), EditorDisplay("Procedural", "Noise Size"), Limit(0.0f), Tooltip("The size (in world units) of the noise pattern used to break up the procedural foliage density. Use 0 to disable noise.")]
+            public float ProceduralNoiseSize
+            {
+                get => _type.ProceduralNoiseSize;
+                set
+                {
+                    _type.ProceduralNoiseSize = value;
+                    Foliage.ResetProcedural();
+                }
+            }
+
+            [EditorOrder(430), EditorDisplay("Procedural", "Noise Threshold"), Limit(0, 1, 0.01f), Tooltip("The minimum noise value (normalized 0-1) required to place the procedural foliage instance.")]
+            public float ProceduralNoiseThreshold
+            {
+                get => _type.ProceduralNoiseThreshold;
+                set
+                {
+                    _type.ProceduralNoiseThreshold = value;
+                    Foliage.ResetProcedural();
+                }
+            }
         }
 
         /// <summary>
@@ -1,5 +1,6 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
+using System.Threading.Tasks;
 using FlaxEngine;
 
 namespace FlaxEditor.Tools.Terrain.Paint
@@ -73,45 +74,55 @@ public override unsafe void Apply(ref ApplyParams p)
             var layer = (int)Layer;
             var brushPosition = p.Gizmo.CursorPosition;
             var c = layer % 4;
-
-            // Apply brush modification
+            var brush = p.Brush;
+            var terrainWorld = p.TerrainWorld;
+            var patchPositionLocal = p.PatchPositionLocal;
+            var modifiedOffset = p.ModifiedOffset;
+            var modifiedSize = p.ModifiedSize;
+            var heightmapSize = p.HeightmapSize;
+            var sourceData = p.SourceData;
+            var sourceDataOther = p.SourceDataOther;
+            var tempBuffer = p.TempBuffer;
+            var tempBufferOther = p.TempBufferOther;
+
+            // Apply brush modification (rows are independent so process them in parallel)
             Profiler.BeginEvent("Apply Brush");
             bool otherModified = false;
-            for (int z = 0; z < p.ModifiedSize.Y; z++)
+            Parallel.For(0, modifiedSize.Y, z =>
             {
-                var zz = z + p.ModifiedOffset.Y;
-                for (int x = 0; x < p.ModifiedSize.X; x++)
+                var zz = z + modifiedOffset.Y;
+                for (int x = 0; x < modifiedSize.X; x++)
                 {
-                    var xx = x + p.ModifiedOffset.X;
-                    var src = (Color)p.SourceData[zz * p.HeightmapSize + xx];
+                    var xx = x + modifiedOffset.X;
+                    var src = (Color)sourceData[zz * heightmapSize + xx];
 
-                    var samplePositionLocal = p.PatchPositionLocal + new Vector3(xx * FlaxEngine.Terrain.UnitsPerVertex, 0, zz * FlaxEngine.Terrain.UnitsPerVertex);
-                    Vector3.Transform(ref samplePositionLocal, ref p.TerrainWorld, out Vector3 samplePositionWorld);
-                    var sample = Mathf.Saturate(p.Brush.Sample(ref brushPosition, ref samplePositionWorld));
+                    var samplePositionLocal = patchPositionLocal + new Vector3(xx * FlaxEngine.Terrain.UnitsPerVertex, 0, zz * FlaxEngine.Terrain.UnitsPerVertex);
+                    Vector3.Transform(ref samplePositionLocal, ref terrainWorld, out Vector3 samplePositionWorld);
+                    var sample = Mathf.Saturate(brush.Sample(ref brushPosition, ref samplePositionWorld));
 
                     var paintAmount = sample * strength;
                     if (paintAmount < 0.0f)
                         continue; // Skip when pixel won't be affected
 
                     // Other layers reduction based on their sum and current paint intensity
-                    var srcOther = (Color)p.SourceDataOther[zz * p.HeightmapSize + xx];
+                    var srcOther = (Color)sourceDataOther[zz * heightmapSize + xx];
                     var otherLayersSum = src.ValuesSum + srcOther.ValuesSum - src[c];
                     var decreaseAmount = paintAmount / otherLayersSum;
 
                     // Paint on the active splatmap texture
                     var srcNew = Color.Clamp(src - src * decreaseAmount, Color.Zero, Color.White);
                     srcNew[c] = Mathf.Saturate(src[c] + paintAmount);
-                    p.TempBuffer[z * p.ModifiedSize.X + x] = srcNew;
+                    tempBuffer[z * modifiedSize.X + x] = srcNew;
 
                     //if (other.ValuesSum > 0.0f) // Skip editing the other splatmap if it's empty
                     {
                         // Remove 'paint' from the other splatmap texture
                         srcOther = Color.Clamp(srcOther - srcOther * decreaseAmount, Color.Zero, Color.White);
-                        p.TempBufferOther[z * p.ModifiedSize.X + x] = srcOther;
+                        tempBufferOther[z * modifiedSize.X + x] = srcOther;
                         otherModified = true;
                     }
                 }
-            }
+            });
             Profiler.EndEvent();
 
             // Update terrain patch
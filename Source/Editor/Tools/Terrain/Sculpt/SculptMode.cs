@@ -1,5 +1,6 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
+using System.Threading.Tasks;
 using FlaxEngine;
 
 namespace FlaxEditor.Tools.Terrain.Sculpt
@@ -19,25 +20,33 @@ public override unsafe void ApplyBrushToPatch(ref ApplyParams p)
         {
             var strength = p.Strength * 1000.0f;
             var brushPosition = p.Gizmo.CursorPosition;
-
-            // Apply brush modification
+            var brush = p.Brush;
+            var terrainWorld = p.TerrainWorld;
+            var patchPositionLocal = p.PatchPositionLocal;
+            var modifiedOffset = p.ModifiedOffset;
+            var modifiedSize = p.ModifiedSize;
+            var heightmapSize = p.HeightmapSize;
+            var sourceHeightMap = p.SourceHeightMap;
+            var tempBuffer = p.TempBuffer;
+
+            // Apply brush modification (rows are independent so process them in parallel)
             Profiler.BeginEvent("Apply Brush");
-            for (int z = 0; z < p.ModifiedSize.Y; z++)
+            Parallel.For(0, modifiedSize.Y, z =>
             {
-                var zz = z + p.ModifiedOffset.Y;
-                for (int x = 0; x < p.ModifiedSize.X; x++)
+                var zz = z + modifiedOffset.Y;
+                for (int x = 0; x < modifiedSize.X; x++)
                 {
-                    var xx = x + p.ModifiedOffset.X;
-                    var sourceHeight = p.SourceHeightMap[zz * p.HeightmapSize + xx];
+                    var xx = x + modifiedOffset.X;
+                    var sourceHeight = sourceHeightMap[zz * heightmapSize + xx];
 
-                    var samplePositionLocal = p.PatchPositionLocal + new Vector3(xx * FlaxEngine.Terrain.UnitsPerVertex, sourceHeight, zz * FlaxEngine.Terrain.UnitsPerVertex);
-                    Vector3.Transform(ref samplePositionLocal, ref p.TerrainWorld, out Vector3 samplePositionWorld);
+                    var samplePositionLocal = patchPositionLocal + new Vector3(xx * FlaxEngine.Terrain.UnitsPerVertex, sourceHeight, zz * FlaxEngine.Terrain.UnitsPerVertex);
+                    Vector3.Transform(ref samplePositionLocal, ref terrainWorld, out Vector3 samplePositionWorld);
 
-                    var paintAmount = p.Brush.Sample(ref brushPosition, ref samplePositionWorld);
+                    var paintAmount = brush.Sample(ref brushPosition, ref samplePositionWorld);
 
-                    p.TempBuffer[z * p.ModifiedSize.X + x] = sourceHeight + paintAmount * strength;
+                    tempBuffer[z * modifiedSize.X + x] = sourceHeight + paintAmount * strength;
                 }
-            }
+            });
             Profiler.EndEvent();
 
             // Update terrain patch
@@ -17,6 +17,7 @@ internal sealed unsafe class GPU : ProfilerMode
         private readonly SingleChart _drawTimeGPU;
         private readonly Timeline _timeline;
         private readonly Table _table;
+        private readonly Button _pipelineStatsButton;
         private SamplesBuffer<ProfilerGPU.Event[]> _events;
         private List<Timeline.Event> _timelineEventsCache;
         private List<Row> _tableRowsCache;
@@ -62,6 +63,22 @@ public GPU()
                 Parent = layout,
             };
 
+            // Pipeline statistics controls
+            var controls = new HorizontalPanel
+            {
+                AutoSize = false,
+                Height = 24.0f,
+                Margin = new Margin(4.0f, 4.0f, 2.0f, 2.0f),
+                Parent = layout,
+            };
+            _pipelineStatsButton = new Button
+            {
+                Width = 200.0f,
+                TooltipText = "Toggles the GPU pipeline statistics collection per event (vertices, primitives and shader invocations). Adds GPU overhead. Supported on DirectX 11 and DirectX 12.",
+                Parent = controls,
+            };
+            _pipelineStatsButton.Clicked += () => ProfilerGPU.PipelineStatistics = !ProfilerGPU.PipelineStatistics;
+
             // Table
             var style = Style.Current;
             var headerColor = style.LightBackground;
@@ -100,6 +117,13 @@ public GPU()
                         FormatValue = FormatCountLong,
                     },
                     new ColumnDefinition
+                    {
+                        Title = "Dispatches",
+                        TitleBackgroundColor = headerColor,
+                        TitleColor = textColor,
+                        FormatValue = FormatCountLong,
+                    },
+                    new ColumnDefinition
                     {
                         Title = "Triangles",
                         TitleBackgroundColor = headerColor,
@@ -113,17 +137,58 @@ public GPU()
                         TitleColor = textColor,
                         FormatValue = FormatCountLong,
                     },
+                    new ColumnDefinition
+                    {
+                        Title = "Redundant Binds",
+                        TitleBackgroundColor = headerColor,
+                        TitleColor = textColor,
+                        FormatValue = FormatCountLong,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "Primitives",
+                        TitleBackgroundColor = headerColor,
+                        TitleColor = textColor,
+                        FormatValue = FormatCountULong,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "VS Invocations",
+                        TitleBackgroundColor = headerColor,
+                        TitleColor = textColor,
+                        FormatValue = FormatCountULong,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "PS Invocations",
+                        TitleBackgroundColor = headerColor,
+                        TitleColor = textColor,
+                        FormatValue = FormatCountULong,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "CS Invocations",
+                        TitleBackgroundColor = headerColor,
+                        TitleColor = textColor,
+                        FormatValue = FormatCountULong,
+                    },
                 },
                 Parent = layout,
             };
             _table.Splits = new[]
             {
-                0.5f,
-                0.1f,
-                0.1f,
-                0.1f,
-                0.1f,
-                0.1f,
+                0.25f,
+                0.06f,
+                0.07f,
+                0.07f,
+                0.07f,
+                0.07f,
+                0.07f,
+                0.07f,
+                0.07f,
+                0.06f,
+                0.07f,
+                0.07f,
             };
         }
 
@@ -132,6 +197,11 @@ private static string FormatCountLong(object x)
             return ((long)x).ToString("###,###,###");
         }
 
+        private static string FormatCountULong(object x)
+        {
+            return ((ulong)x).ToString("###,###,###");
+        }
+
         /// <inheritdoc />
         public override void Clear()
         {
@@ -159,6 +229,7 @@ public override void UpdateView(int selectedFrame, bool showOnlyLastUpdateEvents
         {
             _drawTimeCPU.SelectedSampleIndex = selectedFrame;
             _drawTimeGPU.SelectedSampleIndex = selectedFrame;
+            _pipelineStatsButton.Text = ProfilerGPU.PipelineStatistics ? "Disable Pipeline Statistics" : "Enable Pipeline Statistics";
 
             if (_events == null)
                 return;
@@ -341,8 +412,8 @@ private void UpdateTableInner()
                 {
                     row = new Row
                     {
-                        Values = new object[6],
-                        BackgroundColors = new Color[6],
+                        Values = new object[12],
+                        BackgroundColors = new Color[12],
                     };
                     for (int k = 0; k < row.BackgroundColors.Length; k++)
                         row.BackgroundColors[k] = Color.Transparent;
@@ -360,13 +431,25 @@ private void UpdateTableInner()
                     row.Values[2] = (e.Time * 10000.0f) / 10000.0f;
 
                     // Draw Calls
-                    row.Values[3] = e.Stats.DrawCalls + e.Stats.DispatchCalls;
+                    row.Values[3] = e.Stats.DrawCalls;
+
+                    // Dispatches
+                    row.Values[4] = e.Stats.DispatchCalls;
 
                     // Triangles
-                    row.Values[4] = e.Stats.Triangles;
+                    row.Values[5] = e.Stats.Triangles;
 
                     // Vertices
-                    row.Values[5] = e.Stats.Vertices;
+                    row.Values[6] = e.Stats.Vertices;
+
+                    // Redundant Binds
+                    row.Values[7] = e.Stats.RedundantStateBinds;
+
+                    // Pipeline statistics
+                    row.Values[8] = e.PipelineStats.RasterizedPrimitives;
+                    row.Values[9] = e.PipelineStats.VertexShaderInvocations;
+                    row.Values[10] = e.PipelineStats.PixelShaderInvocations;
+                    row.Values[11] = e.PipelineStats.ComputeShaderInvocations;
                 }
                 row.Depth = e.Depth;
                 row.Width = _table.Width;
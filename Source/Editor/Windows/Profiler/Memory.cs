@@ -1,6 +1,10 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
 using System;
+using System.Collections.Generic;
+using System.IO;
+using FlaxEditor.GUI;
+using FlaxEngine;
 using FlaxEngine.GUI;
 
 namespace FlaxEditor.Windows.Profiler
@@ -13,6 +17,11 @@ internal sealed class Memory : ProfilerMode
     {
         private readonly SingleChart _nativeAllocationsChart;
         private readonly SingleChart _managedAllocationsChart;
+        private readonly Button _trackingButton;
+        private readonly Table _groupsTable;
+        private SamplesBuffer<ProfilerMemory.GroupStats[]> _groups;
+        private List<ClickableRow> _tableRowsCache;
+        private string[] _groupsNames;
 
         public Memory()
         : base("Memory")
@@ -47,6 +56,77 @@ public Memory()
                 Parent = layout,
             };
             _managedAllocationsChart.SelectedSampleChanged += OnSelectedSampleChanged;
+
+            // Memory tracking controls
+            var controls = new HorizontalPanel
+            {
+                AutoSize = false,
+                Height = 24.0f,
+                Margin = new Margin(4.0f, 4.0f, 2.0f, 2.0f),
+                Parent = layout,
+            };
+            _trackingButton = new Button
+            {
+                Width = 200.0f,
+                TooltipText = "Toggles the native memory allocations tracking per engine subsystem (adds overhead to each allocation). Use -memprofiler command line switch to track memory from the engine startup.",
+                Parent = controls,
+            };
+            _trackingButton.Clicked += () => ProfilerMemory.Enabled = !ProfilerMemory.Enabled;
+            var dumpButton = new Button
+            {
+                Text = "Dump Memory Report",
+                Width = 160.0f,
+                TooltipText = "Saves the memory report (groups stats, GPU memory per resource type and the top sampled allocation callstacks) to the file in the project Logs folder.",
+                Parent = controls,
+            };
+            dumpButton.Clicked += OnDumpClicked;
+
+            // Table
+            var style = Style.Current;
+            var headerColor = style.LightBackground;
+            var textColor = style.Foreground;
+            _groupsTable = new Table
+            {
+                Columns = new[]
+                {
+                    new ColumnDefinition
+                    {
+                        UseExpandCollapseMode = true,
+                        CellAlignment = TextAlignment.Near,
+                        Title = "Memory Group",
+                        TitleBackgroundColor = headerColor,
+                        TitleColor = textColor,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "Size",
+                        TitleBackgroundColor = headerColor,
+                        FormatValue = v => Utilities.Utils.FormatBytesCount((ulong)v),
+                        TitleColor = textColor,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "Peak",
+                        TitleBackgroundColor = headerColor,
+                        FormatValue = v => Utilities.Utils.FormatBytesCount((ulong)v),
+                        TitleColor = textColor,
+                    },
+                    new ColumnDefinition
+                    {
+                        Title = "Allocations",
+                        TitleBackgroundColor = headerColor,
+                        TitleColor = textColor,
+                    },
+                },
+                Parent = layout,
+            };
+            _groupsTable.Splits = new[]
+            {
+                0.4f,
+                0.2f,
+                0.2f,
+                0.2f,
+            };
         }
 
         /// <inheritdoc />
@@ -54,6 +134,7 @@ public override void Clear()
         {
             _nativeAllocationsChart.Clear();
             _managedAllocationsChart.Clear();
+            _groups?.Clear();
         }
 
         /// <inheritdoc />
@@ -81,6 +162,11 @@ public override void Update(ref SharedUpdateData sharedData)
 
             _nativeAllocationsChart.AddSample(nativeMemoryAllocation);
             _managedAllocationsChart.AddSample(managedMemoryAllocation);
+
+            // Capture memory groups stats
+            if (_groups == null)
+                _groups = new SamplesBuffer<ProfilerMemory.GroupStats[]>();
+            _groups.Add(ProfilerMemory.Enabled ? ProfilerMemory.GetGroups() : null);
         }
 
         /// <inheritdoc />
@@ -88,6 +174,102 @@ public override void UpdateView(int selectedFrame, bool showOnlyLastUpdateEvents
         {
             _nativeAllocationsChart.SelectedSampleIndex = selectedFrame;
             _managedAllocationsChart.SelectedSampleIndex = selectedFrame;
+            _trackingButton.Text = ProfilerMemory.Enabled ? "Disable Memory Tracking" : "Enable Memory Tracking";
+
+            if (_groups == null)
+                return;
+            if (_tableRowsCache == null)
+                _tableRowsCache = new List<ClickableRow>();
+            if (_groupsNames == null)
+                _groupsNames = Enum.GetNames(typeof(ProfilerMemory.Groups));
+            UpdateTable();
+        }
+
+        /// <inheritdoc />
+        public override void OnDestroy()
+        {
+            _groups?.Clear();
+            _tableRowsCache?.Clear();
+
+            base.OnDestroy();
+        }
+
+        private void OnDumpClicked()
+        {
+            var path = Path.Combine(Globals.ProjectFolder, "Logs", "Memory_" + DateTime.Now.ToString("yyyy_MM_dd_HH_mm_ss") + ".txt");
+            if (ProfilerMemory.Dump(path))
+                Editor.LogError("Failed to save memory report to " + path);
+            else
+                Editor.Log("Saved memory report to " + path);
+        }
+
+        private void UpdateTable()
+        {
+            _groupsTable.IsLayoutLocked = true;
+            int idx = 0;
+            while (_groupsTable.Children.Count > idx)
+            {
+                var child = _groupsTable.Children[idx];
+                if (child is ClickableRow row)
+                {
+                    _tableRowsCache.Add(row);
+                    child.Parent = null;
+                }
+                else
+                {
+                    idx++;
+                }
+            }
+            _groupsTable.LockChildrenRecursive();
+
+            UpdateTableInner();
+
+            _groupsTable.UnlockChildrenRecursive();
+            _groupsTable.PerformLayout();
+        }
+
+        private void UpdateTableInner()
+        {
+            if (_groups.Count == 0)
+                return;
+            var groups = _groups.Get(_nativeAllocationsChart.SelectedSampleIndex);
+            if (groups == null || groups.Length == 0)
+                return;
+
+            // Add rows
+            var rowColor2 = Style.Current.Background * 1.4f;
+            int rowIndex = 0;
+            for (int i = 0; i < groups.Length; i++)
+            {
+                ref var e = ref groups[i];
+                if (e.TotalCount == 0)
+                    continue;
+                ClickableRow row;
+                if (_tableRowsCache.Count != 0)
+                {
+                    // Reuse row
+                    var last = _tableRowsCache.Count - 1;
+                    row = _tableRowsCache[last];
+                    _tableRowsCache.RemoveAt(last);
+                }
+                else
+                {
+                    // Allocate new row
+                    row = new ClickableRow { Values = new object[4] };
+                }
+
+                // Setup row data
+                row.Values[0] = i < _groupsNames.Length ? _groupsNames[i] : i.ToString();
+                row.Values[1] = e.Size;
+                row.Values[2] = e.Peak;
+                row.Values[3] = e.Count;
+
+                // Add row to the table
+                row.Width = _groupsTable.Width;
+                row.BackgroundColor = rowIndex % 2 == 0 ? rowColor2 : Color.Transparent;
+                row.Parent = _groupsTable;
+                rowIndex++;
+            }
         }
     }
 }
@@ -17,6 +17,9 @@ internal sealed class Physics : ProfilerMode
         private readonly SingleChart _staticBodiesChart;
         private readonly SingleChart _newPairsChart;
         private readonly SingleChart _newTouchesChart;
+        private readonly SingleChart _contactPairsChart;
+        private readonly SingleChart _sceneQueriesChart;
+        private readonly SingleChart _sceneQueriesTimeChart;
 
         public Physics()
         : base("Physics")
@@ -73,6 +76,25 @@ public Physics()
                 Parent = layout,
             };
             _newTouchesChart.SelectedSampleChanged += OnSelectedSampleChanged;
+            _contactPairsChart = new SingleChart
+            {
+                Title = "Contact Pairs",
+                Parent = layout,
+            };
+            _contactPairsChart.SelectedSampleChanged += OnSelectedSampleChanged;
+            _sceneQueriesChart = new SingleChart
+            {
+                Title = "Scene Queries",
+                Parent = layout,
+            };
+            _sceneQueriesChart.SelectedSampleChanged += OnSelectedSampleChanged;
+            _sceneQueriesTimeChart = new SingleChart
+            {
+                Title = "Scene Queries Time",
+                FormatSample = v => (Mathf.RoundToInt(v * 100.0f) / 100.0f) + " ms",
+                Parent = layout,
+            };
+            _sceneQueriesTimeChart.SelectedSampleChanged += OnSelectedSampleChanged;
         }
 
         /// <inheritdoc />
@@ -84,6 +106,9 @@ public override void Clear()
             _staticBodiesChart.Clear();
             _newPairsChart.Clear();
             _newTouchesChart.Clear();
+            _contactPairsChart.Clear();
+            _sceneQueriesChart.Clear();
+            _sceneQueriesTimeChart.Clear();
         }
 
         /// <inheritdoc />
@@ -97,6 +122,9 @@ public override void Update(ref SharedUpdateData sharedData)
             _staticBodiesChart.AddSample(statistics.StaticBodies);
             _newPairsChart.AddSample(statistics.NewPairs);
             _newTouchesChart.AddSample(statistics.NewTouches);
+            _contactPairsChart.AddSample(statistics.ContactPairs + statistics.CCDPairs);
+            _sceneQueriesChart.AddSample(statistics.RayCastQueries + statistics.SweepQueries + statistics.OverlapQueries);
+            _sceneQueriesTimeChart.AddSample(statistics.RayCastQueriesTime + statistics.SweepQueriesTime + statistics.OverlapQueriesTime);
         }
 
         /// <inheritdoc />
@@ -108,6 +136,9 @@ public override void UpdateView(int selectedFrame, bool showOnlyLastUpdateEvents
             _staticBodiesChart.SelectedSampleIndex = selectedFrame;
             _newPairsChart.SelectedSampleIndex = selectedFrame;
             _newTouchesChart.SelectedSampleIndex = selectedFrame;
+            _contactPairsChart.SelectedSampleIndex = selectedFrame;
+            _sceneQueriesChart.SelectedSampleIndex = selectedFrame;
+            _sceneQueriesTimeChart.SelectedSampleIndex = selectedFrame;
         }
     }
 }
@@ -6,6 +6,7 @@
 #include "Engine/Engine/Engine.h"
 #include "Engine/Engine/Time.h"
 #include "Engine/Engine/EngineService.h"
+#include "Engine/Level/Actor.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Threading/TaskGraph.h"
 
@@ -34,6 +35,7 @@ class BehaviorService : public EngineService
 
 BehaviorService BehaviorServiceInstance;
 TaskGraphSystem* Behavior::System = nullptr;
+Vector3 Behavior::LODOrigin = Vector3::Zero;
 
 void BehaviorSystem::Job(int32 index)
 {
@@ -89,7 +91,10 @@ void Behavior::UpdateAsync()
 
     // Update timer
     _accumulatedTime += Time::Update.DeltaTime.GetTotalSeconds();
-    const float updateDeltaTime = 1.0f / Math::Max(tree->Graph.Root->UpdateFPS * UpdateRateScale, ZeroTolerance);
+    float updateRateScale = UpdateRateScale;
+    if (LODDistance > ZeroTolerance && _parent && Vector3::DistanceSquared(_parent->GetPosition(), LODOrigin) > LODDistance * LODDistance)
+        updateRateScale *= LODUpdateRateScale;
+    const float updateDeltaTime = 1.0f / Math::Max(tree->Graph.Root->UpdateFPS * updateRateScale, ZeroTolerance);
     if (_accumulatedTime < updateDeltaTime)
         return;
     _accumulatedTime -= updateDeltaTime;
@@ -49,6 +49,23 @@ API_CLASS(Attributes="Category(\"Flax Engine\")") class FLAXENGINE_API Behavior
     API_FIELD(Attributes="EditorOrder(20), Limit(0, 10, 0.01f)")
     float UpdateRateScale = 1.0f;
 
+    /// <summary>
+    /// The distance from the LODOrigin above which behavior logic update rate is scaled by LODUpdateRateScale. Use 0 to disable automatic LOD.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(30), Limit(0)")
+    float LODDistance = 0.0f;
+
+    /// <summary>
+    /// The behavior logic update rate scale used when behavior is further than LODDistance from the LODOrigin.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(40), Limit(0, 1, 0.01f)")
+    float LODUpdateRateScale = 0.25f;
+
+    /// <summary>
+    /// The location used to calculate the behaviors LOD (eg. player or camera position).
+    /// </summary>
+    API_FIELD() static Vector3 LODOrigin;
+
 public:
     /// <summary>
     /// Gets the current behavior knowledge instance. Empty if not started.
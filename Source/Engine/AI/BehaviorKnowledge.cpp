@@ -14,7 +14,7 @@
 #include "Engine/Scripting/ManagedCLR/MUtils.h"
 #endif
 
-bool AccessVariant(Variant& instance, const StringAnsiView& member, Variant& value, bool set)
+bool AccessVariant(Variant& instance, const StringAnsiView& member, Variant& value, bool set, ScriptingTypeHandle typeHandle = ScriptingTypeHandle(), Dictionary<StringAnsi, void*>* fieldsCache = nullptr)
 {
     if (member.IsEmpty())
     {
@@ -31,7 +31,8 @@ bool AccessVariant(Variant& instance, const StringAnsiView& member, Variant& val
     // TODO: support further path for nested value types (eg. structure field access)
 
     const StringAnsiView typeName(instance.Type.TypeName);
-    const ScriptingTypeHandle typeHandle = Scripting::FindScriptingType(typeName);
+    if (!typeHandle)
+        typeHandle = Scripting::FindScriptingType(typeName);
     if (typeHandle)
     {
         const ScriptingType& type = typeHandle.GetType();
@@ -49,7 +50,14 @@ bool AccessVariant(Variant& instance, const StringAnsiView& member, Variant& val
         }
         default:
         {
-            if (void* field = typeHandle.Module->FindField(typeHandle, member))
+            void* field = nullptr;
+            if (!fieldsCache || !fieldsCache->TryGet(member, field))
+            {
+                field = typeHandle.Module->FindField(typeHandle, member);
+                if (fieldsCache)
+                    fieldsCache->Add(StringAnsi(member), field);
+            }
+            if (field)
             {
                 if (set)
                     return !typeHandle.Module->SetFieldValue(field, instance, value);
@@ -100,7 +108,7 @@ bool AccessBehaviorKnowledge(BehaviorKnowledge* knowledge, const StringAnsiView&
     if (type == "Blackboard")
     {
         const StringAnsiView member(path.Get() + typeEnd + 1, path.Length() - typeEnd - 1);
-        return AccessVariant(knowledge->Blackboard, member, value, set);
+        return AccessVariant(knowledge->Blackboard, member, value, set, knowledge->BlackboardType, &knowledge->BlackboardFields);
     }
     if (type == "Goal")
     {
@@ -150,6 +158,7 @@ void BehaviorKnowledge::InitMemory(BehaviorTree* tree)
         return;
     Tree = tree;
     Blackboard = Variant::NewValue(tree->Graph.Root->BlackboardType);
+    BlackboardType = Scripting::FindScriptingType(tree->Graph.Root->BlackboardType);
     RelevantNodes.Resize(tree->Graph.NodesCount, false);
     RelevantNodes.SetAll(false);
     if (!Memory && tree->Graph.NodesStatesSize)
@@ -185,6 +194,8 @@ void BehaviorKnowledge::FreeMemory()
     }
     RelevantNodes.Clear();
     Blackboard.DeleteValue();
+    BlackboardType = ScriptingTypeHandle();
+    BlackboardFields.Clear();
     for (Variant& goal : Goals)
         goal.DeleteValue();
     Goals.Resize(0);
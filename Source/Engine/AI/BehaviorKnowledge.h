@@ -5,6 +5,7 @@
 #include "Engine/Core/Types/Variant.h"
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Collections/BitArray.h"
+#include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Scripting/ScriptingObject.h"
 
 class Behavior;
@@ -44,6 +45,16 @@ API_CLASS() class FLAXENGINE_API BehaviorKnowledge : public ScriptingObject
     /// </summary>
     API_FIELD() Variant Blackboard;
 
+    /// <summary>
+    /// Scripting type of the blackboard (resolved once on memory init).
+    /// </summary>
+    ScriptingTypeHandle BlackboardType;
+
+    /// <summary>
+    /// Cache of the blackboard fields (by member name) used to skip type members search on each knowledge access.
+    /// </summary>
+    Dictionary<StringAnsi, void*> BlackboardFields;
+
     /// <summary>
     /// List of all active goals of the behaviour (structure or class).
     /// </summary>
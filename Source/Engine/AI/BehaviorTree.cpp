@@ -102,11 +102,14 @@ void BehaviorTreeGraph::Setup(BehaviorTree* tree)
 
 void BehaviorTreeGraph::SetupRecursive(Node& node)
 {
-    // Count total states memory size
+    // Count total states memory size (states are packed in the execution order with an alignment for the state data)
     ASSERT_LOW_LAYER(node.Instance);
+    const int32 stateSize = node.Instance->GetStateSize();
+    if (stateSize != 0)
+        NodesStatesSize = Math::AlignUp(NodesStatesSize, stateSize >= 16 ? 16 : 8);
     node.Instance->_memoryOffset = NodesStatesSize;
     node.Instance->_executionIndex = NodesCount;
-    NodesStatesSize += node.Instance->GetStateSize();
+    NodesStatesSize += stateSize;
     NodesCount++;
 
     if (node.TypeID == 1 && node.Values.Count() >= 3)
@@ -1,6 +1,298 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
 #include "AnimationData.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Serialization/ReadStream.h"
+#include "Engine/Serialization/WriteStream.h"
+
+#define COMPRESSED_ANIMATION_VERSION 1
+
+namespace
+{
+    FORCE_INLINE Float3 ReadFloat3(const byte* data, const CompressedAnimationData::TrackFormat format, const Float3& min, const Float3& extent)
+    {
+        if (format == CompressedAnimationData::TrackFormat::Quantized)
+        {
+            const uint16* v = (const uint16*)data;
+            return min + extent * Float3(v[0], v[1], v[2]) * (1.0f / MAX_uint16);
+        }
+        Float3 result;
+        Platform::MemoryCopy(&result, data, sizeof(Float3));
+        return result;
+    }
+
+    FORCE_INLINE Quaternion ReadQuaternion(const byte* data)
+    {
+        // Smallest-three decoding (index of the largest component is stored in the top bits of the first two values)
+        const uint16* v = (const uint16*)data;
+        const int32 largest = (v[0] >> 15) | ((v[1] >> 15) << 1);
+        const float range = Math::Sqrt(0.5f);
+        const float a = (float)(v[0] & 0x7fff) * (2.0f * range / 0x7fff) - range;
+        const float b = (float)(v[1] & 0x7fff) * (2.0f * range / 0x7fff) - range;
+        const float c = (float)(v[2] & 0x7fff) * (2.0f * range / 0x7fff) - range;
+        const float d = Math::Sqrt(Math::Max(1.0f - a * a - b * b - c * c, 0.0f));
+        switch (largest)
+        {
+        case 0:
+            return Quaternion(d, a, b, c);
+        case 1:
+            return Quaternion(a, d, b, c);
+        case 2:
+            return Quaternion(a, b, d, c);
+        default:
+            return Quaternion(a, b, c, d);
+        }
+    }
+
+    FORCE_INLINE void WriteFloat3(byte* data, const CompressedAnimationData::TrackFormat format, const Float3& value, const Float3& min, const Float3& extent)
+    {
+        if (format == CompressedAnimationData::TrackFormat::Quantized)
+        {
+            uint16* v = (uint16*)data;
+            for (int32 i = 0; i < 3; i++)
+                v[i] = extent.Raw[i] > ZeroTolerance ? (uint16)Math::Clamp(Math::RoundToInt((value.Raw[i] - min.Raw[i]) / extent.Raw[i] * MAX_uint16), 0, (int32)MAX_uint16) : 0;
+        }
+        else
+        {
+            Platform::MemoryCopy(data, &value, sizeof(Float3));
+        }
+    }
+
+    FORCE_INLINE void WriteQuaternion(byte* data, Quaternion value)
+    {
+        // Smallest-three encoding (drop the largest component and reconstruct it from the unit length)
+        value.Normalize();
+        int32 largest = 0;
+        for (int32 i = 1; i < 4; i++)
+        {
+            if (Math::Abs(value.Raw[i]) > Math::Abs(value.Raw[largest]))
+                largest = i;
+        }
+        if (value.Raw[largest] < 0.0f)
+            value *= -1.0f;
+        const float range = Math::Sqrt(0.5f);
+        uint16* v = (uint16*)data;
+        for (int32 i = 0, j = 0; i < 4; i++)
+        {
+            if (i == largest)
+                continue;
+            const float normalized = Math::Saturate((value.Raw[i] + range) / (2.0f * range));
+            v[j++] = (uint16)Math::RoundToInt(normalized * 0x7fff);
+        }
+        v[0] |= (uint16)((largest & 1) << 15);
+        v[1] |= (uint16)((largest >> 1) << 15);
+    }
+}
+
+CompressedAnimationData::Sampler CompressedAnimationData::GetSampler(float time) const
+{
+    const float t = Math::Clamp(time, 0.0f, (float)(FramesCount - 1));
+    const int32 frame = Math::Min((int32)t, FramesCount - 1);
+    Sampler sampler;
+    sampler.A = Data.Get() + frame * FrameSize;
+    sampler.B = Data.Get() + Math::Min(frame + 1, FramesCount - 1) * FrameSize;
+    sampler.Alpha = t - (float)frame;
+    return sampler;
+}
+
+void CompressedAnimationData::Evaluate(const Sampler& sampler, int32 channelIndex, Transform* result) const
+{
+    const Channel& channel = Channels.Get()[channelIndex];
+    switch (channel.PositionFormat)
+    {
+    case TrackFormat::Constant:
+        result->Translation = channel.PositionMin;
+        break;
+    case TrackFormat::Quantized:
+    case TrackFormat::Raw:
+    {
+        const Float3 a = ReadFloat3(sampler.A + channel.PositionOffset, channel.PositionFormat, channel.PositionMin, channel.PositionExtent);
+        const Float3 b = ReadFloat3(sampler.B + channel.PositionOffset, channel.PositionFormat, channel.PositionMin, channel.PositionExtent);
+        result->Translation = Float3::Lerp(a, b, sampler.Alpha);
+        break;
+    }
+    default:
+        break;
+    }
+    switch (channel.RotationFormat)
+    {
+    case TrackFormat::Constant:
+        result->Orientation = channel.Rotation;
+        break;
+    case TrackFormat::Quantized:
+        Quaternion::Lerp(ReadQuaternion(sampler.A + channel.RotationOffset), ReadQuaternion(sampler.B + channel.RotationOffset), sampler.Alpha, result->Orientation);
+        break;
+    default:
+        break;
+    }
+    switch (channel.ScaleFormat)
+    {
+    case TrackFormat::Constant:
+        result->Scale = channel.ScaleMin;
+        break;
+    case TrackFormat::Quantized:
+    case TrackFormat::Raw:
+    {
+        const Float3 a = ReadFloat3(sampler.A + channel.ScaleOffset, channel.ScaleFormat, channel.ScaleMin, channel.ScaleExtent);
+        const Float3 b = ReadFloat3(sampler.B + channel.ScaleOffset, channel.ScaleFormat, channel.ScaleMin, channel.ScaleExtent);
+        result->Scale = Float3::Lerp(a, b, sampler.Alpha);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+#if USE_EDITOR
+
+bool CompressedAnimationData::Compress(const AnimationData& data, float positionError, float scaleError)
+{
+    Dispose();
+    if (data.Duration < ZeroTolerance || data.Channels.IsEmpty())
+        return true;
+    const int32 framesCount = (int32)Math::Ceil(data.Duration) + 1;
+
+    // Sample channels once per frame and pick the track formats
+    Array<Float3> positions, scales;
+    Array<Quaternion> rotations;
+    positions.Resize(data.Channels.Count() * framesCount);
+    rotations.Resize(data.Channels.Count() * framesCount);
+    scales.Resize(data.Channels.Count() * framesCount);
+    Channels.Resize(data.Channels.Count());
+    int32 frameSize = 0;
+    for (int32 channelIndex = 0; channelIndex < data.Channels.Count(); channelIndex++)
+    {
+        const NodeAnimationData& src = data.Channels[channelIndex];
+        Channel& dst = Channels[channelIndex];
+        Platform::MemoryClear(&dst, sizeof(Channel));
+        Float3* channelPositions = positions.Get() + channelIndex * framesCount;
+        Quaternion* channelRotations = rotations.Get() + channelIndex * framesCount;
+        Float3* channelScales = scales.Get() + channelIndex * framesCount;
+        for (int32 frame = 0; frame < framesCount; frame++)
+        {
+            src.Position.Evaluate(channelPositions[frame], (float)frame, false);
+            src.Rotation.Evaluate(channelRotations[frame], (float)frame, false);
+            src.Scale.Evaluate(channelScales[frame], (float)frame, false);
+        }
+
+        // Position and scale are range-reduced (or raw if the quantization error is too big)
+#define SETUP_TRACK(curve, values, format, min, extent, offset, error) \
+        if (src.curve.GetKeyframes().HasItems()) \
+        { \
+            Float3 valueMin = values[0], valueMax = values[0]; \
+            for (int32 frame = 1; frame < framesCount; frame++) \
+            { \
+                valueMin = Float3::Min(valueMin, values[frame]); \
+                valueMax = Float3::Max(valueMax, values[frame]); \
+            } \
+            const Float3 valueExtent = valueMax - valueMin; \
+            if (valueExtent.MaxValue() <= error) \
+            { \
+                dst.format = TrackFormat::Constant; \
+                dst.min = (valueMin + valueMax) * 0.5f; \
+            } \
+            else \
+            { \
+                dst.format = valueExtent.MaxValue() / MAX_uint16 * 0.5f <= error ? TrackFormat::Quantized : TrackFormat::Raw; \
+                dst.min = valueMin; \
+                dst.extent = valueExtent; \
+                dst.offset = frameSize; \
+                frameSize += dst.format == TrackFormat::Quantized ? sizeof(uint16) * 3 : sizeof(Float3); \
+            } \
+        }
+        SETUP_TRACK(Position, channelPositions, PositionFormat, PositionMin, PositionExtent, PositionOffset, positionError);
+        SETUP_TRACK(Scale, channelScales, ScaleFormat, ScaleMin, ScaleExtent, ScaleOffset, scaleError);
+#undef SETUP_TRACK
+
+        // Rotation uses smallest-three encoding
+        if (src.Rotation.GetKeyframes().HasItems())
+        {
+            bool isConstant = true;
+            for (int32 frame = 1; frame < framesCount && isConstant; frame++)
+                isConstant = Math::Abs(Quaternion::Dot(channelRotations[0], channelRotations[frame])) >= 1.0f - ZeroTolerance;
+            if (isConstant)
+            {
+                dst.RotationFormat = TrackFormat::Constant;
+                dst.Rotation = channelRotations[0];
+            }
+            else
+            {
+                dst.RotationFormat = TrackFormat::Quantized;
+                dst.RotationOffset = frameSize;
+                frameSize += sizeof(uint16) * 3;
+            }
+        }
+    }
+
+    // Pack the frames
+    FramesCount = framesCount;
+    FrameSize = Math::AlignUp(Math::Max(frameSize, 1), (int32)sizeof(uint16));
+    Data.Resize(FramesCount * FrameSize);
+    Data.SetAll(0);
+    for (int32 frame = 0; frame < framesCount; frame++)
+    {
+        byte* frameData = Data.Get() + frame * FrameSize;
+        for (int32 channelIndex = 0; channelIndex < Channels.Count(); channelIndex++)
+        {
+            const Channel& channel = Channels[channelIndex];
+            const int32 index = channelIndex * framesCount + frame;
+            if (channel.PositionFormat == TrackFormat::Quantized || channel.PositionFormat == TrackFormat::Raw)
+                WriteFloat3(frameData + channel.PositionOffset, channel.PositionFormat, positions[index], channel.PositionMin, channel.PositionExtent);
+            if (channel.RotationFormat == TrackFormat::Quantized)
+                WriteQuaternion(frameData + channel.RotationOffset, rotations[index]);
+            if (channel.ScaleFormat == TrackFormat::Quantized || channel.ScaleFormat == TrackFormat::Raw)
+                WriteFloat3(frameData + channel.ScaleOffset, channel.ScaleFormat, scales[index], channel.ScaleMin, channel.ScaleExtent);
+        }
+    }
+    return false;
+}
+
+#endif
+
+void CompressedAnimationData::Save(WriteStream& stream) const
+{
+    stream.WriteInt32(COMPRESSED_ANIMATION_VERSION);
+    stream.WriteInt32(FramesCount);
+    stream.WriteInt32(FrameSize);
+    stream.WriteInt32(Channels.Count());
+    stream.WriteBytes(Channels.Get(), Channels.Count() * sizeof(Channel));
+    stream.WriteBytes(Data.Get(), Data.Count());
+}
+
+bool CompressedAnimationData::Load(ReadStream& stream)
+{
+    Dispose();
+    int32 version, channelsCount;
+    stream.ReadInt32(&version);
+    if (version != COMPRESSED_ANIMATION_VERSION)
+        return true;
+    stream.ReadInt32(&FramesCount);
+    stream.ReadInt32(&FrameSize);
+    stream.ReadInt32(&channelsCount);
+    if (FramesCount <= 0 || FrameSize <= 0 || channelsCount < 0)
+    {
+        Dispose();
+        return true;
+    }
+    Channels.Resize(channelsCount, false);
+    stream.ReadBytes(Channels.Get(), channelsCount * sizeof(Channel));
+    Data.Resize(FramesCount * FrameSize, false);
+    stream.ReadBytes(Data.Get(), Data.Count());
+    return false;
+}
+
+uint64 CompressedAnimationData::GetMemoryUsage() const
+{
+    return Channels.Capacity() * sizeof(Channel) + Data.Capacity();
+}
+
+void CompressedAnimationData::Dispose()
+{
+    FramesCount = 0;
+    FrameSize = 0;
+    Channels.Resize(0);
+    Data.Resize(0);
+}
 
 void NodeAnimationData::Evaluate(float time, Transform* result, bool loop) const
 {
@@ -44,6 +336,7 @@ uint64 AnimationData::GetMemoryUsage() const
     uint64 result = (Name.Length() + RootNodeName.Length()) * sizeof(Char) + Channels.Capacity() * sizeof(NodeAnimationData);
     for (const auto& e : Channels)
         result += e.GetMemoryUsage();
+    result += Compressed.GetMemoryUsage();
     return result;
 }
 
@@ -63,6 +356,14 @@ NodeAnimationData* AnimationData::GetChannel(const StringView& name)
     return nullptr;
 }
 
+void AnimationData::EvaluateChannel(int32 channelIndex, float time, Transform* result) const
+{
+    if (Compressed.IsValid())
+        Compressed.Evaluate(Compressed.GetSampler(time), channelIndex, result);
+    else
+        Channels[channelIndex].Evaluate(time, result, false);
+}
+
 void AnimationData::Swap(AnimationData& other)
 {
     ::Swap(Duration, other.Duration);
@@ -71,6 +372,10 @@ void AnimationData::Swap(AnimationData& other)
     ::Swap(Name, other.Name);
     ::Swap(RootNodeName, other.RootNodeName);
     Channels.Swap(other.Channels);
+    ::Swap(Compressed.FramesCount, other.Compressed.FramesCount);
+    ::Swap(Compressed.FrameSize, other.Compressed.FrameSize);
+    Compressed.Channels.Swap(other.Compressed.Channels);
+    Compressed.Data.Swap(other.Compressed.Data);
 }
 
 void AnimationData::Dispose()
@@ -81,4 +386,5 @@ void AnimationData::Dispose()
     RootNodeName.Clear();
     RootMotionFlags = AnimationRootMotionFlags::None;
     Channels.Resize(0);
+    Compressed.Dispose();
 }
@@ -6,6 +6,10 @@
 #include "Engine/Core/Math/Transform.h"
 #include "Engine/Animations/Curve.h"
 
+class ReadStream;
+class WriteStream;
+struct AnimationData;
+
 /// <summary>
 /// Single node animation data container.
 /// </summary>
@@ -89,6 +93,123 @@ API_ENUM(Attributes="Flags") enum class AnimationRootMotionFlags : byte
 
 DECLARE_ENUM_OPERATORS(AnimationRootMotionFlags);
 
+/// <summary>
+/// Compressed skeleton nodes animation data. Channels are uniformly sampled (once per animation frame) and quantized: rotations use smallest-three encoding (48 bits), positions and scales are range-reduced into 16 bits per component (or kept raw if quantization would exceed the error threshold) and constant tracks are not stored per-frame. Frames are stored one after another with all animated channels packed together, so sampling the pose reads just two contiguous memory blocks.
+/// </summary>
+struct FLAXENGINE_API CompressedAnimationData
+{
+    /// <summary>
+    /// The channel track data format.
+    /// </summary>
+    enum class TrackFormat : byte
+    {
+        // No animation data (track is not evaluated).
+        None = 0,
+        // Single value for the whole animation.
+        Constant = 1,
+        // Per-frame value quantized into 16 bits per component (range-reduced for translation and scale, smallest-three for rotation).
+        Quantized = 2,
+        // Per-frame 32-bit float value.
+        Raw = 3,
+    };
+
+    /// <summary>
+    /// The single node animation channel description.
+    /// </summary>
+    struct Channel
+    {
+        TrackFormat PositionFormat;
+        TrackFormat RotationFormat;
+        TrackFormat ScaleFormat;
+        // The offsets of the per-frame tracks data within a frame (in bytes).
+        int32 PositionOffset, RotationOffset, ScaleOffset;
+        // The constant value or the range of the quantized values.
+        Float3 PositionMin, PositionExtent;
+        Quaternion Rotation;
+        Float3 ScaleMin, ScaleExtent;
+    };
+
+    /// <summary>
+    /// The animation sampling location (two neighbour frames and the blend weight between them) shared by all channels.
+    /// </summary>
+    struct Sampler
+    {
+        const byte* A;
+        const byte* B;
+        float Alpha;
+    };
+
+    /// <summary>
+    /// The amount of the sampled frames.
+    /// </summary>
+    int32 FramesCount = 0;
+
+    /// <summary>
+    /// The size of the single frame data (in bytes).
+    /// </summary>
+    int32 FrameSize = 0;
+
+    /// <summary>
+    /// The animation channels (matches AnimationData.Channels).
+    /// </summary>
+    Array<Channel> Channels;
+
+    /// <summary>
+    /// The per-frame data.
+    /// </summary>
+    Array<byte> Data;
+
+public:
+    /// <summary>
+    /// Returns true if the compressed data is valid.
+    /// </summary>
+    FORCE_INLINE bool IsValid() const
+    {
+        return FramesCount != 0;
+    }
+
+    /// <summary>
+    /// Gets the sampler for the specified time position (in frames). Time is clamped to the animation range.
+    /// </summary>
+    /// <param name="time">The time to sample the animation at.</param>
+    /// <returns>The sampler to use for the channels evaluation.</returns>
+    Sampler GetSampler(float time) const;
+
+    /// <summary>
+    /// Evaluates the animation channel transformation (only for the tracks with the animation data).
+    /// </summary>
+    /// <param name="sampler">The animation sampler.</param>
+    /// <param name="channelIndex">The channel index.</param>
+    /// <param name="result">The evaluated node transformation.</param>
+    void Evaluate(const Sampler& sampler, int32 channelIndex, Transform* result) const;
+
+#if USE_EDITOR
+    /// <summary>
+    /// Compresses the animation data.
+    /// </summary>
+    /// <param name="data">The source animation data.</param>
+    /// <param name="positionError">The maximum error of the position quantization (in units).</param>
+    /// <param name="scaleError">The maximum error of the scale quantization.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    bool Compress(const AnimationData& data, float positionError = 0.01f, float scaleError = 0.0001f);
+#endif
+
+    /// <summary>
+    /// Serializes the data to the stream.
+    /// </summary>
+    void Save(WriteStream& stream) const;
+
+    /// <summary>
+    /// Deserializes the data from the stream.
+    /// </summary>
+    /// <returns>True if failed, otherwise false.</returns>
+    bool Load(ReadStream& stream);
+
+    uint64 GetMemoryUsage() const;
+
+    void Dispose();
+};
+
 /// <summary>
 /// Skeleton nodes animation data container. Includes metadata about animation sampling, duration and node animations curves.
 /// </summary>
@@ -124,6 +245,11 @@ struct AnimationData
     /// </summary>
     Array<NodeAnimationData> Channels;
 
+    /// <summary>
+    /// The compressed animation channels data. Used instead of the channel curves (which are released) if the animation was compressed when cooking the game.
+    /// </summary>
+    CompressedAnimationData Compressed;
+
 public:
     /// <summary>
     /// Gets the length of the animation (in seconds).
@@ -145,6 +271,14 @@ struct AnimationData
 
     NodeAnimationData* GetChannel(const StringView& name);
 
+    /// <summary>
+    /// Evaluates the animation channel transformation at the specified time (only for the tracks with non-empty data). Uses compressed data if available. Time is clamped to the animation range.
+    /// </summary>
+    /// <param name="channelIndex">The channel index.</param>
+    /// <param name="time">The time to evaluate the channel at (in frames).</param>
+    /// <param name="result">The evaluated node transformation.</param>
+    void EvaluateChannel(int32 channelIndex, float time, Transform* result) const;
+
     /// <summary>
     /// Swaps the contents of object with the other object without copy operation. Performs fast internal data exchange.
     /// </summary>
@@ -2,8 +2,11 @@
 
 #include "Animations.h"
 #include "AnimEvent.h"
+#include "BakedSkinnedAnimation.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Level/Actors/AnimatedModel.h"
 #include "Engine/Engine/Time.h"
 #include "Engine/Engine/EngineService.h"
@@ -13,6 +16,7 @@ class AnimationsService : public EngineService
 {
 public:
     Array<AnimatedModel*> UpdateList;
+    Array<AnimatedModel*> DeferredList;
 
     AnimationsService()
         : EngineService(TEXT("Animations"), -10)
@@ -28,6 +32,11 @@ class AnimationsSystem : public TaskGraphSystem
 public:
     float DeltaTime, UnscaledDeltaTime, Time, UnscaledTime;
 
+    static bool SortByUpdatePriority(AnimatedModel* const& a, AnimatedModel* const& b)
+    {
+        return a->_updatePriority > b->_updatePriority;
+    }
+
     void Job(int32 index);
     void Execute(TaskGraph* graph) override;
     void PostExecute(TaskGraph* graph) override;
@@ -51,6 +60,7 @@ namespace
 
 AnimationsService AnimationManagerInstance;
 TaskGraphSystem* Animations::System = nullptr;
+int32 Animations::UpdatesBudget = 0;
 #if USE_EDITOR
 Delegate<Animations::DebugFlowInfo> Animations::DebugFlow;
 #endif
@@ -75,12 +85,15 @@ bool AnimationsService::Init()
 void AnimationsService::Dispose()
 {
     UpdateList.Resize(0);
+    DeferredList.Resize(0);
+    BakedSkinnedAnimation::ClearCache();
     SAFE_DELETE(Animations::System);
 }
 
 void AnimationsSystem::Job(int32 index)
 {
-    PROFILE_CPU_NAMED("Animations.Job");
+    PROFILE_CPU_CAT_NAMED(ANIMATIONS, "Animations.Job");
+    PROFILE_MEM(Animations);
     auto animatedModel = AnimationManagerInstance.UpdateList[index];
     if (CanUpdateModel(animatedModel))
     {
@@ -108,15 +121,36 @@ void AnimationsSystem::Job(int32 index)
         graph->GraphExecutor.Update(animatedModel->GraphInstance, dt);
 
         // Update gameplay
-        animatedModel->OnAnimationUpdated_Async();
+        animatedModel->OnAnimationUpdated_Async(animatedModel->_updateRate > 1 && animatedModel->InterpolateUpdates);
     }
 }
 
 void AnimationsSystem::Execute(TaskGraph* graph)
 {
-    if (AnimationManagerInstance.UpdateList.Count() == 0)
+    auto& updateList = AnimationManagerInstance.UpdateList;
+    auto& deferredList = AnimationManagerInstance.DeferredList;
+    if (updateList.Count() == 0 && deferredList.Count() == 0)
         return;
 
+    // Limit the amount of models to update (deferred models go first, then the most visible ones)
+    const int32 budget = Animations::UpdatesBudget;
+    if (budget > 0 && updateList.Count() + deferredList.Count() > budget)
+    {
+        Sorting::QuickSort(updateList.Get(), updateList.Count(), &SortByUpdatePriority);
+        deferredList.Add(updateList);
+        updateList.Clear();
+        updateList.Add(deferredList.Get(), budget);
+        const int32 deferredCount = deferredList.Count() - budget;
+        for (int32 i = 0; i < deferredCount; i++)
+            deferredList[i] = deferredList[budget + i];
+        deferredList.Resize(deferredCount);
+    }
+    else if (deferredList.Count() != 0)
+    {
+        updateList.Add(deferredList);
+        deferredList.Clear();
+    }
+
     // Setup data for async update
     const auto& tickData = Time::Update;
     DeltaTime = tickData.DeltaTime.GetTotalSeconds();
@@ -139,11 +173,13 @@ void AnimationsSystem::Execute(TaskGraph* graph)
 void AnimationsSystem::PostExecute(TaskGraph* graph)
 {
     PROFILE_CPU_NAMED("Animations.PostExecute");
+    PROFILE_MEM(Animations);
 
     // Update gameplay
     for (int32 index = 0; index < AnimationManagerInstance.UpdateList.Count(); index++)
     {
         auto animatedModel = AnimationManagerInstance.UpdateList[index];
+        animatedModel->_isQueuedForUpdate = false;
         if (CanUpdateModel(animatedModel))
         {
             animatedModel->GraphInstance.InvokeAnimEvents();
@@ -157,10 +193,15 @@ void AnimationsSystem::PostExecute(TaskGraph* graph)
 
 void Animations::AddToUpdate(AnimatedModel* obj)
 {
+    if (obj->_isQueuedForUpdate)
+        return;
+    obj->_isQueuedForUpdate = true;
     AnimationManagerInstance.UpdateList.Add(obj);
 }
 
 void Animations::RemoveFromUpdate(AnimatedModel* obj)
 {
+    obj->_isQueuedForUpdate = false;
     AnimationManagerInstance.UpdateList.Remove(obj);
+    AnimationManagerInstance.DeferredList.Remove(obj);
 }
@@ -21,6 +21,11 @@ API_CLASS(Static) class FLAXENGINE_API Animations
     /// </summary>
     API_FIELD(ReadOnly) static TaskGraphSystem* System;
 
+    /// <summary>
+    /// The maximum amount of animated models to evaluate during a single update. Models over the budget are deferred to the next update (and processed before the other ones), the remaining ones are evaluated from the most visible on the screen. Use 0 for unlimited.
+    /// </summary>
+    API_FIELD() static int32 UpdatesBudget;
+
 #if USE_EDITOR
     // Data wrapper for the debug flow information.
     API_STRUCT(NoDefault) struct DebugFlowInfo
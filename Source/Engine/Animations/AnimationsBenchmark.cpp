@@ -0,0 +1,391 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#if !BUILD_RELEASE
+
+#include "Graph/AnimGraph.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Matrix3x4.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Content/Assets/Animation.h"
+#include "Engine/Content/Assets/AnimationGraph.h"
+#include "Engine/Content/Assets/SkinnedModel.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Engine/EngineService.h"
+#include "Engine/Engine/CommandLine.h"
+#include "Engine/Engine/Globals.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/Models/Config.h"
+#include "Engine/Graphics/Models/SkinnedMeshDrawData.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Platform/FileSystem.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Serialization/JsonWriters.h"
+#include "Engine/Serialization/MemoryReadStream.h"
+#include "Engine/Serialization/MemoryWriteStream.h"
+#include "Engine/Threading/Threading.h"
+
+// Headless animation benchmark that evaluates a reproducible synthetic crowd (run with: -headless -null -animbenchmark "count=256,bones=64,depth=2,frames=300").
+class AnimationsBenchmarkService : public EngineService
+{
+public:
+    struct Config
+    {
+        int32 Count = 256;
+        int32 Bones = 64;
+        int32 Depth = 2;
+        int32 Frames = 300;
+        int32 Keyframes = 30;
+        float FramesPerSecond = 60.0f;
+        String Output = TEXT("AnimBenchmark.json");
+    };
+
+    struct Stage
+    {
+        const char* Name;
+        double Total = 0.0;
+        double Min = MAX_double;
+        double Max = 0.0;
+
+        void Add(double time)
+        {
+            Total += time;
+            Min = Math::Min(Min, time);
+            Max = Math::Max(Max, time);
+        }
+    };
+
+    AnimationsBenchmarkService()
+        : EngineService(TEXT("Animations Benchmark"), 10000)
+    {
+    }
+
+    bool ParseConfig(const String& text, Config& config);
+    bool Run(const Config& config);
+    void Update() override;
+};
+
+AnimationsBenchmarkService AnimationsBenchmarkServiceInstance;
+
+namespace
+{
+    SkinnedModel* CreateModel(int32 bonesCount)
+    {
+        auto model = Content::CreateVirtualAsset<SkinnedModel>();
+        if (!model)
+            return nullptr;
+        int32 meshesCount = 1;
+        Array<SkeletonNode> nodes;
+        nodes.Resize(bonesCount);
+        for (int32 i = 0; i < bonesCount; i++)
+        {
+            // Binary tree hierarchy to get a deep skeleton with many branches
+            auto& node = nodes[i];
+            node.ParentIndex = i == 0 ? -1 : (i - 1) / 2;
+            node.LocalTransform = Transform(Vector3(0, i == 0 ? 0.0f : 10.0f, 0));
+            node.Name = String::Format(TEXT("Bone{0}"), i);
+        }
+        if (model->SetupLODs(ToSpan(&meshesCount, 1)) || model->SetupSkeleton(nodes))
+        {
+            model->DeleteObject();
+            return nullptr;
+        }
+        return model;
+    }
+
+    Animation* CreateAnimation(SkinnedModel* model, int32 keyframesCount)
+    {
+        auto anim = Content::CreateVirtualAsset<Animation>();
+        if (!anim)
+            return nullptr;
+        const auto& nodes = model->Skeleton.Nodes;
+        AnimationData& data = anim->Data;
+        data.FramesPerSecond = 30.0;
+        data.Duration = keyframesCount;
+        data.RootNodeName = nodes[0].Name;
+        data.Channels.Resize(nodes.Count());
+        for (int32 i = 0; i < nodes.Count(); i++)
+        {
+            auto& channel = data.Channels[i];
+            channel.NodeName = nodes[i].Name;
+            auto keyframes = channel.Rotation.Resize(keyframesCount + 1);
+            for (int32 k = 0; k <= keyframesCount; k++)
+            {
+                const float angle = Math::Sin((float)k / (float)keyframesCount * TWO_PI + (float)i) * 30.0f;
+                keyframes[k] = LinearCurveKeyframe<Quaternion>((float)k, Quaternion::Euler(angle, angle * 0.5f, 0));
+            }
+        }
+        return anim;
+    }
+
+    AnimationGraph* CreateGraph(SkinnedModel* model, Animation* anim, int32 depth)
+    {
+        auto graphAsset = Content::CreateVirtualAsset<AnimationGraph>();
+        if (!graphAsset)
+            return nullptr;
+
+        // Build a chain of Blend nodes that mixes the same animation sampled at different offsets
+        MemoryWriteStream writeStream(1024);
+        {
+            AnimGraph graph(nullptr);
+            const int32 animsCount = depth + 1;
+            graph.Nodes.Resize(1 + animsCount + depth);
+            auto& rootNode = graph.Nodes[0];
+            rootNode.Type = GRAPH_NODE_MAKE_TYPE(9, 1);
+            rootNode.ID = 1;
+            rootNode.Values.Resize(1);
+            rootNode.Values[0] = (int32)RootMotionExtraction::NoExtraction;
+            rootNode.Boxes.Resize(1);
+            rootNode.Boxes[0] = AnimGraphBox(&rootNode, 0, VariantType::Void);
+            for (int32 i = 0; i < animsCount; i++)
+            {
+                auto& animNode = graph.Nodes[1 + i];
+                animNode.Type = GRAPH_NODE_MAKE_TYPE(9, 2);
+                animNode.ID = 100 + i;
+                animNode.Values.Resize(4);
+                animNode.Values[0] = anim->GetID();
+                animNode.Values[1] = 1.0f;
+                animNode.Values[2] = true;
+                animNode.Values[3] = anim->GetLength() * (float)i / (float)animsCount;
+                animNode.Boxes.Resize(8);
+                for (int32 j = 0; j < 8; j++)
+                    animNode.Boxes[j] = AnimGraphBox(&animNode, j, VariantType::Void);
+            }
+            AnimGraphBox* prev = &graph.Nodes[1].Boxes[0];
+            for (int32 i = 0; i < depth; i++)
+            {
+                auto& blendNode = graph.Nodes[1 + animsCount + i];
+                blendNode.Type = GRAPH_NODE_MAKE_TYPE(9, 9);
+                blendNode.ID = 200 + i;
+                blendNode.Values.Resize(1);
+                blendNode.Values[0] = 1.0f / (float)(i + 2);
+                blendNode.Boxes.Resize(4);
+                blendNode.Boxes[0] = AnimGraphBox(&blendNode, 0, VariantType::Void);
+                blendNode.Boxes[1] = AnimGraphBox(&blendNode, 1, VariantType::Void);
+                blendNode.Boxes[2] = AnimGraphBox(&blendNode, 2, VariantType::Void);
+                blendNode.Boxes[3] = AnimGraphBox(&blendNode, 3, VariantType::Float);
+                AnimGraphBox* animBox = &graph.Nodes[2 + i].Boxes[0];
+                blendNode.Boxes[1].Connections.Add(prev);
+                prev->Connections.Add(&blendNode.Boxes[1]);
+                blendNode.Boxes[2].Connections.Add(animBox);
+                animBox->Connections.Add(&blendNode.Boxes[2]);
+                prev = &blendNode.Boxes[0];
+            }
+            rootNode.Boxes[0].Connections.Add(prev);
+            prev->Connections.Add(&rootNode.Boxes[0]);
+            graph.Parameters.Resize(1);
+            AnimGraphParameter& baseModelParam = graph.Parameters[0];
+            baseModelParam.Identifier = ANIM_GRAPH_PARAM_BASE_MODEL_ID;
+            baseModelParam.Type = VariantType::Asset;
+            baseModelParam.IsPublic = false;
+            baseModelParam.Value = model->GetID();
+            if (graph.Save(&writeStream, USE_EDITOR))
+                return nullptr;
+        }
+
+        ScopeLock lock(graphAsset->Locker);
+        MemoryReadStream readStream(writeStream.GetHandle(), writeStream.GetPosition());
+        if (graphAsset->Graph.Load(&readStream, USE_EDITOR))
+        {
+            graphAsset->DeleteObject();
+            return nullptr;
+        }
+        return graphAsset;
+    }
+}
+
+bool AnimationsBenchmarkService::ParseConfig(const String& text, Config& config)
+{
+    Array<String> entries;
+    text.Split(',', entries);
+    for (const String& entry : entries)
+    {
+        const int32 separator = entry.Find('=');
+        if (separator == -1)
+            continue;
+        const String key = entry.Left(separator).TrimTrailing();
+        const String value = entry.Substring(separator + 1).TrimTrailing();
+        bool failed = false;
+        if (key == TEXT("count"))
+            failed = StringUtils::Parse(value.Get(), &config.Count);
+        else if (key == TEXT("bones"))
+            failed = StringUtils::Parse(value.Get(), &config.Bones);
+        else if (key == TEXT("depth"))
+            failed = StringUtils::Parse(value.Get(), &config.Depth);
+        else if (key == TEXT("frames"))
+            failed = StringUtils::Parse(value.Get(), &config.Frames);
+        else if (key == TEXT("keys"))
+            failed = StringUtils::Parse(value.Get(), &config.Keyframes);
+        else if (key == TEXT("fps"))
+            failed = StringUtils::Parse(value.Get(), &config.FramesPerSecond);
+        else if (key == TEXT("output"))
+            config.Output = value;
+        else
+            LOG(Warning, "Unknown animation benchmark option '{0}'.", key);
+        if (failed)
+        {
+            LOG(Error, "Invalid animation benchmark option value '{0}'.", entry);
+            return true;
+        }
+    }
+    if (config.Count <= 0 || config.Bones <= 0 || config.Bones > MAX_BONES_PER_MODEL || config.Depth < 0 || config.Frames <= 0 || config.Keyframes <= 0 || config.FramesPerSecond <= ZeroTolerance)
+    {
+        LOG(Error, "Invalid animation benchmark configuration.");
+        return true;
+    }
+    return false;
+}
+
+bool AnimationsBenchmarkService::Run(const Config& config)
+{
+    if (!GPUDevice::Instance)
+        return true;
+    LOG(Info, "Running animation benchmark: {0} models, {1} bones, blend depth {2}, {3} frames", config.Count, config.Bones, config.Depth, config.Frames);
+
+    // Setup scene
+    SkinnedModel* model = CreateModel(config.Bones);
+    Animation* anim = model ? CreateAnimation(model, config.Keyframes) : nullptr;
+    AnimationGraph* graph = anim ? CreateGraph(model, anim, config.Depth) : nullptr;
+    if (!graph)
+    {
+        LOG(Error, "Failed to setup the animation benchmark assets.");
+        return true;
+    }
+    const auto& skeleton = model->Skeleton;
+    const int32 bonesCount = skeleton.Bones.Count();
+    Array<AnimGraphInstanceData> instances;
+    Array<SkinnedMeshDrawData*> skinning;
+    instances.Resize(config.Count);
+    skinning.Resize(config.Count);
+    for (int32 i = 0; i < config.Count; i++)
+    {
+        auto& instance = instances[i];
+        instance.Object = nullptr;
+        instance.Parameters.Resize(graph->Graph.Parameters.Count());
+        for (int32 j = 0; j < instance.Parameters.Count(); j++)
+        {
+            const auto& src = graph->Graph.Parameters[j];
+            auto& dst = instance.Parameters[j];
+            dst.Type = src.Type;
+            dst.Identifier = src.Identifier;
+            dst.Name = src.Name;
+            dst.IsPublic = src.IsPublic;
+            dst.Value = src.Value;
+        }
+        skinning[i] = New<SkinnedMeshDrawData>();
+        skinning[i]->Setup(bonesCount);
+    }
+
+    // Warm up once so the first frame doesn't include the state allocations
+    const float dt = 1.0f / config.FramesPerSecond;
+    for (auto& instance : instances)
+        graph->GraphExecutor.Update(instance, dt);
+
+    // Run frames
+    Stage stages[] = { { "Graph" }, { "Skinning" }, { "Upload" }, { "Frame" } };
+    GPUContext* context = GPUDevice::Instance->GetMainContext();
+    for (int32 frame = 0; frame < config.Frames; frame++)
+    {
+        PROFILE_CPU_NAMED("AnimationsBenchmark.Frame");
+        const double frameStart = Platform::GetTimeSeconds();
+        double time = frameStart;
+        {
+            PROFILE_CPU_NAMED("AnimationsBenchmark.Graph");
+            for (auto& instance : instances)
+                graph->GraphExecutor.Update(instance, dt);
+        }
+        stages[0].Add(Platform::GetTimeSeconds() - time);
+        time = Platform::GetTimeSeconds();
+        {
+            PROFILE_CPU_NAMED("AnimationsBenchmark.Skinning");
+            for (int32 i = 0; i < config.Count; i++)
+            {
+                const auto& instance = instances[i];
+                auto& data = *skinning[i];
+                Matrix3x4* output = (Matrix3x4*)data.Data.Get();
+                for (int32 boneIndex = 0; boneIndex < bonesCount; boneIndex++)
+                {
+                    const SkeletonBone& bone = skeleton.Bones[boneIndex];
+                    Matrix matrix;
+                    Matrix::Multiply(bone.OffsetMatrix, instance.NodesPose.Get()[bone.NodeIndex], matrix);
+                    output[boneIndex].SetMatrixTranspose(matrix);
+                }
+                data.OnDataChanged(true);
+            }
+        }
+        stages[1].Add(Platform::GetTimeSeconds() - time);
+        time = Platform::GetTimeSeconds();
+        {
+            PROFILE_CPU_NAMED("AnimationsBenchmark.Upload");
+            for (auto data : skinning)
+            {
+                if (data->IsReady() && data->IsDirty())
+                {
+                    context->UpdateBuffer(data->BoneMatrices, data->Data.Get(), data->Data.Count());
+                    data->OnFlush();
+                }
+            }
+        }
+        stages[2].Add(Platform::GetTimeSeconds() - time);
+        stages[3].Add(Platform::GetTimeSeconds() - frameStart);
+    }
+
+    // Write results
+    rapidjson_flax::StringBuffer buffer;
+    PrettyJsonWriter writer(buffer);
+    writer.StartObject();
+    writer.JKEY("Count");
+    writer.Int(config.Count);
+    writer.JKEY("Bones");
+    writer.Int(bonesCount);
+    writer.JKEY("Depth");
+    writer.Int(config.Depth);
+    writer.JKEY("Frames");
+    writer.Int(config.Frames);
+    writer.JKEY("Stages");
+    writer.StartObject();
+    for (const Stage& stage : stages)
+    {
+        writer.Key(stage.Name, StringUtils::Length(stage.Name));
+        writer.StartObject();
+        writer.JKEY("TotalMs");
+        writer.Double(stage.Total * 1000.0);
+        writer.JKEY("AvgMs");
+        writer.Double(stage.Total * 1000.0 / config.Frames);
+        writer.JKEY("MinMs");
+        writer.Double(stage.Min * 1000.0);
+        writer.JKEY("MaxMs");
+        writer.Double(stage.Max * 1000.0);
+        writer.EndObject();
+        LOG(Info, "{0}: avg {1} ms, min {2} ms, max {3} ms", String(stage.Name), stage.Total * 1000.0 / config.Frames, stage.Min * 1000.0, stage.Max * 1000.0);
+    }
+    writer.EndObject();
+    writer.EndObject();
+    const String path = FileSystem::IsRelative(config.Output) ? Globals::ProjectFolder / config.Output : config.Output;
+    const bool failed = File::WriteAllBytes(path, (byte*)buffer.GetString(), (int32)buffer.GetSize());
+    if (failed)
+        LOG(Error, "Failed to save animation benchmark results to {0}", path);
+    else
+        LOG(Info, "Animation benchmark results saved to {0}", path);
+
+    // Cleanup
+    instances.Clear();
+    skinning.ClearDelete();
+    graph->DeleteObject();
+    anim->DeleteObject();
+    model->DeleteObject();
+    return failed;
+}
+
+void AnimationsBenchmarkService::Update()
+{
+    if (!CommandLine::Options.AnimBenchmark.HasValue())
+        return;
+    Config config;
+    const String text = CommandLine::Options.AnimBenchmark.GetValue();
+    CommandLine::Options.AnimBenchmark.Reset();
+    const bool failed = ParseConfig(text, config) || Run(config);
+    Engine::RequestExit(failed ? -1 : 0);
+}
+
+#endif
@@ -0,0 +1,150 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "BakedSkinnedAnimation.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Types/Pair.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Content/Assets/Animation.h"
+#include "Engine/Content/Assets/SkinnedModel.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/Threading.h"
+
+namespace
+{
+    CriticalSection CacheLocker;
+    Dictionary<Pair<SkinnedModel*, Animation*>, BakedSkinnedAnimation*> Cache;
+
+    void OnAssetUnloaded(Asset* asset)
+    {
+        ScopeLock lock(CacheLocker);
+        for (auto it = Cache.Begin(); it.IsNotEnd(); ++it)
+        {
+            if ((Asset*)it->Key.First == asset || (Asset*)it->Key.Second == asset)
+            {
+                Delete(it->Value);
+                Cache.Remove(it);
+            }
+        }
+    }
+}
+
+BakedSkinnedAnimation::~BakedSkinnedAnimation()
+{
+    Frames.ClearDelete();
+}
+
+SkinnedMeshDrawData* BakedSkinnedAnimation::GetFrame(float time) const
+{
+    if (Frames.IsEmpty())
+        return nullptr;
+    const int32 frame = (int32)Math::Mod(time * FramesPerSecond, (float)Frames.Count());
+    return Frames[Math::Clamp(frame, 0, Frames.Count() - 1)];
+}
+
+bool BakedSkinnedAnimation::Bake(SkinnedModel* model, Animation* animation, float framesPerSecond)
+{
+    if (!model || !animation || !model->IsLoaded() || !animation->IsLoaded() || framesPerSecond <= ZeroTolerance)
+        return true;
+    PROFILE_CPU();
+    ScopeLock lock(model->Locker);
+    const SkeletonData& skeleton = model->Skeleton;
+    const AnimationData& data = animation->Data;
+    const int32 nodesCount = skeleton.Nodes.Count();
+    const int32 bonesCount = skeleton.Bones.Count();
+    if (bonesCount == 0 || data.Duration <= ZeroTolerance || data.FramesPerSecond <= ZeroTolerance)
+        return true;
+    Frames.ClearDelete();
+    Model = model;
+    Anim = animation;
+    FramesPerSecond = framesPerSecond;
+    Length = data.GetLength();
+
+    // Map animation channels to the skeleton nodes
+    Array<int32> channelToNode;
+    channelToNode.Resize(data.Channels.Count());
+    for (int32 i = 0; i < data.Channels.Count(); i++)
+        channelToNode[i] = skeleton.FindNode(data.Channels[i].NodeName);
+
+    // Sample frames
+    const int32 framesCount = Math::Max(Math::CeilToInt(Length * framesPerSecond), 1);
+    Array<Transform> localPose;
+    Array<Matrix> modelPose, bones;
+    localPose.Resize(nodesCount);
+    modelPose.Resize(nodesCount);
+    bones.Resize(bonesCount);
+    Frames.Resize(framesCount);
+    for (int32 frameIndex = 0; frameIndex < framesCount; frameIndex++)
+    {
+        const float time = (float)frameIndex / framesPerSecond * (float)data.FramesPerSecond;
+        for (int32 nodeIndex = 0; nodeIndex < nodesCount; nodeIndex++)
+            localPose[nodeIndex] = skeleton.Nodes[nodeIndex].LocalTransform;
+        for (int32 i = 0; i < channelToNode.Count(); i++)
+        {
+            if (channelToNode[i] != -1)
+                data.EvaluateChannel(i, time, &localPose[channelToNode[i]]);
+        }
+        for (int32 nodeIndex = 0; nodeIndex < nodesCount; nodeIndex++)
+        {
+            Matrix localTransform;
+            localPose[nodeIndex].GetWorld(localTransform);
+            const int32 parentIndex = skeleton.Nodes[nodeIndex].ParentIndex;
+            if (parentIndex != -1)
+                modelPose[nodeIndex] = localTransform * modelPose[parentIndex];
+            else
+                modelPose[nodeIndex] = localTransform;
+        }
+        for (int32 boneIndex = 0; boneIndex < bonesCount; boneIndex++)
+        {
+            const SkeletonBone& bone = skeleton.Bones[boneIndex];
+            bones[boneIndex] = bone.OffsetMatrix * modelPose[bone.NodeIndex];
+        }
+        auto frame = New<SkinnedMeshDrawData>();
+        frame->Setup(bonesCount);
+        frame->SetData(bones.Get(), true);
+        Frames[frameIndex] = frame;
+    }
+
+    return false;
+}
+
+BakedSkinnedAnimation* BakedSkinnedAnimation::Get(SkinnedModel* model, Animation* animation, bool bake)
+{
+    if (!model || !animation)
+        return nullptr;
+    const auto key = ToPair(model, animation);
+    ScopeLock lock(CacheLocker);
+    BakedSkinnedAnimation* result = nullptr;
+    if (Cache.TryGet(key, result) || !bake)
+        return result;
+    if (!model->IsLoaded() || !animation->IsLoaded())
+        return nullptr;
+    result = New<BakedSkinnedAnimation>();
+    if (result->Bake(model, animation))
+    {
+        LOG(Warning, "Failed to bake animation {0} for {1}", animation->ToString(), model->ToString());
+        Delete(result);
+        result = nullptr;
+    }
+    else
+    {
+        model->OnUnloaded.Bind<OnAssetUnloaded>();
+        animation->OnUnloaded.Bind<OnAssetUnloaded>();
+    }
+    Cache.Add(key, result);
+    return result;
+}
+
+void BakedSkinnedAnimation::ClearCache()
+{
+    ScopeLock lock(CacheLocker);
+    for (auto& e : Cache)
+    {
+        if (e.Value)
+        {
+            e.Key.First->OnUnloaded.Unbind<OnAssetUnloaded>();
+            e.Key.Second->OnUnloaded.Unbind<OnAssetUnloaded>();
+        }
+        Delete(e.Value);
+    }
+    Cache.Clear();
+}
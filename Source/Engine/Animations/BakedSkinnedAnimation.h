@@ -0,0 +1,80 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Graphics/Models/SkinnedMeshDrawData.h"
+
+class SkinnedModel;
+class Animation;
+
+/// <summary>
+/// The skinned model animation baked into the bone matrices buffers (one per frame) uploaded to the GPU. Used to play the animation without evaluating it on the CPU (eg. for distant characters). All instances that use the same frame share its skinning data so the compute skinning handles it once per frame and the skinned meshes are drawn with instancing.
+/// </summary>
+class FLAXENGINE_API BakedSkinnedAnimation
+{
+public:
+    /// <summary>
+    /// The default baking rate (frames per second).
+    /// </summary>
+    static constexpr float DefaultFramesPerSecond = 15.0f;
+
+    /// <summary>
+    /// The skinned model used for baking.
+    /// </summary>
+    SkinnedModel* Model = nullptr;
+
+    /// <summary>
+    /// The baked animation.
+    /// </summary>
+    Animation* Anim = nullptr;
+
+    /// <summary>
+    /// The baking rate (frames per second).
+    /// </summary>
+    float FramesPerSecond = DefaultFramesPerSecond;
+
+    /// <summary>
+    /// The animation length (in seconds).
+    /// </summary>
+    float Length = 0.0f;
+
+    /// <summary>
+    /// The baked frames.
+    /// </summary>
+    Array<SkinnedMeshDrawData*> Frames;
+
+public:
+    ~BakedSkinnedAnimation();
+
+public:
+    /// <summary>
+    /// Gets the skinning data of the frame at the given playback time (animation is looped).
+    /// </summary>
+    /// <param name="time">The playback time (in seconds).</param>
+    /// <returns>The frame skinning data or null if not baked.</returns>
+    SkinnedMeshDrawData* GetFrame(float time) const;
+
+    /// <summary>
+    /// Bakes the animation for the skinned model skeleton. Samples the animation at the fixed rate and calculates the final bone matrices for each frame.
+    /// </summary>
+    /// <param name="model">The skinned model.</param>
+    /// <param name="animation">The animation to bake.</param>
+    /// <param name="framesPerSecond">The baking rate (frames per second).</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    bool Bake(SkinnedModel* model, Animation* animation, float framesPerSecond = DefaultFramesPerSecond);
+
+    /// <summary>
+    /// Gets the baked animation from the cache (shared by all users of the skinned model and animation pair). Bakes the animation on first use.
+    /// </summary>
+    /// <param name="model">The skinned model.</param>
+    /// <param name="animation">The animation.</param>
+    /// <param name="bake">True if bake the animation if it's missing in cache, otherwise returns null in that case.</param>
+    /// <returns>The baked animation or null if failed or assets are not loaded.</returns>
+    static BakedSkinnedAnimation* Get(SkinnedModel* model, Animation* animation, bool bake = true);
+
+    /// <summary>
+    /// Releases all cached baked animations.
+    /// </summary>
+    static void ClearCache();
+};
@@ -59,6 +59,7 @@ void AnimGraphBase::Clear()
     // Release memory
     SubGraphs.ClearDelete();
     StateTransitions.Resize(0);
+    Programs.ClearDelete();
 
     // Base
     GraphType::Clear();
@@ -0,0 +1,436 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "AnimGraph.h"
+#include "Engine/Core/Collections/Dictionary.h"
+
+namespace
+{
+    enum class ProgramValueType
+    {
+        Invalid,
+        Float,
+        Bool,
+    };
+
+    struct ProgramCompiler
+    {
+        typedef AnimGraphProgram::OpCode OpCode;
+
+        AnimGraph* Graph;
+        AnimGraphProgram* Program;
+        Dictionary<AnimGraphBox*, Pair<int32, ProgramValueType>> Registers;
+
+        int32 Emit(OpCode op, int32 a = 0, int32 b = 0, float constant = 0.0f)
+        {
+            if (Program->Instructions.Count() >= ANIM_GRAPH_PROGRAM_MAX_INSTRUCTIONS)
+                return -1;
+            auto& e = Program->Instructions.AddOne();
+            e.Op = op;
+            e.A = (byte)a;
+            e.B = (byte)b;
+            e.Constant = constant;
+            return Program->Instructions.Count() - 1;
+        }
+
+        int32 CompileConstant(const Variant& value, ProgramValueType& type)
+        {
+            switch (value.Type.Type)
+            {
+            case VariantType::Float:
+                type = ProgramValueType::Float;
+                return Emit(OpCode::Constant, 0, 0, value.AsFloat);
+            case VariantType::Bool:
+                type = ProgramValueType::Bool;
+                return Emit(OpCode::Constant, 0, 0, value.AsBool ? 1.0f : 0.0f);
+            default:
+                return -1;
+            }
+        }
+
+        // Matches VisjectExecutor::tryGetValue behavior (connected box value, or the node value at the given index, or the default value)
+        int32 CompileInput(AnimGraphBox* box, int32 defaultValueIndex, const Variant& defaultValue, ProgramValueType& type)
+        {
+            if (box == nullptr)
+                return -1;
+            if (box->HasConnection())
+                return CompileBox((AnimGraphBox*)box->FirstConnection(), type);
+            const auto node = box->GetParent<AnimGraphNode>();
+            if (defaultValueIndex >= 0 && node->Values.Count() > defaultValueIndex)
+                return CompileConstant(node->Values[defaultValueIndex], type);
+            return CompileConstant(defaultValue, type);
+        }
+
+        int32 CompileBox(AnimGraphBox* box, ProgramValueType& type)
+        {
+            // Reuse already compiled values (eg. parameter used by many nodes)
+            Pair<int32, ProgramValueType> cached;
+            if (Registers.TryGet(box, cached))
+            {
+                type = cached.Second;
+                return cached.First;
+            }
+            type = ProgramValueType::Invalid;
+            const auto node = box->GetParent<AnimGraphNode>();
+            int32 result = -1;
+            switch (node->GroupID)
+            {
+            // Constants
+            case 2:
+                switch (node->TypeID)
+                {
+                case 1:
+                case 2:
+                case 3:
+                case 12:
+                case 15:
+                    result = CompileConstant(node->Values[0], type);
+                    break;
+                // PI
+                case 10:
+                    type = ProgramValueType::Float;
+                    result = Emit(OpCode::Constant, 0, 0, PI);
+                    break;
+                }
+                break;
+            // Math
+            case 3:
+            {
+                OpCode op;
+                int32 inputs = 1;
+                switch (node->TypeID)
+                {
+#define CASE(id, opCode, inputsCount) case id: op = OpCode::opCode; inputs = inputsCount; break
+                CASE(1, Add, 2);
+                CASE(2, Subtract, 2);
+                CASE(3, Multiply, 2);
+                CASE(5, Divide, 2);
+                CASE(21, Max, 2);
+                CASE(22, Min, 2);
+                CASE(23, Pow, 2);
+                CASE(40, Mod, 2);
+                CASE(41, Atan2, 2);
+                CASE(7, Abs, 1);
+                CASE(8, Ceil, 1);
+                CASE(9, Cos, 1);
+                CASE(10, Floor, 1);
+                CASE(13, Round, 1);
+                CASE(14, Saturate, 1);
+                CASE(15, Sin, 1);
+                CASE(16, Sqrt, 1);
+                CASE(17, Tan, 1);
+                CASE(27, Negate, 1);
+                CASE(28, OneMinus, 1);
+                CASE(33, Asin, 1);
+                CASE(34, Acos, 1);
+                CASE(35, Atan, 1);
+                CASE(38, Trunc, 1);
+                CASE(39, Frac, 1);
+                CASE(43, Degrees, 1);
+                CASE(44, Radians, 1);
+#undef CASE
+                default:
+                    return -1;
+                }
+                ProgramValueType typeA, typeB = ProgramValueType::Float;
+                int32 a, b = 0;
+                if (inputs == 2)
+                {
+                    a = CompileInput(node->GetBox(0), 0, Variant::Zero, typeA);
+                    b = CompileInput(node->GetBox(1), 1, Variant::Zero, typeB);
+                }
+                else
+                {
+                    // Unconnected input uses integer zero
+                    const auto input = node->GetBox(0);
+                    a = input && input->HasConnection() ? CompileBox((AnimGraphBox*)input->FirstConnection(), typeA) : -1;
+                }
+                if (a == -1 || b == -1 || typeA != ProgramValueType::Float || typeB != ProgramValueType::Float)
+                    return -1;
+                type = ProgramValueType::Float;
+                result = Emit(op, a, b);
+                break;
+            }
+            // Parameters
+            case 6:
+                if (node->TypeID == 1 && box->ID == 0)
+                {
+                    int32 paramIndex;
+                    const auto param = Graph->GetParameter((Guid)node->Values[0], paramIndex);
+                    if (param && (param->Type.Type == VariantType::Float || param->Type.Type == VariantType::Bool))
+                    {
+                        type = param->Type.Type == VariantType::Float ? ProgramValueType::Float : ProgramValueType::Bool;
+                        result = Emit(OpCode::Parameter);
+                        if (result != -1)
+                            Program->Instructions[result].ParameterIndex = paramIndex;
+                    }
+                }
+                break;
+            // Boolean
+            case 10:
+            {
+                ProgramValueType typeA, typeB = ProgramValueType::Bool;
+                int32 a, b = 0;
+                OpCode op;
+                switch (node->TypeID)
+                {
+                case 1:
+                    op = OpCode::Not;
+                    a = CompileInput(node->GetBox(0), -1, Variant::False, typeA);
+                    break;
+                case 2:
+                case 3:
+                case 4:
+                case 5:
+                case 6:
+                    op = (OpCode)((int32)OpCode::And + node->TypeID - 2);
+                    if (node->Values.Count() < 2)
+                        return -1;
+                    a = CompileInput(node->GetBox(0), 0, Variant::False, typeA);
+                    b = CompileInput(node->GetBox(1), 1, Variant::False, typeB);
+                    break;
+                default:
+                    return -1;
+                }
+                if (a == -1 || b == -1 || typeA != ProgramValueType::Bool || typeB != ProgramValueType::Bool)
+                    return -1;
+                type = ProgramValueType::Bool;
+                result = Emit(op, a, b);
+                break;
+            }
+            // Comparisons
+            case 12:
+            {
+                if (node->TypeID < 1 || node->TypeID > 6 || node->Values.Count() < 2)
+                    return -1;
+                ProgramValueType typeA, typeB;
+                const int32 a = CompileInput(node->GetBox(0), 0, Variant::Zero, typeA);
+                const int32 b = CompileInput(node->GetBox(1), 1, Variant::Zero, typeB);
+
+                // Bool registers store 0 or 1 so casting the second value to the type of the first one is a no-op (except float to bool)
+                if (a == -1 || b == -1 || typeA == ProgramValueType::Invalid || typeB == ProgramValueType::Invalid || (typeA == ProgramValueType::Bool && typeB != ProgramValueType::Bool))
+                    return -1;
+                type = ProgramValueType::Bool;
+                result = Emit((OpCode)((int32)OpCode::Equal + node->TypeID - 1), a, b);
+                break;
+            }
+            default:
+                break;
+            }
+            if (result != -1)
+                Registers.Add(box, ToPair(result, type));
+            return result;
+        }
+    };
+
+    bool IsValueNode(const AnimGraphNode* node)
+    {
+        switch (node->GroupID)
+        {
+        case 2:
+        case 3:
+        case 10:
+        case 12:
+            return true;
+        case 6:
+            return node->TypeID == 1;
+        default:
+            return false;
+        }
+    }
+}
+
+void AnimGraphBase::CompilePrograms()
+{
+    for (AnimSubGraph* subGraph : SubGraphs)
+        subGraph->CompilePrograms();
+
+    // Compile the values used by the nodes outputs
+    ProgramCompiler compiler;
+    compiler.Graph = _graph;
+    for (Node& node : Nodes)
+    {
+        if (!IsValueNode(&node))
+            continue;
+        for (Box& box : node.Boxes)
+        {
+            if (!box.HasConnection() || box.Program || box.Type.Type == VariantType::Void)
+                continue;
+            auto program = New<AnimGraphProgram>();
+            compiler.Program = program;
+            compiler.Registers.Clear();
+            ProgramValueType type;
+            if (compiler.CompileBox(&box, type) != -1 && program->Instructions.HasItems())
+            {
+                program->IsBool = type == ProgramValueType::Bool;
+                box.Program = program;
+                Programs.Add(program);
+            }
+            else
+            {
+                Delete(program);
+            }
+        }
+    }
+}
+
+VisjectExecutor::Value AnimGraphExecutor::ExecuteProgram(const AnimGraphProgram& program)
+{
+    typedef AnimGraphProgram::OpCode OpCode;
+    float registers[ANIM_GRAPH_PROGRAM_MAX_INSTRUCTIONS];
+    const auto& parameters = Context.Get()->Data->Parameters;
+    const auto* instructions = program.Instructions.Get();
+    const int32 count = program.Instructions.Count();
+    for (int32 i = 0; i < count; i++)
+    {
+        const auto& e = instructions[i];
+#define A registers[e.A]
+#define B registers[e.B]
+        float r;
+        switch (e.Op)
+        {
+        case OpCode::Constant:
+            r = e.Constant;
+            break;
+        case OpCode::Parameter:
+        {
+            const Variant& value = parameters[e.ParameterIndex].Value;
+            if (value.Type.Type == VariantType::Float)
+                r = value.AsFloat;
+            else if (value.Type.Type == VariantType::Bool)
+                r = value.AsBool ? 1.0f : 0.0f;
+            else
+                r = (float)value;
+            break;
+        }
+        case OpCode::Add:
+            r = A + B;
+            break;
+        case OpCode::Subtract:
+            r = A - B;
+            break;
+        case OpCode::Multiply:
+            r = A * B;
+            break;
+        case OpCode::Divide:
+            r = A / B;
+            break;
+        case OpCode::Max:
+            r = Math::Max(A, B);
+            break;
+        case OpCode::Min:
+            r = Math::Min(A, B);
+            break;
+        case OpCode::Pow:
+            r = Math::Pow(A, B);
+            break;
+        case OpCode::Mod:
+            r = Math::Mod(A, B);
+            break;
+        case OpCode::Atan2:
+            r = Math::Atan2(A, B);
+            break;
+        case OpCode::Abs:
+            r = Math::Abs(A);
+            break;
+        case OpCode::Ceil:
+            r = Math::Ceil(A);
+            break;
+        case OpCode::Cos:
+            r = Math::Cos(A);
+            break;
+        case OpCode::Floor:
+            r = Math::Floor(A);
+            break;
+        case OpCode::Round:
+            r = Math::Round(A);
+            break;
+        case OpCode::Saturate:
+            r = Math::Saturate(A);
+            break;
+        case OpCode::Sin:
+            r = Math::Sin(A);
+            break;
+        case OpCode::Sqrt:
+            r = Math::Sqrt(A);
+            break;
+        case OpCode::Tan:
+            r = Math::Tan(A);
+            break;
+        case OpCode::Negate:
+            r = -A;
+            break;
+        case OpCode::OneMinus:
+            r = 1.0f - A;
+            break;
+        case OpCode::Asin:
+            r = Math::Asin(A);
+            break;
+        case OpCode::Acos:
+            r = Math::Acos(A);
+            break;
+        case OpCode::Atan:
+            r = Math::Atan(A);
+            break;
+        case OpCode::Trunc:
+            r = Math::Trunc(A);
+            break;
+        case OpCode::Frac:
+        {
+            float tmp;
+            r = Math::ModF(A, &tmp);
+            break;
+        }
+        case OpCode::Degrees:
+            r = A * RadiansToDegrees;
+            break;
+        case OpCode::Radians:
+            r = A * DegreesToRadians;
+            break;
+        case OpCode::Not:
+            r = A != 0.0f ? 0.0f : 1.0f;
+            break;
+        case OpCode::And:
+            r = A != 0.0f && B != 0.0f ? 1.0f : 0.0f;
+            break;
+        case OpCode::Or:
+            r = A != 0.0f || B != 0.0f ? 1.0f : 0.0f;
+            break;
+        case OpCode::Xor:
+            r = (A != 0.0f) != (B != 0.0f) ? 1.0f : 0.0f;
+            break;
+        case OpCode::Nor:
+            r = A != 0.0f || B != 0.0f ? 0.0f : 1.0f;
+            break;
+        case OpCode::Nand:
+            r = A != 0.0f && B != 0.0f ? 0.0f : 1.0f;
+            break;
+        // Comparisons match Variant operators
+        case OpCode::Equal:
+            r = Math::NearEqual(A, B) ? 1.0f : 0.0f;
+            break;
+        case OpCode::NotEqual:
+            r = Math::NearEqual(A, B) ? 0.0f : 1.0f;
+            break;
+        case OpCode::Greater:
+            r = !Math::NearEqual(A, B) && !(A < B) ? 1.0f : 0.0f;
+            break;
+        case OpCode::Less:
+            r = A < B ? 1.0f : 0.0f;
+            break;
+        case OpCode::LessEqual:
+            r = !Math::NearEqual(A, B) && !(A < B) ? 0.0f : 1.0f;
+            break;
+        case OpCode::GreaterEqual:
+            r = A < B ? 0.0f : 1.0f;
+            break;
+        default:
+            r = 0.0f;
+            break;
+        }
+#undef A
+#undef B
+        registers[i] = r;
+    }
+    const float result = registers[count - 1];
+    return program.IsBool ? Value(result != 0.0f) : Value(result);
+}
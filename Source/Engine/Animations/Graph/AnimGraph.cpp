@@ -105,7 +105,7 @@ AnimGraphInstanceData::OutgoingEvent AnimGraphInstanceData::ActiveEvent::End(Ani
 AnimGraphImpulse* AnimGraphNode::GetNodes(AnimGraphExecutor* executor)
 {
     auto& context = *AnimGraphExecutor::Context.Get();
-    const int32 count = executor->_skeletonNodesCount;
+    const int32 count = context.PoseNodesCount;
     if (context.PoseCacheSize == context.PoseCache.Count())
         context.PoseCache.AddOne();
     auto& nodes = context.PoseCache[context.PoseCacheSize++];
@@ -140,6 +140,9 @@ bool AnimGraph::Load(ReadStream* stream, bool loadMeta)
         {
             LOG(Warning, "Missing Base Model asset for the Animation Graph. Animation won't be played.");
         }
+
+        // Compile value expressions (eg. blend alphas and transition rules) into flat programs
+        CompilePrograms();
     }
 
     // Register for scripts reloading events (only if using any custom nodes)
@@ -250,9 +253,30 @@ void AnimGraphExecutor::Update(AnimGraphInstanceData& data, float dt)
         context.EmptyNodes.RootMotion = Transform::Identity;
         context.EmptyNodes.Position = 0.0f;
         context.EmptyNodes.Length = 0.0f;
-        context.EmptyNodes.Nodes.Resize(_skeletonNodesCount, false);
-        for (int32 i = 0; i < _skeletonNodesCount; i++)
+        context.PoseNodesCount = data.RootMotionOnly ? Math::Clamp(data.RootMotionOnlyNodesCount, 1, _skeletonNodesCount) : _skeletonNodesCount;
+        context.EmptyNodes.Nodes.Resize(context.PoseNodesCount, false);
+        for (int32 i = 0; i < context.PoseNodesCount; i++)
             context.EmptyNodes.Nodes[i] = skeleton.Nodes[i].LocalTransform;
+
+        // Init nodes LOD (skip the nodes that are close to the hierarchy leaves)
+        context.SkippedNodes.Clear();
+        if (data.NodesLOD > 0 && _skeletonNodesCount > 1 && !data.RootMotionOnly)
+        {
+            // Calculate the height of each node (distance to the deepest leaf node), parents always come first
+            Array<int32, InlinedAllocation<256>> heights;
+            heights.Resize(_skeletonNodesCount, false);
+            heights.SetAll(0);
+            for (int32 i = _skeletonNodesCount - 1; i > 0; i--)
+            {
+                const int32 parentIndex = skeleton.Nodes[i].ParentIndex;
+                if (parentIndex >= 0)
+                    heights[parentIndex] = Math::Max(heights[parentIndex], heights[i] + 1);
+            }
+            context.SkippedNodes.Resize(_skeletonNodesCount, false);
+            context.SkippedNodes[0] = false;
+            for (int32 i = 1; i < _skeletonNodesCount; i++)
+                context.SkippedNodes[i] = heights[i] < data.NodesLOD;
+        }
     }
 
     // Update the animation graph and gather skeleton nodes transformations in nodes local space
@@ -303,6 +327,14 @@ void AnimGraphExecutor::Update(AnimGraphInstanceData& data, float dt)
         }
     }
 #endif
+    if (data.RootMotionOnly)
+    {
+        // Skip the pose processing in reduced evaluation
+        data.RootMotion = animResult->RootMotion;
+        context.Data->InvokeAnimEvents();
+        context.Data = nullptr;
+        return;
+    }
     SkeletonData* animResultSkeleton = &skeleton;
 
     // Retarget animation when using output pose from other skeleton
@@ -388,7 +420,7 @@ AnimGraphImpulse* AnimGraphExecutor::GetEmptyNodes()
 void AnimGraphExecutor::InitNodes(AnimGraphImpulse* nodes) const
 {
     const auto& emptyNodes = Context.Get()->EmptyNodes;
-    Platform::MemoryCopy(nodes->Nodes.Get(), emptyNodes.Nodes.Get(), sizeof(Transform) * _skeletonNodesCount);
+    Platform::MemoryCopy(nodes->Nodes.Get(), emptyNodes.Nodes.Get(), sizeof(Transform) * nodes->Nodes.Count());
     nodes->RootMotion = emptyNodes.RootMotion;
     nodes->Position = emptyNodes.Position;
     nodes->Length = emptyNodes.Length;
@@ -428,6 +460,15 @@ VisjectExecutor::Value AnimGraphExecutor::eatBox(Node* caller, Box* box)
     }
 #endif
 
+    // Evaluate compiled value expression without walking the nodes (debug flow needs the interpreter to report each node)
+    const AnimGraphProgram* program = ((AnimGraphBox*)box)->Program;
+#if USE_EDITOR
+    if (program && !Animations::DebugFlow.IsBinded())
+#else
+    if (program)
+#endif
+        return ExecuteProgram(*program);
+
     // Add to the calling stack
     context.CallStack.Add(caller);
 
@@ -17,6 +17,7 @@
 #define ANIM_GRAPH_MAX_STATE_TRANSITIONS 64
 #define ANIM_GRAPH_MAX_CALL_STACK 100
 #define ANIM_GRAPH_MAX_EVENTS 64
+#define ANIM_GRAPH_PROGRAM_MAX_INSTRUCTIONS 128
 
 class AnimGraph;
 class AnimSubGraph;
@@ -314,6 +315,21 @@ class FLAXENGINE_API AnimGraphInstanceData
     /// </summary>
     int64 CurrentFrame = 0;
 
+    /// <summary>
+    /// The skeleton nodes Level Of Detail. Nodes closer to the hierarchy leaves than this value (eg. finger tips) are not sampled from the animations and use the bind pose instead. Use 0 to evaluate all nodes.
+    /// </summary>
+    int32 NodesLOD = 0;
+
+    /// <summary>
+    /// If true, the animation update uses the reduced evaluation: state machines, root motion and animation events are processed but the poses contain only the root nodes (other nodes are not sampled nor blended) and the nodes pose is not updated. Can be used for the models that are not visible but still need to move and receive the events.
+    /// </summary>
+    bool RootMotionOnly = false;
+
+    /// <summary>
+    /// The amount of the skeleton nodes evaluated in the reduced evaluation (see RootMotionOnly). Grows to include the root motion nodes of the sampled animations.
+    /// </summary>
+    int32 RootMotionOnlyNodesCount = 1;
+
     /// <summary>
     /// The root node transformation. Cached after the animation update.
     /// </summary>
@@ -426,8 +442,88 @@ struct AnimGraphTransitionData
     float Length;
 };
 
+/// <summary>
+/// The compiled Anim Graph value expression (eg. blend alpha or state transition rule). Pure scalar math and logic sub-graphs are flattened into a linear list of instructions writing to the float registers (one per instruction) which skips the per-node dispatch and Variant values during the graph evaluation.
+/// </summary>
+struct AnimGraphProgram
+{
+    enum class OpCode : byte
+    {
+        Constant,
+        Parameter,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Max,
+        Min,
+        Pow,
+        Mod,
+        Atan2,
+        Abs,
+        Ceil,
+        Cos,
+        Floor,
+        Round,
+        Saturate,
+        Sin,
+        Sqrt,
+        Tan,
+        Negate,
+        OneMinus,
+        Asin,
+        Acos,
+        Atan,
+        Trunc,
+        Frac,
+        Degrees,
+        Radians,
+        Not,
+        And,
+        Or,
+        Xor,
+        Nor,
+        Nand,
+        Equal,
+        NotEqual,
+        Greater,
+        Less,
+        LessEqual,
+        GreaterEqual,
+    };
+
+    struct Instruction
+    {
+        OpCode Op;
+        // The source registers (indices of the previous instructions).
+        byte A, B;
+
+        union
+        {
+            float Constant;
+            int32 ParameterIndex;
+        };
+    };
+
+    /// <summary>
+    /// The instructions to execute in order. The result is the register of the last instruction.
+    /// </summary>
+    Array<Instruction, InlinedAllocation<8>> Instructions;
+
+    /// <summary>
+    /// True if the result is a boolean value, otherwise it's a float.
+    /// </summary>
+    bool IsBool = false;
+};
+
 class AnimGraphBox : public VisjectGraphBox
 {
+public:
+    /// <summary>
+    /// The compiled expression that evaluates the value of this output box (null if not compiled).
+    /// </summary>
+    AnimGraphProgram* Program = nullptr;
+
 public:
     AnimGraphBox()
     {
@@ -647,6 +743,11 @@ class AnimGraphBase : public VisjectGraph<AnimGraphNode, AnimGraphBox, AnimGraph
     /// </summary>
     int32 BucketsCountTotal;
 
+    /// <summary>
+    /// The compiled value expressions used by the graph boxes.
+    /// </summary>
+    Array<AnimGraphProgram*> Programs;
+
 public:
     /// <summary>
     /// Finalizes an instance of the <see cref="AnimGraphBase"/> class.
@@ -654,6 +755,7 @@ class AnimGraphBase : public VisjectGraph<AnimGraphNode, AnimGraphBox, AnimGraph
     ~AnimGraphBase()
     {
         SubGraphs.ClearDelete();
+        Programs.ClearDelete();
     }
 
 public:
@@ -674,6 +776,11 @@ class AnimGraphBase : public VisjectGraph<AnimGraphNode, AnimGraphBox, AnimGraph
     /// <returns>The loaded sub graph or null if there is no surface to load or if loading failed.</returns>
     AnimSubGraph* LoadSubGraph(const void* data, int32 dataLength, const Char* name);
 
+    /// <summary>
+    /// Compiles the pure value expressions (math and logic on the float and bool values, including sub-graphs) into programs executed instead of the nodes.
+    /// </summary>
+    void CompilePrograms();
+
 public:
     // [Graph]
     bool Load(ReadStream* stream, bool loadMeta) override;
@@ -804,6 +911,8 @@ struct AnimGraphContext
     ChunkedArray<AnimGraphImpulse, 256> PoseCache;
     int32 PoseCacheSize;
     Dictionary<VisjectExecutor::Box*, Variant> ValueCache;
+    Array<bool> SkippedNodes; // Nodes to skip from the animations sampling (due to nodes LOD), empty if all nodes are evaluated
+    int32 PoseNodesCount; // Amount of the skeleton nodes in the evaluated poses (less than skeleton nodes count when evaluating only the root motion)
 
     AnimGraphTraceEvent& AddTraceEvent(const AnimGraphNode* node);
 };
@@ -855,7 +964,7 @@ class AnimGraphExecutor : public VisjectExecutor
     FORCE_INLINE void CopyNodes(AnimGraphImpulse* dstNodes, AnimGraphImpulse* srcNodes) const
     {
         // Copy the node transformations
-        Platform::MemoryCopy(dstNodes->Nodes.Get(), srcNodes->Nodes.Get(), sizeof(Transform) * _skeletonNodesCount);
+        Platform::MemoryCopy(dstNodes->Nodes.Get(), srcNodes->Nodes.Get(), sizeof(Transform) * dstNodes->Nodes.Count());
 
         // Copy the animation playback state
         dstNodes->Position = srcNodes->Position;
@@ -875,6 +984,7 @@ class AnimGraphExecutor : public VisjectExecutor
 
 private:
     Value eatBox(Node* caller, Box* box) override;
+    Value ExecuteProgram(const AnimGraphProgram& program);
     Graph* GetCurrentGraph() const override;
 
     void ProcessGroupParameters(Box* box, Node* node, Value& value);
@@ -1,6 +1,7 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
 #include "AnimGraph.h"
+#include "AnimPoseBlending.h"
 #include "Engine/Core/Types/VariantValueCast.h"
 #include "Engine/Content/Assets/Animation.h"
 #include "Engine/Content/Assets/SkeletonMask.h"
@@ -23,10 +24,7 @@ namespace
 
     FORCE_INLINE void NormalizeRotations(AnimGraphImpulse* nodes, RootMotionExtraction rootMotionMode)
     {
-        for (int32 i = 0; i < nodes->Nodes.Count(); i++)
-        {
-            nodes->Nodes[i].Orientation.Normalize();
-        }
+        AnimPoseBlending::NormalizeRotations(nodes->Nodes.Get(), nodes->Nodes.Count());
         if (rootMotionMode != RootMotionExtraction::NoExtraction)
         {
             nodes->RootMotion.Orientation.Normalize();
@@ -280,15 +278,23 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
     SkinnedModel::SkeletonMapping sourceMapping;
     if (retarget)
         sourceMapping = _graph.BaseModel->GetSkeletonMapping(mapping.SourceSkeleton);
+    const bool* skippedNodes = context.SkippedNodes.Count() == nodes->Nodes.Count() ? context.SkippedNodes.Get() : nullptr;
+    const CompressedAnimationData& compressed = anim->Data.Compressed;
+    CompressedAnimationData::Sampler sampler;
+    if (compressed.IsValid())
+        sampler = compressed.GetSampler(animPos);
     for (int32 i = 0; i < nodes->Nodes.Count(); i++)
     {
         const int32 nodeToChannel = mapping.NodesMapping[i];
         Transform& dstNode = nodes->Nodes[i];
         Transform srcNode = emptyNodes->Nodes[i];
-        if (nodeToChannel != -1)
+        if (nodeToChannel != -1 && !(skippedNodes && skippedNodes[i]))
         {
             // Calculate the animated node transformation
-            anim->Data.Channels[nodeToChannel].Evaluate(animPos, &srcNode, false);
+            if (compressed.IsValid())
+                compressed.Evaluate(sampler, nodeToChannel, &srcNode);
+            else
+                anim->Data.Channels[nodeToChannel].Evaluate(animPos, &srcNode, false);
 
             // Optionally retarget animation into the skeleton used by the Anim Graph
             if (retarget)
@@ -323,7 +329,14 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
     }
 
     // Handle root motion
-    if (_rootMotionMode != RootMotionExtraction::NoExtraction && anim->Data.RootMotionFlags != AnimationRootMotionFlags::None)
+    const bool useRootMotion = _rootMotionMode != RootMotionExtraction::NoExtraction && anim->Data.RootMotionFlags != AnimationRootMotionFlags::None;
+    const int32 rootNodeIndex = useRootMotion ? GetRootNodeIndex(anim) : 0;
+    if (rootNodeIndex >= nodes->Nodes.Count())
+    {
+        // Reduced evaluation needs to include the root motion node (and its parents) in the pose
+        context.Data->RootMotionOnlyNodesCount = Math::Max(context.Data->RootMotionOnlyNodesCount, rootNodeIndex + 1);
+    }
+    else if (useRootMotion)
     {
         // Calculate the root motion node transformation
         const bool motionPositionXZ = EnumHasAnyFlags(anim->Data.RootMotionFlags, AnimationRootMotionFlags::RootPositionXZ);
@@ -331,7 +344,6 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
         const bool motionRotation = EnumHasAnyFlags(anim->Data.RootMotionFlags, AnimationRootMotionFlags::RootRotation);
         const Vector3 motionPositionMask(motionPositionXZ ? 1.0f : 0.0f, motionPositionY ? 1.0f : 0.0f, motionPositionXZ ? 1.0f : 0.0f);
         const bool motionPosition = motionPositionXZ | motionPositionY;
-        const int32 rootNodeIndex = GetRootNodeIndex(anim);
         const Transform& refPose = emptyNodes->Nodes[rootNodeIndex];
         Transform& rootNode = nodes->Nodes[rootNodeIndex];
         Transform& dstNode = nodes->RootMotion;
@@ -341,8 +353,7 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
         {
             // Get the root bone transformation
             Transform rootBefore = refPose;
-            const NodeAnimationData& rootChannel = anim->Data.Channels[nodeToChannel];
-            rootChannel.Evaluate(animPrevPos, &rootBefore, false);
+            anim->Data.EvaluateChannel(nodeToChannel, animPrevPos, &rootBefore);
 
             // Check if animation looped
             if (animPos < animPrevPos)
@@ -351,10 +362,10 @@ void AnimGraphExecutor::ProcessAnimation(AnimGraphImpulse* nodes, AnimGraphNode*
                 const float timeToEnd = endPos - animPrevPos;
 
                 Transform rootBegin = refPose;
-                rootChannel.Evaluate(0, &rootBegin, false);
+                anim->Data.EvaluateChannel(nodeToChannel, 0, &rootBegin);
 
                 Transform rootEnd = refPose;
-                rootChannel.Evaluate(endPos, &rootEnd, false);
+                anim->Data.EvaluateChannel(nodeToChannel, endPos, &rootEnd);
 
                 //rootChannel.Evaluate(animPos - timeToEnd, &rootNow, true);
 
@@ -514,10 +525,7 @@ Variant AnimGraphExecutor::Blend(AnimGraphNode* node, const Value& poseA, const
     if (!ANIM_GRAPH_IS_VALID_PTR(poseB))
         nodesB = GetEmptyNodes();
 
-    for (int32 i = 0; i < nodes->Nodes.Count(); i++)
-    {
-        Transform::Lerp(nodesA->Nodes[i], nodesB->Nodes[i], alpha, nodes->Nodes[i]);
-    }
+    AnimPoseBlending::Lerp(nodesA->Nodes.Get(), nodesB->Nodes.Get(), alpha, nodes->Nodes.Get(), nodes->Nodes.Count());
     Transform::Lerp(nodesA->RootMotion, nodesB->RootMotion, alpha, nodes->RootMotion);
     nodes->Position = Math::Lerp(nodesA->Position, nodesB->Position, alpha);
     nodes->Length = Math::Lerp(nodesA->Length, nodesB->Length, alpha);
@@ -1109,10 +1117,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
             if (!ANIM_GRAPH_IS_VALID_PTR(valueB))
                 nodesB = GetEmptyNodes();
 
-            for (int32 i = 0; i < nodes->Nodes.Count(); i++)
-            {
-                Transform::Lerp(nodesA->Nodes[i], nodesB->Nodes[i], alpha, nodes->Nodes[i]);
-            }
+            AnimPoseBlending::Lerp(nodesA->Nodes.Get(), nodesB->Nodes.Get(), alpha, nodes->Nodes.Get(), nodes->Nodes.Count());
             Transform::Lerp(nodesA->RootMotion, nodesB->RootMotion, alpha, nodes->RootMotion);
             value = nodes;
         }
@@ -1149,22 +1154,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
                 const auto basePoseNodes = static_cast<AnimGraphImpulse*>(valueA.AsPointer);
                 const auto blendPoseNodes = static_cast<AnimGraphImpulse*>(valueB.AsPointer);
                 const auto& refrenceNodes = _graph.BaseModel.Get()->GetNodes();
-                Transform t, basePoseTransform, blendPoseTransform, refrenceTransform;
-                for (int32 i = 0; i < nodes->Nodes.Count(); i++)
-                {
-                    basePoseTransform = basePoseNodes->Nodes[i];
-                    blendPoseTransform = blendPoseNodes->Nodes[i];
-                    refrenceTransform = refrenceNodes[i].LocalTransform;
-
-                    // base + (blend - refrence) = transform
-                    t.Translation = basePoseTransform.Translation + (blendPoseTransform.Translation - refrenceTransform.Translation);
-                    auto diff = Quaternion::Invert(refrenceTransform.Orientation) * blendPoseTransform.Orientation;
-                    t.Orientation = basePoseTransform.Orientation * diff;
-                    t.Scale = basePoseTransform.Scale + (blendPoseTransform.Scale - refrenceTransform.Scale);
-
-                    //lerp base and transform
-                    Transform::Lerp(basePoseTransform, t, alpha, nodes->Nodes[i]);
-                }
+                AnimPoseBlending::Additive(basePoseNodes->Nodes.Get(), blendPoseNodes->Nodes.Get(), &refrenceNodes.Get()->LocalTransform, alpha, nodes->Nodes.Get(), nodes->Nodes.Count(), sizeof(SkeletonNode));
                 Transform::Lerp(basePoseNodes->RootMotion, basePoseNodes->RootMotion + blendPoseNodes->RootMotion, alpha, nodes->RootMotion);
                 value = nodes;
             }
@@ -1958,7 +1948,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         transform.Scale = (Float3)tryGetValue(node->GetBox(4), Float3::One);
 
         // Skip if no change will be performed
-        if (nodeIndex < 0 || nodeIndex >= _skeletonNodesCount || transformMode == BoneTransformMode::None || (transformMode == BoneTransformMode::Add && transform.IsIdentity()))
+        if (nodeIndex < 0 || nodeIndex >= context.PoseNodesCount || transformMode == BoneTransformMode::None || (transformMode == BoneTransformMode::Add && transform.IsIdentity()))
         {
             // Pass through the input
             value = Value::Null;
@@ -2027,8 +2017,8 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         const auto copyScale = (bool)node->Values[4];
 
         // Skip if no change will be performed
-        if (srcNodeIndex < 0 || srcNodeIndex >= _skeletonNodesCount ||
-            dstNodeIndex < 0 || dstNodeIndex >= _skeletonNodesCount ||
+        if (srcNodeIndex < 0 || srcNodeIndex >= context.PoseNodesCount ||
+            dstNodeIndex < 0 || dstNodeIndex >= context.PoseNodesCount ||
             !(copyTranslation || copyRotation || copyScale))
         {
             // Pass through the input
@@ -2056,7 +2046,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         // Get input
         const auto nodeIndex = node->Data.TransformNode.NodeIndex;
         const auto input = tryGetValue(node->GetBox(0), Value::Null);
-        if (ANIM_GRAPH_IS_VALID_PTR(input) && nodeIndex >= 0 && nodeIndex < _skeletonNodesCount)
+        if (ANIM_GRAPH_IS_VALID_PTR(input) && nodeIndex >= 0 && nodeIndex < context.PoseNodesCount)
             value = Variant(((AnimGraphImpulse*)input.AsPointer)->GetNodeModelTransformation(_graph.BaseModel->Skeleton, nodeIndex));
         else
             value = Variant(Transform::Identity);
@@ -2069,7 +2059,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         auto input = tryGetValue(node->GetBox(1), Value::Null);
         const auto nodeIndex = node->Data.TransformNode.NodeIndex;
         float weight = (float)tryGetValue(node->GetBox(3), node->Values[1]);
-        if (nodeIndex < 0 || nodeIndex >= _skeletonNodesCount || weight < ANIM_GRAPH_BLEND_THRESHOLD)
+        if (nodeIndex < 0 || nodeIndex >= context.PoseNodesCount || weight < ANIM_GRAPH_BLEND_THRESHOLD)
         {
             // Pass through the input
             value = input;
@@ -2113,7 +2103,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         // Get input
         const auto nodeIndex = node->Data.TransformNode.NodeIndex;
         const auto input = tryGetValue(node->GetBox(0), Value::Null);
-        if (ANIM_GRAPH_IS_VALID_PTR(input) && nodeIndex >= 0 && nodeIndex < _skeletonNodesCount)
+        if (ANIM_GRAPH_IS_VALID_PTR(input) && nodeIndex >= 0 && nodeIndex < context.PoseNodesCount)
             value = Variant(((AnimGraphImpulse*)input.AsPointer)->GetNodeLocalTransformation(_graph.BaseModel->Skeleton, nodeIndex));
         else
             value = Variant(Transform::Identity);
@@ -2126,7 +2116,7 @@ void AnimGraphExecutor::ProcessGroupAnimation(Box* boxBase, Node* nodeBase, Valu
         auto input = tryGetValue(node->GetBox(1), Value::Null);
         const auto nodeIndex = node->Data.TransformNode.NodeIndex;
         float weight = (float)tryGetValue(node->GetBox(4), node->Values[1]);
-        if (nodeIndex < 0 || nodeIndex >= _skeletonNodesCount || weight < ANIM_GRAPH_BLEND_THRESHOLD)
+        if (nodeIndex < 0 || nodeIndex >= context.PoseNodesCount || weight < ANIM_GRAPH_BLEND_THRESHOLD)
         {
             // Pass through the input
             value = input;
@@ -0,0 +1,181 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/SIMD.h"
+#include "Engine/Core/Math/Transform.h"
+
+/// <summary>
+/// Vectorized kernels for the skeleton poses blending used by the Anim Graph executor. Nodes are processed in groups of 4 with their rotations transposed into SoA layout (one SIMD vector per quaternion component) so the rotation math runs for 4 nodes at once.
+/// </summary>
+namespace AnimPoseBlending
+{
+    // Rotations of 4 nodes in SoA layout.
+    struct QuaternionSoA
+    {
+        SimdVector4 X, Y, Z, W;
+
+        FORCE_INLINE static QuaternionSoA Load(const Transform* nodes)
+        {
+            const Quaternion& a = nodes[0].Orientation;
+            const Quaternion& b = nodes[1].Orientation;
+            const Quaternion& c = nodes[2].Orientation;
+            const Quaternion& d = nodes[3].Orientation;
+            return { SIMD::Load(a.X, b.X, c.X, d.X), SIMD::Load(a.Y, b.Y, c.Y, d.Y), SIMD::Load(a.Z, b.Z, c.Z, d.Z), SIMD::Load(a.W, b.W, c.W, d.W) };
+        }
+
+        FORCE_INLINE void Store(Transform* nodes) const
+        {
+            ALIGN_BEGIN(16) float x[4] ALIGN_END(16);
+            ALIGN_BEGIN(16) float y[4] ALIGN_END(16);
+            ALIGN_BEGIN(16) float z[4] ALIGN_END(16);
+            ALIGN_BEGIN(16) float w[4] ALIGN_END(16);
+            SIMD::Store(x, X);
+            SIMD::Store(y, Y);
+            SIMD::Store(z, Z);
+            SIMD::Store(w, W);
+            for (int32 i = 0; i < 4; i++)
+                nodes[i].Orientation = Quaternion(x[i], y[i], z[i], w[i]);
+        }
+
+        FORCE_INLINE SimdVector4 Dot(const QuaternionSoA& other) const
+        {
+            return SIMD::Add(SIMD::Add(SIMD::Mul(X, other.X), SIMD::Mul(Y, other.Y)), SIMD::Add(SIMD::Mul(Z, other.Z), SIMD::Mul(W, other.W)));
+        }
+
+        FORCE_INLINE void Normalize()
+        {
+            const SimdVector4 invLength = SIMD::Div(SIMD::Splat(1.0f), SIMD::Sqrt(Dot(*this)));
+            X = SIMD::Mul(X, invLength);
+            Y = SIMD::Mul(Y, invLength);
+            Z = SIMD::Mul(Z, invLength);
+            W = SIMD::Mul(W, invLength);
+        }
+
+        // Calculates a * b (Quaternion multiplication order).
+        FORCE_INLINE static QuaternionSoA Multiply(const QuaternionSoA& a, const QuaternionSoA& b)
+        {
+            QuaternionSoA r;
+            r.X = SIMD::Add(SIMD::Add(SIMD::Mul(a.X, b.W), SIMD::Mul(b.X, a.W)), SIMD::Sub(SIMD::Mul(a.Y, b.Z), SIMD::Mul(a.Z, b.Y)));
+            r.Y = SIMD::Add(SIMD::Add(SIMD::Mul(a.Y, b.W), SIMD::Mul(b.Y, a.W)), SIMD::Sub(SIMD::Mul(a.Z, b.X), SIMD::Mul(a.X, b.Z)));
+            r.Z = SIMD::Add(SIMD::Add(SIMD::Mul(a.Z, b.W), SIMD::Mul(b.Z, a.W)), SIMD::Sub(SIMD::Mul(a.X, b.Y), SIMD::Mul(a.Y, b.X)));
+            r.W = SIMD::Sub(SIMD::Mul(b.W, a.W), SIMD::Add(SIMD::Add(SIMD::Mul(b.X, a.X), SIMD::Mul(b.Y, a.Y)), SIMD::Mul(b.Z, a.Z)));
+            return r;
+        }
+
+        // Normalized linear interpolation along the shortest path.
+        FORCE_INLINE static QuaternionSoA Nlerp(const QuaternionSoA& a, const QuaternionSoA& b, float alpha)
+        {
+            // Flip the target rotation when it's on the other hemisphere (per-lane sign picked from the dot product)
+            const int32 negative = SIMD::MoveMask(a.Dot(b));
+            const SimdVector4 weightB = SIMD::Load(negative & 1 ? -alpha : alpha, negative & 2 ? -alpha : alpha, negative & 4 ? -alpha : alpha, negative & 8 ? -alpha : alpha);
+            const SimdVector4 weightA = SIMD::Splat(1.0f - alpha);
+            QuaternionSoA r;
+            r.X = SIMD::Add(SIMD::Mul(a.X, weightA), SIMD::Mul(b.X, weightB));
+            r.Y = SIMD::Add(SIMD::Mul(a.Y, weightA), SIMD::Mul(b.Y, weightB));
+            r.Z = SIMD::Add(SIMD::Mul(a.Z, weightA), SIMD::Mul(b.Z, weightB));
+            r.W = SIMD::Add(SIMD::Mul(a.W, weightA), SIMD::Mul(b.W, weightB));
+            r.Normalize();
+            return r;
+        }
+    };
+
+    FORCE_INLINE Quaternion Nlerp(const Quaternion& a, const Quaternion& b, float alpha)
+    {
+        Quaternion result;
+        Quaternion::Lerp(a, b, alpha, result);
+        return result;
+    }
+
+    /// <summary>
+    /// Normalizes the rotations of the nodes.
+    /// </summary>
+    inline void NormalizeRotations(Transform* nodes, int32 count)
+    {
+        int32 i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            QuaternionSoA q = QuaternionSoA::Load(nodes + i);
+            q.Normalize();
+            q.Store(nodes + i);
+        }
+        for (; i < count; i++)
+            nodes[i].Orientation.Normalize();
+    }
+
+    /// <summary>
+    /// Blends the poses (linear interpolation of translation and scale, normalized linear interpolation of rotation).
+    /// </summary>
+    /// <param name="a">The first pose nodes.</param>
+    /// <param name="b">The second pose nodes.</param>
+    /// <param name="alpha">The blend weight (0 for pose A, 1 for pose B).</param>
+    /// <param name="result">The output pose nodes. Can be the same as one of the inputs.</param>
+    /// <param name="count">The amount of nodes.</param>
+    inline void Lerp(const Transform* a, const Transform* b, float alpha, Transform* result, int32 count)
+    {
+        int32 i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const QuaternionSoA rotation = QuaternionSoA::Nlerp(QuaternionSoA::Load(a + i), QuaternionSoA::Load(b + i), alpha);
+            for (int32 j = i; j < i + 4; j++)
+            {
+                Vector3::Lerp(a[j].Translation, b[j].Translation, alpha, result[j].Translation);
+                Float3::Lerp(a[j].Scale, b[j].Scale, alpha, result[j].Scale);
+            }
+            rotation.Store(result + i);
+        }
+        for (; i < count; i++)
+        {
+            Vector3::Lerp(a[i].Translation, b[i].Translation, alpha, result[i].Translation);
+            result[i].Orientation = Nlerp(a[i].Orientation, b[i].Orientation, alpha);
+            Float3::Lerp(a[i].Scale, b[i].Scale, alpha, result[i].Scale);
+        }
+    }
+
+    /// <summary>
+    /// Blends the additive pose (difference between the blend pose and the reference pose) on top of the base pose.
+    /// </summary>
+    /// <param name="base">The base pose nodes.</param>
+    /// <param name="blend">The additive pose nodes.</param>
+    /// <param name="reference">The reference pose nodes (additive pose is relative to it, eg. skeleton bind pose).</param>
+    /// <param name="alpha">The blend weight (0 for base pose only, 1 for the full additive pose).</param>
+    /// <param name="result">The output pose nodes. Can be the same as the base pose.</param>
+    /// <param name="count">The amount of nodes.</param>
+    /// <param name="referenceStride">The stride (in bytes) between the reference pose nodes transformations.</param>
+    inline void Additive(const Transform* base, const Transform* blend, const Transform* reference, float alpha, Transform* result, int32 count, int32 referenceStride = sizeof(Transform))
+    {
+#define GET_REFERENCE(index) (*(const Transform*)((const byte*)reference + (index) * referenceStride))
+        for (int32 i = 0; i < count; i++)
+        {
+            // base + (blend - reference)
+            const Transform& refNode = GET_REFERENCE(i);
+            const Vector3 translation = base[i].Translation + (blend[i].Translation - refNode.Translation);
+            const Float3 scale = base[i].Scale + (blend[i].Scale - refNode.Scale);
+            Vector3::Lerp(base[i].Translation, translation, alpha, result[i].Translation);
+            Float3::Lerp(base[i].Scale, scale, alpha, result[i].Scale);
+        }
+        int32 i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            // Reference rotations are normalized so conjugate is used as an inverse
+            const QuaternionSoA baseRotation = QuaternionSoA::Load(base + i);
+            QuaternionSoA refRotation;
+            {
+                const Quaternion& r0 = GET_REFERENCE(i + 0).Orientation;
+                const Quaternion& r1 = GET_REFERENCE(i + 1).Orientation;
+                const Quaternion& r2 = GET_REFERENCE(i + 2).Orientation;
+                const Quaternion& r3 = GET_REFERENCE(i + 3).Orientation;
+                refRotation = { SIMD::Load(-r0.X, -r1.X, -r2.X, -r3.X), SIMD::Load(-r0.Y, -r1.Y, -r2.Y, -r3.Y), SIMD::Load(-r0.Z, -r1.Z, -r2.Z, -r3.Z), SIMD::Load(r0.W, r1.W, r2.W, r3.W) };
+            }
+            const QuaternionSoA diff = QuaternionSoA::Multiply(refRotation, QuaternionSoA::Load(blend + i));
+            const QuaternionSoA rotation = QuaternionSoA::Multiply(baseRotation, diff);
+            QuaternionSoA::Nlerp(baseRotation, rotation, alpha).Store(result + i);
+        }
+        for (; i < count; i++)
+        {
+            const Quaternion diff = GET_REFERENCE(i).Orientation.Conjugated() * blend[i].Orientation;
+            result[i].Orientation = Nlerp(base[i].Orientation, base[i].Orientation * diff, alpha);
+        }
+#undef GET_REFERENCE
+    }
+}
@@ -1,6 +1,7 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
 #include "InverseKinematics.h"
+#include "Engine/Core/Collections/Array.h"
 
 void InverseKinematics::SolveAimIK(const Transform& node, const Vector3& target, Quaternion& outNodeCorrection)
 {
@@ -110,3 +111,163 @@ void InverseKinematics::SolveTwoBoneIK(Transform& rootNode, Transform& jointNode
 
     targetNode.Translation = resultEndPos;
 }
+
+namespace
+{
+    // Nodes positions of all chains in SoA layout.
+    struct ChainsData
+    {
+        Array<Real, InlinedAllocation<64>> X, Y, Z, Lengths;
+        Array<int32, InlinedAllocation<16>> Offsets;
+
+        void Init(Span<InverseKinematics::Chain> chains)
+        {
+            int32 count = 0;
+            Offsets.Resize(chains.Length() + 1, false);
+            for (int32 chainIndex = 0; chainIndex < chains.Length(); chainIndex++)
+            {
+                Offsets[chainIndex] = count;
+                count += chains[chainIndex].Nodes.Length();
+            }
+            Offsets[chains.Length()] = count;
+            X.Resize(count, false);
+            Y.Resize(count, false);
+            Z.Resize(count, false);
+            Lengths.Resize(count, false);
+            for (int32 chainIndex = 0; chainIndex < chains.Length(); chainIndex++)
+            {
+                const Span<Transform>& nodes = chains[chainIndex].Nodes;
+                const int32 offset = Offsets[chainIndex];
+                for (int32 i = 0; i < nodes.Length(); i++)
+                {
+                    const Vector3& position = nodes[i].Translation;
+                    X[offset + i] = position.X;
+                    Y[offset + i] = position.Y;
+                    Z[offset + i] = position.Z;
+                }
+                for (int32 i = 0; i < nodes.Length() - 1; i++)
+                    Lengths[offset + i] = Vector3::Distance(nodes[i].Translation, nodes[i + 1].Translation);
+                if (nodes.Length() != 0)
+                    Lengths[offset + nodes.Length() - 1] = 0;
+            }
+        }
+
+        FORCE_INLINE Vector3 Get(int32 index) const
+        {
+            return Vector3(X[index], Y[index], Z[index]);
+        }
+
+        FORCE_INLINE void Set(int32 index, const Vector3& position)
+        {
+            X[index] = position.X;
+            Y[index] = position.Y;
+            Z[index] = position.Z;
+        }
+
+        // Moves the node at the fixed distance from the other node (along the direction to it).
+        FORCE_INLINE void Constrain(int32 index, int32 other, Real length)
+        {
+            const Real dx = X[index] - X[other], dy = Y[index] - Y[other], dz = Z[index] - Z[other];
+            const Real distance = Math::Sqrt(dx * dx + dy * dy + dz * dz);
+            const Real scale = distance > ZeroTolerance ? length / distance : 0;
+            X[index] = X[other] + dx * scale;
+            Y[index] = Y[other] + dy * scale;
+            Z[index] = Z[other] + dz * scale;
+        }
+
+        // Applies the solved positions to the chain nodes (rotates the nodes to match the new bone directions).
+        void Apply(Span<InverseKinematics::Chain> chains) const
+        {
+            for (int32 chainIndex = 0; chainIndex < chains.Length(); chainIndex++)
+            {
+                Span<Transform> nodes = chains[chainIndex].Nodes;
+                const int32 offset = Offsets[chainIndex];
+                for (int32 i = 0; i < nodes.Length() - 1; i++)
+                {
+                    const Vector3 oldDir = (nodes[i + 1].Translation - nodes[i].Translation).GetNormalized();
+                    const Vector3 newDir = (Get(offset + i + 1) - Get(offset + i)).GetNormalized();
+                    const Quaternion deltaRotation = Quaternion::FindBetween(oldDir, newDir);
+                    nodes[i].Orientation = deltaRotation * nodes[i].Orientation;
+                }
+                for (int32 i = 1; i < nodes.Length(); i++)
+                    nodes[i].Translation = Get(offset + i);
+            }
+        }
+    };
+}
+
+void InverseKinematics::SolveFABRIK(Span<Chain> chains, float tolerance, int32 maxIterations)
+{
+    ChainsData data;
+    data.Init(chains);
+    const Real toleranceSqr = (Real)tolerance * tolerance;
+    for (int32 chainIndex = 0; chainIndex < chains.Length(); chainIndex++)
+    {
+        const Chain& chain = chains[chainIndex];
+        const int32 start = data.Offsets[chainIndex];
+        const int32 end = data.Offsets[chainIndex + 1] - 1;
+        if (end <= start)
+            continue;
+        const Vector3 root = data.Get(start);
+        Real chainLength = 0;
+        for (int32 i = start; i < end; i++)
+            chainLength += data.Lengths[i];
+
+        // Straighten the chain towards the target if it's out of reach
+        if (Vector3::DistanceSquared(root, chain.Target) >= chainLength * chainLength)
+        {
+            const Vector3 dir = (chain.Target - root).GetNormalized();
+            for (int32 i = start + 1; i <= end; i++)
+                data.Set(i, data.Get(i - 1) + dir * data.Lengths[i - 1]);
+            continue;
+        }
+
+        for (int32 iteration = 0; iteration < maxIterations; iteration++)
+        {
+            if (Vector3::DistanceSquared(data.Get(end), chain.Target) <= toleranceSqr)
+                break;
+
+            // Backward pass (from the target to the root)
+            data.Set(end, chain.Target);
+            for (int32 i = end - 1; i >= start; i--)
+                data.Constrain(i, i + 1, data.Lengths[i]);
+
+            // Forward pass (from the root to the target)
+            data.Set(start, root);
+            for (int32 i = start + 1; i <= end; i++)
+                data.Constrain(i, i - 1, data.Lengths[i - 1]);
+        }
+    }
+    data.Apply(chains);
+}
+
+void InverseKinematics::SolveCCD(Span<Chain> chains, float tolerance, int32 maxIterations)
+{
+    ChainsData data;
+    data.Init(chains);
+    const Real toleranceSqr = (Real)tolerance * tolerance;
+    for (int32 chainIndex = 0; chainIndex < chains.Length(); chainIndex++)
+    {
+        const Chain& chain = chains[chainIndex];
+        const int32 start = data.Offsets[chainIndex];
+        const int32 end = data.Offsets[chainIndex + 1] - 1;
+        for (int32 iteration = 0; iteration < maxIterations && end > start; iteration++)
+        {
+            if (Vector3::DistanceSquared(data.Get(end), chain.Target) <= toleranceSqr)
+                break;
+            for (int32 i = end - 1; i >= start; i--)
+            {
+                // Rotate the sub-chain around the node so the end node points towards the target
+                const Vector3 pivot = data.Get(i);
+                const Vector3 toEnd = data.Get(end) - pivot;
+                const Vector3 toTarget = chain.Target - pivot;
+                if (toEnd.LengthSquared() < ZeroTolerance * ZeroTolerance || toTarget.LengthSquared() < ZeroTolerance * ZeroTolerance)
+                    continue;
+                const Quaternion rotation = Quaternion::FindBetween(toEnd.GetNormalized(), toTarget.GetNormalized());
+                for (int32 j = i + 1; j <= end; j++)
+                    data.Set(j, pivot + Vector3::Transform(data.Get(j) - pivot, rotation));
+            }
+        }
+    }
+    data.Apply(chains);
+}
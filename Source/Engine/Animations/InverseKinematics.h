@@ -5,12 +5,30 @@
 #include "Engine/Core/Math/Vector3.h"
 #include "Engine/Core/Math/Quaternion.h"
 #include "Engine/Core/Math/Transform.h"
+#include "Engine/Core/Types/Span.h"
 
 /// <summary>
 /// The Inverse Kinematics (IK) utility library.
 /// </summary>
 class FLAXENGINE_API InverseKinematics
 {
+public:
+    /// <summary>
+    /// The nodes chain to solve with the multi-bone IK solvers.
+    /// </summary>
+    struct Chain
+    {
+        /// <summary>
+        /// The chain nodes transformations (in model space) ordered from the root node to the end node (each node must be a parent of the next one).
+        /// </summary>
+        Span<Transform> Nodes;
+
+        /// <summary>
+        /// The target position of the end node to reach (in model space).
+        /// </summary>
+        Vector3 Target;
+    };
+
 public:
     /// <summary>
     /// Rotates a node so it aims at a target. Solves the transformation (rotation) that needs to be applied to the node such that a provided forward vector (in node local space) aims at the target position (in skeleton model space).
@@ -31,4 +49,20 @@ class FLAXENGINE_API InverseKinematics
     /// <param name="allowStretching">True if allow bones stretching, otherwise bone lengths will be preserved when trying to reach the target.</param>
     /// <param name="maxStretchScale">The maximum scale when stretching bones. Used only if allowStretching is true.</param>
     static void SolveTwoBoneIK(Transform& rootNode, Transform& jointNode, Transform& targetNode, const Vector3& target, const Vector3& jointTarget, bool allowStretching = false, float maxStretchScale = 1.5f);
+
+    /// <summary>
+    /// Performs inverse kinematic on the nodes chains using FABRIK (Forward And Backward Reaching Inverse Kinematics) solver. All chains are solved together (eg. feet and hands of many characters) with the nodes positions stored in the SoA layout. Bone lengths are preserved.
+    /// </summary>
+    /// <param name="chains">The chains to solve.</param>
+    /// <param name="tolerance">The distance of the end node to the target at which chain is considered as solved.</param>
+    /// <param name="maxIterations">The maximum amount of the solver iterations.</param>
+    static void SolveFABRIK(Span<Chain> chains, float tolerance = 0.01f, int32 maxIterations = 10);
+
+    /// <summary>
+    /// Performs inverse kinematic on the nodes chains using CCD (Cyclic Coordinate Descent) solver. Rotates each node (from the end to the root) so the end node moves towards the target. Bone lengths are preserved.
+    /// </summary>
+    /// <param name="chains">The chains to solve.</param>
+    /// <param name="tolerance">The distance of the end node to the target at which chain is considered as solved.</param>
+    /// <param name="maxIterations">The maximum amount of the solver iterations.</param>
+    static void SolveCCD(Span<Chain> chains, float tolerance = 0.01f, int32 maxIterations = 10);
 };
@@ -23,12 +23,14 @@ public override void Setup(BuildOptions options)
         bool useNone = true;
         bool useOpenAL = false;
         bool useXAudio2 = false;
+        bool useSoftware = false;
 
         switch (options.Platform.Target)
         {
         case TargetPlatform.Windows:
             useNone = true;
             useOpenAL = true;
+            useSoftware = true;
             //useXAudio2 = true;
             break;
         case TargetPlatform.XboxOne:
@@ -38,6 +40,7 @@ public override void Setup(BuildOptions options)
             break;
         case TargetPlatform.Linux:
             useOpenAL = true;
+            useSoftware = true;
             break;
         case TargetPlatform.PS4:
             options.SourcePaths.Add(Path.Combine(Globals.EngineRoot, "Source", "Platforms", "PS4", "Engine", "Audio"));
@@ -56,6 +59,7 @@ public override void Setup(BuildOptions options)
             break;
         case TargetPlatform.Mac:
             useOpenAL = true;
+            useSoftware = true;
             break;
         case TargetPlatform.iOS:
             useOpenAL = true;
@@ -120,6 +124,13 @@ public override void Setup(BuildOptions options)
             }
         }
 
+        if (useSoftware)
+        {
+            // Software mixer outputs the final mix via the platform audio device
+            options.SourcePaths.Add(Path.Combine(FolderPath, "Software"));
+            options.CompileEnv.PreprocessorDefinitions.Add("AUDIO_API_SOFTWARE");
+        }
+
         options.PrivateDependencies.Add("AudioTool");
     }
 
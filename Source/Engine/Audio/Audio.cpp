@@ -3,14 +3,18 @@
 #include "Audio.h"
 #include "AudioBackend.h"
 #include "AudioSettings.h"
+#include "AudioSource.h"
 #include "FlaxEngine.Gen.h"
 #include "Engine/Scripting/ScriptingType.h"
 #include "Engine/Scripting/BinaryModule.h"
 #include "Engine/Level/Level.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Engine/Engine.h"
+#include "Engine/Engine/Time.h"
 #include "Engine/Engine/CommandLine.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Engine/EngineService.h"
 #if AUDIO_API_NONE
 #include "None/AudioBackendNone.h"
@@ -30,6 +34,9 @@
 #if AUDIO_API_XAUDIO2
 #include "XAudio2/AudioBackendXAudio2.h"
 #endif
+#if AUDIO_API_SOFTWARE
+#include "Software/AudioBackendSoftware.h"
+#endif
 
 float AudioDataInfo::GetLength() const
 {
@@ -38,6 +45,7 @@ float AudioDataInfo::GetLength() const
 
 Array<AudioListener*> Audio::Listeners;
 Array<AudioSource*> Audio::Sources;
+Array<AudioReverbZone*> Audio::ReverbZones;
 Array<AudioDevice> Audio::Devices;
 Action Audio::DevicesChanged;
 Action Audio::ActiveDeviceChanged;
@@ -50,6 +58,24 @@ namespace
     int32 ActiveDeviceIndex = -1;
     bool MuteOnFocusLoss = true;
     bool EnableHRTF = true;
+    int32 MaxVoices = 64;
+    float VirtualizationVolume = 0.001f;
+
+    struct SourceVoice
+    {
+        AudioSource* Source;
+        float Score;
+
+        bool operator<(const SourceVoice& other) const
+        {
+            // Sort from the most relevant source
+            return Score > other.Score;
+        }
+    };
+
+    Array<SourceVoice> Voices;
+    Array<AudioSource*> ChangedSources;
+    AudioBackend::SourcesUpdate SourcesUpdate;
 }
 
 class AudioService : public EngineService
@@ -64,6 +90,9 @@ class AudioService : public EngineService
     bool Init() override;
     void Update() override;
     void Dispose() override;
+
+private:
+    static void UpdateSources();
 };
 
 AudioService AudioServiceInstance;
@@ -79,11 +108,70 @@ namespace
     {
         AudioBackend::SetVolume(Volume);
     }
+
+    void UpdateVoices()
+    {
+        PROFILE_CPU();
+
+        // Score playing sources by the audibility and priority
+        Voices.Clear();
+        for (AudioSource* source : Audio::Sources)
+        {
+            if (source->GetState() != AudioSource::States::Playing || !source->Clip || !source->Clip->IsLoaded())
+                continue;
+            if (!source->IsVirtual() && source->SourceIDs.IsEmpty())
+                continue;
+            const float audibility = source->GetAudibility();
+
+            // Inaudible sources don't need a voice (use higher threshold for virtual sources to prevent switching them back and forth)
+            if (audibility < (source->IsVirtual() ? VirtualizationVolume * 2.0f : VirtualizationVolume))
+            {
+                source->Virtualize();
+                continue;
+            }
+            float score = audibility * source->GetPriority();
+            if (!source->IsVirtual())
+                score *= 1.1f;
+            Voices.Add({ source, score });
+        }
+
+        // Play the most relevant sources with the real voices
+        if (MaxVoices > 0 && Voices.Count() > MaxVoices)
+            Sorting::QuickSort(Voices.Get(), Voices.Count());
+        for (int32 i = 0; i < Voices.Count(); i++)
+        {
+            AudioSource* source = Voices[i].Source;
+            if (MaxVoices > 0 && i >= MaxVoices)
+                source->Virtualize();
+            else
+                source->Devirtualize();
+        }
+    }
+
+    void UpdatePrefetch()
+    {
+        if (Engine::FrameCount % 10 != 0)
+            return;
+        PROFILE_CPU();
+
+        // Prefetch the beginning of the streamable clips used by the nearby stopped sources (eg. music or dialogue that might start playing soon)
+        for (AudioSource* source : Audio::Sources)
+        {
+            AudioClip* clip = source->Clip.Get();
+            if (source->GetState() != AudioSource::States::Stopped || !clip || !clip->IsLoaded() || !clip->IsStreamable())
+                continue;
+            if (source->GetAudibility() >= VirtualizationVolume)
+                clip->Prefetch(0);
+        }
+    }
 }
 
 void AudioSettings::Apply()
 {
     ::MuteOnFocusLoss = MuteOnFocusLoss;
+    ::MaxVoices = Math::Max(MaxVoices, 0);
+    ::VirtualizationVolume = Math::Max(VirtualizationVolume, 0.0f);
+    AudioClip::DecodedDataCacheBudget = (int64)Math::Max(DecodedDataCacheSize, 0) * 1024 * 1024;
     if (AudioBackend::Instance != nullptr)
     {
         Audio::SetDopplerFactor(DopplerFactor);
@@ -148,6 +236,16 @@ void Audio::SetEnableHRTF(bool value)
     AudioBackend::Listener::ReinitializeAll();
 }
 
+int32 Audio::GetMaxVoices()
+{
+    return MaxVoices;
+}
+
+void Audio::SetMaxVoices(int32 value)
+{
+    MaxVoices = Math::Max(value, 0);
+}
+
 void Audio::OnAddListener(AudioListener* listener)
 {
     ASSERT(!Listeners.Contains(listener));
@@ -180,12 +278,71 @@ void Audio::OnAddSource(AudioSource* source)
 
 void Audio::OnRemoveSource(AudioSource* source)
 {
+    if (source->_isPendingUpdate)
+    {
+        source->_isPendingUpdate = false;
+        source->_pendingUpdates = 0;
+        ChangedSources.Remove(source);
+    }
     if (!Sources.Remove(source))
     {
         AudioBackend::Source::OnRemove(source);
     }
 }
 
+void Audio::OnSourceChanged(AudioSource* source)
+{
+    ChangedSources.Add(source);
+}
+
+void AudioService::UpdateSources()
+{
+    if (ChangedSources.IsEmpty())
+        return;
+    PROFILE_CPU();
+
+    // Gather changes of the moved or modified sources (static sources are not processed at all)
+    const float dt = Math::Max(Time::Update.UnscaledDeltaTime.GetTotalSeconds(), ZeroTolerance);
+    auto& update = SourcesUpdate;
+    update.Clear();
+    for (int32 i = 0; i < ChangedSources.Count(); i++)
+    {
+        AudioSource* source = ChangedSources[i];
+        uint8 flags = source->_pendingUpdates;
+        source->_pendingUpdates = 0;
+
+        // Update the velocity
+        const Vector3 position = source->GetPosition();
+        const Vector3 velocity = (position - source->_prevPos) / dt;
+        source->_prevPos = position;
+        if (velocity != source->_velocity)
+        {
+            source->_velocity = velocity;
+            flags |= AudioBackend::SourcesUpdate::Velocity;
+        }
+
+        if (flags != 0 && source->SourceIDs.HasItems())
+        {
+            update.Sources.Add(source);
+            update.Flags.Add(flags);
+            update.Positions.Add(position);
+            update.Orientations.Add(source->GetOrientation());
+            update.Velocities.Add(velocity);
+        }
+
+        // Keep tracking moving source until it stops (to reset its velocity)
+        if (velocity.IsZero())
+        {
+            source->_isPendingUpdate = false;
+            ChangedSources.RemoveAt(i--);
+        }
+    }
+
+    // Submit all changes at once
+    if (update.Count() != 0)
+        AudioBackend::Source::UpdateBatch(update);
+}
+
 bool AudioService::Init()
 {
     PROFILE_CPU_NAMED("Audio.Init");
@@ -198,6 +355,10 @@ bool AudioService::Init()
     if (mute)
         backend = New<AudioBackendNone>();
 #endif
+#if AUDIO_API_SOFTWARE
+    if (!backend && settings->UseSoftwareMixer)
+        backend = New<AudioBackendSoftware>();
+#endif
 #if AUDIO_API_PS4
     if (!backend)
         backend = New<AudioBackendPS4>();
@@ -248,6 +409,7 @@ bool AudioService::Init()
 void AudioService::Update()
 {
     PROFILE_CPU_NAMED("Audio.Update");
+    PROFILE_MEM(Audio);
 
     // Update the master volume
     float masterVolume = MasterVolume;
@@ -262,6 +424,9 @@ void AudioService::Update()
         AudioBackend::SetVolume(masterVolume);
     }
 
+    UpdateVoices();
+    UpdatePrefetch();
+    UpdateSources();
     AudioBackend::Update();
 }
 
@@ -278,4 +443,7 @@ void AudioService::Dispose()
         AudioBackend::Instance = nullptr;
     }
     ActiveDeviceIndex = -1;
+    Voices.Resize(0);
+    ChangedSources.Resize(0);
+    SourcesUpdate.Clear();
 }
@@ -28,6 +28,11 @@ API_CLASS(Static) class FLAXENGINE_API Audio
     /// </summary>
     static Array<AudioSource*> Sources;
 
+    /// <summary>
+    /// The audio reverb zones collection registered by the service.
+    /// </summary>
+    static Array<AudioReverbZone*> ReverbZones;
+
     /// <summary>
     /// The all audio devices.
     /// </summary>
@@ -98,10 +103,22 @@ API_CLASS(Static) class FLAXENGINE_API Audio
     /// <param name="value">The value.</param>
     API_PROPERTY() static void SetEnableHRTF(bool value);
 
+    /// <summary>
+    /// Gets the maximum amount of the audio sources played with the real audio backend voices at once (others are virtualized). Value 0 means unlimited.
+    /// </summary>
+    API_PROPERTY() static int32 GetMaxVoices();
+
+    /// <summary>
+    /// Sets the maximum amount of the audio sources played with the real audio backend voices at once (others are virtualized). Value 0 means unlimited.
+    /// </summary>
+    /// <param name="value">The value.</param>
+    API_PROPERTY() static void SetMaxVoices(int32 value);
+
 public:
     static void OnAddListener(AudioListener* listener);
     static void OnRemoveListener(AudioListener* listener);
 
     static void OnAddSource(AudioSource* source);
     static void OnRemoveSource(AudioSource* source);
+    static void OnSourceChanged(AudioSource* source);
 };
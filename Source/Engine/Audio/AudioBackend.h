@@ -5,6 +5,9 @@
 #include "Config.h"
 #include "Types.h"
 #include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Math/Quaternion.h"
 
 /// <summary>
 /// The helper class for that handles active audio backend operations.
@@ -21,6 +24,45 @@ class AudioBackend
         None = 0,
         // Supports multi-channel (incl. stereo) audio playback for spatial sources (3D), otherwise 3d audio needs to be in mono format.
         SpatialMultiChannel = 1,
+        // Supports playback of IMA ADPCM compressed data directly (buffer write with bit depth of 4 and AUDIO_ADPCM_BLOCK_SAMPLES samples per block), otherwise audio gets decoded into PCM before buffer write.
+        ADPCM = 2,
+    };
+
+    /// <summary>
+    /// The audio sources state changes gathered during the frame and submitted to the backend at once (structure of arrays layout).
+    /// </summary>
+    struct SourcesUpdate
+    {
+        enum UpdateFlags : uint8
+        {
+            None = 0,
+            Transform = 1,
+            Velocity = 2,
+            Volume = 4,
+            Pitch = 8,
+            Pan = 16,
+        };
+
+        // Per-source data (the same amount of elements in each array). Position, orientation and velocity are valid only if a proper flag is set.
+        Array<AudioSource*> Sources;
+        Array<uint8> Flags;
+        Array<Vector3> Positions;
+        Array<Quaternion> Orientations;
+        Array<Vector3> Velocities;
+
+        FORCE_INLINE int32 Count() const
+        {
+            return Sources.Count();
+        }
+
+        void Clear()
+        {
+            Sources.Clear();
+            Flags.Clear();
+            Positions.Clear();
+            Orientations.Clear();
+            Velocities.Clear();
+        }
     };
 
     static AudioBackend* Instance;
@@ -39,6 +81,7 @@ class AudioBackend
     virtual void Source_OnRemove(AudioSource* source) = 0;
     virtual void Source_VelocityChanged(AudioSource* source) = 0;
     virtual void Source_TransformChanged(AudioSource* source) = 0;
+    virtual void Source_UpdateBatch(const SourcesUpdate& update) = 0;
     virtual void Source_VolumeChanged(AudioSource* source) = 0;
     virtual void Source_PitchChanged(AudioSource* source) = 0;
     virtual void Source_PanChanged(AudioSource* source) = 0;
@@ -134,6 +177,11 @@ class AudioBackend
             Instance->Source_TransformChanged(source);
         }
 
+        FORCE_INLINE static void UpdateBatch(const SourcesUpdate& update)
+        {
+            Instance->Source_UpdateBatch(update);
+        }
+
         FORCE_INLINE static void VolumeChanged(AudioSource* source)
         {
             Instance->Source_VolumeChanged(source);
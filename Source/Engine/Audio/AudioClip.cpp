@@ -7,15 +7,117 @@
 #include "Engine/Core/Log.h"
 #include "Engine/Content/Upgraders/AudioClipUpgrader.h"
 #include "Engine/Content/Factories/BinaryAssetFactory.h"
+#include "Engine/Content/Loading/ContentLoadTask.h"
 #include "Engine/Scripting/ManagedCLR/MUtils.h"
 #include "Engine/Streaming/StreamingGroup.h"
 #include "Engine/Serialization/MemoryReadStream.h"
 #include "Engine/Tools/AudioTool/OggVorbisDecoder.h"
 #include "Engine/Tools/AudioTool/AudioTool.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Profiler/ProfilerCPU.h"
 
 REGISTER_BINARY_ASSET_WITH_UPGRADER(AudioClip, "FlaxEngine.AudioClip", AudioClipUpgrader, false);
 
+int64 AudioClip::DecodedDataCacheBudget = 32 * 1024 * 1024;
+
+namespace
+{
+    struct DecodedChunk
+    {
+        const AudioClip* Clip;
+        int32 ChunkIndex;
+        AudioDataInfo Info;
+        Array<byte> Data;
+    };
+
+    // Decoded audio data (sorted from the least recently used)
+    CriticalSection DecodedChunksLocker;
+    Array<DecodedChunk*> DecodedChunks;
+    int64 DecodedChunksMemory = 0;
+
+    int32 FindDecodedChunk(const AudioClip* clip, int32 chunkIndex)
+    {
+        for (int32 i = DecodedChunks.Count() - 1; i >= 0; i--)
+        {
+            const DecodedChunk* e = DecodedChunks.Get()[i];
+            if (e->Clip == clip && e->ChunkIndex == chunkIndex)
+                return i;
+        }
+        return INVALID_INDEX;
+    }
+
+    bool HasDecodedChunk(const AudioClip* clip, int32 chunkIndex)
+    {
+        ScopeLock lock(DecodedChunksLocker);
+        return FindDecodedChunk(clip, chunkIndex) != INVALID_INDEX;
+    }
+
+    bool GetDecodedChunk(const AudioClip* clip, int32 chunkIndex, Array<byte>& data, AudioDataInfo& info)
+    {
+        ScopeLock lock(DecodedChunksLocker);
+        const int32 index = FindDecodedChunk(clip, chunkIndex);
+        if (index == INVALID_INDEX)
+            return false;
+        DecodedChunk* e = DecodedChunks[index];
+        data = e->Data;
+        info = e->Info;
+
+        // Mark as the most recently used
+        DecodedChunks.RemoveAtKeepOrder(index);
+        DecodedChunks.Add(e);
+        return true;
+    }
+
+    void AddDecodedChunk(const AudioClip* clip, int32 chunkIndex, Array<byte>&& data, const AudioDataInfo& info)
+    {
+        if (data.Count() > AudioClip::DecodedDataCacheBudget)
+            return;
+        ScopeLock lock(DecodedChunksLocker);
+        if (FindDecodedChunk(clip, chunkIndex) != INVALID_INDEX)
+            return;
+        auto e = New<DecodedChunk>();
+        e->Clip = clip;
+        e->ChunkIndex = chunkIndex;
+        e->Info = info;
+        e->Data = MoveTemp(data);
+        DecodedChunks.Add(e);
+        DecodedChunksMemory += e->Data.Count();
+
+        // Release the least recently used data to fit into the budget
+        while (DecodedChunksMemory > AudioClip::DecodedDataCacheBudget && DecodedChunks.HasItems())
+        {
+            DecodedChunk* first = DecodedChunks[0];
+            DecodedChunksMemory -= first->Data.Count();
+            DecodedChunks.RemoveAtKeepOrder(0);
+            Delete(first);
+        }
+    }
+
+    void RemoveDecodedChunks(const AudioClip* clip)
+    {
+        ScopeLock lock(DecodedChunksLocker);
+        for (int32 i = DecodedChunks.Count() - 1; i >= 0; i--)
+        {
+            DecodedChunk* e = DecodedChunks[i];
+            if (e->Clip == clip)
+            {
+                DecodedChunksMemory -= e->Data.Count();
+                DecodedChunks.RemoveAtKeepOrder(i);
+                Delete(e);
+            }
+        }
+    }
+
+#if COMPILE_WITH_OGG_VORBIS
+    bool DecodeChunk(const FlaxChunk* chunk, Array<byte>& data, AudioDataInfo& info)
+    {
+        OggVorbisDecoder decoder;
+        MemoryReadStream stream(chunk->Get(), chunk->Size());
+        return decoder.Convert(&stream, info, data);
+    }
+#endif
+}
+
 bool AudioClip::StreamingTask::Run()
 {
     AssetReference<AudioClip> ref = _asset.Get();
@@ -67,6 +169,49 @@ bool AudioClip::StreamingTask::Run()
     return false;
 }
 
+bool AudioClip::PrefetchTask::Run()
+{
+#if COMPILE_WITH_OGG_VORBIS
+    AssetReference<AudioClip> ref = _asset.Get();
+    if (ref == nullptr)
+        return true;
+    ScopeLock lock(ref->Locker);
+    auto clip = ref.Get();
+    if (clip->Buffers.Count() <= _chunkIndex || clip->Buffers[_chunkIndex] != AUDIO_BUFFER_ID_INVALID || HasDecodedChunk(clip, _chunkIndex))
+        return false;
+    const auto chunk = clip->GetChunk(_chunkIndex);
+    if (chunk == nullptr || chunk->IsMissing())
+        return false;
+
+    // Decode audio data into the cache
+    PROFILE_CPU_NAMED("AudioClip.Prefetch");
+    Array<byte> data;
+    AudioDataInfo info;
+    if (DecodeChunk(chunk, data, info))
+    {
+        LOG(Warning, "Audio data decode failed (OggVorbisDecoder).");
+        return true;
+    }
+    AddDecodedChunk(clip, _chunkIndex, MoveTemp(data), info);
+#endif
+    return false;
+}
+
+void AudioClip::PrefetchTask::OnEnd()
+{
+    // Unlink
+    if (_asset)
+    {
+        ASSERT(_asset->_prefetchTask == this);
+        _asset->_prefetchTask = nullptr;
+        _asset = nullptr;
+    }
+    _dataLock.Release();
+
+    // Base
+    ThreadPoolTask::OnEnd();
+}
+
 void AudioClip::StreamingTask::OnEnd()
 {
     // Unlink
@@ -218,6 +363,19 @@ bool AudioClip::ExtractDataRaw(Array<byte>& resultData, AudioDataInfo& resultDat
 		return true;
 #endif
     }
+    case AudioFormat::ADPCM:
+    {
+        // Chunks are split at the blocks boundaries so the whole data can be decoded at once
+        Array<byte> adpcmData;
+        if (ExtractData(adpcmData, resultDataInfo))
+            return true;
+        const uint32 samplesPerChannel = resultDataInfo.NumSamples / resultDataInfo.NumChannels;
+        if ((uint32)adpcmData.Count() < AudioTool::GetADPCMSize(samplesPerChannel, resultDataInfo.NumChannels))
+            return true;
+        resultData.Resize(samplesPerChannel * resultDataInfo.NumChannels * sizeof(int16));
+        AudioTool::ConvertFromADPCM(adpcmData.Get(), (int16*)resultData.Get(), samplesPerChannel, resultDataInfo.NumChannels);
+        return false;
+    }
     }
 
     return true;
@@ -229,6 +387,31 @@ void AudioClip::CancelStreaming()
     CancelStreamingTasks();
 }
 
+void AudioClip::Prefetch(int32 chunkIndex)
+{
+    ScopeLock lock(Locker);
+    if (!IsLoaded() || !IsStreamable() || !Math::IsInRange(chunkIndex, 0, _totalChunks - 1) || _prefetchTask || Buffers[chunkIndex] != AUDIO_BUFFER_ID_INVALID)
+        return;
+    const bool decode = Format() == AudioFormat::Vorbis && DecodedDataCacheBudget > 0;
+    if (decode && HasDecodedChunk(this, chunkIndex))
+        return;
+
+    // Load chunk data (and decode it) in the background
+    Task* task = RequestChunkDataAsync(chunkIndex);
+    if (task)
+        ((ContentLoadTask*)task)->SetPriority(ContentLoadTask::GetStreamingPriority(GetStreamingPriority()));
+    if (decode)
+    {
+        _prefetchTask = New<PrefetchTask>(this, chunkIndex);
+        if (task)
+            task->ContinueWith(_prefetchTask);
+        else
+            task = _prefetchTask;
+    }
+    if (task)
+        task->Start();
+}
+
 int32 AudioClip::GetMaxResidency() const
 {
     return _totalChunks;
@@ -267,11 +450,13 @@ Task* AudioClip::CreateStreamingTask(int32 residency)
     for (int32 i = 0; i < StreamingQueue.Count(); i++)
     {
         const int32 idx = StreamingQueue[i];
-        if (Buffers[idx] == AUDIO_BUFFER_ID_INVALID)
+        if (Buffers[idx] == AUDIO_BUFFER_ID_INVALID && !(Format() == AudioFormat::Vorbis && HasDecodedChunk(this, idx)))
         {
-            const auto task = (Task*)RequestChunkDataAsync(idx);
+            const auto loadTask = RequestChunkDataAsync(idx);
+            const auto task = (Task*)loadTask;
             if (task)
             {
+                loadTask->SetPriority(ContentLoadTask::GetStreamingPriority(GetStreamingPriority()));
                 if (result)
                     result->ContinueWith(task);
                 else
@@ -297,6 +482,11 @@ void AudioClip::CancelStreamingTasks()
         _streamingTask->Cancel();
         ASSERT_LOW_LAYER(_streamingTask == nullptr);
     }
+    if (_prefetchTask)
+    {
+        _prefetchTask->Cancel();
+        ASSERT_LOW_LAYER(_prefetchTask == nullptr);
+    }
 }
 
 bool AudioClip::init(AssetInitData& initData)
@@ -396,7 +586,9 @@ void AudioClip::unload(bool isReloading)
     }
 
     StopStreaming();
+    CancelStreamingTasks();
     StreamingQueue.Clear();
+    RemoveDecodedChunks(this);
     if (hasAnyBuffer && AudioBackend::Instance)
     {
         for (AUDIO_BUFFER_ID_TYPE bufferId : Buffers)
@@ -421,16 +613,20 @@ bool AudioClip::WriteBuffer(int32 chunkIndex)
     if (AudioBackend::Instance == nullptr)
         return true;
 
+    Span<byte> data;
+    Array<byte> tmp1, tmp2;
+    AudioDataInfo info = AudioHeader.Info;
+    const uint32 bytesPerSample = info.BitDepth / 8;
+
+    // Use the decoded data from cache (eg. prefetched)
+    AudioDataInfo tmpInfo;
+    const bool isDecoded = Format() == AudioFormat::Vorbis && GetDecodedChunk(this, chunkIndex, tmp1, tmpInfo);
     const auto chunk = GetChunk(chunkIndex);
-    if (chunk == nullptr || chunk->IsMissing())
+    if (!isDecoded && (chunk == nullptr || chunk->IsMissing()))
     {
         LOG(Warning, "Missing audio data.");
         return true;
     }
-    Span<byte> data;
-    Array<byte> tmp1, tmp2;
-    AudioDataInfo info = AudioHeader.Info;
-    const uint32 bytesPerSample = info.BitDepth / 8;
 
     // Get raw data or decompress it
     switch (Format())
@@ -438,10 +634,7 @@ bool AudioClip::WriteBuffer(int32 chunkIndex)
     case AudioFormat::Vorbis:
     {
 #if COMPILE_WITH_OGG_VORBIS
-        OggVorbisDecoder decoder;
-        MemoryReadStream stream(chunk->Get(), chunk->Size());
-        AudioDataInfo tmpInfo;
-        if (decoder.Convert(&stream, tmpInfo, tmp1))
+        if (!isDecoded && DecodeChunk(chunk, tmp1, tmpInfo))
         {
             LOG(Warning, "Audio data decode failed (OggVorbisDecoder).");
             return true;
@@ -457,6 +650,29 @@ bool AudioClip::WriteBuffer(int32 chunkIndex)
     case AudioFormat::Raw:
         data = Span<byte>(chunk->Get(), chunk->Size());
         break;
+    case AudioFormat::ADPCM:
+    {
+        const uint32 samplesPerChannel = AudioHeader.SamplesPerChunk[chunkIndex] / info.NumChannels;
+        if (chunk->Size() < (int32)AudioTool::GetADPCMSize(samplesPerChannel, info.NumChannels))
+        {
+            LOG(Warning, "Invalid audio data size.");
+            return true;
+        }
+        if (EnumHasAnyFlags(AudioBackend::Features(), AudioBackend::FeatureFlags::ADPCM) && !(Is3D() && info.NumChannels > 1 && EnumHasNoneFlags(AudioBackend::Features(), AudioBackend::FeatureFlags::SpatialMultiChannel)))
+        {
+            // Pass the compressed data directly to the backend (decoded during playback)
+            info.BitDepth = 4;
+            info.NumSamples = samplesPerChannel * info.NumChannels;
+            AudioBackend::Buffer::Write(bufferId, chunk->Get(), info);
+            return false;
+        }
+
+        // Decompress into 16-bit PCM
+        tmp1.Resize(samplesPerChannel * info.NumChannels * sizeof(int16));
+        AudioTool::ConvertFromADPCM(chunk->Get(), (int16*)tmp1.Get(), samplesPerChannel, info.NumChannels);
+        data = Span<byte>(tmp1.Get(), tmp1.Count());
+        break;
+    }
     default:
         return true;
     }
@@ -476,5 +692,9 @@ bool AudioClip::WriteBuffer(int32 chunkIndex)
 
     // Write samples to the audio buffer
     AudioBackend::Buffer::Write(bufferId, data.Get(), info);
+
+    // Keep the decoded data for later (eg. when looping or seeking)
+    if (Format() == AudioFormat::Vorbis && !isDecoded && IsStreamable() && DecodedDataCacheBudget > 0)
+        AddDecodedChunk(this, chunkIndex, MoveTemp(tmp1), tmpInfo);
     return false;
 }
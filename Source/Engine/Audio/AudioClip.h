@@ -67,10 +67,47 @@ API_CLASS(NoSpawn) class FLAXENGINE_API AudioClip : public BinaryAsset, public S
         void OnEnd() override;
     };
 
+    /// <summary>
+    /// Audio clip data prefetch task (decodes the audio chunk into the decoded data cache before it gets streamed)
+    /// </summary>
+    class PrefetchTask : public ThreadPoolTask
+    {
+    private:
+        WeakAssetReference<AudioClip> _asset;
+        FlaxStorage::LockData _dataLock;
+        int32 _chunkIndex;
+
+    public:
+        /// <summary>
+        /// Init
+        /// </summary>
+        /// <param name="asset">Parent asset</param>
+        /// <param name="chunkIndex">The audio data chunk index to decode.</param>
+        PrefetchTask(AudioClip* asset, int32 chunkIndex)
+            : _asset(asset)
+            , _dataLock(asset->Storage->Lock())
+            , _chunkIndex(chunkIndex)
+        {
+        }
+
+    public:
+        // [ThreadPoolTask]
+        bool HasReference(Object* resource) const override
+        {
+            return _asset == resource;
+        }
+
+    protected:
+        // [ThreadPoolTask]
+        bool Run() override;
+        void OnEnd() override;
+    };
+
 private:
     int32 _totalChunks;
     int32 _totalChunksSize;
     StreamingTask* _streamingTask;
+    PrefetchTask* _prefetchTask = nullptr;
     float _buffersStartTimes[ASSET_FILE_DATA_CHUNKS + 1];
 
 public:
@@ -85,6 +122,11 @@ API_CLASS(NoSpawn) class FLAXENGINE_API AudioClip : public BinaryAsset, public S
     /// </summary>
     Header AudioHeader;
 
+    /// <summary>
+    /// The memory budget (in bytes) of the decoded audio data cache shared by all audio clips. Least recently used data gets released first when exceeding the budget. Use 0 to disable caching.
+    /// </summary>
+    static int64 DecodedDataCacheBudget;
+
     /// <summary>
     /// The audio backend buffers (internal ids) collection used by this audio clip.
     /// </summary>
@@ -185,6 +227,12 @@ API_CLASS(NoSpawn) class FLAXENGINE_API AudioClip : public BinaryAsset, public S
     /// <returns>True if failed, otherwise false.</returns>
     API_FUNCTION() bool ExtractDataRaw(API_PARAM(Out) Array<byte>& resultData, API_PARAM(Out) AudioDataInfo& resultDataInfo);
 
+    /// <summary>
+    /// Prefetches the audio data chunk of the streamable clip (loads and decodes it in the background) to reduce the playback start latency, eg. when audio source that will play it soon is nearby. Does nothing if data is already available.
+    /// </summary>
+    /// <param name="chunkIndex">The audio data chunk index (0 is the beginning of the clip).</param>
+    API_FUNCTION() void Prefetch(int32 chunkIndex = 0);
+
 public:
     // [BinaryAsset]
     void CancelStreaming() override;
@@ -0,0 +1,68 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "AudioReverbZone.h"
+#include "Engine/Serialization/Serialization.h"
+#include "Audio.h"
+
+AudioReverbZone::AudioReverbZone(const SpawnParams& params)
+    : BoxVolume(params)
+    , _blendRadius(100.0f)
+{
+}
+
+float AudioReverbZone::GetBlendWeight(const Vector3& position) const
+{
+    Real distance;
+    if (_bounds.Contains(position, &distance) != ContainmentType::Contains)
+        return 0.0f;
+    return _blendRadius > 0.0f ? Math::Saturate((float)distance / _blendRadius) : 1.0f;
+}
+
+#if USE_EDITOR
+
+Color AudioReverbZone::GetWiresColor()
+{
+    return Color::MediumPurple;
+}
+
+#endif
+
+void AudioReverbZone::Serialize(SerializeStream& stream, const void* otherObj)
+{
+    // Base
+    BoxVolume::Serialize(stream, otherObj);
+
+    SERIALIZE_GET_OTHER_OBJ(AudioReverbZone);
+
+    SERIALIZE_MEMBER(BlendRadius, _blendRadius);
+    SERIALIZE(RoomSize);
+    SERIALIZE(Damping);
+    SERIALIZE(WetLevel);
+}
+
+void AudioReverbZone::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
+{
+    // Base
+    BoxVolume::Deserialize(stream, modifier);
+
+    DESERIALIZE_MEMBER(BlendRadius, _blendRadius);
+    DESERIALIZE(RoomSize);
+    DESERIALIZE(Damping);
+    DESERIALIZE(WetLevel);
+}
+
+void AudioReverbZone::OnEnable()
+{
+    Audio::ReverbZones.Add(this);
+
+    // Base
+    BoxVolume::OnEnable();
+}
+
+void AudioReverbZone::OnDisable()
+{
+    Audio::ReverbZones.Remove(this);
+
+    // Base
+    BoxVolume::OnDisable();
+}
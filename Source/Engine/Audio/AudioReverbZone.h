@@ -0,0 +1,76 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Level/Actors/BoxVolume.h"
+
+/// <summary>
+/// The volume that applies the reverberation effect to the spatial audio sources when audio listener is inside it (eg. to simulate a cave or a hall). Overlapping zones are blended together. Supported only by the software audio mixer backend.
+/// </summary>
+API_CLASS(Attributes="ActorContextMenu(\"New/Audio/Audio Reverb Zone\"), ActorToolbox(\"Other\")")
+class FLAXENGINE_API AudioReverbZone : public BoxVolume
+{
+    DECLARE_SCENE_OBJECT(AudioReverbZone);
+private:
+    float _blendRadius;
+
+public:
+    /// <summary>
+    /// The size of the simulated room. Higher values produce the longer reverberation tail.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(20), DefaultValue(0.5f), Limit(0, 1, 0.01f), EditorDisplay(\"Reverb\")")
+    float RoomSize = 0.5f;
+
+    /// <summary>
+    /// The damping of the high frequencies of the reverberation. Higher values produce darker sound (eg. soft walls).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(30), DefaultValue(0.5f), Limit(0, 1, 0.01f), EditorDisplay(\"Reverb\")")
+    float Damping = 0.5f;
+
+    /// <summary>
+    /// The volume of the reverberated signal mixed into the output.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(40), DefaultValue(0.3f), Limit(0, 1, 0.01f), EditorDisplay(\"Reverb\")")
+    float WetLevel = 0.3f;
+
+public:
+    /// <summary>
+    /// Gets the distance inside the volume at which blending with the zone's reverb occurs.
+    /// </summary>
+    API_PROPERTY(Attributes="EditorOrder(10), DefaultValue(100.0f), Limit(0), EditorDisplay(\"Reverb\")")
+    FORCE_INLINE float GetBlendRadius() const
+    {
+        return _blendRadius;
+    }
+
+    /// <summary>
+    /// Sets the distance inside the volume at which blending with the zone's reverb occurs.
+    /// </summary>
+    API_PROPERTY() void SetBlendRadius(float value)
+    {
+        _blendRadius = Math::Max(value, 0.0f);
+    }
+
+    /// <summary>
+    /// Calculates the influence of the zone for the given location (eg. audio listener position).
+    /// </summary>
+    /// <param name="position">The world-space location.</param>
+    /// <returns>The blend weight (normalized to range 0-1).</returns>
+    float GetBlendWeight(const Vector3& position) const;
+
+protected:
+    // [BoxVolume]
+#if USE_EDITOR
+    Color GetWiresColor() override;
+#endif
+
+public:
+    // [BoxVolume]
+    void Serialize(SerializeStream& stream, const void* otherObj) override;
+    void Deserialize(DeserializeStream& stream, ISerializeModifier* modifier) override;
+
+protected:
+    // [BoxVolume]
+    void OnEnable() override;
+    void OnDisable() override;
+};
@@ -31,6 +31,12 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings") class FLAXENGINE_API
     API_FIELD(Attributes="EditorOrder(200), DefaultValue(true), EditorDisplay(\"General\", \"Mute On Focus Loss\")")
     bool MuteOnFocusLoss = true;
 
+    /// <summary>
+    /// If checked, the engine will use its own software audio mixer (decoding, resampling, spatialization and effects such as reverb zones are processed in-engine on a dedicated audio thread) to provide the same audio behavior on all platforms. Otherwise, the platform audio backend is used. Requires the engine restart to apply.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(250), DefaultValue(false), EditorDisplay(\"General\", \"Use Software Mixer\")")
+    bool UseSoftwareMixer = false;
+
     /// <summary>
     /// Enables or disables HRTF audio for in-engine processing of 3D audio (if supported by platform).
     /// If enabled, the user should be using two-channel/headphones audio output and have all other surround virtualization disabled (Atmos, DTS:X, vendor specific, etc.)
@@ -38,6 +44,24 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings") class FLAXENGINE_API
     API_FIELD(Attributes="EditorOrder(300), DefaultValue(true), EditorDisplay(\"Spatial Audio\")")
     bool EnableHRTF = true;
 
+    /// <summary>
+    /// The maximum amount of the audio sources played with the real audio backend voices at once. Less audible (or lower priority) sources are virtualized - their playback is tracked without mixing the audio. Use 0 for unlimited amount.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(400), DefaultValue(64), Limit(0, 4096), EditorDisplay(\"Voices\")")
+    int32 MaxVoices = 64;
+
+    /// <summary>
+    /// The audibility (volume including distance attenuation) below which the playing audio sources are virtualized to save the audio backend voices. Use 0 to disable it.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(410), DefaultValue(0.001f), Limit(0, 1, 0.0001f), EditorDisplay(\"Voices\")")
+    float VirtualizationVolume = 0.001f;
+
+    /// <summary>
+    /// The memory budget (in megabytes) for the decoded audio data cache. Used to prefetch the beginning of the streamable audio clips of the nearby sources and to reuse decoded data (eg. when looping music). Use 0 to disable caching.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(500), DefaultValue(32), Limit(0, 4096), EditorDisplay(\"Streaming\", \"Decoded Data Cache Size\")")
+    int32 DecodedDataCacheSize = 32;
+
 public:
     /// <summary>
     /// Gets the instance of the settings asset (default value if missing). Object returned by this method is always loaded with valid data to use.
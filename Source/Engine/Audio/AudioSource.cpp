@@ -9,6 +9,7 @@
 #include "Engine/Level/Scene/Scene.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "AudioBackend.h"
+#include "AudioListener.h"
 #include "Audio.h"
 
 AudioSource::AudioSource(const SpawnParams& params)
@@ -32,8 +33,7 @@ void AudioSource::SetVolume(float value)
     if (Math::NearEqual(_volume, value))
         return;
     _volume = value;
-    if (SourceIDs.HasItems())
-        AudioBackend::Source::VolumeChanged(this);
+    MarkPendingUpdate(AudioBackend::SourcesUpdate::Volume);
 }
 
 void AudioSource::SetPitch(float value)
@@ -42,8 +42,7 @@ void AudioSource::SetPitch(float value)
     if (Math::NearEqual(_pitch, value))
         return;
     _pitch = value;
-    if (SourceIDs.HasItems())
-        AudioBackend::Source::PitchChanged(this);
+    MarkPendingUpdate(AudioBackend::SourcesUpdate::Pitch);
 }
 
 void AudioSource::SetPan(float value)
@@ -52,8 +51,7 @@ void AudioSource::SetPan(float value)
     if (Math::NearEqual(_pan, value))
         return;
     _pan = value;
-    if (SourceIDs.HasItems())
-        AudioBackend::Source::PanChanged(this);
+    MarkPendingUpdate(AudioBackend::SourcesUpdate::Pan);
 }
 
 void AudioSource::SetIsLooping(bool value)
@@ -116,11 +114,22 @@ void AudioSource::SetAllowSpatialization(bool value)
         AudioBackend::Source::SpatialSetupChanged(this);
 }
 
+void AudioSource::SetPriority(float value)
+{
+    _priority = Math::Max(0.0f, value);
+}
+
 void AudioSource::Play()
 {
     auto state = _state;
     if (state == States::Playing)
         return;
+    if (_isVirtual)
+    {
+        // Resume paused source with the real voice
+        Devirtualize();
+        state = _state;
+    }
     if (Clip == nullptr)
     {
         LOG(Warning, "Cannot play audio source without a clip ({0})", GetNamePath());
@@ -183,12 +192,21 @@ void AudioSource::Stop()
     _isActuallyPlayingSth = false;
     _streamingFirstChunk = 0;
 
+    if (_isVirtual)
+    {
+        // Stopped source uses the real voice again
+        Devirtualize();
+        return;
+    }
+
     if (SourceIDs.HasItems())
         AudioBackend::Source::Stop(this);
 }
 
 float AudioSource::GetTime() const
 {
+    if (_isVirtual)
+        return _state == States::Stopped ? 0.0f : _virtualTime;
     if (_state == States::Stopped || SourceIDs.IsEmpty() || !Clip->IsLoaded())
         return 0.0f;
 
@@ -211,6 +229,11 @@ void AudioSource::SetTime(float time)
 {
     if (_state == States::Stopped)
         return;
+    if (_isVirtual)
+    {
+        _virtualTime = Clip && Clip->IsLoaded() ? Math::Clamp(time, 0.0f, Clip->GetLength()) : 0.0f;
+        return;
+    }
 
     const bool isActuallyPlayingSth = _isActuallyPlayingSth;
     const auto state = _state;
@@ -242,6 +265,26 @@ void AudioSource::SetTime(float time)
     }
 }
 
+float AudioSource::GetAudibility() const
+{
+    float audibility = _volume;
+    if (_allowSpatialization && Clip && Clip->IsLoaded() && Clip->Is3D())
+    {
+        if (Audio::Listeners.IsEmpty())
+            return 0.0f;
+
+        // Estimate the distance attenuation to the closest listener (inverse distance clamped model used by the audio backends)
+        const Vector3 position = GetPosition();
+        Real distanceSqr = MAX_Real;
+        for (const AudioListener* listener : Audio::Listeners)
+            distanceSqr = Math::Min(distanceSqr, Vector3::DistanceSquared(position, listener->GetPosition()));
+        const float distance = (float)Math::Sqrt(distanceSqr);
+        if (distance > _minDistance)
+            audibility *= _minDistance / Math::Max(_minDistance + _attenuation * (distance - _minDistance), ZeroTolerance);
+    }
+    return audibility;
+}
+
 bool AudioSource::Is3D() const
 {
     if (Clip == nullptr || Clip->WaitForLoaded())
@@ -258,6 +301,7 @@ void AudioSource::Cleanup()
 {
     _savedState = GetState();
     _savedTime = GetTime();
+    _isVirtual = false;
     Stop();
 
     if (SourceIDs.HasItems())
@@ -267,6 +311,34 @@ void AudioSource::Cleanup()
     }
 }
 
+void AudioSource::Virtualize()
+{
+    if (_isVirtual || _state == States::Stopped || SourceIDs.IsEmpty())
+        return;
+
+    // Release the backend voice but keep the playback state
+    const States state = _state;
+    _virtualTime = GetTime();
+    Stop();
+    AudioBackend::Source::Cleanup(this);
+    SourceIDs.Clear();
+    _state = state;
+    _isVirtual = true;
+}
+
+void AudioSource::Devirtualize()
+{
+    if (!_isVirtual)
+        return;
+
+    // Create the backend voice and restore the playback state (at the virtual time)
+    _isVirtual = false;
+    _savedState = _state;
+    _savedTime = _state == States::Stopped ? 0.0f : _virtualTime;
+    _state = States::Stopped;
+    AudioBackend::Source::OnAdd(this);
+}
+
 void AudioSource::OnClipChanged()
 {
     Stop();
@@ -369,6 +441,7 @@ void AudioSource::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE_MEMBER(PlayOnStart, _playOnStart);
     SERIALIZE_MEMBER(StartTime, _startTime);
     SERIALIZE_MEMBER(AllowSpatialization, _allowSpatialization);
+    SERIALIZE_MEMBER(Priority, _priority);
 }
 
 void AudioSource::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
@@ -386,6 +459,7 @@ void AudioSource::Deserialize(DeserializeStream& stream, ISerializeModifier* mod
     DESERIALIZE_MEMBER(PlayOnStart, _playOnStart);
     DESERIALIZE_MEMBER(StartTime, _startTime);
     DESERIALIZE_MEMBER(AllowSpatialization, _allowSpatialization);
+    DESERIALIZE_MEMBER(Priority, _priority);
     DESERIALIZE(Clip);
 }
 
@@ -399,24 +473,55 @@ bool AudioSource::IntersectsItself(const Ray& ray, Real& distance, Vector3& norm
     return false;
 }
 
-void AudioSource::Update()
+void AudioSource::MarkPendingUpdate(uint8 flags)
 {
-    PROFILE_CPU();
+    // Skip if source is not registered in the audio service (backend state gets restored when source is added)
+    if (!_isEnabled)
+        return;
+    _pendingUpdates |= flags;
+    if (!_isPendingUpdate)
+    {
+        _isPendingUpdate = true;
+        Audio::OnSourceChanged(this);
+    }
+}
 
-    // Update the velocity
-    const Vector3 pos = GetPosition();
-    const float dt = Math::Max(Time::Update.UnscaledDeltaTime.GetTotalSeconds(), ZeroTolerance);
-    const auto prevVelocity = _velocity;
-    _velocity = (pos - _prevPos) / dt;
-    _prevPos = pos;
-    if (_velocity != prevVelocity)
+void AudioSource::Update()
+{
+    // Advance the playback time of the virtual source (without voice)
+    if (_isVirtual)
     {
-        AudioBackend::Source::VelocityChanged(this);
+        if (_state == States::Playing && Clip && Clip->IsLoaded())
+        {
+            _virtualTime += Time::Update.UnscaledDeltaTime.GetTotalSeconds() * _pitch;
+            const float length = Clip->GetLength();
+            if (_virtualTime >= length)
+            {
+                if (_loop && length > ZeroTolerance)
+                {
+                    _virtualTime = Math::Mod(_virtualTime, length);
+                }
+                else
+                {
+                    Stop();
+                    return;
+                }
+            }
+
+            // Keep streaming the audio data around the current time to quickly play it with the real voice
+            if (Clip->IsStreamable())
+            {
+                float relativeTime;
+                _streamingFirstChunk = Clip->GetFirstBufferIndex(_virtualTime, relativeTime);
+            }
+        }
+        return;
     }
 
     // Skip other update logic if it's not valid streamable source
     if (!UseStreaming() || SourceIDs.IsEmpty())
         return;
+    PROFILE_CPU();
     auto clip = Clip.Get();
     clip->Locker.Lock();
 
@@ -530,10 +635,7 @@ void AudioSource::OnTransformChanged()
     _box = BoundingBox(_transform.Translation);
     _sphere = BoundingSphere(_transform.Translation, 0.0f);
 
-    if (IsActiveInHierarchy() && SourceIDs.HasItems())
-    {
-        AudioBackend::Source::TransformChanged(this);
-    }
+    MarkPendingUpdate(AudioBackend::SourcesUpdate::Transform);
 }
 
 void AudioSource::BeginPlay(SceneBeginData* data)
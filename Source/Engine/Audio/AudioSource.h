@@ -19,6 +19,8 @@ class FLAXENGINE_API AudioSource : public Actor
     DECLARE_SCENE_OBJECT(AudioSource);
     friend class AudioStreamingHandler;
     friend class AudioClip;
+    friend class AudioService;
+    friend class Audio;
 public:
     /// <summary>
     /// Valid states in which AudioSource can be in.
@@ -50,6 +52,7 @@ class FLAXENGINE_API AudioSource : public Actor
     float _minDistance;
     float _attenuation = 1.0f;
     float _dopplerFactor = 1.0f;
+    float _priority = 1.0f;
     bool _loop;
     bool _playOnStart;
     float _startTime;
@@ -58,7 +61,11 @@ class FLAXENGINE_API AudioSource : public Actor
 
     bool _isActuallyPlayingSth = false;
     bool _needToUpdateStreamingBuffers = false;
+    bool _isVirtual = false;
+    bool _isPendingUpdate = false;
+    uint8 _pendingUpdates = 0;
     States _state = States::Stopped;
+    float _virtualTime = 0;
 
     States _savedState = States::Stopped;
     float _savedTime = 0;
@@ -224,6 +231,20 @@ class FLAXENGINE_API AudioSource : public Actor
     /// </summary>
     API_PROPERTY() void SetAllowSpatialization(bool value);
 
+    /// <summary>
+    /// Gets the importance of the source used to pick the sources played with the real voices when the voices limit is reached (scales the source audibility). Sources with higher priority are less likely to be virtualized.
+    /// </summary>
+    API_PROPERTY(Attributes="EditorOrder(90), DefaultValue(1.0f), Limit(0, 100.0f, 0.01f), EditorDisplay(\"Audio Source\")")
+    FORCE_INLINE float GetPriority() const
+    {
+        return _priority;
+    }
+
+    /// <summary>
+    /// Sets the importance of the source used to pick the sources played with the real voices when the voices limit is reached (scales the source audibility). Sources with higher priority are less likely to be virtualized.
+    /// </summary>
+    API_PROPERTY() void SetPriority(float value);
+
 public:
     /// <summary>
     /// Starts playing the currently assigned audio clip.
@@ -269,6 +290,19 @@ class FLAXENGINE_API AudioSource : public Actor
     /// </summary>
     API_PROPERTY() bool UseStreaming() const;
 
+    /// <summary>
+    /// Determines whether this audio source is virtual (playback is tracked without the audio backend voice because source is inaudible or the voices limit was reached). Virtual source becomes a real voice again when it gets relevant.
+    /// </summary>
+    API_PROPERTY() FORCE_INLINE bool IsVirtual() const
+    {
+        return _isVirtual;
+    }
+
+    /// <summary>
+    /// Calculates the estimated source audibility (volume including distance attenuation to the closest audio listener) in range 0-1.
+    /// </summary>
+    API_PROPERTY() float GetAudibility() const;
+
     /// <summary>
     /// Restores the saved time position and resumes/pauses the playback based on the state before. Used to restore audio source state after data rebuild (eg. by audio backend).
     /// </summary>
@@ -293,6 +327,16 @@ class FLAXENGINE_API AudioSource : public Actor
     /// </summary>
     void Cleanup();
 
+    /// <summary>
+    /// Releases the audio backend voice and continues tracking the playback time virtually. Called by the Audio manager.
+    /// </summary>
+    void Virtualize();
+
+    /// <summary>
+    /// Acquires the audio backend voice for the virtual source and restores its playback. Called by the Audio manager.
+    /// </summary>
+    void Devirtualize();
+
 private:
     void OnClipChanged();
     void OnClipLoaded();
@@ -307,6 +351,11 @@ class FLAXENGINE_API AudioSource : public Actor
     /// </summary>
     void PlayInternal();
 
+    /// <summary>
+    /// Marks the source state to be submitted to the audio backend within the batched update (once per frame).
+    /// </summary>
+    void MarkPendingUpdate(uint8 flags);
+
     void Update();
 
 public:
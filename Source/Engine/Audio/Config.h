@@ -18,3 +18,9 @@
 
 // The buffer ID that is invalid (unused)
 #define AUDIO_BUFFER_ID_INVALID 0
+
+// The amount of samples (per channel) in a single IMA ADPCM block (header sample + 64 encoded samples)
+#define AUDIO_ADPCM_BLOCK_SAMPLES 65
+
+// The size (in bytes) of a single IMA ADPCM block per channel (4 bytes header + 64 samples encoded as 4-bits)
+#define AUDIO_ADPCM_BLOCK_SIZE 36
@@ -44,6 +44,10 @@ void AudioBackendNone::Source_TransformChanged(AudioSource* source)
 {
 }
 
+void AudioBackendNone::Source_UpdateBatch(const SourcesUpdate& update)
+{
+}
+
 void AudioBackendNone::Source_VolumeChanged(AudioSource* source)
 {
 }
@@ -62,6 +62,8 @@ namespace ALC
     ALCdevice* Device = nullptr;
     Array<ALCcontext*, FixedAllocation<AUDIO_MAX_LISTENERS>> Contexts;
     AudioBackend::FeatureFlags Features = AudioBackend::FeatureFlags::None;
+    LPALDEFERUPDATESSOFT DeferUpdates = nullptr;
+    LPALPROCESSUPDATESSOFT ProcessUpdates = nullptr;
 
     bool IsExtensionSupported(const char* extension)
     {
@@ -392,6 +394,42 @@ void AudioBackendOAL::Source_TransformChanged(AudioSource* source)
     }
 }
 
+void AudioBackendOAL::Source_UpdateBatch(const SourcesUpdate& update)
+{
+    ALC_FOR_EACH_CONTEXT()
+        // Apply all changes at once
+        if (ALC::DeferUpdates)
+            ALC::DeferUpdates();
+        for (int32 j = 0; j < update.Count(); j++)
+        {
+            const AudioSource* source = update.Sources[j];
+            const uint8 flags = update.Flags[j];
+            const uint32 sourceID = source->SourceIDs[i];
+            if (source->Is3D())
+            {
+                if (flags & SourcesUpdate::Transform)
+                    alSource3f(sourceID, AL_POSITION, FLAX_POS_TO_OAL(update.Positions[j]));
+                if (flags & SourcesUpdate::Velocity)
+                    alSource3f(sourceID, AL_VELOCITY, FLAX_VEL_TO_OAL(update.Velocities[j]));
+            }
+            if (flags & SourcesUpdate::Volume)
+                alSourcef(sourceID, AL_GAIN, source->GetVolume());
+            if (flags & SourcesUpdate::Pitch)
+                alSourcef(sourceID, AL_PITCH, source->GetPitch());
+#ifdef AL_EXT_STEREO_ANGLES
+            if (flags & SourcesUpdate::Pan)
+            {
+                const float panAngle = source->GetPan() * PI_HALF;
+                const ALfloat panAngles[2] = { (ALfloat)(PI / 6.0 - panAngle), (ALfloat)(-PI / 6.0 - panAngle) };
+                alSourcefv(sourceID, AL_STEREO_ANGLES, panAngles);
+            }
+#endif
+        }
+        if (ALC::ProcessUpdates)
+            ALC::ProcessUpdates();
+    }
+}
+
 void AudioBackendOAL::Source_VolumeChanged(AudioSource* source)
 {
     ALC_FOR_EACH_CONTEXT()
@@ -618,6 +656,34 @@ void AudioBackendOAL::Buffer_Write(uint32 bufferId, byte* samples, const AudioDa
 {
     PROFILE_CPU();
 
+    // IMA ADPCM compressed data
+    if (info.BitDepth == 4)
+    {
+        const uint32 samplesPerChannel = info.NumSamples / info.NumChannels;
+        if (info.NumChannels <= 2)
+        {
+            if (ALC::IsExtensionSupported("AL_SOFT_block_alignment"))
+            {
+                alBufferi(bufferId, AL_UNPACK_BLOCK_ALIGNMENT_SOFT, AUDIO_ADPCM_BLOCK_SAMPLES);
+                ALC_CHECK_ERROR(alBufferi);
+            }
+            const ALenum format = info.NumChannels == 1 ? AL_FORMAT_MONO_IMA4 : AL_FORMAT_STEREO_IMA4;
+            alBufferData(bufferId, format, samples, AudioTool::GetADPCMSize(samplesPerChannel, info.NumChannels), info.SampleRate);
+            ALC_CHECK_ERROR(alBufferData);
+        }
+        else
+        {
+            // Multichannel data has to be decompressed
+            AudioDataInfo pcmInfo = info;
+            pcmInfo.BitDepth = 16;
+            int16* sampleBuffer16 = (int16*)Allocator::Allocate(info.NumSamples * sizeof(int16));
+            AudioTool::ConvertFromADPCM(samples, sampleBuffer16, samplesPerChannel, info.NumChannels);
+            Buffer_Write(bufferId, (byte*)sampleBuffer16, pcmInfo);
+            Allocator::Free(sampleBuffer16);
+        }
+        return;
+    }
+
     // Pick the format for the audio data (it might not be supported natively)
     ALenum format = GetOpenALBufferFormat(info.NumChannels, info.BitDepth);
 
@@ -869,6 +935,18 @@ bool AudioBackendOAL::Base_Init()
     if (ALC::IsExtensionSupported("AL_SOFT_source_spatialize"))
         ALC::Features = EnumAddFlags(ALC::Features, FeatureFlags::SpatialMultiChannel);
 #endif
+    if (ALC::IsExtensionSupported("AL_EXT_IMA4"))
+        ALC::Features = EnumAddFlags(ALC::Features, FeatureFlags::ADPCM);
+    if (ALC::IsExtensionSupported("AL_SOFT_deferred_updates"))
+    {
+        ALC::DeferUpdates = (LPALDEFERUPDATESSOFT)alGetProcAddress("alDeferUpdatesSOFT");
+        ALC::ProcessUpdates = (LPALPROCESSUPDATESSOFT)alGetProcAddress("alProcessUpdatesSOFT");
+        if (!ALC::DeferUpdates || !ALC::ProcessUpdates)
+        {
+            ALC::DeferUpdates = nullptr;
+            ALC::ProcessUpdates = nullptr;
+        }
+    }
 
     // Log service info
     LOG(Info, "{0} ({1})", String(alGetString(AL_RENDERER)), String(alGetString(AL_VERSION)));
@@ -23,6 +23,7 @@ class AudioBackendOAL : public AudioBackend
     void Source_OnRemove(AudioSource* source) override;
     void Source_VelocityChanged(AudioSource* source) override;
     void Source_TransformChanged(AudioSource* source) override;
+    void Source_UpdateBatch(const SourcesUpdate& update) override;
     void Source_VolumeChanged(AudioSource* source) override;
     void Source_PitchChanged(AudioSource* source) override;
     void Source_PanChanged(AudioSource* source) override;
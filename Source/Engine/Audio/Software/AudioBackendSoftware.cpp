@@ -0,0 +1,1619 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#if AUDIO_API_SOFTWARE
+
+#include "AudioBackendSoftware.h"
+#include "Engine/Audio/Audio.h"
+#include "Engine/Audio/AudioBackendTools.h"
+#include "Engine/Audio/AudioListener.h"
+#include "Engine/Audio/AudioReverbZone.h"
+#include "Engine/Audio/AudioSource.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/SIMD.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/ChunkedArray.h"
+#include "Engine/Platform/Thread.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/IRunnable.h"
+#include "Engine/Threading/Threading.h"
+#include "Engine/Tools/AudioTool/AudioTool.h"
+
+#if AUDIO_API_OPENAL
+// OpenAL is used only as the output device for the final mix
+#include <OpenAL/al.h>
+#include <OpenAL/alc.h>
+#endif
+
+// The output sample rate of the mixer (in Hz)
+#define SOFTWARE_AUDIO_SAMPLE_RATE 48000
+
+// The amount of audio frames mixed at once (~5ms)
+#define SOFTWARE_AUDIO_BLOCK_SIZE 256
+
+// The amount of mixed blocks queued for the output device (latency)
+#define SOFTWARE_AUDIO_OUTPUT_BLOCKS 4
+
+// The maximum amount of input and output channels (stereo)
+#define SOFTWARE_AUDIO_CHANNELS 2
+
+// The capacity of the commands queue (from game thread to audio thread)
+#define SOFTWARE_AUDIO_COMMANDS 4096
+
+// The maximum interaural time difference used by the HRTF (in output samples, ~0.66ms)
+#define SOFTWARE_AUDIO_HRTF_MAX_DELAY 32
+
+namespace SoftwareAudio
+{
+    /// <summary>
+    /// Single-producer single-consumer lock-free ring queue.
+    /// </summary>
+    template<typename T, int32 Capacity>
+    class RingQueue
+    {
+    private:
+        T _items[Capacity];
+        int64 _write = 0;
+        int64 _read = 0;
+
+    public:
+        bool IsFull() const
+        {
+            return Platform::AtomicRead(&_write) - Platform::AtomicRead(&_read) >= Capacity;
+        }
+
+        bool Push(const T& item)
+        {
+            const int64 write = Platform::AtomicRead(&_write);
+            if (write - Platform::AtomicRead(&_read) >= Capacity)
+                return false;
+            _items[write % Capacity] = item;
+            Platform::AtomicStore(&_write, write + 1);
+            return true;
+        }
+
+        bool Pop(T& item)
+        {
+            const int64 read = Platform::AtomicRead(&_read);
+            if (read == Platform::AtomicRead(&_write))
+                return false;
+            item = _items[read % Capacity];
+            Platform::AtomicStore(&_read, read + 1);
+            return true;
+        }
+    };
+
+    struct Buffer
+    {
+        // Samples converted to floats (interleaved channels), written only when buffer is not queued
+        Array<float> Samples;
+        // IMA ADPCM compressed data (decoded during playback), used instead of Samples
+        Array<byte> Compressed;
+        int32 Frames = 0;
+        int32 Channels = 1;
+        int32 SampleRate = SOFTWARE_AUDIO_SAMPLE_RATE;
+    };
+
+    struct VoiceMix
+    {
+        float Gains[SOFTWARE_AUDIO_CHANNELS][SOFTWARE_AUDIO_CHANNELS]; // [input][output]
+        float Pitch;
+        float ReverbSend;
+        float Delay[SOFTWARE_AUDIO_CHANNELS]; // Interaural delay per ear (in output samples)
+        float Shadow[SOFTWARE_AUDIO_CHANNELS]; // Head shadow low-pass coefficient per ear (1 = no filtering)
+        bool HRTF;
+    };
+
+    struct Voice
+    {
+        // Audio thread state
+        Voice* Next = nullptr;
+        Voice* Prev = nullptr;
+        int32 Channels = 1;
+        bool IsPlaying = false;
+        bool IsLooping = false;
+        bool HasMix = false;
+        Buffer* Queue[AUDIO_MAX_SOURCE_BUFFERS];
+        int32 QueueCount = 0;
+        int32 Processed = 0;
+        double Position = 0.0;
+        float StartTime = 0.0f;
+        VoiceMix Current;
+        VoiceMix Target;
+        float History[SOFTWARE_AUDIO_HRTF_MAX_DELAY] = {};
+        float ShadowState[SOFTWARE_AUDIO_CHANNELS] = {};
+        const Buffer* DecodedBuffer = nullptr;
+        int32 DecodedBlock = -1;
+        float Decoded[AUDIO_ADPCM_BLOCK_SAMPLES * SOFTWARE_AUDIO_CHANNELS];
+
+        // Playback state published to the game thread
+        int64 PublishedProcessed = 0;
+        int64 PublishedFrame = 0;
+    };
+
+    struct ReverbParams
+    {
+        float RoomSize;
+        float Damping;
+        float WetLevel;
+    };
+
+    enum class CommandType : byte
+    {
+        AddVoice,
+        RemoveVoice,
+        Play,
+        Pause,
+        Stop,
+        SetLooping,
+        SetStartTime,
+        SetMix,
+        SetBuffer,
+        QueueBuffer,
+        DequeueBuffers,
+        DeleteBuffer,
+        SetReverb,
+    };
+
+    struct Command
+    {
+        CommandType Type;
+        SoftwareAudio::Voice* Voice;
+
+        union
+        {
+            SoftwareAudio::Buffer* Buffer;
+            int32 Count;
+            float Time;
+            bool Value;
+            VoiceMix Mix;
+            ReverbParams Reverb;
+        };
+    };
+
+    // Object released by the audio thread to be deleted on the game thread (audio thread doesn't free the memory)
+    struct Retired
+    {
+        SoftwareAudio::Voice* Voice;
+        SoftwareAudio::Buffer* Buffer;
+    };
+
+    /// <summary>
+    /// The base class for the DSP effects processed on the mixer bus.
+    /// </summary>
+    class Effect
+    {
+    public:
+        virtual ~Effect()
+        {
+        }
+
+        // Processes the block of non-interleaved samples. Input is the bus signal, output is accumulated into the destination bus.
+        virtual void Process(float* input, float* output[SOFTWARE_AUDIO_CHANNELS], int32 frames) = 0;
+    };
+
+    /// <summary>
+    /// Stereo reverberation effect based on Schroeder-Moorer design (parallel low-pass comb filters followed by series all-pass filters, Freeverb tuning).
+    /// </summary>
+    class ReverbEffect : public Effect
+    {
+    private:
+        struct Comb
+        {
+            float Data[1800];
+            int32 Size;
+            int32 Index = 0;
+            float FilterStore = 0.0f;
+        };
+
+        struct AllPass
+        {
+            float Data[640];
+            int32 Size;
+            int32 Index = 0;
+        };
+
+        Comb _combs[SOFTWARE_AUDIO_CHANNELS][4];
+        AllPass _allPasses[SOFTWARE_AUDIO_CHANNELS][2];
+        float _feedback = 0.0f;
+        float _damping = 0.0f;
+        float _wet = 0.0f;
+
+    public:
+        ReverbParams Params = { 0.0f, 0.0f, 0.0f };
+
+        ReverbEffect()
+        {
+            // Freeverb filter lengths (for 44.1 kHz) with stereo spread
+            const int32 combSizes[4] = { 1116, 1277, 1422, 1557 };
+            const int32 allPassSizes[2] = { 556, 341 };
+            const float rateScale = SOFTWARE_AUDIO_SAMPLE_RATE / 44100.0f;
+            for (int32 channel = 0; channel < SOFTWARE_AUDIO_CHANNELS; channel++)
+            {
+                const int32 spread = channel * 23;
+                for (int32 i = 0; i < 4; i++)
+                {
+                    Comb& comb = _combs[channel][i];
+                    comb.Size = Math::Min((int32)((combSizes[i] + spread) * rateScale), (int32)ARRAY_COUNT(comb.Data));
+                    Platform::MemoryClear(comb.Data, sizeof(comb.Data));
+                }
+                for (int32 i = 0; i < 2; i++)
+                {
+                    AllPass& allPass = _allPasses[channel][i];
+                    allPass.Size = Math::Min((int32)((allPassSizes[i] + spread) * rateScale), (int32)ARRAY_COUNT(allPass.Data));
+                    Platform::MemoryClear(allPass.Data, sizeof(allPass.Data));
+                }
+            }
+        }
+
+        bool IsActive() const
+        {
+            return _wet > ZeroTolerance || Params.WetLevel > ZeroTolerance;
+        }
+
+        void Process(float* input, float* output[SOFTWARE_AUDIO_CHANNELS], int32 frames) override
+        {
+            const float feedback = 0.7f + Math::Saturate(Params.RoomSize) * 0.28f;
+            const float damping = Math::Saturate(Params.Damping) * 0.4f;
+            const float wet = Math::Saturate(Params.WetLevel) * 3.0f;
+            const float feedbackStep = (feedback - _feedback) / (float)frames;
+            const float wetStep = (wet - _wet) / (float)frames;
+            _damping = damping;
+            for (int32 channel = 0; channel < SOFTWARE_AUDIO_CHANNELS; channel++)
+            {
+                float* out = output[channel];
+                float feedbackValue = _feedback;
+                float wetValue = _wet;
+                for (int32 i = 0; i < frames; i++)
+                {
+                    const float in = input[i] * 0.015f;
+                    float sum = 0.0f;
+                    for (Comb& comb : _combs[channel])
+                    {
+                        const float value = comb.Data[comb.Index];
+                        comb.FilterStore = value * (1.0f - _damping) + comb.FilterStore * _damping;
+                        comb.Data[comb.Index] = in + comb.FilterStore * feedbackValue;
+                        if (++comb.Index >= comb.Size)
+                            comb.Index = 0;
+                        sum += value;
+                    }
+                    for (AllPass& allPass : _allPasses[channel])
+                    {
+                        const float value = allPass.Data[allPass.Index];
+                        allPass.Data[allPass.Index] = sum + value * 0.5f;
+                        if (++allPass.Index >= allPass.Size)
+                            allPass.Index = 0;
+                        sum = value - sum;
+                    }
+                    out[i] += sum * wetValue;
+                    feedbackValue += feedbackStep;
+                    wetValue += wetStep;
+                }
+            }
+            _feedback = feedback;
+            _wet = wet;
+        }
+    };
+
+    /// <summary>
+    /// The peak limiter that prevents the master bus output from clipping.
+    /// </summary>
+    class LimiterEffect : public Effect
+    {
+    private:
+        float _gain = 1.0f;
+
+    public:
+        void Process(float* input, float* output[SOFTWARE_AUDIO_CHANNELS], int32 frames) override
+        {
+            float peak = 0.0f;
+            for (int32 channel = 0; channel < SOFTWARE_AUDIO_CHANNELS; channel++)
+            {
+                const float* data = output[channel];
+                for (int32 i = 0; i < frames; i++)
+                    peak = Math::Max(peak, Math::Abs(data[i]));
+            }
+
+            // Fast attack, slow release
+            const float targetGain = peak > 0.98f ? 0.98f / peak : 1.0f;
+            const float gain = targetGain < _gain ? targetGain : Math::Lerp(_gain, targetGain, 0.05f);
+            const float gainStep = (gain - _gain) / (float)frames;
+            for (int32 channel = 0; channel < SOFTWARE_AUDIO_CHANNELS; channel++)
+            {
+                float* data = output[channel];
+                float value = _gain;
+                for (int32 i = 0; i < frames; i++)
+                {
+                    value += gainStep;
+                    data[i] *= value;
+                }
+            }
+            _gain = gain;
+        }
+    };
+
+    /// <summary>
+    /// The audio device that plays the final mix.
+    /// </summary>
+    class Output
+    {
+    public:
+        virtual ~Output()
+        {
+        }
+
+        virtual const Char* GetName() const = 0;
+        virtual bool Init() = 0;
+        virtual int32 GetFreeBlocks() = 0;
+        virtual void Submit(const int16* samples, int32 frames) = 0;
+        virtual void Dispose() = 0;
+    };
+
+    /// <summary>
+    /// The null output that consumes the mixed audio at the real-time rate (eg. when audio device is missing).
+    /// </summary>
+    class NullOutput : public Output
+    {
+    private:
+        double _startTime = 0.0;
+        int64 _submittedFrames = 0;
+
+    public:
+        const Char* GetName() const override
+        {
+            return TEXT("Null output");
+        }
+
+        bool Init() override
+        {
+            _startTime = Platform::GetTimeSeconds();
+            _submittedFrames = 0;
+            return false;
+        }
+
+        int32 GetFreeBlocks() override
+        {
+            const int64 playedFrames = (int64)((Platform::GetTimeSeconds() - _startTime) * SOFTWARE_AUDIO_SAMPLE_RATE);
+            const int64 queuedFrames = _submittedFrames - playedFrames;
+            return Math::Max(SOFTWARE_AUDIO_OUTPUT_BLOCKS - (int32)(queuedFrames / SOFTWARE_AUDIO_BLOCK_SIZE), 0);
+        }
+
+        void Submit(const int16* samples, int32 frames) override
+        {
+            _submittedFrames += frames;
+        }
+
+        void Dispose() override
+        {
+        }
+    };
+
+#if AUDIO_API_OPENAL
+    /// <summary>
+    /// The output that streams the final mix via a single OpenAL source.
+    /// </summary>
+    class OpenALOutput : public Output
+    {
+    private:
+        ALCdevice* _device = nullptr;
+        ALCcontext* _context = nullptr;
+        ALuint _source = 0;
+        ALuint _buffers[SOFTWARE_AUDIO_OUTPUT_BLOCKS] = {};
+        ALuint _freeBuffers[SOFTWARE_AUDIO_OUTPUT_BLOCKS] = {};
+        int32 _freeCount = 0;
+
+    public:
+        const Char* GetName() const override
+        {
+            return TEXT("OpenAL output");
+        }
+
+        bool Init() override
+        {
+            _device = alcOpenDevice(nullptr);
+            if (_device == nullptr)
+                return true;
+            const ALCint attributes[] = { ALC_FREQUENCY, SOFTWARE_AUDIO_SAMPLE_RATE, 0 };
+            _context = alcCreateContext(_device, attributes);
+            if (_context == nullptr)
+                return true;
+            alcMakeContextCurrent(_context);
+            alGenSources(1, &_source);
+            alSourcei(_source, AL_SOURCE_RELATIVE, AL_TRUE);
+            alGenBuffers(SOFTWARE_AUDIO_OUTPUT_BLOCKS, _buffers);
+            for (int32 i = 0; i < SOFTWARE_AUDIO_OUTPUT_BLOCKS; i++)
+                _freeBuffers[i] = _buffers[i];
+            _freeCount = SOFTWARE_AUDIO_OUTPUT_BLOCKS;
+            return alGetError() != AL_NO_ERROR;
+        }
+
+        int32 GetFreeBlocks() override
+        {
+            ALint processed = 0;
+            alGetSourcei(_source, AL_BUFFERS_PROCESSED, &processed);
+            while (processed-- > 0 && _freeCount < SOFTWARE_AUDIO_OUTPUT_BLOCKS)
+                alSourceUnqueueBuffers(_source, 1, &_freeBuffers[_freeCount++]);
+            return _freeCount;
+        }
+
+        void Submit(const int16* samples, int32 frames) override
+        {
+            const ALuint buffer = _freeBuffers[--_freeCount];
+            alBufferData(buffer, AL_FORMAT_STEREO16, samples, frames * SOFTWARE_AUDIO_CHANNELS * sizeof(int16), SOFTWARE_AUDIO_SAMPLE_RATE);
+            alSourceQueueBuffers(_source, 1, &buffer);
+
+            // Restart playback after buffer underrun
+            ALint state;
+            alGetSourcei(_source, AL_SOURCE_STATE, &state);
+            if (state != AL_PLAYING && _freeCount == 0)
+                alSourcePlay(_source);
+        }
+
+        void Dispose() override
+        {
+            if (_source)
+            {
+                alSourceStop(_source);
+                alSourcei(_source, AL_BUFFER, 0);
+                alDeleteSources(1, &_source);
+                alDeleteBuffers(SOFTWARE_AUDIO_OUTPUT_BLOCKS, _buffers);
+                _source = 0;
+            }
+            alcMakeContextCurrent(nullptr);
+            if (_context)
+            {
+                alcDestroyContext(_context);
+                _context = nullptr;
+            }
+            if (_device)
+            {
+                alcCloseDevice(_device);
+                _device = nullptr;
+            }
+        }
+    };
+#endif
+
+    struct Listener : AudioBackendTools::Listener
+    {
+        ::AudioListener* AudioListener = nullptr;
+
+        void UpdateTransform()
+        {
+            Position = AudioListener->GetPosition();
+            Orientation = AudioListener->GetOrientation();
+        }
+
+        void UpdateVelocity()
+        {
+            Velocity = AudioListener->GetVelocity();
+        }
+    };
+
+    struct Source : AudioBackendTools::Source
+    {
+        SoftwareAudio::Voice* Voice = nullptr;
+        int32 Channels = 1;
+        int32 QueuedBuffers = 0;
+        bool IsDirty = false;
+
+        bool IsFree() const
+        {
+            return Voice == nullptr;
+        }
+
+        void UpdateTransform(const AudioSource* source)
+        {
+            Position = source->GetPosition();
+            Orientation = source->GetOrientation();
+        }
+
+        void UpdateVelocity(const AudioSource* source)
+        {
+            Velocity = source->GetVelocity();
+        }
+    };
+
+    // Game thread state
+    CriticalSection Locker;
+    AudioBackendTools::Settings Settings;
+    Listener Listeners[AUDIO_MAX_LISTENERS];
+    ChunkedArray<Source, 32> Sources;
+    ChunkedArray<Buffer*, 64> Buffers;
+    ReverbParams Reverb = { 0.0f, 0.0f, 0.0f };
+    bool EnableHRTF = true;
+    bool ForceDirty = true;
+    RingQueue<Command, SOFTWARE_AUDIO_COMMANDS> Commands;
+    RingQueue<Retired, SOFTWARE_AUDIO_COMMANDS> RetiredObjects;
+    Output* Device = nullptr;
+    Thread* MixerThread = nullptr;
+    int64 ExitFlag = 0;
+
+    // Audio thread state
+    Voice* Voices = nullptr;
+    ReverbEffect Reverberation;
+    LimiterEffect Limiter;
+    ALIGN_BEGIN(16) float MasterBus[SOFTWARE_AUDIO_CHANNELS][SOFTWARE_AUDIO_BLOCK_SIZE] ALIGN_END(16);
+    ALIGN_BEGIN(16) float ReverbBus[SOFTWARE_AUDIO_BLOCK_SIZE] ALIGN_END(16);
+    ALIGN_BEGIN(16) float VoiceBus[SOFTWARE_AUDIO_CHANNELS][SOFTWARE_AUDIO_BLOCK_SIZE] ALIGN_END(16);
+    ALIGN_BEGIN(16) float EarBus[SOFTWARE_AUDIO_BLOCK_SIZE] ALIGN_END(16);
+    float DelayLine[SOFTWARE_AUDIO_HRTF_MAX_DELAY + SOFTWARE_AUDIO_BLOCK_SIZE];
+    int16 OutputBlock[SOFTWARE_AUDIO_BLOCK_SIZE * SOFTWARE_AUDIO_CHANNELS];
+
+    void Send(const Command& command)
+    {
+        // Multiple producers (eg. game thread and streaming tasks) are serialized, audio thread consumes commands without locking
+        ScopeLock lock(Locker);
+        while (!Commands.Push(command))
+            Platform::Sleep(1);
+    }
+
+    void Send(CommandType type, Voice* voice)
+    {
+        Command command;
+        command.Type = type;
+        command.Voice = voice;
+        Send(command);
+    }
+
+    Listener* GetListener()
+    {
+        for (int32 i = 0; i < AUDIO_MAX_LISTENERS; i++)
+        {
+            if (Listeners[i].AudioListener)
+                return &Listeners[i];
+        }
+        return nullptr;
+    }
+
+    Listener* GetListener(const AudioListener* listener)
+    {
+        for (int32 i = 0; i < AUDIO_MAX_LISTENERS; i++)
+        {
+            if (Listeners[i].AudioListener == listener)
+                return &Listeners[i];
+        }
+        return nullptr;
+    }
+
+    Source* GetSource(const AudioSource* source)
+    {
+        if (source->SourceIDs.Count() == 0)
+            return nullptr;
+        const AUDIO_SOURCE_ID_TYPE sourceId = source->SourceIDs[0];
+        // 0 is invalid ID so shift them
+        Source* aSource = &Sources[sourceId - 1];
+        return aSource->IsFree() ? nullptr : aSource;
+    }
+
+    Buffer* GetBuffer(uint32 bufferId)
+    {
+        ScopeLock lock(Locker);
+        return Buffers[bufferId - 1];
+    }
+
+    void MarkAllDirty()
+    {
+        ForceDirty = true;
+    }
+
+    // Accumulates the source signal into the destination with the gain linearly interpolated over the block
+    void MixRamp(float* dst, const float* src, float gainStart, float gainEnd)
+    {
+        constexpr int32 count = SOFTWARE_AUDIO_BLOCK_SIZE;
+        const float gainStep = (gainEnd - gainStart) / (float)count;
+        if (Math::IsZero(gainStart) && Math::IsZero(gainEnd))
+            return;
+        SimdVector4 gain = SIMD::Load(gainStart, gainStart + gainStep, gainStart + gainStep * 2, gainStart + gainStep * 3);
+        const SimdVector4 step = SIMD::Splat(gainStep * 4);
+        for (int32 i = 0; i < count; i += 4)
+        {
+            SIMD::Store(dst + i, SIMD::Add(SIMD::Load(dst + i), SIMD::Mul(SIMD::Load(src + i), gain)));
+            gain = SIMD::Add(gain, step);
+        }
+    }
+
+    FORCE_INLINE float GetCompressedBlockSample(const Buffer* buffer, int32 block, int32 channel)
+    {
+        // The first sample of the IMA ADPCM block is stored uncompressed in the block header
+        const byte* header = buffer->Compressed.Get() + block * AUDIO_ADPCM_BLOCK_SIZE * buffer->Channels + channel * 4;
+        return (int16)(header[0] | (header[1] << 8)) * (1.0f / 32767.0f);
+    }
+
+    float GetCompressedSample(Voice& voice, const Buffer* buffer, int32 frame, int32 channel)
+    {
+        const int32 block = frame / AUDIO_ADPCM_BLOCK_SAMPLES;
+        const int32 blockFrame = frame - block * AUDIO_ADPCM_BLOCK_SAMPLES;
+        if (voice.DecodedBuffer != buffer || voice.DecodedBlock != block)
+        {
+            if (blockFrame == 0)
+                return GetCompressedBlockSample(buffer, block, channel);
+
+            // Decode the whole block and cache it within a voice (playback reads samples sequentially)
+            int16 decoded[AUDIO_ADPCM_BLOCK_SAMPLES * SOFTWARE_AUDIO_CHANNELS];
+            AudioTool::DecodeADPCMBlock(buffer->Compressed.Get() + block * AUDIO_ADPCM_BLOCK_SIZE * buffer->Channels, decoded, buffer->Channels);
+            for (int32 i = 0; i < AUDIO_ADPCM_BLOCK_SAMPLES * buffer->Channels; i++)
+                voice.Decoded[i] = decoded[i] * (1.0f / 32767.0f);
+            voice.DecodedBuffer = buffer;
+            voice.DecodedBlock = block;
+        }
+        return voice.Decoded[blockFrame * buffer->Channels + channel];
+    }
+
+    FORCE_INLINE float GetSample(Voice& voice, const Buffer* buffer, int32 frame, int32 channel)
+    {
+        if (buffer->Compressed.HasItems())
+            return GetCompressedSample(voice, buffer, frame, channel);
+        return buffer->Samples.Get()[frame * buffer->Channels + channel];
+    }
+
+    FORCE_INLINE float GetNextSample(Voice& voice, const Buffer* buffer, int32 frame, int32 channel)
+    {
+        // Sample after the end of the buffer comes from the beginning of the loop or the next queued buffer
+        if (frame < buffer->Frames)
+            return GetSample(voice, buffer, frame, channel);
+        if (voice.IsLooping && voice.QueueCount == 1)
+            return buffer->Compressed.HasItems() ? GetCompressedBlockSample(buffer, 0, channel) : buffer->Samples.Get()[channel];
+        if (voice.Processed + 1 < voice.QueueCount)
+        {
+            const Buffer* next = voice.Queue[voice.Processed + 1];
+            channel = Math::Min(channel, next->Channels - 1);
+            if (next->Frames > 0)
+                return next->Compressed.HasItems() ? GetCompressedBlockSample(next, 0, channel) : next->Samples.Get()[channel];
+        }
+        return GetSample(voice, buffer, buffer->Frames - 1, channel);
+    }
+
+    // Resamples the voice audio data into the voice bus (non-interleaved), returns false if voice has no more data to play
+    bool ResampleVoice(Voice& voice)
+    {
+        int32 frame = 0;
+        while (frame < SOFTWARE_AUDIO_BLOCK_SIZE && voice.Processed < voice.QueueCount)
+        {
+            const Buffer* buffer = voice.Queue[voice.Processed];
+            const int32 bufferFrames = buffer->Frames;
+            const int32 stride = buffer->Channels;
+            const int32 channels = Math::Min(stride, SOFTWARE_AUDIO_CHANNELS);
+            const float* samples = buffer->Samples.Get();
+            const double step = (double)voice.Current.Pitch * buffer->SampleRate / SOFTWARE_AUDIO_SAMPLE_RATE;
+            if (step <= 0.0)
+                break;
+            double position = voice.Position;
+            if (bufferFrames > 0 && buffer->Compressed.HasItems())
+            {
+                // Compressed data decoded on the fly (linear interpolation)
+                while (frame < SOFTWARE_AUDIO_BLOCK_SIZE && position < bufferFrames)
+                {
+                    const int32 index = (int32)position;
+                    const float alpha = (float)(position - index);
+                    for (int32 channel = 0; channel < channels; channel++)
+                    {
+                        const float a = GetCompressedSample(voice, buffer, index, channel);
+                        const float b = alpha > 0.0f ? GetNextSample(voice, buffer, index + 1, channel) : a;
+                        VoiceBus[channel][frame] = a + (b - a) * alpha;
+                    }
+                    frame++;
+                    position += step;
+                }
+            }
+            else if (bufferFrames > 0)
+            {
+                if (step == 1.0 && position == (double)(int64)position)
+                {
+                    // Fast path without interpolation
+                    const int32 start = (int32)position;
+                    const int32 count = Math::Clamp(bufferFrames - start, 0, SOFTWARE_AUDIO_BLOCK_SIZE - frame);
+                    for (int32 channel = 0; channel < channels; channel++)
+                    {
+                        float* dst = VoiceBus[channel] + frame;
+                        const float* src = samples + start * stride + channel;
+                        for (int32 i = 0; i < count; i++)
+                            dst[i] = src[i * stride];
+                    }
+                    frame += count;
+                    position += count;
+                }
+                else
+                {
+                    // Linear interpolation of the frames within the buffer (4 frames at once)
+                    const double available = ((double)bufferFrames - 1.0 - position) / step;
+                    const int32 count = available > 0.0 ? (int32)Math::Min<double>(available, SOFTWARE_AUDIO_BLOCK_SIZE - frame) & ~3 : 0;
+                    for (int32 i = 0; i < count; i += 4)
+                    {
+                        int32 index[4];
+                        float alpha[4];
+                        for (int32 j = 0; j < 4; j++)
+                        {
+                            const double p = position + step * j;
+                            index[j] = (int32)p;
+                            alpha[j] = (float)(p - index[j]);
+                        }
+                        const SimdVector4 t = SIMD::Load(alpha[0], alpha[1], alpha[2], alpha[3]);
+                        for (int32 channel = 0; channel < channels; channel++)
+                        {
+                            const float* src = samples + channel;
+                            const SimdVector4 a = SIMD::Load(src[index[0] * stride], src[index[1] * stride], src[index[2] * stride], src[index[3] * stride]);
+                            const SimdVector4 b = SIMD::Load(src[(index[0] + 1) * stride], src[(index[1] + 1) * stride], src[(index[2] + 1) * stride], src[(index[3] + 1) * stride]);
+                            SIMD::Store(VoiceBus[channel] + frame + i, SIMD::Add(a, SIMD::Mul(SIMD::Sub(b, a), t)));
+                        }
+                        position += step * 4;
+                    }
+                    frame += count;
+
+                    // Remaining frames (last frame is interpolated with the next buffer or the loop start)
+                    while (frame < SOFTWARE_AUDIO_BLOCK_SIZE && position < bufferFrames)
+                    {
+                        const int32 index = (int32)position;
+                        const float alpha = (float)(position - index);
+                        for (int32 channel = 0; channel < channels; channel++)
+                        {
+                            const float a = samples[index * stride + channel];
+                            const float b = GetNextSample(voice, buffer, index + 1, channel);
+                            VoiceBus[channel][frame] = a + (b - a) * alpha;
+                        }
+                        frame++;
+                        position += step;
+                    }
+                }
+            }
+            voice.Position = position;
+
+            // Move to the next buffer
+            if (position >= bufferFrames)
+            {
+                voice.Position = bufferFrames > 0 ? position - bufferFrames : 0.0;
+                if (voice.IsLooping && voice.QueueCount == 1 && bufferFrames > 0)
+                    continue;
+                voice.Processed++;
+            }
+        }
+
+        // Clear the remaining part of the block
+        if (frame < SOFTWARE_AUDIO_BLOCK_SIZE)
+        {
+            for (int32 channel = 0; channel < SOFTWARE_AUDIO_CHANNELS; channel++)
+                Platform::MemoryClear(VoiceBus[channel] + frame, (SOFTWARE_AUDIO_BLOCK_SIZE - frame) * sizeof(float));
+        }
+        return frame != 0;
+    }
+
+    void MixVoice(Voice& voice)
+    {
+        if (!ResampleVoice(voice))
+            return;
+        const VoiceMix& from = voice.Current;
+        const VoiceMix& to = voice.Target;
+
+        if (to.HRTF && voice.Channels == 1)
+        {
+            // Binaural spatialization of mono source: interaural time difference (fractional delay) and head shadow (low-pass on the far ear) on top of the level panning
+            Platform::MemoryCopy(DelayLine, voice.History, sizeof(voice.History));
+            Platform::MemoryCopy(DelayLine + SOFTWARE_AUDIO_HRTF_MAX_DELAY, VoiceBus[0], SOFTWARE_AUDIO_BLOCK_SIZE * sizeof(float));
+            for (int32 ear = 0; ear < SOFTWARE_AUDIO_CHANNELS; ear++)
+            {
+                const float delayStart = from.HRTF ? from.Delay[ear] : to.Delay[ear];
+                const float delayStep = (to.Delay[ear] - delayStart) / SOFTWARE_AUDIO_BLOCK_SIZE;
+                const float shadow = to.Shadow[ear];
+                float state = voice.ShadowState[ear];
+                for (int32 i = 0; i < SOFTWARE_AUDIO_BLOCK_SIZE; i++)
+                {
+                    const float readPos = (float)(SOFTWARE_AUDIO_HRTF_MAX_DELAY + i) - (delayStart + delayStep * i);
+                    const int32 index = (int32)readPos;
+                    const float alpha = readPos - index;
+                    const float value = DelayLine[index] + (DelayLine[Math::Min(index + 1, SOFTWARE_AUDIO_HRTF_MAX_DELAY + i)] - DelayLine[index]) * alpha;
+                    state += (value - state) * shadow;
+                    EarBus[i] = state;
+                }
+                voice.ShadowState[ear] = state;
+                MixRamp(MasterBus[ear], EarBus, from.Gains[0][ear], to.Gains[0][ear]);
+            }
+            Platform::MemoryCopy(voice.History, DelayLine + SOFTWARE_AUDIO_BLOCK_SIZE, sizeof(voice.History));
+        }
+        else
+        {
+            // Multi-channel panning matrix
+            for (int32 input = 0; input < voice.Channels; input++)
+            {
+                for (int32 output = 0; output < SOFTWARE_AUDIO_CHANNELS; output++)
+                    MixRamp(MasterBus[output], VoiceBus[input], from.Gains[input][output], to.Gains[input][output]);
+            }
+        }
+
+        // Send to reverb bus (downmixed to mono)
+        if (from.ReverbSend > ZeroTolerance || to.ReverbSend > ZeroTolerance)
+        {
+            const float scale = 1.0f / (float)voice.Channels;
+            for (int32 input = 0; input < voice.Channels; input++)
+                MixRamp(ReverbBus, VoiceBus[input], from.ReverbSend * scale, to.ReverbSend * scale);
+        }
+    }
+
+    void Retire(Voice* voice, Buffer* buffer)
+    {
+        Retired retired;
+        retired.Voice = voice;
+        retired.Buffer = buffer;
+        RetiredObjects.Push(retired);
+    }
+
+    void QueueBuffer(Voice* voice, Buffer* buffer)
+    {
+        if (voice->QueueCount >= AUDIO_MAX_SOURCE_BUFFERS)
+            return;
+        if (voice->Processed == voice->QueueCount)
+        {
+            // Start the new buffer at the requested time
+            voice->Position = voice->StartTime * buffer->SampleRate;
+            voice->StartTime = 0.0f;
+        }
+        voice->Queue[voice->QueueCount++] = buffer;
+        voice->DecodedBuffer = nullptr;
+    }
+
+    void ProcessCommands()
+    {
+        Command command;
+        while (!RetiredObjects.IsFull() && Commands.Pop(command))
+        {
+            Voice* voice = command.Voice;
+            switch (command.Type)
+            {
+            case CommandType::AddVoice:
+                voice->Next = Voices;
+                if (Voices)
+                    Voices->Prev = voice;
+                Voices = voice;
+                break;
+            case CommandType::RemoveVoice:
+                if (voice->Prev)
+                    voice->Prev->Next = voice->Next;
+                else
+                    Voices = voice->Next;
+                if (voice->Next)
+                    voice->Next->Prev = voice->Prev;
+                Retire(voice, nullptr);
+                break;
+            case CommandType::Play:
+                voice->IsPlaying = true;
+                break;
+            case CommandType::Pause:
+                voice->IsPlaying = false;
+                break;
+            case CommandType::Stop:
+                voice->IsPlaying = false;
+                voice->QueueCount = 0;
+                voice->Processed = 0;
+                voice->Position = 0.0;
+                voice->StartTime = 0.0f;
+                Platform::MemoryClear(voice->History, sizeof(voice->History));
+                Platform::MemoryClear(voice->ShadowState, sizeof(voice->ShadowState));
+                break;
+            case CommandType::SetLooping:
+                voice->IsLooping = command.Value;
+                break;
+            case CommandType::SetStartTime:
+                if (voice->Processed < voice->QueueCount)
+                    voice->Position = Math::Max(command.Time, 0.0f) * voice->Queue[voice->Processed]->SampleRate;
+                else
+                    voice->StartTime = command.Time;
+                break;
+            case CommandType::SetMix:
+                voice->Target = command.Mix;
+                if (!voice->HasMix)
+                {
+                    voice->Current = command.Mix;
+                    voice->HasMix = true;
+                }
+                break;
+            case CommandType::SetBuffer:
+                if (voice->QueueCount == 1 && voice->Queue[0] == command.Buffer)
+                    break; // Already set (eg. when resuming paused source)
+                voice->QueueCount = 0;
+                voice->Processed = 0;
+                QueueBuffer(voice, command.Buffer);
+                break;
+            case CommandType::QueueBuffer:
+                QueueBuffer(voice, command.Buffer);
+                break;
+            case CommandType::DequeueBuffers:
+            {
+                const int32 count = Math::Min(command.Count, voice->Processed);
+                for (int32 i = count; i < voice->QueueCount; i++)
+                    voice->Queue[i - count] = voice->Queue[i];
+                voice->QueueCount -= count;
+                voice->Processed -= count;
+                break;
+            }
+            case CommandType::DeleteBuffer:
+                // Ensure that buffer is no longer used by the voices
+                for (Voice* v = Voices; v; v = v->Next)
+                {
+                    for (int32 i = 0; i < v->QueueCount; i++)
+                    {
+                        if (v->Queue[i] == command.Buffer)
+                        {
+                            v->IsPlaying = false;
+                            v->QueueCount = v->Processed = 0;
+                            break;
+                        }
+                    }
+                }
+                Retire(nullptr, command.Buffer);
+                break;
+            case CommandType::SetReverb:
+                Reverberation.Params = command.Reverb;
+                break;
+            }
+        }
+    }
+
+    void Mix()
+    {
+        PROFILE_CPU_NAMED("Audio.Mix");
+        Platform::MemoryClear(MasterBus, sizeof(MasterBus));
+        Platform::MemoryClear(ReverbBus, sizeof(ReverbBus));
+
+        // Mix voices
+        for (Voice* voice = Voices; voice; voice = voice->Next)
+        {
+            if (voice->IsPlaying && voice->HasMix)
+                MixVoice(*voice);
+            voice->Current = voice->Target;
+            Platform::AtomicStore(&voice->PublishedFrame, (int64)voice->Position);
+            Platform::AtomicStore(&voice->PublishedProcessed, voice->Processed);
+        }
+
+        // Process effects
+        float* master[SOFTWARE_AUDIO_CHANNELS] = { MasterBus[0], MasterBus[1] };
+        if (Reverberation.IsActive())
+            Reverberation.Process(ReverbBus, master, SOFTWARE_AUDIO_BLOCK_SIZE);
+        Limiter.Process(nullptr, master, SOFTWARE_AUDIO_BLOCK_SIZE);
+
+        // Convert into interleaved 16-bit output
+        for (int32 i = 0; i < SOFTWARE_AUDIO_BLOCK_SIZE; i++)
+        {
+            for (int32 channel = 0; channel < SOFTWARE_AUDIO_CHANNELS; channel++)
+                OutputBlock[i * SOFTWARE_AUDIO_CHANNELS + channel] = (int16)(Math::Clamp(MasterBus[channel][i], -1.0f, 1.0f) * MAX_int16);
+        }
+    }
+
+    int32 MixerThreadProc()
+    {
+        while (Platform::AtomicRead(&ExitFlag) == 0)
+        {
+            ProcessCommands();
+
+            // Keep the output device queue filled
+            int32 freeBlocks = Device->GetFreeBlocks();
+            while (freeBlocks-- > 0)
+            {
+                Mix();
+                Device->Submit(OutputBlock, SOFTWARE_AUDIO_BLOCK_SIZE);
+                ProcessCommands();
+            }
+
+            Platform::Sleep(1);
+        }
+        return 0;
+    }
+
+    bool DeleteRetired()
+    {
+        bool result = false;
+        Retired retired;
+        while (RetiredObjects.Pop(retired))
+        {
+            if (retired.Voice)
+                Delete(retired.Voice);
+            if (retired.Buffer)
+                Delete(retired.Buffer);
+            result = true;
+        }
+        return result;
+    }
+
+    void UpdateReverb()
+    {
+        // Blend reverb zones at the listener location
+        ReverbParams reverb = { 0.0f, 0.0f, 0.0f };
+        if (const Listener* listener = GetListener())
+        {
+            float totalWeight = 0.0f;
+            for (const AudioReverbZone* zone : Audio::ReverbZones)
+            {
+                const float weight = zone->GetBlendWeight(listener->Position);
+                if (weight <= ZeroTolerance)
+                    continue;
+                reverb.RoomSize += zone->RoomSize * weight;
+                reverb.Damping += zone->Damping * weight;
+                reverb.WetLevel += zone->WetLevel * weight;
+                totalWeight += weight;
+            }
+            if (totalWeight > 1.0f)
+            {
+                reverb.RoomSize /= totalWeight;
+                reverb.Damping /= totalWeight;
+                reverb.WetLevel /= totalWeight;
+            }
+            else if (totalWeight > ZeroTolerance)
+            {
+                // Keep the room parameters of the zone while fading out the effect
+                reverb.RoomSize /= totalWeight;
+                reverb.Damping /= totalWeight;
+            }
+        }
+        if (Platform::MemoryCompare(&reverb, &Reverb, sizeof(reverb)) != 0)
+        {
+            Reverb = reverb;
+            Command command;
+            command.Type = CommandType::SetReverb;
+            command.Voice = nullptr;
+            command.Reverb = reverb;
+            Send(command);
+        }
+    }
+}
+
+void AudioBackendSoftware::Listener_OnAdd(AudioListener* listener)
+{
+    SoftwareAudio::Listener* aListener = SoftwareAudio::GetListener(nullptr);
+    ASSERT(aListener);
+    aListener->AudioListener = listener;
+    aListener->UpdateTransform();
+    aListener->UpdateVelocity();
+    SoftwareAudio::MarkAllDirty();
+}
+
+void AudioBackendSoftware::Listener_OnRemove(AudioListener* listener)
+{
+    SoftwareAudio::Listener* aListener = SoftwareAudio::GetListener(listener);
+    if (aListener)
+    {
+        aListener->AudioListener = nullptr;
+        SoftwareAudio::MarkAllDirty();
+    }
+}
+
+void AudioBackendSoftware::Listener_VelocityChanged(AudioListener* listener)
+{
+    SoftwareAudio::Listener* aListener = SoftwareAudio::GetListener(listener);
+    if (aListener)
+    {
+        aListener->UpdateVelocity();
+        SoftwareAudio::MarkAllDirty();
+    }
+}
+
+void AudioBackendSoftware::Listener_TransformChanged(AudioListener* listener)
+{
+    SoftwareAudio::Listener* aListener = SoftwareAudio::GetListener(listener);
+    if (aListener)
+    {
+        aListener->UpdateTransform();
+        SoftwareAudio::MarkAllDirty();
+    }
+}
+
+void AudioBackendSoftware::Listener_ReinitializeAll()
+{
+    SoftwareAudio::EnableHRTF = Audio::GetEnableHRTF();
+    SoftwareAudio::MarkAllDirty();
+}
+
+void AudioBackendSoftware::Source_OnAdd(AudioSource* source)
+{
+    // Skip if has no clip (needs audio data to create a source - needs data format information)
+    if (source->Clip == nullptr || !source->Clip->IsLoaded())
+        return;
+    auto clip = source->Clip.Get();
+
+    // Get first free source
+    SoftwareAudio::Source* aSource = nullptr;
+    AUDIO_SOURCE_ID_TYPE sourceID = 0;
+    for (int32 i = 0; i < SoftwareAudio::Sources.Count(); i++)
+    {
+        if (SoftwareAudio::Sources[i].IsFree())
+        {
+            sourceID = i;
+            aSource = &SoftwareAudio::Sources[i];
+            break;
+        }
+    }
+    if (aSource == nullptr)
+    {
+        // Add new
+        sourceID = SoftwareAudio::Sources.Count();
+        SoftwareAudio::Sources.Add(SoftwareAudio::Source());
+        aSource = &SoftwareAudio::Sources[sourceID];
+    }
+    sourceID++; // 0 is invalid ID so shift them
+    source->SourceIDs.Add(sourceID);
+
+    // Prepare source state
+    aSource->Voice = New<SoftwareAudio::Voice>();
+    aSource->Channels = clip->Is3D() ? 1 : Math::Min<int32>(clip->AudioHeader.Info.NumChannels, SOFTWARE_AUDIO_CHANNELS); // 3d audio is always mono (AudioClip auto-converts before buffer write if FeatureFlags::SpatialMultiChannel is unset)
+    aSource->Voice->Channels = aSource->Channels;
+    aSource->Voice->IsLooping = source->GetIsLooping() && !clip->IsStreamable();
+    aSource->QueuedBuffers = 0;
+    aSource->IsDirty = true;
+    aSource->Is3D = source->Is3D();
+    aSource->Volume = source->GetVolume();
+    aSource->Pitch = source->GetPitch();
+    aSource->Pan = source->GetPan();
+    aSource->DopplerFactor = source->GetDopplerFactor();
+    aSource->MinDistance = source->GetMinDistance();
+    aSource->Attenuation = source->GetAttenuation();
+    aSource->UpdateTransform(source);
+    aSource->UpdateVelocity(source);
+    SoftwareAudio::Send(SoftwareAudio::CommandType::AddVoice, aSource->Voice);
+
+    source->Restore();
+}
+
+void AudioBackendSoftware::Source_OnRemove(AudioSource* source)
+{
+    source->Cleanup();
+}
+
+void AudioBackendSoftware::Source_VelocityChanged(AudioSource* source)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (aSource)
+    {
+        aSource->UpdateVelocity(source);
+        aSource->IsDirty = true;
+    }
+}
+
+void AudioBackendSoftware::Source_TransformChanged(AudioSource* source)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (aSource)
+    {
+        aSource->UpdateTransform(source);
+        aSource->IsDirty = true;
+    }
+}
+
+void AudioBackendSoftware::Source_UpdateBatch(const SourcesUpdate& update)
+{
+    for (int32 i = 0; i < update.Count(); i++)
+    {
+        AudioSource* source = update.Sources[i];
+        auto aSource = SoftwareAudio::GetSource(source);
+        if (!aSource)
+            continue;
+        const uint8 flags = update.Flags[i];
+        if (flags & SourcesUpdate::Transform)
+        {
+            aSource->Position = update.Positions[i];
+            aSource->Orientation = update.Orientations[i];
+            aSource->IsDirty = true;
+        }
+        if (flags & SourcesUpdate::Velocity)
+        {
+            aSource->Velocity = update.Velocities[i];
+            aSource->IsDirty = true;
+        }
+        if (flags & SourcesUpdate::Volume)
+            Source_VolumeChanged(source);
+        if (flags & SourcesUpdate::Pitch)
+            Source_PitchChanged(source);
+        if (flags & SourcesUpdate::Pan)
+            Source_PanChanged(source);
+    }
+}
+
+void AudioBackendSoftware::Source_VolumeChanged(AudioSource* source)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (aSource)
+    {
+        aSource->Volume = source->GetVolume();
+        aSource->IsDirty = true;
+    }
+}
+
+void AudioBackendSoftware::Source_PitchChanged(AudioSource* source)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (aSource)
+    {
+        aSource->Pitch = source->GetPitch();
+        aSource->IsDirty = true;
+    }
+}
+
+void AudioBackendSoftware::Source_PanChanged(AudioSource* source)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (aSource)
+    {
+        aSource->Pan = source->GetPan();
+        aSource->IsDirty = true;
+    }
+}
+
+void AudioBackendSoftware::Source_IsLoopingChanged(AudioSource* source)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (aSource)
+    {
+        // Streaming sources are looped by the AudioSource
+        SoftwareAudio::Command command;
+        command.Type = SoftwareAudio::CommandType::SetLooping;
+        command.Voice = aSource->Voice;
+        command.Value = source->GetIsLooping() && !source->UseStreaming();
+        SoftwareAudio::Send(command);
+    }
+}
+
+void AudioBackendSoftware::Source_SpatialSetupChanged(AudioSource* source)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (aSource)
+    {
+        aSource->Is3D = source->Is3D();
+        aSource->MinDistance = source->GetMinDistance();
+        aSource->Attenuation = source->GetAttenuation();
+        aSource->DopplerFactor = source->GetDopplerFactor();
+        aSource->IsDirty = true;
+    }
+}
+
+void AudioBackendSoftware::Source_ClipLoaded(AudioSource* source)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (!aSource)
+    {
+        // Register source if clip was missing
+        Source_OnAdd(source);
+    }
+}
+
+void AudioBackendSoftware::Source_Cleanup(AudioSource* source)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (!aSource)
+        return;
+
+    // Voice is deleted after audio thread stops using it
+    SoftwareAudio::Send(SoftwareAudio::CommandType::RemoveVoice, aSource->Voice);
+    aSource->Voice = nullptr;
+    aSource->QueuedBuffers = 0;
+}
+
+void AudioBackendSoftware::Source_Play(AudioSource* source)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (aSource)
+        SoftwareAudio::Send(SoftwareAudio::CommandType::Play, aSource->Voice);
+}
+
+void AudioBackendSoftware::Source_Pause(AudioSource* source)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (aSource)
+        SoftwareAudio::Send(SoftwareAudio::CommandType::Pause, aSource->Voice);
+}
+
+void AudioBackendSoftware::Source_Stop(AudioSource* source)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (aSource)
+    {
+        // Stop and unset buffers
+        SoftwareAudio::Send(SoftwareAudio::CommandType::Stop, aSource->Voice);
+        aSource->QueuedBuffers = 0;
+        Platform::AtomicStore(&aSource->Voice->PublishedProcessed, 0);
+        Platform::AtomicStore(&aSource->Voice->PublishedFrame, 0);
+    }
+}
+
+void AudioBackendSoftware::Source_SetCurrentBufferTime(AudioSource* source, float value)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (aSource)
+    {
+        SoftwareAudio::Command command;
+        command.Type = SoftwareAudio::CommandType::SetStartTime;
+        command.Voice = aSource->Voice;
+        command.Time = value;
+        SoftwareAudio::Send(command);
+    }
+}
+
+float AudioBackendSoftware::Source_GetCurrentBufferTime(const AudioSource* source)
+{
+    float time = 0;
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (aSource)
+    {
+        ASSERT(source->Clip && source->Clip->IsLoaded());
+        const auto& clipInfo = source->Clip->AudioHeader.Info;
+        const int64 frame = Platform::AtomicRead(&aSource->Voice->PublishedFrame);
+        time = (float)frame / (float)Math::Max(1U, clipInfo.SampleRate);
+    }
+    return time;
+}
+
+void AudioBackendSoftware::Source_SetNonStreamingBuffer(AudioSource* source)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (!aSource)
+        return;
+    SoftwareAudio::Command command;
+    command.Type = SoftwareAudio::CommandType::SetBuffer;
+    command.Voice = aSource->Voice;
+    command.Buffer = SoftwareAudio::GetBuffer(source->Clip->Buffers[0]);
+    SoftwareAudio::Send(command);
+    aSource->QueuedBuffers = 1;
+}
+
+void AudioBackendSoftware::Source_GetProcessedBuffersCount(AudioSource* source, int32& processedBuffersCount)
+{
+    processedBuffersCount = 0;
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (aSource)
+        processedBuffersCount = (int32)Platform::AtomicRead(&aSource->Voice->PublishedProcessed);
+}
+
+void AudioBackendSoftware::Source_GetQueuedBuffersCount(AudioSource* source, int32& queuedBuffersCount)
+{
+    queuedBuffersCount = 0;
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (aSource)
+        queuedBuffersCount = aSource->QueuedBuffers;
+}
+
+void AudioBackendSoftware::Source_QueueBuffer(AudioSource* source, uint32 bufferId)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (!aSource)
+        return;
+    SoftwareAudio::Command command;
+    command.Type = SoftwareAudio::CommandType::QueueBuffer;
+    command.Voice = aSource->Voice;
+    command.Buffer = SoftwareAudio::GetBuffer(bufferId);
+    SoftwareAudio::Send(command);
+    aSource->QueuedBuffers++;
+}
+
+void AudioBackendSoftware::Source_DequeueProcessedBuffers(AudioSource* source)
+{
+    auto aSource = SoftwareAudio::GetSource(source);
+    if (!aSource)
+        return;
+    const int32 processed = (int32)Platform::AtomicRead(&aSource->Voice->PublishedProcessed);
+    if (processed == 0)
+        return;
+    SoftwareAudio::Command command;
+    command.Type = SoftwareAudio::CommandType::DequeueBuffers;
+    command.Voice = aSource->Voice;
+    command.Count = processed;
+    SoftwareAudio::Send(command);
+    aSource->QueuedBuffers = Math::Max(aSource->QueuedBuffers - processed, 0);
+    Platform::AtomicStore(&aSource->Voice->PublishedProcessed, 0);
+}
+
+uint32 AudioBackendSoftware::Buffer_Create()
+{
+    ScopeLock lock(SoftwareAudio::Locker);
+
+    // Get first free buffer slot
+    auto aBuffer = New<SoftwareAudio::Buffer>();
+    for (int32 i = 0; i < SoftwareAudio::Buffers.Count(); i++)
+    {
+        if (SoftwareAudio::Buffers[i] == nullptr)
+        {
+            SoftwareAudio::Buffers[i] = aBuffer;
+            return i + 1;
+        }
+    }
+
+    // Add new slot
+    SoftwareAudio::Buffers.Add(aBuffer);
+    return SoftwareAudio::Buffers.Count();
+}
+
+void AudioBackendSoftware::Buffer_Delete(uint32 bufferId)
+{
+    ScopeLock lock(SoftwareAudio::Locker);
+    SoftwareAudio::Buffer*& aBuffer = SoftwareAudio::Buffers[bufferId - 1];
+
+    // Buffer is deleted after audio thread stops using it
+    SoftwareAudio::Command command;
+    command.Type = SoftwareAudio::CommandType::DeleteBuffer;
+    command.Voice = nullptr;
+    command.Buffer = aBuffer;
+    SoftwareAudio::Send(command);
+    aBuffer = nullptr;
+}
+
+void AudioBackendSoftware::Buffer_Write(uint32 bufferId, byte* samples, const AudioDataInfo& info)
+{
+    PROFILE_CPU();
+    CHECK(info.NumChannels <= SOFTWARE_AUDIO_CHANNELS);
+    SoftwareAudio::Buffer* aBuffer = SoftwareAudio::GetBuffer(bufferId);
+
+    if (info.BitDepth == 4)
+    {
+        // Keep IMA ADPCM data compressed and decode it during playback (buffer is not queued during write)
+        aBuffer->Samples.SetCapacity(0, false);
+        aBuffer->Compressed.Set(samples, (int32)AudioTool::GetADPCMSize(info.NumSamples / Math::Max(info.NumChannels, 1U), info.NumChannels));
+    }
+    else
+    {
+        // Convert samples into floats to be used by the mixer (buffer is not queued during write)
+        aBuffer->Compressed.SetCapacity(0, false);
+        aBuffer->Samples.Resize(info.NumSamples);
+        AudioTool::ConvertToFloat(samples, info.BitDepth, aBuffer->Samples.Get(), info.NumSamples);
+    }
+    aBuffer->Channels = (int32)Math::Max(info.NumChannels, 1U);
+    aBuffer->Frames = (int32)info.NumSamples / aBuffer->Channels;
+    aBuffer->SampleRate = (int32)info.SampleRate;
+}
+
+const Char* AudioBackendSoftware::Base_Name()
+{
+    return TEXT("Software");
+}
+
+AudioBackend::FeatureFlags AudioBackendSoftware::Base_Features()
+{
+    return FeatureFlags::ADPCM;
+}
+
+void AudioBackendSoftware::Base_OnActiveDeviceChanged()
+{
+}
+
+void AudioBackendSoftware::Base_SetDopplerFactor(float value)
+{
+    SoftwareAudio::Settings.DopplerFactor = value;
+    SoftwareAudio::MarkAllDirty();
+}
+
+void AudioBackendSoftware::Base_SetVolume(float value)
+{
+    SoftwareAudio::Settings.Volume = value;
+    SoftwareAudio::MarkAllDirty();
+}
+
+bool AudioBackendSoftware::Base_Init()
+{
+    auto& devices = Audio::Devices;
+
+    // Initialize output device
+#if AUDIO_API_OPENAL
+    SoftwareAudio::Device = New<SoftwareAudio::OpenALOutput>();
+    if (SoftwareAudio::Device->Init())
+    {
+        LOG(Warning, "Failed to initialize audio output device. Using null output.");
+        SoftwareAudio::Device->Dispose();
+        Delete(SoftwareAudio::Device);
+        SoftwareAudio::Device = nullptr;
+    }
+#endif
+    if (!SoftwareAudio::Device)
+    {
+        SoftwareAudio::Device = New<SoftwareAudio::NullOutput>();
+        SoftwareAudio::Device->Init();
+    }
+    SoftwareAudio::EnableHRTF = Audio::GetEnableHRTF();
+
+    // Start mixer thread
+    Platform::AtomicStore(&SoftwareAudio::ExitFlag, 0);
+    auto runnable = New<SimpleRunnable>(true);
+    runnable->OnWork.Bind(SoftwareAudio::MixerThreadProc);
+    SoftwareAudio::MixerThread = Thread::Create(runnable, TEXT("Audio Mixer"), ThreadPriority::Highest);
+    if (SoftwareAudio::MixerThread == nullptr)
+    {
+        LOG(Error, "Failed to spawn audio mixer thread.");
+        return true;
+    }
+    LOG(Info, "Software audio mixer: {0} channels at {1} kHz ({2})", SOFTWARE_AUDIO_CHANNELS, SOFTWARE_AUDIO_SAMPLE_RATE / 1000.0f, SoftwareAudio::Device->GetName());
+
+    // Dummy device
+    devices.Resize(1);
+    devices[0].Name = TEXT("Software mixer");
+    Audio::SetActiveDeviceIndex(0);
+
+    return false;
+}
+
+void AudioBackendSoftware::Base_Update()
+{
+    PROFILE_CPU();
+    SoftwareAudio::DeleteRetired();
+
+    // Update dirty voices
+    AudioBackendTools::Listener defaultListener;
+    defaultListener.Velocity = defaultListener.Position = Vector3::Zero;
+    defaultListener.Orientation = Quaternion::Identity;
+    const SoftwareAudio::Listener* listener = SoftwareAudio::GetListener();
+    const AudioBackendTools::Listener& mixListener = listener ? *(const AudioBackendTools::Listener*)listener : defaultListener;
+    const Transform listenerTransform(mixListener.Position, mixListener.Orientation);
+    float outputMatrix[SOFTWARE_AUDIO_CHANNELS * SOFTWARE_AUDIO_CHANNELS];
+    for (int32 i = 0; i < SoftwareAudio::Sources.Count(); i++)
+    {
+        auto& source = SoftwareAudio::Sources[i];
+        if (source.IsFree() || !(source.IsDirty || SoftwareAudio::ForceDirty))
+            continue;
+
+        auto mix = AudioBackendTools::CalculateSoundMix(SoftwareAudio::Settings, mixListener, source, SOFTWARE_AUDIO_CHANNELS);
+        SoftwareAudio::Command command;
+        command.Type = SoftwareAudio::CommandType::SetMix;
+        command.Voice = source.Voice;
+        SoftwareAudio::VoiceMix& voiceMix = command.Mix;
+        voiceMix.Pitch = mix.Pitch;
+        voiceMix.ReverbSend = source.Is3D ? mix.Volume : 0.0f;
+        mix.VolumeIntoChannels();
+        AudioBackendTools::MapChannels(source.Channels, SOFTWARE_AUDIO_CHANNELS, mix.Channels, outputMatrix);
+        for (int32 input = 0; input < SOFTWARE_AUDIO_CHANNELS; input++)
+        {
+            for (int32 output = 0; output < SOFTWARE_AUDIO_CHANNELS; output++)
+                voiceMix.Gains[input][output] = input < source.Channels ? outputMatrix[input * SOFTWARE_AUDIO_CHANNELS + output] : 0.0f;
+        }
+        voiceMix.HRTF = SoftwareAudio::EnableHRTF && source.Is3D && source.Channels == 1;
+        voiceMix.Delay[0] = voiceMix.Delay[1] = 0.0f;
+        voiceMix.Shadow[0] = voiceMix.Shadow[1] = 1.0f;
+        if (voiceMix.HRTF)
+        {
+            // Approximate the head-related transfer with the interaural time difference and the head shadow of the far ear
+            const Float3 direction = Float3::Normalize((Float3)listenerTransform.WorldToLocal(source.Position));
+            const float lateral = Math::Clamp(direction.X, -1.0f, 1.0f);
+            const int32 farEar = lateral > 0.0f ? 0 : 1;
+            voiceMix.Delay[farEar] = Math::Abs(lateral) * (SOFTWARE_AUDIO_HRTF_MAX_DELAY - 1);
+            voiceMix.Shadow[farEar] = 1.0f - Math::Abs(lateral) * 0.6f;
+        }
+        SoftwareAudio::Send(command);
+
+        source.IsDirty = false;
+    }
+    SoftwareAudio::ForceDirty = false;
+
+    SoftwareAudio::UpdateReverb();
+}
+
+void AudioBackendSoftware::Base_Dispose()
+{
+    // Stop mixer thread
+    if (SoftwareAudio::MixerThread)
+    {
+        Platform::AtomicStore(&SoftwareAudio::ExitFlag, 1);
+        SoftwareAudio::MixerThread->Join();
+        Delete(SoftwareAudio::MixerThread);
+        SoftwareAudio::MixerThread = nullptr;
+    }
+
+    // Cleanup stuff
+    if (SoftwareAudio::Device)
+    {
+        SoftwareAudio::Device->Dispose();
+        Delete(SoftwareAudio::Device);
+        SoftwareAudio::Device = nullptr;
+    }
+
+    // Flush pending commands (mixer thread is stopped)
+    do
+    {
+        SoftwareAudio::ProcessCommands();
+    } while (SoftwareAudio::DeleteRetired());
+    for (SoftwareAudio::Voice* voice = SoftwareAudio::Voices; voice;)
+    {
+        SoftwareAudio::Voice* next = voice->Next;
+        Delete(voice);
+        voice = next;
+    }
+    SoftwareAudio::Voices = nullptr;
+    for (int32 i = 0; i < SoftwareAudio::Sources.Count(); i++)
+        SoftwareAudio::Sources[i].Voice = nullptr;
+    for (int32 i = 0; i < SoftwareAudio::Buffers.Count(); i++)
+    {
+        if (SoftwareAudio::Buffers[i])
+            Delete(SoftwareAudio::Buffers[i]);
+    }
+    SoftwareAudio::Buffers.Clear();
+}
+
+#endif
@@ -7,6 +7,7 @@
 class Audio;
 class AudioClip;
 class AudioListener;
+class AudioReverbZone;
 class AudioSource;
 
 /// <summary>
@@ -23,6 +24,11 @@ API_ENUM() enum class AudioFormat
     /// The Vorbis data.
     /// </summary>
     Vorbis,
+
+    /// <summary>
+    /// The IMA ADPCM data (4-bits per sample). Fixed 4:1 compression ratio (compared to 16-bit PCM) with a very cheap decoding which allows to keep the compressed data in memory and decode it during playback.
+    /// </summary>
+    ADPCM,
 };
 
 /// <summary>
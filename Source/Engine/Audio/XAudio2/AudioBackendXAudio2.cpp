@@ -425,6 +425,35 @@ void AudioBackendXAudio2::Source_TransformChanged(AudioSource* source)
     }
 }
 
+void AudioBackendXAudio2::Source_UpdateBatch(const SourcesUpdate& update)
+{
+    for (int32 i = 0; i < update.Count(); i++)
+    {
+        AudioSource* source = update.Sources[i];
+        auto aSource = XAudio2::GetSource(source);
+        if (!aSource)
+            continue;
+        const uint8 flags = update.Flags[i];
+        if (flags & SourcesUpdate::Transform)
+        {
+            aSource->Position = update.Positions[i];
+            aSource->Orientation = update.Orientations[i];
+            aSource->IsDirty = true;
+        }
+        if (flags & SourcesUpdate::Velocity)
+        {
+            aSource->Velocity = update.Velocities[i];
+            aSource->IsDirty = true;
+        }
+        if (flags & SourcesUpdate::Volume)
+            Source_VolumeChanged(source);
+        if (flags & SourcesUpdate::Pitch)
+            Source_PitchChanged(source);
+        if (flags & SourcesUpdate::Pan)
+            Source_PanChanged(source);
+    }
+}
+
 void AudioBackendXAudio2::Source_VolumeChanged(AudioSource* source)
 {
     auto aSource = XAudio2::GetSource(source);
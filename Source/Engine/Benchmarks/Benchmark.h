@@ -0,0 +1,102 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Core/Collections/Array.h"
+
+/// <summary>
+/// Base class for the performance benchmarks. Each benchmark is registered statically and executed by the benchmarks runner multiple times to gather the stable timings statistics.
+/// </summary>
+class Benchmark
+{
+public:
+    /// <summary>
+    /// The benchmark name (unique, used to match the results with the baseline).
+    /// </summary>
+    const Char* Name;
+
+    /// <summary>
+    /// The amount of untimed runs executed before the measured ones (eg. to warm up the caches and pools).
+    /// </summary>
+    int32 WarmupRuns = 2;
+
+    /// <summary>
+    /// The amount of measured runs (overridden by the runner configuration if specified).
+    /// </summary>
+    int32 Runs = 10;
+
+protected:
+    Benchmark(const Char* name);
+
+public:
+    virtual ~Benchmark() = default;
+
+    /// <summary>
+    /// Gets all the registered benchmarks.
+    /// </summary>
+    static Array<Benchmark*>& GetAll();
+
+    /// <summary>
+    /// Consumes the value to prevent the compiler from optimizing out the benchmark code that computes it.
+    /// </summary>
+    static void Keep(uint64 value);
+
+public:
+    /// <summary>
+    /// Prepares the benchmark data (untimed).
+    /// </summary>
+    /// <returns>True if failed, otherwise false.</returns>
+    virtual bool Setup()
+    {
+        return false;
+    }
+
+    /// <summary>
+    /// Prepares the single run (untimed), eg. to reset the state modified by the previous run.
+    /// </summary>
+    virtual void BeforeRun()
+    {
+    }
+
+    /// <summary>
+    /// Executes the single run of the benchmark (timed).
+    /// </summary>
+    virtual void Run() = 0;
+
+    /// <summary>
+    /// Cleanups the single run (untimed).
+    /// </summary>
+    virtual void AfterRun()
+    {
+    }
+
+    /// <summary>
+    /// Releases the benchmark data (untimed).
+    /// </summary>
+    virtual void Teardown()
+    {
+    }
+};
+
+/// <summary>
+/// The timings statistics of the benchmark runs.
+/// </summary>
+struct BenchmarkStats
+{
+    int32 Runs = 0;
+    double MinMs = 0.0;
+    double MaxMs = 0.0;
+    double MeanMs = 0.0;
+    double MedianMs = 0.0;
+    double StdDevMs = 0.0;
+
+    /// <summary>
+    /// Calculates the statistics from the runs timings.
+    /// </summary>
+    /// <param name="samples">The timings of the runs (in milliseconds). Gets sorted.</param>
+    void Calculate(Array<double>& samples);
+};
+
+// Helper macro to register the benchmark class instance
+#define BENCHMARK_REGISTER(type) type type##Instance
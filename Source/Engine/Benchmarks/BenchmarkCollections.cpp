@@ -0,0 +1,193 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Benchmark.h"
+#include "Engine/Core/Collections/Dictionary.h"
+
+#define BENCHMARK_COLLECTIONS_ITEMS 100000
+
+class BenchmarkArrayAdd : public Benchmark
+{
+public:
+    Array<int32> Data;
+
+    BenchmarkArrayAdd()
+        : Benchmark(TEXT("Collections.Array.Add"))
+    {
+    }
+
+    void BeforeRun() override
+    {
+        Data.Clear();
+        Data.SetCapacity(0, false);
+    }
+
+    void Run() override
+    {
+        for (int32 i = 0; i < BENCHMARK_COLLECTIONS_ITEMS; i++)
+            Data.Add(i);
+        Keep(Data.Count());
+    }
+};
+
+class BenchmarkArrayIterate : public Benchmark
+{
+public:
+    Array<int32> Data;
+
+    BenchmarkArrayIterate()
+        : Benchmark(TEXT("Collections.Array.Iterate"))
+    {
+    }
+
+    bool Setup() override
+    {
+        Data.Resize(BENCHMARK_COLLECTIONS_ITEMS);
+        for (int32 i = 0; i < Data.Count(); i++)
+            Data[i] = i;
+        return false;
+    }
+
+    void Run() override
+    {
+        uint64 sum = 0;
+        for (int32 j = 0; j < 10; j++)
+        {
+            for (const int32 e : Data)
+                sum += e;
+        }
+        Keep(sum);
+    }
+
+    void Teardown() override
+    {
+        Data.Resize(0);
+    }
+};
+
+class BenchmarkArrayRemove : public Benchmark
+{
+public:
+    Array<int32> Data;
+
+    BenchmarkArrayRemove()
+        : Benchmark(TEXT("Collections.Array.Remove"))
+    {
+    }
+
+    void BeforeRun() override
+    {
+        Data.Resize(BENCHMARK_COLLECTIONS_ITEMS / 10);
+        for (int32 i = 0; i < Data.Count(); i++)
+            Data[i] = i;
+    }
+
+    void Run() override
+    {
+        // Remove items by value from the front (linear search and order preserving removal)
+        for (int32 i = 0; i < BENCHMARK_COLLECTIONS_ITEMS / 100; i++)
+            Data.RemoveKeepOrder(i);
+        while (Data.HasItems())
+            Data.RemoveAt(Data.Count() / 2);
+        Keep(Data.Count());
+    }
+};
+
+class BenchmarkDictionaryAdd : public Benchmark
+{
+public:
+    Dictionary<int32, int32> Data;
+
+    BenchmarkDictionaryAdd()
+        : Benchmark(TEXT("Collections.Dictionary.Add"))
+    {
+    }
+
+    void BeforeRun() override
+    {
+        Data.Clear();
+        Data.SetCapacity(0, false);
+    }
+
+    void Run() override
+    {
+        for (int32 i = 0; i < BENCHMARK_COLLECTIONS_ITEMS; i++)
+            Data.Add(i * 7, i);
+        Keep(Data.Count());
+    }
+};
+
+class BenchmarkDictionaryFind : public Benchmark
+{
+public:
+    Dictionary<int32, int32> Data;
+
+    BenchmarkDictionaryFind()
+        : Benchmark(TEXT("Collections.Dictionary.Find"))
+    {
+    }
+
+    bool Setup() override
+    {
+        Data.EnsureCapacity(BENCHMARK_COLLECTIONS_ITEMS);
+        for (int32 i = 0; i < BENCHMARK_COLLECTIONS_ITEMS; i++)
+            Data.Add(i * 7, i);
+        return false;
+    }
+
+    void Run() override
+    {
+        // Half of the lookups hit the existing keys
+        uint64 sum = 0;
+        for (int32 i = 0; i < BENCHMARK_COLLECTIONS_ITEMS * 2; i++)
+        {
+            int32 value;
+            if (Data.TryGet(i * 7 / 2, value))
+                sum += value;
+        }
+        Keep(sum);
+    }
+
+    void Teardown() override
+    {
+        Data.Clear();
+        Data.SetCapacity(0, false);
+    }
+};
+
+class BenchmarkDictionaryRemove : public Benchmark
+{
+public:
+    Dictionary<int32, int32> Data;
+
+    BenchmarkDictionaryRemove()
+        : Benchmark(TEXT("Collections.Dictionary.Remove"))
+    {
+    }
+
+    void BeforeRun() override
+    {
+        Data.EnsureCapacity(BENCHMARK_COLLECTIONS_ITEMS);
+        for (int32 i = 0; i < BENCHMARK_COLLECTIONS_ITEMS; i++)
+            Data.Add(i * 7, i);
+    }
+
+    void Run() override
+    {
+        for (int32 i = 0; i < BENCHMARK_COLLECTIONS_ITEMS; i++)
+            Data.Remove(i * 7);
+        Keep(Data.Count());
+    }
+
+    void Teardown() override
+    {
+        Data.Clear();
+        Data.SetCapacity(0, false);
+    }
+};
+
+BENCHMARK_REGISTER(BenchmarkArrayAdd);
+BENCHMARK_REGISTER(BenchmarkArrayIterate);
+BENCHMARK_REGISTER(BenchmarkArrayRemove);
+BENCHMARK_REGISTER(BenchmarkDictionaryAdd);
+BENCHMARK_REGISTER(BenchmarkDictionaryFind);
+BENCHMARK_REGISTER(BenchmarkDictionaryRemove);
@@ -0,0 +1,81 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Benchmark.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Threading/JobSystem.h"
+
+namespace
+{
+    int64 volatile JobsCounter = 0;
+
+    void EmptyJob(int32 index)
+    {
+        Platform::InterlockedIncrement(&JobsCounter);
+    }
+}
+
+class BenchmarkJobSystemDispatch : public Benchmark
+{
+public:
+    BenchmarkJobSystemDispatch()
+        : Benchmark(TEXT("JobSystem.Dispatch"))
+    {
+    }
+
+    void Run() override
+    {
+        // Many small batches (typical per-system jobs dispatch overhead)
+        Function<void(int32)> job(EmptyJob);
+        for (int32 i = 0; i < 1000; i++)
+        {
+            const int64 label = JobSystem::Dispatch(job, 16);
+            JobSystem::Wait(label);
+        }
+        Keep(Platform::AtomicRead(&JobsCounter));
+    }
+};
+
+class BenchmarkJobSystemDispatchLarge : public Benchmark
+{
+public:
+    Array<float> Data;
+
+    BenchmarkJobSystemDispatchLarge()
+        : Benchmark(TEXT("JobSystem.DispatchLarge"))
+    {
+    }
+
+    bool Setup() override
+    {
+        Data.Resize(1024 * 1024);
+        for (int32 i = 0; i < Data.Count(); i++)
+            Data[i] = (float)i;
+        return false;
+    }
+
+    void Run() override
+    {
+        // Single large batch of short jobs (job scheduling throughput)
+        float* data = Data.Get();
+        const int32 count = Data.Count();
+        Function<void(int32)> job = [data, count](int32 index)
+        {
+            const int32 start = index * 1024;
+            const int32 end = Math::Min(start + 1024, count);
+            for (int32 i = start; i < end; i++)
+                data[i] = data[i] * 0.5f + 1.0f;
+        };
+        const int64 label = JobSystem::Dispatch(job, Math::DivideAndRoundUp(count, 1024));
+        JobSystem::Wait(label);
+        Keep((uint64)data[count / 2]);
+    }
+
+    void Teardown() override
+    {
+        Data.Resize(0);
+    }
+};
+
+BENCHMARK_REGISTER(BenchmarkJobSystemDispatch);
+BENCHMARK_REGISTER(BenchmarkJobSystemDispatchLarge);
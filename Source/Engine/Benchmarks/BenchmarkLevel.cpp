@@ -0,0 +1,175 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Benchmark.h"
+#include "Engine/Core/Math/Matrix.h"
+#include "Engine/Core/Types/DataContainer.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Level/Level.h"
+#include "Engine/Level/Scene/Scene.h"
+#include "Engine/Renderer/RenderList.h"
+#include "Engine/Serialization/JsonWriters.h"
+#include "FlaxEngine.Gen.h"
+
+// The size of the standard benchmark scene grid (amount of actors per axis)
+#define BENCHMARK_SCENE_GRID 100
+
+// The spacing of the standard benchmark scene actors (in world units)
+#define BENCHMARK_SCENE_SPACING 500.0f
+
+namespace
+{
+    // Generates the standard benchmark scene with a grid of point lights (actors registered for scene rendering) using deterministic objects IDs
+    void GenerateScene(Array<byte>& output)
+    {
+        const Guid sceneId(0xbe4c0001, 0, 0, 1);
+        rapidjson_flax::StringBuffer buffer;
+        CompactJsonWriter writerImpl(buffer);
+        JsonWriter& writer = writerImpl;
+        writer.StartObject();
+        writer.JKEY("ID");
+        writer.Guid(sceneId);
+        writer.JKEY("TypeName");
+        writer.String("FlaxEngine.SceneAsset");
+        writer.JKEY("EngineBuild");
+        writer.Int(FLAXENGINE_VERSION_BUILD);
+        writer.JKEY("Data");
+        writer.StartArray();
+        {
+            writer.StartObject();
+            writer.JKEY("ID");
+            writer.Guid(sceneId);
+            writer.JKEY("TypeName");
+            writer.String("FlaxEngine.Scene");
+            writer.JKEY("Name");
+            writer.String("Benchmark Scene");
+            writer.EndObject();
+        }
+        const float offset = BENCHMARK_SCENE_GRID * BENCHMARK_SCENE_SPACING * -0.5f;
+        for (int32 z = 0; z < BENCHMARK_SCENE_GRID; z++)
+        {
+            for (int32 x = 0; x < BENCHMARK_SCENE_GRID; x++)
+            {
+                writer.StartObject();
+                writer.JKEY("ID");
+                writer.Guid(Guid(sceneId.A, 1, (uint32)x, (uint32)z));
+                writer.JKEY("TypeName");
+                writer.String("FlaxEngine.PointLight");
+                writer.JKEY("ParentID");
+                writer.Guid(sceneId);
+                writer.JKEY("Name");
+                writer.String("Light");
+                writer.JKEY("Transform");
+                writer.Transform(Transform(Vector3(offset + x * BENCHMARK_SCENE_SPACING, (float)((x * 7 + z * 13) % 10) * 100.0f, offset + z * BENCHMARK_SCENE_SPACING)));
+                writer.JKEY("Radius");
+                writer.Float(BENCHMARK_SCENE_SPACING * 0.5f);
+                writer.EndObject();
+            }
+        }
+        writer.EndArray();
+        writer.EndObject();
+        output.Set((const byte*)buffer.GetString(), (int32)buffer.GetSize());
+    }
+}
+
+class BenchmarkSceneLoad : public Benchmark
+{
+public:
+    Array<byte> SceneData;
+    Array<byte> Data;
+    Scene* LoadedScene = nullptr;
+
+    BenchmarkSceneLoad()
+        : Benchmark(TEXT("Level.SceneLoad"))
+    {
+        Runs = 5;
+    }
+
+    bool Setup() override
+    {
+        GenerateScene(SceneData);
+        return false;
+    }
+
+    void BeforeRun() override
+    {
+        // Scene data is parsed in-situ so use a fresh copy for each run
+        Data.Set(SceneData.Get(), SceneData.Count());
+    }
+
+    void Run() override
+    {
+        BytesContainer data;
+        data.Link(Data.Get(), Data.Count());
+        LoadedScene = Level::LoadSceneFromBytes(data);
+    }
+
+    void AfterRun() override
+    {
+        if (LoadedScene)
+            Level::UnloadScene(LoadedScene);
+        LoadedScene = nullptr;
+    }
+
+    void Teardown() override
+    {
+        SceneData.Resize(0);
+        Data.Resize(0);
+    }
+};
+
+class BenchmarkSceneCulling : public Benchmark
+{
+public:
+    Scene* LoadedScene = nullptr;
+    RenderList* List = nullptr;
+
+    BenchmarkSceneCulling()
+        : Benchmark(TEXT("Level.SceneRenderingCulling"))
+    {
+    }
+
+    bool Setup() override
+    {
+        Array<byte> sceneData;
+        GenerateScene(sceneData);
+        BytesContainer data;
+        data.Link(sceneData.Get(), sceneData.Count());
+        LoadedScene = Level::LoadSceneFromBytes(data);
+        List = RenderList::GetFromPool();
+        return LoadedScene == nullptr;
+    }
+
+    void Run() override
+    {
+        // Rotate the camera around the scene center to cull against the different frustums (depth pass doesn't submit any lights so it measures culling only)
+        RenderContext renderContext;
+        renderContext.List = List;
+        renderContext.View.Pass = DrawPass::Depth;
+        Matrix projection;
+        Matrix::PerspectiveFov(60.0f * DegreesToRadians, 16.0f / 9.0f, 10.0f, 40000.0f, projection);
+        const Float3 position(0.0f, 500.0f, 0.0f);
+        for (int32 i = 0; i < 100; i++)
+        {
+            const float angle = (float)i / 100.0f * TWO_PI;
+            Matrix view;
+            Matrix::LookAt(position, position + Float3(Math::Sin(angle), -0.2f, Math::Cos(angle)), Float3::Up, view);
+            renderContext.View.Position = position;
+            renderContext.View.SetUp(view, projection);
+            RenderContextBatch renderContextBatch(renderContext);
+            LoadedScene->Rendering.Draw(renderContextBatch, SceneRendering::SceneDraw);
+        }
+    }
+
+    void Teardown() override
+    {
+        if (List)
+            RenderList::ReturnToPool(List);
+        List = nullptr;
+        if (LoadedScene)
+            Level::UnloadScene(LoadedScene);
+        LoadedScene = nullptr;
+    }
+};
+
+BENCHMARK_REGISTER(BenchmarkSceneLoad);
+BENCHMARK_REGISTER(BenchmarkSceneCulling);
@@ -0,0 +1,291 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#if PLATFORM_WINDOWS || PLATFORM_LINUX || PLATFORM_MAC
+
+#include "Benchmark.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Engine/EngineService.h"
+#include "Engine/Engine/CommandLine.h"
+#include "Engine/Engine/Globals.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Platform/FileSystem.h"
+#include "Engine/Scripting/Scripting.h"
+#include "Engine/Serialization/Json.h"
+#include "Engine/Serialization/JsonTools.h"
+#include "Engine/Serialization/JsonWriters.h"
+#include "Editor/Scripting/ScriptsBuilder.h"
+#include "FlaxEngine.Gen.h"
+
+// Headless benchmarks runner (configure with: -benchmarks "filter=Collections,runs=20,warmup=2,output=Benchmarks.json,baseline=BenchmarksBaseline.json,threshold=10").
+class BenchmarksRunnerService : public EngineService
+{
+public:
+    struct Config
+    {
+        String Filter;
+        int32 Runs = 0;
+        int32 WarmupRuns = -1;
+        float Threshold = 10.0f;
+        String Output = TEXT("Benchmarks.json");
+        String Baseline;
+    };
+
+    BenchmarksRunnerService()
+        : EngineService(TEXT("BenchmarksRunnerService"), 10000)
+    {
+    }
+
+    bool ParseConfig(const String& text, Config& config);
+    int32 Run(const Config& config);
+    void Update() override;
+};
+
+BenchmarksRunnerService BenchmarksRunnerServiceInstance;
+volatile uint64 BenchmarkSink = 0;
+
+Benchmark::Benchmark(const Char* name)
+    : Name(name)
+{
+    GetAll().Add(this);
+}
+
+Array<Benchmark*>& Benchmark::GetAll()
+{
+    static Array<Benchmark*> benchmarks;
+    return benchmarks;
+}
+
+void Benchmark::Keep(uint64 value)
+{
+    BenchmarkSink = BenchmarkSink + value;
+}
+
+void BenchmarkStats::Calculate(Array<double>& samples)
+{
+    Runs = samples.Count();
+    if (Runs == 0)
+        return;
+    Sorting::QuickSort(samples);
+    MinMs = samples.First();
+    MaxMs = samples.Last();
+    MedianMs = Runs % 2 == 0 ? (samples[Runs / 2 - 1] + samples[Runs / 2]) * 0.5 : samples[Runs / 2];
+    double sum = 0.0;
+    for (const double sample : samples)
+        sum += sample;
+    MeanMs = sum / Runs;
+    double variance = 0.0;
+    for (const double sample : samples)
+        variance += (sample - MeanMs) * (sample - MeanMs);
+    StdDevMs = Math::Sqrt(variance / Runs);
+}
+
+bool BenchmarksRunnerService::ParseConfig(const String& text, Config& config)
+{
+    Array<String> entries;
+    text.Split(',', entries);
+    for (const String& entry : entries)
+    {
+        const int32 separator = entry.Find('=');
+        if (separator == -1)
+            continue;
+        const String key = entry.Left(separator).TrimTrailing();
+        const String value = entry.Substring(separator + 1).TrimTrailing();
+        bool failed = false;
+        if (key == TEXT("filter"))
+            config.Filter = value;
+        else if (key == TEXT("runs"))
+            failed = StringUtils::Parse(value.Get(), &config.Runs);
+        else if (key == TEXT("warmup"))
+            failed = StringUtils::Parse(value.Get(), &config.WarmupRuns);
+        else if (key == TEXT("threshold"))
+            failed = StringUtils::Parse(value.Get(), &config.Threshold);
+        else if (key == TEXT("output"))
+            config.Output = value;
+        else if (key == TEXT("baseline"))
+            config.Baseline = value;
+        else
+            LOG(Warning, "Unknown benchmarks option '{0}'.", key);
+        if (failed)
+        {
+            LOG(Error, "Invalid benchmarks option value '{0}'.", entry);
+            return true;
+        }
+    }
+    if (config.Runs < 0 || config.Threshold < 0.0f)
+    {
+        LOG(Error, "Invalid benchmarks configuration.");
+        return true;
+    }
+    return false;
+}
+
+int32 BenchmarksRunnerService::Run(const Config& config)
+{
+    // Load baseline results to compare against
+    rapidjson_flax::Document baseline;
+    bool hasBaseline = false;
+    if (config.Baseline.HasChars())
+    {
+        const String path = FileSystem::IsRelative(config.Baseline) ? Globals::ProjectFolder / config.Baseline : config.Baseline;
+        Array<byte> data;
+        if (File::ReadAllBytes(path, data))
+        {
+            LOG(Error, "Failed to load benchmarks baseline from {0}", path);
+            return -1;
+        }
+        baseline.Parse((const char*)data.Get(), data.Count());
+        if (baseline.HasParseError() || !baseline.IsObject() || !baseline.HasMember("Benchmarks"))
+        {
+            LOG(Error, "Invalid benchmarks baseline file {0}", path);
+            return -1;
+        }
+        hasBaseline = true;
+    }
+
+    // Run benchmarks
+    rapidjson_flax::StringBuffer buffer;
+    PrettyJsonWriter writer(buffer);
+    writer.StartObject();
+    writer.JKEY("EngineBuild");
+    writer.Int(FLAXENGINE_VERSION_BUILD);
+    writer.JKEY("Platform");
+    const StringAnsi platformName(ToString(PLATFORM_TYPE));
+    writer.String(platformName.Get(), platformName.Length());
+    writer.JKEY("Benchmarks");
+    writer.StartObject();
+    int32 failedCount = 0, regressionsCount = 0;
+    Array<double> samples;
+    for (Benchmark* benchmark : Benchmark::GetAll())
+    {
+        const String name(benchmark->Name);
+        if (config.Filter.HasChars() && !name.Contains(config.Filter, StringSearchCase::IgnoreCase))
+            continue;
+        LOG(Info, "Running benchmark {0}...", name);
+        if (benchmark->Setup())
+        {
+            LOG(Error, "Failed to setup benchmark {0}", name);
+            benchmark->Teardown();
+            failedCount++;
+            continue;
+        }
+        const int32 warmupRuns = config.WarmupRuns >= 0 ? config.WarmupRuns : benchmark->WarmupRuns;
+        const int32 runs = config.Runs > 0 ? config.Runs : benchmark->Runs;
+        for (int32 i = 0; i < warmupRuns; i++)
+        {
+            benchmark->BeforeRun();
+            benchmark->Run();
+            benchmark->AfterRun();
+        }
+        samples.Clear();
+        for (int32 i = 0; i < runs; i++)
+        {
+            benchmark->BeforeRun();
+            const double startTime = Platform::GetTimeSeconds();
+            benchmark->Run();
+            samples.Add((Platform::GetTimeSeconds() - startTime) * 1000.0);
+            benchmark->AfterRun();
+        }
+        benchmark->Teardown();
+        BenchmarkStats stats;
+        stats.Calculate(samples);
+        LOG(Info, "{0}: median {1} ms, mean {2} ms, min {3} ms, max {4} ms, stddev {5} ms", name, stats.MedianMs, stats.MeanMs, stats.MinMs, stats.MaxMs, stats.StdDevMs);
+
+        const StringAnsi nameAnsi(name);
+        writer.Key(nameAnsi.Get(), nameAnsi.Length());
+        writer.StartObject();
+        writer.JKEY("Runs");
+        writer.Int(stats.Runs);
+        writer.JKEY("MedianMs");
+        writer.Double(stats.MedianMs);
+        writer.JKEY("MeanMs");
+        writer.Double(stats.MeanMs);
+        writer.JKEY("MinMs");
+        writer.Double(stats.MinMs);
+        writer.JKEY("MaxMs");
+        writer.Double(stats.MaxMs);
+        writer.JKEY("StdDevMs");
+        writer.Double(stats.StdDevMs);
+
+        // Compare median time against the baseline (more robust to the outliers than mean)
+        if (hasBaseline)
+        {
+            const auto& baselineBenchmarks = baseline["Benchmarks"];
+            const auto member = baselineBenchmarks.FindMember(nameAnsi.Get());
+            if (member != baselineBenchmarks.MemberEnd() && member->value.IsObject())
+            {
+                const double baselineMedian = JsonTools::GetFloat(member->value, "MedianMs", 0.0f);
+                const double change = baselineMedian > ZeroTolerance ? (stats.MedianMs - baselineMedian) / baselineMedian * 100.0 : 0.0;
+                writer.JKEY("BaselineMedianMs");
+                writer.Double(baselineMedian);
+                writer.JKEY("ChangePercent");
+                writer.Double(change);
+                if (change > config.Threshold)
+                {
+                    LOG(Error, "Benchmark {0} regressed by {1}% (baseline median {2} ms)", name, (float)change, baselineMedian);
+                    regressionsCount++;
+                }
+                else if (change < -config.Threshold)
+                {
+                    LOG(Info, "Benchmark {0} improved by {1}% (baseline median {2} ms)", name, (float)-change, baselineMedian);
+                }
+            }
+            else
+            {
+                LOG(Warning, "Benchmark {0} is missing in the baseline", name);
+            }
+        }
+
+        writer.EndObject();
+    }
+    writer.EndObject();
+    writer.JKEY("Failed");
+    writer.Int(failedCount);
+    writer.JKEY("Regressions");
+    writer.Int(regressionsCount);
+    writer.EndObject();
+
+    // Write results
+    const String path = FileSystem::IsRelative(config.Output) ? Globals::ProjectFolder / config.Output : config.Output;
+    if (File::WriteAllBytes(path, (byte*)buffer.GetString(), (int32)buffer.GetSize()))
+    {
+        LOG(Error, "Failed to save benchmarks results to {0}", path);
+        return -1;
+    }
+    LOG(Info, "Benchmarks results saved to {0}", path);
+    return failedCount + regressionsCount;
+}
+
+void BenchmarksRunnerService::Update()
+{
+    // End if failed to perform a startup
+    if (ScriptsBuilder::LastCompilationFailed())
+    {
+        Engine::RequestExit(-1);
+        return;
+    }
+
+    // Wait for Editor to be ready for running benchmarks (eg. scripting loaded)
+    if (!ScriptsBuilder::IsReady() ||
+        !Scripting::IsEveryAssemblyLoaded() ||
+        !Scripting::HasGameModulesLoaded())
+        return;
+
+    // Runs benchmarks
+    Log::Logger::WriteFloor();
+    LOG(Info, "Running Flax Benchmarks...");
+    Config config;
+    int32 result = -1;
+    if (!ParseConfig(CommandLine::Options.Benchmarks.HasValue() ? CommandLine::Options.Benchmarks.GetValue() : String::Empty, config))
+        result = Run(config);
+    if (result == 0)
+        LOG(Info, "Result: {0}", result);
+    else
+        LOG(Error, "Result: {0}", result);
+    Log::Logger::WriteFloor();
+    Engine::RequestExit(result);
+}
+
+#endif
@@ -0,0 +1,69 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Benchmark.h"
+#include "Engine/Level/Actors/EmptyActor.h"
+#include "Engine/Networking/NetworkReplicator.h"
+#include "Engine/Networking/NetworkStream.h"
+#include "Engine/Networking/Components/NetworkTransform.h"
+
+// The amount of the replicated objects
+#define BENCHMARK_NETWORK_OBJECTS 1000
+
+class BenchmarkReplicatorSerialization : public Benchmark
+{
+public:
+    Array<EmptyActor*> Actors;
+    Array<NetworkTransform*> Transforms;
+    NetworkStream* WriteStream = nullptr;
+    NetworkStream* ReadStream = nullptr;
+
+    BenchmarkReplicatorSerialization()
+        : Benchmark(TEXT("Networking.ReplicatorSerialization"))
+    {
+    }
+
+    bool Setup() override
+    {
+        WriteStream = New<NetworkStream>();
+        ReadStream = New<NetworkStream>();
+        for (int32 i = 0; i < BENCHMARK_NETWORK_OBJECTS; i++)
+        {
+            auto actor = New<EmptyActor>();
+            actor->SetPosition(Vector3((float)i, (float)(i % 10), (float)(i % 100)));
+            auto transform = New<NetworkTransform>();
+            transform->SetParent(actor);
+            Actors.Add(actor);
+            Transforms.Add(transform);
+        }
+        return false;
+    }
+
+    void Run() override
+    {
+        // Serialize all objects into a single stream and deserialize them back (as replicator does for the objects state sync)
+        const ScriptingTypeHandle type = NetworkTransform::TypeInitializer;
+        WriteStream->Initialize(BENCHMARK_NETWORK_OBJECTS * 64);
+        for (NetworkTransform* transform : Transforms)
+            NetworkReplicator::InvokeSerializer(type, transform, WriteStream, true);
+        const uint32 length = WriteStream->GetPosition();
+        ReadStream->Initialize(WriteStream->GetBuffer(), length);
+        for (NetworkTransform* transform : Transforms)
+            NetworkReplicator::InvokeSerializer(type, transform, ReadStream, false);
+        Keep(length);
+    }
+
+    void Teardown() override
+    {
+        for (EmptyActor* actor : Actors)
+            actor->DeleteObjectNow();
+        Actors.Clear();
+        Transforms.Clear();
+        if (ReadStream)
+            ReadStream->DeleteObjectNow();
+        if (WriteStream)
+            WriteStream->DeleteObjectNow();
+        ReadStream = WriteStream = nullptr;
+    }
+};
+
+BENCHMARK_REGISTER(BenchmarkReplicatorSerialization);
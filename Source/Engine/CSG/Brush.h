@@ -50,10 +50,10 @@ namespace CSG
         Surface(const Surface& plane)
             : Plane(plane)
             , Material(plane.Material)
-            , TexCoordScale(1)
-            , TexCoordOffset(0.0f)
-            , TexCoordRotation(0)
-            , ScaleInLightmap(1)
+            , TexCoordScale(plane.TexCoordScale)
+            , TexCoordOffset(plane.TexCoordOffset)
+            , TexCoordRotation(plane.TexCoordRotation)
+            , ScaleInLightmap(plane.ScaleInLightmap)
         {
         }
 
@@ -18,6 +18,7 @@
 #include "Engine/Engine/Engine.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Serialization/MemoryWriteStream.h"
+#include "Engine/Threading/JobSystem.h"
 #if USE_EDITOR
 #include "Editor/Editor.h"
 #endif
@@ -33,9 +34,23 @@ struct BuildData;
 
 namespace CSGBuilderImpl
 {
+    /// <summary>
+    /// The cached CSG mesh built for the brush (reused by the next builds if the brush has not been modified).
+    /// </summary>
+    struct BrushMeshCache
+    {
+        Scene* BrushScene;
+        Mode BrushMode;
+        Array<Surface> Surfaces;
+        CSG::Mesh Mesh;
+        bool Used;
+    };
+
     Array<Scene*> ScenesToRebuild;
+    Dictionary<Guid, BrushMeshCache*> BrushMeshes;
 
     void onSceneUnloading(Scene* scene, const Guid& sceneId);
+    void buildMeshes(Scene* scene, const Array<Actor*>& actors, const Array<CSG::Mesh*>& meshes);
     bool buildInner(Scene* scene, BuildData& data);
     void build(Scene* scene);
     bool generateRawDataAsset(Scene* scene, RawData& meshData, Guid& assetId, const String& assetPath);
@@ -63,6 +78,14 @@ void CSGBuilderImpl::onSceneUnloading(Scene* scene, const Guid& sceneId)
 {
     // Ensure to remove scene (prevent crashes)
     ScenesToRebuild.Remove(scene);
+    for (auto i = BrushMeshes.Begin(); i.IsNotEnd(); ++i)
+    {
+        if (i->Value->BrushScene == scene)
+        {
+            Delete(i->Value);
+            BrushMeshes.Remove(i);
+        }
+    }
 }
 
 bool CSGBuilderService::Init()
@@ -132,9 +155,8 @@ namespace CSG
                 // Skip subtract/common meshes from the beginning (they have no effect)
                 if (meshes.Count() > 0 || brush->GetBrushMode() == Mode::Additive)
                 {
-                    // Create new mesh and build for given brush
+                    // Create new mesh for given brush (built later)
                     auto mesh = New<CSG::Mesh>();
-                    mesh->Build(brush);
 
                     // Save results
                     meshes.Add(mesh);
@@ -250,16 +272,106 @@ struct BuildData
     }
 };
 
+namespace
+{
+    bool SurfacesEqual(const Array<Surface>& a, const Array<Surface>& b)
+    {
+        if (a.Count() != b.Count())
+            return false;
+        for (int32 i = 0; i < a.Count(); i++)
+        {
+            const Surface& sa = a[i];
+            const Surface& sb = b[i];
+            if (sa.Normal != sb.Normal || sa.D != sb.D || sa.Material != sb.Material || sa.TexCoordScale != sb.TexCoordScale || sa.TexCoordOffset != sb.TexCoordOffset || sa.TexCoordRotation != sb.TexCoordRotation || sa.ScaleInLightmap != sb.ScaleInLightmap)
+                return false;
+        }
+        return true;
+    }
+}
+
+void CSGBuilderImpl::buildMeshes(Scene* scene, const Array<Actor*>& actors, const Array<CSG::Mesh*>& meshes)
+{
+    // Resolve the cache entries for all brushes
+    Array<BrushMeshCache*> entries;
+    entries.Resize(actors.Count());
+    for (int32 i = 0; i < actors.Count(); i++)
+    {
+        const Guid id = dynamic_cast<Brush*>(actors[i])->GetBrushID();
+        BrushMeshCache* entry;
+        if (!BrushMeshes.TryGet(id, entry))
+        {
+            entry = New<BrushMeshCache>();
+            entry->BrushScene = scene;
+            entry->BrushMode = Mode::Additive;
+            BrushMeshes.Add(id, entry);
+        }
+        entry->Used = true;
+        entries[i] = entry;
+    }
+
+    // Build meshes in parallel (each brush is independent), reuse the cached mesh if the brush has not been modified since the last build
+    JobSystem::ParallelFor(actors.Count(), [&](int32 start, int32 end)
+    {
+        Array<Surface> surfaces;
+        for (int32 i = start; i < end; i++)
+        {
+            auto brush = dynamic_cast<Brush*>(actors[i]);
+            auto entry = entries[i];
+            const Mode mode = brush->GetBrushMode();
+            surfaces.Clear();
+            brush->GetSurfaces(surfaces);
+            if (entry->BrushMode == mode && entry->Surfaces.HasItems() && SurfacesEqual(entry->Surfaces, surfaces))
+            {
+                *meshes[i] = entry->Mesh;
+                continue;
+            }
+            meshes[i]->Build(brush);
+            entry->BrushMode = mode;
+            entry->Surfaces = surfaces;
+            entry->Mesh = *meshes[i];
+        }
+    }, 16);
+
+    // Remove the cached meshes of the brushes that no longer exist in the scene
+    for (auto i = BrushMeshes.Begin(); i.IsNotEnd(); ++i)
+    {
+        auto entry = i->Value;
+        if (entry->BrushScene != scene)
+            continue;
+        if (entry->Used)
+        {
+            entry->Used = false;
+            continue;
+        }
+        Delete(entry);
+        BrushMeshes.Remove(i);
+    }
+}
+
 bool CSGBuilderImpl::buildInner(Scene* scene, BuildData& data)
 {
-    // Setup CSG meshes list and build them
+    // Setup CSG meshes list for the scene brushes
     {
         Function<bool(Actor*, MeshesArray&, MeshesLookup&)> treeWalkFunction(walkTree);
-        SceneQuery::TreeExecute<Array<CSG::Mesh*>&, MeshesLookup&>(treeWalkFunction, data.meshes, data.cache);
+        scene->TreeExecute<Array<CSG::Mesh*>&, MeshesLookup&>(treeWalkFunction, data.meshes, data.cache);
     }
     if (data.meshes.IsEmpty())
         return false;
 
+    // Build meshes for the brushes
+    {
+        Array<Actor*> actors;
+        Array<CSG::Mesh*> meshes;
+        actors.EnsureCapacity(data.cache.Count());
+        meshes.EnsureCapacity(data.cache.Count());
+        for (auto i = data.cache.Begin(); i.IsNotEnd(); ++i)
+        {
+            actors.Add(i->Key);
+            meshes.Add(i->Value);
+        }
+        buildMeshes(scene, actors, meshes);
+    }
+
     // Process all meshes (performs actual CSG opterations on geometry in tree structure)
     CSG::Mesh* combinedMesh = Combine(scene, data.cache);
     if (combinedMesh == nullptr)
@@ -10,8 +10,9 @@
 #include "Engine/Engine/Engine.h"
 #include "Engine/Threading/Threading.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Threading/MainThreadTask.h"
-#include "Engine/Threading/ConcurrentTaskQueue.h"
+#include "Loading/ContentLoadTaskQueue.h"
 #include "Engine/Scripting/ManagedCLR/MCore.h"
 
 AssetReferenceBase::~AssetReferenceBase()
@@ -378,7 +379,7 @@ void Asset::Reload()
 
 namespace ContentLoadingManagerImpl
 {
-    extern ConcurrentTaskQueue<ContentLoadTask> Tasks;
+    extern ContentLoadTaskQueue Tasks;
 };
 
 bool Asset::WaitForLoaded(double timeoutInMilliseconds) const
@@ -585,6 +586,32 @@ bool Asset::IsInternalType() const
     return false;
 }
 
+#if COMPILE_WITH_PROFILER
+
+namespace
+{
+    ProfilerMemory::Groups GetAssetMemoryGroup(const String& typeName)
+    {
+        if (typeName == TEXT("FlaxEngine.Texture") || typeName == TEXT("FlaxEngine.CubeTexture") || typeName == TEXT("FlaxEngine.SpriteAtlas") || typeName == TEXT("FlaxEngine.IESProfile"))
+            return ProfilerMemory::Groups::ContentTextures;
+        if (typeName == TEXT("FlaxEngine.Model") || typeName == TEXT("FlaxEngine.SkinnedModel"))
+            return ProfilerMemory::Groups::ContentModels;
+        if (typeName == TEXT("FlaxEngine.Animation") || typeName == TEXT("FlaxEngine.AnimationGraph") || typeName == TEXT("FlaxEngine.AnimationGraphFunction") || typeName == TEXT("FlaxEngine.SkeletonMask"))
+            return ProfilerMemory::Groups::ContentAnimations;
+        if (typeName == TEXT("FlaxEngine.AudioClip"))
+            return ProfilerMemory::Groups::ContentAudio;
+        if (typeName == TEXT("FlaxEngine.Material") || typeName == TEXT("FlaxEngine.MaterialInstance") || typeName == TEXT("FlaxEngine.MaterialFunction") || typeName == TEXT("FlaxEngine.Shader"))
+            return ProfilerMemory::Groups::ContentMaterials;
+        if (typeName == TEXT("FlaxEngine.ParticleSystem") || typeName == TEXT("FlaxEngine.ParticleEmitter") || typeName == TEXT("FlaxEngine.ParticleEmitterFunction"))
+            return ProfilerMemory::Groups::ContentParticles;
+        if (typeName == TEXT("FlaxEngine.SceneAsset") || typeName == TEXT("FlaxEngine.Prefab"))
+            return ProfilerMemory::Groups::ContentScenes;
+        return ProfilerMemory::Groups::Content;
+    }
+}
+
+#endif
+
 bool Asset::onLoad(LoadAssetTask* task)
 {
     // It may fail when task is cancelled and new one is created later (don't crash but just end with an error)
@@ -597,6 +624,9 @@ bool Asset::onLoad(LoadAssetTask* task)
     LoadResult result;
     {
         PROFILE_CPU_ASSET(this);
+#if COMPILE_WITH_PROFILER
+        ScopeMemoryGroup memoryGroup(GetAssetMemoryGroup(GetTypeName()));
+#endif
         result = loadAsset();
     }
     const bool isLoaded = result == LoadResult::Ok;
@@ -663,7 +693,8 @@ void Asset::onUnload_MainThread()
     {
         // Cancel loading
         Platform::AtomicStore(&_loadingTask, 0);
-        LOG(Warning, "Cancel loading task for \'{0}\'", ToString());
+        if (!loadingTask->IsQueued())
+            LOG(Warning, "Cancel loading task for \'{0}\'", ToString());
         loadingTask->Cancel();
     }
 }
@@ -54,6 +54,7 @@ Animation::InfoData Animation::GetInfo() const
             info.MemoryUsage += e.Rotation.GetKeyframes().Capacity() * sizeof(LinearCurveKeyframe<Quaternion>);
             info.MemoryUsage += e.Scale.GetKeyframes().Capacity() * sizeof(LinearCurveKeyframe<Float3>);
         }
+        info.MemoryUsage += Data.Compressed.GetMemoryUsage();
     }
     else
     {
@@ -647,6 +648,29 @@ Asset::LoadResult Animation::load()
         }
     }
 
+#if !USE_EDITOR
+    // Use the compressed animation data (if created during game cooking) instead of the curves
+    const auto compressedChunk = GetChunk(ANIMATION_COMPRESSED_CHUNK_INDEX);
+    if (compressedChunk && compressedChunk->IsLoaded())
+    {
+        MemoryReadStream compressedStream(compressedChunk->Get(), compressedChunk->Size());
+        if (Data.Compressed.Load(compressedStream) || Data.Compressed.Channels.Count() != Data.Channels.Count())
+        {
+            LOG(Warning, "Failed to load the compressed animation data.");
+            Data.Compressed.Dispose();
+        }
+        else
+        {
+            for (auto& channel : Data.Channels)
+            {
+                channel.Position.GetKeyframes().SetCapacity(0, false);
+                channel.Rotation.GetKeyframes().SetCapacity(0, false);
+                channel.Scale.GetKeyframes().SetCapacity(0, false);
+            }
+        }
+    }
+#endif
+
     return LoadResult::Ok;
 }
 
@@ -674,5 +698,5 @@ void Animation::unload(bool isReloading)
 
 AssetChunksFlag Animation::getChunksToPreload() const
 {
-    return GET_CHUNK_FLAG(0);
+    return GET_CHUNK_FLAG(0) | GET_CHUNK_FLAG(ANIMATION_COMPRESSED_CHUNK_INDEX);
 }
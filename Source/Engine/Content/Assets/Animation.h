@@ -10,6 +10,9 @@
 class SkinnedModel;
 class AnimEvent;
 
+// The index of the asset chunk with the compressed animation data (created when cooking the game, see BuildSettings.CompressAnimations)
+#define ANIMATION_COMPRESSED_CHUNK_INDEX 1
+
 /// <summary>
 /// Asset that contains an animation spline represented by a set of keyframes, each representing an endpoint of a linear curve.
 /// </summary>
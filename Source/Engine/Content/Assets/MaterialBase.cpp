@@ -39,6 +39,20 @@ void MaterialBase::SetParameterValue(const StringView& name, const Variant& valu
     }
 }
 
+void MaterialBase::SetParameterValue(const StringName& name, const Variant& value, bool warnIfMissing)
+{
+    const auto param = Params.Get(name);
+    if (param)
+    {
+        param->SetValue(value);
+        param->SetIsOverride(true);
+    }
+    else if (warnIfMissing)
+    {
+        LOG(Warning, "Missing material parameter '{0}' in material {1}", name, ToString());
+    }
+}
+
 MaterialInstance* MaterialBase::CreateVirtualInstance()
 {
     auto instance = Content::CreateVirtualAsset<MaterialInstance>();
@@ -54,6 +54,14 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API MaterialBase : public BinaryAs
         return Params.Get(name);
     }
 
+    /// <summary>
+    /// Gets the material parameter.
+    /// </summary>
+    FORCE_INLINE MaterialParameter* GetParameter(const StringName& name)
+    {
+        return Params.Get(name);
+    }
+
     /// <summary>
     /// Gets the material parameter value.
     /// </summary>
@@ -68,6 +76,14 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API MaterialBase : public BinaryAs
     /// <param name="warnIfMissing">True if warn if parameter is missing, otherwise will do nothing.</param>
     API_FUNCTION() void SetParameterValue(const StringView& name, const Variant& value, bool warnIfMissing = true);
 
+    /// <summary>
+    /// Sets the material parameter value (and sets IsOverride to true).
+    /// </summary>
+    /// <param name="name">The parameter name.</param>
+    /// <param name="value">The value to set.</param>
+    /// <param name="warnIfMissing">True if warn if parameter is missing, otherwise will do nothing.</param>
+    void SetParameterValue(const StringName& name, const Variant& value, bool warnIfMissing = true);
+
     /// <summary>
     /// Creates the virtual material instance of this material which allows to override any material parameters.
     /// </summary>
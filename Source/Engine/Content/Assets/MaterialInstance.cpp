@@ -50,10 +50,12 @@ void MaterialInstance::OnBaseSet()
         param._registerIndex = baseParam._registerIndex;
         param._offset = baseParam._offset;
         param._name = baseParam._name;
+        param._nameId = baseParam._nameId;
     }
 
     // Params are valid
     Params._versionHash = baseParams._versionHash;
+    Params.InvalidateValues();
     ParamsChanged();
 }
 
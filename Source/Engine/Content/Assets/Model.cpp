@@ -7,10 +7,13 @@
 #include "Engine/Content/WeakAssetReference.h"
 #include "Engine/Content/Upgraders/ModelAssetUpgrader.h"
 #include "Engine/Content/Factories/BinaryAssetFactory.h"
+#include "Engine/Content/Loading/ContentLoadTask.h"
 #include "Engine/Debug/DebugDraw.h"
 #include "Engine/Graphics/RenderTools.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/Models/ModelInstanceEntry.h"
+#include "Engine/Graphics/Models/ModelDrawCache.h"
+#include "Engine/Graphics/Models/MeshCodec.h"
 #include "Engine/Streaming/StreamingGroup.h"
 #include "Engine/Debug/Exceptions/ArgumentOutOfRangeException.h"
 #include "Engine/Graphics/GPUDevice.h"
@@ -176,6 +179,21 @@ bool Model::Intersects(const Ray& ray, const Transform& transform, Real& distanc
     return LODs[lodIndex].Intersects(ray, transform, distance, normal, mesh);
 }
 
+void Model::GetLODData(int32 lodIndex, BytesContainer& data) const
+{
+    const int32 chunkIndex = MODEL_LOD_TO_CHUNK_INDEX(lodIndex);
+    GetChunkData(chunkIndex, data);
+    const FlaxChunk* chunk = GetChunk(chunkIndex);
+    if (data.IsValid() && chunk && EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::EncodedMeshData))
+    {
+        // Decode meshes data (cooked with compression)
+        BytesContainer decoded;
+        if (MeshCodec::DecodeModelLOD(data, decoded))
+            LOG(Warning, "Failed to decode LOD{0} data of model {1}", lodIndex, ToString());
+        data.Swap(decoded);
+    }
+}
+
 BoundingBox Model::GetBox(const Matrix& world, int32 lodIndex) const
 {
     return LODs[lodIndex].GetBox(world);
@@ -287,7 +305,8 @@ FORCE_INLINE void ModelDraw(Model* model, const RenderContext& renderContext, co
     // Draw
     if (info.DrawState->PrevLOD == lodIndex || renderContext.View.IsSingleFrame)
     {
-        model->LODs.Get()[lodIndex].Draw(context, info, 0.0f);
+        if (!info.DrawCache || info.DrawCache->Draw(context, model, lodIndex, info))
+            model->LODs.Get()[lodIndex].Draw(context, info, 0.0f);
     }
     else if (info.DrawState->PrevLOD == -1)
     {
@@ -845,7 +864,10 @@ Task* Model::CreateStreamingTask(int32 residency)
         int32 lodIndex = HighestResidentLODIndex() - 1;
 
         // Request LOD data
-        result = (Task*)RequestLODDataAsync(lodIndex);
+        ContentLoadTask* loadTask = RequestLODDataAsync(lodIndex);
+        if (loadTask)
+            loadTask->SetPriority(ContentLoadTask::GetStreamingPriority(GetStreamingPriority()));
+        result = (Task*)loadTask;
 
         // Add upload data task
         _streamingTask = New<StreamModelLODTask>(this, lodIndex);
@@ -875,6 +897,19 @@ void Model::CancelStreamingTasks()
     }
 }
 
+uint64 Model::GetResidencySize(int32 residency) const
+{
+    // Sum the size of the LODs data chunks
+    uint64 result = 0;
+    for (int32 lodIndex = Math::Max(LODs.Count() - residency, 0); lodIndex < LODs.Count(); lodIndex++)
+    {
+        const auto chunk = GetChunk(MODEL_LOD_TO_CHUNK_INDEX(lodIndex));
+        if (chunk)
+            result += chunk->LocationInFile.Size;
+    }
+    return result;
+}
+
 Asset::LoadResult Model::load()
 {
     // Get header chunk
@@ -1012,6 +1047,39 @@ Asset::LoadResult Model::load()
         }
     }
 
+    // Load meshlets
+    auto meshletsChunk = GetChunk(MODEL_MESHLETS_CHUNK_INDEX);
+    if (meshletsChunk && meshletsChunk->IsLoaded())
+    {
+        // #MODEL_DATA_FORMAT_USAGE
+        MemoryReadStream meshletsStream(meshletsChunk->Get(), meshletsChunk->Size());
+        int32 version, lodsCount;
+        meshletsStream.ReadInt32(&version);
+        meshletsStream.ReadInt32(&lodsCount);
+        if (version == 1 && lodsCount == LODs.Count())
+        {
+            for (int32 lodIndex = 0; lodIndex < lodsCount; lodIndex++)
+            {
+                auto& lod = LODs[lodIndex];
+                int32 meshesCount;
+                meshletsStream.ReadInt32(&meshesCount);
+                if (meshesCount != lod.Meshes.Count())
+                {
+                    LOG(Warning, "Invalid meshlets data in model {0}.", ToString());
+                    break;
+                }
+                for (int32 meshIndex = 0; meshIndex < meshesCount; meshIndex++)
+                {
+                    int32 meshletsCount;
+                    meshletsStream.ReadInt32(&meshletsCount);
+                    auto& meshlets = lod.Meshes[meshIndex].Meshlets;
+                    meshlets.Resize(meshletsCount);
+                    meshletsStream.ReadBytes(meshlets.Get(), meshletsCount * sizeof(ModelMeshlet));
+                }
+            }
+        }
+    }
+
 #if !BUILD_RELEASE
     // Validate LODs
     for (int32 lodIndex = 1; lodIndex < LODs.Count(); lodIndex++)
@@ -1065,7 +1133,7 @@ bool Model::init(AssetInitData& initData)
 AssetChunksFlag Model::getChunksToPreload() const
 {
     // Note: we don't preload any LODs here because it's done by the Streaming Manager
-    return GET_CHUNK_FLAG(0) | GET_CHUNK_FLAG(15);
+    return GET_CHUNK_FLAG(0) | GET_CHUNK_FLAG(MODEL_MESHLETS_CHUNK_INDEX) | GET_CHUNK_FLAG(15);
 }
 
 void ModelBase::SetupMaterialSlots(int32 slotsCount)
@@ -101,15 +101,11 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Model : public ModelBase
     }
 
     /// <summary>
-    /// Gets the model LOD data (links bytes).
+    /// Gets the model LOD data (links bytes or decodes them if the meshes data is encoded).
     /// </summary>
     /// <param name="lodIndex">Index of the LOD.</param>
     /// <param name="data">The data (may be missing if failed to get it).</param>
-    void GetLODData(int32 lodIndex, BytesContainer& data) const
-    {
-        const int32 chunkIndex = MODEL_LOD_TO_CHUNK_INDEX(lodIndex);
-        GetChunkData(chunkIndex, data);
-    }
+    void GetLODData(int32 lodIndex, BytesContainer& data) const;
 
 public:
     /// <summary>
@@ -262,6 +258,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Model : public ModelBase
     Task* UpdateAllocation(int32 residency) override;
     Task* CreateStreamingTask(int32 residency) override;
     void CancelStreamingTasks() override;
+    uint64 GetResidencySize(int32 residency) const override;
 
 protected:
     // [ModelBase]
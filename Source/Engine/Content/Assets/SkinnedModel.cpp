@@ -16,6 +16,7 @@
 #include "Engine/Content/WeakAssetReference.h"
 #include "Engine/Content/Factories/BinaryAssetFactory.h"
 #include "Engine/Content/Upgraders/SkinnedModelAssetUpgrader.h"
+#include "Engine/Content/Loading/ContentLoadTask.h"
 #include "Engine/Debug/Exceptions/ArgumentOutOfRangeException.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Renderer/DrawCall.h"
@@ -1031,7 +1032,10 @@ Task* SkinnedModel::CreateStreamingTask(int32 residency)
         int32 lodIndex = HighestResidentLODIndex() - 1;
 
         // Request LOD data
-        result = (Task*)RequestLODDataAsync(lodIndex);
+        ContentLoadTask* loadTask = RequestLODDataAsync(lodIndex);
+        if (loadTask)
+            loadTask->SetPriority(ContentLoadTask::GetStreamingPriority(GetStreamingPriority()));
+        result = (Task*)loadTask;
 
         // Add upload data task
         _streamingTask = New<StreamSkinnedModelLODTask>(this, lodIndex);
@@ -1061,6 +1065,19 @@ void SkinnedModel::CancelStreamingTasks()
     }
 }
 
+uint64 SkinnedModel::GetResidencySize(int32 residency) const
+{
+    // Sum the size of the LODs data chunks
+    uint64 result = 0;
+    for (int32 lodIndex = Math::Max(LODs.Count() - residency, 0); lodIndex < LODs.Count(); lodIndex++)
+    {
+        const auto chunk = GetChunk(MODEL_LOD_TO_CHUNK_INDEX(lodIndex));
+        if (chunk)
+            result += chunk->LocationInFile.Size;
+    }
+    return result;
+}
+
 Asset::LoadResult SkinnedModel::load()
 {
     // Get header chunk
@@ -334,6 +334,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API SkinnedModel : public ModelBase
     Task* UpdateAllocation(int32 residency) override;
     Task* CreateStreamingTask(int32 residency) override;
     void CancelStreamingTasks() override;
+    uint64 GetResidencySize(int32 residency) const override;
 
 protected:
     // [ModelBase]
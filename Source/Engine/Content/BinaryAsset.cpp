@@ -285,7 +285,9 @@ bool BinaryAsset::LoadChunks(AssetChunksFlag chunks)
     if (chunks == 0)
         return false;
 
-    // Load all missing marked chunks
+    // Gather all missing marked chunks
+    FlaxChunk* toLoad[ASSET_FILE_DATA_CHUNKS];
+    int32 toLoadCount = 0;
     for (int32 i = 0; i < ASSET_FILE_DATA_CHUNKS; i++)
     {
         auto chunk = _header.Chunks[i];
@@ -294,11 +296,16 @@ bool BinaryAsset::LoadChunks(AssetChunksFlag chunks)
             && chunk->IsMissing()
             && chunk->ExistsInFile())
         {
-            if (Storage->LoadAssetChunk(chunk))
-                return true;
+            toLoad[toLoadCount++] = chunk;
         }
     }
 
+    // Batch reads and load chunks
+    if (toLoadCount > 1)
+        Storage->PrefetchAssetChunks(Span<FlaxChunk*>(toLoad, toLoadCount));
+    if (toLoadCount != 0 && Storage->LoadAssetChunks(Span<FlaxChunk*>(toLoad, toLoadCount)))
+        return true;
+
     return false;
 }
 
@@ -7,6 +7,8 @@
 #include "Engine/Core/Types/DateTime.h"
 #include "Engine/Core/Types/Stopwatch.h"
 #include "Engine/Platform/FileSystem.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Serialization/FileWriteStream.h"
 #include "Engine/Serialization/FileReadStream.h"
 #include "Engine/Content/Content.h"
@@ -17,6 +19,39 @@
 #include "Engine/Engine/Globals.h"
 #include "FlaxEngine.Gen.h"
 
+namespace
+{
+    int32 CompareIds(const Guid& a, const Guid& b)
+    {
+        if (a.A != b.A)
+            return a.A < b.A ? -1 : 1;
+        if (a.B != b.B)
+            return a.B < b.B ? -1 : 1;
+        if (a.C != b.C)
+            return a.C < b.C ? -1 : 1;
+        if (a.D != b.D)
+            return a.D < b.D ? -1 : 1;
+        return 0;
+    }
+
+    int32 ComparePaths(const Char* text, const StringView& path)
+    {
+        int32 i = 0;
+        for (; i < path.Length(); i++)
+        {
+            const Char c = text[i];
+            if (c != path[i])
+                return c == 0 || c < path[i] ? -1 : 1;
+        }
+        return text[i] == 0 ? 0 : 1;
+    }
+}
+
+AssetsCache::~AssetsCache()
+{
+    ReleasePacked();
+}
+
 void AssetsCache::Init()
 {
     Entry e;
@@ -73,6 +108,37 @@ void AssetsCache::Init()
 
     ScopeLock lock(_locker);
     _isDirty = false;
+    ReleasePacked();
+
+    if (EnumHasAnyFlags(flags, AssetsCacheFlags::PackedTables))
+    {
+        // Use tables directly from the file memory
+        int32 entriesCount, mappingsCount, stringsCount;
+        uint32 tablesOffset;
+        stream->ReadInt32(&entriesCount);
+        stream->ReadInt32(&mappingsCount);
+        stream->ReadInt32(&stringsCount);
+        stream->ReadUint32(&tablesOffset);
+        const bool hasError = stream->HasError();
+        deleteStream.Delete();
+        _registry.Clear();
+        _pathsMapping.Clear();
+        if (hasError || LoadPacked(tablesOffset, entriesCount, mappingsCount, stringsCount))
+        {
+            _isDirty = true;
+            LOG(Warning, "Asset Cache file has an error.");
+            return;
+        }
+        _packedRelativePaths = EnumHasAnyFlags(flags, AssetsCacheFlags::RelativePaths);
+#if ENABLE_ASSETS_DISCOVERY
+        // Entries need to be validated
+        UnpackTables();
+#endif
+
+        stopwatch.Stop();
+        LOG(Info, "Asset Cache loaded {0} entries in {1}ms (packed)", _registry.Count() + _packedEntriesCount, stopwatch.GetMilliseconds());
+        return;
+    }
 
     // Load elements count
     stream->ReadInt32(&count);
@@ -186,6 +252,14 @@ bool AssetsCache::Save(const StringView& path, const Registry& entries, const Pa
     // Flags
     stream->WriteInt32((int32)flags);
 
+    if (EnumHasAnyFlags(flags, AssetsCacheFlags::PackedTables))
+    {
+        const bool failed = SavePacked(stream, entries, pathsMapping);
+        stream->Flush();
+        Delete(stream);
+        return failed;
+    }
+
     // Items count
     stream->WriteInt32(entries.Count());
 
@@ -234,6 +308,18 @@ const String& AssetsCache::GetEditorAssetPath(const Guid& id) const
         if (e.Value == id)
             return e.Key;
     }
+    for (int32 i = 0; i < _packedMappingsCount; i++)
+    {
+        const PackedMapping& e = _packedMappings[i];
+        if (e.ID == id)
+        {
+            // Cache the path to return the persistent reference
+            auto& result = _packedPaths[id];
+            if (result.IsEmpty())
+                result = GetPackedPath(e.Path);
+            return result;
+        }
+    }
     return String::Empty;
 #endif
 }
@@ -252,6 +338,10 @@ bool AssetsCache::FindAsset(const StringView& path, AssetInfo& info)
     {
         return FindAsset(id, info);
     }
+    if (const PackedMapping* mapping = FindPackedMapping(path))
+    {
+        return FindAsset(mapping->ID, info);
+    }
 #if !USE_EDITOR
     if (FileSystem::IsRelative(path))
     {
@@ -261,6 +351,10 @@ bool AssetsCache::FindAsset(const StringView& path, AssetInfo& info)
         {
             return FindAsset(id, info);
         }
+        if (const PackedMapping* mapping = FindPackedMapping(absolutePath))
+        {
+            return FindAsset(mapping->ID, info);
+        }
     }
 #endif
 
@@ -285,6 +379,22 @@ bool AssetsCache::FindAsset(const StringView& path, AssetInfo& info)
             break;
         }
     }
+    if (!result && _packedEntriesCount != 0)
+    {
+        const String packedPath = ToPackedPath(path);
+        for (int32 i = 0; i < _packedEntriesCount; i++)
+        {
+            const PackedEntry& e = _packedEntries[i];
+            if (ComparePaths(_packedStrings + e.Path, packedPath) == 0 && _packedStrings[e.Path] != 0)
+            {
+                result = true;
+                info.ID = e.ID;
+                info.TypeName = _packedStrings + e.TypeName;
+                info.Path = String(path);
+                break;
+            }
+        }
+    }
 
     return result;
 }
@@ -309,6 +419,17 @@ bool AssetsCache::FindAsset(const Guid& id, AssetInfo& info)
             info = e->Info;
         }
     }
+    else if (const PackedEntry* packed = FindPacked(id))
+    {
+        // Skip entries with missing file (see IsEntryValid)
+        if (_packedStrings[packed->Path] != 0)
+        {
+            result = true;
+            info.ID = packed->ID;
+            info.TypeName = _packedStrings + packed->TypeName;
+            info.Path = GetPackedPath(packed->Path);
+        }
+    }
     return result;
 }
 
@@ -317,6 +438,9 @@ void AssetsCache::GetAll(Array<Guid>& result) const
     PROFILE_CPU();
     ScopeLock lock(_locker);
     _registry.GetKeys(result);
+    result.EnsureCapacity(result.Count() + _packedEntriesCount);
+    for (int32 i = 0; i < _packedEntriesCount; i++)
+        result.Add(_packedEntries[i].ID);
 }
 
 void AssetsCache::GetAllByTypeName(const StringView& typeName, Array<Guid>& result) const
@@ -328,6 +452,11 @@ void AssetsCache::GetAllByTypeName(const StringView& typeName, Array<Guid>& resu
         if (i->Value.Info.TypeName == typeName)
             result.Add(i->Key);
     }
+    for (int32 i = 0; i < _packedEntriesCount; i++)
+    {
+        if (ComparePaths(_packedStrings + _packedEntries[i].TypeName, typeName) == 0)
+            result.Add(_packedEntries[i].ID);
+    }
 }
 
 void AssetsCache::RegisterAssets(FlaxStorage* storage)
@@ -342,6 +471,7 @@ void AssetsCache::RegisterAssets(FlaxStorage* storage)
     ASSERT(entries.HasItems());
 
     ScopeLock lock(_locker);
+    UnpackTables();
     auto storagePath = storage->GetPath();
 
     // Remove all old entries from that location
@@ -440,6 +570,7 @@ void AssetsCache::RegisterAsset(const Guid& id, const String& typeName, const St
 {
     PROFILE_CPU();
     ScopeLock lock(_locker);
+    UnpackTables();
 
     // Check if asset has been already added to the registry
     bool isMissing = true;
@@ -492,6 +623,7 @@ bool AssetsCache::DeleteAsset(const StringView& path, AssetInfo* info)
 {
     bool result = false;
     _locker.Lock();
+    UnpackTables();
 
     for (auto i = _registry.Begin(); i.IsNotEnd(); ++i)
     {
@@ -514,6 +646,8 @@ bool AssetsCache::DeleteAsset(const Guid& id, AssetInfo* info)
 {
     bool result = false;
     _locker.Lock();
+    if (FindPacked(id))
+        UnpackTables();
 
     const auto e = _registry.TryGet(id);
     if (e != nullptr)
@@ -533,6 +667,7 @@ bool AssetsCache::RenameAsset(const StringView& oldPath, const StringView& newPa
 {
     bool result = false;
     _locker.Lock();
+    UnpackTables();
 
     for (auto i = _registry.Begin(); i.IsNotEnd(); ++i)
     {
@@ -606,3 +741,220 @@ bool AssetsCache::IsEntryValid(Entry& e)
     return e.Info.Path.HasChars();
 #endif
 }
+
+bool AssetsCache::LoadPacked(uint32 tablesOffset, int32 entriesCount, int32 mappingsCount, int32 stringsCount)
+{
+    PROFILE_CPU();
+    const uint64 tablesSize = (uint64)entriesCount * sizeof(PackedEntry) + (uint64)mappingsCount * sizeof(PackedMapping) + (uint64)stringsCount * sizeof(Char);
+    if (entriesCount < 0 || mappingsCount < 0 || stringsCount <= 0 || tablesOffset % 16 != 0)
+        return true;
+
+    // Map the file (pages are loaded by the system on access), fallback to loading it into memory
+    auto file = File::Open(_path, FileMode::OpenExisting, FileAccess::Read, FileShare::Read);
+    if (!file)
+        return true;
+    const uint32 size = file->GetSize();
+    if (tablesOffset + tablesSize > size)
+    {
+        Delete(file);
+        return true;
+    }
+    byte* data = (byte*)file->Map();
+    if (data)
+    {
+        _packedFile = file;
+        _packedView = data;
+        _packedSize = size;
+    }
+    else
+    {
+        Delete(file);
+        if (File::ReadAllBytes(_path, _packedData) || _packedData.Count() != (int32)size)
+        {
+            _packedData.Resize(0);
+            return true;
+        }
+        data = _packedData.Get();
+    }
+
+    data += tablesOffset;
+    _packedEntries = (const PackedEntry*)data;
+    _packedEntriesCount = entriesCount;
+    data += entriesCount * sizeof(PackedEntry);
+    _packedMappings = (const PackedMapping*)data;
+    _packedMappingsCount = mappingsCount;
+    data += mappingsCount * sizeof(PackedMapping);
+    _packedStrings = (const Char*)data;
+    if (_packedStrings[stringsCount - 1] != 0)
+    {
+        ReleasePacked();
+        return true;
+    }
+    return false;
+}
+
+void AssetsCache::ReleasePacked()
+{
+    if (_packedFile)
+    {
+        _packedFile->Unmap(_packedView, _packedSize);
+        Delete(_packedFile);
+        _packedFile = nullptr;
+    }
+    _packedView = nullptr;
+    _packedSize = 0;
+    _packedData.Resize(0);
+    _packedEntries = nullptr;
+    _packedEntriesCount = 0;
+    _packedMappings = nullptr;
+    _packedMappingsCount = 0;
+    _packedStrings = nullptr;
+#if !USE_EDITOR
+    _packedPaths.Clear();
+#endif
+}
+
+void AssetsCache::UnpackTables()
+{
+    if (!_packedStrings)
+        return;
+    PROFILE_CPU();
+
+    // Move packed entries into the registry so it can be modified
+    Entry e;
+    _registry.EnsureCapacity(_registry.Count() + _packedEntriesCount);
+    for (int32 i = 0; i < _packedEntriesCount; i++)
+    {
+        const PackedEntry& packed = _packedEntries[i];
+        e.Info.ID = packed.ID;
+        e.Info.TypeName = _packedStrings + packed.TypeName;
+        e.Info.Path = GetPackedPath(packed.Path);
+        if (IsEntryValid(e))
+            _registry.Add(e.Info.ID, e);
+    }
+    _pathsMapping.EnsureCapacity(_pathsMapping.Count() + _packedMappingsCount);
+    for (int32 i = 0; i < _packedMappingsCount; i++)
+    {
+        const PackedMapping& packed = _packedMappings[i];
+        _pathsMapping.Add(GetPackedPath(packed.Path), packed.ID);
+    }
+    ReleasePacked();
+}
+
+const AssetsCache::PackedEntry* AssetsCache::FindPacked(const Guid& id) const
+{
+    int32 left = 0, right = _packedEntriesCount - 1;
+    while (left <= right)
+    {
+        const int32 middle = left + (right - left) / 2;
+        const int32 compare = CompareIds(_packedEntries[middle].ID, id);
+        if (compare == 0)
+            return &_packedEntries[middle];
+        if (compare < 0)
+            left = middle + 1;
+        else
+            right = middle - 1;
+    }
+    return nullptr;
+}
+
+const AssetsCache::PackedMapping* AssetsCache::FindPackedMapping(const StringView& path) const
+{
+    if (_packedMappingsCount == 0)
+        return nullptr;
+    const String packedPath = ToPackedPath(path);
+    int32 left = 0, right = _packedMappingsCount - 1;
+    while (left <= right)
+    {
+        const int32 middle = left + (right - left) / 2;
+        const int32 compare = ComparePaths(_packedStrings + _packedMappings[middle].Path, packedPath);
+        if (compare == 0)
+            return &_packedMappings[middle];
+        if (compare < 0)
+            left = middle + 1;
+        else
+            right = middle - 1;
+    }
+    return nullptr;
+}
+
+String AssetsCache::GetPackedPath(uint32 offset) const
+{
+    const Char* text = _packedStrings + offset;
+    if (_packedRelativePaths && *text)
+        return Globals::StartupFolder / text;
+    return String(text);
+}
+
+String AssetsCache::ToPackedPath(const StringView& path) const
+{
+    // Packed paths are relative to the startup folder (see GetPackedPath)
+    const String& root = Globals::StartupFolder;
+    if (_packedRelativePaths && path.Length() > root.Length() && path.StartsWith(root) && (path[root.Length()] == '/' || path[root.Length()] == '\\'))
+        return path.Substring(root.Length() + 1);
+    return String(path);
+}
+
+bool AssetsCache::SavePacked(WriteStream* stream, const Registry& entries, const PathsMapping& pathsMapping)
+{
+    // Build strings table (assets in the packages share the same path)
+    Array<Char> strings;
+    Dictionary<String, uint32> stringsLookup;
+    auto addString = [&](const String& text)
+    {
+        uint32 offset;
+        if (!stringsLookup.TryGet(text, offset))
+        {
+            offset = strings.Count();
+            strings.Add(text.Get(), text.Length());
+            strings.Add(0);
+            stringsLookup.Add(text, offset);
+        }
+        return offset;
+    };
+    addString(String::Empty);
+
+    // Build tables sorted for the binary search
+    Array<PackedEntry> packedEntries;
+    packedEntries.EnsureCapacity(entries.Count());
+    for (auto i = entries.Begin(); i.IsNotEnd(); ++i)
+    {
+        auto& e = packedEntries.AddOne();
+        e.ID = i->Value.Info.ID;
+        e.TypeName = addString(i->Value.Info.TypeName);
+        e.Path = addString(i->Value.Info.Path);
+    }
+    bool (*compareEntries)(const PackedEntry&, const PackedEntry&) = [](const PackedEntry& a, const PackedEntry& b)
+    {
+        return CompareIds(a.ID, b.ID) < 0;
+    };
+    Sorting::QuickSort(packedEntries.Get(), packedEntries.Count(), compareEntries);
+    Array<PackedMapping> packedMappings;
+    packedMappings.EnsureCapacity(pathsMapping.Count());
+    for (auto i = pathsMapping.Begin(); i.IsNotEnd(); ++i)
+    {
+        auto& e = packedMappings.AddOne();
+        e.ID = i->Value;
+        e.Path = addString(i->Key);
+    }
+    bool (*compareMappings)(const PackedMapping&, const PackedMapping&, Char*) = [](const PackedMapping& a, const PackedMapping& b, Char* strings)
+    {
+        return ComparePaths(strings + a.Path, StringView(strings + b.Path)) < 0;
+    };
+    Sorting::SortArray(packedMappings.Get(), packedMappings.Count(), compareMappings, strings.Get());
+
+    // Header (tables are aligned to allow using them directly from the file memory)
+    const uint32 tablesOffset = Math::AlignUp<uint32>(stream->GetPosition() + sizeof(int32) * 4, 16);
+    stream->WriteInt32(packedEntries.Count());
+    stream->WriteInt32(packedMappings.Count());
+    stream->WriteInt32(strings.Count());
+    stream->WriteUint32(tablesOffset);
+    while (stream->GetPosition() < tablesOffset)
+        stream->WriteByte(0);
+
+    // Tables
+    stream->WriteBytes(packedEntries.Get(), packedEntries.Count() * sizeof(PackedEntry));
+    stream->WriteBytes(packedMappings.Get(), packedMappings.Count() * sizeof(PackedMapping));
+    stream->WriteBytes(strings.Get(), strings.Count() * sizeof(Char));
+    return stream->HasError();
+}
@@ -9,12 +9,15 @@
 #include "Engine/Core/Types/DateTime.h"
 #endif
 #include "Engine/Core/Types/String.h"
+#include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Platform/CriticalSection.h"
 
 struct AssetHeader;
 struct FlaxStorageReference;
 class FlaxStorage;
+class FileBase;
+class WriteStream;
 
 /// <summary>
 /// Assets cache flags.
@@ -30,6 +33,11 @@ enum class AssetsCacheFlags
     /// The serialized paths are relative to the startup folder (should be converted to absolute on load).
     /// </summary>
     RelativePaths = 1,
+
+    /// <summary>
+    /// The registry is stored as the tables sorted by the asset ID and by the mapped path which are used directly from the cache file memory (no per-entry loading on startup). Used by the cooked games.
+    /// </summary>
+    PackedTables = 2,
 };
 
 DECLARE_ENUM_OPERATORS(AssetsCacheFlags);
@@ -74,20 +82,52 @@ class FLAXENGINE_API AssetsCache
     typedef Dictionary<String, Guid> PathsMapping;
 
 private:
+    // The packed registry entry (see AssetsCacheFlags::PackedTables). Strings are stored as offsets (in chars) to the null-terminated text in the strings table.
+    struct PackedEntry
+    {
+        Guid ID;
+        uint32 TypeName;
+        uint32 Path;
+    };
+
+    // The packed paths mapping entry (see AssetsCacheFlags::PackedTables).
+    struct PackedMapping
+    {
+        Guid ID;
+        uint32 Path;
+    };
+
     bool _isDirty = false;
     CriticalSection _locker;
     Registry _registry;
     PathsMapping _pathsMapping;
     String _path;
 
+    // Packed registry tables (used instead of the registry dictionaries until any modification)
+    FileBase* _packedFile = nullptr;
+    byte* _packedView = nullptr;
+    uint32 _packedSize = 0;
+    Array<byte> _packedData;
+    const PackedEntry* _packedEntries = nullptr;
+    int32 _packedEntriesCount = 0;
+    const PackedMapping* _packedMappings = nullptr;
+    int32 _packedMappingsCount = 0;
+    const Char* _packedStrings = nullptr;
+    bool _packedRelativePaths = false;
+#if !USE_EDITOR
+    mutable Dictionary<Guid, String> _packedPaths;
+#endif
+
 public:
+    ~AssetsCache();
+
     /// <summary>
     /// Gets amount of registered assets.
     /// </summary>
     int32 Size() const
     {
         _locker.Lock();
-        const int32 result = _registry.Count();
+        const int32 result = _registry.Count() + _packedEntriesCount;
         _locker.Unlock();
         return result;
     }
@@ -230,4 +270,14 @@ class FLAXENGINE_API AssetsCache
     /// <param name="e">The asset entry.</param>
     /// <returns>True if is valid, otherwise false.</returns>
     bool IsEntryValid(Entry& e);
+
+private:
+    bool LoadPacked(uint32 tablesOffset, int32 entriesCount, int32 mappingsCount, int32 stringsCount);
+    void ReleasePacked();
+    void UnpackTables();
+    const PackedEntry* FindPacked(const Guid& id) const;
+    const PackedMapping* FindPackedMapping(const StringView& path) const;
+    String GetPackedPath(uint32 offset) const;
+    String ToPackedPath(const StringView& path) const;
+    static bool SavePacked(WriteStream* stream, const Registry& entries, const PathsMapping& pathsMapping);
 };
@@ -7,6 +7,7 @@
 #include "Cache/AssetsCache.h"
 #include "Storage/ContentStorageManager.h"
 #include "Storage/JsonStorageProxy.h"
+#include "Loading/ContentLoadTask.h"
 #include "Factories/IAssetFactory.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Types/String.h"
@@ -54,7 +55,7 @@ namespace
 {
     // Assets
     CriticalSection AssetsLocker;
-    Dictionary<Guid, Asset*> Assets(2048);
+    FlatDictionary<Guid, Asset*> Assets(2048);
     Array<Guid> LoadCallAssets(PLATFORM_THREADS_LIMIT);
     CriticalSection LoadedAssetsToInvokeLocker;
     Array<Asset*> LoadedAssetsToInvoke(64);
@@ -149,6 +150,13 @@ void ContentService::LateUpdate()
         {
             ToUnload.Add(i->Key);
         }
+        else if (timeNow - i->Value >= Content::AssetsUpdateInterval)
+        {
+            // Cancel loading of assets that lost all references before loading started (eg. player moved away from the area, so other loads will take it's place)
+            const auto loadingTask = (ContentLoadTask*)Platform::AtomicRead(&i->Key->_loadingTask);
+            if (loadingTask && loadingTask->IsQueued())
+                ToUnload.Add(i->Key);
+        }
     }
 
     // Unload marked assets
@@ -488,7 +496,7 @@ Array<Asset*> Content::GetAssets()
     return assets;
 }
 
-const Dictionary<Guid, Asset*>& Content::GetAssetsRaw()
+const FlatDictionary<Guid, Asset*>& Content::GetAssetsRaw()
 {
     AssetsLocker.Lock();
     AssetsLocker.Unlock();
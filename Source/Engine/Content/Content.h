@@ -6,6 +6,7 @@
 #include "AssetInfo.h"
 #include "Asset.h"
 #include "Config.h"
+#include "Engine/Core/Collections/FlatDictionary.h"
 
 class Engine;
 class FlaxFile;
@@ -128,7 +129,7 @@ API_CLASS(Static) class FLAXENGINE_API Content
     /// Gets the raw dictionary of assets (loaded or during load).
     /// </summary>
     /// <returns>The collection of assets.</returns>
-    static const Dictionary<Guid, Asset*, HeapAllocation>& GetAssetsRaw();
+    static const FlatDictionary<Guid, Asset*, HeapAllocation>& GetAssetsRaw();
 
     /// <summary>
     /// Loads asset and holds it until it won't be referenced by any object. Returns null if asset is missing. Actual asset data loading is performed on a other thread in async.
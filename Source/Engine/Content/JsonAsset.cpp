@@ -102,7 +102,7 @@ uint64 JsonAssetBase::GetMemoryUsage() const
     uint64 result = Asset::GetMemoryUsage();
     result += sizeof(JsonAssetBase) - sizeof(Asset);
     if (Data)
-        result += Document.GetAllocator().Capacity();
+        result += Document.GetAllocator().Capacity() + _parser.GetMemoryUsage();
     Locker.Unlock();
     return result;
 }
@@ -264,12 +264,14 @@ Asset::LoadResult JsonAssetBase::loadAsset()
     // Parse json document
     {
         PROFILE_CPU_NAMED("Json.Parse");
-        Document.Parse(data.Get<char>(), data.Length());
-    }
-    if (Document.HasParseError())
-    {
-        Log::JsonParseException(Document.GetParseError(), Document.GetErrorOffset());
-        return LoadResult::CannotLoadData;
+        const bool failed = JsonParser::IsBinary(data.Get(), data.Length())
+                                ? _parser.ParseBinary(Document, data.Get(), data.Length()) // Cooked binary document
+                                : _parser.Parse(Document, data.Get<char>(), data.Length(), "Data");
+        if (failed)
+        {
+            Log::JsonParseException(_parser.GetParseError(), _parser.GetErrorOffset());
+            return LoadResult::CannotLoadData;
+        }
     }
 
     // Gather information from the header
@@ -296,6 +298,7 @@ void JsonAssetBase::unload(bool isReloading)
 {
     ISerializable::SerializeDocument tmp;
     Document.Swap(tmp);
+    _parser.Clear();
     Data = nullptr;
     DataTypeName.Clear();
     DataEngineBuild = 0;
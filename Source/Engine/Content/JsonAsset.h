@@ -4,7 +4,7 @@
 
 #include "Asset.h"
 #include "Engine/Core/ISerializable.h"
-#include "Engine/Serialization/Json.h"
+#include "Engine/Serialization/JsonParser.h"
 
 /// <summary>
 /// Base class for all Json-format assets.
@@ -16,6 +16,7 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API JsonAssetBase : public Asset
 protected:
     String _path;
     bool _isVirtualDocument = false;
+    JsonParser _parser;
 
 protected:
     /// <summary>
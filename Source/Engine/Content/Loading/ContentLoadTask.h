@@ -25,12 +25,22 @@ class ContentLoadTask : public Task
     /// </summary>
     DECLARE_ENUM_5(Result, Ok, AssetLoadError, MissingReferences, LoadDataError, TaskFailed);
 
+    /// <summary>
+    /// Describes work priority. Loading threads pick tasks with higher priority first.
+    /// </summary>
+    DECLARE_ENUM_3(Priority, High, Normal, Low);
+
 private:
     /// <summary>
     /// Task type
     /// </summary>
     Type _type;
 
+    /// <summary>
+    /// Task priority
+    /// </summary>
+    Priority _priority = Priority::Normal;
+
 protected:
     /// <summary>
     /// Initializes a new instance of the <see cref="ContentLoadTask"/> class.
@@ -50,6 +60,40 @@ class ContentLoadTask : public Task
         return _type;
     }
 
+    /// <summary>
+    /// Gets a task priority.
+    /// </summary>
+    FORCE_INLINE Priority GetPriority() const
+    {
+        return _priority;
+    }
+
+    /// <summary>
+    /// Sets a task priority. Has to be called before starting the task.
+    /// </summary>
+    FORCE_INLINE void SetPriority(Priority priority)
+    {
+        _priority = priority;
+    }
+
+    /// <summary>
+    /// Converts the resource streaming priority into the loading task priority.
+    /// </summary>
+    /// <param name="streamingPriority">The streaming priority (normalized to range 0-1, higher is more important). See StreamableResource::GetStreamingPriority.</param>
+    /// <returns>The task priority.</returns>
+    static Priority GetStreamingPriority(float streamingPriority)
+    {
+        return streamingPriority >= 0.5f ? Priority::High : (streamingPriority >= 0.25f ? Priority::Normal : Priority::Low);
+    }
+
+    /// <summary>
+    /// Checks if task is obsolete and can be skipped without running it (eg. target asset has been already deleted). Obsolete tasks are cancelled by the loading threads.
+    /// </summary>
+    virtual bool IsObsolete() const
+    {
+        return false;
+    }
+
 public:
     /// <summary>
     /// Checks if async task is loading given asset resource
@@ -0,0 +1,52 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "ContentLoadTask.h"
+#include "Engine/Threading/ConcurrentTaskQueue.h"
+
+/// <summary>
+/// Content loading tasks queue that uses separate lanes for each priority.
+/// </summary>
+class ContentLoadTaskQueue
+{
+private:
+    ConcurrentTaskQueue<ContentLoadTask> _lanes[3];
+
+public:
+    FORCE_INLINE void Add(ContentLoadTask* task)
+    {
+        _lanes[(int32)task->GetPriority()].Add(task);
+    }
+
+    FORCE_INLINE bool enqueue_bulk(ContentLoadTask* const* tasks, int32 count)
+    {
+        for (int32 i = 0; i < count; i++)
+            Add(tasks[i]);
+        return true;
+    }
+
+    bool try_dequeue(ContentLoadTask*& task)
+    {
+        for (auto& lane : _lanes)
+        {
+            if (lane.try_dequeue(task))
+                return true;
+        }
+        return false;
+    }
+
+    int32 Count() const
+    {
+        int32 result = 0;
+        for (auto& lane : _lanes)
+            result += lane.Count();
+        return result;
+    }
+
+    void CancelAll()
+    {
+        for (auto& lane : _lanes)
+            lane.CancelAll();
+    }
+};
@@ -2,6 +2,7 @@
 
 #include "ContentLoadingManager.h"
 #include "ContentLoadTask.h"
+#include "ContentLoadTaskQueue.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Math/Math.h"
 #include "Engine/Platform/CPUInfo.h"
@@ -10,7 +11,6 @@
 #include "Engine/Content/Config.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Threading/Threading.h"
-#include "Engine/Threading/ConcurrentTaskQueue.h"
 #if USE_EDITOR && PLATFORM_WINDOWS
 #include "Engine/Platform/Win32/IncludeWindowsHeaders.h"
 #include <propidlbase.h>
@@ -21,7 +21,7 @@ namespace ContentLoadingManagerImpl
     THREADLOCAL LoadingThread* ThisThread = nullptr;
     LoadingThread* MainThread = nullptr;
     Array<LoadingThread*> Threads;
-    ConcurrentTaskQueue<ContentLoadTask> Tasks;
+    ContentLoadTaskQueue Tasks;
     ConditionVariable TasksSignal;
     CriticalSection TasksMutex;
 };
@@ -126,7 +126,10 @@ int32 LoadingThread::Run()
     {
         if (Tasks.try_dequeue(task))
         {
-            Run(task);
+            if (task->IsObsolete())
+                task->Cancel();
+            else
+                Run(task);
         }
         else
         {
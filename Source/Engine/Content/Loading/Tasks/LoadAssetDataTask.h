@@ -43,6 +43,11 @@ class LoadAssetDataTask : public ContentLoadTask
         return obj == _asset;
     }
 
+    bool IsObsolete() const override
+    {
+        return _asset == nullptr;
+    }
+
 protected:
 
     // [ContentLoadTask]
@@ -59,27 +64,32 @@ class LoadAssetDataTask : public ContentLoadTask
         const StringView name(ref->GetPath());
 #endif
 
-        // Load chunks
+        // Gather chunks to load
+        FlaxChunk* chunks[ASSET_FILE_DATA_CHUNKS];
+        int32 chunksCount = 0;
         for (int32 i = 0; i < ASSET_FILE_DATA_CHUNKS; i++)
         {
             if (GET_CHUNK_FLAG(i) & _chunks)
             {
                 const auto chunk = ref->GetChunk(i);
                 if (chunk != nullptr)
-                {
-                    if (IsCancelRequested())
-                        return Result::Ok;
+                    chunks[chunksCount++] = chunk;
+            }
+        }
+        if (chunksCount == 0 || IsCancelRequested())
+            return Result::Ok;
 #if TRACY_ENABLE
-                    ZoneScoped;
-                    ZoneName(*name, name.Length());
+        ZoneScoped;
+        ZoneName(*name, name.Length());
 #endif
-                    if (ref->Storage->LoadAssetChunk(chunk))
-                    {
-                        LOG(Warning, "Cannot load asset \'{0}\' chunk {1}.", ref->ToString(), i);
-                        return Result::LoadDataError;
-                    }
-                }
-            }
+
+        // Start reading all chunks data at once and load them (decompression runs in parallel)
+        const Span<FlaxChunk*> chunksSpan(chunks, chunksCount);
+        ref->Storage->PrefetchAssetChunks(chunksSpan);
+        if (ref->Storage->LoadAssetChunks(chunksSpan))
+        {
+            LOG(Warning, "Cannot load asset \'{0}\' chunks.", ref->ToString());
+            return Result::LoadDataError;
         }
 
         return Result::Ok;
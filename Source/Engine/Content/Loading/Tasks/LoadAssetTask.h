@@ -53,6 +53,11 @@ class LoadAssetTask : public ContentLoadTask
         return obj == Asset;
     }
 
+    bool IsObsolete() const override
+    {
+        return Asset == nullptr;
+    }
+
 protected:
 
     // [ContentLoadTask]
@@ -23,8 +23,13 @@ namespace
     Array<FlaxPackage*> Packages(64);
 #endif
     Dictionary<String, FlaxStorage*> StorageMap(2048);
+    CriticalSection ScratchBuffersLocker;
+    Array<Array<byte>*, InlinedAllocation<16>> ScratchBuffers;
 }
 
+// Buffers larger than this are freed after use instead of being kept in the pool
+#define CONTENT_SCRATCH_BUFFER_MAX_POOLED_SIZE (16 * 1024 * 1024)
+
 class ContentStorageService : public EngineService
 {
 public:
@@ -189,6 +194,43 @@ void ContentStorageManager::EnsureUnlocked()
     Locker.Unlock();
 }
 
+Array<byte>* ContentStorageManager::AcquireScratchBuffer(int32 size)
+{
+    Array<byte>* buffer = nullptr;
+    ScratchBuffersLocker.Lock();
+    if (ScratchBuffers.HasItems())
+    {
+        // Pick the largest buffer to reduce reallocations
+        int32 best = 0;
+        for (int32 i = 1; i < ScratchBuffers.Count(); i++)
+        {
+            if (ScratchBuffers[i]->Capacity() > ScratchBuffers[best]->Capacity())
+                best = i;
+        }
+        buffer = ScratchBuffers[best];
+        ScratchBuffers.RemoveAtKeepOrder(best);
+    }
+    ScratchBuffersLocker.Unlock();
+    if (!buffer)
+        buffer = New<Array<byte>>();
+    buffer->Resize(size, false);
+    return buffer;
+}
+
+void ContentStorageManager::ReleaseScratchBuffer(Array<byte>* buffer)
+{
+    if (!buffer)
+        return;
+    if (buffer->Capacity() > CONTENT_SCRATCH_BUFFER_MAX_POOLED_SIZE)
+    {
+        Delete(buffer);
+        return;
+    }
+    ScratchBuffersLocker.Lock();
+    ScratchBuffers.Add(buffer);
+    ScratchBuffersLocker.Unlock();
+}
+
 void ContentStorageManager::FormatPath(String& path)
 {
     StringUtils::PathRemoveRelativeParts(path);
@@ -246,6 +288,9 @@ void ContentStorageService::Dispose()
     StorageMap.Clear();
     ASSERT(Files.IsEmpty() && Packages.IsEmpty());
     SAFE_DELETE(System);
+    ScratchBuffersLocker.Lock();
+    ScratchBuffers.ClearDelete();
+    ScratchBuffersLocker.Unlock();
 }
 
 void ContentStorageSystem::Job(int32 index)
@@ -75,6 +75,20 @@ class FLAXENGINE_API ContentStorageManager
     /// </summary>
     static void EnsureUnlocked();
 
+    /// <summary>
+    /// Acquires the temporary memory buffer for content data processing (eg. chunk data decompression). Buffers are pooled and shared by all content loading threads to reduce memory allocations.
+    /// </summary>
+    /// <remarks>Buffer has to be returned to the pool via ReleaseScratchBuffer.</remarks>
+    /// <param name="size">The minimum size of the buffer (in bytes). Contents are undefined.</param>
+    /// <returns>The buffer with at least the requested size.</returns>
+    static Array<byte>* AcquireScratchBuffer(int32 size);
+
+    /// <summary>
+    /// Releases the temporary memory buffer back to the pool.
+    /// </summary>
+    /// <param name="buffer">The buffer acquired via AcquireScratchBuffer.</param>
+    static void ReleaseScratchBuffer(Array<byte>* buffer);
+
     // Formats path into valid format used by the storage system (normalized and absolute).
     static void FormatPath(String& path);
 
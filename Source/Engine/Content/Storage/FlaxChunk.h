@@ -19,6 +19,16 @@ enum class FlaxChunkFlags
     /// Compress chunk data using LZ4 algorithm.
     /// </summary>
     CompressedLZ4 = 1,
+
+    /// <summary>
+    /// Compress chunk data using LZ4 algorithm with a high-ratio encoder. Produces smaller data at the cost of slower compression (eg. when cooking the game) while decompression stays as fast as for CompressedLZ4.
+    /// </summary>
+    CompressedLZ4HC = 2,
+
+    /// <summary>
+    /// Chunk data contains the model meshes with vertex and index buffers encoded using MeshCodec (decoded by the asset when accessing the data, not by the storage layer). Can be used together with the LZ4 compression.
+    /// </summary>
+    EncodedMeshData = 4,
 };
 
 DECLARE_ENUM_OPERATORS(FlaxChunkFlags);
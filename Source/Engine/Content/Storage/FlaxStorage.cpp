@@ -5,6 +5,7 @@
 #include "FlaxPackage.h"
 #include "ContentStorageManager.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Core/Types/TimeSpan.h"
 #include "Engine/Platform/File.h"
 #include "Engine/Profiler/ProfilerCPU.h"
@@ -12,6 +13,8 @@
 #include "Engine/Content/Asset.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/JobSystem.h"
+#include "Engine/Utilities/Compression.h"
 #if USE_EDITOR
 #include "Engine/Serialization/JsonWriter.h"
 #include "Engine/Serialization/JsonWriters.h"
@@ -641,81 +644,225 @@ bool FlaxStorage::LoadAssetChunk(FlaxChunk* chunk)
         return true;
     }
 
-    LockChunks();
+    return LoadAssetChunks(ToSpan(&chunk, 1));
+}
 
-    // Open file
-    auto stream = OpenFile();
-    bool failed = stream == nullptr;
-    if (!failed)
+namespace
+{
+    struct ChunkDecompression
+    {
+        FlaxChunk* Chunk;
+        const byte* Data;
+        int32 Size;
+        int32 OriginalSize;
+        Array<byte>* Buffer;
+        int32 Result;
+    };
+
+    // Chunks smaller than this are decompressed on a loading thread (job overhead would be bigger than the work)
+    constexpr int32 ChunkDecompressionJobMinSize = 16 * 1024;
+
+    void DecompressChunk(ChunkDecompression& e)
     {
-        // Seek
-        stream->SetPosition(chunk->LocationInFile.Address);
+        PROFILE_CPU_NAMED("DecompressLZ4");
+        e.Chunk->Data.Allocate(e.OriginalSize);
+        e.Result = LZ4_decompress_safe((const char*)e.Data, e.Chunk->Data.Get<char>(), e.Size, e.OriginalSize);
+        if (e.Result > 0)
+            e.Chunk->Data.SetLength(e.Result);
+        else
+            e.Chunk->Data.Release();
+    }
+}
 
-        if (stream->HasError())
+FileReadStream* FlaxStorage::OpenFile(uint32 position)
+{
+    auto stream = OpenFile();
+    if (stream == nullptr)
+        return nullptr;
+    stream->SetPosition(position);
+    if (stream->HasError())
+    {
+        // Sometimes stream->HasError() from setposition. result in a crash or missing media in release (stream _file._handle = nullptr).
+        // When retrying, it looks like it works and we can continue. We need this to success.
+        for (int retry = 0; retry < 5; retry++)
         {
-            // Sometimes stream->HasError() from setposition. result in a crash or missing media in release (stream _file._handle = nullptr).
-            // When retrying, it looks like it works and we can continue. We need this to success.
-
-            for (int retry = 0; retry < 5; retry++)
+            Platform::Sleep(50);
+            stream = OpenFile();
+            if (stream)
             {
-                Platform::Sleep(50);
-                stream = OpenFile();
-                failed = stream == nullptr;
-                if (!failed)
-                {
-                    stream->SetPosition(chunk->LocationInFile.Address);
-                }
+                stream->SetPosition(position);
                 if (!stream->HasError())
                     break;
             }
         }
+    }
+    if (stream == nullptr || stream->HasError())
+    {
+        LOG(Warning, "SetPosition failed on chunk {0}.", ToString());
+        return nullptr;
+    }
+    return stream;
+}
 
-        if (stream->HasError())
-        {
-            failed = true;
-            UnlockChunks();
-            LOG(Warning, "SetPosition failed on chunk {0}.", ToString());
-            return failed;
-        }
+bool FlaxStorage::LoadAssetChunks(const Span<FlaxChunk*>& chunks)
+{
+    ASSERT(IsLoaded());
+    LockChunks();
+    bool failed = false;
 
-        // Load data
+    // Read chunks data from the file (serialized) and collect compressed ones for decompression
+    Array<ChunkDecompression, InlinedAllocation<ASSET_FILE_DATA_CHUNKS>> decompressions;
+    int32 decompressionJobs = 0;
+#if FLAX_STORAGE_USE_FILE_MAPPING
+    byte* mappedData = MapFile();
+#endif
+    for (FlaxChunk* chunk : chunks)
+    {
+        if (!chunk || chunk->IsLoaded() || !chunk->ExistsInFile())
+            continue;
         auto size = chunk->LocationInFile.Size;
-        if (EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::CompressedLZ4))
+        const bool compressed = EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::CompressedLZ4 | FlaxChunkFlags::CompressedLZ4HC);
+#if FLAX_STORAGE_USE_FILE_MAPPING
+        if (mappedData && (uint64)chunk->LocationInFile.Address + size <= _mappedSize)
         {
-            // Compressed
-            size -= sizeof(int32); // Don't count original size int
-            int32 originalSize;
-            stream->ReadInt32(&originalSize);
-            Array<byte> tmpBuf;
-            tmpBuf.Resize(size); // TODO: maybe use thread local or content loading pool with sharable temp buffers for the decompression?
-            stream->ReadBytes(tmpBuf.Get(), size);
-
-            // Decompress data
-            PROFILE_CPU_NAMED("DecompressLZ4");
-            chunk->Data.Allocate(originalSize);
-            const int32 res = LZ4_decompress_safe((const char*)tmpBuf.Get(), chunk->Data.Get<char>(), size, originalSize);
-            if (res <= 0)
+            const byte* chunkData = mappedData + chunk->LocationInFile.Address;
+            if (compressed)
             {
-                UnlockChunks();
-                LOG(Warning, "Cannot load chunk from {0}. Failed to decompress it data. Result: {1}.", ToString(), res);
-                return true;
+                // Decompress directly from the file view
+                auto& e = decompressions.AddOne();
+                e.Chunk = chunk;
+                e.Data = chunkData + sizeof(int32);
+                e.Size = size - sizeof(int32); // Don't count original size int
+                e.OriginalSize = *(const int32*)chunkData;
+                e.Buffer = nullptr;
+                decompressionJobs += e.OriginalSize >= ChunkDecompressionJobMinSize ? 1 : 0;
+            }
+            else
+            {
+                // Raw data (zero-copy)
+                chunk->Data.Link(chunkData, size);
+                chunk->RegisterUsage();
             }
-            chunk->Data.SetLength(res);
+            continue;
+        }
+#endif
+        auto stream = OpenFile(chunk->LocationInFile.Address);
+        if (!stream)
+        {
+            failed = true;
+            break;
+        }
+        if (compressed)
+        {
+            // Compressed
+            auto& e = decompressions.AddOne();
+            e.Chunk = chunk;
+            e.Size = size - sizeof(int32); // Don't count original size int
+            stream->ReadInt32(&e.OriginalSize);
+            e.Buffer = ContentStorageManager::AcquireScratchBuffer(e.Size);
+            e.Data = e.Buffer->Get();
+            stream->ReadBytes(e.Buffer->Get(), e.Size);
+            decompressionJobs += e.OriginalSize >= ChunkDecompressionJobMinSize ? 1 : 0;
         }
         else
         {
             // Raw data
             chunk->Data.Read(stream, size);
+            ASSERT(chunk->IsLoaded());
+            chunk->RegisterUsage();
         }
-        ASSERT(chunk->IsLoaded());
-        chunk->RegisterUsage();
     }
 
-    UnlockChunks();
+    // Decompress data (in parallel if there are multiple big chunks)
+    if (!failed && decompressions.HasItems())
+    {
+        if (decompressionJobs > 1)
+        {
+            Function<void(int32)> job = [&decompressions](int32 index)
+            {
+                DecompressChunk(decompressions[index]);
+            };
+            JobSystem::Wait(JobSystem::Dispatch(job, decompressions.Count()));
+        }
+        else
+        {
+            for (auto& e : decompressions)
+                DecompressChunk(e);
+        }
+        for (auto& e : decompressions)
+        {
+            if (e.Result <= 0)
+            {
+                LOG(Warning, "Cannot load chunk from {0}. Failed to decompress it data. Result: {1}.", ToString(), e.Result);
+                failed = true;
+            }
+            else
+            {
+                e.Chunk->RegisterUsage();
+            }
+        }
+    }
+    for (auto& e : decompressions)
+        ContentStorageManager::ReleaseScratchBuffer(e.Buffer);
 
+    UnlockChunks();
     return failed;
 }
 
+namespace
+{
+    bool SortChunkLocations(const FlaxChunk::Location& a, const FlaxChunk::Location& b)
+    {
+        return a.Address < b.Address;
+    }
+}
+
+void FlaxStorage::PrefetchAssetChunks(const Span<FlaxChunk*>& chunks)
+{
+    // Collect regions to read (in the file order)
+    Array<FlaxChunk::Location, InlinedAllocation<ASSET_FILE_DATA_CHUNKS>> regions;
+    for (FlaxChunk* chunk : chunks)
+    {
+        if (chunk && chunk->ExistsInFile() && !chunk->IsLoaded())
+            regions.Add(chunk->LocationInFile);
+    }
+    if (regions.IsEmpty())
+        return;
+    PROFILE_CPU();
+    Sorting::QuickSort(regions.Get(), regions.Count(), &SortChunkLocations);
+
+    // Get the file to issue the read-ahead on
+    const File* file = nullptr;
+#if FLAX_STORAGE_USE_FILE_MAPPING
+    if (MapFile())
+        file = _mappedFile;
+#endif
+    if (!file)
+    {
+        auto stream = OpenFile();
+        if (!stream)
+            return;
+        file = stream->GetFile();
+    }
+
+    // Merge adjacent regions to reduce the amount of requests
+    FlaxChunk::Location region = regions[0];
+    for (int32 i = 1; i < regions.Count(); i++)
+    {
+        const FlaxChunk::Location& next = regions[i];
+        if (next.Address <= region.Address + region.Size)
+        {
+            region.Size = Math::Max(region.Address + region.Size, next.Address + next.Size) - region.Address;
+        }
+        else
+        {
+            file->Prefetch(region.Address, region.Size);
+            region = next;
+        }
+    }
+    file->Prefetch(region.Address, region.Size);
+}
+
 #if USE_EDITOR
 
 bool FlaxStorage::ChangeAssetID(Entry& e, const Guid& newId)
@@ -751,13 +898,10 @@ bool FlaxStorage::ChangeAssetID(Entry& e, const Guid& newId)
     }
 
     // Load all chunks
-    for (int32 i = 0; i < _chunks.Count(); i++)
+    if (LoadAssetChunks(ToSpan(_chunks)))
     {
-        if (LoadAssetChunk(_chunks[i]))
-        {
-            LOG(Warning, "Cannot load asset chunk.");
-            return true;
-        }
+        LOG(Warning, "Cannot load asset chunk.");
+        return true;
     }
 
     // Close file
@@ -896,14 +1040,18 @@ bool FlaxStorage::Create(WriteStream* stream, const AssetInitData* data, int32 d
     for (int32 i = 0; i < chunksCount; i++)
     {
         const FlaxChunk* chunk = chunks[i];
-        if (EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::CompressedLZ4))
+        if (EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::CompressedLZ4 | FlaxChunkFlags::CompressedLZ4HC))
         {
             PROFILE_CPU_NAMED("CompressLZ4");
             const int32 srcSize = chunk->Data.Length();
             const int32 maxSize = LZ4_compressBound(srcSize);
             auto& chunkCompressed = compressedChunks[i];
             chunkCompressed.Resize(maxSize);
-            const int32 dstSize = LZ4_compress_default(chunk->Data.Get<char>(), (char*)chunkCompressed.Get(), srcSize, maxSize);
+            int32 dstSize;
+            if (EnumHasAnyFlags(chunk->Flags, FlaxChunkFlags::CompressedLZ4HC))
+                dstSize = Compression::CompressLZ4HC(chunk->Data.Get(), srcSize, chunkCompressed.Get(), maxSize);
+            else
+                dstSize = LZ4_compress_default(chunk->Data.Get<char>(), (char*)chunkCompressed.Get(), srcSize, maxSize);
             if (dstSize <= 0)
             {
                 chunkCompressed.Resize(0);
@@ -1334,6 +1482,67 @@ FileReadStream* FlaxStorage::OpenFile()
     return stream;
 }
 
+#if FLAX_STORAGE_USE_FILE_MAPPING
+
+byte* FlaxStorage::MapFile()
+{
+    byte* data = (byte*)Platform::AtomicRead((int64 volatile*)&_mappedData);
+    if (data || !IsPackage() || AllowDataModifications())
+        return data;
+    ScopeLock lock(_loadLocker);
+    if (_mappedData || _mappingFailed)
+        return _mappedData;
+
+    // Map the whole file (data pages are loaded by the system on access)
+    PROFILE_CPU();
+    auto file = File::Open(_path, FileMode::OpenExisting, FileAccess::Read, FileShare::Read);
+    if (file)
+    {
+        _mappedSize = file->GetSize();
+        data = (byte*)file->Map();
+        if (!data)
+            Delete(file);
+    }
+    if (!data)
+    {
+        // Fallback to the file streams
+        _mappingFailed = true;
+        return nullptr;
+    }
+    _mappedFile = file;
+    Platform::AtomicStore((int64 volatile*)&_mappedData, (int64)data);
+    return data;
+}
+
+bool FlaxStorage::UnmapFile()
+{
+    ScopeLock lock(_loadLocker);
+    if (!_mappedData)
+        return false;
+
+    // Loaded chunks can link the file view memory (and their data pointers can be used by the assets) so keep it mapped until they get unloaded
+    for (FlaxChunk* chunk : _chunks)
+    {
+        if (IsMapped(chunk))
+            return true;
+    }
+
+    _mappedFile->Unmap(_mappedData, (uint32)_mappedSize);
+    Delete(_mappedFile);
+    _mappedFile = nullptr;
+    Platform::AtomicStore((int64 volatile*)&_mappedData, 0);
+    _mappedSize = 0;
+    return false;
+}
+
+bool FlaxStorage::IsMapped(const FlaxChunk* chunk) const
+{
+    const byte* data = chunk->Data.Get();
+    return chunk->IsLoaded() && !chunk->Data.IsAllocated() && data >= _mappedData && data < _mappedData + _mappedSize;
+}
+
+#endif
+
 bool FlaxStorage::CloseFileHandles()
 {
     PROFILE_CPU();
@@ -1375,6 +1584,10 @@ bool FlaxStorage::CloseFileHandles()
             Delete(stream);
     }
     _file.Clear();
+#if FLAX_STORAGE_USE_FILE_MAPPING
+    if (UnmapFile())
+        return true; // Failed, file view is still used by the loaded chunks
+#endif
     return false;
 }
 
@@ -1383,6 +1596,18 @@ void FlaxStorage::Dispose()
     if (IsDisposed())
         return;
 
+#if FLAX_STORAGE_USE_FILE_MAPPING
+    // Release chunks linked to the file view to skip copying them when closing it
+    if (Platform::AtomicRead(&_chunksLock) == 0)
+    {
+        for (FlaxChunk* chunk : _chunks)
+        {
+            if (IsMapped(chunk))
+                chunk->Unload();
+        }
+    }
+#endif
+
     // Close file
     if (CloseFileHandles())
     {
@@ -1391,6 +1616,10 @@ void FlaxStorage::Dispose()
 
     // Release data
     _chunks.ClearDelete();
+#if FLAX_STORAGE_USE_FILE_MAPPING
+    // Close the file view that could be kept by the chunks linked to it
+    UnmapFile();
+#endif
     _version = 0;
 }
 
@@ -6,6 +6,7 @@
 #include "Engine/Core/Delegate.h"
 #include "Engine/Core/Types/String.h"
 #include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Types/Span.h"
 #include "Engine/Platform/CriticalSection.h"
 #include "Engine/Serialization/FileReadStream.h"
 #include "Engine/Threading/ThreadLocal.h"
@@ -16,6 +17,11 @@
 class ContentStorageManager;
 struct FlaxStorageReference;
 
+// Enables reading chunks of the cooked read-only packages via memory-mapped file view (zero-copy for uncompressed chunks)
+#ifndef FLAX_STORAGE_USE_FILE_MAPPING
+#define FLAX_STORAGE_USE_FILE_MAPPING (PLATFORM_64BITS && !USE_EDITOR)
+#endif
+
 /// <summary>
 /// Flax assets storage container.
 /// </summary>
@@ -95,6 +101,12 @@ class FLAXENGINE_API FlaxStorage : public Object
     // Storage
     ThreadLocal<FileReadStream*> _file;
     Array<FlaxChunk*> _chunks;
+#if FLAX_STORAGE_USE_FILE_MAPPING
+    File* _mappedFile = nullptr;
+    byte* _mappedData = nullptr;
+    uint64 _mappedSize = 0;
+    bool _mappingFailed = false;
+#endif
 
     // Metadata
     uint32 _version;
@@ -383,6 +395,19 @@ class FLAXENGINE_API FlaxStorage : public Object
     /// <returns>True if cannot load data, otherwise false</returns>
     bool LoadAssetChunk(FlaxChunk* chunk);
 
+    /// <summary>
+    /// Loads the asset chunks. Reads the data from the file in the given order and decompresses chunks in parallel via Job System (if there are multiple big chunks to decompress).
+    /// </summary>
+    /// <param name="chunks">The chunks to load (missing and already loaded ones are skipped).</param>
+    /// <returns>True if cannot load data, otherwise false</returns>
+    bool LoadAssetChunks(const Span<FlaxChunk*>& chunks);
+
+    /// <summary>
+    /// Starts the asynchronous read-ahead of the asset chunks data. Used to batch storage reads before loading the chunks one-by-one, so loading threads don't block on the storage device latency for each chunk.
+    /// </summary>
+    /// <param name="chunks">The chunks to prefetch (missing and already loaded ones are skipped).</param>
+    void PrefetchAssetChunks(const Span<FlaxChunk*>& chunks);
+
 #if USE_EDITOR
 
     /// <summary>
@@ -486,5 +511,11 @@ class FLAXENGINE_API FlaxStorage : public Object
     void AddChunk(FlaxChunk* chunk);
     virtual void AddEntry(Entry& e) = 0;
     FileReadStream* OpenFile();
+    FileReadStream* OpenFile(uint32 position);
+#if FLAX_STORAGE_USE_FILE_MAPPING
+    byte* MapFile();
+    bool UnmapFile();
+    bool IsMapped(const FlaxChunk* chunk) const;
+#endif
     virtual bool GetEntry(const Guid& id, Entry& e) = 0;
 };
@@ -12,6 +12,7 @@
 #include "Engine/Serialization/Serialization.h"
 #include "Engine/Content/Storage/ContentStorageManager.h"
 #include "Engine/Audio/AudioClip.h"
+#include "Engine/Audio/Config.h"
 #include "Engine/Tools/AudioTool/AudioTool.h"
 #include "Engine/Tools/AudioTool/MP3Decoder.h"
 #include "Engine/Tools/AudioTool/WaveDecoder.h"
@@ -64,8 +65,8 @@ CreateAssetResult ImportAudio::Import(CreateAssetContext& context, AudioDecoder&
         }
     }
 
-    // Vorbis uses fixed 16-bit depth
-    if (options.Format == AudioFormat::Vorbis)
+    // Vorbis and ADPCM use fixed 16-bit depth
+    if (options.Format == AudioFormat::Vorbis || options.Format == AudioFormat::ADPCM)
         options.BitDepth = AudioTool::BitDepth::_16;
 
     LOG_STR(Info, options.ToString());
@@ -123,6 +124,13 @@ CreateAssetResult ImportAudio::Import(CreateAssetContext& context, AudioDecoder&
 #endif
 #define HANDLE_RAW(chunkIndex, dataPtr, dataSize) \
     context.Data.Header.Chunks[chunkIndex]->Data.Copy(dataPtr, dataSize);
+#define HANDLE_ADPCM(chunkIndex, dataPtr, dataSize) \
+    { \
+        const uint32 adpcmSamples = samplesPerChunk[chunkIndex] / info.NumChannels; \
+        auto& adpcmData = context.Data.Header.Chunks[chunkIndex]->Data; \
+        adpcmData.Allocate(AudioTool::GetADPCMSize(adpcmSamples, info.NumChannels)); \
+        AudioTool::ConvertToADPCM((const int16*)(dataPtr), adpcmData.Get(), adpcmSamples, info.NumChannels); \
+    }
 
 #define WRITE_DATA(chunkIndex, dataPtr, dataSize) \
     samplesPerChunk[chunkIndex] = (dataSize) / (outputBitDepth / 8); \
@@ -138,6 +146,11 @@ CreateAssetResult ImportAudio::Import(CreateAssetContext& context, AudioDecoder&
         HANDLE_VORBIS(chunkIndex, dataPtr, dataSize); \
     } \
     break; \
+    case AudioFormat::ADPCM: \
+    { \
+        HANDLE_ADPCM(chunkIndex, dataPtr, dataSize); \
+    } \
+    break; \
     default: \
     { \
         LOG(Warning, "Unknown audio format."); \
@@ -160,8 +173,11 @@ CreateAssetResult ImportAudio::Import(CreateAssetContext& context, AudioDecoder&
     {
         // Split audio data into a several chunks (uniform data spread)
         const int32 minChunkSize = 1 * 1024 * 1024; // 1 MB
-        const int32 dataAlignment = info.NumChannels * bytesPerSample; // Ensure to never split samples in-between (eg. 24-bit that uses 3 bytes)
-        const int32 chunkSize = Math::Max<int32>(minChunkSize, (int32)Math::AlignUp<uint32>(bufferSize / ASSET_FILE_DATA_CHUNKS, dataAlignment));
+        int32 dataAlignment = info.NumChannels * bytesPerSample; // Ensure to never split samples in-between (eg. 24-bit that uses 3 bytes)
+        if (options.Format == AudioFormat::ADPCM)
+            dataAlignment *= AUDIO_ADPCM_BLOCK_SAMPLES; // Ensure to never split ADPCM blocks (only the last chunk can end with a partial block)
+        int32 chunkSize = Math::Max<int32>(minChunkSize, bufferSize / ASSET_FILE_DATA_CHUNKS);
+        chunkSize = (chunkSize + dataAlignment - 1) / dataAlignment * dataAlignment;
         const int32 chunksCount = Math::CeilToInt((float)bufferSize / chunkSize);
         ASSERT(chunksCount > 0 && chunksCount <= ASSET_FILE_DATA_CHUNKS);
 
@@ -0,0 +1,883 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Memory/Memory.h"
+#include "Engine/Core/Memory/Allocation.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Collections/HashFunctions.h"
+#include "Engine/Core/Collections/FlatHashGroup.h"
+
+/// <summary>
+/// Template for unordered dictionary with mapped key with value pairs implemented as open-addressing hash table with separate arrays for control bytes, keys and values.
+/// Lookups probe group of control bytes at once (SSE2/NEON) and touch the keys only for the matching hash bits, which is faster than Dictionary for the large, lookup-heavy maps.
+/// </summary>
+/// <remarks>
+/// API matches Dictionary (except that Add returns value pointer and the iterator exposes Key/Value references). Removing or inserting items invalidates the iterators. Removal with Remove(Iterator) moves the next item of the probing chain into the removed slot (if any), so the loops that remove items should not increment iterator after the removal. Iteration from Begin visits every item exactly once even if items get removed during it (it starts after an empty slot which the probing chains never cross).
+/// </remarks>
+/// <typeparam name="KeyType">The type of the keys in the dictionary.</typeparam>
+/// <typeparam name="ValueType">The type of the values in the dictionary.</typeparam>
+/// <typeparam name="AllocationType">The type of memory allocator.</typeparam>
+template<typename KeyType, typename ValueType, typename AllocationType = HeapAllocation>
+class FlatDictionary
+{
+    friend FlatDictionary;
+public:
+    /// <summary>
+    /// The references to the key and value of the single dictionary item.
+    /// </summary>
+    struct Element
+    {
+        /// <summary>The key.</summary>
+        const KeyType& Key;
+        /// <summary>The value.</summary>
+        ValueType& Value;
+    };
+
+    typedef typename AllocationType::template Data<byte> CtrlAllocationData;
+    typedef typename AllocationType::template Data<KeyType> KeysAllocationData;
+    typedef typename AllocationType::template Data<ValueType> ValuesAllocationData;
+
+private:
+    int32 _elementsCount = 0;
+    int32 _size = 0;
+    CtrlAllocationData _ctrl;
+    KeysAllocationData _keys;
+    ValuesAllocationData _values;
+
+    static void MoveToEmpty(FlatDictionary& to, FlatDictionary& from)
+    {
+        to._elementsCount = from._elementsCount;
+        to._size = from._size;
+        if IF_CONSTEXPR (AllocationType::HasSwap)
+        {
+            to._ctrl.Swap(from._ctrl);
+            to._keys.Swap(from._keys);
+            to._values.Swap(from._values);
+        }
+        else if (from._size != 0)
+        {
+            to._ctrl.Allocate(from._size + FlatHash::Group::Width);
+            to._keys.Allocate(from._size);
+            to._values.Allocate(from._size);
+            Platform::MemoryCopy(to._ctrl.Get(), from._ctrl.Get(), from._size + FlatHash::Group::Width);
+            const byte* ctrl = from._ctrl.Get();
+            for (int32 i = 0; i < from._size; i++)
+            {
+                if (ctrl[i] & FlatHash::Empty)
+                    continue;
+                Memory::MoveItems(to._keys.Get() + i, from._keys.Get() + i, 1);
+                Memory::MoveItems(to._values.Get() + i, from._values.Get() + i, 1);
+                Memory::DestructItem(from._keys.Get() + i);
+                Memory::DestructItem(from._values.Get() + i);
+            }
+            from._ctrl.Free();
+            from._keys.Free();
+            from._values.Free();
+        }
+        from._elementsCount = 0;
+        from._size = 0;
+    }
+
+public:
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatDictionary"/> class.
+    /// </summary>
+    FlatDictionary()
+    {
+    }
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatDictionary"/> class.
+    /// </summary>
+    /// <param name="capacity">The initial capacity (amount of slots).</param>
+    explicit FlatDictionary(const int32 capacity)
+    {
+        SetCapacity(capacity);
+    }
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatDictionary"/> class.
+    /// </summary>
+    /// <param name="other">The other collection to move.</param>
+    FlatDictionary(FlatDictionary&& other) noexcept
+    {
+        MoveToEmpty(*this, other);
+    }
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatDictionary"/> class.
+    /// </summary>
+    /// <param name="other">Other collection to copy</param>
+    FlatDictionary(const FlatDictionary& other)
+    {
+        Clone(other);
+    }
+
+    /// <summary>
+    /// Clones the data from the other collection.
+    /// </summary>
+    /// <param name="other">The other collection to copy.</param>
+    /// <returns>The reference to this.</returns>
+    FlatDictionary& operator=(const FlatDictionary& other)
+    {
+        if (this != &other)
+            Clone(other);
+        return *this;
+    }
+
+    /// <summary>
+    /// Moves the data from the other collection.
+    /// </summary>
+    /// <param name="other">The other collection to move.</param>
+    /// <returns>The reference to this.</returns>
+    FlatDictionary& operator=(FlatDictionary&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Clear();
+            Free();
+            MoveToEmpty(*this, other);
+        }
+        return *this;
+    }
+
+    /// <summary>
+    /// Finalizes an instance of the <see cref="FlatDictionary"/> class.
+    /// </summary>
+    ~FlatDictionary()
+    {
+        Clear();
+    }
+
+public:
+    /// <summary>
+    /// Gets the amount of the elements in the collection.
+    /// </summary>
+    FORCE_INLINE int32 Count() const
+    {
+        return _elementsCount;
+    }
+
+    /// <summary>
+    /// Gets the amount of the slots in the collection (elements can use up to 3/4 of it before rehashing).
+    /// </summary>
+    FORCE_INLINE int32 Capacity() const
+    {
+        return _size;
+    }
+
+    /// <summary>
+    /// Returns true if collection is empty.
+    /// </summary>
+    FORCE_INLINE bool IsEmpty() const
+    {
+        return _elementsCount == 0;
+    }
+
+    /// <summary>
+    /// Returns true if collection has one or more elements.
+    /// </summary>
+    FORCE_INLINE bool HasItems() const
+    {
+        return _elementsCount != 0;
+    }
+
+public:
+    /// <summary>
+    /// The FlatDictionary collection iterator.
+    /// </summary>
+    struct Iterator
+    {
+        friend FlatDictionary;
+    private:
+        FlatDictionary* _collection;
+        int32 _index;
+        int32 _start;
+        alignas(Element) mutable byte _element[sizeof(Element)];
+
+    public:
+        Iterator(FlatDictionary* collection, const int32 index, const int32 start = -1)
+            : _collection(collection)
+            , _index(index)
+            , _start(start)
+        {
+        }
+
+        Iterator(FlatDictionary const* collection, const int32 index, const int32 start = -1)
+            : _collection(const_cast<FlatDictionary*>(collection))
+            , _index(index)
+            , _start(start)
+        {
+        }
+
+        Iterator()
+            : _collection(nullptr)
+            , _index(-1)
+            , _start(-1)
+        {
+        }
+
+        Iterator(const Iterator& i)
+            : _collection(i._collection)
+            , _index(i._index)
+            , _start(i._start)
+        {
+        }
+
+    public:
+        FORCE_INLINE int32 Index() const
+        {
+            return _index;
+        }
+
+        FORCE_INLINE bool IsEnd() const
+        {
+            return _index == _collection->_size;
+        }
+
+        FORCE_INLINE bool IsNotEnd() const
+        {
+            return _index != _collection->_size;
+        }
+
+        FORCE_INLINE Element& operator*() const
+        {
+            return *new(_element) Element{ _collection->_keys.Get()[_index], _collection->_values.Get()[_index] };
+        }
+
+        FORCE_INLINE Element* operator->() const
+        {
+            return &**this;
+        }
+
+        FORCE_INLINE explicit operator bool() const
+        {
+            return _index >= 0 && _index < _collection->_size;
+        }
+
+        FORCE_INLINE bool operator!() const
+        {
+            return !(bool)*this;
+        }
+
+        FORCE_INLINE bool operator==(const Iterator& v) const
+        {
+            return _index == v._index && _collection == v._collection;
+        }
+
+        FORCE_INLINE bool operator!=(const Iterator& v) const
+        {
+            return _index != v._index || _collection != v._collection;
+        }
+
+        Iterator& operator=(const Iterator& v)
+        {
+            _collection = v._collection;
+            _index = v._index;
+            _start = v._start;
+            return *this;
+        }
+
+        Iterator& operator++()
+        {
+            const int32 capacity = _collection->_size;
+            if (_index != capacity)
+            {
+                const byte* ctrl = _collection->_ctrl.Get();
+                if (_start == -1)
+                {
+                    do
+                    {
+                        _index++;
+                    } while (_index != capacity && (ctrl[_index] & FlatHash::Empty));
+                }
+                else
+                {
+                    // Cyclic iteration that begins after the empty slot (probing chains don't cross it, so items shifted back by removal never move into the already visited slots)
+                    const int32 mask = capacity - 1;
+                    do
+                    {
+                        _index = (_index + 1) & mask;
+                        if (_index == _start)
+                        {
+                            _index = capacity;
+                            break;
+                        }
+                    } while (ctrl[_index] & FlatHash::Empty);
+                }
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) const
+        {
+            Iterator i = *this;
+            ++i;
+            return i;
+        }
+    };
+
+public:
+    /// <summary>
+    /// Gets element by the key (will add default ValueType element if key not found).
+    /// </summary>
+    /// <param name="key">The key of the element.</param>
+    /// <returns>The value that is at given index.</returns>
+    template<typename KeyComparableType>
+    ValueType& At(const KeyComparableType& key)
+    {
+        const uint32 hash = FlatHash::Mix(GetHash(key));
+        int32 index = FindSlot(key, hash);
+        if (index == -1)
+        {
+            index = OnAdd(key, hash);
+            Memory::ConstructItem(_values.Get() + index);
+        }
+        return _values.Get()[index];
+    }
+
+    /// <summary>
+    /// Gets the element by the key.
+    /// </summary>
+    /// <param name="key">The ky of the element.</param>
+    /// <returns>The value that is at given index.</returns>
+    template<typename KeyComparableType>
+    const ValueType& At(const KeyComparableType& key) const
+    {
+        const int32 index = FindSlot(key, FlatHash::Mix(GetHash(key)));
+        ASSERT(index != -1);
+        return _values.Get()[index];
+    }
+
+    /// <summary>
+    /// Gets or sets the element by the key.
+    /// </summary>
+    /// <param name="key">The key of the element.</param>
+    /// <returns>The value that is at given index.</returns>
+    template<typename KeyComparableType>
+    FORCE_INLINE ValueType& operator[](const KeyComparableType& key)
+    {
+        return At(key);
+    }
+
+    /// <summary>
+    /// Gets or sets the element by the key.
+    /// </summary>
+    /// <param name="key">The ky of the element.</param>
+    /// <returns>The value that is at given index.</returns>
+    template<typename KeyComparableType>
+    FORCE_INLINE const ValueType& operator[](const KeyComparableType& key) const
+    {
+        return At(key);
+    }
+
+    /// <summary>
+    /// Tries to get element with given key.
+    /// </summary>
+    /// <param name="key">The key of the element.</param>
+    /// <param name="result">The result value.</param>
+    /// <returns>True if element of given key has been found, otherwise false.</returns>
+    template<typename KeyComparableType>
+    bool TryGet(const KeyComparableType& key, ValueType& result) const
+    {
+        if (IsEmpty())
+            return false;
+        const int32 index = FindSlot(key, FlatHash::Mix(GetHash(key)));
+        if (index == -1)
+            return false;
+        result = _values.Get()[index];
+        return true;
+    }
+
+    /// <summary>
+    /// Tries to get pointer to the element with given key.
+    /// </summary>
+    /// <param name="key">The ky of the element.</param>
+    /// <returns>Pointer to the element value or null if cannot find it.</returns>
+    template<typename KeyComparableType>
+    ValueType* TryGet(const KeyComparableType& key) const
+    {
+        if (IsEmpty())
+            return nullptr;
+        const int32 index = FindSlot(key, FlatHash::Mix(GetHash(key)));
+        if (index == -1)
+            return nullptr;
+        return (ValueType*)_values.Get() + index;
+    }
+
+public:
+    /// <summary>
+    /// Clears the collection but without changing its capacity (all inserted elements: keys and values will be removed).
+    /// </summary>
+    void Clear()
+    {
+        if (_elementsCount != 0)
+        {
+            byte* ctrl = _ctrl.Get();
+            for (int32 i = 0; i < _size; i++)
+            {
+                if (ctrl[i] & FlatHash::Empty)
+                    continue;
+                Memory::DestructItem(_keys.Get() + i);
+                Memory::DestructItem(_values.Get() + i);
+            }
+            Platform::MemorySet(ctrl, _size + FlatHash::Group::Width, FlatHash::Empty);
+            _elementsCount = 0;
+        }
+    }
+
+    /// <summary>
+    /// Clears the collection and delete value objects.
+    /// Note: collection must contain pointers to the objects that have public destructor and be allocated using New method.
+    /// </summary>
+#if defined(_MSC_VER)
+    template<typename = typename TEnableIf<TIsPointer<ValueType>::Value>::Type>
+#endif
+    void ClearDelete()
+    {
+        for (Iterator i = Begin(); i.IsNotEnd(); ++i)
+        {
+            if (i->Value)
+                ::Delete(i->Value);
+        }
+        Clear();
+    }
+
+    /// <summary>
+    /// Changes the capacity of the collection.
+    /// </summary>
+    /// <param name="capacity">The new capacity (amount of slots). Gets rounded up to the power of two. Gets increased if cannot fit the current elements.</param>
+    /// <param name="preserveContents">Enables preserving collection contents during resizing.</param>
+    void SetCapacity(int32 capacity, bool preserveContents = true)
+    {
+        ASSERT(capacity >= 0);
+        if (capacity != 0)
+            capacity = Math::RoundUpToPowerOf2(Math::Max(capacity, FlatHash::Group::Width * 2));
+        if (preserveContents)
+        {
+            while (FlatHash::GetMaxLoad(capacity) < _elementsCount)
+                capacity = capacity ? capacity * 2 : FLAT_HASH_DEFAULT_CAPACITY;
+        }
+        if (capacity == _size)
+            return;
+        FlatDictionary old;
+        MoveToEmpty(old, *this);
+        if (capacity)
+        {
+            _ctrl.Allocate(capacity + FlatHash::Group::Width);
+            _keys.Allocate(capacity);
+            _values.Allocate(capacity);
+            Platform::MemorySet(_ctrl.Get(), capacity + FlatHash::Group::Width, FlatHash::Empty);
+        }
+        _size = capacity;
+        if (preserveContents && old._elementsCount != 0)
+        {
+            const byte* oldCtrl = old._ctrl.Get();
+            KeyType* oldKeys = old._keys.Get();
+            ValueType* oldValues = old._values.Get();
+            byte* ctrl = _ctrl.Get();
+            for (int32 i = 0; i < old._size; i++)
+            {
+                if (oldCtrl[i] & FlatHash::Empty)
+                    continue;
+                const uint32 hash = FlatHash::Mix(GetHash(oldKeys[i]));
+                const int32 index = FindEmptySlot(hash);
+                FlatHash::SetCtrl(ctrl, _size, index, FlatHash::H2(hash));
+                Memory::MoveItems(_keys.Get() + index, oldKeys + i, 1);
+                Memory::MoveItems(_values.Get() + index, oldValues + i, 1);
+                _elementsCount++;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Ensures that collection has given capacity.
+    /// </summary>
+    /// <param name="minCapacity">The minimum required capacity (amount of slots).</param>
+    /// <param name="preserveContents">True if preserve collection data when changing its size, otherwise collection after resize will be empty.</param>
+    void EnsureCapacity(int32 minCapacity, bool preserveContents = true)
+    {
+        if (_size >= minCapacity)
+            return;
+        SetCapacity(Math::Max(minCapacity, _size * 2), preserveContents);
+    }
+
+    /// <summary>
+    /// Swaps the contents of collection with the other object without copy operation. Performs fast internal data exchange.
+    /// </summary>
+    /// <param name="other">The other collection.</param>
+    void Swap(FlatDictionary& other)
+    {
+        FlatDictionary tmp;
+        MoveToEmpty(tmp, other);
+        MoveToEmpty(other, *this);
+        MoveToEmpty(*this, tmp);
+    }
+
+public:
+    /// <summary>
+    /// Add pair element to the collection.
+    /// </summary>
+    /// <param name="key">The key.</param>
+    /// <param name="value">The value.</param>
+    /// <returns>Weak reference to the stored value.</returns>
+    template<typename KeyComparableType>
+    ValueType* Add(const KeyComparableType& key, const ValueType& value)
+    {
+        const uint32 hash = FlatHash::Mix(GetHash(key));
+        ASSERT(FindSlot(key, hash) == -1 && "That key has been already added to the dictionary.");
+        const int32 index = OnAdd(key, hash);
+        ValueType* result = _values.Get() + index;
+        Memory::ConstructItems(result, &value, 1);
+        return result;
+    }
+
+    /// <summary>
+    /// Add pair element to the collection.
+    /// </summary>
+    /// <param name="key">The key.</param>
+    /// <param name="value">The value.</param>
+    /// <returns>Weak reference to the stored value.</returns>
+    template<typename KeyComparableType>
+    ValueType* Add(const KeyComparableType& key, ValueType&& value)
+    {
+        const uint32 hash = FlatHash::Mix(GetHash(key));
+        ASSERT(FindSlot(key, hash) == -1 && "That key has been already added to the dictionary.");
+        const int32 index = OnAdd(key, hash);
+        ValueType* result = _values.Get() + index;
+        Memory::MoveItems(result, &value, 1);
+        return result;
+    }
+
+    /// <summary>
+    /// Add pair element to the collection.
+    /// </summary>
+    /// <param name="i">Iterator with key and value.</param>
+    void Add(const Iterator& i)
+    {
+        ASSERT(i._collection != this && i);
+        const Element& e = *i;
+        Add(e.Key, e.Value);
+    }
+
+    /// <summary>
+    /// Removes element with a specified key.
+    /// </summary>
+    /// <param name="key">The element key to remove.</param>
+    /// <returns>True if item has been removed, otherwise false if cannot find it.</returns>
+    template<typename KeyComparableType>
+    bool Remove(const KeyComparableType& key)
+    {
+        if (IsEmpty())
+            return false;
+        const int32 index = FindSlot(key, FlatHash::Mix(GetHash(key)));
+        if (index != -1)
+        {
+            RemoveSlot(index);
+            return true;
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Removes element at specified iterator.
+    /// </summary>
+    /// <param name="i">The element iterator to remove.</param>
+    /// <returns>True if item has been removed, otherwise false if iterator is invalid.</returns>
+    bool Remove(const Iterator& i)
+    {
+        ASSERT(i._collection == this);
+        if (i)
+        {
+            ASSERT(!(_ctrl.Get()[i._index] & FlatHash::Empty));
+            RemoveSlot(i._index);
+            return true;
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Removes element at specified iterator. The iterator will point to the item moved into the freed slot or to the next item, so don't increment it after the removal. Items moved by the removal are never the already visited ones if the iterator comes from Begin.
+    /// </summary>
+    /// <param name="i">The element iterator to remove.</param>
+    /// <returns>True if item has been removed, otherwise false if iterator is invalid.</returns>
+    bool Remove(Iterator& i)
+    {
+        if (Remove((const Iterator&)i))
+        {
+            if (_ctrl.Get()[i._index] & FlatHash::Empty)
+                ++i;
+            return true;
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Removes elements with a specified value
+    /// </summary>
+    /// <param name="value">Element value to remove</param>
+    /// <returns>The amount of removed items. Zero if nothing changed.</returns>
+    int32 RemoveValue(const ValueType& value)
+    {
+        int32 result = 0;
+        const byte* ctrl = _ctrl.Get();
+        for (int32 i = 0; i < _size; i++)
+        {
+            // Check the same slot again after removal as the next item could be moved into it
+            while (!(ctrl[i] & FlatHash::Empty) && _values.Get()[i] == value)
+            {
+                RemoveSlot(i);
+                result++;
+            }
+        }
+        return result;
+    }
+
+public:
+    /// <summary>
+    /// Finds the element with given key in the collection.
+    /// </summary>
+    /// <param name="key">The key to find.</param>
+    /// <returns>The iterator for the found element or End if cannot find it.</returns>
+    template<typename KeyComparableType>
+    Iterator Find(const KeyComparableType& key) const
+    {
+        if (IsEmpty())
+            return End();
+        const int32 index = FindSlot(key, FlatHash::Mix(GetHash(key)));
+        return index != -1 ? Iterator(this, index) : End();
+    }
+
+    /// <summary>
+    /// Checks if given key is in a collection.
+    /// </summary>
+    /// <param name="key">The key to find.</param>
+    /// <returns>True if key has been found in a collection, otherwise false.</returns>
+    template<typename KeyComparableType>
+    bool ContainsKey(const KeyComparableType& key) const
+    {
+        if (IsEmpty())
+            return false;
+        return FindSlot(key, FlatHash::Mix(GetHash(key))) != -1;
+    }
+
+    /// <summary>
+    /// Checks if given value is in a collection.
+    /// </summary>
+    /// <param name="value">The value to find.</param>
+    /// <returns>True if value has been found in a collection, otherwise false.</returns>
+    bool ContainsValue(const ValueType& value) const
+    {
+        if (HasItems())
+        {
+            const byte* ctrl = _ctrl.Get();
+            const ValueType* values = _values.Get();
+            for (int32 i = 0; i < _size; i++)
+            {
+                if (!(ctrl[i] & FlatHash::Empty) && values[i] == value)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Searches for the specified object and returns the zero-based index of the first occurrence within the entire dictionary.
+    /// </summary>
+    /// <param name="value">The value of the key to find.</param>
+    /// <param name="key">The output key.</param>
+    /// <returns>True if value has been found, otherwise false.</returns>
+    bool KeyOf(const ValueType& value, KeyType* key) const
+    {
+        if (HasItems())
+        {
+            const byte* ctrl = _ctrl.Get();
+            const ValueType* values = _values.Get();
+            for (int32 i = 0; i < _size; i++)
+            {
+                if (!(ctrl[i] & FlatHash::Empty) && values[i] == value)
+                {
+                    if (key)
+                        *key = _keys.Get()[i];
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+public:
+    /// <summary>
+    /// Clones other collection into this.
+    /// </summary>
+    /// <param name="other">The other collection to clone.</param>
+    void Clone(const FlatDictionary& other)
+    {
+        Clear();
+        EnsureCapacity(other.Capacity(), false);
+        for (Iterator i = other.Begin(); i != other.End(); ++i)
+            Add(i);
+    }
+
+    /// <summary>
+    /// Gets the keys collection to the output array (will contain unique items).
+    /// </summary>
+    /// <param name="result">The result.</param>
+    template<typename ArrayAllocation>
+    void GetKeys(Array<KeyType, ArrayAllocation>& result) const
+    {
+        for (Iterator i = Begin(); i.IsNotEnd(); ++i)
+            result.Add(i->Key);
+    }
+
+    /// <summary>
+    /// Gets the values collection to the output array (may contain duplicates).
+    /// </summary>
+    /// <param name="result">The result.</param>
+    template<typename ArrayAllocation>
+    void GetValues(Array<ValueType, ArrayAllocation>& result) const
+    {
+        for (Iterator i = Begin(); i.IsNotEnd(); ++i)
+            result.Add(i->Value);
+    }
+
+public:
+    Iterator Begin() const
+    {
+        return BeginIteration();
+    }
+
+    Iterator End() const
+    {
+        return Iterator(this, _size);
+    }
+
+    Iterator begin()
+    {
+        return BeginIteration();
+    }
+
+    FORCE_INLINE Iterator end()
+    {
+        return Iterator(this, _size);
+    }
+
+    const Iterator begin() const
+    {
+        return BeginIteration();
+    }
+
+    FORCE_INLINE const Iterator end() const
+    {
+        return Iterator(this, _size);
+    }
+
+private:
+    Iterator BeginIteration() const
+    {
+        if (_elementsCount == 0)
+            return Iterator(this, _size);
+        const byte* ctrl = _ctrl.Get();
+        int32 start = 0;
+        while (!(ctrl[start] & FlatHash::Empty))
+            start++;
+        Iterator i(this, start, start);
+        ++i;
+        return i;
+    }
+    void Free()
+    {
+        _ctrl.Free();
+        _keys.Free();
+        _values.Free();
+        _size = 0;
+    }
+
+    template<typename KeyComparableType>
+    int32 FindSlot(const KeyComparableType& key, uint32 hash) const
+    {
+        if (_size == 0)
+            return -1;
+        const byte h2 = FlatHash::H2(hash);
+        const int32 mask = _size - 1;
+        const byte* ctrl = _ctrl.Get();
+        const KeyType* keys = _keys.Get();
+        int32 pos = (int32)(FlatHash::H1(hash) & mask);
+        while (true)
+        {
+            const FlatHash::Group group(ctrl + pos);
+            auto match = group.Match(h2);
+            while (match.HasNext())
+            {
+                const int32 index = (pos + match.Next()) & mask;
+                if (keys[index] == key)
+                    return index;
+            }
+            if (group.MatchEmpty().HasNext())
+                return -1;
+            pos = (pos + FlatHash::Group::Width) & mask;
+        }
+    }
+
+    int32 FindEmptySlot(uint32 hash) const
+    {
+        const int32 mask = _size - 1;
+        const byte* ctrl = _ctrl.Get();
+        int32 pos = (int32)(FlatHash::H1(hash) & mask);
+        while (true)
+        {
+            const auto empty = FlatHash::Group(ctrl + pos).MatchEmpty();
+            if (empty.HasNext())
+                return (pos + empty.Lowest()) & mask;
+            pos = (pos + FlatHash::Group::Width) & mask;
+        }
+    }
+
+    template<typename KeyComparableType>
+    int32 OnAdd(const KeyComparableType& key, uint32 hash)
+    {
+        // Ensure to have enough space for the next item
+        if (_elementsCount + 1 > FlatHash::GetMaxLoad(_size))
+            SetCapacity(_size ? _size * 2 : FLAT_HASH_DEFAULT_CAPACITY);
+
+        // Insert at the first empty slot in the probing sequence (keeps the probing chain without gaps)
+        const int32 index = FindEmptySlot(hash);
+        FlatHash::SetCtrl(_ctrl.Get(), _size, index, FlatHash::H2(hash));
+        Memory::ConstructItems(_keys.Get() + index, &key, 1);
+        _elementsCount++;
+        return index;
+    }
+
+    void RemoveSlot(int32 index)
+    {
+        byte* ctrl = _ctrl.Get();
+        KeyType* keys = _keys.Get();
+        ValueType* values = _values.Get();
+        Memory::DestructItem(keys + index);
+        Memory::DestructItem(values + index);
+
+        // Shift back the following items of the probing chain into the gap (tombstone-free deletion)
+        const int32 mask = _size - 1;
+        int32 gap = index;
+        int32 slot = index;
+        while (true)
+        {
+            slot = (slot + 1) & mask;
+            if (ctrl[slot] & FlatHash::Empty)
+                break;
+            const int32 home = (int32)(FlatHash::H1(FlatHash::Mix(GetHash(keys[slot]))) & mask);
+            if (FlatHash::CanShiftBack(gap, slot, home))
+            {
+                Memory::MoveItems(keys + gap, keys + slot, 1);
+                Memory::MoveItems(values + gap, values + slot, 1);
+                Memory::DestructItem(keys + slot);
+                Memory::DestructItem(values + slot);
+                FlatHash::SetCtrl(ctrl, _size, gap, ctrl[slot]);
+                gap = slot;
+            }
+        }
+        FlatHash::SetCtrl(ctrl, _size, gap, FlatHash::Empty);
+        _elementsCount--;
+    }
+};
@@ -0,0 +1,200 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Platform/Defines.h"
+#if PLATFORM_SIMD_SSE2
+#include <emmintrin.h>
+#elif PLATFORM_SIMD_NEON && PLATFORM_ARCH_ARM64
+#include <arm_neon.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/// <summary>
+/// Default capacity for the flat hash tables (amount of slots allocated on the first insertion).
+/// </summary>
+#ifndef FLAT_HASH_DEFAULT_CAPACITY
+#define FLAT_HASH_DEFAULT_CAPACITY 32
+#endif
+
+/// <summary>
+/// Helpers for the open-addressing hash tables (FlatDictionary, FlatHashSet) that store a separate control byte per slot and probe the groups of control bytes at once with SIMD.
+/// </summary>
+/// <remarks>
+/// Control byte is Empty (high bit set) or lower 7 bits of the item hash (H2). Remaining hash bits (H1) select the home slot. Slots are probed linearly in groups (unaligned loads) and the control array has the first group cloned at the end to handle the wrap around.
+/// Deletion doesn't use tombstones: items after the removed one are shifted back into the gap (if their home slot allows it), so the lookups never scan over the deleted slots.
+/// </remarks>
+namespace FlatHash
+{
+    /// <summary>
+    /// Control byte value of the empty slot.
+    /// </summary>
+    constexpr byte Empty = 0x80;
+
+    /// <summary>
+    /// Gets the maximum amount of items in the table of the given capacity before it has to grow (load factor of 3/4 keeps the linear probing chains short).
+    /// </summary>
+    FORCE_INLINE int32 GetMaxLoad(int32 capacity)
+    {
+        return capacity - capacity / 4;
+    }
+
+    /// <summary>
+    /// Mixes the item hash (eg. to decorrelate tables with keys sharing the low bits of hash such as sharded registries).
+    /// </summary>
+    FORCE_INLINE uint32 Mix(uint32 hash)
+    {
+        return (uint32)(((uint64)hash * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+
+    FORCE_INLINE uint32 H1(uint32 mixedHash)
+    {
+        return mixedHash >> 7;
+    }
+
+    FORCE_INLINE byte H2(uint32 mixedHash)
+    {
+        return (byte)(mixedHash & 0x7f);
+    }
+
+    FORCE_INLINE uint32 CountTrailingZeros(uint64 value)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return (uint32)index;
+#else
+        return (uint32)__builtin_ctzll(value);
+#endif
+    }
+
+    /// <summary>
+    /// The mask of slots in a group that matched the query. Iterate with HasNext/Next.
+    /// </summary>
+    template<int32 Shift>
+    struct BitMask
+    {
+        uint64 Mask;
+
+        FORCE_INLINE bool HasNext() const
+        {
+            return Mask != 0;
+        }
+
+        FORCE_INLINE int32 Lowest() const
+        {
+            return (int32)(CountTrailingZeros(Mask) >> Shift);
+        }
+
+        FORCE_INLINE int32 Next()
+        {
+            const int32 result = Lowest();
+            Mask &= Mask - 1;
+            return result;
+        }
+    };
+
+#if PLATFORM_SIMD_SSE2
+    /// <summary>
+    /// Group of 16 control bytes matched with SSE2.
+    /// </summary>
+    struct Group
+    {
+        static constexpr int32 Width = 16;
+        __m128i Ctrl;
+
+        FORCE_INLINE explicit Group(const byte* ctrl)
+            : Ctrl(_mm_loadu_si128((const __m128i*)ctrl))
+        {
+        }
+
+        FORCE_INLINE BitMask<0> Match(byte h2) const
+        {
+            return { (uint64)(uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char)h2), Ctrl)) };
+        }
+
+        FORCE_INLINE BitMask<0> MatchEmpty() const
+        {
+            return { (uint64)(uint32)_mm_movemask_epi8(Ctrl) };
+        }
+    };
+#elif PLATFORM_SIMD_NEON && PLATFORM_ARCH_ARM64
+    /// <summary>
+    /// Group of 16 control bytes matched with NEON (4 bits per slot in the mask).
+    /// </summary>
+    struct Group
+    {
+        static constexpr int32 Width = 16;
+        uint8x16_t Ctrl;
+
+        FORCE_INLINE explicit Group(const byte* ctrl)
+            : Ctrl(vld1q_u8(ctrl))
+        {
+        }
+
+        FORCE_INLINE static uint64 ToMask(uint8x16_t cmp)
+        {
+            return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4)), 0) & 0x8888888888888888ull;
+        }
+
+        FORCE_INLINE BitMask<2> Match(byte h2) const
+        {
+            return { ToMask(vceqq_u8(Ctrl, vdupq_n_u8(h2))) };
+        }
+
+        FORCE_INLINE BitMask<2> MatchEmpty() const
+        {
+            return { ToMask(vcltzq_s8(vreinterpretq_s8_u8(Ctrl))) };
+        }
+    };
+#else
+    /// <summary>
+    /// Group of 8 control bytes matched with SWAR (bit tricks on 64-bit integer).
+    /// </summary>
+    struct Group
+    {
+        static constexpr int32 Width = 8;
+        uint64 Ctrl;
+
+        FORCE_INLINE explicit Group(const byte* ctrl)
+        {
+            Ctrl = 0;
+            for (int32 i = 0; i < Width; i++)
+                Ctrl |= (uint64)ctrl[i] << (i * 8);
+        }
+
+        FORCE_INLINE BitMask<3> Match(byte h2) const
+        {
+            // May return false positives (in rare cases) which are filtered out by the key comparison
+            const uint64 x = Ctrl ^ (0x0101010101010101ull * h2);
+            return { (x - 0x0101010101010101ull) & ~x & 0x8080808080808080ull };
+        }
+
+        FORCE_INLINE BitMask<3> MatchEmpty() const
+        {
+            return { Ctrl & 0x8080808080808080ull };
+        }
+    };
+#endif
+
+    /// <summary>
+    /// Sets the control byte of the slot (including its clone after the end of the control array).
+    /// </summary>
+    FORCE_INLINE void SetCtrl(byte* ctrl, int32 capacity, int32 index, byte value)
+    {
+        ctrl[index] = value;
+        if (index < Group::Width)
+            ctrl[capacity + index] = value;
+    }
+
+    /// <summary>
+    /// Checks if the item at slot can be shifted back into the gap during the tombstone-free deletion (its home slot isn't cyclically in range (gap, slot]).
+    /// </summary>
+    FORCE_INLINE bool CanShiftBack(int32 gap, int32 slot, int32 home)
+    {
+        return gap <= slot ? home <= gap || home > slot : home <= gap && home > slot;
+    }
+}
@@ -0,0 +1,657 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Memory/Memory.h"
+#include "Engine/Core/Memory/Allocation.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Collections/HashFunctions.h"
+#include "Engine/Core/Collections/FlatHashGroup.h"
+
+/// <summary>
+/// Template for unordered set of values (without duplicates with O(1) lookup access) implemented as open-addressing hash table with separate arrays for control bytes and items.
+/// Lookups probe group of control bytes at once (SSE2/NEON) and touch the items only for the matching hash bits, which is faster than HashSet for the large, lookup-heavy sets.
+/// </summary>
+/// <remarks>
+/// API matches HashSet. Removing or inserting items invalidates the iterators. Removal with Remove(Iterator) moves the next item of the probing chain into the removed slot (if any), so the loops that remove items should not increment iterator after the removal. Iteration from Begin visits every item exactly once even if items get removed during it (it starts after an empty slot which the probing chains never cross).
+/// </remarks>
+/// <typeparam name="T">The type of elements in the set.</typeparam>
+/// <typeparam name="AllocationType">The type of memory allocator.</typeparam>
+template<typename T, typename AllocationType = HeapAllocation>
+class FlatHashSet
+{
+    friend FlatHashSet;
+public:
+    /// <summary>
+    /// The reference to the single set item.
+    /// </summary>
+    struct Element
+    {
+        /// <summary>The item.</summary>
+        const T& Item;
+    };
+
+    typedef typename AllocationType::template Data<byte> CtrlAllocationData;
+    typedef typename AllocationType::template Data<T> ItemsAllocationData;
+
+private:
+    int32 _elementsCount = 0;
+    int32 _size = 0;
+    CtrlAllocationData _ctrl;
+    ItemsAllocationData _items;
+
+    static void MoveToEmpty(FlatHashSet& to, FlatHashSet& from)
+    {
+        to._elementsCount = from._elementsCount;
+        to._size = from._size;
+        if IF_CONSTEXPR (AllocationType::HasSwap)
+        {
+            to._ctrl.Swap(from._ctrl);
+            to._items.Swap(from._items);
+        }
+        else if (from._size != 0)
+        {
+            to._ctrl.Allocate(from._size + FlatHash::Group::Width);
+            to._items.Allocate(from._size);
+            Platform::MemoryCopy(to._ctrl.Get(), from._ctrl.Get(), from._size + FlatHash::Group::Width);
+            const byte* ctrl = from._ctrl.Get();
+            for (int32 i = 0; i < from._size; i++)
+            {
+                if (ctrl[i] & FlatHash::Empty)
+                    continue;
+                Memory::MoveItems(to._items.Get() + i, from._items.Get() + i, 1);
+                Memory::DestructItem(from._items.Get() + i);
+            }
+            from._ctrl.Free();
+            from._items.Free();
+        }
+        from._elementsCount = 0;
+        from._size = 0;
+    }
+
+public:
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatHashSet"/> class.
+    /// </summary>
+    FlatHashSet()
+    {
+    }
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatHashSet"/> class.
+    /// </summary>
+    /// <param name="capacity">The initial capacity (amount of slots).</param>
+    explicit FlatHashSet(const int32 capacity)
+    {
+        SetCapacity(capacity);
+    }
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatHashSet"/> class.
+    /// </summary>
+    /// <param name="other">The other collection to move.</param>
+    FlatHashSet(FlatHashSet&& other) noexcept
+    {
+        MoveToEmpty(*this, other);
+    }
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="FlatHashSet"/> class.
+    /// </summary>
+    /// <param name="other">Other collection to copy</param>
+    FlatHashSet(const FlatHashSet& other)
+    {
+        Clone(other);
+    }
+
+    /// <summary>
+    /// Clones the data from the other collection.
+    /// </summary>
+    /// <param name="other">The other collection to copy.</param>
+    /// <returns>The reference to this.</returns>
+    FlatHashSet& operator=(const FlatHashSet& other)
+    {
+        if (this != &other)
+            Clone(other);
+        return *this;
+    }
+
+    /// <summary>
+    /// Moves the data from the other collection.
+    /// </summary>
+    /// <param name="other">The other collection to move.</param>
+    /// <returns>The reference to this.</returns>
+    FlatHashSet& operator=(FlatHashSet&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Clear();
+            _ctrl.Free();
+            _items.Free();
+            MoveToEmpty(*this, other);
+        }
+        return *this;
+    }
+
+    /// <summary>
+    /// Finalizes an instance of the <see cref="FlatHashSet"/> class.
+    /// </summary>
+    ~FlatHashSet()
+    {
+        Clear();
+    }
+
+public:
+    /// <summary>
+    /// Gets the amount of the elements in the collection.
+    /// </summary>
+    FORCE_INLINE int32 Count() const
+    {
+        return _elementsCount;
+    }
+
+    /// <summary>
+    /// Gets the amount of the slots in the collection (elements can use up to 3/4 of it before rehashing).
+    /// </summary>
+    FORCE_INLINE int32 Capacity() const
+    {
+        return _size;
+    }
+
+    /// <summary>
+    /// Returns true if collection is empty.
+    /// </summary>
+    FORCE_INLINE bool IsEmpty() const
+    {
+        return _elementsCount == 0;
+    }
+
+    /// <summary>
+    /// Returns true if collection has one or more elements.
+    /// </summary>
+    FORCE_INLINE bool HasItems() const
+    {
+        return _elementsCount != 0;
+    }
+
+public:
+    /// <summary>
+    /// The FlatHashSet collection iterator.
+    /// </summary>
+    struct Iterator
+    {
+        friend FlatHashSet;
+    private:
+        FlatHashSet* _collection;
+        int32 _index;
+        int32 _start;
+        alignas(Element) mutable byte _element[sizeof(Element)];
+
+    public:
+        Iterator(FlatHashSet* collection, const int32 index, const int32 start = -1)
+            : _collection(collection)
+            , _index(index)
+            , _start(start)
+        {
+        }
+
+        Iterator(FlatHashSet const* collection, const int32 index, const int32 start = -1)
+            : _collection(const_cast<FlatHashSet*>(collection))
+            , _index(index)
+            , _start(start)
+        {
+        }
+
+        Iterator()
+            : _collection(nullptr)
+            , _index(-1)
+            , _start(-1)
+        {
+        }
+
+        Iterator(const Iterator& i)
+            : _collection(i._collection)
+            , _index(i._index)
+            , _start(i._start)
+        {
+        }
+
+    public:
+        FORCE_INLINE int32 Index() const
+        {
+            return _index;
+        }
+
+        FORCE_INLINE bool IsEnd() const
+        {
+            return _index == _collection->_size;
+        }
+
+        FORCE_INLINE bool IsNotEnd() const
+        {
+            return _index != _collection->_size;
+        }
+
+        FORCE_INLINE Element& operator*() const
+        {
+            return *new(_element) Element{ _collection->_items.Get()[_index] };
+        }
+
+        FORCE_INLINE Element* operator->() const
+        {
+            return &**this;
+        }
+
+        FORCE_INLINE explicit operator bool() const
+        {
+            return _index >= 0 && _index < _collection->_size;
+        }
+
+        FORCE_INLINE bool operator!() const
+        {
+            return !(bool)*this;
+        }
+
+        FORCE_INLINE bool operator==(const Iterator& v) const
+        {
+            return _index == v._index && _collection == v._collection;
+        }
+
+        FORCE_INLINE bool operator!=(const Iterator& v) const
+        {
+            return _index != v._index || _collection != v._collection;
+        }
+
+        Iterator& operator=(const Iterator& v)
+        {
+            _collection = v._collection;
+            _index = v._index;
+            _start = v._start;
+            return *this;
+        }
+
+        Iterator& operator++()
+        {
+            const int32 capacity = _collection->_size;
+            if (_index != capacity)
+            {
+                const byte* ctrl = _collection->_ctrl.Get();
+                if (_start == -1)
+                {
+                    do
+                    {
+                        _index++;
+                    } while (_index != capacity && (ctrl[_index] & FlatHash::Empty));
+                }
+                else
+                {
+                    // Cyclic iteration that begins after the empty slot (probing chains don't cross it, so items shifted back by removal never move into the already visited slots)
+                    const int32 mask = capacity - 1;
+                    do
+                    {
+                        _index = (_index + 1) & mask;
+                        if (_index == _start)
+                        {
+                            _index = capacity;
+                            break;
+                        }
+                    } while (ctrl[_index] & FlatHash::Empty);
+                }
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) const
+        {
+            Iterator i = *this;
+            ++i;
+            return i;
+        }
+    };
+
+public:
+    /// <summary>
+    /// Removes all elements from the collection (capacity is not changed).
+    /// </summary>
+    void Clear()
+    {
+        if (_elementsCount != 0)
+        {
+            byte* ctrl = _ctrl.Get();
+            for (int32 i = 0; i < _size; i++)
+            {
+                if (!(ctrl[i] & FlatHash::Empty))
+                    Memory::DestructItem(_items.Get() + i);
+            }
+            Platform::MemorySet(ctrl, _size + FlatHash::Group::Width, FlatHash::Empty);
+            _elementsCount = 0;
+        }
+    }
+
+    /// <summary>
+    /// Changes the capacity of the collection.
+    /// </summary>
+    /// <param name="capacity">The new capacity (amount of slots). Gets rounded up to the power of two. Gets increased if cannot fit the current elements.</param>
+    /// <param name="preserveContents">Enables preserving collection contents during resizing.</param>
+    void SetCapacity(int32 capacity, bool preserveContents = true)
+    {
+        ASSERT(capacity >= 0);
+        if (capacity != 0)
+            capacity = Math::RoundUpToPowerOf2(Math::Max(capacity, FlatHash::Group::Width * 2));
+        if (preserveContents)
+        {
+            while (FlatHash::GetMaxLoad(capacity) < _elementsCount)
+                capacity = capacity ? capacity * 2 : FLAT_HASH_DEFAULT_CAPACITY;
+        }
+        if (capacity == _size)
+            return;
+        FlatHashSet old;
+        MoveToEmpty(old, *this);
+        if (capacity)
+        {
+            _ctrl.Allocate(capacity + FlatHash::Group::Width);
+            _items.Allocate(capacity);
+            Platform::MemorySet(_ctrl.Get(), capacity + FlatHash::Group::Width, FlatHash::Empty);
+        }
+        _size = capacity;
+        if (preserveContents && old._elementsCount != 0)
+        {
+            const byte* oldCtrl = old._ctrl.Get();
+            T* oldItems = old._items.Get();
+            for (int32 i = 0; i < old._size; i++)
+            {
+                if (oldCtrl[i] & FlatHash::Empty)
+                    continue;
+                const uint32 hash = FlatHash::Mix(GetHash(oldItems[i]));
+                const int32 index = FindEmptySlot(hash);
+                FlatHash::SetCtrl(_ctrl.Get(), _size, index, FlatHash::H2(hash));
+                Memory::MoveItems(_items.Get() + index, oldItems + i, 1);
+                _elementsCount++;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Ensures that collection has given capacity.
+    /// </summary>
+    /// <param name="minCapacity">The minimum required capacity (amount of slots).</param>
+    /// <param name="preserveContents">True if preserve collection data when changing its size, otherwise collection after resize will be empty.</param>
+    void EnsureCapacity(int32 minCapacity, bool preserveContents = true)
+    {
+        if (_size >= minCapacity)
+            return;
+        SetCapacity(Math::Max(minCapacity, _size * 2), preserveContents);
+    }
+
+    /// <summary>
+    /// Swaps the contents of collection with the other object without copy operation. Performs fast internal data exchange.
+    /// </summary>
+    /// <param name="other">The other collection.</param>
+    void Swap(FlatHashSet& other)
+    {
+        FlatHashSet tmp;
+        MoveToEmpty(tmp, other);
+        MoveToEmpty(other, *this);
+        MoveToEmpty(*this, tmp);
+    }
+
+public:
+    /// <summary>
+    /// Add element to the collection.
+    /// </summary>
+    /// <param name="item">The element to add to the set.</param>
+    /// <returns>True if element has been added to the collection, otherwise false if the element is already present.</returns>
+    template<typename ItemType>
+    bool Add(const ItemType& item)
+    {
+        const uint32 hash = FlatHash::Mix(GetHash(item));
+        if (FindSlot(item, hash) != -1)
+            return false;
+        const int32 index = OnAdd(hash);
+        Memory::ConstructItems(_items.Get() + index, &item, 1);
+        return true;
+    }
+
+    /// <summary>
+    /// Add element to the collection.
+    /// </summary>
+    /// <param name="item">The element to add to the set.</param>
+    /// <returns>True if element has been added to the collection, otherwise false if the element is already present.</returns>
+    bool Add(T&& item)
+    {
+        const uint32 hash = FlatHash::Mix(GetHash(item));
+        if (FindSlot(item, hash) != -1)
+            return false;
+        const int32 index = OnAdd(hash);
+        Memory::MoveItems(_items.Get() + index, &item, 1);
+        return true;
+    }
+
+    /// <summary>
+    /// Add element at iterator to the collection
+    /// </summary>
+    /// <param name="i">Iterator with item to add</param>
+    void Add(const Iterator& i)
+    {
+        ASSERT(i._collection != this && i);
+        Add(i->Item);
+    }
+
+    /// <summary>
+    /// Removes the specified element from the collection.
+    /// </summary>
+    /// <param name="item">The element to remove.</param>
+    /// <returns>True if item has been removed, otherwise false if cannot find it.</returns>
+    template<typename ItemType>
+    bool Remove(const ItemType& item)
+    {
+        if (IsEmpty())
+            return false;
+        const int32 index = FindSlot(item, FlatHash::Mix(GetHash(item)));
+        if (index != -1)
+        {
+            RemoveSlot(index);
+            return true;
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Removes an element at specified iterator position.
+    /// </summary>
+    /// <param name="i">The element iterator to remove.</param>
+    /// <returns>True if item has been removed, otherwise false if iterator is invalid.</returns>
+    bool Remove(const Iterator& i)
+    {
+        ASSERT(i._collection == this);
+        if (i)
+        {
+            ASSERT(!(_ctrl.Get()[i._index] & FlatHash::Empty));
+            RemoveSlot(i._index);
+            return true;
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Removes an element at specified iterator position. The iterator will point to the item moved into the freed slot or to the next item, so don't increment it after the removal. Items moved by the removal are never the already visited ones if the iterator comes from Begin.
+    /// </summary>
+    /// <param name="i">The element iterator to remove.</param>
+    /// <returns>True if item has been removed, otherwise false if iterator is invalid.</returns>
+    bool Remove(Iterator& i)
+    {
+        if (Remove((const Iterator&)i))
+        {
+            if (_ctrl.Get()[i._index] & FlatHash::Empty)
+                ++i;
+            return true;
+        }
+        return false;
+    }
+
+public:
+    /// <summary>
+    /// Find element with given item in the collection
+    /// </summary>
+    /// <param name="item">Item to find</param>
+    /// <returns>Iterator for the found element or End if cannot find it</returns>
+    template<typename ItemType>
+    Iterator Find(const ItemType& item) const
+    {
+        if (IsEmpty())
+            return End();
+        const int32 index = FindSlot(item, FlatHash::Mix(GetHash(item)));
+        return index != -1 ? Iterator(this, index) : End();
+    }
+
+    /// <summary>
+    /// Determines whether a collection contains the specified element.
+    /// </summary>
+    /// <param name="item">The item to locate.</param>
+    /// <returns>True if value has been found in a collection, otherwise false</returns>
+    template<typename ItemType>
+    bool Contains(const ItemType& item) const
+    {
+        if (IsEmpty())
+            return false;
+        return FindSlot(item, FlatHash::Mix(GetHash(item))) != -1;
+    }
+
+public:
+    /// <summary>
+    /// Clones other collection into this
+    /// </summary>
+    /// <param name="other">Other collection to clone</param>
+    void Clone(const FlatHashSet& other)
+    {
+        Clear();
+        EnsureCapacity(other.Capacity(), false);
+        for (Iterator i = other.Begin(); i != other.End(); ++i)
+            Add(i);
+    }
+
+public:
+    Iterator Begin() const
+    {
+        return BeginIteration();
+    }
+
+    Iterator End() const
+    {
+        return Iterator(this, _size);
+    }
+
+    Iterator begin()
+    {
+        return BeginIteration();
+    }
+
+    FORCE_INLINE Iterator end()
+    {
+        return Iterator(this, _size);
+    }
+
+    const Iterator begin() const
+    {
+        return BeginIteration();
+    }
+
+    FORCE_INLINE const Iterator end() const
+    {
+        return Iterator(this, _size);
+    }
+
+private:
+    Iterator BeginIteration() const
+    {
+        if (_elementsCount == 0)
+            return Iterator(this, _size);
+        const byte* ctrl = _ctrl.Get();
+        int32 start = 0;
+        while (!(ctrl[start] & FlatHash::Empty))
+            start++;
+        Iterator i(this, start, start);
+        ++i;
+        return i;
+    }
+    template<typename ItemType>
+    int32 FindSlot(const ItemType& item, uint32 hash) const
+    {
+        if (_size == 0)
+            return -1;
+        const byte h2 = FlatHash::H2(hash);
+        const int32 mask = _size - 1;
+        const byte* ctrl = _ctrl.Get();
+        const T* items = _items.Get();
+        int32 pos = (int32)(FlatHash::H1(hash) & mask);
+        while (true)
+        {
+            const FlatHash::Group group(ctrl + pos);
+            auto match = group.Match(h2);
+            while (match.HasNext())
+            {
+                const int32 index = (pos + match.Next()) & mask;
+                if (items[index] == item)
+                    return index;
+            }
+            if (group.MatchEmpty().HasNext())
+                return -1;
+            pos = (pos + FlatHash::Group::Width) & mask;
+        }
+    }
+
+    int32 FindEmptySlot(uint32 hash) const
+    {
+        const int32 mask = _size - 1;
+        const byte* ctrl = _ctrl.Get();
+        int32 pos = (int32)(FlatHash::H1(hash) & mask);
+        while (true)
+        {
+            const auto empty = FlatHash::Group(ctrl + pos).MatchEmpty();
+            if (empty.HasNext())
+                return (pos + empty.Lowest()) & mask;
+            pos = (pos + FlatHash::Group::Width) & mask;
+        }
+    }
+
+    int32 OnAdd(uint32 hash)
+    {
+        // Ensure to have enough space for the next item
+        if (_elementsCount + 1 > FlatHash::GetMaxLoad(_size))
+            SetCapacity(_size ? _size * 2 : FLAT_HASH_DEFAULT_CAPACITY);
+
+        // Insert at the first empty slot in the probing sequence (keeps the probing chain without gaps)
+        const int32 index = FindEmptySlot(hash);
+        FlatHash::SetCtrl(_ctrl.Get(), _size, index, FlatHash::H2(hash));
+        _elementsCount++;
+        return index;
+    }
+
+    void RemoveSlot(int32 index)
+    {
+        byte* ctrl = _ctrl.Get();
+        T* items = _items.Get();
+        Memory::DestructItem(items + index);
+
+        // Shift back the following items of the probing chain into the gap (tombstone-free deletion)
+        const int32 mask = _size - 1;
+        int32 gap = index;
+        int32 slot = index;
+        while (true)
+        {
+            slot = (slot + 1) & mask;
+            if (ctrl[slot] & FlatHash::Empty)
+                break;
+            const int32 home = (int32)(FlatHash::H1(FlatHash::Mix(GetHash(items[slot]))) & mask);
+            if (FlatHash::CanShiftBack(gap, slot, home))
+            {
+                Memory::MoveItems(items + gap, items + slot, 1);
+                Memory::DestructItem(items + slot);
+                FlatHash::SetCtrl(ctrl, _size, gap, ctrl[slot]);
+                gap = slot;
+            }
+        }
+        FlatHash::SetCtrl(ctrl, _size, gap, FlatHash::Empty);
+        _elementsCount--;
+    }
+};
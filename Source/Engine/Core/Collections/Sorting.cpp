@@ -1,7 +1,9 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
 #include "Sorting.h"
+#include "Engine/Core/Math/Math.h"
 #include "Engine/Core/Memory/Memory.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Threading/ThreadLocal.h"
 
 // Use a cached storage for the sorting (one per thread to reduce locking)
@@ -53,3 +55,147 @@ void Sorting::SortingStack::EnsureCapacity(int32 minCapacity)
         num = minCapacity;
     SetCapacity(num);
 }
+
+// The radix sort digit size (in bits)
+#define RADIXSORT_BITS 11
+#define RADIXSORT_HISTOGRAM_SIZE (1 << RADIXSORT_BITS)
+#define RADIXSORT_BIT_MASK (RADIXSORT_HISTOGRAM_SIZE - 1)
+
+// The minimum amount of elements to use the histograms of all digits (smaller arrays use the generic implementation)
+#define RADIXSORT_MIN_COUNT 256
+
+// The minimum amount of elements per job to sort the array in parallel
+#define RADIXSORT_MIN_JOB_COUNT 8192
+
+// The maximum amount of jobs used by the parallel sort
+#define RADIXSORT_MAX_JOBS 16
+
+namespace
+{
+    template<typename T>
+    void RadixSortImpl(T*& inputKeys, int32*& inputValues, T* tmpKeys, int32* tmpValues, int32 count)
+    {
+        constexpr int32 passesCount = (sizeof(T) * 8 + RADIXSORT_BITS - 1) / RADIXSORT_BITS;
+        const int32 jobsCount = Math::Clamp(Math::Min(count / RADIXSORT_MIN_JOB_COUNT, JobSystem::GetThreadsCount()), 1, RADIXSORT_MAX_JOBS);
+        const int32 jobSize = (count + jobsCount - 1) / jobsCount;
+        T* keys = inputKeys;
+        int32* values = inputValues;
+
+        // Count digits of all passes at once (per job chunk, also checks if input is already sorted)
+        const int32 jobHistogramSize = passesCount * RADIXSORT_HISTOGRAM_SIZE;
+        uint32* histograms = (uint32*)Allocator::Allocate(sizeof(uint32) * jobHistogramSize * (jobsCount + 1));
+        uint32* totals = histograms + jobHistogramSize * jobsCount;
+        bool sortedJobs[RADIXSORT_MAX_JOBS];
+        JobSystem::Execute([&](int32 jobIndex)
+        {
+            uint32* histogram = histograms + jobHistogramSize * jobIndex;
+            Platform::MemoryClear(histogram, sizeof(uint32) * jobHistogramSize);
+            const int32 start = jobIndex * jobSize;
+            const int32 end = Math::Min(start + jobSize, count);
+            bool sorted = true;
+            T prevKey = keys[start];
+            for (int32 i = start; i < end; i++)
+            {
+                const T key = keys[i];
+                for (int32 pass = 0; pass < passesCount; pass++)
+                    ++histogram[pass * RADIXSORT_HISTOGRAM_SIZE + ((key >> (pass * RADIXSORT_BITS)) & RADIXSORT_BIT_MASK)];
+                sorted &= prevKey <= key;
+                prevKey = key;
+            }
+            sortedJobs[jobIndex] = sorted;
+        }, jobsCount);
+        bool sorted = true;
+        for (int32 jobIndex = 0; jobIndex < jobsCount; jobIndex++)
+            sorted &= sortedJobs[jobIndex] && (jobIndex == 0 || keys[jobIndex * jobSize - 1] <= keys[jobIndex * jobSize]);
+        if (sorted)
+        {
+            Allocator::Free(histograms);
+            return;
+        }
+        Platform::MemoryCopy(totals, histograms, sizeof(uint32) * jobHistogramSize);
+        for (int32 jobIndex = 1; jobIndex < jobsCount; jobIndex++)
+        {
+            const uint32* histogram = histograms + jobHistogramSize * jobIndex;
+            for (int32 i = 0; i < jobHistogramSize; i++)
+                totals[i] += histogram[i];
+        }
+
+        bool reordered = false;
+        for (int32 pass = 0; pass < passesCount; pass++)
+        {
+            // Skip pass if all keys have the same digit
+            const int32 shift = pass * RADIXSORT_BITS;
+            if (totals[pass * RADIXSORT_HISTOGRAM_SIZE + ((keys[0] >> shift) & RADIXSORT_BIT_MASK)] == (uint32)count)
+                continue;
+
+            // Recount digits of the pass per job chunk (keys order changed after the previous pass)
+            if (reordered && jobsCount > 1)
+            {
+                JobSystem::Execute([&](int32 jobIndex)
+                {
+                    uint32* histogram = histograms + jobHistogramSize * jobIndex + pass * RADIXSORT_HISTOGRAM_SIZE;
+                    Platform::MemoryClear(histogram, sizeof(uint32) * RADIXSORT_HISTOGRAM_SIZE);
+                    const int32 start = jobIndex * jobSize;
+                    const int32 end = Math::Min(start + jobSize, count);
+                    for (int32 i = start; i < end; i++)
+                        ++histogram[(keys[i] >> shift) & RADIXSORT_BIT_MASK];
+                }, jobsCount);
+            }
+
+            // Convert counts into the output offsets (stable order of the job chunks for each digit)
+            uint32 offset = 0;
+            for (int32 digit = 0; digit < RADIXSORT_HISTOGRAM_SIZE; digit++)
+            {
+                for (int32 jobIndex = 0; jobIndex < jobsCount; jobIndex++)
+                {
+                    uint32& histogram = histograms[jobHistogramSize * jobIndex + pass * RADIXSORT_HISTOGRAM_SIZE + digit];
+                    const uint32 cnt = histogram;
+                    histogram = offset;
+                    offset += cnt;
+                }
+            }
+
+            // Scatter elements
+            T* passKeys = keys;
+            int32* passValues = values;
+            T* dstKeys = keys == inputKeys ? tmpKeys : inputKeys;
+            int32* dstValues = values == inputValues ? tmpValues : inputValues;
+            JobSystem::Execute([&](int32 jobIndex)
+            {
+                uint32* histogram = histograms + jobHistogramSize * jobIndex + pass * RADIXSORT_HISTOGRAM_SIZE;
+                const int32 start = jobIndex * jobSize;
+                const int32 end = Math::Min(start + jobSize, count);
+                for (int32 i = start; i < end; i++)
+                {
+                    const T key = passKeys[i];
+                    const uint32 dest = histogram[(key >> shift) & RADIXSORT_BIT_MASK]++;
+                    dstKeys[dest] = key;
+                    dstValues[dest] = passValues[i];
+                }
+            }, jobsCount);
+            keys = dstKeys;
+            values = dstValues;
+            reordered = true;
+        }
+
+        Allocator::Free(histograms);
+        inputKeys = keys;
+        inputValues = values;
+    }
+}
+
+void Sorting::RadixSort(uint64*& inputKeys, int32*& inputValues, uint64* tmpKeys, int32* tmpValues, int32 count)
+{
+    if (count < RADIXSORT_MIN_COUNT)
+        RadixSort<uint64, int32>(inputKeys, inputValues, tmpKeys, tmpValues, count);
+    else
+        RadixSortImpl(inputKeys, inputValues, tmpKeys, tmpValues, count);
+}
+
+void Sorting::RadixSort(uint32*& inputKeys, int32*& inputValues, uint32* tmpKeys, int32* tmpValues, int32 count)
+{
+    if (count < RADIXSORT_MIN_COUNT)
+        RadixSort<uint32, int32>(inputKeys, inputValues, tmpKeys, tmpValues, count);
+    else
+        RadixSortImpl(inputKeys, inputValues, tmpKeys, tmpValues, count);
+}
@@ -419,4 +419,24 @@ class FLAXENGINE_API Sorting
             inputValues = tmpValues;
         }
     }
+
+    /// <summary>
+    /// Sorts the linear data array using LSD Radix Sort algorithm specialized for 64-bit keys with indices (uses temporary keys collection). Histograms of all digits are gathered at once and passes over digits shared by all keys are skipped. Large arrays are sorted in parallel using Job System.
+    /// </summary>
+    /// <param name="inputKeys">The data pointer to the input sorting keys array. When this method completes it contains a pointer to the original data or the temporary depending on the algorithm passes count. Use it as a results container.</param>
+    /// <param name="inputValues">The data pointer to the input values array. When this method completes it contains a pointer to the original data or the temporary depending on the algorithm passes count. Use it as a results container.</param>
+    /// <param name="tmpKeys">The data pointer to the temporary sorting keys array.</param>
+    /// <param name="tmpValues">The data pointer to the temporary values array.</param>
+    /// <param name="count">The elements count.</param>
+    static void RadixSort(uint64*& inputKeys, int32*& inputValues, uint64* tmpKeys, int32* tmpValues, int32 count);
+
+    /// <summary>
+    /// Sorts the linear data array using LSD Radix Sort algorithm specialized for 32-bit keys with indices (uses temporary keys collection). Histograms of all digits are gathered at once and passes over digits shared by all keys are skipped. Large arrays are sorted in parallel using Job System.
+    /// </summary>
+    /// <param name="inputKeys">The data pointer to the input sorting keys array. When this method completes it contains a pointer to the original data or the temporary depending on the algorithm passes count. Use it as a results container.</param>
+    /// <param name="inputValues">The data pointer to the input values array. When this method completes it contains a pointer to the original data or the temporary depending on the algorithm passes count. Use it as a results container.</param>
+    /// <param name="tmpKeys">The data pointer to the temporary sorting keys array.</param>
+    /// <param name="tmpValues">The data pointer to the temporary values array.</param>
+    /// <param name="count">The elements count.</param>
+    static void RadixSort(uint32*& inputKeys, int32*& inputValues, uint32* tmpKeys, int32* tmpValues, int32 count);
 };
@@ -7,6 +7,7 @@
 #include "Engine/Content/Asset.h"
 #include "Engine/Content/AssetReference.h"
 #include "Engine/Content/SceneReference.h"
+#include "Engine/Graphics/Textures/Types.h"
 
 /// <summary>
 /// The game building rendering settings.
@@ -83,6 +84,48 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings") class FLAXENGINE_API
     API_FIELD(Attributes="EditorOrder(2010), EditorDisplay(\"Content\")")
     bool ShadersGenerateDebugData = false;
 
+    /// <summary>
+    /// The path (relative to the project folder) of the shaders usage file recorded by running the game with -recordshaders command line switch. If set, the shader permutations not listed in the file are stripped from the cooked game (only for the shaders present in the file). Leave empty to include all permutations.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(2020), EditorDisplay(\"Content\")")
+    String ShadersUsageFile;
+
+    /// <summary>
+    /// Enables building meshlets (small clusters of triangles with culling bounds) for the dense model meshes when cooking the game. Meshlets are culled against the view frustum and by the normal cone (backfaces) at runtime to skip the vertex work of invisible triangles.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(2030), EditorDisplay(\"Content\")")
+    bool GenerateMeshlets = false;
+
+    /// <summary>
+    /// Enables compressing the animations when cooking the game. Compressed animations use quantized per-frame samples instead of the keyframe curves which reduces the memory usage and speeds up the animations sampling.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(2040), EditorDisplay(\"Content\")")
+    bool CompressAnimations = false;
+
+    /// <summary>
+    /// Enables compressing the models meshes when cooking the game. Vertex and index buffers are encoded with a lossless mesh codec (and LZ4) which reduces the size of the geometry on disk at the cost of the decoding when streaming the model.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(2045), EditorDisplay(\"Content\")")
+    bool CompressMeshes = false;
+
+    /// <summary>
+    /// The quality of the textures compression when cooking the game. Lower quality speeds up the cooking of texture-heavy content.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(2050), EditorDisplay(\"Content\")")
+    TextureCompressionQuality TextureCompression = TextureCompressionQuality::Normal;
+
+    /// <summary>
+    /// Enables compressing textures on the GPU (if supported by the graphics device, currently BC6H and BC7 formats with DirectX 11) when cooking the game. Uses the CPU encoder as a fallback.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(2060), EditorDisplay(\"Content\", \"GPU Texture Compression\")")
+    bool GPUTextureCompression = true;
+
+    /// <summary>
+    /// The path (absolute or relative to the project folder) of the shared cooked assets cache folder (eg. on a network drive used by the build machines and the team). Cooked assets are stored there under the hash of their source files contents and the cooking settings so other machines can reuse them instead of cooking again. Leave empty to disable.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(2070), EditorDisplay(\"Content\")")
+    String SharedCookCacheFolder;
+
     /// <summary>
     /// If checked, skips bundling default engine fonts for UI. Use if to reduce build size if you don't use default engine fonts but custom ones only.
     /// </summary>
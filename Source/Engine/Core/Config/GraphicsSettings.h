@@ -47,6 +47,12 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class
     API_FIELD(Attributes="EditorOrder(1250), DefaultValue(Quality.High), EditorDisplay(\"Quality\")")
     Quality VolumetricFogQuality = Quality::High;
 
+    /// <summary>
+    /// Enables checkerboard updates of the volumetric fog. Lighting is calculated only for a half of the fog volume cells each frame (alternating) while the other cells reuse the reprojected temporal history. Halves the fog lighting cost at cost of a slower response to the lighting changes.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1255), DefaultValue(false), EditorDisplay(\"Quality\")")
+    bool VolumetricFogCheckerboard = false;
+
     /// <summary>
     /// The shadows quality.
     /// </summary>
@@ -65,6 +71,54 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class
     API_FIELD(Attributes="EditorOrder(1320), DefaultValue(false), EditorDisplay(\"Quality\", \"Allow CSM Blending\")")
     bool AllowCSMBlending = false;
 
+    /// <summary>
+    /// Enables culling of the instanced draw calls (eg. foliage) per-instance on a GPU with indirect draws. Reduces the rendered geometry of large draw batches that are only partially visible.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1330), DefaultValue(false), EditorDisplay(\"Quality\", \"GPU Instances Culling\")")
+    bool GPUInstancesCulling = false;
+
+    /// <summary>
+    /// Enables GPU-driven foliage rendering. Foliage instances are kept in the persistent GPU buffers and culled (frustum, cull distance and Hierarchical-Z occlusion if occlusion culling is enabled) with LOD selection done on a GPU per view, and drawn with indirect draws. Removes the per-frame CPU cost of the foliage clusters traversal and instances upload for large foliage.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1335), DefaultValue(false), EditorDisplay(\"Quality\", \"GPU Foliage Culling\")")
+    bool GPUFoliageCulling = false;
+
+    /// <summary>
+    /// Enables occlusion culling of the scene objects (actors and foliage) against the Hierarchical-Z buffer built from the scene depth. Results are used with a few frames latency.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1340), DefaultValue(false), EditorDisplay(\"Quality\", \"Occlusion Culling\")")
+    bool OcclusionCulling = false;
+
+    /// <summary>
+    /// Enables caching of the static shadow casters depth for the static lights. Static geometry is rendered into the shadow map only when it changes within the light projection and dynamic objects are drawn on top of it every frame. Directional light cascades are snapped to coarse cells to be reused over multiple frames (at cost of a slightly lower resolution).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1350), DefaultValue(false), EditorDisplay(\"Quality\", \"Static Shadows Caching\")")
+    bool StaticShadowsCaching = false;
+
+    /// <summary>
+    /// The memory budget (in megabytes) for the temporary render targets pool. Unused pooled targets are released (oldest first) when the pool goes over the budget instead of staying resident for a few seconds. Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1360), DefaultValue(0), Limit(0, 16384), EditorDisplay(\"Quality\", \"Render Target Pool Budget\")")
+    int32 RenderTargetPoolBudget = 0;
+
+    /// <summary>
+    /// Enables Variable Rate Shading (if supported by the GPU, see GPULimits::HasVariableRateShading). Screen tiles with low luminance contrast or fast motion in the previous frame are shaded at lower rate in GBuffer, forward and fog passes which reduces the pixel shading cost at high resolutions.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1370), DefaultValue(false), EditorDisplay(\"Quality\", \"Variable Rate Shading\")")
+    bool VariableRateShading = false;
+
+    /// <summary>
+    /// Enables the global meshes geometry pool. Vertex and index buffers of the model meshes are sub-allocated within a few large shared buffers so the draw calls use offsets instead of separate buffers (reduces buffer binding changes and small GPU allocations). Affects only meshes loaded after the change.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1380), DefaultValue(false), EditorDisplay(\"Quality\", \"Mesh Geometry Pool\")")
+    bool MeshGeometryPool = false;
+
+    /// <summary>
+    /// Enables the skinning of the skinned meshes with a compute shader. Mesh vertices are skinned once per frame into the shared vertex buffers and drawn as a static geometry by all the rendering passes (GBuffer, shadow projections, etc.) instead of doing the skinning in the vertex shader of every pass. Motion vectors pass still uses the vertex shader skinning.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1390), DefaultValue(false), EditorDisplay(\"Quality\", \"GPU Skinning\")")
+    bool GPUSkinning = false;
+
     /// <summary>
     /// Default probes cubemap resolution (use for Environment Probes, can be overriden per-actor).
     /// </summary>
@@ -109,6 +163,12 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class
     API_FIELD(Attributes="EditorOrder(2120), Limit(50, 1000), EditorDisplay(\"Global Illumination\")")
     float GIProbesSpacing = 100;
 
+    /// <summary>
+    /// The maximum amount of Global Illumination probe rays to trace per frame (DDGI). Probes far from the camera are updated less frequently when the active probes need more rays than the budget, while newly activated or relocated probes and the probes near the camera are always updated. Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(2125), DefaultValue(0), Limit(0), EditorDisplay(\"Global Illumination\", \"GI Rays Budget\")")
+    int32 GIRaysBudget = 0;
+
     /// <summary>
     /// The Global Surface Atlas resolution. Adjust it if atlas `flickers` due to overflow (eg. to 4096).
     /// </summary>
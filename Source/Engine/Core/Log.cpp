@@ -8,6 +8,9 @@
 #include "Engine/Engine/Globals.h"
 #include "Engine/Platform/FileSystem.h"
 #include "Engine/Platform/CriticalSection.h"
+#include "Engine/Platform/ConditionVariable.h"
+#include "Engine/Platform/Thread.h"
+#include "Engine/Threading/ThreadSpawner.h"
 #include "Engine/Serialization/FileWriteStream.h"
 #include "Engine/Debug/Exceptions/Exceptions.h"
 #if USE_EDITOR
@@ -16,6 +19,16 @@
 #include <iostream>
 
 #define LOG_ENABLE_FILE (!PLATFORM_SWITCH)
+// Enables writing the log file (and standard output) on a background thread, callers only copy the message into the pending buffer
+#define LOG_ENABLE_WRITER_THREAD (PLATFORM_THREADS_LIMIT > 1)
+// Interval (in milliseconds) at which the background writer outputs the pending messages
+#define LOG_WRITER_INTERVAL 100
+// Size (in characters) of the pending messages after which the background writer is woken up before the interval ends
+#define LOG_WRITER_WAKE_SIZE (16 * 1024)
+#if LOG_RATE_LIMIT
+// Amount of the LOG call sites tracked by the rate limiting
+#define LOG_RATE_LIMIT_SLOTS 256
+#endif
 
 namespace
 {
@@ -24,6 +37,78 @@ namespace
     FileWriteStream* LogFile = nullptr;
     CriticalSection LogLocker;
     DateTime LogStartTime;
+#if LOG_ENABLE_WRITER_THREAD
+    // Messages are appended to the pending buffer (under LogLocker) and swapped into the writing buffer by the writer (under LogFileLocker)
+    Array<Char> LogPending, LogWriting;
+    CriticalSection LogFileLocker;
+    ConditionVariable LogSignal;
+    Thread* LogWriterThread = nullptr;
+    int64 LogWriterExit = 0;
+#endif
+#if LOG_RATE_LIMIT
+    struct LogRateSlot
+    {
+        const Char* Format;
+        double WindowStart;
+        int32 Count;
+        int32 Suppressed;
+    };
+
+    LogRateSlot LogRateSlots[LOG_RATE_LIMIT_SLOTS];
+    CriticalSection LogRateLocker;
+#endif
+
+    void WriteStd(const Char* ptr, int32 length)
+    {
+#if PLATFORM_TEXT_IS_CHAR16
+        StringAnsi ansi(ptr, length);
+        printf("%s", ansi.Get());
+#else
+        std::wcout.write(ptr, length);
+#endif
+    }
+
+#if LOG_ENABLE_WRITER_THREAD
+    void WritePending()
+    {
+        ScopeLock fileLock(LogFileLocker);
+        LogLocker.Lock();
+        LogPending.Swap(LogWriting);
+        LogLocker.Unlock();
+        if (LogWriting.IsEmpty())
+            return;
+
+        // Send messages to standard process output
+        if (CommandLine::Options.Std)
+        {
+            WriteStd(LogWriting.Get(), LogWriting.Count());
+        }
+
+        // Write messages to log file
+        if (LogFile)
+        {
+            LogFile->WriteBytes(LogWriting.Get(), LogWriting.Count() * sizeof(Char));
+#if LOG_ENABLE_AUTO_FLUSH
+            LogFile->Flush();
+#endif
+        }
+
+        LogWriting.Clear();
+    }
+
+    int32 LogWriterRun()
+    {
+        while (Platform::AtomicRead(&LogWriterExit) == 0)
+        {
+            LogLocker.Lock();
+            if (LogPending.IsEmpty())
+                LogSignal.Wait(LogLocker, LOG_WRITER_INTERVAL);
+            LogLocker.Unlock();
+            WritePending();
+        }
+        return 0;
+    }
+#endif
 }
 
 String Log::Logger::LogFilePath;
@@ -91,6 +176,13 @@ bool Log::Logger::Init()
     byte bom[] = { 0xFF, 0xFE };
     LogFile->WriteBytes(bom, 2);
 
+#if LOG_ENABLE_WRITER_THREAD
+    // Start background writer
+    Platform::AtomicStore(&LogWriterExit, 0);
+    Function<int32()> run(LogWriterRun);
+    LogWriterThread = ThreadSpawner::Start(run, TEXT("Log Writer"), ThreadPriority::BelowNormal);
+#endif
+
     // Write startup info
     WriteFloor();
     Write(String::Format(TEXT("           Start of the log, {0}"), LogStartTime.ToString()));
@@ -118,22 +210,30 @@ void Log::Logger::Write(const StringView& msg)
     }
     IsDuringLog = true;
 
+    // Send message to platform logging
+    Platform::Log(msg);
+
+#if LOG_ENABLE_WRITER_THREAD
+    if (LogWriterThread)
+    {
+        // Queue message for the background writer
+        LogPending.Add(ptr, length);
+        LogPending.Add(TEXT(PLATFORM_LINE_TERMINATOR), ARRAY_COUNT(PLATFORM_LINE_TERMINATOR) - 1);
+        if (LogPending.Count() >= LOG_WRITER_WAKE_SIZE)
+            LogSignal.NotifyOne();
+        IsDuringLog = false;
+        LogLocker.Unlock();
+        return;
+    }
+#endif
+
     // Send message to standard process output
     if (CommandLine::Options.Std)
     {
-#if PLATFORM_TEXT_IS_CHAR16
-        StringAnsi ansi(msg);
-        ansi += PLATFORM_LINE_TERMINATOR;
-        printf("%s", ansi.Get());
-#else
-        std::wcout.write(ptr, length);
-        std::wcout.write(TEXT(PLATFORM_LINE_TERMINATOR), ARRAY_COUNT(PLATFORM_LINE_TERMINATOR) - 1);
-#endif
+        WriteStd(ptr, length);
+        WriteStd(TEXT(PLATFORM_LINE_TERMINATOR), ARRAY_COUNT(PLATFORM_LINE_TERMINATOR) - 1);
     }
 
-    // Send message to platform logging
-    Platform::Log(msg);
-
     // Write message to log file
     if (LogAfterInit)
     {
@@ -155,6 +255,21 @@ void Log::Logger::Write(const Exception& exception)
 
 void Log::Logger::Dispose()
 {
+#if LOG_ENABLE_WRITER_THREAD
+    // Stop background writer
+    if (LogWriterThread)
+    {
+        Platform::AtomicStore(&LogWriterExit, 1);
+        LogSignal.NotifyAll();
+        LogWriterThread->Join();
+        Delete(LogWriterThread);
+        LogLocker.Lock();
+        LogWriterThread = nullptr;
+        LogLocker.Unlock();
+        WritePending();
+    }
+#endif
+
     LogLocker.Lock();
 
     // Write ending info
@@ -185,6 +300,10 @@ bool Log::Logger::IsLogEnabled()
 
 void Log::Logger::Flush()
 {
+#if LOG_ENABLE_WRITER_THREAD
+    // Don't wait for the background writer (eg. it might be not responding during the crash)
+    WritePending();
+#endif
     LogLocker.Lock();
     if (LogFile)
         LogFile->Flush();
@@ -196,6 +315,60 @@ void Log::Logger::WriteFloor()
     Write(TEXT("================================================================"));
 }
 
+#if LOG_RATE_LIMIT
+
+bool Log::Logger::IsRateLimited(const Char* format)
+{
+    const double time = Platform::GetTimeSeconds();
+    int32 suppressed = 0;
+    {
+        ScopeLock lock(LogRateLocker);
+
+        // Find the call site slot (replace the oldest one if all probed slots are in use)
+        const uint32 hash = (uint32)(((uint64)(uintptr)format * 0x9E3779B97F4A7C15ull) >> 32);
+        LogRateSlot* slot = nullptr;
+        for (int32 i = 0; i < 8; i++)
+        {
+            LogRateSlot& e = LogRateSlots[(hash + i) & (LOG_RATE_LIMIT_SLOTS - 1)];
+            if (e.Format == format || e.Format == nullptr)
+            {
+                slot = &e;
+                break;
+            }
+            if (!slot || e.WindowStart < slot->WindowStart)
+                slot = &e;
+        }
+        if (slot->Format != format)
+        {
+            slot->Format = format;
+            slot->WindowStart = time;
+            slot->Count = 0;
+            slot->Suppressed = 0;
+        }
+
+        // Check the amount of messages within the current window
+        if (time - slot->WindowStart >= 1.0)
+        {
+            suppressed = slot->Suppressed;
+            slot->WindowStart = time;
+            slot->Count = 0;
+            slot->Suppressed = 0;
+        }
+        if (slot->Count >= LOG_RATE_LIMIT)
+        {
+            slot->Suppressed++;
+            return true;
+        }
+        slot->Count++;
+    }
+
+    if (suppressed != 0)
+        Write(LogType::Warning, String::Format(TEXT("Suppressed {0} repeated log messages: {1}"), suppressed, StringView(format)));
+    return false;
+}
+
+#endif
+
 void Log::Logger::ProcessLogMessage(LogType type, const StringView& msg, fmt_flax::memory_buffer& w)
 {
     const TimeSpan time = DateTime::Now() - LogStartTime;
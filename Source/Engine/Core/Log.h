@@ -10,10 +10,15 @@
 // Enable/disable auto flush function
 #define LOG_ENABLE_AUTO_FLUSH 1
 
+// Maximum amount of info/warning messages that can be logged from a single LOG call site within a second (excess is skipped and reported as suppressed, errors are never skipped). Use 0 to disable rate limiting.
+#ifndef LOG_RATE_LIMIT
+#define LOG_RATE_LIMIT 100
+#endif
+
 /// <summary>
 /// Sends a formatted message to the log file (message type - describes level of the log (see LogType enum))
 /// </summary>
-#define LOG(messageType, format, ...) Log::Logger::Write(LogType::messageType, ::String::Format(TEXT(format), ##__VA_ARGS__))
+#define LOG(messageType, format, ...) Log::Logger::WriteFormat(LogType::messageType, TEXT(format), ##__VA_ARGS__)
 
 /// <summary>
 /// Sends a string message to the log file (message type - describes level of the log (see LogType enum))
@@ -111,7 +116,7 @@ namespace Log
         static bool IsLogEnabled();
 
         /// <summary>
-        /// Flushes log file with a memory buffer.
+        /// Flushes log file with a memory buffer. Writes all the messages queued for the background writer on the calling thread (eg. before crash).
         /// </summary>
         static void Flush();
 
@@ -140,7 +145,26 @@ namespace Log
         template<typename... Args>
         FORCE_INLINE static void Write(LogType type, const Char* format, const Args& ... args)
         {
-            Write(type, String::Format(format, args...));
+            WriteFormat(type, format, args...);
+        }
+
+        /// <summary>
+        /// Writes a formatted message to the log file. Formats into the stack buffer (no string allocation) and skips formatting of the messages suppressed by the rate limiting (see LOG_RATE_LIMIT).
+        /// </summary>
+        /// <param name="type">The message type.</param>
+        /// <param name="format">The message format string (static text, used to identify the message source for rate limiting).</param>
+        /// <param name="args">The format arguments.</param>
+        template<typename... Args>
+        static void WriteFormat(LogType type, const Char* format, const Args& ... args)
+        {
+#if LOG_RATE_LIMIT
+            if (!IsError(type) && IsRateLimited(format))
+                return;
+#endif
+            fmt_flax::allocator allocator;
+            fmt_flax::memory_buffer buffer(allocator);
+            fmt_flax::format(buffer, format, args...);
+            Write(type, StringView(buffer.data(), (int32)buffer.size()));
         }
 
         /// <summary>
@@ -182,6 +206,9 @@ namespace Log
 
     private:
 
+#if LOG_RATE_LIMIT
+        static bool IsRateLimited(const Char* format);
+#endif
         static void ProcessLogMessage(LogType type, const StringView& msg, fmt_flax::memory_buffer& w);
     };
 }
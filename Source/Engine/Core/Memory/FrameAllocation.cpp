@@ -0,0 +1,127 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "FrameAllocation.h"
+#include "Engine/Platform/CriticalSection.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+
+// Size of the memory block used by a single thread to allocate from (allocations larger than this use dedicated blocks)
+#define FRAME_ALLOCATOR_BLOCK_SIZE (64 * 1024)
+#define FRAME_ALLOCATOR_HEADER_SIZE 64
+
+struct FrameAllocatorBlock
+{
+    FrameAllocatorBlock* Next;
+};
+
+struct FrameAllocatorThread
+{
+    byte* Pos;
+    byte* End;
+    int64 Frame;
+};
+
+namespace
+{
+    // Frames counting starts from 1 so zero-initialized thread data is always outdated
+    volatile int64 FrameIndex = 1;
+    CriticalSection Locker;
+    FrameAllocatorBlock* FreeBlocks = nullptr;
+    FrameAllocatorBlock* UsedBlocks[FrameAllocator::FramesCount] = {};
+    FrameAllocatorBlock* UsedBlocksTail[FrameAllocator::FramesCount] = {};
+    FrameAllocatorBlock* LargeBlocks[FrameAllocator::FramesCount] = {};
+    THREADLOCAL FrameAllocatorThread ThreadData;
+
+    FORCE_INLINE byte* AlignPtr(byte* ptr, uint64 alignment)
+    {
+        return (byte*)(((uintptr)ptr + (alignment - 1)) & ~(uintptr)(alignment - 1));
+    }
+}
+
+void* FrameAllocator::Allocate(uint64 size, uint64 alignment)
+{
+    // Fast path with bump allocation from the thread block
+    FrameAllocatorThread& thread = ThreadData;
+    const int64 frame = Platform::AtomicRead(&FrameIndex);
+    if (thread.Frame == frame)
+    {
+        byte* ptr = AlignPtr(thread.Pos, alignment);
+        if (ptr + size <= thread.End)
+        {
+            thread.Pos = ptr + size;
+            return ptr;
+        }
+    }
+    const int32 slot = (int32)(frame % FramesCount);
+
+    // Use dedicated block for large allocations
+    if (size + alignment > FRAME_ALLOCATOR_BLOCK_SIZE - FRAME_ALLOCATOR_HEADER_SIZE)
+    {
+        auto block = (FrameAllocatorBlock*)Allocator::Allocate(FRAME_ALLOCATOR_HEADER_SIZE + size + alignment);
+        if (!block)
+            OUT_OF_MEMORY;
+        Locker.Lock();
+        block->Next = LargeBlocks[slot];
+        LargeBlocks[slot] = block;
+        Locker.Unlock();
+        return AlignPtr((byte*)block + FRAME_ALLOCATOR_HEADER_SIZE, alignment);
+    }
+
+    // Get a new block for this thread
+    Locker.Lock();
+    FrameAllocatorBlock* block = FreeBlocks;
+    if (block)
+        FreeBlocks = block->Next;
+    else
+        block = (FrameAllocatorBlock*)Allocator::Allocate(FRAME_ALLOCATOR_BLOCK_SIZE, FRAME_ALLOCATOR_HEADER_SIZE);
+    if (!block)
+        OUT_OF_MEMORY;
+    block->Next = UsedBlocks[slot];
+    UsedBlocks[slot] = block;
+    if (!UsedBlocksTail[slot])
+        UsedBlocksTail[slot] = block;
+    Locker.Unlock();
+    byte* ptr = AlignPtr((byte*)block + FRAME_ALLOCATOR_HEADER_SIZE, alignment);
+    thread.Frame = frame;
+    thread.Pos = ptr + size;
+    thread.End = (byte*)block + FRAME_ALLOCATOR_BLOCK_SIZE;
+    return ptr;
+}
+
+void FrameAllocator::NewFrame()
+{
+    PROFILE_CPU();
+    Locker.Lock();
+    const int64 frame = FrameIndex + 1;
+    const int32 slot = (int32)(frame % FramesCount);
+
+    // Recycle blocks used by the oldest frame (whole list is moved at once)
+    if (UsedBlocks[slot])
+    {
+        UsedBlocksTail[slot]->Next = FreeBlocks;
+        FreeBlocks = UsedBlocks[slot];
+        UsedBlocks[slot] = UsedBlocksTail[slot] = nullptr;
+    }
+    for (FrameAllocatorBlock* block = LargeBlocks[slot]; block;)
+    {
+        FrameAllocatorBlock* next = block->Next;
+        Allocator::Free(block);
+        block = next;
+    }
+    LargeBlocks[slot] = nullptr;
+
+    Platform::AtomicStore(&FrameIndex, frame);
+    Locker.Unlock();
+}
+
+void FrameAllocator::Trim()
+{
+    Locker.Lock();
+    for (FrameAllocatorBlock* block = FreeBlocks; block;)
+    {
+        FrameAllocatorBlock* next = block->Next;
+        Allocator::Free(block);
+        block = next;
+    }
+    FreeBlocks = nullptr;
+    Locker.Unlock();
+}
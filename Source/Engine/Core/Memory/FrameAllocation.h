@@ -0,0 +1,110 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Memory.h"
+#include "Engine/Core/Core.h"
+
+/// <summary>
+/// Frame-scoped linear memory allocator. Uses per-thread memory blocks so allocations are lock-free (except when thread needs a new block). Memory is never freed individually but released all at once when a new frame starts.
+/// </summary>
+/// <remarks>Allocated memory stays valid during the current frame and the next FramesCount-1 frames (frames are multi-buffered so async work started in one frame can end within the next one).</remarks>
+class FLAXENGINE_API FrameAllocator
+{
+public:
+    /// <summary>
+    /// The amount of frames that memory allocated within a frame is valid.
+    /// </summary>
+    static constexpr int32 FramesCount = 3;
+
+    /// <summary>
+    /// Allocates the memory block valid for the current frame (and the next FramesCount-1 frames).
+    /// </summary>
+    /// <param name="size">The size of the memory block (in bytes).</param>
+    /// <param name="alignment">The memory alignment (in bytes). Must be power of two.</param>
+    /// <returns>The allocated memory.</returns>
+    static void* Allocate(uint64 size, uint64 alignment = 16);
+
+    /// <summary>
+    /// Starts a new frame and recycles the memory of the oldest frame. Called by the engine once per main loop tick.
+    /// </summary>
+    static void NewFrame();
+
+    /// <summary>
+    /// Releases the unused memory blocks back to the system.
+    /// </summary>
+    static void Trim();
+};
+
+/// <summary>
+/// The memory allocation policy that uses frame-scoped linear allocator (FrameAllocator). Free is no-op and all memory is reclaimed when frame ends. Use it only for temporary containers that don't outlive a frame (eg. local arrays in per-frame update or rendering code).
+/// </summary>
+class FrameAllocation
+{
+public:
+    enum { HasSwap = true };
+
+    template<typename T>
+    class Data
+    {
+    private:
+        T* _data = nullptr;
+
+    public:
+        FORCE_INLINE Data()
+        {
+        }
+
+        FORCE_INLINE ~Data()
+        {
+        }
+
+        FORCE_INLINE T* Get()
+        {
+            return _data;
+        }
+
+        FORCE_INLINE const T* Get() const
+        {
+            return _data;
+        }
+
+        FORCE_INLINE int32 CalculateCapacityGrow(int32 capacity, int32 minCapacity) const
+        {
+            capacity = capacity ? capacity * 2 : 32;
+            if (capacity < minCapacity)
+                capacity = minCapacity;
+            return capacity;
+        }
+
+        FORCE_INLINE void Allocate(int32 capacity)
+        {
+#if ENABLE_ASSERTION_LOW_LAYERS
+            ASSERT(!_data);
+#endif
+            _data = (T*)FrameAllocator::Allocate(capacity * sizeof(T), alignof(T) > 16 ? alignof(T) : 16);
+        }
+
+        FORCE_INLINE void Relocate(int32 capacity, int32 oldCount, int32 newCount)
+        {
+            T* newData = capacity != 0 ? (T*)FrameAllocator::Allocate(capacity * sizeof(T), alignof(T) > 16 ? alignof(T) : 16) : nullptr;
+            if (oldCount)
+            {
+                if (newCount > 0)
+                    Memory::MoveItems(newData, _data, newCount);
+                Memory::DestructItems(_data, oldCount);
+            }
+            _data = newData;
+        }
+
+        FORCE_INLINE void Free()
+        {
+            _data = nullptr;
+        }
+
+        FORCE_INLINE void Swap(Data& other)
+        {
+            ::Swap(_data, other._data);
+        }
+    };
+};
@@ -6,8 +6,13 @@
 #include "Engine/Platform/Platform.h"
 #include <new>
 
+#if USE_POOL_ALLOCATOR
+#include "PoolAllocator.h"
+typedef PoolAllocator Allocator;
+#else
 #include "CrtAllocator.h"
 typedef CrtAllocator Allocator;
+#endif
 
 namespace AllocatorExt
 {
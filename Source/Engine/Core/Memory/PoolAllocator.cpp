@@ -0,0 +1,320 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "PoolAllocator.h"
+#include "Engine/Core/Math/Math.h"
+#if PLATFORM_LINUX
+#include <sys/mman.h>
+#elif PLATFORM_WINDOWS
+#include "Engine/Platform/Win32/IncludeWindowsHeaders.h"
+#endif
+
+// Enables using huge pages (2MB) for the pool regions to reduce TLB misses (fallbacks to the regular pages if system doesn't allow it)
+#ifndef POOL_ALLOCATOR_LARGE_PAGES
+#define POOL_ALLOCATOR_LARGE_PAGES 1
+#endif
+
+// The size of the allocation header placed before every block
+#define POOL_HEADER_SIZE 16
+// The size of the largest allocation served from the pools
+#define POOL_MAX_SMALL_SIZE (32 * 1024)
+// The amount of size classes (16 classes with 16 bytes step up to 256 bytes and then 4 classes per power of two up to the max small size)
+#define POOL_CLASSES_COUNT 44
+// The size of the memory region allocated from the system for the pools
+#define POOL_REGION_SIZE (2 * 1024 * 1024)
+// The amount of bytes moved between thread cache and shared pool at once
+#define POOL_BATCH_SIZE (64 * 1024)
+// The header size class value used by the allocations that are not served from pools
+#define POOL_LARGE_CLASS MAX_uint32
+
+namespace
+{
+    struct BlockHeader
+    {
+        uint32 SizeClass;
+        uint32 Offset;
+        uint64 Size;
+    };
+
+    static_assert(sizeof(BlockHeader) == POOL_HEADER_SIZE, "Invalid pool allocator header size.");
+
+    struct FreeBlock
+    {
+        FreeBlock* Next;
+    };
+
+    // Simple lock without a constructor so it can be used during static initialization (before any other globals)
+    struct SpinLock
+    {
+        volatile int32 Flag;
+
+        void Lock()
+        {
+            int32 spins = 0;
+            while (Platform::InterlockedCompareExchange(&Flag, 1, 0) != 0)
+            {
+                if (++spins > 100)
+                {
+                    spins = 0;
+                    Platform::Sleep(0);
+                }
+            }
+        }
+
+        void Unlock()
+        {
+            Platform::AtomicStore(&Flag, 0);
+        }
+    };
+
+    struct SharedPool
+    {
+        SpinLock Locker;
+        FreeBlock* Head;
+        int32 Count;
+    };
+
+    struct ThreadCache
+    {
+        FreeBlock* Heads[POOL_CLASSES_COUNT];
+        int32 Counts[POOL_CLASSES_COUNT];
+    };
+
+    // Returns the cached blocks to the shared pools when thread exits (including threads not created by the engine)
+    struct ThreadCacheCleanup
+    {
+        ~ThreadCacheCleanup()
+        {
+            PoolAllocator::FlushThreadCache();
+        }
+    };
+
+    SharedPool Pools[POOL_CLASSES_COUNT];
+    SpinLock RegionLocker;
+    byte* RegionStart;
+    byte* RegionEnd;
+#if POOL_ALLOCATOR_LARGE_PAGES && PLATFORM_WINDOWS
+    bool LargePagesFailed;
+#endif
+    THREADLOCAL ThreadCache Cache;
+
+    FORCE_INLINE uint32 GetSizeClass(uint64 size)
+    {
+        if (size <= 256)
+            return (uint32)((size + 15) / 16) - 1;
+        uint32 shift = 8;
+        while ((size - 1) >> (shift + 1))
+            shift++;
+        const uint32 sub = (uint32)((size - 1) >> (shift - 2)) & 3;
+        return 16 + (shift - 8) * 4 + sub;
+    }
+
+    FORCE_INLINE uint64 GetClassSize(uint32 sizeClass)
+    {
+        if (sizeClass < 16)
+            return (sizeClass + 1) * 16;
+        const uint32 shift = (sizeClass - 16) / 4 + 8;
+        const uint32 sub = (sizeClass - 16) % 4;
+        return (uint64)(5 + sub) << (shift - 2);
+    }
+
+    FORCE_INLINE int32 GetBatchCount(uint32 sizeClass)
+    {
+        return Math::Clamp<int32>(POOL_BATCH_SIZE / (int32)(GetClassSize(sizeClass) + POOL_HEADER_SIZE), 4, 64);
+    }
+
+    byte* AllocateRegion()
+    {
+#if POOL_ALLOCATOR_LARGE_PAGES && PLATFORM_LINUX
+        void* ptr = mmap(nullptr, POOL_REGION_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr == MAP_FAILED)
+        {
+            // Fallback to transparent huge pages
+            ptr = mmap(nullptr, POOL_REGION_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED)
+                return nullptr;
+            madvise(ptr, POOL_REGION_SIZE, MADV_HUGEPAGE);
+        }
+        return (byte*)ptr;
+#elif POOL_ALLOCATOR_LARGE_PAGES && PLATFORM_WINDOWS
+        // Large pages require SeLockMemoryPrivilege to be granted for the process
+        if (!LargePagesFailed && GetLargePageMinimum() != 0 && POOL_REGION_SIZE % GetLargePageMinimum() == 0)
+        {
+            if (void* ptr = VirtualAlloc(nullptr, POOL_REGION_SIZE, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE))
+                return (byte*)ptr;
+            LargePagesFailed = true;
+        }
+        return (byte*)Platform::AllocatePages(1, POOL_REGION_SIZE);
+#else
+        return (byte*)Platform::AllocatePages(1, POOL_REGION_SIZE);
+#endif
+    }
+
+    // Allocates new blocks for the given size class (returns the linked list of blocks)
+    FreeBlock* AllocateBlocks(uint32 sizeClass, int32 count)
+    {
+        const uint64 stride = GetClassSize(sizeClass) + POOL_HEADER_SIZE;
+        RegionLocker.Lock();
+        if (!RegionStart || RegionStart + stride * count > RegionEnd)
+        {
+            // Remaining space of the previous region is wasted (it's smaller than a single batch)
+            RegionStart = AllocateRegion();
+            RegionEnd = RegionStart ? RegionStart + POOL_REGION_SIZE : nullptr;
+            if (!RegionStart)
+            {
+                RegionLocker.Unlock();
+                return nullptr;
+            }
+        }
+        byte* memory = RegionStart;
+        RegionStart += stride * count;
+        RegionLocker.Unlock();
+
+        // Headers are written once and stay valid for all future block reuses
+        FreeBlock* head = nullptr;
+        for (int32 i = count - 1; i >= 0; i--)
+        {
+            byte* block = memory + stride * i;
+            auto header = (BlockHeader*)block;
+            header->SizeClass = sizeClass;
+            header->Offset = POOL_HEADER_SIZE;
+            header->Size = 0;
+            auto freeBlock = (FreeBlock*)(block + POOL_HEADER_SIZE);
+            freeBlock->Next = head;
+            head = freeBlock;
+        }
+        return head;
+    }
+
+    bool RefillCache(uint32 sizeClass)
+    {
+        // Thread cache gets filled for the first time in here so register its cleanup once per thread
+        static thread_local ThreadCacheCleanup cleanup;
+        (void)cleanup;
+
+        const int32 batch = GetBatchCount(sizeClass);
+        SharedPool& pool = Pools[sizeClass];
+        pool.Locker.Lock();
+        if (pool.Count != 0)
+        {
+            // Move the batch of blocks from the shared pool
+            FreeBlock* head = pool.Head;
+            FreeBlock* tail = head;
+            int32 count = 1;
+            while (count < batch && tail->Next)
+            {
+                tail = tail->Next;
+                count++;
+            }
+            pool.Head = tail->Next;
+            pool.Count -= count;
+            pool.Locker.Unlock();
+            tail->Next = Cache.Heads[sizeClass];
+            Cache.Heads[sizeClass] = head;
+            Cache.Counts[sizeClass] += count;
+            return true;
+        }
+        pool.Locker.Unlock();
+
+        // Allocate new memory (from the current thread so pages are first touched by it)
+        FreeBlock* head = AllocateBlocks(sizeClass, batch);
+        if (!head)
+            return false;
+        Cache.Heads[sizeClass] = head;
+        Cache.Counts[sizeClass] = batch;
+        return true;
+    }
+
+    void ReleaseCache(uint32 sizeClass, int32 count)
+    {
+        FreeBlock* head = Cache.Heads[sizeClass];
+        if (!head || count <= 0)
+            return;
+        FreeBlock* tail = head;
+        int32 moved = 1;
+        while (moved < count && tail->Next)
+        {
+            tail = tail->Next;
+            moved++;
+        }
+        Cache.Heads[sizeClass] = tail->Next;
+        Cache.Counts[sizeClass] -= moved;
+
+        SharedPool& pool = Pools[sizeClass];
+        pool.Locker.Lock();
+        tail->Next = pool.Head;
+        pool.Head = head;
+        pool.Count += moved;
+        pool.Locker.Unlock();
+    }
+}
+
+void* PoolAllocator::Allocate(uint64 size, uint64 alignment)
+{
+    // Alignment always has to be power of two
+    ASSERT_LOW_LAYER((alignment & (alignment - 1)) == 0);
+    if (size == 0)
+        return nullptr;
+
+    if (size <= POOL_MAX_SMALL_SIZE && alignment <= POOL_HEADER_SIZE)
+    {
+        // Small allocation from the thread cache
+        const uint32 sizeClass = GetSizeClass(size);
+        FreeBlock* block = Cache.Heads[sizeClass];
+        if (!block)
+        {
+            if (!RefillCache(sizeClass))
+                return nullptr;
+            block = Cache.Heads[sizeClass];
+        }
+        Cache.Heads[sizeClass] = block->Next;
+        Cache.Counts[sizeClass]--;
+        ((BlockHeader*)((byte*)block - POOL_HEADER_SIZE))->Size = size;
+#if COMPILE_WITH_PROFILER
+        Platform::OnMemoryAlloc(block, size);
+#endif
+        return block;
+    }
+
+    // Large allocation from the platform (with header placed before the aligned pointer)
+    const uint64 offset = Math::Max<uint64>(alignment, POOL_HEADER_SIZE);
+    byte* memory = (byte*)Platform::Allocate(size + offset, offset);
+    if (!memory)
+        return nullptr;
+    byte* ptr = memory + offset;
+    auto header = (BlockHeader*)(ptr - POOL_HEADER_SIZE);
+    header->SizeClass = POOL_LARGE_CLASS;
+    header->Offset = (uint32)offset;
+    header->Size = size;
+    return ptr;
+}
+
+void PoolAllocator::Free(void* ptr)
+{
+    if (!ptr)
+        return;
+    const auto header = (BlockHeader*)((byte*)ptr - POOL_HEADER_SIZE);
+    const uint32 sizeClass = header->SizeClass;
+    if (sizeClass == POOL_LARGE_CLASS)
+    {
+        Platform::Free((byte*)ptr - header->Offset);
+        return;
+    }
+    ASSERT_LOW_LAYER(sizeClass < POOL_CLASSES_COUNT);
+#if COMPILE_WITH_PROFILER
+    Platform::OnMemoryFree(ptr);
+#endif
+
+    // Return block to the thread cache (and release the half of cache to the shared pool if it gets too big)
+    auto block = (FreeBlock*)ptr;
+    block->Next = Cache.Heads[sizeClass];
+    Cache.Heads[sizeClass] = block;
+    const int32 batch = GetBatchCount(sizeClass);
+    if (++Cache.Counts[sizeClass] > batch * 2)
+        ReleaseCache(sizeClass, batch);
+}
+
+void PoolAllocator::FlushThreadCache()
+{
+    for (uint32 sizeClass = 0; sizeClass < POOL_CLASSES_COUNT; sizeClass++)
+        ReleaseCache(sizeClass, Cache.Counts[sizeClass]);
+}
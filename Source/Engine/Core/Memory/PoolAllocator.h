@@ -0,0 +1,44 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Platform/Platform.h"
+
+/// <summary>
+/// The high-performance memory allocator with thread-local caches of size-class pools. Small allocations are served from the per-thread free lists (without locking) that are refilled in batches from the shared pools, large allocations fallback to the platform allocator.
+/// </summary>
+/// <remarks>
+/// Enabled via USE_POOL_ALLOCATOR build define (use -usePoolAllocator=true build tool command line). Pools memory is allocated in large regions (using huge pages if POOL_ALLOCATOR_LARGE_PAGES is enabled) which are first touched by the thread that requested them, so on NUMA systems (with the first-touch memory policy) job workers use memory local to their node.
+/// </remarks>
+class FLAXENGINE_API PoolAllocator
+{
+public:
+    /// <summary>
+    /// Allocates memory on a specified alignment boundary.
+    /// </summary>
+    /// <param name="size">The size of the allocation (in bytes).</param>
+    /// <param name="alignment">The memory alignment (in bytes). Must be an integer power of 2.</param>
+    /// <returns>The pointer to the allocated chunk of the memory. The pointer is a multiple of alignment.</returns>
+    static void* Allocate(uint64 size, uint64 alignment = 16);
+
+    /// <summary>
+    /// Frees a block of allocated memory.
+    /// </summary>
+    /// <param name="ptr">A pointer to the memory block to deallocate.</param>
+    static void Free(void* ptr);
+
+    /// <summary>
+    /// Returns all the memory blocks cached by the current thread to the shared pools. Called automatically when thread exits and by the engine for the main thread on exit.
+    /// </summary>
+    static void FlushThreadCache();
+
+    /// <summary>
+    /// Gets the name of the allocator.
+    /// </summary>
+    /// <returns>The name.</returns>
+    static const Char* Name()
+    {
+        return TEXT("Pool");
+    }
+};
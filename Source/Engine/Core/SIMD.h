@@ -4,13 +4,71 @@
 
 #include "Engine/Platform/Platform.h"
 #if PLATFORM_SIMD_SSE2
-#ifdef _WIN32
 #include <xmmintrin.h>
+#if PLATFORM_SIMD_AVX2
+#include <immintrin.h>
 #endif
+#elif PLATFORM_SIMD_NEON && PLATFORM_ARCH_ARM64
+#include <arm_neon.h>
 #else
 #include <math.h>
 #endif
 
+#if PLATFORM_SIMD_AVX2
+
+// Vector of eight floating point values stored in vector register.
+typedef __m256 SimdVector8;
+
+namespace SIMD
+{
+    FORCE_INLINE SimdVector8 Load8(const void* src)
+    {
+        return _mm256_loadu_ps((const float*)(src));
+    }
+
+    FORCE_INLINE SimdVector8 Splat8(float value)
+    {
+        return _mm256_set1_ps(value);
+    }
+
+    FORCE_INLINE void Store(void* dst, SimdVector8 src)
+    {
+        _mm256_storeu_ps((float*)dst, src);
+    }
+
+    FORCE_INLINE int MoveMask(SimdVector8 a)
+    {
+        return _mm256_movemask_ps(a);
+    }
+
+    FORCE_INLINE SimdVector8 Add(SimdVector8 a, SimdVector8 b)
+    {
+        return _mm256_add_ps(a, b);
+    }
+
+    FORCE_INLINE SimdVector8 Sub(SimdVector8 a, SimdVector8 b)
+    {
+        return _mm256_sub_ps(a, b);
+    }
+
+    FORCE_INLINE SimdVector8 Mul(SimdVector8 a, SimdVector8 b)
+    {
+        return _mm256_mul_ps(a, b);
+    }
+
+    FORCE_INLINE SimdVector8 Min(SimdVector8 a, SimdVector8 b)
+    {
+        return _mm256_min_ps(a, b);
+    }
+
+    FORCE_INLINE SimdVector8 Max(SimdVector8 a, SimdVector8 b)
+    {
+        return _mm256_max_ps(a, b);
+    }
+}
+
+#endif
+
 #if PLATFORM_SIMD_SSE2
 
 // Vector of four floating point values stored in vector register.
@@ -94,6 +152,93 @@ namespace SIMD
     }
 }
 
+#elif PLATFORM_SIMD_NEON && PLATFORM_ARCH_ARM64
+
+// Vector of four floating point values stored in vector register.
+typedef float32x4_t SimdVector4;
+
+namespace SIMD
+{
+    FORCE_INLINE SimdVector4 Load(float xyzw)
+    {
+        return vdupq_n_f32(xyzw);
+    }
+
+    FORCE_INLINE SimdVector4 Load(float x, float y, float z, float w)
+    {
+        const float data[4] = { x, y, z, w };
+        return vld1q_f32(data);
+    }
+
+    FORCE_INLINE SimdVector4 Load(const void* src)
+    {
+        return vld1q_f32((const float*)(src));
+    }
+
+    FORCE_INLINE SimdVector4 Splat(float value)
+    {
+        return vdupq_n_f32(value);
+    }
+
+    FORCE_INLINE void Store(void* dst, SimdVector4 src)
+    {
+        vst1q_f32((float*)dst, src);
+    }
+
+    FORCE_INLINE int MoveMask(SimdVector4 a)
+    {
+        // Gather sign bits of all components
+        static const int32_t shift[4] = { 0, 1, 2, 3 };
+        const uint32x4_t signs = vshrq_n_u32(vreinterpretq_u32_f32(a), 31);
+        return (int)vaddvq_u32(vshlq_u32(signs, vld1q_s32(shift)));
+    }
+
+    FORCE_INLINE SimdVector4 Add(SimdVector4 a, SimdVector4 b)
+    {
+        return vaddq_f32(a, b);
+    }
+
+    FORCE_INLINE SimdVector4 Sub(SimdVector4 a, SimdVector4 b)
+    {
+        return vsubq_f32(a, b);
+    }
+
+    FORCE_INLINE SimdVector4 Mul(SimdVector4 a, SimdVector4 b)
+    {
+        return vmulq_f32(a, b);
+    }
+
+    FORCE_INLINE SimdVector4 Div(SimdVector4 a, SimdVector4 b)
+    {
+        return vdivq_f32(a, b);
+    }
+
+    FORCE_INLINE SimdVector4 Rcp(SimdVector4 a)
+    {
+        return vrecpeq_f32(a);
+    }
+
+    FORCE_INLINE SimdVector4 Sqrt(SimdVector4 a)
+    {
+        return vsqrtq_f32(a);
+    }
+
+    FORCE_INLINE SimdVector4 Rsqrt(SimdVector4 a)
+    {
+        return vrsqrteq_f32(a);
+    }
+
+    FORCE_INLINE SimdVector4 Min(SimdVector4 a, SimdVector4 b)
+    {
+        return vminq_f32(a, b);
+    }
+
+    FORCE_INLINE SimdVector4 Max(SimdVector4 a, SimdVector4 b)
+    {
+        return vmaxq_f32(a, b);
+    }
+}
+
 #else
 
 struct SimdVector4
@@ -0,0 +1,97 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "StringName.h"
+#include "String.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Threading/Threading.h"
+
+// The size of the memory blocks used to store the names text (allocated on demand, never released)
+#define STRING_NAME_BLOCK_SIZE (64 * 1024)
+
+namespace
+{
+    byte* NamesBlock = nullptr;
+    int32 NamesBlockLeft = 0;
+
+    // Names can be created during static initialization so the table is created on the first use
+    struct NamesTable
+    {
+        CriticalSection Locker;
+        Dictionary<StringView, const StringName::Entry*> Names;
+
+        NamesTable()
+            : Names(1024)
+        {
+        }
+    };
+
+    NamesTable& GetTable()
+    {
+        static NamesTable table;
+        return table;
+    }
+
+    StringName::Entry* AllocateEntry(int32 length)
+    {
+        // Use linear allocation from the blocks (names are never released and usually short)
+        const int32 size = Math::AlignUp<int32>(OFFSET_OF(StringName::Entry, Text) + (length + 1) * sizeof(Char), sizeof(void*));
+        if (size > STRING_NAME_BLOCK_SIZE / 4)
+            return (StringName::Entry*)Platform::Allocate(size, sizeof(void*));
+        if (size > NamesBlockLeft)
+        {
+            NamesBlock = (byte*)Platform::Allocate(STRING_NAME_BLOCK_SIZE, sizeof(void*));
+            NamesBlockLeft = STRING_NAME_BLOCK_SIZE;
+        }
+        auto entry = (StringName::Entry*)NamesBlock;
+        NamesBlock += size;
+        NamesBlockLeft -= size;
+        return entry;
+    }
+}
+
+const StringName StringName::Empty;
+
+StringName::StringName(const StringView& text)
+{
+    if (text.IsEmpty())
+        return;
+    NamesTable& table = GetTable();
+    ScopeLock lock(table.Locker);
+    const Entry* entry;
+    if (!table.Names.TryGet(text, entry))
+    {
+        Entry* newEntry = AllocateEntry(text.Length());
+        newEntry->Hash = GetHash(text);
+        newEntry->Length = text.Length();
+        Platform::MemoryCopy(newEntry->Text, text.Get(), text.Length() * sizeof(Char));
+        newEntry->Text[text.Length()] = 0;
+        table.Names.Add(StringView(newEntry->Text, newEntry->Length), newEntry);
+        entry = newEntry;
+    }
+    _entry = entry;
+}
+
+StringName StringName::Find(const StringView& text)
+{
+    const Entry* entry = nullptr;
+    if (text.HasChars())
+    {
+        NamesTable& table = GetTable();
+        ScopeLock lock(table.Locker);
+        table.Names.TryGet(text, entry);
+    }
+    return StringName(entry);
+}
+
+int32 StringName::GetNamesCount()
+{
+    NamesTable& table = GetTable();
+    ScopeLock lock(table.Locker);
+    return table.Names.Count();
+}
+
+String StringName::ToString() const
+{
+    return String(ToStringView());
+}
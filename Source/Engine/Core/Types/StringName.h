@@ -0,0 +1,161 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Core/Types/StringView.h"
+#include "Engine/Core/Templates.h"
+#include "Engine/Core/Formatting.h"
+
+/// <summary>
+/// Interned, immutable text (eg. parameter or type name). Each unique text is stored once in the global names table (never released) so names are compared by pointer and have the hash cached.
+/// </summary>
+/// <remarks>
+/// Creating the name from text looks up the global table (thread-safe, locks). Cache the names used on the hot paths (eg. in static variables) and compare them instead of the strings. Names are case-sensitive.
+/// </remarks>
+struct FLAXENGINE_API StringName
+{
+public:
+    /// <summary>
+    /// The interned text entry.
+    /// </summary>
+    struct Entry
+    {
+        uint32 Hash;
+        int32 Length;
+        Char Text[1];
+    };
+
+private:
+    const Entry* _entry = nullptr;
+
+    FORCE_INLINE explicit StringName(const Entry* entry)
+        : _entry(entry)
+    {
+    }
+
+public:
+    /// <summary>
+    /// The empty name.
+    /// </summary>
+    static const StringName Empty;
+
+    StringName() = default;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="StringName"/> struct (interns the text if it's not in the names table yet).
+    /// </summary>
+    /// <param name="text">The text.</param>
+    explicit StringName(const StringView& text);
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="StringName"/> struct (interns the text if it's not in the names table yet).
+    /// </summary>
+    /// <param name="text">The text.</param>
+    explicit StringName(const Char* text)
+        : StringName(StringView(text))
+    {
+    }
+
+    /// <summary>
+    /// Finds the name of the given text without adding it to the names table.
+    /// </summary>
+    /// <param name="text">The text.</param>
+    /// <returns>The name or empty if the text has not been interned.</returns>
+    static StringName Find(const StringView& text);
+
+    /// <summary>
+    /// Gets the amount of the unique names in the table.
+    /// </summary>
+    static int32 GetNamesCount();
+
+public:
+    FORCE_INLINE bool IsEmpty() const
+    {
+        return _entry == nullptr;
+    }
+
+    FORCE_INLINE bool HasChars() const
+    {
+        return _entry != nullptr;
+    }
+
+    FORCE_INLINE int32 Length() const
+    {
+        return _entry ? _entry->Length : 0;
+    }
+
+    /// <summary>
+    /// Gets the pointer to the null-terminated text (or empty text).
+    /// </summary>
+    FORCE_INLINE const Char* GetText() const
+    {
+        return _entry ? _entry->Text : TEXT("");
+    }
+
+    /// <summary>
+    /// Gets the cached hash code of the text.
+    /// </summary>
+    FORCE_INLINE uint32 GetHashCode() const
+    {
+        return _entry ? _entry->Hash : 0;
+    }
+
+    FORCE_INLINE StringView ToStringView() const
+    {
+        return _entry ? StringView(_entry->Text, _entry->Length) : StringView::Empty;
+    }
+
+    String ToString() const;
+
+    FORCE_INLINE bool operator==(const StringName& other) const
+    {
+        return _entry == other._entry;
+    }
+
+    FORCE_INLINE bool operator!=(const StringName& other) const
+    {
+        return _entry != other._entry;
+    }
+
+    bool operator==(const StringView& other) const
+    {
+        return ToStringView() == other;
+    }
+
+    bool operator!=(const StringView& other) const
+    {
+        return ToStringView() != other;
+    }
+};
+
+template<>
+struct TIsPODType<StringName>
+{
+    enum { Value = true };
+};
+
+inline uint32 GetHash(const StringName& key)
+{
+    return key.GetHashCode();
+}
+
+namespace fmt
+{
+    template<>
+    struct formatter<StringName, Char>
+    {
+        template<typename ParseContext>
+        auto parse(ParseContext& ctx)
+        {
+            return ctx.begin();
+        }
+
+        template<typename FormatContext>
+        auto format(const StringName& v, FormatContext& ctx) -> decltype(ctx.out())
+        {
+            const Char* text = v.GetText();
+            return fmt::detail::copy_str<Char>(text, text + v.Length(), ctx.out());
+        }
+    };
+}
@@ -34,6 +34,101 @@
 #define MANAGED_GC_HANDLE AsUint
 #endif
 
+// Size of the pooled memory block used for the value types that don't fit into the Variant inlined data (eg. Transform or Matrix)
+#define VARIANT_VALUE_BLOCK_SIZE 64
+// Maximum amount of the free value blocks cached per-thread (excess is moved to the shared list)
+#define VARIANT_VALUE_BLOCKS_CACHE 256
+
+namespace
+{
+    struct ValueBlock
+    {
+        ValueBlock* Next;
+    };
+
+    struct ValueBlocksCache
+    {
+        ValueBlock* Head;
+        int32 Count;
+    };
+
+    // Boxed value types are created and destroyed very frequently (eg. by Visject graphs) so they use fixed-size blocks from the per-thread free lists instead of the heap allocations.
+    // Blocks can be freed on a different thread than allocated (they flow back via the shared list). Memory is never released.
+    THREADLOCAL ValueBlocksCache ValueBlocksLocal = { nullptr, 0 };
+    ValueBlock* ValueBlocksShared = nullptr;
+    int32 volatile ValueBlocksLocker = 0;
+
+    void LockValueBlocks()
+    {
+        while (Platform::InterlockedCompareExchange(&ValueBlocksLocker, 1, 0) != 0)
+            Platform::Sleep(0);
+    }
+
+    void UnlockValueBlocks()
+    {
+        Platform::AtomicStore(&ValueBlocksLocker, 0);
+    }
+
+    void* AllocateValue()
+    {
+        ValueBlocksCache& cache = ValueBlocksLocal;
+        if (!cache.Head)
+        {
+            // Refill local cache from the shared list
+            constexpr int32 batch = VARIANT_VALUE_BLOCKS_CACHE / 2;
+            LockValueBlocks();
+            while (ValueBlocksShared && cache.Count < batch)
+            {
+                ValueBlock* block = ValueBlocksShared;
+                ValueBlocksShared = block->Next;
+                block->Next = cache.Head;
+                cache.Head = block;
+                cache.Count++;
+            }
+            UnlockValueBlocks();
+            if (!cache.Head)
+            {
+                // Allocate a new chunk of blocks
+                byte* chunk = (byte*)Allocator::Allocate(batch * VARIANT_VALUE_BLOCK_SIZE, 16);
+                for (int32 i = 0; i < batch; i++)
+                {
+                    ValueBlock* block = (ValueBlock*)(chunk + i * VARIANT_VALUE_BLOCK_SIZE);
+                    block->Next = cache.Head;
+                    cache.Head = block;
+                }
+                cache.Count = batch;
+            }
+        }
+        ValueBlock* block = cache.Head;
+        cache.Head = block->Next;
+        cache.Count--;
+        return block;
+    }
+
+    void FreeValue(void* ptr)
+    {
+        ValueBlocksCache& cache = ValueBlocksLocal;
+        ValueBlock* block = (ValueBlock*)ptr;
+        block->Next = cache.Head;
+        cache.Head = block;
+        cache.Count++;
+        if (cache.Count > VARIANT_VALUE_BLOCKS_CACHE)
+        {
+            // Move half of the local cache to the shared list (eg. when values are produced on one thread and released on another)
+            ValueBlock* first = cache.Head;
+            ValueBlock* last = first;
+            for (int32 i = 1; i < VARIANT_VALUE_BLOCKS_CACHE / 2; i++)
+                last = last->Next;
+            cache.Head = last->Next;
+            cache.Count -= VARIANT_VALUE_BLOCKS_CACHE / 2;
+            LockValueBlocks();
+            last->Next = ValueBlocksShared;
+            ValueBlocksShared = first;
+            UnlockValueBlocks();
+        }
+    }
+}
+
 namespace
 {
     const char* InBuiltTypesTypeNames[40] =
@@ -484,6 +579,11 @@ static_assert(sizeof(Variant::AsData) >= sizeof(BoundingBox), "Invalid Variant d
 static_assert(sizeof(Variant::AsData) >= sizeof(Ray), "Invalid Variant data size!");
 #endif
 static_assert(sizeof(Variant::AsData) >= sizeof(Array<Variant, HeapAllocation>), "Invalid Variant data size!");
+static_assert(sizeof(Double4) <= VARIANT_VALUE_BLOCK_SIZE, "Invalid Variant value block size!");
+static_assert(sizeof(Transform) <= VARIANT_VALUE_BLOCK_SIZE, "Invalid Variant value block size!");
+static_assert(sizeof(Matrix) <= VARIANT_VALUE_BLOCK_SIZE, "Invalid Variant value block size!");
+static_assert(sizeof(BoundingBox) <= VARIANT_VALUE_BLOCK_SIZE, "Invalid Variant value block size!");
+static_assert(sizeof(Ray) <= VARIANT_VALUE_BLOCK_SIZE, "Invalid Variant value block size!");
 
 const Variant Variant::Zero(0.0f);
 const Variant Variant::One(1.0f);
@@ -755,7 +855,7 @@ Variant::Variant(const Double4& v)
     : Type(VariantType::Double4)
 {
     AsBlob.Length = sizeof(Double4);
-    AsBlob.Data = Allocator::Allocate(AsBlob.Length);
+    AsBlob.Data = AllocateValue();
     *(Double4*)AsBlob.Data = v;
 }
 
@@ -794,7 +894,7 @@ Variant::Variant(const BoundingSphere& v)
 {
 #if USE_LARGE_WORLDS
     AsBlob.Length = sizeof(BoundingSphere);
-    AsBlob.Data = Allocator::Allocate(AsBlob.Length);
+    AsBlob.Data = AllocateValue();
     *(BoundingSphere*)AsBlob.Data = v;
 #else
     *(BoundingSphere*)AsData = v;
@@ -812,7 +912,7 @@ Variant::Variant(const BoundingBox& v)
 {
 #if USE_LARGE_WORLDS
     AsBlob.Length = sizeof(BoundingBox);
-    AsBlob.Data = Allocator::Allocate(AsBlob.Length);
+    AsBlob.Data = AllocateValue();
     *(BoundingBox*)AsBlob.Data = v;
 #else
     *(BoundingBox*)AsData = v;
@@ -823,7 +923,7 @@ Variant::Variant(const Transform& v)
     : Type(VariantType::Transform)
 {
     AsBlob.Length = sizeof(Transform);
-    AsBlob.Data = Allocator::Allocate(AsBlob.Length);
+    AsBlob.Data = AllocateValue();
     *(Transform*)AsBlob.Data = v;
 }
 
@@ -832,7 +932,7 @@ Variant::Variant(const Ray& v)
 {
 #if USE_LARGE_WORLDS
     AsBlob.Length = sizeof(Ray);
-    AsBlob.Data = Allocator::Allocate(AsBlob.Length);
+    AsBlob.Data = AllocateValue();
     *(Ray*)AsBlob.Data = v;
 #else
     *(Ray*)AsData = v;
@@ -843,7 +943,7 @@ Variant::Variant(const Matrix& v)
     : Type(VariantType::Matrix)
 {
     AsBlob.Length = sizeof(Matrix);
-    AsBlob.Data = Allocator::Allocate(AsBlob.Length);
+    AsBlob.Data = AllocateValue();
     *(Matrix*)AsBlob.Data = v;
 }
 
@@ -976,16 +1076,18 @@ Variant::~Variant()
         break;
     case VariantType::String:
     case VariantType::Blob:
+    case VariantType::Typename:
+        Allocator::Free(AsBlob.Data);
+        break;
     case VariantType::Transform:
     case VariantType::Matrix:
-    case VariantType::Typename:
     case VariantType::Double4:
 #if USE_LARGE_WORLDS
     case VariantType::BoundingSphere:
     case VariantType::BoundingBox:
     case VariantType::Ray:
 #endif
-        Allocator::Free(AsBlob.Data);
+        FreeValue(AsBlob.Data);
         break;
     case VariantType::Array:
         reinterpret_cast<Array<Variant, HeapAllocation>*>(AsData)->~Array<Variant, HeapAllocation>();
@@ -1071,17 +1173,20 @@ Variant& Variant::operator=(const Variant& other)
     case VariantType::Structure:
         CopyStructure(other.AsBlob.Data);
         break;
-    case VariantType::String:
-    case VariantType::Blob:
     case VariantType::Transform:
     case VariantType::Matrix:
-    case VariantType::Typename:
     case VariantType::Double4:
 #if USE_LARGE_WORLDS
     case VariantType::BoundingSphere:
     case VariantType::BoundingBox:
     case VariantType::Ray:
 #endif
+        // Value block is always allocated by SetType for the boxed value types
+        Platform::MemoryCopy(AsBlob.Data, other.AsBlob.Data, AsBlob.Length);
+        break;
+    case VariantType::String:
+    case VariantType::Blob:
+    case VariantType::Typename:
         if (other.AsBlob.Data)
         {
             if (!AsBlob.Data || AsBlob.Length != other.AsBlob.Length)
@@ -2366,16 +2471,18 @@ void Variant::SetType(const VariantType& type)
         break;
     case VariantType::String:
     case VariantType::Blob:
+    case VariantType::Typename:
+        Allocator::Free(AsBlob.Data);
+        break;
     case VariantType::Transform:
     case VariantType::Matrix:
-    case VariantType::Typename:
     case VariantType::Double4:
 #if USE_LARGE_WORLDS
     case VariantType::BoundingSphere:
     case VariantType::BoundingBox:
     case VariantType::Ray:
 #endif
-        Allocator::Free(AsBlob.Data);
+        FreeValue(AsBlob.Data);
         break;
     case VariantType::Array:
         reinterpret_cast<Array<Variant, HeapAllocation>*>(AsData)->~Array<Variant, HeapAllocation>();
@@ -2410,29 +2517,29 @@ void Variant::SetType(const VariantType& type)
         AsAsset = nullptr;
         break;
     case VariantType::Double4:
-        AsBlob.Data = Allocator::Allocate(sizeof(Double4));
+        AsBlob.Data = AllocateValue();
         AsBlob.Length = sizeof(Double4);
         break;
 #if USE_LARGE_WORLDS
     case VariantType::BoundingSphere:
-        AsBlob.Data = Allocator::Allocate(sizeof(BoundingSphere));
+        AsBlob.Data = AllocateValue();
         AsBlob.Length = sizeof(BoundingSphere);
         break;
     case VariantType::BoundingBox:
-        AsBlob.Data = Allocator::Allocate(sizeof(BoundingBox));
+        AsBlob.Data = AllocateValue();
         AsBlob.Length = sizeof(BoundingBox);
         break;
     case VariantType::Ray:
-        AsBlob.Data = Allocator::Allocate(sizeof(Ray));
+        AsBlob.Data = AllocateValue();
         AsBlob.Length = sizeof(Ray);
         break;
 #endif
     case VariantType::Transform:
-        AsBlob.Data = Allocator::Allocate(sizeof(Transform));
+        AsBlob.Data = AllocateValue();
         AsBlob.Length = sizeof(Transform);
         break;
     case VariantType::Matrix:
-        AsBlob.Data = Allocator::Allocate(sizeof(Matrix));
+        AsBlob.Data = AllocateValue();
         AsBlob.Length = sizeof(Matrix);
         break;
     case VariantType::Array:
@@ -2478,16 +2585,18 @@ void Variant::SetType(VariantType&& type)
         break;
     case VariantType::String:
     case VariantType::Blob:
+    case VariantType::Typename:
+        Allocator::Free(AsBlob.Data);
+        break;
     case VariantType::Transform:
     case VariantType::Matrix:
-    case VariantType::Typename:
     case VariantType::Double4:
 #if USE_LARGE_WORLDS
     case VariantType::BoundingSphere:
     case VariantType::BoundingBox:
     case VariantType::Ray:
 #endif
-        Allocator::Free(AsBlob.Data);
+        FreeValue(AsBlob.Data);
         break;
     case VariantType::Array:
         reinterpret_cast<Array<Variant, HeapAllocation>*>(AsData)->~Array<Variant, HeapAllocation>();
@@ -2522,29 +2631,29 @@ void Variant::SetType(VariantType&& type)
         AsAsset = nullptr;
         break;
     case VariantType::Double4:
-        AsBlob.Data = Allocator::Allocate(sizeof(Double4));
+        AsBlob.Data = AllocateValue();
         AsBlob.Length = sizeof(Double4);
         break;
 #if USE_LARGE_WORLDS
     case VariantType::BoundingSphere:
-        AsBlob.Data = Allocator::Allocate(sizeof(BoundingSphere));
+        AsBlob.Data = AllocateValue();
         AsBlob.Length = sizeof(BoundingSphere);
         break;
     case VariantType::BoundingBox:
-        AsBlob.Data = Allocator::Allocate(sizeof(BoundingBox));
+        AsBlob.Data = AllocateValue();
         AsBlob.Length = sizeof(BoundingBox);
         break;
     case VariantType::Ray:
-        AsBlob.Data = Allocator::Allocate(sizeof(Ray));
+        AsBlob.Data = AllocateValue();
         AsBlob.Length = sizeof(Ray);
         break;
 #endif
     case VariantType::Transform:
-        AsBlob.Data = Allocator::Allocate(sizeof(Transform));
+        AsBlob.Data = AllocateValue();
         AsBlob.Length = sizeof(Transform);
         break;
     case VariantType::Matrix:
-        AsBlob.Data = Allocator::Allocate(sizeof(Matrix));
+        AsBlob.Data = AllocateValue();
         AsBlob.Length = sizeof(Matrix);
         break;
     case VariantType::Array:
@@ -9,6 +9,7 @@
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Core/Math/OrientedBoundingBox.h"
+#include "Engine/Core/Math/Matrix3x4.h"
 #include "Engine/Content/Assets/Shader.h"
 #include "Engine/Content/AssetReference.h"
 #include "Engine/Graphics/GPUContext.h"
@@ -25,6 +26,8 @@
 #include "Engine/Debug/DebugLog.h"
 #include "Engine/Render2D/Render2D.h"
 #include "Engine/Render2D/FontAsset.h"
+#include "Engine/Threading/Threading.h"
+#include "Engine/Threading/ThreadLocal.h"
 #if USE_EDITOR
 #include "Editor/Editor.h"
 #endif
@@ -120,14 +123,46 @@ struct DebugText3D
     float TimeLeft;
 };
 
+// Wireframe shapes drawn with instancing of the unit mesh (see ShapeMeshes)
+enum class DebugShapeType
+{
+    WireBox,
+    WireSphereLOD0,
+    WireSphereLOD1,
+    WireSphereLOD2,
+    MAX
+};
+
+#define DEBUG_DRAW_SHAPE_TYPES ((int32)DebugShapeType::MAX)
+
+struct DebugShape
+{
+    Matrix3x4 World;
+    Color32 Color;
+    float TimeLeft;
+};
+
 PACK_STRUCT(struct Vertex {
     Float3 Position;
     Color32 Color;
     });
 
+PACK_STRUCT(struct RetainedVertex {
+    Float3 Position;
+    Color32 Color;
+    float ExpireTime;
+    });
+
+PACK_STRUCT(struct ShapeInstance {
+    Matrix3x4 World;
+    Color32 Color;
+    float ExpireTime;
+    });
+
 PACK_STRUCT(struct Data {
     Matrix ViewProjection;
-    Float2 Padding;
+    float Time;
+    float Padding;
     float ClipPosZBias;
     uint32 EnableDepthTest;
     });
@@ -178,18 +213,84 @@ struct PsData
     }
 };
 
+struct PsDataSet
+{
+    PsData LinesDefault;
+    PsData LinesDepthTest;
+    PsData WireTrianglesDefault;
+    PsData WireTrianglesDepthTest;
+    PsData TrianglesDefault;
+    PsData TrianglesDepthTest;
+
+    bool Create(GPUShader* shader, GPUShaderProgramVS* vs)
+    {
+        bool failed = false;
+        GPUPipelineState::Description desc = GPUPipelineState::Description::Default;
+        desc.BlendMode = BlendingMode::AlphaBlend;
+        desc.CullMode = CullMode::TwoSided;
+        desc.VS = vs;
+
+        // Default
+        desc.PS = shader->GetPS("PS", 0);
+        desc.PrimitiveTopology = PrimitiveTopologyType::Line;
+        failed |= LinesDefault.Create(desc);
+        desc.PS = shader->GetPS("PS", 1);
+        desc.PrimitiveTopology = PrimitiveTopologyType::Triangle;
+        failed |= TrianglesDefault.Create(desc);
+        desc.Wireframe = true;
+        failed |= WireTrianglesDefault.Create(desc);
+
+        // Depth Test
+        desc.Wireframe = false;
+        desc.PS = shader->GetPS("PS", 2);
+        desc.PrimitiveTopology = PrimitiveTopologyType::Line;
+        failed |= LinesDepthTest.Create(desc);
+        desc.PS = shader->GetPS("PS", 3);
+        desc.PrimitiveTopology = PrimitiveTopologyType::Triangle;
+        failed |= TrianglesDepthTest.Create(desc);
+        desc.Wireframe = true;
+        failed |= WireTrianglesDepthTest.Create(desc);
+
+        return failed;
+    }
+
+    void Release()
+    {
+        LinesDefault.Release();
+        LinesDepthTest.Release();
+        WireTrianglesDefault.Release();
+        WireTrianglesDepthTest.Release();
+        TrianglesDefault.Release();
+        TrianglesDepthTest.Release();
+    }
+};
+
+FORCE_INLINE GPUPipelineState* GetState(PsData& psDefault, PsData& psDepthTest, bool depthPass, bool enableDepthTest)
+{
+    if (depthPass)
+        return (enableDepthTest ? psDepthTest : psDefault).Get(enableDepthTest, true);
+    return psDefault.Get(false, false);
+}
+
 template<typename T>
-void UpdateList(float dt, Array<T>& list)
+int32 UpdateList(float dt, Array<T>& list)
 {
-    for (int32 i = 0; i < list.Count() && list.HasItems(); i++)
+    // Remove expired items in a single pass (preserves the order)
+    T* items = list.Get();
+    int32 count = 0;
+    for (int32 i = 0; i < list.Count(); i++)
     {
-        list[i].TimeLeft -= dt;
-        if (list[i].TimeLeft <= 0)
+        items[i].TimeLeft -= dt;
+        if (items[i].TimeLeft > 0)
         {
-            list.RemoveAt(i);
-            i--;
+            if (count != i)
+                items[count] = MoveTemp(items[i]);
+            count++;
         }
     }
+    const int32 removed = list.Count() - count;
+    list.Resize(count);
+    return removed;
 }
 
 void TeleportList(const Float3& delta, Array<DebugLine>& list)
@@ -227,6 +328,39 @@ void TeleportList(const Float3& delta, Array<DebugText3D>& list)
     }
 }
 
+void TeleportList(const Float3& delta, Array<DebugShape>& list)
+{
+    for (auto& v : list)
+    {
+        v.World.M[0][3] += delta.X;
+        v.World.M[1][3] += delta.Y;
+        v.World.M[2][3] += delta.Z;
+    }
+}
+
+struct DebugDrawCall
+{
+    int32 StartVertex = 0;
+    int32 VertexCount = 0;
+};
+
+struct DebugDrawCalls
+{
+    DebugDrawCall Lines;
+    DebugDrawCall WireTriangles;
+    DebugDrawCall Triangles;
+    // Ranges of instances in the instances buffer (StartVertex is the first instance)
+    DebugDrawCall Shapes[DEBUG_DRAW_SHAPE_TYPES];
+
+    bool HasItems() const
+    {
+        int32 count = Lines.VertexCount + WireTriangles.VertexCount + Triangles.VertexCount;
+        for (int32 i = 0; i < DEBUG_DRAW_SHAPE_TYPES; i++)
+            count += Shapes[i].VertexCount;
+        return count != 0;
+    }
+};
+
 struct DebugDrawData
 {
     Array<DebugLine> DefaultLines;
@@ -235,14 +369,30 @@ struct DebugDrawData
     Array<DebugTriangle> OneFrameTriangles;
     Array<DebugTriangle> DefaultWireTriangles;
     Array<DebugTriangle> OneFrameWireTriangles;
+    Array<DebugShape> DefaultShapes[DEBUG_DRAW_SHAPE_TYPES];
+    Array<DebugShape> OneFrameShapes[DEBUG_DRAW_SHAPE_TYPES];
     Array<DebugText2D> DefaultText2D;
     Array<DebugText2D> OneFrameText2D;
     Array<DebugText3D> DefaultText3D;
     Array<DebugText3D> OneFrameText3D;
 
+    // Persistent shapes (with duration) are kept in GPU buffers and uploaded only after a change (expired items are culled in a vertex shader until the next upload)
+    DynamicVertexBuffer* RetainedVB = nullptr;
+    DynamicVertexBuffer* RetainedInstancesVB = nullptr;
+    DebugDrawCalls Retained;
+    int32 RetainedUploaded = 0;
+    int32 RetainedItems = 0;
+    bool RetainedDirty = false;
+
+    ~DebugDrawData()
+    {
+        SAFE_DELETE(RetainedVB);
+        SAFE_DELETE(RetainedInstancesVB);
+    }
+
     inline int32 Count() const
     {
-        return LinesCount() + TrianglesCount() + TextCount();
+        return LinesCount() + TrianglesCount() + ShapesCount() + TextCount();
     }
 
     inline int32 LinesCount() const
@@ -255,6 +405,37 @@ struct DebugDrawData
         return DefaultTriangles.Count() + OneFrameTriangles.Count() + DefaultWireTriangles.Count() + OneFrameWireTriangles.Count();
     }
 
+    inline int32 ShapesCount() const
+    {
+        return DefaultShapesCount() + OneFrameShapesCount();
+    }
+
+    inline int32 DefaultShapesCount() const
+    {
+        int32 count = 0;
+        for (int32 i = 0; i < DEBUG_DRAW_SHAPE_TYPES; i++)
+            count += DefaultShapes[i].Count();
+        return count;
+    }
+
+    inline int32 OneFrameShapesCount() const
+    {
+        int32 count = 0;
+        for (int32 i = 0; i < DEBUG_DRAW_SHAPE_TYPES; i++)
+            count += OneFrameShapes[i].Count();
+        return count;
+    }
+
+    inline int32 OneFrameVerticesCount() const
+    {
+        return OneFrameLines.Count() + (OneFrameTriangles.Count() + OneFrameWireTriangles.Count()) * 3;
+    }
+
+    inline int32 RetainedCount() const
+    {
+        return DefaultLines.Count() + DefaultTriangles.Count() + DefaultWireTriangles.Count() + DefaultShapesCount();
+    }
+
     inline int32 TextCount() const
     {
         return DefaultText2D.Count() + OneFrameText2D.Count() + DefaultText3D.Count() + OneFrameText3D.Count();
@@ -276,21 +457,42 @@ struct DebugDrawData
             OneFrameWireTriangles.Add(t);
     }
 
+    inline void AddShape(DebugShapeType type, const Matrix& world, const Color& color, float duration)
+    {
+        auto& shape = (duration > 0 ? DefaultShapes : OneFrameShapes)[(int32)type].AddOne();
+        shape.World.SetMatrixTranspose(world);
+        shape.Color = Color32(color);
+        shape.TimeLeft = duration;
+    }
+
     inline void Update(float deltaTime)
     {
-        UpdateList(deltaTime, DefaultLines);
-        UpdateList(deltaTime, DefaultTriangles);
-        UpdateList(deltaTime, DefaultWireTriangles);
+        int32 removed = UpdateList(deltaTime, DefaultLines);
+        removed += UpdateList(deltaTime, DefaultTriangles);
+        removed += UpdateList(deltaTime, DefaultWireTriangles);
+        for (int32 i = 0; i < DEBUG_DRAW_SHAPE_TYPES; i++)
+            removed += UpdateList(deltaTime, DefaultShapes[i]);
         UpdateList(deltaTime, DefaultText2D);
         UpdateList(deltaTime, DefaultText3D);
+        RetainedItems -= removed;
+        if (RetainedItems == 0)
+        {
+            // Skip drawing when all uploaded items expired
+            Retained = DebugDrawCalls();
+            RetainedUploaded = 0;
+        }
 
         OneFrameLines.Clear();
         OneFrameTriangles.Clear();
         OneFrameWireTriangles.Clear();
+        for (int32 i = 0; i < DEBUG_DRAW_SHAPE_TYPES; i++)
+            OneFrameShapes[i].Clear();
         OneFrameText2D.Clear();
         OneFrameText3D.Clear();
     }
 
+    void UpdateRetained(GPUContext* context, float time);
+
     void Teleport(const Float3& delta)
     {
         TeleportList(delta, DefaultLines);
@@ -299,8 +501,34 @@ struct DebugDrawData
         TeleportList(delta, OneFrameTriangles);
         TeleportList(delta, DefaultWireTriangles);
         TeleportList(delta, OneFrameWireTriangles);
+        for (int32 i = 0; i < DEBUG_DRAW_SHAPE_TYPES; i++)
+        {
+            TeleportList(delta, DefaultShapes[i]);
+            TeleportList(delta, OneFrameShapes[i]);
+        }
         TeleportList(delta, DefaultText3D);
         TeleportList(delta, OneFrameText3D);
+        RetainedDirty = true;
+    }
+
+    void Append(DebugDrawData& other)
+    {
+        DefaultLines.Add(other.DefaultLines);
+        OneFrameLines.Add(other.OneFrameLines);
+        DefaultTriangles.Add(other.DefaultTriangles);
+        OneFrameTriangles.Add(other.OneFrameTriangles);
+        DefaultWireTriangles.Add(other.DefaultWireTriangles);
+        OneFrameWireTriangles.Add(other.OneFrameWireTriangles);
+        for (int32 i = 0; i < DEBUG_DRAW_SHAPE_TYPES; i++)
+        {
+            DefaultShapes[i].Add(other.DefaultShapes[i]);
+            OneFrameShapes[i].Add(other.OneFrameShapes[i]);
+        }
+        DefaultText2D.Add(other.DefaultText2D);
+        OneFrameText2D.Add(other.OneFrameText2D);
+        DefaultText3D.Add(other.DefaultText3D);
+        OneFrameText3D.Add(other.OneFrameText3D);
+        other.Clear();
     }
 
     inline void Clear()
@@ -311,10 +539,16 @@ struct DebugDrawData
         OneFrameTriangles.Clear();
         DefaultWireTriangles.Clear();
         OneFrameWireTriangles.Clear();
+        for (int32 i = 0; i < DEBUG_DRAW_SHAPE_TYPES; i++)
+        {
+            DefaultShapes[i].Clear();
+            OneFrameShapes[i].Clear();
+        }
         DefaultText2D.Clear();
         OneFrameText2D.Clear();
         DefaultText3D.Clear();
         OneFrameText3D.Clear();
+        RetainedDirty = true;
     }
 
     inline void Release()
@@ -325,10 +559,21 @@ struct DebugDrawData
         OneFrameTriangles.Resize(0);
         DefaultWireTriangles.Resize(0);
         OneFrameWireTriangles.Resize(0);
+        for (int32 i = 0; i < DEBUG_DRAW_SHAPE_TYPES; i++)
+        {
+            DefaultShapes[i].Resize(0);
+            OneFrameShapes[i].Resize(0);
+        }
         DefaultText2D.Resize(0);
         OneFrameText2D.Resize(0);
         DefaultText3D.Resize(0);
         OneFrameText3D.Resize(0);
+        SAFE_DELETE(RetainedVB);
+        SAFE_DELETE(RetainedInstancesVB);
+        Retained = DebugDrawCalls();
+        RetainedUploaded = 0;
+        RetainedItems = 0;
+        RetainedDirty = true;
     }
 };
 
@@ -339,6 +584,31 @@ struct DebugDrawContext
     DebugDrawData DebugDrawDepthTest;
     Float3 LastViewPos = Float3::Zero;
     Matrix LastViewProj = Matrix::Identity;
+    float Time = 0.0f;
+
+    void Update(float deltaTime)
+    {
+        DebugDrawDefault.Update(deltaTime);
+        DebugDrawDepthTest.Update(deltaTime);
+
+        // Persistent shapes expiration time is relative to the context time so reset it when nothing is in use to keep the precision
+        if (DebugDrawDefault.RetainedItems == 0 && DebugDrawDepthTest.RetainedItems == 0)
+            Time = 0.0f;
+        else
+            Time += deltaTime;
+    }
+
+    void Clear()
+    {
+        DebugDrawDefault.Clear();
+        DebugDrawDepthTest.Clear();
+    }
+};
+
+struct DebugDrawThreadContext
+{
+    CriticalSection Locker;
+    DebugDrawContext Context;
 };
 
 namespace
@@ -347,13 +617,16 @@ namespace
     DebugDrawContext* Context;
     AssetReference<Shader> DebugDrawShader;
     AssetReference<FontAsset> DebugDrawFont;
-    PsData DebugDrawPsLinesDefault;
-    PsData DebugDrawPsLinesDepthTest;
-    PsData DebugDrawPsWireTrianglesDefault;
-    PsData DebugDrawPsWireTrianglesDepthTest;
-    PsData DebugDrawPsTrianglesDefault;
-    PsData DebugDrawPsTrianglesDepthTest;
+    PsDataSet DebugDrawPs;
+    PsDataSet DebugDrawPsRetained;
+    PsDataSet DebugDrawPsInstanced;
     DynamicVertexBuffer* DebugDrawVB = nullptr;
+    DynamicVertexBuffer* DebugDrawInstancesVB = nullptr;
+    GPUBuffer* DebugDrawShapesVB = nullptr;
+    DebugDrawCall ShapeMeshes[DEBUG_DRAW_SHAPE_TYPES];
+    ThreadLocal<DebugDrawThreadContext*> ThreadContexts;
+    Array<DebugDrawThreadContext*> ThreadContextsList;
+    CriticalSection ThreadContextsLocker;
     Float3 CircleCache[DEBUG_DRAW_CIRCLE_VERTICES];
     Array<Float3> SphereTriangleCache;
     DebugSphereCache SphereCache[3];
@@ -361,12 +634,9 @@ namespace
 #if COMPILE_WITH_DEV_ENV
     void OnShaderReloading(Asset* obj)
     {
-        DebugDrawPsLinesDefault.Release();
-        DebugDrawPsLinesDepthTest.Release();
-        DebugDrawPsWireTrianglesDefault.Release();
-        DebugDrawPsWireTrianglesDepthTest.Release();
-        DebugDrawPsTrianglesDefault.Release();
-        DebugDrawPsTrianglesDepthTest.Release();
+        DebugDrawPs.Release();
+        DebugDrawPsRetained.Release();
+        DebugDrawPsInstanced.Release();
     }
 
 #endif
@@ -392,12 +662,6 @@ int32 BoxLineIndicesCache[] =
     // @formatter:on
 };
 
-struct DebugDrawCall
-{
-    int32 StartVertex;
-    int32 VertexCount;
-};
-
 DebugDrawCall WriteList(int32& vertexCounter, const Array<Vertex>& list)
 {
     DebugDrawCall drawCall;
@@ -408,57 +672,220 @@ DebugDrawCall WriteList(int32& vertexCounter, const Array<Vertex>& list)
     return drawCall;
 }
 
-DebugDrawCall WriteList(int32& vertexCounter, const Array<DebugLine>& list)
+DebugDrawCall WriteList(int32& vertexCounter, const Array<DebugTriangle>& list)
+{
+    DebugDrawCall drawCall;
+    drawCall.StartVertex = vertexCounter;
+    drawCall.VertexCount = list.Count() * 3;
+    vertexCounter += drawCall.VertexCount;
+    Vertex* dst = DebugDrawVB->WriteReserve<Vertex>(list.Count() * 3);
+    for (int32 i = 0, j = 0; i < list.Count(); i++)
+    {
+        const DebugTriangle& l = list.Get()[i];
+        dst[j++] = { l.V0, l.Color };
+        dst[j++] = { l.V1, l.Color };
+        dst[j++] = { l.V2, l.Color };
+    }
+    return drawCall;
+}
+
+DebugDrawCall WriteRetainedList(DynamicVertexBuffer* vb, int32& vertexCounter, const Array<DebugLine>& list, float time)
 {
     DebugDrawCall drawCall;
     drawCall.StartVertex = vertexCounter;
     drawCall.VertexCount = list.Count() * 2;
     vertexCounter += drawCall.VertexCount;
-    Vertex* dst = DebugDrawVB->WriteReserve<Vertex>(list.Count() * 2);
+    RetainedVertex* dst = vb->WriteReserve<RetainedVertex>(list.Count() * 2);
     for (int32 i = 0, j = 0; i < list.Count(); i++)
     {
         const DebugLine& l = list.Get()[i];
-        dst[j++] = { l.Start, l.Color };
-        dst[j++] = { l.End, l.Color };
+        const float expireTime = time + l.TimeLeft;
+        dst[j++] = { l.Start, l.Color, expireTime };
+        dst[j++] = { l.End, l.Color, expireTime };
     }
     return drawCall;
 }
 
-DebugDrawCall WriteList(int32& vertexCounter, const Array<DebugTriangle>& list)
+DebugDrawCall WriteRetainedList(DynamicVertexBuffer* vb, int32& vertexCounter, const Array<DebugTriangle>& list, float time)
 {
     DebugDrawCall drawCall;
     drawCall.StartVertex = vertexCounter;
     drawCall.VertexCount = list.Count() * 3;
     vertexCounter += drawCall.VertexCount;
-    Vertex* dst = DebugDrawVB->WriteReserve<Vertex>(list.Count() * 3);
+    RetainedVertex* dst = vb->WriteReserve<RetainedVertex>(list.Count() * 3);
     for (int32 i = 0, j = 0; i < list.Count(); i++)
     {
         const DebugTriangle& l = list.Get()[i];
-        dst[j++] = { l.V0, l.Color };
-        dst[j++] = { l.V1, l.Color };
-        dst[j++] = { l.V2, l.Color };
+        const float expireTime = time + l.TimeLeft;
+        dst[j++] = { l.V0, l.Color, expireTime };
+        dst[j++] = { l.V1, l.Color, expireTime };
+        dst[j++] = { l.V2, l.Color, expireTime };
     }
     return drawCall;
 }
 
-template<typename T, typename U>
-DebugDrawCall WriteLists(int32& vertexCounter, const Array<T>& listA, const Array<U>& listB)
+DebugDrawCall WriteShapes(DynamicVertexBuffer* vb, int32& instanceCounter, const Array<DebugShape>& list, float time)
 {
-    const DebugDrawCall drawCallA = WriteList(vertexCounter, listA);
-    const DebugDrawCall drawCallB = WriteList(vertexCounter, listB);
     DebugDrawCall drawCall;
-    drawCall.StartVertex = drawCallA.StartVertex;
-    drawCall.VertexCount = drawCallA.VertexCount + drawCallB.VertexCount;
+    drawCall.StartVertex = instanceCounter;
+    drawCall.VertexCount = list.Count();
+    instanceCounter += drawCall.VertexCount;
+    ShapeInstance* dst = vb->WriteReserve<ShapeInstance>(list.Count());
+    for (int32 i = 0; i < list.Count(); i++)
+    {
+        const DebugShape& l = list.Get()[i];
+        dst[i] = { l.World, l.Color, time + l.TimeLeft };
+    }
     return drawCall;
 }
 
-FORCE_INLINE DebugTriangle* AppendTriangles(int32 count, float duration, bool depthTest)
+void DebugDrawData::UpdateRetained(GPUContext* context, float time)
+{
+    // Skip if nothing was added since the last upload (removed items are already hidden by the GPU), compact buffers once most of the items expired
+    const int32 count = RetainedCount();
+    if (!RetainedDirty && count == RetainedItems && RetainedItems * 2 >= RetainedUploaded)
+        return;
+    PROFILE_CPU_NAMED("Update Retained");
+    RetainedDirty = false;
+    RetainedItems = RetainedUploaded = count;
+    Retained = DebugDrawCalls();
+
+    // Lines and triangles
+    const int32 verticesCount = DefaultLines.Count() * 2 + (DefaultTriangles.Count() + DefaultWireTriangles.Count()) * 3;
+    if (verticesCount != 0)
+    {
+        if (RetainedVB == nullptr)
+            RetainedVB = New<DynamicVertexBuffer>(0u, (uint32)sizeof(RetainedVertex), TEXT("DebugDraw.RetainedVB"));
+        RetainedVB->Map(context, verticesCount * sizeof(RetainedVertex));
+        int32 vertexCounter = 0;
+        Retained.Lines = WriteRetainedList(RetainedVB, vertexCounter, DefaultLines, time);
+        Retained.Triangles = WriteRetainedList(RetainedVB, vertexCounter, DefaultTriangles, time);
+        Retained.WireTriangles = WriteRetainedList(RetainedVB, vertexCounter, DefaultWireTriangles, time);
+        RetainedVB->Unmap(context);
+    }
+
+    // Instanced shapes
+    const int32 instancesCount = DefaultShapesCount();
+    if (instancesCount != 0)
+    {
+        if (RetainedInstancesVB == nullptr)
+            RetainedInstancesVB = New<DynamicVertexBuffer>(0u, (uint32)sizeof(ShapeInstance), TEXT("DebugDraw.RetainedInstancesVB"));
+        RetainedInstancesVB->Map(context, instancesCount * sizeof(ShapeInstance));
+        int32 instanceCounter = 0;
+        for (int32 i = 0; i < DEBUG_DRAW_SHAPE_TYPES; i++)
+            Retained.Shapes[i] = WriteShapes(RetainedInstancesVB, instanceCounter, DefaultShapes[i], time);
+        RetainedInstancesVB->Unmap(context);
+    }
+}
+
+void DrawList(GPUContext* context, GPUPipelineState* state, GPUBuffer* vb, const DebugDrawCall& drawCall)
+{
+    context->SetState(state);
+    context->BindVB(ToSpan(&vb, 1));
+    context->Draw(drawCall.StartVertex, drawCall.VertexCount);
+}
+
+void DrawCalls(GPUContext* context, const DebugDrawCalls& drawCalls, DynamicVertexBuffer* vb, DynamicVertexBuffer* instancesVB, PsDataSet& ps, bool depthPass, bool enableDepthTest)
+{
+    // Lines
+    if (drawCalls.Lines.VertexCount)
+        DrawList(context, GetState(ps.LinesDefault, ps.LinesDepthTest, depthPass, enableDepthTest), vb->GetBuffer(), drawCalls.Lines);
+
+    // Shapes
+    for (int32 i = 0; i < DEBUG_DRAW_SHAPE_TYPES; i++)
+    {
+        const DebugDrawCall& drawCall = drawCalls.Shapes[i];
+        if (drawCall.VertexCount == 0)
+            continue;
+        GPUBuffer* vbs[2] = { DebugDrawShapesVB, instancesVB->GetBuffer() };
+        context->SetState(GetState(DebugDrawPsInstanced.LinesDefault, DebugDrawPsInstanced.LinesDepthTest, depthPass, enableDepthTest));
+        context->BindVB(ToSpan(vbs, 2));
+        context->DrawInstanced(ShapeMeshes[i].VertexCount, drawCall.VertexCount, drawCall.StartVertex, ShapeMeshes[i].StartVertex);
+    }
+
+    // Wire Triangles
+    if (drawCalls.WireTriangles.VertexCount)
+        DrawList(context, GetState(ps.WireTrianglesDefault, ps.WireTrianglesDepthTest, depthPass, enableDepthTest), vb->GetBuffer(), drawCalls.WireTriangles);
+
+    // Triangles
+    if (drawCalls.Triangles.VertexCount)
+        DrawList(context, GetState(ps.TrianglesDefault, ps.TrianglesDepthTest, depthPass, enableDepthTest), vb->GetBuffer(), drawCalls.Triangles);
+}
+
+DebugDrawThreadContext* GetThreadContext()
+{
+    DebugDrawThreadContext*& threadContext = ThreadContexts.Get();
+    if (threadContext == nullptr)
+    {
+        threadContext = New<DebugDrawThreadContext>();
+        ScopeLock lock(ThreadContextsLocker);
+        ThreadContextsList.Add(threadContext);
+    }
+    return threadContext;
+}
+
+void MergeThreadContexts(DebugDrawContext& target)
+{
+    ScopeLock lock(ThreadContextsLocker);
+    for (DebugDrawThreadContext* threadContext : ThreadContextsList)
+    {
+        ScopeLock threadLock(threadContext->Locker);
+        DebugDrawContext& source = threadContext->Context;
+        if (source.Origin != target.Origin)
+        {
+            // Move shapes to the target context origin
+            const Float3 delta = source.Origin - target.Origin;
+            source.DebugDrawDefault.Teleport(delta);
+            source.DebugDrawDepthTest.Teleport(delta);
+            source.Origin = target.Origin;
+        }
+        source.LastViewPos = target.LastViewPos;
+        source.LastViewProj = target.LastViewProj;
+        target.DebugDrawDefault.Append(source.DebugDrawDefault);
+        target.DebugDrawDepthTest.Append(source.DebugDrawDepthTest);
+    }
+}
+
+// Picks the debug shapes container for the calling thread. Main thread writes directly to the active context, other threads use own context (merged into the global context on the main thread).
+class DebugDrawContextScope
+{
+private:
+    DebugDrawThreadContext* _threadContext;
+
+public:
+    DebugDrawContext* Target;
+
+    DebugDrawContextScope()
+    {
+        if (IsInMainThread())
+        {
+            _threadContext = nullptr;
+            Target = Context;
+        }
+        else
+        {
+            _threadContext = GetThreadContext();
+            _threadContext->Locker.Lock();
+            Target = &_threadContext->Context;
+        }
+    }
+
+    ~DebugDrawContextScope()
+    {
+        if (_threadContext)
+            _threadContext->Locker.Unlock();
+    }
+};
+
+#define DEBUG_DRAW_CONTEXT() const DebugDrawContextScope contextScope; DebugDrawContext* const context = contextScope.Target
+
+FORCE_INLINE DebugTriangle* AppendTriangles(DebugDrawContext* context, int32 count, float duration, bool depthTest)
 {
     Array<DebugTriangle>* list;
     if (depthTest)
-        list = duration > 0 ? &Context->DebugDrawDepthTest.DefaultTriangles : &Context->DebugDrawDepthTest.OneFrameTriangles;
+        list = duration > 0 ? &context->DebugDrawDepthTest.DefaultTriangles : &context->DebugDrawDepthTest.OneFrameTriangles;
     else
-        list = duration > 0 ? &Context->DebugDrawDefault.DefaultTriangles : &Context->DebugDrawDefault.OneFrameTriangles;
+        list = duration > 0 ? &context->DebugDrawDefault.DefaultTriangles : &context->DebugDrawDefault.OneFrameTriangles;
     const int32 startIndex = list->Count();
     list->AddUninitialized(count);
     return list->Get() + startIndex;
@@ -613,8 +1040,8 @@ void DebugDrawService::Update()
     // Special case for Null renderer
     if (GPUDevice::Instance->GetRendererType() == RendererType::Null)
     {
-        GlobalContext.DebugDrawDefault.Clear();
-        GlobalContext.DebugDrawDepthTest.Clear();
+        MergeThreadContexts(GlobalContext);
+        GlobalContext.Clear();
         return;
     }
 
@@ -626,8 +1053,8 @@ void DebugDrawService::Update()
     if (!Editor::IsPlayMode)
         deltaTime = Time::Update.UnscaledDeltaTime.GetTotalSeconds();
 #endif
-    GlobalContext.DebugDrawDefault.Update(deltaTime);
-    GlobalContext.DebugDrawDepthTest.Update(deltaTime);
+    MergeThreadContexts(GlobalContext);
+    GlobalContext.Update(deltaTime);
 
     // Lazy-init resources
     if (DebugDrawShader == nullptr)
@@ -641,47 +1068,44 @@ void DebugDrawService::Update()
         DebugDrawShader->OnReloading.Bind(&OnShaderReloading);
 #endif
     }
-    if (DebugDrawPsWireTrianglesDepthTest.Depth == nullptr && DebugDrawShader && DebugDrawShader->IsLoaded())
+    if (DebugDrawPsInstanced.WireTrianglesDepthTest.Depth == nullptr && DebugDrawShader && DebugDrawShader->IsLoaded())
     {
-        bool failed = false;
-        const auto shader = DebugDrawShader->GetShader();
-
         // Create pipeline states
-        GPUPipelineState::Description desc = GPUPipelineState::Description::Default;
-        desc.BlendMode = BlendingMode::AlphaBlend;
-        desc.CullMode = CullMode::TwoSided;
-        desc.VS = shader->GetVS("VS");
-
-        // Default
-        desc.PS = shader->GetPS("PS", 0);
-        desc.PrimitiveTopology = PrimitiveTopologyType::Line;
-        failed |= DebugDrawPsLinesDefault.Create(desc);
-        desc.PS = shader->GetPS("PS", 1);
-        desc.PrimitiveTopology = PrimitiveTopologyType::Triangle;
-        failed |= DebugDrawPsTrianglesDefault.Create(desc);
-        desc.Wireframe = true;
-        failed |= DebugDrawPsWireTrianglesDefault.Create(desc);
-
-        // Depth Test
-        desc.Wireframe = false;
-        desc.PS = shader->GetPS("PS", 2);
-        desc.PrimitiveTopology = PrimitiveTopologyType::Line;
-        failed |= DebugDrawPsLinesDepthTest.Create(desc);
-        desc.PS = shader->GetPS("PS", 3);
-        desc.PrimitiveTopology = PrimitiveTopologyType::Triangle;
-        failed |= DebugDrawPsTrianglesDepthTest.Create(desc);
-        desc.Wireframe = true;
-        failed |= DebugDrawPsWireTrianglesDepthTest.Create(desc);
-
+        const auto shader = DebugDrawShader->GetShader();
+        bool failed = DebugDrawPs.Create(shader, shader->GetVS("VS"));
+        failed |= DebugDrawPsRetained.Create(shader, shader->GetVS("VS_Retained"));
+        failed |= DebugDrawPsInstanced.Create(shader, shader->GetVS("VS_Instanced"));
         if (failed)
         {
             LOG(Fatal, "Cannot setup DebugDraw service!");
         }
     }
 
-    // Vertex buffer
+    // Vertex buffers
     if (DebugDrawVB == nullptr)
         DebugDrawVB = New<DynamicVertexBuffer>((uint32)(DEBUG_DRAW_INITIAL_VB_CAPACITY * sizeof(Vertex)), (uint32)sizeof(Vertex), TEXT("DebugDraw.VB"));
+    if (DebugDrawInstancesVB == nullptr)
+        DebugDrawInstancesVB = New<DynamicVertexBuffer>(0u, (uint32)sizeof(ShapeInstance), TEXT("DebugDraw.InstancesVB"));
+    if (DebugDrawShapesVB == nullptr)
+    {
+        // Unit meshes of the instanced shapes
+        Array<Float3> vertices;
+        Vector3 corners[8];
+        BoundingBox(Vector3(-1.0f), Vector3(1.0f)).GetCorners(corners);
+        ShapeMeshes[(int32)DebugShapeType::WireBox] = { vertices.Count(), ARRAY_COUNT(BoxLineIndicesCache) };
+        for (uint32 i = 0; i < ARRAY_COUNT(BoxLineIndicesCache); i++)
+            vertices.Add(corners[BoxLineIndicesCache[i]]);
+        for (int32 lod = 0; lod < ARRAY_COUNT(SphereCache); lod++)
+        {
+            ShapeMeshes[(int32)DebugShapeType::WireSphereLOD0 + lod] = { vertices.Count(), SphereCache[lod].Vertices.Count() };
+            vertices.Add(SphereCache[lod].Vertices);
+        }
+        DebugDrawShapesVB = GPUDevice::Instance->CreateBuffer(TEXT("DebugDraw.ShapesVB"));
+        if (DebugDrawShapesVB->Init(GPUBufferDescription::Vertex(sizeof(Float3), vertices.Count(), vertices.Get())))
+        {
+            LOG(Fatal, "Cannot setup DebugDraw service!");
+        }
+    }
 }
 
 void DebugDrawService::Dispose()
@@ -689,16 +1113,19 @@ void DebugDrawService::Dispose()
     // Clear lists
     GlobalContext.DebugDrawDefault.Release();
     GlobalContext.DebugDrawDepthTest.Release();
+    ThreadContextsLocker.Lock();
+    ThreadContextsList.ClearDelete();
+    ThreadContexts.Clear();
+    ThreadContextsLocker.Unlock();
 
     // Release resources
     SphereTriangleCache.Resize(0);
-    DebugDrawPsLinesDefault.Release();
-    DebugDrawPsLinesDepthTest.Release();
-    DebugDrawPsWireTrianglesDefault.Release();
-    DebugDrawPsWireTrianglesDepthTest.Release();
-    DebugDrawPsTrianglesDefault.Release();
-    DebugDrawPsTrianglesDepthTest.Release();
+    DebugDrawPs.Release();
+    DebugDrawPsRetained.Release();
+    DebugDrawPsInstanced.Release();
     SAFE_DELETE(DebugDrawVB);
+    SAFE_DELETE(DebugDrawInstancesVB);
+    SAFE_DELETE_GPU_RESOURCE(DebugDrawShapesVB);
     DebugDrawShader = nullptr;
 }
 
@@ -722,8 +1149,7 @@ void DebugDraw::UpdateContext(void* context, float deltaTime)
 {
     if (!context)
         context = &GlobalContext;
-    ((DebugDrawContext*)context)->DebugDrawDefault.Update(deltaTime);
-    ((DebugDrawContext*)context)->DebugDrawDepthTest.Update(deltaTime);
+    ((DebugDrawContext*)context)->Update(deltaTime);
 }
 
 void DebugDraw::SetContext(void* context)
@@ -737,12 +1163,16 @@ void DebugDraw::Draw(RenderContext& renderContext, GPUTextureView* target, GPUTe
 {
     PROFILE_GPU_CPU("Debug Draw");
 
+    // Collect shapes submitted from the other threads
+    if (Context == &GlobalContext)
+        MergeThreadContexts(GlobalContext);
+
     // Ensure to have shader loaded and any lines to render
     const int32 debugDrawDepthTestCount = Context->DebugDrawDepthTest.Count();
     const int32 debugDrawDefaultCount = Context->DebugDrawDefault.Count();
-    if (DebugDrawShader == nullptr || !DebugDrawShader->IsLoaded() || debugDrawDepthTestCount + debugDrawDefaultCount == 0 || DebugDrawPsWireTrianglesDepthTest.Depth == nullptr)
+    if (DebugDrawShader == nullptr || !DebugDrawShader->IsLoaded() || debugDrawDepthTestCount + debugDrawDefaultCount == 0 || DebugDrawPsInstanced.WireTrianglesDepthTest.Depth == nullptr)
         return;
-    if (renderContext.Buffers == nullptr || !DebugDrawVB)
+    if (renderContext.Buffers == nullptr || !DebugDrawVB || !DebugDrawShapesVB)
         return;
     auto context = GPUDevice::Instance->GetMainContext();
     const RenderView& view = renderContext.View;
@@ -762,22 +1192,39 @@ void DebugDraw::Draw(RenderContext& renderContext, GPUTextureView* target, GPUTe
     if (target == nullptr && renderContext.Task)
         target = renderContext.Task->GetOutputView();
 
-    // Fill vertex buffer and upload data
-    DebugDrawCall depthTestLines, defaultLines, depthTestTriangles, defaultTriangles, depthTestWireTriangles, defaultWireTriangles;
+    // Fill vertex buffers and upload data
+    auto& depthTestData = Context->DebugDrawDepthTest;
+    auto& defaultData = Context->DebugDrawDefault;
+    DebugDrawCalls depthTestCalls, defaultCalls;
     {
         PROFILE_CPU_NAMED("Update Buffer");
-        DebugDrawVB->Clear();
+        const int32 verticesCount = depthTestData.OneFrameVerticesCount() + defaultData.OneFrameVerticesCount();
+        DebugDrawVB->Map(context, verticesCount * sizeof(Vertex));
         int32 vertexCounter = 0;
-        depthTestLines = WriteLists(vertexCounter, Context->DebugDrawDepthTest.DefaultLines, Context->DebugDrawDepthTest.OneFrameLines);
-        defaultLines = WriteLists(vertexCounter, Context->DebugDrawDefault.DefaultLines, Context->DebugDrawDefault.OneFrameLines);
-        depthTestTriangles = WriteLists(vertexCounter, Context->DebugDrawDepthTest.DefaultTriangles, Context->DebugDrawDepthTest.OneFrameTriangles);
-        defaultTriangles = WriteLists(vertexCounter, Context->DebugDrawDefault.DefaultTriangles, Context->DebugDrawDefault.OneFrameTriangles);
-        depthTestWireTriangles = WriteLists(vertexCounter, Context->DebugDrawDepthTest.DefaultWireTriangles, Context->DebugDrawDepthTest.OneFrameWireTriangles);
-        defaultWireTriangles = WriteLists(vertexCounter, Context->DebugDrawDefault.DefaultWireTriangles, Context->DebugDrawDefault.OneFrameWireTriangles);
+        depthTestCalls.Lines = WriteList(vertexCounter, depthTestData.OneFrameLines);
+        defaultCalls.Lines = WriteList(vertexCounter, defaultData.OneFrameLines);
+        depthTestCalls.Triangles = WriteList(vertexCounter, depthTestData.OneFrameTriangles);
+        defaultCalls.Triangles = WriteList(vertexCounter, defaultData.OneFrameTriangles);
+        depthTestCalls.WireTriangles = WriteList(vertexCounter, depthTestData.OneFrameWireTriangles);
+        defaultCalls.WireTriangles = WriteList(vertexCounter, defaultData.OneFrameWireTriangles);
+        const int32 instancesCount = depthTestData.OneFrameShapesCount() + defaultData.OneFrameShapesCount();
+        DebugDrawInstancesVB->Map(context, instancesCount * sizeof(ShapeInstance));
+        int32 instanceCounter = 0;
+        for (int32 i = 0; i < DEBUG_DRAW_SHAPE_TYPES; i++)
+        {
+            // One-frame shapes never expire on GPU
+            depthTestCalls.Shapes[i] = WriteShapes(DebugDrawInstancesVB, instanceCounter, depthTestData.OneFrameShapes[i], MAX_float);
+            defaultCalls.Shapes[i] = WriteShapes(DebugDrawInstancesVB, instanceCounter, defaultData.OneFrameShapes[i], MAX_float);
+        }
         {
             PROFILE_CPU_NAMED("Flush");
-            DebugDrawVB->Flush(context);
+            DebugDrawVB->Unmap(context);
+            DebugDrawInstancesVB->Unmap(context);
         }
+
+        // Persistent shapes are uploaded only after a change
+        depthTestData.UpdateRetained(context, Context->Time);
+        defaultData.UpdateRetained(context, Context->Time);
     }
 
     // Update constant buffer
@@ -786,80 +1233,35 @@ void DebugDraw::Draw(RenderContext& renderContext, GPUTextureView* target, GPUTe
     Matrix vp;
     Matrix::Multiply(view.View, view.Projection, vp);
     Matrix::Transpose(vp, data.ViewProjection);
+    data.Time = Context->Time;
+    data.Padding = 0.0f;
     data.ClipPosZBias = -0.2f; // Reduce Z-fighting artifacts (eg. editor grid)
     data.EnableDepthTest = enableDepthTest;
     context->UpdateCB(cb, &data);
     context->BindCB(0, cb);
-    auto vb = DebugDrawVB->GetBuffer();
 
     // Draw with depth test
-    if (depthTestLines.VertexCount + depthTestTriangles.VertexCount + depthTestWireTriangles.VertexCount > 0)
+    if (depthTestCalls.HasItems() || depthTestData.Retained.HasItems())
     {
         if (data.EnableDepthTest)
             context->BindSR(0, renderContext.Buffers->DepthBuffer);
-        const bool enableDepthWrite = data.EnableDepthTest;
 
         context->SetRenderTarget(depthBuffer ? depthBuffer : (data.EnableDepthTest ? nullptr : renderContext.Buffers->DepthBuffer->View()), target);
 
-        // Lines
-        if (depthTestLines.VertexCount)
-        {
-            auto state = data.EnableDepthTest ? &DebugDrawPsLinesDepthTest : &DebugDrawPsLinesDefault;
-            context->SetState(state->Get(enableDepthWrite, true));
-            context->BindVB(ToSpan(&vb, 1));
-            context->Draw(depthTestLines.StartVertex, depthTestLines.VertexCount);
-        }
-
-        // Wire Triangles
-        if (depthTestWireTriangles.VertexCount)
-        {
-            auto state = data.EnableDepthTest ? &DebugDrawPsWireTrianglesDepthTest : &DebugDrawPsWireTrianglesDefault;
-            context->SetState(state->Get(enableDepthWrite, true));
-            context->BindVB(ToSpan(&vb, 1));
-            context->Draw(depthTestWireTriangles.StartVertex, depthTestWireTriangles.VertexCount);
-        }
-
-        // Triangles
-        if (depthTestTriangles.VertexCount)
-        {
-            auto state = data.EnableDepthTest ? &DebugDrawPsTrianglesDepthTest : &DebugDrawPsTrianglesDefault;
-            context->SetState(state->Get(enableDepthWrite, true));
-            context->BindVB(ToSpan(&vb, 1));
-            context->Draw(depthTestTriangles.StartVertex, depthTestTriangles.VertexCount);
-        }
+        DrawCalls(context, depthTestCalls, DebugDrawVB, DebugDrawInstancesVB, DebugDrawPs, true, data.EnableDepthTest);
+        DrawCalls(context, depthTestData.Retained, depthTestData.RetainedVB, depthTestData.RetainedInstancesVB, DebugDrawPsRetained, true, data.EnableDepthTest);
 
         if (data.EnableDepthTest)
             context->UnBindSR(0);
     }
 
     // Draw without depth
-    if (defaultLines.VertexCount + defaultTriangles.VertexCount + defaultWireTriangles.VertexCount > 0)
+    if (defaultCalls.HasItems() || defaultData.Retained.HasItems())
     {
         context->SetRenderTarget(target);
 
-        // Lines
-        if (defaultLines.VertexCount)
-        {
-            context->SetState(DebugDrawPsLinesDefault.Get(false, false));
-            context->BindVB(ToSpan(&vb, 1));
-            context->Draw(defaultLines.StartVertex, defaultLines.VertexCount);
-        }
-
-        // Wire Triangles
-        if (defaultWireTriangles.VertexCount)
-        {
-            context->SetState(DebugDrawPsWireTrianglesDefault.Get(false, false));
-            context->BindVB(ToSpan(&vb, 1));
-            context->Draw(defaultWireTriangles.StartVertex, defaultWireTriangles.VertexCount);
-        }
-
-        // Triangles
-        if (defaultTriangles.VertexCount)
-        {
-            context->SetState(DebugDrawPsTrianglesDefault.Get(false, false));
-            context->BindVB(ToSpan(&vb, 1));
-            context->Draw(defaultTriangles.StartVertex, defaultTriangles.VertexCount);
-        }
+        DrawCalls(context, defaultCalls, DebugDrawVB, DebugDrawInstancesVB, DebugDrawPs, false, false);
+        DrawCalls(context, defaultData.Retained, defaultData.RetainedVB, defaultData.RetainedInstancesVB, DebugDrawPsRetained, false, false);
     }
 
     // Text
@@ -985,8 +1387,9 @@ void DebugDraw::DrawRay(const Ray& ray, const Color& color, float length, float
 
 void DebugDraw::DrawLine(const Vector3& start, const Vector3& end, const Color& color, float duration, bool depthTest)
 {
-    const Float3 startF = start - Context->Origin, endF = end - Context->Origin;
-    auto& debugDrawData = depthTest ? Context->DebugDrawDepthTest : Context->DebugDrawDefault;
+    DEBUG_DRAW_CONTEXT();
+    const Float3 startF = start - context->Origin, endF = end - context->Origin;
+    auto& debugDrawData = depthTest ? context->DebugDrawDepthTest : context->DebugDrawDefault;
     if (duration > 0)
     {
         DebugLine l = { startF, endF, Color32(color), duration };
@@ -1003,8 +1406,9 @@ void DebugDraw::DrawLine(const Vector3& start, const Vector3& end, const Color&
 
 void DebugDraw::DrawLine(const Vector3& start, const Vector3& end, const Color& startColor, const Color& endColor, float duration, bool depthTest)
 {
-    const Float3 startF = start - Context->Origin, endF = end - Context->Origin;
-    auto& debugDrawData = depthTest ? Context->DebugDrawDepthTest : Context->DebugDrawDefault;
+    DEBUG_DRAW_CONTEXT();
+    const Float3 startF = start - context->Origin, endF = end - context->Origin;
+    auto& debugDrawData = depthTest ? context->DebugDrawDepthTest : context->DebugDrawDefault;
     if (duration > 0)
     {
         // TODO: separate start/end colors for persistent lines
@@ -1032,9 +1436,10 @@ void DebugDraw::DrawLines(const Span<Float3>& lines, const Matrix& transform, co
     }
 
     // Draw lines
+    DEBUG_DRAW_CONTEXT();
     const Float3* p = lines.Get();
-    auto& debugDrawData = depthTest ? Context->DebugDrawDepthTest : Context->DebugDrawDefault;
-    const Matrix transformF = transform * Matrix::Translation(-Context->Origin);
+    auto& debugDrawData = depthTest ? context->DebugDrawDepthTest : context->DebugDrawDefault;
+    const Matrix transformF = transform * Matrix::Translation(-context->Origin);
     if (duration > 0)
     {
         DebugLine l = { Float3::Zero, Float3::Zero, Color32(color), duration };
@@ -1076,9 +1481,10 @@ void DebugDraw::DrawLines(const Span<Double3>& lines, const Matrix& transform, c
     }
 
     // Draw lines
+    DEBUG_DRAW_CONTEXT();
     const Double3* p = lines.Get();
-    auto& debugDrawData = depthTest ? Context->DebugDrawDepthTest : Context->DebugDrawDefault;
-    const Matrix transformF = transform * Matrix::Translation(-Context->Origin);
+    auto& debugDrawData = depthTest ? context->DebugDrawDepthTest : context->DebugDrawDefault;
+    const Matrix transformF = transform * Matrix::Translation(-context->Origin);
     if (duration > 0)
     {
         DebugLine l = { Float3::Zero, Float3::Zero, Color32(color), duration };
@@ -1111,7 +1517,8 @@ void DebugDraw::DrawLines(const Array<Double3, HeapAllocation>& lines, const Mat
 
 void DebugDraw::DrawBezier(const Vector3& p1, const Vector3& p2, const Vector3& p3, const Vector3& p4, const Color& color, float duration, bool depthTest)
 {
-    const Float3 p1F = p1 - Context->Origin, p2F = p2 - Context->Origin, p3F = p3 - Context->Origin, p4F = p4 - Context->Origin;
+    DEBUG_DRAW_CONTEXT();
+    const Float3 p1F = p1 - context->Origin, p2F = p2 - context->Origin, p3F = p3 - context->Origin, p4F = p4 - context->Origin;
 
     // Find amount of segments to use
     const Float3 d1 = p2F - p1F;
@@ -1122,7 +1529,7 @@ void DebugDraw::DrawBezier(const Vector3& p1, const Vector3& p2, const Vector3&
     const float segmentCountInv = 1.0f / (float)segmentCount;
 
     // Draw segmented curve from lines
-    auto& debugDrawData = depthTest ? Context->DebugDrawDepthTest : Context->DebugDrawDefault;
+    auto& debugDrawData = depthTest ? context->DebugDrawDepthTest : context->DebugDrawDefault;
     if (duration > 0)
     {
         DebugLine l = { p1F, Float3::Zero, Color32(color), duration };
@@ -1155,48 +1562,28 @@ void DebugDraw::DrawBezier(const Vector3& p1, const Vector3& p2, const Vector3&
 
 void DebugDraw::DrawWireBox(const BoundingBox& box, const Color& color, float duration, bool depthTest)
 {
-    // Get corners
-    Vector3 corners[8];
-    box.GetCorners(corners);
-    for (Vector3& c : corners)
-        c -= Context->Origin;
+    DEBUG_DRAW_CONTEXT();
 
-    // Draw lines
-    auto& debugDrawData = depthTest ? Context->DebugDrawDepthTest : Context->DebugDrawDefault;
-    if (duration > 0)
-    {
-        DebugLine l = { Float3::Zero, Float3::Zero, Color32(color), duration };
-        for (uint32 i = 0; i < ARRAY_COUNT(BoxLineIndicesCache);)
-        {
-            l.Start = corners[BoxLineIndicesCache[i++]];
-            l.End = corners[BoxLineIndicesCache[i++]];
-            debugDrawData.DefaultLines.Add(l);
-        }
-    }
-    else
-    {
-        // TODO: draw lines as strips to reuse vertices with a single draw call
-        Vertex l = { Float3::Zero, Color32(color) };
-        for (uint32 i = 0; i < ARRAY_COUNT(BoxLineIndicesCache);)
-        {
-            l.Position = corners[BoxLineIndicesCache[i++]];
-            debugDrawData.OneFrameLines.Add(l);
-            l.Position = corners[BoxLineIndicesCache[i++]];
-            debugDrawData.OneFrameLines.Add(l);
-        }
-    }
+    // Draw unit box after linear transform
+    const Float3 centerF = box.GetCenter() - context->Origin;
+    const Float3 extentsF = box.GetSize() * 0.5f;
+    const Matrix world = Matrix::Scaling(extentsF) * Matrix::Translation(centerF);
+    auto& debugDrawData = depthTest ? context->DebugDrawDepthTest : context->DebugDrawDefault;
+    debugDrawData.AddShape(DebugShapeType::WireBox, world, color, duration);
 }
 
 void DebugDraw::DrawWireFrustum(const BoundingFrustum& frustum, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
+
     // Get corners
     Vector3 corners[8];
     frustum.GetCorners(corners);
     for (Vector3& c : corners)
-        c -= Context->Origin;
+        c -= context->Origin;
 
     // Draw lines
-    auto& debugDrawData = depthTest ? Context->DebugDrawDepthTest : Context->DebugDrawDefault;
+    auto& debugDrawData = depthTest ? context->DebugDrawDepthTest : context->DebugDrawDefault;
     if (duration > 0)
     {
         DebugLine l = { Float3::Zero, Float3::Zero, Color32(color), duration };
@@ -1223,92 +1610,55 @@ void DebugDraw::DrawWireFrustum(const BoundingFrustum& frustum, const Color& col
 
 void DebugDraw::DrawWireBox(const OrientedBoundingBox& box, const Color& color, float duration, bool depthTest)
 {
-    // Get corners
-    Vector3 corners[8];
-    box.GetCorners(corners);
-    for (Vector3& c : corners)
-        c -= Context->Origin;
+    DEBUG_DRAW_CONTEXT();
 
-    // Draw lines
-    auto& debugDrawData = depthTest ? Context->DebugDrawDepthTest : Context->DebugDrawDefault;
-    if (duration > 0)
-    {
-        DebugLine l = { Float3::Zero, Float3::Zero, Color32(color), duration };
-        for (uint32 i = 0; i < ARRAY_COUNT(BoxLineIndicesCache);)
-        {
-            l.Start = corners[BoxLineIndicesCache[i++]];
-            l.End = corners[BoxLineIndicesCache[i++]];
-            debugDrawData.DefaultLines.Add(l);
-        }
-    }
-    else
-    {
-        // TODO: draw lines as strips to reuse vertices with a single draw call
-        Vertex l = { Float3::Zero, Color32(color) };
-        for (uint32 i = 0; i < ARRAY_COUNT(BoxLineIndicesCache);)
-        {
-            l.Position = corners[BoxLineIndicesCache[i++]];
-            debugDrawData.OneFrameLines.Add(l);
-            l.Position = corners[BoxLineIndicesCache[i++]];
-            debugDrawData.OneFrameLines.Add(l);
-        }
-    }
+    // Draw unit box after linear transform
+    Transform transform = box.Transformation;
+    transform.Translation -= context->Origin;
+    Matrix transformWorld;
+    transform.GetWorld(transformWorld);
+    const Matrix world = Matrix::Scaling(Float3(box.Extents)) * transformWorld;
+    auto& debugDrawData = depthTest ? context->DebugDrawDepthTest : context->DebugDrawDefault;
+    debugDrawData.AddShape(DebugShapeType::WireBox, world, color, duration);
 }
 
 void DebugDraw::DrawWireSphere(const BoundingSphere& sphere, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
+
     // Select LOD
-    int32 index;
-    const Float3 centerF = sphere.Center - Context->Origin;
+    DebugShapeType type;
+    const Float3 centerF = sphere.Center - context->Origin;
     const float radiusF = (float)sphere.Radius;
-    const float screenRadiusSquared = RenderTools::ComputeBoundsScreenRadiusSquared(centerF, radiusF, Context->LastViewPos, Context->LastViewProj);
+    const float screenRadiusSquared = RenderTools::ComputeBoundsScreenRadiusSquared(centerF, radiusF, context->LastViewPos, context->LastViewProj);
     if (screenRadiusSquared > DEBUG_DRAW_SPHERE_LOD0_SCREEN_SIZE * DEBUG_DRAW_SPHERE_LOD0_SCREEN_SIZE * 0.25f)
-        index = 0;
+        type = DebugShapeType::WireSphereLOD0;
     else if (screenRadiusSquared > DEBUG_DRAW_SPHERE_LOD1_SCREEN_SIZE * DEBUG_DRAW_SPHERE_LOD1_SCREEN_SIZE * 0.25f)
-        index = 1;
+        type = DebugShapeType::WireSphereLOD1;
     else
-        index = 2;
-    auto& cache = SphereCache[index];
+        type = DebugShapeType::WireSphereLOD2;
 
-    // Draw lines of the unit sphere after linear transform
-    auto& debugDrawData = depthTest ? Context->DebugDrawDepthTest : Context->DebugDrawDefault;
-    if (duration > 0)
-    {
-        DebugLine l = { Float3::Zero, Float3::Zero, Color32(color), duration };
-        for (int32 i = 0; i < cache.Vertices.Count();)
-        {
-            l.Start = centerF + cache.Vertices.Get()[i++] * radiusF;
-            l.End = centerF + cache.Vertices.Get()[i++] * radiusF;
-            debugDrawData.DefaultLines.Add(l);
-        }
-    }
-    else
-    {
-        Vertex l = { Float3::Zero, Color32(color) };
-        for (int32 i = 0; i < cache.Vertices.Count();)
-        {
-            l.Position = centerF + cache.Vertices.Get()[i++] * radiusF;
-            debugDrawData.OneFrameLines.Add(l);
-            l.Position = centerF + cache.Vertices.Get()[i++] * radiusF;
-            debugDrawData.OneFrameLines.Add(l);
-        }
-    }
+    // Draw unit sphere after linear transform
+    const Matrix world = Matrix::Scaling(radiusF) * Matrix::Translation(centerF);
+    auto& debugDrawData = depthTest ? context->DebugDrawDepthTest : context->DebugDrawDefault;
+    debugDrawData.AddShape(type, world, color, duration);
 }
 
 void DebugDraw::DrawSphere(const BoundingSphere& sphere, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     DebugTriangle t;
     t.Color = Color32(color);
     t.TimeLeft = duration;
 
     Array<DebugTriangle>* list;
     if (depthTest)
-        list = duration > 0 ? &Context->DebugDrawDepthTest.DefaultTriangles : &Context->DebugDrawDepthTest.OneFrameTriangles;
+        list = duration > 0 ? &context->DebugDrawDepthTest.DefaultTriangles : &context->DebugDrawDepthTest.OneFrameTriangles;
     else
-        list = duration > 0 ? &Context->DebugDrawDefault.DefaultTriangles : &Context->DebugDrawDefault.OneFrameTriangles;
+        list = duration > 0 ? &context->DebugDrawDefault.DefaultTriangles : &context->DebugDrawDefault.OneFrameTriangles;
     list->EnsureCapacity(list->Count() + SphereTriangleCache.Count());
 
-    const Float3 centerF = sphere.Center - Context->Origin;
+    const Float3 centerF = sphere.Center - context->Origin;
     const float radiusF = (float)sphere.Radius;
     for (int32 i = 0; i < SphereTriangleCache.Count();)
     {
@@ -1321,6 +1671,8 @@ void DebugDraw::DrawSphere(const BoundingSphere& sphere, const Color& color, flo
 
 void DebugDraw::DrawCircle(const Vector3& position, const Float3& normal, float radius, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
+
     // Create matrix transform for unit circle points
     Matrix world, scale, matrix;
     Float3 right, up;
@@ -1332,13 +1684,13 @@ void DebugDraw::DrawCircle(const Vector3& position, const Float3& normal, float
         Float3::Cross(normal, Float3::Up, right);
     Float3::Cross(right, normal, up);
     Matrix::Scaling(radius, scale);
-    const Float3 positionF = position - Context->Origin;
+    const Float3 positionF = position - context->Origin;
     Matrix::CreateWorld(positionF, normal, up, world);
     Matrix::Multiply(scale, world, matrix);
 
     // Draw lines of the unit circle after linear transform
     Float3 prev = Float3::Transform(CircleCache[0], matrix);
-    auto& debugDrawData = depthTest ? Context->DebugDrawDepthTest : Context->DebugDrawDefault;
+    auto& debugDrawData = depthTest ? context->DebugDrawDepthTest : context->DebugDrawDefault;
     for (int32 i = 1; i < DEBUG_DRAW_CIRCLE_VERTICES;)
     {
         Float3 cur = Float3::Transform(CircleCache[i++], matrix);
@@ -1367,26 +1719,28 @@ void DebugDraw::DrawWireTriangle(const Vector3& v0, const Vector3& v1, const Vec
 
 void DebugDraw::DrawTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     DebugTriangle t;
     t.Color = Color32(color);
     t.TimeLeft = duration;
-    t.V0 = v0 - Context->Origin;
-    t.V1 = v1 - Context->Origin;
-    t.V2 = v2 - Context->Origin;
+    t.V0 = v0 - context->Origin;
+    t.V1 = v1 - context->Origin;
+    t.V2 = v2 - context->Origin;
     if (depthTest)
-        Context->DebugDrawDepthTest.Add(t);
+        context->DebugDrawDepthTest.Add(t);
     else
-        Context->DebugDrawDefault.Add(t);
+        context->DebugDrawDefault.Add(t);
 }
 
 void DebugDraw::DrawTriangles(const Span<Float3>& vertices, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     CHECK(vertices.Length() % 3 == 0);
     DebugTriangle t;
     t.Color = Color32(color);
     t.TimeLeft = duration;
-    auto dst = AppendTriangles(vertices.Length() / 3, duration, depthTest);
-    const Float3 origin = Context->Origin;
+    auto dst = AppendTriangles(context, vertices.Length() / 3, duration, depthTest);
+    const Float3 origin = context->Origin;
     for (int32 i = 0; i < vertices.Length();)
     {
         t.V0 = vertices.Get()[i++] - origin;
@@ -1398,12 +1752,13 @@ void DebugDraw::DrawTriangles(const Span<Float3>& vertices, const Color& color,
 
 void DebugDraw::DrawTriangles(const Span<Float3>& vertices, const Matrix& transform, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     CHECK(vertices.Length() % 3 == 0);
     DebugTriangle t;
     t.Color = Color32(color);
     t.TimeLeft = duration;
-    auto dst = AppendTriangles(vertices.Length() / 3, duration, depthTest);
-    const Matrix transformF = transform * Matrix::Translation(-Context->Origin);
+    auto dst = AppendTriangles(context, vertices.Length() / 3, duration, depthTest);
+    const Matrix transformF = transform * Matrix::Translation(-context->Origin);
     for (int32 i = 0; i < vertices.Length();)
     {
         Float3::Transform(vertices.Get()[i++], transformF, t.V0);
@@ -1425,12 +1780,13 @@ void DebugDraw::DrawTriangles(const Array<Float3>& vertices, const Matrix& trans
 
 void DebugDraw::DrawTriangles(const Span<Float3>& vertices, const Span<int32>& indices, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     CHECK(indices.Length() % 3 == 0);
     DebugTriangle t;
     t.Color = Color32(color);
     t.TimeLeft = duration;
-    auto dst = AppendTriangles(indices.Length() / 3, duration, depthTest);
-    const Float3 origin = Context->Origin;
+    auto dst = AppendTriangles(context, indices.Length() / 3, duration, depthTest);
+    const Float3 origin = context->Origin;
     for (int32 i = 0; i < indices.Length();)
     {
         t.V0 = vertices[indices.Get()[i++]] - origin;
@@ -1442,12 +1798,13 @@ void DebugDraw::DrawTriangles(const Span<Float3>& vertices, const Span<int32>& i
 
 void DebugDraw::DrawTriangles(const Span<Float3>& vertices, const Span<int32>& indices, const Matrix& transform, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     CHECK(indices.Length() % 3 == 0);
     DebugTriangle t;
     t.Color = Color32(color);
     t.TimeLeft = duration;
-    auto dst = AppendTriangles(indices.Length() / 3, duration, depthTest);
-    const Matrix transformF = transform * Matrix::Translation(-Context->Origin);
+    auto dst = AppendTriangles(context, indices.Length() / 3, duration, depthTest);
+    const Matrix transformF = transform * Matrix::Translation(-context->Origin);
     for (int32 i = 0; i < indices.Length();)
     {
         Float3::Transform(vertices[indices.Get()[i++]], transformF, t.V0);
@@ -1469,12 +1826,13 @@ void DebugDraw::DrawTriangles(const Array<Float3>& vertices, const Array<int32,
 
 void DebugDraw::DrawTriangles(const Span<Double3>& vertices, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     CHECK(vertices.Length() % 3 == 0);
     DebugTriangle t;
     t.Color = Color32(color);
     t.TimeLeft = duration;
-    auto dst = AppendTriangles(vertices.Length() / 3, duration, depthTest);
-    const Double3 origin = Context->Origin;
+    auto dst = AppendTriangles(context, vertices.Length() / 3, duration, depthTest);
+    const Double3 origin = context->Origin;
     for (int32 i = 0; i < vertices.Length();)
     {
         t.V0 = vertices.Get()[i++] - origin;
@@ -1486,12 +1844,13 @@ void DebugDraw::DrawTriangles(const Span<Double3>& vertices, const Color& color,
 
 void DebugDraw::DrawTriangles(const Span<Double3>& vertices, const Matrix& transform, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     CHECK(vertices.Length() % 3 == 0);
     DebugTriangle t;
     t.Color = Color32(color);
     t.TimeLeft = duration;
-    auto dst = AppendTriangles(vertices.Length() / 3, duration, depthTest);
-    const Matrix transformF = transform * Matrix::Translation(-Context->Origin);
+    auto dst = AppendTriangles(context, vertices.Length() / 3, duration, depthTest);
+    const Matrix transformF = transform * Matrix::Translation(-context->Origin);
     for (int32 i = 0; i < vertices.Length();)
     {
         Float3::Transform(vertices.Get()[i++], transformF, t.V0);
@@ -1513,12 +1872,13 @@ void DebugDraw::DrawTriangles(const Array<Double3>& vertices, const Matrix& tran
 
 void DebugDraw::DrawTriangles(const Span<Double3>& vertices, const Span<int32>& indices, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     CHECK(indices.Length() % 3 == 0);
     DebugTriangle t;
     t.Color = Color32(color);
     t.TimeLeft = duration;
-    auto dst = AppendTriangles(indices.Length() / 3, duration, depthTest);
-    const Double3 origin = Context->Origin;
+    auto dst = AppendTriangles(context, indices.Length() / 3, duration, depthTest);
+    const Double3 origin = context->Origin;
     for (int32 i = 0; i < indices.Length();)
     {
         t.V0 = vertices[indices.Get()[i++]] - origin;
@@ -1530,12 +1890,13 @@ void DebugDraw::DrawTriangles(const Span<Double3>& vertices, const Span<int32>&
 
 void DebugDraw::DrawTriangles(const Span<Double3>& vertices, const Span<int32>& indices, const Matrix& transform, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     CHECK(indices.Length() % 3 == 0);
     DebugTriangle t;
     t.Color = Color32(color);
     t.TimeLeft = duration;
-    auto dst = AppendTriangles(indices.Length() / 3, duration, depthTest);
-    const Matrix transformF = transform * Matrix::Translation(-Context->Origin);
+    auto dst = AppendTriangles(context, indices.Length() / 3, duration, depthTest);
+    const Matrix transformF = transform * Matrix::Translation(-context->Origin);
     for (int32 i = 0; i < indices.Length();)
     {
         Float3::Transform(vertices[indices.Get()[i++]], transformF, t.V0);
@@ -1557,12 +1918,13 @@ void DebugDraw::DrawTriangles(const Array<Double3>& vertices, const Array<int32,
 
 void DebugDraw::DrawWireTriangles(const Span<Float3>& vertices, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     CHECK(vertices.Length() % 3 == 0);
     DebugTriangle t;
     t.Color = Color32(color);
     t.TimeLeft = duration;
-    auto dst = AppendTriangles(vertices.Length() / 3, duration, depthTest);
-    const Float3 origin = Context->Origin;
+    auto dst = AppendTriangles(context, vertices.Length() / 3, duration, depthTest);
+    const Float3 origin = context->Origin;
     for (int32 i = 0; i < vertices.Length();)
     {
         t.V0 = vertices.Get()[i++] - origin;
@@ -1579,12 +1941,13 @@ void DebugDraw::DrawWireTriangles(const Array<Float3>& vertices, const Color& co
 
 void DebugDraw::DrawWireTriangles(const Span<Float3>& vertices, const Span<int32>& indices, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     CHECK(indices.Length() % 3 == 0);
     DebugTriangle t;
     t.Color = Color32(color);
     t.TimeLeft = duration;
-    auto dst = AppendTriangles(indices.Length() / 3, duration, depthTest);
-    const Float3 origin = Context->Origin;
+    auto dst = AppendTriangles(context, indices.Length() / 3, duration, depthTest);
+    const Float3 origin = context->Origin;
     for (int32 i = 0; i < indices.Length();)
     {
         t.V0 = vertices[indices.Get()[i++]] - origin;
@@ -1601,12 +1964,13 @@ void DebugDraw::DrawWireTriangles(const Array<Float3>& vertices, const Array<int
 
 void DebugDraw::DrawWireTriangles(const Span<Double3>& vertices, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     CHECK(vertices.Length() % 3 == 0);
     DebugTriangle t;
     t.Color = Color32(color);
     t.TimeLeft = duration;
-    auto dst = AppendTriangles(vertices.Length() / 3, duration, depthTest);
-    const Double3 origin = Context->Origin;
+    auto dst = AppendTriangles(context, vertices.Length() / 3, duration, depthTest);
+    const Double3 origin = context->Origin;
     for (int32 i = 0; i < vertices.Length();)
     {
         t.V0 = vertices.Get()[i++] - origin;
@@ -1623,12 +1987,13 @@ void DebugDraw::DrawWireTriangles(const Array<Double3>& vertices, const Color& c
 
 void DebugDraw::DrawWireTriangles(const Span<Double3>& vertices, const Span<int32>& indices, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     CHECK(indices.Length() % 3 == 0);
     DebugTriangle t;
     t.Color = Color32(color);
     t.TimeLeft = duration;
-    auto dst = AppendTriangles(indices.Length() / 3, duration, depthTest);
-    const Double3 origin = Context->Origin;
+    auto dst = AppendTriangles(context, indices.Length() / 3, duration, depthTest);
+    const Double3 origin = context->Origin;
     for (int32 i = 0; i < indices.Length();)
     {
         t.V0 = vertices[indices.Get()[i++]] - origin;
@@ -1664,6 +2029,8 @@ void DebugDraw::DrawTube(const Vector3& position, const Quaternion& orientation,
 
 void DebugDraw::DrawWireTube(const Vector3& position, const Quaternion& orientation, float radius, float length, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
+
     // Check if has no length (just sphere)
     if (length < ZeroTolerance)
     {
@@ -1679,12 +2046,12 @@ void DebugDraw::DrawWireTube(const Vector3& position, const Quaternion& orientat
         const float halfLength = length / 2.0f;
         Matrix rotation, translation, world;
         Matrix::RotationQuaternion(orientation, rotation);
-        const Float3 positionF = position - Context->Origin;
+        const Float3 positionF = position - context->Origin;
         Matrix::Translation(positionF, translation);
         Matrix::Multiply(rotation, translation, world);
 
         // Write vertices
-        auto& debugDrawData = depthTest ? Context->DebugDrawDepthTest : Context->DebugDrawDefault;
+        auto& debugDrawData = depthTest ? context->DebugDrawDepthTest : context->DebugDrawDefault;
         Color32 color32(color);
         if (duration > 0)
         {
@@ -1775,7 +2142,7 @@ void DebugDraw::DrawWireTube(const Vector3& position, const Quaternion& orientat
 
 namespace
 {
-    void DrawCylinder(Array<DebugTriangle>* list, const Vector3& position, const Quaternion& orientation, float radius, float height, const Color& color, float duration)
+    void DrawCylinder(DebugDrawContext* context, Array<DebugTriangle>* list, const Vector3& position, const Quaternion& orientation, float radius, float height, const Color& color, float duration)
     {
         // Setup cache
         Float3 CylinderCache[DEBUG_DRAW_CYLINDER_VERTICES];
@@ -1804,7 +2171,7 @@ namespace
         DebugTriangle t;
         t.Color = Color32(color);
         t.TimeLeft = duration;
-        const Float3 positionF = position - Context->Origin;
+        const Float3 positionF = position - context->Origin;
         const Matrix world = Matrix::RotationQuaternion(orientation) * Matrix::Translation(positionF);
 
         // Write triangles
@@ -1847,7 +2214,7 @@ namespace
         }
     }
 
-    void DrawCone(Array<DebugTriangle>* list, const Vector3& position, const Quaternion& orientation, float radius, float angleXY, float angleXZ, const Color& color, float duration)
+    void DrawCone(DebugDrawContext* context, Array<DebugTriangle>* list, const Vector3& position, const Quaternion& orientation, float radius, float angleXY, float angleXZ, const Color& color, float duration)
     {
         const float tolerance = 0.001f;
         const float angle1 = Math::Clamp(angleXY, tolerance, PI - tolerance);
@@ -1861,7 +2228,7 @@ namespace
         DebugTriangle t;
         t.Color = Color32(color);
         t.TimeLeft = duration;
-        const Float3 positionF = position - Context->Origin;
+        const Float3 positionF = position - context->Origin;
         const Matrix world = Matrix::RotationQuaternion(orientation) * Matrix::Translation(positionF);
         t.V0 = world.GetTranslation();
 
@@ -1896,42 +2263,46 @@ namespace
 
 void DebugDraw::DrawCylinder(const Vector3& position, const Quaternion& orientation, float radius, float height, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     Array<DebugTriangle>* list;
     if (depthTest)
-        list = duration > 0 ? &Context->DebugDrawDepthTest.DefaultTriangles : &Context->DebugDrawDepthTest.OneFrameTriangles;
+        list = duration > 0 ? &context->DebugDrawDepthTest.DefaultTriangles : &context->DebugDrawDepthTest.OneFrameTriangles;
     else
-        list = duration > 0 ? &Context->DebugDrawDefault.DefaultTriangles : &Context->DebugDrawDefault.OneFrameTriangles;
-    ::DrawCylinder(list, position, orientation, radius, height, color, duration);
+        list = duration > 0 ? &context->DebugDrawDefault.DefaultTriangles : &context->DebugDrawDefault.OneFrameTriangles;
+    ::DrawCylinder(context, list, position, orientation, radius, height, color, duration);
 }
 
 void DebugDraw::DrawWireCylinder(const Vector3& position, const Quaternion& orientation, float radius, float height, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     Array<DebugTriangle>* list;
     if (depthTest)
-        list = duration > 0 ? &Context->DebugDrawDepthTest.DefaultWireTriangles : &Context->DebugDrawDepthTest.OneFrameWireTriangles;
+        list = duration > 0 ? &context->DebugDrawDepthTest.DefaultWireTriangles : &context->DebugDrawDepthTest.OneFrameWireTriangles;
     else
-        list = duration > 0 ? &Context->DebugDrawDefault.DefaultWireTriangles : &Context->DebugDrawDefault.OneFrameWireTriangles;
-    ::DrawCylinder(list, position, orientation, radius, height, color, duration);
+        list = duration > 0 ? &context->DebugDrawDefault.DefaultWireTriangles : &context->DebugDrawDefault.OneFrameWireTriangles;
+    ::DrawCylinder(context, list, position, orientation, radius, height, color, duration);
 }
 
 void DebugDraw::DrawCone(const Vector3& position, const Quaternion& orientation, float radius, float angleXY, float angleXZ, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     Array<DebugTriangle>* list;
     if (depthTest)
-        list = duration > 0 ? &Context->DebugDrawDepthTest.DefaultTriangles : &Context->DebugDrawDepthTest.OneFrameTriangles;
+        list = duration > 0 ? &context->DebugDrawDepthTest.DefaultTriangles : &context->DebugDrawDepthTest.OneFrameTriangles;
     else
-        list = duration > 0 ? &Context->DebugDrawDefault.DefaultTriangles : &Context->DebugDrawDefault.OneFrameTriangles;
-    ::DrawCone(list, position, orientation, radius, angleXY, angleXZ, color, duration);
+        list = duration > 0 ? &context->DebugDrawDefault.DefaultTriangles : &context->DebugDrawDefault.OneFrameTriangles;
+    ::DrawCone(context, list, position, orientation, radius, angleXY, angleXZ, color, duration);
 }
 
 void DebugDraw::DrawWireCone(const Vector3& position, const Quaternion& orientation, float radius, float angleXY, float angleXZ, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
     Array<DebugTriangle>* list;
     if (depthTest)
-        list = duration > 0 ? &Context->DebugDrawDepthTest.DefaultWireTriangles : &Context->DebugDrawDepthTest.OneFrameWireTriangles;
+        list = duration > 0 ? &context->DebugDrawDepthTest.DefaultWireTriangles : &context->DebugDrawDepthTest.OneFrameWireTriangles;
     else
-        list = duration > 0 ? &Context->DebugDrawDefault.DefaultWireTriangles : &Context->DebugDrawDefault.OneFrameWireTriangles;
-    ::DrawCone(list, position, orientation, radius, angleXY, angleXZ, color, duration);
+        list = duration > 0 ? &context->DebugDrawDefault.DefaultWireTriangles : &context->DebugDrawDefault.OneFrameWireTriangles;
+    ::DrawCone(context, list, position, orientation, radius, angleXY, angleXZ, color, duration);
 }
 
 void DebugDraw::DrawArc(const Vector3& position, const Quaternion& orientation, float radius, float angle, const Color& color, float duration, bool depthTest)
@@ -1940,14 +2311,15 @@ void DebugDraw::DrawArc(const Vector3& position, const Quaternion& orientation,
         return;
     if (angle > TWO_PI)
         angle = TWO_PI;
+    DEBUG_DRAW_CONTEXT();
     Array<DebugTriangle>* list;
     if (depthTest)
-        list = duration > 0 ? &Context->DebugDrawDepthTest.DefaultTriangles : &Context->DebugDrawDepthTest.OneFrameTriangles;
+        list = duration > 0 ? &context->DebugDrawDepthTest.DefaultTriangles : &context->DebugDrawDepthTest.OneFrameTriangles;
     else
-        list = duration > 0 ? &Context->DebugDrawDefault.DefaultTriangles : &Context->DebugDrawDefault.OneFrameTriangles;
+        list = duration > 0 ? &context->DebugDrawDefault.DefaultTriangles : &context->DebugDrawDefault.OneFrameTriangles;
     const int32 resolution = Math::CeilToInt((float)DEBUG_DRAW_CONE_RESOLUTION / TWO_PI * angle);
     const float angleStep = angle / (float)resolution;
-    const Float3 positionF = position - Context->Origin;
+    const Float3 positionF = position - context->Origin;
     const Matrix world = Matrix::RotationQuaternion(orientation) * Matrix::Translation(positionF);
     float currentAngle = 0.0f;
     DebugTriangle t;
@@ -1972,9 +2344,10 @@ void DebugDraw::DrawWireArc(const Vector3& position, const Quaternion& orientati
         return;
     if (angle > TWO_PI)
         angle = TWO_PI;
+    DEBUG_DRAW_CONTEXT();
     const int32 resolution = Math::CeilToInt((float)DEBUG_DRAW_CONE_RESOLUTION / TWO_PI * angle);
     const float angleStep = angle / (float)resolution;
-    const Float3 positionF = position - Context->Origin;
+    const Float3 positionF = position - context->Origin;
     const Matrix world = Matrix::RotationQuaternion(orientation) * Matrix::Translation(positionF);
     float currentAngle = 0.0f;
     Float3 prevPos(world.GetTranslation());
@@ -2014,11 +2387,13 @@ void DebugDraw::DrawWireArrow(const Vector3& position, const Quaternion& orienta
 
 void DebugDraw::DrawBox(const BoundingBox& box, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
+
     // Get corners
     Vector3 corners[8];
     box.GetCorners(corners);
     for (Vector3& c : corners)
-        c -= Context->Origin;
+        c -= context->Origin;
 
     // Draw triangles
     DebugTriangle t;
@@ -2026,9 +2401,9 @@ void DebugDraw::DrawBox(const BoundingBox& box, const Color& color, float durati
     t.TimeLeft = duration;
     Array<DebugTriangle>* list;
     if (depthTest)
-        list = duration > 0 ? &Context->DebugDrawDepthTest.DefaultTriangles : &Context->DebugDrawDepthTest.OneFrameTriangles;
+        list = duration > 0 ? &context->DebugDrawDepthTest.DefaultTriangles : &context->DebugDrawDepthTest.OneFrameTriangles;
     else
-        list = duration > 0 ? &Context->DebugDrawDefault.DefaultTriangles : &Context->DebugDrawDefault.OneFrameTriangles;
+        list = duration > 0 ? &context->DebugDrawDefault.DefaultTriangles : &context->DebugDrawDefault.OneFrameTriangles;
     list->EnsureCapacity(list->Count() + 36);
     for (int i0 = 0; i0 < 36;)
     {
@@ -2042,11 +2417,13 @@ void DebugDraw::DrawBox(const BoundingBox& box, const Color& color, float durati
 
 void DebugDraw::DrawBox(const OrientedBoundingBox& box, const Color& color, float duration, bool depthTest)
 {
+    DEBUG_DRAW_CONTEXT();
+
     // Get corners
     Vector3 corners[8];
     box.GetCorners(corners);
     for (Vector3& c : corners)
-        c -= Context->Origin;
+        c -= context->Origin;
 
     // Draw triangles
     DebugTriangle t;
@@ -2054,9 +2431,9 @@ void DebugDraw::DrawBox(const OrientedBoundingBox& box, const Color& color, floa
     t.TimeLeft = duration;
     Array<DebugTriangle>* list;
     if (depthTest)
-        list = duration > 0 ? &Context->DebugDrawDepthTest.DefaultTriangles : &Context->DebugDrawDepthTest.OneFrameTriangles;
+        list = duration > 0 ? &context->DebugDrawDepthTest.DefaultTriangles : &context->DebugDrawDepthTest.OneFrameTriangles;
     else
-        list = duration > 0 ? &Context->DebugDrawDefault.DefaultTriangles : &Context->DebugDrawDefault.OneFrameTriangles;
+        list = duration > 0 ? &context->DebugDrawDefault.DefaultTriangles : &context->DebugDrawDefault.OneFrameTriangles;
     list->EnsureCapacity(list->Count() + 36);
     for (int i0 = 0; i0 < 36;)
     {
@@ -2072,7 +2449,8 @@ void DebugDraw::DrawText(const StringView& text, const Float2& position, const C
 {
     if (text.Length() == 0 || size < 4)
         return;
-    Array<DebugText2D>* list = duration > 0 ? &Context->DebugDrawDefault.DefaultText2D : &Context->DebugDrawDefault.OneFrameText2D;
+    DEBUG_DRAW_CONTEXT();
+    Array<DebugText2D>* list = duration > 0 ? &context->DebugDrawDefault.DefaultText2D : &context->DebugDrawDefault.OneFrameText2D;
     auto& t = list->AddOne();
     t.Text.Resize(text.Length() + 1);
     Platform::MemoryCopy(t.Text.Get(), text.Get(), text.Length() * sizeof(Char));
@@ -2087,12 +2465,13 @@ void DebugDraw::DrawText(const StringView& text, const Vector3& position, const
 {
     if (text.Length() == 0 || size < 4)
         return;
-    Array<DebugText3D>* list = duration > 0 ? &Context->DebugDrawDefault.DefaultText3D : &Context->DebugDrawDefault.OneFrameText3D;
+    DEBUG_DRAW_CONTEXT();
+    Array<DebugText3D>* list = duration > 0 ? &context->DebugDrawDefault.DefaultText3D : &context->DebugDrawDefault.OneFrameText3D;
     auto& t = list->AddOne();
     t.Text.Resize(text.Length() + 1);
     Platform::MemoryCopy(t.Text.Get(), text.Get(), text.Length() * sizeof(Char));
     t.Text[text.Length()] = 0;
-    t.Transform = position - Context->Origin;
+    t.Transform = position - context->Origin;
     t.Transform.Scale.X = scale;
     t.FaceCamera = true;
     t.Size = size;
@@ -2104,13 +2483,14 @@ void DebugDraw::DrawText(const StringView& text, const Transform& transform, con
 {
     if (text.Length() == 0 || size < 4)
         return;
-    Array<DebugText3D>* list = duration > 0 ? &Context->DebugDrawDefault.DefaultText3D : &Context->DebugDrawDefault.OneFrameText3D;
+    DEBUG_DRAW_CONTEXT();
+    Array<DebugText3D>* list = duration > 0 ? &context->DebugDrawDefault.DefaultText3D : &context->DebugDrawDefault.OneFrameText3D;
     auto& t = list->AddOne();
     t.Text.Resize(text.Length() + 1);
     Platform::MemoryCopy(t.Text.Get(), text.Get(), text.Length() * sizeof(Char));
     t.Text[text.Length()] = 0;
     t.Transform = transform;
-    t.Transform.Translation -= Context->Origin;
+    t.Transform.Translation -= context->Origin;
     t.FaceCamera = false;
     t.Size = size;
     t.Color = color;
@@ -18,6 +18,7 @@ struct Transform;
 
 /// <summary>
 /// The debug shapes rendering service. Not available in final game. For use only in the editor.
+/// Shapes can be drawn from job threads too (they are collected into per-thread buffers and merged into the global context on the main thread).
 /// </summary>
 API_CLASS(Static) class FLAXENGINE_API DebugDraw
 {
@@ -145,6 +145,18 @@ bool CommandLine::Parse(const Char* cmdLine)
     PARSE_BOOL_SWITCH("-monolog ", MonoLog);
     PARSE_BOOL_SWITCH("-mute ", Mute);
     PARSE_BOOL_SWITCH("-lowdpi ", LowDPI);
+    PARSE_ARG_SWITCH("-jobthreads ", JobThreads);
+    PARSE_BOOL_SWITCH("-jobsmt ", JobSMT);
+    PARSE_BOOL_SWITCH("-nojobsmt ", NoJobSMT);
+    PARSE_BOOL_SWITCH("-jobefficiencycores ", JobEfficiencyCores);
+    PARSE_BOOL_SWITCH("-nojobaffinity ", NoJobAffinity);
+    PARSE_BOOL_SWITCH("-recordshaders ", RecordShaders);
+    PARSE_BOOL_SWITCH("-memprofiler ", MemoryProfiler);
+    PARSE_ARG_SWITCH("-telemetry ", Telemetry);
+#if !BUILD_RELEASE
+    PARSE_ARG_SWITCH("-animbenchmark ", AnimBenchmark);
+    PARSE_ARG_SWITCH("-benchmarks ", Benchmarks);
+#endif
 
 #if USE_EDITOR
 
@@ -156,6 +168,7 @@ bool CommandLine::Parse(const Char* cmdLine)
     PARSE_ARG_SWITCH("-build ", Build);
     PARSE_BOOL_SWITCH("-skipcompile ", SkipCompile);
     PARSE_BOOL_SWITCH("-shaderdebug ", ShaderDebug);
+    PARSE_ARG_SWITCH("-shadercache ", ShaderCache);
     PARSE_ARG_OPT_SWITCH("-play ", Play);
 
 #endif
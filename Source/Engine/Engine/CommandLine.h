@@ -127,6 +127,56 @@ class CommandLine
         /// </summary>
         Nullable<bool> LowDPI;
 
+        /// <summary>
+        /// -jobthreads !count! (overrides the amount of Job System worker threads)
+        /// </summary>
+        Nullable<String> JobThreads;
+
+        /// <summary>
+        /// -jobsmt (allows Job System worker threads to run on SMT/Hyper-Threading sibling processors)
+        /// </summary>
+        Nullable<bool> JobSMT;
+
+        /// <summary>
+        /// -nojobsmt (uses a single Job System worker thread per physical core)
+        /// </summary>
+        Nullable<bool> NoJobSMT;
+
+        /// <summary>
+        /// -jobefficiencycores (allows Job System worker threads to run on efficiency cores of hybrid CPUs)
+        /// </summary>
+        Nullable<bool> JobEfficiencyCores;
+
+        /// <summary>
+        /// -nojobaffinity (disables pinning Job System worker threads to the logical processors)
+        /// </summary>
+        Nullable<bool> NoJobAffinity;
+
+        /// <summary>
+        /// -recordshaders (records used shader permutations into ShadersUsage.txt for cook-time variant stripping, non-release builds only)
+        /// </summary>
+        Nullable<bool> RecordShaders;
+
+        /// <summary>
+        /// -memprofiler (enables the native memory allocations tracking per engine subsystem from the startup, profiler builds only)
+        /// </summary>
+        Nullable<bool> MemoryProfiler;
+
+        /// <summary>
+        /// -telemetry !path! (records the per-frame performance telemetry and hitch captures to the file from the startup, profiler builds only)
+        /// </summary>
+        Nullable<String> Telemetry;
+
+        /// <summary>
+        /// -animbenchmark !config! (runs the headless animation benchmark and exits, eg. "count=256,bones=64,depth=2,frames=300,output=AnimBenchmark.json", non-release builds only)
+        /// </summary>
+        Nullable<String> AnimBenchmark;
+
+        /// <summary>
+        /// -benchmarks !config! (configures the benchmarks runner of the FlaxBenchmarks target, eg. "filter=Collections,runs=20,warmup=2,output=Benchmarks.json,baseline=BenchmarksBaseline.json,threshold=10", non-release builds only)
+        /// </summary>
+        Nullable<String> Benchmarks;
+
 #if USE_EDITOR
 
         /// <summary>
@@ -169,6 +219,11 @@ class CommandLine
         /// </summary>
         Nullable<bool> ShaderDebug;
 
+        /// <summary>
+        /// -shadercache !path! (shared shaders compilation cache folder, eg. network directory used by the build machines and other editors)
+        /// </summary>
+        Nullable<String> ShaderCache;
+
         /// <summary>
         /// -play !guid! ( Scene to play, can be empty to use default )
         /// </summary>
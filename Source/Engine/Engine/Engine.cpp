@@ -11,10 +11,15 @@
 #include "Engine/Core/Core.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/ObjectsRemovalService.h"
+#include "Engine/Core/Memory/FrameAllocation.h"
+#if USE_POOL_ALLOCATOR
+#include "Engine/Core/Memory/PoolAllocator.h"
+#endif
 #include "Engine/Core/Types/String.h"
 #include "Engine/Platform/Platform.h"
 #include "Engine/Platform/Window.h"
 #include "Engine/Platform/FileSystem.h"
+#include "Engine/Level/Level.h"
 #include "Engine/Physics/Physics.h"
 #include "Engine/Threading/Threading.h"
 #include "Engine/Threading/MainThreadTask.h"
@@ -84,6 +89,10 @@ int32 Engine::Main(const Char* cmdLine)
         Platform::Fatal(TEXT("Invalid command line."));
         return -1;
     }
+#if COMPILE_WITH_PROFILER
+    if (CommandLine::Options.MemoryProfiler.IsTrue())
+        ProfilerMemory::Enabled = true;
+#endif
 
 #if FLAX_TESTS
     // Configure engine for test running environment
@@ -163,6 +172,9 @@ int32 Engine::Main(const Char* cmdLine)
     const bool useSleep = true; // TODO: this should probably be a platform setting
     while (!ShouldExit())
     {
+        // Recycle transient memory of the oldest frame
+        FrameAllocator::NewFrame();
+
         // Reduce CPU usage by introducing idle time if the engine is running very fast and has enough time to spend
         if ((useSleep && Time::UpdateFPS > ZeroTolerance) || !Platform::GetHasFocus())
         {
@@ -260,6 +272,9 @@ void Engine::OnFixedUpdate()
 {
     PROFILE_CPU_NAMED("Fixed Update");
 
+    // Finish the previous async simulation step (if there was no game update since then)
+    Physics::CollectResults();
+
     Physics::FlushRequests();
 
     // Call event
@@ -268,6 +283,9 @@ void Engine::OnFixedUpdate()
     // Update services
     EngineService::OnFixedUpdate();
 
+    // Apply deferred actors transformations before the physics simulation
+    Level::FlushTransforms();
+
     if (!Time::GetGamePaused())
     {
         const float dt = Time::Physics.DeltaTime.GetTotalSeconds();
@@ -289,7 +307,9 @@ void Engine::OnLateFixedUpdate()
     EngineService::OnLateFixedUpdate();
 
     // Collect physics simulation results (does nothing if Simulate hasn't been called in the previous loop step)
-    Physics::CollectResults();
+    // Async simulation runs during the frame rendering and gets collected before the next game update
+    if (!Physics::AsyncSimulation)
+        Physics::CollectResults();
 }
 
 void Engine::OnUpdate()
@@ -320,6 +340,9 @@ void Engine::OnUpdate()
     // Simulate lags
     //Platform::Sleep(100);
 
+    // Collect async physics simulation results from the previous frame
+    Physics::CollectResults();
+
     MainThreadTask::RunAll(Time::Update.UnscaledDeltaTime.GetTotalSeconds());
 
     // Call event
@@ -345,6 +368,9 @@ void Engine::OnDraw()
 {
     PROFILE_CPU_NAMED("Draw");
 
+    // Apply deferred actors transformations before the rendering
+    Level::FlushTransforms();
+
     // Begin frame rendering
     FrameCount++;
     const double time = Platform::GetTimeSeconds();
@@ -502,6 +528,11 @@ void Engine::OnExit()
     // Close logging service
     Log::Logger::Dispose();
 
+#if USE_POOL_ALLOCATOR
+    // Return memory cached by the main thread to the shared pools
+    PoolAllocator::FlushThreadCache();
+#endif
+
     Platform::Exit();
 }
 
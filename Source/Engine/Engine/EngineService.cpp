@@ -4,6 +4,7 @@
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Threading/JobSystem.h"
 #include <ThirdParty/tracy/tracy/Tracy.hpp>
 
 static bool CompareEngineServices(EngineService* const& a, EngineService* const& b)
@@ -65,16 +66,10 @@ bool EngineService::Init()
     return false;
 }
 
-void EngineService::OnInit()
+namespace
 {
-    ZoneScoped;
-    Sort();
-
-    // Init services from front to back
-    auto& services = GetServices();
-    for (int32 i = 0; i < services.Count(); i++)
+    bool InitService(EngineService* service, float& timeMs)
     {
-        const auto service = services[i];
         const StringView name(service->Name);
 #if TRACY_ENABLE
         ZoneScoped;
@@ -88,14 +83,75 @@ void EngineService::OnInit()
         ZoneName(nameBuffer, nameBufferLength);
 #endif
         LOG(Info, "Initialize {0}...", name);
-        service->IsInitialized = true;
-        if (service->Init())
+        const double startTime = Platform::GetTimeSeconds();
+        const bool failed = service->Init();
+        timeMs = (float)((Platform::GetTimeSeconds() - startTime) * 1000.0);
+        return failed;
+    }
+}
+
+void EngineService::OnInit()
+{
+    ZoneScoped;
+    Sort();
+    const double startTime = Platform::GetTimeSeconds();
+
+    // Init services from front to back
+    auto& services = GetServices();
+    while (true)
+    {
+        // Pick the next services to init (new services can be registered during the other services init, eg. from loaded plugins)
+        int32 i = 0;
+        while (i < services.Count() && services[i]->IsInitialized)
+            i++;
+        if (i == services.Count())
+            break;
+
+        // Services with the same order don't depend on each other so the ones with parallel init enabled can run on job threads while main thread initializes the others
+        const int32 order = services[i]->Order;
+        EngineServicesArray group, parallel;
+        for (; i < services.Count() && services[i]->Order == order; i++)
+        {
+            const auto service = services[i];
+            if (service->IsInitialized)
+                continue;
+            service->IsInitialized = true;
+            if (service->ParallelInit && JobSystem::GetThreadsCount() > 0)
+                parallel.Add(service);
+            else
+                group.Add(service);
+        }
+        int64 parallelLabel = 0;
+        volatile int64 parallelFailed = 0;
+        if (parallel.HasItems())
         {
-            Platform::Fatal(String::Format(TEXT("Failed to initialize {0}."), name));
+            parallelLabel = JobSystem::Dispatch([&](int32 j)
+            {
+                if (InitService(parallel[j], parallel[j]->InitTime))
+                    Platform::AtomicStore(&parallelFailed, j + 1);
+            }, parallel.Count());
+        }
+        for (const auto service : group)
+        {
+            if (InitService(service, service->InitTime))
+                Platform::Fatal(String::Format(TEXT("Failed to initialize {0}."), service->Name));
+        }
+        if (parallel.HasItems())
+        {
+            JobSystem::Wait(parallelLabel);
+            const int64 failed = Platform::AtomicRead(&parallelFailed);
+            if (failed != 0)
+                Platform::Fatal(String::Format(TEXT("Failed to initialize {0}."), parallel[(int32)failed - 1]->Name));
         }
     }
 
-    LOG(Info, "Engine services are ready!");
+    // Log the slowest services to track the startup time
+    for (int32 i = 0; i < services.Count(); i++)
+    {
+        if (services[i]->InitTime >= 1.0f)
+            LOG(Info, "{0} initialization took {1} ms", services[i]->Name, Math::RoundToInt(services[i]->InitTime));
+    }
+    LOG(Info, "Engine services are ready in {0} ms!", Math::RoundToInt((float)((Platform::GetTimeSeconds() - startTime) * 1000.0)));
 }
 
 void EngineService::Dispose()
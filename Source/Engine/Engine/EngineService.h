@@ -27,6 +27,7 @@ class EngineService
 private:
 
     bool IsInitialized = false;
+    float InitTime = 0.0f;
 
 protected:
 
@@ -39,6 +40,11 @@ class EngineService
     const Char* Name;
     int32 Order;
 
+    /// <summary>
+    /// True if the service initialization can run on a job thread, in parallel to the initialization of the other services with the same order. Services with lower order are the dependencies (always initialized before). Init has to be thread-safe and independent from the other services with the same order (eg. mustn't use main-thread-only systems like windows, graphics device or COM which is initialized only on the main thread).
+    /// </summary>
+    bool ParallelInit = false;
+
 #define DECLARE_ENGINE_SERVICE_EVENT(result, name) virtual result name(); static void On##name();
     DECLARE_ENGINE_SERVICE_EVENT(bool, Init);
     DECLARE_ENGINE_SERVICE_EVENT(void, FixedUpdate);
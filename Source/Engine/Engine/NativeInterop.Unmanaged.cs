@@ -451,6 +451,20 @@ internal static ManagedHandle GetCustomAttribute(ManagedHandle typeHandle, Manag
             return new ManagedHandle();
         }
 
+        [UnmanagedCallersOnly]
+        internal static byte TypeHasCustomAttribute(ManagedHandle typeHandle, ManagedHandle attributeHandle)
+        {
+            // Check the attributes metadata to skip creating the attribute objects (used during assembly loading)
+            Type type = Unsafe.As<TypeHolder>(typeHandle.Target);
+            Type attributeType = Unsafe.As<TypeHolder>(attributeHandle.Target);
+            foreach (var attributeData in type.GetCustomAttributesData())
+            {
+                if (attributeData.AttributeType == attributeType)
+                    return 1;
+            }
+            return 0;
+        }
+
         [UnmanagedCallersOnly]
         internal static void GetClassInterfaces(ManagedHandle typeHandle, IntPtr* classInterfaces, int* classInterfacesCount)
         {
@@ -1633,20 +1633,21 @@ private static Type[] GetAssemblyTypes(Assembly assembly)
         {
             var referencedAssemblies = assembly.GetReferencedAssemblies();
             var allAssemblies = Utils.GetAssemblies();
-            var referencedTypes = new List<string>();
+            var referencedTypes = new HashSet<string>();
             foreach (var assemblyName in referencedAssemblies)
             {
                 var asm = allAssemblies.FirstOrDefault(x => x.GetName().Name == assemblyName.Name);
                 if (asm == null)
                     continue;
-                referencedTypes.AddRange(asm.DefinedTypes.Select(x => x.FullName).ToArray());
+                foreach (var type in asm.DefinedTypes)
+                    referencedTypes.Add(type.FullName);
             }
 
             // TODO: use MetadataReader to read types without loading any of the referenced assemblies?
             // https://makolyte.com/csharp-get-a-list-of-types-defined-in-an-assembly-without-loading-it/
 
             // We need private types of this assembly too, DefinedTypes contains a lot of types from other assemblies...
-            var types = referencedTypes.Any() ? assembly.DefinedTypes.Where(x => !referencedTypes.Contains(x.FullName)).ToArray() : assembly.DefinedTypes.ToArray();
+            var types = referencedTypes.Count != 0 ? assembly.DefinedTypes.Where(x => !referencedTypes.Contains(x.FullName)).ToArray() : assembly.DefinedTypes.ToArray();
 
             Assert.IsTrue(Utils.GetAssemblies().Count(x => x.GetName().Name == "FlaxEngine.CSharp") == 1);
             return types;
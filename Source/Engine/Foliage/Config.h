@@ -24,3 +24,9 @@ struct FoliageInstance;
 
 // Size of the cluster container for instances
 #define FOLIAGE_CLUSTER_CAPACITY (64)
+
+// Maximum amount of procedural foliage tiles generated during a single update (the closest tiles go first)
+#define FOLIAGE_PROCEDURAL_MAX_TILES_PER_UPDATE (16)
+
+// Maximum amount of procedural foliage instances of a single type within a single tile
+#define FOLIAGE_PROCEDURAL_MAX_TILE_INSTANCES (100000)
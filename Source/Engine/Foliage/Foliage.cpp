@@ -5,6 +5,8 @@
 #include "FoliageCluster.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Random.h"
+#include "Engine/Core/RandomStream.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Graphics/RenderTask.h"
 #if !FOLIAGE_USE_SINGLE_QUAD_TREE
@@ -12,15 +14,25 @@
 #if FOLIAGE_USE_DRAW_CALLS_BATCHING
 #include "Engine/Graphics/RenderTools.h"
 #include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/Graphics.h"
 #include "Engine/Renderer/RenderList.h"
+#include "Engine/Renderer/OcclusionCullingPass.h"
+#include "Engine/Renderer/Utils/InstanceCulling.h"
 #endif
 #endif
 #include "Engine/Level/SceneQuery.h"
+#include "Engine/Level/Actors/Camera.h"
+#include "Engine/Terrain/Terrain.h"
+#include "Engine/Terrain/TerrainPatch.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Renderer/GlobalSignDistanceFieldPass.h"
 #include "Engine/Renderer/GI/GlobalSurfaceAtlasPass.h"
 #include "Engine/Serialization/Serialization.h"
 #include "Engine/Utilities/Encryption.h"
+#include "Engine/Utilities/Noise.h"
+#if USE_EDITOR
+#include "Editor/Editor.h"
+#endif
 
 #define FOLIAGE_GET_DRAW_MODES(renderContext, type) (type.DrawModes & renderContext.View.Pass & renderContext.View.GetShadowsDrawPassMask(type.ShadowsMode))
 #define FOLIAGE_CAN_DRAW(renderContext, type) (type.IsReady() && FOLIAGE_GET_DRAW_MODES(renderContext, type) != DrawPass::None && type.Model->CanBeRendered())
@@ -141,6 +153,16 @@ void Foliage::DrawCluster(RenderContext& renderContext, FoliageCluster* cluster,
     if (Float3::Distance(renderContext.View.Position, cluster->TotalBoundsSphere.Center - viewOrigin) - (float)cluster->TotalBoundsSphere.Radius > cluster->MaxCullDistance)
         return;
 
+    // Skip clusters occluded in the previous frames
+    if (OcclusionCullingData* occlusion = renderContext.List->Occlusion)
+    {
+        BoundingSphere sphere = cluster->TotalBoundsSphere;
+        sphere.Center -= viewOrigin;
+        occlusion->AddQuery(cluster, sphere);
+        if (occlusion->IsOccluded(cluster))
+            return;
+    }
+
     //DebugDraw::DrawBox(cluster->Bounds, Color::Red);
 
     // Draw visible children
@@ -270,6 +292,16 @@ void Foliage::DrawCluster(RenderContext& renderContext, FoliageCluster* cluster,
     if (Float3::Distance(renderContext.View.Position, cluster->TotalBoundsSphere.Center - viewOrigin) - (float)cluster->TotalBoundsSphere.Radius > cluster->MaxCullDistance)
         return;
 
+    // Skip clusters occluded in the previous frames
+    if (OcclusionCullingData* occlusion = renderContext.List->Occlusion)
+    {
+        BoundingSphere sphere = cluster->TotalBoundsSphere;
+        sphere.Center -= viewOrigin;
+        occlusion->AddQuery(cluster, sphere);
+        if (occlusion->IsOccluded(cluster))
+            return;
+    }
+
     //DebugDraw::DrawBox(cluster->Bounds, Color::Red);
 
     // Draw visible children
@@ -398,10 +430,170 @@ void Foliage::DrawClusterGlobalSA(GlobalSurfaceAtlasPass* globalSA, const Vector
     }
 }
 
+bool Foliage::DrawTypeGPU(RenderContext& renderContext, FoliageType& type, DrawCallsList* drawCallsLists, DrawPass typeDrawModes)
+{
+    const auto model = type.Model.Get();
+    const int32 lodsCount = model->LODs.Count();
+    if (lodsCount > MODEL_MAX_LODS)
+        return true;
+
+    // Sync the persistent instances (uploaded to the GPU only when modified)
+    if (type._gpuInstancesDirty || !type._gpuInstances)
+    {
+        PROFILE_CPU_NAMED("Update GPU Instances");
+        if (!type._gpuInstances)
+            type._gpuInstances = New<InstanceCullingBuffers>();
+        auto& buffers = *type._gpuInstances;
+        buffers.Instances.Clear();
+        buffers.Bounds.Clear();
+        buffers.Origin = _transform.Translation;
+        buffers.IsDirty = true;
+        type._gpuInstancesDirty = 0;
+        type._gpuInstancesLightmap = INVALID_INDEX;
+        type._gpuInstancesRadius = 0.0f;
+        bool firstInstance = true;
+        for (auto i = type.Clusters.Begin(); i.IsNotEnd(); ++i)
+        {
+            for (FoliageInstance* instancePtr : i->Instances)
+            {
+                const FoliageInstance& instance = *instancePtr;
+                if (firstInstance)
+                    type._gpuInstancesLightmap = instance.Lightmap.TextureIndex;
+                else if (type._gpuInstancesLightmap != instance.Lightmap.TextureIndex)
+                    type._gpuInstancesLightmap = -2; // Instances use different lightmaps so can't be drawn within a single draw
+                firstInstance = false;
+                Matrix world;
+                const Transform transform = _transform.LocalToWorld(instance.Transform);
+                const Float3 translation = transform.Translation - buffers.Origin;
+                Matrix::Transformation(transform.Scale, transform.Orientation, translation, world);
+                auto& instanceData = buffers.Instances.AddOne();
+                instanceData.InstanceOrigin = Float3(world.M41, world.M42, world.M43);
+                instanceData.PerInstanceRandom = instance.Random;
+                instanceData.InstanceTransform1 = Float3(world.M11, world.M12, world.M13);
+                instanceData.LODDitherFactor = 0.0f;
+                instanceData.InstanceTransform2 = Float3(world.M21, world.M22, world.M23);
+                instanceData.InstanceTransform3 = Float3(world.M31, world.M32, world.M33);
+                instanceData.InstanceLightmapArea = Half4(instance.Lightmap.UVsArea);
+                auto& bounds = buffers.Bounds.AddOne();
+                bounds.Center = instance.Bounds.Center - buffers.Origin;
+                bounds.Radius = (float)instance.Bounds.Radius;
+                bounds.CullDistance = instance.CullDistance;
+                type._gpuInstancesRadius = Math::Max(type._gpuInstancesRadius, bounds.Radius);
+            }
+        }
+    }
+    auto& buffers = *type._gpuInstances;
+    if (buffers.Instances.IsEmpty())
+        return false;
+    if (type._gpuInstancesLightmap == -2)
+        return true;
+
+    // Skip if the whole foliage type is too far or outside the view
+    const Vector3 viewOrigin = renderContext.View.Origin;
+    BoundingBox box = type.Root->TotalBounds;
+    box.Minimum -= viewOrigin;
+    box.Maximum -= viewOrigin;
+    const Vector3 closestPoint = CollisionsHelper::ClosestPointBoxPoint(box, renderContext.View.Position);
+    if (Vector3::Distance(closestPoint, renderContext.View.Position) > type.Root->MaxCullDistance ||
+        !renderContext.View.CullingFrustum.Intersects(box))
+        return false;
+
+    // Mark the model as used by the closest instance for the streaming (LOD is selected per-instance on a GPU)
+    if (RenderTools::ComputeModelLOD(model, closestPoint, type._gpuInstancesRadius, renderContext) == -1)
+        return false;
+    if (renderContext.List->Occlusion)
+        renderContext.List->Occlusion->RequestHZB();
+
+    // Setup draw indirect arguments for every LOD mesh (geometry may be relocated so update it every frame)
+    const int32 instancesCount = buffers.Instances.Count();
+    buffers.DrawArgs.Clear();
+    for (int32 lod = 0; lod < lodsCount; lod++)
+    {
+        const auto& meshes = model->LODs.Get()[lod].Meshes;
+        for (int32 meshIndex = 0; meshIndex < meshes.Count(); meshIndex++)
+        {
+            DrawCall drawCall;
+            meshes.Get()[meshIndex].GetDrawCallGeometry(drawCall);
+            auto& args = buffers.DrawArgs.AddOne();
+            args.IndicesCount = drawCall.Draw.IndicesCount;
+            args.InstanceCount = 0;
+            args.StartIndex = drawCall.Draw.StartIndex;
+            args.StartVertex = 0;
+            args.StartInstance = lod * instancesCount;
+        }
+    }
+
+    // Add the culling job for this view
+    InstanceCullingJob job;
+    job.Buffers = &buffers;
+    job.MinScreenSizeSq = Math::Square(model->MinScreenSize * 0.5f);
+    for (int32 lod = 0; lod < lodsCount; lod++)
+        job.LODScreenSizesSq[lod] = Math::Square(model->LODs.Get()[lod].ScreenSize * 0.5f);
+    job.LODsCount = lodsCount;
+    job.LODBias = renderContext.View.ModelLODBias;
+    job.MinLOD = model->HighestResidentLODIndex();
+    job.CulledInstances = nullptr;
+    job.DrawArgs = nullptr;
+    const int32 jobIndex = renderContext.List->InstanceCullingJobs.Add(job);
+
+    // Submit the indirect draws for every LOD mesh
+    const Lightmap* lightmap = EnumHasAnyFlags(_staticFlags, StaticFlags::Lightmap) ? _scene->LightmapsData.GetReadyLightmap(type._gpuInstancesLightmap) : nullptr;
+    int32 drawIndex = 0;
+    for (int32 lod = 0; lod < lodsCount; lod++)
+    {
+        const auto& meshes = model->LODs.Get()[lod].Meshes;
+        for (int32 meshIndex = 0; meshIndex < meshes.Count(); meshIndex++, drawIndex++)
+        {
+            const auto& mesh = meshes.Get()[meshIndex];
+            MaterialBase* material = (MaterialBase*)drawCallsLists[lod][meshIndex].DrawCall.Material;
+            if (!material)
+                continue;
+            const auto& entry = type.Entries[mesh.GetMaterialSlotIndex()];
+            const MaterialSlot& slot = model->MaterialSlots[mesh.GetMaterialSlotIndex()];
+            const auto shadowsMode = entry.ShadowsMode & slot.ShadowsMode;
+            const auto drawModes = typeDrawModes & renderContext.View.GetShadowsDrawPassMask(shadowsMode) & material->GetDrawModes();
+
+            // Setup draw call (instances data comes from the culling job)
+            BatchedDrawCall batch;
+            batch.DrawCall.Material = material;
+            mesh.GetDrawCallGeometry(batch.DrawCall);
+            batch.DrawCall.InstanceCount = 1;
+            batch.DrawCall.ObjectPosition = type.Root->TotalBoundsSphere.Center - viewOrigin;
+            batch.DrawCall.ObjectRadius = (float)type.Root->TotalBoundsSphere.Radius;
+            batch.DrawCall.PerInstanceRandom = 0.0f;
+            batch.DrawCall.Surface.Lightmap = lightmap;
+            batch.DrawCall.Surface.LightmapUVsArea = Rectangle::Empty;
+            batch.DrawCall.Surface.LODDitherFactor = 0.0f;
+            batch.DrawCall.World = Matrix::Identity;
+            batch.DrawCall.Surface.PrevWorld = Matrix::Identity;
+            batch.DrawCall.Surface.GeometrySize = mesh.GetBox().GetSize();
+            batch.DrawCall.Surface.Skinning = nullptr;
+            batch.DrawCall.WorldDeterminantSign = 1;
+            batch.InstanceCullingJob = jobIndex;
+            batch.InstanceCullingDraw = drawIndex;
+            const int32 batchIndex = renderContext.List->BatchedDrawCalls.Add(MoveTemp(batch));
+
+            // Add draw call to proper draw lists
+            if (EnumHasAnyFlags(drawModes, DrawPass::Depth))
+            {
+                renderContext.List->DrawCallsLists[(int32)DrawCallsListType::Depth].PreBatchedDrawCalls.Add(batchIndex);
+            }
+            if (EnumHasAnyFlags(drawModes, DrawPass::GBuffer))
+            {
+                if (entry.ReceiveDecals)
+                    renderContext.List->DrawCallsLists[(int32)DrawCallsListType::GBuffer].PreBatchedDrawCalls.Add(batchIndex);
+                else
+                    renderContext.List->DrawCallsLists[(int32)DrawCallsListType::GBufferNoDecals].PreBatchedDrawCalls.Add(batchIndex);
+            }
+        }
+    }
+    return false;
+}
+
 void Foliage::DrawFoliageJob(int32 i)
 {
     PROFILE_CPU();
-    const FoliageType& type = FoliageTypes[i];
+    FoliageType& type = FoliageTypes[i];
     if (type.IsReady() && type.Model->CanBeRendered())
     {
         DrawCallsList drawCallsLists[MODEL_MAX_LODS];
@@ -412,14 +604,15 @@ void Foliage::DrawFoliageJob(int32 i)
 
 #endif
 
-void Foliage::DrawType(RenderContext& renderContext, const FoliageType& type, DrawCallsList* drawCallsLists)
+void Foliage::DrawType(RenderContext& renderContext, FoliageType& type, DrawCallsList* drawCallsLists)
 {
-    if (!type.Root || !FOLIAGE_CAN_DRAW(renderContext, type))
+    if (!type.Root || !FOLIAGE_CAN_DRAW(renderContext, type) || (_staticFlags & renderContext.List->StaticFlagsFilterMask) != renderContext.List->StaticFlagsFilterValue)
         return;
     const DrawPass typeDrawModes = FOLIAGE_GET_DRAW_MODES(renderContext, type);
     PROFILE_CPU_ASSET(type.Model);
 #if FOLIAGE_USE_DRAW_CALLS_BATCHING
     // Initialize draw calls for foliage type all LODs meshes
+    bool useGPUCulling = Graphics::GPUFoliageCulling && GPUDevice::Instance->Limits.HasInstancing && InstanceCulling::Instance()->IsReady();
     for (int32 lod = 0; lod < type.Model->LODs.Count(); lod++)
     {
         auto& modelLod = type.Model->LODs[lod];
@@ -455,10 +648,19 @@ void Foliage::DrawType(RenderContext& renderContext, const FoliageType& type, Dr
             if (drawModes == DrawPass::None)
                 continue;
 
+            // Transparency requires sorting by depth and motion vectors use the previous frame transformation so those are drawn by the CPU
+            if (EnumHasAnyFlags(drawModes, DrawPass::Forward | DrawPass::Distortion) ||
+                (EnumHasAnyFlags(drawModes, DrawPass::MotionVectors) && (_staticFlags & StaticFlags::Transform) == StaticFlags::None))
+                useGPUCulling = false;
+
             drawCall.DrawCall.Material = material;
         }
     }
 
+    // Draw instances of the foliage type with the GPU-driven culling (fallback to the CPU if not supported)
+    if (useGPUCulling && !DrawTypeGPU(renderContext, type, drawCallsLists, typeDrawModes))
+        return;
+
     // Draw instances of the foliage type
     BatchedDrawCalls result;
     DrawCluster(renderContext, type.Root, type, drawCallsLists, result);
@@ -492,6 +694,7 @@ void Foliage::DrawType(RenderContext& renderContext, const FoliageType& type, Dr
         batch.DrawCall.Surface.GeometrySize = mesh.GetBox().GetSize();
         batch.DrawCall.Surface.Skinning = nullptr;
         batch.DrawCall.WorldDeterminantSign = 1;
+        batch.Bounds = mesh.GetSphere();
 
         if (EnumHasAnyFlags(drawModes, DrawPass::Forward))
         {
@@ -723,6 +926,8 @@ void Foliage::OnFoliageTypeModelLoaded(int32 index)
     PROFILE_CPU();
     auto& type = FoliageTypes[index];
     ASSERT(type.IsReady());
+    if (IsProcedural())
+        _proceduralDirty = true;
 
     // Update bounds for instances using this type
     bool hasAnyInstance = false;
@@ -834,6 +1039,7 @@ void Foliage::RebuildClusters()
         {
             type.Root = nullptr;
             type.Clusters.Clear();
+            type._gpuInstancesDirty = 1;
         }
 #endif
         _box = BoundingBox(_transform.Translation, _transform.Translation);
@@ -962,6 +1168,7 @@ void Foliage::RebuildClusters()
 #else
     for (auto& type : FoliageTypes)
     {
+        type._gpuInstancesDirty = 1;
         if (type.Root)
         {
             PROFILE_CPU_NAMED("Update Cache");
@@ -994,6 +1201,7 @@ void Foliage::UpdateCullDistance()
 #else
     for (auto& type : FoliageTypes)
     {
+        type._gpuInstancesDirty = 1;
         if (type.Root)
         {
             PROFILE_CPU_NAMED("Clusters");
@@ -1003,6 +1211,333 @@ void Foliage::UpdateCullDistance()
 #endif
 }
 
+bool Foliage::IsProcedural() const
+{
+    return ProceduralTerrain != nullptr;
+}
+
+void Foliage::ResetProcedural()
+{
+    _proceduralDirty = true;
+}
+
+namespace
+{
+    struct ProceduralPatch
+    {
+        const float* Heightmap;
+        const byte* HolesMask;
+        const Color32* SplatMaps[TERRAIN_MAX_SPLATMAPS_COUNT];
+    };
+
+    struct ProceduralType
+    {
+        const FoliageType* Type;
+        BoundingBox Box;
+    };
+
+    struct ProceduralTile
+    {
+        Int2 Coord;
+        float Distance;
+
+        bool operator<(const ProceduralTile& other) const
+        {
+            return Distance < other.Distance;
+        }
+    };
+
+    struct ProceduralContext
+    {
+        Transform TerrainTransform;
+        Transform FoliageTransform;
+        float TileSize;
+        float PatchSize;
+        int32 HeightmapSize;
+        int32 Seed;
+        Dictionary<Int2, ProceduralPatch> Patches;
+        Array<ProceduralType, InlinedAllocation<8>> Types;
+
+        bool SampleTerrain(const Float2& position, float& height, Float3& normal, int32& layerIndex, const ProceduralPatch*& patch) const
+        {
+            // Find the patch (terrain local-space)
+            const Int2 patchCoord(Math::FloorToInt(position.X / PatchSize), Math::FloorToInt(position.Y / PatchSize));
+            patch = Patches.TryGet(patchCoord);
+            if (!patch)
+                return false;
+
+            // Sample heightmap with bilinear filtering
+            const Float2 uv = (position - Float2((float)patchCoord.X, (float)patchCoord.Y) * PatchSize) / TERRAIN_UNITS_PER_VERTEX;
+            const int32 x = Math::Clamp(Math::FloorToInt(uv.X), 0, HeightmapSize - 2);
+            const int32 z = Math::Clamp(Math::FloorToInt(uv.Y), 0, HeightmapSize - 2);
+            const float fx = Math::Saturate(uv.X - (float)x);
+            const float fz = Math::Saturate(uv.Y - (float)z);
+            const int32 index = z * HeightmapSize + x;
+            const float h00 = patch->Heightmap[index];
+            const float h10 = patch->Heightmap[index + 1];
+            const float h01 = patch->Heightmap[index + HeightmapSize];
+            const float h11 = patch->Heightmap[index + HeightmapSize + 1];
+            height = Math::Lerp(Math::Lerp(h00, h10, fx), Math::Lerp(h01, h11, fx), fz);
+            const float dx = (h10 - h00 + h11 - h01) * 0.5f;
+            const float dz = (h01 - h00 + h11 - h10) * 0.5f;
+            normal = Float3(-dx, TERRAIN_UNITS_PER_VERTEX, -dz);
+
+            // Use the nearest sample for holes and splatmaps
+            layerIndex = (z + (fz >= 0.5f ? 1 : 0)) * HeightmapSize + x + (fx >= 0.5f ? 1 : 0);
+            return !patch->HolesMask || patch->HolesMask[layerIndex] != 0;
+        }
+
+        void GenerateTile(const Int2& tile, Array<FoliageInstance>& result) const
+        {
+            const Float2 tileMin = Float2((float)tile.X, (float)tile.Y) * TileSize;
+            const Float3 terrainScale = TerrainTransform.Scale;
+            const float tileArea = TileSize * TileSize * Math::Abs(terrainScale.X * terrainScale.Z);
+            Vector3 corners[8];
+            Quaternion tmp;
+            for (const ProceduralType& e : Types)
+            {
+                const FoliageType& type = *e.Type;
+
+                // Deterministic random numbers stream per tile and foliage type
+                uint32 hash = (uint32)Seed;
+                CombineHash(hash, GetHash(tile));
+                CombineHash(hash, (uint32)type.Index);
+                const RandomStream random((int32)hash);
+
+                // Instances count from the density that is defined per 1000x1000 units area
+                const float count = Math::Min(type.PaintDensity * tileArea / (1000.0f * 1000.0f), (float)FOLIAGE_PROCEDURAL_MAX_TILE_INSTANCES);
+                const int32 countInt = (int32)count + (random.Rand() < count - Math::Floor(count) ? 1 : 0);
+                const float minNormalAngle = Math::Cos(type.PaintGroundSlopeAngleMin * DegreesToRadians);
+                const float maxNormalAngle = Math::Cos(type.PaintGroundSlopeAngleMax * DegreesToRadians);
+                const int32 layer = type.ProceduralLayer;
+                const bool useLayer = layer >= 0 && layer < TERRAIN_MAX_SPLATMAPS_COUNT * 4;
+                const bool useNoise = type.ProceduralNoiseSize > ZeroTolerance;
+                for (int32 i = 0; i < countInt; i++)
+                {
+                    // Consume the same amount of the random numbers for every candidate to keep placement stable when rules change
+                    const Float2 position = tileMin + Float2(random.Rand(), random.Rand()) * TileSize;
+                    const float layerRandom = random.Rand();
+                    const float yawRandom = random.Rand();
+                    const float rollRandom = random.Rand();
+                    const float pitchRandom = random.Rand();
+                    const float offsetRandom = random.Rand();
+                    const float instanceRandom = random.Rand();
+                    const Float3 scale = type.GetRandomScale(random);
+
+                    // Evaluate placement rules
+                    float height;
+                    Float3 normal;
+                    int32 sampleIndex;
+                    const ProceduralPatch* patch;
+                    if (!SampleTerrain(position, height, normal, sampleIndex, patch))
+                        continue;
+                    if (useLayer)
+                    {
+                        const Color32& splatmap = patch->SplatMaps[layer / 4][sampleIndex];
+                        const float weight = (float)((const byte*)&splatmap)[layer % 4] / 255.0f;
+                        if (weight < type.ProceduralLayerThreshold || layerRandom > weight)
+                            continue;
+                    }
+                    if (useNoise && Noise::PerlinNoise(position / type.ProceduralNoiseSize) < type.ProceduralNoiseThreshold)
+                        continue;
+                    normal /= terrainScale;
+                    normal = TerrainTransform.Orientation * normal;
+                    normal.Normalize();
+                    const float normalAngle = Float3::Dot(normal, Float3::Up);
+                    if (normalAngle > minNormalAngle + ZeroTolerance || normalAngle < maxNormalAngle - ZeroTolerance)
+                        continue;
+
+                    // Setup instance transformation (the same way as foliage painting tool does)
+                    Transform transform;
+                    const Float3 alignNormal = type.PlacementAlignToNormal ? normal : Float3::Up;
+                    if (alignNormal == Float3::Down)
+                        transform.Orientation = Quaternion(0.0f, 0.0f, Math::Sin(PI_OVER_2), Math::Cos(PI_OVER_2));
+                    else
+                        transform.Orientation = Quaternion::LookRotation(Float3::Cross(Float3::Cross(alignNormal, Float3::Forward), alignNormal), alignNormal);
+                    if (type.PlacementRandomYaw)
+                    {
+                        Quaternion::RotationAxis(Float3::UnitY, yawRandom * TWO_PI, tmp);
+                        transform.Orientation *= tmp;
+                    }
+                    if (!Math::IsZero(type.PlacementRandomRollAngle))
+                    {
+                        Quaternion::RotationAxis(Float3::UnitZ, rollRandom * DegreesToRadians * type.PlacementRandomRollAngle, tmp);
+                        transform.Orientation *= tmp;
+                    }
+                    if (!Math::IsZero(type.PlacementRandomPitchAngle))
+                    {
+                        Quaternion::RotationAxis(Float3::UnitX, pitchRandom * DegreesToRadians * type.PlacementRandomPitchAngle, tmp);
+                        transform.Orientation *= tmp;
+                    }
+                    transform.Translation = TerrainTransform.LocalToWorld(Vector3(position.X, height, position.Y));
+                    if (!type.PlacementOffsetY.IsZero())
+                        transform.Translation += (transform.Orientation * Float3::Up) * Math::Lerp(type.PlacementOffsetY.X, type.PlacementOffsetY.Y, offsetRandom);
+                    transform.Scale = scale;
+                    transform.Orientation.Normalize();
+
+                    // Add instance (in foliage actor local-space)
+                    auto& instance = result.AddOne();
+                    FoliageTransform.WorldToLocal(transform, instance.Transform);
+                    instance.Type = type.Index;
+                    instance.Random = instanceRandom;
+                    instance.CullDistance = type.CullDistance + type.CullDistanceRandomRange * instanceRandom;
+                    instance.Lightmap = LightmapEntry();
+                    e.Box.GetCorners(corners);
+                    for (int32 k = 0; k < 8; k++)
+                        Vector3::Transform(corners[k], transform, corners[k]);
+                    BoundingSphere::FromPoints(corners, 8, instance.Bounds);
+                    instance.Bounds.Radius += ZeroTolerance;
+                }
+            }
+        }
+    };
+
+    float GetTileDistance(const Int2& tile, float tileSize, const Float2& position)
+    {
+        const Float2 tileMin = Float2((float)tile.X, (float)tile.Y) * tileSize;
+        const Float2 tileMax = tileMin + tileSize;
+        const Float2 delta = Float2::Max(Float2::Max(tileMin - position, position - tileMax), Float2::Zero);
+        return delta.Length();
+    }
+}
+
+void Foliage::UpdateProcedural()
+{
+    Terrain* terrain = ProceduralTerrain.Get();
+    if (!terrain || terrain->GetPatchesCount() == 0 || ProceduralTileSize <= ZeroTolerance)
+    {
+        if (_proceduralTiles.HasItems())
+        {
+            // Procedural mode got disabled
+            _proceduralTiles.Clear();
+            Instances.Clear();
+            RebuildClusters();
+        }
+        return;
+    }
+    PROFILE_CPU();
+
+    // Get the view location
+    Vector3 viewPosition;
+    if (const Camera* camera = Camera::GetMainCamera())
+        viewPosition = camera->GetPosition();
+    else if (MainRenderTask::Instance)
+        viewPosition = MainRenderTask::Instance->View.WorldPosition;
+    else
+        return;
+    bool changed = false;
+    if (_proceduralDirty)
+    {
+        _proceduralDirty = false;
+        changed = _proceduralTiles.HasItems() || Instances.HasItems();
+        _proceduralTiles.Clear();
+    }
+    const Transform& terrainTransform = terrain->GetTransform();
+    const Vector3 viewPositionLocal = terrainTransform.WorldToLocal(viewPosition);
+    const Float2 center((float)viewPositionLocal.X, (float)viewPositionLocal.Z);
+    const float tileSize = ProceduralTileSize;
+    const float distance = Math::Max(ProceduralDistance, 0.0f);
+
+    // Release far tiles (use margin of a single tile to prevent regenerating tiles when moving back and forth around the range border)
+    for (auto it = _proceduralTiles.Begin(); it.IsNotEnd(); ++it)
+    {
+        if (GetTileDistance(it->Key, tileSize, center) > distance + tileSize)
+        {
+            _proceduralTiles.Remove(it);
+            changed = true;
+        }
+    }
+
+    // Find missing tiles (the closest ones first)
+    Array<ProceduralTile, RendererAllocation> missingTiles;
+    const Int2 tileMin(Math::FloorToInt((center.X - distance) / tileSize), Math::FloorToInt((center.Y - distance) / tileSize));
+    const Int2 tileMax(Math::FloorToInt((center.X + distance) / tileSize), Math::FloorToInt((center.Y + distance) / tileSize));
+    for (int32 z = tileMin.Y; z <= tileMax.Y; z++)
+    {
+        for (int32 x = tileMin.X; x <= tileMax.X; x++)
+        {
+            const Int2 coord(x, z);
+            const float tileDistance = GetTileDistance(coord, tileSize, center);
+            if (tileDistance <= distance && !_proceduralTiles.ContainsKey(coord))
+                missingTiles.Add({ coord, tileDistance });
+        }
+    }
+    if (missingTiles.HasItems())
+    {
+        Sorting::QuickSort(missingTiles);
+        if (missingTiles.Count() > FOLIAGE_PROCEDURAL_MAX_TILES_PER_UPDATE)
+            missingTiles.Resize(FOLIAGE_PROCEDURAL_MAX_TILES_PER_UPDATE);
+
+        // Prepare data for the generation (terrain data access is cached and not thread-safe thus gather it on a main thread)
+        ProceduralContext context;
+        context.TerrainTransform = terrainTransform;
+        context.FoliageTransform = _transform;
+        context.TileSize = tileSize;
+        context.PatchSize = (float)(terrain->GetChunkSize() * Terrain::ChunksCountEdge) * TERRAIN_UNITS_PER_VERTEX;
+        context.HeightmapSize = terrain->GetChunkSize() * Terrain::ChunksCountEdge + 1;
+        context.Seed = ProceduralSeed;
+        for (const FoliageType& type : FoliageTypes)
+        {
+            if (!type.IsReady() || type.PaintDensity <= ZeroTolerance)
+                continue;
+            ProceduralType& e = context.Types.AddOne();
+            e.Type = &type;
+            e.Box = type.Model->LODs[0].GetBox();
+        }
+        for (int32 i = 0; i < terrain->GetPatchesCount(); i++)
+        {
+            TerrainPatch* patch = terrain->GetPatch(i);
+            ProceduralPatch e;
+            e.Heightmap = patch->GetHeightmapData();
+            e.HolesMask = patch->GetHolesMaskData();
+            bool valid = e.Heightmap != nullptr;
+            for (int32 j = 0; j < TERRAIN_MAX_SPLATMAPS_COUNT; j++)
+            {
+                e.SplatMaps[j] = patch->GetSplatMapData(j);
+                valid &= e.SplatMaps[j] != nullptr;
+            }
+            if (valid)
+                context.Patches.Add(Int2(patch->GetX(), patch->GetZ()), e);
+        }
+
+        // Generate tiles on job system workers
+        Array<Array<FoliageInstance>> results;
+        results.Resize(missingTiles.Count());
+        JobSystem::Execute([&](int32 i)
+        {
+            PROFILE_CPU_NAMED("Foliage.GenerateTile");
+            context.GenerateTile(missingTiles[i].Coord, results[i]);
+        }, missingTiles.Count());
+        for (int32 i = 0; i < missingTiles.Count(); i++)
+            _proceduralTiles[missingTiles[i].Coord] = MoveTemp(results[i]);
+        changed = true;
+    }
+
+    // Sync instances with the generated tiles
+    if (changed)
+    {
+        PROFILE_CPU_NAMED("Sync Instances");
+        Instances.Clear();
+        for (const auto& e : _proceduralTiles)
+        {
+            for (const FoliageInstance& instance : e.Value)
+                Instances.Add(instance);
+        }
+        RebuildClusters();
+    }
+}
+
+#if USE_EDITOR
+
+void Foliage::UpdateProceduralExecuteInEditor()
+{
+    // Preview procedural foliage in Editor
+    if (!Editor::IsPlayMode)
+        UpdateProcedural();
+}
+
+#endif
+
 static float GlobalDensityScale = 1.0f;
 
 float Foliage::GetGlobalDensityScale()
@@ -1293,6 +1828,11 @@ void Foliage::Serialize(SerializeStream& stream, const void* otherObj)
 
     SERIALIZE_GET_OTHER_OBJ(Foliage);
 
+    SERIALIZE(ProceduralTerrain);
+    SERIALIZE(ProceduralDistance);
+    SERIALIZE(ProceduralTileSize);
+    SERIALIZE(ProceduralSeed);
+
     if (FoliageTypes.IsEmpty())
         return;
 
@@ -1308,6 +1848,10 @@ void Foliage::Serialize(SerializeStream& stream, const void* otherObj)
     }
     stream.EndArray();
 
+    // Procedural foliage instances are generated at runtime
+    if (IsProcedural())
+        return;
+
     stream.JKEY("Instances");
     stream.StartArray();
     InstanceEncoded enc;
@@ -1346,6 +1890,13 @@ void Foliage::Deserialize(DeserializeStream& stream, ISerializeModifier* modifie
 #endif
     Instances.Release();
     FoliageTypes.Resize(0, false);
+    _proceduralTiles.Clear();
+    _proceduralDirty = true;
+
+    DESERIALIZE(ProceduralTerrain);
+    DESERIALIZE(ProceduralDistance);
+    DESERIALIZE(ProceduralTileSize);
+    DESERIALIZE(ProceduralSeed);
 
     // Deserialize foliage types
     int32 foliageTypesCount = 0;
@@ -1366,8 +1917,8 @@ void Foliage::Deserialize(DeserializeStream& stream, ISerializeModifier* modifie
         }
     }
 
-    // Skip if no foliage
-    if (FoliageTypes.IsEmpty())
+    // Skip if no foliage or if it's procedural
+    if (FoliageTypes.IsEmpty() || IsProcedural())
         return;
 
     // Deserialize foliage instances
@@ -1464,6 +2015,10 @@ void Foliage::OnLayerChanged()
 void Foliage::OnEnable()
 {
     GetSceneRendering()->AddActor(this, _sceneRenderingKey);
+    GetScene()->Ticking.Update.AddTick<Foliage, &Foliage::UpdateProcedural>(this);
+#if USE_EDITOR
+    GetScene()->Ticking.Update.AddTickExecuteInEditor<Foliage, &Foliage::UpdateProceduralExecuteInEditor>(this);
+#endif
 
     // Base
     Actor::OnEnable();
@@ -1471,6 +2026,10 @@ void Foliage::OnEnable()
 
 void Foliage::OnDisable()
 {
+#if USE_EDITOR
+    GetScene()->Ticking.Update.RemoveTickExecuteInEditor(this);
+#endif
+    GetScene()->Ticking.Update.RemoveTick(this);
     GetSceneRendering()->RemoveActor(this, _sceneRenderingKey);
 
     // Base
@@ -1483,6 +2042,8 @@ void Foliage::OnTransformChanged()
     Actor::OnTransformChanged();
 
     PROFILE_CPU();
+    if (IsProcedural())
+        _proceduralDirty = true;
 
     // Update instances matrices and cached world bounds
     Vector3 corners[8];
@@ -7,6 +7,10 @@
 #include "FoliageCluster.h"
 #include "FoliageType.h"
 #include "Engine/Level/Actor.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Scripting/ScriptingObjectReference.h"
+
+class Terrain;
 
 /// <summary>
 /// Represents a foliage actor that contains a set of instanced meshes.
@@ -17,7 +21,9 @@ API_CLASS() class FLAXENGINE_API Foliage final : public Actor
     DECLARE_SCENE_OBJECT(Foliage);
 private:
     bool _disableFoliageTypeEvents;
+    bool _proceduralDirty = false;
     int32 _sceneRenderingKey = -1;
+    Dictionary<Int2, Array<FoliageInstance>> _proceduralTiles;
 
 public:
     /// <summary>
@@ -43,6 +49,30 @@ API_CLASS() class FLAXENGINE_API Foliage final : public Actor
     API_FIELD(ReadOnly, Attributes="HideInEditor, NoSerialize")
     Array<FoliageType> FoliageTypes;
 
+    /// <summary>
+    /// The terrain to scatter the procedural foliage over. If set, foliage instances are not stored but generated at runtime in tiles around the camera using the foliage types placement rules (density, terrain layer, noise, slope, scale and rotation). Painted instances are discarded in this mode.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(100), EditorDisplay(\"Procedural\", \"Terrain\")")
+    ScriptingObjectReference<Terrain> ProceduralTerrain;
+
+    /// <summary>
+    /// The distance (in terrain local-space units) around the camera up to which procedural foliage tiles are generated. Tiles beyond that distance are released.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(110), EditorDisplay(\"Procedural\", \"Distance\"), Limit(0)")
+    float ProceduralDistance = 10000.0f;
+
+    /// <summary>
+    /// The size (in terrain local-space units) of the single procedural foliage tile. Instances are generated and released per-tile.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(120), EditorDisplay(\"Procedural\", \"Tile Size\"), Limit(100)")
+    float ProceduralTileSize = 2000.0f;
+
+    /// <summary>
+    /// The seed of the procedural foliage placement. The same seed always produces the same instances on a given terrain.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(130), EditorDisplay(\"Procedural\", \"Seed\")")
+    int32 ProceduralSeed = 0;
+
 public:
     /// <summary>
     /// Gets the total amount of the instanced of foliage.
@@ -134,6 +164,16 @@ API_CLASS() class FLAXENGINE_API Foliage final : public Actor
     /// </summary>
     API_FUNCTION() void UpdateCullDistance();
 
+    /// <summary>
+    /// Determines whether foliage instances are generated procedurally at runtime (see <see cref="ProceduralTerrain"/>).
+    /// </summary>
+    API_PROPERTY() bool IsProcedural() const;
+
+    /// <summary>
+    /// Releases all generated procedural foliage tiles which forces them to be regenerated during the next update. Call it after changing terrain or procedural placement settings.
+    /// </summary>
+    API_FUNCTION() void ResetProcedural();
+
 public:
     /// <summary>
     /// Gets the global density scale for all foliage instances. The default value is 1. Use values from range 0-1. Lower values decrease amount of foliage instances in-game. Use it to tweak game performance for slower devices.
@@ -146,6 +186,10 @@ API_CLASS() class FLAXENGINE_API Foliage final : public Actor
     API_PROPERTY() static void SetGlobalDensityScale(float value);
 
 private:
+    void UpdateProcedural();
+#if USE_EDITOR
+    void UpdateProceduralExecuteInEditor();
+#endif
     void AddToCluster(ChunkedArray<FoliageCluster, FOLIAGE_CLUSTER_CHUNKS_SIZE>& clusters, FoliageCluster* cluster, FoliageInstance& instance);
 #if !FOLIAGE_USE_SINGLE_QUAD_TREE && FOLIAGE_USE_DRAW_CALLS_BATCHING
     struct DrawKey
@@ -172,6 +216,7 @@ API_CLASS() class FLAXENGINE_API Foliage final : public Actor
     typedef Dictionary<DrawKey, struct BatchedDrawCall, class RendererAllocation> BatchedDrawCalls;
     void DrawInstance(RenderContext& renderContext, FoliageInstance& instance, const FoliageType& type, Model* model, int32 lod, float lodDitherFactor, DrawCallsList* drawCallsLists, BatchedDrawCalls& result) const;
     void DrawCluster(RenderContext& renderContext, FoliageCluster* cluster, const FoliageType& type, DrawCallsList* drawCallsLists, BatchedDrawCalls& result) const;
+    bool DrawTypeGPU(RenderContext& renderContext, FoliageType& type, DrawCallsList* drawCallsLists, DrawPass typeDrawModes);
 #else
     void DrawCluster(RenderContext& renderContext, FoliageCluster* cluster, Mesh::DrawInfo& draw);
 #endif
@@ -181,7 +226,7 @@ API_CLASS() class FLAXENGINE_API Foliage final : public Actor
     void DrawFoliageJob(int32 i);
     RenderContextBatch* _renderContextBatch;
 #endif
-    void DrawType(RenderContext& renderContext, const FoliageType& type, DrawCallsList* drawCallsLists);
+    void DrawType(RenderContext& renderContext, FoliageType& type, DrawCallsList* drawCallsLists);
 
 public:
     /// <summary>
@@ -3,7 +3,9 @@
 #include "FoliageType.h"
 #include "Engine/Core/Collections/ArrayExtensions.h"
 #include "Engine/Core/Random.h"
+#include "Engine/Core/RandomStream.h"
 #include "Engine/Serialization/Serialization.h"
+#include "Engine/Renderer/Utils/InstanceCulling.h"
 #include "Foliage.h"
 
 FoliageType::FoliageType()
@@ -12,6 +14,7 @@ FoliageType::FoliageType()
     , Index(-1)
 {
     _isReady = 0;
+    _gpuInstancesDirty = 1;
 
     ReceiveDecals = true;
     UseDensityScaling = false;
@@ -22,8 +25,15 @@ FoliageType::FoliageType()
     Model.Loaded.Bind<FoliageType, &FoliageType::OnModelLoaded>(this);
 }
 
+FoliageType::~FoliageType()
+{
+    if (_gpuInstances)
+        Delete(_gpuInstances);
+}
+
 FoliageType& FoliageType::operator=(const FoliageType& other)
 {
+    _gpuInstancesDirty = 1;
     Foliage = other.Foliage;
     Index = other.Index;
     Model = other.Model;
@@ -44,6 +54,10 @@ FoliageType& FoliageType::operator=(const FoliageType& other)
     PlacementRandomPitchAngle = other.PlacementRandomPitchAngle;
     PlacementRandomRollAngle = other.PlacementRandomRollAngle;
     DensityScalingScale = other.DensityScalingScale;
+    ProceduralLayer = other.ProceduralLayer;
+    ProceduralLayerThreshold = other.ProceduralLayerThreshold;
+    ProceduralNoiseSize = other.ProceduralNoiseSize;
+    ProceduralNoiseThreshold = other.ProceduralNoiseThreshold;
     ReceiveDecals = other.ReceiveDecals;
     UseDensityScaling = other.UseDensityScaling;
     PlacementAlignToNormal = other.PlacementAlignToNormal;
@@ -67,48 +81,63 @@ void FoliageType::SetMaterials(const Array<MaterialBase*>& value)
         Entries[i].Material = value[i];
 }
 
-Float3 FoliageType::GetRandomScale() const
+namespace
 {
-    Float3 result;
-    float tmp;
-    switch (PaintScaling)
+    template<typename RandomFunc>
+    Float3 GetRandomScaleImpl(const FoliageType& type, const RandomFunc& random)
     {
-    case FoliageScalingModes::Uniform:
-        result.X = Math::Lerp(PaintScaleMin.X, PaintScaleMax.X, Random::Rand());
-        result.Y = result.X;
-        result.Z = result.X;
-        break;
-    case FoliageScalingModes::Free:
-        result.X = Math::Lerp(PaintScaleMin.X, PaintScaleMax.X, Random::Rand());
-        result.Y = Math::Lerp(PaintScaleMin.Y, PaintScaleMax.Y, Random::Rand());
-        result.Z = Math::Lerp(PaintScaleMin.Z, PaintScaleMax.Z, Random::Rand());
-        break;
-    case FoliageScalingModes::LockXY:
-        tmp = Random::Rand();
-        result.X = Math::Lerp(PaintScaleMin.X, PaintScaleMax.X, tmp);
-        result.Y = Math::Lerp(PaintScaleMin.Y, PaintScaleMax.Y, tmp);
-        result.Z = Math::Lerp(PaintScaleMin.Z, PaintScaleMax.Z, Random::Rand());
-        break;
-    case FoliageScalingModes::LockXZ:
-        tmp = Random::Rand();
-        result.X = Math::Lerp(PaintScaleMin.X, PaintScaleMax.X, tmp);
-        result.Y = Math::Lerp(PaintScaleMin.Y, PaintScaleMax.Y, Random::Rand());
-        result.Z = Math::Lerp(PaintScaleMin.Z, PaintScaleMax.Z, tmp);
-        break;
-    case FoliageScalingModes::LockYZ:
-        tmp = Random::Rand();
-        result.X = Math::Lerp(PaintScaleMin.X, PaintScaleMax.X, Random::Rand());
-        result.Y = Math::Lerp(PaintScaleMin.Y, PaintScaleMax.Y, tmp);
-        result.Z = Math::Lerp(PaintScaleMin.Z, PaintScaleMax.Z, tmp);
-        break;
+        Float3 result;
+        float tmp;
+        switch (type.PaintScaling)
+        {
+        case FoliageScalingModes::Uniform:
+            result.X = Math::Lerp(type.PaintScaleMin.X, type.PaintScaleMax.X, random());
+            result.Y = result.X;
+            result.Z = result.X;
+            break;
+        case FoliageScalingModes::Free:
+            result.X = Math::Lerp(type.PaintScaleMin.X, type.PaintScaleMax.X, random());
+            result.Y = Math::Lerp(type.PaintScaleMin.Y, type.PaintScaleMax.Y, random());
+            result.Z = Math::Lerp(type.PaintScaleMin.Z, type.PaintScaleMax.Z, random());
+            break;
+        case FoliageScalingModes::LockXY:
+            tmp = random();
+            result.X = Math::Lerp(type.PaintScaleMin.X, type.PaintScaleMax.X, tmp);
+            result.Y = Math::Lerp(type.PaintScaleMin.Y, type.PaintScaleMax.Y, tmp);
+            result.Z = Math::Lerp(type.PaintScaleMin.Z, type.PaintScaleMax.Z, random());
+            break;
+        case FoliageScalingModes::LockXZ:
+            tmp = random();
+            result.X = Math::Lerp(type.PaintScaleMin.X, type.PaintScaleMax.X, tmp);
+            result.Y = Math::Lerp(type.PaintScaleMin.Y, type.PaintScaleMax.Y, random());
+            result.Z = Math::Lerp(type.PaintScaleMin.Z, type.PaintScaleMax.Z, tmp);
+            break;
+        case FoliageScalingModes::LockYZ:
+            tmp = random();
+            result.X = Math::Lerp(type.PaintScaleMin.X, type.PaintScaleMax.X, random());
+            result.Y = Math::Lerp(type.PaintScaleMin.Y, type.PaintScaleMax.Y, tmp);
+            result.Z = Math::Lerp(type.PaintScaleMin.Z, type.PaintScaleMax.Z, tmp);
+            break;
+        }
+        return result;
     }
-    return result;
+}
+
+Float3 FoliageType::GetRandomScale() const
+{
+    return GetRandomScaleImpl(*this, [] { return Random::Rand(); });
+}
+
+Float3 FoliageType::GetRandomScale(const RandomStream& random) const
+{
+    return GetRandomScaleImpl(*this, [&random] { return random.Rand(); });
 }
 
 void FoliageType::OnModelChanged()
 {
     // Cleanup
     _isReady = 0;
+    _gpuInstancesDirty = 1;
     Entries.Release();
 }
 
@@ -165,6 +194,11 @@ void FoliageType::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE(PlacementRandomRollAngle);
     SERIALIZE_BIT(PlacementAlignToNormal);
     SERIALIZE_BIT(PlacementRandomYaw);
+
+    SERIALIZE(ProceduralLayer);
+    SERIALIZE(ProceduralLayerThreshold);
+    SERIALIZE(ProceduralNoiseSize);
+    SERIALIZE(ProceduralNoiseThreshold);
 }
 
 void FoliageType::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
@@ -205,4 +239,9 @@ void FoliageType::Deserialize(DeserializeStream& stream, ISerializeModifier* mod
     DESERIALIZE(PlacementRandomRollAngle);
     DESERIALIZE_BIT(PlacementAlignToNormal);
     DESERIALIZE_BIT(PlacementRandomYaw);
+
+    DESERIALIZE(ProceduralLayer);
+    DESERIALIZE(ProceduralLayerThreshold);
+    DESERIALIZE(ProceduralNoiseSize);
+    DESERIALIZE(ProceduralNoiseThreshold);
 }
@@ -47,6 +47,10 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API FoliageType : public ScriptingOb
     friend Foliage;
 private:
     uint8 _isReady : 1;
+    uint8 _gpuInstancesDirty : 1;
+    int32 _gpuInstancesLightmap = INVALID_INDEX;
+    float _gpuInstancesRadius = 0.0f;
+    class InstanceCullingBuffers* _gpuInstances = nullptr;
 
 public:
     /// <summary>
@@ -54,6 +58,11 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API FoliageType : public ScriptingOb
     /// </summary>
     FoliageType();
 
+    /// <summary>
+    /// Finalizes an instance of the <see cref="FoliageType"/> class.
+    /// </summary>
+    ~FoliageType();
+
     FoliageType(const FoliageType& other)
         : FoliageType()
     {
@@ -187,6 +196,26 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API FoliageType : public ScriptingOb
     /// </summary>
     API_FIELD() float DensityScalingScale = 1.0f;
 
+    /// <summary>
+    /// The terrain layer index (0-7) that drives the procedural foliage placement (layer weight scales the density). Use -1 to scatter instances over the whole terrain. Used only when foliage uses procedural mode.
+    /// </summary>
+    API_FIELD() int32 ProceduralLayer = -1;
+
+    /// <summary>
+    /// The minimum terrain layer weight (normalized 0-1) required to place the procedural foliage instance.
+    /// </summary>
+    API_FIELD() float ProceduralLayerThreshold = 0.1f;
+
+    /// <summary>
+    /// The size (in world units) of the noise pattern used to break up the procedural foliage density. Use 0 to disable noise.
+    /// </summary>
+    API_FIELD() float ProceduralNoiseSize = 0.0f;
+
+    /// <summary>
+    /// The minimum noise value (normalized 0-1) required to place the procedural foliage instance.
+    /// </summary>
+    API_FIELD() float ProceduralNoiseThreshold = 0.5f;
+
     /// <summary>
     /// Determines whenever this meshes can receive decals.
     /// </summary>
@@ -221,6 +250,11 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API FoliageType : public ScriptingOb
     /// </summary>
     Float3 GetRandomScale() const;
 
+    /// <summary>
+    /// Gets the random scale for the foliage instance of this type using the given deterministic random numbers stream.
+    /// </summary>
+    Float3 GetRandomScale(const class RandomStream& random) const;
+
 private:
     void OnModelChanged();
     void OnModelLoaded();
@@ -0,0 +1,274 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "GPUReadback.h"
+#include "GPUSyncPoint.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Engine/EngineService.h"
+#include "Engine/Graphics/GPUBuffer.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/RenderTools.h"
+#include "Engine/Graphics/Textures/GPUTexture.h"
+#include "Engine/Graphics/Textures/TextureData.h"
+#include "Engine/Platform/CriticalSection.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+
+// The amount of frames after which unused staging resources are released
+#define GPU_READBACK_POOL_TIMEOUT 60
+
+namespace
+{
+    struct ReadbackRequest
+    {
+        uint64 ID;
+        uint64 Frame;
+        GPUBuffer* Buffer;
+        GPUTexture* Texture;
+        uint32 Size;
+        GPUReadback::BufferCallback BufferCallback;
+        GPUReadback::TextureCallback TextureCallback;
+    };
+
+    struct PoolItem
+    {
+        GPUResource* Resource;
+        uint64 LastUsedFrame;
+    };
+
+    CriticalSection Locker;
+    uint64 NextID = 1;
+    Array<ReadbackRequest> Requests;
+    Array<PoolItem> BuffersPool;
+    Array<PoolItem> TexturesPool;
+
+    GPUBuffer* AllocateBuffer(uint32 size)
+    {
+        // Pick the smallest free staging buffer that fits the data
+        int32 best = -1;
+        for (int32 i = 0; i < BuffersPool.Count(); i++)
+        {
+            const uint32 bufferSize = ((GPUBuffer*)BuffersPool[i].Resource)->GetSize();
+            if (bufferSize >= size && (best == -1 || bufferSize < ((GPUBuffer*)BuffersPool[best].Resource)->GetSize()))
+                best = i;
+        }
+        if (best != -1)
+        {
+            const auto buffer = (GPUBuffer*)BuffersPool[best].Resource;
+            BuffersPool.RemoveAt(best);
+            return buffer;
+        }
+
+        // Create a new one (aligned to reuse it for a different sizes)
+        const auto buffer = GPUDevice::Instance->CreateBuffer(TEXT("GPUReadback.Buffer"));
+        if (buffer->Init(GPUBufferDescription::Buffer(Math::AlignUp<uint32>(size, 256), GPUBufferFlags::None, PixelFormat::Unknown, nullptr, 0, GPUResourceUsage::StagingReadback)))
+        {
+            LOG(Error, "Failed to create GPU readback buffer.");
+            Delete(buffer);
+            return nullptr;
+        }
+        return buffer;
+    }
+
+    GPUTexture* AllocateTexture(const GPUTextureDescription& desc)
+    {
+        for (int32 i = 0; i < TexturesPool.Count(); i++)
+        {
+            const auto texture = (GPUTexture*)TexturesPool[i].Resource;
+            if (texture->GetDescription().Equals(desc))
+            {
+                TexturesPool.RemoveAt(i);
+                return texture;
+            }
+        }
+        const auto texture = GPUDevice::Instance->CreateTexture(TEXT("GPUReadback.Texture"));
+        if (texture->Init(desc))
+        {
+            LOG(Error, "Failed to create GPU readback texture.");
+            Delete(texture);
+            return nullptr;
+        }
+        return texture;
+    }
+
+    void ReleaseToPool(const ReadbackRequest& request)
+    {
+        if (request.Buffer)
+            BuffersPool.Add({ request.Buffer, Engine::FrameCount });
+        if (request.Texture)
+            TexturesPool.Add({ request.Texture, Engine::FrameCount });
+    }
+
+    void UpdatePool(Array<PoolItem>& pool, uint64 frame)
+    {
+        for (int32 i = pool.Count() - 1; i >= 0; i--)
+        {
+            if (frame - pool[i].LastUsedFrame > GPU_READBACK_POOL_TIMEOUT)
+            {
+                SAFE_DELETE_GPU_RESOURCE(pool[i].Resource);
+                pool.RemoveAt(i);
+            }
+        }
+    }
+
+    void ClearPool(Array<PoolItem>& pool)
+    {
+        for (auto& e : pool)
+            SAFE_DELETE_GPU_RESOURCE(e.Resource);
+        pool.Clear();
+    }
+}
+
+class GPUReadbackService : public EngineService
+{
+public:
+    GPUReadbackService()
+        : EngineService(TEXT("GPU Readback"), -39)
+    {
+    }
+
+    void Draw() override;
+    void Dispose() override;
+};
+
+GPUReadbackService GPUReadbackServiceInstance;
+
+uint64 GPUReadback::ReadBuffer(GPUContext* context, GPUBuffer* buffer, const BufferCallback& callback, uint32 size, uint32 offset)
+{
+    CHECK_RETURN(context && buffer && callback.IsBinded(), 0);
+    if (size == 0)
+        size = buffer->GetSize() - Math::Min(offset, buffer->GetSize());
+    if (size == 0 || offset + size > buffer->GetSize())
+    {
+        LOG(Warning, "Invalid GPU readback range of buffer {0}.", buffer->ToString());
+        return 0;
+    }
+    ScopeLock lock(Locker);
+    GPUBuffer* staging = AllocateBuffer(size);
+    if (!staging)
+        return 0;
+    context->CopyBuffer(staging, buffer, size, 0, offset);
+    auto& request = Requests.AddOne();
+    request.ID = NextID++;
+    request.Frame = Engine::FrameCount;
+    request.Buffer = staging;
+    request.Texture = nullptr;
+    request.Size = size;
+    request.BufferCallback = callback;
+    request.TextureCallback = TextureCallback();
+    return request.ID;
+}
+
+uint64 GPUReadback::ReadTexture(GPUContext* context, GPUTexture* texture, int32 mipIndex, int32 arrayIndex, const TextureCallback& callback)
+{
+    CHECK_RETURN(context && texture && callback.IsBinded(), 0);
+    const auto& textureDesc = texture->GetDescription();
+    if (mipIndex < 0 || mipIndex >= texture->MipLevels() || arrayIndex < 0 || arrayIndex >= texture->ArraySize() || textureDesc.IsMultiSample())
+    {
+        LOG(Warning, "Invalid GPU readback subresource of texture {0}.", texture->ToString());
+        return 0;
+    }
+
+    // Staging texture matches the size of a single subresource
+    GPUTextureDescription desc = textureDesc.ToStagingReadback();
+    desc.Dimensions = textureDesc.IsVolume() ? TextureDimensions::VolumeTexture : TextureDimensions::Texture;
+    desc.Width = Math::Max(textureDesc.Width >> mipIndex, 1);
+    desc.Height = Math::Max(textureDesc.Height >> mipIndex, 1);
+    desc.Depth = textureDesc.IsVolume() ? Math::Max(textureDesc.Depth >> mipIndex, 1) : 1;
+    desc.ArraySize = 1;
+    desc.MipLevels = 1;
+    ScopeLock lock(Locker);
+    GPUTexture* staging = AllocateTexture(desc);
+    if (!staging)
+        return 0;
+    context->CopySubresource(staging, 0, texture, RenderTools::CalcSubresourceIndex(mipIndex, arrayIndex, texture->MipLevels()));
+    auto& request = Requests.AddOne();
+    request.ID = NextID++;
+    request.Frame = Engine::FrameCount;
+    request.Buffer = nullptr;
+    request.Texture = staging;
+    request.Size = 0;
+    request.BufferCallback = BufferCallback();
+    request.TextureCallback = callback;
+    return request.ID;
+}
+
+void GPUReadback::Cancel(uint64 id)
+{
+    ScopeLock lock(Locker);
+    for (auto& request : Requests)
+    {
+        if (request.ID == id)
+        {
+            // Request stays in the queue until the copy is done (to reuse the staging resource) but without a callback
+            request.ID = 0;
+            request.BufferCallback = BufferCallback();
+            request.TextureCallback = TextureCallback();
+            break;
+        }
+    }
+}
+
+void GPUReadbackService::Draw()
+{
+    ScopeLock lock(Locker);
+    if (Requests.IsEmpty() && BuffersPool.IsEmpty() && TexturesPool.IsEmpty())
+        return;
+    PROFILE_CPU_NAMED("GPU Readback");
+    const uint64 frame = Engine::FrameCount;
+
+    // Process the requests which copies have been completed by the GPU (requests are sorted by the frame)
+    int32 count = 0;
+    while (count < Requests.Count() && frame - Requests[count].Frame > GPU_ASYNC_LATENCY)
+        count++;
+    for (int32 i = 0; i < count; i++)
+    {
+        // Callbacks are invoked with the lock held so Cancel won't return during the callback invocation (new requests can be added from the callback)
+        ReadbackRequest request = MoveTemp(Requests[i]);
+        if (request.ID == 0)
+        {
+            // Canceled
+        }
+        else if (request.Buffer)
+        {
+            if (auto data = (byte*)request.Buffer->Map(GPUResourceMapMode::Read))
+            {
+                request.BufferCallback(Span<byte>(data, (int32)request.Size));
+                request.Buffer->Unmap();
+            }
+            else
+            {
+                request.BufferCallback(Span<byte>());
+            }
+        }
+        else
+        {
+            TextureMipData data;
+            if (request.Texture->GetData(0, 0, data))
+                data = TextureMipData();
+            request.TextureCallback(data);
+        }
+        ReleaseToPool(request);
+    }
+    for (int32 i = count; i < Requests.Count(); i++)
+        Requests[i - count] = MoveTemp(Requests[i]);
+    Requests.Resize(Requests.Count() - count);
+
+    // Release unused staging resources
+    UpdatePool(BuffersPool, frame);
+    UpdatePool(TexturesPool, frame);
+}
+
+void GPUReadbackService::Dispose()
+{
+    ScopeLock lock(Locker);
+    for (auto& request : Requests)
+    {
+        SAFE_DELETE_GPU_RESOURCE(request.Buffer);
+        SAFE_DELETE_GPU_RESOURCE(request.Texture);
+    }
+    Requests.Clear();
+    ClearPool(BuffersPool);
+    ClearPool(TexturesPool);
+}
@@ -0,0 +1,58 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Delegate.h"
+#include "Engine/Core/Types/Span.h"
+
+class GPUContext;
+class GPUBuffer;
+class GPUTexture;
+class TextureMipData;
+
+/// <summary>
+/// Asynchronous GPU data readback utility. Copies the GPU resource data into the pooled staging resources and invokes the callback once the data can be read on a CPU (after GPU_ASYNC_LATENCY frames) so the CPU never waits for the GPU to finish the work.
+/// </summary>
+/// <remarks>Callbacks are invoked on the main thread during frame rendering (before the render tasks). Readback data is valid only during the callback.</remarks>
+class FLAXENGINE_API GPUReadback
+{
+public:
+    /// <summary>
+    /// The buffer readback callback. Data is empty if readback failed (eg. mapping staging memory failed).
+    /// </summary>
+    typedef Function<void(Span<byte> data)> BufferCallback;
+
+    /// <summary>
+    /// The texture readback callback. Data is empty if readback failed (eg. mapping staging memory failed).
+    /// </summary>
+    typedef Function<void(const TextureMipData& data)> TextureCallback;
+
+public:
+    /// <summary>
+    /// Requests the asynchronous readback of the buffer data. Copy is recorded into the given context immediately so the source buffer can be modified right after this call.
+    /// </summary>
+    /// <param name="context">The GPU context to record the copy.</param>
+    /// <param name="buffer">The source buffer.</param>
+    /// <param name="callback">The callback to invoke with the read data.</param>
+    /// <param name="size">The amount of bytes to read. Use 0 to read the whole buffer (from the offset).</param>
+    /// <param name="offset">The offset (in bytes) of the data to read.</param>
+    /// <returns>The readback request identifier (can be used to cancel it) or 0 if failed.</returns>
+    static uint64 ReadBuffer(GPUContext* context, GPUBuffer* buffer, const BufferCallback& callback, uint32 size = 0, uint32 offset = 0);
+
+    /// <summary>
+    /// Requests the asynchronous readback of the texture subresource data (single mip of a single array slice or cube face). Copy is recorded into the given context immediately so the source texture can be modified right after this call.
+    /// </summary>
+    /// <param name="context">The GPU context to record the copy.</param>
+    /// <param name="texture">The source texture (multi-sampled textures are not supported).</param>
+    /// <param name="mipIndex">The mip level to read.</param>
+    /// <param name="arrayIndex">The array slice (or cube face) to read.</param>
+    /// <param name="callback">The callback to invoke with the read data.</param>
+    /// <returns>The readback request identifier (can be used to cancel it) or 0 if failed.</returns>
+    static uint64 ReadTexture(GPUContext* context, GPUTexture* texture, int32 mipIndex, int32 arrayIndex, const TextureCallback& callback);
+
+    /// <summary>
+    /// Cancels the pending readback request (callback won't be invoked). Use it when the callback owner gets destroyed before the readback is completed.
+    /// </summary>
+    /// <param name="id">The readback request identifier.</param>
+    static void Cancel(uint64 id);
+};
@@ -83,6 +83,15 @@ class GPUTask : public Task
         return IsRunning() && _syncPoint != 0;
     }
 
+    /// <summary>
+    /// Gets the resource written by this task if it uses only copy commands on it (eg. data upload). Such tasks can be executed on a dedicated copy queue (if supported by the graphics backend).
+    /// </summary>
+    /// <returns>The destination resource or null if task uses other GPU commands.</returns>
+    virtual GPUResource* GetCopyDestination() const
+    {
+        return nullptr;
+    }
+
 public:
     /// <summary>
     /// Executes this task.
@@ -70,10 +70,20 @@ void GPUTasksContext::OnFrameBegin()
     ++_currentSyncPoint;
 
     // Try to flush done jobs
-    auto currentSyncPointGPU = _currentSyncPoint - GPU_ASYNC_LATENCY;
+    SyncDone(_currentSyncPoint - GPU_ASYNC_LATENCY);
+}
+
+void GPUTasksContext::OnFrameBegin(GPUSyncPoint currentSyncPoint, GPUSyncPoint completedSyncPoint)
+{
+    _currentSyncPoint = currentSyncPoint;
+    SyncDone(completedSyncPoint);
+}
+
+void GPUTasksContext::SyncDone(GPUSyncPoint syncPoint)
+{
     for (int32 i = 0; i < _tasksDone.Count(); i++)
     {
-        if (_tasksDone[i]->GetSyncPoint() <= currentSyncPointGPU)
+        if (_tasksDone[i]->GetSyncPoint() <= syncPoint)
         {
             // TODO: add stats counter and count performed jobs, print to log on exit.
 
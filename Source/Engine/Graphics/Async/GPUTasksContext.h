@@ -77,5 +77,15 @@ class GPUTasksContext
 public:
     void OnFrameBegin();
 
+    /// <summary>
+    /// Begins the frame for the context which GPU work completion is tracked with a fence (instead of the fixed frames latency).
+    /// </summary>
+    /// <param name="currentSyncPoint">The sync point of the next GPU work submission (eg. the fence value to be signaled).</param>
+    /// <param name="completedSyncPoint">The sync point of the GPU work already completed (eg. the completed fence value).</param>
+    void OnFrameBegin(GPUSyncPoint currentSyncPoint, GPUSyncPoint completedSyncPoint);
+
     void OnFrameEnd();
+
+private:
+    void SyncDone(GPUSyncPoint syncPoint);
 };
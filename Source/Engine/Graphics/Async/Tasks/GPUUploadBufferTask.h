@@ -52,6 +52,11 @@ class GPUUploadBufferTask : public GPUTask
         return _buffer == resource;
     }
 
+    GPUResource* GetCopyDestination() const override
+    {
+        return _buffer.Get();
+    }
+
 protected:
     // [GPUTask]
     Result run(GPUTasksContext* context) override
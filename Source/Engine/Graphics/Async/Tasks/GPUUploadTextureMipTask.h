@@ -56,6 +56,11 @@ class GPUUploadTextureMipTask : public GPUTask
         return _texture == resource;
     }
 
+    GPUResource* GetCopyDestination() const override
+    {
+        return _texture.Get();
+    }
+
 protected:
     // [GPUTask]
     Result run(GPUTasksContext* context) override
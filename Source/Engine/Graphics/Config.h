@@ -22,6 +22,9 @@
 // Amount of initial slots used for global samplers (static, 4 common samplers + 2 comparision samplers)
 #define GPU_STATIC_SAMPLERS_COUNT 6
 
+// Maximum amount of shader resources in the global bindless descriptors table (see GPULimits::HasBindlessResources)
+#define GPU_MAX_BINDLESS_RESOURCES (64 * 1024)
+
 // Maximum amount of binded vertex buffers at the same time
 #define GPU_MAX_VB_BINDED 4
 
@@ -28,22 +28,9 @@ void DynamicBuffer::Flush()
     const uint32 size = Data.Count();
     if (size > 0)
     {
-        // Check if has no buffer
-        if (_buffer == nullptr)
-            _buffer = GPUDevice::Instance->CreateBuffer(_name);
-
-        // Check if need to resize buffer
-        if (_buffer->GetSize() < size)
-        {
-            const uint32 numElements = Math::AlignUp<uint32>(static_cast<uint32>((size / _stride) * 1.3f), 32);
-            GPUBufferDescription desc;
-            InitDesc(desc, numElements);
-            if (_buffer->Init(desc))
-            {
-                LOG(Fatal, "Cannot setup dynamic buffer '{0}'! Size: {1}", _name, Utilities::BytesToText(size));
-                return;
-            }
-        }
+        // Ensure to have buffer with enough capacity
+        if (Resize(size))
+            return;
 
         // Upload data to the buffer
         if (GPUDevice::Instance->IsRendering())
@@ -65,28 +52,60 @@ void DynamicBuffer::Flush(GPUContext* context)
     const uint32 size = Data.Count();
     if (size > 0)
     {
-        // Check if has no buffer
-        if (_buffer == nullptr)
-            _buffer = GPUDevice::Instance->CreateBuffer(_name);
-
-        // Check if need to resize buffer
-        if (_buffer->GetSize() < size)
-        {
-            const uint32 numElements = Math::AlignUp<uint32>(static_cast<uint32>((size / _stride) * 1.3f), 32);
-            GPUBufferDescription desc;
-            InitDesc(desc, numElements);
-            if (_buffer->Init(desc))
-            {
-                LOG(Fatal, "Cannot setup dynamic buffer '{0}'! Size: {1}", _name, Utilities::BytesToText(size));
-                return;
-            }
-        }
+        // Ensure to have buffer with enough capacity
+        if (Resize(size))
+            return;
 
         // Upload data to the buffer
         context->UpdateBuffer(_buffer, Data.Get(), size);
     }
 }
 
+void DynamicBuffer::Map(GPUContext* context, uint32 size)
+{
+    ASSERT(!_mapped);
+    Data.Clear();
+    if (size == 0 || Resize(size))
+        return;
+
+    // Write directly into the upload memory if supported, otherwise fallback to Data
+    _mapped = (byte*)context->UpdateBufferMapped(_buffer, size);
+    _mappedSize = 0;
+    _mappedCapacity = _mapped ? size : 0;
+}
+
+void DynamicBuffer::Unmap(GPUContext* context)
+{
+    if (_mapped)
+    {
+        _mapped = nullptr;
+        _mappedCapacity = 0;
+        return;
+    }
+    Flush(context);
+}
+
+bool DynamicBuffer::Resize(uint32 size)
+{
+    // Check if has no buffer
+    if (_buffer == nullptr)
+        _buffer = GPUDevice::Instance->CreateBuffer(_name);
+
+    // Check if need to resize buffer
+    if (_buffer->GetSize() < size)
+    {
+        const uint32 numElements = Math::AlignUp<uint32>(static_cast<uint32>((size / _stride) * 1.3f), 32);
+        GPUBufferDescription desc;
+        InitDesc(desc, numElements);
+        if (_buffer->Init(desc))
+        {
+            LOG(Fatal, "Cannot setup dynamic buffer '{0}'! Size: {1}", _name, Utilities::BytesToText(size));
+            return true;
+        }
+    }
+    return false;
+}
+
 void DynamicBuffer::Dispose()
 {
     SAFE_DELETE_GPU_RESOURCE(_buffer);
@@ -14,6 +14,9 @@ class FLAXENGINE_API DynamicBuffer
     GPUBuffer* _buffer;
     String _name;
     uint32 _stride;
+    byte* _mapped = nullptr;
+    uint32 _mappedSize = 0;
+    uint32 _mappedCapacity = 0;
 
 public:
     NON_COPYABLE(DynamicBuffer);
@@ -60,7 +63,10 @@ class FLAXENGINE_API DynamicBuffer
     template<typename T>
     FORCE_INLINE void Write(const T& data)
     {
-        Data.Add((byte*)&data, sizeof(T));
+        if (_mapped)
+            Platform::MemoryCopy(WriteReserve(sizeof(T)), &data, sizeof(T));
+        else
+            Data.Add((byte*)&data, sizeof(T));
     }
 
     /// <summary>
@@ -70,7 +76,10 @@ class FLAXENGINE_API DynamicBuffer
     /// <param name="size">Amount of data to write (in bytes)</param>
     FORCE_INLINE void Write(const void* bytes, int32 size)
     {
-        Data.Add((byte*)bytes, size);
+        if (_mapped)
+            Platform::MemoryCopy(WriteReserve(size), bytes, size);
+        else
+            Data.Add((byte*)bytes, size);
     }
 
     /// <summary>
@@ -79,6 +88,13 @@ class FLAXENGINE_API DynamicBuffer
     /// <param name="size">Amount of data to allocate (in bytes)</param>
     FORCE_INLINE byte* WriteReserve(int32 size)
     {
+        if (_mapped)
+        {
+            ASSERT_LOW_LAYER(_mappedSize + size <= _mappedCapacity);
+            byte* result = _mapped + _mappedSize;
+            _mappedSize += size;
+            return result;
+        }
         const int32 start = Data.Count();
         Data.AddUninitialized(size);
         return Data.Get() + start;
@@ -105,12 +121,26 @@ class FLAXENGINE_API DynamicBuffer
     /// <param name="context">The GPU command list context to use for data uploading.</param>
     void Flush(class GPUContext* context);
 
+    /// <summary>
+    /// Begins writing data directly into the GPU upload memory (persistently mapped ring on supported platforms) to skip the intermediate copy from Data. Write and WriteReserve return the mapped memory until Unmap is called (memory is write-only, don't read from it). Buffer gets resized to fit the size if needed (previous contents are discarded).
+    /// </summary>
+    /// <param name="context">The GPU command list context to use for data uploading.</param>
+    /// <param name="size">The total amount of data to write (in bytes).</param>
+    void Map(class GPUContext* context, uint32 size);
+
+    /// <summary>
+    /// Ends writing data started with Map (flushes Data if mapped memory is not supported, it will be ready for a draw).
+    /// </summary>
+    /// <param name="context">The GPU command list context to use for data uploading.</param>
+    void Unmap(class GPUContext* context);
+
     /// <summary>
     /// Disposes the buffer resource and clears the used memory.
     /// </summary>
     void Dispose();
 
 protected:
+    bool Resize(uint32 size);
     virtual void InitDesc(GPUBufferDescription& desc, int32 numElements) = 0;
 };
 
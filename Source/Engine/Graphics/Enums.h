@@ -695,6 +695,11 @@ API_ENUM() enum class PostProcessEffectLocation
     /// </summary>
     AfterForwardPass = 7,
 
+    /// <summary>
+    /// The custom temporal up-scaling that replaces default Temporal Anti-Aliasing and frame up-scaling (eg. vendor-specific upscaler). Used only when rendering at lower resolution with TAA and upscaling before post processing. Input is the jittered frame at rendering resolution, output is at the output viewport resolution (post processing, motion blur and UI are rendered after it).
+    /// </summary>
+    CustomTemporalUpscale = 8,
+
     API_ENUM(Attributes="HideInEditor")
     MAX,
 };
@@ -751,6 +756,12 @@ API_ENUM(Attributes="Flags") enum class DrawPass : int32
     API_ENUM(Attributes="HideInEditor")
     QuadOverdraw = 1 << 20,
 
+    /// <summary>
+    /// The texture streaming feedback rendering (records mip levels sampled by the materials).
+    /// </summary>
+    API_ENUM(Attributes="HideInEditor")
+    TextureFeedback = 1 << 21,
+
     /// <summary>
     /// The default set of draw passes for the scene objects.
     /// </summary>
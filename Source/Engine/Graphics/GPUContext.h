@@ -226,6 +226,18 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API GPUContext : public ScriptingObj
     /// <param name="offset">The offset (in bytes) from the buffer start to copy data to.</param>
     API_FUNCTION() virtual void UpdateBuffer(GPUBuffer* buffer, const void* data, uint32 size, uint32 offset = 0) = 0;
 
+    /// <summary>
+    /// Updates the buffer data by writing it directly into the persistently mapped upload memory (without an intermediate copy). Records the buffer update and returns the pointer to the write-only memory that has to be filled with data before the context commands get submitted (eg. within the current frame rendering).
+    /// </summary>
+    /// <param name="buffer">The destination buffer to write to.</param>
+    /// <param name="size">The data size (in bytes) to write.</param>
+    /// <param name="offset">The offset (in bytes) from the buffer start to copy data to.</param>
+    /// <returns>The pointer to the mapped upload memory to write data to or null if not supported (use UpdateBuffer instead).</returns>
+    virtual void* UpdateBufferMapped(GPUBuffer* buffer, uint32 size, uint32 offset = 0)
+    {
+        return nullptr;
+    }
+
     /// <summary>
     /// Copies the buffer data.
     /// </summary>
@@ -444,6 +456,14 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API GPUContext : public ScriptingObj
     /// <param name="offsetForArgs">The aligned byte offset for arguments.</param>
     API_FUNCTION() virtual void DispatchIndirect(GPUShaderProgramCS* shader, GPUBuffer* bufferForArgs, uint32 offsetForArgs) = 0;
 
+    /// <summary>
+    /// Begins or ends the unordered access resources overlap region. Compute shader dispatches within the region are not separated with UAV barriers so they can execute simultaneously on GPU. Use it only for dispatches that don't read data written by the other dispatches from the region (eg. writing to different parts of the same resource).
+    /// </summary>
+    /// <param name="end">False to begin the region, true to end it (places a barrier so the next commands can read the results).</param>
+    API_FUNCTION() virtual void OverlapUA(bool end)
+    {
+    }
+
     /// <summary>
     /// Resolves the multisampled texture by performing a copy of the resource into a non-multisampled resource.
     /// </summary>
@@ -581,6 +601,14 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API GPUContext : public ScriptingObj
     /// <param name="scissorRect">The scissor rectangle (in pixels).</param>
     API_FUNCTION() virtual void SetScissor(API_PARAM(Ref) const Rectangle& scissorRect) = 0;
 
+    /// <summary>
+    /// Sets the shading rate image for the Variable Rate Shading of the next draws (see GPULimits::HasVariableRateShading). Each texel (R8_UInt) covers the tile of GPULimits::VariableRateShadingTileSize pixels and contains the shading rate encoded as (log2(width) << 2) | log2(height) (eg. 0 for 1x1, 5 for 2x2). The image must not be written while it's set.
+    /// </summary>
+    /// <param name="shadingRate">The shading rate image, or null to disable the variable rate shading.</param>
+    API_FUNCTION() virtual void SetShadingRate(GPUTexture* shadingRate)
+    {
+    }
+
 public:
     /// <summary>
     /// Sets the graphics pipeline state.
@@ -614,6 +642,11 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API GPUContext : public ScriptingObj
     /// </summary>
     virtual void SetResourceState(GPUResource* resource, uint64 state, int32 subresource = -1);
 
+    /// <summary>
+    /// Sets the state of the resource (or subresource) to be readable by the shaders without binding it to the slot (eg. texture accessed via bindless index).
+    /// </summary>
+    virtual void SetResourceShaderReadState(GPUResource* resource, int32 subresource = -1);
+
     /// <summary>
     /// Forces graphics backend to rebind descriptors after command list was used by external graphics library.
     /// </summary>
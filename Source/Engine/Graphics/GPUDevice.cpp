@@ -9,6 +9,7 @@
 #include "RenderTools.h"
 #include "Graphics.h"
 #include "Shaders/GPUShader.h"
+#include "Shaders/Cache/ShaderUsageRecorder.h"
 #include "Async/DefaultGPUTasksExecutor.h"
 #include "Async/GPUTasksManager.h"
 #include "Engine/Core/Log.h"
@@ -99,6 +100,18 @@ bool GPUPipelineState::Init(const Description& desc)
     CHECK_STAGE(PS);
 #undef CHECK_STAGE
 
+#if !BUILD_RELEASE
+    // Track used shader permutations for the cook-time variants stripping
+    if (ShaderUsageRecorder::Enabled)
+    {
+        ShaderUsageRecorder::OnUsed(desc.VS);
+        ShaderUsageRecorder::OnUsed(desc.HS);
+        ShaderUsageRecorder::OnUsed(desc.DS);
+        ShaderUsageRecorder::OnUsed(desc.GS);
+        ShaderUsageRecorder::OnUsed(desc.PS);
+    }
+#endif
+
 #if USE_EDITOR
     // Estimate somehow performance cost of this pipeline state for the content profiling
     const int32 textureLookupCost = 20;
@@ -653,6 +666,11 @@ uint64 GPUDevice::GetMemoryUsage() const
     return result;
 }
 
+uint64 GPUDevice::GetMemoryBudget() const
+{
+    return TotalGraphicsMemory;
+}
+
 Array<GPUResource*> GPUDevice::GetResources() const
 {
     _resourcesLock.Lock();
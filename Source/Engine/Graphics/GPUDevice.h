@@ -225,6 +225,11 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API GPUDevice : public ScriptingObje
     /// </summary>
     API_PROPERTY() uint64 GetMemoryUsage() const;
 
+    /// <summary>
+    /// Gets the amount of GPU memory (in bytes) that the application can use without exceeding the system limits (as reported by the driver, eg. via DXGI QueryVideoMemoryInfo or VK_EXT_memory_budget). Value may change at runtime (eg. when other applications allocate video memory). Uses total graphics memory if not supported by the backend.
+    /// </summary>
+    API_PROPERTY() virtual uint64 GetMemoryBudget() const;
+
     /// <summary>
     /// Gets the list with all active GPU resources.
     /// </summary>
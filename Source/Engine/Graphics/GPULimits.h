@@ -279,6 +279,26 @@ API_STRUCT() struct GPULimits
     /// </summary>
     API_FIELD() bool HasTypedUAVLoad;
 
+    /// <summary>
+    /// True if device supports sparse (partially resident) 2D textures with memory committed on demand (see GPUTextureFlags::Sparse).
+    /// </summary>
+    API_FIELD() bool HasSparseTextures;
+
+    /// <summary>
+    /// True if device supports the image-based Variable Rate Shading (per-tile shading rate for rasterization, see GPUContext::SetShadingRate).
+    /// </summary>
+    API_FIELD() bool HasVariableRateShading;
+
+    /// <summary>
+    /// The size (in pixels) of the screen tile covered by a single texel of the shading rate image. Valid only if HasVariableRateShading is set.
+    /// </summary>
+    API_FIELD() int32 VariableRateShadingTileSize;
+
+    /// <summary>
+    /// True if device supports the bindless shader resources (global descriptors table accessed in shaders by the index, see GPUResourceView::GetBindlessIndex).
+    /// </summary>
+    API_FIELD() bool HasBindlessResources;
+
     /// <summary>
     /// The maximum amount of texture mip levels.
     /// </summary>
@@ -5,6 +5,7 @@
 #include "Engine/Core/Types/BaseTypes.h"
 #include "Shaders/GPUShaderProgram.h"
 #include "Enums.h"
+#include "PixelFormat.h"
 #include "GPUResource.h"
 
 /// <summary>
@@ -220,6 +221,17 @@ API_CLASS(Sealed) class FLAXENGINE_API GPUPipelineState : public GPUResource
     /// <returns>True if cannot create state, otherwise false</returns>
     API_FUNCTION() virtual bool Init(API_PARAM(Ref) const Description& desc);
 
+    /// <summary>
+    /// Compiles the backend pipeline state object for the given render targets setup ahead of the first draw (to avoid hitches during rendering). Can be called from any thread before the state gets used for rendering. Does nothing on backends that create the whole pipeline within Init.
+    /// </summary>
+    /// <param name="depthFormat">The depth buffer format (or PixelFormat::Unknown if not used).</param>
+    /// <param name="rtCount">The render targets count (can be 0).</param>
+    /// <param name="rtFormats">The render targets formats array.</param>
+    /// <param name="msaa">The multi-sample anti-aliasing level.</param>
+    virtual void Precompile(PixelFormat depthFormat, int32 rtCount, const PixelFormat* rtFormats, MSAALevel msaa = MSAALevel::None)
+    {
+    }
+
 public:
     // [GPUResource]
     GPUResourceType GetResourceType() const final override;
@@ -205,4 +205,13 @@ API_CLASS(Abstract, NoSpawn, Attributes="HideInEditor") class FLAXENGINE_API GPU
     /// Gets the native pointer to the underlying view. It's a platform-specific handle.
     /// </summary>
     virtual void* GetNativePtr() const = 0;
+
+    /// <summary>
+    /// Gets the index of the view shader resource within the global bindless resources table (see GPULimits::HasBindlessResources). Can be passed to the shaders via constant buffer to access the resource without binding it to the slot (eg. BINDLESS_TEXTURE_2D(index) in Bindless.hlsl).
+    /// </summary>
+    /// <returns>The bindless index or -1 if not supported or view has no shader resource.</returns>
+    API_PROPERTY() virtual int32 GetBindlessIndex() const
+    {
+        return -1;
+    }
 };
@@ -4,6 +4,44 @@
 
 #include "GPUResource.h"
 
+/// <summary>
+/// The GPU pipeline statistics gathered by the query (amount of the processed vertices, primitives and shader invocations).
+/// </summary>
+API_STRUCT(NoDefault) struct FLAXENGINE_API GPUPipelineStatistics
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(GPUPipelineStatistics);
+
+    /// <summary>
+    /// The amount of vertices read by the input assembler.
+    /// </summary>
+    API_FIELD() uint64 InputVertices;
+
+    /// <summary>
+    /// The amount of primitives read by the input assembler.
+    /// </summary>
+    API_FIELD() uint64 InputPrimitives;
+
+    /// <summary>
+    /// The amount of vertex shader invocations.
+    /// </summary>
+    API_FIELD() uint64 VertexShaderInvocations;
+
+    /// <summary>
+    /// The amount of primitives sent to the rasterizer (after clipping).
+    /// </summary>
+    API_FIELD() uint64 RasterizedPrimitives;
+
+    /// <summary>
+    /// The amount of pixel shader invocations.
+    /// </summary>
+    API_FIELD() uint64 PixelShaderInvocations;
+
+    /// <summary>
+    /// The amount of compute shader invocations.
+    /// </summary>
+    API_FIELD() uint64 ComputeShaderInvocations;
+};
+
 /// <summary>
 /// Represents a GPU query that measures execution time of GPU operations.
 /// The query will measure any GPU operations that take place between its Begin() and End() calls.
@@ -11,6 +49,12 @@
 /// <seealso cref="GPUResource" />
 class FLAXENGINE_API GPUTimerQuery : public GPUResource
 {
+public:
+    /// <summary>
+    /// Enables the pipeline statistics collection between the Begin/End calls (if supported by the graphics backend). Has additional GPU overhead so it's disabled by default. Has to be set before calling Begin.
+    /// </summary>
+    bool CollectPipelineStatistics = false;
+
 public:
     /// <summary>
     /// Finalizes an instance of the <see cref="GPUTimerQuery"/> class.
@@ -42,6 +86,16 @@ class FLAXENGINE_API GPUTimerQuery : public GPUResource
     /// <returns>The time in milliseconds.</returns>
     virtual float GetResult() = 0;
 
+    /// <summary>
+    /// Gets the query pipeline statistics result. Valid only if query has been started with CollectPipelineStatistics enabled and has result.
+    /// </summary>
+    /// <param name="result">The result pipeline statistics.</param>
+    /// <returns>True if got the valid statistics, otherwise false (eg. not supported by the graphics backend).</returns>
+    virtual bool GetPipelineStatistics(GPUPipelineStatistics& result)
+    {
+        return false;
+    }
+
 public:
     // [GPUResource]
     String ToString() const override
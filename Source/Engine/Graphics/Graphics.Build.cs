@@ -92,6 +92,7 @@ public override void Setup(BuildOptions options)
         }
 
         options.PrivateDependencies.Add("TextureTool");
+        options.PrivateDependencies.Add("meshoptimizer");
         if (options.Target.IsEditor)
         {
             options.PublicDependencies.Add("ModelTool");
@@ -15,11 +15,21 @@ Quality Graphics::AAQuality = Quality::Medium;
 Quality Graphics::SSRQuality = Quality::Medium;
 Quality Graphics::SSAOQuality = Quality::Medium;
 Quality Graphics::VolumetricFogQuality = Quality::High;
+bool Graphics::VolumetricFogCheckerboard = false;
 Quality Graphics::ShadowsQuality = Quality::Medium;
 Quality Graphics::ShadowMapsQuality = Quality::Medium;
 bool Graphics::AllowCSMBlending = false;
+bool Graphics::GPUInstancesCulling = false;
+bool Graphics::GPUFoliageCulling = false;
+bool Graphics::OcclusionCulling = false;
+bool Graphics::StaticShadowsCaching = false;
+int32 Graphics::RenderTargetPoolBudget = 0;
+bool Graphics::VariableRateShading = false;
+bool Graphics::MeshGeometryPool = false;
+bool Graphics::GPUSkinning = false;
 Quality Graphics::GlobalSDFQuality = Quality::High;
 Quality Graphics::GIQuality = Quality::High;
+int32 Graphics::GIRaysBudget = 0;
 PostProcessSettings Graphics::PostProcessSettings;
 
 #if GRAPHICS_API_NULL
@@ -63,11 +73,21 @@ void GraphicsSettings::Apply()
     Graphics::SSRQuality = SSRQuality;
     Graphics::SSAOQuality = SSAOQuality;
     Graphics::VolumetricFogQuality = VolumetricFogQuality;
+    Graphics::VolumetricFogCheckerboard = VolumetricFogCheckerboard;
     Graphics::ShadowsQuality = ShadowsQuality;
     Graphics::ShadowMapsQuality = ShadowMapsQuality;
     Graphics::AllowCSMBlending = AllowCSMBlending;
+    Graphics::GPUInstancesCulling = GPUInstancesCulling;
+    Graphics::GPUFoliageCulling = GPUFoliageCulling;
+    Graphics::OcclusionCulling = OcclusionCulling;
+    Graphics::StaticShadowsCaching = StaticShadowsCaching;
+    Graphics::RenderTargetPoolBudget = RenderTargetPoolBudget;
+    Graphics::VariableRateShading = VariableRateShading;
+    Graphics::MeshGeometryPool = MeshGeometryPool;
+    Graphics::GPUSkinning = GPUSkinning;
     Graphics::GlobalSDFQuality = GlobalSDFQuality;
     Graphics::GIQuality = GIQuality;
+    Graphics::GIRaysBudget = GIRaysBudget;
     Graphics::PostProcessSettings = ::PostProcessSettings();
     Graphics::PostProcessSettings.BlendWith(PostProcessSettings, 1.0f);
 #if !USE_EDITOR // OptionsModule handles fallback fonts in Editor
@@ -38,6 +38,11 @@ API_CLASS(Static) class FLAXENGINE_API Graphics
     /// </summary>
     API_FIELD() static Quality VolumetricFogQuality;
 
+    /// <summary>
+    /// Enables checkerboard updates of the volumetric fog. Lighting is calculated only for a half of the fog volume cells each frame (alternating) while the other cells reuse the reprojected temporal history. Halves the fog lighting cost at cost of a slower response to the lighting changes.
+    /// </summary>
+    API_FIELD() static bool VolumetricFogCheckerboard;
+
     /// <summary>
     /// The shadows quality.
     /// </summary>
@@ -53,6 +58,46 @@ API_CLASS(Static) class FLAXENGINE_API Graphics
     /// </summary>
     API_FIELD() static bool AllowCSMBlending;
 
+    /// <summary>
+    /// Enables culling of the instanced draw calls (eg. foliage) per-instance on a GPU with indirect draws. Reduces the rendered geometry of large draw batches that are only partially visible.
+    /// </summary>
+    API_FIELD() static bool GPUInstancesCulling;
+
+    /// <summary>
+    /// Enables GPU-driven foliage rendering. Foliage instances are kept in the persistent GPU buffers and culled (frustum, cull distance and Hierarchical-Z occlusion if occlusion culling is enabled) with LOD selection done on a GPU per view, and drawn with indirect draws. Removes the per-frame CPU cost of the foliage clusters traversal and instances upload for large foliage.
+    /// </summary>
+    API_FIELD() static bool GPUFoliageCulling;
+
+    /// <summary>
+    /// Enables occlusion culling of the scene objects (actors and foliage) against the Hierarchical-Z buffer built from the scene depth. Results are used with a few frames latency.
+    /// </summary>
+    API_FIELD() static bool OcclusionCulling;
+
+    /// <summary>
+    /// Enables caching of the static shadow casters depth for the static lights. Static geometry is rendered into the shadow map only when it changes within the light projection and dynamic objects are drawn on top of it every frame. Directional light cascades are snapped to coarse cells to be reused over multiple frames (at cost of a slightly lower resolution).
+    /// </summary>
+    API_FIELD() static bool StaticShadowsCaching;
+
+    /// <summary>
+    /// The memory budget (in megabytes) for the temporary render targets pool. Unused pooled targets are released (oldest first) when the pool goes over the budget instead of staying resident for a few seconds. Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD() static int32 RenderTargetPoolBudget;
+
+    /// <summary>
+    /// Enables Variable Rate Shading (if supported by the GPU, see GPULimits::HasVariableRateShading). Screen tiles with low luminance contrast or fast motion in the previous frame are shaded at lower rate in GBuffer, forward and fog passes which reduces the pixel shading cost at high resolutions.
+    /// </summary>
+    API_FIELD() static bool VariableRateShading;
+
+    /// <summary>
+    /// Enables the global meshes geometry pool. Vertex and index buffers of the model meshes are sub-allocated within a few large shared buffers so the draw calls use offsets instead of separate buffers (reduces buffer binding changes and small GPU allocations). Affects only meshes loaded after the change.
+    /// </summary>
+    API_FIELD() static bool MeshGeometryPool;
+
+    /// <summary>
+    /// Enables the skinning of the skinned meshes with a compute shader. Mesh vertices are skinned once per frame into the shared vertex buffers and drawn as a static geometry by all the rendering passes (GBuffer, shadow projections, etc.) instead of doing the skinning in the vertex shader of every pass. Motion vectors pass still uses the vertex shader skinning.
+    /// </summary>
+    API_FIELD() static bool GPUSkinning;
+
     /// <summary>
     /// The Global SDF quality. Controls the volume texture resolution and amount of cascades to use.
     /// </summary>
@@ -63,6 +108,11 @@ API_CLASS(Static) class FLAXENGINE_API Graphics
     /// </summary>
     API_FIELD() static Quality GIQuality;
 
+    /// <summary>
+    /// The maximum amount of Global Illumination probe rays to trace per frame (DDGI). Probes far from the camera are updated less frequently when the active probes need more rays than the budget, while newly activated or relocated probes and the probes near the camera are always updated. Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD() static int32 GIRaysBudget;
+
     /// <summary>
     /// The default Post Process settings. Can be overriden by PostFxVolume on a level locally, per camera or for a whole map.
     /// </summary>
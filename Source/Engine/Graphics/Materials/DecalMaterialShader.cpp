@@ -14,8 +14,6 @@
 #include "Engine/Renderer/DrawCall.h"
 
 PACK_STRUCT(struct DecalMaterialShaderData {
-    Matrix WorldMatrix;
-    Matrix InvWorld;
     Matrix SVPositionToWorld;
     });
 
@@ -35,7 +33,7 @@ void DecalMaterialShader::Bind(BindParameters& params)
     auto materialData = reinterpret_cast<DecalMaterialShaderData*>(cb.Get());
     cb = Span<byte>(cb.Get() + sizeof(DecalMaterialShaderData), cb.Length() - sizeof(DecalMaterialShaderData));
     int32 srv = 0;
-    const bool isCameraInside = OrientedBoundingBox(Vector3::Half, params.FirstDrawCall->World).Contains(view.Position) == ContainmentType::Contains;
+    const bool isCameraInside = OrientedBoundingBox(Vector3::Half, drawCall.World).Contains(view.Position) == ContainmentType::Contains;
 
     // Setup parameters
     MaterialParameter::BindMeta bindMeta;
@@ -50,15 +48,8 @@ void DecalMaterialShader::Bind(BindParameters& params)
     // Decals use depth buffer to draw on top of the objects
     context->BindSR(0, GET_TEXTURE_VIEW_SAFE(params.RenderContext.Buffers->DepthBuffer));
 
-    // Setup material constants
+    // Setup material constants (decal transformation comes from the per-instance data)
     {
-        Matrix::Transpose(drawCall.World, materialData->WorldMatrix);
-
-        // Matrix for transformation from world space to decal object space
-        Matrix invWorld;
-        Matrix::Invert(drawCall.World, invWorld);
-        Matrix::Transpose(invWorld, materialData->InvWorld);
-
         // Matrix for transformation from SV Position space to world space
         const Matrix offsetMatrix(
             2.0f * view.ScreenSize.Z, 0, 0, 0,
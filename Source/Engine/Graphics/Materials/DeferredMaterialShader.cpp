@@ -12,9 +12,11 @@
 #include "Engine/Graphics/Shaders/GPUConstantBuffer.h"
 #include "Engine/Graphics/Models/SkinnedMeshDrawData.h"
 #include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/Config.h"
 #include "Engine/Graphics/Shaders/GPUShader.h"
 #include "Engine/Graphics/GPULimits.h"
 #include "Engine/Graphics/RenderTask.h"
+#include "Engine/Renderer/TextureFeedbackPass.h"
 
 PACK_STRUCT(struct DeferredMaterialShaderData {
     Matrix WorldMatrix;
@@ -28,7 +30,10 @@ PACK_STRUCT(struct DeferredMaterialShaderData {
 
 DrawPass DeferredMaterialShader::GetDrawModes() const
 {
-    return DrawPass::Depth | DrawPass::GBuffer | DrawPass::GlobalSurfaceAtlas | DrawPass::MotionVectors | DrawPass::QuadOverdraw;
+    DrawPass result = DrawPass::Depth | DrawPass::GBuffer | DrawPass::GlobalSurfaceAtlas | DrawPass::MotionVectors | DrawPass::QuadOverdraw;
+    if (_hasTextureFeedback)
+        result |= DrawPass::TextureFeedback;
+    return result;
 }
 
 bool DeferredMaterialShader::CanUseLightmap() const
@@ -66,7 +71,15 @@ void DeferredMaterialShader::Bind(BindParameters& params)
     bindMeta.Buffers = params.RenderContext.Buffers;
     bindMeta.CanSampleDepth = false;
     bindMeta.CanSampleGBuffer = false;
+    uint32 textureFeedback[GPU_MAX_SR_BINDED];
+    if (view.Pass == DrawPass::TextureFeedback)
+    {
+        Platform::MemorySet(textureFeedback, sizeof(textureFeedback), MAX_uint8);
+        bindMeta.TextureFeedback = textureFeedback;
+    }
     MaterialParams::Bind(params.ParamsLink, bindMeta);
+    if (bindMeta.TextureFeedback)
+        TextureFeedbackPass::Instance()->BindMaterial(context, textureFeedback);
 
     // Setup material constants
     {
@@ -132,6 +145,19 @@ void DeferredMaterialShader::Unload()
 
     _cache.Release();
     _cacheInstanced.Release();
+    _hasTextureFeedback = false;
+}
+
+void DeferredMaterialShader::PrecompilePS()
+{
+    // Compile the most common states for the GBuffer and depth passes (see GBufferPass::Fill)
+    const PixelFormat gBufferFormats[] = { PixelFormat::R11G11B10_Float, GBUFFER0_FORMAT, GBUFFER1_FORMAT, GBUFFER2_FORMAT, GBUFFER3_FORMAT };
+    const CullMode cullMode = _info.CullMode;
+    _cache.Default.Precompile(cullMode, false, GPU_DEPTH_BUFFER_PIXEL_FORMAT, ARRAY_COUNT(gBufferFormats), gBufferFormats);
+    _cacheInstanced.Default.Precompile(cullMode, false, GPU_DEPTH_BUFFER_PIXEL_FORMAT, ARRAY_COUNT(gBufferFormats), gBufferFormats);
+    _cache.DefaultSkinned.Precompile(cullMode, false, GPU_DEPTH_BUFFER_PIXEL_FORMAT, ARRAY_COUNT(gBufferFormats), gBufferFormats);
+    _cache.Depth.Precompile(CullMode::TwoSided, false, GPU_DEPTH_BUFFER_PIXEL_FORMAT);
+    _cacheInstanced.Depth.Precompile(CullMode::TwoSided, false, GPU_DEPTH_BUFFER_PIXEL_FORMAT);
 }
 
 bool DeferredMaterialShader::Load()
@@ -209,6 +235,17 @@ bool DeferredMaterialShader::Load()
     psDesc.VS = _shader->GetVS("VS_Skinned", 1);
     _cache.MotionVectorsSkinnedPerBone.Init(psDesc);
 
+    // Texture Feedback Pass
+    _hasTextureFeedback = _shader->HasShader("PS_TextureFeedback");
+    if (_hasTextureFeedback)
+    {
+        psDesc.VS = _shader->GetVS("VS");
+        psDesc.PS = _shader->GetPS("PS_TextureFeedback");
+        _cache.TextureFeedback.Init(psDesc);
+        psDesc.VS = _shader->GetVS("VS_Skinned");
+        _cache.TextureFeedbackSkinned.Init(psDesc);
+    }
+
     // Depth Pass
     psDesc.CullMode = CullMode::TwoSided;
     psDesc.DepthClipEnable = false;
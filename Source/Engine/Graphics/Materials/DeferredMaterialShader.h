@@ -24,6 +24,8 @@ class DeferredMaterialShader : public MaterialShader
         PipelineStateCache QuadOverdraw;
         PipelineStateCache QuadOverdrawSkinned;
 #endif
+        PipelineStateCache TextureFeedback;
+        PipelineStateCache TextureFeedbackSkinned;
 
         FORCE_INLINE PipelineStateCache* GetPS(const DrawPass pass, const bool useLightmap, const bool useSkinning, const bool perBoneMotionBlur)
         {
@@ -41,6 +43,8 @@ class DeferredMaterialShader : public MaterialShader
             case DrawPass::QuadOverdraw:
                 return useSkinning ? &QuadOverdrawSkinned : &QuadOverdraw;
 #endif
+            case DrawPass::TextureFeedback:
+                return useSkinning ? &TextureFeedbackSkinned : &TextureFeedback;
             default:
                 return nullptr;
             }
@@ -59,12 +63,15 @@ class DeferredMaterialShader : public MaterialShader
             QuadOverdraw.Release();
             QuadOverdrawSkinned.Release();
 #endif
+            TextureFeedback.Release();
+            TextureFeedbackSkinned.Release();
         }
     };
 
 private:
     Cache _cache;
     Cache _cacheInstanced;
+    bool _hasTextureFeedback = false;
 
 public:
     DeferredMaterialShader(const StringView& name)
@@ -83,4 +90,5 @@ class DeferredMaterialShader : public MaterialShader
 protected:
     // [MaterialShader]
     bool Load() override;
+    void PrecompilePS() override;
 };
@@ -5,6 +5,7 @@
 #include "MaterialParams.h"
 #include "Engine/Graphics/GPUContext.h"
 #include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/Config.h"
 #include "Engine/Graphics/GPULimits.h"
 #include "Engine/Graphics/RenderView.h"
 #include "Engine/Graphics/RenderTask.h"
@@ -125,6 +126,16 @@ void ForwardMaterialShader::Unload()
     _cacheInstanced.Release();
 }
 
+void ForwardMaterialShader::PrecompilePS()
+{
+    // Compile the most common states for the forward pass (renders into the light buffer)
+    const PixelFormat lightBufferFormat = PixelFormat::R11G11B10_Float;
+    const CullMode cullMode = _info.CullMode;
+    _cache.Default.Precompile(cullMode, false, GPU_DEPTH_BUFFER_PIXEL_FORMAT, 1, &lightBufferFormat);
+    _cacheInstanced.Default.Precompile(cullMode, false, GPU_DEPTH_BUFFER_PIXEL_FORMAT, 1, &lightBufferFormat);
+    _cache.DefaultSkinned.Precompile(cullMode, false, GPU_DEPTH_BUFFER_PIXEL_FORMAT, 1, &lightBufferFormat);
+}
+
 bool ForwardMaterialShader::Load()
 {
     _drawModes = DrawPass::Depth | DrawPass::Forward | DrawPass::QuadOverdraw;
@@ -78,4 +78,5 @@ class ForwardMaterialShader : public MaterialShader
 protected:
     // [MaterialShader]
     bool Load() override;
+    void PrecompilePS() override;
 };
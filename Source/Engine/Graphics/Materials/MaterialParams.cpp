@@ -275,6 +275,19 @@ void MaterialParameter::SetValue(const Variant& value)
     {
         LOG(Error, "Invalid material parameter value type {0} to set (param type: {1})", value.Type, ScriptingEnum::ToString(_type));
     }
+    else if (_owner)
+    {
+        _owner->InvalidateValues();
+    }
+}
+
+void MaterialParameter::SetIsOverride(bool value)
+{
+    if (_override == value)
+        return;
+    _override = value;
+    if (_owner)
+        _owner->InvalidateValues();
 }
 
 void MaterialParameter::Bind(BindMeta& meta) const
@@ -321,6 +334,8 @@ void MaterialParameter::Bind(BindMeta& meta) const
             texture = GPUDevice::Instance->GetDefaultNormalMap();
         const auto view = GET_TEXTURE_VIEW_SAFE(texture);
         meta.Context->BindSR(_registerIndex, view);
+        if (meta.TextureFeedback && _asAsset && _registerIndex < GPU_MAX_SR_BINDED)
+            meta.TextureFeedback[_registerIndex] = ((TextureBase*)_asAsset.Get())->StreamingTexture()->GetFeedbackData();
         break;
     }
     case MaterialParameterType::Texture:
@@ -329,6 +344,8 @@ void MaterialParameter::Bind(BindMeta& meta) const
         const auto texture = _asAsset ? ((TextureBase*)_asAsset.Get())->GetTexture() : nullptr;
         const auto view = GET_TEXTURE_VIEW_SAFE(texture);
         meta.Context->BindSR(_registerIndex, view);
+        if (meta.TextureFeedback && _asAsset && _registerIndex < GPU_MAX_SR_BINDED && _type == MaterialParameterType::Texture)
+            meta.TextureFeedback[_registerIndex] = ((TextureBase*)_asAsset.Get())->StreamingTexture()->GetFeedbackData();
         break;
     }
     case MaterialParameterType::GPUTexture:
@@ -476,6 +493,26 @@ bool MaterialParameter::HasContentLoaded() const
     return _asAsset == nullptr || _asAsset->IsLoaded();
 }
 
+bool MaterialParameter::IsConstantValue() const
+{
+    switch (_type)
+    {
+    case MaterialParameterType::Bool:
+    case MaterialParameterType::Integer:
+    case MaterialParameterType::Float:
+    case MaterialParameterType::Vector2:
+    case MaterialParameterType::Vector3:
+    case MaterialParameterType::Vector4:
+    case MaterialParameterType::Color:
+    case MaterialParameterType::Matrix:
+    case MaterialParameterType::ChannelMask:
+    case MaterialParameterType::Invalid:
+        return true;
+    default:
+        return false;
+    }
+}
+
 void MaterialParameter::clone(const MaterialParameter* param)
 {
     // Clone data
@@ -485,6 +522,7 @@ void MaterialParameter::clone(const MaterialParameter* param)
     _registerIndex = param->_registerIndex;
     _offset = param->_offset;
     _name = param->_name;
+    _nameId = param->_nameId;
     _paramId = param->_paramId;
 
     // Clone value
@@ -561,6 +599,16 @@ MaterialParameter* MaterialParams::Get(const StringView& name)
     return result;
 }
 
+MaterialParameter* MaterialParams::Get(const StringName& name)
+{
+    for (int32 i = 0; i < Count(); i++)
+    {
+        if (At(i).GetNameId() == name)
+            return &At(i);
+    }
+    return nullptr;
+}
+
 int32 MaterialParams::Find(const Guid& id)
 {
     int32 result = -1;
@@ -589,14 +637,55 @@ int32 MaterialParams::Find(const StringView& name)
     return result;
 }
 
+int32 MaterialParams::Find(const StringName& name)
+{
+    for (int32 i = 0; i < Count(); i++)
+    {
+        if (At(i).GetNameId() == name)
+            return i;
+    }
+    return -1;
+}
+
 int32 MaterialParams::GetVersionHash() const
 {
     return _versionHash;
 }
 
+void MaterialParams::InvalidateValues()
+{
+    _valuesVersion = NextValuesVersion();
+}
+
 void MaterialParams::Bind(MaterialParamsLink* link, MaterialParameter::BindMeta& meta)
 {
     ASSERT(link && link->This);
+    MaterialParams& cache = *link->This;
+
+    // Check if any of the linked parameters has been modified since the last binding
+    bool cacheValid = cache._bindCacheConstants.Count() == meta.Constants.Length() && cache._bindCacheLinks.HasItems();
+    int32 linksCount = 0;
+    for (MaterialParamsLink* l = link; l && cacheValid; l = l->Down, linksCount++)
+    {
+        cacheValid = linksCount < cache._bindCacheLinks.Count() &&
+                cache._bindCacheLinks[linksCount].Params == l->This &&
+                cache._bindCacheLinks[linksCount].ValuesVersion == l->This->_valuesVersion;
+    }
+    if (cacheValid && linksCount == cache._bindCacheLinks.Count())
+    {
+        // Reuse the constants and bind only resources and parameters that depend on the rendering state
+        if (meta.Constants.Length() != 0)
+            Platform::MemoryCopy(meta.Constants.Get(), cache._bindCacheConstants.Get(), meta.Constants.Length());
+        for (const MaterialParameter* param : cache._bindCacheParams)
+            param->Bind(meta);
+        return;
+    }
+
+    // Bind all parameters and cache the result
+    cache._bindCacheLinks.Clear();
+    for (MaterialParamsLink* l = link; l; l = l->Down)
+        cache._bindCacheLinks.Add({ l->This, l->This->_valuesVersion });
+    cache._bindCacheParams.Clear();
     for (int32 i = 0; i < link->This->Count(); i++)
     {
         MaterialParamsLink* l = link;
@@ -605,8 +694,12 @@ void MaterialParams::Bind(MaterialParamsLink* link, MaterialParameter::BindMeta&
             l = l->Down;
         }
 
-        l->This->At(i).Bind(meta);
+        const MaterialParameter& param = l->This->At(i);
+        param.Bind(meta);
+        if (!param.IsConstantValue())
+            cache._bindCacheParams.Add(&param);
     }
+    cache._bindCacheConstants.Set(meta.Constants.Get(), meta.Constants.Length());
 }
 
 void MaterialParams::Clone(MaterialParams& result)
@@ -621,12 +714,14 @@ void MaterialParams::Clone(MaterialParams& result)
     }
 
     result._versionHash = _versionHash;
+    result.UpdateOwners();
 }
 
 void MaterialParams::Dispose()
 {
     Resize(0);
     _versionHash = 0;
+    UpdateOwners();
 }
 
 bool MaterialParams::Load(ReadStream* stream)
@@ -663,6 +758,7 @@ bool MaterialParams::Load(ReadStream* stream)
                 param->_isPublic = stream->ReadBool();
                 param->_override = param->_isPublic;
                 stream->ReadString(&param->_name, 10421);
+                param->_nameId = StringName(param->_name);
                 param->_registerIndex = stream->ReadByte();
                 stream->ReadUint16(&param->_offset);
 
@@ -738,6 +834,7 @@ bool MaterialParams::Load(ReadStream* stream)
                 param->_isPublic = stream->ReadBool();
                 param->_override = param->_isPublic;
                 stream->ReadString(&param->_name, 10421);
+                param->_nameId = StringName(param->_name);
                 param->_registerIndex = stream->ReadByte();
                 stream->ReadUint16(&param->_offset);
 
@@ -812,6 +909,7 @@ bool MaterialParams::Load(ReadStream* stream)
                 param->_isPublic = stream->ReadBool();
                 param->_override = stream->ReadBool();
                 stream->ReadString(&param->_name, 10421);
+                param->_nameId = StringName(param->_name);
                 param->_registerIndex = stream->ReadByte();
                 stream->ReadUint16(&param->_offset);
 
@@ -876,6 +974,7 @@ bool MaterialParams::Load(ReadStream* stream)
     }
 
     UpdateHash();
+    UpdateOwners();
 
     return result;
 }
@@ -1073,3 +1172,19 @@ void MaterialParams::UpdateHash()
 {
     _versionHash = rand();
 }
+
+void MaterialParams::UpdateOwners()
+{
+    for (int32 i = 0; i < Count(); i++)
+        At(i)._owner = this;
+    _bindCacheLinks.Clear();
+    _bindCacheParams.Clear();
+    _bindCacheConstants.Clear();
+    InvalidateValues();
+}
+
+uint64 MaterialParams::NextValuesVersion()
+{
+    static int64 Version = 0;
+    return (uint64)Platform::InterlockedIncrement(&Version);
+}
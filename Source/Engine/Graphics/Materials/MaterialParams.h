@@ -6,6 +6,7 @@
 #include "Engine/Core/Math/Vector2.h"
 #include "Engine/Core/Math/Vector3.h"
 #include "Engine/Core/Types/StringView.h"
+#include "Engine/Core/Types/StringName.h"
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Scripting/ScriptingObjectReference.h"
 #include "Engine/Content/Assets/Texture.h"
@@ -197,6 +198,8 @@ API_CLASS(NoSpawn) class FLAXENGINE_API MaterialParameter : public ScriptingObje
     AssetReference<Asset> _asAsset;
     ScriptingObjectReference<GPUTexture> _asGPUTexture;
     String _name;
+    StringName _nameId;
+    MaterialParams* _owner = nullptr;
 
 public:
     MaterialParameter(const MaterialParameter& other)
@@ -240,6 +243,14 @@ API_CLASS(NoSpawn) class FLAXENGINE_API MaterialParameter : public ScriptingObje
         return _name;
     }
 
+    /// <summary>
+    /// Gets the interned parameter name (for fast lookups by name).
+    /// </summary>
+    FORCE_INLINE const StringName& GetNameId() const
+    {
+        return _nameId;
+    }
+
     /// <summary>
     /// Returns true is parameter is public visible.
     /// </summary>
@@ -259,10 +270,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API MaterialParameter : public ScriptingObje
     /// <summary>
     /// Sets the value override mode.
     /// </summary>
-    API_PROPERTY() void SetIsOverride(bool value)
-    {
-        _override = value;
-    }
+    API_PROPERTY() void SetIsOverride(bool value);
 
     /// <summary>
     /// Gets the parameter resource graphics pipeline binding register index.
@@ -328,6 +336,11 @@ API_CLASS(NoSpawn) class FLAXENGINE_API MaterialParameter : public ScriptingObje
         /// True if parameters can sample GBuffer.
         /// </summary>
         bool CanSampleGBuffer;
+
+        /// <summary>
+        /// The texture feedback data (per shader resource register) to fill for the bound streamed textures. It's optional and used only in texture feedback pass.
+        /// </summary>
+        uint32* TextureFeedback = nullptr;
     };
 
     /// <summary>
@@ -338,6 +351,11 @@ API_CLASS(NoSpawn) class FLAXENGINE_API MaterialParameter : public ScriptingObje
 
     bool HasContentLoaded() const;
 
+    /// <summary>
+    /// Returns true if parameter binding writes only the parameter value into the constants buffer (result depends only on the parameter value, not on the rendering state or other assets).
+    /// </summary>
+    bool IsConstantValue() const;
+
 private:
     void clone(const MaterialParameter* param);
 
@@ -354,14 +372,29 @@ API_CLASS(NoSpawn) class FLAXENGINE_API MaterialParameter : public ScriptingObje
 class FLAXENGINE_API MaterialParams : public Array<MaterialParameter>
 {
     friend MaterialInstance;
+    friend MaterialParameter;
 private:
+    struct BindCacheLink
+    {
+        const MaterialParams* Params;
+        uint64 ValuesVersion;
+    };
+
     int32 _versionHash = 0;
+    uint64 _valuesVersion = NextValuesVersion();
+
+    // Cached parameters binding (constants bound by the last Bind call from this collection) to skip parameters evaluation when values are not modified
+    Array<BindCacheLink, InlinedAllocation<4>> _bindCacheLinks;
+    Array<const MaterialParameter*> _bindCacheParams;
+    Array<byte> _bindCacheConstants;
 
 public:
     MaterialParameter* Get(const Guid& id);
     MaterialParameter* Get(const StringView& name);
+    MaterialParameter* Get(const StringName& name);
     int32 Find(const Guid& id);
     int32 Find(const StringView& name);
+    int32 Find(const StringName& name);
 
 public:
     /// <summary>
@@ -369,10 +402,24 @@ class FLAXENGINE_API MaterialParams : public Array<MaterialParameter>
     /// </summary>
     int32 GetVersionHash() const;
 
+    /// <summary>
+    /// Gets the parameters values version. Every time any parameter value or override mode is modified the version changes (it's unique across all parameter collections).
+    /// </summary>
+    FORCE_INLINE uint64 GetValuesVersion() const
+    {
+        return _valuesVersion;
+    }
+
+    /// <summary>
+    /// Invalidates the parameters values version (eg. after modifying parameters layout).
+    /// </summary>
+    void InvalidateValues();
+
 public:
     /// <summary>
     /// Binds the parameters to the pipeline.
     /// </summary>
+    /// <remarks>The constants written by the parameters are cached in the top-most parameters collection of the link and reused if none of the linked collections has been modified since the last binding, then only resources and state-dependent parameters are bound.</remarks>
     /// <param name="link">The parameters binding link. Used to support per-parameter override.</param>
     /// <param name="meta">The bind meta.</param>
     static void Bind(MaterialParamsLink* link, MaterialParameter::BindMeta& meta);
@@ -430,4 +477,6 @@ class FLAXENGINE_API MaterialParams : public Array<MaterialParameter>
 
 private:
     void UpdateHash();
+    void UpdateOwners();
+    static uint64 NextValuesVersion();
 };
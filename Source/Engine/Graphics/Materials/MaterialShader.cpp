@@ -10,6 +10,8 @@
 #include "Engine/Graphics/Shaders/GPUConstantBuffer.h"
 #include "Engine/Graphics/Shaders/GPUShader.h"
 #include "Engine/Engine/Time.h"
+#include "Engine/Threading/Task.h"
+#include "Engine/Profiler/ProfilerCPU.h"
 #include "DecalMaterialShader.h"
 #include "PostFxMaterialShader.h"
 #include "ForwardMaterialShader.h"
@@ -33,6 +35,8 @@ PACK_STRUCT(struct MaterialShaderDataPerView {
     Float4 ViewInfo;
     Float4 ScreenSize;
     Float4 TemporalAAJitter;
+    float TexturesMipBias;
+    Float3 Dummy0;
     });
 
 IMaterial::BindParameters::BindParameters(::GPUContext* context, const ::RenderContext& renderContext)
@@ -87,23 +91,47 @@ void IMaterial::BindParameters::BindViewData()
     cb.ViewInfo = RenderContext.View.ViewInfo;
     cb.ScreenSize = RenderContext.View.ScreenSize;
     cb.TemporalAAJitter = RenderContext.View.TemporalAAJitter;
+    cb.TexturesMipBias = RenderContext.View.TexturesMipBias;
+    cb.Dummy0 = Float3::Zero;
 
     // Update constants
     GPUContext->UpdateCB(PerViewConstants, &cb);
     GPUContext->BindCB(1, PerViewConstants);
 }
 
-GPUPipelineState* MaterialShader::PipelineStateCache::InitPS(CullMode mode, bool wireframe)
+void MaterialShader::PipelineStateCache::Precompile(CullMode mode, bool wireframe, PixelFormat depthFormat, int32 rtCount, const PixelFormat* rtFormats)
 {
-    Desc.CullMode = mode;
-    Desc.Wireframe = wireframe;
+    const int32 index = static_cast<int32>(mode) + (wireframe ? 3 : 0);
+    if (!Desc.VS || PS[index])
+        return;
+    InitPS(mode, wireframe, depthFormat, rtCount, rtFormats);
+}
+
+GPUPipelineState* MaterialShader::PipelineStateCache::InitPS(CullMode mode, bool wireframe, PixelFormat depthFormat, int32 rtCount, const PixelFormat* rtFormats)
+{
+    // Use a local description copy to support creating states from multiple threads
+    const int32 index = static_cast<int32>(mode) + (wireframe ? 3 : 0);
+    auto desc = Desc;
+    desc.CullMode = mode;
+    desc.Wireframe = wireframe;
     auto ps = GPUDevice::Instance->CreatePipelineState();
-    ps->Init(Desc);
+    ps->Init(desc);
+    if (depthFormat != PixelFormat::Unknown || rtCount != 0)
+        ps->Precompile(depthFormat, rtCount, rtFormats);
+
+    // Publish the state (other thread could be faster)
+    const auto prev = (GPUPipelineState*)Platform::InterlockedCompareExchange((intptr volatile*)&PS[index], (intptr)ps, 0);
+    if (prev)
+    {
+        ps->DeleteObjectNow();
+        ps = prev;
+    }
     return ps;
 }
 
 MaterialShader::MaterialShader(const StringView& name)
     : _isLoaded(false)
+    , _precompiling(0)
     , _shader(nullptr)
 {
     ASSERT(GPUDevice::Instance);
@@ -202,7 +230,7 @@ const MaterialInfo& MaterialShader::GetInfo() const
 
 bool MaterialShader::IsReady() const
 {
-    return _isLoaded;
+    return _isLoaded && Platform::AtomicRead(&_precompiling) == 0;
 }
 
 bool MaterialShader::Load(MemoryReadStream& shaderCacheStream, const MaterialInfo& info)
@@ -241,11 +269,30 @@ bool MaterialShader::Load(MemoryReadStream& shaderCacheStream, const MaterialInf
     }
 
     _isLoaded = true;
+
+    // Compile pipeline states in async to prevent stalls on a first draw
+    if (GPUDevice::Instance->GetRendererType() != RendererType::Null)
+    {
+        Platform::InterlockedIncrement(&_precompiling);
+        Function<void()> action = [this]
+        {
+            PROFILE_CPU_NAMED("Precompile Material");
+            PrecompilePS();
+            Platform::InterlockedDecrement(&_precompiling);
+        };
+        if (!Task::StartNew(action))
+            Platform::InterlockedDecrement(&_precompiling);
+    }
+
     return false;
 }
 
 void MaterialShader::Unload()
 {
+    // Wait for the async pipeline states compilation end
+    while (Platform::AtomicRead(&_precompiling) != 0)
+        Platform::Sleep(1);
+
     _isLoaded = false;
     _cb = nullptr;
     _cbData.Resize(0, false);
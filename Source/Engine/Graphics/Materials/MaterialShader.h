@@ -10,7 +10,7 @@
 /// <summary>
 /// Current materials shader version.
 /// </summary>
-#define MATERIAL_GRAPH_VERSION 161
+#define MATERIAL_GRAPH_VERSION 168
 
 class Material;
 class GPUShader;
@@ -43,11 +43,16 @@ class MaterialShader : public IMaterial
             const int32 index = static_cast<int32>(mode) + (wireframe ? 3 : 0);
             auto ps = PS[index];
             if (!ps)
-                PS[index] = ps = InitPS(mode, wireframe);
+                ps = InitPS(mode, wireframe);
             return ps;
         }
 
-        GPUPipelineState* InitPS(CullMode mode, bool wireframe);
+        /// <summary>
+        /// Creates the pipeline state (if missing) and compiles it for the given render targets setup. Safe to call from a worker thread.
+        /// </summary>
+        void Precompile(CullMode mode, bool wireframe, PixelFormat depthFormat, int32 rtCount = 0, const PixelFormat* rtFormats = nullptr);
+
+        GPUPipelineState* InitPS(CullMode mode, bool wireframe, PixelFormat depthFormat = PixelFormat::Unknown, int32 rtCount = 0, const PixelFormat* rtFormats = nullptr);
 
         void Release()
         {
@@ -57,6 +62,7 @@ class MaterialShader : public IMaterial
 
 protected:
     bool _isLoaded;
+    volatile int64 _precompiling;
     GPUShader* _shader;
     GPUConstantBuffer* _cb;
     Array<byte> _cbData;
@@ -102,6 +108,13 @@ class MaterialShader : public IMaterial
     bool Load(MemoryReadStream& shaderCacheStream, const MaterialInfo& info);
     virtual bool Load() = 0;
 
+    /// <summary>
+    /// Compiles the pipeline states used by the most common draw passes. Called on a worker thread after material load so the first draw doesn't stall rendering. Material is not ready until this ends.
+    /// </summary>
+    virtual void PrecompilePS()
+    {
+    }
+
 public:
     // [IMaterial]
     const MaterialInfo& GetInfo() const override;
@@ -5,6 +5,7 @@
 #include "Engine/Graphics/Textures/GPUTexture.h"
 #include "Engine/Renderer/RenderList.h"
 #include "Engine/Renderer/ShadowsPass.h"
+#include "Engine/Renderer/LightsGridPass.h"
 #if USE_EDITOR
 #include "Engine/Renderer/Lightmaps.h"
 #endif
@@ -22,6 +23,7 @@ void ForwardShadingFeature::Bind(MaterialShader::BindParameters& params, Span<by
     const int32 envProbeShaderRegisterIndex = srv + 0;
     const int32 skyLightShaderRegisterIndex = srv + 1;
     const int32 dirLightShaderRegisterIndex = srv + 2;
+    const int32 lightsGridShaderRegisterIndex = srv + 3;
     const bool canUseShadow = view.Pass != DrawPass::Depth;
 
     // Set fog input
@@ -97,26 +99,45 @@ void ForwardShadingFeature::Bind(MaterialShader::BindParameters& params, Span<by
         params.GPUContext->UnBindSR(envProbeShaderRegisterIndex);
     }
 
-    // Set local lights
+    // Set local lights (use clustered lights grid if built for this view)
     data.LocalLightsCount = 0;
-    const BoundingSphere objectBounds(drawCall.ObjectPosition, drawCall.ObjectRadius);
-    // TODO: optimize lights searching for a transparent material - use spatial cache for renderer to find it
-    for (int32 i = 0; i < cache->PointLights.Count() && data.LocalLightsCount < MaxLocalLights; i++)
+    const LightsGridPass::BindingData* lightsGrid = LightsGridPass::Instance()->Get(cache);
+    if (lightsGrid)
     {
-        const auto& light = cache->PointLights[i];
-        if (CollisionsHelper::SphereIntersectsSphere(objectBounds, BoundingSphere(light.Position, light.Radius)))
-        {
-            light.SetupLightData(&data.LocalLights[data.LocalLightsCount], false);
-            data.LocalLightsCount++;
-        }
+        data.LightsGridSize[0] = lightsGrid->GridSize[0];
+        data.LightsGridSize[1] = lightsGrid->GridSize[1];
+        data.LightsGridSize[2] = lightsGrid->GridSize[2];
+        data.LightsGridDepthScale = lightsGrid->DepthScale;
+        data.LightsGridDepthBias = lightsGrid->DepthBias;
+        params.GPUContext->BindSR(lightsGridShaderRegisterIndex + 0, lightsGrid->Lights->View());
+        params.GPUContext->BindSR(lightsGridShaderRegisterIndex + 1, lightsGrid->Clusters->View());
+        params.GPUContext->BindSR(lightsGridShaderRegisterIndex + 2, lightsGrid->Indices->View());
     }
-    for (int32 i = 0; i < cache->SpotLights.Count() && data.LocalLightsCount < MaxLocalLights; i++)
+    else
     {
-        const auto& light = cache->SpotLights[i];
-        if (CollisionsHelper::SphereIntersectsSphere(objectBounds, BoundingSphere(light.Position, light.Radius)))
+        data.LightsGridSize[0] = data.LightsGridSize[1] = data.LightsGridSize[2] = 0;
+        params.GPUContext->UnBindSR(lightsGridShaderRegisterIndex + 0);
+        params.GPUContext->UnBindSR(lightsGridShaderRegisterIndex + 1);
+        params.GPUContext->UnBindSR(lightsGridShaderRegisterIndex + 2);
+        const BoundingSphere objectBounds(drawCall.ObjectPosition, drawCall.ObjectRadius);
+        // TODO: optimize lights searching for a transparent material - use spatial cache for renderer to find it
+        for (int32 i = 0; i < cache->PointLights.Count() && data.LocalLightsCount < MaxLocalLights; i++)
         {
-            light.SetupLightData(&data.LocalLights[data.LocalLightsCount], false);
-            data.LocalLightsCount++;
+            const auto& light = cache->PointLights[i];
+            if (CollisionsHelper::SphereIntersectsSphere(objectBounds, BoundingSphere(light.Position, light.Radius)))
+            {
+                light.SetupLightData(&data.LocalLights[data.LocalLightsCount], false);
+                data.LocalLightsCount++;
+            }
+        }
+        for (int32 i = 0; i < cache->SpotLights.Count() && data.LocalLightsCount < MaxLocalLights; i++)
+        {
+            const auto& light = cache->SpotLights[i];
+            if (CollisionsHelper::SphereIntersectsSphere(objectBounds, BoundingSphere(light.Position, light.Radius)))
+            {
+                light.SetupLightData(&data.LocalLights[data.LocalLightsCount], false);
+                data.LocalLightsCount++;
+            }
         }
     }
 
@@ -23,7 +23,7 @@ struct ForwardShadingFeature : MaterialShaderFeature
 {
     enum { MaxLocalLights = 4 };
 
-    enum { SRVs = 3 };
+    enum { SRVs = 6 };
 
     PACK_STRUCT(struct Data
         {
@@ -35,6 +35,10 @@ struct ForwardShadingFeature : MaterialShaderFeature
         Float3 Dummy2;
         uint32 LocalLightsCount;
         LightData LocalLights[MaxLocalLights];
+        uint32 LightsGridSize[3];
+        float LightsGridDepthScale;
+        float LightsGridDepthBias;
+        Float3 Dummy3;
         });
 
     static void Bind(MaterialShader::BindParameters& params, Span<byte>& cb, int32& srv);
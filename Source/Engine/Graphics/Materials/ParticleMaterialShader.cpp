@@ -6,6 +6,7 @@
 #include "Engine/Renderer/DrawCall.h"
 #include "Engine/Renderer/RenderList.h"
 #include "Engine/Graphics/RenderView.h"
+#include "Engine/Graphics/Config.h"
 #include "Engine/Graphics/GPUContext.h"
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Graphics/GPULimits.h"
@@ -182,6 +183,16 @@ void ParticleMaterialShader::Unload()
     _cacheVolumetricFog.Release();
 }
 
+void ParticleMaterialShader::PrecompilePS()
+{
+    // Compile the forward pass states (renders into the light buffer) so spawning particle effects doesn't stall rendering
+    const PixelFormat lightBufferFormat = PixelFormat::R11G11B10_Float;
+    const CullMode cullMode = _info.CullMode;
+    _cacheSprite.Default.Precompile(cullMode, false, GPU_DEPTH_BUFFER_PIXEL_FORMAT, 1, &lightBufferFormat);
+    _cacheModel.Default.Precompile(cullMode, false, GPU_DEPTH_BUFFER_PIXEL_FORMAT, 1, &lightBufferFormat);
+    _cacheRibbon.Default.Precompile(cullMode, false, GPU_DEPTH_BUFFER_PIXEL_FORMAT, 1, &lightBufferFormat);
+}
+
 bool ParticleMaterialShader::Load()
 {
     _drawModes = DrawPass::Depth | DrawPass::Forward | DrawPass::QuadOverdraw;
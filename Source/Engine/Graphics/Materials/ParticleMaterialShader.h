@@ -75,4 +75,5 @@ class ParticleMaterialShader : public MaterialShader
 protected:
     // [MaterialShader]
     bool Load() override;
+    void PrecompilePS() override;
 };
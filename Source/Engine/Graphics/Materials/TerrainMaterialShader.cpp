@@ -13,6 +13,7 @@
 #include "Engine/Graphics/Shaders/GPUConstantBuffer.h"
 #include "Engine/Level/Scene/Lightmap.h"
 #include "Engine/Renderer/DrawCall.h"
+#include "Engine/Renderer/TerrainVirtualTexturePass.h"
 #include "Engine/Terrain/TerrainPatch.h"
 
 PACK_STRUCT(struct TerrainMaterialShaderData {
@@ -26,6 +27,10 @@ PACK_STRUCT(struct TerrainMaterialShaderData {
     Float4 HeightmapUVScaleBias; // xy-scale, zw-offset for chunk geometry UVs into heightmap UVs (as single MAD instruction)
     Float4 NeighborLOD; // Per component LOD index for chunk neighbors ordered: top, left, right, bottom
     Float2 OffsetUV; // Offset applied to the texture coordinates (used to implement seamless UVs based on chunk location relative to terrain root)
+    float VirtualTextureTexel; // Half-texel size of the virtual texture tile (in chunk UVs)
+    float HeightmapMipOffset; // Amount of the heightmap mips streamed-out (GPU texture mip 0 is the absolute mip of this index)
+    Float4 VirtualTextureUV; // xy-scale, zw-offset for chunk UVs into the virtual texture atlas UVs (zero if not used)
+    Float2 SplatmapMipOffset; // Amount of the splatmaps mips streamed-out
     Float2 Dummy0;
     });
 
@@ -49,7 +54,7 @@ void TerrainMaterialShader::Bind(BindParameters& params)
     ASSERT_LOW_LAYER(cb.Length() >= sizeof(TerrainMaterialShaderData));
     auto materialData = reinterpret_cast<TerrainMaterialShaderData*>(cb.Get());
     cb = Span<byte>(cb.Get() + sizeof(TerrainMaterialShaderData), cb.Length() - sizeof(TerrainMaterialShaderData));
-    int32 srv = 3;
+    int32 srv = 7;
 
     // Setup features
     const bool useLightmap = LightmapFeature::Bind(params, cb, srv);
@@ -82,15 +87,30 @@ void TerrainMaterialShader::Bind(BindParameters& params)
         materialData->HeightmapUVScaleBias = drawCall.Terrain.HeightmapUVScaleBias;
         materialData->NeighborLOD = drawCall.Terrain.NeighborLOD;
         materialData->OffsetUV = drawCall.Terrain.OffsetUV;
+        materialData->VirtualTextureTexel = drawCall.Terrain.VirtualTextureTexel;
+        materialData->VirtualTextureUV = drawCall.Terrain.VirtualTextureUV;
     }
 
     // Bind terrain textures
     const auto heightmap = drawCall.Terrain.Patch->Heightmap->GetTexture();
     const auto splatmap0 = drawCall.Terrain.Patch->Splatmap[0] ? drawCall.Terrain.Patch->Splatmap[0]->GetTexture() : nullptr;
     const auto splatmap1 = drawCall.Terrain.Patch->Splatmap[1] ? drawCall.Terrain.Patch->Splatmap[1]->GetTexture() : nullptr;
+    {
+        // Textures with streamed-out mips use smaller GPU resource (mip 0 is not the top-most mip) so shader has to offset the sampled LOD
+        materialData->HeightmapMipOffset = (float)(drawCall.Terrain.Patch->Heightmap->StreamingTexture()->TotalMipLevels() - heightmap->MipLevels());
+        materialData->SplatmapMipOffset.X = splatmap0 ? (float)(drawCall.Terrain.Patch->Splatmap[0]->StreamingTexture()->TotalMipLevels() - splatmap0->MipLevels()) : 0.0f;
+        materialData->SplatmapMipOffset.Y = splatmap1 ? (float)(drawCall.Terrain.Patch->Splatmap[1]->StreamingTexture()->TotalMipLevels() - splatmap1->MipLevels()) : 0.0f;
+        materialData->Dummy0 = Float2::Zero;
+    }
     context->BindSR(0, heightmap);
     context->BindSR(1, splatmap0);
     context->BindSR(2, splatmap1);
+    if (drawCall.Terrain.VirtualTextureUV.X > 0.0f)
+    {
+        const auto virtualTexture = TerrainVirtualTexturePass::Instance();
+        for (int32 i = 0; i < 4; i++)
+            context->BindSR(3 + i, virtualTexture->GetAtlas(i));
+    }
 
     // Bind constants
     if (_cb)
@@ -0,0 +1,268 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "CollisionProxy.h"
+#include "Engine/Core/Math/Matrix.h"
+
+namespace
+{
+    struct BuildItem
+    {
+        int32 Node, Start, Count;
+    };
+
+    bool RayIntersectsNode(const CollisionProxy::BVHNode& node, const Float3& origin, const Float3& invDirection, float maxDistance, float& distance)
+    {
+        float tMin = 0.0f, tMax = maxDistance;
+        for (int32 axis = 0; axis < 3; axis++)
+        {
+            float t0 = (node.Min.Raw[axis] - origin.Raw[axis]) * invDirection.Raw[axis];
+            float t1 = (node.Max.Raw[axis] - origin.Raw[axis]) * invDirection.Raw[axis];
+            if (t0 > t1)
+                Swap(t0, t1);
+            tMin = Math::Max(tMin, t0);
+            tMax = Math::Min(tMax, t1);
+            if (tMin > tMax)
+                return false;
+        }
+        distance = tMin;
+        return true;
+    }
+
+    float DistanceNodePoint(const CollisionProxy::BVHNode& node, const Float3& point)
+    {
+        return Float3::Distance(point, Float3::Clamp(point, node.Min, node.Max));
+    }
+
+    template<typename TriangleTransform>
+    bool IntersectsBVH(const CollisionProxy& proxy, const Ray& ray, const Float3& localOrigin, const Float3& localDirection, const TriangleTransform& toWorld, Real& distance, Vector3& normal)
+    {
+        // Ray is traversed in the local-space of the triangles with the non-normalized direction so the distance along it matches the world-space distance
+        distance = MAX_Real;
+        Float3 invDirection;
+        for (int32 axis = 0; axis < 3; axis++)
+            invDirection.Raw[axis] = Math::IsZero(localDirection.Raw[axis]) ? MAX_float : 1.0f / localDirection.Raw[axis];
+        Array<int32, InlinedAllocation<64>> stack;
+        stack.Add(0);
+        float nodeDistance;
+        while (stack.HasItems())
+        {
+            const auto& node = proxy.Nodes[stack.Pop()];
+            if (!RayIntersectsNode(node, localOrigin, invDirection, (float)Math::Min<Real>(distance, MAX_float), nodeDistance))
+                continue;
+            if (node.Count == 0)
+            {
+                // Visit the closer child first
+                const auto& left = proxy.Nodes[node.Index];
+                const float leftDistance = Float3::DistanceSquared(localOrigin, (left.Min + left.Max) * 0.5f);
+                const auto& right = proxy.Nodes[node.Index + 1];
+                const float rightDistance = Float3::DistanceSquared(localOrigin, (right.Min + right.Max) * 0.5f);
+                stack.Add(leftDistance < rightDistance ? node.Index + 1 : node.Index);
+                stack.Add(leftDistance < rightDistance ? node.Index : node.Index + 1);
+                continue;
+            }
+
+            // Test triangles in world-space to match the precision of the brute force test
+            for (int32 i = node.Index; i < node.Index + node.Count; i++)
+            {
+                Vector3 v0, v1, v2;
+                toWorld(proxy.Triangles[i], v0, v1, v2);
+                Real d;
+                if (CollisionsHelper::RayIntersectsTriangle(ray, v0, v1, v2, d) && d < distance)
+                {
+                    normal = Vector3::Normalize((v1 - v0) ^ (v2 - v0));
+                    distance = d;
+                }
+            }
+        }
+        return distance < MAX_Real;
+    }
+
+    template<typename TriangleTransform>
+    bool IntersectsBruteForce(const CollisionProxy& proxy, const Ray& ray, const TriangleTransform& toWorld, Real& distance, Vector3& normal)
+    {
+        distance = MAX_Real;
+        for (int32 i = 0; i < proxy.Triangles.Count(); i++)
+        {
+            Vector3 v0, v1, v2;
+            toWorld(proxy.Triangles[i], v0, v1, v2);
+
+            // TODO: use 32-bit precision for intersection
+            Real d;
+            if (CollisionsHelper::RayIntersectsTriangle(ray, v0, v1, v2, d) && d < distance)
+            {
+                normal = Vector3::Normalize((v1 - v0) ^ (v2 - v0));
+                distance = d;
+            }
+        }
+        return distance < MAX_Real;
+    }
+}
+
+void CollisionProxy::BuildBVH(int32 maxLeafSize)
+{
+    Nodes.Clear();
+    const int32 count = Triangles.Count();
+    if (count <= maxLeafSize)
+        return;
+    Nodes.EnsureCapacity(count / maxLeafSize * 2 + 1, false);
+
+    Array<Float3> centers;
+    centers.Resize(count, false);
+    for (int32 i = 0; i < count; i++)
+    {
+        const auto& t = Triangles[i];
+        centers[i] = (t.V0 + t.V1 + t.V2) * (1.0f / 3.0f);
+    }
+
+    Array<BuildItem, InlinedAllocation<64>> stack;
+    Nodes.AddUninitialized(1);
+    stack.Add({ 0, 0, count });
+    while (stack.HasItems())
+    {
+        const BuildItem item = stack.Pop();
+
+        // Calculate bounds of the node triangles and their centers
+        Float3 min = Float3::Maximum, max = Float3::Minimum;
+        Float3 centersMin = Float3::Maximum, centersMax = Float3::Minimum;
+        for (int32 i = item.Start; i < item.Start + item.Count; i++)
+        {
+            const auto& t = Triangles[i];
+            min = Float3::Min(min, Float3::Min(t.V0, Float3::Min(t.V1, t.V2)));
+            max = Float3::Max(max, Float3::Max(t.V0, Float3::Max(t.V1, t.V2)));
+            centersMin = Float3::Min(centersMin, centers[i]);
+            centersMax = Float3::Max(centersMax, centers[i]);
+        }
+        BVHNode& node = Nodes[item.Node];
+        node.Min = min;
+        node.Max = max;
+        if (item.Count <= maxLeafSize)
+        {
+            node.Index = item.Start;
+            node.Count = item.Count;
+            continue;
+        }
+
+        // Split triangles in half of the longest axis of the centers bounds (fallback to the equal count split if all centers lie on one side)
+        const Float3 size = centersMax - centersMin;
+        const int32 axis = size.X > size.Y ? (size.X > size.Z ? 0 : 2) : (size.Y > size.Z ? 1 : 2);
+        const float split = (centersMin.Raw[axis] + centersMax.Raw[axis]) * 0.5f;
+        int32 left = item.Start, right = item.Start + item.Count - 1;
+        while (left <= right)
+        {
+            if (centers[left].Raw[axis] < split)
+            {
+                left++;
+            }
+            else
+            {
+                Swap(Triangles[left], Triangles[right]);
+                Swap(centers[left], centers[right]);
+                right--;
+            }
+        }
+        int32 leftCount = left - item.Start;
+        if (leftCount == 0 || leftCount == item.Count)
+            leftCount = item.Count / 2;
+
+        // Add children (it invalidates the node reference)
+        const int32 childIndex = Nodes.Count();
+        node.Index = childIndex;
+        node.Count = 0;
+        Nodes.AddUninitialized(2);
+        stack.Add({ childIndex, item.Start, leftCount });
+        stack.Add({ childIndex + 1, item.Start + leftCount, item.Count - leftCount });
+    }
+}
+
+bool CollisionProxy::Intersects(const Ray& ray, const Matrix& world, Real& distance, Vector3& normal) const
+{
+    const auto toWorld = [&world](const CollisionTriangle& triangle, Vector3& v0, Vector3& v1, Vector3& v2)
+    {
+        Float3 t;
+        Float3::Transform(triangle.V0, world, t);
+        v0 = t;
+        Float3::Transform(triangle.V1, world, t);
+        v1 = t;
+        Float3::Transform(triangle.V2, world, t);
+        v2 = t;
+    };
+    if (Nodes.IsEmpty())
+        return IntersectsBruteForce(*this, ray, toWorld, distance, normal);
+    Matrix invWorld;
+    Matrix::Invert(world, invWorld);
+    Float3 localOrigin, localDirection;
+    Float3::Transform(Float3(ray.Position), invWorld, localOrigin);
+    Float3::TransformNormal(Float3(ray.Direction), invWorld, localDirection);
+    return IntersectsBVH(*this, ray, localOrigin, localDirection, toWorld, distance, normal);
+}
+
+bool CollisionProxy::Intersects(const Ray& ray, const Transform& transform, Real& distance, Vector3& normal) const
+{
+    const auto toWorld = [&transform](const CollisionTriangle& triangle, Vector3& v0, Vector3& v1, Vector3& v2)
+    {
+        transform.LocalToWorld(triangle.V0, v0);
+        transform.LocalToWorld(triangle.V1, v1);
+        transform.LocalToWorld(triangle.V2, v2);
+    };
+    if (Nodes.IsEmpty())
+        return IntersectsBruteForce(*this, ray, toWorld, distance, normal);
+    Vector3 localOrigin, localDirection;
+    transform.WorldToLocal(ray.Position, localOrigin);
+    transform.WorldToLocalVector(ray.Direction, localDirection);
+    return IntersectsBVH(*this, ray, localOrigin, localDirection, toWorld, distance, normal);
+}
+
+bool CollisionProxy::ClosestPoint(const Vector3& point, const Transform& transform, Vector3& result, Real& distance) const
+{
+    distance = MAX_Real;
+    if (Triangles.IsEmpty())
+        return false;
+    const auto testTriangles = [&](int32 start, int32 count)
+    {
+        for (int32 i = start; i < start + count; i++)
+        {
+            const auto& triangle = Triangles[i];
+            Vector3 v0, v1, v2, p;
+            transform.LocalToWorld(triangle.V0, v0);
+            transform.LocalToWorld(triangle.V1, v1);
+            transform.LocalToWorld(triangle.V2, v2);
+            CollisionsHelper::ClosestPointPointTriangle(point, v0, v1, v2, p);
+            const Real d = Vector3::Distance(point, p);
+            if (d < distance)
+            {
+                distance = d;
+                result = p;
+            }
+        }
+    };
+    if (Nodes.IsEmpty())
+    {
+        testTriangles(0, Triangles.Count());
+        return true;
+    }
+
+    // Local-space distance scaled by the smallest scale component is the lower bound of the world-space distance to the node
+    Vector3 localPoint;
+    transform.WorldToLocal(point, localPoint);
+    const Float3 localPointFloat = localPoint;
+    const float minScale = transform.Scale.GetAbsolute().MinValue();
+    Array<int32, InlinedAllocation<64>> stack;
+    stack.Add(0);
+    while (stack.HasItems())
+    {
+        const auto& node = Nodes[stack.Pop()];
+        if (DistanceNodePoint(node, localPointFloat) * minScale >= distance)
+            continue;
+        if (node.Count == 0)
+        {
+            // Visit the closer child first
+            const float leftDistance = DistanceNodePoint(Nodes[node.Index], localPointFloat);
+            const float rightDistance = DistanceNodePoint(Nodes[node.Index + 1], localPointFloat);
+            stack.Add(leftDistance < rightDistance ? node.Index + 1 : node.Index);
+            stack.Add(leftDistance < rightDistance ? node.Index : node.Index + 1);
+            continue;
+        }
+        testTriangles(node.Index, node.Count);
+    }
+    return true;
+}
@@ -20,10 +20,26 @@ class FLAXENGINE_API CollisionProxy
     };
 
     /// <summary>
-    /// The triangles.
+    /// The Bounding Volume Hierarchy (BVH) node. Leaf nodes reference a contiguous range of the triangles, inner nodes reference two children stored next to each other.
+    /// </summary>
+    struct BVHNode
+    {
+        Float3 Min;
+        int32 Index; // The first triangle index (leaf) or the first child node index (inner node)
+        Float3 Max;
+        int32 Count; // The amount of triangles (leaf) or zero (inner node)
+    };
+
+    /// <summary>
+    /// The triangles (sorted to match the BVH leaves).
     /// </summary>
     Array<CollisionTriangle> Triangles;
 
+    /// <summary>
+    /// The BVH nodes (first node is a root) used to accelerate the geometry queries. Empty for small meshes that are tested brute force.
+    /// </summary>
+    Array<BVHNode> Nodes;
+
 public:
     FORCE_INLINE bool HasData() const
     {
@@ -48,53 +64,32 @@ class FLAXENGINE_API CollisionProxy
                 Triangles.Add({ positions[i0], positions[i1], positions[i2] });
             }
         }
+
+        BuildBVH();
     }
 
     void Clear()
     {
         Triangles.Clear();
+        Nodes.Clear();
     }
 
-    bool Intersects(const Ray& ray, const Matrix& world, Real& distance, Vector3& normal) const
-    {
-        distance = MAX_Real;
-        for (int32 i = 0; i < Triangles.Count(); i++)
-        {
-            CollisionTriangle triangle = Triangles[i];
-            Float3::Transform(triangle.V0, world, triangle.V0);
-            Float3::Transform(triangle.V1, world, triangle.V1);
-            Float3::Transform(triangle.V2, world, triangle.V2);
-
-            // TODO: use 32-bit precision for intersection
-            Real d;
-            if (CollisionsHelper::RayIntersectsTriangle(ray, triangle.V0, triangle.V1, triangle.V2, d) && d < distance)
-            {
-                normal = Vector3::Normalize((triangle.V1 - triangle.V0) ^ (triangle.V2 - triangle.V0));
-                distance = d;
-            }
-        }
-        return distance < MAX_Real;
-    }
+    /// <summary>
+    /// Builds the BVH over the triangles (reorders them). Skipped for meshes with less triangles than the leaf size.
+    /// </summary>
+    /// <param name="maxLeafSize">The maximum amount of triangles in a leaf node.</param>
+    void BuildBVH(int32 maxLeafSize = 8);
 
-    bool Intersects(const Ray& ray, const Transform& transform, Real& distance, Vector3& normal) const
-    {
-        distance = MAX_Real;
-        for (int32 i = 0; i < Triangles.Count(); i++)
-        {
-            CollisionTriangle triangle = Triangles[i];
-            Vector3 v0, v1, v2;
-            transform.LocalToWorld(triangle.V0, v0);
-            transform.LocalToWorld(triangle.V1, v1);
-            transform.LocalToWorld(triangle.V2, v2);
+    bool Intersects(const Ray& ray, const Matrix& world, Real& distance, Vector3& normal) const;
+    bool Intersects(const Ray& ray, const Transform& transform, Real& distance, Vector3& normal) const;
 
-            // TODO: use 32-bit precision for intersection
-            Real d;
-            if (CollisionsHelper::RayIntersectsTriangle(ray, v0, v1, v2, d) && d < distance)
-            {
-                normal = Vector3::Normalize((v1 - v0) ^ (v2 - v0));
-                distance = d;
-            }
-        }
-        return distance < MAX_Real;
-    }
+    /// <summary>
+    /// Finds the closest point on the triangles to the given location.
+    /// </summary>
+    /// <param name="point">The location to test (in world-space).</param>
+    /// <param name="transform">The local-to-world transformation of the triangles.</param>
+    /// <param name="result">The closest point on the mesh surface (in world-space).</param>
+    /// <param name="distance">The distance to the closest point.</param>
+    /// <returns>True if found any point (has triangles), otherwise false.</returns>
+    bool ClosestPoint(const Vector3& point, const Transform& transform, Vector3& result, Real& distance) const;
 };
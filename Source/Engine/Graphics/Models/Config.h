@@ -21,3 +21,13 @@
 
 // Defines the maximum allowed amount of skeleton bones to be used with skinned model
 #define MAX_BONES_PER_MODEL 256
+
+// The maximum amount of vertices and triangles per mesh meshlet (cluster of triangles with culling bounds)
+#define MODEL_MESHLET_MAX_VERTICES 64
+#define MODEL_MESHLET_MAX_TRIANGLES 124
+
+// The minimum amount of mesh triangles to build meshlets for it (only dense meshes benefit from the per-meshlet culling)
+#define MODEL_MESHLETS_MIN_TRIANGLES 16384
+
+// The maximum amount of draw calls emitted per mesh after meshlets culling (visible meshlets ranges are merged above this limit)
+#define MODEL_MESHLETS_MAX_DRAWS 16
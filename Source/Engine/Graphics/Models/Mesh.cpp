@@ -9,6 +9,7 @@
 #include "Engine/Core/Math/Transform.h"
 #include "Engine/Graphics/GPUContext.h"
 #include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/Graphics.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/RenderTools.h"
 #include "Engine/Profiler/ProfilerCPU.h"
@@ -93,6 +94,51 @@ namespace
         return mesh->UpdateMesh(vertexCount, triangleCount, (VB0ElementType*)vertices, vb1.Get(), vb2.HasItems() ? vb2.Get() : nullptr, triangles);
     }
 
+    struct MeshletsRange
+    {
+        uint32 StartIndex;
+        uint32 IndicesCount;
+    };
+
+    int32 CullMeshlets(const Array<ModelMeshlet>& meshlets, const RenderView& view, const Matrix& world, bool coneCulling, MeshletsRange ranges[MODEL_MESHLETS_MAX_DRAWS])
+    {
+        PROFILE_CPU();
+
+        // Cone culling is done in the mesh local-space to skip transforming every meshlet cone
+        Matrix invWorld;
+        Matrix::Invert(world, invWorld);
+        Float3 viewPosition;
+        Float3::Transform(view.Position, invWorld, viewPosition);
+        const float scale = world.GetScaleVector().GetAbsolute().MaxValue();
+
+        int32 rangesCount = 0;
+        for (const ModelMeshlet& meshlet : meshlets)
+        {
+            // Backface cone culling
+            if (coneCulling && Float3::Dot(Float3::Normalize(meshlet.ConeApex - viewPosition), meshlet.ConeAxis) >= meshlet.ConeCutoff)
+                continue;
+
+            // Frustum culling
+            Float3 center;
+            Float3::Transform(meshlet.Center, world, center);
+            if (!view.CullingFrustum.Intersects(BoundingSphere(center, meshlet.Radius * scale)))
+                continue;
+
+            // Merge with the previous range if contiguous, otherwise extend the last range once out of the draws limit
+            if (rangesCount != 0)
+            {
+                MeshletsRange& last = ranges[rangesCount - 1];
+                if (last.StartIndex + last.IndicesCount == meshlet.StartIndex || rangesCount == MODEL_MESHLETS_MAX_DRAWS)
+                {
+                    last.IndicesCount = meshlet.StartIndex + meshlet.IndicesCount - last.StartIndex;
+                    continue;
+                }
+            }
+            ranges[rangesCount++] = { meshlet.StartIndex, meshlet.IndicesCount };
+        }
+        return rangesCount;
+    }
+
 #if !COMPILE_WITHOUT_CSHARP
 
     template<typename IndexType>
@@ -135,6 +181,7 @@ bool Mesh::UpdateMesh(uint32 vertexCount, uint32 triangleCount, VB0ElementType*
     auto model = (Model*)_model;
 
     Unload();
+    Meshlets.Clear();
 
     // Setup GPU resources
     model->LODs[_lodIndex]._verticesCount -= _vertices;
@@ -182,7 +229,11 @@ bool Mesh::UpdateTriangles(uint32 triangleCount, void* ib, bool use16BitIndices)
     // TODO: update collision proxy
 
     // Initialize
-    SAFE_DELETE_GPU_RESOURCE(_indexBuffer);
+    Meshlets.Clear();
+    if (_geometry[3].IsValid())
+        MeshGeometryPool::Free(_geometry[3]);
+    else
+        SAFE_DELETE_GPU_RESOURCE(_indexBuffer);
     _indexBuffer = indexBuffer;
     _triangles = triangleCount;
     _use16BitIndexBuffer = use16BitIndices;
@@ -206,15 +257,14 @@ void Mesh::Init(Model* model, int32 lodIndex, int32 index, int32 materialSlotInd
     _vertexBuffers[1] = nullptr;
     _vertexBuffers[2] = nullptr;
     _indexBuffer = nullptr;
+    for (auto& geometry : _geometry)
+        geometry = MeshGeometryPool::Allocation();
 }
 
 Mesh::~Mesh()
 {
     // Release buffers
-    SAFE_DELETE_GPU_RESOURCE(_vertexBuffers[0]);
-    SAFE_DELETE_GPU_RESOURCE(_vertexBuffers[1]);
-    SAFE_DELETE_GPU_RESOURCE(_vertexBuffers[2]);
-    SAFE_DELETE_GPU_RESOURCE(_indexBuffer);
+    ReleaseBuffers();
 }
 
 bool Mesh::Load(uint32 vertices, uint32 triangles, void* vb0, void* vb1, void* vb2, void* ib, bool use16BitIndexBuffer)
@@ -228,6 +278,27 @@ bool Mesh::Load(uint32 vertices, uint32 triangles, void* vb0, void* vb1, void* v
     GPUBuffer* vertexBuffer2 = nullptr;
     GPUBuffer* indexBuffer = nullptr;
 
+    // Try to use the shared geometry pool
+    if (Graphics::MeshGeometryPool)
+    {
+        MeshGeometryPool::Allocation geometry[4];
+        if (!MeshGeometryPool::Allocate(MeshGeometryStream::Vertex0, vertices, vb0, geometry[0]) &&
+            !MeshGeometryPool::Allocate(MeshGeometryStream::Vertex1, vertices, vb1, geometry[1]) &&
+            (!vb2 || !MeshGeometryPool::Allocate(MeshGeometryStream::Vertex2, vertices, vb2, geometry[2])) &&
+            !MeshGeometryPool::Allocate(use16BitIndexBuffer ? MeshGeometryStream::Index16 : MeshGeometryStream::Index32, indicesCount, ib, geometry[3]))
+        {
+            for (int32 i = 0; i < 4; i++)
+                _geometry[i] = geometry[i];
+            vertexBuffer0 = geometry[0].Buffer;
+            vertexBuffer1 = geometry[1].Buffer;
+            vertexBuffer2 = geometry[2].Buffer;
+            indexBuffer = geometry[3].Buffer;
+            goto INIT_COLLISION;
+        }
+        for (int32 i = 0; i < 4; i++)
+            MeshGeometryPool::Free(geometry[i]);
+    }
+
     // Create GPU buffers
 #if GPU_ENABLE_RESOURCE_NAMING
 #define MESH_BUFFER_NAME(postfix) GetModel()->GetPath() + TEXT(postfix)
@@ -250,6 +321,7 @@ bool Mesh::Load(uint32 vertices, uint32 triangles, void* vb0, void* vb1, void* v
     if (indexBuffer->Init(GPUBufferDescription::Index(ibStride, indicesCount, ib)))
         goto ERROR_LOAD_END;
 
+INIT_COLLISION:
     // Init collision proxy
 #if USE_PRECISE_MESH_INTERSECTS
     if (!_collisionProxy.HasData())
@@ -287,10 +359,7 @@ bool Mesh::Load(uint32 vertices, uint32 triangles, void* vb0, void* vb1, void* v
 
 void Mesh::Unload()
 {
-    SAFE_DELETE_GPU_RESOURCE(_vertexBuffers[0]);
-    SAFE_DELETE_GPU_RESOURCE(_vertexBuffers[1]);
-    SAFE_DELETE_GPU_RESOURCE(_vertexBuffers[2]);
-    SAFE_DELETE_GPU_RESOURCE(_indexBuffer);
+    ReleaseBuffers();
     _triangles = 0;
     _vertices = 0;
     _use16BitIndexBuffer = false;
@@ -370,10 +439,10 @@ void Mesh::GetDrawCallGeometry(DrawCall& drawCall) const
     drawCall.Geometry.VertexBuffers[0] = _vertexBuffers[0];
     drawCall.Geometry.VertexBuffers[1] = _vertexBuffers[1];
     drawCall.Geometry.VertexBuffers[2] = _vertexBuffers[2];
-    drawCall.Geometry.VertexBuffersOffsets[0] = 0;
-    drawCall.Geometry.VertexBuffersOffsets[1] = 0;
-    drawCall.Geometry.VertexBuffersOffsets[2] = 0;
-    drawCall.Draw.StartIndex = 0;
+    drawCall.Geometry.VertexBuffersOffsets[0] = _geometry[0].GetByteOffset();
+    drawCall.Geometry.VertexBuffersOffsets[1] = _geometry[1].GetByteOffset();
+    drawCall.Geometry.VertexBuffersOffsets[2] = _geometry[2].GetByteOffset();
+    drawCall.Draw.StartIndex = _geometry[3].Offset;
     drawCall.Draw.IndicesCount = _triangles * 3;
 }
 
@@ -382,9 +451,10 @@ void Mesh::Render(GPUContext* context) const
     if (!IsInitialized())
         return;
 
-    context->BindVB(ToSpan((GPUBuffer**)_vertexBuffers, 3));
+    const uint32 vertexBuffersOffsets[3] = { _geometry[0].GetByteOffset(), _geometry[1].GetByteOffset(), _geometry[2].GetByteOffset() };
+    context->BindVB(ToSpan((GPUBuffer**)_vertexBuffers, 3), vertexBuffersOffsets);
     context->BindIB(_indexBuffer);
-    context->DrawIndexedInstanced(_triangles * 3, 1, 0, 0, 0);
+    context->DrawIndexedInstanced(_triangles * 3, 1, 0, 0, _geometry[3].Offset);
 }
 
 void Mesh::Draw(const RenderContext& renderContext, MaterialBase* material, const Matrix& world, StaticFlags flags, bool receiveDecals, DrawPass drawModes, float perInstanceRandom, int16 sortOrder) const
@@ -397,11 +467,7 @@ void Mesh::Draw(const RenderContext& renderContext, MaterialBase* material, cons
 
     // Setup draw call
     DrawCall drawCall;
-    drawCall.Geometry.IndexBuffer = _indexBuffer;
-    drawCall.Geometry.VertexBuffers[0] = _vertexBuffers[0];
-    drawCall.Geometry.VertexBuffers[1] = _vertexBuffers[1];
-    drawCall.Geometry.VertexBuffers[2] = _vertexBuffers[2];
-    drawCall.Draw.IndicesCount = _triangles * 3;
+    GetDrawCallGeometry(drawCall);
     drawCall.InstanceCount = 1;
     drawCall.Material = material;
     drawCall.World = world;
@@ -418,7 +484,7 @@ void Mesh::Draw(const RenderContext& renderContext, MaterialBase* material, cons
 #if USE_EDITOR
     const ViewMode viewMode = renderContext.View.Mode;
     if (viewMode == ViewMode::LightmapUVsDensity || viewMode == ViewMode::LODPreview)
-        GBufferPass::AddIndexBufferToModelLOD(_indexBuffer, &((Model*)_model)->LODs[_lodIndex]);
+        GBufferPass::AddIndexBufferToModelLOD(_indexBuffer, drawCall.Draw.StartIndex, &((Model*)_model)->LODs[_lodIndex]);
 #endif
 
     // Push draw call to the render list
@@ -434,9 +500,9 @@ void Mesh::Draw(const RenderContext& renderContext, const DrawInfo& info, float
 
     // Select material
     MaterialBase* material;
-    if (entry.Material && entry.Material->IsLoaded())
+    if (entry.Material && entry.Material->IsReady())
         material = entry.Material;
-    else if (slot.Material && slot.Material->IsLoaded())
+    else if (slot.Material && slot.Material->IsReady())
         material = slot.Material;
     else
         material = GPUDevice::Instance->GetDefaultMaterial();
@@ -451,14 +517,16 @@ void Mesh::Draw(const RenderContext& renderContext, const DrawInfo& info, float
 
     // Setup draw call
     DrawCall drawCall;
-    drawCall.Geometry.IndexBuffer = _indexBuffer;
-    drawCall.Geometry.VertexBuffers[0] = _vertexBuffers[0];
-    drawCall.Geometry.VertexBuffers[1] = _vertexBuffers[1];
-    drawCall.Geometry.VertexBuffers[2] = _vertexBuffers[2];
+    GetDrawCallGeometry(drawCall);
     if (info.Deformation)
     {
         info.Deformation->RunDeformers(this, MeshBufferType::Vertex0, drawCall.Geometry.VertexBuffers[0]);
         info.Deformation->RunDeformers(this, MeshBufferType::Vertex1, drawCall.Geometry.VertexBuffers[1]);
+        for (int32 i = 0; i < 2; i++)
+        {
+            if (drawCall.Geometry.VertexBuffers[i] != _vertexBuffers[i])
+                drawCall.Geometry.VertexBuffersOffsets[i] = 0; // Deformed vertices use a separate buffer
+        }
     }
     if (info.VertexColors && info.VertexColors[_lodIndex])
     {
@@ -469,7 +537,6 @@ void Mesh::Draw(const RenderContext& renderContext, const DrawInfo& info, float
         drawCall.Geometry.VertexBuffers[2] = info.VertexColors[_lodIndex];
         drawCall.Geometry.VertexBuffersOffsets[2] = vertexOffset * sizeof(VB2ElementType);
     }
-    drawCall.Draw.IndicesCount = _triangles * 3;
     drawCall.InstanceCount = 1;
     drawCall.Material = material;
     drawCall.World = *info.World;
@@ -486,10 +553,25 @@ void Mesh::Draw(const RenderContext& renderContext, const DrawInfo& info, float
 #if USE_EDITOR
     const ViewMode viewMode = renderContext.View.Mode;
     if (viewMode == ViewMode::LightmapUVsDensity || viewMode == ViewMode::LODPreview)
-        GBufferPass::AddIndexBufferToModelLOD(_indexBuffer, &((Model*)_model)->LODs[_lodIndex]);
+        GBufferPass::AddIndexBufferToModelLOD(_indexBuffer, drawCall.Draw.StartIndex, &((Model*)_model)->LODs[_lodIndex]);
 #endif
 
     // Push draw call to the render list
+    if (Meshlets.HasItems() && !info.Deformation && renderContext.View.Pass != DrawPass::Depth)
+    {
+        // Draw only the visible meshlets
+        MeshletsRange ranges[MODEL_MESHLETS_MAX_DRAWS];
+        const bool coneCulling = material->GetInfo().CullMode == CullMode::Normal && drawCall.WorldDeterminantSign > 0 && !renderContext.View.IsOrthographicProjection();
+        const int32 rangesCount = CullMeshlets(Meshlets, renderContext.View, drawCall.World, coneCulling, ranges);
+        const uint32 startIndex = drawCall.Draw.StartIndex;
+        for (int32 i = 0; i < rangesCount; i++)
+        {
+            drawCall.Draw.StartIndex = startIndex + ranges[i].StartIndex;
+            drawCall.Draw.IndicesCount = ranges[i].IndicesCount;
+            renderContext.List->AddDrawCall(renderContext, drawModes, info.Flags, drawCall, entry.ReceiveDecals, info.SortOrder);
+        }
+        return;
+    }
     renderContext.List->AddDrawCall(renderContext, drawModes, info.Flags, drawCall, entry.ReceiveDecals, info.SortOrder);
 }
 
@@ -502,9 +584,9 @@ void Mesh::Draw(const RenderContextBatch& renderContextBatch, const DrawInfo& in
 
     // Select material
     MaterialBase* material;
-    if (entry.Material && entry.Material->IsLoaded())
+    if (entry.Material && entry.Material->IsReady())
         material = entry.Material;
-    else if (slot.Material && slot.Material->IsLoaded())
+    else if (slot.Material && slot.Material->IsReady())
         material = slot.Material;
     else
         material = GPUDevice::Instance->GetDefaultMaterial();
@@ -513,14 +595,16 @@ void Mesh::Draw(const RenderContextBatch& renderContextBatch, const DrawInfo& in
 
     // Setup draw call
     DrawCall drawCall;
-    drawCall.Geometry.IndexBuffer = _indexBuffer;
-    drawCall.Geometry.VertexBuffers[0] = _vertexBuffers[0];
-    drawCall.Geometry.VertexBuffers[1] = _vertexBuffers[1];
-    drawCall.Geometry.VertexBuffers[2] = _vertexBuffers[2];
+    GetDrawCallGeometry(drawCall);
     if (info.Deformation)
     {
         info.Deformation->RunDeformers(this, MeshBufferType::Vertex0, drawCall.Geometry.VertexBuffers[0]);
         info.Deformation->RunDeformers(this, MeshBufferType::Vertex1, drawCall.Geometry.VertexBuffers[1]);
+        for (int32 i = 0; i < 2; i++)
+        {
+            if (drawCall.Geometry.VertexBuffers[i] != _vertexBuffers[i])
+                drawCall.Geometry.VertexBuffersOffsets[i] = 0; // Deformed vertices use a separate buffer
+        }
     }
     if (info.VertexColors && info.VertexColors[_lodIndex])
     {
@@ -531,7 +615,6 @@ void Mesh::Draw(const RenderContextBatch& renderContextBatch, const DrawInfo& in
         drawCall.Geometry.VertexBuffers[2] = info.VertexColors[_lodIndex];
         drawCall.Geometry.VertexBuffersOffsets[2] = vertexOffset * sizeof(VB2ElementType);
     }
-    drawCall.Draw.IndicesCount = _triangles * 3;
     drawCall.InstanceCount = 1;
     drawCall.Material = material;
     drawCall.World = *info.World;
@@ -548,14 +631,38 @@ void Mesh::Draw(const RenderContextBatch& renderContextBatch, const DrawInfo& in
 #if USE_EDITOR
     const ViewMode viewMode = renderContextBatch.GetMainContext().View.Mode;
     if (viewMode == ViewMode::LightmapUVsDensity || viewMode == ViewMode::LODPreview)
-        GBufferPass::AddIndexBufferToModelLOD(_indexBuffer, &((Model*)_model)->LODs[_lodIndex]);
+        GBufferPass::AddIndexBufferToModelLOD(_indexBuffer, drawCall.Draw.StartIndex, &((Model*)_model)->LODs[_lodIndex]);
 #endif
 
     // Push draw call to the render lists
     const auto shadowsMode = entry.ShadowsMode & slot.ShadowsMode;
     const auto drawModes = info.DrawModes & material->GetDrawModes();
-    if (drawModes != DrawPass::None)
-        renderContextBatch.GetMainContext().List->AddDrawCall(renderContextBatch, drawModes, info.Flags, shadowsMode, info.Bounds, drawCall, entry.ReceiveDecals, info.SortOrder);
+    if (drawModes == DrawPass::None)
+        return;
+    const RenderContext& mainContext = renderContextBatch.GetMainContext();
+    if (Meshlets.HasItems() && !info.Deformation && mainContext.View.Pass != DrawPass::Depth)
+    {
+        // Shadow projections use the whole mesh
+        DrawCall shadowsDrawCall = drawCall;
+        mainContext.List->AddShadowsDrawCall(renderContextBatch, drawModes, info.Flags, shadowsMode, info.Bounds, shadowsDrawCall, info.SortOrder);
+
+        // Main view draws only the visible meshlets
+        const DrawPass mainDrawModes = drawModes & mainContext.View.Pass & mainContext.View.GetShadowsDrawPassMask(shadowsMode);
+        if (mainDrawModes == DrawPass::None || !mainContext.View.CullingFrustum.Intersects(info.Bounds))
+            return;
+        MeshletsRange ranges[MODEL_MESHLETS_MAX_DRAWS];
+        const bool coneCulling = material->GetInfo().CullMode == CullMode::Normal && drawCall.WorldDeterminantSign > 0 && !mainContext.View.IsOrthographicProjection();
+        const int32 rangesCount = CullMeshlets(Meshlets, mainContext.View, drawCall.World, coneCulling, ranges);
+        const uint32 startIndex = drawCall.Draw.StartIndex;
+        for (int32 i = 0; i < rangesCount; i++)
+        {
+            drawCall.Draw.StartIndex = startIndex + ranges[i].StartIndex;
+            drawCall.Draw.IndicesCount = ranges[i].IndicesCount;
+            mainContext.List->AddDrawCall(mainContext, mainDrawModes, info.Flags, drawCall, entry.ReceiveDecals, info.SortOrder);
+        }
+        return;
+    }
+    mainContext.List->AddDrawCall(renderContextBatch, drawModes, info.Flags, shadowsMode, info.Bounds, drawCall, entry.ReceiveDecals, info.SortOrder);
 }
 
 bool Mesh::DownloadDataGPU(MeshBufferType type, BytesContainer& result) const
@@ -576,6 +683,21 @@ bool Mesh::DownloadDataGPU(MeshBufferType type, BytesContainer& result) const
         buffer = _vertexBuffers[2];
         break;
     }
+    const MeshGeometryPool::Allocation& geometry = _geometry[type == MeshBufferType::Index ? 3 : (int32)type - (int32)MeshBufferType::Vertex0];
+    if (buffer && geometry.IsValid())
+    {
+        // Download only the mesh range from the shared geometry buffer
+        if (IsInMainThread())
+        {
+            LOG(Warning, "Cannot download GPU buffer data on a main thread. Use staging readback buffer or invoke this function from another thread.");
+            return true;
+        }
+        Task* task = MeshGeometryPool::DownloadAsync(geometry, result);
+        if (task == nullptr)
+            return true;
+        task->Start();
+        return task->Wait();
+    }
     return buffer && buffer->DownloadData(result);
 }
 
@@ -597,6 +719,9 @@ Task* Mesh::DownloadDataGPUAsync(MeshBufferType type, BytesContainer& result) co
         buffer = _vertexBuffers[2];
         break;
     }
+    const MeshGeometryPool::Allocation& geometry = _geometry[type == MeshBufferType::Index ? 3 : (int32)type - (int32)MeshBufferType::Vertex0];
+    if (buffer && geometry.IsValid())
+        return MeshGeometryPool::DownloadAsync(geometry, result);
     return buffer ? buffer->DownloadDataAsync(result) : nullptr;
 }
 
@@ -617,14 +742,15 @@ bool Mesh::DownloadDataCPU(MeshBufferType type, BytesContainer& result, int32& c
         const auto chunkIndex = MODEL_LOD_TO_CHUNK_INDEX(GetLODIndex());
         if (model->LoadChunk(chunkIndex))
             return true;
-        const auto chunk = model->GetChunk(chunkIndex);
-        if (!chunk)
+        BytesContainer data;
+        model->GetLODData(GetLODIndex(), data);
+        if (data.IsInvalid())
         {
             LOG(Error, "Missing chunk.");
             return true;
         }
 
-        MemoryReadStream stream(chunk->Get(), chunk->Size());
+        MemoryReadStream stream(data.Get(), data.Length());
 
         // Seek to find mesh location
         for (int32 i = 0; i <= _index; i++)
@@ -690,6 +816,31 @@ bool Mesh::DownloadDataCPU(MeshBufferType type, BytesContainer& result, int32& c
     return false;
 }
 
+void Mesh::ReleaseBuffers()
+{
+    for (int32 i = 0; i < 3; i++)
+    {
+        if (_geometry[i].IsValid())
+        {
+            MeshGeometryPool::Free(_geometry[i]);
+            _vertexBuffers[i] = nullptr;
+        }
+        else
+        {
+            SAFE_DELETE_GPU_RESOURCE(_vertexBuffers[i]);
+        }
+    }
+    if (_geometry[3].IsValid())
+    {
+        MeshGeometryPool::Free(_geometry[3]);
+        _indexBuffer = nullptr;
+    }
+    else
+    {
+        SAFE_DELETE_GPU_RESOURCE(_indexBuffer);
+    }
+}
+
 ScriptingObject* Mesh::GetParentModel()
 {
     return _model;
@@ -4,6 +4,7 @@
 
 #include "MeshBase.h"
 #include "ModelInstanceEntry.h"
+#include "MeshGeometryPool.h"
 #include "Config.h"
 #include "Types.h"
 #if USE_PRECISE_MESH_INTERSECTS
@@ -22,6 +23,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Mesh : public MeshBase
     bool _hasLightmapUVs;
     GPUBuffer* _vertexBuffers[3] = {};
     GPUBuffer* _indexBuffer = nullptr;
+    MeshGeometryPool::Allocation _geometry[4]; // VB0, VB1, VB2, IB (valid only if allocated within the shared geometry pool)
 #if USE_PRECISE_MESH_INTERSECTS
     CollisionProxy _collisionProxy;
 #endif
@@ -29,6 +31,12 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Mesh : public MeshBase
     mutable Array<byte> _cachedIndexBuffer;
     mutable int32 _cachedIndexBufferCount;
 
+public:
+    /// <summary>
+    /// The mesh clusters (meshlets) used for the fine-grained culling of the dense meshes. Each meshlet references a contiguous range of the index buffer. Empty if not generated (see BuildSettings.GenerateMeshlets).
+    /// </summary>
+    Array<ModelMeshlet> Meshlets;
+
 public:
     Mesh(const Mesh& other)
         : Mesh()
@@ -70,6 +78,24 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Mesh : public MeshBase
         return _vertexBuffers[index];
     }
 
+    /// <summary>
+    /// Gets the vertex buffer byte offset (non-zero if mesh geometry is located within the shared geometry pool).
+    /// </summary>
+    /// <param name="index">The index.</param>
+    /// <returns>The offset (in bytes).</returns>
+    FORCE_INLINE uint32 GetVertexBufferOffset(int32 index) const
+    {
+        return _geometry[index].GetByteOffset();
+    }
+
+    /// <summary>
+    /// Gets the location of the first mesh index within the index buffer (non-zero if mesh geometry is located within the shared geometry pool).
+    /// </summary>
+    FORCE_INLINE uint32 GetIndexBufferStart() const
+    {
+        return _geometry[3].Offset;
+    }
+
     /// <summary>
     /// Determines whether this mesh is initialized (has vertex and index buffers initialized).
     /// </summary>
@@ -312,6 +338,8 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Mesh : public MeshBase
     bool DownloadDataCPU(MeshBufferType type, BytesContainer& result, int32& count) const override;
 
 private:
+    void ReleaseBuffers();
+
     // Internal bindings
     API_FUNCTION(NoProxy) ScriptingObject* GetParentModel();
 #if !COMPILE_WITHOUT_CSHARP
@@ -19,6 +19,7 @@ class Lightmap;
 class GPUBuffer;
 class SkinnedMeshDrawData;
 class BlendShapesInstance;
+class ModelDrawCache;
 
 /// <summary>
 /// Base class for model resources meshes.
@@ -241,5 +242,10 @@ API_CLASS(Abstract, NoSpawn) class FLAXENGINE_API MeshBase : public ScriptingObj
         /// The object sorting key.
         /// </summary>
         int16 SortOrder;
+
+        /// <summary>
+        /// The draw calls cache of the static object to use (optional). Skips the draw calls setup when object doesn't change between frames.
+        /// </summary>
+        ModelDrawCache* DrawCache = nullptr;
     };
 };
@@ -0,0 +1,159 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "MeshCodec.h"
+#include "Types.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Serialization/MemoryReadStream.h"
+#include "Engine/Serialization/MemoryWriteStream.h"
+#include <ThirdParty/meshoptimizer/meshoptimizer.h>
+
+// Version of the encoded meshes data layout
+#define MESH_CODEC_VERSION 1
+
+namespace
+{
+    void EncodeVertices(MemoryWriteStream& stream, Array<byte>& buffer, const void* vertices, uint32 count, uint32 stride)
+    {
+        buffer.Resize((int32)meshopt_encodeVertexBufferBound(count, stride), false);
+        const uint32 size = (uint32)meshopt_encodeVertexBuffer(buffer.Get(), buffer.Count(), vertices, count, stride);
+        stream.WriteUint32(size);
+        stream.WriteBytes(buffer.Get(), size);
+    }
+
+    const byte* ReadEncoded(const byte*& ptr, const byte* end, uint32& size)
+    {
+        if (end - ptr < (int64)sizeof(uint32))
+            return nullptr;
+        size = *(const uint32*)ptr;
+        ptr += sizeof(uint32);
+        if (end - ptr < (int64)size)
+            return nullptr;
+        const byte* result = ptr;
+        ptr += size;
+        return result;
+    }
+}
+
+bool MeshCodec::EncodeModelLOD(const Span<byte>& data, Array<byte>& result)
+{
+    PROFILE_CPU();
+    MemoryReadStream input(data.Get(), data.Length());
+    MemoryWriteStream output(data.Length());
+    output.WriteInt32(MESH_CODEC_VERSION);
+    output.WriteInt32(data.Length());
+    Array<byte> buffer;
+    Array<uint32> indices;
+    while (input.GetPosition() < input.GetLength())
+    {
+        // #MODEL_DATA_FORMAT_USAGE
+        uint32 vertices, triangles;
+        input.ReadUint32(&vertices);
+        input.ReadUint32(&triangles);
+        const uint32 indicesCount = triangles * 3;
+        const bool use16BitIndexBuffer = indicesCount <= MAX_uint16;
+        const uint32 ibStride = use16BitIndexBuffer ? sizeof(uint16) : sizeof(uint32);
+        if (vertices == 0 || triangles == 0 || input.GetLength() - input.GetPosition() < vertices * (sizeof(VB0ElementType) + sizeof(VB1ElementType)) + 1)
+            return true;
+        const auto vb0 = input.Move<VB0ElementType>(vertices);
+        const auto vb1 = input.Move<VB1ElementType>(vertices);
+        const bool hasColors = input.ReadBool();
+        const uint32 remaining = input.GetLength() - input.GetPosition();
+        if (remaining < (hasColors ? vertices * sizeof(VB2ElementType) : 0) + indicesCount * ibStride)
+            return true;
+        const VB2ElementType* vb2 = hasColors ? input.Move<VB2ElementType>(vertices) : nullptr;
+        const byte* ib = input.Move<byte>(indicesCount * ibStride);
+
+        output.WriteUint32(vertices);
+        output.WriteUint32(triangles);
+        output.WriteBool(hasColors);
+        EncodeVertices(output, buffer, vb0, vertices, sizeof(VB0ElementType));
+        EncodeVertices(output, buffer, vb1, vertices, sizeof(VB1ElementType));
+        if (hasColors)
+            EncodeVertices(output, buffer, vb2, vertices, sizeof(VB2ElementType));
+
+        // Index codec works on 32-bit indices (decoder outputs the original index size)
+        indices.Resize(indicesCount, false);
+        if (use16BitIndexBuffer)
+        {
+            for (uint32 i = 0; i < indicesCount; i++)
+                indices.Get()[i] = ((const uint16*)ib)[i];
+        }
+        else
+        {
+            Platform::MemoryCopy(indices.Get(), ib, indicesCount * sizeof(uint32));
+        }
+        buffer.Resize((int32)meshopt_encodeIndexBufferBound(indicesCount, vertices), false);
+        const uint32 size = (uint32)meshopt_encodeIndexBuffer(buffer.Get(), buffer.Count(), indices.Get(), indicesCount);
+        if (size == 0)
+            return true;
+        output.WriteUint32(size);
+        output.WriteBytes(buffer.Get(), size);
+    }
+    result.Set(output.GetHandle(), (int32)output.GetPosition());
+    return false;
+}
+
+bool MeshCodec::DecodeModelLOD(const Span<byte>& data, BytesContainer& result)
+{
+    PROFILE_CPU();
+    const byte* ptr = data.Get();
+    const byte* end = ptr + data.Length();
+    if (data.Length() < (int32)sizeof(int32) * 2 || ((const int32*)ptr)[0] != MESH_CODEC_VERSION)
+    {
+        LOG(Warning, "Invalid encoded mesh data.");
+        return true;
+    }
+    const int32 decodedSize = ((const int32*)ptr)[1];
+    ptr += sizeof(int32) * 2;
+    result.Allocate(decodedSize);
+    byte* dst = result.Get();
+    byte* dstEnd = dst + decodedSize;
+    while (ptr < end)
+    {
+        // #MODEL_DATA_FORMAT_USAGE
+        if (end - ptr < (int64)(sizeof(uint32) * 2 + 1))
+            break;
+        const uint32 vertices = ((const uint32*)ptr)[0];
+        const uint32 triangles = ((const uint32*)ptr)[1];
+        const bool hasColors = ptr[sizeof(uint32) * 2] != 0;
+        ptr += sizeof(uint32) * 2 + 1;
+        const uint32 indicesCount = triangles * 3;
+        const uint32 ibStride = indicesCount <= MAX_uint16 ? sizeof(uint16) : sizeof(uint32);
+        const uint64 meshSize = sizeof(uint32) * 2 + (uint64)vertices * (sizeof(VB0ElementType) + sizeof(VB1ElementType) + (hasColors ? sizeof(VB2ElementType) : 0)) + 1 + (uint64)indicesCount * ibStride;
+        if ((uint64)(dstEnd - dst) < meshSize)
+            break;
+        *(uint32*)dst = vertices;
+        *(uint32*)(dst + sizeof(uint32)) = triangles;
+        dst += sizeof(uint32) * 2;
+
+        uint32 size;
+        const byte* encoded = ReadEncoded(ptr, end, size);
+        if (!encoded || meshopt_decodeVertexBuffer(dst, vertices, sizeof(VB0ElementType), encoded, size) != 0)
+            break;
+        dst += vertices * sizeof(VB0ElementType);
+        encoded = ReadEncoded(ptr, end, size);
+        if (!encoded || meshopt_decodeVertexBuffer(dst, vertices, sizeof(VB1ElementType), encoded, size) != 0)
+            break;
+        dst += vertices * sizeof(VB1ElementType);
+        *dst++ = hasColors ? 1 : 0;
+        if (hasColors)
+        {
+            encoded = ReadEncoded(ptr, end, size);
+            if (!encoded || meshopt_decodeVertexBuffer(dst, vertices, sizeof(VB2ElementType), encoded, size) != 0)
+                break;
+            dst += vertices * sizeof(VB2ElementType);
+        }
+        encoded = ReadEncoded(ptr, end, size);
+        if (!encoded || meshopt_decodeIndexBuffer(dst, indicesCount, ibStride, encoded, size) != 0)
+            break;
+        dst += indicesCount * ibStride;
+    }
+    if (ptr != end || dst != dstEnd)
+    {
+        LOG(Warning, "Invalid encoded mesh data.");
+        result.Release();
+        return true;
+    }
+    return false;
+}
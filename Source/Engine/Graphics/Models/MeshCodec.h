@@ -0,0 +1,32 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/DataContainer.h"
+#include "Engine/Core/Collections/Array.h"
+
+/// <summary>
+/// The model meshes data compression utility. Encodes the vertex and index buffers of the model LOD data chunk with meshoptimizer codecs (lossless) which reduces the size on disk (especially when followed by the LZ4 compression).
+/// </summary>
+/// <remarks>
+/// Decoded data has the same layout as the model LOD data chunk (#MODEL_DATA_FORMAT_USAGE) so it can be used by the existing readers. Chunks storing the encoded data use FlaxChunkFlags::EncodedMeshData flag.
+/// </remarks>
+class FLAXENGINE_API MeshCodec
+{
+public:
+    /// <summary>
+    /// Encodes the model LOD data (static model meshes).
+    /// </summary>
+    /// <param name="data">The model LOD data chunk contents.</param>
+    /// <param name="result">The output encoded data.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    static bool EncodeModelLOD(const Span<byte>& data, Array<byte>& result);
+
+    /// <summary>
+    /// Decodes the model LOD data (static model meshes) encoded with EncodeModelLOD.
+    /// </summary>
+    /// <param name="data">The encoded data.</param>
+    /// <param name="result">The output model LOD data.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    static bool DecodeModelLOD(const Span<byte>& data, BytesContainer& result);
+};
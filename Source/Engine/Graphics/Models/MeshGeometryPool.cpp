@@ -0,0 +1,233 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "MeshGeometryPool.h"
+#include "Types.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Engine/EngineService.h"
+#include "Engine/Graphics/GPUBuffer.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/Async/Tasks/GPUUploadBufferTask.h"
+#include "Engine/Platform/CriticalSection.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/Threading.h"
+
+namespace
+{
+    struct Range
+    {
+        uint32 Offset;
+        uint32 Count;
+    };
+
+    struct Page
+    {
+        GPUBuffer* Buffer;
+        uint32 Capacity;
+        Array<Range> FreeRanges;
+    };
+
+    struct PendingFree
+    {
+        MeshGeometryPool::Allocation Alloc;
+        uint64 TargetFrame;
+    };
+
+    CriticalSection Locker;
+    Array<Page> Pages[(int32)MeshGeometryStream::MAX];
+    Array<PendingFree> PendingFrees;
+
+    uint32 GetStride(MeshGeometryStream stream)
+    {
+        switch (stream)
+        {
+        case MeshGeometryStream::Vertex0:
+            return sizeof(VB0ElementType);
+        case MeshGeometryStream::Vertex1:
+            return sizeof(VB1ElementType);
+        case MeshGeometryStream::Vertex2:
+            return sizeof(VB2ElementType);
+        case MeshGeometryStream::SkinnedVertex0:
+            return sizeof(VB0SkinnedElementType);
+        case MeshGeometryStream::Index16:
+            return sizeof(uint16);
+        case MeshGeometryStream::Index32:
+            return sizeof(uint32);
+        default:
+            return 0;
+        }
+    }
+
+    void FreeRange(const MeshGeometryPool::Allocation& allocation)
+    {
+        for (auto& pages : Pages)
+        {
+            for (Page& page : pages)
+            {
+                if (page.Buffer != allocation.Buffer)
+                    continue;
+
+                // Insert the free range (sorted by offset) and merge with the neighbours
+                auto& ranges = page.FreeRanges;
+                int32 index = 0;
+                while (index < ranges.Count() && ranges[index].Offset < allocation.Offset)
+                    index++;
+                ranges.Insert(index, { allocation.Offset, allocation.Count });
+                if (index + 1 < ranges.Count() && ranges[index].Offset + ranges[index].Count == ranges[index + 1].Offset)
+                {
+                    ranges[index].Count += ranges[index + 1].Count;
+                    ranges.RemoveAtKeepOrder(index + 1);
+                }
+                if (index > 0 && ranges[index - 1].Offset + ranges[index - 1].Count == ranges[index].Offset)
+                {
+                    ranges[index - 1].Count += ranges[index].Count;
+                    ranges.RemoveAtKeepOrder(index);
+                }
+                return;
+            }
+        }
+    }
+
+    void FlushPendingFrees()
+    {
+        const uint64 currentFrame = Engine::FrameCount;
+        for (int32 i = PendingFrees.Count() - 1; i >= 0; i--)
+        {
+            if (PendingFrees[i].TargetFrame <= currentFrame)
+            {
+                FreeRange(PendingFrees[i].Alloc);
+                PendingFrees.RemoveAt(i);
+            }
+        }
+    }
+}
+
+class MeshGeometryPoolService : public EngineService
+{
+public:
+    MeshGeometryPoolService()
+        : EngineService(TEXT("Mesh Geometry Pool"), -30)
+    {
+    }
+
+    void Dispose() override
+    {
+        ScopeLock lock(Locker);
+        PendingFrees.Clear();
+        for (auto& pages : Pages)
+        {
+            for (Page& page : pages)
+                SAFE_DELETE_GPU_RESOURCE(page.Buffer);
+            pages.Clear();
+        }
+    }
+};
+
+MeshGeometryPoolService MeshGeometryPoolServiceInstance;
+
+bool MeshGeometryPool::Allocate(MeshGeometryStream stream, uint32 count, const void* data, Allocation& result)
+{
+    const uint32 stride = GetStride(stream);
+    const uint32 capacity = MESH_GEOMETRY_POOL_PAGE_SIZE / stride;
+    if (count == 0 || count > capacity || !data || !GPUDevice::Instance)
+        return true;
+    ScopeLock lock(Locker);
+    FlushPendingFrees();
+    auto& pages = Pages[(int32)stream];
+
+    // Find the first free range that fits (keeps geometry packed at the start of the pages)
+    Page* page = nullptr;
+    uint32 offset = 0;
+    for (int32 pageIndex = 0; pageIndex < pages.Count() && !page; pageIndex++)
+    {
+        auto& ranges = pages[pageIndex].FreeRanges;
+        for (int32 i = 0; i < ranges.Count(); i++)
+        {
+            Range& range = ranges[i];
+            if (range.Count >= count)
+            {
+                page = &pages[pageIndex];
+                offset = range.Offset;
+                range.Offset += count;
+                range.Count -= count;
+                if (range.Count == 0)
+                    ranges.RemoveAtKeepOrder(i);
+                break;
+            }
+        }
+    }
+    if (!page)
+    {
+        // Create a new page
+        PROFILE_CPU_NAMED("Create Geometry Page");
+#if GPU_ENABLE_RESOURCE_NAMING
+        GPUBuffer* buffer = GPUDevice::Instance->CreateBuffer(String::Format(TEXT("MeshGeometryPool.{0}.{1}"), (int32)stream, pages.Count()));
+#else
+        GPUBuffer* buffer = GPUDevice::Instance->CreateBuffer(String::Empty);
+#endif
+        const bool isIndex = stream == MeshGeometryStream::Index16 || stream == MeshGeometryStream::Index32;
+        if (buffer->Init(isIndex ? GPUBufferDescription::Index(stride, capacity) : GPUBufferDescription::Vertex(stride, capacity)))
+        {
+            LOG(Warning, "Failed to create mesh geometry pool buffer.");
+            Delete(buffer);
+            return true;
+        }
+        page = &pages.AddOne();
+        page->Buffer = buffer;
+        page->Capacity = capacity;
+        page->FreeRanges.Clear();
+        page->FreeRanges.Add({ count, capacity - count });
+        offset = 0;
+    }
+    result.Buffer = page->Buffer;
+    result.Offset = offset;
+    result.Count = count;
+    result.Stride = stride;
+
+    // Upload geometry data
+    const uint32 size = count * stride;
+    if (GPUDevice::Instance->IsRendering() && IsInMainThread())
+    {
+        GPUDevice::Instance->GetMainContext()->UpdateBuffer(result.Buffer, data, size, result.GetByteOffset());
+    }
+    else
+    {
+        auto uploadTask = ::New<GPUUploadBufferTask>(result.Buffer, (int32)result.GetByteOffset(), Span<byte>((const byte*)data, size), true);
+        uploadTask->Start();
+    }
+    return false;
+}
+
+void MeshGeometryPool::Free(Allocation& allocation)
+{
+    if (!allocation.IsValid())
+        return;
+    ScopeLock lock(Locker);
+    PendingFrees.Add({ allocation, Engine::FrameCount + MESH_GEOMETRY_POOL_FREE_FRAMES });
+    allocation = Allocation();
+}
+
+Task* MeshGeometryPool::DownloadAsync(const Allocation& allocation, BytesContainer& result)
+{
+    if (!allocation.IsValid())
+        return nullptr;
+    auto data = New<BytesContainer>();
+    Task* task = allocation.Buffer->DownloadDataAsync(*data);
+    if (!task)
+    {
+        Delete(data);
+        return nullptr;
+    }
+    const uint32 offset = allocation.GetByteOffset();
+    const uint32 size = allocation.Count * allocation.Stride;
+    const Function<void()> action = [data, offset, size, &result]
+    {
+        if (data->Length() >= (int32)(offset + size))
+            result.Copy(data->Get() + offset, size);
+        Delete(data);
+    };
+    task->ContinueWith(action);
+    return task;
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Core/Types/DataContainer.h"
+
+class GPUBuffer;
+class Task;
+
+// Size (in bytes) of the single shared buffer page within the meshes geometry pool
+#define MESH_GEOMETRY_POOL_PAGE_SIZE (32 * 1024 * 1024)
+
+// Amount of frames after which the released geometry range can be reused
+#define MESH_GEOMETRY_POOL_FREE_FRAMES 4
+
+/// <summary>
+/// The type of the geometry data stream stored within the meshes geometry pool.
+/// </summary>
+enum class MeshGeometryStream
+{
+    Vertex0,
+    Vertex1,
+    Vertex2,
+    SkinnedVertex0,
+    Index16,
+    Index32,
+    MAX
+};
+
+/// <summary>
+/// Global pool of a few large vertex and index buffers shared by the model meshes (used when Graphics::MeshGeometryPool is enabled). Mesh geometry is sub-allocated within shared buffers so draw calls only differ in the offsets which reduces buffer binding changes between draws and the amount of small GPU allocations.
+/// </summary>
+class FLAXENGINE_API MeshGeometryPool
+{
+public:
+    /// <summary>
+    /// The geometry range allocated within the shared buffer.
+    /// </summary>
+    struct Allocation
+    {
+        GPUBuffer* Buffer = nullptr;
+        uint32 Offset = 0;
+        uint32 Count = 0;
+        uint32 Stride = 0;
+
+        FORCE_INLINE bool IsValid() const
+        {
+            return Buffer != nullptr;
+        }
+
+        FORCE_INLINE uint32 GetByteOffset() const
+        {
+            return Offset * Stride;
+        }
+    };
+
+public:
+    /// <summary>
+    /// Allocates the geometry range within the pool and uploads its data to the GPU.
+    /// </summary>
+    /// <param name="stream">The geometry stream type.</param>
+    /// <param name="count">The amount of elements to allocate.</param>
+    /// <param name="data">The initial data (count elements of the stream type).</param>
+    /// <param name="result">The result allocation.</param>
+    /// <returns>True if failed (eg. geometry is too big for the pool), otherwise false.</returns>
+    static bool Allocate(MeshGeometryStream stream, uint32 count, const void* data, Allocation& result);
+
+    /// <summary>
+    /// Frees the allocated geometry range (reused after a few frames).
+    /// </summary>
+    /// <param name="allocation">The allocation to free. Reset on return.</param>
+    static void Free(Allocation& allocation);
+
+    /// <summary>
+    /// Downloads the allocated geometry range data from the GPU (whole shared buffer is copied to the staging memory).
+    /// </summary>
+    /// <param name="allocation">The allocation.</param>
+    /// <param name="result">The result data.</param>
+    /// <returns>The download task (not started) or null if failed.</returns>
+    static Task* DownloadAsync(const Allocation& allocation, BytesContainer& result);
+};
@@ -0,0 +1,169 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "ModelDrawCache.h"
+#include "Engine/Content/Assets/Material.h"
+#include "Engine/Content/Assets/Model.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Renderer/RenderList.h"
+
+void ModelDrawCache::Clear()
+{
+    _lodsMask = 0;
+    for (auto& entries : _lods)
+        entries.Resize(0);
+}
+
+bool ModelDrawCache::Draw(const RenderContext& renderContext, const Model* model, int32 lodIndex, const Mesh::DrawInfo& info)
+{
+    if (Prepare(renderContext, model, lodIndex, info))
+        return true;
+    const RenderView& view = renderContext.View;
+    for (const Entry& e : _lods[lodIndex])
+    {
+        const auto drawModes = info.DrawModes & view.Pass & view.GetShadowsDrawPassMask(e.ShadowsMode) & e.Call.Material->GetDrawModes();
+        if (drawModes != DrawPass::None)
+            renderContext.List->AddCachedDrawCall(renderContext, drawModes, info.Flags, e.Call, e.ReceiveDecals);
+    }
+    return false;
+}
+
+bool ModelDrawCache::Draw(const RenderContextBatch& renderContextBatch, const Model* model, int32 lodIndex, const Mesh::DrawInfo& info)
+{
+    const RenderContext& renderContext = renderContextBatch.GetMainContext();
+    if (Prepare(renderContext, model, lodIndex, info))
+        return true;
+    for (const Entry& e : _lods[lodIndex])
+    {
+        const auto drawModes = info.DrawModes & e.Call.Material->GetDrawModes();
+        if (drawModes != DrawPass::None)
+            renderContext.List->AddCachedDrawCall(renderContextBatch, drawModes, info.Flags, e.ShadowsMode, info.Bounds, e.Call, e.ReceiveDecals);
+    }
+    return false;
+}
+
+bool ModelDrawCache::Prepare(const RenderContext& renderContext, const Model* model, int32 lodIndex, const Mesh::DrawInfo& info)
+{
+#if USE_EDITOR
+    // Debug view modes collect the data during meshes drawing
+    const ViewMode viewMode = renderContext.View.Mode;
+    if (viewMode == ViewMode::LightmapUVsDensity || viewMode == ViewMode::LODPreview)
+        return true;
+#endif
+    const ModelLOD& lod = model->LODs.Get()[lodIndex];
+    auto& entries = _lods[lodIndex];
+    const Rectangle lightmapUVs = info.LightmapUVs ? *info.LightmapUVs : Rectangle::Empty;
+    if (_origin != renderContext.View.Origin || _lightmap != info.Lightmap || _lightmapUVs != lightmapUVs || _flags != info.Flags || _sortOrder != info.SortOrder)
+        _lodsMask = 0;
+    const uint32 lodMask = 1u << lodIndex;
+    GPUBuffer* vertexColors = info.VertexColors ? info.VertexColors[lodIndex] : nullptr;
+    if (_lodsMask & lodMask)
+    {
+        // Validate the cached geometry (eg. LOD streamed out and in, virtual mesh updated or material reloaded)
+        bool valid = true;
+        for (int32 i = 0; i < entries.Count() && valid; i++)
+        {
+            const Entry& e = entries.Get()[i];
+            if (e.MeshIndex >= lod.Meshes.Count())
+            {
+                valid = false;
+                break;
+            }
+            const Mesh& mesh = lod.Meshes.Get()[e.MeshIndex];
+            valid = mesh.GetIndexBuffer() == e.Call.Geometry.IndexBuffer &&
+                    mesh.GetIndexBufferStart() == e.Call.Draw.StartIndex &&
+                    mesh.GetVertexBuffer(0) == e.Call.Geometry.VertexBuffers[0] &&
+                    mesh.GetVertexBufferOffset(0) == e.Call.Geometry.VertexBuffersOffsets[0] &&
+                    (vertexColors ? vertexColors : mesh.GetVertexBuffer(2)) == e.Call.Geometry.VertexBuffers[2] &&
+                    mesh.GetTriangleCount() * 3 == e.Call.Draw.IndicesCount &&
+                    e.Call.Material->IsReady();
+        }
+        if (valid)
+            return false;
+        _lodsMask &= ~lodMask;
+    }
+
+    // Cache only static objects (previous frame transform has to match the current one)
+    if (*info.World != info.DrawState->PrevWorld)
+        return true;
+
+    // Build draw calls
+    entries.Clear();
+    bool complete = true;
+    uint32 vertexOffset = 0;
+    for (int32 meshIndex = 0; meshIndex < lod.Meshes.Count(); meshIndex++)
+    {
+        const Mesh& mesh = lod.Meshes.Get()[meshIndex];
+        if (mesh.Meshlets.HasItems())
+        {
+            // Meshlets are culled per-view so the draw calls cannot be reused
+            entries.Clear();
+            return true;
+        }
+        const uint32 meshVertexOffset = vertexOffset;
+        vertexOffset += mesh.GetVertexCount();
+        const auto& entry = info.Buffer->At(mesh.GetMaterialSlotIndex());
+        if (!entry.Visible)
+            continue;
+        if (!mesh.IsInitialized())
+        {
+            complete = false;
+            continue;
+        }
+        const MaterialSlot& slot = model->MaterialSlots[mesh.GetMaterialSlotIndex()];
+
+        // Select material (don't keep the draw calls using fallback material while the actual one is still loading)
+        MaterialBase* material;
+        if (entry.Material && entry.Material->IsReady())
+        {
+            material = entry.Material;
+        }
+        else if (slot.Material && slot.Material->IsReady())
+        {
+            material = slot.Material;
+            complete &= !entry.Material;
+        }
+        else
+        {
+            material = GPUDevice::Instance->GetDefaultMaterial();
+            complete &= !entry.Material && !slot.Material;
+        }
+        if (!material || !material->IsSurface())
+            continue;
+
+        // Setup draw call
+        Entry& e = entries.AddOne();
+        e.MeshIndex = meshIndex;
+        e.ShadowsMode = entry.ShadowsMode & slot.ShadowsMode;
+        e.ReceiveDecals = entry.ReceiveDecals;
+        DrawCall& drawCall = e.Call;
+        mesh.GetDrawCallGeometry(drawCall);
+        if (vertexColors)
+        {
+            drawCall.Geometry.VertexBuffers[2] = vertexColors;
+            drawCall.Geometry.VertexBuffersOffsets[2] = meshVertexOffset * sizeof(VB2ElementType);
+        }
+        drawCall.InstanceCount = 1;
+        drawCall.Material = material;
+        drawCall.World = *info.World;
+        drawCall.ObjectPosition = drawCall.World.GetTranslation();
+        drawCall.ObjectRadius = info.Bounds.Radius;
+        drawCall.Surface.GeometrySize = mesh.GetBox().GetSize();
+        drawCall.Surface.PrevWorld = info.DrawState->PrevWorld;
+        drawCall.Surface.Lightmap = (info.Flags & StaticFlags::Lightmap) != StaticFlags::None ? info.Lightmap : nullptr;
+        drawCall.Surface.LightmapUVsArea = lightmapUVs;
+        drawCall.Surface.Skinning = nullptr;
+        drawCall.Surface.LODDitherFactor = 0.0f;
+        drawCall.WorldDeterminantSign = Math::FloatSelect(drawCall.World.RotDeterminant(), 1, -1);
+        drawCall.PerInstanceRandom = info.PerInstanceRandom;
+        RenderList::CalculateBatchKey(drawCall, info.SortOrder);
+    }
+    _origin = renderContext.View.Origin;
+    _lightmap = info.Lightmap;
+    _lightmapUVs = lightmapUVs;
+    _flags = info.Flags;
+    _sortOrder = info.SortOrder;
+    if (complete)
+        _lodsMask |= lodMask;
+    return false;
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Mesh.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Math/Rectangle.h"
+#include "Engine/Renderer/DrawCall.h"
+
+/// <summary>
+/// The model instance draw calls (per LOD) retained between frames for the static objects. Skips the draw calls setup and batch keys calculation when the object doesn't change.
+/// </summary>
+/// <remarks>
+/// The owner has to invalidate the cache on the instance state changes (eg. transform or material entries). Geometry, lightmap and view origin changes are detected on draw.
+/// </remarks>
+class FLAXENGINE_API ModelDrawCache
+{
+private:
+    struct Entry
+    {
+        DrawCall Call;
+        int32 MeshIndex;
+        ShadowsCastingMode ShadowsMode;
+        bool ReceiveDecals;
+    };
+
+    Array<Entry> _lods[MODEL_MAX_LODS];
+    uint32 _lodsMask = 0;
+    Vector3 _origin;
+    const Lightmap* _lightmap = nullptr;
+    Rectangle _lightmapUVs;
+    StaticFlags _flags = StaticFlags::None;
+    int16 _sortOrder = 0;
+
+public:
+    /// <summary>
+    /// Invalidates the cached draw calls. They will be rebuilt on the next draw.
+    /// </summary>
+    FORCE_INLINE void Invalidate()
+    {
+        _lodsMask = 0;
+    }
+
+    /// <summary>
+    /// Releases the cached draw calls memory.
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// Draws the model LOD using the cached draw calls (rebuilds them if invalid).
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="model">The model to draw.</param>
+    /// <param name="lodIndex">The model LOD index to draw.</param>
+    /// <param name="info">The packed drawing info data.</param>
+    /// <returns>True if cache cannot be used and model has to be drawn directly, otherwise false.</returns>
+    bool Draw(const RenderContext& renderContext, const Model* model, int32 lodIndex, const Mesh::DrawInfo& info);
+
+    /// <summary>
+    /// Draws the model LOD using the cached draw calls (rebuilds them if invalid).
+    /// </summary>
+    /// <param name="renderContextBatch">The rendering context batch.</param>
+    /// <param name="model">The model to draw.</param>
+    /// <param name="lodIndex">The model LOD index to draw.</param>
+    /// <param name="info">The packed drawing info data.</param>
+    /// <returns>True if cache cannot be used and model has to be drawn directly, otherwise false.</returns>
+    bool Draw(const RenderContextBatch& renderContextBatch, const Model* model, int32 lodIndex, const Mesh::DrawInfo& info);
+
+private:
+    bool Prepare(const RenderContext& renderContext, const Model* model, int32 lodIndex, const Mesh::DrawInfo& info);
+};
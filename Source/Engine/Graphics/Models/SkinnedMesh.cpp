@@ -8,10 +8,12 @@
 #include "Engine/Core/Log.h"
 #include "Engine/Graphics/GPUContext.h"
 #include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/Graphics.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/RenderTools.h"
 #include "Engine/Level/Scene/Scene.h"
 #include "Engine/Renderer/RenderList.h"
+#include "Engine/Renderer/Utils/ComputeSkinning.h"
 #include "Engine/Serialization/MemoryReadStream.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Scripting/ManagedCLR/MCore.h"
@@ -94,6 +96,8 @@ void SkinnedMesh::Init(SkinnedModel* model, int32 lodIndex, int32 index, int32 m
     _triangles = 0;
     _vertexBuffer = nullptr;
     _indexBuffer = nullptr;
+    _geometry[0] = MeshGeometryPool::Allocation();
+    _geometry[1] = MeshGeometryPool::Allocation();
     _cachedIndexBuffer.Clear();
     _cachedVertexBuffer.Clear();
     BlendShapes.Clear();
@@ -101,8 +105,7 @@ void SkinnedMesh::Init(SkinnedModel* model, int32 lodIndex, int32 index, int32 m
 
 SkinnedMesh::~SkinnedMesh()
 {
-    SAFE_DELETE_GPU_RESOURCE(_vertexBuffer);
-    SAFE_DELETE_GPU_RESOURCE(_indexBuffer);
+    ReleaseBuffers();
 }
 
 bool SkinnedMesh::Load(uint32 vertices, uint32 triangles, void* vb0, void* ib, bool use16BitIndexBuffer)
@@ -114,6 +117,23 @@ bool SkinnedMesh::Load(uint32 vertices, uint32 triangles, void* vb0, void* ib, b
     GPUBuffer* vertexBuffer = nullptr;
     GPUBuffer* indexBuffer = nullptr;
 
+    // Try to use the shared geometry pool
+    if (Graphics::MeshGeometryPool)
+    {
+        MeshGeometryPool::Allocation geometry[2];
+        if (!MeshGeometryPool::Allocate(MeshGeometryStream::SkinnedVertex0, vertices, vb0, geometry[0]) &&
+            !MeshGeometryPool::Allocate(use16BitIndexBuffer ? MeshGeometryStream::Index16 : MeshGeometryStream::Index32, indicesCount, ib, geometry[1]))
+        {
+            _geometry[0] = geometry[0];
+            _geometry[1] = geometry[1];
+            vertexBuffer = geometry[0].Buffer;
+            indexBuffer = geometry[1].Buffer;
+            goto INIT_END;
+        }
+        MeshGeometryPool::Free(geometry[0]);
+        MeshGeometryPool::Free(geometry[1]);
+    }
+
     // Create vertex buffer
 #if GPU_ENABLE_RESOURCE_NAMING
     vertexBuffer = GPUDevice::Instance->CreateBuffer(GetSkinnedModel()->GetPath() + TEXT(".VB"));
@@ -132,6 +152,7 @@ bool SkinnedMesh::Load(uint32 vertices, uint32 triangles, void* vb0, void* ib, b
     if (indexBuffer->Init(GPUBufferDescription::Index(ibStride, indicesCount, ib)))
         goto ERROR_LOAD_END;
 
+INIT_END:
     // Initialize
     _vertexBuffer = vertexBuffer;
     _indexBuffer = indexBuffer;
@@ -150,8 +171,7 @@ bool SkinnedMesh::Load(uint32 vertices, uint32 triangles, void* vb0, void* ib, b
 
 void SkinnedMesh::Unload()
 {
-    SAFE_DELETE_GPU_RESOURCE(_vertexBuffer);
-    SAFE_DELETE_GPU_RESOURCE(_indexBuffer);
+    ReleaseBuffers();
     _cachedIndexBuffer.Clear();
     _cachedVertexBuffer.Clear();
     _triangles = 0;
@@ -164,6 +184,7 @@ bool SkinnedMesh::UpdateMesh(uint32 vertexCount, uint32 triangleCount, VB0Skinne
     auto model = (SkinnedModel*)_model;
 
     // Setup GPU resources
+    ReleaseBuffers();
     const bool failed = Load(vertexCount, triangleCount, vb, ib, use16BitIndices);
     if (!failed)
     {
@@ -205,9 +226,10 @@ void SkinnedMesh::Render(GPUContext* context) const
 {
     ASSERT(IsInitialized());
 
-    context->BindVB(ToSpan(&_vertexBuffer, 1));
+    const uint32 vertexBufferOffset = _geometry[0].GetByteOffset();
+    context->BindVB(ToSpan(&_vertexBuffer, 1), &vertexBufferOffset);
     context->BindIB(_indexBuffer);
-    context->DrawIndexed(_triangles * 3);
+    context->DrawIndexed(_triangles * 3, 0, _geometry[1].Offset);
 }
 
 void SkinnedMesh::Draw(const RenderContext& renderContext, const DrawInfo& info, float lodDitherFactor) const
@@ -219,9 +241,9 @@ void SkinnedMesh::Draw(const RenderContext& renderContext, const DrawInfo& info,
 
     // Select material
     MaterialBase* material;
-    if (entry.Material && entry.Material->IsLoaded())
+    if (entry.Material && entry.Material->IsReady())
         material = entry.Material;
-    else if (slot.Material && slot.Material->IsLoaded())
+    else if (slot.Material && slot.Material->IsReady())
         material = slot.Material;
     else
         material = GPUDevice::Instance->GetDefaultMaterial();
@@ -238,9 +260,14 @@ void SkinnedMesh::Draw(const RenderContext& renderContext, const DrawInfo& info,
     DrawCall drawCall;
     drawCall.Geometry.IndexBuffer = _indexBuffer;
     drawCall.Geometry.VertexBuffers[0] = _vertexBuffer;
+    drawCall.Geometry.VertexBuffersOffsets[0] = _geometry[0].GetByteOffset();
     if (info.Deformation)
+    {
         info.Deformation->RunDeformers(this, MeshBufferType::Vertex0, drawCall.Geometry.VertexBuffers[0]);
-    drawCall.Draw.StartIndex = 0;
+        if (drawCall.Geometry.VertexBuffers[0] != _vertexBuffer)
+            drawCall.Geometry.VertexBuffersOffsets[0] = 0; // Deformed vertices use a separate buffer
+    }
+    drawCall.Draw.StartIndex = _geometry[1].Offset;
     drawCall.Draw.IndicesCount = _triangles * 3;
     drawCall.InstanceCount = 1;
     drawCall.Material = material;
@@ -257,7 +284,21 @@ void SkinnedMesh::Draw(const RenderContext& renderContext, const DrawInfo& info,
     drawCall.PerInstanceRandom = info.PerInstanceRandom;
 
     // Push draw call to the render list
-    renderContext.List->AddDrawCall(renderContext, drawModes, StaticFlags::None, drawCall, entry.ReceiveDecals, info.SortOrder);
+    DrawPass skinnedDrawModes = drawModes;
+    if (Graphics::GPUSkinning && info.Skinning)
+    {
+        // Draw vertices skinned with a compute shader as a static mesh (motion vectors still use the vertex shader skinning for the previous frame bones)
+        DrawCall computeDrawCall = drawCall;
+        const DrawPass computeDrawModes = drawModes & ~DrawPass::MotionVectors;
+        if (computeDrawModes != DrawPass::None && !ComputeSkinning::Instance()->Skin(this, info.Skinning, drawCall.Geometry.VertexBuffers[0], drawCall.Geometry.VertexBuffersOffsets[0], computeDrawCall))
+        {
+            computeDrawCall.Surface.Skinning = nullptr;
+            renderContext.List->AddDrawCall(renderContext, computeDrawModes, StaticFlags::None, computeDrawCall, entry.ReceiveDecals, info.SortOrder);
+            skinnedDrawModes &= DrawPass::MotionVectors;
+        }
+    }
+    if (skinnedDrawModes != DrawPass::None)
+        renderContext.List->AddDrawCall(renderContext, skinnedDrawModes, StaticFlags::None, drawCall, entry.ReceiveDecals, info.SortOrder);
 }
 
 void SkinnedMesh::Draw(const RenderContextBatch& renderContextBatch, const DrawInfo& info, float lodDitherFactor) const
@@ -269,9 +310,9 @@ void SkinnedMesh::Draw(const RenderContextBatch& renderContextBatch, const DrawI
 
     // Select material
     MaterialBase* material;
-    if (entry.Material && entry.Material->IsLoaded())
+    if (entry.Material && entry.Material->IsReady())
         material = entry.Material;
-    else if (slot.Material && slot.Material->IsLoaded())
+    else if (slot.Material && slot.Material->IsReady())
         material = slot.Material;
     else
         material = GPUDevice::Instance->GetDefaultMaterial();
@@ -282,8 +323,14 @@ void SkinnedMesh::Draw(const RenderContextBatch& renderContextBatch, const DrawI
     DrawCall drawCall;
     drawCall.Geometry.IndexBuffer = _indexBuffer;
     drawCall.Geometry.VertexBuffers[0] = _vertexBuffer;
+    drawCall.Geometry.VertexBuffersOffsets[0] = _geometry[0].GetByteOffset();
     if (info.Deformation)
+    {
         info.Deformation->RunDeformers(this, MeshBufferType::Vertex0, drawCall.Geometry.VertexBuffers[0]);
+        if (drawCall.Geometry.VertexBuffers[0] != _vertexBuffer)
+            drawCall.Geometry.VertexBuffersOffsets[0] = 0; // Deformed vertices use a separate buffer
+    }
+    drawCall.Draw.StartIndex = _geometry[1].Offset;
     drawCall.Draw.IndicesCount = _triangles * 3;
     drawCall.InstanceCount = 1;
     drawCall.Material = material;
@@ -302,8 +349,24 @@ void SkinnedMesh::Draw(const RenderContextBatch& renderContextBatch, const DrawI
     // Push draw call to the render lists
     const auto shadowsMode = entry.ShadowsMode & slot.ShadowsMode;
     const auto drawModes = info.DrawModes & material->GetDrawModes();
-    if (drawModes != DrawPass::None)
-        renderContextBatch.GetMainContext().List->AddDrawCall(renderContextBatch, drawModes, StaticFlags::None, shadowsMode, info.Bounds, drawCall, entry.ReceiveDecals, info.SortOrder);
+    if (drawModes == DrawPass::None)
+        return;
+    RenderList* renderList = renderContextBatch.GetMainContext().List;
+    DrawPass skinnedDrawModes = drawModes;
+    if (Graphics::GPUSkinning && info.Skinning)
+    {
+        // Draw vertices skinned with a compute shader as a static mesh (motion vectors still use the vertex shader skinning for the previous frame bones)
+        DrawCall computeDrawCall = drawCall;
+        const DrawPass computeDrawModes = drawModes & ~DrawPass::MotionVectors;
+        if (computeDrawModes != DrawPass::None && !ComputeSkinning::Instance()->Skin(this, info.Skinning, drawCall.Geometry.VertexBuffers[0], drawCall.Geometry.VertexBuffersOffsets[0], computeDrawCall))
+        {
+            computeDrawCall.Surface.Skinning = nullptr;
+            renderList->AddDrawCall(renderContextBatch, computeDrawModes, StaticFlags::None, shadowsMode, info.Bounds, computeDrawCall, entry.ReceiveDecals, info.SortOrder);
+            skinnedDrawModes &= DrawPass::MotionVectors;
+        }
+    }
+    if (skinnedDrawModes != DrawPass::None)
+        renderList->AddDrawCall(renderContextBatch, skinnedDrawModes, StaticFlags::None, shadowsMode, info.Bounds, drawCall, entry.ReceiveDecals, info.SortOrder);
 }
 
 bool SkinnedMesh::DownloadDataGPU(MeshBufferType type, BytesContainer& result) const
@@ -318,6 +381,20 @@ bool SkinnedMesh::DownloadDataGPU(MeshBufferType type, BytesContainer& result) c
         buffer = _vertexBuffer;
         break;
     }
+    if (buffer && _geometry[type == MeshBufferType::Index ? 1 : 0].IsValid())
+    {
+        // Download only the mesh range from the shared geometry buffer
+        if (IsInMainThread())
+        {
+            LOG(Warning, "Cannot download GPU buffer data on a main thread. Use staging readback buffer or invoke this function from another thread.");
+            return true;
+        }
+        Task* task = MeshGeometryPool::DownloadAsync(_geometry[type == MeshBufferType::Index ? 1 : 0], result);
+        if (task == nullptr)
+            return true;
+        task->Start();
+        return task->Wait();
+    }
     return buffer && buffer->DownloadData(result);
 }
 
@@ -333,6 +410,8 @@ Task* SkinnedMesh::DownloadDataGPUAsync(MeshBufferType type, BytesContainer& res
         buffer = _vertexBuffer;
         break;
     }
+    if (buffer && _geometry[type == MeshBufferType::Index ? 1 : 0].IsValid())
+        return MeshGeometryPool::DownloadAsync(_geometry[type == MeshBufferType::Index ? 1 : 0], result);
     return buffer ? buffer->DownloadDataAsync(result) : nullptr;
 }
 
@@ -421,6 +500,28 @@ bool SkinnedMesh::DownloadDataCPU(MeshBufferType type, BytesContainer& result, i
     return false;
 }
 
+void SkinnedMesh::ReleaseBuffers()
+{
+    if (_geometry[0].IsValid())
+    {
+        MeshGeometryPool::Free(_geometry[0]);
+        _vertexBuffer = nullptr;
+    }
+    else
+    {
+        SAFE_DELETE_GPU_RESOURCE(_vertexBuffer);
+    }
+    if (_geometry[1].IsValid())
+    {
+        MeshGeometryPool::Free(_geometry[1]);
+        _indexBuffer = nullptr;
+    }
+    else
+    {
+        SAFE_DELETE_GPU_RESOURCE(_indexBuffer);
+    }
+}
+
 ScriptingObject* SkinnedMesh::GetParentModel()
 {
     return _model;
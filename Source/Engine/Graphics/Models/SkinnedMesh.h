@@ -4,6 +4,7 @@
 
 #include "MeshBase.h"
 #include "Types.h"
+#include "MeshGeometryPool.h"
 #include "BlendShape.h"
 
 /// <summary>
@@ -15,6 +16,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API SkinnedMesh : public MeshBase
 protected:
     GPUBuffer* _vertexBuffer = nullptr;
     GPUBuffer* _indexBuffer = nullptr;
+    MeshGeometryPool::Allocation _geometry[2]; // VB0, IB (valid only if allocated within the shared geometry pool)
     mutable Array<byte> _cachedIndexBuffer;
     mutable Array<byte> _cachedVertexBuffer;
     mutable int32 _cachedIndexBufferCount;
@@ -185,6 +187,8 @@ API_CLASS(NoSpawn) class FLAXENGINE_API SkinnedMesh : public MeshBase
     bool DownloadDataCPU(MeshBufferType type, BytesContainer& result, int32& count) const override;
 
 private:
+    void ReleaseBuffers();
+
     // Internal bindings
     API_FUNCTION(NoProxy) ScriptingObject* GetParentModel();
 #if !COMPILE_WITHOUT_CSHARP
@@ -193,3 +193,15 @@ PACK_STRUCT(struct VB0SkinnedElementType2
 
 typedef VB0SkinnedElementType2 VB0SkinnedElementType;
 //
+
+// Mesh triangles cluster with the culling bounds (in mesh local space). Meshlet triangles use a contiguous range within the mesh index buffer.
+PACK_STRUCT(struct ModelMeshlet
+    {
+    Float3 Center;
+    float Radius;
+    Float3 ConeApex;
+    float ConeCutoff;
+    Float3 ConeAxis;
+    uint32 StartIndex;
+    uint32 IndicesCount;
+    });
@@ -89,6 +89,11 @@ API_CLASS() class FLAXENGINE_API RenderBuffers : public ScriptingObject
     GPUTexture* TemporalAA = nullptr;
     uint64 LastFrameTemporalAA = 0;
 
+    // Helper target for the Variable Rate Shading image (generated from the previous frame).
+    // Should be released if not used for a few frames.
+    GPUTexture* ShadingRate = nullptr;
+    uint64 LastFrameShadingRate = 0;
+
     // Maps the custom buffer type into the object that holds the state.
     Array<CustomBuffer*, HeapAllocation> CustomBuffers;
 
@@ -2,6 +2,8 @@
 
 #include "RenderTargetPool.h"
 #include "GPUDevice.h"
+#include "Graphics.h"
+#include "RenderTools.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Profiler/ProfilerCPU.h"
@@ -10,6 +12,7 @@ struct Entry
 {
     GPUTexture* RT;
     uint64 LastFrameReleased;
+    uint64 MemoryUsage;
     uint32 DescriptionHash;
     bool IsOccupied;
 };
@@ -17,6 +20,31 @@ struct Entry
 namespace
 {
     Array<Entry> TemporaryRTs;
+    uint64 TemporaryRTsMemoryUsage = 0;
+
+    void ReleaseOverBudget(uint64 extraMemory)
+    {
+        if (Graphics::RenderTargetPoolBudget <= 0)
+            return;
+        const uint64 budget = (uint64)Graphics::RenderTargetPoolBudget * 1024 * 1024;
+        while (TemporaryRTsMemoryUsage + extraMemory > budget)
+        {
+            // Release the unused render target that was not used for the longest time
+            int32 oldest = -1;
+            for (int32 i = 0; i < TemporaryRTs.Count(); i++)
+            {
+                const auto& e = TemporaryRTs[i];
+                if (!e.IsOccupied && (oldest == -1 || e.LastFrameReleased < TemporaryRTs[oldest].LastFrameReleased))
+                    oldest = i;
+            }
+            if (oldest == -1)
+                break;
+            const auto& e = TemporaryRTs[oldest];
+            TemporaryRTsMemoryUsage -= e.MemoryUsage;
+            e.RT->DeleteObjectNow();
+            TemporaryRTs.RemoveAt(oldest);
+        }
+    }
 }
 
 void RenderTargetPool::Flush(bool force, int32 framesOffset)
@@ -33,12 +61,19 @@ void RenderTargetPool::Flush(bool force, int32 framesOffset)
         const auto& e = TemporaryRTs[i];
         if (!e.IsOccupied && (force || e.LastFrameReleased < maxReleaseFrame))
         {
+            TemporaryRTsMemoryUsage -= e.MemoryUsage;
             e.RT->DeleteObjectNow();
             TemporaryRTs.RemoveAt(i--);
             if (TemporaryRTs.IsEmpty())
                 break;
         }
     }
+    ReleaseOverBudget(0);
+}
+
+uint64 RenderTargetPool::GetMemoryUsage()
+{
+    return TemporaryRTsMemoryUsage;
 }
 
 GPUTexture* RenderTargetPool::Get(const GPUTextureDescription& desc)
@@ -50,7 +85,7 @@ GPUTexture* RenderTargetPool::Get(const GPUTextureDescription& desc)
     for (int32 i = 0; i < TemporaryRTs.Count(); i++)
     {
         auto& e = TemporaryRTs[i];
-        if (!e.IsOccupied && e.DescriptionHash == descHash)
+        if (!e.IsOccupied && e.DescriptionHash == descHash && e.RT->GetDescription() == desc)
         {
             // Mark as used
             e.IsOccupied = true;
@@ -65,6 +100,9 @@ GPUTexture* RenderTargetPool::Get(const GPUTextureDescription& desc)
     }
 #endif
 
+    // Make space for a new rt
+    ReleaseOverBudget(RenderTools::CalculateTextureMemoryUsage(desc.Format, desc.Width, desc.Height, desc.Depth, desc.MipLevels) * desc.ArraySize);
+
     // Create new rt
     const String name = TEXT("TemporaryRT_") + StringUtils::ToString(TemporaryRTs.Count());
     GPUTexture* rt = GPUDevice::Instance->CreateTexture(name);
@@ -80,8 +118,10 @@ GPUTexture* RenderTargetPool::Get(const GPUTextureDescription& desc)
     e.IsOccupied = true;
     e.LastFrameReleased = 0;
     e.RT = rt;
+    e.MemoryUsage = rt->GetMemoryUsage();
     e.DescriptionHash = descHash;
     TemporaryRTs.Add(e);
+    TemporaryRTsMemoryUsage += e.MemoryUsage;
 
     return rt;
 }
@@ -18,6 +18,11 @@ API_CLASS(Static) class FLAXENGINE_API RenderTargetPool
     /// <param name="framesOffset">Amount of previous frames that should persist in the pool after flush. Resources used more than given value wil be freed. Use value of -1 to auto pick default duration.</param>
     static void Flush(bool force = false, int32 framesOffset = -1);
 
+    /// <summary>
+    /// Gets the total GPU memory used by the pooled render targets (in bytes), including the ones that are not used at the moment. Limited by <see cref="Graphics::RenderTargetPoolBudget"/>.
+    /// </summary>
+    API_PROPERTY() static uint64 GetMemoryUsage();
+
     /// <summary>
     /// Gets a temporary render target.
     /// </summary>
@@ -4,6 +4,7 @@
 #include "RenderBuffers.h"
 #include "GPUDevice.h"
 #include "GPUSwapChain.h"
+#include "GPUTimerQuery.h"
 #include "PostProcessEffect.h"
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Debug/DebugLog.h"
@@ -148,6 +149,8 @@ SceneRenderTask::SceneRenderTask(const SpawnParams& params)
 
 SceneRenderTask::~SceneRenderTask()
 {
+    for (auto& timer : _dynamicResolutionTimers)
+        SAFE_DELETE_GPU_RESOURCE(timer);
     if (Buffers)
         Buffers->DeleteObjectNow();
     if (_customActorsScene)
@@ -361,9 +364,55 @@ GPUTextureView* SceneRenderTask::GetOutputView() const
     return nullptr;
 }
 
+void SceneRenderTask::UpdateDynamicResolution()
+{
+    if (DynamicResolutionTargetTime <= 0.0f || _dynamicResolutionFrame == Engine::FrameCount)
+        return;
+    _dynamicResolutionFrame = Engine::FrameCount;
+
+    // Gather the finished GPU time measurements of the previous frames (scaled to the current rendering resolution, assuming cost proportional to the pixels count)
+    const float minPercentage = Math::Clamp(DynamicResolutionMin, 0.1f, 1.0f);
+    const float maxPercentage = Math::Clamp(DynamicResolutionMax, minPercentage, 1.0f);
+    for (int32 i = 0; i < ARRAY_COUNT(_dynamicResolutionTimers); i++)
+    {
+        GPUTimerQuery* timer = _dynamicResolutionTimers[i];
+        if (timer && _dynamicResolutionPercentages[i] > 0.0f && timer->HasResult())
+        {
+            const float scale = RenderingPercentage / _dynamicResolutionPercentages[i];
+            const float time = timer->GetResult() * scale * scale;
+            _dynamicResolutionTime = _dynamicResolutionTime > 0.0f ? Math::Lerp(_dynamicResolutionTime, time, 0.2f) : time;
+            _dynamicResolutionPercentages[i] = 0.0f;
+        }
+    }
+    if (_dynamicResolutionTime <= 0.0f)
+        return;
+    if (_dynamicResolutionCooldown > 0)
+    {
+        _dynamicResolutionCooldown--;
+        return;
+    }
+
+    // Change the resolution only if the time is out of the hysteresis range (drop fast when over budget, grow slowly to prevent oscillations)
+    const float target = DynamicResolutionTargetTime;
+    float percentage = RenderingPercentage;
+    if (_dynamicResolutionTime > target)
+        percentage *= Math::Max(Math::Sqrt(target * 0.95f / _dynamicResolutionTime), 0.8f);
+    else if (_dynamicResolutionTime < target * 0.8f)
+        percentage *= Math::Min(Math::Sqrt(target * 0.9f / _dynamicResolutionTime), 1.05f);
+
+    // Quantize the resolution scale to reduce the render buffers reallocations
+    percentage = Math::Clamp(Math::Round(percentage * 40.0f) / 40.0f, minPercentage, maxPercentage);
+    if (Math::NotNearEqual(percentage, RenderingPercentage))
+    {
+        RenderingPercentage = percentage;
+        _dynamicResolutionCooldown = 10;
+    }
+}
+
 void SceneRenderTask::OnBegin(GPUContext* context)
 {
     RenderTask::OnBegin(context);
+    UpdateDynamicResolution();
 
     // Copy view info if camera is specified
     if (Camera)
@@ -386,8 +435,28 @@ void SceneRenderTask::OnBegin(GPUContext* context)
 void SceneRenderTask::OnRender(GPUContext* context)
 {
     if (!IsCustomRendering && Buffers && Buffers->GetWidth() > 0)
+    {
+        // Measure the GPU time of the scene rendering for the dynamic resolution (skip if all queries are still in flight)
+        GPUTimerQuery* timer = nullptr;
+        if (DynamicResolutionTargetTime > 0.0f)
+        {
+            const int32 index = (int32)(Engine::FrameCount % ARRAY_COUNT(_dynamicResolutionTimers));
+            if (!_dynamicResolutionTimers[index])
+                _dynamicResolutionTimers[index] = GPUDevice::Instance->CreateTimerQuery();
+            if (_dynamicResolutionPercentages[index] <= 0.0f)
+            {
+                timer = _dynamicResolutionTimers[index];
+                _dynamicResolutionPercentages[index] = RenderingPercentage;
+                timer->Begin();
+            }
+        }
+
         Renderer::Render(this);
 
+        if (timer)
+            timer->End();
+    }
+
     RenderTask::OnRender(context);
 }
 
@@ -449,6 +518,7 @@ void MainRenderTask::OnBegin(GPUContext* context)
 
 #if !USE_EDITOR
     // Sync render buffers size with the backbuffer
+    UpdateDynamicResolution();
     const auto size = Screen::GetSize();
     Buffers->Init((int32)(size.X * RenderingPercentage), (int32)(size.Y * RenderingPercentage));
 #endif
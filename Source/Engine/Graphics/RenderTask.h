@@ -5,6 +5,7 @@
 #include "Engine/Core/Delegate.h"
 #include "Engine/Core/Math/Viewport.h"
 #include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Memory/FrameAllocation.h"
 #include "Engine/Platform/CriticalSection.h"
 #include "Engine/Scripting/ScriptingObjectReference.h"
 #include "Engine/Scripting/ScriptingType.h"
@@ -16,6 +17,7 @@ class GPUContext;
 class GPUTexture;
 class GPUTextureView;
 class GPUSwapChain;
+class GPUTimerQuery;
 class RenderBuffers;
 class PostProcessEffect;
 struct RenderContext;
@@ -213,6 +215,11 @@ API_CLASS() class FLAXENGINE_API SceneRenderTask : public RenderTask
     DECLARE_SCRIPTING_TYPE(SceneRenderTask);
 protected:
     class SceneRendering* _customActorsScene = nullptr;
+    GPUTimerQuery* _dynamicResolutionTimers[3] = {};
+    float _dynamicResolutionPercentages[3] = {};
+    float _dynamicResolutionTime = 0.0f;
+    uint64 _dynamicResolutionFrame = 0;
+    int32 _dynamicResolutionCooldown = 0;
 
 public:
     /// <summary>
@@ -271,6 +278,21 @@ API_CLASS() class FLAXENGINE_API SceneRenderTask : public RenderTask
     /// </summary>
     API_FIELD() RenderingUpscaleLocation UpscaleLocation = RenderingUpscaleLocation::AfterAntiAliasingPass;
 
+    /// <summary>
+    /// The target GPU time (in milliseconds) of the scene rendering for the dynamic resolution. If above 0, then RenderingPercentage is automatically adjusted every frame (within the min/max range) to keep the measured GPU time of the task near the target. Use with TAA and BeforePostProcessingPass upscale location for the best quality.
+    /// </summary>
+    API_FIELD() float DynamicResolutionTargetTime = 0.0f;
+
+    /// <summary>
+    /// The minimum scale of the rendering resolution used by the dynamic resolution.
+    /// </summary>
+    API_FIELD(Attributes="Limit(0.1f, 1.0f, 0.01f)") float DynamicResolutionMin = 0.5f;
+
+    /// <summary>
+    /// The maximum scale of the rendering resolution used by the dynamic resolution.
+    /// </summary>
+    API_FIELD(Attributes="Limit(0.1f, 1.0f, 0.01f)") float DynamicResolutionMax = 1.0f;
+
 public:
     /// <summary>
     /// The custom set of actors to render. Used when ActorsSources::CustomActors flag is active.
@@ -403,6 +425,9 @@ API_CLASS() class FLAXENGINE_API SceneRenderTask : public RenderTask
     /// </summary>
     API_PROPERTY() GPUTextureView* GetOutputView() const;
 
+protected:
+    void UpdateDynamicResolution();
+
 public:
     // [RenderTask]
     bool Resize(int32 width, int32 height) override;
@@ -505,9 +530,9 @@ API_STRUCT(NoDefault) struct RenderContextBatch
     API_FIELD() Array<RenderContext, RendererAllocation> Contexts;
 
     /// <summary>
-    /// The Job System labels to wait on, after draw calls collecting.
+    /// The Job System labels to wait on, after draw calls collecting. Uses frame allocation so the batch should not outlive the frame.
     /// </summary>
-    API_FIELD() Array<uint64, InlinedAllocation<8>> WaitLabels;
+    API_FIELD() Array<uint64, InlinedAllocation<8, FrameAllocation>> WaitLabels;
 
     /// <summary>
     /// Enables using async tasks via Job System when performing drawing.
@@ -421,6 +421,7 @@ int32 RenderTools::ComputeModelLOD(const Model* model, const Float3& origin, flo
     // Check if model is being culled
     if (Math::Square(model->MinScreenSize * 0.5f) > screenRadiusSquared)
         return -1;
+    model->MarkUsed(screenRadiusSquared, Time::Draw.LastBegin);
 
     // Skip if no need to calculate LOD
     if (model->LODs.Count() <= 1)
@@ -446,6 +447,7 @@ int32 RenderTools::ComputeSkinnedModelLOD(const SkinnedModel* model, const Float
     // Check if model is being culled
     if (Math::Square(model->MinScreenSize * 0.5f) > screenRadiusSquared)
         return -1;
+    model->MarkUsed(screenRadiusSquared, Time::Draw.LastBegin);
 
     // Skip if no need to calculate LOD
     if (model->LODs.Count() <= 1)
@@ -19,10 +19,17 @@ void RenderView::Prepare(RenderContext& renderContext)
     Float2 taaJitter;
     NonJitteredProjection = Projection;
     IsTaaResolved = false;
+    TexturesMipBias = 0.0f;
     if (renderContext.List->Setup.UseTemporalAAJitter)
     {
-        // Move to the next frame
-        const int MaxSampleCount = 8;
+        // Move to the next frame (temporal upscaling needs more samples to cover each output pixel)
+        int32 MaxSampleCount = 8;
+        if (renderContext.List->Setup.UseTemporalUpscaling)
+        {
+            const float upscaleRatio = renderContext.Task->GetOutputViewport().Width / width;
+            MaxSampleCount = Math::Clamp((int32)(8.0f * upscaleRatio * upscaleRatio), 8, 64);
+            TexturesMipBias = Math::Log2(1.0f / upscaleRatio);
+        }
         if (++TaaFrameIndex >= MaxSampleCount)
             TaaFrameIndex = 0;
 
@@ -190,6 +190,11 @@ API_STRUCT(NoDefault) struct FLAXENGINE_API RenderView
     /// </summary>
     API_FIELD() Float4 TemporalAAJitter;
 
+    /// <summary>
+    /// The mip-map level bias applied to the material textures sampling. Negative when rendering at lower resolution with temporal upscaling (to match the output resolution texture detail). Cached before rendering.
+    /// </summary>
+    API_FIELD() float TexturesMipBias = 0.0f;
+
     /// <summary>
     /// The previous frame rendering view origin.
     /// </summary>
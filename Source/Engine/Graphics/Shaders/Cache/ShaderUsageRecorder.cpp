@@ -0,0 +1,146 @@
+// Copyright (c) 2012-2022 Wojciech Figat. All rights reserved.
+
+#include "ShaderUsageRecorder.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Types/StringBuilder.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Platform/FileSystem.h"
+#include "Engine/Platform/CriticalSection.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Engine/CommandLine.h"
+#include "Engine/Engine/EngineService.h"
+#include "Engine/Engine/Globals.h"
+#include "Engine/Graphics/Shaders/GPUShader.h"
+#include "Engine/Graphics/Shaders/GPUShaderProgram.h"
+
+#if !BUILD_RELEASE
+
+namespace
+{
+    CriticalSection Locker;
+
+    // Used permutations per shader resource name (asset path), resolved into asset ids on save
+    Dictionary<String, HashSet<StringAnsi>> Recorded;
+}
+
+class ShaderUsageRecorderService : public EngineService
+{
+public:
+    ShaderUsageRecorderService()
+        : EngineService(TEXT("Shader Usage Recorder"), -190)
+    {
+    }
+
+    bool Init() override
+    {
+        ShaderUsageRecorder::Enabled = CommandLine::Options.RecordShaders.IsTrue();
+        if (ShaderUsageRecorder::Enabled)
+            LOG(Info, "Recording shaders usage to {0}", ShaderUsageRecorder::GetDefaultPath());
+        return false;
+    }
+
+    void Dispose() override
+    {
+        if (ShaderUsageRecorder::Enabled)
+        {
+            ShaderUsageRecorder::Save(ShaderUsageRecorder::GetDefaultPath());
+            ShaderUsageRecorder::Enabled = false;
+        }
+        Recorded.Clear();
+    }
+};
+
+ShaderUsageRecorderService ShaderUsageRecorderServiceInstance;
+
+bool ShaderUsageRecorder::Enabled = false;
+
+void ShaderUsageRecorder::OnUsed(const GPUShaderProgram* program)
+{
+    if (!program || !program->GetOwner())
+        return;
+    const StringView ownerName = program->GetOwner()->GetName();
+    if (ownerName.IsEmpty())
+        return;
+    const StringAnsi entry = StringAnsi::Format("{}:{}", program->GetName(), program->GetPermutationIndex());
+
+    ScopeLock lock(Locker);
+    Recorded[String(ownerName)].Add(entry);
+}
+
+String ShaderUsageRecorder::GetDefaultPath()
+{
+#if USE_EDITOR
+    return Globals::ProjectCacheFolder / TEXT("ShadersUsage.txt");
+#else
+    return Globals::ProductLocalFolder / TEXT("ShadersUsage.txt");
+#endif
+}
+
+bool ShaderUsageRecorder::Save(const StringView& path)
+{
+    // Merge with the existing data to accumulate usage over multiple sessions
+    UsageData data;
+    if (FileSystem::FileExists(path))
+        Load(path, data);
+    {
+        ScopeLock lock(Locker);
+        for (auto& e : Recorded)
+        {
+            Asset* asset = Content::GetAsset(e.Key);
+            if (!asset)
+                continue;
+            auto& set = data[asset->GetID()];
+            for (auto& permutation : e.Value)
+                set.Add(permutation.Item);
+        }
+    }
+
+    StringBuilder text;
+    for (auto& e : data)
+    {
+        const String id = e.Key.ToString(Guid::FormatType::N);
+        for (auto& permutation : e.Value)
+        {
+            text.Append(id).Append(TEXT(' ')).Append(String(permutation.Item)).Append(TEXT('\n'));
+        }
+    }
+    if (File::WriteAllText(path, text, Encoding::ANSI))
+    {
+        LOG(Warning, "Failed to save shaders usage to {0}", path);
+        return true;
+    }
+    LOG(Info, "Saved shaders usage for {0} asset(s) to {1}", data.Count(), path);
+    return false;
+}
+
+#endif
+
+bool ShaderUsageRecorder::Load(const StringView& path, UsageData& data)
+{
+    StringAnsi text;
+    if (File::ReadAllText(path, text))
+        return true;
+    const char* ptr = text.Get();
+    const char* end = ptr + text.Length();
+    while (ptr < end)
+    {
+        // Parse a single line
+        const char* lineStart = ptr;
+        while (ptr < end && *ptr != '\n')
+            ptr++;
+        const char* lineEnd = ptr;
+        ptr++;
+        while (lineEnd > lineStart && (lineEnd[-1] == '\r' || lineEnd[-1] == ' '))
+            lineEnd--;
+        const char* separator = lineStart;
+        while (separator < lineEnd && *separator != ' ')
+            separator++;
+        if (separator == lineStart || separator + 1 >= lineEnd)
+            continue;
+        Guid id;
+        if (Guid::Parse(StringAnsiView(lineStart, (int32)(separator - lineStart)), id) || !id.IsValid())
+            continue;
+        data[id].Add(StringAnsi(separator + 1, (int32)(lineEnd - separator - 1)));
+    }
+    return false;
+}
@@ -0,0 +1,58 @@
+// Copyright (c) 2012-2022 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/Guid.h"
+#include "Engine/Core/Types/String.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Collections/HashSet.h"
+
+class GPUShaderProgram;
+
+/// <summary>
+/// Records the shader function permutations used at runtime (by the pipeline states) to allow stripping the unused variants when cooking the game.
+/// </summary>
+/// <remarks>
+/// The usage file is a text file with a single entry per line in format: '[asset id] [function name]:[permutation index]'.
+/// </remarks>
+class FLAXENGINE_API ShaderUsageRecorder
+{
+public:
+    /// <summary>
+    /// The used permutations (as 'FunctionName:PermutationIndex') per shader asset id.
+    /// </summary>
+    typedef Dictionary<Guid, HashSet<StringAnsi>> UsageData;
+
+#if !BUILD_RELEASE
+    /// <summary>
+    /// True if the shaders usage recording is enabled (via -recordshaders command line switch).
+    /// </summary>
+    static bool Enabled;
+
+    /// <summary>
+    /// Called when the shader program gets used by the pipeline state. Safe to call from any thread.
+    /// </summary>
+    /// <param name="program">The used shader program. Can be null.</param>
+    static void OnUsed(const GPUShaderProgram* program);
+
+    /// <summary>
+    /// Gets the default path of the recorded shaders usage file.
+    /// </summary>
+    static String GetDefaultPath();
+
+    /// <summary>
+    /// Saves the recorded shaders usage to the file (merged with the existing file contents).
+    /// </summary>
+    /// <param name="path">The output file path.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    static bool Save(const StringView& path);
+#endif
+
+    /// <summary>
+    /// Loads the shaders usage from the file.
+    /// </summary>
+    /// <param name="path">The input file path.</param>
+    /// <param name="data">The output usage data (loaded entries are appended).</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    static bool Load(const StringView& path, UsageData& data);
+};
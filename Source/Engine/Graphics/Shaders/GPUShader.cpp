@@ -16,6 +16,7 @@ GPUShaderProgramsContainer::GPUShaderProgramsContainer()
 GPUShaderProgramsContainer::~GPUShaderProgramsContainer()
 {
     // Remember to delete all programs
+    _aliases.Clear();
     _shaders.ClearDelete();
 }
 
@@ -120,7 +121,19 @@ bool GPUShader::Create(MemoryReadStream& stream)
             // Read bindings
             stream.ReadBytes(&initializer.Bindings, sizeof(ShaderBindings));
 
+            if (cacheSize == 0)
+            {
+                // Permutation stripped from the cooked game as unused (see ShaderUsageRecorder) so fallback to the first one
+                GPUShaderProgram* fallback = _shaders.Get(initializer.Name, 0);
+                if (fallback)
+                    _shaders.AddAlias(fallback, permutationIndex);
+                continue;
+            }
+
             // Create shader program
+#if !BUILD_RELEASE
+            initializer.PermutationIndex = permutationIndex;
+#endif
             if (type == ShaderStage::Compute && !hasCompute)
             {
                 LOG(Warning, "Failed to create {} Shader program '{}' ({}).", ::ToString(type), String(initializer.Name), name);
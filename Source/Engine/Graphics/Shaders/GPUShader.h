@@ -21,6 +21,7 @@ class GPUShaderProgramsContainer
 {
 private:
     Dictionary<int32, GPUShaderProgram*> _shaders;
+    Dictionary<int32, GPUShaderProgram*> _aliases;
 
 public:
     /// <summary>
@@ -41,6 +42,13 @@ class GPUShaderProgramsContainer
     /// <param name="permutationIndex">The shader permutation index.</param>
     void Add(GPUShaderProgram* shader, int32 permutationIndex);
 
+    /// <summary>
+    /// Adds an alias for the existing shader program to be used for the other permutation index (eg. permutation stripped from the cooked shader cache). Aliases are not owned by the collection.
+    /// </summary>
+    /// <param name="shader">The shader to use.</param>
+    /// <param name="permutationIndex">The shader permutation index to alias.</param>
+    void AddAlias(GPUShaderProgram* shader, int32 permutationIndex);
+
     /// <summary>
     /// Gets a shader of given name and permutation index.
     /// </summary>
@@ -41,6 +41,7 @@ struct GPUShaderProgramInitializer
     ShaderFlags Flags;
 #if !BUILD_RELEASE
     GPUShader* Owner;
+    int32 PermutationIndex;
 #endif
 };
 
@@ -55,6 +56,7 @@ class FLAXENGINE_API GPUShaderProgram
     ShaderFlags _flags;
 #if !BUILD_RELEASE
     GPUShader* _owner;
+    int32 _permutationIndex;
 #endif
 
     void Init(const GPUShaderProgramInitializer& initializer)
@@ -64,6 +66,7 @@ class FLAXENGINE_API GPUShaderProgram
         _flags = initializer.Flags;
 #if !BUILD_RELEASE
         _owner = initializer.Owner;
+        _permutationIndex = initializer.PermutationIndex;
 #endif
     }
 
@@ -100,6 +103,24 @@ class FLAXENGINE_API GPUShaderProgram
         return _flags;
     }
 
+#if !BUILD_RELEASE
+    /// <summary>
+    /// Gets the shader that owns this program.
+    /// </summary>
+    FORCE_INLINE GPUShader* GetOwner() const
+    {
+        return _owner;
+    }
+
+    /// <summary>
+    /// Gets the index of the shader function permutation.
+    /// </summary>
+    FORCE_INLINE int32 GetPermutationIndex() const
+    {
+        return _permutationIndex;
+    }
+#endif
+
 public:
     /// <summary>
     /// Gets shader program stage type.
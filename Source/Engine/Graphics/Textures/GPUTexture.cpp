@@ -201,6 +201,7 @@ GPUTexture* GPUTexture::New()
 GPUTexture::GPUTexture()
     : GPUResource(SpawnParams(Guid::New(), TypeInitializer))
     , _residentMipLevels(0)
+    , _committedMipLevels(0)
     , _sRGB(false)
     , _isBlockCompressed(false)
 {
@@ -461,6 +462,19 @@ bool GPUTexture::Init(const GPUTextureDescription& desc)
         break;
     }
     }
+    if (desc.IsSparse())
+    {
+        if (!device->Limits.HasSparseTextures)
+        {
+            LOG(Warning, "Cannot create texture. The current graphics platform does not support sparse textures. Description: {0}", desc.ToString());
+            return true;
+        }
+        if (desc.Dimensions != TextureDimensions::Texture || desc.IsArray() || desc.IsMultiSample() || desc.Usage != GPUResourceUsage::Default || (desc.Flags & ~GPUTextureFlags::Sparse) != GPUTextureFlags::ShaderResource)
+        {
+            LOG(Warning, "Cannot create texture. Sparse texture has to be a regular 2D texture (shader resource only, no array and no multi-sampling). Description: {0}", desc.ToString());
+            return true;
+        }
+    }
     const bool isCompressed = PixelFormatExtensions::IsCompressed(desc.Format);
     if (isCompressed)
     {
@@ -479,11 +493,13 @@ bool GPUTexture::Init(const GPUTextureDescription& desc)
     _desc = desc;
     _sRGB = PixelFormatExtensions::IsSRGB(desc.Format);
     _isBlockCompressed = isCompressed;
+    _committedMipLevels = _desc.MipLevels;
     if (OnInit())
     {
         ReleaseGPU();
         _desc.Clear();
         _residentMipLevels = 0;
+        _committedMipLevels = 0;
         LOG(Warning, "Cannot initialize texture. Description: {0}", desc.ToString());
         return true;
     }
@@ -578,6 +594,7 @@ void GPUTexture::OnReleaseGPU()
 {
     _desc.Clear();
     _residentMipLevels = 0;
+    _committedMipLevels = 0;
 }
 
 GPUTask* GPUTexture::UploadMipMapAsync(const BytesContainer& data, int32 mipIndex, bool copyData)
@@ -798,10 +815,25 @@ Task* GPUTexture::DownloadDataAsync(TextureData& result)
 
 void GPUTexture::SetResidentMipLevels(int32 count)
 {
-    count = Math::Clamp(count, 0, MipLevels());
+    count = Math::Clamp(count, 0, IsSparse() ? _committedMipLevels : MipLevels());
     if (_residentMipLevels == count || !IsRegularTexture())
         return;
     _residentMipLevels = count;
     OnResidentMipsChanged();
     ResidentMipsChanged(this);
 }
+
+bool GPUTexture::SetCommittedMipLevels(int32 count)
+{
+    if (!IsSparse())
+        return true;
+    count = Math::Clamp(count, 0, MipLevels());
+    if (count < _residentMipLevels)
+    {
+        LOG(Warning, "Cannot decommit mips {0} of texture {1} that are resident.", MipLevels() - count - 1, ToString());
+        return true;
+    }
+    if (_committedMipLevels == count)
+        return false;
+    return OnCommitMips(count);
+}
@@ -76,6 +76,7 @@ API_CLASS(Sealed) class FLAXENGINE_API GPUTexture : public GPUResource
 
 protected:
     int32 _residentMipLevels;
+    int32 _committedMipLevels;
     bool _sRGB, _isBlockCompressed;
     GPUTextureDescription _desc;
 
@@ -154,6 +155,22 @@ API_CLASS(Sealed) class FLAXENGINE_API GPUTexture : public GPUResource
         return _residentMipLevels;
     }
 
+    /// <summary>
+    /// Gets the number of mipmap levels in the texture that have GPU memory committed. Sparse textures commit memory on demand (counted from the lowest quality mip), otherwise all mips are committed.
+    /// </summary>
+    API_PROPERTY() FORCE_INLINE int32 CommittedMipLevels() const
+    {
+        return _committedMipLevels;
+    }
+
+    /// <summary>
+    /// Gets a value indicating whether this texture is sparse (partially resident with GPU memory committed per mip map on demand).
+    /// </summary>
+    API_PROPERTY() FORCE_INLINE bool IsSparse() const
+    {
+        return _desc.IsSparse();
+    }
+
     /// <summary>
     /// Gets the index of the highest resident mip map (may be equal to MipLevels if no mip has been uploaded). Note: mip=0 is the highest (top quality).
     /// </summary>
@@ -288,7 +305,7 @@ API_CLASS(Sealed) class FLAXENGINE_API GPUTexture : public GPUResource
     /// </summary>
     FORCE_INLINE bool IsRegularTexture() const
     {
-        return _desc.Flags == GPUTextureFlags::ShaderResource;
+        return (_desc.Flags & ~GPUTextureFlags::Sparse) == GPUTextureFlags::ShaderResource;
     }
 
     /// <summary>
@@ -557,6 +574,13 @@ API_CLASS(Sealed) class FLAXENGINE_API GPUTexture : public GPUResource
     /// </summary>
     API_PROPERTY() void SetResidentMipLevels(int32 count);
 
+    /// <summary>
+    /// Sets the number of mipmap levels (counted from the lowest quality mip) that have GPU memory committed. Valid only for sparse textures. Committed mips count cannot be lower than the resident mips count. The backend may keep more mips committed (eg. packed mip tail that cannot be decommitted).
+    /// </summary>
+    /// <param name="count">The committed mips count.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    API_FUNCTION() bool SetCommittedMipLevels(int32 count);
+
     /// <summary>
     /// Event called when texture residency gets changed. Texture Mip gets loaded into GPU memory and is ready to use.
     /// </summary>
@@ -566,6 +590,10 @@ API_CLASS(Sealed) class FLAXENGINE_API GPUTexture : public GPUResource
     virtual bool OnInit() = 0;
     uint64 calculateMemoryUsage() const;
     virtual void OnResidentMipsChanged() = 0;
+    virtual bool OnCommitMips(int32 count)
+    {
+        return true;
+    }
 
 public:
     // [GPUResource]
@@ -55,6 +55,11 @@ API_ENUM(Attributes="Flags") enum class GPUTextureFlags
     /// Create a texture that can be used as a native window swap chain backbuffer surface.
     /// </summary>
     BackBuffer = 0x0080,
+
+    /// <summary>
+    /// Create a sparse (partially resident) texture that has no GPU memory committed upfront. Memory is committed for mip maps on demand (see GPUTexture::SetCommittedMipLevels). Valid only for regular Texture2D (no array, no multi-sampling) and if the graphics device supports it (see GPULimits::HasSparseTextures).
+    /// </summary>
+    Sparse = 0x0100,
 };
 
 DECLARE_ENUM_OPERATORS(GPUTextureFlags);
@@ -191,6 +196,14 @@ API_STRUCT() struct FLAXENGINE_API GPUTextureDescription
         return (Flags & GPUTextureFlags::PerSliceViews) != GPUTextureFlags::None;
     }
 
+    /// <summary>
+    /// Gets a value indicating whether this instance is a sparse (partially resident) texture.
+    /// </summary>
+    FORCE_INLINE bool IsSparse() const
+    {
+        return (Flags & GPUTextureFlags::Sparse) != GPUTextureFlags::None;
+    }
+
     /// <summary>
     /// Gets a value indicating whether this instance is a multi sample texture.
     /// </summary>
@@ -3,6 +3,7 @@
 #include "StreamingTexture.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Streaming/Streaming.h"
 #include "Engine/Streaming/StreamingGroup.h"
 #include "Engine/Content/Loading/ContentLoadingManager.h"
 #include "Engine/Graphics/PixelFormatExtensions.h"
@@ -43,11 +44,89 @@ TextureHeader::TextureHeader(const TextureHeader_Deprecated& old)
 static_assert(sizeof(TextureHeader_Deprecated) == 10 * sizeof(int32), "Invalid TextureHeader size.");
 static_assert(sizeof(TextureHeader) == 36, "Invalid TextureHeader size.");
 
+namespace
+{
+    CriticalSection FeedbackSlotsLocker;
+    StreamingTexture* FeedbackSlots[STREAMING_TEXTURE_FEEDBACK_SLOTS] = {};
+    Array<int32> FeedbackFreeSlots;
+    int32 FeedbackSlotsCount = 0;
+
+    struct PooledTexture
+    {
+        GPUTexture* Texture;
+        uint32 DescriptionHash;
+        double ReleaseTime;
+    };
+
+    // Textures released by the streaming reallocations that can be reused by other streaming textures with the same description (sorted by release time)
+    CriticalSection PoolLocker;
+    Array<PooledTexture> Pool;
+    uint64 PoolMemory = 0;
+
+    GPUTexture* GetPooledTexture(const GPUTextureDescription& desc)
+    {
+        const uint32 descHash = GetHash(desc);
+        ScopeLock lock(PoolLocker);
+        for (int32 i = Pool.Count() - 1; i >= 0; i--)
+        {
+            const PooledTexture& e = Pool[i];
+            if (e.DescriptionHash == descHash && e.Texture->GetDescription() == desc)
+            {
+                GPUTexture* texture = e.Texture;
+                PoolMemory -= texture->GetMemoryUsage();
+                Pool.RemoveAtKeepOrder(i);
+                return texture;
+            }
+        }
+        return nullptr;
+    }
+
+    void ReleasePooledTexture(GPUTexture* texture)
+    {
+        const uint64 poolSize = (uint64)Math::Max(Streaming::TexturePoolSizeMB, 0) * 1024 * 1024;
+        const uint64 memoryUsage = texture->GetMemoryUsage();
+        if (!texture->IsAllocated() || texture->IsSparse() || memoryUsage > poolSize)
+        {
+            SAFE_DELETE_GPU_RESOURCE(texture);
+            return;
+        }
+        ScopeLock lock(PoolLocker);
+        while (Pool.HasItems() && PoolMemory + memoryUsage > poolSize)
+        {
+            // Free the oldest textures to fit into the pool size
+            GPUTexture* oldTexture = Pool[0].Texture;
+            PoolMemory -= oldTexture->GetMemoryUsage();
+            Pool.RemoveAtKeepOrder(0);
+            SAFE_DELETE_GPU_RESOURCE(oldTexture);
+        }
+        Pool.Add({ texture, GetHash(texture->GetDescription()), Platform::GetTimeSeconds() });
+        PoolMemory += memoryUsage;
+    }
+}
+
+void StreamingTexture::FlushPool(bool force)
+{
+    const double maxReleaseTime = Platform::GetTimeSeconds() - 10.0;
+    ScopeLock lock(PoolLocker);
+    while (Pool.HasItems() && (force || Pool[0].ReleaseTime < maxReleaseTime))
+    {
+        GPUTexture* texture = Pool[0].Texture;
+        PoolMemory -= texture->GetMemoryUsage();
+        Pool.RemoveAtKeepOrder(0);
+        SAFE_DELETE_GPU_RESOURCE(texture);
+    }
+}
+
 StreamingTexture::StreamingTexture(ITextureOwner* parent, const String& name)
     : StreamableResource(StreamingGroups::Instance()->Textures())
     , _owner(parent)
     , _texture(nullptr)
     , _isBlockCompressed(false)
+    , _feedbackSlot(-1)
+    , _feedbackMip(-1)
+    , _feedbackTime(-1)
+    , _requestedMip(-1)
+    , _requestedMipTime(-1)
 {
     ASSERT(parent != nullptr);
 
@@ -62,6 +141,12 @@ StreamingTexture::StreamingTexture(ITextureOwner* parent, const String& name)
 StreamingTexture::~StreamingTexture()
 {
     UnloadTexture();
+    if (_feedbackSlot != -1)
+    {
+        ScopeLock lock(FeedbackSlotsLocker);
+        FeedbackSlots[_feedbackSlot] = nullptr;
+        FeedbackFreeSlots.Add(_feedbackSlot);
+    }
     SAFE_DELETE(_texture);
 }
 
@@ -137,6 +222,10 @@ void StreamingTexture::UnloadTexture()
     CancelStreamingTasks();
     _texture->ReleaseGPU();
     _header.MipLevels = 0;
+    _feedbackMip = -1;
+    _feedbackTime = -1;
+    _requestedMip = -1;
+    _requestedMipTime = -1;
     ASSERT(_streamingTasks.Count() == 0);
 }
 
@@ -146,6 +235,41 @@ uint64 StreamingTexture::GetTotalMemoryUsage() const
     return RenderTools::CalculateTextureMemoryUsage(_header.Format, _header.Width, _header.Height, _header.MipLevels) * arraySize;
 }
 
+uint32 StreamingTexture::GetFeedbackData() const
+{
+    const int32 allocatedMips = _texture->MipLevels();
+    if (allocatedMips == 0 || !IsDynamic())
+        return MAX_uint32;
+    if (_feedbackSlot == -1)
+    {
+        ScopeLock lock(FeedbackSlotsLocker);
+        if (FeedbackFreeSlots.HasItems())
+            _feedbackSlot = FeedbackFreeSlots.Pop();
+        else if (FeedbackSlotsCount < STREAMING_TEXTURE_FEEDBACK_SLOTS)
+            _feedbackSlot = FeedbackSlotsCount++;
+        else
+            return MAX_uint32;
+        FeedbackSlots[_feedbackSlot] = const_cast<StreamingTexture*>(this);
+    }
+    return (uint32)_feedbackSlot | ((uint32)(TotalMipLevels() - allocatedMips) << 24);
+}
+
+void StreamingTexture::ApplyFeedback(const uint32* data, int32 count, double time)
+{
+    ScopeLock lock(FeedbackSlotsLocker);
+    count = Math::Min(count, FeedbackSlotsCount);
+    for (int32 i = 0; i < count; i++)
+    {
+        StreamingTexture* texture = FeedbackSlots[i];
+        const uint32 mip = data[i];
+        if (texture && mip != MAX_uint32)
+        {
+            texture->_feedbackMip = Math::Min((int32)mip, texture->TotalMipLevels() - 1);
+            texture->_feedbackTime = time;
+        }
+    }
+}
+
 String StreamingTexture::ToString() const
 {
     return _texture->ToString();
@@ -163,7 +287,8 @@ int32 StreamingTexture::GetCurrentResidency() const
 
 int32 StreamingTexture::GetAllocatedResidency() const
 {
-    return _texture->MipLevels();
+    // Sparse textures have the full mip chain allocated but only some mips backed by the memory
+    return _texture->IsSparse() ? _texture->CommittedMipLevels() : _texture->MipLevels();
 }
 
 bool StreamingTexture::CanBeUpdated() const
@@ -198,7 +323,8 @@ class StreamTextureResizeTask : public GPUTask
 
     ~StreamTextureResizeTask()
     {
-        SAFE_DELETE_GPU_RESOURCE(_newTexture);
+        if (_newTexture)
+            ReleasePooledTexture(_newTexture);
     }
 
 protected:
@@ -241,7 +367,57 @@ class StreamTextureResizeTask : public GPUTask
         Swap(_streamingTexture->_texture, _newTexture);
         _streamingTexture->GetTexture()->SetResidentMipLevels(_uploadedMipCount);
         _streamingTexture->ResidencyChanged();
-        SAFE_DELETE_GPU_RESOURCE(_newTexture);
+        ReleasePooledTexture(_newTexture);
+        _newTexture = nullptr;
+
+        // Base
+        GPUTask::OnSync();
+    }
+};
+
+class StreamTextureDecommitTask : public GPUTask
+{
+private:
+    StreamingTexture* _streamingTexture;
+    int32 _residency;
+
+public:
+    StreamTextureDecommitTask(StreamingTexture* texture, int32 residency)
+        : GPUTask(Type::Custom)
+        , _streamingTexture(texture)
+        , _residency(residency)
+    {
+        _streamingTexture->_streamingTasks.Add(this);
+    }
+
+protected:
+    // [GPUTask]
+    Result run(GPUTasksContext* context) override
+    {
+        if (_streamingTexture == nullptr)
+            return Result::MissingResources;
+
+        // Stop using the mips before decommitting them (memory gets unmapped once GPU is done with the previous frames)
+        _streamingTexture->GetTexture()->SetResidentMipLevels(Math::Min(_streamingTexture->GetTexture()->ResidentMipLevels(), _residency));
+        return Result::Ok;
+    }
+
+    void OnEnd() override
+    {
+        if (_streamingTexture)
+        {
+            ScopeLock lock(_streamingTexture->GetOwner()->GetOwnerLocker());
+            _streamingTexture->_streamingTasks.Remove(this);
+        }
+
+        // Base
+        GPUTask::OnEnd();
+    }
+
+    void OnSync() override
+    {
+        _streamingTexture->GetTexture()->SetCommittedMipLevels(_residency);
+        _streamingTexture->ResidencyChanged();
 
         // Base
         GPUTask::OnSync();
@@ -266,18 +442,27 @@ Task* StreamingTexture::UpdateAllocation(int32 residency)
         // Release texture memory
         _texture->ReleaseGPU();
     }
-    else
+    else if (_texture->IsSparse())
     {
-        // Use new texture object for resizing task
-        GPUTexture* texture = _texture;
-        if (allocatedResidency != 0)
+        if (residency > allocatedResidency || _texture->ResidentMipLevels() <= residency)
         {
-#if GPU_ENABLE_RESOURCE_NAMING
-            texture = GPUDevice::Instance->CreateTexture(_texture->GetName());
-#else
-            texture = GPUDevice::Instance->CreateTexture();
-#endif
+            // Commit mips memory (or decommit the mips that are not in use)
+            _texture->SetCommittedMipLevels(residency);
+        }
+        else
+        {
+            // Lower the resident mips first and decommit memory after GPU stops using them
+            result = New<StreamTextureDecommitTask>(this, residency);
         }
+    }
+    else
+    {
+        // Large textures can use sparse allocation with the full mip chain (only committed mips are backed by the memory)
+        const bool useSparse = allocatedResidency == 0 &&
+                Streaming::SparseTextures &&
+                GPUDevice::Instance->Limits.HasSparseTextures &&
+                !IsCubeMap() &&
+                Math::Max(TotalWidth(), TotalHeight()) >= STREAMING_TEXTURE_SPARSE_MIN_SIZE;
 
         // Create texture description
         const int32 mip = TotalMipLevels() - residency;
@@ -289,13 +474,49 @@ Task* StreamingTexture::UpdateAllocation(int32 residency)
             ASSERT(width == height);
             desc = GPUTextureDescription::NewCube(width, residency, _header.Format, GPUTextureFlags::ShaderResource);
         }
+        else if (useSparse)
+        {
+            desc = GPUTextureDescription::New2D(TotalWidth(), TotalHeight(), TotalMipLevels(), _header.Format, GPUTextureFlags::ShaderResource | GPUTextureFlags::Sparse);
+        }
         else
         {
             desc = GPUTextureDescription::New2D(width, height, residency, _header.Format, GPUTextureFlags::ShaderResource);
         }
 
-        // Setup texture
-        if (texture->Init(desc))
+        // Use new texture object for resizing task (reuse the one released by other streaming texture if it matches to skip allocation)
+        GPUTexture* texture = _texture;
+        bool failed = true;
+        if (allocatedResidency != 0)
+        {
+            texture = GetPooledTexture(desc);
+            if (texture)
+            {
+                failed = false;
+#if GPU_ENABLE_RESOURCE_NAMING
+                texture->SetName(_texture->GetName());
+#endif
+            }
+            else
+            {
+#if GPU_ENABLE_RESOURCE_NAMING
+                texture = GPUDevice::Instance->CreateTexture(_texture->GetName());
+#else
+                texture = GPUDevice::Instance->CreateTexture();
+#endif
+            }
+        }
+
+        // Setup texture (fallback to the regular texture if sparse one cannot be created, eg. texture format is not supported)
+        if (useSparse)
+        {
+            failed = texture->Init(desc) || texture->SetCommittedMipLevels(residency);
+            if (failed)
+            {
+                texture->ReleaseGPU();
+                desc = GPUTextureDescription::New2D(width, height, residency, _header.Format, GPUTextureFlags::ShaderResource);
+            }
+        }
+        if (failed && texture->Init(desc))
         {
             Streaming.Error = true;
 #if GPU_ENABLE_RESOURCE_NAMING
@@ -479,3 +700,17 @@ void StreamingTexture::CancelStreamingTasks()
     for (auto task : tasks)
         task->Cancel();
 }
+
+uint64 StreamingTexture::GetResidencySize(int32 residency) const
+{
+    residency = Math::Min(residency, _header.MipLevels);
+    if (residency <= 0)
+        return 0;
+
+    // Calculate size of the resident mip chain (the smallest mips)
+    const uint64 arraySize = _header.IsCubeMap ? 6 : 1;
+    const int32 mipIndex = _header.MipLevels - residency;
+    const int32 width = Math::Max(_header.Width >> mipIndex, 1);
+    const int32 height = Math::Max(_header.Height >> mipIndex, 1);
+    return RenderTools::CalculateTextureMemoryUsage(_header.Format, width, height, residency) * arraySize;
+}
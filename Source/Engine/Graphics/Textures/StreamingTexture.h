@@ -6,6 +6,21 @@
 #include "Engine/Streaming/StreamableResource.h"
 #include "Types.h"
 
+/// <summary>
+/// The maximum amount of streaming textures that can be tracked by the GPU texture feedback pass at once.
+/// </summary>
+#define STREAMING_TEXTURE_FEEDBACK_SLOTS 4096
+
+/// <summary>
+/// The minimum size (in texels) of the streaming texture to use sparse allocation (if enabled). Smaller textures are cheap to reallocate.
+/// </summary>
+#define STREAMING_TEXTURE_SPARSE_MIN_SIZE 1024
+
+/// <summary>
+/// The time (in seconds) after which the mip requested on a CPU (see StreamingTexture::RequestMip) expires and texture gets streamed-out to the lowest mip (used when texture has no group assigned).
+/// </summary>
+#define STREAMING_TEXTURE_REQUEST_TIME_TO_INVISIBLE 10.0f
+
 /// <summary>
 /// GPU texture object which can change it's resolution (quality) at runtime.
 /// </summary>
@@ -15,6 +30,7 @@ class FLAXENGINE_API StreamingTexture : public Object, public StreamableResource
     friend class TexturesStreamingHandler;
     friend class StreamTextureMipTask;
     friend class StreamTextureResizeTask;
+    friend class StreamTextureDecommitTask;
 protected:
     ITextureOwner* _owner;
     GPUTexture* _texture;
@@ -22,6 +38,11 @@ class FLAXENGINE_API StreamingTexture : public Object, public StreamableResource
     int32 _minMipCountBlockCompressed;
     bool _isBlockCompressed;
     Array<Task*, FixedAllocation<16>> _streamingTasks;
+    mutable int32 _feedbackSlot;
+    int32 _feedbackMip;
+    double _feedbackTime;
+    mutable int32 _requestedMip;
+    mutable double _requestedMipTime;
 
 public:
     StreamingTexture(ITextureOwner* owner, const String& name);
@@ -156,6 +177,77 @@ class FLAXENGINE_API StreamingTexture : public Object, public StreamableResource
     /// <returns>The amount of bytes.</returns>
     uint64 GetTotalMemoryUsage() const;
 
+public:
+    /// <summary>
+    /// Gets the texture data for the GPU texture feedback pass: feedback slot index (low 24 bits) and the amount of not allocated mips (high 8 bits). Allocates the feedback slot on the first use.
+    /// </summary>
+    /// <returns>The packed feedback data or MAX_uint32 if texture cannot use feedback (eg. not streamed, not allocated or run out of feedback slots).</returns>
+    uint32 GetFeedbackData() const;
+
+    /// <summary>
+    /// Gets the most detailed mip map index requested by the materials during the last texture feedback pass that rendered this texture (absolute index).
+    /// </summary>
+    FORCE_INLINE int32 GetFeedbackMip() const
+    {
+        return _feedbackMip;
+    }
+
+    /// <summary>
+    /// Gets the time of the last texture feedback pass that rendered this texture. Value is -1 if texture was never seen by the feedback pass.
+    /// </summary>
+    FORCE_INLINE double GetFeedbackTime() const
+    {
+        return _feedbackTime;
+    }
+
+    /// <summary>
+    /// Gets the most detailed mip map index requested on a CPU by the texture user during the last frame it was requested (absolute index).
+    /// </summary>
+    FORCE_INLINE int32 GetRequestedMip() const
+    {
+        return _requestedMip;
+    }
+
+    /// <summary>
+    /// Gets the last time when the mip was requested on a CPU. Value is -1 if texture was never requested that way (streaming uses texture group and visibility then).
+    /// </summary>
+    FORCE_INLINE double GetRequestedMipTime() const
+    {
+        return _requestedMipTime;
+    }
+
+    /// <summary>
+    /// Requests the most detailed mip map to be streamed-in (eg. terrain heightmap based on the chunks LOD). Overrides the texture group quality. Texture gets streamed-out to the lowest mip if not requested for some time.
+    /// </summary>
+    /// <param name="mip">The mip map index (absolute index).</param>
+    /// <param name="time">The current frame time (platform time in seconds).</param>
+    FORCE_INLINE void RequestMip(int32 mip, double time) const
+    {
+        if (_requestedMipTime != time)
+        {
+            _requestedMipTime = time;
+            _requestedMip = mip;
+        }
+        else if (mip < _requestedMip)
+        {
+            _requestedMip = mip;
+        }
+    }
+
+    /// <summary>
+    /// Applies the results of the GPU texture feedback pass to the streaming textures.
+    /// </summary>
+    /// <param name="data">The requested mip level for each feedback slot (MAX_uint32 if slot was not sampled).</param>
+    /// <param name="count">The amount of slots.</param>
+    /// <param name="time">The time of the feedback pass rendering.</param>
+    static void ApplyFeedback(const uint32* data, int32 count, double time);
+
+    /// <summary>
+    /// Releases the textures kept in the reallocation pool (see Streaming::TexturePoolSizeMB).
+    /// </summary>
+    /// <param name="force">True if release all pooled textures, otherwise only the ones that were not reused for a longer time.</param>
+    static void FlushPool(bool force = false);
+
 public:
     FORCE_INLINE GPUTexture* operator->() const
     {
@@ -174,4 +266,5 @@ class FLAXENGINE_API StreamingTexture : public Object, public StreamableResource
     Task* UpdateAllocation(int32 residency) override;
     Task* CreateStreamingTask(int32 residency) override;
     void CancelStreamingTasks() override;
+    uint64 GetResidencySize(int32 residency) const override;
 };
@@ -11,6 +11,7 @@
 #include "Engine/Debug/Exceptions/InvalidOperationException.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Content/Factories/BinaryAssetFactory.h"
+#include "Engine/Content/Loading/ContentLoadTask.h"
 #include "Engine/Scripting/Enums.h"
 #include "Engine/Tools/TextureTool/TextureTool.h"
 #include "Engine/Threading/Threading.h"
@@ -696,7 +697,10 @@ Task* TextureBase::RequestMipDataAsync(int32 mipIndex)
         return nullptr;
 
     auto chunkIndex = CalculateChunkIndex(mipIndex);
-    return (Task*)_parent->RequestChunkDataAsync(chunkIndex);
+    ContentLoadTask* task = _parent->RequestChunkDataAsync(chunkIndex);
+    if (task)
+        task->SetPriority(ContentLoadTask::GetStreamingPriority(_texture.GetStreamingPriority()));
+    return (Task*)task;
 }
 
 FlaxStorage::LockData TextureBase::LockData()
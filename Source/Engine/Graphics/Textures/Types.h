@@ -27,6 +27,19 @@ API_ENUM() enum class TextureFormatType : byte
     HdrRGB,
 };
 
+/// <summary>
+/// The texture compression quality (trade-off between the compression time and the quality of the compressed blocks).
+/// </summary>
+API_ENUM() enum class TextureCompressionQuality : byte
+{
+    // The fastest compression with lower quality (eg. for quick iteration builds).
+    Fast,
+    // The balanced compression speed and quality.
+    Normal,
+    // The best quality with the slowest compression (eg. for distribution builds).
+    High,
+};
+
 /// <summary>
 /// Old texture header structure (was not fully initialized to zero).
 /// </summary>
@@ -345,6 +345,7 @@ void GPUContextDX11::BindCB(int32 slot, GPUConstantBuffer* cb)
         buffer = cbDX11->GetBuffer();
     }
 
+    RENDER_STAT_STATE_BIND(_cbHandles[slot] == buffer);
     if (_cbHandles[slot] != buffer)
     {
         _cbDirtyFlag = true;
@@ -356,6 +357,7 @@ void GPUContextDX11::BindSR(int32 slot, GPUResourceView* view)
 {
     ASSERT(slot >= 0 && slot < GPU_MAX_SR_BINDED);
     auto handle = view ? ((IShaderResourceDX11*)view->GetNativePtr())->SRV() : nullptr;
+    RENDER_STAT_STATE_BIND(_srHandles[slot] == handle);
     if (_srHandles[slot] != handle)
     {
         _srMaskDirtyGraphics |= 1 << slot;
@@ -370,6 +372,7 @@ void GPUContextDX11::BindUA(int32 slot, GPUResourceView* view)
 {
     ASSERT(slot >= 0 && slot < GPU_MAX_UA_BINDED);
     auto handle = view ? ((IShaderResourceDX11*)view->GetNativePtr())->UAV() : nullptr;
+    RENDER_STAT_STATE_BIND(_uaHandles[slot] == handle);
     if (_uaHandles[slot] != handle)
     {
         _uaDirtyFlag = true;
@@ -397,6 +400,7 @@ void GPUContextDX11::BindVB(const Span<GPUBuffer*>& vertexBuffers, const uint32*
         vbEdited |= offset != _vbOffsets[i];
         _vbOffsets[i] = offset;
     }
+    RENDER_STAT_STATE_BIND(!vbEdited);
     if (vbEdited)
     {
         _context->IASetVertexBuffers(0, vertexBuffers.Length(), _vbHandles, _vbStrides, _vbOffsets);
@@ -406,6 +410,7 @@ void GPUContextDX11::BindVB(const Span<GPUBuffer*>& vertexBuffers, const uint32*
 void GPUContextDX11::BindIB(GPUBuffer* indexBuffer)
 {
     const auto ibDX11 = static_cast<GPUBufferDX11*>(indexBuffer);
+    RENDER_STAT_STATE_BIND(ibDX11 == _ibHandle);
     if (ibDX11 != _ibHandle)
     {
         _ibHandle = ibDX11;
@@ -416,6 +421,7 @@ void GPUContextDX11::BindIB(GPUBuffer* indexBuffer)
 void GPUContextDX11::BindSampler(int32 slot, GPUSampler* sampler)
 {
     const auto samplerDX11 = sampler ? static_cast<GPUSamplerDX11*>(sampler)->SamplerState : nullptr;
+    RENDER_STAT_STATE_BIND(false);
     _context->VSSetSamplers(slot, 1, &samplerDX11);
 #if GPU_ALLOW_TESSELLATION_SHADERS
     _context->DSSetSamplers(slot, 1, &samplerDX11);
@@ -550,6 +556,7 @@ GPUPipelineState* GPUContextDX11::GetState() const
 
 void GPUContextDX11::SetState(GPUPipelineState* state)
 {
+    RENDER_STAT_STATE_BIND(_currentState == state);
     if (_currentState != state)
     {
         _currentState = static_cast<GPUPipelineStateDX11*>(state);
@@ -306,6 +306,7 @@ bool GPUDeviceDX11::Init()
         return true;
     }
     UpdateOutputs(adapter);
+    InitMemoryBudget(adapter);
 
     ComPtr<IDXGIFactory5> factory5;
     _factoryDXGI->QueryInterface(IID_PPV_ARGS(&factory5));
@@ -363,6 +364,10 @@ bool GPUDeviceDX11::Init()
             limits.HasReadOnlyDepth = true;
             limits.HasMultisampleDepthAsSRV = true;
             limits.HasTypedUAVLoad = featureDataD3D11Options2.TypedUAVLoadAdditionalFormats != 0;
+            limits.HasSparseTextures = false;
+            limits.HasVariableRateShading = false;
+            limits.VariableRateShadingTileSize = 0;
+            limits.HasBindlessResources = false;
             limits.MaximumMipLevelsCount = D3D11_REQ_MIP_LEVELS;
             limits.MaximumTexture1DSize = D3D11_REQ_TEXTURE1D_U_DIMENSION;
             limits.MaximumTexture1DArraySize = D3D11_REQ_TEXTURE1D_ARRAY_AXIS_DIMENSION;
@@ -387,6 +392,10 @@ bool GPUDeviceDX11::Init()
             limits.HasReadOnlyDepth = createdFeatureLevel == D3D_FEATURE_LEVEL_10_1;
             limits.HasMultisampleDepthAsSRV = false;
             limits.HasTypedUAVLoad = false;
+            limits.HasSparseTextures = false;
+            limits.HasVariableRateShading = false;
+            limits.VariableRateShadingTileSize = 0;
+            limits.HasBindlessResources = false;
             limits.MaximumMipLevelsCount = D3D10_REQ_MIP_LEVELS;
             limits.MaximumTexture1DSize = D3D10_REQ_TEXTURE1D_U_DIMENSION;
             limits.MaximumTexture1DArraySize = D3D10_REQ_TEXTURE1D_ARRAY_AXIS_DIMENSION;
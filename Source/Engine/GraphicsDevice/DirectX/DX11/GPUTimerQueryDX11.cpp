@@ -43,6 +43,8 @@ GPUTimerQueryDX11::~GPUTimerQueryDX11()
         _endQuery->Release();
     if (_disjointQuery)
         _disjointQuery->Release();
+    if (_statsQuery)
+        _statsQuery->Release();
 }
 
 void GPUTimerQueryDX11::OnReleaseGPU()
@@ -50,6 +52,8 @@ void GPUTimerQueryDX11::OnReleaseGPU()
     SAFE_RELEASE(_beginQuery);
     SAFE_RELEASE(_endQuery);
     SAFE_RELEASE(_disjointQuery);
+    SAFE_RELEASE(_statsQuery);
+    _statsActive = false;
 }
 
 ID3D11Resource* GPUTimerQueryDX11::GetResource()
@@ -63,6 +67,24 @@ void GPUTimerQueryDX11::Begin()
     context->Begin(_disjointQuery);
     context->End(_beginQuery);
 
+    // Create pipeline statistics query on demand
+    _statsActive = false;
+    if (CollectPipelineStatistics)
+    {
+        if (!_statsQuery)
+        {
+            D3D11_QUERY_DESC queryDesc;
+            queryDesc.Query = D3D11_QUERY_PIPELINE_STATISTICS;
+            queryDesc.MiscFlags = 0;
+            _device->GetDevice()->CreateQuery(&queryDesc, &_statsQuery);
+        }
+        if (_statsQuery)
+        {
+            context->Begin(_statsQuery);
+            _statsActive = true;
+        }
+    }
+
     _endCalled = false;
 }
 
@@ -72,6 +94,8 @@ void GPUTimerQueryDX11::End()
         return;
 
     auto context = _device->GetIM();
+    if (_statsActive)
+        context->End(_statsQuery);
     context->End(_endQuery);
     context->End(_disjointQuery);
 
@@ -85,7 +109,9 @@ bool GPUTimerQueryDX11::HasResult()
         return false;
 
     D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjointData;
-    return _device->GetIM()->GetData(_disjointQuery, &disjointData, sizeof(disjointData), 0) == S_OK;
+    if (_device->GetIM()->GetData(_disjointQuery, &disjointData, sizeof(disjointData), 0) != S_OK)
+        return false;
+    return !_statsActive || _device->GetIM()->GetData(_statsQuery, nullptr, 0, 0) == S_OK;
 }
 
 float GPUTimerQueryDX11::GetResult()
@@ -128,4 +154,18 @@ float GPUTimerQueryDX11::GetResult()
     return _timeDelta;
 }
 
+bool GPUTimerQueryDX11::GetPipelineStatistics(GPUPipelineStatistics& result)
+{
+    D3D11_QUERY_DATA_PIPELINE_STATISTICS data;
+    if (!_statsActive || !_endCalled || _device->GetIM()->GetData(_statsQuery, &data, sizeof(data), 0) != S_OK)
+        return false;
+    result.InputVertices = data.IAVertices;
+    result.InputPrimitives = data.IAPrimitives;
+    result.VertexShaderInvocations = data.VSInvocations;
+    result.RasterizedPrimitives = data.CPrimitives;
+    result.PixelShaderInvocations = data.PSInvocations;
+    result.ComputeShaderInvocations = data.CSInvocations;
+    return true;
+}
+
 #endif
@@ -16,11 +16,13 @@ class GPUTimerQueryDX11 : public GPUResourceDX11<GPUTimerQuery>
 
     bool _finalized = false;
     bool _endCalled = false;
+    bool _statsActive = false;
     float _timeDelta = 0.0f;
 
     ID3D11Query* _beginQuery = nullptr;
     ID3D11Query* _endQuery = nullptr;
     ID3D11Query* _disjointQuery = nullptr;
+    ID3D11Query* _statsQuery = nullptr;
 
 public:
 
@@ -45,6 +47,7 @@ class GPUTimerQueryDX11 : public GPUResourceDX11<GPUTimerQuery>
     void End() override;
     bool HasResult() override;
     float GetResult() override;
+    bool GetPipelineStatistics(GPUPipelineStatistics& result) override;
 
 protected:
 
@@ -158,6 +158,11 @@ class CommandQueueDX12
         return SyncPointDX12(&_fence, _fence.GetCurrentValue());
     }
 
+    FORCE_INLINE FenceDX12& GetFence()
+    {
+        return _fence;
+    }
+
 public:
 
     /// <summary>
@@ -178,11 +178,12 @@ void DescriptorHeapWithSlotsDX12::OnReleaseGPU()
     _descriptorsCount = 0;
 }
 
-DescriptorHeapRingBufferDX12::DescriptorHeapRingBufferDX12(GPUDeviceDX12* device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32 descriptorsCount, bool shaderVisible)
+DescriptorHeapRingBufferDX12::DescriptorHeapRingBufferDX12(GPUDeviceDX12* device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32 descriptorsCount, bool shaderVisible, uint32 reservedCount)
     : _device(device)
     , _heap(nullptr)
     , _type(type)
     , _descriptorsCount(descriptorsCount)
+    , _reservedCount(reservedCount)
     , _shaderVisible(shaderVisible)
 {
 }
@@ -199,7 +200,7 @@ bool DescriptorHeapRingBufferDX12::Init()
     LOG_DIRECTX_RESULT_WITH_RETURN(result, true);
 
     // Setup
-    _firstFree = 0;
+    _firstFree = _reservedCount;
     _beginCPU = _heap->GetCPUDescriptorHandleForHeapStart();
     if (_shaderVisible)
         _beginGPU = _heap->GetGPUDescriptorHandleForHeapStart();
@@ -222,9 +223,9 @@ DescriptorHeapRingBufferDX12::Allocation DescriptorHeapRingBufferDX12::AllocateT
     // Check for overflow
     if (_firstFree >= _descriptorsCount)
     {
-        // Move to the begin
-        index = 0;
-        _firstFree = numDesc;
+        // Move to the begin (after the reserved descriptors)
+        index = _reservedCount;
+        _firstFree = _reservedCount + numDesc;
     }
 
     // Set pointers
@@ -234,10 +235,19 @@ DescriptorHeapRingBufferDX12::Allocation DescriptorHeapRingBufferDX12::AllocateT
     return result;
 }
 
+DescriptorHeapRingBufferDX12::Allocation DescriptorHeapRingBufferDX12::GetReserved(uint32 index) const
+{
+    ASSERT_LOW_LAYER(index < _reservedCount);
+    Allocation result;
+    result.CPU.ptr = _beginCPU.ptr + static_cast<SIZE_T>(index * _incrementSize);
+    result.GPU.ptr = _shaderVisible ? _beginGPU.ptr + index * _incrementSize : 0;
+    return result;
+}
+
 void DescriptorHeapRingBufferDX12::OnReleaseGPU()
 {
     DX_SAFE_RELEASE_CHECK(_heap, 0);
-    _firstFree = 0;
+    _firstFree = _reservedCount;
 }
 
 #endif
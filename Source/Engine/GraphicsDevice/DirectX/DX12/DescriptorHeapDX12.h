@@ -150,12 +150,13 @@ class DescriptorHeapRingBufferDX12 : public GPUResource
     D3D12_DESCRIPTOR_HEAP_TYPE _type;
     uint32 _incrementSize;
     uint32 _descriptorsCount;
+    uint32 _reservedCount;
     uint32 _firstFree;
     bool _shaderVisible;
 
 public:
 
-    DescriptorHeapRingBufferDX12(GPUDeviceDX12* device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32 descriptorsCount, bool shaderVisible);
+    DescriptorHeapRingBufferDX12(GPUDeviceDX12* device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32 descriptorsCount, bool shaderVisible, uint32 reservedCount = 0);
 
 public:
 
@@ -167,6 +168,9 @@ class DescriptorHeapRingBufferDX12 : public GPUResource
     bool Init();
     Allocation AllocateTable(uint32 numDesc);
 
+    // Gets the persistent descriptor from the reserved range at the heap start (not used by the ring buffer allocations).
+    Allocation GetReserved(uint32 index) const;
+
 public:
 
     // [GPUResourceDX12]
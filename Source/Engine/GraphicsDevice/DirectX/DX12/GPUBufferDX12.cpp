@@ -12,6 +12,8 @@
 void GPUBufferViewDX12::SetSRV(D3D12_SHADER_RESOURCE_VIEW_DESC& srvDesc)
 {
     _srv.CreateSRV(_device, _owner->GetResource(), &srvDesc);
+    _device->FreeBindless(_bindless);
+    _bindless = _device->AllocateBindless(_srv.CPU());
 }
 
 void GPUBufferViewDX12::SetUAV(D3D12_UNORDERED_ACCESS_VIEW_DESC& uavDesc, ID3D12Resource* counterResource)
@@ -134,9 +136,23 @@ bool GPUBufferDX12::OnInit()
     heapProperties.VisibleNodeMask = 1;
 
     // Create resource
-    ID3D12Resource* resource;
+    ID3D12Resource* resource = nullptr;
     D3D12_RESOURCE_STATES initialState = D3D12_RESOURCE_STATE_COMMON;
-    VALIDATE_DIRECTX_CALL(_device->GetDevice()->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, initialState, nullptr, IID_PPV_ARGS(&resource)));
+    if (heapProperties.Type == D3D12_HEAP_TYPE_DEFAULT && !_device->BuffersAllocator->Allocate(_desc.Size, _allocation))
+    {
+        // Place small buffers within the pooled heaps
+        const HRESULT result = _device->GetDevice()->CreatePlacedResource(_allocation.Owner->Heap, _allocation.Offset, &resourceDesc, initialState, nullptr, IID_PPV_ARGS(&resource));
+        if (FAILED(result))
+        {
+            LOG_DIRECTX_RESULT(result);
+            _device->BuffersAllocator->Free(_allocation, 0);
+            resource = nullptr;
+        }
+    }
+    if (resource == nullptr)
+    {
+        VALIDATE_DIRECTX_CALL(_device->GetDevice()->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, initialState, nullptr, IID_PPV_ARGS(&resource)));
+    }
 
     // Set state
     initResource(resource, initialState, 1);
@@ -241,6 +257,7 @@ void GPUBufferDX12::OnReleaseGPU()
 {
     _view.Release();
     releaseResource();
+    _device->BuffersAllocator->Free(_allocation, DX12_RESOURCE_DELETE_SAFE_FRAMES_COUNT);
     SAFE_DELETE_GPU_RESOURCE(_counter);
 
     // Base
@@ -5,6 +5,7 @@
 #include "Engine/Graphics/GPUBuffer.h"
 #include "GPUDeviceDX12.h"
 #include "IShaderResourceDX12.h"
+#include "HeapAllocatorDX12.h"
 #include "../IncludeDirectXHeaders.h"
 
 #if GRAPHICS_API_DIRECTX12
@@ -19,6 +20,7 @@ class GPUBufferViewDX12 : public GPUBufferView, public IShaderResourceDX12
     GPUDeviceDX12* _device = nullptr;
     ResourceOwnerDX12* _owner = nullptr;
     DescriptorHeapWithSlotsDX12::Slot _srv, _uav;
+    int32 _bindless = -1;
 
 public:
 
@@ -57,6 +59,11 @@ class GPUBufferViewDX12 : public GPUBufferView, public IShaderResourceDX12
     /// </summary>
     void Release()
     {
+        if (_bindless != -1)
+        {
+            _device->FreeBindless(_bindless);
+            _bindless = -1;
+        }
         _srv.Release();
         _uav.Release();
     }
@@ -83,6 +90,10 @@ class GPUBufferViewDX12 : public GPUBufferView, public IShaderResourceDX12
     {
         return (void*)(IShaderResourceDX12*)this;
     }
+    int32 GetBindlessIndex() const override
+    {
+        return _bindless;
+    }
 
     // [IShaderResourceDX12]
     bool IsDepthStencilResource() const override
@@ -114,6 +125,7 @@ class GPUBufferDX12 : public GPUResourceDX12<GPUBuffer>, public ResourceOwnerDX1
     GPUBufferViewDX12 _view;
     GPUBufferDX12* _counter = nullptr;
     GPUResourceMapMode _lastMapMode = (GPUResourceMapMode)255;
+    HeapAllocatorDX12::Allocation _allocation;
 
 public:
 
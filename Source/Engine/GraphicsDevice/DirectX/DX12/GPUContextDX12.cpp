@@ -58,10 +58,15 @@ static_assert(OFFSET_OF(GPUDrawIndexedIndirectArgs, StartIndex) == OFFSET_OF(D3D
 static_assert(OFFSET_OF(GPUDrawIndexedIndirectArgs, StartVertex) == OFFSET_OF(D3D12_DRAW_INDEXED_ARGUMENTS, BaseVertexLocation), "Wrong offset for GPUDrawIndexedIndirectArgs::StartVertex");
 static_assert(OFFSET_OF(GPUDrawIndexedIndirectArgs, StartInstance) == OFFSET_OF(D3D12_DRAW_INDEXED_ARGUMENTS, StartInstanceLocation), "Wrong offset for GPUDrawIndexedIndirectArgs::StartInstance");
 
-GPUContextDX12::GPUContextDX12(GPUDeviceDX12* device, D3D12_COMMAND_LIST_TYPE type)
+GPUContextDX12::GPUContextDX12(GPUDeviceDX12* device, CommandQueueDX12* queue)
     : GPUContext(device)
     , _device(device)
+    , _queue(queue)
     , _commandList(nullptr)
+#if DX12_ENABLE_VARIABLE_RATE_SHADING
+    , _commandList5(nullptr)
+    , _shadingRate(nullptr)
+#endif
     , _currentAllocator(nullptr)
     , _currentState(nullptr)
     , _currentCompute(nullptr)
@@ -69,6 +74,8 @@ GPUContextDX12::GPUContextDX12(GPUDeviceDX12* device, D3D12_COMMAND_LIST_TYPE ty
     , _vbCount(0)
     , _rtCount(0)
     , _rbBufferSize(0)
+    , _uaUsedCount(0)
+    , _uaPendingCount(0)
     , _srMaskDirtyGraphics(0)
     , _srMaskDirtyCompute(0)
     , _isCompute(0)
@@ -77,20 +84,32 @@ GPUContextDX12::GPUContextDX12(GPUDeviceDX12* device, D3D12_COMMAND_LIST_TYPE ty
     , _cbGraphicsDirtyFlag(0)
     , _cbComputeDirtyFlag(0)
     , _samplersDirtyFlag(0)
+    , _isOverlapUA(0)
     , _rtDepth(nullptr)
     , _ibHandle(nullptr)
 {
     FrameFenceValues[0] = 0;
     FrameFenceValues[1] = 0;
-    _currentAllocator = _device->GetCommandQueue()->RequestAllocator();
-    VALIDATE_DIRECTX_CALL(device->GetDevice()->CreateCommandList(0, type, _currentAllocator, nullptr, IID_PPV_ARGS(&_commandList)));
+    _currentAllocator = _queue->RequestAllocator();
+    VALIDATE_DIRECTX_CALL(device->GetDevice()->CreateCommandList(0, _queue->_type, _currentAllocator, nullptr, IID_PPV_ARGS(&_commandList)));
 #if GPU_ENABLE_RESOURCE_NAMING
     _commandList->SetName(TEXT("GPUContextDX12::CommandList"));
 #endif
+#if DX12_ENABLE_VARIABLE_RATE_SHADING
+    if (device->Limits.HasVariableRateShading)
+        _commandList->QueryInterface(IID_PPV_ARGS(&_commandList5));
+#endif
 }
 
 GPUContextDX12::~GPUContextDX12()
 {
+#if DX12_ENABLE_VARIABLE_RATE_SHADING
+    if (_commandList5)
+    {
+        _commandList5->Release();
+        _commandList5 = nullptr;
+    }
+#endif
     DX_SAFE_RELEASE_CHECK(_commandList, 0);
 }
 
@@ -126,6 +145,12 @@ void GPUContextDX12::AddTransitionBarrier(ResourceOwnerDX12* resource, const D3D
 
 void GPUContextDX12::AddUAVBarrier()
 {
+    // UAV barrier with a null resource syncs all UAV writes so nothing is pending anymore
+    _uaPendingCount = 0;
+#if DX12_ENABLE_RESOURCE_BARRIERS_BATCHING
+    if (_rbBufferSize != 0 && _rbBuffer[_rbBufferSize - 1].Type == D3D12_RESOURCE_BARRIER_TYPE_UAV)
+        return;
+#endif
     if (_rbBufferSize == DX12_RB_BUFFER_SIZE)
         flushRBs();
 
@@ -208,13 +233,17 @@ void GPUContextDX12::Reset()
     ASSERT(_commandList != nullptr);
     if (_currentAllocator == nullptr)
     {
-        _currentAllocator = _device->GetCommandQueue()->RequestAllocator();
+        _currentAllocator = _queue->RequestAllocator();
         _commandList->Reset(_currentAllocator, nullptr);
     }
 
     // Setup initial state
     _currentState = nullptr;
     _rtDirtyFlag = false;
+    _isOverlapUA = false;
+#if DX12_ENABLE_VARIABLE_RATE_SHADING
+    _shadingRate = nullptr;
+#endif
     _cbGraphicsDirtyFlag = false;
     _cbComputeDirtyFlag = false;
     _samplersDirtyFlag = false;
@@ -228,6 +257,8 @@ void GPUContextDX12::Reset()
     _isCompute = false;
     _currentCompute = nullptr;
     _rbBufferSize = 0;
+    _uaUsedCount = 0;
+    _uaPendingCount = 0;
     _vbCount = 0;
     Platform::MemoryClear(_rtHandles, sizeof(_rtHandles));
     Platform::MemoryClear(_srHandles, sizeof(_srHandles));
@@ -238,15 +269,19 @@ void GPUContextDX12::Reset()
     Platform::MemoryClear(&_samplers, sizeof(_samplers));
     _swapChainsUsed = 0;
 
-    ForceRebindDescriptors();
+    // Copy command lists don't use root signatures nor descriptor heaps
+    if (_queue->_type != D3D12_COMMAND_LIST_TYPE_COPY)
+        ForceRebindDescriptors();
 }
 
 uint64 GPUContextDX12::Execute(bool waitForCompletion)
 {
     ASSERT(_currentAllocator != nullptr);
-    auto queue = _device->GetCommandQueue();
+    auto queue = _queue;
 
     // Flush remaining and buffered commands
+    if (_uaPendingCount != 0)
+        AddUAVBarrier();
     FlushState();
     _currentState = nullptr;
 
@@ -420,6 +455,7 @@ void GPUContextDX12::flushUAVs()
     // Fill table with source descriptors
     DxShaderHeader& header = _currentCompute ? ((GPUShaderProgramCSDX12*)_currentCompute)->Header : _currentState->Header;
     D3D12_CPU_DESCRIPTOR_HANDLE srcDescriptorRangeStarts[GPU_MAX_UA_BINDED];
+    bool uaBarrier = false;
     for (uint32 i = 0; i < uaCount; i++)
     {
         const auto handle = _uaHandles[i];
@@ -428,13 +464,21 @@ void GPUContextDX12::flushUAVs()
         {
             ASSERT(handle->UavDimension == dimensions);
             srcDescriptorRangeStarts[i] = handle->UAV();
-            SetResourceState(handle->GetResourceOwner(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+            ResourceOwnerDX12* resource = handle->GetResourceOwner();
+            SetResourceState(resource, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+            // Sync with the previous UAV writes to this resource (unless overlapping is allowed)
+            uaBarrier |= !_isOverlapUA && isUAWritePending(resource);
+            if (_isCompute)
+                _uaUsed[_uaUsedCount++] = resource;
         }
         else
         {
             srcDescriptorRangeStarts[i] = _device->NullUAV();
         }
     }
+    if (uaBarrier)
+        AddUAVBarrier();
 
     // Allocate data for the table
     auto allocation = _device->RingHeap_CBV_SRV_UAV.AllocateTable(uaCount);
@@ -536,6 +580,37 @@ void GPUContextDX12::flushRBs()
 #endif
 }
 
+bool GPUContextDX12::isUAWritePending(const ResourceOwnerDX12* resource) const
+{
+    for (int32 i = 0; i < _uaPendingCount; i++)
+    {
+        if (_uaPending[i] == resource)
+            return true;
+    }
+    return false;
+}
+
+void GPUContextDX12::addUAWrite(ResourceOwnerDX12* resource)
+{
+    if (isUAWritePending(resource))
+        return;
+    if (_uaPendingCount == DX12_UA_PENDING_SIZE)
+    {
+        // Too many resources to track so sync all the writes
+        AddUAVBarrier();
+        return;
+    }
+    _uaPending[_uaPendingCount++] = resource;
+}
+
+void GPUContextDX12::addUAWrites()
+{
+    // Track resources written by the dispatch to insert UAV barrier only before the next access to them
+    for (int32 i = 0; i < _uaUsedCount; i++)
+        addUAWrite(_uaUsed[i]);
+    _uaUsedCount = 0;
+}
+
 void GPUContextDX12::flushPS()
 {
     if (_psDirtyFlag && _currentState && (_rtDepth || _rtCount))
@@ -571,6 +646,12 @@ void GPUContextDX12::OnDrawCall()
     {
         SetResourceState(_ibHandle, D3D12_RESOURCE_STATE_INDEX_BUFFER);
     }
+#if DX12_ENABLE_VARIABLE_RATE_SHADING
+    if (_shadingRate)
+    {
+        SetResourceState(_shadingRate, D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE);
+    }
+#endif
 
     if (_currentState)
     {
@@ -732,12 +813,15 @@ void GPUContextDX12::ClearUA(GPUBuffer* buf, const Float4& value)
     auto bufDX12 = reinterpret_cast<GPUBufferDX12*>(buf);
 
     SetResourceState(bufDX12, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    if (isUAWritePending(bufDX12))
+        AddUAVBarrier();
     flushRBs();
 
     auto uav = ((GPUBufferViewDX12*)bufDX12->View())->UAV();
     Descriptor desc;
     GetActiveHeapDescriptor(uav, desc);
     _commandList->ClearUnorderedAccessViewFloat(desc.GPU, uav, bufDX12->GetResource(), value.Raw, 0, nullptr);
+    addUAWrite(bufDX12);
 }
 
 void GPUContextDX12::ClearUA(GPUBuffer* buf, const uint32 value[4])
@@ -746,12 +830,15 @@ void GPUContextDX12::ClearUA(GPUBuffer* buf, const uint32 value[4])
     auto bufDX12 = reinterpret_cast<GPUBufferDX12*>(buf);
 
     SetResourceState(bufDX12, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    if (isUAWritePending(bufDX12))
+        AddUAVBarrier();
     flushRBs();
 
     auto uav = ((GPUBufferViewDX12*)bufDX12->View())->UAV();
     Descriptor desc;
     GetActiveHeapDescriptor(uav, desc);
     _commandList->ClearUnorderedAccessViewUint(desc.GPU, uav, bufDX12->GetResource(), value, 0, nullptr);
+    addUAWrite(bufDX12);
 }
 
 void GPUContextDX12::ClearUA(GPUTexture* texture, const uint32 value[4])
@@ -760,12 +847,15 @@ void GPUContextDX12::ClearUA(GPUTexture* texture, const uint32 value[4])
     auto texDX12 = reinterpret_cast<GPUTextureDX12*>(texture);
 
     SetResourceState(texDX12, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    if (isUAWritePending(texDX12))
+        AddUAVBarrier();
     flushRBs();
 
     auto uav = ((GPUTextureViewDX12*)texDX12->View(0))->UAV();
     Descriptor desc;
     GetActiveHeapDescriptor(uav, desc);
     _commandList->ClearUnorderedAccessViewUint(desc.GPU, uav, texDX12->GetResource(), value, 0, nullptr);
+    addUAWrite(texDX12);
 }
 
 void GPUContextDX12::ClearUA(GPUTexture* texture, const Float4& value)
@@ -774,12 +864,15 @@ void GPUContextDX12::ClearUA(GPUTexture* texture, const Float4& value)
     auto texDX12 = reinterpret_cast<GPUTextureDX12*>(texture);
 
     SetResourceState(texDX12, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    if (isUAWritePending(texDX12))
+        AddUAVBarrier();
     flushRBs();
 
     auto uav = ((GPUTextureViewDX12*)(texDX12->IsVolume() ? texDX12->ViewVolume() : texDX12->View(0)))->UAV();
     Descriptor desc;
     GetActiveHeapDescriptor(uav, desc);
     _commandList->ClearUnorderedAccessViewFloat(desc.GPU, uav, texDX12->GetResource(), value.Raw, 0, nullptr);
+    addUAWrite(texDX12);
 }
 
 void GPUContextDX12::ResetRenderTarget()
@@ -903,6 +996,7 @@ void GPUContextDX12::BindCB(int32 slot, GPUConstantBuffer* cb)
 {
     ASSERT(slot >= 0 && slot < GPU_MAX_CB_BINDED);
     auto cbDX12 = static_cast<GPUConstantBufferDX12*>(cb);
+    RENDER_STAT_STATE_BIND(_cbHandles[slot] == cbDX12);
     if (_cbHandles[slot] != cbDX12)
     {
         _cbGraphicsDirtyFlag = true;
@@ -915,6 +1009,7 @@ void GPUContextDX12::BindSR(int32 slot, GPUResourceView* view)
 {
     ASSERT(slot >= 0 && slot < GPU_MAX_SR_BINDED);
     auto handle = view ? (IShaderResourceDX12*)view->GetNativePtr() : nullptr;
+    RENDER_STAT_STATE_BIND(_srHandles[slot] == handle && handle);
     if (_srHandles[slot] != handle || !handle)
     {
         _srMaskDirtyGraphics |= 1 << slot;
@@ -928,7 +1023,9 @@ void GPUContextDX12::BindSR(int32 slot, GPUResourceView* view)
 void GPUContextDX12::BindUA(int32 slot, GPUResourceView* view)
 {
     ASSERT(slot >= 0 && slot < GPU_MAX_UA_BINDED);
-    _uaHandles[slot] = view ? (IShaderResourceDX12*)view->GetNativePtr() : nullptr;
+    const auto handle = view ? (IShaderResourceDX12*)view->GetNativePtr() : nullptr;
+    RENDER_STAT_STATE_BIND(_uaHandles[slot] == handle);
+    _uaHandles[slot] = handle;
     if (view)
         *view->LastRenderTime = _lastRenderTime;
 }
@@ -959,6 +1056,7 @@ void GPUContextDX12::BindVB(const Span<GPUBuffer*>& vertexBuffers, const uint32*
         vbEdited |= vbDX12 != _vbHandles[i];
         _vbHandles[i] = vbDX12;
     }
+    RENDER_STAT_STATE_BIND(!vbEdited);
     if (vbEdited)
     {
         _vbCount = vertexBuffers.Length();
@@ -976,6 +1074,7 @@ void GPUContextDX12::BindIB(GPUBuffer* indexBuffer)
     const auto ibDX12 = static_cast<GPUBufferDX12*>(indexBuffer);
     D3D12_INDEX_BUFFER_VIEW view;
     ibDX12->GetIBView(view);
+    RENDER_STAT_STATE_BIND(!(ibDX12 != _ibHandle || _ibView != view));
     if (ibDX12 != _ibHandle || _ibView != view)
     {
         _ibHandle = ibDX12;
@@ -988,6 +1087,7 @@ void GPUContextDX12::BindSampler(int32 slot, GPUSampler* sampler)
 {
     ASSERT(slot >= GPU_STATIC_SAMPLERS_COUNT && slot < GPU_MAX_SAMPLER_BINDED);
     const auto handle = sampler ? static_cast<GPUSamplerDX12*>(sampler) : nullptr;
+    RENDER_STAT_STATE_BIND(_samplers[slot - GPU_STATIC_SAMPLERS_COUNT] == handle);
     if (_samplers[slot - GPU_STATIC_SAMPLERS_COUNT] != handle)
     {
         _samplersDirtyFlag = true;
@@ -1050,8 +1150,8 @@ void GPUContextDX12::Dispatch(GPUShaderProgramCS* shader, uint32 threadGroupCoun
     // Restore previous state on next draw call
     _psDirtyFlag = true;
 
-    // Insert UAV barrier to ensure proper memory access for multiple sequential dispatches
-    AddUAVBarrier();
+    // Insert UAV barrier before the next access to the resources written by this dispatch
+    addUAWrites();
 }
 
 void GPUContextDX12::DispatchIndirect(GPUShaderProgramCS* shader, GPUBuffer* bufferForArgs, uint32 offsetForArgs)
@@ -1084,8 +1184,14 @@ void GPUContextDX12::DispatchIndirect(GPUShaderProgramCS* shader, GPUBuffer* buf
     // Restore previous state on next draw call
     _psDirtyFlag = true;
 
-    // Insert UAV barrier to ensure proper memory access for multiple sequential dispatches
-    AddUAVBarrier();
+    // Insert UAV barrier before the next access to the resources written by this dispatch
+    addUAWrites();
+}
+
+void GPUContextDX12::OverlapUA(bool end)
+{
+    // Writes done during overlapping are still tracked so the following accesses will be synced
+    _isOverlapUA = !end;
 }
 
 void GPUContextDX12::ResolveMultisample(GPUTexture* sourceMultisampleTexture, GPUTexture* destTexture, int32 sourceSubResource, int32 destSubResource, PixelFormat format)
@@ -1159,6 +1265,23 @@ void GPUContextDX12::SetScissor(const Rectangle& scissorRect)
     _commandList->RSSetScissorRects(1, &rect);
 }
 
+void GPUContextDX12::SetShadingRate(GPUTexture* shadingRate)
+{
+#if DX12_ENABLE_VARIABLE_RATE_SHADING
+    auto shadingRateDX12 = static_cast<GPUTextureDX12*>(shadingRate);
+    if (!_commandList5 || _shadingRate == shadingRateDX12)
+        return;
+    _shadingRate = shadingRateDX12;
+
+    // Use the rate from the image (per-primitive and per-draw rates are not used)
+    const D3D12_SHADING_RATE_COMBINER combiners[D3D12_RS_SET_SHADING_RATE_COMBINER_COUNT] = { D3D12_SHADING_RATE_COMBINER_PASSTHROUGH, D3D12_SHADING_RATE_COMBINER_OVERRIDE };
+    _commandList5->RSSetShadingRate(D3D12_SHADING_RATE_1X1, shadingRateDX12 ? combiners : nullptr);
+    if (shadingRateDX12)
+        SetResourceState(shadingRateDX12, D3D12_RESOURCE_STATE_SHADING_RATE_SOURCE);
+    _commandList5->RSSetShadingRateImage(shadingRateDX12 ? shadingRateDX12->GetResource() : nullptr);
+#endif
+}
+
 GPUPipelineState* GPUContextDX12::GetState() const
 {
     return _currentState;
@@ -1166,6 +1289,7 @@ GPUPipelineState* GPUContextDX12::GetState() const
 
 void GPUContextDX12::SetState(GPUPipelineState* state)
 {
+    RENDER_STAT_STATE_BIND(_currentState == state);
     if (_currentState != state)
     {
         _currentState = static_cast<GPUPipelineStateDX12*>(state);
@@ -1223,6 +1347,26 @@ void GPUContextDX12::UpdateBuffer(GPUBuffer* buffer, const void* data, uint32 si
     _device->UploadBuffer->UploadBuffer(this, bufferDX12->GetResource(), offset, data, size);
 }
 
+void* GPUContextDX12::UpdateBufferMapped(GPUBuffer* buffer, uint32 size, uint32 offset)
+{
+    ASSERT(buffer && buffer->GetSize() >= size + offset);
+
+    auto bufferDX12 = (GPUBufferDX12*)buffer;
+
+    // Allocate data within the upload buffer page (persistently mapped and valid until the frame gets executed by the GPU)
+    const DynamicAllocation allocation = _device->UploadBuffer->Allocate(size, 4);
+    if (allocation.IsInvalid())
+        return nullptr;
+
+    SetResourceState(bufferDX12, D3D12_RESOURCE_STATE_COPY_DEST);
+    flushRBs();
+
+    // Copy buffer region (data is written by the caller before command list submission)
+    _commandList->CopyBufferRegion(bufferDX12->GetResource(), offset, allocation.Page->GetResource(), allocation.Offset, size);
+
+    return allocation.CPUAddress;
+}
+
 void GPUContextDX12::CopyBuffer(GPUBuffer* dstBuffer, GPUBuffer* srcBuffer, uint32 size, uint32 dstOffset, uint32 srcOffset)
 {
     ASSERT(dstBuffer && srcBuffer);
@@ -1450,6 +1594,12 @@ void GPUContextDX12::SetResourceState(GPUResource* resource, uint64 state, int32
     SetResourceState(resourceDX12, (D3D12_RESOURCE_STATES)state, subresource);
 }
 
+void GPUContextDX12::SetResourceShaderReadState(GPUResource* resource, int32 subresource)
+{
+    auto resourceDX12 = dynamic_cast<ResourceOwnerDX12*>(resource);
+    SetResourceState(resourceDX12, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, subresource);
+}
+
 void GPUContextDX12::ForceRebindDescriptors()
 {
     // Bind Root Signature
@@ -1459,6 +1609,14 @@ void GPUContextDX12::ForceRebindDescriptors()
     // Bind heaps
     ID3D12DescriptorHeap* ppHeaps[] = {_device->RingHeap_CBV_SRV_UAV.GetHeap(), _device->RingHeap_Sampler.GetHeap()};
     _commandList->SetDescriptorHeaps(ARRAY_COUNT(ppHeaps), ppHeaps);
+
+    // Bind global bindless resources table
+    if (_device->Limits.HasBindlessResources)
+    {
+        const D3D12_GPU_DESCRIPTOR_HANDLE bindless = _device->RingHeap_CBV_SRV_UAV.GetReserved(0).GPU;
+        _commandList->SetGraphicsRootDescriptorTable(DX12_ROOT_SIGNATURE_BINDLESS, bindless);
+        _commandList->SetComputeRootDescriptorTable(DX12_ROOT_SIGNATURE_BINDLESS, bindless);
+    }
 }
 
 #endif
@@ -14,12 +14,19 @@ class GPUPipelineStateDX12;
 class GPUBufferDX12;
 class GPUSamplerDX12;
 class GPUConstantBufferDX12;
+class GPUTextureDX12;
 class GPUTextureViewDX12;
+class CommandQueueDX12;
 
 /// <summary>
 /// Size of the resource barriers buffer size (will be flushed on overflow)
 /// </summary>
-#define DX12_RB_BUFFER_SIZE 16
+#define DX12_RB_BUFFER_SIZE 64
+
+/// <summary>
+/// Size of the buffer with resources written via UAV by dispatches since the last UAV barrier (barrier will be inserted on overflow)
+/// </summary>
+#define DX12_UA_PENDING_SIZE 32
 
 /// <summary>
 /// GPU Commands Context implementation for DirectX 12
@@ -35,7 +42,12 @@ class GPUContextDX12 : public GPUContext
 private:
 
     GPUDeviceDX12* _device;
+    CommandQueueDX12* _queue;
     ID3D12GraphicsCommandList* _commandList;
+#if DX12_ENABLE_VARIABLE_RATE_SHADING
+    ID3D12GraphicsCommandList5* _commandList5;
+    GPUTextureDX12* _shadingRate;
+#endif
     ID3D12CommandAllocator* _currentAllocator;
     GPUPipelineStateDX12* _currentState;
     GPUShaderProgramCS* _currentCompute;
@@ -44,6 +56,8 @@ class GPUContextDX12 : public GPUContext
     int32 _vbCount;
     int32 _rtCount;
     int32 _rbBufferSize;
+    int32 _uaUsedCount;
+    int32 _uaPendingCount;
 
     uint32 _srMaskDirtyGraphics;
     uint32 _srMaskDirtyCompute;
@@ -56,6 +70,7 @@ class GPUContextDX12 : public GPUContext
     int32 _cbGraphicsDirtyFlag : 1;
     int32 _cbComputeDirtyFlag : 1;
     int32 _samplersDirtyFlag : 1;
+    int32 _isOverlapUA : 1;
 
     GPUTextureViewDX12* _rtDepth;
     GPUTextureViewDX12* _rtHandles[GPU_MAX_RT_BINDED];
@@ -66,12 +81,14 @@ class GPUContextDX12 : public GPUContext
     D3D12_INDEX_BUFFER_VIEW _ibView;
     D3D12_VERTEX_BUFFER_VIEW _vbViews[GPU_MAX_VB_BINDED];
     D3D12_RESOURCE_BARRIER _rbBuffer[DX12_RB_BUFFER_SIZE];
+    ResourceOwnerDX12* _uaUsed[GPU_MAX_UA_BINDED];
+    ResourceOwnerDX12* _uaPending[DX12_UA_PENDING_SIZE];
     GPUConstantBufferDX12* _cbHandles[GPU_MAX_CB_BINDED];
     GPUSamplerDX12* _samplers[GPU_MAX_SAMPLER_BINDED - GPU_STATIC_SAMPLERS_COUNT];
 
 public:
 
-    GPUContextDX12(GPUDeviceDX12* device, D3D12_COMMAND_LIST_TYPE type);
+    GPUContextDX12(GPUDeviceDX12* device, CommandQueueDX12* queue);
     ~GPUContextDX12();
 
 public:
@@ -145,6 +162,9 @@ class GPUContextDX12 : public GPUContext
     void flushSamplers();
     void flushRBs();
     void flushPS();
+    bool isUAWritePending(const ResourceOwnerDX12* resource) const;
+    void addUAWrite(ResourceOwnerDX12* resource);
+    void addUAWrites();
     void OnDrawCall();
 
 public:
@@ -182,6 +202,7 @@ class GPUContextDX12 : public GPUContext
     void UpdateCB(GPUConstantBuffer* cb, const void* data) override;
     void Dispatch(GPUShaderProgramCS* shader, uint32 threadGroupCountX, uint32 threadGroupCountY, uint32 threadGroupCountZ) override;
     void DispatchIndirect(GPUShaderProgramCS* shader, GPUBuffer* bufferForArgs, uint32 offsetForArgs) override;
+    void OverlapUA(bool end) override;
     void ResolveMultisample(GPUTexture* sourceMultisampleTexture, GPUTexture* destTexture, int32 sourceSubResource, int32 destSubResource, PixelFormat format) override;
     void DrawInstanced(uint32 verticesCount, uint32 instanceCount, int32 startInstance, int32 startVertex) override;
     void DrawIndexedInstanced(uint32 indicesCount, uint32 instanceCount, int32 startInstance, int32 startVertex, int32 startIndex) override;
@@ -189,12 +210,14 @@ class GPUContextDX12 : public GPUContext
     void DrawIndexedInstancedIndirect(GPUBuffer* bufferForArgs, uint32 offsetForArgs) override;
     void SetViewport(const Viewport& viewport) override;
     void SetScissor(const Rectangle& scissorRect) override;
+    void SetShadingRate(GPUTexture* shadingRate) override;
     GPUPipelineState* GetState() const override;
     void SetState(GPUPipelineState* state) override;
     void ClearState() override;
     void FlushState() override;
     void Flush() override;
     void UpdateBuffer(GPUBuffer* buffer, const void* data, uint32 size, uint32 offset) override;
+    void* UpdateBufferMapped(GPUBuffer* buffer, uint32 size, uint32 offset) override;
     void CopyBuffer(GPUBuffer* dstBuffer, GPUBuffer* srcBuffer, uint32 size, uint32 dstOffset, uint32 srcOffset) override;
     void UpdateTexture(GPUTexture* texture, int32 arrayIndex, int32 mipIndex, const void* data, uint32 rowPitch, uint32 slicePitch) override;
     void CopyTexture(GPUTexture* dstResource, uint32 dstSubresource, uint32 dstX, uint32 dstY, uint32 dstZ, GPUTexture* srcResource, uint32 srcSubresource) override;
@@ -203,6 +226,7 @@ class GPUContextDX12 : public GPUContext
     void CopyResource(GPUResource* dstResource, GPUResource* srcResource) override;
     void CopySubresource(GPUResource* dstResource, uint32 dstSubresource, GPUResource* srcResource, uint32 srcSubresource) override;
     void SetResourceState(GPUResource* resource, uint64 state, int32 subresource) override;
+    void SetResourceShaderReadState(GPUResource* resource, int32 subresource) override;
     void ForceRebindDescriptors() override;
 };
 
@@ -11,6 +11,7 @@
 #include "GPUBufferDX12.h"
 #include "GPUSamplerDX12.h"
 #include "GPUSwapChainDX12.h"
+#include "GPUTasksExecutorDX12.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Engine/CommandLine.h"
 #include "Engine/Graphics/RenderTask.h"
@@ -19,6 +20,7 @@
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Config/PlatformSettings.h"
 #include "UploadBufferDX12.h"
+#include "HeapAllocatorDX12.h"
 #include "CommandQueueDX12.h"
 #include "Engine/Core/Utilities.h"
 #include "Engine/Threading/Threading.h"
@@ -227,12 +229,14 @@ GPUDeviceDX12::GPUDeviceDX12(IDXGIFactory4* dxgiFactory, GPUAdapterDX* adapter)
     , _commandQueue(nullptr)
     , _mainContext(nullptr)
     , UploadBuffer(nullptr)
+    , BuffersAllocator(nullptr)
     , TimestampQueryHeap(this, D3D12_QUERY_HEAP_TYPE_TIMESTAMP, DX12_BACK_BUFFER_COUNT * 1024)
+    , PipelineStatsQueryHeap(this, D3D12_QUERY_HEAP_TYPE_PIPELINE_STATISTICS, DX12_BACK_BUFFER_COUNT * 512)
     , Heap_CBV_SRV_UAV(this, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 4 * 1024, false)
     , Heap_RTV(this, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, 1 * 1024, false)
     , Heap_DSV(this, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 64, false)
     , Heap_Sampler(this, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, 128, false)
-    , RingHeap_CBV_SRV_UAV(this, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 512 * 1024, true)
+    , RingHeap_CBV_SRV_UAV(this, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 512 * 1024, true, GPU_MAX_BINDLESS_RESOURCES)
     , RingHeap_Sampler(this, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, 1 * 1024, true)
 {
 }
@@ -303,6 +307,7 @@ bool GPUDeviceDX12::Init()
         return true;
     }
     UpdateOutputs(adapter);
+    InitMemoryBudget(adapter);
 
     ComPtr<IDXGIFactory5> factory5;
     _factoryDXGI->QueryInterface(IID_PPV_ARGS(&factory5));
@@ -320,6 +325,11 @@ bool GPUDeviceDX12::Init()
 
     // Create DirectX device
     VALIDATE_DIRECTX_CALL(D3D12CreateDevice(adapter, D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&_device)));
+#if DX12_ENABLE_PIPELINE_LIBRARY
+    LARGE_INTEGER driverVersion;
+    if (SUCCEEDED(adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driverVersion)))
+        _driverVersion = (uint64)driverVersion.QuadPart;
+#endif
 
     // Debug Layer
 #if GPU_ENABLE_DIAGNOSTICS
@@ -385,6 +395,21 @@ bool GPUDeviceDX12::Init()
         limits.HasReadOnlyDepth = true;
         limits.HasMultisampleDepthAsSRV = true;
         limits.HasTypedUAVLoad = options.TypedUAVLoadAdditionalFormats != 0;
+        limits.HasSparseTextures = options.TiledResourcesTier >= D3D12_TILED_RESOURCES_TIER_1;
+#if DX12_ENABLE_VARIABLE_RATE_SHADING
+        D3D12_FEATURE_DATA_D3D12_OPTIONS6 options6 = {};
+        if (SUCCEEDED(_device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS6, &options6, sizeof(options6))) && options6.VariableShadingRateTier >= D3D12_VARIABLE_SHADING_RATE_TIER_2)
+        {
+            limits.HasVariableRateShading = true;
+            limits.VariableRateShadingTileSize = (int32)options6.ShadingRateImageTileSize;
+        }
+        else
+#endif
+        {
+            limits.HasVariableRateShading = false;
+            limits.VariableRateShadingTileSize = 0;
+        }
+        limits.HasBindlessResources = options.ResourceBindingTier >= D3D12_RESOURCE_BINDING_TIER_2;
         limits.MaximumMipLevelsCount = D3D12_REQ_MIP_LEVELS;
         limits.MaximumTexture1DSize = D3D12_REQ_TEXTURE1D_U_DIMENSION;
         limits.MaximumTexture1DArraySize = D3D12_REQ_TEXTURE1D_ARRAY_AXIS_DIMENSION;
@@ -419,7 +444,7 @@ bool GPUDeviceDX12::Init()
     _commandQueue = New<CommandQueueDX12>(this, D3D12_COMMAND_LIST_TYPE_DIRECT);
     if (_commandQueue->Init())
         return true;
-    _mainContext = New<GPUContextDX12>(this, D3D12_COMMAND_LIST_TYPE_DIRECT);
+    _mainContext = New<GPUContextDX12>(this, _commandQueue);
     if (RingHeap_CBV_SRV_UAV.Init())
         return true;
     if (RingHeap_Sampler.Init())
@@ -498,12 +523,20 @@ bool GPUDeviceDX12::Init()
         uavDesc.Texture2D.PlaneSlice = 0;
         _nullUav.CreateUAV(this, nullptr, &uavDesc);
     }
+    if (Limits.HasBindlessResources)
+    {
+        // Initialize bindless resources table with null descriptors
+        const D3D12_CPU_DESCRIPTOR_HANDLE nullSrv = _nullSrv[D3D12_SRV_DIMENSION_TEXTURE2D].CPU();
+        for (uint32 i = 0; i < GPU_MAX_BINDLESS_RESOURCES; i++)
+            _device->CopyDescriptorsSimple(1, RingHeap_CBV_SRV_UAV.GetReserved(i).CPU, nullSrv, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    }
 
     // Create root signature
     // TODO: maybe create set of different root signatures? for UAVs, for compute, for simple drawing, for post fx?
     {
         // Descriptor tables
         D3D12_DESCRIPTOR_RANGE r[3]; // SRV+UAV+Sampler
+        D3D12_DESCRIPTOR_RANGE bindlessRanges[4]; // Texture2D+Texture3D+TextureCube+Buffer (aliased in separate register spaces)
         {
             D3D12_DESCRIPTOR_RANGE& range = r[0];
             range.RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
@@ -528,9 +561,18 @@ bool GPUDeviceDX12::Init()
             range.RegisterSpace = 0;
             range.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
         }
+        for (int32 i = 0; i < ARRAY_COUNT(bindlessRanges); i++)
+        {
+            D3D12_DESCRIPTOR_RANGE& range = bindlessRanges[i];
+            range.RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+            range.NumDescriptors = GPU_MAX_BINDLESS_RESOURCES;
+            range.BaseShaderRegister = 0;
+            range.RegisterSpace = i + 1;
+            range.OffsetInDescriptorsFromTableStart = 0;
+        }
 
         // Root parameters
-        D3D12_ROOT_PARAMETER rootParameters[GPU_MAX_CB_BINDED + 3];
+        D3D12_ROOT_PARAMETER rootParameters[GPU_MAX_CB_BINDED + 4];
         for (int32 i = 0; i < GPU_MAX_CB_BINDED; i++)
         {
             // CB
@@ -564,6 +606,14 @@ bool GPUDeviceDX12::Init()
             rootParam.DescriptorTable.NumDescriptorRanges = 1;
             rootParam.DescriptorTable.pDescriptorRanges = &r[2];
         }
+        {
+            // Bindless resources (skipped if not supported)
+            D3D12_ROOT_PARAMETER& rootParam = rootParameters[DX12_ROOT_SIGNATURE_BINDLESS];
+            rootParam.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+            rootParam.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+            rootParam.DescriptorTable.NumDescriptorRanges = ARRAY_COUNT(bindlessRanges);
+            rootParam.DescriptorTable.pDescriptorRanges = bindlessRanges;
+        }
 
         // Static samplers
         D3D12_STATIC_SAMPLER_DESC staticSamplers[6];
@@ -654,7 +704,7 @@ bool GPUDeviceDX12::Init()
 
         // Init
         D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc;
-        rootSignatureDesc.NumParameters = ARRAY_COUNT(rootParameters);
+        rootSignatureDesc.NumParameters = Limits.HasBindlessResources ? ARRAY_COUNT(rootParameters) : ARRAY_COUNT(rootParameters) - 1;
         rootSignatureDesc.pParameters = rootParameters;
         rootSignatureDesc.NumStaticSamplers = ARRAY_COUNT(staticSamplers);
         rootSignatureDesc.pStaticSamplers = staticSamplers;
@@ -672,7 +722,15 @@ bool GPUDeviceDX12::Init()
     // Upload buffer
     UploadBuffer = New<UploadBufferDX12>(this);
 
-    if (TimestampQueryHeap.Init())
+    // Buffers memory allocator
+    BuffersAllocator = New<HeapAllocatorDX12>(this);
+
+#if DX12_ENABLE_PIPELINE_LIBRARY
+    // Pipeline states cache
+    LoadPipelineLibrary();
+#endif
+
+    if (TimestampQueryHeap.Init() || PipelineStatsQueryHeap.Init())
         return true;
 
     // Cached command signatures
@@ -708,6 +766,7 @@ void GPUDeviceDX12::DrawBegin()
     GPUDeviceDX::DrawBegin();
 
     updateRes2Dispose();
+    BuffersAllocator->Update(Engine::FrameCount);
     UploadBuffer->BeginGeneration(Engine::FrameCount);
 }
 
@@ -718,6 +777,7 @@ void GPUDeviceDX12::RenderEnd()
 
     // Resolve the timestamp queries
     TimestampQueryHeap.EndQueryBatchAndResolveQueryData(_mainContext);
+    PipelineStatsQueryHeap.EndQueryBatchAndResolveQueryData(_mainContext);
 }
 
 GPUDeviceDX12::~GPUDeviceDX12()
@@ -746,6 +806,115 @@ ID3D12CommandQueue* GPUDeviceDX12::GetCommandQueueDX12() const
     return _commandQueue->GetCommandQueue();
 }
 
+#if DX12_ENABLE_PIPELINE_LIBRARY
+
+#define DX12_PIPELINE_LIBRARY_MAGIC 0x4C505846 // 'FXPL'
+#define DX12_PIPELINE_LIBRARY_VERSION 1
+
+struct PipelineLibraryHeaderDX12
+{
+    uint32 Magic;
+    uint32 Version;
+    uint32 VendorId;
+    uint32 DeviceId;
+    uint32 SubSysId;
+    uint32 Revision;
+    uint64 DriverVersion;
+};
+
+static void GetPipelineLibraryPath(String& path)
+{
+#if USE_EDITOR
+    path = Globals::ProjectCacheFolder / TEXT("DX12Pipeline.cache");
+#else
+    path = Globals::ProductLocalFolder / TEXT("DX12Pipeline.cache");
+#endif
+}
+
+static void GetPipelineLibraryHeader(PipelineLibraryHeaderDX12& header, const DXGI_ADAPTER_DESC& desc, uint64 driverVersion)
+{
+    Platform::MemoryClear(&header, sizeof(header));
+    header.Magic = DX12_PIPELINE_LIBRARY_MAGIC;
+    header.Version = DX12_PIPELINE_LIBRARY_VERSION;
+    header.VendorId = desc.VendorId;
+    header.DeviceId = desc.DeviceId;
+    header.SubSysId = desc.SubSysId;
+    header.Revision = desc.Revision;
+    header.DriverVersion = driverVersion;
+}
+
+void GPUDeviceDX12::LoadPipelineLibrary()
+{
+    ComPtr<ID3D12Device1> device1;
+    if (FAILED(_device->QueryInterface(IID_PPV_ARGS(&device1))) || !device1)
+        return;
+    PipelineLibraryHeaderDX12 header;
+    GetPipelineLibraryHeader(header, _adapter->Description, _driverVersion);
+
+    // Load library from the previous run (skip data created for a different GPU or driver)
+    String path;
+    GetPipelineLibraryPath(path);
+    Array<byte> data;
+    if (FileSystem::FileExists(path) && !File::ReadAllBytes(path, data) && data.Count() > (int32)sizeof(header))
+    {
+        if (Platform::MemoryCompare(data.Get(), &header, sizeof(header)) == 0)
+        {
+            LOG(Info, "Trying to load DirectX 12 pipeline library file {0}", path);
+
+            // Serialized data has to be valid during the library lifetime
+            _pipelineLibraryData.Set(data.Get() + sizeof(header), data.Count() - (int32)sizeof(header));
+            const HRESULT result = device1->CreatePipelineLibrary(_pipelineLibraryData.Get(), _pipelineLibraryData.Count(), IID_PPV_ARGS(&PipelineLibrary));
+            if (FAILED(result))
+            {
+                LOG(Info, "Discarding DirectX 12 pipeline library (result: 0x{0:x})", (uint32)result);
+                PipelineLibrary = nullptr;
+                _pipelineLibraryData.Resize(0);
+            }
+        }
+        else
+        {
+            LOG(Info, "Discarding DirectX 12 pipeline library created for a different GPU or driver");
+        }
+    }
+
+    // Create an empty library
+    if (!PipelineLibrary)
+    {
+        const HRESULT result = device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&PipelineLibrary));
+        if (FAILED(result))
+        {
+            // Not supported (eg. by graphics debugging tools)
+            LOG(Info, "DirectX 12 pipeline library is not supported (result: 0x{0:x})", (uint32)result);
+            PipelineLibrary = nullptr;
+        }
+    }
+}
+
+bool GPUDeviceDX12::SavePipelineLibrary()
+{
+    ScopeLock lock(PipelineLibraryLocker);
+    if (!PipelineLibrary || !PipelineLibraryDirty)
+        return false;
+
+    // Serialize library with header used to validate it on load
+    PipelineLibraryHeaderDX12 header;
+    GetPipelineLibraryHeader(header, _adapter->Description, _driverVersion);
+    const SIZE_T size = PipelineLibrary->GetSerializedSize();
+    Array<byte> data;
+    data.Resize(sizeof(header) + (int32)size);
+    Platform::MemoryCopy(data.Get(), &header, sizeof(header));
+    const HRESULT result = PipelineLibrary->Serialize(data.Get() + sizeof(header), size);
+    LOG_DIRECTX_RESULT_WITH_RETURN(result, true);
+    PipelineLibraryDirty = false;
+
+    // Save data
+    String path;
+    GetPipelineLibraryPath(path);
+    return File::WriteAllBytes(path, data);
+}
+
+#endif
+
 void GPUDeviceDX12::Dispose()
 {
     GPUDeviceLock lock(this);
@@ -760,6 +929,11 @@ void GPUDeviceDX12::Dispose()
     // Wait for rendering end
     WaitForGPU();
 
+#if DX12_ENABLE_PIPELINE_LIBRARY
+    if (SavePipelineLibrary())
+        LOG(Warning, "Failed to save DirectX 12 pipeline library");
+#endif
+
     // Pre dispose
     preDispose();
 
@@ -771,6 +945,11 @@ void GPUDeviceDX12::Dispose()
         srv.Release();
     _nullUav.Release();
     TimestampQueryHeap.Destroy();
+    PipelineStatsQueryHeap.Destroy();
+#if DX12_ENABLE_PIPELINE_LIBRARY
+    SAFE_RELEASE(PipelineLibrary);
+    _pipelineLibraryData.Resize(0);
+#endif
     DX_SAFE_RELEASE_CHECK(_rootSignature, 0);
     Heap_CBV_SRV_UAV.ReleaseGPU();
     Heap_RTV.ReleaseGPU();
@@ -779,6 +958,7 @@ void GPUDeviceDX12::Dispose()
     RingHeap_CBV_SRV_UAV.ReleaseGPU();
     RingHeap_Sampler.ReleaseGPU();
     SAFE_DELETE(UploadBuffer);
+    SAFE_DELETE(BuffersAllocator);
     SAFE_DELETE(DrawIndirectCommandSignature);
     SAFE_DELETE(_mainContext);
     SAFE_DELETE(_commandQueue);
@@ -840,6 +1020,11 @@ GPUConstantBuffer* GPUDeviceDX12::CreateConstantBuffer(uint32 size, const String
     return New<GPUConstantBufferDX12>(this, size, name);
 }
 
+GPUTasksExecutor* GPUDeviceDX12::CreateTasksExecutor()
+{
+    return New<GPUTasksExecutorDX12>(this);
+}
+
 void GPUDeviceDX12::AddResourceToLateRelease(IGraphicsUnknown* resource, uint32 safeFrameCount)
 {
     if (resource == nullptr)
@@ -854,6 +1039,40 @@ void GPUDeviceDX12::AddResourceToLateRelease(IGraphicsUnknown* resource, uint32
     _res2Dispose.Add(entry);
 }
 
+int32 GPUDeviceDX12::AllocateBindless(D3D12_CPU_DESCRIPTOR_HANDLE srv)
+{
+    if (!Limits.HasBindlessResources || srv.ptr == 0)
+        return -1;
+    ScopeLock lock(_bindlessLock);
+
+    // Reuse the slot released a few frames ago or use a new one
+    int32 index = -1;
+    if (_bindlessFree.HasItems() && _bindlessFree[0].TargetFrame <= Engine::FrameCount)
+    {
+        index = _bindlessFree[0].Index;
+        _bindlessFree.RemoveAtKeepOrder(0);
+    }
+    else if (_bindlessCount < GPU_MAX_BINDLESS_RESOURCES)
+    {
+        index = _bindlessCount++;
+    }
+    else
+    {
+        return -1;
+    }
+
+    _device->CopyDescriptorsSimple(1, RingHeap_CBV_SRV_UAV.GetReserved(index).CPU, srv, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    return index;
+}
+
+void GPUDeviceDX12::FreeBindless(int32 index)
+{
+    if (index < 0)
+        return;
+    ScopeLock lock(_bindlessLock);
+    _bindlessFree.Add({ index, Engine::FrameCount + DX12_BACK_BUFFER_COUNT + 1 });
+}
+
 void GPUDeviceDX12::updateRes2Dispose()
 {
     uint64 currentFrame = Engine::FrameCount;
@@ -13,20 +13,26 @@
 
 #if PLATFORM_WINDOWS
 #define DX12_BACK_BUFFER_COUNT 3
+#define DX12_ENABLE_VARIABLE_RATE_SHADING 1
+#define DX12_ENABLE_PIPELINE_LIBRARY 1
 #else
 #define DX12_BACK_BUFFER_COUNT 2
+#define DX12_ENABLE_VARIABLE_RATE_SHADING 0
+#define DX12_ENABLE_PIPELINE_LIBRARY 0
 #endif
 
 #define DX12_ROOT_SIGNATURE_CB 0
 #define DX12_ROOT_SIGNATURE_SR (GPU_MAX_CB_BINDED+0)
 #define DX12_ROOT_SIGNATURE_UA (GPU_MAX_CB_BINDED+1)
 #define DX12_ROOT_SIGNATURE_SAMPLER (GPU_MAX_CB_BINDED+2)
+#define DX12_ROOT_SIGNATURE_BINDLESS (GPU_MAX_CB_BINDED+3)
 
 class Engine;
 class WindowsWindow;
 class GPUContextDX12;
 class GPUSwapChainDX12;
 class UploadBufferDX12;
+class HeapAllocatorDX12;
 class CommandQueueDX12;
 class CommandSignatureDX12;
 
@@ -46,6 +52,12 @@ class GPUDeviceDX12 : public GPUDeviceDX
         uint64 TargetFrame;
     };
 
+    struct BindlessSlotEntry
+    {
+        int32 Index;
+        uint64 TargetFrame;
+    };
+
 private:
 
     // Private Stuff
@@ -53,6 +65,13 @@ class GPUDeviceDX12 : public GPUDeviceDX
     IDXGIFactory4* _factoryDXGI;
     CriticalSection _res2DisposeLock;
     Array<DisposeResourceEntry> _res2Dispose;
+    CriticalSection _bindlessLock;
+    Array<BindlessSlotEntry> _bindlessFree;
+    int32 _bindlessCount = 0;
+#if DX12_ENABLE_PIPELINE_LIBRARY
+    Array<byte> _pipelineLibraryData;
+    uint64 _driverVersion = 0;
+#endif
 
     // Pipeline
     ID3D12RootSignature* _rootSignature;
@@ -76,16 +95,35 @@ class GPUDeviceDX12 : public GPUDeviceDX
     /// </summary>
     UploadBufferDX12* UploadBuffer;
 
+    /// <summary>
+    /// Pooled heaps allocator for the placed buffers.
+    /// </summary>
+    HeapAllocatorDX12* BuffersAllocator;
+
     /// <summary>
     /// The timestamp queries heap.
     /// </summary>
     QueryHeapDX12 TimestampQueryHeap;
 
+    /// <summary>
+    /// The pipeline statistics queries heap.
+    /// </summary>
+    QueryHeapDX12 PipelineStatsQueryHeap;
+
     bool AllowTearing = false;
     CommandSignatureDX12* DispatchIndirectCommandSignature = nullptr;
     CommandSignatureDX12* DrawIndexedIndirectCommandSignature = nullptr;
     CommandSignatureDX12* DrawIndirectCommandSignature = nullptr;
 
+#if DX12_ENABLE_PIPELINE_LIBRARY
+    /// <summary>
+    /// The persistent pipeline states library (loaded from the cache file on startup and saved on exit). Null if not supported. Access to it has to be synchronized with PipelineLibraryLocker.
+    /// </summary>
+    ID3D12PipelineLibrary* PipelineLibrary = nullptr;
+    CriticalSection PipelineLibraryLocker;
+    bool PipelineLibraryDirty = false;
+#endif
+
     D3D12_CPU_DESCRIPTOR_HANDLE NullSRV(D3D12_SRV_DIMENSION dimension) const;
     D3D12_CPU_DESCRIPTOR_HANDLE NullUAV() const;
 
@@ -155,6 +193,12 @@ class GPUDeviceDX12 : public GPUDeviceDX
     // Add resource to late release service (will be released after 'safeFrameCount' frames)
     void AddResourceToLateRelease(IGraphicsUnknown* resource, uint32 safeFrameCount = DX12_RESOURCE_DELETE_SAFE_FRAMES_COUNT);
 
+    // Allocates the slot in the global bindless resources table (reserved range of the shader-visible heap) and copies the SRV descriptor into it. Returns -1 if not supported or table is full.
+    int32 AllocateBindless(D3D12_CPU_DESCRIPTOR_HANDLE srv);
+
+    // Frees the slot in the global bindless resources table (it gets reused after a few frames, once GPU is done with it).
+    void FreeBindless(int32 index);
+
     static FORCE_INLINE uint32 GetMaxMSAAQuality(uint32 sampleCount)
     {
         if (sampleCount <= 8)
@@ -173,6 +217,10 @@ class GPUDeviceDX12 : public GPUDeviceDX
     void updateFrameEvents();
 #endif
     void updateRes2Dispose();
+#if DX12_ENABLE_PIPELINE_LIBRARY
+    void LoadPipelineLibrary();
+    bool SavePipelineLibrary();
+#endif
 
 public:
 
@@ -198,6 +246,7 @@ class GPUDeviceDX12 : public GPUDeviceDX
     GPUSampler* CreateSampler() override;
     GPUSwapChain* CreateSwapChain(Window* window) override;
     GPUConstantBuffer* CreateConstantBuffer(uint32 size, const StringView& name) override;
+    GPUTasksExecutor* CreateTasksExecutor() override;
 };
 
 /// <summary>
@@ -8,6 +8,12 @@
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/GraphicsDevice/DirectX/RenderToolsDX.h"
 #include "Engine/Graphics/PixelFormatExtensions.h"
+#if DX12_ENABLE_PIPELINE_LIBRARY
+#include "Engine/Core/Types/String.h"
+#include "Engine/Platform/StringUtils.h"
+#include "Engine/Utilities/Crc.h"
+#include "Engine/Threading/Threading.h"
+#endif
 
 static D3D12_STENCIL_OP ToStencilOp(StencilOperation value)
 {
@@ -59,7 +65,27 @@ ID3D12PipelineState* GPUPipelineStateDX12::GetState(GPUTextureViewDX12* depth, i
         key.RTVsFormats[i] = rtHandles[i]->GetFormat();
     for (int32 i = rtCount; i < GPU_MAX_RT_BINDED; i++)
         key.RTVsFormats[i] = PixelFormat::Unknown;
+    return GetState(key);
+}
+
+void GPUPipelineStateDX12::Precompile(PixelFormat depthFormat, int32 rtCount, const PixelFormat* rtFormats, MSAALevel msaa)
+{
+    ASSERT(depthFormat != PixelFormat::Unknown || rtCount);
+    if (!IsValid())
+        return;
+    GPUPipelineStateKeyDX12 key;
+    key.RTsCount = rtCount;
+    key.DepthFormat = depthFormat;
+    key.MSAA = msaa;
+    for (int32 i = 0; i < rtCount; i++)
+        key.RTVsFormats[i] = rtFormats[i];
+    for (int32 i = rtCount; i < GPU_MAX_RT_BINDED; i++)
+        key.RTVsFormats[i] = PixelFormat::Unknown;
+    GetState(key);
+}
 
+ID3D12PipelineState* GPUPipelineStateDX12::GetState(const GPUPipelineStateKeyDX12& key)
+{
     // Try reuse cached version
     ID3D12PipelineState* state = nullptr;
     if (_states.TryGet(key, state))
@@ -84,11 +110,35 @@ ID3D12PipelineState* GPUPipelineStateDX12::GetState(GPUTextureViewDX12* depth, i
     _desc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
     _desc.DSVFormat = RenderToolsDX::ToDxgiFormat(PixelFormatExtensions::FindDepthStencilFormat(key.DepthFormat));
 
-    // Create object
-    const HRESULT result = _device->GetDevice()->CreateGraphicsPipelineState(&_desc, IID_PPV_ARGS(&state));
-    LOG_DIRECTX_RESULT(result);
-    if (FAILED(result))
-        return nullptr;
+#if DX12_ENABLE_PIPELINE_LIBRARY
+    // Try to load object from the persistent library
+    auto library = _device->PipelineLibrary;
+    String libraryName;
+    if (library)
+    {
+        libraryName = String::Format(TEXT("{0:x}-{1:x}"), _libraryHash, GetHash(key));
+        ScopeLock lock(_device->PipelineLibraryLocker);
+        if (FAILED(library->LoadGraphicsPipeline(*libraryName, &_desc, IID_PPV_ARGS(&state))))
+            state = nullptr;
+    }
+    if (!state)
+#endif
+    {
+        // Create object
+        const HRESULT result = _device->GetDevice()->CreateGraphicsPipelineState(&_desc, IID_PPV_ARGS(&state));
+        LOG_DIRECTX_RESULT(result);
+        if (FAILED(result))
+            return nullptr;
+#if DX12_ENABLE_PIPELINE_LIBRARY
+        if (library)
+        {
+            // Store object in the library to be reused on the next run
+            ScopeLock lock(_device->PipelineLibraryLocker);
+            if (SUCCEEDED(library->StorePipeline(*libraryName, state)))
+                _device->PipelineLibraryDirty = true;
+        }
+#endif
+    }
 #if GPU_ENABLE_RESOURCE_NAMING && BUILD_DEBUG
     Array<char, InlinedAllocation<200>> name;
     if (DebugDesc.VS)
@@ -253,6 +303,30 @@ bool GPUPipelineStateDX12::Init(const Description& desc)
 
     // Cache description
     _desc = psDesc;
+#if DX12_ENABLE_PIPELINE_LIBRARY
+    // Compute the stable identifier of the pipeline (used to store it in the library between runs)
+    uint32 hash = 0;
+#define HASH_SHADER_STAGE(stage) \
+    if (psDesc.stage.pShaderBytecode) \
+        hash = Crc::MemCrc32(psDesc.stage.pShaderBytecode, (int32)psDesc.stage.BytecodeLength, hash)
+    HASH_SHADER_STAGE(VS);
+    HASH_SHADER_STAGE(HS);
+    HASH_SHADER_STAGE(DS);
+    HASH_SHADER_STAGE(GS);
+    HASH_SHADER_STAGE(PS);
+#undef HASH_SHADER_STAGE
+    for (UINT i = 0; i < psDesc.InputLayout.NumElements; i++)
+    {
+        const D3D12_INPUT_ELEMENT_DESC& e = psDesc.InputLayout.pInputElementDescs[i];
+        hash = Crc::MemCrc32(e.SemanticName, StringUtils::Length(e.SemanticName), hash);
+        hash = Crc::MemCrc32(&e.SemanticIndex, sizeof(D3D12_INPUT_ELEMENT_DESC) - offsetof(D3D12_INPUT_ELEMENT_DESC, SemanticIndex), hash);
+    }
+    hash = Crc::MemCrc32(&psDesc.BlendState, sizeof(psDesc.BlendState), hash);
+    hash = Crc::MemCrc32(&psDesc.RasterizerState, sizeof(psDesc.RasterizerState), hash);
+    hash = Crc::MemCrc32(&psDesc.DepthStencilState, sizeof(psDesc.DepthStencilState), hash);
+    hash = Crc::MemCrc32(&psDesc.PrimitiveTopologyType, sizeof(psDesc.PrimitiveTopologyType), hash);
+    _libraryHash = hash;
+#endif
 
     // Set non-zero memory usage
     _memoryUsage = sizeof(D3D12_GRAPHICS_PIPELINE_STATE_DESC);
@@ -49,6 +49,9 @@ class GPUPipelineStateDX12 : public GPUResourceDX12<GPUPipelineState>
 
     Dictionary<GPUPipelineStateKeyDX12, ID3D12PipelineState*> _states;
     D3D12_GRAPHICS_PIPELINE_STATE_DESC _desc;
+#if DX12_ENABLE_PIPELINE_LIBRARY
+    uint32 _libraryHash = 0;
+#endif
 
 public:
 
@@ -68,11 +71,16 @@ class GPUPipelineStateDX12 : public GPUResourceDX12<GPUPipelineState>
     /// <returns>DirectX 12 graphics pipeline state object</returns>
     ID3D12PipelineState* GetState(GPUTextureViewDX12* depth, int32 rtCount, GPUTextureViewDX12** rtHandles);
 
+private:
+
+    ID3D12PipelineState* GetState(const GPUPipelineStateKeyDX12& key);
+
 public:
 
     // [GPUPipelineState]
     bool IsValid() const override;
     bool Init(const Description& desc) override;
+    void Precompile(PixelFormat depthFormat, int32 rtCount, const PixelFormat* rtFormats, MSAALevel msaa) override;
 
 protected:
 
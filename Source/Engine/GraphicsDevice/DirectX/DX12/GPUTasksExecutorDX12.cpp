@@ -0,0 +1,151 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#if GRAPHICS_API_DIRECTX12
+
+#include "GPUTasksExecutorDX12.h"
+#include "GPUDeviceDX12.h"
+#include "GPUContextDX12.h"
+#include "CommandQueueDX12.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Graphics/Async/GPUTask.h"
+#include "Engine/Graphics/Async/GPUTasksManager.h"
+
+GPUTasksExecutorDX12::GPUTasksExecutorDX12(GPUDeviceDX12* device)
+    : _device(device)
+{
+    _copyQueue = New<CommandQueueDX12>(device, D3D12_COMMAND_LIST_TYPE_COPY);
+    if (_copyQueue->Init())
+    {
+        LOG(Warning, "Failed to create copy queue for GPU tasks. Uploads will use the main context.");
+        Delete(_copyQueue);
+        _copyQueue = nullptr;
+        return;
+    }
+    _copyContext = New<GPUContextDX12>(device, _copyQueue);
+}
+
+GPUTasksExecutorDX12::~GPUTasksExecutorDX12()
+{
+    Task::CancelAll(_delayedTasks);
+    if (_copyQueue)
+    {
+        _copyQueue->WaitForGPU();
+        if (_copyTasksContext)
+            _copyTasksContext->GPU = nullptr;
+        Delete(_copyContext);
+        Delete(_copyQueue);
+    }
+}
+
+bool GPUTasksExecutorDX12::CanRunOnCopyQueue(GPUTask* task, ResourceOwnerDX12*& resource) const
+{
+    GPUResource* destination = task->GetCopyDestination();
+    resource = destination ? dynamic_cast<ResourceOwnerDX12*>(destination) : nullptr;
+    if (resource == nullptr || resource->GetResource() == nullptr)
+        return false;
+    if (_copyResources.Contains(resource))
+        return true;
+
+    // Copy queue can access only resources in a common state (not yet used by the graphics queue so there is no need to sync with the rendering)
+    const ResourceStateDX12& state = resource->State;
+    return state.AreAllSubresourcesSame() && state.GetSubresourceState(0) == D3D12_RESOURCE_STATE_COMMON;
+}
+
+bool GPUTasksExecutorDX12::UsesCopyResources(GPUTask* task) const
+{
+    for (ResourceOwnerDX12* resource : _copyResources)
+    {
+        if (task->HasReference(resource->AsGPUResource()))
+            return true;
+    }
+    return false;
+}
+
+String GPUTasksExecutorDX12::ToString() const
+{
+    return TEXT("DirectX 12 GPU Async Executor");
+}
+
+void GPUTasksExecutorDX12::FrameBegin()
+{
+    // Base
+    DefaultGPUTasksExecutor::FrameBegin();
+
+    if (_copyContext == nullptr)
+        return;
+    if (_copyTasksContext == nullptr)
+    {
+        _copyTasksContext = createContext();
+        _copyTasksContext->GPU = _copyContext;
+    }
+
+    // Make graphics queue wait for the copies submitted in the previous frame (uploaded resources can be used by the rendering from now on)
+    FenceDX12& fence = _copyQueue->GetFence();
+    if (_copyFenceValue != 0)
+    {
+        fence.WaitGPU(_device->GetCommandQueue(), _copyFenceValue);
+        _copyFenceValue = 0;
+    }
+
+    // Sync tasks which copies have been completed by the GPU
+    const uint64 signaledValue = fence.GetLastSignaledValue();
+    const uint64 completedValue = fence.IsFenceComplete(signaledValue) ? signaledValue : fence.GetLastCompletedValue();
+    _copyTasksContext->OnFrameBegin(fence.GetCurrentValue(), completedValue);
+}
+
+void GPUTasksExecutorDX12::FrameEnd()
+{
+    if (_copyTasksContext == nullptr)
+    {
+        DefaultGPUTasksExecutor::FrameEnd();
+        return;
+    }
+
+    // Run tasks that were delayed because they were using resources written by the copy queue in the previous frame
+    for (GPUTask* task : _delayedTasks)
+    {
+        if (task->IsQueued())
+            _context->Run(task);
+    }
+    _delayedTasks.Clear();
+
+    // Split tasks between the copy queue and the main context
+    GPUTask* buffer[32];
+    const int32 count = GPUDevice::Instance->GetTasksManager()->RequestWork(buffer, 32);
+    for (int32 i = 0; i < count; i++)
+    {
+        GPUTask* task = buffer[i];
+        ResourceOwnerDX12* resource;
+        if (CanRunOnCopyQueue(task, resource))
+        {
+            if (_copyResources.IsEmpty())
+                _copyContext->Reset();
+            _copyResources.AddUnique(resource);
+            _copyTasksContext->Run(task);
+        }
+        else if (UsesCopyResources(task))
+        {
+            // Resource will be accessed by the copy queue in this frame so run it in the next one
+            _delayedTasks.Add(task);
+        }
+        else
+        {
+            _context->Run(task);
+        }
+    }
+
+    _context->OnFrameEnd();
+
+    // Submit copies without waiting on the rendering (graphics queue waits for them on the next frame begin)
+    if (_copyResources.HasItems())
+    {
+        _copyFenceValue = _copyContext->Execute(false);
+
+        // Resources used on a copy queue decay to the common state after the execution
+        for (ResourceOwnerDX12* resource : _copyResources)
+            resource->State.SetResourceState(D3D12_RESOURCE_STATE_COMMON);
+        _copyResources.Clear();
+    }
+}
+
+#endif
@@ -0,0 +1,55 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#if GRAPHICS_API_DIRECTX12
+
+#include "Engine/Graphics/Async/DefaultGPUTasksExecutor.h"
+
+class GPUDeviceDX12;
+class GPUContextDX12;
+class CommandQueueDX12;
+class ResourceOwnerDX12;
+
+/// <summary>
+/// GPU tasks executor for DirectX 12 backend. Runs the data uploads to the idle resources on a dedicated copy queue so they can execute on GPU concurrently with the frame rendering.
+/// </summary>
+class GPUTasksExecutorDX12 : public DefaultGPUTasksExecutor
+{
+private:
+
+    GPUDeviceDX12* _device;
+    CommandQueueDX12* _copyQueue = nullptr;
+    GPUContextDX12* _copyContext = nullptr;
+    GPUTasksContext* _copyTasksContext = nullptr;
+    uint64 _copyFenceValue = 0;
+    Array<ResourceOwnerDX12*> _copyResources;
+    Array<GPUTask*> _delayedTasks;
+
+public:
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="GPUTasksExecutorDX12"/> class.
+    /// </summary>
+    /// <param name="device">The graphics device.</param>
+    GPUTasksExecutorDX12(GPUDeviceDX12* device);
+
+    /// <summary>
+    /// Finalizes an instance of the <see cref="GPUTasksExecutorDX12"/> class.
+    /// </summary>
+    ~GPUTasksExecutorDX12();
+
+private:
+
+    bool CanRunOnCopyQueue(GPUTask* task, ResourceOwnerDX12*& resource) const;
+    bool UsesCopyResources(GPUTask* task) const;
+
+public:
+
+    // [DefaultGPUTasksExecutor]
+    String ToString() const override;
+    void FrameBegin() override;
+    void FrameEnd() override;
+};
+
+#endif
@@ -133,7 +133,7 @@ bool GPUTextureDX12::OnInit()
     resourceDesc.SampleDesc.Count = static_cast<UINT>(_desc.MultiSampleLevel);
     resourceDesc.SampleDesc.Quality = IsMultiSample() ? GPUDeviceDX12::GetMaxMSAAQuality((int32)_desc.MultiSampleLevel) : 0;
     resourceDesc.Alignment = 0;
-    resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+    resourceDesc.Layout = IsSparse() ? D3D12_TEXTURE_LAYOUT_64KB_UNDEFINED_SWIZZLE : D3D12_TEXTURE_LAYOUT_UNKNOWN;
     resourceDesc.Dimension = IsVolume() ? D3D12_RESOURCE_DIMENSION_TEXTURE3D : D3D12_RESOURCE_DIMENSION_TEXTURE2D;
     if (useRTV)
     {
@@ -182,8 +182,12 @@ bool GPUTextureDX12::OnInit()
     if (IsRegularTexture())
         initialState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
 
-    // Create texture
-    auto result = device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, initialState, clearValuePtr, IID_PPV_ARGS(&resource));
+    // Create texture (sparse textures have no memory backing until tiles get mapped)
+    HRESULT result;
+    if (IsSparse())
+        result = device->CreateReservedResource(&resourceDesc, initialState, clearValuePtr, IID_PPV_ARGS(&resource));
+    else
+        result = device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, initialState, clearValuePtr, IID_PPV_ARGS(&resource));
     LOG_DIRECTX_RESULT_WITH_RETURN(result, true);
 
     // Set state
@@ -191,7 +195,15 @@ bool GPUTextureDX12::OnInit()
     bool isWrite = useDSV || useRTV || useUAV;
     initResource(resource, initialState, resourceDesc, isRead && isWrite);
     DX_SET_DEBUG_NAME(_resource, GetName());
-    _memoryUsage = calculateMemoryUsage();
+    if (IsSparse())
+    {
+        if (initSparse())
+            return true;
+    }
+    else
+    {
+        _memoryUsage = calculateMemoryUsage();
+    }
 
     // Initialize handles to the resource
     if (IsRegularTexture())
@@ -244,6 +256,101 @@ void GPUTextureDX12::OnResidentMipsChanged()
         view.SetSRV(srDesc);
 }
 
+bool GPUTextureDX12::OnCommitMips(int32 count)
+{
+    GPUDeviceLock lock(_device);
+    const int32 mipLevels = MipLevels();
+    const int32 standardMips = mipLevels - _sparsePackedMips;
+    bool failed = false;
+    for (int32 mipIndex = 0; mipIndex < standardMips; mipIndex++)
+    {
+        const bool commit = mipIndex >= mipLevels - count;
+        if (commit != (_sparseMips[mipIndex].Heap != nullptr))
+            failed |= commitSparseMip(mipIndex, commit);
+    }
+    int32 committedMips = _sparsePackedMips;
+    while (committedMips < mipLevels && _sparseMips[mipLevels - committedMips - 1].Heap)
+        committedMips++;
+    _committedMipLevels = committedMips;
+    return failed;
+}
+
+bool GPUTextureDX12::initSparse()
+{
+    // Query the texture tiling layout
+    UINT tilesCount = 0;
+    D3D12_PACKED_MIP_INFO packedMipInfo;
+    D3D12_TILE_SHAPE tileShape;
+    UINT subresourcesCount = MipLevels();
+    D3D12_SUBRESOURCE_TILING tilings[GPU_MAX_TEXTURE_MIP_LEVELS];
+    _device->GetDevice()->GetResourceTiling(_resource, &tilesCount, &packedMipInfo, &tileShape, &subresourcesCount, 0, tilings);
+    _sparsePackedMips = packedMipInfo.NumPackedMips;
+    _sparseMips.Resize(packedMipInfo.NumStandardMips + 1);
+    for (int32 mipIndex = 0; mipIndex < (int32)packedMipInfo.NumStandardMips; mipIndex++)
+    {
+        const D3D12_SUBRESOURCE_TILING& tiling = tilings[mipIndex];
+        _sparseMips[mipIndex] = { nullptr, tiling.WidthInTiles * tiling.HeightInTiles * tiling.DepthInTiles };
+    }
+    _sparseMips.Last() = { nullptr, packedMipInfo.NumTilesForPackedMips };
+    _memoryUsage = 0;
+
+    // Packed mips tail cannot be mapped partially so keep it always committed
+    _committedMipLevels = _sparsePackedMips;
+    if (_sparsePackedMips != 0)
+        return commitSparseMip(_sparseMips.Count() - 1, true);
+    return false;
+}
+
+bool GPUTextureDX12::commitSparseMip(int32 index, bool commit)
+{
+    SparseMip& mip = _sparseMips[index];
+    if (mip.TilesCount == 0)
+        return false;
+    const bool isPacked = index == _sparseMips.Count() - 1;
+    D3D12_TILED_RESOURCE_COORDINATE coordinate;
+    coordinate.X = 0;
+    coordinate.Y = 0;
+    coordinate.Z = 0;
+    coordinate.Subresource = index; // Packed mips use the first packed subresource with tile offset in X
+    D3D12_TILE_REGION_SIZE regionSize;
+    regionSize.NumTiles = mip.TilesCount;
+    regionSize.UseBox = FALSE;
+    regionSize.Width = regionSize.NumTiles;
+    regionSize.Height = 1;
+    regionSize.Depth = 1;
+    const UINT heapOffset = 0;
+    const UINT tilesCount = mip.TilesCount;
+    ID3D12CommandQueue* queue = _device->GetCommandQueueDX12();
+    if (commit)
+    {
+        // Allocate memory for the mip tiles
+        D3D12_HEAP_DESC heapDesc;
+        heapDesc.SizeInBytes = (UINT64)mip.TilesCount * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+        heapDesc.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+        heapDesc.Properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        heapDesc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+        heapDesc.Properties.CreationNodeMask = 1;
+        heapDesc.Properties.VisibleNodeMask = 1;
+        heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+        heapDesc.Flags = D3D12_HEAP_FLAG_DENY_BUFFERS | D3D12_HEAP_FLAG_DENY_RT_DS_TEXTURES;
+        const HRESULT result = _device->GetDevice()->CreateHeap(&heapDesc, IID_PPV_ARGS(&mip.Heap));
+        LOG_DIRECTX_RESULT_WITH_RETURN(result, true);
+        const D3D12_TILE_RANGE_FLAGS rangeFlags = D3D12_TILE_RANGE_FLAG_NONE;
+        queue->UpdateTileMappings(_resource, 1, &coordinate, &regionSize, mip.Heap, 1, &rangeFlags, &heapOffset, &tilesCount, D3D12_TILE_MAPPING_FLAG_NONE);
+        _memoryUsage += heapDesc.SizeInBytes;
+    }
+    else if (!isPacked)
+    {
+        // Unmap tiles and release memory once GPU is done with it
+        const D3D12_TILE_RANGE_FLAGS rangeFlags = D3D12_TILE_RANGE_FLAG_NULL;
+        queue->UpdateTileMappings(_resource, 1, &coordinate, &regionSize, nullptr, 1, &rangeFlags, &heapOffset, &tilesCount, D3D12_TILE_MAPPING_FLAG_NONE);
+        _device->AddResourceToLateRelease(mip.Heap);
+        mip.Heap = nullptr;
+        _memoryUsage -= (uint64)mip.TilesCount * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+    }
+    return false;
+}
+
 void GPUTextureDX12::OnReleaseGPU()
 {
     _handlesPerMip.Resize(0, false);
@@ -253,6 +360,13 @@ void GPUTextureDX12::OnReleaseGPU()
     _srv.Release();
     _uav.Release();
     releaseResource();
+    for (SparseMip& mip : _sparseMips)
+    {
+        if (mip.Heap)
+            _device->AddResourceToLateRelease(mip.Heap);
+    }
+    _sparseMips.Clear();
+    _sparsePackedMips = 0;
 
     // Base
     GPUTexture::OnReleaseGPU();
@@ -260,6 +374,11 @@ void GPUTextureDX12::OnReleaseGPU()
 
 void GPUTextureViewDX12::Release()
 {
+    if (_bindless != -1)
+    {
+        _device->FreeBindless(_bindless);
+        _bindless = -1;
+    }
     _rtv.Release();
     _srv.Release();
     _dsv.Release();
@@ -275,6 +394,8 @@ void GPUTextureViewDX12::SetSRV(D3D12_SHADER_RESOURCE_VIEW_DESC& srvDesc)
 {
     SrvDimension = srvDesc.ViewDimension;
     _srv.CreateSRV(_device, _owner->GetResource(), &srvDesc);
+    _device->FreeBindless(_bindless);
+    _bindless = _device->AllocateBindless(_srv.CPU());
 }
 
 void GPUTextureViewDX12::SetDSV(D3D12_DEPTH_STENCIL_VIEW_DESC& dsvDesc)
@@ -19,6 +19,7 @@ class GPUTextureViewDX12 : public GPUTextureView, public IShaderResourceDX12
     GPUDeviceDX12* _device = nullptr;
     ResourceOwnerDX12* _owner = nullptr;
     DescriptorHeapWithSlotsDX12::Slot _rtv, _srv, _dsv, _uav;
+    int32 _bindless = -1;
 
 public:
 
@@ -104,6 +105,10 @@ class GPUTextureViewDX12 : public GPUTextureView, public IShaderResourceDX12
     {
         return (void*)(IShaderResourceDX12*)this;
     }
+    int32 GetBindlessIndex() const override
+    {
+        return _bindless;
+    }
 
     // [IShaderResourceDX12]
     bool IsDepthStencilResource() const override
@@ -145,6 +150,16 @@ class GPUTextureDX12 : public GPUResourceDX12<GPUTexture>, public ResourceOwnerD
     DXGI_FORMAT _dxgiFormatRTV;
     DXGI_FORMAT _dxgiFormatUAV;
 
+    struct SparseMip
+    {
+        ID3D12Heap* Heap;
+        uint32 TilesCount;
+    };
+
+    // Sparse texture tiles mapping per standard mip (the last entry is for packed mips tail)
+    Array<SparseMip, FixedAllocation<GPU_MAX_TEXTURE_MIP_LEVELS + 1>> _sparseMips;
+    int32 _sparsePackedMips = 0;
+
 public:
 
     GPUTextureDX12(GPUDeviceDX12* device, const StringView& name)
@@ -155,6 +170,8 @@ class GPUTextureDX12 : public GPUResourceDX12<GPUTexture>, public ResourceOwnerD
 private:
 
     void initHandles();
+    bool initSparse();
+    bool commitSparseMip(int32 index, bool commit);
 
 public:
 
@@ -217,6 +234,7 @@ class GPUTextureDX12 : public GPUResourceDX12<GPUTexture>, public ResourceOwnerD
     // [GPUTexture]
     bool OnInit() override;
     void OnResidentMipsChanged() override;
+    bool OnCommitMips(int32 count) override;
     void OnReleaseGPU() override;
 };
 
@@ -14,6 +14,7 @@ void GPUTimerQueryDX12::OnReleaseGPU()
 {
     _hasResult = false;
     _endCalled = false;
+    _statsActive = false;
     _timeDelta = 0.0f;
 }
 
@@ -22,6 +23,9 @@ void GPUTimerQueryDX12::Begin()
     const auto context = _device->GetMainContextDX12();
     auto& heap = _device->TimestampQueryHeap;
     heap.EndQuery(context, _begin);
+    _statsActive = CollectPipelineStatistics;
+    if (_statsActive)
+        _device->PipelineStatsQueryHeap.BeginQuery(context, _stats);
 
     _hasResult = false;
     _endCalled = false;
@@ -34,6 +38,8 @@ void GPUTimerQueryDX12::End()
 
     const auto context = _device->GetMainContextDX12();
     auto& heap = _device->TimestampQueryHeap;
+    if (_statsActive)
+        _device->PipelineStatsQueryHeap.EndActiveQuery(context, _stats);
     heap.EndQuery(context, _end);
 
     const auto queue = _device->GetCommandQueue()->GetCommandQueue();
@@ -50,7 +56,7 @@ bool GPUTimerQueryDX12::HasResult()
         return true;
 
     auto& heap = _device->TimestampQueryHeap;
-    return heap.IsReady(_end) && heap.IsReady(_begin);
+    return heap.IsReady(_end) && heap.IsReady(_begin) && (!_statsActive || _device->PipelineStatsQueryHeap.IsReady(_stats));
 }
 
 float GPUTimerQueryDX12::GetResult()
@@ -79,4 +85,18 @@ float GPUTimerQueryDX12::GetResult()
     return _timeDelta;
 }
 
+bool GPUTimerQueryDX12::GetPipelineStatistics(GPUPipelineStatistics& result)
+{
+    if (!_statsActive || !_endCalled)
+        return false;
+    const auto& data = *(D3D12_QUERY_DATA_PIPELINE_STATISTICS*)_device->PipelineStatsQueryHeap.ResolveQuery(_stats);
+    result.InputVertices = data.IAVertices;
+    result.InputPrimitives = data.IAPrimitives;
+    result.VertexShaderInvocations = data.VSInvocations;
+    result.RasterizedPrimitives = data.CPrimitives;
+    result.PixelShaderInvocations = data.PSInvocations;
+    result.ComputeShaderInvocations = data.CSInvocations;
+    return true;
+}
+
 #endif
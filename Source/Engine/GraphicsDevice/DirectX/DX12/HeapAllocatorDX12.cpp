@@ -0,0 +1,158 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#if GRAPHICS_API_DIRECTX12
+
+#include "HeapAllocatorDX12.h"
+#include "GPUDeviceDX12.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+
+HeapAllocatorDX12::HeapAllocatorDX12(GPUDeviceDX12* device)
+    : _device(device)
+{
+}
+
+HeapAllocatorDX12::~HeapAllocatorDX12()
+{
+    Update(MAX_uint64);
+    for (Page* page : _pages)
+    {
+        if (page->Used != 0)
+        {
+            LOG(Warning, "Releasing DirectX 12 heap page with {0} bytes still in use.", page->Used);
+        }
+        page->Heap->Release();
+        Delete(page);
+    }
+    _pages.Clear();
+}
+
+bool HeapAllocatorDX12::Allocate(uint64 size, Allocation& result)
+{
+    size = Math::AlignUp<uint64>(size, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+    if (size == 0 || size > DX12_HEAP_ALLOCATOR_MAX_SIZE)
+        return true;
+    ScopeLock lock(_locker);
+
+    // Find the first free range that fits (keeps allocations packed at the start of the pages)
+    for (Page* page : _pages)
+    {
+        for (int32 i = 0; i < page->FreeRanges.Count(); i++)
+        {
+            Range& range = page->FreeRanges[i];
+            if (range.Size >= size)
+            {
+                result.Owner = page;
+                result.Offset = range.Offset;
+                result.Size = size;
+                range.Offset += size;
+                range.Size -= size;
+                if (range.Size == 0)
+                    page->FreeRanges.RemoveAtKeepOrder(i);
+                page->Used += size;
+                page->LastUsedFrame = Engine::FrameCount;
+                return false;
+            }
+        }
+    }
+
+    // Create a new page
+    PROFILE_CPU_NAMED("Create Heap Page");
+    D3D12_HEAP_DESC heapDesc;
+    heapDesc.SizeInBytes = DX12_HEAP_ALLOCATOR_PAGE_SIZE;
+    heapDesc.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+    heapDesc.Properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    heapDesc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    heapDesc.Properties.CreationNodeMask = 1;
+    heapDesc.Properties.VisibleNodeMask = 1;
+    heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+    ID3D12Heap* heap = nullptr;
+    const HRESULT hr = _device->GetDevice()->CreateHeap(&heapDesc, IID_PPV_ARGS(&heap));
+    if (FAILED(hr))
+    {
+        LOG_DIRECTX_RESULT(hr);
+        return true;
+    }
+#if GPU_ENABLE_RESOURCE_NAMING
+    heap->SetName(TEXT("HeapAllocatorDX12::Page"));
+#endif
+    Page* page = New<Page>();
+    page->Heap = heap;
+    page->Used = size;
+    page->LastUsedFrame = Engine::FrameCount;
+    page->FreeRanges.Add({ size, DX12_HEAP_ALLOCATOR_PAGE_SIZE - size });
+    _pages.Add(page);
+    result.Owner = page;
+    result.Offset = 0;
+    result.Size = size;
+    return false;
+}
+
+void HeapAllocatorDX12::Free(Allocation& allocation, uint32 safeFrameCount)
+{
+    if (!allocation.IsValid())
+        return;
+    ScopeLock lock(_locker);
+    _pendingFrees.Add({ allocation, Engine::FrameCount + safeFrameCount });
+    allocation = Allocation();
+}
+
+void HeapAllocatorDX12::Update(uint64 currentFrame)
+{
+    ScopeLock lock(_locker);
+
+    // Return memory of the released resources
+    for (int32 i = _pendingFrees.Count() - 1; i >= 0; i--)
+    {
+        const PendingFree& e = _pendingFrees[i];
+        if (e.TargetFrame <= currentFrame)
+        {
+            FreeNow(e.Alloc);
+            _pendingFrees.RemoveAt(i);
+        }
+    }
+
+    // Release unused pages (keep a single page to prevent heaps recreation)
+    if (currentFrame == MAX_uint64)
+        return;
+    for (int32 i = _pages.Count() - 1; i >= 0 && _pages.Count() > 1; i--)
+    {
+        Page* page = _pages[i];
+        if (page->Used == 0 && page->LastUsedFrame + DX12_HEAP_ALLOCATOR_PAGE_NOT_USED_FRAME_TIMEOUT < currentFrame)
+        {
+            page->Heap->Release();
+            Delete(page);
+            _pages.RemoveAtKeepOrder(i);
+        }
+    }
+}
+
+void HeapAllocatorDX12::FreeNow(const Allocation& allocation)
+{
+    Page* page = allocation.Owner;
+    ASSERT(page && page->Used >= allocation.Size);
+    page->Used -= allocation.Size;
+    page->LastUsedFrame = Engine::FrameCount;
+
+    // Insert the free range (sorted by offset) and merge with the neighbours
+    auto& ranges = page->FreeRanges;
+    int32 index = 0;
+    while (index < ranges.Count() && ranges[index].Offset < allocation.Offset)
+        index++;
+    ranges.Insert(index, { allocation.Offset, allocation.Size });
+    if (index + 1 < ranges.Count() && ranges[index].Offset + ranges[index].Size == ranges[index + 1].Offset)
+    {
+        ranges[index].Size += ranges[index + 1].Size;
+        ranges.RemoveAtKeepOrder(index + 1);
+    }
+    if (index > 0 && ranges[index - 1].Offset + ranges[index - 1].Size == ranges[index].Offset)
+    {
+        ranges[index - 1].Size += ranges[index].Size;
+        ranges.RemoveAtKeepOrder(index);
+    }
+}
+
+#endif
@@ -0,0 +1,114 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Platform/CriticalSection.h"
+#include "../IncludeDirectXHeaders.h"
+
+#if GRAPHICS_API_DIRECTX12
+
+// Size of the single memory heap page used for the placed buffers
+#define DX12_HEAP_ALLOCATOR_PAGE_SIZE (32 * 1024 * 1024) // 32 MB
+
+// Maximum size of the buffer allocated from the pooled heaps (larger ones use committed resources)
+#define DX12_HEAP_ALLOCATOR_MAX_SIZE (4 * 1024 * 1024) // 4 MB
+
+// Empty heap pages that are not used for a few frames are released (except the last one)
+#define DX12_HEAP_ALLOCATOR_PAGE_NOT_USED_FRAME_TIMEOUT 60
+
+class GPUDeviceDX12;
+
+/// <summary>
+/// Sub-allocator of the GPU memory for the placed buffer resources. Uses pooled heaps instead of the implicit heap per committed resource to reduce the allocation and residency overhead of many small buffers.
+/// </summary>
+class HeapAllocatorDX12
+{
+public:
+
+    struct Page;
+
+    /// <summary>
+    /// The memory allocation within the heap page.
+    /// </summary>
+    struct Allocation
+    {
+        Page* Owner = nullptr;
+        uint64 Offset = 0;
+        uint64 Size = 0;
+
+        FORCE_INLINE bool IsValid() const
+        {
+            return Owner != nullptr;
+        }
+    };
+
+    struct Range
+    {
+        uint64 Offset;
+        uint64 Size;
+    };
+
+    struct Page
+    {
+        ID3D12Heap* Heap;
+        uint64 Used;
+        uint64 LastUsedFrame;
+        Array<Range> FreeRanges;
+    };
+
+private:
+
+    struct PendingFree
+    {
+        Allocation Alloc;
+        uint64 TargetFrame;
+    };
+
+    GPUDeviceDX12* _device;
+    CriticalSection _locker;
+    Array<Page*> _pages;
+    Array<PendingFree> _pendingFrees;
+
+public:
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="HeapAllocatorDX12"/> class.
+    /// </summary>
+    /// <param name="device">The graphics device.</param>
+    HeapAllocatorDX12(GPUDeviceDX12* device);
+
+    /// <summary>
+    /// Finalizes an instance of the <see cref="HeapAllocatorDX12"/> class.
+    /// </summary>
+    ~HeapAllocatorDX12();
+
+public:
+
+    /// <summary>
+    /// Allocates the memory for the placed buffer.
+    /// </summary>
+    /// <param name="size">The buffer size (in bytes).</param>
+    /// <param name="result">The result allocation.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    bool Allocate(uint64 size, Allocation& result);
+
+    /// <summary>
+    /// Frees the allocated memory. Memory is reused after a given amount of frames to ensure that GPU is not using the old resource anymore.
+    /// </summary>
+    /// <param name="allocation">The allocation.</param>
+    /// <param name="safeFrameCount">The amount of frames after which memory can be reused.</param>
+    void Free(Allocation& allocation, uint32 safeFrameCount);
+
+    /// <summary>
+    /// Updates the pending frees and releases unused heap pages.
+    /// </summary>
+    /// <param name="currentFrame">The current frame number (use MAX_uint64 to release all pending allocations).</param>
+    void Update(uint64 currentFrame);
+
+private:
+
+    void FreeNow(const Allocation& allocation);
+};
+
+#endif
@@ -164,6 +164,13 @@ class QueryHeapDX12
     /// <param name="handle">The query handle.</param>
     void EndQuery(GPUContextDX12* context, ElementHandle& handle);
 
+    /// <summary>
+    /// Calls EndQuery on command list for the query heap slot started with BeginQuery (range queries such as pipeline statistics use the same slot for begin and end).
+    /// </summary>
+    /// <param name="context">The context.</param>
+    /// <param name="handle">The query handle returned by BeginQuery.</param>
+    void EndActiveQuery(GPUContextDX12* context, ElementHandle handle);
+
     /// <summary>
     /// Determines whether the specified query handle is ready to read data (command list has been executed by the GPU).
     /// </summary>
@@ -97,6 +97,9 @@ class GPUDeviceDX : public GPUDevice
 protected:
 
     GPUAdapterDX* _adapter;
+#if PLATFORM_WINDOWS
+    ComPtr<IDXGIAdapter3> _adapterMemoryInfo;
+#endif
 
 protected:
 
@@ -124,6 +127,14 @@ class GPUDeviceDX : public GPUDevice
 
 protected:
 
+    void InitMemoryBudget(IDXGIAdapter* adapter)
+    {
+#if PLATFORM_WINDOWS
+        // Video memory budget query requires DXGI 1.4 (Windows 10)
+        adapter->QueryInterface(IID_PPV_ARGS(&_adapterMemoryInfo));
+#endif
+    }
+
     void UpdateOutputs(IDXGIAdapter* adapter)
     {
 #if PLATFORM_WINDOWS
@@ -261,6 +272,16 @@ class GPUDeviceDX : public GPUDevice
     {
         return _adapter;
     }
+    uint64 GetMemoryBudget() const override
+    {
+#if PLATFORM_WINDOWS
+        // Query the OS-provided video memory budget for the local (dedicated) segment
+        DXGI_QUERY_VIDEO_MEMORY_INFO info;
+        if (_adapterMemoryInfo && SUCCEEDED(_adapterMemoryInfo->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &info)) && info.Budget != 0)
+            return info.Budget;
+#endif
+        return GPUDevice::GetMemoryBudget();
+    }
 
 protected:
 
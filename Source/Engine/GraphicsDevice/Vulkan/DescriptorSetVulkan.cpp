@@ -207,6 +207,25 @@ bool TypedDescriptorPoolSetVulkan::AllocateDescriptorSets(const DescriptorSetLay
     return true;
 }
 
+bool TypedDescriptorPoolSetVulkan::TryGetCachedSets(uint32 hash, const Array<byte>& key, VkDescriptorSet* outSets, int32 count) const
+{
+    const CachedSets* cached = _cachedSets.TryGet(hash);
+    if (cached && cached->Key == key)
+    {
+        Platform::MemoryCopy(outSets, cached->Sets, count * sizeof(VkDescriptorSet));
+        return true;
+    }
+    return false;
+}
+
+void TypedDescriptorPoolSetVulkan::AddCachedSets(uint32 hash, const Array<byte>& key, const VkDescriptorSet* sets, int32 count)
+{
+    ASSERT(count <= DescriptorSet::Max);
+    CachedSets& cached = _cachedSets[hash];
+    cached.Key = key;
+    Platform::MemoryCopy(cached.Sets, sets, count * sizeof(VkDescriptorSet));
+}
+
 DescriptorPoolVulkan* TypedDescriptorPoolSetVulkan::GetFreePool(bool forceNewPool)
 {
     if (!forceNewPool)
@@ -243,6 +262,7 @@ void TypedDescriptorPoolSetVulkan::Reset()
         pool->Element->Reset();
     }
     _poolListCurrent = _poolListHead;
+    _cachedSets.Clear();
 }
 
 DescriptorPoolSetContainerVulkan::DescriptorPoolSetContainerVulkan(GPUDeviceVulkan* device)
@@ -394,4 +414,21 @@ uint32 DescriptorSetWriterVulkan::SetupDescriptorWrites(const SpirvShaderDescrip
     return dynamicOffsetIndex;
 }
 
+void DescriptorSetWriterVulkan::WriteCacheKey(Array<byte>& key, uint32 setIndex) const
+{
+    key.Add((const byte*)&setIndex, sizeof(setIndex));
+    for (uint32 i = 0; i < WritesCount; i++)
+    {
+        const VkWriteDescriptorSet& write = WriteDescriptors[i];
+        key.Add((const byte*)&write.dstBinding, sizeof(write.dstBinding));
+        key.Add((const byte*)&write.descriptorType, sizeof(write.descriptorType));
+        if (write.pImageInfo)
+            key.Add((const byte*)write.pImageInfo, write.descriptorCount * sizeof(VkDescriptorImageInfo));
+        else if (write.pBufferInfo)
+            key.Add((const byte*)write.pBufferInfo, write.descriptorCount * sizeof(VkDescriptorBufferInfo));
+        else if (write.pTexelBufferView)
+            key.Add((const byte*)write.pTexelBufferView, write.descriptorCount * sizeof(VkBufferView));
+    }
+}
+
 #endif
@@ -183,6 +183,15 @@ class TypedDescriptorPoolSetVulkan
     PoolList* _poolListHead = nullptr;
     PoolList* _poolListCurrent = nullptr;
 
+    struct CachedSets
+    {
+        Array<byte> Key;
+        VkDescriptorSet Sets[DescriptorSet::Max];
+    };
+
+    // Already written descriptor sets (by contents hash) reused until pools reset
+    Dictionary<uint32, CachedSets> _cachedSets;
+
 public:
     TypedDescriptorPoolSetVulkan(GPUDeviceVulkan* device, const DescriptorPoolSetContainerVulkan* owner, const DescriptorSetLayoutVulkan& layout)
         : _device(device)
@@ -196,6 +205,25 @@ class TypedDescriptorPoolSetVulkan
 
     bool AllocateDescriptorSets(const DescriptorSetLayoutVulkan& layout, VkDescriptorSet* outSets);
 
+    /// <summary>
+    /// Tries to find the descriptor sets allocated and written before with the same contents.
+    /// </summary>
+    /// <param name="hash">The descriptor sets contents hash.</param>
+    /// <param name="key">The descriptor sets contents key (see DescriptorSetWriterVulkan::WriteCacheKey).</param>
+    /// <param name="outSets">The output descriptor sets.</param>
+    /// <param name="count">The amount of the descriptor sets.</param>
+    /// <returns>True if found cached sets, otherwise false.</returns>
+    bool TryGetCachedSets(uint32 hash, const Array<byte>& key, VkDescriptorSet* outSets, int32 count) const;
+
+    /// <summary>
+    /// Caches the written descriptor sets for reuse by the draws with the same descriptors.
+    /// </summary>
+    /// <param name="hash">The descriptor sets contents hash.</param>
+    /// <param name="key">The descriptor sets contents key (see DescriptorSetWriterVulkan::WriteCacheKey).</param>
+    /// <param name="sets">The descriptor sets.</param>
+    /// <param name="count">The amount of the descriptor sets.</param>
+    void AddCachedSets(uint32 hash, const Array<byte>& key, const VkDescriptorSet* sets, int32 count);
+
     const DescriptorPoolSetContainerVulkan* GetOwner() const
     {
         return _owner;
@@ -281,6 +309,13 @@ class DescriptorSetWriterVulkan
 public:
     uint32 SetupDescriptorWrites(const SpirvShaderDescriptorInfo& info, VkWriteDescriptorSet* writeDescriptors, VkDescriptorImageInfo* imageInfo, VkDescriptorBufferInfo* bufferInfo, VkBufferView* texelBufferView, byte* bindingToDynamicOffset);
 
+    /// <summary>
+    /// Appends the current descriptors contents to the key used to find the identical descriptor sets written before.
+    /// </summary>
+    /// <param name="key">The output key data.</param>
+    /// <param name="setIndex">The descriptor set index.</param>
+    void WriteCacheKey(Array<byte>& key, uint32 setIndex) const;
+
     bool WriteUniformBuffer(uint32 descriptorIndex, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range, uint32 index = 0) const
     {
         ASSERT(descriptorIndex < WritesCount);
@@ -12,6 +12,7 @@
 #include "GPUSamplerVulkan.h"
 #include "GPUPipelineStateVulkan.h"
 #include "Engine/Profiler/RenderStats.h"
+#include "Engine/Utilities/Crc.h"
 #include "GPUShaderProgramVulkan.h"
 #include "GPUTextureVulkan.h"
 #include "Engine/Graphics/PixelFormatExtensions.h"
@@ -592,9 +593,16 @@ void GPUContextVulkan::UpdateDescriptorSets(ComputePipelineStateVulkan* pipeline
     // Update descriptors
     UpdateDescriptorSets(*pipelineState->DescriptorInfo, pipelineState->DSWriter, needsWrite);
 
-    // Allocate sets if need to
-    //if (needsWrite) // TODO: write on change only?f
+    // Allocate sets if need to (otherwise reuse the current ones)
+    if (needsWrite)
     {
+        // Reuse the sets written before with the same descriptors
+        _descriptorSetsKey.Clear();
+        pipelineState->DSWriter.WriteCacheKey(_descriptorSetsKey, DescriptorSet::Compute);
+        const uint32 hash = Crc::MemCrc32(_descriptorSetsKey.Get(), _descriptorSetsKey.Count());
+        if (pipelineState->CurrentTypedDescriptorPoolSet->TryGetCachedSets(hash, _descriptorSetsKey, pipelineState->DescriptorSetHandles.Get(), pipelineState->DescriptorSetHandles.Count()))
+            return;
+
         if (!pipelineState->AllocateDescriptorSets())
         {
             return;
@@ -603,6 +611,19 @@ void GPUContextVulkan::UpdateDescriptorSets(ComputePipelineStateVulkan* pipeline
         pipelineState->DSWriter.SetDescriptorSet(descriptorSet);
 
         vkUpdateDescriptorSets(_device->Device, pipelineState->DSWriteContainer.DescriptorWrites.Count(), pipelineState->DSWriteContainer.DescriptorWrites.Get(), 0, nullptr);
+        pipelineState->CurrentTypedDescriptorPoolSet->AddCachedSets(hash, _descriptorSetsKey, pipelineState->DescriptorSetHandles.Get(), pipelineState->DescriptorSetHandles.Count());
+    }
+}
+
+void GPUContextVulkan::ValidateInputAssemblyCache(const CmdBufferVulkan* cmdBuffer)
+{
+    // Bindings don't persist between command buffers (or its recordings)
+    if (_iaCmdBuffer != cmdBuffer || _iaCmdBufferFenceCounter != cmdBuffer->GetSubmittedFenceCounter())
+    {
+        _iaCmdBuffer = cmdBuffer;
+        _iaCmdBufferFenceCounter = cmdBuffer->GetSubmittedFenceCounter();
+        Platform::MemoryClear(_vbHandles, sizeof(_vbHandles));
+        _ibHandle = VK_NULL_HANDLE;
     }
 }
 
@@ -630,22 +651,39 @@ void GPUContextVulkan::OnDrawCall()
             remainingHasDescriptorsPerStageMask >>= 1;
         }
 
-        // Allocate sets if need to
-        //if (needsWrite) // TODO: write on change only?
+        // Allocate sets if need to (otherwise reuse the current ones)
+        if (needsWrite)
         {
-            if (!pipelineState->CurrentTypedDescriptorPoolSet->AllocateDescriptorSets(*pipelineState->DescriptorSetsLayout, pipelineState->DescriptorSetHandles.Get()))
-                return;
+            // Reuse the sets written before with the same descriptors
+            TypedDescriptorPoolSetVulkan* poolSet = pipelineState->CurrentTypedDescriptorPoolSet;
+            _descriptorSetsKey.Clear();
             uint32 remainingStagesMask = pipelineState->HasDescriptorsPerStageMask;
             uint32 stage = 0;
             while (remainingStagesMask)
             {
                 if (remainingStagesMask & 1)
-                    pipelineState->DSWriter[stage].SetDescriptorSet(pipelineState->DescriptorSetHandles[stage]);
+                    pipelineState->DSWriter[stage].WriteCacheKey(_descriptorSetsKey, stage);
                 remainingStagesMask >>= 1;
                 stage++;
             }
+            const uint32 hash = Crc::MemCrc32(_descriptorSetsKey.Get(), _descriptorSetsKey.Count());
+            if (!poolSet->TryGetCachedSets(hash, _descriptorSetsKey, pipelineState->DescriptorSetHandles.Get(), pipelineState->DescriptorSetHandles.Count()))
+            {
+                if (!poolSet->AllocateDescriptorSets(*pipelineState->DescriptorSetsLayout, pipelineState->DescriptorSetHandles.Get()))
+                    return;
+                remainingStagesMask = pipelineState->HasDescriptorsPerStageMask;
+                stage = 0;
+                while (remainingStagesMask)
+                {
+                    if (remainingStagesMask & 1)
+                        pipelineState->DSWriter[stage].SetDescriptorSet(pipelineState->DescriptorSetHandles[stage]);
+                    remainingStagesMask >>= 1;
+                    stage++;
+                }
 
-            vkUpdateDescriptorSets(_device->Device, pipelineState->DSWriteContainer.DescriptorWrites.Count(), pipelineState->DSWriteContainer.DescriptorWrites.Get(), 0, nullptr);
+                vkUpdateDescriptorSets(_device->Device, pipelineState->DSWriteContainer.DescriptorWrites.Count(), pipelineState->DSWriteContainer.DescriptorWrites.Get(), 0, nullptr);
+                poolSet->AddCachedSets(hash, _descriptorSetsKey, pipelineState->DescriptorSetHandles.Get(), pipelineState->DescriptorSetHandles.Count());
+            }
         }
     }
 
@@ -656,8 +694,13 @@ void GPUContextVulkan::OnDrawCall()
     {
         VkBuffer buffers[GPU_MAX_VB_BINDED];
         VkDeviceSize offsets[GPU_MAX_VB_BINDED] = {};
+        ValidateInputAssemblyCache(cmdBuffer);
         for (int32 i = 0; i < missingVBs; i++)
+        {
             buffers[i] = _device->HelperResources.GetDummyVertexBuffer()->GetHandle();
+            _vbHandles[_vbCount + i] = buffers[i];
+            _vbOffsets[_vbCount + i] = 0;
+        }
         vkCmdBindVertexBuffers(cmdBuffer->GetHandle(), _vbCount, missingVBs, buffers, offsets);
     }
 
@@ -710,6 +753,7 @@ void GPUContextVulkan::FrameBegin()
     _psDirtyFlag = 0;
     _rtDirtyFlag = 0;
     _cbDirtyFlag = 0;
+    _isOverlapUA = 0;
     _rtCount = 0;
     _vbCount = 0;
     _stencilRef = 0;
@@ -990,6 +1034,7 @@ void GPUContextVulkan::BindCB(int32 slot, GPUConstantBuffer* cb)
 
     const auto cbVulkan = static_cast<GPUConstantBufferVulkan*>(cb);
 
+    RENDER_STAT_STATE_BIND(_cbHandles[slot] == cbVulkan);
     if (_cbHandles[slot] != cbVulkan)
     {
         _cbDirtyFlag = true;
@@ -1001,6 +1046,7 @@ void GPUContextVulkan::BindSR(int32 slot, GPUResourceView* view)
 {
     ASSERT(slot >= 0 && slot < GPU_MAX_SR_BINDED);
     const auto handle = view ? (DescriptorOwnerResourceVulkan*)view->GetNativePtr() : nullptr;
+    RENDER_STAT_STATE_BIND(_srHandles[slot] == handle);
     if (_srHandles[slot] != handle)
     {
         _srHandles[slot] = handle;
@@ -1013,6 +1059,7 @@ void GPUContextVulkan::BindUA(int32 slot, GPUResourceView* view)
 {
     ASSERT(slot >= 0 && slot < GPU_MAX_UA_BINDED);
     const auto handle = view ? (DescriptorOwnerResourceVulkan*)view->GetNativePtr() : nullptr;
+    RENDER_STAT_STATE_BIND(_uaHandles[slot] == handle);
     if (_uaHandles[slot] != handle)
     {
         _uaHandles[slot] = handle;
@@ -1027,8 +1074,10 @@ void GPUContextVulkan::BindVB(const Span<GPUBuffer*>& vertexBuffers, const uint3
     if (vertexBuffers.Length() == 0)
         return;
     const auto cmdBuffer = _cmdBufferManager->GetCmdBuffer();
+    ValidateInputAssemblyCache(cmdBuffer);
     VkBuffer buffers[GPU_MAX_VB_BINDED];
     VkDeviceSize offsets[GPU_MAX_VB_BINDED];
+    bool vbEdited = false;
     for (int32 i = 0; i < vertexBuffers.Length(); i++)
     {
         auto vbVulkan = static_cast<GPUBufferVulkan*>(vertexBuffers[i]);
@@ -1036,21 +1085,35 @@ void GPUContextVulkan::BindVB(const Span<GPUBuffer*>& vertexBuffers, const uint3
             vbVulkan = _device->HelperResources.GetDummyVertexBuffer();
         buffers[i] = vbVulkan->GetHandle();
         offsets[i] = vertexBuffersOffsets ? vertexBuffersOffsets[i] : 0;
+        vbEdited |= DescriptorSet::CopyAndReturnNotEqual(_vbHandles[i], buffers[i]);
+        vbEdited |= DescriptorSet::CopyAndReturnNotEqual(_vbOffsets[i], offsets[i]);
     }
-    vkCmdBindVertexBuffers(cmdBuffer->GetHandle(), 0, vertexBuffers.Length(), buffers, offsets);
+    RENDER_STAT_STATE_BIND(!vbEdited);
+    if (vbEdited)
+        vkCmdBindVertexBuffers(cmdBuffer->GetHandle(), 0, vertexBuffers.Length(), buffers, offsets);
 }
 
 void GPUContextVulkan::BindIB(GPUBuffer* indexBuffer)
 {
     const auto cmdBuffer = _cmdBufferManager->GetCmdBuffer();
+    ValidateInputAssemblyCache(cmdBuffer);
     const auto ibVulkan = static_cast<GPUBufferVulkan*>(indexBuffer)->GetHandle();
-    vkCmdBindIndexBuffer(cmdBuffer->GetHandle(), ibVulkan, 0, indexBuffer->GetFormat() == PixelFormat::R32_UInt ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16);
+    const VkIndexType ibType = indexBuffer->GetFormat() == PixelFormat::R32_UInt ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16;
+    const bool redundant = _ibHandle == ibVulkan && _ibType == ibType;
+    RENDER_STAT_STATE_BIND(redundant);
+    if (!redundant)
+    {
+        _ibHandle = ibVulkan;
+        _ibType = ibType;
+        vkCmdBindIndexBuffer(cmdBuffer->GetHandle(), ibVulkan, 0, ibType);
+    }
 }
 
 void GPUContextVulkan::BindSampler(int32 slot, GPUSampler* sampler)
 {
     ASSERT(slot >= GPU_STATIC_SAMPLERS_COUNT && slot < GPU_MAX_SAMPLER_BINDED);
     const auto handle = sampler ? ((GPUSamplerVulkan*)sampler)->Sampler : VK_NULL_HANDLE;
+    RENDER_STAT_STATE_BIND(_samplerHandles[slot] == handle);
     _samplerHandles[slot] = handle;
 }
 
@@ -1108,9 +1171,9 @@ void GPUContextVulkan::Dispatch(GPUShaderProgramCS* shader, uint32 threadGroupCo
     vkCmdDispatch(cmdBuffer->GetHandle(), threadGroupCountX, threadGroupCountY, threadGroupCountZ);
     RENDER_STAT_DISPATCH_CALL();
 
-    // Place a barrier between dispatches, so that UAVs can be read+write in subsequent passes
-    // TODO: optimize it by moving inputs/outputs into higher-layer so eg. Global SDF can manually optimize it
-    vkCmdPipelineBarrier(cmdBuffer->GetHandle(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+    // Place a barrier between dispatches, so that UAVs can be read+write in subsequent passes (unless inside overlap region)
+    if (!_isOverlapUA)
+        vkCmdPipelineBarrier(cmdBuffer->GetHandle(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
 
 #if VK_ENABLE_BARRIERS_DEBUG
     LOG(Warning, "Dispatch");
@@ -1144,15 +1207,25 @@ void GPUContextVulkan::DispatchIndirect(GPUShaderProgramCS* shader, GPUBuffer* b
     vkCmdDispatchIndirect(cmdBuffer->GetHandle(), bufferForArgsVulkan->GetHandle(), offsetForArgs);
     RENDER_STAT_DISPATCH_CALL();
 
-    // Place a barrier between dispatches, so that UAVs can be read+write in subsequent passes
-    // TODO: optimize it by moving inputs/outputs into higher-layer so eg. Global SDF can manually optimize it
-    vkCmdPipelineBarrier(cmdBuffer->GetHandle(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+    // Place a barrier between dispatches, so that UAVs can be read+write in subsequent passes (unless inside overlap region)
+    if (!_isOverlapUA)
+        vkCmdPipelineBarrier(cmdBuffer->GetHandle(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
 
 #if VK_ENABLE_BARRIERS_DEBUG
     LOG(Warning, "DispatchIndirect");
 #endif
 }
 
+void GPUContextVulkan::OverlapUA(bool end)
+{
+    _isOverlapUA = !end;
+    if (end)
+    {
+        const auto cmdBuffer = _cmdBufferManager->GetCmdBuffer();
+        vkCmdPipelineBarrier(cmdBuffer->GetHandle(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+    }
+}
+
 void GPUContextVulkan::ResolveMultisample(GPUTexture* sourceMultisampleTexture, GPUTexture* destTexture, int32 sourceSubResource, int32 destSubResource, PixelFormat format)
 {
     ASSERT(sourceMultisampleTexture && sourceMultisampleTexture->IsMultiSample());
@@ -1253,6 +1326,7 @@ GPUPipelineState* GPUContextVulkan::GetState() const
 
 void GPUContextVulkan::SetState(GPUPipelineState* state)
 {
+    RENDER_STAT_STATE_BIND(_currentState == state);
     if (_currentState != state)
     {
         _currentState = static_cast<GPUPipelineStateVulkan*>(state);
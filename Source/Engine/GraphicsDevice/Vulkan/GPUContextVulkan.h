@@ -75,11 +75,20 @@ class GPUContextVulkan : public GPUContext
     int32 _psDirtyFlag : 1;
     int32 _rtDirtyFlag : 1;
     int32 _cbDirtyFlag : 1;
+    int32 _isOverlapUA : 1;
 
     int32 _rtCount;
     int32 _vbCount;
     uint32 _stencilRef;
 
+    // Input assembly bindings cache to skip redundant binds (valid only within the recorded command buffer)
+    const CmdBufferVulkan* _iaCmdBuffer = nullptr;
+    uint64 _iaCmdBufferFenceCounter = 0;
+    VkBuffer _vbHandles[GPU_MAX_VB_BINDED];
+    VkDeviceSize _vbOffsets[GPU_MAX_VB_BINDED];
+    VkBuffer _ibHandle;
+    VkIndexType _ibType;
+
     RenderPassVulkan* _renderPass;
     GPUPipelineStateVulkan* _currentState;
     GPUTextureViewVulkan* _rtDepth;
@@ -95,6 +104,7 @@ class GPUContextVulkan : public GPUContext
 
     typedef Array<DescriptorPoolVulkan*> DescriptorPoolArray;
     Dictionary<uint32, DescriptorPoolArray> _descriptorPools;
+    Array<byte> _descriptorSetsKey;
 
 public:
     /// <summary>
@@ -138,6 +148,7 @@ class GPUContextVulkan : public GPUContext
 private:
     void UpdateDescriptorSets(const struct SpirvShaderDescriptorInfo& descriptorInfo, class DescriptorSetWriterVulkan& dsWriter, bool& needsWrite);
     void UpdateDescriptorSets(ComputePipelineStateVulkan* pipelineState);
+    void ValidateInputAssemblyCache(const CmdBufferVulkan* cmdBuffer);
     void OnDrawCall();
 
 public:
@@ -174,6 +185,7 @@ class GPUContextVulkan : public GPUContext
     void UpdateCB(GPUConstantBuffer* cb, const void* data) override;
     void Dispatch(GPUShaderProgramCS* shader, uint32 threadGroupCountX, uint32 threadGroupCountY, uint32 threadGroupCountZ) override;
     void DispatchIndirect(GPUShaderProgramCS* shader, GPUBuffer* bufferForArgs, uint32 offsetForArgs) override;
+    void OverlapUA(bool end) override;
     void ResolveMultisample(GPUTexture* sourceMultisampleTexture, GPUTexture* destTexture, int32 sourceSubResource, int32 destSubResource, PixelFormat format) override;
     void DrawInstanced(uint32 verticesCount, uint32 instanceCount, int32 startInstance, int32 startVertex) override;
     void DrawIndexedInstanced(uint32 indicesCount, uint32 instanceCount, int32 startInstance, int32 startVertex, int32 startIndex) override;
@@ -42,6 +42,9 @@ static const char* GInstanceExtensions[] =
 #if VK_EXT_validation_cache
     VK_EXT_VALIDATION_CACHE_EXTENSION_NAME,
 #endif
+#if VK_EXT_memory_budget && !PLATFORM_APPLE_FAMILY
+    VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME,
+#endif
 #if defined(VK_KHR_display) && 0
     VK_KHR_DISPLAY_EXTENSION_NAME,
 #endif
@@ -62,6 +65,9 @@ static const char* GDeviceExtensions[] =
 #endif
 #if VK_KHR_sampler_mirror_clamp_to_edge
     VK_KHR_SAMPLER_MIRROR_CLAMP_TO_EDGE_EXTENSION_NAME,
+#endif
+#if VK_EXT_memory_budget
+    VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
 #endif
     nullptr
 };
@@ -585,6 +591,9 @@ void GPUDeviceVulkan::ParseOptionalDeviceExtensions(const Array<const char*>& de
 #if VK_EXT_validation_cache
     OptionalDeviceExtensions.HasEXTValidationCache = RenderToolsVulkan::HasExtension(deviceExtensions, VK_EXT_VALIDATION_CACHE_EXTENSION_NAME);
 #endif
+#if VK_EXT_memory_budget
+    OptionalDeviceExtensions.HasEXTMemoryBudget = RenderToolsVulkan::HasExtension(deviceExtensions, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) && RenderToolsVulkan::HasExtension(InstanceExtensions, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+#endif
 }
 
 #endif
@@ -390,6 +390,10 @@ void DeferredDeletionQueueVulkan::ReleaseResources(bool immediately)
                 {
                     vmaDestroyBuffer(_device->Allocator, (VkBuffer)e->Handle, e->AllocationHandle);
                 }
+                else if (e->StructureType == Memory)
+                {
+                    vmaFreeMemory(_device->Allocator, e->AllocationHandle);
+                }
 #if !BUILD_RELEASE
                 else
                 {
@@ -1415,6 +1419,28 @@ void GetPipelineCachePath(String& path)
 #endif
 }
 
+bool IsPipelineCacheValid(const Array<uint8>& data, const VkPhysicalDeviceProperties& props)
+{
+    // Validate the cache header (see VkPipelineCacheHeaderVersionOne) to skip data created for a different GPU or driver
+    struct PipelineCacheHeader
+    {
+        uint32 HeaderSize;
+        uint32 HeaderVersion;
+        uint32 VendorID;
+        uint32 DeviceID;
+        uint8 PipelineCacheUUID[VK_UUID_SIZE];
+    };
+    if (data.Count() < (int32)sizeof(PipelineCacheHeader))
+        return false;
+    PipelineCacheHeader header;
+    Platform::MemoryCopy(&header, data.Get(), sizeof(header));
+    return header.HeaderSize >= sizeof(PipelineCacheHeader) &&
+        header.HeaderVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+        header.VendorID == props.vendorID &&
+        header.DeviceID == props.deviceID &&
+        Platform::MemoryCompare(header.PipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
 bool GPUDeviceVulkan::SavePipelineCache()
 {
     if (PipelineCache == VK_NULL_HANDLE || !vkGetPipelineCacheData)
@@ -1508,6 +1534,25 @@ void* GPUDeviceVulkan::GetNativePtr() const
     return _nativePtr;
 }
 
+uint64 GPUDeviceVulkan::GetMemoryBudget() const
+{
+    if (!Allocator)
+        return GPUDevice::GetMemoryBudget();
+
+    // Sum the budget of the device-local heaps (uses VK_EXT_memory_budget if available, otherwise estimated from heap sizes)
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(Adapter->Gpu, &memoryProperties);
+    VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+    vmaGetBudget(Allocator, budgets);
+    uint64 result = 0;
+    for (uint32 i = 0; i < memoryProperties.memoryHeapCount; i++)
+    {
+        if ((memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) == VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+            result += budgets[i].budget;
+    }
+    return result != 0 ? result : GPUDevice::GetMemoryBudget();
+}
+
 static int32 GetMaxSampleCount(VkSampleCountFlags counts)
 {
     if (counts & VK_SAMPLE_COUNT_64_BIT)
@@ -1706,6 +1751,10 @@ bool GPUDeviceVulkan::Init()
         limits.HasReadOnlyDepth = true;
         limits.HasMultisampleDepthAsSRV = !!PhysicalDeviceFeatures.sampleRateShading;
         limits.HasTypedUAVLoad = true;
+        limits.HasVariableRateShading = false; // TODO: implement VK_KHR_fragment_shading_rate (requires shading rate attachment in the render passes)
+        limits.VariableRateShadingTileSize = 0;
+        limits.HasBindlessResources = false; // TODO: implement bindless with VK_EXT_descriptor_indexing
+        limits.HasSparseTextures = PhysicalDeviceFeatures.sparseBinding && PhysicalDeviceFeatures.sparseResidencyImage2D && (QueueFamilyProps[graphicsQueueFamilyIndex].queueFlags & VK_QUEUE_SPARSE_BINDING_BIT) == VK_QUEUE_SPARSE_BINDING_BIT;
         limits.MaximumMipLevelsCount = Math::Min(static_cast<int32>(log2(PhysicalDeviceLimits.maxImageDimension2D)), GPU_MAX_TEXTURE_MIP_LEVELS);
         limits.MaximumTexture1DSize = PhysicalDeviceLimits.maxImageDimension1D;
         limits.MaximumTexture1DArraySize = PhysicalDeviceLimits.maxImageArrayLayers;
@@ -1841,6 +1890,11 @@ bool GPUDeviceVulkan::Init()
         INIT_FUNC(vkGetImageMemoryRequirements2KHR);
 #endif
 #endif
+#if VMA_MEMORY_BUDGET
+        vulkanFunctions.vkGetPhysicalDeviceMemoryProperties2KHR = nullptr;
+        if (OptionalDeviceExtensions.HasEXTMemoryBudget)
+            INIT_FUNC(vkGetPhysicalDeviceMemoryProperties2KHR);
+#endif
 #undef INIT_FUNC
         VmaAllocatorCreateInfo allocatorInfo = {};
         allocatorInfo.vulkanApiVersion = VULKAN_API_VERSION;
@@ -1848,6 +1902,10 @@ bool GPUDeviceVulkan::Init()
         allocatorInfo.instance = Instance;
         allocatorInfo.device = Device;
         allocatorInfo.pVulkanFunctions = &vulkanFunctions;
+#if VMA_MEMORY_BUDGET
+        if (OptionalDeviceExtensions.HasEXTMemoryBudget && vulkanFunctions.vkGetPhysicalDeviceMemoryProperties2KHR)
+            allocatorInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+#endif
         VALIDATE_VULKAN_RESULT(vmaCreateAllocator(&allocatorInfo, &Allocator));
     }
 
@@ -1892,6 +1950,11 @@ bool GPUDeviceVulkan::Init()
         {
             LOG(Info, "Trying to load Vulkan pipeline cache file {0}", path);
             File::ReadAllBytes(path, data);
+            if (data.Count() != 0 && !IsPipelineCacheValid(data, Adapter->GpuProps))
+            {
+                LOG(Info, "Discarding Vulkan pipeline cache created for a different GPU or driver");
+                data.Clear();
+            }
         }
         VkPipelineCacheCreateInfo pipelineCacheCreateInfo;
         RenderToolsVulkan::ZeroStruct(pipelineCacheCreateInfo, VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO);
@@ -1953,6 +2016,9 @@ void GPUDeviceVulkan::DrawBegin()
     // Base
     GPUDevice::DrawBegin();
 
+    // Refresh memory budget
+    vmaSetCurrentFrameIndex(Allocator, (uint32)Engine::FrameCount);
+
     // Flush resources
     DeferredDeletionQueue.ReleaseResources();
     StagingManager.ProcessPendingFree();
@@ -123,6 +123,7 @@ class DeferredDeletionQueueVulkan
         ShaderModule,
         Event,
         QueryPool,
+        Memory,
     };
 
 private:
@@ -401,6 +402,7 @@ class GPUDeviceVulkan : public GPUDevice
         uint32 HasKHRMaintenance2 : 1;
         uint32 HasMirrorClampToEdge : 1;
         uint32 HasEXTValidationCache : 1;
+        uint32 HasEXTMemoryBudget : 1;
     };
 
     static void GetInstanceLayersAndExtensions(Array<const char*>& outInstanceExtensions, Array<const char*>& outInstanceLayers, bool& outDebugUtils);
@@ -600,6 +602,7 @@ class GPUDeviceVulkan : public GPUDevice
     GPUContext* GetMainContext() override;
     GPUAdapter* GetAdapter() const override;
     void* GetNativePtr() const override;
+    uint64 GetMemoryBudget() const override;
     bool Init() override;
     void DrawBegin() override;
     void Dispose() override;
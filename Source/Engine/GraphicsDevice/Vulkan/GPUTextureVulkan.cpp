@@ -5,6 +5,7 @@
 #include "GPUTextureVulkan.h"
 #include "GPUBufferVulkan.h"
 #include "GPUContextVulkan.h"
+#include "QueueVulkan.h"
 #include "RenderToolsVulkan.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Graphics/PixelFormatExtensions.h"
@@ -289,6 +290,8 @@ bool GPUTextureVulkan::OnInit()
     imageInfo.extent.height = Height();
     imageInfo.extent.depth = Depth();
     imageInfo.flags = IsCubeMap() ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
+    if (IsSparse())
+        imageInfo.flags |= VK_IMAGE_CREATE_SPARSE_BINDING_BIT | VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT;
     if (IsSRGB())
         imageInfo.flags |= VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT;
 #if VK_KHR_maintenance1
@@ -313,10 +316,18 @@ bool GPUTextureVulkan::OnInit()
     imageInfo.samples = (VkSampleCountFlagBits)MultiSampleLevel();
     // TODO: set initialLayout to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL for IsRegularTexture() ???
 
-    // Create texture
-    VmaAllocationCreateInfo allocInfo = {};
-    allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-    const VkResult result = vmaCreateImage(_device->Allocator, &imageInfo, &allocInfo, &_image, &_allocation, nullptr);
+    // Create texture (sparse textures have no memory bound until mips get committed)
+    VkResult result;
+    if (IsSparse())
+    {
+        result = vkCreateImage(_device->Device, &imageInfo, nullptr, &_image);
+    }
+    else
+    {
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+        result = vmaCreateImage(_device->Allocator, &imageInfo, &allocInfo, &_image, &_allocation, nullptr);
+    }
     LOG_VULKAN_RESULT_WITH_RETURN(result);
 #if GPU_ENABLE_RESOURCE_NAMING
     VK_SET_DEBUG_NAME(_device, _image, VK_OBJECT_TYPE_IMAGE, GetName());
@@ -325,7 +336,15 @@ bool GPUTextureVulkan::OnInit()
 
     // Set state
     initResource(VK_IMAGE_LAYOUT_UNDEFINED, _desc.MipLevels, _desc.ArraySize, true);
-    _memoryUsage = calculateMemoryUsage();
+    if (IsSparse())
+    {
+        if (initSparse())
+            return true;
+    }
+    else
+    {
+        _memoryUsage = calculateMemoryUsage();
+    }
     if (PixelFormatExtensions::IsDepthStencil(format))
     {
         DefaultAspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
@@ -474,6 +493,145 @@ void GPUTextureVulkan::OnResidentMipsChanged()
     view.Init(_device, this, _image, mipLevels, Format(), MultiSampleLevel(), extent, viewType, mipLevels, firstMipIndex, ArraySize());
 }
 
+bool GPUTextureVulkan::OnCommitMips(int32 count)
+{
+    GPUDeviceLock lock(_device);
+    const int32 mipLevels = MipLevels();
+    const int32 standardMips = mipLevels - _sparsePackedMips;
+    bool failed = false;
+    for (int32 mipIndex = 0; mipIndex < standardMips; mipIndex++)
+    {
+        const bool commit = mipIndex >= mipLevels - count;
+        if (commit != (_sparseMips[mipIndex] != VK_NULL_HANDLE))
+            failed |= commitSparseMip(mipIndex, commit);
+    }
+    int32 committedMips = _sparsePackedMips;
+    while (committedMips < mipLevels && _sparseMips[mipLevels - committedMips - 1] != VK_NULL_HANDLE)
+        committedMips++;
+    _committedMipLevels = committedMips;
+    return failed;
+}
+
+bool GPUTextureVulkan::initSparse()
+{
+    // Query the image sparse memory layout
+    vkGetImageMemoryRequirements(_device->Device, _image, &_sparseMemoryRequirements);
+    uint32 requirementsCount = 0;
+    vkGetImageSparseMemoryRequirements(_device->Device, _image, &requirementsCount, nullptr);
+    Array<VkSparseImageMemoryRequirements, InlinedAllocation<4>> requirements;
+    requirements.Resize(requirementsCount);
+    vkGetImageSparseMemoryRequirements(_device->Device, _image, &requirementsCount, requirements.Get());
+    int32 colorRequirements = -1;
+    for (int32 i = 0; i < requirements.Count() && colorRequirements == -1; i++)
+    {
+        if (requirements[i].formatProperties.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT)
+            colorRequirements = i;
+    }
+    if (colorRequirements == -1)
+    {
+        LOG(Error, "Missing sparse memory requirements for texture {0}.", ToString());
+        return true;
+    }
+    _sparseRequirements = requirements[colorRequirements];
+    const int32 mipTailFirstLod = Math::Min((int32)_sparseRequirements.imageMipTailFirstLod, MipLevels());
+    _sparsePackedMips = MipLevels() - mipTailFirstLod;
+    _sparseMips.Resize(mipTailFirstLod + 1);
+    for (int32 i = 0; i < _sparseMips.Count(); i++)
+        _sparseMips[i] = VK_NULL_HANDLE;
+    _memoryUsage = 0;
+
+    // Mip tail cannot be bound partially so keep it always committed
+    _committedMipLevels = _sparsePackedMips;
+    if (_sparsePackedMips != 0)
+        return commitSparseMip(_sparseMips.Count() - 1, true);
+    return false;
+}
+
+bool GPUTextureVulkan::commitSparseMip(int32 index, bool commit)
+{
+    VmaAllocation& allocation = _sparseMips[index];
+    const bool isTail = index == _sparseMips.Count() - 1;
+    if (!commit && isTail)
+        return false;
+
+    // Calculate memory size for the mip
+    const VkExtent3D granularity = _sparseRequirements.formatProperties.imageGranularity;
+    const uint32 mipWidth = Math::Max(Width() >> index, 1);
+    const uint32 mipHeight = Math::Max(Height() >> index, 1);
+    VkMemoryRequirements memoryRequirements = _sparseMemoryRequirements;
+    if (isTail)
+        memoryRequirements.size = _sparseRequirements.imageMipTailSize;
+    else
+        memoryRequirements.size = (VkDeviceSize)Math::DivideAndRoundUp(mipWidth, granularity.width) * Math::DivideAndRoundUp(mipHeight, granularity.height) * _sparseMemoryRequirements.alignment;
+
+    // Allocate memory (or unbind when decommitting)
+    VmaAllocationInfo allocationInfo = {};
+    if (commit)
+    {
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+        const VkResult result = vmaAllocateMemory(_device->Allocator, &memoryRequirements, &allocInfo, &allocation, &allocationInfo);
+        LOG_VULKAN_RESULT_WITH_RETURN(result);
+    }
+
+    // Bind memory to the image
+    VkBindSparseInfo bindInfo;
+    RenderToolsVulkan::ZeroStruct(bindInfo, VK_STRUCTURE_TYPE_BIND_SPARSE_INFO);
+    VkSparseMemoryBind tailBind = {};
+    VkSparseImageOpaqueMemoryBindInfo tailBindInfo;
+    VkSparseImageMemoryBind mipBind = {};
+    VkSparseImageMemoryBindInfo mipBindInfo;
+    if (isTail)
+    {
+        tailBind.resourceOffset = _sparseRequirements.imageMipTailOffset;
+        tailBind.size = _sparseRequirements.imageMipTailSize;
+        tailBind.memory = allocationInfo.deviceMemory;
+        tailBind.memoryOffset = allocationInfo.offset;
+        tailBindInfo.image = _image;
+        tailBindInfo.bindCount = 1;
+        tailBindInfo.pBinds = &tailBind;
+        bindInfo.imageOpaqueBindCount = 1;
+        bindInfo.pImageOpaqueBinds = &tailBindInfo;
+    }
+    else
+    {
+        mipBind.subresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        mipBind.subresource.mipLevel = index;
+        mipBind.extent = { mipWidth, mipHeight, 1 };
+        mipBind.memory = allocationInfo.deviceMemory;
+        mipBind.memoryOffset = allocationInfo.offset;
+        mipBindInfo.image = _image;
+        mipBindInfo.bindCount = 1;
+        mipBindInfo.pBinds = &mipBind;
+        bindInfo.imageBindCount = 1;
+        bindInfo.pImageBinds = &mipBindInfo;
+    }
+    FenceVulkan* fence = _device->FenceManager.AllocateFence();
+    const VkResult result = vkQueueBindSparse(_device->GraphicsQueue->GetHandle(), 1, &bindInfo, fence->Handle);
+    _device->FenceManager.WaitAndReleaseFence(fence, MAX_uint64);
+    if (result != VK_SUCCESS)
+    {
+        LOG_VULKAN_RESULT(result);
+        if (commit)
+        {
+            vmaFreeMemory(_device->Allocator, allocation);
+            allocation = VK_NULL_HANDLE;
+        }
+        return true;
+    }
+    if (commit)
+    {
+        _memoryUsage += memoryRequirements.size;
+    }
+    else
+    {
+        _device->DeferredDeletionQueue.EnqueueResource(DeferredDeletionQueueVulkan::Type::Memory, allocation, allocation);
+        allocation = VK_NULL_HANDLE;
+        _memoryUsage -= memoryRequirements.size;
+    }
+    return false;
+}
+
 void GPUTextureVulkan::OnReleaseGPU()
 {
     _handleArray.Release();
@@ -499,6 +657,13 @@ void GPUTextureVulkan::OnReleaseGPU()
         _image = VK_NULL_HANDLE;
         _allocation = VK_NULL_HANDLE;
     }
+    for (VmaAllocation allocation : _sparseMips)
+    {
+        if (allocation != VK_NULL_HANDLE)
+            _device->DeferredDeletionQueue.EnqueueResource(DeferredDeletionQueueVulkan::Type::Memory, allocation, allocation);
+    }
+    _sparseMips.Clear();
+    _sparsePackedMips = 0;
     SAFE_DELETE_GPU_RESOURCE(StagingBuffer);
     State.Release();
 
@@ -94,6 +94,12 @@ class GPUTextureVulkan : public GPUResourceVulkan<GPUTexture>, public ResourceOw
     Array<GPUTextureViewVulkan> _handlesPerSlice; // [slice]
     Array<Array<GPUTextureViewVulkan>> _handlesPerMip; // [slice][mip]
 
+    // Sparse texture memory bound per standard mip (the last entry is for the mip tail)
+    Array<VmaAllocation, FixedAllocation<GPU_MAX_TEXTURE_MIP_LEVELS + 1>> _sparseMips;
+    VkSparseImageMemoryRequirements _sparseRequirements;
+    VkMemoryRequirements _sparseMemoryRequirements;
+    int32 _sparsePackedMips = 0;
+
 public:
     /// <summary>
     /// Initializes a new instance of the <see cref="GPUTextureVulkan"/> class.
@@ -126,6 +132,8 @@ class GPUTextureVulkan : public GPUResourceVulkan<GPUTexture>, public ResourceOw
 
 private:
     void initHandles();
+    bool initSparse();
+    bool commitSparseMip(int32 index, bool commit);
 
 public:
     // [GPUTexture]
@@ -177,6 +185,7 @@ class GPUTextureVulkan : public GPUResourceVulkan<GPUTexture>, public ResourceOw
     // [GPUTexture]
     bool OnInit() override;
     void OnResidentMipsChanged() override;
+    bool OnCommitMips(int32 count) override;
     void OnReleaseGPU() override;
 };
 
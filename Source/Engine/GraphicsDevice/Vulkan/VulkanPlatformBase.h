@@ -40,9 +40,7 @@ class VulkanPlatformBase
         featuresToEnable = deviceFeatures;
         featuresToEnable.shaderResourceResidency = VK_FALSE;
         featuresToEnable.shaderResourceMinLod = VK_FALSE;
-        featuresToEnable.sparseBinding = VK_FALSE;
         featuresToEnable.sparseResidencyBuffer = VK_FALSE;
-        featuresToEnable.sparseResidencyImage2D = VK_FALSE;
         featuresToEnable.sparseResidencyImage3D = VK_FALSE;
         featuresToEnable.sparseResidency2Samples = VK_FALSE;
         featuresToEnable.sparseResidency4Samples = VK_FALSE;
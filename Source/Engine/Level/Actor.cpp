@@ -37,6 +37,9 @@
 
 namespace
 {
+    bool IsFlushingTransforms = false;
+    Array<Actor*> DirtyTransforms;
+
     Actor* GetChildByPrefabObjectId(Actor* a, const Guid& prefabObjectId)
     {
         Actor* result = nullptr;
@@ -84,6 +87,8 @@ Actor::Actor(const SpawnParams& params)
 {
     _drawNoCulling = 0;
     _drawCategory = 0;
+    _isTransformDirty = 0;
+    _isTransformStale = 0;
 }
 
 SceneRendering* Actor::GetSceneRendering() const
@@ -258,7 +263,7 @@ void Actor::SetParent(Actor* value, bool worldPositionsStays, bool canBreakPrefa
 #endif
 
     // Peek the previous state
-    const Transform prevTransform = _transform;
+    const Transform prevTransform = GetTransform();
     const bool wasActiveInTree = IsActiveInHierarchy();
     const auto prevParent = _parent;
     const auto prevScene = _scene;
@@ -319,7 +324,7 @@ void Actor::SetParent(Actor* value, bool worldPositionsStays, bool canBreakPrefa
     if (worldPositionsStays)
     {
         if (_parent)
-            _parent->_transform.WorldToLocal(prevTransform, _localTransform);
+            _parent->GetTransform().WorldToLocal(prevTransform, _localTransform);
         else
             _localTransform = prevTransform;
     }
@@ -615,59 +620,59 @@ void Actor::SetStaticFlags(StaticFlags value)
 void Actor::SetTransform(const Transform& value)
 {
     CHECK(!value.IsNanOrInfinity());
-    if (!(Vector3::NearEqual(_transform.Translation, value.Translation) && Quaternion::NearEqual(_transform.Orientation, value.Orientation, ACTOR_ORIENTATION_EPSILON) && Float3::NearEqual(_transform.Scale, value.Scale)))
+    if (!(Vector3::NearEqual(GetTransform().Translation, value.Translation) && Quaternion::NearEqual(GetTransform().Orientation, value.Orientation, ACTOR_ORIENTATION_EPSILON) && Float3::NearEqual(GetTransform().Scale, value.Scale)))
     {
         if (_parent)
-            _parent->_transform.WorldToLocal(value, _localTransform);
+            _parent->GetTransform().WorldToLocal(value, _localTransform);
         else
             _localTransform = value;
-        OnTransformChanged();
+        InvalidateTransform();
     }
 }
 
 void Actor::SetPosition(const Vector3& value)
 {
     CHECK(!value.IsNanOrInfinity());
-    if (!Vector3::NearEqual(_transform.Translation, value))
+    if (!Vector3::NearEqual(GetTransform().Translation, value))
     {
         if (_parent)
-            _localTransform.Translation = _parent->_transform.WorldToLocal(value);
+            _localTransform.Translation = _parent->GetTransform().WorldToLocal(value);
         else
             _localTransform.Translation = value;
-        OnTransformChanged();
+        InvalidateTransform();
     }
 }
 
 void Actor::SetOrientation(const Quaternion& value)
 {
     CHECK(!value.IsNanOrInfinity());
-    if (!Quaternion::NearEqual(_transform.Orientation, value, ACTOR_ORIENTATION_EPSILON))
+    if (!Quaternion::NearEqual(GetTransform().Orientation, value, ACTOR_ORIENTATION_EPSILON))
     {
         if (_parent)
-            _parent->_transform.WorldToLocal(value, _localTransform.Orientation);
+            _parent->GetTransform().WorldToLocal(value, _localTransform.Orientation);
         else
             _localTransform.Orientation = value;
-        OnTransformChanged();
+        InvalidateTransform();
     }
 }
 
 void Actor::SetScale(const Float3& value)
 {
     CHECK(!value.IsNanOrInfinity());
-    if (!Float3::NearEqual(_transform.Scale, value))
+    if (!Float3::NearEqual(GetTransform().Scale, value))
     {
         if (_parent)
-            Float3::Divide(value, _parent->_transform.Scale, _localTransform.Scale);
+            Float3::Divide(value, _parent->GetTransform().Scale, _localTransform.Scale);
         else
             _localTransform.Scale = value;
-        OnTransformChanged();
+        InvalidateTransform();
     }
 }
 
 Matrix Actor::GetRotation() const
 {
     Matrix result;
-    Matrix::RotationQuaternion(_transform.Orientation, result);
+    Matrix::RotationQuaternion(GetTransform().Orientation, result);
     return result;
 }
 
@@ -706,7 +711,7 @@ void Actor::SetLocalTransform(const Transform& value)
     if (!(Vector3::NearEqual(_localTransform.Translation, value.Translation) && Quaternion::NearEqual(_localTransform.Orientation, value.Orientation, ACTOR_ORIENTATION_EPSILON) && Float3::NearEqual(_localTransform.Scale, value.Scale)))
     {
         _localTransform = value;
-        OnTransformChanged();
+        InvalidateTransform();
     }
 }
 
@@ -716,7 +721,7 @@ void Actor::SetLocalPosition(const Vector3& value)
     if (!Vector3::NearEqual(_localTransform.Translation, value))
     {
         _localTransform.Translation = value;
-        OnTransformChanged();
+        InvalidateTransform();
     }
 }
 
@@ -728,7 +733,7 @@ void Actor::SetLocalOrientation(const Quaternion& value)
     if (!Quaternion::NearEqual(_localTransform.Orientation, v, ACTOR_ORIENTATION_EPSILON))
     {
         _localTransform.Orientation = v;
-        OnTransformChanged();
+        InvalidateTransform();
     }
 }
 
@@ -738,16 +743,16 @@ void Actor::SetLocalScale(const Float3& value)
     if (!Float3::NearEqual(_localTransform.Scale, value))
     {
         _localTransform.Scale = value;
-        OnTransformChanged();
+        InvalidateTransform();
     }
 }
 
 void Actor::AddMovement(const Vector3& translation, const Quaternion& rotation)
 {
     Transform t;
-    t.Translation = _transform.Translation + translation;
-    t.Orientation = _transform.Orientation * rotation;
-    t.Scale = _transform.Scale;
+    t.Translation = GetTransform().Translation + translation;
+    t.Orientation = GetTransform().Orientation * rotation;
+    t.Scale = GetTransform().Scale;
     SetTransform(t);
 }
 
@@ -893,6 +898,15 @@ void Actor::EndPlay()
     CHECK(IsDuringPlay());
 #endif
 
+    // Skip pending transform update
+    if (_isTransformDirty)
+    {
+        _isTransformDirty = 0;
+        const int32 index = DirtyTransforms.Find(this);
+        if (index != -1)
+            DirtyTransforms[index] = nullptr;
+    }
+
     // Fire event for scripting
     if (IsActiveInHierarchy() && GetScene())
     {
@@ -1169,9 +1183,10 @@ void Actor::OnTransformChanged()
 {
     ASSERT_LOW_LAYER(!_localTransform.IsNanOrInfinity());
 
+    _isTransformStale = 0;
     if (_parent)
     {
-        _parent->_transform.LocalToWorld(_localTransform, _transform);
+        _parent->GetTransform().LocalToWorld(_localTransform, _transform);
     }
     else
     {
@@ -1184,6 +1199,87 @@ void Actor::OnTransformChanged()
     }
 }
 
+void Actor::InvalidateTransform()
+{
+    if (Level::DeferTransformUpdates && !IsFlushingTransforms && IsDuringPlay() && IsInMainThread())
+    {
+        // Update only this actor world transform, children resolve it on access and the whole hierarchy is updated later in FlushTransforms
+        if (_parent)
+            _parent->GetTransform().LocalToWorld(_localTransform, _transform);
+        else
+            _transform = _localTransform;
+        _isTransformStale = 0;
+        for (auto child : Children)
+            child->MarkTransformStale();
+        if (!_isTransformDirty)
+        {
+            _isTransformDirty = 1;
+            DirtyTransforms.Add(this);
+        }
+    }
+    else
+    {
+        OnTransformChanged();
+    }
+}
+
+void Actor::MarkTransformStale()
+{
+    if (_isTransformStale)
+        return;
+    _isTransformStale = 1;
+    for (auto child : Children)
+        child->MarkTransformStale();
+}
+
+void Actor::ResolveTransform() const
+{
+    auto actor = const_cast<Actor*>(this);
+    actor->_isTransformStale = 0;
+    if (_parent)
+        _parent->GetTransform().LocalToWorld(_localTransform, actor->_transform);
+    else
+        actor->_transform = _localTransform;
+}
+
+void Actor::FlushTransforms()
+{
+    if (DirtyTransforms.IsEmpty())
+        return;
+    PROFILE_CPU();
+    ASSERT(IsInMainThread());
+
+    // Skip actors that are updated by the dirty parent
+    for (int32 i = 0; i < DirtyTransforms.Count(); i++)
+    {
+        Actor* actor = DirtyTransforms.Get()[i];
+        if (!actor)
+            continue;
+        for (Actor* parent = actor->_parent; parent; parent = parent->_parent)
+        {
+            if (parent->_isTransformDirty)
+            {
+                actor->_isTransformDirty = 0;
+                DirtyTransforms.Get()[i] = nullptr;
+                break;
+            }
+        }
+    }
+
+    // Update world transformation, bounds and rendering state of the modified hierarchies (changes done meantime are applied immediately)
+    IsFlushingTransforms = true;
+    for (int32 i = 0; i < DirtyTransforms.Count(); i++)
+    {
+        Actor* actor = DirtyTransforms.Get()[i];
+        if (!actor)
+            continue;
+        actor->_isTransformDirty = 0;
+        actor->OnTransformChanged();
+    }
+    DirtyTransforms.Clear();
+    IsFlushingTransforms = false;
+}
+
 void Actor::OnActiveChanged()
 {
     const bool wasActiveInTree = IsActiveInHierarchy();
@@ -1525,26 +1621,26 @@ void Actor::LookAt(const Vector3& worldPos, const Vector3& worldUp)
 
 Quaternion Actor::LookingAt(const Vector3& worldPos) const
 {
-    const Vector3 direction = worldPos - _transform.Translation;
+    const Vector3 direction = worldPos - GetTransform().Translation;
     if (direction.LengthSquared() < ZeroTolerance)
         return _parent->GetOrientation();
 
     const Float3 newForward = Vector3::Normalize(direction);
-    const Float3 oldForward = _transform.Orientation * Vector3::Forward;
+    const Float3 oldForward = GetTransform().Orientation * Vector3::Forward;
 
     Quaternion orientation;
     if ((newForward + oldForward).LengthSquared() < 0.00005f)
     {
         // 180 degree turn (infinite possible rotation axes)
         // Default to yaw i.e. use current Up
-        orientation = Quaternion(-_transform.Orientation.Y, -_transform.Orientation.Z, _transform.Orientation.W, _transform.Orientation.X);
+        orientation = Quaternion(-GetTransform().Orientation.Y, -GetTransform().Orientation.Z, GetTransform().Orientation.W, GetTransform().Orientation.X);
     }
     else
     {
         // Derive shortest arc to new direction
         Quaternion rotQuat;
         Quaternion::GetRotationFromTo(oldForward, newForward, rotQuat, Float3::Zero);
-        orientation = rotQuat * _transform.Orientation;
+        orientation = rotQuat * GetTransform().Orientation;
     }
 
     return orientation;
@@ -1552,7 +1648,7 @@ Quaternion Actor::LookingAt(const Vector3& worldPos) const
 
 Quaternion Actor::LookingAt(const Vector3& worldPos, const Vector3& worldUp) const
 {
-    const Vector3 direction = worldPos - _transform.Translation;
+    const Vector3 direction = worldPos - GetTransform().Translation;
     if (direction.LengthSquared() < ZeroTolerance)
         return _parent->GetOrientation();
     const Float3 forward = Vector3::Normalize(direction);
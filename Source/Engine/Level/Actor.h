@@ -39,6 +39,8 @@ API_CLASS(Abstract) class FLAXENGINE_API Actor : public SceneObject
     uint16 _isEnabled : 1;
     uint16 _drawNoCulling : 1;
     uint16 _drawCategory : 4;
+    uint16 _isTransformDirty : 1; // Actor transform was modified and it's waiting for the update (see Level::DeferTransformUpdates)
+    uint16 _isTransformStale : 1; // World transform is outdated and has to be resolved from the parent on access
     byte _layer;
     StaticFlags _staticFlags;
     Transform _localTransform;
@@ -456,6 +458,8 @@ API_CLASS(Abstract) class FLAXENGINE_API Actor : public SceneObject
     API_PROPERTY(Attributes="HideInEditor, NoSerialize")
     FORCE_INLINE const Transform& GetTransform() const
     {
+        if (_isTransformStale)
+            ResolveTransform();
         return _transform;
     }
 
@@ -471,6 +475,8 @@ API_CLASS(Abstract) class FLAXENGINE_API Actor : public SceneObject
     API_PROPERTY(Attributes="HideInEditor, NoSerialize")
     FORCE_INLINE Vector3 GetPosition() const
     {
+        if (_isTransformStale)
+            ResolveTransform();
         return _transform.Translation;
     }
 
@@ -486,6 +492,8 @@ API_CLASS(Abstract) class FLAXENGINE_API Actor : public SceneObject
     API_PROPERTY(Attributes="HideInEditor, NoSerialize")
     FORCE_INLINE Quaternion GetOrientation() const
     {
+        if (_isTransformStale)
+            ResolveTransform();
         return _transform.Orientation;
     }
 
@@ -501,6 +509,8 @@ API_CLASS(Abstract) class FLAXENGINE_API Actor : public SceneObject
     API_PROPERTY(Attributes="HideInEditor, NoSerialize")
     FORCE_INLINE Float3 GetScale() const
     {
+        if (_isTransformStale)
+            ResolveTransform();
         return _transform.Scale;
     }
 
@@ -1051,6 +1061,10 @@ API_CLASS(Abstract) class FLAXENGINE_API Actor : public SceneObject
     }
 
 private:
+    void InvalidateTransform();
+    void MarkTransformStale();
+    void ResolveTransform() const;
+    static void FlushTransforms();
     void SetSceneInHierarchy(Scene* scene);
     void OnEnableInHierarchy();
     void OnDisableInHierarchy();
@@ -5,18 +5,28 @@
 #include "Engine/Core/Math/Matrix3x4.h"
 #include "Engine/Threading/Threading.h"
 #include "Engine/Animations/Animations.h"
+#include "Engine/Animations/BakedSkinnedAnimation.h"
 #include "Engine/Engine/Engine.h"
+#include "Engine/Engine/Time.h"
 #if USE_EDITOR
 #include "Editor/Editor.h"
 #endif
 #include "Engine/Graphics/GPUContext.h"
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Graphics/RenderTask.h"
+#include "Engine/Graphics/RenderTools.h"
 #include "Engine/Graphics/Models/MeshDeformation.h"
 #include "Engine/Level/Scene/Scene.h"
 #include "Engine/Level/SceneObjectsFactory.h"
 #include "Engine/Serialization/Serialization.h"
 
+namespace
+{
+    // Models that evaluate the shared pose (per skinned model, animation graph and pose sharing group)
+    typedef Pair<Pair<SkinnedModel*, AnimationGraph*>, int32> SharedPoseKey;
+    Dictionary<SharedPoseKey, AnimatedModel*> SharedPoses;
+}
+
 AnimatedModel::AnimatedModel(const SpawnParams& params)
     : ModelInstanceActor(params)
     , _actualMode(AnimationUpdateMode::Never)
@@ -54,7 +64,8 @@ void AnimatedModel::UpdateAnimation()
         || SkinnedModel == nullptr
         || !SkinnedModel->IsLoaded()
         || _lastUpdateFrame == Engine::FrameCount
-        || _masterPose)
+        || _masterPose
+        || _sharedPose)
         return;
     _lastUpdateFrame = Engine::FrameCount;
 
@@ -709,6 +720,7 @@ void AnimatedModel::OnEnable()
 void AnimatedModel::OnDisable()
 {
     GetScene()->Ticking.Update.RemoveTick(this);
+    ReleaseSharedPose();
 
     // Base
     ModelInstanceActor::OnDisable();
@@ -759,6 +771,76 @@ void AnimatedModel::UpdateBounds()
         GetSceneRendering()->UpdateActor(this, _sceneRenderingKey);
 }
 
+void AnimatedModel::UpdateSharedPose()
+{
+    if (!SharePose || !SkinnedModel || !AnimationGraph || _masterPose)
+    {
+        if (_sharedPose || SharePose)
+            ReleaseSharedPose();
+        return;
+    }
+    const SharedPoseKey key(ToPair(SkinnedModel.Get(), AnimationGraph.Get()), SharePoseGroup);
+    AnimatedModel* owner;
+    if (SharedPoses.TryGet(key, owner))
+    {
+        if (owner == this)
+            return;
+
+        // Validate the owner (it might have changed the model or graph since registering)
+        if (owner->SharePose && owner->SkinnedModel == SkinnedModel && owner->AnimationGraph == AnimationGraph && owner->SharePoseGroup == SharePoseGroup && !owner->_masterPose)
+        {
+            // Use pose from the owner
+            if (_sharedPose != owner)
+            {
+                ReleaseSharedPose();
+                _sharedPose = owner;
+            }
+            return;
+        }
+    }
+
+    // Evaluate the shared pose by this model
+    ReleaseSharedPose();
+    SharedPoses[key] = this;
+}
+
+void AnimatedModel::ReleaseSharedPose()
+{
+    _sharedPose = nullptr;
+    for (auto it = SharedPoses.Begin(); it.IsNotEnd(); ++it)
+    {
+        if (it->Value == this)
+        {
+            SharedPoses.Remove(it);
+            break;
+        }
+    }
+}
+
+SkinnedMeshDrawData& AnimatedModel::GetDrawSkinningData()
+{
+    AnimatedModel* owner = _sharedPose.Get();
+    if (owner)
+    {
+        // Propagate the visibility to the model that evaluates the shared pose (used by the animation updates throttling)
+        owner->_lastMinDstSqr = Math::Min(owner->_lastMinDstSqr, _lastMinDstSqr);
+        owner->_lastMaxScreenSize = Math::Max(owner->_lastMaxScreenSize, _lastMaxScreenSize);
+    }
+    else
+    {
+        owner = this;
+    }
+    if (owner->_isDistant)
+    {
+        // Use the baked animation frame (with a random offset per instance)
+        const BakedSkinnedAnimation* baked = BakedSkinnedAnimation::Get(SkinnedModel, owner->DistantAnimation, false);
+        SkinnedMeshDrawData* frame = baked ? baked->GetFrame(owner->_distantTime + GetPerInstanceRandom() * baked->Length) : nullptr;
+        if (frame)
+            return *frame;
+    }
+    return owner->_skinningData;
+}
+
 void AnimatedModel::UpdateSockets()
 {
     for (int32 i = 0; i < Children.Count(); i++)
@@ -769,10 +851,16 @@ void AnimatedModel::UpdateSockets()
     }
 }
 
-void AnimatedModel::OnAnimationUpdated_Async()
+void AnimatedModel::OnAnimationUpdated_Async(bool interpolate)
 {
     // Update asynchronous stuff
     const auto& skeleton = SkinnedModel->Skeleton;
+    if (GraphInstance.RootMotionOnly && !_masterPose)
+    {
+        // Reduced evaluation doesn't update the nodes pose
+        _interpolationData.Clear();
+        return;
+    }
 
     // Copy pose from the master
     // TODO: support retargetting master pose to current pose
@@ -789,9 +877,30 @@ void AnimatedModel::OnAnimationUpdated_Async()
     {
         ANIM_GRAPH_PROFILE_EVENT("Final Pose");
         const int32 bonesCount = skeleton.Bones.Count();
+        const int32 dataSize = _skinningData.Data.Count();
         Matrix3x4* output = (Matrix3x4*)_skinningData.Data.Get();
         ASSERT(GraphInstance.NodesPose.Count() == skeleton.Nodes.Count());
-        ASSERT(_skinningData.Data.Count() == bonesCount * sizeof(Matrix3x4));
+        ASSERT(dataSize == bonesCount * sizeof(Matrix3x4));
+        bool interpolationReset = false;
+        if (interpolate)
+        {
+            // Output the new pose as the interpolation target and start from the previous one
+            if (_interpolationData.Count() != dataSize * 2)
+            {
+                _interpolationData.Resize(dataSize * 2, false);
+                interpolationReset = true;
+            }
+            else
+            {
+                Platform::MemoryCopy(_interpolationData.Get(), _interpolationData.Get() + dataSize, dataSize);
+            }
+            output = (Matrix3x4*)(_interpolationData.Get() + dataSize);
+            _framesSinceUpdate = 0;
+        }
+        else
+        {
+            _interpolationData.Clear();
+        }
         for (int32 boneIndex = 0; boneIndex < bonesCount; boneIndex++)
         {
             const SkeletonBone& bone = skeleton.Bones[boneIndex];
@@ -799,6 +908,12 @@ void AnimatedModel::OnAnimationUpdated_Async()
             Matrix::Multiply(bone.OffsetMatrix, GraphInstance.NodesPose.Get()[bone.NodeIndex], matrix);
             output[boneIndex].SetMatrixTranspose(matrix);
         }
+        if (interpolate)
+        {
+            if (interpolationReset)
+                Platform::MemoryCopy(_interpolationData.Get(), output, dataSize);
+            Platform::MemoryCopy(_skinningData.Data.Get(), _interpolationData.Get(), dataSize);
+        }
         _skinningData.OnDataChanged(!PerBoneMotionBlur);
     }
 
@@ -822,7 +937,9 @@ void AnimatedModel::OnAnimationUpdated_Sync()
 void AnimatedModel::OnAnimationUpdated()
 {
     ANIM_GRAPH_PROFILE_EVENT("OnAnimationUpdated");
-    OnAnimationUpdated_Async();
+
+    // Pose copied from the master model follows its interpolation
+    OnAnimationUpdated_Async(_masterPose && _masterPose->_interpolationData.HasItems() && InterpolateUpdates);
     OnAnimationUpdated_Sync();
 }
 
@@ -866,42 +983,115 @@ bool AnimatedModel::HasContentLoaded() const
 
 void AnimatedModel::Update()
 {
+    UpdateSharedPose();
+    if (_sharedPose)
+    {
+        // Pose is evaluated by the other model (it gets the visibility of this model during drawing)
+        _actualMode = AnimationUpdateMode::Manual;
+        _lastMinDstSqr = MAX_Real;
+        _lastMaxScreenSize = 0.0f;
+        return;
+    }
+
+    // Play the baked animation when far from the view
+    _isDistant = DistantAnimationDistance > 0.0f && DistantAnimation && _lastMinDstSqr < MAX_Real && _lastMinDstSqr >= Math::Square((Real)DistantAnimationDistance) && BakedSkinnedAnimation::Get(SkinnedModel, DistantAnimation);
+    if (_isDistant)
+    {
+        _distantTime += Time::Update.DeltaTime.GetTotalSeconds() * UpdateSpeed;
+        _actualMode = AnimationUpdateMode::Manual;
+        _lastMinDstSqr = MAX_Real;
+        _updatePriority = _lastMaxScreenSize;
+        _lastMaxScreenSize = 0.0f;
+        return;
+    }
+
     // Update the mode
     _actualMode = UpdateMode;
+    const bool reducedOffscreen = ReducedUpdateWhenOffscreen && !UpdateWhenOffscreen && _lastMinDstSqr >= MAX_Real;
+    int32 nodesLOD = 0;
     if (_actualMode == AnimationUpdateMode::Auto)
     {
         // TODO: handle low performance platforms
 
-        if (_lastMinDstSqr < 3000.0f * 3000.0f)
-            _actualMode = AnimationUpdateMode::EveryUpdate;
-        else if (_lastMinDstSqr < 6000.0f * 6000.0f)
-            _actualMode = AnimationUpdateMode::EverySecondUpdate;
-        else if (_lastMinDstSqr < 10000.0f * 10000.0f)
-            _actualMode = AnimationUpdateMode::EveryFourthUpdate;
+        // Throttle updates and skip animating the leaf nodes based on the model size on the screen
+        const float screenSize = _lastMaxScreenSize;
+        if (screenSize >= 0.25f)
+        {
+            _updateRate = 1;
+        }
+        else if (screenSize >= 0.1f)
+        {
+            _updateRate = 2;
+        }
+        else if (screenSize >= 0.04f)
+        {
+            _updateRate = 4;
+            nodesLOD = 1;
+        }
+        else if (screenSize >= 0.01f || (screenSize <= 0.0f && UpdateWhenOffscreen))
+        {
+            _updateRate = 8;
+            nodesLOD = 2;
+        }
+        else if (reducedOffscreen)
+        {
+            _updateRate = 4;
+        }
         else
+        {
+            _updateRate = 0;
             _actualMode = AnimationUpdateMode::Manual;
+        }
+    }
+    else
+    {
+        switch (_actualMode)
+        {
+        case AnimationUpdateMode::EveryFourthUpdate:
+            _updateRate = 4;
+            break;
+        case AnimationUpdateMode::EverySecondUpdate:
+            _updateRate = 2;
+            break;
+        case AnimationUpdateMode::EveryUpdate:
+            _updateRate = 1;
+            break;
+        default:
+            _updateRate = 0;
+            break;
+        }
+    }
+    if (_masterPose)
+    {
+        // Pose is copied from the master model
+        _updateRate = _masterPose->_updateRate;
     }
+    GraphInstance.NodesLOD = nodesLOD;
 
     // Check if update during this tick
-    bool updateAnim = false;
-    switch (_actualMode)
+    const bool updateAnim = _updateRate > 0 && !_masterPose && _counter++ % _updateRate == 0;
+    if (updateAnim && (UpdateWhenOffscreen || _lastMinDstSqr < MAX_Real || reducedOffscreen))
     {
-    case AnimationUpdateMode::EveryFourthUpdate:
-        updateAnim = _counter++ % 4 == 0;
-        break;
-    case AnimationUpdateMode::EverySecondUpdate:
-        updateAnim = _counter++ % 2 == 0;
-        break;
-    case AnimationUpdateMode::EveryUpdate:
-        updateAnim = true;
-        break;
-    default:
-        break;
-    }
-    if (updateAnim && (UpdateWhenOffscreen || _lastMinDstSqr < MAX_Real))
+        GraphInstance.RootMotionOnly = reducedOffscreen;
         UpdateAnimation();
+    }
+    else if (_interpolationData.HasItems() && _framesSinceUpdate < _updateRate && _interpolationData.Count() == _skinningData.Data.Count() * 2)
+    {
+        // Interpolate the pose between the last two animation updates
+        _framesSinceUpdate++;
+        const float alpha = (float)_framesSinceUpdate / (float)_updateRate;
+        const int32 count = _skinningData.Data.Count() / sizeof(float);
+        const float* start = (const float*)_interpolationData.Get();
+        const float* target = start + count;
+        float* output = (float*)_skinningData.Data.Get();
+        for (int32 i = 0; i < count; i++)
+            output[i] = Math::Lerp(start[i], target[i], alpha);
+        _skinningData.OnDataChanged(!PerBoneMotionBlur);
+    }
 
     _lastMinDstSqr = MAX_Real;
+    _updatePriority = _lastMaxScreenSize;
+    _lastMaxScreenSize = 0.0f;
 }
 
 void AnimatedModel::Draw(RenderContext& renderContext)
@@ -918,19 +1108,23 @@ void AnimatedModel::Draw(RenderContext& renderContext)
     GEOMETRY_DRAW_STATE_EVENT_BEGIN(_drawState, world);
 
     _lastMinDstSqr = Math::Min(_lastMinDstSqr, Vector3::DistanceSquared(_transform.Translation, renderContext.View.WorldPosition));
-    if (_skinningData.IsReady())
+    if (EnumHasAnyFlags(renderContext.View.Pass, DrawPass::GBuffer | DrawPass::Forward))
+        _lastMaxScreenSize = Math::Max(_lastMaxScreenSize, Math::Sqrt(RenderTools::ComputeBoundsScreenRadiusSquared(_sphere.Center - renderContext.View.Origin, (float)_sphere.Radius, renderContext.View)) * 2.0f);
+    SkinnedMeshDrawData& skinningData = GetDrawSkinningData();
+    if (skinningData.IsReady())
     {
         // Flush skinning data with GPU
-        if (_skinningData.IsDirty())
+        if (skinningData.IsDirty())
         {
             RenderContext::GPULocker.Lock();
-            GPUDevice::Instance->GetMainContext()->UpdateBuffer(_skinningData.BoneMatrices, _skinningData.Data.Get(), _skinningData.Data.Count());
+            GPUDevice::Instance->GetMainContext()->UpdateBuffer(skinningData.BoneMatrices, skinningData.Data.Get(), skinningData.Data.Count());
+            skinningData.OnFlush();
             RenderContext::GPULocker.Unlock();
         }
 
         SkinnedMesh::DrawInfo draw;
         draw.Buffer = &Entries;
-        draw.Skinning = &_skinningData;
+        draw.Skinning = &skinningData;
         draw.World = &world;
         draw.DrawState = &_drawState;
         draw.Deformation = _deformation;
@@ -961,19 +1155,22 @@ void AnimatedModel::Draw(RenderContextBatch& renderContextBatch)
     GEOMETRY_DRAW_STATE_EVENT_BEGIN(_drawState, world);
 
     _lastMinDstSqr = Math::Min(_lastMinDstSqr, Vector3::DistanceSquared(_transform.Translation, renderContext.View.WorldPosition));
-    if (_skinningData.IsReady())
+    _lastMaxScreenSize = Math::Max(_lastMaxScreenSize, Math::Sqrt(RenderTools::ComputeBoundsScreenRadiusSquared(_sphere.Center - renderContext.View.Origin, (float)_sphere.Radius, renderContext.View)) * 2.0f);
+    SkinnedMeshDrawData& skinningData = GetDrawSkinningData();
+    if (skinningData.IsReady())
     {
         // Flush skinning data with GPU
-        if (_skinningData.IsDirty())
+        if (skinningData.IsDirty())
         {
             RenderContext::GPULocker.Lock();
-            GPUDevice::Instance->GetMainContext()->UpdateBuffer(_skinningData.BoneMatrices, _skinningData.Data.Get(), _skinningData.Data.Count());
+            GPUDevice::Instance->GetMainContext()->UpdateBuffer(skinningData.BoneMatrices, skinningData.Data.Get(), skinningData.Data.Count());
+            skinningData.OnFlush();
             RenderContext::GPULocker.Unlock();
         }
 
         SkinnedMesh::DrawInfo draw;
         draw.Buffer = &Entries;
-        draw.Skinning = &_skinningData;
+        draw.Skinning = &skinningData;
         draw.World = &world;
         draw.DrawState = &_drawState;
         draw.Deformation = _deformation;
@@ -1054,6 +1251,12 @@ void AnimatedModel::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE(UpdateWhenOffscreen);
     SERIALIZE(UpdateSpeed);
     SERIALIZE(UpdateMode);
+    SERIALIZE(InterpolateUpdates);
+    SERIALIZE(ReducedUpdateWhenOffscreen);
+    SERIALIZE(SharePose);
+    SERIALIZE(SharePoseGroup);
+    SERIALIZE(DistantAnimation);
+    SERIALIZE(DistantAnimationDistance);
     SERIALIZE(BoundsScale);
     SERIALIZE(CustomBounds);
     SERIALIZE(LODBias);
@@ -1081,6 +1284,12 @@ void AnimatedModel::Deserialize(DeserializeStream& stream, ISerializeModifier* m
     DESERIALIZE(UpdateWhenOffscreen);
     DESERIALIZE(UpdateSpeed);
     DESERIALIZE(UpdateMode);
+    DESERIALIZE(InterpolateUpdates);
+    DESERIALIZE(ReducedUpdateWhenOffscreen);
+    DESERIALIZE(SharePose);
+    DESERIALIZE(SharePoseGroup);
+    DESERIALIZE(DistantAnimation);
+    DESERIALIZE(DistantAnimationDistance);
     DESERIALIZE(BoundsScale);
     DESERIALIZE(CustomBounds);
     DESERIALIZE(LODBias);
@@ -16,6 +16,7 @@ API_CLASS(Attributes="ActorContextMenu(\"New/Other/Animated Model\"), ActorToolb
 class FLAXENGINE_API AnimatedModel : public ModelInstanceActor
 {
     DECLARE_SCENE_OBJECT(AnimatedModel);
+    friend class Animations;
     friend class AnimationsSystem;
 
     /// <summary>
@@ -24,7 +25,7 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor
     API_ENUM() enum class AnimationUpdateMode
     {
         /// <summary>
-        /// The automatic updates will be used (based on platform capabilities, distance to the player, etc.).
+        /// The automatic updates will be used (based on platform capabilities, size of the model on the screen, etc.). Small models are updated less frequently and skip the animation of the nodes close to the skeleton hierarchy leaves (eg. fingers).
         /// </summary>
         Auto = 0,
 
@@ -67,10 +68,19 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor
     AnimationUpdateMode _actualMode;
     uint32 _counter;
     Real _lastMinDstSqr;
+    float _lastMaxScreenSize = 0.0f;
+    float _updatePriority = 0.0f;
+    int32 _updateRate = 0;
+    int32 _framesSinceUpdate = 0;
     bool _isDuringUpdateEvent = false;
+    bool _isQueuedForUpdate = false;
     uint64 _lastUpdateFrame;
+    Array<byte> _interpolationData; // Skinning data from the last two animation updates (start followed by the target) used to interpolate the pose between the throttled updates
     mutable MeshDeformation* _deformation = nullptr;
     ScriptingObjectReference<AnimatedModel> _masterPose;
+    ScriptingObjectReference<AnimatedModel> _sharedPose;
+    bool _isDistant = false;
+    float _distantTime = 0.0f;
     Array<Pair<String, float>> _blendShapeWeights;
     Array<BlendShapeMesh> _blendShapeMeshes;
 
@@ -107,6 +117,12 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor
     API_FIELD(Attributes="EditorOrder(40), DefaultValue(false), EditorDisplay(\"Skinned Model\")")
     bool UpdateWhenOffscreen = false;
 
+    /// <summary>
+    /// If checked, the model that is not visible (and doesn't update when offscreen) still updates the animation in the reduced mode: only the state machines, root motion and animation events are evaluated (without sampling and blending the whole pose and without updating the skinning). Useful for invisible characters that still need to move and receive animation events.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(41), DefaultValue(false), EditorDisplay(\"Skinned Model\")")
+    bool ReducedUpdateWhenOffscreen = false;
+
     /// <summary>
     /// The animation update delta time scale. Can be used to speed up animation playback or create slow motion effect.
     /// </summary>
@@ -119,6 +135,36 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor
     API_FIELD(Attributes="EditorOrder(50), DefaultValue(AnimationUpdateMode.Auto), EditorDisplay(\"Skinned Model\")")
     AnimationUpdateMode UpdateMode = AnimationUpdateMode::Auto;
 
+    /// <summary>
+    /// If checked, the skinned mesh pose will be interpolated between the animation updates when the animation is not updated every game update (see UpdateMode). Makes the throttled animations smooth at cost of a small latency (the pose lags behind by one update).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(55), DefaultValue(true), EditorDisplay(\"Skinned Model\")")
+    bool InterpolateUpdates = true;
+
+    /// <summary>
+    /// If checked, the animated models that use the same skinned model, animation graph and pose sharing group will share a single pose (animation is evaluated only for one of them and the bones buffer is shared on GPU). Useful for large crowds of background characters. Gameplay changes to the pose, root motion, sockets and animation events are handled only by the model that owns the shared pose.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(56), DefaultValue(false), EditorDisplay(\"Skinned Model\")")
+    bool SharePose = false;
+
+    /// <summary>
+    /// The pose sharing group. Models with pose sharing enabled share the pose only within the same group (eg. to use a few different poses for the crowd made of the same characters).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(57), DefaultValue(0), EditorDisplay(\"Skinned Model\"), VisibleIf(nameof(SharePose))")
+    int32 SharePoseGroup = 0;
+
+    /// <summary>
+    /// The animation to play when the model is further from the view than the distant animation distance. It's baked into the bone matrices (see BakedSkinnedAnimation) and played on the GPU without updating the animation graph. All distant instances that show the same frame are drawn with instancing.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(58), DefaultValue(null), EditorDisplay(\"Skinned Model\")")
+    AssetReference<Animation> DistantAnimation;
+
+    /// <summary>
+    /// The distance from the view at which the model switches to the baked distant animation. Use 0 to disable it.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(59), DefaultValue(0.0f), Limit(0), EditorDisplay(\"Skinned Model\")")
+    float DistantAnimationDistance = 0.0f;
+
     /// <summary>
     /// The master scale parameter for the actor bounding box. Helps reducing mesh flickering effect on screen edges.
     /// </summary>
@@ -398,8 +444,11 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor
     void RunBlendShapeDeformer(const MeshBase* mesh, struct MeshDeformationData& deformation);
 
     void Update();
+    void UpdateSharedPose();
+    void ReleaseSharedPose();
+    SkinnedMeshDrawData& GetDrawSkinningData();
     void UpdateSockets();
-    void OnAnimationUpdated_Async();
+    void OnAnimationUpdated_Async(bool interpolate = false);
     void OnAnimationUpdated_Sync();
     void OnAnimationUpdated();
 
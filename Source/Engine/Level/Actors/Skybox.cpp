@@ -117,11 +117,14 @@ void Skybox::ApplySky(GPUContext* context, RenderContext& renderContext, const M
         auto material = _proxyMaterial.Get();
         if (material && material->IsReady())
         {
-            // TODO: optimize materials binding -> cache them
-            material->SetParameterValue(TEXT("CubeTexture"), CubeTexture.Get(), false);
-            material->SetParameterValue(TEXT("PanoramicTexture"), PanoramicTexture.Get(), false);
-            material->SetParameterValue(TEXT("Color"), Color * Math::Exp2(Exposure), false);
-            material->SetParameterValue(TEXT("IsPanoramic"), PanoramicTexture != nullptr, false);
+            static StringName CubeTextureParamName(TEXT("CubeTexture"));
+            static StringName PanoramicTextureParamName(TEXT("PanoramicTexture"));
+            static StringName ColorParamName(TEXT("Color"));
+            static StringName IsPanoramicParamName(TEXT("IsPanoramic"));
+            material->SetParameterValue(CubeTextureParamName, CubeTexture.Get(), false);
+            material->SetParameterValue(PanoramicTextureParamName, PanoramicTexture.Get(), false);
+            material->SetParameterValue(ColorParamName, Color * Math::Exp2(Exposure), false);
+            material->SetParameterValue(IsPanoramicParamName, PanoramicTexture != nullptr, false);
             material->Bind(bindParams);
         }
     }
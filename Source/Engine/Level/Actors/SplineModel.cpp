@@ -16,12 +16,45 @@
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Renderer/DrawCall.h"
 #include "Engine/Renderer/RenderList.h"
+#include "Engine/Renderer/Utils/SplineDeformation.h"
 #if USE_EDITOR
 #include "Editor/Editor.h"
 #endif
 
 #define SPLINE_RESOLUTION 32.0f
 
+namespace
+{
+    void EvaluateChunk(const Transform& start, const Transform& leftTangent, const Transform& rightTangent, const Transform& end, float alpha, Matrix& result)
+    {
+        // Evaluate transformation at the curve
+        Transform transform;
+        AnimationUtils::Bezier(start, leftTangent, rightTangent, end, alpha, transform);
+
+        // Apply spline direction (from position 1st derivative)
+        Vector3 direction;
+        AnimationUtils::BezierFirstDerivative(start.Translation, leftTangent.Translation, rightTangent.Translation, end.Translation, alpha, direction);
+        direction.Normalize();
+        Quaternion orientation;
+        if (direction.IsZero())
+            orientation = Quaternion::Identity;
+        else if (Vector3::Dot(direction, Vector3::Up) >= 0.999f)
+            Quaternion::RotationAxis(Vector3::Left, PI_HALF, orientation);
+        else
+            Quaternion::LookRotation(direction, Vector3::Cross(Vector3::Cross(direction, Vector3::Up), direction), orientation);
+        transform.Orientation = orientation * transform.Orientation;
+        transform.GetWorld(result);
+    }
+
+    void WriteControlPoint(Float4*& ptr, const Transform& transform, int32 segment)
+    {
+        // Layout must match SplineDeformation shader
+        *ptr++ = Float4(Float3(transform.Translation), (float)segment);
+        *ptr++ = Float4(transform.Orientation.X, transform.Orientation.Y, transform.Orientation.Z, transform.Orientation.W);
+        *ptr++ = Float4(transform.Scale, 0.0f);
+    }
+}
+
 SplineModel::SplineModel(const SpawnParams& params)
     : ModelInstanceActor(params)
 {
@@ -33,8 +66,6 @@ SplineModel::SplineModel(const SpawnParams& params)
 SplineModel::~SplineModel()
 {
     SAFE_DELETE_GPU_RESOURCE(_deformationBuffer);
-    if (_deformationBufferData)
-        Allocator::Free(_deformationBufferData);
 }
 
 Transform SplineModel::GetPreTransform() const
@@ -229,97 +260,111 @@ void SplineModel::UpdateDeformationBuffer()
     const int32 chunksPerSegment = Math::Clamp(Math::CeilToInt(SPLINE_RESOLUTION * _quality), 2, 1024);
     const int32 count = (chunksPerSegment * segments + 1) * 3;
     const uint32 size = count * sizeof(Float4);
-    if (_deformationBuffer->GetSize() != size)
+    auto splineDeformation = SplineDeformation::Instance();
+    const bool useCompute = splineDeformation->CanDeform();
+    bool fullUpdate = _deformationKeyframes.Count() != keyframes.Count() || !Math::NearEqual(_chunksPerSegment, (float)chunksPerSegment);
+    if (_deformationBuffer->GetSize() != size || (useCompute && !_deformationBuffer->IsUnorderedAccess()))
     {
-        if (_deformationBufferData)
-        {
-            Allocator::Free(_deformationBufferData);
-            _deformationBufferData = nullptr;
-        }
-        if (_deformationBuffer->Init(GPUBufferDescription::Typed(count, PixelFormat::R32G32B32A32_Float, false, IsTransformStatic() ? GPUResourceUsage::Default : GPUResourceUsage::Dynamic)))
+        // Use default usage to support partial updates of the modified segments
+        if (_deformationBuffer->Init(GPUBufferDescription::Typed(count, PixelFormat::R32G32B32A32_Float, useCompute)))
         {
             LOG(Error, "Failed to initialize the spline model {0} deformation buffer.", ToString());
+            _deformationKeyframes.Clear();
             return;
         }
+        fullUpdate = true;
     }
-    if (!_deformationBufferData)
-        _deformationBufferData = Allocator::Allocate(size);
     _chunksPerSegment = (float)chunksPerSegment;
 
-    // Update pre-calculated matrices for spline chunks
-    auto ptr = (Matrix3x4*)_deformationBufferData;
-    const float chunksPerSegmentInv = 1.0f / (float)chunksPerSegment;
-    Matrix m;
-    Transform transform, leftTangent, rightTangent;
+    // Find segments modified since the last update (each segment depends only on its start and end keyframes)
+    Array<int32, InlinedAllocation<64>> dirtySegments;
     for (int32 segment = 0; segment < segments; segment++)
     {
-        auto& instance = _instances[segment];
-        const auto& start = keyframes[segment];
-        const auto& end = keyframes[segment + 1];
-        const float length = end.Time - start.Time;
-        AnimationUtils::GetTangent(start.Value, start.TangentOut, length, leftTangent);
-        AnimationUtils::GetTangent(end.Value, end.TangentIn, length, rightTangent);
-        for (int32 chunk = 0; chunk < chunksPerSegment; chunk++)
+        if (fullUpdate ||
+            Platform::MemoryCompare(&keyframes[segment], &_deformationKeyframes[segment], sizeof(BezierCurveKeyframe<Transform>)) != 0 ||
+            Platform::MemoryCompare(&keyframes[segment + 1], &_deformationKeyframes[segment + 1], sizeof(BezierCurveKeyframe<Transform>)) != 0)
+            dirtySegments.Add(segment);
+    }
+    _deformationKeyframes.Set(keyframes.Get(), keyframes.Count());
+    if (dirtySegments.IsEmpty())
+        return;
+    auto context = GPUDevice::Instance->GetMainContext();
+    Matrix m;
+    Transform leftTangent, rightTangent;
+
+    // Evaluate chunk matrices on a GPU by uploading only the control points of the modified segments
+    if (useCompute)
+    {
+        _deformationData.Resize(dirtySegments.Count() * SplineDeformation::SegmentStride, false);
+        Float4* ptr = _deformationData.Get();
+        for (const int32 segment : dirtySegments)
+        {
+            const auto& start = keyframes[segment];
+            const auto& end = keyframes[segment + 1];
+            const float length = end.Time - start.Time;
+            AnimationUtils::GetTangent(start.Value, start.TangentOut, length, leftTangent);
+            AnimationUtils::GetTangent(end.Value, end.TangentIn, length, rightTangent);
+            WriteControlPoint(ptr, start.Value, segment);
+            WriteControlPoint(ptr, leftTangent, segment);
+            WriteControlPoint(ptr, rightTangent, segment);
+            WriteControlPoint(ptr, end.Value, segment);
+
+            // Segment end orientation is used to pick the triangles winding
+            EvaluateChunk(start.Value, leftTangent, rightTangent, end.Value, 1.0f, m);
+            _instances[segment].RotDeterminant = m.RotDeterminant();
+        }
+        if (!splineDeformation->Deform(context, _deformationBuffer, _deformationData.Get(), dirtySegments.Count(), chunksPerSegment, segments))
         {
-            const float alpha = (chunk == chunksPerSegment - 1) ? 1.0f : ((float)chunk * chunksPerSegmentInv);
-
-            // Evaluate transformation at the curve
-            AnimationUtils::Bezier(start.Value, leftTangent, rightTangent, end.Value, alpha, transform);
-
-            // Apply spline direction (from position 1st derivative)
-            Vector3 direction;
-            AnimationUtils::BezierFirstDerivative(start.Value.Translation, leftTangent.Translation, rightTangent.Translation, end.Value.Translation, alpha, direction);
-            direction.Normalize();
-            Quaternion orientation;
-            if (direction.IsZero())
-                orientation = Quaternion::Identity;
-            else if (Vector3::Dot(direction, Vector3::Up) >= 0.999f)
-                Quaternion::RotationAxis(Vector3::Left, PI_HALF, orientation);
-            else
-                Quaternion::LookRotation(direction, Vector3::Cross(Vector3::Cross(direction, Vector3::Up), direction), orientation);
-            transform.Orientation = orientation * transform.Orientation;
-
-            // Write transform into deformation buffer
-            transform.GetWorld(m);
-            ptr->SetMatrixTranspose(m);
-            ptr++;
+            if (IsTransformStatic())
+                _deformationData.SetCapacity(0, false);
+            return;
         }
-        instance.RotDeterminant = m.RotDeterminant();
     }
 
-    // Add last transformation to prevent issues when sampling spline deformation buffer with alpha=1
+    // Update pre-calculated matrices for continuous ranges of the modified spline chunks
+    const float chunksPerSegmentInv = 1.0f / (float)chunksPerSegment;
+    for (int32 i = 0; i < dirtySegments.Count();)
     {
-        const auto& start = keyframes[segments - 1];
-        const auto& end = keyframes[segments];
-        const float length = end.Time - start.Time;
-        const float alpha = 1.0f - ZeroTolerance; // Offset to prevent zero derivative at the end of the curve
-        AnimationUtils::GetTangent(start.Value, start.TangentOut, length, leftTangent);
-        AnimationUtils::GetTangent(end.Value, end.TangentIn, length, rightTangent);
-        AnimationUtils::Bezier(start.Value, leftTangent, rightTangent, end.Value, alpha, transform);
-        Vector3 direction;
-        AnimationUtils::BezierFirstDerivative(start.Value.Translation, leftTangent.Translation, rightTangent.Translation, end.Value.Translation, alpha, direction);
-        direction.Normalize();
-        Quaternion orientation;
-        if (direction.IsZero())
-            orientation = Quaternion::Identity;
-        else if (Vector3::Dot(direction, Vector3::Up) >= 0.999f)
-            Quaternion::RotationAxis(Vector3::Left, PI_HALF, orientation);
-        else
-            Quaternion::LookRotation(direction, Vector3::Cross(Vector3::Cross(direction, Vector3::Up), direction), orientation);
-        transform.Orientation = orientation * transform.Orientation;
-        transform.GetWorld(m);
-        ptr->SetMatrixTranspose(m);
-    }
+        const int32 first = dirtySegments[i];
+        int32 last = first;
+        while (++i < dirtySegments.Count() && dirtySegments[i] == last + 1)
+            last++;
+        const int32 rangeCount = ((last - first + 1) * chunksPerSegment + (last == segments - 1 ? 1 : 0)) * 3;
+        _deformationData.Resize(rangeCount, false);
+        auto ptr = (Matrix3x4*)_deformationData.Get();
+        for (int32 segment = first; segment <= last; segment++)
+        {
+            auto& instance = _instances[segment];
+            const auto& start = keyframes[segment];
+            const auto& end = keyframes[segment + 1];
+            const float length = end.Time - start.Time;
+            AnimationUtils::GetTangent(start.Value, start.TangentOut, length, leftTangent);
+            AnimationUtils::GetTangent(end.Value, end.TangentIn, length, rightTangent);
+            for (int32 chunk = 0; chunk < chunksPerSegment; chunk++)
+            {
+                const float alpha = (chunk == chunksPerSegment - 1) ? 1.0f : ((float)chunk * chunksPerSegmentInv);
+                EvaluateChunk(start.Value, leftTangent, rightTangent, end.Value, alpha, m);
+                ptr->SetMatrixTranspose(m);
+                ptr++;
+            }
+            instance.RotDeterminant = m.RotDeterminant();
 
-    // Flush data with GPU
-    GPUDevice::Instance->GetMainContext()->UpdateBuffer(_deformationBuffer, _deformationBufferData, size);
+            // Add last transformation to prevent issues when sampling spline deformation buffer with alpha=1
+            if (segment == segments - 1)
+            {
+                const float alpha = 1.0f - ZeroTolerance; // Offset to prevent zero derivative at the end of the curve
+                EvaluateChunk(start.Value, leftTangent, rightTangent, end.Value, alpha, m);
+                ptr->SetMatrixTranspose(m);
+            }
+        }
+
+        // Flush data with GPU
+        context->UpdateBuffer(_deformationBuffer, _deformationData.Get(), rangeCount * sizeof(Float4), first * chunksPerSegment * 3 * sizeof(Float4));
+    }
 
     // Static splines are rarely updated so release scratch memory
     if (IsTransformStatic())
-    {
-        Allocator::Free(_deformationBufferData);
-        _deformationBufferData = nullptr;
-    }
+        _deformationData.SetCapacity(0, false);
 }
 
 void SplineModel::OnParentChanged()
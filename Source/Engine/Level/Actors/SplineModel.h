@@ -4,6 +4,7 @@
 
 #include "ModelInstanceActor.h"
 #include "Engine/Content/Assets/Model.h"
+#include "Engine/Animations/Curve.h"
 
 class Spline;
 
@@ -28,7 +29,8 @@ API_CLASS() class FLAXENGINE_API SplineModel : public ModelInstanceActor
     Transform _preTransform = Transform::Identity;
     Spline* _spline = nullptr;
     GPUBuffer* _deformationBuffer = nullptr;
-    void* _deformationBufferData = nullptr;
+    Array<Float4> _deformationData;
+    Array<BezierCurveKeyframe<Transform>> _deformationKeyframes;
     float _chunksPerSegment, _meshMinZ, _meshMaxZ;
 
 public:
@@ -18,6 +18,42 @@
 #include "Editor/Editor.h"
 #endif
 
+// Invalidates the cached draw calls of the static models on actors changes in the scene rendering (eg. transform or materials update)
+class StaticModelDrawCacheListener : public ISceneRenderingListener
+{
+public:
+    FORCE_INLINE static void Invalidate(Actor* a)
+    {
+        if (a->Is<StaticModel>())
+            ((StaticModel*)a)->_drawCache.Invalidate();
+    }
+
+    // [ISceneRenderingListener]
+    void OnSceneRenderingAddActor(Actor* a) override
+    {
+        Invalidate(a);
+    }
+
+    void OnSceneRenderingUpdateActor(Actor* a, const BoundingSphere& prevBounds) override
+    {
+        Invalidate(a);
+    }
+
+    void OnSceneRenderingRemoveActor(Actor* a) override
+    {
+        Invalidate(a);
+    }
+
+    void OnSceneRenderingClear(SceneRendering* scene) override
+    {
+    }
+};
+
+namespace
+{
+    StaticModelDrawCacheListener DrawCacheListener;
+}
+
 StaticModel::StaticModel(const SpawnParams& params)
     : ModelInstanceActor(params)
     , _scaleInLightmap(1.0f)
@@ -231,6 +267,7 @@ void StaticModel::OnModelChanged()
     }
     RemoveVertexColors();
     Entries.Release();
+    _drawCache.Clear();
     if (Model && !Model->IsLoaded())
         UpdateBounds();
     if (_deformation)
@@ -242,6 +279,7 @@ void StaticModel::OnModelChanged()
 void StaticModel::OnModelLoaded()
 {
     Entries.SetupIfInvalid(Model);
+    _drawCache.Invalidate();
     UpdateBounds();
     if (_sceneRenderingKey == -1 && _scene && _isActiveInHierarchy && _isEnabled && !_residencyChangedModel)
     {
@@ -357,6 +395,7 @@ void StaticModel::Draw(RenderContext& renderContext)
     draw.ForcedLOD = _forcedLod;
     draw.SortOrder = _sortOrder;
     draw.VertexColors = _vertexColorsCount ? _vertexColorsBuffer : nullptr;
+    draw.DrawCache = EnumHasAnyFlags(_staticFlags, StaticFlags::Transform) && !_deformation ? &_drawCache : nullptr;
 
     Model->Draw(renderContext, draw);
 
@@ -391,6 +430,7 @@ void StaticModel::Draw(RenderContextBatch& renderContextBatch)
     draw.ForcedLOD = _forcedLod;
     draw.SortOrder = _sortOrder;
     draw.VertexColors = _vertexColorsCount ? _vertexColorsBuffer : nullptr;
+    draw.DrawCache = EnumHasAnyFlags(_staticFlags, StaticFlags::Transform) && !_deformation ? &_drawCache : nullptr;
 
     Model->Draw(renderContextBatch, draw);
 
@@ -480,6 +520,7 @@ void StaticModel::Deserialize(DeserializeStream& stream, ISerializeModifier* mod
     DESERIALIZE_MEMBER(LightmapArea, Lightmap.UVsArea);
 
     Entries.DeserializeIfExists(stream, "Buffer", modifier);
+    _drawCache.Invalidate();
 
     {
         const auto member = stream.FindMember("VertexColors");
@@ -655,6 +696,9 @@ void StaticModel::OnEnable()
         }
     }
 
+    if (_scene)
+        DrawCacheListener.ListenSceneRendering(GetSceneRendering());
+
     // Skip ModelInstanceActor (add to SceneRendering manually)
     Actor::OnEnable();
 }
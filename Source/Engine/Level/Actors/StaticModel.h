@@ -4,6 +4,7 @@
 
 #include "ModelInstanceActor.h"
 #include "Engine/Content/Assets/Model.h"
+#include "Engine/Graphics/Models/ModelDrawCache.h"
 #include "Engine/Renderer/DrawCall.h"
 #include "Engine/Renderer/Lightmaps.h"
 
@@ -14,6 +15,7 @@ API_CLASS(Attributes="ActorContextMenu(\"New/Model\"), ActorToolbox(\"Visuals\")
 class FLAXENGINE_API StaticModel : public ModelInstanceActor
 {
     DECLARE_SCENE_OBJECT(StaticModel);
+    friend class StaticModelDrawCacheListener;
 private:
     GeometryDrawStateData _drawState;
     float _scaleInLightmap;
@@ -27,6 +29,7 @@ class FLAXENGINE_API StaticModel : public ModelInstanceActor
     GPUBuffer* _vertexColorsBuffer[MODEL_MAX_LODS];
     Model* _residencyChangedModel = nullptr;
     mutable MeshDeformation* _deformation = nullptr;
+    ModelDrawCache _drawCache;
 
 public:
     /// <summary>
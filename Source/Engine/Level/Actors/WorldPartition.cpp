@@ -0,0 +1,402 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "WorldPartition.h"
+#include "Camera.h"
+#include "StaticModel.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Level/Level.h"
+#include "Engine/Level/Scene/Scene.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Serialization/Serialization.h"
+#if USE_EDITOR
+#include "Engine/Content/Config.h"
+#include "Engine/ContentImporters/AssetsImportingManager.h"
+#include "Engine/Graphics/Models/ModelData.h"
+#include "Engine/Level/SceneQuery.h"
+#include "Engine/Tools/ModelTool/ModelTool.h"
+#endif
+
+namespace
+{
+    struct CellDistance
+    {
+        Real Distance;
+        int32 Index;
+
+        bool operator<(const CellDistance& other) const
+        {
+            return Distance < other.Distance;
+        }
+    };
+}
+
+WorldPartition::WorldPartition(const SpawnParams& params)
+    : Actor(params)
+{
+}
+
+int32 WorldPartition::GetLoadedCellsCount() const
+{
+    int32 result = 0;
+    for (const WorldPartitionCell& cell : Cells)
+    {
+        if (Level::FindScene(cell.Scene))
+            result++;
+    }
+    return result;
+}
+
+bool WorldPartition::IsCellLoaded(int32 index) const
+{
+    CHECK_RETURN(index >= 0 && index < Cells.Count(), false);
+    return Level::FindScene(Cells[index].Scene) != nullptr;
+}
+
+#if USE_EDITOR
+
+void WorldPartition::BuildCells()
+{
+    for (WorldPartitionCell& cell : Cells)
+    {
+        Scene* scene = Level::FindScene(cell.Scene);
+        if (!scene)
+        {
+            LOG(Warning, "Cannot build world partition cell {0} because scene is not loaded.", cell.Scene);
+            continue;
+        }
+        cell.Bounds = scene->GetBoxWithChildren();
+        Asset* asset = Content::GetAsset(cell.Scene);
+        cell.MemoryUsage = asset ? asset->GetMemoryUsage() : 0;
+    }
+}
+
+bool WorldPartition::BuildHLODs(float triangleReduction)
+{
+    PROFILE_CPU();
+    Matrix worldToLocal;
+    GetWorldToLocalMatrix(worldToLocal);
+    Array<Actor*> actors;
+    Array<MaterialBase*> materials;
+    BytesContainer vb0, vb1, ib;
+    for (WorldPartitionCell& cell : Cells)
+    {
+        Scene* scene = Level::FindScene(cell.Scene);
+        if (!scene)
+        {
+            LOG(Warning, "Cannot build HLOD for world partition cell {0} because scene is not loaded.", cell.Scene);
+            continue;
+        }
+
+        // Merge static geometry of the cell (single mesh per material)
+        ModelData modelData;
+        ModelLodData& lod = modelData.LODs.AddOne();
+        materials.Clear();
+        actors.Clear();
+        SceneQuery::GetAllActors(scene, actors);
+        for (Actor* actor : actors)
+        {
+            auto staticModel = dynamic_cast<StaticModel*>(actor);
+            if (!staticModel || !staticModel->IsActiveInHierarchy() || !staticModel->Model || staticModel->Model->WaitForLoaded())
+                continue;
+            Model* model = staticModel->Model.Get();
+            Matrix world, meshWorld;
+            staticModel->GetLocalToWorldMatrix(world);
+            Matrix::Multiply(world, worldToLocal, meshWorld);
+            for (const Mesh& mesh : model->LODs.Last().Meshes)
+            {
+                // Extract mesh data
+                int32 vertices, vertices1, indices;
+                if (mesh.DownloadDataCPU(MeshBufferType::Vertex0, vb0, vertices) ||
+                    mesh.DownloadDataCPU(MeshBufferType::Vertex1, vb1, vertices1) ||
+                    mesh.DownloadDataCPU(MeshBufferType::Index, ib, indices) ||
+                    vertices != vertices1)
+                {
+                    LOG(Warning, "Failed to get mesh data of model {0} for HLOD.", model->ToString());
+                    continue;
+                }
+                MeshData meshData;
+                meshData.InitFromModelVertices((VB0ElementType*)vb0.Get(), (VB1ElementType*)vb1.Get(), vertices);
+                meshData.Indices.Resize(indices);
+                for (int32 i = 0; i < indices; i++)
+                    meshData.Indices[i] = mesh.Use16BitIndexBuffer() ? ((const uint16*)ib.Get())[i] : ((const uint32*)ib.Get())[i];
+                meshData.TransformBuffer(meshWorld);
+
+                // Find the output mesh for the material
+                const int32 slotIndex = mesh.GetMaterialSlotIndex();
+                MaterialBase* material = slotIndex < staticModel->Entries.Count() ? staticModel->Entries[slotIndex].Material.Get() : nullptr;
+                if (!material && slotIndex < model->MaterialSlots.Count())
+                    material = model->MaterialSlots[slotIndex].Material.Get();
+                int32 materialIndex = materials.Find(material);
+                if (materialIndex == INVALID_INDEX)
+                {
+                    materialIndex = materials.Count();
+                    materials.Add(material);
+                    MaterialSlotEntry& slot = modelData.Materials.AddOne();
+                    slot.Name = material ? material->ToString() : TEXT("Default");
+                    slot.AssetID = material ? material->GetID() : Guid::Empty;
+                    MeshData* dstMesh = New<MeshData>();
+                    dstMesh->MaterialSlotIndex = materialIndex;
+                    dstMesh->Name = slot.Name;
+                    lod.Meshes.Add(dstMesh);
+                }
+                lod.Meshes[materialIndex]->Merge(meshData);
+            }
+        }
+        if (lod.Meshes.IsEmpty())
+            continue;
+
+        // Simplify merged geometry (far cells are small on a screen so use sloppy simplification that can collapse the disjoint meshes)
+        for (MeshData*& mesh : lod.Meshes)
+        {
+            MeshData* simplified = New<MeshData>();
+            simplified->MaterialSlotIndex = mesh->MaterialSlotIndex;
+            simplified->Name = mesh->Name;
+            if (ModelTool::SimplifyMesh(*mesh, *simplified, triangleReduction, 0.05f, true))
+            {
+                Delete(simplified);
+                continue;
+            }
+            Delete(mesh);
+            mesh = simplified;
+        }
+
+        // Import proxy model
+        Guid proxyId = cell.Proxy.GetID();
+        if (!proxyId.IsValid())
+            proxyId = Guid::New();
+        const String proxyPath = scene->GetDataFolderPath() / TEXT("HLOD") + ASSET_FILES_EXTENSION_WITH_DOT;
+        if (AssetsImportingManager::Create(AssetsImportingManager::CreateModelTag, proxyPath, proxyId, &modelData))
+        {
+            LOG(Warning, "Failed to import HLOD model for world partition cell {0}", cell.Scene);
+            return true;
+        }
+        cell.Proxy = Content::LoadAsync<Model>(proxyId);
+        cell.Bounds = scene->GetBoxWithChildren();
+    }
+    ClearProxies();
+    return false;
+}
+
+#endif
+
+void WorldPartition::Update()
+{
+    PROFILE_CPU();
+
+    // Gather the streaming sources
+    Array<Vector3, InlinedAllocation<8>> sources;
+    for (const auto& source : Sources)
+    {
+        if (source && source->IsActiveInHierarchy())
+            sources.Add(source->GetPosition());
+    }
+    if (sources.IsEmpty())
+    {
+        const Camera* camera = Camera::GetMainCamera();
+        if (camera)
+            sources.Add(camera->GetPosition());
+    }
+    if (_states.Count() != Cells.Count())
+        _states.Resize(Cells.Count());
+    if (sources.IsEmpty())
+    {
+        UpdateProxies();
+        return;
+    }
+
+    // Sort cells by the distance to the closest streaming source (closest cells get loaded first within the memory budget)
+    Array<CellDistance, InlinedAllocation<64>> distances;
+    distances.Resize(Cells.Count());
+    for (int32 i = 0; i < Cells.Count(); i++)
+    {
+        const BoundingBox& bounds = Cells[i].Bounds;
+        Real distance = MAX_Real;
+        if (bounds != BoundingBox::Empty)
+        {
+            for (const Vector3& source : sources)
+                distance = Math::Min(distance, bounds.Distance(source));
+        }
+        distances[i] = { distance, i };
+    }
+    Sorting::QuickSort(distances.Get(), distances.Count());
+
+    // Update cells streaming
+    const uint64 budget = (uint64)MemoryBudget * 1024 * 1024;
+    const Real unloadDistance = Math::Max(UnloadDistance, LoadDistance);
+    uint64 memoryUsage = 0;
+    for (const CellDistance& e : distances)
+    {
+        WorldPartitionCell& cell = Cells[e.Index];
+        CellStates& state = _states[e.Index];
+        Scene* scene = Level::FindScene(cell.Scene);
+        if (state == CellStates::Failed || (scene && scene == GetScene()))
+            continue;
+        if (scene && state != CellStates::Loaded)
+        {
+            state = CellStates::Loaded;
+            if (cell.Bounds == BoundingBox::Empty)
+                cell.Bounds = scene->GetBoxWithChildren();
+        }
+        else if (!scene && state == CellStates::Loaded)
+        {
+            state = CellStates::Unloaded;
+        }
+
+        // Use larger distance for the loaded cells to prevent streaming flickering around the cell border
+        bool wanted = e.Distance <= (state == CellStates::Unloaded ? (Real)LoadDistance : unloadDistance);
+        if (wanted && budget != 0)
+        {
+            if (memoryUsage != 0 && memoryUsage + cell.MemoryUsage > budget)
+                wanted = false;
+            else
+                memoryUsage += cell.MemoryUsage;
+        }
+
+        if (wanted && state == CellStates::Unloaded)
+        {
+            if (Level::LoadSceneAsync(cell.Scene))
+                state = CellStates::Failed;
+            else
+                state = CellStates::Loading;
+        }
+        else if (!wanted && state == CellStates::Loaded)
+        {
+            Level::UnloadSceneAsync(scene);
+            state = CellStates::Unloaded;
+        }
+    }
+
+    UpdateProxies();
+}
+
+void WorldPartition::UpdateProxies()
+{
+    // Show hierarchical LOD proxies in place of the cells that are not loaded
+    if (_proxies.Count() != Cells.Count())
+        _proxies.Resize(Cells.Count());
+    for (int32 i = 0; i < Cells.Count(); i++)
+    {
+        const WorldPartitionCell& cell = Cells[i];
+        StaticModel* proxy = _proxies[i].Get();
+        if (proxy && proxy->Model != cell.Proxy)
+        {
+            proxy->DeleteObject();
+            proxy = nullptr;
+        }
+        const bool visible = cell.Proxy && _states[i] != CellStates::Loaded;
+        if (!proxy && visible)
+        {
+            proxy = New<StaticModel>();
+            proxy->SetStaticFlags(StaticFlags::Transform);
+            proxy->HideFlags = HideFlags::FullyHidden;
+            proxy->Model = cell.Proxy;
+            proxy->SetParent(this, false, false);
+        }
+        if (proxy)
+            proxy->SetIsActive(visible);
+        _proxies[i] = proxy;
+    }
+}
+
+void WorldPartition::ClearProxies()
+{
+    for (const auto& proxy : _proxies)
+    {
+        if (proxy)
+            proxy->DeleteObject();
+    }
+    _proxies.Clear();
+}
+
+void WorldPartition::OnSceneLoadError(Scene* scene, const Guid& sceneId)
+{
+    for (int32 i = 0; i < Cells.Count() && i < _states.Count(); i++)
+    {
+        if (Cells[i].Scene == sceneId)
+        {
+            LOG(Warning, "Failed to load world partition cell {0}", sceneId);
+            _states[i] = CellStates::Failed;
+        }
+    }
+}
+
+#if USE_EDITOR
+
+#include "Engine/Debug/DebugDraw.h"
+
+BoundingBox WorldPartition::GetEditorBox() const
+{
+    const Vector3 size(50);
+    return BoundingBox(_transform.Translation - size, _transform.Translation + size);
+}
+
+void WorldPartition::OnDebugDrawSelected()
+{
+    for (const WorldPartitionCell& cell : Cells)
+    {
+        if (cell.Bounds != BoundingBox::Empty)
+            DEBUG_DRAW_WIRE_BOX(cell.Bounds, Level::FindScene(cell.Scene) ? Color::Green : Color::Gray, 0, true);
+    }
+
+    // Base
+    Actor::OnDebugDrawSelected();
+}
+
+#endif
+
+void WorldPartition::Serialize(SerializeStream& stream, const void* otherObj)
+{
+    // Base
+    Actor::Serialize(stream, otherObj);
+
+    SERIALIZE_GET_OTHER_OBJ(WorldPartition);
+
+    SERIALIZE(Cells);
+    SERIALIZE(Sources);
+    SERIALIZE(LoadDistance);
+    SERIALIZE(UnloadDistance);
+    SERIALIZE(MemoryBudget);
+}
+
+void WorldPartition::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
+{
+    // Base
+    Actor::Deserialize(stream, modifier);
+
+    DESERIALIZE(Cells);
+    DESERIALIZE(Sources);
+    DESERIALIZE(LoadDistance);
+    DESERIALIZE(UnloadDistance);
+    DESERIALIZE(MemoryBudget);
+}
+
+void WorldPartition::OnEnable()
+{
+    _states.Clear();
+    Level::SceneLoadError.Bind<WorldPartition, &WorldPartition::OnSceneLoadError>(this);
+    GetScene()->Ticking.Update.AddTick<WorldPartition, &WorldPartition::Update>(this);
+
+    // Base
+    Actor::OnEnable();
+}
+
+void WorldPartition::OnDisable()
+{
+    GetScene()->Ticking.Update.RemoveTick(this);
+    Level::SceneLoadError.Unbind<WorldPartition, &WorldPartition::OnSceneLoadError>(this);
+    ClearProxies();
+
+    // Base
+    Actor::OnDisable();
+}
+
+void WorldPartition::OnTransformChanged()
+{
+    // Base
+    Actor::OnTransformChanged();
+
+    _box = BoundingBox(_transform.Translation);
+    _sphere = BoundingSphere(_transform.Translation, 0.0f);
+}
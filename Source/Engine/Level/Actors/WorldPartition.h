@@ -0,0 +1,148 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "../Actor.h"
+#include "Engine/Core/ISerializable.h"
+#include "Engine/Content/AssetReference.h"
+#include "Engine/Content/Assets/Model.h"
+#include "Engine/Scripting/ScriptingObjectReference.h"
+
+/// <summary>
+/// The world partition cell that describes a sub-scene streamed in and out by the <see cref="WorldPartition"/>.
+/// </summary>
+API_STRUCT() struct FLAXENGINE_API WorldPartitionCell : ISerializable
+{
+    API_AUTO_SERIALIZATION();
+    DECLARE_SCRIPTING_TYPE_MINIMAL(WorldPartitionCell);
+
+    /// <summary>
+    /// The scene asset identifier to load for this cell.
+    /// </summary>
+    API_FIELD(Attributes="AssetReference(typeof(SceneAsset))") Guid Scene;
+
+    /// <summary>
+    /// The cell bounds in world-space (combined bounds of all scene actors). Empty bounds get refreshed when the cell gets loaded.
+    /// </summary>
+    API_FIELD() BoundingBox Bounds = BoundingBox::Empty;
+
+    /// <summary>
+    /// The estimated memory usage of the loaded cell (in bytes). Used by the streaming memory budget.
+    /// </summary>
+    API_FIELD() uint64 MemoryUsage = 0;
+
+    /// <summary>
+    /// The hierarchical LOD proxy model (merged and simplified static geometry of the cell) drawn in place of the cell actors when cell is not loaded.
+    /// </summary>
+    API_FIELD() AssetReference<Model> Proxy;
+
+public:
+    bool operator==(const WorldPartitionCell& other) const
+    {
+        return Scene == other.Scene && Bounds == other.Bounds && MemoryUsage == other.MemoryUsage && Proxy == other.Proxy;
+    }
+
+    FORCE_INLINE bool operator!=(const WorldPartitionCell& other) const
+    {
+        return !operator==(other);
+    }
+};
+
+/// <summary>
+/// The world partition that streams the spatial cells (sub-scenes) in and out around the streaming sources (eg. player or camera). Place it in the persistent scene to build seamless open worlds.
+/// </summary>
+API_CLASS(Attributes="ActorContextMenu(\"New/Other/World Partition\"), ActorToolbox(\"Other\")")
+class FLAXENGINE_API WorldPartition : public Actor
+{
+    DECLARE_SCENE_OBJECT(WorldPartition);
+private:
+    enum class CellStates : byte
+    {
+        Unloaded,
+        Loading,
+        Loaded,
+        Failed,
+    };
+
+    Array<CellStates> _states;
+    Array<ScriptingObjectReference<class StaticModel>> _proxies;
+
+public:
+    /// <summary>
+    /// The world cells to stream.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(0), EditorDisplay(\"World Partition\")")
+    Array<WorldPartitionCell> Cells;
+
+    /// <summary>
+    /// The streaming sources (eg. players). Cells are loaded around the sources positions. If empty then the main camera is used.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(10), EditorDisplay(\"World Partition\")")
+    Array<ScriptingObjectReference<Actor>> Sources;
+
+    /// <summary>
+    /// The distance from the streaming source to the cell bounds at which cell gets loaded.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(20), Limit(0), EditorDisplay(\"World Partition\")")
+    float LoadDistance = 20000.0f;
+
+    /// <summary>
+    /// The distance from the streaming source to the cell bounds at which cell gets unloaded. Should be larger than LoadDistance to prevent cells from loading and unloading every frame when streaming source moves around the cell border (hysteresis).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(30), Limit(0), EditorDisplay(\"World Partition\")")
+    float UnloadDistance = 25000.0f;
+
+    /// <summary>
+    /// The memory budget (in megabytes) for the loaded cells. The closest cells are loaded first and the farthest cells get unloaded when the budget is exceeded. Use 0 for unlimited budget.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(40), Limit(0), EditorDisplay(\"World Partition\")")
+    int32 MemoryBudget = 0;
+
+public:
+    /// <summary>
+    /// Gets the amount of the currently loaded cells.
+    /// </summary>
+    API_PROPERTY() int32 GetLoadedCellsCount() const;
+
+    /// <summary>
+    /// Determines whether the cell at the given index is loaded.
+    /// </summary>
+    /// <param name="index">The cell index.</param>
+    /// <returns>True if cell scene is loaded, otherwise false.</returns>
+    API_FUNCTION() bool IsCellLoaded(int32 index) const;
+
+#if USE_EDITOR
+    /// <summary>
+    /// Updates the bounds and estimated memory usage of the cells that are loaded (from the actors bounds). Should be called before cooking the game.
+    /// </summary>
+    API_FUNCTION() void BuildCells();
+
+    /// <summary>
+    /// Builds the hierarchical LOD proxy models for the cells that are loaded. Static models of each cell get merged per material (from their lowest LOD) and simplified into a single proxy model that is drawn beyond the streaming distance instead of the individual actors.
+    /// </summary>
+    /// <param name="triangleReduction">The target amount of triangles of the proxy (normalized to range 0-1 of the merged geometry triangles count).</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    API_FUNCTION() bool BuildHLODs(float triangleReduction = 0.1f);
+#endif
+
+private:
+    void Update();
+    void UpdateProxies();
+    void ClearProxies();
+    void OnSceneLoadError(Scene* scene, const Guid& sceneId);
+
+public:
+    // [Actor]
+#if USE_EDITOR
+    BoundingBox GetEditorBox() const override;
+    void OnDebugDrawSelected() override;
+#endif
+    void Serialize(SerializeStream& stream, const void* otherObj) override;
+    void Deserialize(DeserializeStream& stream, ISerializeModifier* modifier) override;
+
+protected:
+    // [Actor]
+    void OnEnable() override;
+    void OnDisable() override;
+    void OnTransformChanged() override;
+};
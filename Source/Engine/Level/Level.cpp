@@ -23,6 +23,7 @@
 #include "Engine/Platform/File.h"
 #include "Engine/Platform/FileSystem.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Scripting/Script.h"
 #include "Engine/Engine/Time.h"
 #include "Engine/Scripting/ManagedCLR/MAssembly.h"
@@ -32,6 +33,7 @@
 #include "Engine/Scripting/Scripting.h"
 #include "Engine/Scripting/BinaryModule.h"
 #include "Engine/Serialization/JsonTools.h"
+#include "Engine/Serialization/JsonParser.h"
 #include "Engine/Serialization/Serialization.h"
 #include "Engine/Serialization/JsonWriters.h"
 #include "Prefabs/Prefab.h"
@@ -92,6 +94,12 @@ class SceneAction
     {
         return true;
     }
+
+    // Checks if action has been completed (time-sliced actions are performed over multiple frames).
+    virtual bool IsDone() const
+    {
+        return true;
+    }
 };
 
 #if USE_EDITOR
@@ -110,6 +118,7 @@ namespace LevelImpl
     Array<SceneAction*> _sceneActions;
     CriticalSection _sceneActionsLocker;
     DateTime _lastSceneLoadTime(0);
+    float _sceneLoadProgress = 1.0f;
 #if USE_EDITOR
     Array<ScriptsReloadObject> ScriptsReloadObjects;
 #endif
@@ -149,6 +158,8 @@ LevelService LevelServiceInstanceService;
 CriticalSection Level::ScenesLock;
 Array<Scene*> Level::Scenes;
 bool Level::TickEnabled = true;
+float Level::SceneLoadTimeBudget = 0.0f;
+bool Level::DeferTransformUpdates = false;
 Delegate<Actor*> Level::ActorSpawned;
 Delegate<Actor*> Level::ActorDeleted;
 Delegate<Actor*, Actor*> Level::ActorParentChanged;
@@ -273,27 +284,34 @@ void LayersAndTagsSettings::Apply()
 
 void LevelService::Update()
 {
+    PROFILE_MEM(Level);
     TICK_LEVEL(Update, "Level::Update")
     TICK_LEVEL_EDITOR(Update)
+    Level::FlushTransforms();
 }
 
 void LevelService::LateUpdate()
 {
+    PROFILE_MEM(Level);
     TICK_LEVEL(LateUpdate, "Level::LateUpdate")
     TICK_LEVEL_EDITOR(LateUpdate)
+    Level::FlushTransforms();
     flushActions();
 }
 
 void LevelService::FixedUpdate()
 {
+    PROFILE_MEM(Level);
     TICK_LEVEL(FixedUpdate, "Level::FixedUpdate")
     TICK_LEVEL_EDITOR(FixedUpdate)
+    Level::FlushTransforms();
 }
 
 void LevelService::LateFixedUpdate()
 {
     TICK_LEVEL(LateFixedUpdate, "Level::LateFixedUpdate")
     TICK_LEVEL_EDITOR(LateFixedUpdate)
+    Level::FlushTransforms();
 }
 
 #undef TICK_LEVEL
@@ -303,6 +321,11 @@ void LevelService::Dispose()
 {
     ScopeLock lock(_sceneActionsLocker);
 
+    // Cancel pending actions (including the time-sliced scene load that is in progress)
+    for (SceneAction* action : _sceneActions)
+        Delete(action);
+    _sceneActions.Clear();
+
     // Unload scenes
     unloadScenes();
 
@@ -336,6 +359,11 @@ DateTime Level::GetLastSceneLoadTime()
     return _lastSceneLoadTime;
 }
 
+float Level::GetSceneLoadProgress()
+{
+    return _sceneLoadProgress;
+}
+
 bool Level::SpawnActor(Actor* actor, Actor* parent)
 {
     ASSERT(actor);
@@ -391,6 +419,7 @@ class LoadSceneAction : public SceneAction
 public:
     Guid SceneId;
     AssetReference<JsonAsset> SceneAsset;
+    mutable Level::SceneLoader* Loader = nullptr;
 
     LoadSceneAction(const Guid& sceneId, JsonAsset* sceneAsset)
     {
@@ -398,34 +427,16 @@ class LoadSceneAction : public SceneAction
         SceneAsset = sceneAsset;
     }
 
+    ~LoadSceneAction();
+
     bool CanDo() const override
     {
         return SceneAsset == nullptr || SceneAsset->IsLoaded();
     }
 
-    bool Do() const override
-    {
-        // Now to deserialize scene in a proper way we need to load scripting
-        if (!Scripting::IsEveryAssemblyLoaded())
-        {
-            LOG(Error, "Scripts must be compiled without any errors in order to load a scene.");
-#if USE_EDITOR
-            Platform::Error(TEXT("Scripts must be compiled without any errors in order to load a scene. Please fix it."));
-#endif
-            CallSceneEvent(SceneEventType::OnSceneLoadError, nullptr, SceneId);
-            return true;
-        }
-
-        // Load scene
-        if (Level::loadScene(SceneAsset))
-        {
-            LOG(Error, "Failed to deserialize scene {0}", SceneId);
-            CallSceneEvent(SceneEventType::OnSceneLoadError, nullptr, SceneId);
-            return true;
-        }
+    bool Do() const override;
 
-        return false;
-    }
+    bool IsDone() const override;
 };
 
 class UnloadSceneAction : public SceneAction
@@ -767,8 +778,11 @@ void LevelImpl::flushActions()
 
     while (_sceneActions.HasItems() && _sceneActions.First()->CanDo())
     {
-        const auto action = _sceneActions.Dequeue();
+        const auto action = _sceneActions.First();
         action->Do();
+        if (!action->IsDone())
+            break; // Continue in the next frame
+        _sceneActions.Dequeue();
         Delete(action);
     }
 }
@@ -817,139 +831,212 @@ bool LevelImpl::unloadScenes()
     return false;
 }
 
-bool Level::loadScene(JsonAsset* sceneAsset)
-{
-    // Keep reference to the asset (prevent unloading during action)
-    AssetReference<JsonAsset> ref = sceneAsset;
-    if (sceneAsset == nullptr || sceneAsset->WaitForLoaded())
-    {
-        LOG(Error, "Cannot load scene asset.");
-        return true;
-    }
-
-    return loadScene(*sceneAsset->Data, sceneAsset->DataEngineBuild);
-}
+// The amount of objects processed between the time budget checks during time-sliced scene loading
+#define SCENE_LOADER_TIME_CHECK_INTERVAL 16
 
-bool Level::loadScene(const BytesContainer& sceneData, Scene** outScene)
+class Level::SceneLoader
 {
-    if (sceneData.IsInvalid())
-    {
-        LOG(Error, "Missing scene data.");
-        return true;
-    }
+public:
+    enum class Stages
+    {
+        Begin,
+        Spawn,
+        SetupPrefabs,
+        Deserialize,
+        SetupTransform,
+        Initialize,
+        BeginPlay,
+        Loaded,
+    };
+
+    rapidjson_flax::Value& Data;
+    AssetReference<JsonAsset> Asset; // Keeps the source asset loaded while its data is used (optional)
+    int32 EngineBuild;
+    float TimeBudget;
+    Stages Stage = Stages::Begin;
+    Guid SceneId;
+    Scene* LoadedScene = nullptr;
+    int32 DataCount;
+    int32 ObjectIndex = 0;
+    double TickStartTime = 0.0;
+    Stopwatch Timer;
+    CollectionPoolCache<ISerializeModifier, Cache::ISerializeModifierClearCallback>::ScopeCache Modifier;
+    CollectionPoolCache<ActorsCache::SceneObjectsListType>::ScopeCache SceneObjects;
+    SceneObjectsFactory::Context FactoryContext;
+    SceneObjectsFactory::PrefabSyncData PrefabSync;
 
-    // Parse scene JSON file
-    rapidjson_flax::Document document;
-    {
-        PROFILE_CPU_NAMED("Json.Parse");
-        document.Parse(sceneData.Get<char>(), sceneData.Length());
-    }
-    if (document.HasParseError())
+    SceneLoader(rapidjson_flax::Value& data, int32 engineBuild, float timeBudget)
+        : Data(data)
+        , EngineBuild(engineBuild)
+        , TimeBudget(timeBudget)
+        , DataCount(data.IsArray() ? (int32)data.Size() : 0)
+        , Modifier(Cache::ISerializeModifier.Get())
+        , SceneObjects(ActorsCache::SceneObjectsListCache.Get())
+        , FactoryContext(Modifier.Value)
+        , PrefabSync(*SceneObjects.Value, data, Modifier.Value)
     {
-        Log::JsonParseException(document.GetParseError(), document.GetErrorOffset());
-        return true;
     }
 
-    ScopeLock lock(ScenesLock);
-    return loadScene(document, outScene);
-}
-
-bool Level::loadScene(rapidjson_flax::Document& document, Scene** outScene)
-{
-    auto data = document.FindMember("Data");
-    if (data == document.MemberEnd())
+    float GetProgress() const
     {
-        LOG(Error, "Missing Data member.");
-        return true;
+        float stageProgress = 0.0f;
+        if ((Stage == Stages::Deserialize || Stage == Stages::Initialize) && DataCount > 0)
+            stageProgress = (float)ObjectIndex / (float)DataCount;
+        return Math::Saturate(((float)Stage + stageProgress) / (float)Stages::Loaded);
     }
-    const int32 saveEngineBuild = JsonTools::GetInt(document, "EngineBuild", 0);
-    return loadScene(data->value, saveEngineBuild, outScene);
-}
-
-bool Level::loadScene(rapidjson_flax::Value& data, int32 engineBuild, Scene** outScene)
-{
-    PROFILE_CPU_NAMED("Level.LoadScene");
-    if (outScene)
-        *outScene = nullptr;
-    LOG(Info, "Loading scene...");
-    Stopwatch stopwatch;
-    _lastSceneLoadTime = DateTime::Now();
 
-    // Here whole scripting backend should be loaded for current project
-    // Later scripts will setup attached scripts and restore initial vars
-    if (!Scripting::HasGameModulesLoaded())
+    // Deletes all the objects created by the loading that has not been completed (the scene is not yet added to the loaded scenes).
+    void Cancel()
     {
-        LOG(Error, "Cannot load scene without game modules loaded.");
-#if USE_EDITOR
-        if (!CommandLine::Options.Headless.IsTrue())
+        if (Stage == Stages::Loaded || !LoadedScene)
+            return;
+        PROFILE_CPU_NAMED("Level.CancelLoadScene");
+        LOG(Warning, "Canceled loading scene {0}", SceneId);
+        if (Stage != Stages::Spawn)
         {
-            if (ScriptsBuilder::LastCompilationFailed())
-                MessageBox::Show(TEXT("Scripts compilation failed. Cannot load scene without game script modules. Please fix the compilation issues. See logs for more info."), TEXT("Failed to compile scripts"), MessageBoxButtons::OK, MessageBoxIcon::Error);
-            else
-                MessageBox::Show(TEXT("Failed to load scripts. Cannot load scene without game script modules. See logs for more info."), TEXT("Missing game modules"), MessageBoxButtons::OK, MessageBoxIcon::Error);
+            // Delete in the reverse order so children go before their parents (parent deletion doesn't need to unlink them)
+            SceneObject** objects = SceneObjects->Get();
+            for (int32 i = SceneObjects->Count() - 1; i > 0; i--)
+            {
+                if (objects[i])
+                    objects[i]->DeleteObjectNow();
+            }
         }
-#endif
-        return true;
+        LoadedScene->DeleteObjectNow();
+        LoadedScene = nullptr;
+        SceneObjects->Clear();
+        Stage = Stages::Loaded;
     }
 
-    // Peek meta
-    if (engineBuild < 6000)
-    {
-        LOG(Error, "Invalid serialized engine build.");
-        return true;
-    }
-    if (!data.IsArray())
+    // Performs the loading stages until the scene gets loaded or the time budget (in seconds, 0 if unlimited) is used. Returns true if failed.
+    bool Tick()
     {
-        LOG(Error, "Invalid Data member.");
-        return true;
+        PROFILE_CPU_NAMED("Level.LoadScene");
+        TickStartTime = Platform::GetTimeSeconds();
+        bool first = true;
+        while (Stage != Stages::Loaded)
+        {
+            if (!first && IsOutOfTime())
+                break;
+            first = false;
+            switch (Stage)
+            {
+            case Stages::Begin:
+                if (TickBegin())
+                    return true;
+                break;
+            case Stages::Spawn:
+                TickSpawn();
+                break;
+            case Stages::SetupPrefabs:
+                TickSetupPrefabs();
+                break;
+            case Stages::Deserialize:
+                TickDeserialize();
+                break;
+            case Stages::SetupTransform:
+                TickSetupTransform();
+                break;
+            case Stages::Initialize:
+                TickInitialize();
+                break;
+            case Stages::BeginPlay:
+                TickBeginPlay();
+                break;
+            default: ;
+            }
+        }
+        return false;
     }
 
-    // Peek scene node value (it's the first actor serialized)
-    auto sceneId = JsonTools::GetGuid(data[0], "ID");
-    if (!sceneId.IsValid())
+private:
+    bool IsOutOfTime() const
     {
-        LOG(Error, "Invalid scene id.");
-        return true;
+        return TimeBudget > 0.0f && Platform::GetTimeSeconds() - TickStartTime >= TimeBudget;
     }
-    auto modifier = Cache::ISerializeModifier.Get();
-    modifier->EngineBuild = engineBuild;
 
-    // Skip is that scene is already loaded
-    if (FindScene(sceneId) != nullptr)
+    bool TickBegin()
     {
-        LOG(Info, "Scene {0} is already loaded.", sceneId);
-        return false;
-    }
+        LOG(Info, "Loading scene...");
+        Timer.Start();
+        _lastSceneLoadTime = DateTime::Now();
 
-    // Create scene actor
-    // Note: the first object in the scene file data is a Scene Actor
-    auto scene = New<Scene>(ScriptingObjectSpawnParams(sceneId, Scene::TypeInitializer));
-    scene->RegisterObject();
-    scene->Deserialize(data[0], modifier.Value);
+        // Here whole scripting backend should be loaded for current project
+        // Later scripts will setup attached scripts and restore initial vars
+        if (!Scripting::HasGameModulesLoaded())
+        {
+            LOG(Error, "Cannot load scene without game modules loaded.");
+#if USE_EDITOR
+            if (!CommandLine::Options.Headless.IsTrue())
+            {
+                if (ScriptsBuilder::LastCompilationFailed())
+                    MessageBox::Show(TEXT("Scripts compilation failed. Cannot load scene without game script modules. Please fix the compilation issues. See logs for more info."), TEXT("Failed to compile scripts"), MessageBoxButtons::OK, MessageBoxIcon::Error);
+                else
+                    MessageBox::Show(TEXT("Failed to load scripts. Cannot load scene without game script modules. See logs for more info."), TEXT("Missing game modules"), MessageBoxButtons::OK, MessageBoxIcon::Error);
+            }
+#endif
+            return true;
+        }
 
-    // Fire event
-    CallSceneEvent(SceneEventType::OnSceneLoading, scene, sceneId);
+        // Peek meta
+        if (EngineBuild < 6000)
+        {
+            LOG(Error, "Invalid serialized engine build.");
+            return true;
+        }
+        if (!Data.IsArray())
+        {
+            LOG(Error, "Invalid Data member.");
+            return true;
+        }
 
-    // Loaded scene objects list
-    CollectionPoolCache<ActorsCache::SceneObjectsListType>::ScopeCache sceneObjects = ActorsCache::SceneObjectsListCache.Get();
-    const int32 dataCount = (int32)data.Size();
-    sceneObjects->Resize(dataCount);
-    sceneObjects->At(0) = scene;
+        // Peek scene node value (it's the first actor serialized)
+        SceneId = JsonTools::GetGuid(Data[0], "ID");
+        if (!SceneId.IsValid())
+        {
+            LOG(Error, "Invalid scene id.");
+            return true;
+        }
+        Modifier->EngineBuild = EngineBuild;
 
-    // Spawn all scene objects
-    SceneObjectsFactory::Context context(modifier.Value);
-    context.Async = JobSystem::GetThreadsCount() > 1 && dataCount > 10;
+        // Skip is that scene is already loaded
+        if (FindScene(SceneId) != nullptr)
+        {
+            LOG(Info, "Scene {0} is already loaded.", SceneId);
+            Stage = Stages::Loaded;
+            return false;
+        }
+
+        // Create scene actor
+        // Note: the first object in the scene file data is a Scene Actor
+        LoadedScene = New<Scene>(ScriptingObjectSpawnParams(SceneId, Scene::TypeInitializer));
+        LoadedScene->RegisterObject();
+        LoadedScene->Deserialize(Data[0], Modifier.Value);
+
+        // Fire event
+        CallSceneEvent(SceneEventType::OnSceneLoading, LoadedScene, SceneId);
+
+        // Loaded scene objects list
+        SceneObjects->Resize(DataCount);
+        SceneObjects->At(0) = LoadedScene;
+        FactoryContext.Async = JobSystem::GetThreadsCount() > 1 && DataCount > 10;
+        Stage = Stages::Spawn;
+        return false;
+    }
+
+    void TickSpawn()
     {
+        // Spawn all scene objects
         PROFILE_CPU_NAMED("Spawn");
-        SceneObject** objects = sceneObjects->Get();
-        if (context.Async)
+        SceneObject** objects = SceneObjects->Get();
+        if (FactoryContext.Async)
         {
             ScenesLock.Unlock(); // Unlock scenes from Main Thread so Job Threads can use it to safely setup actors hierarchy (see Actor::Deserialize)
             JobSystem::Execute([&](int32 i)
             {
                 i++; // Start from 1. at index [0] was scene
-                auto& stream = data[i];
-                auto obj = SceneObjectsFactory::Spawn(context, stream);
+                auto& stream = Data[i];
+                auto obj = SceneObjectsFactory::Spawn(FactoryContext, stream);
                 objects[i] = obj;
                 if (obj)
                 {
@@ -961,131 +1048,246 @@ bool Level::loadScene(rapidjson_flax::Value& data, int32 engineBuild, Scene** ou
                 }
                 else
                     SceneObjectsFactory::HandleObjectDeserializationError(stream);
-            }, dataCount - 1);
+            }, DataCount - 1);
             ScenesLock.Lock();
         }
         else
         {
-            for (int32 i = 1; i < dataCount; i++) // start from 1. at index [0] was scene
+            for (int32 i = 1; i < DataCount; i++) // start from 1. at index [0] was scene
             {
-                auto& stream = data[i];
-                auto obj = SceneObjectsFactory::Spawn(context, stream);
-                sceneObjects->At(i) = obj;
+                auto& stream = Data[i];
+                auto obj = SceneObjectsFactory::Spawn(FactoryContext, stream);
+                objects[i] = obj;
                 if (obj)
                     obj->RegisterObject();
                 else
                     SceneObjectsFactory::HandleObjectDeserializationError(stream);
             }
         }
+        Stage = Stages::SetupPrefabs;
     }
 
-    // Capture prefab instances in a scene to restore any missing objects (eg. newly added objects to prefab that are missing in scene file)
-    SceneObjectsFactory::PrefabSyncData prefabSyncData(*sceneObjects.Value, data, modifier.Value);
-    SceneObjectsFactory::SetupPrefabInstances(context, prefabSyncData);
-    // TODO: resave and force sync scenes during game cooking so this step could be skipped in game
-    SceneObjectsFactory::SynchronizeNewPrefabInstances(context, prefabSyncData);
-
-    // /\ all above this has to be done on an any thread
-    // \/ all below this has to be done on multiple threads at once
+    void TickSetupPrefabs()
+    {
+        // Capture prefab instances in a scene to restore any missing objects (eg. newly added objects to prefab that are missing in scene file)
+        SceneObjectsFactory::SetupPrefabInstances(FactoryContext, PrefabSync);
+        // TODO: resave and force sync scenes during game cooking so this step could be skipped in game
+        SceneObjectsFactory::SynchronizeNewPrefabInstances(FactoryContext, PrefabSync);
+        ObjectIndex = 1; // start from 1. at index [0] was scene
+        Stage = Stages::Deserialize;
+    }
 
-    // Load all scene objects
+    void TickDeserialize()
     {
+        // Load all scene objects
+        // TODO: deserialize objects via Job System after fixing Actor's Scripts and Children order when loading objects data out of order and adding _loadNoAsync flag for the types that don't support it (eg. UIControl/UICanvas)
         PROFILE_CPU_NAMED("Deserialize");
-        SceneObject** objects = sceneObjects->Get();
-        bool wasAsync = context.Async;
-        context.Async = false; // TODO: before doing full async for scene objects fix:
-        // TODO: - fix Actor's Scripts and Children order when loading objects data out of order via async jobs
-        // TODO: - add _loadNoAsync flag to SceneObject or Actor to handle non-async loading for those types (eg. UIControl/UICanvas)
-        if (context.Async)
-        {
-            ScenesLock.Unlock(); // Unlock scenes from Main Thread so Job Threads can use it to safely setup actors hierarchy (see Actor::Deserialize)
-            JobSystem::Execute([&](int32 i)
-            {
-                i++; // Start from 1. at index [0] was scene
-                auto obj = objects[i];
-                if (obj)
-                {
-                    auto& idMapping = Scripting::ObjectsLookupIdMapping.Get();
-                    idMapping = &context.GetModifier()->IdsMapping;
-                    SceneObjectsFactory::Deserialize(context, obj, data[i]);
-                    idMapping = nullptr;
-                }
-            }, dataCount - 1);
-            ScenesLock.Lock();
-        }
-        else
+        SceneObject** objects = SceneObjects->Get();
+        Scripting::ObjectsLookupIdMapping.Set(&Modifier->IdsMapping);
+        for (int32 i = 0; ObjectIndex < DataCount; ObjectIndex++, i++)
         {
-            Scripting::ObjectsLookupIdMapping.Set(&modifier.Value->IdsMapping);
-            for (int32 i = 1; i < dataCount; i++) // start from 1. at index [0] was scene
-            {
-                auto& objData = data[i];
-                auto obj = objects[i];
-                if (obj)
-                    SceneObjectsFactory::Deserialize(context, obj, objData);
-            }
-            Scripting::ObjectsLookupIdMapping.Set(nullptr);
+            if (i != 0 && i % SCENE_LOADER_TIME_CHECK_INTERVAL == 0 && IsOutOfTime())
+                break;
+            auto obj = objects[ObjectIndex];
+            if (obj)
+                SceneObjectsFactory::Deserialize(FactoryContext, obj, Data[ObjectIndex]);
         }
-        context.Async = wasAsync;
-    }
-
-    // /\ all above this has to be done on multiple threads at once
-    // \/ all below this has to be done on an any thread
+        Scripting::ObjectsLookupIdMapping.Set(nullptr);
+        if (ObjectIndex < DataCount)
+            return;
 
-    // Synchronize prefab instances (prefab may have objects removed or reordered so deserialized instances need to synchronize with it)
-    // TODO: resave and force sync scenes during game cooking so this step could be skipped in game
-    SceneObjectsFactory::SynchronizePrefabInstances(context, prefabSyncData);
+        // Synchronize prefab instances (prefab may have objects removed or reordered so deserialized instances need to synchronize with it)
+        // TODO: resave and force sync scenes during game cooking so this step could be skipped in game
+        SceneObjectsFactory::SynchronizePrefabInstances(FactoryContext, PrefabSync);
+        Stage = Stages::SetupTransform;
+    }
 
-    // Cache transformations
+    void TickSetupTransform()
     {
+        // Cache transformations
         PROFILE_CPU_NAMED("Cache Transform");
-
-        scene->OnTransformChanged();
+        LoadedScene->OnTransformChanged();
+        ObjectIndex = 0;
+        Stage = Stages::Initialize;
     }
 
-    // Initialize scene objects
+    void TickInitialize()
     {
+        // Initialize scene objects
         PROFILE_CPU_NAMED("Initialize");
-
-        SceneObject** objects = sceneObjects->Get();
-        for (int32 i = 0; i < dataCount; i++)
+        SceneObject** objects = SceneObjects->Get();
+        for (int32 i = 0; ObjectIndex < DataCount; ObjectIndex++, i++)
         {
-            SceneObject* obj = objects[i];
+            if (i != 0 && i % SCENE_LOADER_TIME_CHECK_INTERVAL == 0 && IsOutOfTime())
+                break;
+            SceneObject* obj = objects[ObjectIndex];
             if (obj)
             {
                 obj->Initialize();
 
                 // Delete objects without parent
-                if (i != 0 && obj->GetParent() == nullptr)
+                if (ObjectIndex != 0 && obj->GetParent() == nullptr)
                 {
                     LOG(Warning, "Scene object {0} {1} has missing parent object after load. Removing it.", obj->GetID(), obj->ToString());
                     obj->DeleteObject();
+                    objects[ObjectIndex] = nullptr; // Object can be removed before loading ends
                 }
             }
         }
-        prefabSyncData.InitNewObjects();
+        if (ObjectIndex < DataCount)
+            return;
+        PrefabSync.InitNewObjects();
+        Stage = Stages::BeginPlay;
     }
 
-    // /\ all above this has to be done on an any thread
-    // \/ all below this has to be done on a main thread
+    void TickBeginPlay()
+    {
+        // Link scene and call init
+        {
+            PROFILE_CPU_NAMED("BeginPlay");
+            ScopeLock lock(ScenesLock);
+            Scenes.Add(LoadedScene);
+            SceneBeginData beginData;
+            LoadedScene->BeginPlay(&beginData);
+            beginData.OnDone();
+        }
+
+        // Fire event
+        CallSceneEvent(SceneEventType::OnSceneLoaded, LoadedScene, SceneId);
+
+        Timer.Stop();
+        LOG(Info, "Scene loaded in {0}ms", Timer.GetMilliseconds());
+        Stage = Stages::Loaded;
+    }
+};
 
-    // Link scene and call init
+LoadSceneAction::~LoadSceneAction()
+{
+    if (Loader)
     {
-        PROFILE_CPU_NAMED("BeginPlay");
+        if (Loader->Stage != Level::SceneLoader::Stages::Loaded)
+        {
+            // Action has been destroyed during loading (eg. engine exit or scenes unload) so remove partially loaded scene
+            Loader->Cancel();
+            CallSceneEvent(SceneEventType::OnSceneLoadError, nullptr, SceneId);
+        }
+        Delete(Loader);
+        _sceneLoadProgress = 1.0f;
+    }
+}
 
-        ScopeLock lock(ScenesLock);
-        Scenes.Add(scene);
-        SceneBeginData beginData;
-        scene->BeginPlay(&beginData);
-        beginData.OnDone();
+bool LoadSceneAction::Do() const
+{
+    if (!Loader)
+    {
+        // Now to deserialize scene in a proper way we need to load scripting
+        if (!Scripting::IsEveryAssemblyLoaded())
+        {
+            LOG(Error, "Scripts must be compiled without any errors in order to load a scene.");
+#if USE_EDITOR
+            Platform::Error(TEXT("Scripts must be compiled without any errors in order to load a scene. Please fix it."));
+#endif
+            CallSceneEvent(SceneEventType::OnSceneLoadError, nullptr, SceneId);
+            return true;
+        }
+        if (Level::SceneLoadTimeBudget <= 0.0f)
+        {
+            // Load scene
+            if (Level::loadScene(SceneAsset))
+            {
+                LOG(Error, "Failed to deserialize scene {0}", SceneId);
+                CallSceneEvent(SceneEventType::OnSceneLoadError, nullptr, SceneId);
+                return true;
+            }
+            return false;
+        }
+        if (SceneAsset == nullptr || SceneAsset->WaitForLoaded())
+        {
+            LOG(Error, "Cannot load scene asset.");
+            CallSceneEvent(SceneEventType::OnSceneLoadError, nullptr, SceneId);
+            return true;
+        }
+        Loader = New<Level::SceneLoader>(*SceneAsset->Data, SceneAsset->DataEngineBuild, Level::SceneLoadTimeBudget * 0.001f);
+        Loader->Asset = SceneAsset;
     }
 
-    // Fire event
-    CallSceneEvent(SceneEventType::OnSceneLoaded, scene, sceneId);
+    // Load scene over multiple frames within the time budget
+    if (Loader->Tick())
+    {
+        LOG(Error, "Failed to deserialize scene {0}", SceneId);
+        CallSceneEvent(SceneEventType::OnSceneLoadError, nullptr, SceneId);
+        Delete(Loader);
+        Loader = nullptr;
+        _sceneLoadProgress = 1.0f;
+        return true;
+    }
+    _sceneLoadProgress = Loader->GetProgress();
+    return false;
+}
 
-    stopwatch.Stop();
-    LOG(Info, "Scene loaded in {0}ms", stopwatch.GetMilliseconds());
+bool LoadSceneAction::IsDone() const
+{
+    return !Loader || Loader->Stage == Level::SceneLoader::Stages::Loaded;
+}
+
+bool Level::loadScene(JsonAsset* sceneAsset)
+{
+    // Keep reference to the asset (prevent unloading during action)
+    AssetReference<JsonAsset> ref = sceneAsset;
+    if (sceneAsset == nullptr || sceneAsset->WaitForLoaded())
+    {
+        LOG(Error, "Cannot load scene asset.");
+        return true;
+    }
+
+    return loadScene(*sceneAsset->Data, sceneAsset->DataEngineBuild);
+}
+
+bool Level::loadScene(const BytesContainer& sceneData, Scene** outScene)
+{
+    if (sceneData.IsInvalid())
+    {
+        LOG(Error, "Missing scene data.");
+        return true;
+    }
+
+    // Parse scene JSON file (the document is temporary so strings can be decoded in-situ)
+    JsonParser parser;
+    rapidjson_flax::Document document;
+    {
+        PROFILE_CPU_NAMED("Json.Parse");
+        if (parser.Parse(document, sceneData.Get<char>(), sceneData.Length(), "Data", true))
+        {
+            Log::JsonParseException(parser.GetParseError(), parser.GetErrorOffset());
+            return true;
+        }
+    }
+
+    ScopeLock lock(ScenesLock);
+    return loadScene(document, outScene);
+}
+
+bool Level::loadScene(rapidjson_flax::Document& document, Scene** outScene)
+{
+    auto data = document.FindMember("Data");
+    if (data == document.MemberEnd())
+    {
+        LOG(Error, "Missing Data member.");
+        return true;
+    }
+    const int32 saveEngineBuild = JsonTools::GetInt(document, "EngineBuild", 0);
+    return loadScene(data->value, saveEngineBuild, outScene);
+}
+
+bool Level::loadScene(rapidjson_flax::Value& data, int32 engineBuild, Scene** outScene)
+{
     if (outScene)
-        *outScene = scene;
+        *outScene = nullptr;
+    SceneLoader loader(data, engineBuild, 0.0f);
+    if (loader.Tick())
+        return true;
+    if (outScene)
+        *outScene = loader.LoadedScene;
     return false;
 }
 
@@ -1360,6 +1562,15 @@ void Level::UnloadSceneAsync(Scene* scene)
 bool Level::UnloadAllScenes()
 {
     ScopeLock lock(_sceneActionsLocker);
+
+    // Cancel the time-sliced scene load that is in progress (its scene is not yet added to the loaded scenes list)
+    if (_sceneActions.HasItems() && !_sceneActions.First()->IsDone())
+    {
+        const auto action = _sceneActions.First();
+        _sceneActions.Dequeue();
+        Delete(action);
+    }
+
     return unloadScenes();
 }
 
@@ -1369,6 +1580,11 @@ void Level::UnloadAllScenesAsync()
     _sceneActions.Enqueue(New<UnloadScenesAction>());
 }
 
+void Level::FlushTransforms()
+{
+    Actor::FlushTransforms();
+}
+
 #if USE_EDITOR
 
 void Level::ReloadScriptsAsync()
@@ -50,6 +50,16 @@ API_CLASS(Static) class FLAXENGINE_API Level
     /// </summary>
     API_FIELD() static bool TickEnabled;
 
+    /// <summary>
+    /// True if actor transformation changes made on a main thread during gameplay should be applied lazily. Modified actors are marked as dirty and the world transform, bounds and rendering state of their hierarchy gets updated once (see FlushTransforms) after each game update stage, before the physics simulation and before the frame rendering. Helps when moving the same actors with many children multiple times per frame. Child actors world transform is still valid on access via properties, but the custom actor types code that uses cached data (eg. bounds) might see the outdated values until the flush.
+    /// </summary>
+    API_FIELD() static bool DeferTransformUpdates;
+
+    /// <summary>
+    /// The time budget (in milliseconds) per frame for the scenes loaded via LoadSceneAsync. Scene objects deserialization and initialization gets spread across multiple frames to reduce the hitches during level streaming (objects creation runs on Job System). Use 0 to load the whole scene within a single frame.
+    /// </summary>
+    API_FIELD() static float SceneLoadTimeBudget;
+
 public:
     /// <summary>
     /// Occurs when new actor gets spawned to the game.
@@ -108,6 +118,11 @@ API_CLASS(Static) class FLAXENGINE_API Level
     /// <returns>Last scene load time</returns>
     API_PROPERTY() static DateTime GetLastSceneLoadTime();
 
+    /// <summary>
+    /// Gets the progress of the scene loaded over multiple frames (see SceneLoadTimeBudget). Normalized to range 0-1, returns 1 if no scene is being loaded.
+    /// </summary>
+    API_PROPERTY() static float GetSceneLoadProgress();
+
     /// <summary>
     /// Gets the scenes count.
     /// </summary>
@@ -332,6 +347,11 @@ API_CLASS(Static) class FLAXENGINE_API Level
     /// </summary>
     API_FUNCTION() static void UnloadAllScenesAsync();
 
+    /// <summary>
+    /// Updates all actors with deferred transformation changes (see DeferTransformUpdates). Called automatically by the engine but can be used to force the update before reading the actors bounds.
+    /// </summary>
+    API_FUNCTION() static void FlushTransforms();
+
 #if USE_EDITOR
 
     /// <summary>
@@ -546,6 +566,10 @@ API_CLASS(Static) class FLAXENGINE_API Level
 
     static void callActorEvent(ActorEventType eventType, Actor* a, Actor* b);
 
+    // Scene loading state (can be performed over multiple frames)
+    class SceneLoader;
+    friend class LoadSceneAction;
+
     // All loadScene assume that ScenesLock has been taken by the calling thread
     static bool loadScene(JsonAsset* sceneAsset);
     static bool loadScene(const BytesContainer& sceneData, Scene** outScene = nullptr);
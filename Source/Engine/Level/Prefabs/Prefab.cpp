@@ -8,9 +8,8 @@
 #include "Engine/Level/Prefabs/PrefabManager.h"
 #include "Engine/Level/Actor.h"
 #include "Engine/Threading/Threading.h"
-#if USE_EDITOR
+#include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Scripting/Scripting.h"
-#endif
 
 REGISTER_JSON_ASSET(Prefab, "FlaxEngine.Prefab", true);
 
@@ -96,10 +95,39 @@ SceneObject* Prefab::GetDefaultInstance(const Guid& objectId)
     return result;
 }
 
+const Prefab::SpawnTemplate& Prefab::GetSpawnTemplate()
+{
+    ASSERT(IsLoaded());
+    ScopeLock lock(Locker);
+    if (_spawnTemplate.Types.Count() != ObjectsCount)
+    {
+        PROFILE_CPU();
+        _spawnTemplate.RootIndex = ObjectsIds.Find(GetRootObjectId());
+        _spawnTemplate.Types.Resize(ObjectsCount);
+        const auto& data = *Data;
+        for (int32 objectIndex = 0; objectIndex < ObjectsCount; objectIndex++)
+        {
+            // Cache types of the regular objects (nested prefab instances are resolved by the objects factory)
+            const auto& objData = data[objectIndex];
+            ScriptingTypeHandle type;
+            const auto typeNameMember = objData.FindMember("TypeName");
+            if (!objData.HasMember("PrefabObjectID") && typeNameMember != objData.MemberEnd() && typeNameMember->value.IsString())
+            {
+                type = Scripting::FindScriptingType(typeNameMember->value.GetStringAnsiView());
+                if (type && !SceneObject::TypeInitializer.IsAssignableFrom(type))
+                    type = ScriptingTypeHandle();
+            }
+            _spawnTemplate.Types[objectIndex] = type;
+        }
+    }
+    return _spawnTemplate;
+}
+
 void Prefab::DeleteDefaultInstance()
 {
     ScopeLock lock(Locker);
     ObjectsCache.Clear();
+    _spawnTemplate.Types.Clear();
     if (_defaultInstance)
     {
         _defaultInstance->DeleteObject();
@@ -190,6 +218,7 @@ void Prefab::unload(bool isReloading)
     ObjectsDataCache.SetCapacity(0);
     ObjectsCache.Clear();
     ObjectsCache.SetCapacity(0);
+    _spawnTemplate.Types.Resize(0);
     if (_defaultInstance)
     {
         _defaultInstance->DeleteObject();
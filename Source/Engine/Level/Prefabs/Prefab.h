@@ -5,6 +5,7 @@
 #include "Engine/Content/JsonAsset.h"
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Scripting/ScriptingType.h"
 
 class Actor;
 class SceneObject;
@@ -46,6 +47,17 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Prefab : public JsonAssetBase
     /// </summary>
     Dictionary<Guid, SceneObject*> ObjectsCache;
 
+    /// <summary>
+    /// The cached data used to spawn the prefab instances (see PrefabManager::SpawnPrefab).
+    /// </summary>
+    struct SpawnTemplate
+    {
+        // Scripting types of the prefab objects (by object index). Invalid handle for the objects that have to be created via SceneObjectsFactory (eg. nested prefab instances).
+        Array<ScriptingTypeHandle> Types;
+        // Index of the prefab root object.
+        int32 RootIndex = -1;
+    };
+
 public:
     /// <summary>
     /// Gets the root object identifier (prefab object ID). Asset must be loaded.
@@ -58,6 +70,11 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Prefab : public JsonAssetBase
     /// <returns>The root of the prefab object loaded from the prefab. Contains the default values. It's not added to gameplay but deserialized with postLoad and init event fired.</returns>
     API_FUNCTION() Actor* GetDefaultInstance();
 
+    /// <summary>
+    /// Gets the spawn template of the prefab that caches the objects data lookups done on every prefab instance spawn. Built on the first use.
+    /// </summary>
+    const SpawnTemplate& GetSpawnTemplate();
+
     /// <summary>
     /// Requests the default prefab object instance. Deserializes the prefab objects from the asset. Skips if already done.
     /// </summary>
@@ -87,6 +104,9 @@ API_CLASS(NoSpawn) class FLAXENGINE_API Prefab : public JsonAssetBase
 #endif
     void DeleteDefaultInstance();
 
+private:
+    SpawnTemplate _spawnTemplate;
+
 protected:
     // [JsonAssetBase]
     LoadResult loadAsset() override;
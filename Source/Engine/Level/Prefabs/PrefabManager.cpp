@@ -121,6 +121,7 @@ Actor* PrefabManager::SpawnPrefab(Prefab* prefab, const Transform& transform, Ac
         objectsCache->SetCapacity(prefab->ObjectsDataCache.Capacity());
     }
     auto& data = *prefab->Data;
+    const Prefab::SpawnTemplate& spawnTemplate = prefab->GetSpawnTemplate();
     SceneObjectsFactory::Context context(modifier.Value);
 
     // Deserialize prefab objects
@@ -129,7 +130,16 @@ Actor* PrefabManager::SpawnPrefab(Prefab* prefab, const Transform& transform, Ac
     for (int32 i = 0; i < dataCount; i++)
     {
         auto& stream = data[i];
-        SceneObject* obj = SceneObjectsFactory::Spawn(context, stream);
+        SceneObject* obj = nullptr;
+        const ScriptingTypeHandle& type = spawnTemplate.Types[i];
+        if (type)
+        {
+            // Create object of the cached type directly
+            const ScriptingObjectSpawnParams params(modifier->IdsMapping[prefab->ObjectsIds[i]], type);
+            obj = (SceneObject*)type.GetType().Script.Spawn(params);
+        }
+        if (!obj)
+            obj = SceneObjectsFactory::Spawn(context, stream);
         sceneObjects->At(i) = obj;
         if (obj)
             obj->RegisterObject();
@@ -137,6 +147,7 @@ Actor* PrefabManager::SpawnPrefab(Prefab* prefab, const Transform& transform, Ac
             SceneObjectsFactory::HandleObjectDeserializationError(stream);
     }
     SceneObjectsFactory::PrefabSyncData prefabSyncData(*sceneObjects.Value, data, modifier.Value);
+    withSynchronization &= prefab->NestedPrefabs.HasItems(); // Only nested prefab instances need to be synchronized
     if (withSynchronization)
     {
         // Synchronize new prefab instances (prefab may have new objects added so deserialized instances need to synchronize with it)
@@ -163,12 +174,8 @@ Actor* PrefabManager::SpawnPrefab(Prefab* prefab, const Transform& transform, Ac
 
     // Pick prefab root object
     Actor* root = nullptr;
-    const Guid prefabRootObjectId = prefab->GetRootObjectId();
-    for (int32 i = 0; i < dataCount && !root; i++)
-    {
-        if (JsonTools::GetGuid(data[i], "ID") == prefabRootObjectId)
-            root = dynamic_cast<Actor*>(sceneObjects->At(i));
-    }
+    if (spawnTemplate.RootIndex != -1)
+        root = dynamic_cast<Actor*>(sceneObjects->At(spawnTemplate.RootIndex));
     if (!root)
     {
         // Fallback to the first actor that has no parent
@@ -268,12 +275,11 @@ Actor* PrefabManager::SpawnPrefab(Prefab* prefab, const Transform& transform, Ac
     // Link objects to prefab (only deserialized from prefab data)
     for (int32 i = 0; i < dataCount; i++)
     {
-        auto& stream = data[i];
         SceneObject* obj = sceneObjects->At(i);
         if (!obj)
             continue;
 
-        const Guid prefabObjectId = JsonTools::GetGuid(stream, "ID");
+        const Guid prefabObjectId = prefab->ObjectsIds[i];
         if (objectsCache)
             objectsCache->Add(prefabObjectId, obj);
         obj->LinkPrefab(prefabId, prefabObjectId);
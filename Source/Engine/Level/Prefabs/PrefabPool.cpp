@@ -0,0 +1,124 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "PrefabPool.h"
+#include "PrefabManager.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Level/Actor.h"
+#include "Engine/Level/Level.h"
+#include "Engine/Level/Scene/Scene.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+
+PrefabPool::PrefabPool(const SpawnParams& params)
+    : ScriptingObject(params)
+{
+}
+
+PrefabPool::~PrefabPool()
+{
+    Clear();
+}
+
+Prefab* PrefabPool::GetPrefab() const
+{
+    return _prefab.Get();
+}
+
+void PrefabPool::SetPrefab(Prefab* value)
+{
+    if (_prefab == value)
+        return;
+    Clear();
+    _prefab = value;
+}
+
+int32 PrefabPool::GetFreeCount() const
+{
+    return _free.Count();
+}
+
+bool PrefabPool::Warmup(int32 count, Actor* parent)
+{
+    PROFILE_CPU();
+    for (int32 i = 0; i < count; i++)
+    {
+        Actor* actor = Create(parent);
+        if (!actor)
+            return true;
+        _free.Add(actor);
+    }
+    return false;
+}
+
+Actor* PrefabPool::Spawn(const Transform& transform, Actor* parent)
+{
+    PROFILE_CPU();
+
+    // Pick the free instance (skip the ones destroyed in the meantime)
+    Actor* actor = nullptr;
+    while (!actor && _free.HasItems())
+    {
+        actor = _free.Last().Get();
+        _free.RemoveLast();
+    }
+    if (!actor)
+    {
+        actor = Create(parent);
+        if (!actor)
+            return nullptr;
+    }
+    else if (parent && actor->GetParent() != parent)
+    {
+        actor->SetParent(parent, false);
+    }
+
+    // Reset and activate the instance
+    actor->SetTransform(transform);
+    Spawned(actor);
+    actor->SetIsActive(true);
+    return actor;
+}
+
+void PrefabPool::Release(Actor* actor)
+{
+    if (!actor)
+        return;
+    Released(actor);
+    if (MaxFreeCount > 0 && _free.Count() >= MaxFreeCount)
+    {
+        actor->DeleteObject();
+        return;
+    }
+    actor->SetIsActive(false);
+    _free.Add(actor);
+}
+
+void PrefabPool::Clear()
+{
+    for (auto& e : _free)
+    {
+        Actor* actor = e.Get();
+        if (actor)
+            actor->DeleteObject();
+    }
+    _free.Clear();
+}
+
+Actor* PrefabPool::Create(Actor* parent)
+{
+    if (!_prefab)
+    {
+        LOG(Warning, "Missing prefab to spawn by the pool.");
+        return nullptr;
+    }
+    if (!parent)
+        parent = Level::Scenes.Count() != 0 ? Level::Scenes.Get()[0] : nullptr;
+
+    // Deserialize the prefab objects and deactivate the root before adding it to the scene, scripts get OnAwake but no OnEnable and the actors are not registered for drawing nor ticking
+    Actor* actor = PrefabManager::SpawnPrefab(_prefab.Get(), nullptr);
+    if (!actor)
+        return nullptr;
+    actor->SetIsActive(false);
+    if (parent)
+        actor->SetParent(parent, false);
+    return actor;
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Prefab.h"
+#include "Engine/Core/Delegate.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Content/AssetReference.h"
+#include "Engine/Scripting/ScriptingObject.h"
+#include "Engine/Scripting/ScriptingObjectReference.h"
+
+class Actor;
+
+/// <summary>
+/// The pool of reusable prefab instances for spawn-heavy gameplay (eg. projectiles or pickups). Released instances are deactivated and kept in the scene to be reused by the next spawn which skips the prefab deserialization, objects registration and the gameplay initialization.
+/// </summary>
+API_CLASS(Sealed) class FLAXENGINE_API PrefabPool : public ScriptingObject
+{
+    DECLARE_SCRIPTING_TYPE(PrefabPool);
+    ~PrefabPool();
+
+private:
+    AssetReference<Prefab> _prefab;
+    Array<ScriptingObjectReference<Actor>> _free;
+
+public:
+    /// <summary>
+    /// The maximum amount of the free instances kept in the pool. Instances released above that limit are destroyed. Use 0 to not limit it.
+    /// </summary>
+    API_FIELD() int32 MaxFreeCount = 0;
+
+    /// <summary>
+    /// Occurs when the pooled instance gets spawned (before activating it). Can be used to reset the gameplay state of the reused instance.
+    /// </summary>
+    API_EVENT() Delegate<Actor*> Spawned;
+
+    /// <summary>
+    /// Occurs when the pooled instance gets released back to the pool (before deactivating it).
+    /// </summary>
+    API_EVENT() Delegate<Actor*> Released;
+
+public:
+    /// <summary>
+    /// Gets the prefab asset used to create the pooled instances.
+    /// </summary>
+    API_PROPERTY() Prefab* GetPrefab() const;
+
+    /// <summary>
+    /// Sets the prefab asset used to create the pooled instances. Changing it clears the pool.
+    /// </summary>
+    API_PROPERTY() void SetPrefab(Prefab* value);
+
+    /// <summary>
+    /// Gets the amount of the free instances in the pool.
+    /// </summary>
+    API_PROPERTY() int32 GetFreeCount() const;
+
+public:
+    /// <summary>
+    /// Pre-instantiates the inactive prefab instances to be used by the next spawns (eg. during level loading to prevent the gameplay hitches).
+    /// </summary>
+    /// <param name="count">The amount of the instances to create.</param>
+    /// <param name="parent">The parent actor for the instances. Null to use the first loaded scene.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    API_FUNCTION() bool Warmup(int32 count, Actor* parent = nullptr);
+
+    /// <summary>
+    /// Spawns the prefab instance. Reuses the free instance from the pool if available, otherwise creates a new one.
+    /// </summary>
+    /// <param name="transform">The spawn transformation in the world space.</param>
+    /// <param name="parent">The parent actor to add the instance. Null to use the first loaded scene.</param>
+    /// <returns>The spawned actor (root) or null if failed.</returns>
+    API_FUNCTION() Actor* Spawn(const Transform& transform, Actor* parent = nullptr);
+
+    /// <summary>
+    /// Releases the instance back to the pool (deactivates it to be reused by the next spawn).
+    /// </summary>
+    /// <param name="actor">The actor (root) spawned from this pool.</param>
+    API_FUNCTION() void Release(Actor* actor);
+
+    /// <summary>
+    /// Destroys all the free instances from the pool.
+    /// </summary>
+    API_FUNCTION() void Clear();
+
+private:
+    Actor* Create(Actor* parent);
+};
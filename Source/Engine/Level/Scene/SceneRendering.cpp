@@ -2,13 +2,18 @@
 
 #define SCENE_RENDERING_USE_PROFILER_PER_ACTOR 0
 
+// The minimum amount of actors in the draw category to cull them via spatial tree
+#define SCENE_RENDERING_TREE_MIN_ACTORS 256
+
 #include "SceneRendering.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/RenderView.h"
 #include "Engine/Renderer/RenderList.h"
+#include "Engine/Renderer/OcclusionCullingPass.h"
 #include "Engine/Threading/JobSystem.h"
 #include "Engine/Threading/Threading.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Core/SIMD.h"
 
 ISceneRenderingListener::~ISceneRenderingListener()
 {
@@ -58,19 +63,87 @@ void SceneRendering::Draw(RenderContextBatch& renderContextBatch, DrawCategory c
     }
     auto& view = renderContextBatch.GetMainContext().View;
     auto& list = Actors[(int32)category];
-    _drawListData = list.Get();
-    _drawListSize = list.Count();
     _drawBatch = &renderContextBatch;
 
     // Setup frustum data
     const int32 frustumsCount = renderContextBatch.Contexts.Count();
     _drawFrustumsData.Resize(frustumsCount);
+    _drawFrustumsPlanes.Resize(frustumsCount * 6);
     for (int32 i = 0; i < frustumsCount; i++)
-        _drawFrustumsData.Get()[i] = renderContextBatch.Contexts.Get()[i].View.CullingFrustum;
+    {
+        const BoundingFrustum& frustum = renderContextBatch.Contexts.Get()[i].View.CullingFrustum;
+        _drawFrustumsData.Get()[i] = frustum;
+        for (int32 j = 0; j < 6; j++)
+        {
+            const Plane& plane = frustum.GetPlane(j);
+            _drawFrustumsPlanes.Get()[i * 6 + j] = Float4((float)plane.Normal.X, (float)plane.Normal.Y, (float)plane.Normal.Z, (float)plane.D);
+        }
+    }
+
+    // Gather actors to draw (skip whole areas of the scene outside all view frustums via spatial tree) and write their bounds for culling in a single pass (and occlusion queries for the main view)
+    _drawList.Clear();
+    _drawCullBlocks.Resize(Math::DivideAndRoundUp(list.Count(), SCENE_RENDERING_CULL_WIDTH), false);
+    CullBlock* blocks = _drawCullBlocks.Get();
+    OcclusionCullingData* occlusion = category == SceneDraw || category == SceneDrawAsync ? renderContextBatch.GetMainContext().List->Occlusion : nullptr;
+    const Vector3 origin = view.Origin;
+    const auto addDrawActor = [this, blocks, occlusion, &origin](const DrawActor& e)
+    {
+        const int32 i = _drawList.Count();
+        _drawList.Add(e.Actor);
+        CullBlock& block = blocks[i / SCENE_RENDERING_CULL_WIDTH];
+        const int32 lane = i % SCENE_RENDERING_CULL_WIDTH;
+        const Vector3 center = e.Bounds.Center - origin;
+        block.X[lane] = (float)center.X;
+        block.Y[lane] = (float)center.Y;
+        block.Z[lane] = (float)center.Z;
+        block.Radius[lane] = e.NoCulling ? MAX_float : (float)e.Bounds.Radius;
+        if (lane == 0)
+            block.OccludedMask = 0;
+        if (occlusion && !e.NoCulling)
+        {
+            occlusion->AddQuery(e.Actor, BoundingSphere(center, e.Bounds.Radius));
+            if (occlusion->IsOccluded(e.Actor))
+                block.OccludedMask |= 1 << lane;
+        }
+    };
+    const uint32 layersMask = view.RenderLayersMask.Mask;
+    const DrawActor* listData = list.Get();
+    if (list.Count() >= SCENE_RENDERING_TREE_MIN_ACTORS)
+    {
+        PROFILE_CPU_NAMED("Cull Tree");
+        _trees[(int32)category].Query([this, &origin](const BoundingSphere& bounds)
+        {
+            return FrustumsListCull(BoundingSphere(bounds.Center - origin, bounds.Radius), _drawFrustumsData);
+        }, [listData, layersMask, &addDrawActor](int32 key)
+        {
+            const DrawActor& e = listData[key];
+            if (e.LayerMask & layersMask)
+                addDrawActor(e);
+        });
+    }
+    else
+    {
+        for (int32 i = 0; i < list.Count(); i++)
+        {
+            const DrawActor& e = listData[i];
+            if (e.LayerMask & layersMask)
+                addDrawActor(e);
+        }
+    }
+    const int32 drawCount = _drawList.Count();
+    _drawListSize = Math::DivideAndRoundUp(drawCount, SCENE_RENDERING_CULL_WIDTH);
+    for (int32 i = drawCount; i < (int32)_drawListSize * SCENE_RENDERING_CULL_WIDTH; i++)
+    {
+        // Padding is always culled
+        CullBlock& block = blocks[i / SCENE_RENDERING_CULL_WIDTH];
+        const int32 lane = i % SCENE_RENDERING_CULL_WIDTH;
+        block.X[lane] = block.Y[lane] = block.Z[lane] = 0.0f;
+        block.Radius[lane] = -MAX_float;
+    }
 
     // Draw all visual components
     _drawListIndex = -1;
-    if (_drawListSize >= 64 && category == SceneDrawAsync && renderContextBatch.EnableAsync)
+    if (drawCount >= 64 && category == SceneDrawAsync && renderContextBatch.EnableAsync)
     {
         // Run in async via Job System
         Function<void(int32)> func;
@@ -132,11 +205,49 @@ void SceneRendering::Clear()
     _listeners.Clear();
     for (auto& e : Actors)
         e.Clear();
+    for (auto& e : _trees)
+        e.Clear();
 #if USE_EDITOR
     PhysicsDebug.Clear();
 #endif
 }
 
+void SceneRendering::QueryActors(const BoundingSphere& bounds, Array<Actor*>& actors)
+{
+    ScopeLock lock(Locker);
+    for (int32 category = 0; category < MAX; category++)
+    {
+        const DrawActor* listData = Actors[category].Get();
+        _trees[category].Query([&bounds](const BoundingSphere& nodeBounds)
+        {
+            return nodeBounds.Intersects(bounds);
+        }, [&bounds, &actors, listData](int32 key)
+        {
+            const DrawActor& e = listData[key];
+            if (e.Actor && e.Bounds.Intersects(bounds))
+                actors.Add(e.Actor);
+        });
+    }
+}
+
+void SceneRendering::QueryActors(const Ray& ray, Array<Actor*>& actors)
+{
+    ScopeLock lock(Locker);
+    for (int32 category = 0; category < MAX; category++)
+    {
+        const DrawActor* listData = Actors[category].Get();
+        _trees[category].Query([&ray](const BoundingSphere& nodeBounds)
+        {
+            return nodeBounds.Intersects(ray);
+        }, [&ray, &actors, listData](int32 key)
+        {
+            const DrawActor& e = listData[key];
+            if (e.Actor && e.Bounds.Intersects(ray))
+                actors.Add(e.Actor);
+        });
+    }
+}
+
 void SceneRendering::AddActor(Actor* a, int32& key)
 {
     if (key != -1)
@@ -158,6 +269,7 @@ void SceneRendering::AddActor(Actor* a, int32& key)
     e.LayerMask = a->GetLayerMask();
     e.Bounds = a->GetSphere();
     e.NoCulling = a->_drawNoCulling;
+    _trees[category].Add(key, e.Bounds, e.NoCulling);
     for (auto* listener : _listeners)
         listener->OnSceneRenderingAddActor(a);
 }
@@ -166,8 +278,19 @@ void SceneRendering::UpdateActor(Actor* a, int32& key)
 {
     const int32 category = a->_drawCategory;
     ScopeLock lock(Locker);
+    if (_updateBatch != 0)
+    {
+        // Defer update until the batch end (actor bounds are read at that point)
+        _pendingUpdates.Add({ a, key, category });
+        return;
+    }
+    UpdateActorInternal(a, key, category);
+}
+
+void SceneRendering::UpdateActorInternal(Actor* a, int32 key, int32 category)
+{
     auto& list = Actors[category];
-    if (list.Count() <= key) // Ignore invalid key softly
+    if (key < 0 || list.Count() <= key) // Ignore invalid key softly
         return;
     auto& e = list[key];
     if (e.Actor == a)
@@ -176,9 +299,30 @@ void SceneRendering::UpdateActor(Actor* a, int32& key)
             listener->OnSceneRenderingUpdateActor(a, e.Bounds);
         e.LayerMask = a->GetLayerMask();
         e.Bounds = a->GetSphere();
+        _trees[category].Update(key, e.Bounds, e.NoCulling);
     }
 }
 
+void SceneRendering::BeginUpdateBatch()
+{
+    ScopeLock lock(Locker);
+    _updateBatch++;
+}
+
+void SceneRendering::EndUpdateBatch()
+{
+    PROFILE_CPU();
+    ScopeLock lock(Locker);
+    ASSERT(_updateBatch > 0);
+    if (--_updateBatch != 0)
+        return;
+
+    // Apply all deferred updates at once (removed actors are skipped via the key validation)
+    for (const PendingUpdate& e : _pendingUpdates)
+        UpdateActorInternal(e.Actor, e.Key, e.Category);
+    _pendingUpdates.Clear();
+}
+
 void SceneRendering::RemoveActor(Actor* a, int32& key)
 {
     const int32 category = a->_drawCategory;
@@ -193,18 +337,51 @@ void SceneRendering::RemoveActor(Actor* a, int32& key)
                 listener->OnSceneRenderingRemoveActor(a);
             e.Actor = nullptr;
             e.LayerMask = 0;
+            _trees[category].Remove(key);
         }
     }
     key = -1;
 }
 
-#define FOR_EACH_BATCH_ACTOR const int64 count = _drawListSize; while (true) { const int64 index = Platform::InterlockedIncrement(&_drawListIndex); if (index >= count) break; auto e = _drawListData[index];
-#define CHECK_ACTOR ((view.RenderLayersMask.Mask & e.LayerMask) && (e.NoCulling || FrustumsListCull(e.Bounds, _drawFrustumsData)))
-#define CHECK_ACTOR_SINGLE_FRUSTUM ((view.RenderLayersMask.Mask & e.LayerMask) && (e.NoCulling || view.CullingFrustum.Intersects(e.Bounds)))
+// Culls the block of spheres against all frustums at once, returns the bitmask of lanes visible in any frustum
+FORCE_INLINE int32 CullSpheres(const float* x, const float* y, const float* z, const float* radius, const Float4* planes, int32 frustumsCount)
+{
+#if SCENE_RENDERING_CULL_WIDTH == 8
+#define SIMD_LOAD(src) SIMD::Load8(src)
+#define SIMD_SPLAT(value) SIMD::Splat8(value)
+#else
+#define SIMD_LOAD(src) SIMD::Load(src)
+#define SIMD_SPLAT(value) SIMD::Splat(value)
+#endif
+    constexpr int32 lanesMask = (1 << SCENE_RENDERING_CULL_WIDTH) - 1;
+    const auto vx = SIMD_LOAD(x);
+    const auto vy = SIMD_LOAD(y);
+    const auto vz = SIMD_LOAD(z);
+    const auto vr = SIMD_LOAD(radius);
+    int32 visible = 0;
+    for (int32 i = 0; i < frustumsCount; i++)
+    {
+        // Sphere is outside the frustum if it's behind any plane (distance + radius < 0)
+        int32 outside = 0;
+        for (int32 j = 0; j < 6; j++)
+        {
+            const Float4& plane = planes[i * 6 + j];
+            const auto distance = SIMD::Add(SIMD::Add(SIMD::Mul(vx, SIMD_SPLAT(plane.X)), SIMD::Mul(vy, SIMD_SPLAT(plane.Y))), SIMD::Add(SIMD::Mul(vz, SIMD_SPLAT(plane.Z)), SIMD::Add(vr, SIMD_SPLAT(plane.W))));
+            outside |= SIMD::MoveMask(distance);
+        }
+        visible |= ~outside & lanesMask;
+        if (visible == lanesMask)
+            break;
+    }
+    return visible;
+#undef SIMD_LOAD
+#undef SIMD_SPLAT
+}
+
 #if SCENE_RENDERING_USE_PROFILER_PER_ACTOR
-#define DRAW_ACTOR(mode) PROFILE_CPU_ACTOR(e.Actor); e.Actor->Draw(mode)
+#define DRAW_ACTOR(mode) PROFILE_CPU_ACTOR(actor); actor->Draw(mode)
 #else
-#define DRAW_ACTOR(mode) e.Actor->Draw(mode)
+#define DRAW_ACTOR(mode) actor->Draw(mode)
 #endif
 
 void SceneRendering::DrawActorsJob(int32)
@@ -212,50 +389,43 @@ void SceneRendering::DrawActorsJob(int32)
     PROFILE_CPU();
     auto& mainContext = _drawBatch->GetMainContext();
     const auto& view = mainContext.View;
-    if (view.IsOfflinePass)
+    const bool singleContext = _drawFrustumsData.Count() == 1 && !view.IsOfflinePass;
+    const int32 frustumsCount = _drawFrustumsData.Count();
+    const Float4* planes = _drawFrustumsPlanes.Get();
+    const CullBlock* blocks = _drawCullBlocks.Get();
+    Actor* const* drawList = _drawList.Get();
+    const int64 count = _drawListSize;
+    while (true)
     {
-        // Offline pass with additional static flags culling
-        FOR_EACH_BATCH_ACTOR
-            e.Bounds.Center -= view.Origin;
-            if (CHECK_ACTOR && (e.Actor->GetStaticFlags() & view.StaticFlagsMask) != StaticFlags::None)
-            {
-                DRAW_ACTOR(*_drawBatch);
-            }
+        const int64 index = Platform::InterlockedIncrement(&_drawListIndex);
+        if (index >= count)
+            break;
+        const CullBlock& block = blocks[index];
+        int32 visible = CullSpheres(block.X, block.Y, block.Z, block.Radius, planes, frustumsCount);
+        if (visible & block.OccludedMask)
+        {
+            // Actors occluded in the main view are drawn only if visible in the other views (eg. shadow projections)
+            const int32 otherVisible = frustumsCount > 1 ? CullSpheres(block.X, block.Y, block.Z, block.Radius, planes + 6, frustumsCount - 1) : 0;
+            visible &= ~block.OccludedMask | otherVisible;
         }
-    }
-    else if (view.Origin.IsZero() && _drawFrustumsData.Count() == 1)
-    {
-        // Fast path for no origin shifting with a single context
-        FOR_EACH_BATCH_ACTOR
-            if (CHECK_ACTOR_SINGLE_FRUSTUM)
+        if (visible == 0)
+            continue;
+        for (int32 lane = 0; lane < SCENE_RENDERING_CULL_WIDTH; lane++)
+        {
+            if ((visible & (1 << lane)) == 0)
+                continue;
+            Actor* actor = drawList[index * SCENE_RENDERING_CULL_WIDTH + lane];
+            if (singleContext)
             {
                 DRAW_ACTOR(mainContext);
             }
-        }
-    }
-    else if (view.Origin.IsZero())
-    {
-        // Fast path for no origin shifting
-        FOR_EACH_BATCH_ACTOR
-            if (CHECK_ACTOR)
-            {
-                DRAW_ACTOR(*_drawBatch);
-            }
-        }
-    }
-    else
-    {
-        // Generic case
-        FOR_EACH_BATCH_ACTOR
-            e.Bounds.Center -= view.Origin;
-            if (CHECK_ACTOR)
+            else if (!view.IsOfflinePass || (actor->GetStaticFlags() & view.StaticFlagsMask) != StaticFlags::None)
             {
+                // Offline pass with additional static flags culling
                 DRAW_ACTOR(*_drawBatch);
             }
         }
     }
 }
 
-#undef FOR_EACH_BATCH_ACTOR
-#undef CHECK_ACTOR
 #undef DRAW_ACTOR
@@ -8,6 +8,14 @@
 #include "Engine/Core/Math/BoundingFrustum.h"
 #include "Engine/Level/Actor.h"
 #include "Engine/Platform/CriticalSection.h"
+#include "SceneRenderingTree.h"
+
+// The amount of actors culled at once using SIMD
+#if PLATFORM_SIMD_AVX2
+#define SCENE_RENDERING_CULL_WIDTH 8
+#else
+#define SCENE_RENDERING_CULL_WIDTH 4
+#endif
 
 class SceneRenderTask;
 class SceneRendering;
@@ -104,6 +112,22 @@ class FLAXENGINE_API SceneRendering
     friend ISceneRenderingListener;
     Array<ISceneRenderingListener*, InlinedAllocation<8>> _listeners;
 
+    // Spatial index of the actors (per draw category) used for hierarchical culling
+    SceneRenderingTree _trees[MAX];
+
+    // Actors updates deferred during the batch (see BeginUpdateBatch)
+    struct PendingUpdate
+    {
+        Actor* Actor;
+        int32 Key;
+        int32 Category;
+    };
+
+    int32 _updateBatch = 0;
+    Array<PendingUpdate> _pendingUpdates;
+
+    void UpdateActorInternal(Actor* a, int32 key, int32 category);
+
 public:
     /// <summary>
     /// Draws the scene. Performs the optimized actors culling and draw calls submission for the current render pass (defined by the render view).
@@ -123,11 +147,35 @@ class FLAXENGINE_API SceneRendering
     /// </summary>
     void Clear();
 
+    /// <summary>
+    /// Gets the actors (from all draw categories) which bounds intersect with the given sphere. Uses the spatial index for fast culling.
+    /// </summary>
+    /// <param name="bounds">The bounds to test.</param>
+    /// <param name="actors">The output actors (appended).</param>
+    void QueryActors(const BoundingSphere& bounds, Array<Actor*>& actors);
+
+    /// <summary>
+    /// Gets the actors (from all draw categories) which bounds intersect with the given ray. Uses the spatial index for fast culling.
+    /// </summary>
+    /// <param name="ray">The ray to test.</param>
+    /// <param name="actors">The output actors (appended).</param>
+    void QueryActors(const Ray& ray, Array<Actor*>& actors);
+
 public:
     void AddActor(Actor* a, int32& key);
     void UpdateActor(Actor* a, int32& key);
     void RemoveActor(Actor* a, int32& key);
 
+    /// <summary>
+    /// Begins the batched actors update. Bounds updates get deferred until EndUpdateBatch to refresh the spatial index in a single pass (eg. for the physics write-back of many simulated rigidbodies).
+    /// </summary>
+    void BeginUpdateBatch();
+
+    /// <summary>
+    /// Ends the batched actors update and applies all deferred bounds updates. Calls must be paired with BeginUpdateBatch.
+    /// </summary>
+    void EndUpdateBatch();
+
     FORCE_INLINE void AddPostFxProvider(IPostFxSettingsProvider* obj)
     {
         PostFxProviders.Add(obj);
@@ -183,8 +231,21 @@ class FLAXENGINE_API SceneRendering
 #endif
 
 private:
+    // Bounds of the actors to draw in structure-of-arrays layout (relative to the view origin) for SIMD culling
+    ALIGN_BEGIN(16) struct CullBlock
+    {
+        float X[SCENE_RENDERING_CULL_WIDTH];
+        float Y[SCENE_RENDERING_CULL_WIDTH];
+        float Z[SCENE_RENDERING_CULL_WIDTH];
+        float Radius[SCENE_RENDERING_CULL_WIDTH];
+        // Lanes mask of the actors occluded in the main view.
+        int32 OccludedMask;
+    } ALIGN_END(16);
+
     Array<BoundingFrustum> _drawFrustumsData;
-    DrawActor* _drawListData;
+    Array<Float4> _drawFrustumsPlanes;
+    Array<Actor*> _drawList;
+    Array<CullBlock> _drawCullBlocks;
     int64 _drawListSize;
     volatile int64 _drawListIndex;
     RenderContextBatch* _drawBatch;
@@ -0,0 +1,135 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "SceneRenderingTree.h"
+
+void SceneRenderingTree::Add(int32 key, const BoundingSphere& bounds, bool unbounded)
+{
+    if (_locations.Count() <= key)
+    {
+        const int32 start = _locations.Count();
+        _locations.Resize(key + 1);
+        for (int32 i = start; i < _locations.Count(); i++)
+            _locations.Get()[i].Node = -2;
+    }
+    else if (_locations.Get()[key].Node != -2)
+    {
+        Erase(key);
+    }
+    Insert(key, unbounded ? -1 : FindNode(bounds));
+}
+
+void SceneRenderingTree::Update(int32 key, const BoundingSphere& bounds, bool unbounded)
+{
+    if (_locations.Count() <= key || _locations.Get()[key].Node == -2)
+    {
+        Add(key, bounds, unbounded);
+        return;
+    }
+    const int32 nodeIndex = unbounded ? -1 : FindNode(bounds);
+    if (_locations.Get()[key].Node != nodeIndex)
+    {
+        // Move item to the other node
+        Erase(key);
+        Insert(key, nodeIndex);
+    }
+}
+
+void SceneRenderingTree::Remove(int32 key)
+{
+    // Ignore invalid key softly (eg. after clear during scene unload)
+    if (_locations.Count() > key && key >= 0 && _locations.Get()[key].Node != -2)
+        Erase(key);
+}
+
+void SceneRenderingTree::Clear()
+{
+    _nodes.Clear();
+    _unbounded.Clear();
+    _locations.Clear();
+}
+
+int32 SceneRenderingTree::FindNode(const BoundingSphere& bounds)
+{
+    if (_nodes.IsEmpty())
+    {
+        auto& root = _nodes.AddOne();
+        root.Center = Vector3::Zero;
+        root.HalfSize = SCENE_RENDERING_TREE_SIZE;
+        root.Parent = -1;
+        root.Children = -1;
+        root.Count = 0;
+    }
+
+    // Objects outside the root node are not culled by the tree
+    const Vector3 center = bounds.Center;
+    if (bounds.Radius > SCENE_RENDERING_TREE_SIZE ||
+        Math::Abs(center.X) > SCENE_RENDERING_TREE_SIZE ||
+        Math::Abs(center.Y) > SCENE_RENDERING_TREE_SIZE ||
+        Math::Abs(center.Z) > SCENE_RENDERING_TREE_SIZE)
+        return -1;
+
+    // Go down the tree into the cell that contains the object center as long as object fits into the child loose bounds
+    int32 nodeIndex = 0;
+    for (int32 depth = 0; depth < SCENE_RENDERING_TREE_MAX_DEPTH; depth++)
+    {
+        const Node& node = _nodes.Get()[nodeIndex];
+        const Real childHalfSize = node.HalfSize * 0.5f;
+        if (bounds.Radius > childHalfSize)
+            break;
+        const Vector3 nodeCenter = node.Center;
+        int32 children = node.Children;
+        if (children == -1)
+        {
+            // Create child nodes
+            children = _nodes.Count();
+            _nodes.Get()[nodeIndex].Children = children;
+            for (int32 i = 0; i < 8; i++)
+            {
+                auto& child = _nodes.AddOne();
+                child.Center = nodeCenter + Vector3(i & 1 ? childHalfSize : -childHalfSize, i & 2 ? childHalfSize : -childHalfSize, i & 4 ? childHalfSize : -childHalfSize);
+                child.HalfSize = childHalfSize;
+                child.Parent = nodeIndex;
+                child.Children = -1;
+                child.Count = 0;
+            }
+        }
+        nodeIndex = children + (center.X >= nodeCenter.X ? 1 : 0) + (center.Y >= nodeCenter.Y ? 2 : 0) + (center.Z >= nodeCenter.Z ? 4 : 0);
+    }
+    return nodeIndex;
+}
+
+void SceneRenderingTree::Insert(int32 key, int32 nodeIndex)
+{
+    Location& location = _locations.Get()[key];
+    location.Node = nodeIndex;
+    if (nodeIndex == -1)
+    {
+        location.Index = _unbounded.Count();
+        _unbounded.Add(key);
+        return;
+    }
+    Node* nodes = _nodes.Get();
+    location.Index = nodes[nodeIndex].Items.Count();
+    nodes[nodeIndex].Items.Add(key);
+    for (int32 i = nodeIndex; i != -1; i = nodes[i].Parent)
+        nodes[i].Count++;
+}
+
+void SceneRenderingTree::Erase(int32 key)
+{
+    Location& location = _locations.Get()[key];
+    Array<int32>& items = location.Node == -1 ? _unbounded : _nodes.Get()[location.Node].Items;
+
+    // Swap-remove the item and fix the location of the moved item
+    const int32 last = items.Last();
+    items.Get()[location.Index] = last;
+    _locations.Get()[last].Index = location.Index;
+    items.RemoveLast();
+    if (location.Node != -1)
+    {
+        Node* nodes = _nodes.Get();
+        for (int32 i = location.Node; i != -1; i = nodes[i].Parent)
+            nodes[i].Count--;
+    }
+    location.Node = -2;
+}
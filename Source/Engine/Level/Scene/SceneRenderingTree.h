@@ -0,0 +1,107 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Math/BoundingSphere.h"
+
+// The half-size of the spatial tree root node (objects outside it are always visited by queries)
+#define SCENE_RENDERING_TREE_SIZE 1048576.0f
+
+// The maximum depth of the spatial tree nodes
+#define SCENE_RENDERING_TREE_MAX_DEPTH 12
+
+/// <summary>
+/// Loose octree with the bounds of the scene rendering actors used for hierarchical culling. Updated incrementally on actors changes.
+/// </summary>
+/// <remarks>Items are identified by the keys of the actors in the scene rendering list. Loose node bounds are twice the node cell size, so each item is placed in the deepest node that fully contains it.</remarks>
+class FLAXENGINE_API SceneRenderingTree
+{
+public:
+    struct Node
+    {
+        Vector3 Center;
+        Real HalfSize;
+        int32 Parent;
+        // Index of the first of 8 child nodes or -1 if not created.
+        int32 Children;
+        // Amount of items in this node and its children.
+        int32 Count;
+        Array<int32> Items;
+    };
+
+private:
+    struct Location
+    {
+        // Index of the node with item, -1 for items not in the tree (unbounded) or -2 if not added.
+        int32 Node;
+        int32 Index;
+    };
+
+    Array<Node> _nodes;
+    Array<int32> _unbounded;
+    Array<Location> _locations;
+
+public:
+    /// <summary>
+    /// Adds the item to the tree.
+    /// </summary>
+    /// <param name="key">The item key.</param>
+    /// <param name="bounds">The item bounds.</param>
+    /// <param name="unbounded">True if item bounds should be ignored and it should be always visited by the queries.</param>
+    void Add(int32 key, const BoundingSphere& bounds, bool unbounded = false);
+
+    /// <summary>
+    /// Updates the item bounds in the tree.
+    /// </summary>
+    /// <param name="key">The item key.</param>
+    /// <param name="bounds">The item bounds.</param>
+    /// <param name="unbounded">True if item bounds should be ignored and it should be always visited by the queries.</param>
+    void Update(int32 key, const BoundingSphere& bounds, bool unbounded = false);
+
+    /// <summary>
+    /// Removes the item from the tree.
+    /// </summary>
+    /// <param name="key">The item key.</param>
+    void Remove(int32 key);
+
+    /// <summary>
+    /// Clears the tree.
+    /// </summary>
+    void Clear();
+
+    /// <summary>
+    /// Visits the tree items within the nodes that pass the test (whole subtrees are skipped for failed nodes). Unbounded items are always visited.
+    /// </summary>
+    /// <param name="nodeTest">The node test function that takes the loose node bounds sphere and returns true if visit the node.</param>
+    /// <param name="itemFunc">The function called for each visited item key.</param>
+    template<typename NodeTest, typename ItemFunc>
+    void Query(const NodeTest& nodeTest, const ItemFunc& itemFunc) const
+    {
+        for (const int32 key : _unbounded)
+            itemFunc(key);
+        if (_nodes.IsEmpty())
+            return;
+        const Node* nodes = _nodes.Get();
+        Array<int32, InlinedAllocation<128>> stack;
+        stack.Add(0);
+        while (stack.HasItems())
+        {
+            const Node& node = nodes[stack.Pop()];
+            if (node.Count == 0 || !nodeTest(BoundingSphere(node.Center, node.HalfSize * (Real)(2.0f * 1.7320508f))))
+                continue;
+            for (const int32 key : node.Items)
+                itemFunc(key);
+            if (node.Children != -1)
+            {
+                for (int32 i = 0; i < 8; i++)
+                    stack.Add(node.Children + i);
+            }
+        }
+    }
+
+private:
+    int32 FindNode(const BoundingSphere& bounds);
+    void Insert(int32 key, int32 nodeIndex);
+    void Erase(int32 key);
+};
@@ -3,6 +3,87 @@
 #include "SceneTicking.h"
 #include "Scene.h"
 #include "Engine/Scripting/Script.h"
+#include "Engine/Platform/CriticalSection.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/JobSystem.h"
+#if USE_NETCORE
+#include "Engine/Core/Log.h"
+#include "Engine/Debug/DebugLog.h"
+#include "Engine/Scripting/ManagedCLR/MClass.h"
+#include "Engine/Scripting/ManagedCLR/MMethod.h"
+#endif
+
+// The amount of the parallel scripts updated by a single job
+#define SCENE_TICKING_PARALLEL_CHUNK_SIZE 64
+
+namespace
+{
+    volatile int64 ParallelTicking = 0;
+    CriticalSection DeferredActionsLocker;
+    Array<Function<void()>> DeferredActions;
+    const Array<Script*>* ParallelScripts = nullptr;
+
+    void TickScriptsParallelJob(int32 index)
+    {
+        const Array<Script*>& scripts = *ParallelScripts;
+        const int32 start = index * SCENE_TICKING_PARALLEL_CHUNK_SIZE;
+        const int32 end = Math::Min(start + SCENE_TICKING_PARALLEL_CHUNK_SIZE, scripts.Count());
+        for (int32 i = start; i < end; i++)
+        {
+            scripts.Get()[i]->OnUpdate();
+        }
+    }
+
+#if USE_NETCORE
+    MMethod* TickScriptsBatchMethod = nullptr;
+    Array<Script*> ScriptsBatch;
+    Array<MObject*> ScriptsBatchObjects;
+
+    void FlushScriptsBatch(int32 phase, void (Script::*method)())
+    {
+        if (ScriptsBatch.IsEmpty())
+            return;
+        if (TickScriptsBatchMethod == nullptr)
+        {
+            MClass* mclass = Script::GetStaticClass();
+            TickScriptsBatchMethod = mclass ? mclass->GetMethod("Internal_TickScripts", 3) : nullptr;
+            if (TickScriptsBatchMethod == nullptr)
+            {
+                LOG(Error, "Missing Script.Internal_TickScripts method. Disabling batched managed update.");
+                Script::BatchManagedUpdate = false;
+                for (Script* script : ScriptsBatch)
+                    (script->*method)();
+                ScriptsBatch.Clear();
+                ScriptsBatchObjects.Clear();
+                return;
+            }
+        }
+
+        // Tick all scripts from the batch with a single call to the managed code
+        void* objects = ScriptsBatchObjects.Get();
+        int32 count = ScriptsBatchObjects.Count();
+        void* params[3];
+        params[0] = &objects;
+        params[1] = &count;
+        params[2] = &phase;
+        MObject* exception = nullptr;
+        TickScriptsBatchMethod->Invoke(nullptr, params, &exception);
+        DebugLog::LogException(exception);
+        ScriptsBatch.Clear();
+        ScriptsBatchObjects.Clear();
+    }
+#endif
+
+    void FlushDeferredActions()
+    {
+        PROFILE_CPU();
+        DeferredActionsLocker.Lock();
+        Array<Function<void()>> actions = MoveTemp(DeferredActions);
+        DeferredActionsLocker.Unlock();
+        for (const auto& action : actions)
+            action();
+    }
+}
 
 SceneTicking::TickData::TickData(int32 capacity)
     : Scripts(capacity)
@@ -82,6 +163,30 @@ void SceneTicking::TickData::Clear()
 #endif
 }
 
+#if USE_NETCORE
+
+void SceneTicking::TickData::TickScriptsBatched(const Array<Script*>& scripts, int32 phase, void (Script::*method)())
+{
+    for (Script* script : scripts)
+    {
+        MObject* object;
+        if (script->_managedTick && (object = script->GetOrCreateManagedInstance()) != nullptr)
+        {
+            ScriptsBatch.Add(script);
+            ScriptsBatchObjects.Add(object);
+        }
+        else
+        {
+            // Keep the scripts order by ticking the pending managed scripts before the native one
+            FlushScriptsBatch(phase, method);
+            (script->*method)();
+        }
+    }
+    FlushScriptsBatch(phase, method);
+}
+
+#endif
+
 SceneTicking::FixedUpdateTickData::FixedUpdateTickData()
     : TickData(512)
 {
@@ -89,6 +194,13 @@ SceneTicking::FixedUpdateTickData::FixedUpdateTickData()
 
 void SceneTicking::FixedUpdateTickData::TickScripts(const Array<Script*>& scripts)
 {
+#if USE_NETCORE
+    if (Script::BatchManagedUpdate)
+    {
+        TickScriptsBatched(scripts, 2, &Script::OnFixedUpdate);
+        return;
+    }
+#endif
     for (auto* script : scripts)
     {
         script->OnFixedUpdate();
@@ -102,12 +214,85 @@ SceneTicking::UpdateTickData::UpdateTickData()
 
 void SceneTicking::UpdateTickData::TickScripts(const Array<Script*>& scripts)
 {
+#if USE_NETCORE
+    if (Script::BatchManagedUpdate)
+    {
+        TickScriptsBatched(scripts, 0, &Script::OnUpdate);
+        return;
+    }
+#endif
     for (auto* script : scripts)
     {
         script->OnUpdate();
     }
 }
 
+void SceneTicking::UpdateTickData::TickScriptsParallel()
+{
+    if (ScriptsParallel.IsEmpty())
+        return;
+    PROFILE_CPU();
+
+    // Update scripts in chunks on job system workers (actions deferred by scripts are executed after all jobs end)
+    Platform::AtomicStore(&ParallelTicking, 1);
+    ParallelScripts = &ScriptsParallel;
+    const int32 jobCount = Math::DivideAndRoundUp(ScriptsParallel.Count(), SCENE_TICKING_PARALLEL_CHUNK_SIZE);
+    if (jobCount == 1)
+        TickScriptsParallelJob(0);
+    else
+        JobSystem::Execute(TickScriptsParallelJob, jobCount);
+    ParallelScripts = nullptr;
+    Platform::AtomicStore(&ParallelTicking, 0);
+    FlushDeferredActions();
+}
+
+void SceneTicking::UpdateTickData::AddScript(Script* script)
+{
+    if (script->_parallelUpdate)
+    {
+        ScriptsParallel.Add(script);
+#if USE_EDITOR
+        if (script->_executeInEditor)
+            ScriptsExecuteInEditor.Add(script);
+#endif
+    }
+    else
+    {
+        TickData::AddScript(script);
+    }
+}
+
+void SceneTicking::UpdateTickData::RemoveScript(Script* script)
+{
+    if (script->_parallelUpdate)
+    {
+        ScriptsParallel.Remove(script);
+#if USE_EDITOR
+        if (script->_executeInEditor)
+            ScriptsExecuteInEditor.Remove(script);
+#endif
+    }
+    else
+    {
+        TickData::RemoveScript(script);
+    }
+}
+
+void SceneTicking::UpdateTickData::Tick()
+{
+    TickScripts(Scripts);
+    TickScriptsParallel();
+
+    for (int32 i = 0; i < Ticks.Count(); i++)
+        Ticks.Get()[i].Call();
+}
+
+void SceneTicking::UpdateTickData::Clear()
+{
+    TickData::Clear();
+    ScriptsParallel.Clear();
+}
+
 SceneTicking::LateUpdateTickData::LateUpdateTickData()
     : TickData(64)
 {
@@ -115,6 +300,13 @@ SceneTicking::LateUpdateTickData::LateUpdateTickData()
 
 void SceneTicking::LateUpdateTickData::TickScripts(const Array<Script*>& scripts)
 {
+#if USE_NETCORE
+    if (Script::BatchManagedUpdate)
+    {
+        TickScriptsBatched(scripts, 1, &Script::OnLateUpdate);
+        return;
+    }
+#endif
     for (auto* script : scripts)
     {
         script->OnLateUpdate();
@@ -128,6 +320,13 @@ SceneTicking::LateFixedUpdateTickData::LateFixedUpdateTickData()
 
 void SceneTicking::LateFixedUpdateTickData::TickScripts(const Array<Script*>& scripts)
 {
+#if USE_NETCORE
+    if (Script::BatchManagedUpdate)
+    {
+        TickScriptsBatched(scripts, 3, &Script::OnLateFixedUpdate);
+        return;
+    }
+#endif
     for (auto* script : scripts)
     {
         script->OnLateFixedUpdate();
@@ -160,6 +359,17 @@ void SceneTicking::RemoveScript(Script* obj)
         LateFixedUpdate.RemoveScript(obj);
 }
 
+void SceneTicking::Defer(const Function<void()>& action)
+{
+    if (Platform::AtomicRead(&ParallelTicking) == 0)
+    {
+        action();
+        return;
+    }
+    ScopeLock lock(DeferredActionsLocker);
+    DeferredActions.Add(action);
+}
+
 void SceneTicking::Clear()
 {
     FixedUpdate.Clear();
@@ -3,7 +3,9 @@
 #pragma once
 
 #include "Engine/Level/Types.h"
+#include "Engine/Core/Delegate.h"
 #include "Engine/Core/Collections/Array.h"
+#include "Engine/Scripting/Types.h"
 
 /// <summary>
 /// Scene gameplay updating helper subsystem that boosts the level ticking by providing efficient objects cache.
@@ -58,8 +60,8 @@ class FLAXENGINE_API SceneTicking
 
         virtual void TickScripts(const Array<Script*>& scripts) = 0;
 
-        void AddScript(Script* script);
-        void RemoveScript(Script* script);
+        virtual void AddScript(Script* script);
+        virtual void RemoveScript(Script* script);
 
         template<class T, void(T::*Method)()>
         void AddTick(T* callee)
@@ -70,7 +72,7 @@ class FLAXENGINE_API SceneTicking
         }
 
         void RemoveTick(void* callee);
-        void Tick();
+        virtual void Tick();
 
 #if USE_EDITOR
         template<class T, void(T::*Method)()>
@@ -85,7 +87,12 @@ class FLAXENGINE_API SceneTicking
         void TickExecuteInEditor();
 #endif
 
-        void Clear();
+        virtual void Clear();
+
+    protected:
+#if USE_NETCORE
+        static void TickScriptsBatched(const Array<Script*>& scripts, int32 phase, void (Script::*method)());
+#endif
     };
 
     class FLAXENGINE_API FixedUpdateTickData : public TickData
@@ -98,8 +105,17 @@ class FLAXENGINE_API SceneTicking
     class FLAXENGINE_API UpdateTickData : public TickData
     {
     public:
+        // Scripts with thread-safe update that are ticked in parallel using Job System (see Script::GetParallelUpdate).
+        Array<Script*> ScriptsParallel;
+
         UpdateTickData();
         void TickScripts(const Array<Script*>& scripts) override;
+        void TickScriptsParallel();
+
+        void AddScript(Script* script) override;
+        void RemoveScript(Script* script) override;
+        void Tick() override;
+        void Clear() override;
     };
 
     class FLAXENGINE_API LateUpdateTickData : public TickData
@@ -134,6 +150,12 @@ class FLAXENGINE_API SceneTicking
     /// </summary>
     void Clear();
 
+    /// <summary>
+    /// Queues the action to be executed on the main thread after the parallel scripts update. Use it to perform structural changes (eg. spawn, destroy or reparent objects) from the scripts with the thread-safe update. Executes action immediately when called outside the parallel update.
+    /// </summary>
+    /// <param name="action">The action to execute.</param>
+    static void Defer(const Function<void()>& action);
+
 public:
     /// <summary>
     /// The fixed update tick function.
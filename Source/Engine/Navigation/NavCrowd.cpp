@@ -7,6 +7,7 @@
 #include "Engine/Level/Level.h"
 #include "Engine/Level/Scene/Scene.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Threading/Threading.h"
 #include <ThirdParty/recastnavigation/DetourCrowd.h>
 
@@ -82,6 +83,8 @@ bool NavCrowd::Init(float maxAgentRadius, int32 maxAgents, NavMeshRuntime* navMe
         }
     }
 
+    _skippedAgents.Resize(Math::Max(maxAgents, 0));
+    _skippedAgents.SetAll(0);
     return !_crowd->init(maxAgents, maxAgentRadius, navMesh->GetNavMesh());
 }
 
@@ -171,7 +174,82 @@ void NavCrowd::RemoveAgent(int32 id)
 void NavCrowd::Update(float dt)
 {
     PROFILE_CPU();
-    _crowd->update(Math::Max(dt, ZeroTolerance), nullptr);
+    dt = Math::Max(dt, ZeroTolerance);
+    const bool useLOD = LODDistance > ZeroTolerance && _skippedAgents.Count() == _crowd->getAgentCount();
+    if (useLOD)
+        UpdateLOD(dt);
+
+    _crowd->update(dt, nullptr);
+
+    if (useLOD)
+    {
+        // Restore agents skipped by LOD
+        for (int32 i = 0; i < _skippedAgents.Count(); i++)
+        {
+            if (_skippedAgents[i])
+            {
+                _skippedAgents[i] = 0;
+                _crowd->getEditableAgent(i)->state = DT_CROWDAGENT_STATE_WALKING;
+            }
+        }
+    }
+    _frame++;
+}
+
+void NavCrowd::UpdateCrowds(const Array<NavCrowd*>& crowds, float dt)
+{
+    if (crowds.Count() == 1)
+    {
+        if (crowds[0])
+            crowds[0]->Update(dt);
+        return;
+    }
+    PROFILE_CPU();
+
+    // Each crowd uses own navmesh query and agents so they can be simulated in parallel
+    JobSystem::Execute([&](int32 i)
+    {
+        if (crowds[i])
+            crowds[i]->Update(dt);
+    }, crowds.Count());
+}
+
+void NavCrowd::UpdateLOD(float dt)
+{
+    PROFILE_CPU();
+    const Float3 origin = LODOrigin;
+    const float lodDistanceSqr = LODDistance * LODDistance;
+    const uint32 interval = (uint32)Math::Max(LODUpdateInterval, 1);
+    const int32 agentsCount = _crowd->getAgentCount();
+    for (int32 i = 0; i < agentsCount; i++)
+    {
+        dtCrowdAgent* agent = _crowd->getEditableAgent(i);
+        if (!agent || !agent->active)
+            continue;
+        const bool isFar = Float3::DistanceSquared(origin, *(Float3*)agent->npos) > lodDistanceSqr;
+
+        // Distant agents skip the local avoidance (the most expensive part of the crowd simulation)
+        uint8 updateFlags = agent->params.updateFlags;
+        if (isFar)
+        {
+            updateFlags &= ~(DT_CROWD_OBSTACLE_AVOIDANCE | DT_CROWD_SEPARATION);
+        }
+        else
+        {
+            updateFlags |= DT_CROWD_OBSTACLE_AVOIDANCE;
+            if (agent->params.separationWeight > 0.001f)
+                updateFlags |= DT_CROWD_SEPARATION;
+        }
+        agent->params.updateFlags = updateFlags;
+
+        // Distant agents are updated at reduced rate (spread across frames by agent index) and keep moving with the last velocity in between
+        if (isFar && interval > 1 && agent->state == DT_CROWDAGENT_STATE_WALKING && (_frame + (uint32)i) % interval != 0)
+        {
+            *(Float3*)agent->npos += *(Float3*)agent->vel * dt;
+            agent->state = DT_CROWDAGENT_STATE_INVALID;
+            _skippedAgents[i] = 1;
+        }
+    }
 }
 
 void NavCrowd::InitCrowdAgentParams(dtCrowdAgentParams& agentParams, const NavAgentProperties& properties)
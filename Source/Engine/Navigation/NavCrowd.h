@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Engine/Scripting/ScriptingObject.h"
+#include "Engine/Core/Collections/Array.h"
 #include "NavigationTypes.h"
 
 class NavMesh;
@@ -18,10 +19,27 @@ API_CLASS() class FLAXENGINE_API NavCrowd : public ScriptingObject
     DECLARE_SCRIPTING_TYPE(NavCrowd);
 private:
     dtCrowd* _crowd;
+    uint32 _frame = 0;
+    Array<byte> _skippedAgents;
 
 public:
     ~NavCrowd();
 
+    /// <summary>
+    /// The distance from the LOD origin above which agents use the simplified simulation (no local avoidance and separation, updated every LODUpdateInterval frames). Use 0 to disable crowd LOD.
+    /// </summary>
+    API_FIELD(Attributes="Limit(0)") float LODDistance = 0.0f;
+
+    /// <summary>
+    /// The location used to calculate the agents LOD (eg. player or camera position).
+    /// </summary>
+    API_FIELD() Vector3 LODOrigin = Vector3::Zero;
+
+    /// <summary>
+    /// The update interval (in frames) of the agents that are further than LODDistance from the LOD origin. Distant agents updates are spread across frames.
+    /// </summary>
+    API_FIELD(Attributes="Limit(1, 60)") int32 LODUpdateInterval = 4;
+
     /// <summary>
     /// Initializes the crowd.
     /// </summary>
@@ -122,6 +140,14 @@ API_CLASS() class FLAXENGINE_API NavCrowd : public ScriptingObject
     /// <param name="dt">The simulation update delta time (in seconds).</param>
     API_FUNCTION() void Update(float dt);
 
+    /// <summary>
+    /// Updates the steering and positions of all agents in the given crowds. Crowds are simulated in parallel using Job System (eg. spatially partitioned groups of agents that use separate crowds).
+    /// </summary>
+    /// <param name="crowds">The crowds to update.</param>
+    /// <param name="dt">The simulation update delta time (in seconds).</param>
+    API_FUNCTION() static void UpdateCrowds(const Array<NavCrowd*>& crowds, float dt);
+
 private:
+    void UpdateLOD(float dt);
     void InitCrowdAgentParams(dtCrowdAgentParams& agentParams, const NavAgentProperties& properties);
 };
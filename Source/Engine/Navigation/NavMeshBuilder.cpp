@@ -10,6 +10,7 @@
 #include "NavModifierVolume.h"
 #include "NavMeshRuntime.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Core/Math/BoundingBox.h"
 #include "Engine/Core/Math/Vector3.h"
 #include "Engine/Physics/Colliders/BoxCollider.h"
@@ -27,6 +28,8 @@
 #include <ThirdParty/recastnavigation/Recast.h>
 #include <ThirdParty/recastnavigation/DetourNavMeshBuilder.h>
 #include <ThirdParty/recastnavigation/DetourNavMesh.h>
+#include <ThirdParty/recastnavigation/RecastAlloc.h>
+#include <ThirdParty/LZ4/lz4.h>
 
 int32 BoxTrianglesIndicesCache[] =
 {
@@ -82,6 +85,7 @@ struct NavigationSceneRasterization
     Array<OffMeshLink>* OffMeshLinks;
     Array<Modifier>* Modifiers;
     const bool IsWorldToNavMeshIdentity;
+    bool SkipGeometry;
 
     NavigationSceneRasterization(::NavMesh* navMesh, const BoundingBox& tileBoundsNavMesh, const Matrix& worldToNavMesh, rcContext* context, rcConfig* config, rcHeightfield* heightfield, Array<OffMeshLink>* offMeshLinks, Array<Modifier>* modifiers)
         : TileBoundsNavMesh(tileBoundsNavMesh)
@@ -95,13 +99,14 @@ struct NavigationSceneRasterization
         WalkableThreshold = Math::Cos(config->walkableSlopeAngle * DegreesToRadians);
         OffMeshLinks = offMeshLinks;
         Modifiers = modifiers;
+        SkipGeometry = heightfield == nullptr;
     }
 
     void RasterizeTriangles()
     {
         auto& vb = VertexBuffer;
         auto& ib = IndexBuffer;
-        if (vb.IsEmpty() || ib.IsEmpty())
+        if (vb.IsEmpty() || ib.IsEmpty() || SkipGeometry)
             return;
 
         // Rasterize triangles
@@ -225,6 +230,10 @@ struct NavigationSceneRasterization
         if (!actorBoxNavMesh.Intersects(e.TileBoundsNavMesh))
             return true;
 
+        // Geometry is already rasterized in the cached tile so gather only links and modifiers
+        if (e.SkipGeometry && !dynamic_cast<NavLink*>(actor) && !dynamic_cast<NavModifierVolume*>(actor))
+            return true;
+
         // Prepare buffers (for triangles)
         auto& vb = e.VertexBuffer;
         auto& ib = e.IndexBuffer;
@@ -408,6 +417,147 @@ bool GetNavMeshTileBounds(Scene* scene, NavMesh* navMesh, int32 x, int32 y, floa
     return foundAnyVolume;
 }
 
+struct NavTileCacheKey
+{
+    Guid NavMeshId;
+    int32 X;
+    int32 Y;
+
+    bool operator==(const NavTileCacheKey& other) const
+    {
+        return NavMeshId == other.NavMeshId && X == other.X && Y == other.Y;
+    }
+};
+
+uint32 GetHash(const NavTileCacheKey& key)
+{
+    uint32 hash = GetHash(key.NavMeshId);
+    CombineHash(hash, GetHash(key.X));
+    CombineHash(hash, GetHash(key.Y));
+    return hash;
+}
+
+// Compressed compact heightfield of the tile (rasterized and filtered scene geometry, before erosion and areas marking)
+struct NavTileCacheEntry
+{
+    int32 Width;
+    int32 Height;
+    int32 SpanCount;
+    int32 WalkableHeight;
+    int32 WalkableClimb;
+    int32 BorderSize;
+    Float3 BoundsMin;
+    Float3 BoundsMax;
+    float CellSize;
+    float CellHeight;
+    int32 DataSize;
+    Array<byte> Data;
+};
+
+CriticalSection NavTileCacheLocker;
+Dictionary<NavTileCacheKey, NavTileCacheEntry> NavTileCache;
+
+void SaveCachedTile(NavMesh* navMesh, int32 x, int32 y, const rcCompactHeightfield& chf)
+{
+    PROFILE_CPU_NAMED("SaveCachedTile");
+
+    NavTileCacheEntry entry;
+    entry.Width = chf.width;
+    entry.Height = chf.height;
+    entry.SpanCount = chf.spanCount;
+    entry.WalkableHeight = chf.walkableHeight;
+    entry.WalkableClimb = chf.walkableClimb;
+    entry.BorderSize = chf.borderSize;
+    entry.BoundsMin = Float3(chf.bmin);
+    entry.BoundsMax = Float3(chf.bmax);
+    entry.CellSize = chf.cs;
+    entry.CellHeight = chf.ch;
+    const int32 cellsSize = chf.width * chf.height * sizeof(rcCompactCell);
+    const int32 spansSize = chf.spanCount * sizeof(rcCompactSpan);
+    entry.DataSize = cellsSize + spansSize + chf.spanCount;
+
+    Array<byte> data;
+    data.Resize(entry.DataSize);
+    Platform::MemoryCopy(data.Get(), chf.cells, cellsSize);
+    Platform::MemoryCopy(data.Get() + cellsSize, chf.spans, spansSize);
+    Platform::MemoryCopy(data.Get() + cellsSize + spansSize, chf.areas, chf.spanCount);
+    entry.Data.Resize(LZ4_compressBound(entry.DataSize));
+    const int32 compressedSize = LZ4_compress_default((const char*)data.Get(), (char*)entry.Data.Get(), entry.DataSize, entry.Data.Count());
+    if (compressedSize <= 0)
+        return;
+    entry.Data.Resize(compressedSize);
+
+    ScopeLock lock(NavTileCacheLocker);
+    NavTileCache[NavTileCacheKey{ navMesh->GetID(), x, y }] = MoveTemp(entry);
+}
+
+rcCompactHeightfield* LoadCachedTile(NavMesh* navMesh, int32 x, int32 y, const rcConfig& config)
+{
+    PROFILE_CPU_NAMED("LoadCachedTile");
+    ScopeLock lock(NavTileCacheLocker);
+
+    // Skip missing or outdated tiles (eg. navmesh settings were modified)
+    const NavTileCacheEntry* entry = NavTileCache.TryGet(NavTileCacheKey{ navMesh->GetID(), x, y });
+    if (!entry ||
+        entry->Width != config.width ||
+        entry->Height != config.height ||
+        entry->WalkableHeight != config.walkableHeight ||
+        entry->WalkableClimb != config.walkableClimb ||
+        entry->BorderSize != config.borderSize ||
+        Math::NotNearEqual(entry->CellSize, config.cs) ||
+        Math::NotNearEqual(entry->CellHeight, config.ch))
+        return nullptr;
+
+    const int32 cellsSize = entry->Width * entry->Height * sizeof(rcCompactCell);
+    const int32 spansSize = entry->SpanCount * sizeof(rcCompactSpan);
+    Array<byte> data;
+    data.Resize(entry->DataSize);
+    if (LZ4_decompress_safe((const char*)entry->Data.Get(), (char*)data.Get(), entry->Data.Count(), entry->DataSize) != entry->DataSize)
+        return nullptr;
+    rcCompactHeightfield* chf = rcAllocCompactHeightfield();
+    if (!chf)
+        return nullptr;
+    chf->width = entry->Width;
+    chf->height = entry->Height;
+    chf->spanCount = entry->SpanCount;
+    chf->walkableHeight = entry->WalkableHeight;
+    chf->walkableClimb = entry->WalkableClimb;
+    chf->borderSize = entry->BorderSize;
+    *(Float3*)chf->bmin = entry->BoundsMin;
+    *(Float3*)chf->bmax = entry->BoundsMax;
+    chf->cs = entry->CellSize;
+    chf->ch = entry->CellHeight;
+    chf->cells = (rcCompactCell*)rcAlloc(cellsSize, RC_ALLOC_PERM);
+    chf->spans = (rcCompactSpan*)rcAlloc(spansSize, RC_ALLOC_PERM);
+    chf->areas = (unsigned char*)rcAlloc(entry->SpanCount, RC_ALLOC_PERM);
+    if (!chf->cells || !chf->spans || !chf->areas)
+    {
+        rcFreeCompactHeightfield(chf);
+        return nullptr;
+    }
+    Platform::MemoryCopy(chf->cells, data.Get(), cellsSize);
+    Platform::MemoryCopy(chf->spans, data.Get() + cellsSize, spansSize);
+    Platform::MemoryCopy(chf->areas, data.Get() + cellsSize + spansSize, entry->SpanCount);
+    return chf;
+}
+
+void RemoveCachedTile(NavMesh* navMesh, int32 x, int32 y)
+{
+    ScopeLock lock(NavTileCacheLocker);
+    NavTileCache.Remove(NavTileCacheKey{ navMesh->GetID(), x, y });
+}
+
+void ClearCachedTiles(NavMesh* navMesh)
+{
+    ScopeLock lock(NavTileCacheLocker);
+    const Guid id = navMesh->GetID();
+    for (auto i = NavTileCache.Begin(); i.IsNotEnd(); ++i)
+    {
+        if (i->Key.NavMeshId == id)
+            NavTileCache.Remove(i);
+    }
+}
+
 void RemoveTile(NavMesh* navMesh, NavMeshRuntime* runtime, int32 x, int32 y, int32 layer)
 {
     ScopeLock lock(runtime->Locker);
@@ -428,7 +578,7 @@ void RemoveTile(NavMesh* navMesh, NavMeshRuntime* runtime, int32 x, int32 y, int
     runtime->RemoveTile(x, y, layer);
 }
 
-bool GenerateTile(NavMesh* navMesh, NavMeshRuntime* runtime, int32 x, int32 y, BoundingBox& tileBoundsNavMesh, const Matrix& worldToNavMesh, float tileSize, rcConfig& config)
+bool GenerateTile(NavMesh* navMesh, NavMeshRuntime* runtime, int32 x, int32 y, BoundingBox& tileBoundsNavMesh, const Matrix& worldToNavMesh, float tileSize, rcConfig& config, bool useTileCache, bool obstaclesOnly)
 {
     rcContext context;
     int32 layer = 0;
@@ -441,39 +591,51 @@ bool GenerateTile(NavMesh* navMesh, NavMeshRuntime* runtime, int32 x, int32 y, B
     *(Float3*)&config.bmin = tileBoundsNavMesh.Minimum;
     *(Float3*)&config.bmax = tileBoundsNavMesh.Maximum;
 
-    rcHeightfield* heightfield = rcAllocHeightfield();
-    if (!heightfield)
+    Array<OffMeshLink> offMeshLinks;
+    Array<Modifier> modifiers;
+    rcCompactHeightfield* compactHeightfield = useTileCache && obstaclesOnly ? LoadCachedTile(navMesh, x, y, config) : nullptr;
+    if (compactHeightfield)
     {
-        LOG(Warning, "Could not generate navmesh: Out of memory for heightfield.");
-        return true;
+        // Reuse cached geometry and gather only links and modifiers
+        RasterizeGeometry(navMesh, tileBoundsNavMesh, worldToNavMesh, &context, &config, nullptr, &offMeshLinks, &modifiers);
     }
-    if (!rcCreateHeightfield(&context, *heightfield, config.width, config.height, config.bmin, config.bmax, config.cs, config.ch))
+    else
     {
-        LOG(Warning, "Could not generate navmesh: Could not create solid heightfield.");
-        return true;
-    }
+        rcHeightfield* heightfield = rcAllocHeightfield();
+        if (!heightfield)
+        {
+            LOG(Warning, "Could not generate navmesh: Out of memory for heightfield.");
+            return true;
+        }
+        if (!rcCreateHeightfield(&context, *heightfield, config.width, config.height, config.bmin, config.bmax, config.cs, config.ch))
+        {
+            LOG(Warning, "Could not generate navmesh: Could not create solid heightfield.");
+            return true;
+        }
 
-    Array<OffMeshLink> offMeshLinks;
-    Array<Modifier> modifiers;
-    RasterizeGeometry(navMesh, tileBoundsNavMesh, worldToNavMesh, &context, &config, heightfield, &offMeshLinks, &modifiers);
+        RasterizeGeometry(navMesh, tileBoundsNavMesh, worldToNavMesh, &context, &config, heightfield, &offMeshLinks, &modifiers);
 
-    rcFilterLowHangingWalkableObstacles(&context, config.walkableClimb, *heightfield);
-    rcFilterLedgeSpans(&context, config.walkableHeight, config.walkableClimb, *heightfield);
-    rcFilterWalkableLowHeightSpans(&context, config.walkableHeight, *heightfield);
+        rcFilterLowHangingWalkableObstacles(&context, config.walkableClimb, *heightfield);
+        rcFilterLedgeSpans(&context, config.walkableHeight, config.walkableClimb, *heightfield);
+        rcFilterWalkableLowHeightSpans(&context, config.walkableHeight, *heightfield);
 
-    rcCompactHeightfield* compactHeightfield = rcAllocCompactHeightfield();
-    if (!compactHeightfield)
-    {
-        LOG(Warning, "Could not generate navmesh: Out of memory compact heightfield.");
-        return true;
-    }
-    if (!rcBuildCompactHeightfield(&context, config.walkableHeight, config.walkableClimb, *heightfield, *compactHeightfield))
-    {
-        LOG(Warning, "Could not generate navmesh: Could not build compact data.");
-        return true;
-    }
+        compactHeightfield = rcAllocCompactHeightfield();
+        if (!compactHeightfield)
+        {
+            LOG(Warning, "Could not generate navmesh: Out of memory compact heightfield.");
+            return true;
+        }
+        if (!rcBuildCompactHeightfield(&context, config.walkableHeight, config.walkableClimb, *heightfield, *compactHeightfield))
+        {
+            LOG(Warning, "Could not generate navmesh: Could not build compact data.");
+            return true;
+        }
 
-    rcFreeHeightField(heightfield);
+        rcFreeHeightField(heightfield);
+
+        if (useTileCache)
+            SaveCachedTile(navMesh, x, y, *compactHeightfield);
+    }
 
     if (!rcErodeWalkableArea(&context, config.walkableRadius, *compactHeightfield))
     {
@@ -701,6 +863,21 @@ struct BuildRequest
     ScriptingObjectReference<Scene> Scene;
     DateTime Time;
     BoundingBox DirtyBounds;
+    bool ObstaclesOnly;
+};
+
+struct TileBuildRequest
+{
+    Scene* Scene;
+    ScriptingObjectReference<NavMesh> NavMesh;
+    NavMeshRuntime* Runtime;
+    BoundingBox TileBoundsNavMesh;
+    Matrix WorldToNavMesh;
+    int32 X;
+    int32 Y;
+    float TileSize;
+    rcConfig Config;
+    bool ObstaclesOnly;
 };
 
 CriticalSection NavBuildQueueLocker;
@@ -709,6 +886,7 @@ Array<BuildRequest> NavBuildQueue;
 CriticalSection NavBuildTasksLocker;
 int32 NavBuildTasksMaxCount = 0;
 Array<class NavMeshTileBuildTask*> NavBuildTasks;
+Array<TileBuildRequest> NavBuildTilesQueue;
 
 class NavMeshTileBuildTask : public ThreadPoolTask
 {
@@ -722,6 +900,8 @@ class NavMeshTileBuildTask : public ThreadPoolTask
     int32 Y;
     float TileSize;
     rcConfig Config;
+    bool UseTileCache;
+    bool ObstaclesOnly;
 
 public:
     // [ThreadPoolTask]
@@ -734,7 +914,7 @@ class NavMeshTileBuildTask : public ThreadPoolTask
         {
             return false;
         }
-        if (GenerateTile(NavMesh, Runtime, X, Y, TileBoundsNavMesh, WorldToNavMesh, TileSize, Config))
+        if (GenerateTile(NavMesh, Runtime, X, Y, TileBoundsNavMesh, WorldToNavMesh, TileSize, Config, UseTileCache, ObstaclesOnly))
         {
             LOG(Warning, "Failed to generate navmesh tile at {0}x{1}.", X, Y);
         }
@@ -747,7 +927,7 @@ class NavMeshTileBuildTask : public ThreadPoolTask
         // Remove from tasks list
         ScopeLock lock(NavBuildTasksLocker);
         NavBuildTasks.Remove(this);
-        if (NavBuildTasks.IsEmpty())
+        if (NavBuildTasks.IsEmpty() && NavBuildTilesQueue.IsEmpty())
             NavBuildTasksMaxCount = 0;
     }
 };
@@ -766,8 +946,13 @@ void OnSceneUnloading(Scene* scene, const Guid& sceneId)
     }
     NavBuildQueueLocker.Unlock();
 
-    // Cancel active build tasks
+    // Cancel pending tiles and active build tasks
     NavBuildTasksLocker.Lock();
+    for (int32 i = 0; i < NavBuildTilesQueue.Count(); i++)
+    {
+        if (NavBuildTilesQueue[i].Scene == scene)
+            NavBuildTilesQueue.RemoveAt(i--);
+    }
     for (int32 i = 0; i < NavBuildTasks.Count(); i++)
     {
         auto task = NavBuildTasks[i];
@@ -785,6 +970,10 @@ void OnSceneUnloading(Scene* scene, const Guid& sceneId)
         }
     }
     NavBuildTasksLocker.Unlock();
+
+    // Release cached tiles
+    for (NavMesh* navMesh : scene->Navigation.Meshes)
+        ClearCachedTiles(navMesh);
 }
 
 void NavMeshBuilder::Init()
@@ -795,7 +984,7 @@ void NavMeshBuilder::Init()
 bool NavMeshBuilder::IsBuildingNavMesh()
 {
     NavBuildTasksLocker.Lock();
-    const bool hasAnyTask = NavBuildTasks.HasItems();
+    const bool hasAnyTask = NavBuildTasks.HasItems() || NavBuildTilesQueue.HasItems();
     NavBuildTasksLocker.Unlock();
 
     return hasAnyTask;
@@ -807,50 +996,94 @@ float NavMeshBuilder::GetNavMeshBuildingProgress()
     float result = 1.0f;
     if (NavBuildTasksMaxCount != 0)
     {
-        result = (float)(NavBuildTasksMaxCount - NavBuildTasks.Count()) / NavBuildTasksMaxCount;
+        result = (float)(NavBuildTasksMaxCount - NavBuildTasks.Count() - NavBuildTilesQueue.Count()) / NavBuildTasksMaxCount;
     }
     NavBuildTasksLocker.Unlock();
 
     return result;
 }
 
-void BuildTileAsync(NavMesh* navMesh, int32 x, int32 y, rcConfig& config, const BoundingBox& tileBoundsNavMesh, const Matrix& worldToNavMesh, float tileSize)
+void BuildTileAsync(NavMesh* navMesh, int32 x, int32 y, rcConfig& config, const BoundingBox& tileBoundsNavMesh, const Matrix& worldToNavMesh, float tileSize, bool obstaclesOnly)
 {
     NavMeshRuntime* runtime = navMesh->GetRuntime();
-    NavBuildTasksLocker.Lock();
+    ScopeLock lock(NavBuildTasksLocker);
 
-    // Skip if this tile is already during cooking
-    for (int32 i = 0; i < NavBuildTasks.Count(); i++)
+    // Merge with the pending request for the same tile
+    TileBuildRequest* request = nullptr;
+    for (int32 i = 0; i < NavBuildTilesQueue.Count(); i++)
     {
-        const auto task = NavBuildTasks[i];
-        if (task->X == x && task->Y == y && task->Runtime == runtime)
+        auto& e = NavBuildTilesQueue[i];
+        if (e.X == x && e.Y == y && e.Runtime == runtime)
         {
-            NavBuildTasksLocker.Unlock();
-            return;
+            request = &e;
+            obstaclesOnly &= e.ObstaclesOnly;
+            break;
         }
     }
+    if (!request)
+    {
+        request = &NavBuildTilesQueue.AddOne();
+        NavBuildTasksMaxCount++;
+    }
+
+    // Enqueue the tile (started by Update within a per-frame budget)
+    request->Scene = navMesh->GetScene();
+    request->NavMesh = navMesh;
+    request->Runtime = runtime;
+    request->X = x;
+    request->Y = y;
+    request->TileBoundsNavMesh = tileBoundsNavMesh;
+    request->WorldToNavMesh = worldToNavMesh;
+    request->TileSize = tileSize;
+    request->Config = config;
+    request->ObstaclesOnly = obstaclesOnly;
+}
 
-    // Create task
-    auto task = New<NavMeshTileBuildTask>();
-    task->Scene = navMesh->GetScene();
-    task->NavMesh = navMesh;
-    task->Runtime = runtime;
-    task->X = x;
-    task->Y = y;
-    task->TileBoundsNavMesh = tileBoundsNavMesh;
-    task->WorldToNavMesh = worldToNavMesh;
-    task->TileSize = tileSize;
-    task->Config = config;
-    NavBuildTasks.Add(task);
-    NavBuildTasksMaxCount++;
+void StartTileBuilds()
+{
+    const int32 maxTileBuilds = NavigationSettings::Get()->MaxTileBuildsPerFrame;
+    const bool useTileCache = NavigationSettings::Get()->UseTileCache;
+    Array<NavMeshTileBuildTask*, InlinedAllocation<32>> tasks;
+    NavBuildTasksLocker.Lock();
+    for (int32 i = 0; i < NavBuildTilesQueue.Count() && (maxTileBuilds <= 0 || tasks.Count() < maxTileBuilds); i++)
+    {
+        const auto& request = NavBuildTilesQueue[i];
+
+        // Skip tiles during cooking (pending request is started after the current one ends so the latest changes are not lost)
+        bool isBuilding = false;
+        for (int32 j = 0; j < NavBuildTasks.Count() && !isBuilding; j++)
+        {
+            const auto task = NavBuildTasks[j];
+            isBuilding = task->X == request.X && task->Y == request.Y && task->Runtime == request.Runtime;
+        }
+        if (isBuilding)
+            continue;
 
+        // Create task
+        auto task = New<NavMeshTileBuildTask>();
+        task->Scene = request.Scene;
+        task->NavMesh = request.NavMesh;
+        task->Runtime = request.Runtime;
+        task->X = request.X;
+        task->Y = request.Y;
+        task->TileBoundsNavMesh = request.TileBoundsNavMesh;
+        task->WorldToNavMesh = request.WorldToNavMesh;
+        task->TileSize = request.TileSize;
+        task->Config = request.Config;
+        task->UseTileCache = useTileCache;
+        task->ObstaclesOnly = request.ObstaclesOnly;
+        NavBuildTasks.Add(task);
+        tasks.Add(task);
+        NavBuildTilesQueue.RemoveAtKeepOrder(i--);
+    }
     NavBuildTasksLocker.Unlock();
 
-    // Invoke job
-    task->Start();
+    // Invoke jobs
+    for (auto task : tasks)
+        task->Start();
 }
 
-void BuildDirtyBounds(Scene* scene, NavMesh* navMesh, const BoundingBox& dirtyBounds, bool rebuild)
+void BuildDirtyBounds(Scene* scene, NavMesh* navMesh, const BoundingBox& dirtyBounds, bool rebuild, bool obstaclesOnly)
 {
     const float tileSize = GetTileSize();
     NavMeshRuntime* runtime = navMesh->GetRuntime();
@@ -879,6 +1112,7 @@ void BuildDirtyBounds(Scene* scene, NavMesh* navMesh, const BoundingBox& dirtyBo
         {
             // Remove all tiles from navmesh runtime
             runtime->RemoveTiles(navMesh);
+            ClearCachedTiles(navMesh);
             runtime->SetTileSize(tileSize);
             runtime->EnsureCapacity(tilesX * tilesY);
 
@@ -911,10 +1145,11 @@ void BuildDirtyBounds(Scene* scene, NavMesh* navMesh, const BoundingBox& dirtyBo
                 BoundingBox tileBoundsNavMesh;
                 if (GetNavMeshTileBounds(scene, navMesh, x, y, tileSize, tileBoundsNavMesh, worldToNavMesh))
                 {
-                    BuildTileAsync(navMesh, x, y, config, tileBoundsNavMesh, worldToNavMesh, tileSize);
+                    BuildTileAsync(navMesh, x, y, config, tileBoundsNavMesh, worldToNavMesh, tileSize, obstaclesOnly && !rebuild);
                 }
                 else
                 {
+                    RemoveCachedTile(navMesh, x, y);
                     RemoveTile(navMesh, runtime, x, y, 0);
                 }
             }
@@ -922,7 +1157,7 @@ void BuildDirtyBounds(Scene* scene, NavMesh* navMesh, const BoundingBox& dirtyBo
     }
 }
 
-void BuildDirtyBounds(Scene* scene, const BoundingBox& dirtyBounds, bool rebuild)
+void BuildDirtyBounds(Scene* scene, const BoundingBox& dirtyBounds, bool rebuild, bool obstaclesOnly)
 {
     auto settings = NavigationSettings::Get();
 
@@ -981,7 +1216,7 @@ void BuildDirtyBounds(Scene* scene, const BoundingBox& dirtyBounds, bool rebuild
     // Build all navmeshes on the scene
     for (NavMesh* navMesh : scene->Navigation.Meshes)
     {
-        BuildDirtyBounds(scene, navMesh, dirtyBounds, rebuild);
+        BuildDirtyBounds(scene, navMesh, dirtyBounds, rebuild, obstaclesOnly);
     }
 
     // Remove unused navmeshes
@@ -1001,6 +1236,11 @@ void BuildDirtyBounds(Scene* scene, const BoundingBox& dirtyBounds, bool rebuild
                 if (NavBuildTasks[i]->NavMesh == navMesh)
                     usageCount++;
             }
+            for (int32 i = 0; i < NavBuildTilesQueue.Count(); i++)
+            {
+                if (NavBuildTilesQueue[i].NavMesh == navMesh)
+                    usageCount++;
+            }
             NavBuildTasksLocker.Unlock();
             if (usageCount != 0)
                 continue;
@@ -1015,7 +1255,7 @@ void BuildWholeScene(Scene* scene)
     // Compute total navigation area bounds
     const BoundingBox worldBounds = scene->Navigation.GetNavigationBounds();
 
-    BuildDirtyBounds(scene, worldBounds, true);
+    BuildDirtyBounds(scene, worldBounds, true, false);
 }
 
 void ClearNavigation(Scene* scene)
@@ -1023,6 +1263,7 @@ void ClearNavigation(Scene* scene)
     const bool autoRemoveMissingNavMeshes = NavigationSettings::Get()->AutoRemoveMissingNavMeshes;
     for (NavMesh* navMesh : scene->Navigation.Meshes)
     {
+        ClearCachedTiles(navMesh);
         navMesh->ClearData();
         if (autoRemoveMissingNavMeshes)
             navMesh->DeleteObject();
@@ -1059,10 +1300,13 @@ void NavMeshBuilder::Update()
             }
             else
             {
-                BuildDirtyBounds(scene, req.DirtyBounds, false);
+                BuildDirtyBounds(scene, req.DirtyBounds, false, req.ObstaclesOnly);
             }
         }
     }
+
+    // Kick the tiles building tasks
+    StartTileBuilds();
 }
 
 void NavMeshBuilder::Build(Scene* scene, float timeoutMs)
@@ -1088,6 +1332,7 @@ void NavMeshBuilder::Build(Scene* scene, float timeoutMs)
     req.Scene = scene;
     req.Time = DateTime::NowUTC() + TimeSpan::FromMilliseconds(timeoutMs);
     req.DirtyBounds = BoundingBox::Empty;
+    req.ObstaclesOnly = false;
 
     for (int32 i = 0; i < NavBuildQueue.Count(); i++)
     {
@@ -1102,7 +1347,7 @@ void NavMeshBuilder::Build(Scene* scene, float timeoutMs)
     NavBuildQueue.Add(req);
 }
 
-void NavMeshBuilder::Build(Scene* scene, const BoundingBox& dirtyBounds, float timeoutMs)
+void NavMeshBuilder::Build(Scene* scene, const BoundingBox& dirtyBounds, float timeoutMs, bool obstaclesOnly)
 {
     if (!scene)
     {
@@ -1125,6 +1370,7 @@ void NavMeshBuilder::Build(Scene* scene, const BoundingBox& dirtyBounds, float t
     req.Scene = scene;
     req.Time = DateTime::NowUTC() + TimeSpan::FromMilliseconds(timeoutMs);
     req.DirtyBounds = dirtyBounds;
+    req.ObstaclesOnly = obstaclesOnly;
 
     NavBuildQueue.Add(req);
 }
@@ -19,7 +19,7 @@ class FLAXENGINE_API NavMeshBuilder
     static float GetNavMeshBuildingProgress();
     static void Update();
     static void Build(Scene* scene, float timeoutMs);
-    static void Build(Scene* scene, const BoundingBox& dirtyBounds, float timeoutMs);
+    static void Build(Scene* scene, const BoundingBox& dirtyBounds, float timeoutMs, bool obstaclesOnly = false);
 };
 
 #endif
@@ -5,6 +5,7 @@
 #include "NavMesh.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Random.h"
+#include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Threading/Threading.h"
 #include <ThirdParty/recastnavigation/DetourNavMesh.h>
@@ -12,6 +13,7 @@
 #include <ThirdParty/recastnavigation/RecastAlloc.h>
 
 #define MAX_NODES 2048
+#define MAX_PATH_CACHE_SIZE 1024
 #define USE_DATA_LINK 0
 #define USE_NAV_MESH_ALLOC 1
 // TODO: try not using USE_NAV_MESH_ALLOC
@@ -23,8 +25,101 @@ namespace
         Platform::MemoryCopy(filter.m_areaCost, NavMeshRuntime::NavAreasCosts, sizeof(NavMeshRuntime::NavAreasCosts));
         static_assert(sizeof(dtQueryFilter::m_areaCost) == sizeof(NavMeshRuntime::NavAreasCosts), "Invalid navmesh area cost list.");
     }
+
+    bool BuildPathPoints(dtNavMeshQuery* query, const Quaternion& rotation, const Vector3& startPosition, const Float3& startPositionNavMesh, Float3 endPositionNavMesh, dtPolyRef startPoly, const dtPolyRef* path, int32 pathSize, bool partial, Array<Vector3, HeapAllocation>& resultPath, NavMeshPathFlags& resultFlags)
+    {
+        Quaternion invRotation;
+        Quaternion::Invert(rotation, invRotation);
+
+        if (pathSize == 1 && partial)
+        {
+            resultFlags |= NavMeshPathFlags::PartialPath;
+            // TODO: skip adding 2nd end point if it's not reachable (use navmesh raycast check? or physics check? or local Z distance check?)
+            resultPath.Resize(2);
+            resultPath[0] = startPosition;
+            query->closestPointOnPolyBoundary(startPoly, &endPositionNavMesh.X, &endPositionNavMesh.X);
+            resultPath[1] = endPositionNavMesh;
+            Vector3::Transform(resultPath[1], invRotation, resultPath[1]);
+        }
+        else
+        {
+            int pathPointsCount = 0;
+            Float3 pathPoints[NAV_MESH_PATH_MAX_SIZE];
+            const auto findStraightPathStatus = query->findStraightPath(&startPositionNavMesh.X, &endPositionNavMesh.X, path, pathSize, (float*)&pathPoints, nullptr, nullptr, &pathPointsCount, NAV_MESH_PATH_MAX_SIZE, DT_STRAIGHTPATH_AREA_CROSSINGS);
+            if (dtStatusFailed(findStraightPathStatus))
+            {
+                return false;
+            }
+            resultPath.Resize(pathPointsCount);
+            for (int32 i = 0; i < pathPointsCount; i++)
+            {
+                Vector3::Transform(pathPoints[i], invRotation, resultPath[i]);
+            }
+        }
+
+        return true;
+    }
 }
 
+struct PathRequestsData
+{
+    struct Request
+    {
+        uint32 ID;
+        int32 Priority;
+        Vector3 StartPosition;
+        Vector3 EndPosition;
+        NavMeshRuntime::PathRequestCallback Callback;
+    };
+
+    struct Result
+    {
+        bool Success;
+        Array<Vector3, HeapAllocation> Path;
+    };
+
+    uint32 IdCounter = 0;
+    Array<Request> Requests;
+    Dictionary<uint32, Result> Results;
+
+    // Sliced pathfinding state (accessed only by UpdatePathRequests)
+    dtNavMeshQuery* Query = nullptr;
+    dtQueryFilter Filter;
+    uint32 ActiveID = 0;
+    uint32 ActiveVersion = 0;
+    dtPolyRef StartPoly, EndPoly;
+    Float3 StartPositionNavMesh, EndPositionNavMesh;
+
+    // Cache of the found polygons corridors for the repeated start/end polygons
+    uint32 CacheVersion = 0;
+    Dictionary<uint64, Array<dtPolyRef>> Cache;
+
+    ~PathRequestsData()
+    {
+        FreeQuery();
+    }
+
+    void FreeQuery()
+    {
+        if (Query)
+        {
+            dtFreeNavMeshQuery(Query);
+            Query = nullptr;
+        }
+        ActiveID = 0;
+    }
+
+    int32 Find(uint32 id) const
+    {
+        for (int32 i = 0; i < Requests.Count(); i++)
+        {
+            if (Requests.Get()[i].ID == id)
+                return i;
+        }
+        return INVALID_INDEX;
+    }
+};
+
 NavMeshRuntime::NavMeshRuntime(const NavMeshProperties& properties)
     : ScriptingObject(SpawnParams(Guid::New(), NavMeshRuntime::TypeInitializer))
     , Properties(properties)
@@ -38,6 +133,87 @@ NavMeshRuntime::~NavMeshRuntime()
 {
     Dispose();
     dtFreeNavMeshQuery(_navMeshQuery);
+    Delete(_pathRequests);
+}
+
+class NavMeshRuntime::QueryScope
+{
+private:
+    const NavMeshRuntime* _runtime;
+    dtNavMeshQuery* _query;
+
+public:
+    QueryScope(const NavMeshRuntime* runtime)
+        : _runtime(runtime)
+        , _query(runtime->BeginQuery())
+    {
+    }
+
+    ~QueryScope()
+    {
+        if (_query)
+            _runtime->EndQuery(_query);
+    }
+
+    FORCE_INLINE dtNavMeshQuery* Get() const
+    {
+        return _query;
+    }
+};
+
+dtNavMeshQuery* NavMeshRuntime::BeginQuery() const
+{
+    // Register query under the lock so the navmesh modifications (that hold the lock) can wait for all active queries to end
+    ScopeLock lock(Locker);
+    if (!_navMesh)
+        return nullptr;
+    dtNavMeshQuery* query = nullptr;
+    _queriesLocker.Lock();
+    if (_queries.HasItems())
+        query = _queries.Pop();
+    _queriesLocker.Unlock();
+    if (!query)
+    {
+        query = dtAllocNavMeshQuery();
+        if (dtStatusFailed(query->init(_navMesh, MAX_NODES)))
+        {
+            LOG(Error, "Failed to initialize navmesh {0} query.", Properties.Name);
+            dtFreeNavMeshQuery(query);
+            return nullptr;
+        }
+    }
+    Platform::InterlockedIncrement(&_activeQueries);
+    return query;
+}
+
+void NavMeshRuntime::EndQuery(dtNavMeshQuery* query) const
+{
+    _queriesLocker.Lock();
+    _queries.Add(query);
+    _queriesLocker.Unlock();
+    Platform::InterlockedDecrement(&_activeQueries);
+}
+
+void NavMeshRuntime::WaitForQueries()
+{
+    // Locker has to be taken to prevent new queries from starting
+    while (Platform::AtomicRead(&_activeQueries) != 0)
+        Platform::Sleep(0);
+
+    // Navmesh is going to be modified so invalidate any cached paths
+    _version++;
+}
+
+void NavMeshRuntime::ClearQueries()
+{
+    WaitForQueries();
+    _queriesLocker.Lock();
+    for (dtNavMeshQuery* query : _queries)
+        dtFreeNavMeshQuery(query);
+    _queries.Clear();
+    _queriesLocker.Unlock();
+    if (_pathRequests)
+        _pathRequests->FreeQuery();
 }
 
 int32 NavMeshRuntime::GetTilesCapacity() const
@@ -47,9 +223,9 @@ int32 NavMeshRuntime::GetTilesCapacity() const
 
 bool NavMeshRuntime::FindDistanceToWall(const Vector3& startPosition, NavMeshHit& hitInfo, float maxDistance) const
 {
-    ScopeLock lock(Locker);
-    const auto query = GetNavMeshQuery();
-    if (!query || !_navMesh)
+    const QueryScope scope(this);
+    const auto query = scope.Get();
+    if (!query)
         return false;
 
     dtQueryFilter filter;
@@ -84,9 +260,9 @@ bool NavMeshRuntime::FindPath(const Vector3& startPosition, const Vector3& endPo
 {
     resultPath.Clear();
     resultFlags = NavMeshPathFlags::None;
-    ScopeLock lock(Locker);
-    const auto query = GetNavMeshQuery();
-    if (!query || !_navMesh)
+    const QueryScope scope(this);
+    const auto query = scope.Get();
+    if (!query)
         return false;
 
     dtQueryFilter filter;
@@ -118,43 +294,14 @@ bool NavMeshRuntime::FindPath(const Vector3& startPosition, const Vector3& endPo
         return false;
     }
 
-    Quaternion invRotation;
-    Quaternion::Invert(Properties.Rotation, invRotation);
-
-    if (pathSize == 1 && dtStatusDetail(findPathStatus, DT_PARTIAL_RESULT))
-    {
-        resultFlags |= NavMeshPathFlags::PartialPath;
-        // TODO: skip adding 2nd end point if it's not reachable (use navmesh raycast check? or physics check? or local Z distance check?)
-        resultPath.Resize(2);
-        resultPath[0] = startPosition;
-        query->closestPointOnPolyBoundary(startPoly, &endPositionNavMesh.X, &endPositionNavMesh.X);
-        resultPath[1] = endPositionNavMesh;
-        Vector3::Transform(resultPath[1], invRotation, resultPath[1]);
-    }
-    else
-    {
-        int pathPointsCount = 0;
-        Float3 pathPoints[NAV_MESH_PATH_MAX_SIZE];
-        const auto findStraightPathStatus = query->findStraightPath(&startPositionNavMesh.X, &endPositionNavMesh.X, path, pathSize, (float*)&pathPoints, nullptr, nullptr, &pathPointsCount, NAV_MESH_PATH_MAX_SIZE, DT_STRAIGHTPATH_AREA_CROSSINGS);
-        if (dtStatusFailed(findStraightPathStatus))
-        {
-            return false;
-        }
-        resultPath.Resize(pathPointsCount);
-        for (int32 i = 0; i < pathPointsCount; i++)
-        {
-            Vector3::Transform(pathPoints[i], invRotation, resultPath[i]);
-        }
-    }
-
-    return true;
+    return BuildPathPoints(query, Properties.Rotation, startPosition, startPositionNavMesh, endPositionNavMesh, startPoly, path, pathSize, dtStatusDetail(findPathStatus, DT_PARTIAL_RESULT), resultPath, resultFlags);
 }
 
 bool NavMeshRuntime::TestPath(const Vector3& startPosition, const Vector3& endPosition) const
 {
-    ScopeLock lock(Locker);
-    const auto query = GetNavMeshQuery();
-    if (!query || !_navMesh)
+    const QueryScope scope(this);
+    const auto query = scope.Get();
+    if (!query)
         return false;
 
     dtQueryFilter filter;
@@ -194,11 +341,203 @@ bool NavMeshRuntime::TestPath(const Vector3& startPosition, const Vector3& endPo
     return true;
 }
 
+uint32 NavMeshRuntime::FindPathAsync(const Vector3& startPosition, const Vector3& endPosition, int32 priority)
+{
+    return FindPathAsync(startPosition, endPosition, PathRequestCallback(), priority);
+}
+
+uint32 NavMeshRuntime::FindPathAsync(const Vector3& startPosition, const Vector3& endPosition, const PathRequestCallback& callback, int32 priority)
+{
+    ScopeLock lock(_pathRequestsLocker);
+    if (!_pathRequests)
+        _pathRequests = New<PathRequestsData>();
+    if (++_pathRequests->IdCounter == 0)
+        _pathRequests->IdCounter++;
+    auto& request = _pathRequests->Requests.AddOne();
+    request.ID = _pathRequests->IdCounter;
+    request.Priority = priority;
+    request.StartPosition = startPosition;
+    request.EndPosition = endPosition;
+    request.Callback = callback;
+    return request.ID;
+}
+
+NavMeshPathRequestState NavMeshRuntime::GetPathRequestResult(uint32 requestId, Array<Vector3, HeapAllocation>& resultPath)
+{
+    resultPath.Clear();
+    ScopeLock lock(_pathRequestsLocker);
+    if (!_pathRequests)
+        return NavMeshPathRequestState::Invalid;
+    PathRequestsData::Result* result = _pathRequests->Results.TryGet(requestId);
+    if (!result)
+        return _pathRequests->Find(requestId) != INVALID_INDEX ? NavMeshPathRequestState::Pending : NavMeshPathRequestState::Invalid;
+    const bool success = result->Success;
+    resultPath = MoveTemp(result->Path);
+    _pathRequests->Results.Remove(requestId);
+    return success ? NavMeshPathRequestState::Succeed : NavMeshPathRequestState::Failed;
+}
+
+void NavMeshRuntime::CancelPathRequest(uint32 requestId)
+{
+    ScopeLock lock(_pathRequestsLocker);
+    if (!_pathRequests)
+        return;
+    const int32 index = _pathRequests->Find(requestId);
+    if (index != INVALID_INDEX)
+        _pathRequests->Requests.RemoveAtKeepOrder(index);
+    _pathRequests->Results.Remove(requestId);
+}
+
+void NavMeshRuntime::UpdatePathRequests()
+{
+    PathRequestsData* data = _pathRequests;
+    if (!data)
+        return;
+    _pathRequestsLocker.Lock();
+    const bool anyRequest = data->Requests.HasItems();
+    _pathRequestsLocker.Unlock();
+    if (!anyRequest)
+        return;
+    PROFILE_CPU();
+
+    // Register as an active query (sliced pathfinding state persists between frames so restart it if navmesh was modified in-between)
+    {
+        ScopeLock lock(Locker);
+        if (!_navMesh)
+            return;
+        if (!data->Query)
+        {
+            data->Query = dtAllocNavMeshQuery();
+            if (dtStatusFailed(data->Query->init(_navMesh, MAX_NODES)))
+            {
+                LOG(Error, "Failed to initialize navmesh {0} query.", Properties.Name);
+                data->FreeQuery();
+                return;
+            }
+        }
+        Platform::InterlockedIncrement(&_activeQueries);
+    }
+    dtNavMeshQuery* query = data->Query;
+    if (data->CacheVersion != _version)
+    {
+        data->CacheVersion = _version;
+        data->Cache.Clear();
+    }
+
+    Array<PathRequestsData::Request, InlinedAllocation<16>> completed;
+    Array<PathRequestsData::Result, InlinedAllocation<16>> completedResults;
+    int32 iterationsLeft = Math::Max(PathRequestsMaxIterations, 1);
+    while (iterationsLeft > 0)
+    {
+        // Pick the request to process (continue the active one or the first one with the highest priority)
+        PathRequestsData::Request request;
+        _pathRequestsLocker.Lock();
+        int32 requestIndex = data->ActiveID ? data->Find(data->ActiveID) : INVALID_INDEX;
+        if (requestIndex == INVALID_INDEX)
+        {
+            for (int32 i = 0; i < data->Requests.Count(); i++)
+            {
+                if (requestIndex == INVALID_INDEX || data->Requests[i].Priority > data->Requests[requestIndex].Priority)
+                    requestIndex = i;
+            }
+        }
+        if (requestIndex != INVALID_INDEX)
+            request = data->Requests[requestIndex];
+        _pathRequestsLocker.Unlock();
+        if (requestIndex == INVALID_INDEX)
+            break;
+
+        bool done = false;
+        PathRequestsData::Result result;
+        result.Success = false;
+        NavMeshPathFlags flags = NavMeshPathFlags::None;
+        if (data->ActiveID != request.ID || data->ActiveVersion != _version)
+        {
+            // Start the request
+            iterationsLeft--;
+            data->ActiveID = request.ID;
+            data->ActiveVersion = _version;
+            InitFilter(data->Filter);
+            Float3 extent = Properties.DefaultQueryExtent;
+            Float3::Transform(request.StartPosition, Properties.Rotation, data->StartPositionNavMesh);
+            Float3::Transform(request.EndPosition, Properties.Rotation, data->EndPositionNavMesh);
+            data->StartPoly = data->EndPoly = 0;
+            query->findNearestPoly(&data->StartPositionNavMesh.X, &extent.X, &data->Filter, &data->StartPoly, nullptr);
+            query->findNearestPoly(&data->EndPositionNavMesh.X, &extent.X, &data->Filter, &data->EndPoly, nullptr);
+            if (!data->StartPoly || !data->EndPoly)
+            {
+                done = true;
+            }
+            else if (const Array<dtPolyRef>* corridor = data->Cache.TryGet(((uint64)data->StartPoly << 32) | (uint64)data->EndPoly))
+            {
+                // Reuse cached path corridor
+                result.Success = BuildPathPoints(query, Properties.Rotation, request.StartPosition, data->StartPositionNavMesh, data->EndPositionNavMesh, data->StartPoly, corridor->Get(), corridor->Count(), false, result.Path, flags);
+                done = true;
+            }
+            else if (dtStatusFailed(query->initSlicedFindPath(data->StartPoly, data->EndPoly, &data->StartPositionNavMesh.X, &data->EndPositionNavMesh.X, &data->Filter)))
+            {
+                done = true;
+            }
+        }
+        if (!done)
+        {
+            // Continue the request
+            int doneIterations = 0;
+            dtStatus status = query->updateSlicedFindPath(iterationsLeft, &doneIterations);
+            iterationsLeft -= Math::Max(doneIterations, 1);
+            if (dtStatusInProgress(status))
+                continue;
+            if (dtStatusSucceed(status))
+            {
+                dtPolyRef path[NAV_MESH_PATH_MAX_SIZE];
+                int32 pathSize = 0;
+                status = query->finalizeSlicedFindPath(path, &pathSize, NAV_MESH_PATH_MAX_SIZE);
+                if (dtStatusSucceed(status) && pathSize > 0)
+                {
+                    const bool partial = dtStatusDetail(status, DT_PARTIAL_RESULT);
+                    if (!partial)
+                    {
+                        if (data->Cache.Count() >= MAX_PATH_CACHE_SIZE)
+                            data->Cache.Clear();
+                        data->Cache[((uint64)data->StartPoly << 32) | (uint64)data->EndPoly].Set(path, pathSize);
+                    }
+                    result.Success = BuildPathPoints(query, Properties.Rotation, request.StartPosition, data->StartPositionNavMesh, data->EndPositionNavMesh, data->StartPoly, path, pathSize, partial, result.Path, flags);
+                }
+            }
+        }
+
+        // Complete the request
+        data->ActiveID = 0;
+        _pathRequestsLocker.Lock();
+        requestIndex = data->Find(request.ID);
+        if (requestIndex != INVALID_INDEX)
+        {
+            data->Requests.RemoveAtKeepOrder(requestIndex);
+            if (request.Callback.IsBinded())
+            {
+                completed.Add(request);
+                completedResults.Add(MoveTemp(result));
+            }
+            else
+            {
+                data->Results[request.ID] = MoveTemp(result);
+            }
+        }
+        _pathRequestsLocker.Unlock();
+    }
+
+    Platform::InterlockedDecrement(&_activeQueries);
+
+    // Invoke callbacks after ending the query (callback might modify navmesh)
+    for (int32 i = 0; i < completed.Count(); i++)
+        completed[i].Callback(completed[i].ID, completedResults[i].Success, completedResults[i].Path);
+}
+
 bool NavMeshRuntime::FindClosestPoint(const Vector3& point, Vector3& result) const
 {
-    ScopeLock lock(Locker);
-    const auto query = GetNavMeshQuery();
-    if (!query || !_navMesh)
+    const QueryScope scope(this);
+    const auto query = scope.Get();
+    if (!query)
         return false;
 
     dtQueryFilter filter;
@@ -225,9 +564,9 @@ bool NavMeshRuntime::FindClosestPoint(const Vector3& point, Vector3& result) con
 
 bool NavMeshRuntime::FindRandomPoint(Vector3& result) const
 {
-    ScopeLock lock(Locker);
-    const auto query = GetNavMeshQuery();
-    if (!query || !_navMesh)
+    const QueryScope scope(this);
+    const auto query = scope.Get();
+    if (!query)
         return false;
 
     dtQueryFilter filter;
@@ -250,9 +589,9 @@ bool NavMeshRuntime::FindRandomPoint(Vector3& result) const
 
 bool NavMeshRuntime::FindRandomPointAroundCircle(const Vector3& center, float radius, Vector3& result) const
 {
-    ScopeLock lock(Locker);
-    const auto query = GetNavMeshQuery();
-    if (!query || !_navMesh)
+    const QueryScope scope(this);
+    const auto query = scope.Get();
+    if (!query)
         return false;
 
     dtQueryFilter filter;
@@ -286,9 +625,9 @@ bool NavMeshRuntime::FindRandomPointAroundCircle(const Vector3& center, float ra
 
 bool NavMeshRuntime::RayCast(const Vector3& startPosition, const Vector3& endPosition, NavMeshHit& hitInfo) const
 {
-    ScopeLock lock(Locker);
-    const auto query = GetNavMeshQuery();
-    if (!query || !_navMesh)
+    const QueryScope scope(this);
+    const auto query = scope.Get();
+    if (!query)
         return false;
 
     dtQueryFilter filter;
@@ -357,6 +696,7 @@ void NavMeshRuntime::EnsureCapacity(int32 tilesToAddCount)
         newCapacity = Math::RoundUpToPowerOf2(newCapacity + 1);
 
     LOG(Info, "Resizing navmesh {2} from {0} to {1} tiles capacity", capacity, newCapacity, Properties.Name);
+    ClearQueries();
 
     // Ensure to have size assigned
     ASSERT(_tileSize != 0);
@@ -494,6 +834,7 @@ void NavMeshRuntime::RemoveTile(int32 x, int32 y, int32 layer)
         return;
     }
 
+    WaitForQueries();
     if (dtStatusFailed(_navMesh->removeTile(tileRef, nullptr, nullptr)))
     {
         LOG(Warning, "Failed to remove tile from navmesh {0}.", Properties.Name);
@@ -517,6 +858,7 @@ void NavMeshRuntime::RemoveTiles(bool (*prediction)(const NavMeshRuntime* navMes
     if (!_navMesh)
         return;
     PROFILE_CPU_NAMED("NavMeshRuntime.RemoveTiles");
+    WaitForQueries();
 
     for (int32 i = 0; i < _tiles.Count(); i++)
     {
@@ -650,6 +992,8 @@ void NavMeshRuntime::DebugDraw()
 
 void NavMeshRuntime::Dispose()
 {
+    ScopeLock lock(Locker);
+    ClearQueries();
     if (_navMesh)
     {
         dtFreeNavMesh(_navMesh);
@@ -660,6 +1004,8 @@ void NavMeshRuntime::Dispose()
 
 void NavMeshRuntime::AddTileInternal(NavMesh* navMesh, NavMeshTileData& tileData)
 {
+    WaitForQueries();
+
     // Check if that tile has been added to navmesh
     NavMeshTile* tile = nullptr;
     const auto tileRef = _navMesh->getTileRefAt(tileData.PosX, tileData.PosY, tileData.Layer);
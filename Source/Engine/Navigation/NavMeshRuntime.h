@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Core/Delegate.h"
 #include "Engine/Platform/CriticalSection.h"
 #include "Engine/Scripting/ScriptingObject.h"
 #include "NavMeshData.h"
@@ -38,6 +39,21 @@ enum class NavMeshPathFlags
 
 DECLARE_ENUM_OPERATORS(NavMeshPathFlags);
 
+/// <summary>
+/// The asynchronous navigation mesh path request state.
+/// </summary>
+API_ENUM() enum class NavMeshPathRequestState
+{
+    // Invalid request (unknown, cancelled or already collected).
+    Invalid = 0,
+    // Path is not yet generated.
+    Pending = 1,
+    // Path has been found (may be partial).
+    Succeed = 2,
+    // Path finding failed.
+    Failed = 3,
+};
+
 /// <summary>
 /// The navigation mesh runtime object that builds the navmesh from all loaded scenes.
 /// </summary>
@@ -63,19 +79,40 @@ API_CLASS(NoSpawn) class FLAXENGINE_API NavMeshRuntime : public ScriptingObject
     static Color NavAreasColors[64];
 #endif
 
+    /// <summary>
+    /// The maximum amount of the pathfinding iterations (visited navmesh nodes) processed per-frame for the asynchronous path requests of a single navmesh. Limits the time spent on pathfinding per frame.
+    /// </summary>
+    API_FIELD() static int32 PathRequestsMaxIterations;
+
+    /// <summary>
+    /// The asynchronous path request completion callback. Called on a main thread with the request id, the success flag and the result path.
+    /// </summary>
+    typedef Function<void(uint32, bool, const Array<Vector3, HeapAllocation>&)> PathRequestCallback;
+
 private:
     dtNavMesh* _navMesh;
     dtNavMeshQuery* _navMeshQuery;
     float _tileSize;
     Array<NavMeshTile> _tiles;
 
+    // Pool of the navmesh queries used to run multiple queries at once from different threads (each query has own nodes pool)
+    mutable CriticalSection _queriesLocker;
+    mutable Array<dtNavMeshQuery*> _queries;
+    mutable volatile int64 _activeQueries = 0;
+    uint32 _version = 0;
+    class QueryScope;
+
+    // Asynchronous path requests (allocated on the first use)
+    CriticalSection _pathRequestsLocker;
+    struct PathRequestsData* _pathRequests = nullptr;
+
 public:
     NavMeshRuntime(const NavMeshProperties& properties);
     ~NavMeshRuntime();
 
 public:
     /// <summary>
-    /// The object locker.
+    /// The object locker. Navmesh queries (eg. FindPath) can run concurrently from multiple threads and the navmesh modifications (eg. adding tiles) wait for the active queries to end.
     /// </summary>
     CriticalSection Locker;
 
@@ -145,6 +182,44 @@ API_CLASS(NoSpawn) class FLAXENGINE_API NavMeshRuntime : public ScriptingObject
     /// <returns>True if found valid path between given two points, otherwise false if failed.</returns>
     API_FUNCTION() bool TestPath(const Vector3& startPosition, const Vector3& endPosition) const;
 
+    /// <summary>
+    /// Requests the path between the two positions to be found asynchronously over the next frames (within PathRequestsMaxIterations budget). Use GetPathRequestResult to collect the result path.
+    /// </summary>
+    /// <param name="startPosition">The start position.</param>
+    /// <param name="endPosition">The end position.</param>
+    /// <param name="priority">The request priority. Requests with higher priority are processed first.</param>
+    /// <returns>The path request identifier.</returns>
+    API_FUNCTION() uint32 FindPathAsync(const Vector3& startPosition, const Vector3& endPosition, int32 priority = 0);
+
+    /// <summary>
+    /// Requests the path between the two positions to be found asynchronously over the next frames (within PathRequestsMaxIterations budget).
+    /// </summary>
+    /// <param name="startPosition">The start position.</param>
+    /// <param name="endPosition">The end position.</param>
+    /// <param name="callback">The callback invoked on a main thread when request gets completed (result is not stored for GetPathRequestResult).</param>
+    /// <param name="priority">The request priority. Requests with higher priority are processed first.</param>
+    /// <returns>The path request identifier.</returns>
+    uint32 FindPathAsync(const Vector3& startPosition, const Vector3& endPosition, const PathRequestCallback& callback, int32 priority = 0);
+
+    /// <summary>
+    /// Gets the result of the asynchronous path request. Completed request result is released after this call.
+    /// </summary>
+    /// <param name="requestId">The path request identifier.</param>
+    /// <param name="resultPath">The result path (valid only if request succeed).</param>
+    /// <returns>The path request state.</returns>
+    API_FUNCTION() NavMeshPathRequestState GetPathRequestResult(uint32 requestId, API_PARAM(Out) Array<Vector3, HeapAllocation>& resultPath);
+
+    /// <summary>
+    /// Cancels the asynchronous path request (or releases its result).
+    /// </summary>
+    /// <param name="requestId">The path request identifier.</param>
+    API_FUNCTION() void CancelPathRequest(uint32 requestId);
+
+    /// <summary>
+    /// Processes the pending asynchronous path requests. Called by the navigation service every frame.
+    /// </summary>
+    void UpdatePathRequests();
+
     /// <summary>
     /// Finds the nearest point on a nav mesh surface.
     /// </summary>
@@ -248,4 +323,8 @@ API_CLASS(NoSpawn) class FLAXENGINE_API NavMeshRuntime : public ScriptingObject
 
 private:
     void AddTileInternal(NavMesh* navMesh, NavMeshTileData& tileData);
+    dtNavMeshQuery* BeginQuery() const;
+    void EndQuery(dtNavMeshQuery* query) const;
+    void WaitForQueries();
+    void ClearQueries();
 };
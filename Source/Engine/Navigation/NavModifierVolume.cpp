@@ -69,7 +69,7 @@ void NavModifierVolume::OnBoundsChanged(const BoundingBox& prevBounds)
 #else
         const float timeoutMs = 0.0f;
 #endif
-        NavMeshBuilder::Build(GetScene(), dirtyBounds, timeoutMs);
+        NavMeshBuilder::Build(GetScene(), dirtyBounds, timeoutMs, true);
     }
 #endif
 }
@@ -18,6 +18,7 @@
 
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Serialization/Serialization.h"
 #include <ThirdParty/recastnavigation/DetourNavMesh.h>
 #include <ThirdParty/recastnavigation/RecastAlloc.h>
@@ -104,6 +105,7 @@ float NavMeshRuntime::NavAreasCosts[64];
 #if COMPILE_WITH_DEBUG_DRAW
 Color NavMeshRuntime::NavAreasColors[64];
 #endif
+int32 NavMeshRuntime::PathRequestsMaxIterations = 2000;
 
 bool NavAgentProperties::operator==(const NavAgentProperties& other) const
 {
@@ -168,9 +170,7 @@ class NavigationService : public EngineService
     }
 
     bool Init() override;
-#if COMPILE_WITH_NAV_MESH_BUILDER
     void Update() override;
-#endif
     void Dispose() override;
 };
 
@@ -239,6 +239,8 @@ void NavigationSettings::Deserialize(DeserializeStream& stream, ISerializeModifi
 {
     DESERIALIZE(AutoAddMissingNavMeshes);
     DESERIALIZE(AutoRemoveMissingNavMeshes);
+    DESERIALIZE(UseTileCache);
+    DESERIALIZE(MaxTileBuildsPerFrame);
     DESERIALIZE(CellHeight);
     DESERIALIZE(CellSize);
     DESERIALIZE(TileSize);
@@ -283,15 +285,18 @@ bool NavigationService::Init()
     return false;
 }
 
-#if COMPILE_WITH_NAV_MESH_BUILDER
-
 void NavigationService::Update()
 {
+    PROFILE_MEM(Navigation);
+#if COMPILE_WITH_NAV_MESH_BUILDER
     NavMeshBuilder::Update();
-}
-
 #endif
 
+    // Process asynchronous path requests
+    for (auto navMesh : NavMeshes)
+        navMesh->UpdatePathRequests();
+}
+
 void NavigationService::Dispose()
 {
     // Release nav meshes
@@ -26,6 +26,18 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class
     API_FIELD(Attributes="EditorOrder(110), EditorDisplay(\"Navigation\")")
     bool AutoRemoveMissingNavMeshes = true;
 
+    /// <summary>
+    /// If checked, the navmesh builder keeps the compressed rasterized geometry of each tile so rebuilds caused only by dynamic Nav Modifier Volumes (obstacles) don't need to rasterize the scene geometry again. Uses more memory.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(120), EditorDisplay(\"Navigation\")")
+    bool UseTileCache = false;
+
+    /// <summary>
+    /// The maximum amount of navmesh tiles to start building every frame. Pending build requests for the same tile are merged into a single rebuild. Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD(Attributes="Limit(0), EditorOrder(130), EditorDisplay(\"Navigation\")")
+    int32 MaxTileBuildsPerFrame = 16;
+
 public:
     /// <summary>
     /// The height of a grid cell in the navigation mesh building steps using heightfields. A lower number means higher precision on the vertical axis but longer build times.
@@ -77,6 +77,15 @@ void ENetDriver::Dispose()
         enet_peer_disconnect_now(_peer, 0);
     enet_host_destroy(_host);
 
+    // Release any received packets that were not recycled
+    for (ENetPacket* packet : _packets)
+    {
+        if (packet)
+            enet_packet_destroy(packet);
+    }
+    _packets.Clear();
+    _freePackets.Clear();
+
     enet_deinitialize();
 
     _peerMap.Clear();
@@ -193,11 +202,22 @@ bool ENetDriver::PopEvent(NetworkEvent& eventPtr)
                 _peerMap.Remove(connectionId);
             break;
         case ENET_EVENT_TYPE_RECEIVE:
+        {
+            // Reference the packet data directly within the message (packet is destroyed when message gets recycled)
+            uint32 packetIndex;
+            if (_freePackets.HasItems())
+                packetIndex = _freePackets.Pop();
+            else
+            {
+                packetIndex = _packets.Count();
+                _packets.Add(nullptr);
+            }
+            _packets[packetIndex] = event.packet;
+            const uint32 length = (uint32)event.packet->dataLength;
             eventPtr.EventType = NetworkEventType::Message;
-            eventPtr.Message = _networkHost->CreateMessage();
-            eventPtr.Message.Length = event.packet->dataLength;
-            Platform::MemoryCopy(eventPtr.Message.Buffer, event.packet->data, event.packet->dataLength);
+            eventPtr.Message = NetworkMessage(event.packet->data, NetworkMessage::DriverMessageIdFlag | packetIndex, length, length, 0);
             break;
+        }
         default:
             break;
         }
@@ -210,6 +230,15 @@ bool ENetDriver::PopEvent(NetworkEvent& eventPtr)
     return false;
 }
 
+void ENetDriver::RecycleMessage(const NetworkMessage& message)
+{
+    const uint32 packetIndex = message.MessageId & ~NetworkMessage::DriverMessageIdFlag;
+    ASSERT(packetIndex < (uint32)_packets.Count() && _packets[packetIndex]);
+    enet_packet_destroy(_packets[packetIndex]);
+    _packets[packetIndex] = nullptr;
+    _freePackets.Push(packetIndex);
+}
+
 void ENetDriver::SendMessage(const NetworkChannelType channelType, const NetworkMessage& message)
 {
     ASSERT(!IsServer());
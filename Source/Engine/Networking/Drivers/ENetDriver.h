@@ -6,6 +6,7 @@
 #include "Engine/Networking/INetworkDriver.h"
 #include "Engine/Networking/NetworkConnection.h"
 #include "Engine/Networking/NetworkConfig.h"
+#include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Scripting/ScriptingObject.h"
 #include "Engine/Scripting/ScriptingType.h"
@@ -30,6 +31,7 @@ API_CLASS(Namespace="FlaxEngine.Networking", Sealed) class FLAXENGINE_API ENetDr
     void Disconnect() override;
     void Disconnect(const NetworkConnection& connection) override;
     bool PopEvent(NetworkEvent& eventPtr) override;
+    void RecycleMessage(const NetworkMessage& message) override;
     void SendMessage(NetworkChannelType channelType, const NetworkMessage& message) override;
     void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, NetworkConnection target) override;
     void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection, HeapAllocation>& targets) override;
@@ -48,4 +50,6 @@ API_CLASS(Namespace="FlaxEngine.Networking", Sealed) class FLAXENGINE_API ENetDr
     struct _ENetHost* _host = nullptr;
     struct _ENetPeer* _peer = nullptr;
     Dictionary<uint32, struct _ENetPeer*> _peerMap;
+    Array<struct _ENetPacket*> _packets;
+    Array<uint32> _freePackets;
 };
@@ -122,6 +122,12 @@ bool NetworkLagDriver::PopEvent(NetworkEvent& eventPtr)
     return false;
 }
 
+void NetworkLagDriver::RecycleMessage(const NetworkMessage& message)
+{
+    if (_driver)
+        _driver->RecycleMessage(message);
+}
+
 void NetworkLagDriver::SendMessage(const NetworkChannelType channelType, const NetworkMessage& message)
 {
     if (Lag <= 0.0)
@@ -69,6 +69,7 @@ API_CLASS(Namespace="FlaxEngine.Networking", Sealed) class FLAXENGINE_API Networ
     void Disconnect() override;
     void Disconnect(const NetworkConnection& connection) override;
     bool PopEvent(NetworkEvent& eventPtr) override;
+    void RecycleMessage(const NetworkMessage& message) override;
     void SendMessage(NetworkChannelType channelType, const NetworkMessage& message) override;
     void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, NetworkConnection target) override;
     void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection, HeapAllocation>& targets) override;
@@ -0,0 +1,273 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "NetworkRecordDriver.h"
+#include "ENetDriver.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Networking/NetworkStats.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Serialization/FileReadStream.h"
+#include "Engine/Serialization/FileWriteStream.h"
+
+// Recording file format: header (magic, version), then the sequence of records (time, kind, type, channel, connection id, data size, data)
+#define NETWORK_RECORD_MAGIC 0x4345524E
+#define NETWORK_RECORD_VERSION 1
+#define NETWORK_RECORD_KIND_SEND 0
+#define NETWORK_RECORD_KIND_EVENT 1
+
+NetworkRecordDriver::NetworkRecordDriver(const SpawnParams& params)
+    : ScriptingObject(params)
+{
+}
+
+NetworkRecordDriver::~NetworkRecordDriver()
+{
+    SetDriver(nullptr);
+}
+
+void NetworkRecordDriver::SetDriver(INetworkDriver* value)
+{
+    if (_driver == value)
+        return;
+
+    // Cleanup created proxy driver object
+    if (auto* driver = FromInterface(_driver, INetworkDriver::TypeInitializer))
+        Delete(driver);
+
+    _driver = value;
+}
+
+String NetworkRecordDriver::DriverName()
+{
+    if (!_driver)
+        return String::Empty;
+    return _driver->DriverName();
+}
+
+bool NetworkRecordDriver::Initialize(NetworkPeer* host, const NetworkConfig& config)
+{
+    if (!_driver)
+    {
+        // Use ENet as default
+        _driver = New<ENetDriver>();
+    }
+    if (!_driver)
+    {
+        LOG(Error, "Missing Driver for Network Record.");
+        return true;
+    }
+    if (Mode == NetworkRecordMode::Replay)
+    {
+        if (LoadReplay())
+            return true;
+    }
+    else if (Path.HasChars())
+    {
+        _file = FileWriteStream::Open(Path);
+        if (!_file)
+        {
+            LOG(Error, "Failed to open network recording file '{0}'.", Path);
+            return true;
+        }
+        _file->WriteUint32(NETWORK_RECORD_MAGIC);
+        _file->WriteInt32(NETWORK_RECORD_VERSION);
+    }
+    _startTime = Platform::GetTimeSeconds();
+    return _driver->Initialize(host, config);
+}
+
+void NetworkRecordDriver::Dispose()
+{
+    if (!_driver)
+        return;
+    _driver->Dispose();
+    if (_file)
+    {
+        Delete(_file);
+        _file = nullptr;
+    }
+    _replay.Clear();
+    _replayIndex = -1;
+}
+
+bool NetworkRecordDriver::Listen()
+{
+    if (!_driver)
+        return false;
+    return _driver->Listen();
+}
+
+bool NetworkRecordDriver::Connect()
+{
+    if (!_driver)
+        return false;
+    return _driver->Connect();
+}
+
+void NetworkRecordDriver::Disconnect()
+{
+    if (!_driver)
+        return;
+    _driver->Disconnect();
+}
+
+void NetworkRecordDriver::Disconnect(const NetworkConnection& connection)
+{
+    if (!_driver)
+        return;
+    _driver->Disconnect(connection);
+}
+
+bool NetworkRecordDriver::PopEvent(NetworkEvent& eventPtr)
+{
+    if (!_driver)
+        return false;
+    UpdateReplay();
+    if (!_driver->PopEvent(eventPtr))
+        return false;
+    if (_file)
+    {
+        const bool isMessage = eventPtr.EventType == NetworkEventType::Message;
+        Write(NETWORK_RECORD_KIND_EVENT, (byte)eventPtr.EventType, NetworkChannelType::None, eventPtr.Sender.ConnectionId, isMessage ? eventPtr.Message.Buffer : nullptr, isMessage ? eventPtr.Message.Length : 0);
+    }
+    else if (Mode == NetworkRecordMode::Replay && eventPtr.EventType == NetworkEventType::Connected && _replayIndex == -1)
+    {
+        // Start replaying once connected to the server
+        _startTime = Platform::GetTimeSeconds();
+        _replayIndex = 0;
+    }
+    return true;
+}
+
+void NetworkRecordDriver::RecycleMessage(const NetworkMessage& message)
+{
+    if (!_driver)
+        return;
+    _driver->RecycleMessage(message);
+}
+
+void NetworkRecordDriver::SendMessage(const NetworkChannelType channelType, const NetworkMessage& message)
+{
+    if (!_driver)
+        return;
+    if (_file)
+        Write(NETWORK_RECORD_KIND_SEND, 0, channelType, 0, message.Buffer, message.Length);
+    _driver->SendMessage(channelType, message);
+}
+
+void NetworkRecordDriver::SendMessage(NetworkChannelType channelType, const NetworkMessage& message, NetworkConnection target)
+{
+    if (!_driver)
+        return;
+    if (_file)
+        Write(NETWORK_RECORD_KIND_SEND, 1, channelType, target.ConnectionId, message.Buffer, message.Length);
+    _driver->SendMessage(channelType, message, target);
+}
+
+void NetworkRecordDriver::SendMessage(const NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection, HeapAllocation>& targets)
+{
+    if (!_driver)
+        return;
+    if (_file)
+    {
+        for (const NetworkConnection& target : targets)
+            Write(NETWORK_RECORD_KIND_SEND, 2, channelType, target.ConnectionId, message.Buffer, message.Length);
+    }
+    _driver->SendMessage(channelType, message, targets);
+}
+
+NetworkDriverStats NetworkRecordDriver::GetStats()
+{
+    if (!_driver)
+        return NetworkDriverStats();
+    return _driver->GetStats();
+}
+
+NetworkDriverStats NetworkRecordDriver::GetStats(NetworkConnection target)
+{
+    if (!_driver)
+        return NetworkDriverStats();
+    return _driver->GetStats(target);
+}
+
+bool NetworkRecordDriver::LoadReplay()
+{
+    _replay.Clear();
+    _replayIndex = -1;
+    FileReadStream* file = FileReadStream::Open(Path);
+    if (!file)
+    {
+        LOG(Error, "Failed to open network recording file '{0}'.", Path);
+        return true;
+    }
+    uint32 magic = 0;
+    int32 version = 0;
+    file->ReadUint32(&magic);
+    file->ReadInt32(&version);
+    if (magic != NETWORK_RECORD_MAGIC || version != NETWORK_RECORD_VERSION)
+    {
+        LOG(Error, "Invalid network recording file '{0}'.", Path);
+        Delete(file);
+        return true;
+    }
+
+    // Load only the messages sent by the client to the server (server messages and events are not replayed)
+    while (file->CanRead() && !file->HasError())
+    {
+        double time;
+        byte kind, type, channelType;
+        uint32 connectionId, length;
+        file->ReadDouble(&time);
+        file->ReadByte(&kind);
+        file->ReadByte(&type);
+        file->ReadByte(&channelType);
+        file->ReadUint32(&connectionId);
+        file->ReadUint32(&length);
+        if (kind == NETWORK_RECORD_KIND_SEND && type == 0)
+        {
+            auto& message = _replay.AddOne();
+            message.Time = time;
+            message.ChannelType = (NetworkChannelType)channelType;
+            message.MessageData.Resize((int32)length, false);
+            file->ReadBytes(message.MessageData.Get(), length);
+        }
+        else
+        {
+            file->SetPosition(file->GetPosition() + length);
+        }
+    }
+    const bool failed = file->HasError();
+    Delete(file);
+    if (failed)
+    {
+        LOG(Error, "Failed to load network recording file '{0}'.", Path);
+        _replay.Clear();
+        return true;
+    }
+    return false;
+}
+
+void NetworkRecordDriver::UpdateReplay()
+{
+    if (_replayIndex < 0)
+        return;
+    const double time = Platform::GetTimeSeconds() - _startTime;
+    for (; _replayIndex < _replay.Count() && _replay[_replayIndex].Time <= time; _replayIndex++)
+    {
+        auto& e = _replay[_replayIndex];
+        const uint32 length = (uint32)e.MessageData.Count();
+        const NetworkMessage message(e.MessageData.Get(), 0, length, length, 0);
+        _driver->SendMessage(e.ChannelType, message);
+    }
+}
+
+void NetworkRecordDriver::Write(byte kind, byte type, NetworkChannelType channelType, uint32 connectionId, const byte* data, uint32 length)
+{
+    _file->WriteDouble(Platform::GetTimeSeconds() - _startTime);
+    _file->WriteByte(kind);
+    _file->WriteByte(type);
+    _file->WriteByte((byte)channelType);
+    _file->WriteUint32(connectionId);
+    _file->WriteUint32(length);
+    if (length)
+        _file->WriteBytes(data, length);
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Networking/INetworkDriver.h"
+#include "Engine/Networking/NetworkChannelType.h"
+#include "Engine/Networking/NetworkMessage.h"
+#include "Engine/Networking/NetworkConnection.h"
+#include "Engine/Networking/NetworkEvent.h"
+#include "Engine/Scripting/ScriptingObject.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Types/String.h"
+
+class FileWriteStream;
+
+/// <summary>
+/// The network traffic recording driver modes.
+/// </summary>
+API_ENUM(Namespace="FlaxEngine.Networking") enum class NetworkRecordMode
+{
+    /// <summary>
+    /// Captures all traffic (sent messages and received events) to the file.
+    /// </summary>
+    Record,
+
+    /// <summary>
+    /// Sends the messages captured in the file to the server (with the original timings) once connected. Used by the client bots for load testing.
+    /// </summary>
+    Replay,
+};
+
+/// <summary>
+/// Low-level network transport interface implementation that is proxy of another nested INetworkDriver implementation but with traffic recording and replaying feature.
+/// </summary>
+API_CLASS(Namespace="FlaxEngine.Networking", Sealed) class FLAXENGINE_API NetworkRecordDriver : public ScriptingObject, public INetworkDriver
+{
+    DECLARE_SCRIPTING_TYPE(NetworkRecordDriver);
+
+private:
+    struct RecordedMessage
+    {
+        double Time;
+        NetworkChannelType ChannelType;
+        Array<byte> MessageData;
+    };
+
+    INetworkDriver* _driver = nullptr;
+    FileWriteStream* _file = nullptr;
+    double _startTime = 0.0;
+    Array<RecordedMessage> _replay;
+    int32 _replayIndex = -1;
+
+public:
+    ~NetworkRecordDriver();
+
+    /// <summary>
+    /// The driver mode.
+    /// </summary>
+    API_FIELD() NetworkRecordMode Mode = NetworkRecordMode::Record;
+
+    /// <summary>
+    /// The path of the recording file (written when recording, read when replaying).
+    /// </summary>
+    API_FIELD() String Path;
+
+    /// <summary>
+    /// Gets or sets the nested INetworkDriver to use as a proxy with recording.
+    /// </summary>
+    API_PROPERTY() INetworkDriver* GetDriver() const
+    {
+        return _driver;
+    }
+
+    /// <summary>
+    /// Gets or sets the nested INetworkDriver to use as a proxy with recording.
+    /// </summary>
+    API_PROPERTY() void SetDriver(INetworkDriver* value);
+
+    /// <summary>
+    /// Checks if the replay has been started and all the recorded messages have been sent.
+    /// </summary>
+    API_PROPERTY() bool IsReplayDone() const
+    {
+        return _replayIndex >= _replay.Count();
+    }
+
+public:
+    // [INetworkDriver]
+    String DriverName() override;
+    bool Initialize(NetworkPeer* host, const NetworkConfig& config) override;
+    void Dispose() override;
+    bool Listen() override;
+    bool Connect() override;
+    void Disconnect() override;
+    void Disconnect(const NetworkConnection& connection) override;
+    bool PopEvent(NetworkEvent& eventPtr) override;
+    void RecycleMessage(const NetworkMessage& message) override;
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message) override;
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, NetworkConnection target) override;
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection, HeapAllocation>& targets) override;
+    NetworkDriverStats GetStats() override;
+    NetworkDriverStats GetStats(NetworkConnection target) override;
+
+private:
+    bool LoadReplay();
+    void UpdateReplay();
+    void Write(byte kind, byte type, NetworkChannelType channelType, uint32 connectionId, const byte* data, uint32 length);
+};
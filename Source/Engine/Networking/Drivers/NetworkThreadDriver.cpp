@@ -0,0 +1,275 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "NetworkThreadDriver.h"
+#include "ENetDriver.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Networking/NetworkStats.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/ThreadSpawner.h"
+
+NetworkThreadDriver::NetworkThreadDriver(const SpawnParams& params)
+    : ScriptingObject(params)
+{
+}
+
+NetworkThreadDriver::~NetworkThreadDriver()
+{
+    StopThread();
+    SetDriver(nullptr);
+    ThreadMessage* msg;
+    while (_messagesPool.try_dequeue(msg))
+        Delete(msg);
+}
+
+void NetworkThreadDriver::SetDriver(INetworkDriver* value)
+{
+    if (_driver == value)
+        return;
+    ASSERT(_thread == nullptr);
+
+    // Cleanup created proxy driver object
+    if (auto* driver = FromInterface(_driver, INetworkDriver::TypeInitializer))
+        Delete(driver);
+
+    _driver = value;
+}
+
+String NetworkThreadDriver::DriverName()
+{
+    if (!_driver)
+        return String::Empty;
+    return _driver->DriverName();
+}
+
+bool NetworkThreadDriver::Initialize(NetworkPeer* host, const NetworkConfig& config)
+{
+    if (!_driver)
+    {
+        // Use ENet as default
+        _driver = New<ENetDriver>();
+    }
+    if (!_driver)
+    {
+        LOG(Error, "Missing Driver for Network Thread.");
+        return true;
+    }
+    return _driver->Initialize(host, config);
+}
+
+void NetworkThreadDriver::Dispose()
+{
+    if (!_driver)
+        return;
+    StopThread();
+    Update();
+    _driver->Dispose();
+
+    // Cleanup any pending data (driver releases all received messages on dispose)
+    NetworkEvent e;
+    while (_events.try_dequeue(e))
+    {
+    }
+    NetworkMessage message;
+    while (_recycledMessages.try_dequeue(message))
+    {
+    }
+    ThreadMessage* msg;
+    while (_messages.try_dequeue(msg))
+        _messagesPool.enqueue(msg);
+}
+
+bool NetworkThreadDriver::Listen()
+{
+    if (!_driver)
+        return false;
+    {
+        ScopeLock lock(_driverLocker);
+        if (!_driver->Listen())
+            return false;
+    }
+    StartThread();
+    return true;
+}
+
+bool NetworkThreadDriver::Connect()
+{
+    if (!_driver)
+        return false;
+    {
+        ScopeLock lock(_driverLocker);
+        if (!_driver->Connect())
+            return false;
+    }
+    StartThread();
+    return true;
+}
+
+void NetworkThreadDriver::Disconnect()
+{
+    if (!_driver)
+        return;
+    ScopeLock lock(_driverLocker);
+    _driver->Disconnect();
+}
+
+void NetworkThreadDriver::Disconnect(const NetworkConnection& connection)
+{
+    if (!_driver)
+        return;
+    ScopeLock lock(_driverLocker);
+    _driver->Disconnect(connection);
+}
+
+bool NetworkThreadDriver::PopEvent(NetworkEvent& eventPtr)
+{
+    if (!_thread)
+    {
+        // Pass-through when network thread is not running
+        if (!_driver)
+            return false;
+        ScopeLock lock(_driverLocker);
+        return _driver->PopEvent(eventPtr);
+    }
+    return _events.try_dequeue(eventPtr);
+}
+
+void NetworkThreadDriver::RecycleMessage(const NetworkMessage& message)
+{
+    if (!_driver)
+        return;
+    if (!_thread)
+    {
+        ScopeLock lock(_driverLocker);
+        _driver->RecycleMessage(message);
+        return;
+    }
+
+    // Release received message on a network thread
+    _recycledMessages.enqueue(message);
+}
+
+void NetworkThreadDriver::SendMessage(const NetworkChannelType channelType, const NetworkMessage& message)
+{
+    AddMessage(0, channelType, message);
+}
+
+void NetworkThreadDriver::SendMessage(NetworkChannelType channelType, const NetworkMessage& message, NetworkConnection target)
+{
+    ThreadMessage* msg = AddMessage(1, channelType, message);
+    if (msg)
+        msg->Target = target;
+}
+
+void NetworkThreadDriver::SendMessage(const NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection, HeapAllocation>& targets)
+{
+    ThreadMessage* msg = AddMessage(2, channelType, message);
+    if (msg)
+        msg->Targets = targets;
+}
+
+NetworkDriverStats NetworkThreadDriver::GetStats()
+{
+    if (!_driver)
+        return NetworkDriverStats();
+    ScopeLock lock(_driverLocker);
+    return _driver->GetStats();
+}
+
+NetworkDriverStats NetworkThreadDriver::GetStats(NetworkConnection target)
+{
+    if (!_driver)
+        return NetworkDriverStats();
+    ScopeLock lock(_driverLocker);
+    return _driver->GetStats(target);
+}
+
+void NetworkThreadDriver::StartThread()
+{
+    if (_thread)
+        return;
+    Platform::AtomicStore(&_exitFlag, 0);
+    Function<int32()> run;
+    run.Bind<NetworkThreadDriver, &NetworkThreadDriver::Run>(this);
+    _thread = ThreadSpawner::Start(run, TEXT("Network"), ThreadPriority::AboveNormal);
+}
+
+void NetworkThreadDriver::StopThread()
+{
+    if (!_thread)
+        return;
+    Platform::AtomicStore(&_exitFlag, 1);
+    _thread->Join();
+    Delete(_thread);
+    _thread = nullptr;
+}
+
+int32 NetworkThreadDriver::Run()
+{
+    while (Platform::AtomicRead(&_exitFlag) == 0)
+    {
+        Update();
+        Platform::Sleep(UpdateInterval);
+    }
+    return 0;
+}
+
+void NetworkThreadDriver::Update()
+{
+    PROFILE_CPU();
+    ScopeLock lock(_driverLocker);
+
+    // Release processed messages
+    NetworkMessage message;
+    while (_recycledMessages.try_dequeue(message))
+        _driver->RecycleMessage(message);
+
+    // Send pending messages
+    ThreadMessage* msg;
+    while (_messages.try_dequeue(msg))
+    {
+        const uint32 length = (uint32)msg->MessageData.Count();
+        message = NetworkMessage(msg->MessageData.Get(), 0, length, length, 0);
+        switch (msg->Type)
+        {
+        case 0:
+            _driver->SendMessage(msg->ChannelType, message);
+            break;
+        case 1:
+            _driver->SendMessage(msg->ChannelType, message, msg->Target);
+            break;
+        case 2:
+            _driver->SendMessage(msg->ChannelType, message, msg->Targets);
+            break;
+        }
+        _messagesPool.enqueue(msg);
+    }
+
+    // Receive events
+    if (_thread)
+    {
+        NetworkEvent e;
+        e.Timestamp = 0.0;
+        while (_driver->PopEvent(e))
+        {
+            e.Timestamp = Platform::GetTimeSeconds();
+            _events.enqueue(e);
+        }
+    }
+}
+
+NetworkThreadDriver::ThreadMessage* NetworkThreadDriver::AddMessage(int32 type, NetworkChannelType channelType, const NetworkMessage& message)
+{
+    if (!_driver)
+        return nullptr;
+
+    // Copy message data (peer recycles message after sending)
+    ThreadMessage* msg;
+    if (!_messagesPool.try_dequeue(msg))
+        msg = New<ThreadMessage>();
+    msg->Type = type;
+    msg->ChannelType = channelType;
+    msg->MessageData.Set(message.Buffer, (int32)message.Length);
+    _messages.enqueue(msg);
+    return msg;
+}
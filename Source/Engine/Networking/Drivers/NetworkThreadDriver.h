@@ -0,0 +1,86 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Networking/INetworkDriver.h"
+#include "Engine/Networking/NetworkMessage.h"
+#include "Engine/Networking/NetworkConnection.h"
+#include "Engine/Networking/NetworkEvent.h"
+#include "Engine/Scripting/ScriptingObject.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Platform/CriticalSection.h"
+#include "Engine/Platform/Thread.h"
+#include "Engine/Threading/ConcurrentQueue.h"
+
+/// <summary>
+/// Low-level network transport interface implementation that is proxy of another nested INetworkDriver implementation but runs it on a dedicated network thread. Polls events, sends messages and timestamps received events independently of the game frame time which reduces latency and jitter.
+/// </summary>
+/// <remarks>Nested driver must not use the peer messages pool when receiving messages (eg. ENetDriver references the received packets memory directly).</remarks>
+API_CLASS(Namespace="FlaxEngine.Networking", Sealed) class FLAXENGINE_API NetworkThreadDriver : public ScriptingObject, public INetworkDriver
+{
+    DECLARE_SCRIPTING_TYPE(NetworkThreadDriver);
+
+private:
+    struct ThreadMessage
+    {
+        int32 Type;
+        NetworkChannelType ChannelType;
+        NetworkConnection Target;
+        Array<NetworkConnection> Targets;
+        Array<byte> MessageData;
+    };
+
+    INetworkDriver* _driver = nullptr;
+    Thread* _thread = nullptr;
+    volatile int64 _exitFlag = 0;
+    CriticalSection _driverLocker;
+    ConcurrentQueue<NetworkEvent> _events;
+    ConcurrentQueue<NetworkMessage> _recycledMessages;
+    ConcurrentQueue<ThreadMessage*> _messages;
+    ConcurrentQueue<ThreadMessage*> _messagesPool;
+
+public:
+    ~NetworkThreadDriver();
+
+    /// <summary>
+    /// The time (in milliseconds) between the network thread updates.
+    /// </summary>
+    API_FIELD(Attributes="Limit(0, 100)") int32 UpdateInterval = 1;
+
+    /// <summary>
+    /// Gets or sets the nested INetworkDriver to run on a network thread.
+    /// </summary>
+    API_PROPERTY() INetworkDriver* GetDriver() const
+    {
+        return _driver;
+    }
+
+    /// <summary>
+    /// Gets or sets the nested INetworkDriver to run on a network thread.
+    /// </summary>
+    API_PROPERTY() void SetDriver(INetworkDriver* value);
+
+public:
+    // [INetworkDriver]
+    String DriverName() override;
+    bool Initialize(NetworkPeer* host, const NetworkConfig& config) override;
+    void Dispose() override;
+    bool Listen() override;
+    bool Connect() override;
+    void Disconnect() override;
+    void Disconnect(const NetworkConnection& connection) override;
+    bool PopEvent(NetworkEvent& eventPtr) override;
+    void RecycleMessage(const NetworkMessage& message) override;
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message) override;
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, NetworkConnection target) override;
+    void SendMessage(NetworkChannelType channelType, const NetworkMessage& message, const Array<NetworkConnection, HeapAllocation>& targets) override;
+    NetworkDriverStats GetStats() override;
+    NetworkDriverStats GetStats(NetworkConnection target) override;
+
+private:
+    void StartThread();
+    void StopThread();
+    int32 Run();
+    void Update();
+    ThreadMessage* AddMessage(int32 type, NetworkChannelType channelType, const NetworkMessage& message);
+};
@@ -73,6 +73,14 @@ API_INTERFACE(Namespace="FlaxEngine.Networking") class FLAXENGINE_API INetworkDr
     /// <returns>True when succeeded and the event can be processed.</returns>
     API_FUNCTION() virtual bool PopEvent(API_PARAM(Out) NetworkEvent& eventPtr) = 0;
 
+    /// <summary>
+    /// Releases the received message that references the driver memory (zero-copy receive). Called for messages with NetworkMessage::DriverMessageIdFlag set in the message id.
+    /// </summary>
+    /// <param name="message">The message.</param>
+    API_FUNCTION() virtual void RecycleMessage(const NetworkMessage& message)
+    {
+    }
+
     /// <summary>
     /// Sends given message over specified channel to the server.
     /// </summary>
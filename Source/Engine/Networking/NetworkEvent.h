@@ -61,6 +61,11 @@ API_STRUCT(Namespace="FlaxEngine.Networking") struct FLAXENGINE_API NetworkEvent
     /// </summary>
     /// <remarks>Only valid when event has been received on server-peer.</remarks>
     API_FIELD() NetworkConnection Sender;
+
+    /// <summary>
+    /// The time (in seconds, see Platform::GetTimeSeconds) when the event was received by the network driver. Can be used to measure latency independently of the frame time (eg. when using a dedicated network thread).
+    /// </summary>
+    API_FIELD() double Timestamp;
 };
 
 template<>
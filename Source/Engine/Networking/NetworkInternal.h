@@ -19,6 +19,9 @@ enum class NetworkMessageIDs : uint8
     ObjectDespawn,
     ObjectRole,
     ObjectRpc,
+    ObjectReplicateAck,
+    ObjectReplicateBatch,
+    ObjectRpcBatch,
 
     MAX,
 };
@@ -38,6 +41,9 @@ class NetworkInternal
     static void OnNetworkMessageObjectDespawn(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
     static void OnNetworkMessageObjectRole(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
     static void OnNetworkMessageObjectRpc(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
+    static void OnNetworkMessageObjectReplicateAck(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
+    static void OnNetworkMessageObjectReplicateBatch(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
+    static void OnNetworkMessageObjectRpcBatch(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer);
 
 #if COMPILE_WITH_PROFILER
 
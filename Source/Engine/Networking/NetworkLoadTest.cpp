@@ -0,0 +1,182 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "NetworkLoadTest.h"
+#include "NetworkPeer.h"
+#include "NetworkEvent.h"
+#include "NetworkStats.h"
+#include "INetworkDriver.h"
+#include "Drivers/ENetDriver.h"
+#include "Drivers/NetworkRecordDriver.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Serialization/FileWriteStream.h"
+#include "Engine/Serialization/JsonWriters.h"
+
+NetworkLoadTest::NetworkLoadTest(const SpawnParams& params)
+    : ScriptingObject(params)
+{
+}
+
+NetworkLoadTest::~NetworkLoadTest()
+{
+    Stop();
+}
+
+bool NetworkLoadTest::Start()
+{
+    if (IsRunning())
+        return true;
+    LOG(Info, "Starting network load test with {0} bots connecting to {1}:{2}", BotsCount, Config.Address, Config.Port);
+    if (StatsPath.HasChars())
+    {
+        _statsFile = FileWriteStream::Open(StatsPath);
+        if (!_statsFile)
+        {
+            LOG(Error, "Failed to open network stats file '{0}'.", StatsPath);
+            return true;
+        }
+        _statsFile->WriteBytes("[\n", 2);
+    }
+
+    // Spawn bots
+    _bots.EnsureCapacity(BotsCount);
+    for (int32 i = 0; i < BotsCount; i++)
+    {
+        NetworkConfig config = Config;
+        if (ReplayPath.HasChars())
+        {
+            auto driver = New<NetworkRecordDriver>();
+            driver->Mode = NetworkRecordMode::Replay;
+            driver->Path = ReplayPath;
+            config.NetworkDriver = driver;
+        }
+        else
+        {
+            config.NetworkDriver = New<ENetDriver>();
+        }
+        NetworkPeer* peer = NetworkPeer::CreatePeer(config);
+        if (!peer || !peer->Connect())
+        {
+            LOG(Error, "Failed to spawn network bot {0}", i);
+            if (peer)
+                NetworkPeer::ShutdownPeer(peer);
+            else
+                Delete(config.NetworkDriver);
+            Stop();
+            return true;
+        }
+        _bots.Add(peer);
+    }
+    _botsConnected.Resize(_bots.Count());
+    _botsConnected.SetAll(false);
+    _tick = 0;
+    _startTime = Platform::GetTimeSeconds();
+    if (AutoUpdate)
+    {
+        _autoUpdate = true;
+        Engine::Update.Bind<NetworkLoadTest, &NetworkLoadTest::Update>(this);
+    }
+    return false;
+}
+
+void NetworkLoadTest::Stop()
+{
+    if (_autoUpdate)
+    {
+        _autoUpdate = false;
+        Engine::Update.Unbind<NetworkLoadTest, &NetworkLoadTest::Update>(this);
+    }
+    if (_bots.HasItems())
+        LOG(Info, "Stopping network load test after {0} ticks", _tick);
+    for (NetworkPeer* peer : _bots)
+    {
+        peer->Disconnect();
+        NetworkPeer::ShutdownPeer(peer);
+    }
+    _bots.Clear();
+    _botsConnected.Clear();
+    if (_statsFile)
+    {
+        _statsFile->WriteBytes("]\n", 2);
+        Delete(_statsFile);
+        _statsFile = nullptr;
+    }
+}
+
+void NetworkLoadTest::Update()
+{
+    if (!IsRunning())
+        return;
+    PROFILE_CPU();
+
+    for (int32 i = 0; i < _bots.Count(); i++)
+    {
+        NetworkPeer* peer = _bots[i];
+
+        // Process received events (bots don't simulate the game state)
+        NetworkEvent e;
+        while (peer->PopEvent(e))
+        {
+            switch (e.EventType)
+            {
+            case NetworkEventType::Connected:
+                _botsConnected[i] = true;
+                break;
+            case NetworkEventType::Disconnected:
+            case NetworkEventType::Timeout:
+                _botsConnected[i] = false;
+                break;
+            case NetworkEventType::Message:
+                peer->RecycleMessage(e.Message);
+                break;
+            default:
+                break;
+            }
+        }
+
+        // Scripted input
+        if (_botsConnected[i])
+            BotUpdate(i, peer);
+    }
+
+    if (_statsFile)
+        WriteStats();
+    _tick++;
+}
+
+void NetworkLoadTest::WriteStats()
+{
+    PROFILE_CPU();
+    rapidjson_flax::StringBuffer buffer;
+    CompactJsonWriter writer(buffer);
+    writer.StartObject();
+    writer.JKEY("Tick");
+    writer.Int(_tick);
+    writer.JKEY("Time");
+    writer.Double(Platform::GetTimeSeconds() - _startTime);
+    writer.JKEY("Bots");
+    writer.StartArray();
+    for (int32 i = 0; i < _bots.Count(); i++)
+    {
+        const NetworkDriverStats stats = _bots[i]->NetworkDriver->GetStats();
+        writer.StartObject();
+        writer.JKEY("Id");
+        writer.Int(i);
+        writer.JKEY("Connected");
+        writer.Bool(_botsConnected[i]);
+        writer.JKEY("RTT");
+        writer.Float(stats.RTT);
+        writer.JKEY("TotalDataSent");
+        writer.Uint(stats.TotalDataSent);
+        writer.JKEY("TotalDataReceived");
+        writer.Uint(stats.TotalDataReceived);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    if (_tick != 0)
+        _statsFile->WriteBytes(",\n", 2);
+    _statsFile->WriteBytes(buffer.GetString(), (uint32)buffer.GetSize());
+}
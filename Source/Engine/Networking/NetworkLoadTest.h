@@ -0,0 +1,96 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "NetworkConfig.h"
+#include "Engine/Core/Delegate.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Scripting/ScriptingObject.h"
+
+class NetworkPeer;
+class FileWriteStream;
+
+/// <summary>
+/// Headless network load testing harness. Spawns a set of simulated clients (bots) that connect to the (dedicated) server and run replayed traffic (see NetworkRecordDriver) or scripted input. Emits per-tick network driver statistics to the JSON file.
+/// </summary>
+API_CLASS(Namespace="FlaxEngine.Networking") class FLAXENGINE_API NetworkLoadTest : public ScriptingObject
+{
+    DECLARE_SCRIPTING_TYPE(NetworkLoadTest);
+
+private:
+    Array<NetworkPeer*> _bots;
+    Array<bool> _botsConnected;
+    FileWriteStream* _statsFile = nullptr;
+    int32 _tick = 0;
+    double _startTime = 0.0;
+    bool _autoUpdate = false;
+
+public:
+    ~NetworkLoadTest();
+
+    /// <summary>
+    /// The amount of the simulated clients to spawn.
+    /// </summary>
+    API_FIELD(Attributes="Limit(1, 10000)") int32 BotsCount = 16;
+
+    /// <summary>
+    /// The network configuration of the bot peers (contains the server address and port to connect to). Network driver is created for each bot separately (NetworkDriver field is ignored).
+    /// </summary>
+    API_FIELD() NetworkConfig Config;
+
+    /// <summary>
+    /// The path of the network recording file (see NetworkRecordDriver) to replay by every bot. If empty, then bots send only the scripted input (see BotUpdate event).
+    /// </summary>
+    API_FIELD() String ReplayPath;
+
+    /// <summary>
+    /// The path of the output JSON file with the per-tick statistics of every bot. If empty, then statistics are not written.
+    /// </summary>
+    API_FIELD() String StatsPath;
+
+    /// <summary>
+    /// If checked, bots are updated automatically every engine update, otherwise call Update manually.
+    /// </summary>
+    API_FIELD() bool AutoUpdate = true;
+
+    /// <summary>
+    /// Event called for every connected bot on each update. Can be used to send scripted input messages by the bot peer.
+    /// </summary>
+    API_EVENT() Delegate<int32, NetworkPeer*> BotUpdate;
+
+    /// <summary>
+    /// Gets the list of the bots peers.
+    /// </summary>
+    API_PROPERTY() const Array<NetworkPeer*>& GetBots() const
+    {
+        return _bots;
+    }
+
+    /// <summary>
+    /// Checks if the load test is running.
+    /// </summary>
+    API_PROPERTY() bool IsRunning() const
+    {
+        return _bots.HasItems();
+    }
+
+public:
+    /// <summary>
+    /// Starts the load test by spawning and connecting all bots.
+    /// </summary>
+    /// <returns>True if failed, otherwise false.</returns>
+    API_FUNCTION() bool Start();
+
+    /// <summary>
+    /// Stops the load test by disconnecting and destroying all bots.
+    /// </summary>
+    API_FUNCTION() void Stop();
+
+    /// <summary>
+    /// Updates all bots (processes the received events, calls BotUpdate and writes statistics).
+    /// </summary>
+    API_FUNCTION() void Update();
+
+private:
+    void WriteStats();
+};
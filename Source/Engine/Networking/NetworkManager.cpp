@@ -13,6 +13,7 @@
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Engine/Time.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Scripting/Scripting.h"
 
 #define NETWORK_PROTOCOL_VERSION 3
@@ -135,6 +136,9 @@ namespace
         NetworkInternal::OnNetworkMessageObjectDespawn,
         NetworkInternal::OnNetworkMessageObjectRole,
         NetworkInternal::OnNetworkMessageObjectRpc,
+        NetworkInternal::OnNetworkMessageObjectReplicateAck,
+        NetworkInternal::OnNetworkMessageObjectReplicateBatch,
+        NetworkInternal::OnNetworkMessageObjectRpcBatch,
     };
 }
 
@@ -374,6 +378,7 @@ void NetworkManagerService::Update()
     auto peer = NetworkManager::Peer;
     if (NetworkManager::Mode == NetworkManagerMode::Offline || (float)(currentTime - LastUpdateTime) < minDeltaTime || !peer)
         return;
+    PROFILE_MEM(Networking);
     PROFILE_CPU();
     LastUpdateTime = currentTime;
     NetworkManager::Frame++;
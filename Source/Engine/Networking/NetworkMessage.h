@@ -41,6 +41,12 @@ API_STRUCT(Namespace="FlaxEngine.Networking") struct FLAXENGINE_API NetworkMessa
     /// </summary>
     API_FIELD() uint32 Position = 0;
 
+public:
+    /// <summary>
+    /// The message identifier flag used by messages that reference memory owned by the network driver (eg. received packet data). Such messages are returned to the driver via INetworkDriver::RecycleMessage instead of the peer messages pool.
+    /// </summary>
+    static constexpr uint32 DriverMessageIdFlag = 0x80000000;
+
 public:
     /// <summary>
     /// Initializes default values of the <seealso cref="NetworkMessage"/> structure.
@@ -6,6 +6,7 @@
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Math/Math.h"
 #include "Engine/Platform/CPUInfo.h"
+#include "Engine/Platform/Platform.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 
 Array<NetworkPeer*> NetworkPeer::Peers;
@@ -134,7 +135,12 @@ void NetworkPeer::Disconnect(const NetworkConnection& connection)
 bool NetworkPeer::PopEvent(NetworkEvent& eventRef)
 {
     PROFILE_CPU();
-    return NetworkDriver->PopEvent(eventRef);
+    eventRef.Timestamp = 0.0;
+    if (!NetworkDriver->PopEvent(eventRef))
+        return false;
+    if (eventRef.Timestamp <= 0.0)
+        eventRef.Timestamp = Platform::GetTimeSeconds();
+    return true;
 }
 
 NetworkMessage NetworkPeer::CreateMessage()
@@ -146,6 +152,12 @@ NetworkMessage NetworkPeer::CreateMessage()
 
 void NetworkPeer::RecycleMessage(const NetworkMessage& message)
 {
+    if (message.MessageId & NetworkMessage::DriverMessageIdFlag)
+    {
+        // Release received message data back to the driver
+        NetworkDriver->RecycleMessage(message);
+        return;
+    }
     ASSERT(message.IsValid());
 #ifdef BUILD_DEBUG
     ASSERT(MessagePool.Contains(message.MessageId) == false);
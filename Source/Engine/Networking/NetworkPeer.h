@@ -75,7 +75,7 @@ API_CLASS(sealed, NoSpawn, Namespace = "FlaxEngine.Networking") class FLAXENGINE
     API_FUNCTION() NetworkMessage CreateMessage();
 
     /// <summary>
-    /// Returns given message to the pool.
+    /// Returns given message to the pool (or to the network driver if message references driver memory).
     /// </summary>
     /// <remarks>Make sure that this message belongs to the peer and has not been recycled already (debug build checks for this)!</remarks>
     API_FUNCTION() void RecycleMessage(const NetworkMessage& message);
@@ -2,6 +2,8 @@
 
 #include "NetworkReplicationHierarchy.h"
 #include "NetworkManager.h"
+#include "NetworkReplicator.h"
+#include "NetworkClient.h"
 #include "Engine/Level/Actor.h"
 #include "Engine/Level/SceneObject.h"
 
@@ -25,7 +27,13 @@ void NetworkReplicationHierarchyUpdateResult::Init()
     _clients.Resize(NetworkManager::Clients.Count());
     _clientsMask = NetworkManager::Mode == NetworkManagerMode::Client ? NetworkClientsMask::All : NetworkClientsMask();
     for (int32 i = 0; i < _clients.Count(); i++)
+    {
+        Client& client = _clients[i];
+        client.HasLocation = false;
+        client.HasViewDirection = false;
+        client.BandwidthBudget = -1;
         _clientsMask.SetBit(i);
+    }
     _entries.Clear();
     ReplicationScale = 1.0f;
 }
@@ -47,6 +55,34 @@ bool NetworkReplicationHierarchyUpdateResult::GetClientLocation(int32 clientInde
     return client.HasLocation;
 }
 
+void NetworkReplicationHierarchyUpdateResult::SetClientViewDirection(int32 clientIndex, const Float3& direction)
+{
+    CHECK(clientIndex >= 0 && clientIndex < _clients.Count());
+    Client& client = _clients[clientIndex];
+    client.HasViewDirection = true;
+    client.ViewDirection = direction;
+}
+
+bool NetworkReplicationHierarchyUpdateResult::GetClientViewDirection(int32 clientIndex, Float3& direction) const
+{
+    CHECK_RETURN(clientIndex >= 0 && clientIndex < _clients.Count(), false);
+    const Client& client = _clients[clientIndex];
+    direction = client.ViewDirection;
+    return client.HasViewDirection;
+}
+
+void NetworkReplicationHierarchyUpdateResult::SetClientBandwidthBudget(int32 clientIndex, int32 bytes)
+{
+    CHECK(clientIndex >= 0 && clientIndex < _clients.Count());
+    _clients[clientIndex].BandwidthBudget = bytes;
+}
+
+int32 NetworkReplicationHierarchyUpdateResult::GetClientBandwidthBudget(int32 clientIndex) const
+{
+    CHECK_RETURN(clientIndex >= 0 && clientIndex < _clients.Count(), -1);
+    return _clients[clientIndex].BandwidthBudget;
+}
+
 void NetworkReplicationNode::AddObject(NetworkReplicationHierarchyObject obj)
 {
     if (obj.ReplicationFPS > ZeroTolerance) // > 0
@@ -106,14 +142,14 @@ void NetworkReplicationNode::Update(NetworkReplicationHierarchyUpdateResult* res
             {
                 // Marked as dirty to sync manually
                 obj.ReplicationUpdatesLeft = 0;
-                result->AddObject(obj.Object);
+                result->AddObject(obj.Object, NetworkClientsMask::All, obj.Priority);
             }
             continue;
         }
         else if (obj.ReplicationFPS < ZeroTolerance) // == 0
         {
             // Always relevant
-            result->AddObject(obj.Object);
+            result->AddObject(obj.Object, NetworkClientsMask::All, obj.Priority);
         }
         else if (obj.ReplicationUpdatesLeft > 0)
         {
@@ -149,7 +185,7 @@ void NetworkReplicationNode::Update(NetworkReplicationHierarchyUpdateResult* res
             if (targetClients && obj.Object)
             {
                 // Replicate this frame
-                result->AddObject(obj.Object, targetClients);
+                result->AddObject(obj.Object, targetClients, obj.Priority);
             }
 
             // Calculate frames until next replication
@@ -261,3 +297,347 @@ void NetworkReplicationGridNode::Update(NetworkReplicationHierarchyUpdateResult*
         }
     }
 }
+
+Int3 NetworkReplicationSpatialNode::GetCell(const Vector3& position) const
+{
+    const Vector3 cell = position / CellSize;
+    return Int3(Math::FloorToInt((float)cell.X), Math::FloorToInt((float)cell.Y), Math::FloorToInt((float)cell.Z));
+}
+
+bool NetworkReplicationSpatialNode::IsInRange(const Int3& clientCell, const Int3& objectCell) const
+{
+    return Math::Abs(clientCell.X - objectCell.X) <= _cellsRadius &&
+            Math::Abs(clientCell.Y - objectCell.Y) <= _cellsRadius &&
+            Math::Abs(clientCell.Z - objectCell.Z) <= _cellsRadius;
+}
+
+void NetworkReplicationSpatialNode::SetRelevance(int32 objectIndex, int32 clientIndex, bool relevant)
+{
+    ObjectState& state = _objectStates[objectIndex];
+    if (state.Clients.HasBit(clientIndex) == relevant)
+        return;
+    if (relevant)
+        state.Clients.SetBit(clientIndex);
+    else
+        state.Clients.UnsetBit(clientIndex);
+    const uint32 clientId = _clients[clientIndex].ClientId;
+    if (UpdateSpawning)
+        NetworkReplicator::SetObjectRelevance(state.Object, clientId, relevant);
+    if (relevant)
+    {
+        // Replicate object to the client as soon as possible
+        NetworkReplicationHierarchyObject& obj = Objects[objectIndex];
+        obj.ReplicationUpdatesLeft = obj.ReplicationFPS < -ZeroTolerance ? 1 : 0;
+    }
+    _events.Add({ state.Object, clientId, relevant });
+}
+
+void NetworkReplicationSpatialNode::UpdateClients()
+{
+    const auto& clients = NetworkManager::Clients;
+    bool changed = clients.Count() != _clients.Count();
+    for (int32 i = 0; i < clients.Count() && !changed; i++)
+        changed = clients[i]->ClientId != _clients[i].ClientId;
+    if (!changed)
+        return;
+
+    // Remap relevance masks to match the new clients list (eg. after client connected or disconnected)
+    Array<ClientState> newClients;
+    Array<int32> oldIndices;
+    newClients.Resize(clients.Count());
+    oldIndices.Resize(clients.Count());
+    for (int32 i = 0; i < clients.Count(); i++)
+    {
+        ClientState& client = newClients[i];
+        client.ClientId = clients[i]->ClientId;
+        client.HasCell = false;
+        oldIndices[i] = -1;
+        for (int32 j = 0; j < _clients.Count(); j++)
+        {
+            if (_clients[j].ClientId == client.ClientId)
+            {
+                client = _clients[j];
+                oldIndices[i] = j;
+                break;
+            }
+        }
+    }
+    for (ObjectState& state : _objectStates)
+    {
+        NetworkClientsMask mask;
+        for (int32 i = 0; i < oldIndices.Count(); i++)
+        {
+            // New clients get all objects spawned so they are relevant until client location is known
+            if (oldIndices[i] == -1 || state.Clients.HasBit(oldIndices[i]))
+                mask.SetBit(i);
+        }
+        state.Clients = mask;
+    }
+    _clients = MoveTemp(newClients);
+}
+
+void NetworkReplicationSpatialNode::MoveObject(int32 objectIndex, const Int3& cell)
+{
+    ObjectState& state = _objectStates[objectIndex];
+    if (state.HasCell)
+        _cells[state.Cell].Remove(objectIndex);
+    state.HasCell = true;
+    state.Cell = cell;
+    _cells[cell].Add(objectIndex);
+
+    // Update relevance for the clients that see the old or new cell
+    for (int32 clientIndex = 0; clientIndex < _clients.Count(); clientIndex++)
+    {
+        const ClientState& client = _clients[clientIndex];
+        if (client.HasCell)
+            SetRelevance(objectIndex, clientIndex, IsInRange(client.Cell, cell));
+    }
+}
+
+void NetworkReplicationSpatialNode::MoveClient(int32 clientIndex, const Int3& cell)
+{
+    ClientState& client = _clients[clientIndex];
+    if (!client.HasCell)
+    {
+        // Initial location so check all objects
+        client.HasCell = true;
+        client.Cell = cell;
+        for (int32 objectIndex = 0; objectIndex < _objectStates.Count(); objectIndex++)
+        {
+            const ObjectState& state = _objectStates[objectIndex];
+            if (state.HasCell)
+                SetRelevance(objectIndex, clientIndex, IsInRange(cell, state.Cell));
+        }
+        return;
+    }
+    const Int3 prevCell = client.Cell;
+    client.Cell = cell;
+
+    // Objects in cells that went out of range
+    const int32 r = _cellsRadius;
+    for (int32 x = -r; x <= r; x++)
+    {
+        for (int32 y = -r; y <= r; y++)
+        {
+            for (int32 z = -r; z <= r; z++)
+            {
+                const Int3 coord = prevCell + Int3(x, y, z);
+                if (IsInRange(cell, coord))
+                    continue;
+                if (const Array<int32>* objects = _cells.TryGet(coord))
+                {
+                    for (const int32 objectIndex : *objects)
+                        SetRelevance(objectIndex, clientIndex, false);
+                }
+            }
+        }
+    }
+
+    // Objects in cells that came into range
+    for (int32 x = -r; x <= r; x++)
+    {
+        for (int32 y = -r; y <= r; y++)
+        {
+            for (int32 z = -r; z <= r; z++)
+            {
+                const Int3 coord = cell + Int3(x, y, z);
+                if (IsInRange(prevCell, coord))
+                    continue;
+                if (const Array<int32>* objects = _cells.TryGet(coord))
+                {
+                    for (const int32 objectIndex : *objects)
+                        SetRelevance(objectIndex, clientIndex, true);
+                }
+            }
+        }
+    }
+}
+
+void NetworkReplicationSpatialNode::AddObject(NetworkReplicationHierarchyObject obj)
+{
+    ScriptingObject* object = obj.Object.Get();
+    if (!object || _objectToIndex.ContainsKey(object))
+        return;
+    _objectToIndex[object] = Objects.Count();
+    NetworkReplicationNode::AddObject(obj);
+
+    // Object is relevant for all clients until it gets location (during update)
+    ObjectState& state = _objectStates.AddOne();
+    state.Object = object;
+    state.HasCell = false;
+    state.Clients = NetworkClientsMask::All;
+}
+
+bool NetworkReplicationSpatialNode::RemoveObject(ScriptingObject* obj)
+{
+    int32 index;
+    if (!_objectToIndex.TryGet(obj, index))
+        return false;
+    _objectToIndex.Remove(obj);
+    const ObjectState& state = _objectStates[index];
+    if (state.HasCell)
+        _cells[state.Cell].Remove(index);
+
+    // Move the last object into the removed slot
+    const int32 lastIndex = Objects.Count() - 1;
+    if (index != lastIndex)
+    {
+        const ObjectState& lastState = _objectStates[lastIndex];
+        _objectToIndex[lastState.Object] = index;
+        if (lastState.HasCell)
+        {
+            Array<int32>& cell = _cells[lastState.Cell];
+            cell[cell.Find(lastIndex)] = index;
+        }
+    }
+    Objects.RemoveAt(index);
+    _objectStates.RemoveAt(index);
+    return true;
+}
+
+bool NetworkReplicationSpatialNode::GetObject(ScriptingObject* obj, NetworkReplicationHierarchyObject& result)
+{
+    int32 index;
+    if (_objectToIndex.TryGet(obj, index))
+    {
+        result = Objects[index];
+        return true;
+    }
+    return false;
+}
+
+bool NetworkReplicationSpatialNode::DirtyObject(ScriptingObject* obj)
+{
+    int32 index;
+    if (_objectToIndex.TryGet(obj, index))
+    {
+        NetworkReplicationHierarchyObject& e = Objects[index];
+        e.ReplicationUpdatesLeft = e.ReplicationFPS < -ZeroTolerance ? 1 : 0;
+        return true;
+    }
+    return false;
+}
+
+void NetworkReplicationSpatialNode::Update(NetworkReplicationHierarchyUpdateResult* result)
+{
+    CHECK(result);
+    UpdateClients();
+    const int32 cellsRadius = Math::Max(Math::CeilToInt(RelevanceDistance / Math::Max(CellSize, 1.0f)), 0);
+    if (_cellsRadius != cellsRadius)
+    {
+        // Range changed so refresh relevance for all clients
+        _cellsRadius = cellsRadius;
+        for (ClientState& client : _clients)
+            client.HasCell = false;
+    }
+
+    // Update clients that moved into a different cell
+    for (int32 clientIndex = 0; clientIndex < _clients.Count(); clientIndex++)
+    {
+        Vector3 location;
+        if (result->GetClientLocation(clientIndex, location))
+        {
+            const Int3 cell = GetCell(location);
+            const ClientState& client = _clients[clientIndex];
+            if (!client.HasCell || client.Cell != cell)
+                MoveClient(clientIndex, cell);
+        }
+    }
+
+    const float networkFPS = NetworkManager::NetworkFPS / result->ReplicationScale;
+    const NetworkClientsMask clientsMask = result->GetClientsMask();
+    for (int32 objectIndex = 0; objectIndex < Objects.Count(); objectIndex++)
+    {
+        NetworkReplicationHierarchyObject& obj = Objects[objectIndex];
+
+        // Update objects that moved into a different cell
+        if (const Actor* actor = obj.GetActor())
+        {
+            const Int3 cell = GetCell(actor->GetPosition());
+            const ObjectState& state = _objectStates[objectIndex];
+            if (!state.HasCell || state.Cell != cell)
+                MoveObject(objectIndex, cell);
+        }
+
+        // Replicate object only to the clients that it's relevant for
+        NetworkClientsMask targetClients = clientsMask;
+        if (_clients.HasItems())
+        {
+            const NetworkClientsMask& relevantClients = _objectStates[objectIndex].Clients;
+            targetClients.Word0 &= relevantClients.Word0;
+            targetClients.Word1 &= relevantClients.Word1;
+        }
+        if (obj.ReplicationFPS < -ZeroTolerance) // < 0
+        {
+            if (obj.ReplicationUpdatesLeft)
+            {
+                // Marked as dirty to sync manually
+                obj.ReplicationUpdatesLeft = 0;
+                if (targetClients)
+                    result->AddObject(obj.Object, targetClients, obj.Priority);
+            }
+        }
+        else if (obj.ReplicationFPS < ZeroTolerance) // == 0
+        {
+            // Always relevant
+            if (targetClients)
+                result->AddObject(obj.Object, targetClients, obj.Priority);
+        }
+        else if (obj.ReplicationUpdatesLeft > 0)
+        {
+            // Move to the next frame
+            obj.ReplicationUpdatesLeft--;
+        }
+        else
+        {
+            if (targetClients && obj.Object)
+            {
+                // Replicate this frame
+                result->AddObject(obj.Object, targetClients, obj.Priority);
+            }
+
+            // Calculate frames until next replication
+            obj.ReplicationUpdatesLeft = (uint16)Math::Clamp<int32>(Math::RoundToInt(networkFPS / obj.ReplicationFPS) - 1, 0, MAX_uint16);
+        }
+    }
+
+    // Send relevance events (after update to allow modifying the node from the event handlers)
+    if (_events.HasItems())
+    {
+        Array<RelevanceEvent> events = MoveTemp(_events);
+        for (const RelevanceEvent& e : events)
+        {
+            NetworkClient* client = NetworkManager::GetClient(e.ClientId);
+            if (!client)
+                continue;
+            if (e.Relevant)
+                ObjectEnter(e.Object, client);
+            else
+                ObjectLeave(e.Object, client);
+        }
+    }
+}
+
+float NetworkReplicationHierarchy::GetPriority(NetworkReplicationHierarchyUpdateResult* result, int32 clientIndex, ScriptingObject* obj, float priority)
+{
+    CHECK_RETURN(result && clientIndex >= 0 && clientIndex < result->_clients.Count(), priority);
+    const auto& client = result->_clients[clientIndex];
+    const Actor* actor = NetworkReplicationHierarchyObject(obj).GetActor();
+    if (!client.HasLocation || !actor)
+        return priority;
+    const Vector3 toObject = actor->GetPosition() - client.Location;
+    const float distance = (float)toObject.Length();
+
+    // Lower priority of the objects far away from the viewer
+    if (PriorityDistance > ZeroTolerance)
+        priority /= 1.0f + distance / PriorityDistance;
+
+    // Lower priority of the objects behind the viewer
+    if (client.HasViewDirection && distance > ZeroTolerance)
+    {
+        const float facing = Float3::Dot(Float3(toObject / distance), client.ViewDirection);
+        priority *= Math::Lerp(PriorityBehindScale, 1.0f, Math::Saturate(facing * 0.5f + 0.5f));
+    }
+
+    return priority;
+}
@@ -6,6 +6,7 @@
 #include "Engine/Core/Math/Vector3.h"
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Delegate.h"
 #include "Engine/Scripting/ScriptingObject.h"
 #include "Engine/Scripting/ScriptingObjectReference.h"
 
@@ -24,6 +25,8 @@ API_STRUCT(NoDefault, Namespace = "FlaxEngine.Networking") struct FLAXENGINE_API
     API_FIELD() float ReplicationFPS = 60;
     // The minimum distance from the player to the object at which it can process replication. For example, players further away won't receive object data. Use 0 if unused.
     API_FIELD() float CullDistance = 15000;
+    // The base priority of the object replication. Objects with higher priority are sent first when the replication data is limited by the client bandwidth budget (see NetworkReplicationHierarchy::ClientBandwidthBudget).
+    API_FIELD() float Priority = 1.0f;
     // Runtime value for update frames left for the next replication of this object. Matches NetworkManager::NetworkFPS calculated from ReplicationFPS. Set to 1 if ReplicationFPS less than 0 to indicate dirty object.
     API_FIELD(Attributes="HideInEditor") uint16 ReplicationUpdatesLeft = 0;
 
@@ -115,18 +118,23 @@ API_CLASS(Namespace = "FlaxEngine.Networking") class FLAXENGINE_API NetworkRepli
     friend class NetworkInternal;
     friend class NetworkReplicationNode;
     friend class NetworkReplicationGridNode;
+    friend class NetworkReplicationHierarchy;
 
 private:
     struct Client
     {
         bool HasLocation;
+        bool HasViewDirection;
         Vector3 Location;
+        Float3 ViewDirection;
+        int32 BandwidthBudget;
     };
 
     struct Entry
     {
         ScriptingObject* Object;
         NetworkClientsMask TargetClients;
+        float Priority;
     };
 
     bool _clientsHaveLocation;
@@ -146,6 +154,7 @@ API_CLASS(Namespace = "FlaxEngine.Networking") class FLAXENGINE_API NetworkRepli
         Entry& e = _entries.AddOne();
         e.Object = obj;
         e.TargetClients = NetworkClientsMask::All;
+        e.Priority = 1.0f;
     }
 
     // Adds object to the update results. Defines specific clients to receive the update (server-only, unused on client). Mask matches NetworkManager::Clients.
@@ -154,6 +163,16 @@ API_CLASS(Namespace = "FlaxEngine.Networking") class FLAXENGINE_API NetworkRepli
         Entry& e = _entries.AddOne();
         e.Object = obj;
         e.TargetClients = targetClients;
+        e.Priority = 1.0f;
+    }
+
+    // Adds object to the update results. Defines specific clients to receive the update (server-only, unused on client) and the base priority of the object replication. Mask matches NetworkManager::Clients.
+    API_FUNCTION() void AddObject(ScriptingObject* obj, NetworkClientsMask targetClients, float priority)
+    {
+        Entry& e = _entries.AddOne();
+        e.Object = obj;
+        e.TargetClients = targetClients;
+        e.Priority = priority;
     }
 
     // Gets amount of the clients to use. Matches NetworkManager::Clients.
@@ -173,6 +192,18 @@ API_CLASS(Namespace = "FlaxEngine.Networking") class FLAXENGINE_API NetworkRepli
 
     // Gets the viewer location for a certain client. Client index must match NetworkManager::Clients. Returns true if got a location set, otherwise false.
     API_FUNCTION() bool GetClientLocation(int32 clientIndex, API_PARAM(out) Vector3& location) const;
+
+    // Sets the viewer direction for a certain client (normalized vector). Used to prioritize objects in front of the viewer. Client index must match NetworkManager::Clients.
+    API_FUNCTION() void SetClientViewDirection(int32 clientIndex, const Float3& direction);
+
+    // Gets the viewer direction for a certain client. Client index must match NetworkManager::Clients. Returns true if got a direction set, otherwise false.
+    API_FUNCTION() bool GetClientViewDirection(int32 clientIndex, API_PARAM(out) Float3& direction) const;
+
+    // Sets the bandwidth budget (in bytes) for the objects replication data sent to a certain client within this update. Use 0 to disable limit and -1 to use NetworkReplicationHierarchy::ClientBandwidthBudget. Client index must match NetworkManager::Clients.
+    API_FUNCTION() void SetClientBandwidthBudget(int32 clientIndex, int32 bytes);
+
+    // Gets the bandwidth budget (in bytes) for the objects replication data sent to a certain client within this update. Returns -1 if uses the default budget from the hierarchy. Client index must match NetworkManager::Clients.
+    API_FUNCTION() int32 GetClientBandwidthBudget(int32 clientIndex) const;
 };
 
 /// <summary>
@@ -261,6 +292,86 @@ API_CLASS(Namespace = "FlaxEngine.Networking") class FLAXENGINE_API NetworkRepli
     void Update(NetworkReplicationHierarchyUpdateResult* result) override;
 };
 
+/// <summary>
+/// Network replication hierarchy node with incremental spatial hashing for the interest management (server-only). Tracks objects relevance for each client based on the grid cells around the client location and updates it only when objects or clients move across the cells which scales to large amounts of objects.
+/// Objects that lose relevance for a client get despawned on it and are spawned back once they become relevant again (see NetworkReplicator::SetObjectRelevance). Objects without location (eg. not attached to actor) are relevant for all clients.
+/// </summary>
+API_CLASS(Namespace = "FlaxEngine.Networking") class FLAXENGINE_API NetworkReplicationSpatialNode : public NetworkReplicationNode
+{
+    DECLARE_SCRIPTING_TYPE_WITH_CONSTRUCTOR_IMPL(NetworkReplicationSpatialNode, NetworkReplicationNode);
+
+private:
+    struct ObjectState
+    {
+        ScriptingObject* Object;
+        bool HasCell;
+        Int3 Cell;
+        NetworkClientsMask Clients;
+    };
+
+    struct ClientState
+    {
+        uint32 ClientId;
+        bool HasCell;
+        Int3 Cell;
+    };
+
+    struct RelevanceEvent
+    {
+        ScriptingObject* Object;
+        uint32 ClientId;
+        bool Relevant;
+    };
+
+    int32 _cellsRadius = -1;
+    Array<ObjectState> _objectStates;
+    Dictionary<ScriptingObject*, int32> _objectToIndex;
+    Dictionary<Int3, Array<int32>> _cells;
+    Array<ClientState> _clients;
+    Array<RelevanceEvent> _events;
+
+public:
+    /// <summary>
+    /// Size of the grid cell (in world units). Used to chunk the space for the relevance tracking.
+    /// </summary>
+    API_FIELD() float CellSize = 5000.0f;
+
+    /// <summary>
+    /// The distance (in world units) from the client location within which the objects are relevant for the client. Rounded up to the grid cells.
+    /// </summary>
+    API_FIELD() float RelevanceDistance = 15000.0f;
+
+    /// <summary>
+    /// If checked, relevance changes despawn irrelevant objects on clients and spawn them back when they become relevant (see NetworkReplicator::SetObjectRelevance). Otherwise, relevance only limits the objects replication.
+    /// </summary>
+    API_FIELD() bool UpdateSpawning = true;
+
+    /// <summary>
+    /// Event called when object becomes relevant for a client (enters the client area of interest).
+    /// </summary>
+    API_EVENT() Delegate<ScriptingObject*, NetworkClient*> ObjectEnter;
+
+    /// <summary>
+    /// Event called when object is no longer relevant for a client (leaves the client area of interest).
+    /// </summary>
+    API_EVENT() Delegate<ScriptingObject*, NetworkClient*> ObjectLeave;
+
+private:
+    Int3 GetCell(const Vector3& position) const;
+    bool IsInRange(const Int3& clientCell, const Int3& objectCell) const;
+    void SetRelevance(int32 objectIndex, int32 clientIndex, bool relevant);
+    void UpdateClients();
+    void MoveObject(int32 objectIndex, const Int3& cell);
+    void MoveClient(int32 clientIndex, const Int3& cell);
+
+public:
+    void AddObject(NetworkReplicationHierarchyObject obj) override;
+    bool RemoveObject(ScriptingObject* obj) override;
+    bool GetObject(ScriptingObject* obj, NetworkReplicationHierarchyObject& result) override;
+    bool DirtyObject(ScriptingObject* obj) override;
+    void Update(NetworkReplicationHierarchyUpdateResult* result) override;
+};
+
 /// <summary>
 /// Defines the network objects replication hierarchy (tree structure) that controls chunking and configuration of the game objects replication.
 /// Contains only 'owned' objects. It's used by the networking system only on a main thread.
@@ -268,4 +379,34 @@ API_CLASS(Namespace = "FlaxEngine.Networking") class FLAXENGINE_API NetworkRepli
 API_CLASS(Namespace = "FlaxEngine.Networking") class FLAXENGINE_API NetworkReplicationHierarchy : public NetworkReplicationNode
 {
     DECLARE_SCRIPTING_TYPE_WITH_CONSTRUCTOR_IMPL(NetworkReplicationHierarchy, NetworkReplicationNode);
+
+    /// <summary>
+    /// The bandwidth budget (in bytes) for the objects replication data sent to each client within a single network update (server-only). Objects are sent in order of their priority and the ones that don't fit accumulate priority until they get sent. Use 0 to disable limit.
+    /// </summary>
+    API_FIELD() int32 ClientBandwidthBudget = 0;
+
+    /// <summary>
+    /// The distance (in world units) from the client location at which the replication priority of the object gets halved. Use 0 to disable distance-based priority.
+    /// </summary>
+    API_FIELD() float PriorityDistance = 5000.0f;
+
+    /// <summary>
+    /// The scale of the replication priority for the objects behind the client view direction (in range 0-1).
+    /// </summary>
+    API_FIELD(Attributes="Limit(0, 1)") float PriorityBehindScale = 0.25f;
+
+    /// <summary>
+    /// The maximum amount of network updates for which the object replication to a client can be skipped due to the bandwidth budget. Objects waiting longer are sent even over the budget to prevent starvation.
+    /// </summary>
+    API_FIELD(Attributes="Limit(1)") int32 MaxStarvationUpdates = 30;
+
+    /// <summary>
+    /// Calculates the replication priority of the object for a certain client. Used to sort objects replication when it's limited by the client bandwidth budget (priority of the skipped objects is accumulated over time).
+    /// </summary>
+    /// <param name="result">The update results container.</param>
+    /// <param name="clientIndex">The client index. Matches NetworkManager::Clients.</param>
+    /// <param name="obj">The object to replicate.</param>
+    /// <param name="priority">The base priority of the object replication.</param>
+    /// <returns>The object replication priority.</returns>
+    API_FUNCTION() virtual float GetPriority(NetworkReplicationHierarchyUpdateResult* result, int32 clientIndex, ScriptingObject* obj, float priority);
 };
@@ -16,7 +16,9 @@
 #include "Engine/Core/Collections/HashSet.h"
 #include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Core/Collections/ChunkedArray.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Core/Types/DataContainer.h"
+#include "Engine/Core/Memory/FrameAllocation.h"
 #include "Engine/Platform/CriticalSection.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Level/Actor.h"
@@ -27,6 +29,7 @@
 #include "Engine/Scripting/Script.h"
 #include "Engine/Scripting/Scripting.h"
 #include "Engine/Scripting/ScriptingObjectReference.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Threading/Threading.h"
 #include "Engine/Threading/ThreadLocal.h"
 #if USE_EDITOR
@@ -43,6 +46,18 @@ bool NetworkReplicator::EnableLog = false;
 #define NETWORK_REPLICATOR_LOG(messageType, format, ...)
 #endif
 
+bool NetworkReplicator::EnableDeltaCompression = true;
+bool NetworkReplicator::EnableParallelSerialization = false;
+
+// The maximum amount of recent replication states stored per object to be used as delta compression baselines (on both sender and receiver)
+#define NETWORK_REPLICATOR_BASELINES 8
+
+// The maximum amount of pooled buffers used to reassemble multi-part replication and spawn messages
+#define NETWORK_REPLICATOR_PARTS_POOL_SIZE 32
+
+// The minimum amount of replicated objects to serialize them on Job System threads (smaller amounts are serialized on the main thread)
+#define NETWORK_REPLICATOR_JOBS_MIN_OBJECTS 32
+
 #if COMPILE_WITH_PROFILER
 bool NetworkInternal::EnableProfiling = false;
 Dictionary<Pair<ScriptingTypeHandle, StringAnsiView>, NetworkInternal::ProfilerEvent> NetworkInternal::ProfilerEvents;
@@ -55,6 +70,7 @@ PACK_STRUCT(struct NetworkMessageObjectReplicate
     Guid ObjectId; // TODO: introduce networked-ids to synchronize unique ids as ushort (less data over network)
     Guid ParentId;
     char ObjectTypeName[128]; // TODO: introduce networked-name to synchronize unique names as ushort (less data over network)
+    uint32 BaselineFrame; // Frame of the acknowledged state that data is delta-encoded against (0 if data contains the full state)
     uint16 DataSize;
     uint16 PartsCount;
     });
@@ -63,6 +79,7 @@ PACK_STRUCT(struct NetworkMessageObjectReplicatePart
     {
     NetworkMessageIDs ID = NetworkMessageIDs::ObjectReplicatePart;
     uint32 OwnerFrame;
+    uint32 BaselineFrame;
     uint16 DataSize;
     uint16 PartsCount;
     uint16 PartStart;
@@ -70,6 +87,24 @@ PACK_STRUCT(struct NetworkMessageObjectReplicatePart
     Guid ObjectId; // TODO: introduce networked-ids to synchronize unique ids as ushort (less data over network)
     });
 
+PACK_STRUCT(struct NetworkMessageObjectReplicateBatch
+    {
+    NetworkMessageIDs ID = NetworkMessageIDs::ObjectReplicateBatch;
+    uint16 ItemsCount; // Amount of NetworkMessageObjectReplicate items (each followed by its data)
+    });
+
+PACK_STRUCT(struct NetworkMessageObjectReplicateAck
+    {
+    NetworkMessageIDs ID = NetworkMessageIDs::ObjectReplicateAck;
+    uint16 ItemsCount;
+    });
+
+PACK_STRUCT(struct NetworkMessageObjectReplicateAckItem
+    {
+    Guid ObjectId; // TODO: introduce networked-ids to synchronize unique ids as ushort (less data over network)
+    uint32 OwnerFrame;
+    });
+
 PACK_STRUCT(struct NetworkMessageObjectSpawn
     {
     NetworkMessageIDs ID = NetworkMessageIDs::ObjectSpawn;
@@ -119,6 +154,31 @@ PACK_STRUCT(struct NetworkMessageObjectRpc
     uint16 ArgsSize;
     });
 
+PACK_STRUCT(struct NetworkMessageObjectRpcBatch
+    {
+    NetworkMessageIDs ID = NetworkMessageIDs::ObjectRpcBatch;
+    uint16 ItemsCount; // Amount of NetworkMessageObjectRpc items (each followed by its args data)
+    });
+
+struct ReplicationState
+{
+    uint32 Frame;
+    Array<byte> Data;
+};
+
+struct ReplicationBaseline
+{
+    uint32 ClientId;
+    uint32 Frame;
+};
+
+struct ReplicationPriority
+{
+    uint32 ClientId;
+    float Accumulated;
+    int32 StarvedUpdates;
+};
+
 struct NetworkReplicatedObject
 {
     ScriptingObjectReference<ScriptingObject> Object;
@@ -131,6 +191,11 @@ struct NetworkReplicatedObject
     uint8 Synced : 1;
     DataContainer<uint32> TargetClientIds;
     INetworkObject* AsNetworkObject;
+    Array<ReplicationState> SentStates; // Recently sent states (baselines for delta compression)
+    Array<ReplicationState> ReceivedStates; // Recently received states (baselines for delta decompression)
+    Array<ReplicationBaseline> Baselines; // The latest sent state acknowledged by each receiver
+    Array<ReplicationPriority> Priorities; // Accumulated priority of the replication skipped for each receiver due to the bandwidth budget
+    HashSet<uint32> IrrelevantClientIds; // Clients that should not receive this object (see NetworkReplicator::SetObjectRelevance)
 
     NetworkReplicatedObject()
     {
@@ -176,6 +241,7 @@ struct ReplicateItem
     Guid ObjectId;
     uint16 PartsLeft;
     uint32 OwnerFrame;
+    uint32 BaselineFrame;
     uint32 OwnerClientId;
     Array<byte> Data;
 };
@@ -207,6 +273,58 @@ struct DespawnItem
     DataContainer<uint32> Targets;
 };
 
+struct RelevanceItem
+{
+    ScriptingObjectReference<ScriptingObject> Object;
+    uint32 ClientId;
+};
+
+struct ReplicateAckItem
+{
+    Guid ObjectId;
+    uint32 OwnerFrame;
+    uint32 ClientId;
+};
+
+struct ReplicateBatch
+{
+    NetworkConnection Target;
+    NetworkMessage Message;
+    uint16 ItemsCount;
+};
+
+struct RpcBatch
+{
+    NetworkConnection Target;
+    NetworkChannelType Channel;
+    NetworkMessage Message;
+    uint16 ItemsCount;
+};
+
+struct ReplicatePacket
+{
+    uint32 BaselineFrame;
+    bool UseDelta;
+    Array<NetworkConnection> Targets;
+    Array<uint32> TargetIds;
+    Array<byte> DeltaData;
+};
+
+struct ReplicateJob
+{
+    NetworkReplicatedObject* Item;
+    ScriptingObject* Object;
+    Array<NetworkConnection> Targets;
+    Array<uint32> TargetIds;
+    Array<byte> Data;
+    uint32 OwnerFrame;
+    bool Failed;
+    float BasePriority;
+    float Priority;
+    int32 PacketsCount;
+    Array<ReplicatePacket> Packets;
+};
+
 struct RpcItem
 {
     ScriptingObjectReference<ScriptingObject> Object;
@@ -222,9 +340,13 @@ namespace
     HashSet<NetworkReplicatedObject> Objects;
     Array<ReplicateItem> ReplicationParts;
     Array<SpawnItemParts> SpawnParts;
+    Array<Array<byte>> ReplicationPartsDataPool;
+    Array<Array<NetworkMessageObjectSpawnItem>> SpawnPartsItemsPool;
     Array<SpawnItem> SpawnQueue;
     Array<DespawnItem> DespawnQueue;
+    Array<RelevanceItem> RelevanceQueue;
     Array<RpcItem> RpcQueue;
+    Array<ReplicateAckItem> ReplicateAckQueue;
     Dictionary<Guid, Guid> IdsRemappingTable;
     NetworkStream* CachedWriteStream = nullptr;
     NetworkStream* CachedReadStream = nullptr;
@@ -232,6 +354,17 @@ namespace
     NetworkReplicationHierarchy* Hierarchy = nullptr;
     Array<NetworkClient*> NewClients;
     Array<NetworkConnection> CachedTargets;
+    Array<uint32> CachedTargetIds;
+    Array<byte> CachedDeltaData;
+    Array<ReplicateBatch> ReplicateBatches;
+    Array<ReplicateJob> ReplicateJobs;
+    Array<int32> ReplicateJobsOrder;
+    Array<int32> CachedClientBudgets;
+    Dictionary<uint32, int32> CachedClientIndices;
+    ThreadLocal<NetworkStream*> CachedJobWriteStreams;
+    Dictionary<uint32, int32> ReplicateBatchesTable;
+    Array<RpcBatch> RpcBatches;
+    Dictionary<uint64, int32> RpcBatchesTable;
     Dictionary<ScriptingTypeHandle, Serializer> SerializersTable;
 #if !COMPILE_WITHOUT_CSHARP
     Dictionary<StringAnsiView, StringAnsi*> CSharpCachedNames;
@@ -392,6 +525,7 @@ void BuildCachedTargets(const Array<NetworkClient*>& clients, const NetworkClien
 void BuildCachedTargets(const Array<NetworkClient*>& clients, const DataContainer<uint32>& clientIds, const uint32 excludedClientId = NetworkManager::ServerClientId, const NetworkClientsMask clientsMask = NetworkClientsMask::All)
 {
     CachedTargets.Clear();
+    CachedTargetIds.Clear();
     if (clientIds.IsValid())
     {
         for (int32 clientIndex = 0; clientIndex < clients.Count(); clientIndex++)
@@ -404,6 +538,7 @@ void BuildCachedTargets(const Array<NetworkClient*>& clients, const DataContaine
                     if (clientIds[i] == client->ClientId)
                     {
                         CachedTargets.Add(client->Connection);
+                        CachedTargetIds.Add(client->ClientId);
                         break;
                     }
                 }
@@ -416,7 +551,10 @@ void BuildCachedTargets(const Array<NetworkClient*>& clients, const DataContaine
         {
             const NetworkClient* client = clients.Get()[clientIndex];
             if (client->State == NetworkConnectionState::Connected && client->ClientId != excludedClientId && clientsMask.HasBit(clientIndex))
+            {
                 CachedTargets.Add(client->Connection);
+                CachedTargetIds.Add(client->ClientId);
+            }
         }
     }
 }
@@ -461,10 +599,25 @@ void BuildCachedTargets(const Array<NetworkClient*>& clients, const DataContaine
     }
 }
 
+void RemoveIrrelevantCachedTargets(const NetworkReplicatedObject& item)
+{
+    if (item.IrrelevantClientIds.IsEmpty())
+        return;
+    for (int32 i = CachedTargetIds.Count() - 1; i >= 0; i--)
+    {
+        if (item.IrrelevantClientIds.Contains(CachedTargetIds[i]))
+        {
+            CachedTargets.RemoveAt(i);
+            CachedTargetIds.RemoveAt(i);
+        }
+    }
+}
+
 FORCE_INLINE void BuildCachedTargets(const NetworkReplicatedObject& item, const NetworkClientsMask clientsMask = NetworkClientsMask::All)
 {
     // By default send object to all connected clients excluding the owner but with optional TargetClientIds list
     BuildCachedTargets(NetworkManager::Clients, item.TargetClientIds, item.OwnerClientId, clientsMask);
+    RemoveIrrelevantCachedTargets(item);
 }
 
 FORCE_INLINE void GetNetworkName(char buffer[128], const StringAnsiView& name)
@@ -517,6 +670,13 @@ void SendObjectSpawnMessage(const SpawnGroup& group, const Array<NetworkClient*>
         auto it = Objects.Find(obj->GetID());
         const auto& item = it->Item;
         BuildCachedTargets(clients, item.TargetClientIds);
+        RemoveIrrelevantCachedTargets(item);
+    }
+    if (!isClient && CachedTargets.Count() == 0)
+    {
+        // Skip if none will receive it (eg. object is irrelevant for target clients)
+        peer->AbortSendMessage(msg);
+        return;
     }
 
     // Network Peer has fixed size of messages so split spawn message into parts if there are too many objects to fit at once
@@ -621,7 +781,7 @@ SceneObject* FindPrefabObject(Actor* a, const Guid& prefabObjectId)
     return result;
 }
 
-void SetupObjectSpawnGroupItem(ScriptingObject* obj, Array<SpawnGroup, InlinedAllocation<8>>& spawnGroups, SpawnItem& spawnItem)
+void SetupObjectSpawnGroupItem(ScriptingObject* obj, Array<SpawnGroup, InlinedAllocation<8, FrameAllocation>>& spawnGroups, SpawnItem& spawnItem)
 {
     // Check if can fit this object into any of the existing groups (eg. script which can be spawned with parent actor)
     SpawnGroup* group = nullptr;
@@ -695,6 +855,593 @@ FORCE_INLINE void DirtyObjectImpl(NetworkReplicatedObject& item, ScriptingObject
         Hierarchy->DirtyObject(obj);
 }
 
+void ResetReplicationBaselines(NetworkReplicatedObject& item)
+{
+    // Replication frames are counted by the object owner so all states become invalid after ownership change
+    item.SentStates.Clear();
+    item.ReceivedStates.Clear();
+    item.Baselines.Clear();
+}
+
+const ReplicationState* FindReplicationState(const Array<ReplicationState>& states, uint32 frame)
+{
+    for (const ReplicationState& e : states)
+    {
+        if (e.Frame == frame)
+            return &e;
+    }
+    return nullptr;
+}
+
+void AddReplicationState(Array<ReplicationState>& states, uint32 frame, const byte* data, uint32 size)
+{
+    if (states.Count() == NETWORK_REPLICATOR_BASELINES)
+        states.RemoveAtKeepOrder(0);
+    auto& state = states.AddOne();
+    state.Frame = frame;
+    state.Data.Set(data, (int32)size);
+}
+
+uint32 AddSentReplicationState(NetworkReplicatedObject& item, const byte* data, uint32 size)
+{
+    // Reuse the last state if object didn't change (receivers that already acknowledged it can skip replication)
+    if (item.SentStates.HasItems())
+    {
+        const ReplicationState& last = item.SentStates.Last();
+        if (last.Data.Count() == size && Platform::MemoryCompare(last.Data.Get(), data, size) == 0)
+            return last.Frame;
+    }
+    AddReplicationState(item.SentStates, NetworkManager::Frame, data, size);
+    return NetworkManager::Frame;
+}
+
+uint32 GetReplicationBaseline(const NetworkReplicatedObject& item, uint32 clientId)
+{
+    for (const ReplicationBaseline& e : item.Baselines)
+    {
+        if (e.ClientId == clientId)
+            return e.Frame;
+    }
+    return 0;
+}
+
+void SetReplicationBaseline(NetworkReplicatedObject& item, uint32 clientId, uint32 frame)
+{
+    for (ReplicationBaseline& e : item.Baselines)
+    {
+        if (e.ClientId == clientId)
+        {
+            // Skip late acknowledgments of the older states (eg. due to unordered channel usage)
+            if (e.Frame < frame)
+                e.Frame = frame;
+            return;
+        }
+    }
+    item.Baselines.Add({ clientId, frame });
+}
+
+// Encodes data against the baseline as runs of unchanged bytes (copied from the baseline) followed by the changed bytes. Returns true if delta is not smaller than the data itself.
+bool EncodeReplicationDelta(const byte* data, const byte* baseline, uint32 size, Array<byte>& output)
+{
+    const uint32 runHeaderSize = sizeof(uint16) * 2;
+    output.Clear();
+    uint32 pos = 0;
+    while (pos < size)
+    {
+        // Skip unchanged bytes
+        uint32 start = pos;
+        while (pos < size && data[pos] == baseline[pos])
+            pos++;
+        if (pos == size)
+            break; // Trailing unchanged bytes are copied from the baseline
+        const uint16 unchangedCount = (uint16)(pos - start);
+
+        // Find the end of changed bytes (include short unchanged gaps that are cheaper to send than a new run)
+        start = pos;
+        while (pos < size)
+        {
+            if (data[pos] != baseline[pos])
+            {
+                pos++;
+                continue;
+            }
+            uint32 end = pos;
+            while (end < size && end - pos < runHeaderSize && data[end] == baseline[end])
+                end++;
+            if (end == size || end - pos == runHeaderSize)
+                break;
+            pos = end;
+        }
+        const uint16 changedCount = (uint16)(pos - start);
+
+        output.Add((const byte*)&unchangedCount, sizeof(uint16));
+        output.Add((const byte*)&changedCount, sizeof(uint16));
+        output.Add(data + start, changedCount);
+        if ((uint32)output.Count() >= size)
+            return true;
+    }
+    return false;
+}
+
+// Decodes data encoded with EncodeReplicationDelta. Returns true if failed (eg. corrupted data).
+bool DecodeReplicationDelta(const byte* delta, uint32 deltaSize, const Array<byte>& baseline, Array<byte>& output)
+{
+    const uint32 runHeaderSize = sizeof(uint16) * 2;
+    const uint32 size = baseline.Count();
+    output.Set(baseline.Get(), baseline.Count());
+    uint32 pos = 0, deltaPos = 0;
+    while (deltaPos < deltaSize)
+    {
+        if (deltaPos + runHeaderSize > deltaSize)
+            return true;
+        uint16 unchangedCount, changedCount;
+        Platform::MemoryCopy(&unchangedCount, delta + deltaPos, sizeof(uint16));
+        Platform::MemoryCopy(&changedCount, delta + deltaPos + sizeof(uint16), sizeof(uint16));
+        deltaPos += runHeaderSize;
+        pos += unchangedCount;
+        if (pos + changedCount > size || deltaPos + changedCount > deltaSize)
+            return true;
+        Platform::MemoryCopy(output.Get() + pos, delta + deltaPos, changedCount);
+        pos += changedCount;
+        deltaPos += changedCount;
+    }
+    return false;
+}
+
+void AddReplicateAck(const NetworkReplicatedObject& item, uint32 ownerFrame, uint32 senderClientId)
+{
+    if (!NetworkReplicator::EnableDeltaCompression)
+        return;
+    auto& ack = ReplicateAckQueue.AddOne();
+    ack.ObjectId = item.ObjectId;
+    ack.OwnerFrame = ownerFrame;
+    ack.ClientId = senderClientId;
+}
+
+void SendObjectReplicateBatch(NetworkPeer* peer, const ReplicateBatch& batch, bool isClient)
+{
+    ((NetworkMessageObjectReplicateBatch*)batch.Message.Buffer)->ItemsCount = batch.ItemsCount;
+    if (isClient)
+        peer->EndSendMessage(NetworkChannelType::Unreliable, batch.Message);
+    else
+        peer->EndSendMessage(NetworkChannelType::Unreliable, batch.Message, batch.Target);
+}
+
+void AddObjectReplicateBatchItem(NetworkPeer* peer, const NetworkConnection& target, const NetworkMessageObjectReplicate& msgData, const byte* data, uint32 size, bool isClient)
+{
+    // Get the current batch for this target
+    ReplicateBatch* batch;
+    int32 batchIndex;
+    if (ReplicateBatchesTable.TryGet(target.ConnectionId, batchIndex))
+    {
+        batch = &ReplicateBatches[batchIndex];
+        if (batch->Message.Length + sizeof(NetworkMessageObjectReplicate) + size > batch->Message.BufferSize)
+        {
+            // Send full batch and start a new one
+            SendObjectReplicateBatch(peer, *batch, isClient);
+            batch->Message = peer->BeginSendMessage();
+            batch->Message.WriteStructure(NetworkMessageObjectReplicateBatch());
+            batch->ItemsCount = 0;
+        }
+    }
+    else
+    {
+        ReplicateBatchesTable.Add(target.ConnectionId, ReplicateBatches.Count());
+        batch = &ReplicateBatches.AddOne();
+        batch->Target = target;
+        batch->Message = peer->BeginSendMessage();
+        batch->Message.WriteStructure(NetworkMessageObjectReplicateBatch());
+        batch->ItemsCount = 0;
+    }
+
+    // Append object data
+    batch->Message.WriteStructure(msgData);
+    batch->Message.WriteBytes(data, size);
+    batch->ItemsCount++;
+}
+
+void SendObjectRpcBatch(NetworkPeer* peer, const RpcBatch& batch, bool isClient)
+{
+    ((NetworkMessageObjectRpcBatch*)batch.Message.Buffer)->ItemsCount = batch.ItemsCount;
+    if (isClient)
+        peer->EndSendMessage(batch.Channel, batch.Message);
+    else
+        peer->EndSendMessage(batch.Channel, batch.Message, batch.Target);
+}
+
+void AddObjectRpcBatchItem(NetworkPeer* peer, const NetworkConnection& target, NetworkChannelType channel, const NetworkMessageObjectRpc& msgData, const Span<byte>& args, bool isClient)
+{
+    // Get the current batch for this target and channel
+    const uint64 key = ((uint64)target.ConnectionId << 8) | (uint64)channel;
+    RpcBatch* batch;
+    int32 batchIndex;
+    if (RpcBatchesTable.TryGet(key, batchIndex))
+    {
+        batch = &RpcBatches[batchIndex];
+        if (batch->Message.Length + sizeof(NetworkMessageObjectRpc) + args.Length() > batch->Message.BufferSize)
+        {
+            // Send full batch and start a new one
+            SendObjectRpcBatch(peer, *batch, isClient);
+            batch->Message = peer->BeginSendMessage();
+            batch->Message.WriteStructure(NetworkMessageObjectRpcBatch());
+            batch->ItemsCount = 0;
+        }
+    }
+    else
+    {
+        RpcBatchesTable.Add(key, RpcBatches.Count());
+        batch = &RpcBatches.AddOne();
+        batch->Target = target;
+        batch->Channel = channel;
+        batch->Message = peer->BeginSendMessage();
+        batch->Message.WriteStructure(NetworkMessageObjectRpcBatch());
+        batch->ItemsCount = 0;
+    }
+
+    // Append RPC data
+    batch->Message.WriteStructure(msgData);
+    batch->Message.WriteBytes(args.Get(), args.Length());
+    batch->ItemsCount++;
+}
+
+void SendObjectRpcMessage(NetworkPeer* peer, ScriptingObject* obj, const NetworkReplicatedObject& item, const NetworkRpcName& name, const NetworkRpcInfo& info, const Span<byte>& args, const Span<uint32>& targetIds, bool isClient, bool batched)
+{
+    //NETWORK_REPLICATOR_LOG(Info, "[NetworkReplicator] Rpc {}::{} object ID={}", name.First.ToString(), String(name.Second), item.ToString());
+    NetworkMessageObjectRpc msgData;
+    msgData.ObjectId = item.ObjectId;
+    msgData.ParentId = item.ParentId;
+    if (isClient)
+    {
+        // Remap local client object ids into server ids
+        IdsRemappingTable.KeyOf(msgData.ObjectId, &msgData.ObjectId);
+        IdsRemappingTable.KeyOf(msgData.ParentId, &msgData.ParentId);
+    }
+    GetNetworkName(msgData.ObjectTypeName, obj->GetType().Fullname);
+    GetNetworkName(msgData.RpcTypeName, name.First.GetType().Fullname);
+    GetNetworkName(msgData.RpcName, name.Second);
+    msgData.ArgsSize = (uint16)args.Length();
+    const NetworkChannelType channel = (NetworkChannelType)info.Channel;
+    const uint32 dataSize = args.Length(), messageSize = sizeof(NetworkMessageObjectRpc) + args.Length();
+    uint32 receivers = 0;
+
+    // Pack small RPCs into batched messages (per target and channel) to reduce messages count
+    batched &= sizeof(NetworkMessageObjectRpcBatch) + messageSize <= peer->Config.MessageSize;
+    if (info.Server && isClient)
+    {
+        // Client -> Server
+#if USE_NETWORK_REPLICATOR_LOG
+        if (targetIds.Length() != 0)
+            NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Server RPC '{}::{}' called with non-empty list of targets is not supported (only server will receive it)", name.First.ToString(), name.Second.ToString());
+#endif
+        if (batched)
+        {
+            AddObjectRpcBatchItem(peer, NetworkConnection(), channel, msgData, args, isClient);
+        }
+        else
+        {
+            NetworkMessage msg = peer->BeginSendMessage();
+            msg.WriteStructure(msgData);
+            msg.WriteBytes(args.Get(), args.Length());
+            peer->EndSendMessage(channel, msg);
+        }
+        receivers = 1;
+    }
+    else if (info.Client && !isClient)
+    {
+        // Server -> Client(s)
+        BuildCachedTargets(NetworkManager::Clients, item.TargetClientIds, targetIds, NetworkManager::LocalClientId);
+        if (batched)
+        {
+            for (const NetworkConnection& target : CachedTargets)
+                AddObjectRpcBatchItem(peer, target, channel, msgData, args, isClient);
+        }
+        else if (CachedTargets.HasItems())
+        {
+            NetworkMessage msg = peer->BeginSendMessage();
+            msg.WriteStructure(msgData);
+            msg.WriteBytes(args.Get(), args.Length());
+            peer->EndSendMessage(channel, msg, CachedTargets);
+        }
+        receivers = CachedTargets.Count();
+    }
+
+#if COMPILE_WITH_PROFILER
+    // Network stats recording
+    if (NetworkInternal::EnableProfiling && receivers)
+    {
+        auto& profileEvent = NetworkInternal::ProfilerEvents[name];
+        profileEvent.Count++;
+        profileEvent.DataSize += dataSize;
+        profileEvent.MessageSize += messageSize;
+        profileEvent.Receivers += receivers;
+    }
+#endif
+}
+
+void SendObjectReplicateMessage(NetworkPeer* peer, NetworkMessageObjectReplicate& msgData, const byte* data, uint32 size, const Array<NetworkConnection>& targets, bool isClient, uint32& dataSize, uint32& messageSize)
+{
+    msgData.DataSize = size;
+    if (sizeof(NetworkMessageObjectReplicateBatch) + sizeof(NetworkMessageObjectReplicate) + size <= peer->Config.MessageSize)
+    {
+        // Pack small objects into batched messages (per target) to share the message overhead
+        msgData.PartsCount = 1;
+        for (const NetworkConnection& target : targets)
+            AddObjectReplicateBatchItem(peer, target, msgData, data, size, isClient);
+        dataSize += size;
+        messageSize += sizeof(NetworkMessageObjectReplicate) + size;
+        return;
+    }
+
+    // Send large objects in separate messages
+    const uint32 msgMaxData = peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicate);
+    const uint32 partMaxData = peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicatePart);
+    uint32 partsCount = 1;
+    uint32 dataStart = 0;
+    uint32 msgDataSize = size;
+    if (size > msgMaxData)
+    {
+        // Send msgMaxData within first message
+        msgDataSize = msgMaxData;
+        dataStart += msgMaxData;
+
+        // Send rest of the data in separate parts
+        partsCount += Math::DivideAndRoundUp(size - dataStart, partMaxData);
+    }
+    else
+        dataStart += size;
+    ASSERT(partsCount <= MAX_uint8);
+    msgData.PartsCount = partsCount;
+    NetworkMessage msg = peer->BeginSendMessage();
+    msg.WriteStructure(msgData);
+    msg.WriteBytes(data, msgDataSize);
+    dataSize += msgDataSize;
+    messageSize += msg.Length;
+    if (isClient)
+        peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
+    else
+        peer->EndSendMessage(NetworkChannelType::Unreliable, msg, targets);
+
+    // Send all other parts
+    for (uint32 partIndex = 1; partIndex < partsCount; partIndex++)
+    {
+        NetworkMessageObjectReplicatePart msgDataPart;
+        msgDataPart.OwnerFrame = msgData.OwnerFrame;
+        msgDataPart.BaselineFrame = msgData.BaselineFrame;
+        msgDataPart.ObjectId = msgData.ObjectId;
+        msgDataPart.DataSize = msgData.DataSize;
+        msgDataPart.PartsCount = msgData.PartsCount;
+        msgDataPart.PartStart = dataStart;
+        msgDataPart.PartSize = Math::Min(size - dataStart, partMaxData);
+        msg = peer->BeginSendMessage();
+        msg.WriteStructure(msgDataPart);
+        msg.WriteBytes(data + msgDataPart.PartStart, msgDataPart.PartSize);
+        messageSize += msg.Length;
+        dataSize += msgDataPart.PartSize;
+        dataStart += msgDataPart.PartSize;
+        if (isClient)
+            peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
+        else
+            peer->EndSendMessage(NetworkChannelType::Unreliable, msg, targets);
+    }
+    ASSERT_LOW_LAYER(dataStart == size);
+}
+
+void PrepareReplicateJob(int32 index)
+{
+    ReplicateJob& job = ReplicateJobs[index];
+    job.PacketsCount = 0;
+    job.Failed = job.Item == nullptr;
+    if (job.Failed)
+        return;
+    NetworkReplicatedObject& item = *job.Item;
+    ScriptingObject* obj = job.Object;
+
+    // Serialize object
+    NetworkStream*& stream = CachedJobWriteStreams.Get();
+    if (stream == nullptr)
+        stream = New<NetworkStream>();
+    stream->Initialize();
+    stream->SenderId = NetworkManager::LocalClientId;
+    Scripting::IdsMappingTable* mapping = Scripting::ObjectsLookupIdMapping.Get();
+    Scripting::ObjectsLookupIdMapping.Set(&IdsRemappingTable);
+    job.Failed = NetworkReplicator::InvokeSerializer(obj->GetTypeHandle(), obj, stream, true);
+    Scripting::ObjectsLookupIdMapping.Set(mapping);
+    if (job.Failed)
+    {
+        //NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Cannot serialize object {} of type {} (missing serialization logic)", item.ToString(), obj->GetType().ToString());
+        return;
+    }
+    const uint32 size = stream->GetPosition();
+    ASSERT(size <= MAX_uint16);
+    const byte* data = stream->GetBuffer();
+    job.Data.Set(data, (int32)size);
+
+    if (!NetworkReplicator::EnableDeltaCompression)
+    {
+        // Send full state
+        job.OwnerFrame = NetworkManager::Frame;
+        if (job.Packets.Count() == 0)
+            job.Packets.AddOne();
+        ReplicatePacket& packet = job.Packets[job.PacketsCount++];
+        packet.BaselineFrame = 0;
+        packet.UseDelta = false;
+        packet.Targets = job.Targets;
+        packet.TargetIds = job.TargetIds;
+        return;
+    }
+
+    // Send only changes against the last state acknowledged by the receivers (grouped by the same baseline)
+    job.OwnerFrame = AddSentReplicationState(item, data, size);
+    while (job.TargetIds.HasItems())
+    {
+        const uint32 baselineFrame = GetReplicationBaseline(item, job.TargetIds.Last());
+        if (job.PacketsCount == job.Packets.Count())
+            job.Packets.AddOne();
+        ReplicatePacket& packet = job.Packets[job.PacketsCount];
+        packet.Targets.Clear();
+        packet.TargetIds.Clear();
+        for (int32 i = job.TargetIds.Count() - 1; i >= 0; i--)
+        {
+            if (GetReplicationBaseline(item, job.TargetIds[i]) == baselineFrame)
+            {
+                packet.Targets.Add(job.Targets[i]);
+                packet.TargetIds.Add(job.TargetIds[i]);
+                job.Targets.RemoveAt(i);
+                job.TargetIds.RemoveAt(i);
+            }
+        }
+
+        // Skip replication if receivers already have this state
+        if (baselineFrame == job.OwnerFrame)
+            continue;
+
+        // Encode delta against the baseline or fallback to the full state (eg. baseline got evicted or delta doesn't save any data)
+        const ReplicationState* baseline = FindReplicationState(item.SentStates, baselineFrame);
+        packet.UseDelta = baseline && baseline->Data.Count() == size && !EncodeReplicationDelta(data, baseline->Data.Get(), size, packet.DeltaData);
+        packet.BaselineFrame = packet.UseDelta ? baselineFrame : 0;
+        job.PacketsCount++;
+    }
+}
+
+ReplicationPriority& GetReplicationPriority(NetworkReplicatedObject& item, uint32 clientId)
+{
+    for (ReplicationPriority& e : item.Priorities)
+    {
+        if (e.ClientId == clientId)
+            return e;
+    }
+    return item.Priorities.AddOne() = { clientId, 0.0f, 0 };
+}
+
+bool SortReplicateJobs(const int32& a, const int32& b)
+{
+    return ReplicateJobs[a].Priority > ReplicateJobs[b].Priority;
+}
+
+void ApplyReplicationBudget(int32 jobsCount)
+{
+    // Setup clients budgets for this update
+    bool hasBudget = false;
+    CachedClientBudgets.Resize(NetworkManager::Clients.Count());
+    CachedClientIndices.Clear();
+    for (int32 i = 0; i < CachedClientBudgets.Count(); i++)
+    {
+        int32 budget = CachedReplicationResult->GetClientBandwidthBudget(i);
+        if (budget < 0)
+            budget = Hierarchy->ClientBandwidthBudget;
+        CachedClientBudgets[i] = budget > 0 ? budget : MAX_int32;
+        CachedClientIndices[NetworkManager::Clients[i]->ClientId] = i;
+        hasBudget |= budget > 0;
+    }
+    if (!hasBudget)
+        return;
+    PROFILE_CPU();
+
+    // Sort objects by the highest priority among their receivers (including priority accumulated while waiting to be sent)
+    ReplicateJobsOrder.Clear();
+    for (int32 jobIndex = 0; jobIndex < jobsCount; jobIndex++)
+    {
+        ReplicateJob& job = ReplicateJobs[jobIndex];
+        if (job.Failed || job.PacketsCount == 0)
+            continue;
+        job.Priority = 0.0f;
+        for (int32 i = 0; i < job.PacketsCount; i++)
+        {
+            for (const uint32 clientId : job.Packets[i].TargetIds)
+            {
+                const int32 clientIndex = CachedClientIndices[clientId];
+                const float priority = Hierarchy->GetPriority(CachedReplicationResult, clientIndex, job.Object, job.BasePriority) + GetReplicationPriority(*job.Item, clientId).Accumulated;
+                job.Priority = Math::Max(job.Priority, priority);
+            }
+        }
+        ReplicateJobsOrder.Add(jobIndex);
+    }
+    Sorting::QuickSort(ReplicateJobsOrder.Get(), ReplicateJobsOrder.Count(), &SortReplicateJobs);
+
+    // Fill the clients bandwidth with the most important objects, the rest accumulates priority and waits for the next update
+    for (const int32 jobIndex : ReplicateJobsOrder)
+    {
+        ReplicateJob& job = ReplicateJobs[jobIndex];
+        NetworkReplicatedObject& item = *job.Item;
+        bool skipped = false;
+        for (int32 packetIndex = 0; packetIndex < job.PacketsCount; packetIndex++)
+        {
+            ReplicatePacket& packet = job.Packets[packetIndex];
+            const int32 size = (packet.UseDelta ? packet.DeltaData.Count() : job.Data.Count()) + sizeof(NetworkMessageObjectReplicate);
+            for (int32 i = packet.TargetIds.Count() - 1; i >= 0; i--)
+            {
+                const uint32 clientId = packet.TargetIds[i];
+                const int32 clientIndex = CachedClientIndices[clientId];
+                int32& budget = CachedClientBudgets[clientIndex];
+                ReplicationPriority& priority = GetReplicationPriority(item, clientId);
+                if (budget >= size || priority.StarvedUpdates >= Hierarchy->MaxStarvationUpdates)
+                {
+                    budget = Math::Max(budget - size, 0);
+                    priority.Accumulated = 0.0f;
+                    priority.StarvedUpdates = 0;
+                }
+                else
+                {
+                    priority.Accumulated += Hierarchy->GetPriority(CachedReplicationResult, clientIndex, job.Object, job.BasePriority);
+                    priority.StarvedUpdates++;
+                    packet.Targets.RemoveAt(i);
+                    packet.TargetIds.RemoveAt(i);
+                    skipped = true;
+                }
+            }
+        }
+
+        // Replicate skipped object again during the next update
+        if (skipped)
+            Hierarchy->DirtyObject(job.Object);
+    }
+}
+
+void SendObjectReplicateAckMessages(NetworkPeer* peer, bool isClient)
+{
+    const uint32 maxItems = (peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicateAck)) / sizeof(NetworkMessageObjectReplicateAckItem);
+    Array<NetworkMessageObjectReplicateAckItem, InlinedAllocation<64>> items;
+    while (ReplicateAckQueue.HasItems())
+    {
+        // Batch acknowledgments for the same sender
+        const uint32 clientId = ReplicateAckQueue.Last().ClientId;
+        items.Clear();
+        for (int32 i = ReplicateAckQueue.Count() - 1; i >= 0 && (uint32)items.Count() < maxItems; i--)
+        {
+            const ReplicateAckItem& e = ReplicateAckQueue[i];
+            if (e.ClientId != clientId)
+                continue;
+            auto& ack = items.AddOne();
+            ack.ObjectId = e.ObjectId;
+            ack.OwnerFrame = e.OwnerFrame;
+            if (isClient)
+            {
+                // Remap local client object ids into server ids
+                IdsRemappingTable.KeyOf(ack.ObjectId, &ack.ObjectId);
+            }
+            ReplicateAckQueue.RemoveAt(i);
+        }
+
+        NetworkMessageObjectReplicateAck msgData;
+        msgData.ItemsCount = items.Count();
+        NetworkMessage msg = peer->BeginSendMessage();
+        msg.WriteStructure(msgData);
+        msg.WriteBytes((const uint8*)items.Get(), items.Count() * sizeof(NetworkMessageObjectReplicateAckItem));
+        if (isClient)
+        {
+            peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
+        }
+        else
+        {
+            const NetworkClient* client = NetworkManager::GetClient(clientId);
+            if (client && client->State == NetworkConnectionState::Connected)
+                peer->EndSendMessage(NetworkChannelType::Unreliable, msg, client->Connection);
+            else
+                peer->AbortSendMessage(msg);
+        }
+    }
+}
+
 template<typename MessageType>
 ReplicateItem* AddObjectReplicateItem(NetworkEvent& event, const MessageType& msgData, uint16 partStart, uint16 partSize, uint32 senderClientId)
 {
@@ -702,7 +1449,7 @@ ReplicateItem* AddObjectReplicateItem(NetworkEvent& event, const MessageType& ms
     ReplicateItem* replicateItem = nullptr;
     for (auto& e : ReplicationParts)
     {
-        if (e.OwnerFrame == msgData.OwnerFrame && e.Data.Count() == msgData.DataSize && e.ObjectId == msgData.ObjectId)
+        if (e.OwnerFrame == msgData.OwnerFrame && e.BaselineFrame == msgData.BaselineFrame && e.Data.Count() == msgData.DataSize && e.ObjectId == msgData.ObjectId)
         {
             // Reuse
             replicateItem = &e;
@@ -716,8 +1463,15 @@ ReplicateItem* AddObjectReplicateItem(NetworkEvent& event, const MessageType& ms
         replicateItem->ObjectId = msgData.ObjectId;
         replicateItem->PartsLeft = msgData.PartsCount;
         replicateItem->OwnerFrame = msgData.OwnerFrame;
+        replicateItem->BaselineFrame = msgData.BaselineFrame;
         replicateItem->OwnerClientId = senderClientId;
-        replicateItem->Data.Resize(msgData.DataSize);
+        if (ReplicationPartsDataPool.HasItems())
+        {
+            // Reuse the reassembly buffer
+            replicateItem->Data.Swap(ReplicationPartsDataPool.Last());
+            ReplicationPartsDataPool.RemoveLast();
+        }
+        replicateItem->Data.Resize(msgData.DataSize, false);
     }
 
     // Copy part data
@@ -730,7 +1484,7 @@ ReplicateItem* AddObjectReplicateItem(NetworkEvent& event, const MessageType& ms
     return replicateItem;
 }
 
-void InvokeObjectReplication(NetworkReplicatedObject& item, uint32 ownerFrame, byte* data, uint32 dataSize, uint32 senderClientId)
+void InvokeObjectReplication(NetworkReplicatedObject& item, uint32 ownerFrame, uint32 baselineFrame, byte* data, uint32 dataSize, uint32 senderClientId)
 {
     ScriptingObject* obj = item.Object.Get();
     if (!obj)
@@ -742,8 +1496,28 @@ void InvokeObjectReplication(NetworkReplicatedObject& item, uint32 ownerFrame, b
 
     // Drop object replication if it has old data (eg. newer message was already processed due to unordered channel usage)
     if (item.LastOwnerFrame >= ownerFrame)
+    {
+        // Sender repeats the unchanged state until it gets acknowledged so resend ack in case the previous one got lost
+        if (item.LastOwnerFrame == ownerFrame)
+            AddReplicateAck(item, ownerFrame, senderClientId);
         return;
+    }
+
+    // Reconstruct the full state from the delta against the acknowledged baseline
+    if (baselineFrame != 0)
+    {
+        const ReplicationState* baseline = FindReplicationState(item.ReceivedStates, baselineFrame);
+        if (!baseline || DecodeReplicationDelta(data, dataSize, baseline->Data, CachedDeltaData))
+            return; // Sender will switch to the newer baseline (or full state) once it gets the acknowledgment
+        data = CachedDeltaData.Get();
+        dataSize = CachedDeltaData.Count();
+    }
     item.LastOwnerFrame = ownerFrame;
+    if (NetworkReplicator::EnableDeltaCompression)
+    {
+        AddReplicationState(item.ReceivedStates, ownerFrame, data, dataSize);
+        AddReplicateAck(item, ownerFrame, senderClientId);
+    }
 
     // Setup message reading stream
     if (CachedReadStream == nullptr)
@@ -1031,7 +1805,7 @@ void RPC_Execute_Managed(ScriptingObject* obj, NetworkStream* stream, void* tag)
     signature(obj, stream);
 }
 
-void NetworkReplicator::AddRPC(const ScriptingTypeHandle& typeHandle, const StringAnsiView& name, const Function<void(void*, void*)>& execute, bool isServer, bool isClient, NetworkChannelType channel)
+void NetworkReplicator::AddRPC(const ScriptingTypeHandle& typeHandle, const StringAnsiView& name, const Function<void(void*, void*)>& execute, bool isServer, bool isClient, NetworkChannelType channel, bool isImmediate)
 {
     if (!typeHandle)
         return;
@@ -1040,6 +1814,7 @@ void NetworkReplicator::AddRPC(const ScriptingTypeHandle& typeHandle, const Stri
     rpcInfo.Server = isServer;
     rpcInfo.Client = isClient;
     rpcInfo.Channel = (uint8)channel;
+    rpcInfo.Immediate = isImmediate;
     rpcInfo.Invoke = nullptr; // C# RPCs invoking happens on C# side (build-time code generation)
     rpcInfo.Execute = RPC_Execute_Managed;
     rpcInfo.Tag = (void*)*(SerializeFunc*)&execute;
@@ -1285,6 +2060,89 @@ void NetworkReplicator::DespawnObject(ScriptingObject* obj)
     DeleteNetworkObject(obj);
 }
 
+void NetworkReplicator::SetObjectRelevance(ScriptingObject* obj, uint32 clientId, bool relevant)
+{
+    if (!obj || NetworkManager::IsOffline() || NetworkManager::IsClient())
+        return;
+    ScopeLock lock(ObjectsLock);
+    const auto it = Objects.Find(obj->GetID());
+    if (it == Objects.End())
+        return;
+    auto& item = it->Item;
+    if (relevant)
+    {
+        if (!item.IrrelevantClientIds.Remove(clientId))
+            return;
+
+        // Cancel pending despawn (client still has this object)
+        for (int32 i = 0; i < DespawnQueue.Count(); i++)
+        {
+            const DespawnItem& e = DespawnQueue[i];
+            if (e.Id == item.ObjectId && e.Targets.Length() == 1 && e.Targets[0] == clientId)
+            {
+                DespawnQueue.RemoveAtKeepOrder(i);
+                return;
+            }
+        }
+
+        // Register for spawning on that client (batched during update)
+        if (item.Spawned)
+            RelevanceQueue.Add({ obj, clientId });
+    }
+    else
+    {
+        if (item.IrrelevantClientIds.Contains(clientId))
+            return;
+        item.IrrelevantClientIds.Add(clientId);
+
+        // Cancel pending spawn (client doesn't have this object yet)
+        for (int32 i = 0; i < RelevanceQueue.Count(); i++)
+        {
+            const RelevanceItem& e = RelevanceQueue[i];
+            if (e.Object == obj && e.ClientId == clientId)
+            {
+                RelevanceQueue.RemoveAt(i);
+                return;
+            }
+        }
+
+        // Register for despawning on that client (batched during update)
+        if (item.Spawned)
+        {
+            auto& despawn = DespawnQueue.AddOne();
+            despawn.Id = item.ObjectId;
+            despawn.Targets.Copy(&clientId, 1);
+        }
+
+        // Reset replication state for that client (object will be spawned from scratch)
+        for (int32 i = 0; i < item.Baselines.Count(); i++)
+        {
+            if (item.Baselines[i].ClientId == clientId)
+            {
+                item.Baselines.RemoveAt(i);
+                break;
+            }
+        }
+        for (int32 i = 0; i < item.Priorities.Count(); i++)
+        {
+            if (item.Priorities[i].ClientId == clientId)
+            {
+                item.Priorities.RemoveAt(i);
+                break;
+            }
+        }
+    }
+}
+
+bool NetworkReplicator::IsObjectRelevant(const ScriptingObject* obj, uint32 clientId)
+{
+    if (!obj)
+        return false;
+    ScopeLock lock(ObjectsLock);
+    const auto it = Objects.Find(obj->GetID());
+    return it != Objects.End() && !it->Item.IrrelevantClientIds.Contains(clientId);
+}
+
 bool NetworkReplicator::HasObject(const ScriptingObject* obj)
 {
     if (obj)
@@ -1427,6 +2285,7 @@ void NetworkReplicator::SetObjectOwnership(ScriptingObject* obj, uint32 ownerCli
                 item.OwnerClientId = ownerClientId;
                 item.LastOwnerFrame = 1;
                 item.Role = localRole;
+                ResetReplicationBaselines(item);
                 SendObjectRoleMessage(item);
             }
         }
@@ -1488,13 +2347,22 @@ bool NetworkReplicator::EndInvokeRPC(ScriptingObject* obj, const ScriptingTypeHa
     if (!info || !obj || NetworkManager::IsOffline())
         return false;
     ObjectsLock.Lock();
-    auto& rpc = RpcQueue.AddOne();
-    rpc.Object = obj;
-    rpc.Name.First = type;
-    rpc.Name.Second = name;
-    rpc.Info = *info;
-    rpc.ArgsData.Copy(Span<byte>(argsStream->GetBuffer(), argsStream->GetPosition()));
-    rpc.Targets.Copy(targetIds);
+    const auto it = info->Immediate ? Objects.Find(obj->GetID()) : Objects.End();
+    if (it != Objects.End() && it->Item.Spawned)
+    {
+        // Send latency-critical RPC right away (skips batching)
+        SendObjectRpcMessage(NetworkManager::Peer, obj, it->Item, NetworkRpcName(type, name), *info, Span<byte>(argsStream->GetBuffer(), argsStream->GetPosition()), targetIds, NetworkManager::IsClient(), false);
+    }
+    else
+    {
+        auto& rpc = RpcQueue.AddOne();
+        rpc.Object = obj;
+        rpc.Name.First = type;
+        rpc.Name.Second = name;
+        rpc.Info = *info;
+        rpc.ArgsData.Copy(Span<byte>(argsStream->GetBuffer(), argsStream->GetPosition()));
+        rpc.Targets.Copy(targetIds);
+    }
     ObjectsLock.Unlock();
 
     // Check if skip local execution (eg. server rpc called from client or client rpc with specific targets)
@@ -1525,6 +2393,23 @@ void NetworkInternal::NetworkReplicatorClientDisconnected(NetworkClient* client)
     for (auto it = Objects.Begin(); it.IsNotEnd(); ++it)
     {
         auto& item = it->Item;
+        for (int32 i = 0; i < item.Baselines.Count(); i++)
+        {
+            if (item.Baselines[i].ClientId == clientId)
+            {
+                item.Baselines.RemoveAt(i);
+                break;
+            }
+        }
+        for (int32 i = 0; i < item.Priorities.Count(); i++)
+        {
+            if (item.Priorities[i].ClientId == clientId)
+            {
+                item.Priorities.RemoveAt(i);
+                break;
+            }
+        }
+        item.IrrelevantClientIds.Remove(clientId);
         ScriptingObject* obj = item.Object.Get();
         if (obj && item.Spawned && item.OwnerClientId == clientId)
         {
@@ -1567,14 +2452,34 @@ void NetworkInternal::NetworkReplicatorClear()
     }
     Objects.Clear();
     RpcQueue.Clear();
+    RpcBatches.Clear();
+    RpcBatchesTable.Clear();
+    ReplicateAckQueue.Clear();
     SpawnQueue.Clear();
     DespawnQueue.Clear();
+    RelevanceQueue.Clear();
+    ReplicationParts.Clear();
+    SpawnParts.Clear();
+    ReplicationPartsDataPool.Clear();
+    SpawnPartsItemsPool.Clear();
     IdsRemappingTable.Clear();
     SAFE_DELETE(CachedWriteStream);
     SAFE_DELETE(CachedReadStream);
     SAFE_DELETE(CachedReplicationResult);
     NewClients.Clear();
     CachedTargets.Clear();
+    CachedTargetIds.Clear();
+    CachedDeltaData.Clear();
+    ReplicateBatches.Clear();
+    ReplicateBatchesTable.Clear();
+    ReplicateJobs.Clear();
+    ReplicateJobsOrder.Clear();
+    CachedClientBudgets.Clear();
+    CachedClientIndices.Clear();
+    Array<NetworkStream*> jobWriteStreams;
+    CachedJobWriteStreams.GetValues(jobWriteStreams);
+    jobWriteStreams.ClearDelete();
+    CachedJobWriteStreams.Clear();
     DespawnedObjects.Clear();
 }
 
@@ -1591,8 +2496,6 @@ void NetworkInternal::NetworkReplicatorUpdate()
     if (Objects.Count() == 0)
         return;
     const bool isClient = NetworkManager::IsClient();
-    const bool isServer = NetworkManager::IsServer();
-    const bool isHost = NetworkManager::IsHost();
     NetworkPeer* peer = NetworkManager::Peer;
 
     if (!isClient && NewClients.Count() != 0)
@@ -1601,7 +2504,7 @@ void NetworkInternal::NetworkReplicatorUpdate()
         PROFILE_CPU_NAMED("NewClients");
         // TODO: try iterative loop over several frames to reduce both server and client perf-spikes in case of large amount of spawned objects
         ChunkedArray<SpawnItem, 256> spawnItems;
-        Array<SpawnGroup, InlinedAllocation<8>> spawnGroups;
+        Array<SpawnGroup, InlinedAllocation<8, FrameAllocation>> spawnGroups;
         for (auto it = Objects.Begin(); it.IsNotEnd(); ++it)
         {
             auto& item = it->Item;
@@ -1653,6 +2556,51 @@ void NetworkInternal::NetworkReplicatorUpdate()
         DespawnQueue.Clear();
     }
 
+    // Spawn objects that became relevant for clients
+    if (!isClient && RelevanceQueue.Count() != 0)
+    {
+        PROFILE_CPU_NAMED("RelevanceQueue");
+        ChunkedArray<SpawnItem, 256> spawnItems;
+        Array<SpawnGroup, InlinedAllocation<8, FrameAllocation>> spawnGroups;
+        Array<NetworkClient*> targetClients;
+        while (RelevanceQueue.HasItems())
+        {
+            // Batch objects for a single client
+            const uint32 clientId = RelevanceQueue.Last().ClientId;
+            for (int32 i = RelevanceQueue.Count() - 1; i >= 0; i--)
+            {
+                const RelevanceItem& e = RelevanceQueue[i];
+                if (e.ClientId != clientId)
+                    continue;
+                ScriptingObject* obj = e.Object.Get();
+                auto it = obj ? Objects.Find(obj->GetID()) : Objects.End();
+                if (it != Objects.End() && it->Item.Spawned)
+                {
+                    auto& item = it->Item;
+                    auto& spawnItem = spawnItems.AddOne();
+                    spawnItem.Object = obj;
+                    spawnItem.Targets.Link(item.TargetClientIds);
+                    spawnItem.OwnerClientId = item.OwnerClientId;
+                    spawnItem.Role = item.Role;
+                    SetupObjectSpawnGroupItem(obj, spawnGroups, spawnItem);
+                }
+                RelevanceQueue.RemoveAt(i);
+            }
+
+            // Groups of objects to spawn
+            if (NetworkClient* client = NetworkManager::GetClient(clientId))
+            {
+                NETWORK_REPLICATOR_LOG(Info, "[NetworkReplicator] Spawn {} relevant object groups for client {}", spawnGroups.Count(), clientId);
+                targetClients.Clear();
+                targetClients.Add(client);
+                for (SpawnGroup& g : spawnGroups)
+                    SendObjectSpawnMessage(g, targetClients);
+            }
+            spawnGroups.Clear();
+            spawnItems.Clear();
+        }
+    }
+
     // Spawn
     if (SpawnQueue.Count() != 0)
     {
@@ -1680,7 +2628,7 @@ void NetworkInternal::NetworkReplicatorUpdate()
 
         // Batch spawned objects into groups (eg. player actor with scripts and child actors merged as a single spawn message)
         // That's because NetworkReplicator::SpawnObject can be called in separate for different actors/scripts of a single prefab instance but we want to spawn it at once over the network
-        Array<SpawnGroup, InlinedAllocation<8>> spawnGroups;
+        Array<SpawnGroup, InlinedAllocation<8, FrameAllocation>> spawnGroups;
         for (SpawnItem& e : SpawnQueue)
         {
             ScriptingObject* obj = e.Object.Get();
@@ -1761,14 +2709,24 @@ void NetworkInternal::NetworkReplicatorUpdate()
                     auto& item = it->Item;
 
                     // Replicate from all collected parts data
-                    InvokeObjectReplication(item, e.OwnerFrame, e.Data.Get(), e.Data.Count(), e.OwnerClientId);
+                    InvokeObjectReplication(item, e.OwnerFrame, e.BaselineFrame, e.Data.Get(), e.Data.Count(), e.OwnerClientId);
                 }
             }
 
+            // Return the reassembly buffer to the pool
+            if (ReplicationPartsDataPool.Count() < NETWORK_REPLICATOR_PARTS_POOL_SIZE)
+                ReplicationPartsDataPool.AddOne().Swap(e.Data);
             ReplicationParts.RemoveAt(i);
         }
     }
 
+    // Acknowledge received replication states so senders can use them as delta compression baselines
+    if (ReplicateAckQueue.HasItems())
+    {
+        PROFILE_CPU_NAMED("ReplicationAcks");
+        SendObjectReplicateAckMessages(peer, isClient);
+    }
+
     // TODO: remove items from SpawnParts after some TTL to reduce memory usage
 
     // Replicate all owned networked objects with other clients or server
@@ -1808,11 +2766,7 @@ void NetworkInternal::NetworkReplicatorUpdate()
     if (CachedReplicationResult->_entries.HasItems())
     {
         PROFILE_CPU_NAMED("Replication");
-        if (CachedWriteStream == nullptr)
-            CachedWriteStream = New<NetworkStream>();
-        NetworkStream* stream = CachedWriteStream;
-        stream->SenderId = NetworkManager::LocalClientId;
-        // TODO: use Job System when replicated objects count is large
+        int32 jobsCount = 0;
         for (auto& e : CachedReplicationResult->_entries)
         {
             ScriptingObject* obj = e.Object;
@@ -1832,20 +2786,60 @@ void NetworkInternal::NetworkReplicatorUpdate()
             if (item.AsNetworkObject)
                 item.AsNetworkObject->OnNetworkSerialize();
 
-            // Serialize object
-            stream->Initialize();
-            const bool failed = NetworkReplicator::InvokeSerializer(obj->GetTypeHandle(), obj, stream, true);
-            if (failed)
+            if (jobsCount == ReplicateJobs.Count())
+                ReplicateJobs.AddOne();
+            ReplicateJob& job = ReplicateJobs[jobsCount++];
+            job.Object = obj;
+            job.BasePriority = e.Priority;
+            if (isClient)
             {
-                //NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Cannot serialize object {} of type {} (missing serialization logic)", item.ToString(), obj->GetType().ToString());
-                continue;
+                NetworkConnection server;
+                server.ConnectionId = 0;
+                job.Targets.Clear();
+                job.Targets.Add(server);
+                job.TargetIds.Clear();
+                job.TargetIds.Add(NetworkManager::ServerClientId);
             }
+            else
+            {
+                job.Targets = CachedTargets;
+                job.TargetIds = CachedTargetIds;
+            }
+        }
+
+        // Serialize objects and encode per-receiver data (OnNetworkSerialize can add new objects so items are resolved after it)
+        for (int32 i = 0; i < jobsCount; i++)
+        {
+            ReplicateJob& job = ReplicateJobs[i];
+            auto it = Objects.Find(job.Object->GetID());
+            job.Item = it.IsEnd() ? nullptr : &it->Item;
+        }
+        if (NetworkReplicator::EnableParallelSerialization && jobsCount >= NETWORK_REPLICATOR_JOBS_MIN_OBJECTS)
+        {
+            Function<void(int32)> prepareJob;
+            prepareJob.Bind<PrepareReplicateJob>();
+            JobSystem::Execute(prepareJob, jobsCount);
+        }
+        else
+        {
+            for (int32 i = 0; i < jobsCount; i++)
+                PrepareReplicateJob(i);
+        }
+
+        // Limit the replication data sent to each client
+        if (!isClient && Hierarchy)
+            ApplyReplicationBudget(jobsCount);
 
-            // Send object to clients
-            const uint32 size = stream->GetPosition();
-            ASSERT(size <= MAX_uint16);
+        // Send objects to clients
+        for (int32 jobIndex = 0; jobIndex < jobsCount; jobIndex++)
+        {
+            const ReplicateJob& job = ReplicateJobs[jobIndex];
+            if (job.Failed)
+                continue;
+            const NetworkReplicatedObject& item = *job.Item;
+            ScriptingObject* obj = job.Object;
             NetworkMessageObjectReplicate msgData;
-            msgData.OwnerFrame = NetworkManager::Frame;
+            msgData.OwnerFrame = job.OwnerFrame;
             msgData.ObjectId = item.ObjectId;
             msgData.ParentId = item.ParentId;
             if (isClient)
@@ -1855,70 +2849,37 @@ void NetworkInternal::NetworkReplicatorUpdate()
                 IdsRemappingTable.KeyOf(msgData.ParentId, &msgData.ParentId);
             }
             GetNetworkName(msgData.ObjectTypeName, obj->GetType().Fullname);
-            msgData.DataSize = size;
-            const uint32 msgMaxData = peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicate);
-            const uint32 partMaxData = peer->Config.MessageSize - sizeof(NetworkMessageObjectReplicatePart);
-            uint32 partsCount = 1;
-            uint32 dataStart = 0;
-            uint32 msgDataSize = size;
-            if (size > msgMaxData)
-            {
-                // Send msgMaxData within first message
-                msgDataSize = msgMaxData;
-                dataStart += msgMaxData;
-
-                // Send rest of the data in separate parts
-                partsCount += Math::DivideAndRoundUp(size - dataStart, partMaxData);
-            }
-            else
-                dataStart += size;
-            ASSERT(partsCount <= MAX_uint8);
-            msgData.PartsCount = partsCount;
-            NetworkMessage msg = peer->BeginSendMessage();
-            msg.WriteStructure(msgData);
-            msg.WriteBytes(stream->GetBuffer(), msgDataSize);
-            uint32 dataSize = msgDataSize, messageSize = msg.Length;
-            if (isClient)
-                peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
-            else
-                peer->EndSendMessage(NetworkChannelType::Unreliable, msg, CachedTargets);
-
-            // Send all other parts
-            for (uint32 partIndex = 1; partIndex < partsCount; partIndex++)
+            uint32 dataSize = 0, messageSize = 0, receivers = 0;
+            for (int32 i = 0; i < job.PacketsCount; i++)
             {
-                NetworkMessageObjectReplicatePart msgDataPart;
-                msgDataPart.OwnerFrame = msgData.OwnerFrame;
-                msgDataPart.ObjectId = msgData.ObjectId;
-                msgDataPart.DataSize = msgData.DataSize;
-                msgDataPart.PartsCount = msgData.PartsCount;
-                msgDataPart.PartStart = dataStart;
-                msgDataPart.PartSize = Math::Min(size - dataStart, partMaxData);
-                msg = peer->BeginSendMessage();
-                msg.WriteStructure(msgDataPart);
-                msg.WriteBytes(stream->GetBuffer() + msgDataPart.PartStart, msgDataPart.PartSize);
-                messageSize += msg.Length;
-                dataSize += msgDataPart.PartSize;
-                dataStart += msgDataPart.PartSize;
-                if (isClient)
-                    peer->EndSendMessage(NetworkChannelType::Unreliable, msg);
-                else
-                    peer->EndSendMessage(NetworkChannelType::Unreliable, msg, CachedTargets);
+                const ReplicatePacket& packet = job.Packets[i];
+                if (packet.Targets.Count() == 0)
+                    continue;
+                const Array<byte>& data = packet.UseDelta ? packet.DeltaData : job.Data;
+                msgData.BaselineFrame = packet.BaselineFrame;
+                SendObjectReplicateMessage(peer, msgData, data.Get(), data.Count(), packet.Targets, isClient, dataSize, messageSize);
+                receivers += packet.Targets.Count();
             }
-            ASSERT_LOW_LAYER(dataStart == size);
 
 #if COMPILE_WITH_PROFILER
             // Network stats recording
-            if (EnableProfiling)
+            if (EnableProfiling && receivers != 0)
             {
                 const Pair<ScriptingTypeHandle, StringAnsiView> name(obj->GetTypeHandle(), StringAnsiView::Empty);
                 auto& profileEvent = ProfilerEvents[name];
                 profileEvent.Count++;
                 profileEvent.DataSize += dataSize;
                 profileEvent.MessageSize += messageSize;
-                profileEvent.Receivers += isClient ? 1 : CachedTargets.Count();
+                profileEvent.Receivers += receivers;
             }
 #endif
         }
+
+        // Send batched replication messages
+        for (const ReplicateBatch& batch : ReplicateBatches)
+            SendObjectReplicateBatch(peer, batch, isClient);
+        ReplicateBatches.Clear();
+        ReplicateBatchesTable.Clear();
     }
 
     // Invoke RPCs
@@ -1941,55 +2902,14 @@ void NetworkInternal::NetworkReplicatorUpdate()
             auto& item = it->Item;
 
             // Send RPC message
-            //NETWORK_REPLICATOR_LOG(Info, "[NetworkReplicator] Rpc {}::{} object ID={}", e.Name.First.ToString(), String(e.Name.Second), item.ToString());
-            NetworkMessageObjectRpc msgData;
-            msgData.ObjectId = item.ObjectId;
-            msgData.ParentId = item.ParentId;
-            if (isClient)
-            {
-                // Remap local client object ids into server ids
-                IdsRemappingTable.KeyOf(msgData.ObjectId, &msgData.ObjectId);
-                IdsRemappingTable.KeyOf(msgData.ParentId, &msgData.ParentId);
-            }
-            GetNetworkName(msgData.ObjectTypeName, obj->GetType().Fullname);
-            GetNetworkName(msgData.RpcTypeName, e.Name.First.GetType().Fullname);
-            GetNetworkName(msgData.RpcName, e.Name.Second);
-            msgData.ArgsSize = (uint16)e.ArgsData.Length();
-            NetworkMessage msg = peer->BeginSendMessage();
-            msg.WriteStructure(msgData);
-            msg.WriteBytes(e.ArgsData.Get(), e.ArgsData.Length());
-            uint32 dataSize = e.ArgsData.Length(), messageSize = msg.Length, receivers = 0;
-            NetworkChannelType channel = (NetworkChannelType)e.Info.Channel;
-            if (e.Info.Server && isClient)
-            {
-                // Client -> Server
-#if USE_NETWORK_REPLICATOR_LOG
-                if (e.Targets.Length() != 0)
-                    NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Server RPC '{}::{}' called with non-empty list of targets is not supported (only server will receive it)", e.Name.First.ToString(), e.Name.Second.ToString());
-#endif
-                peer->EndSendMessage(channel, msg);
-                receivers = 1;
-            }
-            else if (e.Info.Client && (isServer || isHost))
-            {
-                // Server -> Client(s)
-                BuildCachedTargets(NetworkManager::Clients, item.TargetClientIds, e.Targets, NetworkManager::LocalClientId);
-                peer->EndSendMessage(channel, msg, CachedTargets);
-                receivers = CachedTargets.Count();
-            }
-
-#if COMPILE_WITH_PROFILER
-            // Network stats recording
-            if (EnableProfiling && receivers)
-            {
-                auto& profileEvent = ProfilerEvents[e.Name];
-                profileEvent.Count++;
-                profileEvent.DataSize += dataSize;
-                profileEvent.MessageSize += messageSize;
-                profileEvent.Receivers += receivers;
-            }
-#endif
+            SendObjectRpcMessage(peer, obj, item, e.Name, e.Info, Span<byte>(e.ArgsData.Get(), e.ArgsData.Length()), e.Targets, isClient, true);
         }
+
+        // Send batched RPC messages
+        for (const RpcBatch& batch : RpcBatches)
+            SendObjectRpcBatch(peer, batch, isClient);
+        RpcBatches.Clear();
+        RpcBatchesTable.Clear();
         RpcQueue.Clear();
     }
 
@@ -1997,12 +2917,8 @@ void NetworkInternal::NetworkReplicatorUpdate()
     Scripting::ObjectsLookupIdMapping.Set(nullptr);
 }
 
-void NetworkInternal::OnNetworkMessageObjectReplicate(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
+void ProcessObjectReplicate(const NetworkMessageObjectReplicate& msgData, NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
 {
-    PROFILE_CPU();
-    NetworkMessageObjectReplicate msgData;
-    event.Message.ReadStructure(msgData);
-    ScopeLock lock(ObjectsLock);
     if (DespawnedObjects.Contains(msgData.ObjectId))
         return; // Skip replicating not-existing objects
     NetworkReplicatedObject* e = ResolveObject(msgData.ObjectId, msgData.ParentId, msgData.ObjectTypeName);
@@ -2018,7 +2934,7 @@ void NetworkInternal::OnNetworkMessageObjectReplicate(NetworkEvent& event, Netwo
     if (msgData.PartsCount == 1)
     {
         // Replicate
-        InvokeObjectReplication(item, msgData.OwnerFrame, event.Message.Buffer + event.Message.Position, msgData.DataSize, senderClientId);
+        InvokeObjectReplication(item, msgData.OwnerFrame, msgData.BaselineFrame, event.Message.Buffer + event.Message.Position, msgData.DataSize, senderClientId);
     }
     else
     {
@@ -2029,6 +2945,33 @@ void NetworkInternal::OnNetworkMessageObjectReplicate(NetworkEvent& event, Netwo
     }
 }
 
+void NetworkInternal::OnNetworkMessageObjectReplicate(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
+{
+    PROFILE_CPU();
+    NetworkMessageObjectReplicate msgData;
+    event.Message.ReadStructure(msgData);
+    ScopeLock lock(ObjectsLock);
+    ProcessObjectReplicate(msgData, event, client, peer);
+}
+
+void NetworkInternal::OnNetworkMessageObjectReplicateBatch(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
+{
+    PROFILE_CPU();
+    NetworkMessageObjectReplicateBatch msgData;
+    event.Message.ReadStructure(msgData);
+    ScopeLock lock(ObjectsLock);
+    for (uint16 i = 0; i < msgData.ItemsCount; i++)
+    {
+        NetworkMessageObjectReplicate msgDataItem;
+        event.Message.ReadStructure(msgDataItem);
+        const uint32 dataEnd = event.Message.Position + msgDataItem.DataSize;
+        if (msgDataItem.PartsCount != 1 || dataEnd > event.Message.Length)
+            break; // Invalid data
+        ProcessObjectReplicate(msgDataItem, event, client, peer);
+        event.Message.Position = dataEnd;
+    }
+}
+
 void NetworkInternal::OnNetworkMessageObjectReplicatePart(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
 {
     PROFILE_CPU();
@@ -2042,6 +2985,23 @@ void NetworkInternal::OnNetworkMessageObjectReplicatePart(NetworkEvent& event, N
     AddObjectReplicateItem(event, msgData, msgData.PartStart, msgData.PartSize, senderClientId);
 }
 
+void NetworkInternal::OnNetworkMessageObjectReplicateAck(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
+{
+    PROFILE_CPU();
+    NetworkMessageObjectReplicateAck msgData;
+    event.Message.ReadStructure(msgData);
+    ScopeLock lock(ObjectsLock);
+    const uint32 senderClientId = client ? client->ClientId : NetworkManager::ServerClientId;
+    for (uint16 i = 0; i < msgData.ItemsCount; i++)
+    {
+        NetworkMessageObjectReplicateAckItem msgDataItem;
+        event.Message.ReadStructure(msgDataItem);
+        NetworkReplicatedObject* e = ResolveObject(msgDataItem.ObjectId);
+        if (e)
+            SetReplicationBaseline(*e, senderClientId, msgDataItem.OwnerFrame);
+    }
+}
+
 void NetworkInternal::OnNetworkMessageObjectSpawn(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
 {
     PROFILE_CPU();
@@ -2054,7 +3014,13 @@ void NetworkInternal::OnNetworkMessageObjectSpawn(NetworkEvent& event, NetworkCl
         // Allocate spawn message parts collecting
         auto& parts = SpawnParts.AddOne();
         parts.MsgData = msgData;
-        parts.Items.Resize(msgData.ItemsCount);
+        if (SpawnPartsItemsPool.HasItems())
+        {
+            // Reuse the reassembly buffer
+            parts.Items.Swap(SpawnPartsItemsPool.Last());
+            SpawnPartsItemsPool.RemoveLast();
+        }
+        parts.Items.Resize(msgData.ItemsCount, false);
         for (auto& item : parts.Items)
             item.ObjectId = Guid::Empty; // Mark as not yet received
     }
@@ -2100,6 +3066,8 @@ void NetworkInternal::OnNetworkMessageObjectSpawnPart(NetworkEvent& event, Netwo
             return;
     }
     InvokeObjectSpawn(spawnParts.MsgData, spawnParts.Items.Get());
+    if (SpawnPartsItemsPool.Count() < NETWORK_REPLICATOR_PARTS_POOL_SIZE)
+        SpawnPartsItemsPool.AddOne().Swap(spawnParts.Items);
     SpawnParts.RemoveAt(spawnPartsIndex);
 }
 
@@ -2156,6 +3124,8 @@ void NetworkInternal::OnNetworkMessageObjectRole(NetworkEvent& event, NetworkCli
             return;
 
         // Update
+        if (item.OwnerClientId != msgData.OwnerClientId)
+            ResetReplicationBaselines(item);
         item.OwnerClientId = msgData.OwnerClientId;
         item.LastOwnerFrame = 1;
         if (item.OwnerClientId == NetworkManager::LocalClientId)
@@ -2185,13 +3155,8 @@ void NetworkInternal::OnNetworkMessageObjectRole(NetworkEvent& event, NetworkCli
     }
 }
 
-void NetworkInternal::OnNetworkMessageObjectRpc(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
+void ProcessObjectRpc(const NetworkMessageObjectRpc& msgData, NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
 {
-    PROFILE_CPU();
-    NetworkMessageObjectRpc msgData;
-    event.Message.ReadStructure(msgData);
-    ScopeLock lock(ObjectsLock);
-
     // Find RPC info
     NetworkRpcName name;
     name.First = Scripting::FindScriptingType(msgData.RpcTypeName);
@@ -2239,3 +3204,30 @@ void NetworkInternal::OnNetworkMessageObjectRpc(NetworkEvent& event, NetworkClie
         NETWORK_REPLICATOR_LOG(Error, "[NetworkReplicator] Unknown object {} RPC {}::{}", msgData.ObjectId, String(msgData.RpcTypeName), String(msgData.RpcName));
     }
 }
+
+void NetworkInternal::OnNetworkMessageObjectRpc(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
+{
+    PROFILE_CPU();
+    NetworkMessageObjectRpc msgData;
+    event.Message.ReadStructure(msgData);
+    ScopeLock lock(ObjectsLock);
+    ProcessObjectRpc(msgData, event, client, peer);
+}
+
+void NetworkInternal::OnNetworkMessageObjectRpcBatch(NetworkEvent& event, NetworkClient* client, NetworkPeer* peer)
+{
+    PROFILE_CPU();
+    NetworkMessageObjectRpcBatch msgData;
+    event.Message.ReadStructure(msgData);
+    ScopeLock lock(ObjectsLock);
+    for (uint16 i = 0; i < msgData.ItemsCount; i++)
+    {
+        NetworkMessageObjectRpc msgDataItem;
+        event.Message.ReadStructure(msgDataItem);
+        const uint32 dataEnd = event.Message.Position + msgDataItem.ArgsSize;
+        if (dataEnd > event.Message.Length)
+            break; // Invalid data
+        ProcessObjectRpc(msgDataItem, event, client, peer);
+        event.Message.Position = dataEnd;
+    }
+}
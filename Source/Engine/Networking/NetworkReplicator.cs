@@ -136,8 +136,9 @@ public static bool EndInvokeRPC(Object obj, Type type, string name, NetworkStrea
         /// <param name="isServer">Server RPC.</param>
         /// <param name="isClient">Client RPC.</param>
         /// <param name="channel">Network channel to use for RPC transport.</param>
+        /// <param name="isImmediate">Immediate RPC (sent right away without batching).</param>
         [Unmanaged]
-        public static unsafe void AddRPC(Type type, string name, ExecuteRPCFunc execute, bool isServer = true, bool isClient = false, NetworkChannelType channel = NetworkChannelType.ReliableOrdered)
+        public static unsafe void AddRPC(Type type, string name, ExecuteRPCFunc execute, bool isServer = true, bool isClient = false, NetworkChannelType channel = NetworkChannelType.ReliableOrdered, bool isImmediate = false)
         {
             if (!typeof(FlaxEngine.Object).IsAssignableFrom(type))
                 throw new ArgumentException("Not supported type for RPC. Only FlaxEngine.Object types are valid.");
@@ -153,7 +154,7 @@ public static unsafe void AddRPC(Type type, string name, ExecuteRPCFunc execute,
             // Store the reference to prevent garbage collection
             _managedExecuteRpcFuncs.Add(execute);
 
-            Internal_AddRPC(type, name, Marshal.GetFunctionPointerForDelegate(execute), isServer, isClient, channel);
+            Internal_AddRPC(type, name, Marshal.GetFunctionPointerForDelegate(execute), isServer, isClient, channel, isImmediate);
         }
     }
 }
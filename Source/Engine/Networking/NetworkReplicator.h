@@ -42,6 +42,16 @@ API_CLASS(static, Namespace = "FlaxEngine.Networking") class FLAXENGINE_API Netw
     API_FIELD() static bool EnableLog;
 #endif
 
+    /// <summary>
+    /// Enables delta compression of the objects replication. Replicated data is encoded against the last state acknowledged by each receiver which greatly reduces the bandwidth usage for the objects that change only a bit (or not at all) between replication ticks.
+    /// </summary>
+    API_FIELD() static bool EnableDeltaCompression;
+
+    /// <summary>
+    /// Enables serialization of the replicated objects on Job System threads when replicating a large amount of objects (sending is still performed on the main thread). Requires custom serializers to be thread-safe (eg. they cannot access the NetworkReplicator state or the other objects that are modified during replication).
+    /// </summary>
+    API_FIELD() static bool EnableParallelSerialization;
+
     /// <summary>
     /// Gets the network replication hierarchy.
     /// </summary>
@@ -110,6 +120,23 @@ API_CLASS(static, Namespace = "FlaxEngine.Networking") class FLAXENGINE_API Netw
     /// <param name="obj">The object to despawn on other clients.</param>
     API_FUNCTION() static void DespawnObject(ScriptingObject* obj);
 
+    /// <summary>
+    /// Sets the object relevance for a certain client (server-only). Irrelevant objects are not replicated and get despawned on that client, then they are spawned back once they become relevant again. Used by the interest management (eg. NetworkReplicationSpatialNode) to limit the objects existing on each client.
+    /// </summary>
+    /// <remarks>Objects are relevant for all clients by default.</remarks>
+    /// <param name="obj">The network object.</param>
+    /// <param name="clientId">The network client ID.</param>
+    /// <param name="relevant">True if object is relevant for the client, otherwise false.</param>
+    API_FUNCTION() static void SetObjectRelevance(ScriptingObject* obj, uint32 clientId, bool relevant);
+
+    /// <summary>
+    /// Checks if the object is relevant for a certain client (see SetObjectRelevance).
+    /// </summary>
+    /// <param name="obj">The network object.</param>
+    /// <param name="clientId">The network client ID.</param>
+    /// <returns>True if object is relevant for the client, otherwise false.</returns>
+    API_FUNCTION() static bool IsObjectRelevant(const ScriptingObject* obj, uint32 clientId);
+
     /// <summary>
     /// Checks if the network object is spawned or added to the network replication system.
     /// </summary>
@@ -208,7 +235,7 @@ API_CLASS(static, Namespace = "FlaxEngine.Networking") class FLAXENGINE_API Netw
 private:
 #if !COMPILE_WITHOUT_CSHARP
     API_FUNCTION(NoProxy) static void AddSerializer(const ScriptingTypeHandle& typeHandle, const Function<void(void*, void*)>& serialize, const Function<void(void*, void*)>& deserialize);
-    API_FUNCTION(NoProxy) static void AddRPC(const ScriptingTypeHandle& typeHandle, const StringAnsiView& name, const Function<void(void*, void*)>& execute, bool isServer, bool isClient, NetworkChannelType channel);
+    API_FUNCTION(NoProxy) static void AddRPC(const ScriptingTypeHandle& typeHandle, const StringAnsiView& name, const Function<void(void*, void*)>& execute, bool isServer, bool isClient, NetworkChannelType channel, bool isImmediate);
     API_FUNCTION(NoProxy) static bool CSharpEndInvokeRPC(ScriptingObject* obj, const ScriptingTypeHandle& type, const StringAnsiView& name, NetworkStream* argsStream, MArray* targetIds);
     static StringAnsiView GetCSharpCachedName(const StringAnsiView& name);
 #endif
@@ -40,6 +40,7 @@ struct FLAXENGINE_API NetworkRpcInfo
     uint8 Server : 1;
     uint8 Client : 1;
     uint8 Channel : 4;
+    uint8 Immediate : 1; // True if RPC is sent right away when invoked (latency-critical), otherwise it's queued and batched with other RPCs at the end of the network update
     void (*Execute)(ScriptingObject* obj, NetworkStream* stream, void* tag);
     bool (*Invoke)(ScriptingObject* obj, void** args);
     void* Tag;
@@ -2,6 +2,7 @@
 
 #include "NetworkStream.h"
 #include "INetworkSerializable.h"
+#include "Engine/Core/Math/Math.h"
 
 NetworkStream::NetworkStream(const SpawnParams& params)
     : ScriptingObject(params)
@@ -37,6 +38,7 @@ void NetworkStream::Initialize(uint32 minCapacity)
 
     // Reset pointer to the start
     _position = _buffer;
+    _bitPosition = 0;
 }
 
 void NetworkStream::Initialize(byte* buffer, uint32 length)
@@ -45,9 +47,248 @@ void NetworkStream::Initialize(byte* buffer, uint32 length)
         Allocator::Free(_buffer);
     _position = _buffer = buffer;
     _length = length;
+    _bitPosition = 0;
     _allocated = false;
 }
 
+void NetworkStream::WriteBits(uint32 value, int32 bits)
+{
+    ASSERT(bits >= 0 && bits <= 32);
+    while (bits > 0)
+    {
+        // Start a new byte
+        if (_bitPosition == 0)
+        {
+            const byte zero = 0;
+            WriteBytes(&zero, 1);
+        }
+
+        // Pack bits into the last byte
+        const int32 count = Math::Min(bits, 8 - _bitPosition);
+        _position[-1] |= (byte)((value & ((1u << count) - 1)) << _bitPosition);
+        value >>= count;
+        bits -= count;
+        _bitPosition = (_bitPosition + count) & 7;
+    }
+}
+
+uint32 NetworkStream::ReadBits(int32 bits)
+{
+    ASSERT(bits >= 0 && bits <= 32);
+    uint32 value = 0;
+    int32 offset = 0;
+    while (offset < bits)
+    {
+        // Move to the next byte
+        if (_bitPosition == 0)
+        {
+            ASSERT(GetLength() - GetPosition() >= 1);
+            _position++;
+        }
+
+        // Unpack bits from the last byte
+        const int32 count = Math::Min(bits - offset, 8 - _bitPosition);
+        value |= (uint32)((_position[-1] >> _bitPosition) & ((1u << count) - 1)) << offset;
+        offset += count;
+        _bitPosition = (_bitPosition + count) & 7;
+    }
+    return value;
+}
+
+void NetworkStream::WriteVarUInt32(uint32 value)
+{
+    byte data[5];
+    int32 size = 0;
+    while (value >= 0x80)
+    {
+        data[size++] = (byte)(value | 0x80);
+        value >>= 7;
+    }
+    data[size++] = (byte)value;
+    WriteBytes(data, size);
+}
+
+uint32 NetworkStream::ReadVarUInt32()
+{
+    uint32 value = 0;
+    for (int32 shift = 0; shift < 35; shift += 7)
+    {
+        byte data;
+        ReadBytes(&data, 1);
+        value |= (uint32)(data & 0x7f) << shift;
+        if ((data & 0x80) == 0)
+            break;
+    }
+    return value;
+}
+
+void NetworkStream::WriteVarInt32(int32 value)
+{
+    WriteVarUInt32(((uint32)value << 1) ^ (uint32)(value >> 31));
+}
+
+int32 NetworkStream::ReadVarInt32()
+{
+    const uint32 value = ReadVarUInt32();
+    return (int32)(value >> 1) ^ -(int32)(value & 1);
+}
+
+void NetworkStream::WriteVarUInt64(uint64 value)
+{
+    byte data[10];
+    int32 size = 0;
+    while (value >= 0x80)
+    {
+        data[size++] = (byte)(value | 0x80);
+        value >>= 7;
+    }
+    data[size++] = (byte)value;
+    WriteBytes(data, size);
+}
+
+uint64 NetworkStream::ReadVarUInt64()
+{
+    uint64 value = 0;
+    for (int32 shift = 0; shift < 70; shift += 7)
+    {
+        byte data;
+        ReadBytes(&data, 1);
+        value |= (uint64)(data & 0x7f) << shift;
+        if ((data & 0x80) == 0)
+            break;
+    }
+    return value;
+}
+
+void NetworkStream::WriteVarInt64(int64 value)
+{
+    WriteVarUInt64(((uint64)value << 1) ^ (uint64)(value >> 63));
+}
+
+int64 NetworkStream::ReadVarInt64()
+{
+    const uint64 value = ReadVarUInt64();
+    return (int64)(value >> 1) ^ -(int64)(value & 1);
+}
+
+void NetworkStream::WriteFloatQuantized(float value, float min, float max, int32 bits)
+{
+    ASSERT(bits > 0 && bits <= 32 && max > min);
+    const uint32 maxValue = bits == 32 ? MAX_uint32 : (1u << bits) - 1;
+    const double alpha = Math::Saturate((value - min) / (max - min));
+    WriteBits((uint32)(alpha * maxValue + 0.5), bits);
+}
+
+float NetworkStream::ReadFloatQuantized(float min, float max, int32 bits)
+{
+    ASSERT(bits > 0 && bits <= 32 && max > min);
+    const uint32 maxValue = bits == 32 ? MAX_uint32 : (1u << bits) - 1;
+    const double alpha = (double)ReadBits(bits) / maxValue;
+    return (float)(min + alpha * (max - min));
+}
+
+void NetworkStream::WriteFloat3Quantized(const Float3& value, float min, float max, int32 bits)
+{
+    WriteFloatQuantized(value.X, min, max, bits);
+    WriteFloatQuantized(value.Y, min, max, bits);
+    WriteFloatQuantized(value.Z, min, max, bits);
+}
+
+Float3 NetworkStream::ReadFloat3Quantized(float min, float max, int32 bits)
+{
+    Float3 value;
+    value.X = ReadFloatQuantized(min, max, bits);
+    value.Y = ReadFloatQuantized(min, max, bits);
+    value.Z = ReadFloatQuantized(min, max, bits);
+    return value;
+}
+
+void NetworkStream::WriteFloatPrecision(float value, float precision)
+{
+    ASSERT(precision > 0.0f);
+    const double steps = Math::Clamp<double>(floor((double)value / precision + 0.5), MIN_int32, MAX_int32);
+    WriteVarInt32((int32)steps);
+}
+
+float NetworkStream::ReadFloatPrecision(float precision)
+{
+    return (float)((double)ReadVarInt32() * precision);
+}
+
+void NetworkStream::WriteFloat3Precision(const Float3& value, float precision)
+{
+    WriteFloatPrecision(value.X, precision);
+    WriteFloatPrecision(value.Y, precision);
+    WriteFloatPrecision(value.Z, precision);
+}
+
+Float3 NetworkStream::ReadFloat3Precision(float precision)
+{
+    Float3 value;
+    value.X = ReadFloatPrecision(precision);
+    value.Y = ReadFloatPrecision(precision);
+    value.Z = ReadFloatPrecision(precision);
+    return value;
+}
+
+void NetworkStream::WriteVector3Precision(const Vector3& value, float precision)
+{
+    ASSERT(precision > 0.0f);
+    for (int32 i = 0; i < 3; i++)
+    {
+        const double steps = Math::Clamp<double>(floor((double)value.Raw[i] / precision + 0.5), MIN_int32, MAX_int32);
+        WriteVarInt32((int32)steps);
+    }
+}
+
+Vector3 NetworkStream::ReadVector3Precision(float precision)
+{
+    Vector3 value;
+    for (int32 i = 0; i < 3; i++)
+        value.Raw[i] = (Real)((double)ReadVarInt32() * precision);
+    return value;
+}
+
+void NetworkStream::WriteQuaternionQuantized(const Quaternion& value, int32 bits)
+{
+    ASSERT(bits >= 2 && bits <= 32);
+
+    // Find the largest component (it's reconstructed from the other ones)
+    int32 largest = 0;
+    for (int32 i = 1; i < 4; i++)
+    {
+        if (Math::Abs(value.Raw[i]) > Math::Abs(value.Raw[largest]))
+            largest = i;
+    }
+
+    // Use positive largest component (q and -q represent the same rotation) so the other components are within [-1/sqrt(2), 1/sqrt(2)] range
+    const float sign = value.Raw[largest] < 0.0f ? -1.0f : 1.0f;
+    WriteBits(largest, 2);
+    for (int32 i = 0; i < 4; i++)
+    {
+        if (i != largest)
+            WriteFloatQuantized(value.Raw[i] * sign, -0.70710678f, 0.70710678f, bits);
+    }
+}
+
+Quaternion NetworkStream::ReadQuaternionQuantized(int32 bits)
+{
+    ASSERT(bits >= 2 && bits <= 32);
+    Quaternion value;
+    const int32 largest = ReadBits(2);
+    float sum = 0.0f;
+    for (int32 i = 0; i < 4; i++)
+    {
+        if (i != largest)
+        {
+            value.Raw[i] = ReadFloatQuantized(-0.70710678f, 0.70710678f, bits);
+            sum += value.Raw[i] * value.Raw[i];
+        }
+    }
+    value.Raw[largest] = Math::Sqrt(Math::Max(1.0f - sum, 0.0f));
+    return value;
+}
+
 void NetworkStream::Read(INetworkSerializable& obj)
 {
     obj.Deserialize(this);
@@ -79,6 +320,7 @@ void NetworkStream::Close()
         Allocator::Free(_buffer);
     _position = _buffer = nullptr;
     _length = 0;
+    _bitPosition = 0;
     _allocated = false;
 }
 
@@ -96,10 +338,12 @@ void NetworkStream::SetPosition(uint32 seek)
 {
     ASSERT(_length > 0);
     _position = _buffer + seek;
+    _bitPosition = 0;
 }
 
 void NetworkStream::ReadBytes(void* data, uint32 bytes)
 {
+    _bitPosition = 0;
     if (bytes > 0)
     {
         ASSERT(data && GetLength() - GetPosition() >= bytes);
@@ -112,6 +356,7 @@ void NetworkStream::WriteBytes(const void* data, uint32 bytes)
 {
     // Calculate current position
     const uint32 position = GetPosition();
+    _bitPosition = 0;
 
     // Check if there is need to update a buffer size
     if (_length - position < bytes)
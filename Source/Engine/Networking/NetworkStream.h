@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Engine/Scripting/ScriptingObject.h"
+#include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Math/Quaternion.h"
 #include "Engine/Serialization/ReadStream.h"
 #include "Engine/Serialization/WriteStream.h"
 
@@ -18,6 +20,7 @@ API_CLASS(sealed, Namespace = "FlaxEngine.Networking") class FLAXENGINE_API Netw
     byte* _buffer = nullptr;
     byte* _position = nullptr;
     uint32 _length = 0;
+    int32 _bitPosition = 0;
     bool _allocated = false;
 
 public:
@@ -69,6 +72,160 @@ API_CLASS(sealed, Namespace = "FlaxEngine.Networking") class FLAXENGINE_API Netw
         ReadBytes(data, bytes);
     }
 
+    /// <summary>
+    /// Writes the lowest bits of the value to the stream. Consecutive bit writes are packed together, any byte write starts at the next full byte.
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    /// <param name="bits">The amount of bits to write (0-32).</param>
+    API_FUNCTION() void WriteBits(uint32 value, int32 bits);
+
+    /// <summary>
+    /// Reads the bits from the stream (written with WriteBits).
+    /// </summary>
+    /// <param name="bits">The amount of bits to read (0-32).</param>
+    /// <returns>The value.</returns>
+    API_FUNCTION() uint32 ReadBits(int32 bits);
+
+    /// <summary>
+    /// Writes the unsigned integer using variable-length encoding (7 bits per byte, small values use less bytes).
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    API_FUNCTION() void WriteVarUInt32(uint32 value);
+
+    /// <summary>
+    /// Reads the unsigned integer written with WriteVarUInt32.
+    /// </summary>
+    /// <returns>The value.</returns>
+    API_FUNCTION() uint32 ReadVarUInt32();
+
+    /// <summary>
+    /// Writes the signed integer using variable-length encoding (zig-zag encoded so small negative values use less bytes too).
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    API_FUNCTION() void WriteVarInt32(int32 value);
+
+    /// <summary>
+    /// Reads the signed integer written with WriteVarInt32.
+    /// </summary>
+    /// <returns>The value.</returns>
+    API_FUNCTION() int32 ReadVarInt32();
+
+    /// <summary>
+    /// Writes the unsigned 64-bit integer using variable-length encoding (7 bits per byte, small values use less bytes).
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    API_FUNCTION() void WriteVarUInt64(uint64 value);
+
+    /// <summary>
+    /// Reads the unsigned 64-bit integer written with WriteVarUInt64.
+    /// </summary>
+    /// <returns>The value.</returns>
+    API_FUNCTION() uint64 ReadVarUInt64();
+
+    /// <summary>
+    /// Writes the signed 64-bit integer using variable-length encoding (zig-zag encoded so small negative values use less bytes too).
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    API_FUNCTION() void WriteVarInt64(int64 value);
+
+    /// <summary>
+    /// Reads the signed 64-bit integer written with WriteVarInt64.
+    /// </summary>
+    /// <returns>The value.</returns>
+    API_FUNCTION() int64 ReadVarInt64();
+
+    /// <summary>
+    /// Writes the float value quantized within the range using the specified amount of bits.
+    /// </summary>
+    /// <param name="value">The value to write. Clamped to the range.</param>
+    /// <param name="min">The minimum value of the range.</param>
+    /// <param name="max">The maximum value of the range.</param>
+    /// <param name="bits">The amount of bits to use (1-32).</param>
+    API_FUNCTION() void WriteFloatQuantized(float value, float min, float max, int32 bits);
+
+    /// <summary>
+    /// Reads the float value written with WriteFloatQuantized.
+    /// </summary>
+    /// <param name="min">The minimum value of the range.</param>
+    /// <param name="max">The maximum value of the range.</param>
+    /// <param name="bits">The amount of bits to use (1-32).</param>
+    /// <returns>The value.</returns>
+    API_FUNCTION() float ReadFloatQuantized(float min, float max, int32 bits);
+
+    /// <summary>
+    /// Writes the vector quantized within the range (per-component) using the specified amount of bits for each component.
+    /// </summary>
+    /// <param name="value">The value to write. Clamped to the range.</param>
+    /// <param name="min">The minimum value of the range.</param>
+    /// <param name="max">The maximum value of the range.</param>
+    /// <param name="bits">The amount of bits to use per component (1-32).</param>
+    API_FUNCTION() void WriteFloat3Quantized(const Float3& value, float min, float max, int32 bits);
+
+    /// <summary>
+    /// Reads the vector written with WriteFloat3Quantized.
+    /// </summary>
+    /// <param name="min">The minimum value of the range.</param>
+    /// <param name="max">The maximum value of the range.</param>
+    /// <param name="bits">The amount of bits to use per component (1-32).</param>
+    /// <returns>The value.</returns>
+    API_FUNCTION() Float3 ReadFloat3Quantized(float min, float max, int32 bits);
+
+    /// <summary>
+    /// Writes the float value quantized to the given precision (as variable-length integer so the range is not limited and small values use less bytes).
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    /// <param name="precision">The quantization step (eg. 0.01 to keep 2 decimal places).</param>
+    API_FUNCTION() void WriteFloatPrecision(float value, float precision);
+
+    /// <summary>
+    /// Reads the float value written with WriteFloatPrecision.
+    /// </summary>
+    /// <param name="precision">The quantization step (eg. 0.01 to keep 2 decimal places).</param>
+    /// <returns>The value.</returns>
+    API_FUNCTION() float ReadFloatPrecision(float precision);
+
+    /// <summary>
+    /// Writes the vector quantized to the given precision (per-component, as variable-length integers).
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    /// <param name="precision">The quantization step (eg. 0.01 to keep 2 decimal places).</param>
+    API_FUNCTION() void WriteFloat3Precision(const Float3& value, float precision);
+
+    /// <summary>
+    /// Reads the vector written with WriteFloat3Precision.
+    /// </summary>
+    /// <param name="precision">The quantization step (eg. 0.01 to keep 2 decimal places).</param>
+    /// <returns>The value.</returns>
+    API_FUNCTION() Float3 ReadFloat3Precision(float precision);
+
+    /// <summary>
+    /// Writes the vector quantized to the given precision (per-component, as variable-length integers).
+    /// </summary>
+    /// <param name="value">The value to write.</param>
+    /// <param name="precision">The quantization step (eg. 0.01 to keep 2 decimal places).</param>
+    API_FUNCTION() void WriteVector3Precision(const Vector3& value, float precision);
+
+    /// <summary>
+    /// Reads the vector written with WriteVector3Precision.
+    /// </summary>
+    /// <param name="precision">The quantization step (eg. 0.01 to keep 2 decimal places).</param>
+    /// <returns>The value.</returns>
+    API_FUNCTION() Vector3 ReadVector3Precision(float precision);
+
+    /// <summary>
+    /// Writes the rotation using smallest-three encoding: index of the largest component (2 bits) and the other three components quantized using the specified amount of bits.
+    /// </summary>
+    /// <param name="value">The value to write. Should be normalized.</param>
+    /// <param name="bits">The amount of bits to use per component (2-32).</param>
+    API_FUNCTION() void WriteQuaternionQuantized(const Quaternion& value, int32 bits = 10);
+
+    /// <summary>
+    /// Reads the rotation written with WriteQuaternionQuantized.
+    /// </summary>
+    /// <param name="bits">The amount of bits to use per component (2-32).</param>
+    /// <returns>The value.</returns>
+    API_FUNCTION() Quaternion ReadQuaternionQuantized(int32 bits = 10);
+
     using ReadStream::Read;
     void Read(INetworkSerializable& obj);
     void Read(INetworkSerializable* obj);
@@ -1,7 +1,9 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
 #include "ParticleEmitterGraph.CPU.h"
-#include "Engine/Core/Random.h"
+#include "ParticleEmitterGraph.CPU.Simd.h"
+#include "Engine/Particles/ParticleEffect.h"
+#include "Engine/Renderer/GlobalSignDistanceFieldPass.h"
 #include "Engine/Utilities/Noise.h"
 #include "Engine/Core/Types/CommonValue.h"
 
@@ -11,10 +13,11 @@
 // ReSharper disable CppClangTidyCppcoreguidelinesMacroUsage
 // ReSharper disable CppClangTidyClangDiagnosticOldStyleCast
 
-#define RAND Random::Rand()
-#define RAND2 Float2(RAND, RAND)
-#define RAND3 Float3(RAND, RAND, RAND)
-#define RAND4 Float4(RAND, RAND, RAND, RAND)
+// Random numbers come from the emitter instance stream to keep the simulation deterministic (braced initialization enforces the left-to-right evaluation order)
+#define RAND context.Random.Rand()
+#define RAND2 Float2{ RAND, RAND }
+#define RAND3 Float3{ RAND, RAND, RAND }
+#define RAND4 Float4{ RAND, RAND, RAND, RAND }
 
 // Enable to insert CPU profiler events for particles modules
 #define PARTICLE_EMITTER_MODULES_PROFILE 0
@@ -55,8 +58,7 @@ int32 ParticleEmitterGraphCPUExecutor::ProcessSpawnModule(int32 index)
     auto& context = *Context.Get();
     auto& data = context.Data->SpawnModulesData[index];
 
-    // Accumulate the previous frame fraction
-    float spawnCount = data.SpawnCounter;
+    float spawnCount = 0.0f;
 
     // Calculate particles to spawn during this frame
     switch (node->TypeID)
@@ -109,8 +111,10 @@ int32 ParticleEmitterGraphCPUExecutor::ProcessSpawnModule(int32 index)
     }
     }
 
+    // Scale spawn rate by the effect simulation detail level and accumulate the previous frame fraction
+    spawnCount = Math::Max(data.SpawnCounter + spawnCount * context.Effect->GetSpawnRateScale(), 0.0f);
+
     // Calculate actual spawn amount
-    spawnCount = Math::Max(spawnCount, 0.0f);
     const int32 result = Math::FloorToInt(spawnCount);
     spawnCount -= (float)result;
     data.SpawnCounter = spawnCount;
@@ -192,11 +196,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         PARTICLE_EMITTER_MODULE("Update Age");
         auto& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
         byte* agePtr = start + attribute.Offset;
-        for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
-        {
-            *((float*)agePtr) += context.DeltaTime;
-            agePtr += stride;
-        }
+        ParticlesSimd::Add1(agePtr, stride, particlesEnd - particlesStart, context.DeltaTime);
         break;
     }
     // Gravity/Force
@@ -220,11 +220,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         else
         {
             const Float3 force = (Float3)GetValue(box, 2);
-            for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
-            {
-                *((Float3*)velocityPtr) += force * context.DeltaTime;
-                velocityPtr += stride;
-            }
+            ParticlesSimd::Add3(velocityPtr, stride, particlesEnd - particlesStart, force * context.DeltaTime);
         }
         break;
     }
@@ -466,6 +462,11 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
                 LOGIC();
             }
         }
+        else if (!useSpriteSize)
+        {
+            INPUTS_FETCH();
+            ParticlesSimd::LinearDrag(velocityPtr, massPtr, stride, particlesEnd - particlesStart, drag * context.DeltaTime);
+        }
         else
         {
             INPUTS_FETCH();
@@ -550,13 +551,17 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         ValueType type(GetVariantType(attribute.ValueType));
         if (node->UsePerParticleDataResolve())
         {
-            Value value;
-            for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
+            // Evaluate the compiled input expression for the particles in batches
+            if (!TryExecuteProgram(box, particlesStart, particlesEnd, dataPtr, stride, attribute.ValueType))
             {
-                context.ParticleIndex = particleIndex;
-                value = GetValue(box, 4).Cast(type);
-                Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
-                dataPtr += stride;
+                Value value;
+                for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
+                {
+                    context.ParticleIndex = particleIndex;
+                    value = GetValue(box, 4).Cast(type);
+                    Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
+                    dataPtr += stride;
+                }
             }
         }
         else
@@ -608,13 +613,17 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
         ValueType type(GetVariantType(attribute.ValueType));
         if (node->UsePerParticleDataResolve())
         {
-            Value value;
-            for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
+            // Evaluate the compiled input expression for the particles in batches
+            if (!TryExecuteProgram(box, particlesStart, particlesEnd, dataPtr, stride, attribute.ValueType))
             {
-                context.ParticleIndex = particleIndex;
-                value = GetValue(box, 2).Cast(type);
-                Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
-                dataPtr += stride;
+                Value value;
+                for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
+                {
+                    context.ParticleIndex = particleIndex;
+                    value = GetValue(box, 2).Cast(type);
+                    Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
+                    dataPtr += stride;
+                }
             }
         }
         else
@@ -1412,13 +1421,140 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
     // Conform to Global SDF
     case 335:
     {
-        // Not supported
+        PARTICLE_EMITTER_MODULE("Conform to Global SDF");
+        auto& positionAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
+        auto& velocityAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[1]];
+        auto& massAttr = context.Data->Buffer->Layout->Attributes[node->Attributes[2]];
+        byte* positionPtr = start + positionAttr.Offset;
+        byte* velocityPtr = start + velocityAttr.Offset;
+        byte* massPtr = start + massAttr.Offset;
+        auto attractionSpeedBox = node->GetBox(0);
+        auto attractionForceBox = node->GetBox(1);
+        auto stickDistanceBox = node->GetBox(2);
+        auto stickForceBox = node->GetBox(3);
+        const bool isLocal = context.Emitter->SimulationSpace == ParticlesSimulationSpace::Local;
+        Matrix world = Matrix::Identity;
+        if (isLocal)
+            context.Effect->GetLocalToWorldMatrix(world);
+        const auto& sdf = GlobalSignDistanceFieldPass::Instance()->LockCPUData();
+        if (sdf.Resolution == 0)
+        {
+            GlobalSignDistanceFieldPass::Instance()->UnlockCPUData();
+            break;
+        }
+#define INPUTS_FETCH() \
+	const float attractionSpeed = (float)GetValue(attractionSpeedBox, 2); \
+	const float attractionForce = (float)GetValue(attractionForceBox, 3); \
+	const float stickDistance = (float)GetValue(stickDistanceBox, 4); \
+	const float stickForce = (float)GetValue(stickForceBox, 5)
+#define LOGIC() \
+	Float3 position = *(Float3*)positionPtr; \
+	if (isLocal) \
+		position = Float3::Transform(position, world); \
+	float dist; \
+	if (sdf.Sample(position, dist)) \
+	{ \
+		Float3 dir = Float3::Normalize(sdf.SampleGradient(position)); \
+		if (dist > 0) \
+			dir *= -1; \
+		if (isLocal) \
+		{ \
+			Float3::TransformNormal(dir, world, dir); \
+			dir.Normalize(); \
+		} \
+		Float3& velocity = *(Float3*)velocityPtr; \
+		float spdNormal = Float3::Dot(dir, velocity); \
+		float ratio = Math::SmoothStep(0.0f, stickDistance * 2.0f, Math::Abs(dist)); \
+		float deltaSpeed = attractionSpeed * ratio - spdNormal; \
+		velocity += dir * (Math::Sign(deltaSpeed) * Math::Min(Math::Abs(deltaSpeed), context.DeltaTime * Math::Lerp(stickForce, attractionForce, ratio)) / Math::Max(*(float*)massPtr, ZeroTolerance)); \
+	} \
+	positionPtr += stride; \
+	velocityPtr += stride; \
+	massPtr += stride
+
+        if (node->UsePerParticleDataResolve())
+        {
+            for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
+            {
+                context.ParticleIndex = particleIndex;
+                INPUTS_FETCH();
+                LOGIC();
+            }
+        }
+        else
+        {
+            INPUTS_FETCH();
+            for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
+            {
+                LOGIC();
+            }
+        }
+#undef INPUTS_FETCH
+#undef LOGIC
+        GlobalSignDistanceFieldPass::Instance()->UnlockCPUData();
         break;
     }
     // Collision (Global SDF)
     case 336:
     {
-        // Not supported
+        COLLISION_BEGIN();
+        const bool isLocal = context.Emitter->SimulationSpace == ParticlesSimulationSpace::Local;
+        Matrix world = Matrix::Identity, invWorld = Matrix::Identity;
+        if (isLocal)
+        {
+            context.Effect->GetLocalToWorldMatrix(world);
+            Matrix::Invert(world, invWorld);
+        }
+        const auto& sdf = GlobalSignDistanceFieldPass::Instance()->LockCPUData();
+        if (sdf.Resolution == 0)
+        {
+            GlobalSignDistanceFieldPass::Instance()->UnlockCPUData();
+            break;
+        }
+#define INPUTS_FETCH() \
+	COLLISION_INPUTS_FETCH()
+#define LOGIC() \
+	Float3 position = *(Float3*)positionPtr; \
+	Float3 velocity = *(Float3*)velocityPtr; \
+	Float3 nextPos = position + velocity * context.DeltaTime; \
+	if (isLocal) \
+		nextPos = Float3::Transform(nextPos, world); \
+	float dist; \
+	if (sdf.Sample(nextPos, dist) && dist < radius) \
+	{ \
+		if (isLocal) \
+			position = Float3::Transform(position, world); \
+		Float3 n = Float3::Normalize(sdf.SampleGradient(position)); \
+		position += n * -dist; \
+		if (isLocal) \
+		{ \
+			position = Float3::Transform(position, invWorld); \
+			Float3::TransformNormal(n, invWorld, n); \
+			n.Normalize(); \
+		} \
+		*(Float3*)positionPtr = position; \
+	COLLISION_LOGIC()
+
+        if (node->UsePerParticleDataResolve())
+        {
+            for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
+            {
+                context.ParticleIndex = particleIndex;
+                INPUTS_FETCH();
+                LOGIC();
+            }
+        }
+        else
+        {
+            INPUTS_FETCH();
+            for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
+            {
+                LOGIC();
+            }
+        }
+#undef INPUTS_FETCH
+#undef LOGIC
+        GlobalSignDistanceFieldPass::Instance()->UnlockCPUData();
         break;
     }
 
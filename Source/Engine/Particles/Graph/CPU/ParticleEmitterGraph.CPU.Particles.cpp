@@ -452,6 +452,54 @@ void ParticleEmitterGraphCPUExecutor::ProcessGroupParticles(Box* box, Node* node
         context.GraphStack.Pop();
         break;
     }
+    // Random Float
+    case 208:
+        value = context.Random.Rand();
+        break;
+    // Random Vector2
+    case 209:
+        value = Float2{ context.Random.Rand(), context.Random.Rand() };
+        break;
+    // Random Vector3
+    case 210:
+        value = Float3{ context.Random.Rand(), context.Random.Rand(), context.Random.Rand() };
+        break;
+    // Random Vector4
+    case 211:
+        value = Float4{ context.Random.Rand(), context.Random.Rand(), context.Random.Rand(), context.Random.Rand() };
+        break;
+    // Random Float Range
+    case 213:
+    {
+        auto a = (float)tryGetValue(node->TryGetBox(1), node->Values[0]);
+        auto b = (float)tryGetValue(node->TryGetBox(2), node->Values[1]);
+        value = Math::Lerp(a, b, context.Random.Rand());
+        break;
+    }
+    // Random Vector2 Range
+    case 214:
+    {
+        auto a = (Float2)tryGetValue(node->TryGetBox(1), node->Values[0]);
+        auto b = (Float2)tryGetValue(node->TryGetBox(2), node->Values[1]);
+        value = a + (b - a) * Float2{ context.Random.Rand(), context.Random.Rand() };
+        break;
+    }
+    // Random Vector3 Range
+    case 215:
+    {
+        auto a = (Float3)tryGetValue(node->TryGetBox(1), node->Values[0]);
+        auto b = (Float3)tryGetValue(node->TryGetBox(2), node->Values[1]);
+        value = a + (b - a) * Float3{ context.Random.Rand(), context.Random.Rand(), context.Random.Rand() };
+        break;
+    }
+    // Random Vector4 Range
+    case 216:
+    {
+        auto a = (Float4)tryGetValue(node->TryGetBox(1), node->Values[0]);
+        auto b = (Float4)tryGetValue(node->TryGetBox(2), node->Values[1]);
+        value = a + (b - a) * Float4{ context.Random.Rand(), context.Random.Rand(), context.Random.Rand(), context.Random.Rand() };
+        break;
+    }
     // Particle Index
     case 301:
         value = context.ParticleIndex;
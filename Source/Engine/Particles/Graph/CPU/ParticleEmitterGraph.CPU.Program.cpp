@@ -0,0 +1,505 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "ParticleEmitterGraph.CPU.h"
+#include "Engine/Core/Types/Pair.h"
+#include "Engine/Core/Collections/Dictionary.h"
+
+namespace
+{
+    int32 GetComponents(VariantType::Types type)
+    {
+        switch (type)
+        {
+        case VariantType::Float:
+            return 1;
+        case VariantType::Float2:
+            return 2;
+        case VariantType::Float3:
+            return 3;
+        case VariantType::Float4:
+        case VariantType::Color:
+            return 4;
+        default:
+            return 0;
+        }
+    }
+
+    VariantType::Types GetAttributeType(ParticleAttribute::ValueTypes type)
+    {
+        switch (type)
+        {
+        case ParticleAttribute::ValueTypes::Float:
+            return VariantType::Float;
+        case ParticleAttribute::ValueTypes::Float2:
+            return VariantType::Float2;
+        case ParticleAttribute::ValueTypes::Float3:
+            return VariantType::Float3;
+        case ParticleAttribute::ValueTypes::Float4:
+            return VariantType::Float4;
+        default:
+            return VariantType::Null;
+        }
+    }
+
+    struct ProgramCompiler
+    {
+        typedef ParticleEmitterGraphCPUProgram::OpCode OpCode;
+        typedef ParticleEmitterGraphCPUProgram::Instruction Instruction;
+
+        ParticleEmitterGraphCPU* Graph;
+        ParticleEmitterGraphCPUProgram* Program;
+        Dictionary<ParticleEmitterGraphCPUBox*, Pair<int32, VariantType::Types>> Registers;
+
+        int32 Emit(OpCode op, VariantType::Types type, int32 a = 0, int32 b = 0)
+        {
+            if (Program->Instructions.Count() >= PARTICLE_EMITTER_PROGRAM_MAX_INSTRUCTIONS)
+                return -1;
+            auto& e = Program->Instructions.AddOne();
+            e.Op = op;
+            e.A = (byte)a;
+            e.B = (byte)b;
+            e.Components = (byte)GetComponents(type);
+            e.Constant = Float4::Zero;
+            return Program->Instructions.Count() - 1;
+        }
+
+        int32 CompileConstant(const Variant& value, VariantType::Types& type)
+        {
+            type = value.Type.Type;
+            if (GetComponents(type) == 0)
+                return -1;
+            const int32 result = Emit(OpCode::Constant, type);
+            if (result != -1)
+                Program->Instructions[result].Constant = type == VariantType::Float ? Float4(value.AsFloat) : (Float4)value;
+            return result;
+        }
+
+        int32 CompileComponent(int32 a, int32 component, VariantType::Types& type)
+        {
+            type = VariantType::Float;
+            const int32 result = a != -1 ? Emit(OpCode::Component, type, a) : -1;
+            if (result != -1)
+                Program->Instructions[result].ComponentIndex = component;
+            return result;
+        }
+
+        // Matches the Variant cast between float and vector types (scalar is broadcasted, vector is truncated to its first component)
+        int32 CompileCast(int32 a, VariantType::Types typeA, VariantType::Types type)
+        {
+            if (a == -1 || typeA == type)
+                return a;
+            const int32 componentsA = GetComponents(typeA);
+            const int32 components = GetComponents(type);
+            if (componentsA == components)
+                return a;
+            VariantType::Types tmp;
+            if (components == 1)
+                return CompileComponent(a, 0, tmp);
+            if (componentsA == 1)
+                return Emit(OpCode::Broadcast, type, a);
+            return -1;
+        }
+
+        // Matches VisjectExecutor::tryGetValue behavior (connected box value, or the node value at the given index, or the default value)
+        int32 CompileInput(ParticleEmitterGraphCPUBox* box, int32 defaultValueIndex, VariantType::Types& type)
+        {
+            if (box == nullptr)
+                return -1;
+            if (box->HasConnection())
+                return CompileBox((ParticleEmitterGraphCPUBox*)box->FirstConnection(), type);
+            const auto node = box->GetParent<ParticleEmitterGraphCPUNode>();
+            if (defaultValueIndex >= 0 && node->Values.Count() > defaultValueIndex)
+                return CompileConstant(node->Values[defaultValueIndex], type);
+            return -1;
+        }
+
+        int32 CompileAttribute(ParticleEmitterGraphCPUNode* node, VariantType::Types attributeType, VariantType::Types& type)
+        {
+            type = attributeType;
+            const int32 result = Emit(OpCode::Attribute, type);
+            if (result != -1)
+                Program->Instructions[result].Attributes[0] = (byte)node->Attributes[0];
+            return result;
+        }
+
+        int32 CompileBox(ParticleEmitterGraphCPUBox* box, VariantType::Types& type)
+        {
+            // Reuse already compiled values (eg. attribute used by many nodes)
+            Pair<int32, VariantType::Types> cached;
+            if (Registers.TryGet(box, cached))
+            {
+                type = cached.Second;
+                return cached.First;
+            }
+            type = VariantType::Null;
+            const auto node = box->GetParent<ParticleEmitterGraphCPUNode>();
+            int32 result = -1;
+            switch (node->GroupID)
+            {
+            // Constants
+            case 2:
+                switch (node->TypeID)
+                {
+                case 3:
+                    result = CompileConstant(node->Values[0], type);
+                    break;
+                // Float2/3/4, Color
+                case 4:
+                case 5:
+                case 6:
+                case 7:
+                    result = CompileConstant(node->Values[0], type);
+                    if (box->ID != 0)
+                        result = box->ID <= GetComponents(type) ? CompileComponent(result, box->ID - 1, type) : -1;
+                    break;
+                // PI
+                case 10:
+                    result = CompileConstant(Variant(PI), type);
+                    break;
+                }
+                break;
+            // Math
+            case 3:
+            {
+                OpCode op;
+                int32 inputs = 1;
+                switch (node->TypeID)
+                {
+#define CASE(id, opCode, inputsCount) case id: op = OpCode::opCode; inputs = inputsCount; break
+                CASE(1, Add, 2);
+                CASE(2, Subtract, 2);
+                CASE(3, Multiply, 2);
+                CASE(5, Divide, 2);
+                CASE(21, Max, 2);
+                CASE(22, Min, 2);
+                CASE(23, Pow, 2);
+                CASE(40, Mod, 2);
+                CASE(41, Atan2, 2);
+                CASE(7, Abs, 1);
+                CASE(8, Ceil, 1);
+                CASE(9, Cos, 1);
+                CASE(10, Floor, 1);
+                CASE(11, Length, 1);
+                CASE(12, Normalize, 1);
+                CASE(13, Round, 1);
+                CASE(14, Saturate, 1);
+                CASE(15, Sin, 1);
+                CASE(16, Sqrt, 1);
+                CASE(17, Tan, 1);
+                CASE(27, Negate, 1);
+                CASE(28, OneMinus, 1);
+                CASE(33, Asin, 1);
+                CASE(34, Acos, 1);
+                CASE(35, Atan, 1);
+                CASE(38, Trunc, 1);
+                CASE(39, Frac, 1);
+                CASE(43, Degrees, 1);
+                CASE(44, Radians, 1);
+#undef CASE
+                default:
+                    return -1;
+                }
+                if (inputs == 2)
+                {
+                    // The unconnected input is casted to the type of the other one
+                    VariantType::Types typeA, typeB;
+                    const auto boxA = node->GetBox(0);
+                    int32 a = CompileInput(boxA, 0, typeA);
+                    int32 b = CompileInput(node->GetBox(1), 1, typeB);
+                    if (a == -1 || b == -1)
+                        return -1;
+                    type = boxA->HasConnection() ? typeA : typeB;
+                    a = CompileCast(a, typeA, type);
+                    b = CompileCast(b, typeB, type);
+                    if (a == -1 || b == -1)
+                        return -1;
+                    result = Emit(op, type, a, b);
+                }
+                else
+                {
+                    // Unconnected input uses integer zero
+                    const auto input = node->GetBox(0);
+                    VariantType::Types typeA;
+                    const int32 a = input && input->HasConnection() ? CompileBox((ParticleEmitterGraphCPUBox*)input->FirstConnection(), typeA) : -1;
+                    if (a == -1)
+                        return -1;
+                    type = typeA;
+                    if (op == OpCode::Length)
+                    {
+                        if (typeA == VariantType::Float)
+                            return -1;
+                        type = VariantType::Float;
+                    }
+                    else if (op == OpCode::Normalize)
+                    {
+                        if (typeA == VariantType::Float)
+                            op = OpCode::Saturate;
+                        else if (typeA == VariantType::Color)
+                            return -1;
+                    }
+                    result = Emit(op, type, a);
+                    if (result != -1 && op == OpCode::Length)
+                        Program->Instructions[result].Components = (byte)GetComponents(typeA);
+                }
+                break;
+            }
+            // Parameters
+            case 6:
+                if (node->TypeID == 2)
+                {
+                    int32 paramIndex;
+                    const auto param = Graph->GetParameter((Guid)node->Values[0], paramIndex);
+                    if (param && GetComponents(param->Type.Type) != 0)
+                    {
+                        type = param->Type.Type;
+                        result = Emit(OpCode::Parameter, type);
+                        if (result != -1)
+                            Program->Instructions[result].ParameterIndex = paramIndex;
+                        if (box->ID != 0)
+                            result = type != VariantType::Float && box->ID <= GetComponents(type) ? CompileComponent(result, box->ID - 1, type) : -1;
+                    }
+                }
+                break;
+            // Particles
+            case 14:
+                switch (node->TypeID)
+                {
+                // Particle Attribute
+                case 100:
+                {
+                    const VariantType::Types attributeType = GetAttributeType((ParticleAttribute::ValueTypes)node->Attributes[1]);
+                    if (attributeType != VariantType::Null)
+                        result = CompileAttribute(node, attributeType, type);
+                    break;
+                }
+                // Particle Lifetime, Age, Mass, Radius
+                case 102:
+                case 103:
+                case 107:
+                case 111:
+                    result = CompileAttribute(node, VariantType::Float, type);
+                    break;
+                // Particle Sprite Size
+                case 106:
+                    result = CompileAttribute(node, VariantType::Float2, type);
+                    break;
+                // Particle Position, Velocity, Rotation, Angular Velocity, Scale
+                case 101:
+                case 105:
+                case 108:
+                case 109:
+                case 112:
+                    result = CompileAttribute(node, VariantType::Float3, type);
+                    break;
+                // Particle Color
+                case 104:
+                    result = CompileAttribute(node, VariantType::Float4, type);
+                    break;
+                // Particle Normalized Age
+                case 110:
+                    type = VariantType::Float;
+                    result = Emit(OpCode::NormalizedAge, type);
+                    if (result != -1)
+                    {
+                        Program->Instructions[result].Attributes[0] = (byte)node->Attributes[0];
+                        Program->Instructions[result].Attributes[1] = (byte)node->Attributes[1];
+                    }
+                    break;
+                }
+                break;
+            default:
+                break;
+            }
+            if (result != -1)
+                Registers.Add(box, ToPair(result, type));
+            return result;
+        }
+    };
+}
+
+void ParticleEmitterGraphCPU::CompilePrograms()
+{
+    ProgramCompiler compiler;
+    compiler.Graph = this;
+    const auto compileModules = [&compiler, this](const Array<Node*, FixedAllocation<PARTICLE_EMITTER_MAX_MODULES>>& modules)
+    {
+        // Compile the values used by the modules inputs (only nodes reachable from the modules are initialized)
+        for (Node* module : modules)
+        {
+            for (Box& input : module->Boxes)
+            {
+                auto box = input.HasConnection() ? (Box*)input.FirstConnection() : nullptr;
+                if (!box || box->Program)
+                    continue;
+                auto program = New<ParticleEmitterGraphCPUProgram>();
+                compiler.Program = program;
+                compiler.Registers.Clear();
+                VariantType::Types type;
+                if (compiler.CompileBox(box, type) != -1 && program->Instructions.HasItems())
+                {
+                    program->ResultType = type;
+                    box->Program = program;
+                    Programs.Add(program);
+                }
+                else
+                {
+                    Delete(program);
+                }
+            }
+        }
+    };
+    compileModules(SpawnModules);
+    compileModules(InitModules);
+    compileModules(UpdateModules);
+}
+
+void ParticleEmitterGraphCPUExecutor::ExecuteProgram(const ParticleEmitterGraphCPUProgram& program, int32 particlesStart, int32 particlesCount, Float4* output)
+{
+    typedef ParticleEmitterGraphCPUProgram::OpCode OpCode;
+    ASSERT(particlesCount <= PARTICLE_EMITTER_PROGRAM_BATCH_SIZE);
+    Float4 registers[PARTICLE_EMITTER_PROGRAM_MAX_INSTRUCTIONS][PARTICLE_EMITTER_PROGRAM_BATCH_SIZE];
+    auto& context = *Context.Get();
+    const auto buffer = context.Data->Buffer;
+    const auto* instructions = program.Instructions.Get();
+    const int32 count = program.Instructions.Count();
+    for (int32 i = 0; i < count; i++)
+    {
+        const auto& e = instructions[i];
+        Float4* r = registers[i];
+        const Float4* a = registers[e.A];
+        const Float4* b = registers[e.B];
+#define FOR_EACH(expression) for (int32 j = 0; j < particlesCount; j++) { expression; } break
+#define OP1(func) FOR_EACH(r[j] = Float4(func(a[j].X), func(a[j].Y), func(a[j].Z), func(a[j].W)))
+#define OP2(func) FOR_EACH(r[j] = Float4(func(a[j].X, b[j].X), func(a[j].Y, b[j].Y), func(a[j].Z, b[j].Z), func(a[j].W, b[j].W)))
+        switch (e.Op)
+        {
+        case OpCode::Constant:
+            FOR_EACH(r[j] = e.Constant);
+        case OpCode::Parameter:
+        {
+            const Variant& value = context.Data->Parameters[e.ParameterIndex];
+            const Float4 v = e.Components == 1 ? Float4((float)value) : (Float4)value;
+            FOR_EACH(r[j] = v);
+        }
+        case OpCode::Attribute:
+        {
+            const byte* ptr = buffer->GetParticleCPU(particlesStart) + buffer->Layout->Attributes[context.AttributesRemappingTable[e.Attributes[0]]].Offset;
+            const int32 stride = buffer->Stride;
+            const int32 size = e.Components * sizeof(float);
+            FOR_EACH(r[j] = Float4::Zero; Platform::MemoryCopy(&r[j], ptr + j * stride, size));
+        }
+        case OpCode::NormalizedAge:
+        {
+            const byte* particles = buffer->GetParticleCPU(particlesStart);
+            const auto& attributes = buffer->Layout->Attributes;
+            const int32 stride = buffer->Stride;
+            const byte* agePtr = particles + attributes[context.AttributesRemappingTable[e.Attributes[0]]].Offset;
+            const byte* lifetimePtr = particles + attributes[context.AttributesRemappingTable[e.Attributes[1]]].Offset;
+            FOR_EACH(r[j] = Float4(*(const float*)(agePtr + j * stride) / Math::Max(*(const float*)(lifetimePtr + j * stride), ZeroTolerance)));
+        }
+        case OpCode::Component:
+            FOR_EACH(r[j] = Float4(a[j].Raw[e.ComponentIndex]));
+        case OpCode::Broadcast:
+            FOR_EACH(r[j] = Float4(a[j].X));
+        case OpCode::Add:
+            FOR_EACH(r[j] = a[j] + b[j]);
+        case OpCode::Subtract:
+            FOR_EACH(r[j] = a[j] - b[j]);
+        case OpCode::Multiply:
+            FOR_EACH(r[j] = a[j] * b[j]);
+        case OpCode::Divide:
+            FOR_EACH(r[j] = a[j] / b[j]);
+        case OpCode::Max:
+            OP2(Math::Max);
+        case OpCode::Min:
+            OP2(Math::Min);
+        case OpCode::Pow:
+            OP2(Math::Pow);
+        case OpCode::Mod:
+            OP2(Math::Mod);
+        case OpCode::Atan2:
+            OP2(Math::Atan2);
+        case OpCode::Abs:
+            OP1(Math::Abs);
+        case OpCode::Ceil:
+            OP1(Math::Ceil);
+        case OpCode::Cos:
+            OP1(Math::Cos);
+        case OpCode::Floor:
+            OP1(Math::Floor);
+        case OpCode::Round:
+            OP1(Math::Round);
+        case OpCode::Saturate:
+            OP1(Math::Saturate);
+        case OpCode::Sin:
+            OP1(Math::Sin);
+        case OpCode::Sqrt:
+            OP1(Math::Sqrt);
+        case OpCode::Tan:
+            OP1(Math::Tan);
+        case OpCode::Negate:
+            FOR_EACH(r[j] = -a[j]);
+        case OpCode::OneMinus:
+            FOR_EACH(r[j] = Float4::One - a[j]);
+        case OpCode::Asin:
+            OP1(Math::Asin);
+        case OpCode::Acos:
+            OP1(Math::Acos);
+        case OpCode::Atan:
+            OP1(Math::Atan);
+        case OpCode::Trunc:
+            OP1(Math::Trunc);
+        case OpCode::Frac:
+        {
+            float tmp;
+            FOR_EACH(r[j] = Float4(Math::ModF(a[j].X, &tmp), Math::ModF(a[j].Y, &tmp), Math::ModF(a[j].Z, &tmp), Math::ModF(a[j].W, &tmp)));
+        }
+        case OpCode::Degrees:
+            FOR_EACH(r[j] = a[j] * RadiansToDegrees);
+        case OpCode::Radians:
+            FOR_EACH(r[j] = a[j] * DegreesToRadians);
+        case OpCode::Length:
+            // Components store the input vector size (Float4 uses only XYZ like the graph node)
+            FOR_EACH(r[j] = Float4(e.Components == 2 ? Float2(a[j]).Length() : Float3(a[j]).Length()));
+        case OpCode::Normalize:
+            FOR_EACH(r[j] = e.Components == 2 ? Float4(Float2::Normalize(Float2(a[j])), 0.0f, 0.0f) : Float4(Float3::Normalize(Float3(a[j])), 0.0f));
+        default:
+            FOR_EACH(r[j] = Float4::Zero);
+        }
+#undef FOR_EACH
+#undef OP1
+#undef OP2
+    }
+    Platform::MemoryCopy(output, registers[count - 1], particlesCount * sizeof(Float4));
+}
+
+bool ParticleEmitterGraphCPUExecutor::TryExecuteProgram(Box* box, int32 particlesStart, int32 particlesEnd, byte* dataPtr, int32 stride, ParticleAttribute::ValueTypes valueType)
+{
+    // Batched evaluation of the value that gets stored in the particle attribute (the cast must match Variant::Cast)
+    const auto source = box->HasConnection() ? (ParticleEmitterGraphCPUBox*)box->FirstConnection() : nullptr;
+    const ParticleEmitterGraphCPUProgram* program = source ? source->Program : nullptr;
+    const int32 components = GetComponents(GetAttributeType(valueType));
+    if (!program || components == 0)
+        return false;
+    const int32 resultComponents = GetComponents(program->ResultType);
+    if (resultComponents != components && resultComponents != 1 && components != 1)
+        return false;
+    const int32 size = components * sizeof(float);
+    Float4 results[PARTICLE_EMITTER_PROGRAM_BATCH_SIZE];
+    for (int32 batchStart = particlesStart; batchStart < particlesEnd; batchStart += PARTICLE_EMITTER_PROGRAM_BATCH_SIZE)
+    {
+        const int32 batchCount = Math::Min(particlesEnd - batchStart, PARTICLE_EMITTER_PROGRAM_BATCH_SIZE);
+        ExecuteProgram(*program, batchStart, batchCount, results);
+        if (resultComponents == 1)
+        {
+            for (int32 j = 0; j < batchCount; j++)
+                results[j] = Float4(results[j].X);
+        }
+        for (int32 j = 0; j < batchCount; j++)
+        {
+            Platform::MemoryCopy(dataPtr, &results[j], size);
+            dataPtr += stride;
+        }
+    }
+    return true;
+}
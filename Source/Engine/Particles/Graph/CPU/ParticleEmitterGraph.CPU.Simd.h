@@ -0,0 +1,157 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/SIMD.h"
+#include "Engine/Core/Math/Vector3.h"
+
+/// <summary>
+/// The CPU particles attributes processing helpers that operate on 4 particles at once. Particle data uses interleaved layout (attributes of a single particle are stored next to each other) so the attribute values of the 4 particles are transposed into SIMD registers (one register per vector component).
+/// </summary>
+namespace ParticlesSimd
+{
+    FORCE_INLINE SimdVector4 Gather(const byte* ptr, int32 stride)
+    {
+        return SIMD::Load(*(const float*)ptr, *(const float*)(ptr + stride), *(const float*)(ptr + stride * 2), *(const float*)(ptr + stride * 3));
+    }
+
+    FORCE_INLINE void Scatter(byte* ptr, int32 stride, SimdVector4 value)
+    {
+        ALIGN_BEGIN(16) float tmp[4] ALIGN_END(16);
+        SIMD::Store(tmp, value);
+        *(float*)ptr = tmp[0];
+        *(float*)(ptr + stride) = tmp[1];
+        *(float*)(ptr + stride * 2) = tmp[2];
+        *(float*)(ptr + stride * 3) = tmp[3];
+    }
+
+    /// <summary>
+    /// Performs dst += src * scale on Float3 attributes (eg. Euler integration of the position).
+    /// </summary>
+    inline void MulAdd3(byte* dstPtr, const byte* srcPtr, int32 stride, int32 count, float scale)
+    {
+        const SimdVector4 scale4 = SIMD::Splat(scale);
+        const int32 stride4 = stride * 4;
+        int32 i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            for (int32 c = 0; c < 3; c++)
+            {
+                const int32 offset = c * sizeof(float);
+                const SimdVector4 dst = Gather(dstPtr + offset, stride);
+                const SimdVector4 src = Gather(srcPtr + offset, stride);
+                Scatter(dstPtr + offset, stride, SIMD::Add(dst, SIMD::Mul(src, scale4)));
+            }
+            dstPtr += stride4;
+            srcPtr += stride4;
+        }
+        for (; i < count; i++)
+        {
+            *(Float3*)dstPtr += *(const Float3*)srcPtr * scale;
+            dstPtr += stride;
+            srcPtr += stride;
+        }
+    }
+
+    /// <summary>
+    /// Performs dst += value on Float3 attributes (eg. constant force applied to the velocity).
+    /// </summary>
+    inline void Add3(byte* dstPtr, int32 stride, int32 count, const Float3& value)
+    {
+        const SimdVector4 value4[3] = { SIMD::Splat(value.X), SIMD::Splat(value.Y), SIMD::Splat(value.Z) };
+        const int32 stride4 = stride * 4;
+        int32 i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            for (int32 c = 0; c < 3; c++)
+            {
+                const int32 offset = c * sizeof(float);
+                Scatter(dstPtr + offset, stride, SIMD::Add(Gather(dstPtr + offset, stride), value4[c]));
+            }
+            dstPtr += stride4;
+        }
+        for (; i < count; i++)
+        {
+            *(Float3*)dstPtr += value;
+            dstPtr += stride;
+        }
+    }
+
+    /// <summary>
+    /// Performs dst += value on float attributes (eg. age update).
+    /// </summary>
+    inline void Add1(byte* dstPtr, int32 stride, int32 count, float value)
+    {
+        const SimdVector4 value4 = SIMD::Splat(value);
+        const int32 stride4 = stride * 4;
+        int32 i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            Scatter(dstPtr, stride, SIMD::Add(Gather(dstPtr, stride), value4));
+            dstPtr += stride4;
+        }
+        for (; i < count; i++)
+        {
+            *(float*)dstPtr += value;
+            dstPtr += stride;
+        }
+    }
+
+    /// <summary>
+    /// Performs velocity *= max(0, 1 - drag / max(mass, epsilon)) on Float3 velocity and float mass attributes (linear drag with the constant drag input premultiplied by the delta time).
+    /// </summary>
+    inline void LinearDrag(byte* velocityPtr, const byte* massPtr, int32 stride, int32 count, float drag)
+    {
+        const SimdVector4 drag4 = SIMD::Splat(drag);
+        const SimdVector4 one4 = SIMD::Splat(1.0f);
+        const SimdVector4 zero4 = SIMD::Splat(0.0f);
+        const SimdVector4 epsilon4 = SIMD::Splat(ZeroTolerance);
+        const int32 stride4 = stride * 4;
+        int32 i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const SimdVector4 mass = SIMD::Max(Gather(massPtr, stride), epsilon4);
+            const SimdVector4 factor = SIMD::Max(zero4, SIMD::Sub(one4, SIMD::Div(drag4, mass)));
+            for (int32 c = 0; c < 3; c++)
+            {
+                const int32 offset = c * sizeof(float);
+                Scatter(velocityPtr + offset, stride, SIMD::Mul(Gather(velocityPtr + offset, stride), factor));
+            }
+            velocityPtr += stride4;
+            massPtr += stride4;
+        }
+        for (; i < count; i++)
+        {
+            *(Float3*)velocityPtr *= Math::Max(0.0f, 1.0f - drag / Math::Max(*(const float*)massPtr, ZeroTolerance));
+            velocityPtr += stride;
+            massPtr += stride;
+        }
+    }
+
+    /// <summary>
+    /// Finds the first particle (starting from the given index) that has value a greater or equal to value b (eg. age that exceeded lifetime). Returns count if not found.
+    /// </summary>
+    inline int32 FindGreaterEqual(const byte* aPtr, const byte* bPtr, int32 stride, int32 start, int32 count)
+    {
+        int32 i = start;
+        aPtr += start * stride;
+        bPtr += start * stride;
+        const int32 stride4 = stride * 4;
+        for (; i + 4 <= count; i += 4)
+        {
+            // Sign bit is set for every a < b so full mask means that none of 4 particles matches
+            if (SIMD::MoveMask(SIMD::Sub(Gather(aPtr, stride), Gather(bPtr, stride))) != 0xf)
+                break;
+            aPtr += stride4;
+            bPtr += stride4;
+        }
+        for (; i < count; i++)
+        {
+            if (*(const float*)aPtr >= *(const float*)bPtr)
+                break;
+            aPtr += stride;
+            bPtr += stride;
+        }
+        return i;
+    }
+}
@@ -1,12 +1,14 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
 #include "ParticleEmitterGraph.CPU.h"
+#include "ParticleEmitterGraph.CPU.Simd.h"
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Content/Assets/Model.h"
 #include "Engine/Renderer/RenderList.h"
 #include "Engine/Particles/ParticleEffect.h"
 #include "Engine/Engine/Time.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/JobSystem.h"
 
 ThreadLocal<ParticleEmitterGraphCPUContext*> ParticleEmitterGraphCPUExecutor::Context;
 
@@ -36,6 +38,13 @@ void ParticleEmitterGraphCPU::CreateDefault()
     Root = rootNode;
 }
 
+void ParticleEmitterGraphCPU::Clear()
+{
+    Programs.ClearDelete();
+
+    Base::Clear();
+}
+
 bool ParticleEmitterGraphCPU::Load(ReadStream* stream, bool loadMeta)
 {
     if (Base::Load(stream, loadMeta))
@@ -89,6 +98,23 @@ bool ParticleEmitterGraphCPU::Load(ReadStream* stream, bool loadMeta)
         }
     }
 
+    // Compile module inputs (emitter functions are evaluated via the interpreter as they use the caller layout and parameters)
+    if (Root)
+        CompilePrograms();
+
+    // Check if modules can run in parallel on particle ranges
+    bool readsOtherParticles = false;
+    for (const Node& node : Nodes)
+        readsOtherParticles |= node.Used && node.Type == GRAPH_NODE_MAKE_TYPE(14, 303);
+    CanUpdateParallel = !readsOtherParticles;
+    CanInitParallel = !readsOtherParticles && CustomDataSize == 0;
+    for (const Node* module : UpdateModules)
+    {
+        // Kill modules remove particles from the buffer
+        if (module->TypeID == 306 || module->TypeID == 307 || module->TypeID == 308)
+            CanUpdateParallel = false;
+    }
+
     return false;
 }
 
@@ -135,6 +161,7 @@ void ParticleEmitterGraphCPUExecutor::Init(ParticleEmitter* emitter, ParticleEff
     context.ParticleIndex = 0;
     context.ViewTask = effect->GetRenderTask();
     context.CallStackSize = 0;
+    context.Random.Initialize((int32)data.RandomSeed);
     context.Functions.Clear();
     for (int32 i = 0; i < PARTICLE_ATTRIBUTES_MAX_COUNT; i++)
         context.AttributesRemappingTable[i] = i;
@@ -438,10 +465,7 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
     if (cpu.Count > 0)
     {
         PROFILE_CPU_NAMED("Update");
-        for (int32 i = 0; i < _graph.UpdateModules.Count(); i++)
-        {
-            ProcessModule(_graph.UpdateModules[i], 0, cpu.Count);
-        }
+        ProcessModules(_graph.UpdateModules, 0, cpu.Count, _graph.CanUpdateParallel);
     }
 
     // Dead particles removal
@@ -450,19 +474,13 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
         PROFILE_CPU_NAMED("Age kill");
         byte* agePtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrAge].Offset;
         byte* lifetimePtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrLifetime].Offset;
-        for (int32 particleIndex = 0; particleIndex < cpu.Count; particleIndex++)
+        const int32 stride = data.Buffer->Stride;
+        int32 particleIndex = 0;
+        while ((particleIndex = ParticlesSimd::FindGreaterEqual(agePtr, lifetimePtr, stride, particleIndex, cpu.Count)) < cpu.Count)
         {
-            if (*(float*)agePtr >= *(float*)lifetimePtr)
-            {
-                cpu.Count--;
-                Platform::MemoryCopy(data.Buffer->GetParticleCPU(particleIndex), data.Buffer->GetParticleCPU(cpu.Count), data.Buffer->Stride);
-                particleIndex--;
-            }
-            else
-            {
-                agePtr += data.Buffer->Stride;
-                lifetimePtr += data.Buffer->Stride;
-            }
+            // Replace the dead particle with the last one and test it again
+            cpu.Count--;
+            Platform::MemoryCopy(data.Buffer->GetParticleCPU(particleIndex), data.Buffer->GetParticleCPU(cpu.Count), stride);
         }
     }
 
@@ -486,12 +504,7 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
         PROFILE_CPU_NAMED("Euler Integration");
         byte* positionPtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrPosition].Offset;
         byte* velocityPtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrVelocity].Offset;
-        for (int32 particleIndex = 0; particleIndex < cpu.Count; particleIndex++)
-        {
-            *((Float3*)positionPtr) += *((Float3*)velocityPtr) * dt;
-            positionPtr += data.Buffer->Stride;
-            velocityPtr += data.Buffer->Stride;
-        }
+        ParticlesSimd::MulAdd3(positionPtr, velocityPtr, data.Buffer->Stride, cpu.Count, dt);
     }
 
     // Angular Euler Integration
@@ -500,12 +513,7 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
         PROFILE_CPU_NAMED("Angular Euler Integration");
         byte* rotationPtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrRotation].Offset;
         byte* angularVelocityPtr = cpu.Buffer.Get() + data.Buffer->Layout->Attributes[_graph._attrAngularVelocity].Offset;
-        for (int32 particleIndex = 0; particleIndex < cpu.Count; particleIndex++)
-        {
-            *((Float3*)rotationPtr) += *((Float3*)angularVelocityPtr) * dt;
-            rotationPtr += data.Buffer->Stride;
-            angularVelocityPtr += data.Buffer->Stride;
-        }
+        ParticlesSimd::MulAdd3(rotationPtr, angularVelocityPtr, data.Buffer->Stride, cpu.Count, dt);
     }
 
     // Spawn particles
@@ -534,10 +542,7 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
                 Platform::MemoryCopy(data.Buffer->GetParticleCPU(countBefore + i), _graph._defaultParticleData.Get(), data.Buffer->Stride);
 
             // Initialize particles
-            for (int32 i = 0; i < _graph.InitModules.Count(); i++)
-            {
-                ProcessModule(_graph.InitModules[i], countBefore, countAfter);
-            }
+            ProcessModules(_graph.InitModules, countBefore, countAfter, _graph.CanInitParallel);
         }
     }
 
@@ -567,6 +572,46 @@ void ParticleEmitterGraphCPUExecutor::Update(ParticleEmitter* emitter, ParticleE
             }
         }
     }
+
+    // Advance the random numbers generator for the next update
+    data.RandomSeed = context->Random.GetUnsignedInt();
+}
+
+void ParticleEmitterGraphCPUExecutor::ProcessModules(const Array<ParticleEmitterGraphCPUNode*, FixedAllocation<PARTICLE_EMITTER_MAX_MODULES>>& modules, int32 particlesStart, int32 particlesEnd, bool canRunParallel)
+{
+    const int32 count = particlesEnd - particlesStart;
+    if (!canRunParallel || count < PARTICLE_EMITTER_PARALLEL_MIN_PARTICLES)
+    {
+        for (int32 i = 0; i < modules.Count(); i++)
+            ProcessModule(modules[i], particlesStart, particlesEnd);
+        return;
+    }
+    PROFILE_CPU_NAMED("Parallel");
+
+    // Split particles into ranges processed by all modules (in order) on the job threads
+    auto& context = *Context.Get();
+    ParticleEmitter* emitter = context.Emitter;
+    ParticleEffect* effect = context.Effect;
+    ParticleEmitterInstance& data = *context.Data;
+    const float dt = context.DeltaTime;
+    const uint32 jobsSeed = context.Random.GetUnsignedInt();
+    const int32 jobsCount = Math::DivideAndRoundUp(count, PARTICLE_EMITTER_PARALLEL_BATCH_SIZE);
+    const Function<void(int32)> job = [&](int32 jobIndex)
+    {
+        // Use a separate context as this thread can be in the middle of another emitter update (waiting threads help with the jobs)
+        auto& contextPtr = Context.Get();
+        const auto prevContext = contextPtr;
+        ParticleEmitterGraphCPUContext jobContext;
+        contextPtr = &jobContext;
+        Init(emitter, effect, data, dt);
+        jobContext.Random.Initialize((int32)(jobsSeed + (uint32)jobIndex * 0x9E3779B9)); // Random sequence depends only on the particles range (not on the thread that runs it)
+        const int32 start = particlesStart + jobIndex * PARTICLE_EMITTER_PARALLEL_BATCH_SIZE;
+        const int32 end = Math::Min(start + PARTICLE_EMITTER_PARALLEL_BATCH_SIZE, particlesEnd);
+        for (int32 i = 0; i < modules.Count(); i++)
+            ProcessModule(modules[i], start, end);
+        contextPtr = prevContext;
+    };
+    JobSystem::Execute(job, jobsCount);
 }
 
 int32 ParticleEmitterGraphCPUExecutor::UpdateSpawn(ParticleEmitter* emitter, ParticleEffect* effect, ParticleEmitterInstance& data, float dt)
@@ -583,6 +628,9 @@ int32 ParticleEmitterGraphCPUExecutor::UpdateSpawn(ParticleEmitter* emitter, Par
         spawnCount += ProcessSpawnModule(i);
     }
 
+    // Advance the random numbers generator for the next update
+    data.RandomSeed = Context.Get()->Random.GetUnsignedInt();
+
     return spawnCount;
 }
 
@@ -603,6 +651,26 @@ VisjectExecutor::Value ParticleEmitterGraphCPUExecutor::eatBox(Node* caller, Box
     }
 #endif
 
+    // Evaluate compiled value expression without walking the nodes
+    if (const ParticleEmitterGraphCPUProgram* program = ((ParticleEmitterGraphCPUBox*)box)->Program)
+    {
+        Float4 result;
+        ExecuteProgram(*program, context.ParticleIndex, 1, &result);
+        switch (program->ResultType)
+        {
+        case VariantType::Float2:
+            return Value(Float2(result));
+        case VariantType::Float3:
+            return Value(Float3(result));
+        case VariantType::Float4:
+            return Value(result);
+        case VariantType::Color:
+            return Value(Color(result));
+        default:
+            return Value(result.X);
+        }
+    }
+
     // Add to the calling stack
     context.CallStack[context.CallStackSize++] = caller;
 
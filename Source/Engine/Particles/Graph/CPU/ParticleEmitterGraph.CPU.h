@@ -7,6 +7,7 @@
 #include "Engine/Particles/ParticlesData.h"
 #include "Engine/Visject/VisjectGraph.h"
 #include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/RandomStream.h"
 #include "Engine/Threading/ThreadLocal.h"
 
 struct RenderContext;
@@ -30,8 +31,97 @@ class ParticleEmitterGraphCPUExecutor;
 
 #define PARTICLE_EMITTER_MAX_CALL_STACK 100
 
+// The minimum amount of particles to update emitter in parallel (split into particle ranges processed by the Job System)
+#define PARTICLE_EMITTER_PARALLEL_MIN_PARTICLES 8192
+
+// The amount of particles processed by a single job of the emitter parallel update
+#define PARTICLE_EMITTER_PARALLEL_BATCH_SIZE 2048
+
+// The maximum amount of instructions in the compiled value expression
+#define PARTICLE_EMITTER_PROGRAM_MAX_INSTRUCTIONS 64
+
+// The amount of particles evaluated at once by the compiled value expression
+#define PARTICLE_EMITTER_PROGRAM_BATCH_SIZE 16
+
+/// <summary>
+/// The compiled CPU particles value expression (eg. module input computed from the particle attributes). Pure vector math sub-graphs are flattened into a linear list of instructions writing to the Float4 registers (one per instruction) which are evaluated over a batch of particles at once without the per-node dispatch and Variant values.
+/// </summary>
+struct ParticleEmitterGraphCPUProgram
+{
+    enum class OpCode : byte
+    {
+        Constant,
+        Parameter,
+        Attribute,
+        NormalizedAge,
+        Component,
+        Broadcast,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Max,
+        Min,
+        Pow,
+        Mod,
+        Atan2,
+        Abs,
+        Ceil,
+        Cos,
+        Floor,
+        Round,
+        Saturate,
+        Sin,
+        Sqrt,
+        Tan,
+        Negate,
+        OneMinus,
+        Asin,
+        Acos,
+        Atan,
+        Trunc,
+        Frac,
+        Degrees,
+        Radians,
+        Length,
+        Normalize,
+    };
+
+    struct Instruction
+    {
+        OpCode Op;
+        // The source registers (indices of the previous instructions).
+        byte A, B;
+        // The amount of the used register components (1-4).
+        byte Components;
+
+        union
+        {
+            Float4 Constant;
+            int32 ParameterIndex;
+            int32 ComponentIndex;
+            byte Attributes[2];
+        };
+    };
+
+    /// <summary>
+    /// The instructions to execute in order. The result is the register of the last instruction.
+    /// </summary>
+    Array<Instruction, InlinedAllocation<8>> Instructions;
+
+    /// <summary>
+    /// The type of the result value (float or vector).
+    /// </summary>
+    VariantType::Types ResultType = VariantType::Float;
+};
+
 class ParticleEmitterGraphCPUBox : public VisjectGraphBox
 {
+public:
+    /// <summary>
+    /// The compiled expression that evaluates the value of this output box (null if not compiled).
+    /// </summary>
+    ParticleEmitterGraphCPUProgram* Program = nullptr;
 };
 
 class ParticleEmitterGraphCPUNode : public ParticleEmitterGraphNode<VisjectGraphNode<ParticleEmitterGraphCPUBox>>
@@ -79,6 +169,24 @@ class ParticleEmitterGraphCPU : public ParticleEmitterGraph<VisjectGraph<Particl
     // Size of the custom pre-node data buffer used for state tracking (eg. position on spiral arc progression).
     int32 CustomDataSize = 0;
 
+    // The compiled value expressions used by the graph boxes.
+    Array<ParticleEmitterGraphCPUProgram*> Programs;
+
+    // True if update modules can process particle ranges in parallel (eg. no particles removal or reading other particles data).
+    bool CanUpdateParallel = false;
+
+    // True if initialization modules can process particle ranges in parallel (eg. no sequential state tracking).
+    bool CanInitParallel = false;
+
+public:
+    /// <summary>
+    /// Finalizes an instance of the <see cref="ParticleEmitterGraphCPU"/> class.
+    /// </summary>
+    ~ParticleEmitterGraphCPU()
+    {
+        Programs.ClearDelete();
+    }
+
     /// <summary>
     /// Creates the default surface graph (the main root node) for the particle emitter. Ensure to dispose the previous graph data before.
     /// </summary>
@@ -100,8 +208,14 @@ class ParticleEmitterGraphCPU : public ParticleEmitterGraph<VisjectGraph<Particl
         return _attrAge != -1 ? Layout.Attributes[_attrAge].Offset : -1;
     }
 
+    /// <summary>
+    /// Compiles the pure value expressions (vector math on the parameters and particle attributes) into programs executed instead of the nodes.
+    /// </summary>
+    void CompilePrograms();
+
 public:
     // [ParticleEmitterGraph]
+    void Clear() override;
     bool Load(ReadStream* stream, bool loadMeta) override;
     void InitializeNode(Node* node) override;
 };
@@ -122,6 +236,7 @@ struct ParticleEmitterGraphCPUContext
     byte AttributesRemappingTable[PARTICLE_ATTRIBUTES_MAX_COUNT]; // Maps node attribute indices to the current particle layout (used to support accessing particle data from function graph which has different layout).
     int32 CallStackSize = 0;
     VisjectExecutor::Node* CallStack[PARTICLE_EMITTER_MAX_CALL_STACK];
+    RandomStream Random; // The random numbers generator used by the simulation (seeded from the emitter instance to keep the simulation deterministic).
 };
 
 /// <summary>
@@ -195,6 +310,9 @@ class ParticleEmitterGraphCPUExecutor : public VisjectExecutor
 
     int32 ProcessSpawnModule(int32 index);
     void ProcessModule(ParticleEmitterGraphCPUNode* node, int32 particlesStart, int32 particlesEnd);
+    void ProcessModules(const Array<ParticleEmitterGraphCPUNode*, FixedAllocation<PARTICLE_EMITTER_MAX_MODULES>>& modules, int32 particlesStart, int32 particlesEnd, bool canRunParallel);
+    void ExecuteProgram(const ParticleEmitterGraphCPUProgram& program, int32 particlesStart, int32 particlesCount, Float4* output);
+    bool TryExecuteProgram(Box* box, int32 particlesStart, int32 particlesEnd, byte* dataPtr, int32 stride, ParticleAttribute::ValueTypes valueType);
 
     FORCE_INLINE Value GetValue(Box* box, int32 defaultValueBoxIndex)
     {
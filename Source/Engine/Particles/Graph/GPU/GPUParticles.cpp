@@ -140,6 +140,7 @@ void GPUParticles::Execute(GPUContext* context, ParticleEmitter* emitter, Partic
     {
         data.Buffer->GPU.PendingClear = false;
         data.Buffer->GPU.ParticlesCountMax = 0;
+        data.Buffer->GPU.HasIndirectDispatchArgs = false;
 
         // Clear counter in the particles buffer
         context->UpdateBuffer(data.Buffer->GPU.Buffer, &counterDefaultValue, sizeof(counterDefaultValue), counterOffset);
@@ -258,9 +259,17 @@ void GPUParticles::Execute(GPUContext* context, ParticleEmitter* emitter, Partic
     context->BindSR(0, data.Buffer->GPU.Buffer->View());
     context->BindUA(0, data.Buffer->GPU.BufferSecondary->View());
 
-    // Invoke Compute shader
-    const int32 threadGroupSize = 1024;
-    context->Dispatch(_mainCS, Math::Min(Math::DivideAndRoundUp(threads, threadGroupSize), GPU_MAX_CS_DISPATCH_THREAD_GROUPS), 1, 1);
+    // Invoke Compute shader (use indirect arguments generated from the actual particles count if available)
+    if (data.Buffer->GPU.HasIndirectDispatchArgs)
+    {
+        data.Buffer->GPU.HasIndirectDispatchArgs = false;
+        context->DispatchIndirect(_mainCS, data.Buffer->GPU.IndirectDispatchArgsBuffer, 0);
+    }
+    else
+    {
+        const int32 threadGroupSize = 1024;
+        context->Dispatch(_mainCS, Math::Min(Math::DivideAndRoundUp(threads, threadGroupSize), GPU_MAX_CS_DISPATCH_THREAD_GROUPS), 1, 1);
+    }
 
     // Copy custom data
     for (int32 i = 0; i < CustomDataSize; i += 4)
@@ -5,10 +5,17 @@
 #include "Engine/Core/Types/CommonValue.h"
 #include "Engine/Serialization/JsonTools.h"
 #include "Engine/Serialization/Serialization.h"
+#include "Engine/Serialization/MemoryReadStream.h"
+#include "Engine/Serialization/MemoryWriteStream.h"
 #include "Engine/Level/Scene/SceneRendering.h"
 #include "Engine/Level/Scene/Scene.h"
 #include "Engine/Engine/Time.h"
 #include "Engine/Engine/Engine.h"
+#include "Engine/Graphics/RenderTools.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+
+// The version of the particles simulation snapshot data format (see ParticleEffect::SaveSnapshot)
+#define PARTICLE_EFFECT_SNAPSHOT_VERSION 1
 
 ParticleEffect::ParticleEffect(const SpawnParams& params)
     : Actor(params)
@@ -254,6 +261,19 @@ int32 ParticleEffect::GetParticlesCount() const
     return Instance.GetParticlesCount();
 }
 
+uint32 ParticleEffect::GetRandomSeed() const
+{
+    return Instance.RandomSeed;
+}
+
+void ParticleEffect::SetRandomSeed(uint32 value)
+{
+    if (Instance.RandomSeed == value)
+        return;
+    Instance.RandomSeed = value;
+    ResetSimulation();
+}
+
 bool ParticleEffect::GetIsPlaying() const
 {
     return _isPlaying;
@@ -275,7 +295,10 @@ void ParticleEffect::UpdateSimulation(bool singleFrame)
 
     // Request update
     _lastUpdateFrame = Engine::FrameCount;
+    _lastVisibleDstSqr = _lastMinDstSqr;
+    _lastVisibleScreenSize = _lastMaxScreenSize;
     _lastMinDstSqr = MAX_Real;
+    _lastMaxScreenSize = 0.0f;
     if (singleFrame)
         Instance.LastUpdateTime = (UseTimeScale ? Time::Update.Time : Time::Update.UnscaledTime).GetTotalSeconds();
     Particles::UpdateEffect(this);
@@ -299,6 +322,132 @@ void ParticleEffect::Stop()
     ResetSimulation();
 }
 
+void ParticleEffect::Prewarm(int32 instancesCount)
+{
+    const auto particleSystem = ParticleSystem.Get();
+    if (!particleSystem || !particleSystem->IsLoaded())
+        return;
+    for (const auto& track : particleSystem->Tracks)
+    {
+        if (track.Type != ParticleSystem::Track::Types::Emitter || track.Disabled)
+            continue;
+        ParticleEmitter* emitter = particleSystem->Emitters[track.AsEmitter.Index].Get();
+        Particles::PrewarmParticleBuffers(emitter, instancesCount);
+    }
+}
+
+bool ParticleEffect::SaveSnapshot(Array<byte>& data)
+{
+    data.Clear();
+    const auto system = ParticleSystem.Get();
+    if (!system || !system->IsLoaded() || Instance.Version != system->Version)
+        return true;
+    PROFILE_CPU();
+
+    MemoryWriteStream stream(1024);
+    stream.WriteInt32(PARTICLE_EFFECT_SNAPSHOT_VERSION);
+    stream.WriteFloat(Instance.Time);
+    stream.WriteInt32(Instance.Emitters.Count());
+    for (int32 emitterIndex = 0; emitterIndex < Instance.Emitters.Count(); emitterIndex++)
+    {
+        const ParticleEmitter* emitter = system->Emitters[emitterIndex].Get();
+        const ParticleEmitterInstance& e = Instance.Emitters[emitterIndex];
+        if (!emitter || e.Version != emitter->Graph.Version)
+        {
+            // Not used emitter (eg. disabled track)
+            stream.WriteInt32(0);
+            continue;
+        }
+
+        // Emitter layout (used to validate the data on load)
+        stream.WriteInt32(emitter->Graph.Layout.Size);
+        stream.WriteInt32(e.SpawnModulesData.Count());
+        stream.WriteInt32(e.CustomData.Count());
+
+        // Simulation state
+        stream.WriteFloat(e.Time);
+        stream.WriteUint32(e.RandomSeed);
+        stream.WriteBytes(e.SpawnModulesData.Get(), e.SpawnModulesData.Count() * sizeof(ParticleEmitterInstance::SpawnerData));
+        stream.WriteBytes(e.CustomData.Get(), e.CustomData.Count());
+
+        // CPU particles data
+        const int32 count = e.Buffer && e.Buffer->Mode == ParticlesSimulationMode::CPU ? e.Buffer->CPU.Count : 0;
+        stream.WriteInt32(count);
+        stream.WriteBytes(e.Buffer ? e.Buffer->CPU.Buffer.Get() : nullptr, count * emitter->Graph.Layout.Size);
+    }
+
+    data.Set(stream.GetHandle(), stream.GetPosition());
+    return false;
+}
+
+bool ParticleEffect::LoadSnapshot(const Span<byte>& data)
+{
+    const auto system = ParticleSystem.Get();
+    if (!system || system->WaitForLoaded())
+        return true;
+    PROFILE_CPU();
+    MemoryReadStream stream(data.Get(), data.Length());
+#define CHECK_SNAPSHOT(expression) if (!(expression)) { LOG(Warning, "Invalid particle effect snapshot data for '{0}'.", GetNamePath()); ResetSimulation(); return true; }
+#define CHECK_SNAPSHOT_SIZE(size) CHECK_SNAPSHOT(stream.GetLength() - stream.GetPosition() >= (uint32)(size))
+
+    // Header
+    CHECK_SNAPSHOT_SIZE(sizeof(int32) * 2 + sizeof(float));
+    int32 version, emittersCount;
+    float time;
+    stream.ReadInt32(&version);
+    stream.ReadFloat(&time);
+    stream.ReadInt32(&emittersCount);
+    CHECK_SNAPSHOT(version == PARTICLE_EFFECT_SNAPSHOT_VERSION && emittersCount == system->Emitters.Count());
+
+    // Start from the clean state that matches the particle system
+    ResetSimulation();
+    Sync();
+    Instance.Time = time;
+    for (int32 emitterIndex = 0; emitterIndex < emittersCount; emitterIndex++)
+    {
+        ParticleEmitter* emitter = system->Emitters[emitterIndex].Get();
+        ParticleEmitterInstance& e = Instance.Emitters[emitterIndex];
+        CHECK_SNAPSHOT_SIZE(sizeof(int32));
+        int32 layoutSize;
+        stream.ReadInt32(&layoutSize);
+        if (layoutSize == 0)
+            continue;
+
+        // Validate layout
+        CHECK_SNAPSHOT_SIZE(sizeof(int32) * 2);
+        int32 spawnModulesCount, customDataSize;
+        stream.ReadInt32(&spawnModulesCount);
+        stream.ReadInt32(&customDataSize);
+        CHECK_SNAPSHOT(emitter && e.Version == emitter->Graph.Version && layoutSize == emitter->Graph.Layout.Size && spawnModulesCount == e.SpawnModulesData.Count() && customDataSize == e.CustomData.Count());
+
+        // Simulation state
+        CHECK_SNAPSHOT_SIZE(sizeof(float) + sizeof(uint32) + spawnModulesCount * sizeof(ParticleEmitterInstance::SpawnerData) + customDataSize + sizeof(int32));
+        stream.ReadFloat(&e.Time);
+        stream.ReadUint32(&e.RandomSeed);
+        stream.ReadBytes(e.SpawnModulesData.Get(), spawnModulesCount * sizeof(ParticleEmitterInstance::SpawnerData));
+        stream.ReadBytes(e.CustomData.Get(), customDataSize);
+
+        // CPU particles data
+        int32 count;
+        stream.ReadInt32(&count);
+        CHECK_SNAPSHOT(count >= 0 && count <= emitter->Capacity && (count == 0 || emitter->SimulationMode == ParticlesSimulationMode::CPU));
+        CHECK_SNAPSHOT_SIZE(count * layoutSize);
+        if (count != 0)
+        {
+            if (!e.Buffer)
+                e.Buffer = Particles::AcquireParticleBuffer(emitter);
+            CHECK_SNAPSHOT(e.Buffer);
+            e.Buffer->CPU.Count = count;
+            stream.ReadBytes(e.Buffer->CPU.Buffer.Get(), count * layoutSize);
+        }
+    }
+
+#undef CHECK_SNAPSHOT
+#undef CHECK_SNAPSHOT_SIZE
+    UpdateBounds();
+    return false;
+}
+
 void ParticleEffect::UpdateBounds()
 {
     BoundingBox bounds = BoundingBox::Empty;
@@ -535,6 +684,7 @@ void ParticleEffect::Draw(RenderContext& renderContext)
     if (renderContext.View.Pass == DrawPass::GlobalSDF || renderContext.View.Pass == DrawPass::GlobalSurfaceAtlas)
         return;
     _lastMinDstSqr = Math::Min(_lastMinDstSqr, Vector3::DistanceSquared(GetPosition(), renderContext.View.Position));
+    _lastMaxScreenSize = Math::Max(_lastMaxScreenSize, Math::Sqrt(RenderTools::ComputeBoundsScreenRadiusSquared(_sphere.Center - renderContext.View.Origin, (float)_sphere.Radius, renderContext.View)) * 2.0f);
     Particles::DrawParticles(renderContext, this);
 }
 
@@ -614,8 +764,12 @@ void ParticleEffect::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE(IsLooping);
     SERIALIZE(PlayOnStart);
     SERIALIZE(UpdateWhenOffscreen);
+    SERIALIZE(SimulationLODDistance);
+    SERIALIZE(UseSimulationBudget);
+    SERIALIZE(SignificanceScale);
     SERIALIZE(DrawModes);
     SERIALIZE(SortOrder);
+    SERIALIZE_MEMBER(RandomSeed, Instance.RandomSeed);
 }
 
 void ParticleEffect::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
@@ -715,8 +869,12 @@ void ParticleEffect::Deserialize(DeserializeStream& stream, ISerializeModifier*
     DESERIALIZE(IsLooping);
     DESERIALIZE(PlayOnStart);
     DESERIALIZE(UpdateWhenOffscreen);
+    DESERIALIZE(SimulationLODDistance);
+    DESERIALIZE(UseSimulationBudget);
+    DESERIALIZE(SignificanceScale);
     DESERIALIZE(DrawModes);
     DESERIALIZE(SortOrder);
+    DESERIALIZE_MEMBER(RandomSeed, Instance.RandomSeed);
 
     if (_parameters.HasItems())
     {
@@ -154,6 +154,32 @@ class FLAXENGINE_API ParticleEffect : public Actor
         FixedTimestep = 1,
     };
 
+    /// <summary>
+    /// The particles simulation detail levels. Assigned by the particles manager based on the effect significance and the global simulation budgets.
+    /// </summary>
+    API_ENUM() enum class SimulationLODs
+    {
+        /// <summary>
+        /// Full simulation quality.
+        /// </summary>
+        Full = 0,
+
+        /// <summary>
+        /// Particles spawn rate is scaled down.
+        /// </summary>
+        ReducedSpawn = 1,
+
+        /// <summary>
+        /// Simulation is updated every few frames (with accumulated delta time) and particles spawn rate is scaled down.
+        /// </summary>
+        ReducedRate = 2,
+
+        /// <summary>
+        /// Simulation is paused. Particles are still drawn.
+        /// </summary>
+        Paused = 3,
+    };
+
     /// <summary>
     /// The particle parameter override data.
     /// </summary>
@@ -178,8 +204,14 @@ class FLAXENGINE_API ParticleEffect : public Actor
     };
 
 private:
+    friend class ParticlesSystem;
     uint64 _lastUpdateFrame;
     Real _lastMinDstSqr;
+    Real _lastVisibleDstSqr = MAX_Real; // Closest view distance from the previous simulation update (MAX_Real if effect was not visible)
+    float _lastMaxScreenSize = 0.0f;
+    float _lastVisibleScreenSize = 0.0f;
+    float _significance = 1.0f;
+    SimulationLODs _simulationLOD = SimulationLODs::Full;
     int32 _sceneRenderingKey = -1;
     uint32 _parametersVersion = 0; // Version number for _parameters to be in sync with Instance.ParametersVersion
     Array<ParticleEffectParameter> _parameters; // Cached for scripting API
@@ -248,6 +280,24 @@ class FLAXENGINE_API ParticleEffect : public Actor
     API_FIELD(Attributes="EditorDisplay(\"Particle Effect\"), DefaultValue(true), EditorOrder(70)")
     bool UpdateWhenOffscreen = true;
 
+    /// <summary>
+    /// The distance from the view above which the particles simulation is updated with a lower frequency and spawn rate. Use 0 to disable it.
+    /// </summary>
+    API_FIELD(Attributes="EditorDisplay(\"Particle Effect\"), DefaultValue(0.0f), Limit(0), EditorOrder(71)")
+    float SimulationLODDistance = 0.0f;
+
+    /// <summary>
+    /// If true, the particle simulation can be degraded (reduced spawn rate, lower update frequency or paused) when the global particles simulation budget gets exceeded. Otherwise, effect is always simulated at full quality.
+    /// </summary>
+    API_FIELD(Attributes="EditorDisplay(\"Particle Effect\"), DefaultValue(true), EditorOrder(72)")
+    bool UseSimulationBudget = true;
+
+    /// <summary>
+    /// The effect significance scale used to prioritize the particles simulation when the global particles simulation budget gets exceeded. Higher values make the effect more important than others with the same screen size.
+    /// </summary>
+    API_FIELD(Attributes="EditorDisplay(\"Particle Effect\"), DefaultValue(1.0f), Limit(0), EditorOrder(73), VisibleIf(nameof(UseSimulationBudget))")
+    float SignificanceScale = 1.0f;
+
     /// <summary>
     /// The draw passes to use for rendering this object.
     /// </summary>
@@ -334,6 +384,40 @@ class FLAXENGINE_API ParticleEffect : public Actor
     /// </summary>
     API_PROPERTY() int32 GetParticlesCount() const;
 
+    /// <summary>
+    /// Gets the seed of the particles simulation random numbers. Effects with the same non-zero seed, parameters and update steps produce the same CPU particles (eg. for networked or replayed effects). Value 0 uses a random seed on every simulation reset.
+    /// </summary>
+    API_PROPERTY(Attributes="EditorDisplay(\"Particle Effect\"), DefaultValue(0), EditorOrder(74)") uint32 GetRandomSeed() const;
+
+    /// <summary>
+    /// Sets the seed of the particles simulation random numbers. Effects with the same non-zero seed, parameters and update steps produce the same CPU particles (eg. for networked or replayed effects). Value 0 uses a random seed on every simulation reset. Changing the seed resets the simulation.
+    /// </summary>
+    API_PROPERTY() void SetRandomSeed(uint32 value);
+
+    /// <summary>
+    /// Gets the current particles simulation detail level (assigned by the particles manager based on the effect significance and the global simulation budgets).
+    /// </summary>
+    API_PROPERTY(Attributes="NoSerialize, HideInEditor") SimulationLODs GetSimulationLOD() const
+    {
+        return _simulationLOD;
+    }
+
+    /// <summary>
+    /// Gets the effect significance calculated during the last simulation update (based on the effect visibility and screen size).
+    /// </summary>
+    API_PROPERTY(Attributes="NoSerialize, HideInEditor") float GetSignificance() const
+    {
+        return _significance;
+    }
+
+    /// <summary>
+    /// Gets the particles spawn rate scale for the current simulation detail level.
+    /// </summary>
+    float GetSpawnRateScale() const
+    {
+        return _simulationLOD == SimulationLODs::Full ? 1.0f : 0.5f;
+    }
+
     /// <summary>
     /// Gets whether or not the particle effect is playing.
     /// </summary>
@@ -365,6 +449,26 @@ class FLAXENGINE_API ParticleEffect : public Actor
     /// </summary>
     API_FUNCTION() void Stop();
 
+    /// <summary>
+    /// Prepares the particle buffers for the effect emitters ahead of spawning the effects (eg. during level loading), so playing effects later doesn't allocate GPU resources. Buffers are placed in the shared pool and released after Particles.ParticleBufferRecycleTimeout if not used. Particle materials compile their pipeline states on load.
+    /// </summary>
+    /// <param name="instancesCount">The amount of the effect instances to prepare.</param>
+    API_FUNCTION() void Prewarm(int32 instancesCount = 1);
+
+    /// <summary>
+    /// Saves the particles simulation state into a compact binary snapshot (timeline time, emitters spawn state, random numbers generators and CPU particles data). Can be used to replicate the effect over the network or to restore it later with LoadSnapshot. GPU particles live in the GPU memory only so their emitters are restored from the reset state.
+    /// </summary>
+    /// <param name="data">The output snapshot data.</param>
+    /// <returns>True if failed to save the snapshot (eg. particle system is not loaded), otherwise false.</returns>
+    API_FUNCTION() bool SaveSnapshot(API_PARAM(Out) Array<byte>& data);
+
+    /// <summary>
+    /// Restores the particles simulation state from the snapshot created with SaveSnapshot (for the same particle system). To fast-forward the restored effect (eg. to compensate the network latency) set the LastUpdateTime to the snapshot time so the next update simulates the elapsed time.
+    /// </summary>
+    /// <param name="data">The snapshot data.</param>
+    /// <returns>True if failed to load the snapshot (eg. data doesn't match the particle system), otherwise false.</returns>
+    API_FUNCTION() bool LoadSnapshot(const Span<byte>& data);
+
     /// <summary>
     /// Updates the actor bounds.
     /// </summary>
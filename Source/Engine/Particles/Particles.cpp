@@ -5,6 +5,7 @@
 #include "Engine/Content/Assets/Model.h"
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Core/Collections/HashSet.h"
+#include "Engine/Core/Memory/FrameAllocation.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Engine/Time.h"
 #include "Engine/Engine/Engine.h"
@@ -15,6 +16,7 @@
 #include "Engine/Graphics/GPUContext.h"
 #include "Engine/Graphics/RenderTools.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Renderer/DrawCall.h"
 #include "Engine/Renderer/RenderList.h"
 #include "Engine/Threading/TaskGraph.h"
@@ -23,6 +25,7 @@
 #include "Engine/Content/Assets/Shader.h"
 #include "Engine/Profiler/ProfilerGPU.h"
 #include "Engine/Renderer/Utils/BitonicSort.h"
+#include "Engine/Renderer/Utils/RadixSort.h"
 #endif
 #if USE_EDITOR
 #include "Editor/Editor.h"
@@ -99,30 +102,63 @@ struct EmitterCache
 namespace ParticleManagerImpl
 {
     CriticalSection PoolLocker;
-    Dictionary<ParticleEmitter*, Array<EmitterCache>> Pool;
+    // Pooled buffers grouped by the simulation mode and the data size class (see GetPoolKey)
+    Dictionary<uint64, Array<EmitterCache>> Pool;
+    int64 PoolMemory = 0;
     Array<ParticleEffect*> UpdateList;
+    // The amount of frames between updates of the effects using reduced update rate
+    constexpr uint64 ReducedRateFrames = 4;
 #if COMPILE_WITH_GPU_PARTICLES
     CriticalSection GpuUpdateListLocker;
     Array<ParticleEffect*> GpuUpdateList;
+
+    struct GpuEmitterUpdate
+    {
+        ParticleEmitter* Emitter;
+        ParticleEffect* Effect;
+        int32 EmitterIndex;
+
+        static bool SortByEmitter(const GpuEmitterUpdate& a, const GpuEmitterUpdate& b)
+        {
+            return (uintptr)a.Emitter < (uintptr)b.Emitter;
+        }
+    };
+
+    Array<GpuEmitterUpdate> GpuEmitterUpdates;
     RenderTask* GpuRenderTask = nullptr;
 #endif
 }
 
 using namespace ParticleManagerImpl;
 
+namespace
+{
+    FORCE_INLINE uint64 GetPoolKey(ParticlesSimulationMode mode, int32 sizeClass)
+    {
+        return ((uint64)mode << 32) | (uint32)sizeClass;
+    }
+
+    FORCE_INLINE uint64 GetPoolKey(ParticleEmitter* emitter)
+    {
+        return GetPoolKey(emitter->SimulationMode, ParticleBuffer::GetSizeClass(ParticleBuffer::GetRequiredSize(emitter)));
+    }
+
+    void DeletePooledBuffer(ParticleBuffer* buffer)
+    {
+        PoolMemory -= buffer->AllocatedSize;
+        Delete(buffer);
+    }
+}
+
 TaskGraphSystem* Particles::System = nullptr;
 bool Particles::EnableParticleBufferPooling = true;
 float Particles::ParticleBufferRecycleTimeout = 10.0f;
+int64 Particles::ParticleBufferPoolBudget = 0;
+int32 Particles::MaxSimulatedParticles = 0;
+int32 Particles::MaxUpdatedEmitters = 0;
 
 SpriteParticleRenderer SpriteRenderer;
 
-namespace ParticlesDrawCPU
-{
-    Array<uint32> SortingKeys[2];
-    Array<int32> SortingIndices;
-    Array<int32> SortedIndices;
-}
-
 class ParticleManagerService : public EngineService
 {
 public:
@@ -139,6 +175,7 @@ class ParticlesSystem : public TaskGraphSystem
 {
 public:
     float DeltaTime, UnscaledDeltaTime, Time, UnscaledTime;
+    void UpdateSimulationLODs();
     void Job(int32 index);
     void Execute(TaskGraph* graph) override;
     void PostExecute(TaskGraph* graph) override;
@@ -161,6 +198,125 @@ void Particles::OnEffectDestroy(ParticleEffect* effect)
 
 typedef Array<int32, FixedAllocation<PARTICLE_EMITTER_MAX_MODULES>> RenderModulesIndices;
 
+#if COMPILE_WITH_GPU_PARTICLES
+
+PACK_STRUCT(struct ParticleRibbonData {
+    uint32 ParticlesCount;
+    uint32 ParticleStride;
+    uint32 PositionOffset;
+    uint32 RibbonOrderOffset;
+    uint32 VertexOffset;
+    uint32 IndexOffset;
+    uint32 IndirectArgsOffset;
+    uint32 Dummy0;
+    });
+
+AssetReference<Shader> ParticleRibbonShader;
+GPUConstantBuffer* ParticleRibbonCB = nullptr;
+GPUShaderProgramCS* ParticleRibbonCS = nullptr;
+
+#if COMPILE_WITH_DEV_ENV
+
+void OnParticleRibbonShaderReloading(Asset* obj)
+{
+    ParticleRibbonCB = nullptr;
+    ParticleRibbonCS = nullptr;
+}
+
+#endif
+
+bool InitParticleRibbonGPU()
+{
+    if (!ParticleRibbonCS)
+    {
+        const auto& limits = GPUDevice::Instance->Limits;
+        if (!limits.HasCompute || !limits.HasDrawIndirect)
+            return true;
+        if (ParticleRibbonShader == nullptr)
+        {
+            ParticleRibbonShader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/ParticleRibbon"));
+            if (ParticleRibbonShader == nullptr)
+                return true;
+#if COMPILE_WITH_DEV_ENV
+            ParticleRibbonShader.Get()->OnReloading.Bind<OnParticleRibbonShaderReloading>();
+#endif
+        }
+
+        // Use CPU ribbons until shader gets loaded
+        if (!ParticleRibbonShader->IsLoaded())
+            return true;
+        const auto shader = ParticleRibbonShader->GetShader();
+        ParticleRibbonCB = shader->GetCB(0);
+        if (ParticleRibbonCB->GetSize() != sizeof(ParticleRibbonData))
+        {
+            REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 0, ParticleRibbonData);
+            return true;
+        }
+        ParticleRibbonCS = shader->GetCS("CS_GenerateRibbon");
+    }
+    return false;
+}
+
+bool GenerateRibbonsGPU(GPUContext* context, ParticleBuffer* buffer, const RenderModulesIndices& renderModulesIndices)
+{
+    auto emitter = buffer->Emitter;
+    if (buffer->CPU.RibbonOrder.IsEmpty() || InitParticleRibbonGPU())
+        return true;
+    PROFILE_GPU_CPU_NAMED("Ribbons");
+
+    // Prepare buffers (each ribbon module uses a dedicated range)
+    const int32 ribbonsCount = emitter->Graph.RibbonRenderingModules.Count();
+    const int32 capacity = buffer->Capacity;
+    if (!buffer->GPU.RibbonIndirectArgsBuffer)
+    {
+        buffer->GPU.RibbonOrderBuffer = GPUDevice::Instance->CreateBuffer(TEXT("RibbonOrderBuffer"));
+        if (buffer->GPU.RibbonOrderBuffer->Init(GPUBufferDescription::Buffer(ribbonsCount * capacity * sizeof(uint32), GPUBufferFlags::ShaderResource, PixelFormat::R32_UInt, nullptr, sizeof(uint32), GPUResourceUsage::Dynamic)))
+            return true;
+        buffer->GPU.RibbonVertexBuffer = GPUDevice::Instance->CreateBuffer(TEXT("RibbonVertexBuffer"));
+        if (buffer->GPU.RibbonVertexBuffer->Init(GPUBufferDescription::Buffer(ribbonsCount * capacity * 2 * sizeof(RibbonParticleVertex), GPUBufferFlags::VertexBuffer | GPUBufferFlags::UnorderedAccess, PixelFormat::R32G32B32A32_UInt, nullptr, sizeof(RibbonParticleVertex))))
+            return true;
+        buffer->GPU.RibbonIndexBuffer = GPUDevice::Instance->CreateBuffer(TEXT("RibbonIndexBuffer"));
+        if (buffer->GPU.RibbonIndexBuffer->Init(GPUBufferDescription::Buffer(ribbonsCount * capacity * 6 * sizeof(uint32), GPUBufferFlags::IndexBuffer | GPUBufferFlags::UnorderedAccess, PixelFormat::R32_UInt, nullptr, sizeof(uint32))))
+            return true;
+        buffer->GPU.RibbonIndirectArgsBuffer = GPUDevice::Instance->CreateBuffer(TEXT("RibbonIndirectArgsBuffer"));
+        if (buffer->GPU.RibbonIndirectArgsBuffer->Init(GPUBufferDescription::Raw(ribbonsCount * sizeof(GPUDrawIndexedIndirectArgs), GPUBufferFlags::Argument | GPUBufferFlags::UnorderedAccess)))
+            return true;
+    }
+
+    // Generate geometry for all ribbon modules
+    ParticleRibbonData data;
+    data.ParticlesCount = buffer->CPU.Count;
+    data.ParticleStride = buffer->Stride;
+    data.Dummy0 = 0;
+    context->BindSR(0, buffer->GPU.Buffer->View());
+    context->BindSR(1, buffer->GPU.RibbonOrderBuffer->View());
+    context->BindUA(0, buffer->GPU.RibbonVertexBuffer->View());
+    context->BindUA(1, buffer->GPU.RibbonIndexBuffer->View());
+    context->BindUA(2, buffer->GPU.RibbonIndirectArgsBuffer->View());
+    for (int32 index = 0; index < renderModulesIndices.Count(); index++)
+    {
+        auto module = emitter->Graph.RenderModules[renderModulesIndices[index]];
+        const int32 positionOffset = emitter->Graph.Layout.GetAttributeOffset(module->Attributes[0]);
+        if (module->TypeID != 404 || positionOffset == -1)
+            continue;
+        const int32 ribbonIndex = module->RibbonOrderOffset / capacity;
+        data.PositionOffset = positionOffset;
+        data.RibbonOrderOffset = module->RibbonOrderOffset;
+        data.VertexOffset = ribbonIndex * capacity * 2;
+        data.IndexOffset = ribbonIndex * capacity * 6;
+        data.IndirectArgsOffset = ribbonIndex * sizeof(GPUDrawIndexedIndirectArgs);
+        context->UpdateBuffer(buffer->GPU.RibbonOrderBuffer, buffer->CPU.RibbonOrder.Get() + module->RibbonOrderOffset, buffer->CPU.Count * sizeof(int32), module->RibbonOrderOffset * sizeof(int32));
+        context->UpdateCB(ParticleRibbonCB, &data);
+        context->BindCB(0, ParticleRibbonCB);
+        context->Dispatch(ParticleRibbonCS, 1, 1, 1);
+    }
+    context->ResetUA();
+    context->ResetSR();
+    return false;
+}
+
+#endif
+
 void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCall& drawCall, DrawPass drawModes, StaticFlags staticFlags, ParticleEmitterInstance& emitterData, const RenderModulesIndices& renderModulesIndices, int16 sortOrder)
 {
     // Skip if CPU buffer is empty
@@ -175,6 +331,13 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
         // Prepare sorting data
         if (!buffer->GPU.SortedIndices)
             buffer->AllocateSortBuffer();
+        const int32 listSize = buffer->CPU.Count;
+        Array<uint32, FrameAllocation> sortingKeys[2];
+        Array<int32, FrameAllocation> sortingIndices, sortedIndicesList;
+        sortingKeys[0].Resize(listSize);
+        sortingKeys[1].Resize(listSize);
+        sortingIndices.Resize(listSize);
+        sortedIndicesList.Resize(listSize);
 
         // Execute all sorting modules
         for (int32 moduleIndex = 0; moduleIndex < emitter->Graph.SortModules.Count(); moduleIndex++)
@@ -183,13 +346,7 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
             const int32 sortedIndicesOffset = module->SortedIndicesOffset;
             const auto sortMode = static_cast<ParticleSortMode>(module->Values[2].AsInt);
             const int32 stride = buffer->Stride;
-            const int32 listSize = buffer->CPU.Count;
-#define PREPARE_CACHE(list) (ParticlesDrawCPU::list).Clear(); (ParticlesDrawCPU::list).Resize(listSize)
-            PREPARE_CACHE(SortingKeys[0]);
-            PREPARE_CACHE(SortingKeys[1]);
-            PREPARE_CACHE(SortingIndices);
-#undef PREPARE_CACHE
-            uint32* sortedKeys = ParticlesDrawCPU::SortingKeys[0].Get();
+            uint32* sortedKeys = sortingKeys[0].Get();
             const uint32 sortKeyXor = sortMode != ParticleSortMode::CustomAscending ? MAX_uint32 : 0;
             switch (sortMode)
             {
@@ -263,15 +420,14 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
             // Generate sorting indices
             int32* sortedIndices;
             {
-                ParticlesDrawCPU::SortedIndices.Resize(listSize);
-                sortedIndices = ParticlesDrawCPU::SortedIndices.Get();
+                sortedIndices = sortedIndicesList.Get();
                 for (int i = 0; i < listSize; i++)
                     sortedIndices[i] = i;
             }
 
             // Sort keys with indices
             {
-                Sorting::RadixSort(sortedKeys, sortedIndices, ParticlesDrawCPU::SortingKeys[1].Get(), ParticlesDrawCPU::SortingIndices.Get(), listSize);
+                Sorting::RadixSort(sortedKeys, sortedIndices, sortingKeys[1].Get(), sortingIndices.Get(), listSize);
             }
 
             // Upload CPU particles indices
@@ -286,13 +442,18 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
         context->UpdateBuffer(buffer->GPU.Buffer, buffer->CPU.Buffer.Get(), buffer->CPU.Count * buffer->Stride);
     }
 
-    // Check if need to setup ribbon modules
+    // Check if need to setup ribbon modules (generate geometry with compute shader if possible)
+#if COMPILE_WITH_GPU_PARTICLES
+    const bool useGpuRibbons = emitter->Graph.RibbonRenderingModules.HasItems() && buffer->CPU.Count >= 2 && !GenerateRibbonsGPU(context, buffer, renderModulesIndices);
+#else
+    const bool useGpuRibbons = false;
+#endif
     int32 ribbonModuleIndex = 0;
     int32 ribbonModulesDrawIndicesPos = 0;
     int32 ribbonModulesDrawIndicesStart[PARTICLE_EMITTER_MAX_RIBBONS];
     int32 ribbonModulesDrawIndicesCount[PARTICLE_EMITTER_MAX_RIBBONS];
     int32 ribbonModulesSegmentCount[PARTICLE_EMITTER_MAX_RIBBONS];
-    if (emitter->Graph.RibbonRenderingModules.HasItems())
+    if (emitter->Graph.RibbonRenderingModules.HasItems() && !useGpuRibbons)
     {
         // Prepare ribbon data
         if (!buffer->GPU.RibbonIndexBufferDynamic)
@@ -478,7 +639,7 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
         // Ribbon Rendering
         case 404:
         {
-            if (ribbonModulesDrawIndicesCount[ribbonModuleIndex] == 0)
+            if (useGpuRibbons ? emitter->Graph.Layout.GetAttributeOffset(module->Attributes[0]) == -1 : ribbonModulesDrawIndicesCount[ribbonModuleIndex] == 0)
                 break;
             const auto material = (MaterialBase*)module->Assets[0].Get();
             const auto moduleDrawModes = module->Values.Count() > 6 ? (DrawPass)module->Values[6].AsInt : DrawPass::Default;
@@ -499,7 +660,7 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
             // Setup ribbon data
             auto& ribbon = drawCall.Particle.Ribbon;
             ribbon.UVTilingDistance = uvTilingDistance;
-            ribbon.SegmentCount = ribbonModulesSegmentCount[ribbonModuleIndex];
+            ribbon.SegmentCount = useGpuRibbons ? count - 1 : ribbonModulesSegmentCount[ribbonModuleIndex];
             ribbon.UVScaleX = uvScale.X;
             ribbon.UVScaleY = uvScale.Y;
             ribbon.UVOffsetX = uvOffset.X;
@@ -519,16 +680,27 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
             // TODO: invert particles rendering order if camera is closer to the ribbon end than start
 
             // Submit draw call
-            drawCall.Geometry.IndexBuffer = buffer->GPU.RibbonIndexBufferDynamic->GetBuffer();
-            drawCall.Geometry.VertexBuffers[0] = buffer->GPU.RibbonVertexBufferDynamic->GetBuffer();
             drawCall.Geometry.VertexBuffers[1] = nullptr;
             drawCall.Geometry.VertexBuffers[2] = nullptr;
             drawCall.Geometry.VertexBuffersOffsets[0] = 0;
             drawCall.Geometry.VertexBuffersOffsets[1] = 0;
             drawCall.Geometry.VertexBuffersOffsets[2] = 0;
-            drawCall.Draw.StartIndex = ribbonModulesDrawIndicesStart[ribbonModuleIndex];
-            drawCall.Draw.IndicesCount = ribbonModulesDrawIndicesCount[ribbonModuleIndex];
-            drawCall.InstanceCount = 1;
+            if (useGpuRibbons)
+            {
+                drawCall.Geometry.IndexBuffer = buffer->GPU.RibbonIndexBuffer;
+                drawCall.Geometry.VertexBuffers[0] = buffer->GPU.RibbonVertexBuffer;
+                drawCall.Draw.IndirectArgsBuffer = buffer->GPU.RibbonIndirectArgsBuffer;
+                drawCall.Draw.IndirectArgsOffset = module->RibbonOrderOffset / buffer->Capacity * sizeof(GPUDrawIndexedIndirectArgs);
+                drawCall.InstanceCount = 0;
+            }
+            else
+            {
+                drawCall.Geometry.IndexBuffer = buffer->GPU.RibbonIndexBufferDynamic->GetBuffer();
+                drawCall.Geometry.VertexBuffers[0] = buffer->GPU.RibbonVertexBufferDynamic->GetBuffer();
+                drawCall.Draw.StartIndex = ribbonModulesDrawIndicesStart[ribbonModuleIndex];
+                drawCall.Draw.IndicesCount = ribbonModulesDrawIndicesCount[ribbonModuleIndex];
+                drawCall.InstanceCount = 1;
+            }
             renderContext.List->AddDrawCall(renderContext, dp, staticFlags, drawCall, false, sortOrder);
 
             ribbonModuleIndex++;
@@ -576,12 +748,20 @@ PACK_STRUCT(struct GPUParticlesSortingData {
     uint32 ParticleCapacity;
     uint32 PositionOffset;
     uint32 CustomOffset;
+    uint32 IndirectArgsAddCount;
+    uint32 IndirectArgsThreadGroupSize;
+    uint32 IndirectArgsOffset;
+    uint32 Dummy0;
     Matrix PositionTransform;
     });
 
+// The minimum particles capacity of the emitter to use Radix Sort instead of Bitonic Sort for GPU particles sorting
+#define GPU_PARTICLES_RADIX_SORT_MIN_CAPACITY 16384
+
 AssetReference<Shader> GPUParticlesSorting;
 GPUConstantBuffer* GPUParticlesSortingCB;
 GPUShaderProgramCS* GPUParticlesSortingCS[3];
+GPUShaderProgramCS* GPUParticlesIndirectArgsCS;
 
 #if COMPILE_WITH_DEV_ENV
 
@@ -589,6 +769,7 @@ void OnShaderReloading(Asset* obj)
 {
     GPUParticlesSortingCB = nullptr;
     Platform::MemoryClear(GPUParticlesSortingCS, sizeof(GPUParticlesSortingCS));
+    GPUParticlesIndirectArgsCS = nullptr;
 }
 
 #endif
@@ -598,6 +779,51 @@ void CleanupGPUParticlesSorting()
     GPUParticlesSorting = nullptr;
 }
 
+bool InitGPUParticlesSorting()
+{
+    if (GPUParticlesSorting == nullptr)
+    {
+        // TODO: preload shader if platform supports GPU particles
+        GPUParticlesSorting = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/GPUParticlesSorting"));
+        if (GPUParticlesSorting == nullptr || GPUParticlesSorting->WaitForLoaded())
+            return true;
+#if COMPILE_WITH_DEV_ENV
+        GPUParticlesSorting.Get()->OnReloading.Bind<OnShaderReloading>();
+#endif
+    }
+    if (!GPUParticlesSortingCB)
+    {
+        if (!GPUParticlesSorting->IsLoaded())
+            return true;
+        const auto shader = GPUParticlesSorting->GetShader();
+        const StringAnsiView CS_Sort("CS_Sort");
+        GPUParticlesSortingCS[0] = shader->GetCS(CS_Sort, 0);
+        GPUParticlesSortingCS[1] = shader->GetCS(CS_Sort, 1);
+        GPUParticlesSortingCS[2] = shader->GetCS(CS_Sort, 2);
+        GPUParticlesIndirectArgsCS = shader->GetCS("CS_IndirectArgs");
+        GPUParticlesSortingCB = shader->GetCB(0);
+        ASSERT(GPUParticlesSortingCB);
+    }
+    return false;
+}
+
+void GenerateGPUParticlesIndirectArgs(GPUContext* context, ParticleBuffer* buffer, GPUBuffer* particlesBuffer, uint32 addCount, uint32 threadGroupSize, uint32 argsOffset)
+{
+    // Generate dispatch arguments on a GPU from the particles counter value to dispatch only the threads for alive particles
+    GPUParticlesSortingData data;
+    data.ParticleCounterOffset = buffer->GPU.ParticleCounterOffset;
+    data.ParticleCapacity = buffer->Capacity;
+    data.IndirectArgsAddCount = addCount;
+    data.IndirectArgsThreadGroupSize = threadGroupSize;
+    data.IndirectArgsOffset = argsOffset;
+    context->UpdateCB(GPUParticlesSortingCB, &data);
+    context->BindCB(0, GPUParticlesSortingCB);
+    context->BindSR(0, particlesBuffer->View());
+    context->BindUA(0, buffer->GPU.IndirectDispatchArgsBuffer->View());
+    context->Dispatch(GPUParticlesIndirectArgsCS, 1, 1, 1);
+    context->ResetUA();
+}
+
 void DrawEmitterGPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCall& drawCall, DrawPass drawModes, StaticFlags staticFlags, ParticleEmitterInstance& emitterData, const RenderModulesIndices& renderModulesIndices, int16 sortOrder)
 {
     const auto context = GPUDevice::Instance->GetMainContext();
@@ -609,32 +835,19 @@ void DrawEmitterGPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
         PROFILE_GPU_CPU_NAMED("Sort Particles");
 
         // Prepare pipeline
-        if (GPUParticlesSorting == nullptr)
-        {
-            // TODO: preload shader if platform supports GPU particles
-            GPUParticlesSorting = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/GPUParticlesSorting"));
-            if (GPUParticlesSorting == nullptr || GPUParticlesSorting->WaitForLoaded())
-                return;
-#if COMPILE_WITH_DEV_ENV
-            GPUParticlesSorting.Get()->OnReloading.Bind<OnShaderReloading>();
-#endif
-        }
-        if (!GPUParticlesSortingCB)
-        {
-            const auto shader = GPUParticlesSorting->GetShader();
-            const StringAnsiView CS_Sort("CS_Sort");
-            GPUParticlesSortingCS[0] = shader->GetCS(CS_Sort, 0);
-            GPUParticlesSortingCS[1] = shader->GetCS(CS_Sort, 1);
-            GPUParticlesSortingCS[2] = shader->GetCS(CS_Sort, 2);
-            GPUParticlesSortingCB = shader->GetCB(0);
-            ASSERT(GPUParticlesSortingCB);
-        }
+        if (InitGPUParticlesSorting())
+            return;
 
         // Prepare sorting data
         if (!buffer->GPU.SortedIndices)
             buffer->AllocateSortBuffer();
         ASSERT(buffer->GPU.SortingKeysBuffer);
 
+        // Generate sorting keys dispatch arguments from the particles count (shared by all sorting modules)
+        const int32 threadGroupSize = 1024;
+        const uint32 sortArgsOffset = sizeof(GPUDispatchIndirectArgs);
+        GenerateGPUParticlesIndirectArgs(context, buffer, buffer->GPU.Buffer, 0, threadGroupSize, sortArgsOffset);
+
         // Execute all sorting modules
         for (int32 moduleIndex = 0; moduleIndex < emitter->Graph.SortModules.Count(); moduleIndex++)
         {
@@ -705,12 +918,14 @@ void DrawEmitterGPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
             context->BindCB(0, GPUParticlesSortingCB);
             context->BindSR(0, buffer->GPU.Buffer->View());
             context->BindUA(0, buffer->GPU.SortingKeysBuffer->View());
-            // TODO: optimize it by using DispatchIndirect with shared invoke args generated after particles update
-            const int32 threadGroupSize = 1024;
-            context->Dispatch(GPUParticlesSortingCS[permutationIndex], Math::DivideAndRoundUp(buffer->GPU.ParticlesCountMax, threadGroupSize), 1, 1);
-
-            // Perform sorting
-            BitonicSort::Instance()->Sort(context, buffer->GPU.SortingKeysBuffer, buffer->GPU.Buffer, data.ParticleCounterOffset, sortAscending, buffer->GPU.SortedIndices);
+            context->DispatchIndirect(GPUParticlesSortingCS[permutationIndex], buffer->GPU.IndirectDispatchArgsBuffer, sortArgsOffset);
+            context->ResetUA();
+
+            // Perform sorting (Bitonic Sort is faster for small lists, Radix Sort scales linearly for the large ones)
+            if (buffer->Capacity >= GPU_PARTICLES_RADIX_SORT_MIN_CAPACITY)
+                RadixSort::Instance()->Sort(context, buffer->GPU.SortingKeysBuffer, buffer->GPU.Buffer, data.ParticleCounterOffset, sortAscending, buffer->GPU.SortedIndices);
+            else
+                BitonicSort::Instance()->Sort(context, buffer->GPU.SortingKeysBuffer, buffer->GPU.Buffer, data.ParticleCounterOffset, sortAscending, buffer->GPU.SortedIndices);
         }
     }
 
@@ -804,7 +1019,7 @@ void DrawEmitterGPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
                 if (!mesh.IsInitialized())
                     continue;
 
-                GPUDrawIndexedIndirectArgs indirectArgsBufferInitData = { (uint32)mesh.GetTriangleCount() * 3, 1, 0, 0, 0 };
+                GPUDrawIndexedIndirectArgs indirectArgsBufferInitData = { (uint32)mesh.GetTriangleCount() * 3, 1, mesh.GetIndexBufferStart(), 0, 0 };
                 const uint32 offset = indirectDrawCallIndex * sizeof(GPUDrawIndexedIndirectArgs);
                 context->UpdateBuffer(buffer->GPU.IndirectDrawArgsBuffer, &indirectArgsBufferInitData, sizeof(indirectArgsBufferInitData), offset);
                 const uint32 counterOffset = buffer->GPU.ParticleCounterOffset;
@@ -1051,15 +1266,16 @@ void UpdateGPU(RenderTask* task, GPUContext* context)
         return;
 
     PROFILE_GPU("GPU Particles");
+    const bool canUseIndirectArgs = !InitGPUParticlesSorting();
 
+    // Gather emitters to update
+    GpuEmitterUpdates.Clear();
     for (ParticleEffect* effect : GpuUpdateList)
     {
         auto& instance = effect->Instance;
         const auto particleSystem = effect->ParticleSystem.Get();
         if (!particleSystem || !particleSystem->IsLoaded())
             continue;
-
-        // Update all emitter tracks
         for (int32 j = 0; j < particleSystem->Tracks.Count(); j++)
         {
             const auto& track = particleSystem->Tracks[j];
@@ -1073,11 +1289,34 @@ void UpdateGPU(RenderTask* task, GPUContext* context)
             if (!data.Buffer)
                 continue;
             ASSERT(emitter->Capacity != 0 && emitter->Graph.Layout.Size != 0);
+            GpuEmitterUpdates.Add({ emitter, effect, emitterIndex });
+        }
+    }
+
+    // Batch updates of the emitters that share the same simulation shader to reduce pipeline state changes
+    Sorting::QuickSort(GpuEmitterUpdates.Get(), GpuEmitterUpdates.Count(), &GpuEmitterUpdate::SortByEmitter);
 
-            // TODO: use async context for particles to update them on compute during GBuffer rendering
-            emitter->GPU.Execute(context, emitter, effect, emitterIndex, data);
+    // Generate simulation dispatch arguments from the particles count (alive particles and the ones to spawn) for all emitters at once
+    if (canUseIndirectArgs)
+    {
+        for (const GpuEmitterUpdate& e : GpuEmitterUpdates)
+        {
+            ParticleEmitterInstance& data = e.Effect->Instance.Emitters[e.EmitterIndex];
+            if (!data.Buffer->GPU.PendingClear && data.Buffer->GPU.HasValidCount)
+            {
+                GenerateGPUParticlesIndirectArgs(context, data.Buffer, data.Buffer->GPU.Buffer, data.GPU.SpawnCount, 1024, 0);
+                data.Buffer->GPU.HasIndirectDispatchArgs = true;
+            }
         }
     }
+
+    // Run simulation
+    for (const GpuEmitterUpdate& e : GpuEmitterUpdates)
+    {
+        // TODO: use async context for particles to update them on compute during GBuffer rendering
+        e.Emitter->GPU.Execute(context, e.Emitter, e.Effect, e.EmitterIndex, e.Effect->Instance.Emitters[e.EmitterIndex]);
+    }
+    GpuEmitterUpdates.Clear();
     GpuUpdateList.Clear();
 
     context->ResetSR();
@@ -1095,27 +1334,24 @@ ParticleBuffer* Particles::AcquireParticleBuffer(ParticleEmitter* emitter)
     if (emitter->EnablePooling && EnableParticleBufferPooling)
     {
         PoolLocker.Lock();
-        const auto entries = Pool.TryGet(emitter);
-        if (entries)
+        const auto entries = Pool.TryGet(GetPoolKey(emitter));
+        if (entries && entries->HasItems())
         {
-            while (entries->HasItems())
+            // Prefer the most recently used buffer of the same emitter (skips sorting buffers reallocation), otherwise reuse any compatible buffer
+            int32 index = entries->Count() - 1;
+            for (int32 i = index; i >= 0; i--)
             {
-                // Reuse buffer
-                result = entries->Last().Buffer;
-                entries->RemoveLast();
-
-                // Remove old buffers
-                if (result->Version != emitter->Graph.Version)
+                const ParticleBuffer* buffer = entries->At(i).Buffer;
+                if (buffer->Emitter == emitter && buffer->Version == emitter->Graph.Version)
                 {
-                    Delete(result);
-                    result = nullptr;
-                    if (entries->IsEmpty())
-                    {
-                        Pool.Remove(emitter);
-                        break;
-                    }
+                    index = i;
+                    break;
                 }
             }
+            result = entries->At(index).Buffer;
+            entries->RemoveAtKeepOrder(index);
+            PoolMemory -= result->AllocatedSize;
+            RENDER_STAT_PARTICLE_BUFFERS_POOL_MEMORY(PoolMemory);
         }
         PoolLocker.Unlock();
     }
@@ -1130,16 +1366,54 @@ ParticleBuffer* Particles::AcquireParticleBuffer(ParticleEmitter* emitter)
             Delete(result);
             return nullptr;
         }
+        RENDER_STAT_PARTICLE_BUFFER_ACQUIRE(false);
     }
     else
     {
         // Prepare buffer
-        result->Clear();
+        result->Reuse(emitter);
+        RENDER_STAT_PARTICLE_BUFFER_ACQUIRE(true);
     }
 
     return result;
 }
 
+void Particles::PrewarmParticleBuffers(ParticleEmitter* emitter, int32 count)
+{
+    if (!emitter || !emitter->IsLoaded() || emitter->Capacity == 0 || emitter->Graph.Layout.Size == 0 || !emitter->EnablePooling || !EnableParticleBufferPooling)
+        return;
+    PROFILE_CPU();
+    const uint64 key = GetPoolKey(emitter);
+
+    // Count compatible buffers that are already pooled
+    PoolLocker.Lock();
+    const auto entries = Pool.TryGet(key);
+    const int32 pooled = entries ? entries->Count() : 0;
+    PoolLocker.Unlock();
+
+    // Allocate missing buffers
+    const double time = Platform::GetTimeSeconds();
+    for (int32 i = pooled; i < count; i++)
+    {
+        auto buffer = New<ParticleBuffer>();
+        if (buffer->Init(emitter))
+        {
+            LOG(Error, "Failed to create particle buffer for emitter {0}", emitter->ToString());
+            Delete(buffer);
+            return;
+        }
+        RENDER_STAT_PARTICLE_BUFFER_ACQUIRE(false);
+        EmitterCache c;
+        c.LastTimeUsed = time;
+        c.Buffer = buffer;
+        PoolLocker.Lock();
+        Pool[key].Add(c);
+        PoolMemory += buffer->AllocatedSize;
+        RENDER_STAT_PARTICLE_BUFFERS_POOL_MEMORY(PoolMemory);
+        PoolLocker.Unlock();
+    }
+}
+
 void Particles::RecycleParticleBuffer(ParticleBuffer* buffer)
 {
     if (buffer->Emitter->EnablePooling && EnableParticleBufferPooling)
@@ -1150,7 +1424,9 @@ void Particles::RecycleParticleBuffer(ParticleBuffer* buffer)
         c.Buffer = buffer;
 
         PoolLocker.Lock();
-        Pool[buffer->Emitter].Add(c);
+        Pool[GetPoolKey(buffer->Mode, buffer->AllocatedSize)].Add(c);
+        PoolMemory += buffer->AllocatedSize;
+        RENDER_STAT_PARTICLE_BUFFERS_POOL_MEMORY(PoolMemory);
         PoolLocker.Unlock();
     }
     else
@@ -1163,16 +1439,21 @@ void Particles::RecycleParticleBuffer(ParticleBuffer* buffer)
 void Particles::OnEmitterUnload(ParticleEmitter* emitter)
 {
     PoolLocker.Lock();
-    const auto entries = Pool.TryGet(emitter);
-    if (entries)
+    for (auto i = Pool.Begin(); i.IsNotEnd(); ++i)
     {
-        for (int32 i = 0; i < entries->Count(); i++)
+        auto& entries = i->Value;
+        for (int32 j = entries.Count() - 1; j >= 0; j--)
         {
-            Delete(entries->At(i).Buffer);
+            if (entries[j].Buffer->Emitter == emitter)
+            {
+                DeletePooledBuffer(entries[j].Buffer);
+                entries.RemoveAtKeepOrder(j);
+            }
         }
-        entries->Clear();
-        Pool.Remove(emitter);
+        if (entries.IsEmpty())
+            Pool.Remove(i);
     }
+    RENDER_STAT_PARTICLE_BUFFERS_POOL_MEMORY(PoolMemory);
     PoolLocker.Unlock();
 
 #if COMPILE_WITH_GPU_PARTICLES
@@ -1199,6 +1480,7 @@ void ParticleManagerService::Dispose()
     UpdateList.Clear();
 #if COMPILE_WITH_GPU_PARTICLES
     GpuUpdateList.Clear();
+    GpuEmitterUpdates.SetCapacity(0);
     if (GpuRenderTask)
     {
         ScopeLock lock(RenderTask::TasksLocker);
@@ -1207,32 +1489,115 @@ void ParticleManagerService::Dispose()
         GpuRenderTask = nullptr;
     }
     CleanupGPUParticlesSorting();
+    ParticleRibbonShader = nullptr;
 #endif
-    ParticlesDrawCPU::SortingKeys[0].SetCapacity(0);
-    ParticlesDrawCPU::SortingKeys[1].SetCapacity(0);
-    ParticlesDrawCPU::SortingIndices.SetCapacity(0);
-    ParticlesDrawCPU::SortedIndices.SetCapacity(0);
-
     PoolLocker.Lock();
     for (auto i = Pool.Begin(); i.IsNotEnd(); ++i)
     {
         auto& entries = i->Value;
         for (int32 j = 0; j < entries.Count(); j++)
         {
-            Delete(entries[j].Buffer);
+            DeletePooledBuffer(entries[j].Buffer);
         }
         entries.Clear();
     }
     Pool.Clear();
+    RENDER_STAT_PARTICLE_BUFFERS_POOL_MEMORY(PoolMemory);
     PoolLocker.Unlock();
 
     SpriteRenderer.Dispose();
     SAFE_DELETE(Particles::System);
 }
 
+bool SortBySignificance(ParticleEffect* const& a, ParticleEffect* const& b)
+{
+    // Effects excluded from the budget go first
+    if (a->UseSimulationBudget != b->UseSimulationBudget)
+        return !a->UseSimulationBudget;
+    return a->GetSignificance() > b->GetSignificance();
+}
+
+void ParticlesSystem::UpdateSimulationLODs()
+{
+    PROFILE_CPU();
+    typedef ParticleEffect::SimulationLODs LODs;
+
+    // Calculate effects significance (from the last frame visibility and screen size) and distance-based detail level
+    for (ParticleEffect* effect : UpdateList)
+    {
+        const bool isVisible = effect->_lastVisibleDstSqr < MAX_Real;
+        effect->_significance = isVisible ? effect->_lastVisibleScreenSize * effect->SignificanceScale : 0.0f;
+        effect->_simulationLOD = LODs::Full;
+        if (effect->SimulationLODDistance > 0.0f && (!isVisible || effect->_lastVisibleDstSqr > Math::Square((Real)effect->SimulationLODDistance)))
+            effect->_simulationLOD = LODs::ReducedRate;
+    }
+
+    // Degrade the least significant effects that exceed the global budget (the more the budget is exceeded, the more the simulation is reduced)
+    if (Particles::MaxSimulatedParticles > 0 || Particles::MaxUpdatedEmitters > 0)
+    {
+        Sorting::QuickSort(UpdateList.Get(), UpdateList.Count(), &SortBySignificance);
+        const float maxParticles = Particles::MaxSimulatedParticles > 0 ? (float)Particles::MaxSimulatedParticles : MAX_float;
+        const float maxEmitters = Particles::MaxUpdatedEmitters > 0 ? (float)Particles::MaxUpdatedEmitters : MAX_float;
+        int32 particles = 0, emitters = 0;
+        for (ParticleEffect* effect : UpdateList)
+        {
+            for (const auto& emitter : effect->Instance.Emitters)
+            {
+                if (!emitter.Buffer)
+                    continue;
+                emitters++;
+                if (emitter.Buffer->Mode == ParticlesSimulationMode::CPU)
+                    particles += emitter.Buffer->CPU.Count;
+            }
+            if (!effect->UseSimulationBudget)
+                continue;
+            const float budgetUsage = Math::Max((float)particles / maxParticles, (float)emitters / maxEmitters);
+            LODs lod = LODs::Full;
+            if (budgetUsage > 2.0f)
+                lod = LODs::Paused;
+            else if (budgetUsage > 1.5f)
+                lod = LODs::ReducedRate;
+            else if (budgetUsage > 1.0f)
+                lod = LODs::ReducedSpawn;
+            if (lod > effect->_simulationLOD)
+                effect->_simulationLOD = lod;
+        }
+    }
+
+    // Skip updates of the reduced effects
+    const uint64 frame = Engine::FrameCount;
+    for (int32 i = UpdateList.Count() - 1; i >= 0; i--)
+    {
+        ParticleEffect* effect = UpdateList[i];
+        switch (effect->_simulationLOD)
+        {
+        case LODs::ReducedRate:
+            // Spread effects updates over frames (delta time accumulates since the last update)
+            if ((frame + effect->GetID().A) % ReducedRateFrames != 0)
+                UpdateList.RemoveAt(i);
+            break;
+        case LODs::Paused:
+        {
+            // Move update timer forward while paused for correct delta time after unpause
+            bool useTimeScale = effect->UseTimeScale;
+#if USE_EDITOR
+            if (!Editor::IsPlayMode)
+                useTimeScale = false;
+#endif
+            effect->Instance.LastUpdateTime = useTimeScale ? Time : UnscaledTime;
+            UpdateList.RemoveAt(i);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
 void ParticlesSystem::Job(int32 index)
 {
-    PROFILE_CPU_NAMED("Particles.Job");
+    PROFILE_CPU_CAT_NAMED(PARTICLES, "Particles.Job");
+    PROFILE_MEM(Particles);
     auto effect = UpdateList[index];
     auto& instance = effect->Instance;
     const auto particleSystem = effect->ParticleSystem.Get();
@@ -1397,6 +1762,11 @@ void ParticlesSystem::Execute(TaskGraph* graph)
     Time = tickData.Time.GetTotalSeconds();
     UnscaledTime = tickData.UnscaledTime.GetTotalSeconds();
 
+    // Apply simulation budgets
+    UpdateSimulationLODs();
+    if (UpdateList.Count() == 0)
+        return;
+
     // Schedule work to update all particles in async
     Function<void(int32)> job;
     job.Bind<ParticlesSystem, &ParticlesSystem::Job>(this);
@@ -1406,6 +1776,7 @@ void ParticlesSystem::Execute(TaskGraph* graph)
 void ParticlesSystem::PostExecute(TaskGraph* graph)
 {
     PROFILE_CPU_NAMED("Particles.PostExecute");
+    PROFILE_MEM(Particles);
 
     UpdateList.Clear();
 
@@ -1437,13 +1808,28 @@ void ParticlesSystem::PostExecute(TaskGraph* graph)
             auto& e = entries[j];
             if (timeSeconds - e.LastTimeUsed >= Particles::ParticleBufferRecycleTimeout)
             {
-                Delete(e.Buffer);
-                entries.RemoveAt(j--);
+                DeletePooledBuffer(e.Buffer);
+                entries.RemoveAtKeepOrder(j--);
             }
         }
 
         if (entries.IsEmpty())
             Pool.Remove(i);
     }
+    while (Particles::ParticleBufferPoolBudget > 0 && PoolMemory > Particles::ParticleBufferPoolBudget)
+    {
+        // Release the least recently used buffer (the first one in each size class list is the oldest)
+        Array<EmitterCache>* oldest = nullptr;
+        for (auto i = Pool.Begin(); i.IsNotEnd(); ++i)
+        {
+            if (i->Value.HasItems() && (!oldest || i->Value.First().LastTimeUsed < oldest->First().LastTimeUsed))
+                oldest = &i->Value;
+        }
+        if (!oldest)
+            break;
+        DeletePooledBuffer(oldest->First().Buffer);
+        oldest->RemoveAtKeepOrder(0);
+    }
+    RENDER_STAT_PARTICLE_BUFFERS_POOL_MEMORY(PoolMemory);
     PoolLocker.Unlock();
 }
@@ -59,6 +59,21 @@ API_CLASS(Static) class FLAXENGINE_API Particles
     /// </summary>
     static float ParticleBufferRecycleTimeout;
 
+    /// <summary>
+    /// The maximum memory (in bytes) used by the pooled (unused) particle buffers. The least recently used buffers above the budget are released. Use 0 to disable the limit.
+    /// </summary>
+    static int64 ParticleBufferPoolBudget;
+
+    /// <summary>
+    /// The maximum amount of CPU particles simulated during a single frame. Least significant effects above the budget get reduced spawn rate, lower update frequency or paused simulation. Use 0 to disable the limit.
+    /// </summary>
+    static int32 MaxSimulatedParticles;
+
+    /// <summary>
+    /// The maximum amount of particle emitters updated during a single frame. Least significant effects above the budget get reduced spawn rate, lower update frequency or paused simulation. Use 0 to disable the limit.
+    /// </summary>
+    static int32 MaxUpdatedEmitters;
+
     /// <summary>
     /// Acquires the free particle buffer for the emitter instance data.
     /// </summary>
@@ -66,6 +81,13 @@ API_CLASS(Static) class FLAXENGINE_API Particles
     /// <returns>The particle buffer.</returns>
     static ParticleBuffer* AcquireParticleBuffer(ParticleEmitter* emitter);
 
+    /// <summary>
+    /// Allocates the particle buffers for the emitter up-front and returns them to the pool, so spawning effects later doesn't allocate GPU resources. Pooled buffers are shared by the emitters with the same simulation mode and data size class.
+    /// </summary>
+    /// <param name="emitter">The emitter.</param>
+    /// <param name="count">The amount of buffers to ensure in the pool.</param>
+    static void PrewarmParticleBuffers(ParticleEmitter* emitter, int32 count = 1);
+
     /// <summary>
     /// Recycles the used particle buffer.
     /// </summary>
@@ -4,6 +4,7 @@
 #include "ParticleEmitter.h"
 #include "Engine/Graphics/GPUBuffer.h"
 #include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPUContext.h"
 #include "Engine/Graphics/DynamicBuffer.h"
 
 ParticleBuffer::ParticleBuffer()
@@ -15,10 +16,15 @@ ParticleBuffer::~ParticleBuffer()
     SAFE_DELETE_GPU_RESOURCE(GPU.Buffer);
     SAFE_DELETE_GPU_RESOURCE(GPU.BufferSecondary);
     SAFE_DELETE_GPU_RESOURCE(GPU.IndirectDrawArgsBuffer);
+    SAFE_DELETE_GPU_RESOURCE(GPU.IndirectDispatchArgsBuffer);
     SAFE_DELETE_GPU_RESOURCE(GPU.SortingKeysBuffer);
     SAFE_DELETE_GPU_RESOURCE(GPU.SortedIndices);
     SAFE_DELETE(GPU.RibbonIndexBufferDynamic);
     SAFE_DELETE(GPU.RibbonVertexBufferDynamic);
+    SAFE_DELETE_GPU_RESOURCE(GPU.RibbonOrderBuffer);
+    SAFE_DELETE_GPU_RESOURCE(GPU.RibbonVertexBuffer);
+    SAFE_DELETE_GPU_RESOURCE(GPU.RibbonIndexBuffer);
+    SAFE_DELETE_GPU_RESOURCE(GPU.RibbonIndirectArgsBuffer);
 }
 
 bool ParticleBuffer::Init(ParticleEmitter* emitter)
@@ -33,15 +39,16 @@ bool ParticleBuffer::Init(ParticleEmitter* emitter)
     Mode = emitter->SimulationMode;
 
     const int32 size = Capacity * Stride;
+    AllocatedSize = GetSizeClass(GetRequiredSize(emitter));
     switch (Mode)
     {
     case ParticlesSimulationMode::CPU:
     {
         CPU.Count = 0;
-        CPU.Buffer.Resize(size);
+        CPU.Buffer.Resize(AllocatedSize);
         CPU.RibbonOrder.Resize(0);
         GPU.Buffer = GPUDevice::Instance->CreateBuffer(TEXT("ParticleBuffer"));
-        if (GPU.Buffer->Init(GPUBufferDescription::Raw(size, GPUBufferFlags::ShaderResource, GPUResourceUsage::Dynamic)))
+        if (GPU.Buffer->Init(GPUBufferDescription::Raw(AllocatedSize, GPUBufferFlags::ShaderResource, GPUResourceUsage::Dynamic)))
             return true;
         break;
     }
@@ -56,14 +63,18 @@ bool ParticleBuffer::Init(ParticleEmitter* emitter)
 
         // Particle data buffer: attributes + counter + custom data
         GPU.Buffer = GPUDevice::Instance->CreateBuffer(TEXT("ParticleBuffer A"));
-        if (GPU.Buffer->Init(GPUBufferDescription::Raw(size + sizeof(uint32) + emitter->GPU.CustomDataSize, GPUBufferFlags::ShaderResource | GPUBufferFlags::UnorderedAccess)))
+        if (GPU.Buffer->Init(GPUBufferDescription::Raw(AllocatedSize, GPUBufferFlags::ShaderResource | GPUBufferFlags::UnorderedAccess)))
             return true;
         GPU.BufferSecondary = GPUDevice::Instance->CreateBuffer(TEXT("ParticleBuffer B"));
         if (GPU.BufferSecondary->Init(GPU.Buffer->GetDescription()))
             return true;
         GPU.IndirectDrawArgsBuffer = GPUDevice::Instance->CreateBuffer(TEXT("ParticleIndirectDrawArgsBuffer"));
+        GPU.IndirectDispatchArgsBuffer = GPUDevice::Instance->CreateBuffer(TEXT("ParticleIndirectDispatchArgsBuffer"));
+        if (GPU.IndirectDispatchArgsBuffer->Init(GPUBufferDescription::Raw(sizeof(GPUDispatchIndirectArgs) * 2, GPUBufferFlags::Argument | GPUBufferFlags::UnorderedAccess)))
+            return true;
         GPU.PendingClear = true;
         GPU.HasValidCount = false;
+        GPU.HasIndirectDispatchArgs = false;
         GPU.ParticleCounterOffset = size;
         GPU.ParticlesCountMax = 0;
         break;
@@ -76,6 +87,58 @@ bool ParticleBuffer::Init(ParticleEmitter* emitter)
     return false;
 }
 
+bool ParticleBuffer::CanReuse(ParticleEmitter* emitter) const
+{
+    return Mode == emitter->SimulationMode && AllocatedSize >= GetRequiredSize(emitter);
+}
+
+void ParticleBuffer::Reuse(ParticleEmitter* emitter)
+{
+    ASSERT(emitter && emitter->IsLoaded() && CanReuse(emitter));
+
+    // Sorting and ribbon buffers depend on the emitter capacity and modules (allocated on demand)
+    if (Emitter != emitter || Version != emitter->Graph.Version)
+    {
+        SAFE_DELETE_GPU_RESOURCE(GPU.SortingKeysBuffer);
+        SAFE_DELETE_GPU_RESOURCE(GPU.SortedIndices);
+        SAFE_DELETE_GPU_RESOURCE(GPU.RibbonOrderBuffer);
+        SAFE_DELETE_GPU_RESOURCE(GPU.RibbonVertexBuffer);
+        SAFE_DELETE_GPU_RESOURCE(GPU.RibbonIndexBuffer);
+        SAFE_DELETE_GPU_RESOURCE(GPU.RibbonIndirectArgsBuffer);
+    }
+
+    Version = emitter->Graph.Version;
+    Capacity = emitter->Capacity;
+    Emitter = emitter;
+    Layout = &emitter->Graph.Layout;
+    Stride = Layout->Size;
+#if COMPILE_WITH_GPU_PARTICLES
+    if (Mode == ParticlesSimulationMode::GPU)
+        GPU.ParticleCounterOffset = Capacity * Stride;
+#endif
+    Clear();
+}
+
+int32 ParticleBuffer::GetRequiredSize(ParticleEmitter* emitter)
+{
+    int32 size = emitter->Capacity * emitter->Graph.Layout.Size;
+#if COMPILE_WITH_GPU_PARTICLES
+    if (emitter->SimulationMode == ParticlesSimulationMode::GPU)
+    {
+        // Particles counter + custom data
+        size += sizeof(uint32) + emitter->GPU.CustomDataSize;
+    }
+#endif
+    return size;
+}
+
+int32 ParticleBuffer::GetSizeClass(int32 size)
+{
+    size = Math::Max(size, 4 * 1024);
+    const int32 step = (1 << Math::FloorLog2((uint32)size)) / 4;
+    return Math::AlignUp(size, step);
+}
+
 bool ParticleBuffer::AllocateSortBuffer()
 {
     ASSERT(Emitter && GPU.SortedIndices == nullptr && GPU.SortingKeysBuffer == nullptr);
@@ -128,6 +191,7 @@ void ParticleBuffer::Clear()
     {
         GPU.PendingClear = true;
         GPU.HasValidCount = false;
+        GPU.HasIndirectDispatchArgs = false;
         break;
     }
 #endif
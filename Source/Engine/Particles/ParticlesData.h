@@ -236,6 +236,11 @@ class FLAXENGINE_API ParticleBuffer
     /// </summary>
     ParticlesSimulationMode Mode;
 
+    /// <summary>
+    /// The size of the particles data allocation (in bytes). Rounded up to the pooling size class so the buffer can be reused by other emitters with similar data size.
+    /// </summary>
+    int32 AllocatedSize;
+
     /// <summary>
     /// The emitter.
     /// </summary>
@@ -284,6 +289,11 @@ class FLAXENGINE_API ParticleBuffer
         /// </summary>
         GPUBuffer* IndirectDrawArgsBuffer = nullptr;
 
+        /// <summary>
+        /// The indirect dispatch arguments buffer used by the GPU particles to invoke simulation and sorting on a GPU based on the particles amount. Contains two GPUDispatchIndirectArgs entries: simulation update and sorting keys generation.
+        /// </summary>
+        GPUBuffer* IndirectDispatchArgsBuffer = nullptr;
+
         /// <summary>
         /// The GPU particles sorting buffer. Contains structure of particle index and the sorting key for every particle. Used to sort particles.
         /// </summary>
@@ -307,6 +317,26 @@ class FLAXENGINE_API ParticleBuffer
         /// </summary>
         DynamicVertexBuffer* RibbonVertexBufferDynamic = nullptr;
 
+        /// <summary>
+        /// The ribbon particles order buffer (uploaded from CPU.RibbonOrder). Used to generate ribbons geometry for CPU particles with a compute shader.
+        /// </summary>
+        GPUBuffer* RibbonOrderBuffer = nullptr;
+
+        /// <summary>
+        /// The ribbon particles rendering vertex buffer generated by a compute shader.
+        /// </summary>
+        GPUBuffer* RibbonVertexBuffer = nullptr;
+
+        /// <summary>
+        /// The ribbon particles rendering index buffer generated by a compute shader.
+        /// </summary>
+        GPUBuffer* RibbonIndexBuffer = nullptr;
+
+        /// <summary>
+        /// The indirect draw command arguments buffer for the ribbons geometry generated by a compute shader (one entry per ribbon module).
+        /// </summary>
+        GPUBuffer* RibbonIndirectArgsBuffer = nullptr;
+
         /// <summary>
         /// The flag used to indicate that GPU buffers data should be cleared before next simulation.
         /// </summary>
@@ -317,6 +347,11 @@ class FLAXENGINE_API ParticleBuffer
         /// </summary>
         bool HasValidCount;
 
+        /// <summary>
+        /// The flag used to indicate that IndirectDispatchArgsBuffer contains valid simulation update arguments generated for the next simulation.
+        /// </summary>
+        bool HasIndirectDispatchArgs;
+
         /// <summary>
         /// The particle counter (uint type) offset. Located in Buffer and BufferSecondary if GPU particles simulation is used to store the particles count in the buffer. Placed after the particle attributes.
         /// </summary>
@@ -346,6 +381,33 @@ class FLAXENGINE_API ParticleBuffer
     /// <returns>True if failed, otherwise false.</returns>
     bool Init(ParticleEmitter* emitter);
 
+    /// <summary>
+    /// Checks if the buffer can be reused for the specified emitter (the same simulation mode and big enough allocation).
+    /// </summary>
+    /// <param name="emitter">The emitter.</param>
+    /// <returns>True if buffer can be reused, otherwise false.</returns>
+    bool CanReuse(ParticleEmitter* emitter) const;
+
+    /// <summary>
+    /// Reinitializes the already allocated particle buffer for the specified emitter. Buffer has to be compatible (see CanReuse).
+    /// </summary>
+    /// <param name="emitter">The emitter.</param>
+    void Reuse(ParticleEmitter* emitter);
+
+    /// <summary>
+    /// Gets the size of the particles data (in bytes) required by the emitter.
+    /// </summary>
+    /// <param name="emitter">The emitter.</param>
+    /// <returns>The data size (in bytes).</returns>
+    static int32 GetRequiredSize(ParticleEmitter* emitter);
+
+    /// <summary>
+    /// Rounds up the particles data size to the pooling size class. Size classes use 4 steps per power of two so the allocation wastes up to 25% of memory but can be shared by emitters with different layouts and capacities.
+    /// </summary>
+    /// <param name="size">The data size (in bytes).</param>
+    /// <returns>The size class allocation size (in bytes).</returns>
+    static int32 GetSizeClass(int32 size);
+
     /// <summary>
     /// Allocates the particles sorting indices buffer.
     /// </summary>
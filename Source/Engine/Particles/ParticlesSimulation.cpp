@@ -7,6 +7,7 @@
 #include "Engine/Graphics/GPUBuffer.h"
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Core/Types/CommonValue.h"
+#include "Engine/Core/RandomStream.h"
 
 ParticleEmitterInstance::ParticleEmitterInstance()
 {
@@ -26,6 +27,7 @@ void ParticleEmitterInstance::ClearState()
     Time = 0;
     SpawnModulesData.Clear();
     CustomData.Clear();
+    RandomSeed = 0;
 #if COMPILE_WITH_GPU_PARTICLES
     GPU.DeltaTime = 0.0f;
     GPU.SpawnCount = 0;
@@ -73,6 +75,14 @@ void ParticleEmitterInstance::Sync(ParticleSystemInstance& systemInstance, Parti
             CustomData.Resize(emitter->Graph.CustomDataSize, false);
             Platform::MemoryClear(CustomData.Get(), CustomData.Count());
         }
+
+        // Initialize the random numbers generator (the same system seed gives the same emitters simulation)
+        RandomStream random;
+        if (systemInstance.RandomSeed != 0)
+            random.Initialize((int32)(systemInstance.RandomSeed + (uint32)emitterIndex * 0x9E3779B9));
+        else
+            random.GenerateNewSeed();
+        RandomSeed = random.GetUnsignedInt();
     }
 
     // Sync buffer version
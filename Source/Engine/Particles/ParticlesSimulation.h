@@ -84,6 +84,11 @@ class FLAXENGINE_API ParticleEmitterInstance
     /// </summary>
     Array<byte> CustomData;
 
+    /// <summary>
+    /// The seed of the random numbers generator used by the particles simulation. Advanced with every simulation update so the same seed and the same update steps result in the same particles.
+    /// </summary>
+    uint32 RandomSeed = 0;
+
     struct
     {
         /// <summary>
@@ -153,6 +158,11 @@ class FLAXENGINE_API ParticleSystemInstance
     /// </summary>
     float LastUpdateTime = -1;
 
+    /// <summary>
+    /// The seed used to initialize the emitters random numbers generators. Value 0 uses a random seed for every simulation reset. Not cleared by the state reset.
+    /// </summary>
+    uint32 RandomSeed = 0;
+
     /// <summary>
     /// The particle system emitters data (one per emitter instance).
     /// </summary>
@@ -11,6 +11,7 @@ RigidBody::RigidBody(const SpawnParams& params)
     : Actor(params)
     , _actor(nullptr)
     , _cachedScale(1.0f)
+    , _sceneIndex(-1)
     , _mass(1.0f)
     , _linearDamping(0.01f)
     , _angularDamping(0.05f)
@@ -506,6 +507,7 @@ void RigidBody::BeginPlay(SceneBeginData* data)
 
     // Register actor
     PhysicsBackend::AddSceneActor(scene, _actor);
+    GetPhysicsScene()->AddRigidBody(this);
     const bool putToSleep = !_startAwake && GetEnableSimulation() && !GetIsKinematic() && IsActiveInHierarchy();
     if (putToSleep)
         PhysicsBackend::AddSceneActorAction(scene, _actor, PhysicsBackend::ActionType::Sleep);
@@ -525,6 +527,7 @@ void RigidBody::EndPlay()
     if (_actor)
     {
         // Remove actor
+        GetPhysicsScene()->RemoveRigidBody(this);
         void* scene = GetPhysicsScene()->GetPhysicsScene();
         PhysicsBackend::RemoveSceneActor(scene, _actor);
         PhysicsBackend::DestroyActor(_actor);
@@ -570,8 +573,10 @@ void RigidBody::OnTransformChanged()
 void RigidBody::OnPhysicsSceneChanged(PhysicsScene* previous)
 {
     PhysicsBackend::RemoveSceneActor(previous->GetPhysicsScene(), _actor, true);
+    previous->RemoveRigidBody(this);
     void* scene = GetPhysicsScene()->GetPhysicsScene();
     PhysicsBackend::AddSceneActor(scene, _actor);
+    GetPhysicsScene()->AddRigidBody(this);
     const bool putToSleep = !_startAwake && GetEnableSimulation() && !GetIsKinematic() && IsActiveInHierarchy();
     if (putToSleep)
         PhysicsBackend::AddSceneActorAction(scene, _actor, PhysicsBackend::ActionType::Sleep);
@@ -18,9 +18,11 @@ API_CLASS(Attributes="ActorContextMenu(\"New/Physics/Rigid Body\"), ActorToolbox
 class FLAXENGINE_API RigidBody : public Actor, public IPhysicsActor
 {
     DECLARE_SCENE_OBJECT(RigidBody);
+    friend PhysicsScene;
 protected:
     void* _actor;
     Float3 _cachedScale;
+    int32 _sceneIndex;
 
     float _mass;
     float _linearDamping;
@@ -8,6 +8,8 @@
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Utilities.h"
 #include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Level/Level.h"
+#include "Engine/Level/Scene/Scene.h"
 #include "Engine/Physics/CollisionData.h"
 #include "Engine/Physics/PhysicalMaterial.h"
 #include "Engine/Physics/PhysicsScene.h"
@@ -21,14 +23,17 @@
 #include "Engine/Physics/Joints/SphericalJoint.h"
 #include "Engine/Physics/Joints/D6Joint.h"
 #include "Engine/Physics/Colliders/Collider.h"
-#include "Engine/Platform/CPUInfo.h"
 #include "Engine/Platform/CriticalSection.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Serialization/WriteStream.h"
+#include "Engine/Threading/JobSystem.h"
 #include <ThirdParty/PhysX/PxPhysicsAPI.h>
 #include <ThirdParty/PhysX/PxQueryFiltering.h>
 #include <ThirdParty/PhysX/extensions/PxFixedJoint.h>
 #include <ThirdParty/PhysX/extensions/PxSphericalJoint.h>
+#if WITH_PHYSX_GPU && !PX_SUPPORT_GPU_PHYSX
+#undef WITH_PHYSX_GPU
+#endif
 #if WITH_VEHICLE
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Physics/Actors/WheeledVehicle.h"
@@ -44,7 +49,6 @@
 #endif
 #if WITH_CLOTH
 #include "Engine/Physics/Actors/Cloth.h"
-#include "Engine/Threading/JobSystem.h"
 #include "Engine/Threading/Threading.h"
 #include <ThirdParty/NvCloth/Callbacks.h>
 #include <ThirdParty/NvCloth/Factory.h>
@@ -78,6 +82,48 @@ struct ActionDataPhysX
     PxActor* Actor;
 };
 
+#if COMPILE_WITH_PROFILER
+
+enum class SceneQueryTypePhysX
+{
+    RayCast,
+    Sweep,
+    Overlap,
+    MAX
+};
+
+struct SceneQueryStatsPhysX
+{
+    volatile int64 Count = 0;
+    volatile int64 Cycles = 0;
+};
+
+struct ScopeSceneQueryPhysX
+{
+    SceneQueryStatsPhysX& Stats;
+    uint64 StartCycles;
+
+    FORCE_INLINE ScopeSceneQueryPhysX(SceneQueryStatsPhysX& stats)
+        : Stats(stats)
+        , StartCycles(Platform::GetTimeCycles())
+    {
+    }
+
+    FORCE_INLINE ~ScopeSceneQueryPhysX()
+    {
+        Platform::InterlockedIncrement(&Stats.Count);
+        Platform::InterlockedAdd(&Stats.Cycles, (int64)(Platform::GetTimeCycles() - StartCycles));
+    }
+};
+
+#define SCENE_QUERY_STATS(type) ScopeSceneQueryPhysX sceneQueryStats(scenePhysX->QueryStats[(int32)SceneQueryTypePhysX::type])
+
+#else
+
+#define SCENE_QUERY_STATS(type)
+
+#endif
+
 struct ScenePhysX
 {
     PxScene* Scene = nullptr;
@@ -100,11 +146,17 @@ struct ScenePhysX
 #if WITH_CLOTH
     nv::cloth::Solver* ClothSolver = nullptr;
     Array<nv::cloth::Cloth*> ClothsList;
+    Array<bool> ClothsBroken;
+#endif
+#if COMPILE_WITH_PROFILER
+    SceneQueryStatsPhysX QueryStats[(int32)SceneQueryTypePhysX::MAX];
+    SceneQueryStatsPhysX LastQueryStats[(int32)SceneQueryTypePhysX::MAX];
 #endif
 
 #if WITH_CLOTH
     void PreSimulateCloth(int32 i);
     void SimulateCloth(int32 i);
+    void PostSimulateCloth(int32 i);
 #endif
 };
 
@@ -130,28 +182,59 @@ class ErrorPhysX : public PxErrorCallback
     }
 };
 
-#if WITH_CLOTH
-
-class AssertPhysX : public nv::cloth::PxAssertHandler
+class ProfilerPhysX : public PxProfilerCallback
 {
 public:
-    void operator()(const char* exp, const char* file, int line, bool& ignore) override
+    void* zoneStart(const char* eventName, bool detached, uint64_t contextId) override
     {
-        Platform::Error(String(exp));
-        Platform::Crash(line, file);
+#if COMPILE_WITH_PROFILER
+        // Forward the simulation stages (broad phase, narrow phase, solver, CCD, etc.) to the engine profiler (cross-thread zones are skipped)
+        if (!detached && ProfilerCPU::Enabled)
+            return (void*)(intptr)(ProfilerCPU::BeginEvent(eventName) + 1);
+#endif
+        return nullptr;
+    }
+
+    void zoneEnd(void* profilerData, const char* eventName, bool detached, uint64_t contextId) override
+    {
+#if COMPILE_WITH_PROFILER
+        if (profilerData)
+            ProfilerCPU::EndEvent((int32)(intptr)profilerData - 1);
+#endif
     }
 };
 
-class ProfilerPhysX : public PxProfilerCallback
+class CpuDispatcherPhysX : public PxCpuDispatcher
 {
 public:
-    void* zoneStart(const char* eventName, bool detached, uint64_t contextId) override
+    void submitTask(PxBaseTask& task) override
     {
-        return nullptr;
+        // Run PhysX tasks on the engine job threads (physics scales with the cores count and shares them with the other engine systems)
+        PxBaseTask* taskPtr = &task;
+        const Function<void(int32)> job = [taskPtr](int32)
+        {
+            PROFILE_CPU_NAMED("PhysX Task");
+            taskPtr->run();
+            taskPtr->release();
+        };
+        JobSystem::Dispatch(job);
     }
 
-    void zoneEnd(void* profilerData, const char* eventName, bool detached, uint64_t contextId) override
+    uint32_t getWorkerCount() const override
+    {
+        return (uint32_t)Math::Max(JobSystem::GetThreadsCount(), 1);
+    }
+};
+
+#if WITH_CLOTH
+
+class AssertPhysX : public nv::cloth::PxAssertHandler
+{
+public:
+    void operator()(const char* exp, const char* file, int line, bool& ignore) override
     {
+        Platform::Error(String(exp));
+        Platform::Crash(line, file);
     }
 };
 
@@ -493,16 +576,23 @@ class DynamicHitBuffer : public PxHitCallback<HitType>
 		filterData.data.word1 = blockSingle ? 1 : 0; \
 		filterData.data.word2 = hitTriggers ? 1 : 0
 
+#define SCENE_QUERY_SETUP_RAYCAST(blockSingle) SCENE_QUERY_SETUP(blockSingle); \
+		SCENE_QUERY_STATS(RayCast)
+
 #define SCENE_QUERY_SETUP_SWEEP_1() SCENE_QUERY_SETUP(true); \
+		SCENE_QUERY_STATS(Sweep); \
 		PxSweepBufferN<1> buffer
 
 #define SCENE_QUERY_SETUP_SWEEP() SCENE_QUERY_SETUP(false); \
+		SCENE_QUERY_STATS(Sweep); \
 		DynamicHitBuffer<PxSweepHit> buffer
 
 #define SCENE_QUERY_SETUP_OVERLAP_1() SCENE_QUERY_SETUP(false); \
+		SCENE_QUERY_STATS(Overlap); \
 		PxOverlapBufferN<1> buffer
 
 #define SCENE_QUERY_SETUP_OVERLAP() SCENE_QUERY_SETUP(false); \
+		SCENE_QUERY_STATS(Overlap); \
 		DynamicHitBuffer<PxOverlapHit> buffer
 
 #define SCENE_QUERY_COLLECT_SINGLE() const auto& hit = buffer.getAnyHit(0); \
@@ -543,6 +633,9 @@ namespace
 #if WITH_PVD
     PxPvd* PVD = nullptr;
 #endif
+#if WITH_PHYSX_GPU
+    PxCudaContextManager* CudaContextManager = nullptr;
+#endif
 #if COMPILE_WITH_PHYSICS_COOKING
     PxCooking* Cooking = nullptr;
 #endif
@@ -551,8 +644,8 @@ namespace
     ErrorPhysX ErrorCallback;
 #if WITH_CLOTH
     AssertPhysX AssertCallback;
-    ProfilerPhysX ProfilerCallback;
 #endif
+    ProfilerPhysX ProfilerCallback;
     PxTolerancesScale ToleranceScale;
     QueryFilterPhysX QueryFilter;
     CharacterQueryFilterPhysX CharacterQueryFilter;
@@ -920,6 +1013,14 @@ void ScenePhysX::SimulateCloth(int32 i)
     ClothSolver->simulateChunk(i);
 }
 
+void ScenePhysX::PostSimulateCloth(int32 i)
+{
+    PROFILE_CPU();
+    auto clothPhysX = ClothsList[i];
+    const auto& clothSettings = Cloths[clothPhysX];
+    ClothsBroken[i] = !clothSettings.Culled && clothSettings.UpdateBounds(clothPhysX);
+}
+
 #endif
 
 void* PhysicalMaterial::GetPhysicsMaterial()
@@ -966,6 +1067,7 @@ void PhysicalMaterial::UpdatePhysicsMaterial()
 
 #if COMPILE_WITH_PHYSICS_COOKING
 
+// Note: cooking uses the stateless PhysX cooking functions with per-call params so it can be safely invoked from multiple threads at once (eg. parallel assets import or terrain patches update)
 #define ENSURE_CAN_COOK \
     auto cooking = Cooking; \
     if (cooking == nullptr) \
@@ -1001,12 +1103,11 @@ bool CollisionCooking::CookConvexMesh(CookingInput& input, BytesContainer& outpu
         desc.flags |= PxConvexFlag::Enum::eSHIFT_VERTICES;
     PxCookingParams cookingParams = cooking->getParams();
     cookingParams.suppressTriangleMeshRemapTable = EnumHasAnyFlags(input.ConvexFlags, ConvexMeshGenerationFlags::SuppressFaceRemapTable);
-    cooking->setParams(cookingParams);
 
     // Perform cooking
     PxDefaultMemoryOutputStream outputStream;
     PxConvexMeshCookingResult::Enum result;
-    if (!cooking->cookConvexMesh(desc, outputStream, &result))
+    if (!PxCookConvexMesh(cookingParams, desc, outputStream, &result))
     {
         LOG(Warning, "Convex Mesh cooking failed. Error code: {0}, Input vertices count: {1}", (int32)result, input.VertexCount);
         return true;
@@ -1036,12 +1137,11 @@ bool CollisionCooking::CookTriangleMesh(CookingInput& input, BytesContainer& out
     desc.flags = input.Is16bitIndexData ? PxMeshFlag::e16_BIT_INDICES : (PxMeshFlag::Enum)0;
     PxCookingParams cookingParams = cooking->getParams();
     cookingParams.suppressTriangleMeshRemapTable = EnumHasAnyFlags(input.ConvexFlags, ConvexMeshGenerationFlags::SuppressFaceRemapTable);
-    cooking->setParams(cookingParams);
 
     // Perform cooking
     PxDefaultMemoryOutputStream outputStream;
     PxTriangleMeshCookingResult::Enum result;
-    if (!cooking->cookTriangleMesh(desc, outputStream, &result))
+    if (!PxCookTriangleMesh(cookingParams, desc, outputStream, &result))
     {
         LOG(Warning, "Triangle Mesh cooking failed. Error code: {0}, Input vertices count: {1}, indices count: {2}", (int32)result, input.VertexCount, input.IndexCount);
         return true;
@@ -1068,7 +1168,7 @@ bool CollisionCooking::CookHeightField(int32 cols, int32 rows, const PhysicsBack
 
     WriteStreamPhysX outputStream;
     outputStream.Stream = &stream;
-    if (!Cooking->cookHeightField(heightFieldDesc, outputStream))
+    if (!PxCookHeightField(heightFieldDesc, outputStream))
     {
         LOG(Warning, "Height Field collision cooking failed.");
         return true;
@@ -1106,6 +1206,9 @@ bool PhysicsBackend::Init()
     LOG(Info, "Setup NVIDIA PhysX {0}.{1}.{2}", PX_PHYSICS_VERSION_MAJOR, PX_PHYSICS_VERSION_MINOR, PX_PHYSICS_VERSION_BUGFIX);
     Foundation = PxCreateFoundation(PX_PHYSICS_VERSION, AllocatorCallback, ErrorCallback);
     CHECK_INIT(Foundation, "PxCreateFoundation failed!");
+#if COMPILE_WITH_PROFILER
+    PxSetProfilerCallback(&ProfilerCallback);
+#endif
 
     // Init debugger
     PxPvd* pvd = nullptr;
@@ -1152,6 +1255,27 @@ bool PhysicsBackend::Init()
     }
 #endif
 
+    // Init GPU simulation
+#if WITH_PHYSX_GPU
+    if (settings.EnableGPUSimulation)
+    {
+        PxCudaContextManagerDesc cudaContextManagerDesc;
+        CudaContextManager = PxCreateCudaContextManager(*Foundation, cudaContextManagerDesc, PxGetProfilerCallback());
+        if (CudaContextManager && !CudaContextManager->contextIsValid())
+        {
+            CudaContextManager->release();
+            CudaContextManager = nullptr;
+        }
+        if (CudaContextManager)
+            LOG(Info, "Using GPU simulation on {0}", String(CudaContextManager->getDeviceName()));
+        else
+            LOG(Warning, "Failed to initialize CUDA context for GPU simulation. Using CPU simulation.");
+    }
+#else
+    if (settings.EnableGPUSimulation)
+        LOG(Warning, "GPU simulation is not supported in this build. Using CPU simulation.");
+#endif
+
     // Create default material
     DefaultMaterial = PhysX->createMaterial(0.7f, 0.7f, 0.3f);
 
@@ -1203,6 +1327,9 @@ void PhysicsBackend::Shutdown()
 #endif
 #if COMPILE_WITH_PHYSICS_COOKING
     RELEASE_PHYSX(Cooking);
+#endif
+#if WITH_PHYSX_GPU
+    RELEASE_PHYSX(CudaContextManager);
 #endif
     if (PhysX)
     {
@@ -1212,6 +1339,9 @@ void PhysicsBackend::Shutdown()
     }
 #if WITH_PVD
     RELEASE_PHYSX(PVD);
+#endif
+#if COMPILE_WITH_PROFILER
+    PxSetProfilerCallback(nullptr);
 #endif
     RELEASE_PHYSX(Foundation);
     SceneOrigins.Clear();
@@ -1267,8 +1397,7 @@ void* PhysicsBackend::CreateScene(const PhysicsSettings& settings)
     }
     if (sceneDesc.cpuDispatcher == nullptr)
     {
-        scenePhysX->CpuDispatcher = PxDefaultCpuDispatcherCreate(Math::Clamp<uint32>(Platform::GetCPUInfo().ProcessorCoreCount - 1, 1, 4));
-        CHECK_INIT(scenePhysX->CpuDispatcher, "PxDefaultCpuDispatcherCreate failed!");
+        scenePhysX->CpuDispatcher = New<CpuDispatcherPhysX>();
         sceneDesc.cpuDispatcher = scenePhysX->CpuDispatcher;
     }
     switch (settings.BroadPhaseType)
@@ -1286,6 +1415,14 @@ void* PhysicsBackend::CreateScene(const PhysicsSettings& settings)
         sceneDesc.broadPhaseType = PxBroadPhaseType::ePABP;
         break;
     }
+#if WITH_PHYSX_GPU
+    if (CudaContextManager)
+    {
+        sceneDesc.cudaContextManager = CudaContextManager;
+        sceneDesc.flags |= PxSceneFlag::eENABLE_GPU_DYNAMICS;
+        sceneDesc.broadPhaseType = PxBroadPhaseType::eGPU;
+    }
+#endif
 
     // Create scene
     scenePhysX->Scene = PhysX->createScene(sceneDesc);
@@ -1346,6 +1483,16 @@ void PhysicsBackend::StartSimulateScene(void* scene, float dt)
     // Clamp delta
     dt = Math::Clamp(dt, 0.0f, settings.MaxDeltaTime);
 
+#if COMPILE_WITH_PROFILER
+    // Capture queries stats between the simulation steps
+    for (int32 i = 0; i < (int32)SceneQueryTypePhysX::MAX; i++)
+    {
+        auto& stats = scenePhysX->QueryStats[i];
+        scenePhysX->LastQueryStats[i].Count = Platform::InterlockedExchange(&stats.Count, 0);
+        scenePhysX->LastQueryStats[i].Cycles = Platform::InterlockedExchange(&stats.Cycles, 0);
+    }
+#endif
+
     // Prepare util objects
     if (scenePhysX->ScratchMemory == nullptr)
     {
@@ -1363,6 +1510,7 @@ void PhysicsBackend::StartSimulateScene(void* scene, float dt)
     }
 
     // Start simulation (may not be fired due to too small delta time)
+    PxSceneWriteLock lock(*scenePhysX->Scene);
     if (scenePhysX->Stepper.advance(scenePhysX->Scene, dt, scenePhysX->ScratchMemory, PHYSX_SCRATCH_BLOCK_SIZE) == false)
         return;
     scenePhysX->EventsCallback.Clear();
@@ -1376,6 +1524,9 @@ void PhysicsBackend::EndSimulateScene(void* scene)
 {
     auto scenePhysX = (ScenePhysX*)scene;
 
+    // Wait for the scene queries running on other threads (see PhysicsScene::LockRead)
+    scenePhysX->Scene->lockWrite(__FILE__, __LINE__);
+
     {
         PROFILE_CPU_NAMED("Physics.Fetch");
 
@@ -1836,8 +1987,11 @@ void PhysicsBackend::EndSimulateScene(void* scene)
         PxActor** activeActors = scenePhysX->Scene->getActiveActors(activeActorsCount);
         if (activeActorsCount > 0)
         {
+            // Defer the actors bounds updates to refresh the scene rendering spatial index once for all simulated bodies
+            for (Scene* scene : Level::Scenes)
+                scene->Rendering.BeginUpdateBatch();
+
             // Update changed transformations
-            // TODO: use jobs system if amount if huge
             for (uint32 i = 0; i < activeActorsCount; i++)
             {
                 const auto pxActor = (PxRigidActor*)*activeActors++;
@@ -1845,9 +1999,14 @@ void PhysicsBackend::EndSimulateScene(void* scene)
                 if (actor)
                     actor->OnActiveTransformChanged();
             }
+
+            for (Scene* scene : Level::Scenes)
+                scene->Rendering.EndUpdateBatch();
         }
     }
 
+    scenePhysX->Scene->unlockWrite();
+
 #if WITH_CLOTH
     nv::cloth::Solver* clothSolver = scenePhysX->ClothSolver;
     if (clothSolver && scenePhysX->ClothsList.Count() != 0)
@@ -1875,16 +2034,28 @@ void PhysicsBackend::EndSimulateScene(void* scene)
         {
             PROFILE_CPU_NAMED("Post");
             ScopeLock lock(ClothLocker);
+
+            // Update cloths bounds in parallel
+            scenePhysX->ClothsBroken.Resize(scenePhysX->ClothsList.Count(), false);
+            Function<void(int32)> job;
+            job.Bind<ScenePhysX, &ScenePhysX::PostSimulateCloth>(scenePhysX);
+            JobSystem::Execute(job, scenePhysX->ClothsList.Count());
+
+            // Update cloths rendering state (batched scene rendering bounds updates)
+            for (Scene* scene : Level::Scenes)
+                scene->Rendering.BeginUpdateBatch();
             Array<Cloth*> brokenCloths;
-            for (auto clothPhysX : scenePhysX->ClothsList)
+            for (int32 i = 0; i < scenePhysX->ClothsList.Count(); i++)
             {
-                const auto& clothSettings = Cloths[clothPhysX];
+                const auto& clothSettings = Cloths[scenePhysX->ClothsList[i]];
                 if (clothSettings.Culled)
                     continue;
-                if (clothSettings.UpdateBounds(clothPhysX))
+                if (scenePhysX->ClothsBroken[i])
                     brokenCloths.Add(clothSettings.Actor);
                 clothSettings.Actor->OnPostUpdate();
             }
+            for (Scene* scene : Level::Scenes)
+                scene->Rendering.EndUpdateBatch();
             for (auto cloth : brokenCloths)
             {
                 // Rebuild cloth object but keep fabric ref to prevent fabric recook
@@ -1908,6 +2079,18 @@ void PhysicsBackend::EndSimulateScene(void* scene)
 #endif
 }
 
+void PhysicsBackend::LockSceneRead(void* scene)
+{
+    auto scenePhysX = (ScenePhysX*)scene;
+    scenePhysX->Scene->lockRead(__FILE__, __LINE__);
+}
+
+void PhysicsBackend::UnlockSceneRead(void* scene)
+{
+    auto scenePhysX = (ScenePhysX*)scene;
+    scenePhysX->Scene->unlockRead();
+}
+
 Vector3 PhysicsBackend::GetSceneGravity(void* scene)
 {
     auto scenePhysX = (ScenePhysX*)scene;
@@ -2039,20 +2222,38 @@ void PhysicsBackend::GetSceneStatistics(void* scene, PhysicsStatistics& result)
     result.LostPairs = px.nbLostPairs;
     result.NewTouches = px.nbNewTouches;
     result.LostTouches = px.nbLostTouches;
+    result.ContactPairs = px.nbDiscreteContactPairsTotal;
+    result.ContactPairsWithContacts = px.nbDiscreteContactPairsWithContacts;
+    result.CCDPairs = 0;
+    for (int32 i = 0; i < PxGeometryType::eGEOMETRY_COUNT; i++)
+    {
+        for (int32 j = 0; j < PxGeometryType::eGEOMETRY_COUNT; j++)
+            result.CCDPairs += px.nbCCDPairs[i][j];
+    }
+    result.BroadPhaseAdds = px.getNbBroadPhaseAdds();
+    result.BroadPhaseRemoves = px.getNbBroadPhaseRemoves();
+    const double cyclesToMs = 1000.0 / (double)Platform::GetClockFrequency();
+    const auto& queryStats = scenePhysX->LastQueryStats;
+    result.RayCastQueries = (uint32)queryStats[(int32)SceneQueryTypePhysX::RayCast].Count;
+    result.SweepQueries = (uint32)queryStats[(int32)SceneQueryTypePhysX::Sweep].Count;
+    result.OverlapQueries = (uint32)queryStats[(int32)SceneQueryTypePhysX::Overlap].Count;
+    result.RayCastQueriesTime = (float)(queryStats[(int32)SceneQueryTypePhysX::RayCast].Cycles * cyclesToMs);
+    result.SweepQueriesTime = (float)(queryStats[(int32)SceneQueryTypePhysX::Sweep].Cycles * cyclesToMs);
+    result.OverlapQueriesTime = (float)(queryStats[(int32)SceneQueryTypePhysX::Overlap].Cycles * cyclesToMs);
 }
 
 #endif
 
 bool PhysicsBackend::RayCast(void* scene, const Vector3& origin, const Vector3& direction, const float maxDistance, uint32 layerMask, bool hitTriggers)
 {
-    SCENE_QUERY_SETUP(true);
+    SCENE_QUERY_SETUP_RAYCAST(true);
     PxRaycastBuffer buffer;
     return scenePhysX->Scene->raycast(C2P(origin - scenePhysX->Origin), C2P(direction), maxDistance, buffer, PxHitFlagEmpty, filterData, &QueryFilter);
 }
 
 bool PhysicsBackend::RayCast(void* scene, const Vector3& origin, const Vector3& direction, RayCastHit& hitInfo, const float maxDistance, uint32 layerMask, bool hitTriggers)
 {
-    SCENE_QUERY_SETUP(true);
+    SCENE_QUERY_SETUP_RAYCAST(true);
     PxRaycastBuffer buffer;
     if (!scenePhysX->Scene->raycast(C2P(origin - scenePhysX->Origin), C2P(direction), maxDistance, buffer, SCENE_QUERY_FLAGS, filterData, &QueryFilter))
         return false;
@@ -2062,7 +2263,7 @@ bool PhysicsBackend::RayCast(void* scene, const Vector3& origin, const Vector3&
 
 bool PhysicsBackend::RayCastAll(void* scene, const Vector3& origin, const Vector3& direction, Array<RayCastHit>& results, const float maxDistance, uint32 layerMask, bool hitTriggers)
 {
-    SCENE_QUERY_SETUP(false);
+    SCENE_QUERY_SETUP_RAYCAST(false);
     DynamicHitBuffer<PxRaycastHit> buffer;
     if (!scenePhysX->Scene->raycast(C2P(origin - scenePhysX->Origin), C2P(direction), maxDistance, buffer, SCENE_QUERY_FLAGS, filterData, &QueryFilter))
         return false;
@@ -4397,6 +4598,7 @@ void PhysicsBackend::FlushRequests()
 void PhysicsBackend::FlushRequests(void* scene)
 {
     auto scenePhysX = (ScenePhysX*)scene;
+    PxSceneWriteLock lock(*scenePhysX->Scene);
     FlushLocker.Lock();
 
     // Perform latent actions
@@ -6,15 +6,24 @@
 #include "PhysicalMaterial.h"
 #include "PhysicsSettings.h"
 #include "PhysicsStatistics.h"
+#include "Actors/RigidBody.h"
 #include "Engine/Engine/Time.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "Engine/Serialization/Serialization.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/JobSystem.h"
+#include "Engine/Core/Math/Ray.h"
+#include "Engine/Core/Collections/Sorting.h"
+
+// The minimum amount of scene queries executed by a single job in the batched queries
+#define PHYSICS_QUERY_BATCH_SIZE 64
 
 PhysicsScene* Physics::DefaultScene = nullptr;
 Array<PhysicsScene*> Physics::Scenes;
 uint32 Physics::LayerMasks[32];
+bool Physics::AsyncSimulation = false;
 
 class PhysicsService : public EngineService
 {
@@ -36,6 +45,7 @@ PhysicsService PhysicsServiceInstance;
 void PhysicsSettings::Apply()
 {
     Time::_physicsMaxDeltaTime = MaxDeltaTime;
+    Physics::AsyncSimulation = AsyncSimulation;
     Platform::MemoryCopy(Physics::LayerMasks, LayerMasks, sizeof(LayerMasks));
     Physics::SetGravity(DefaultGravity);
     Physics::SetBounceThresholdVelocity(BounceThresholdVelocity);
@@ -59,10 +69,12 @@ void PhysicsSettings::Deserialize(DeserializeStream& stream, ISerializeModifier*
     DESERIALIZE(DisableCCD);
     DESERIALIZE(BroadPhaseType);
     DESERIALIZE(SolverType);
+    DESERIALIZE(EnableGPUSimulation);
     DESERIALIZE(MaxDeltaTime);
     DESERIALIZE(EnableSubstepping);
     DESERIALIZE(SubstepDeltaTime);
     DESERIALIZE(MaxSubsteps);
+    DESERIALIZE(AsyncSimulation);
     DESERIALIZE(QueriesHitTriggers);
     DESERIALIZE(SupportCookingAtRuntime);
 
@@ -97,6 +109,7 @@ bool PhysicsService::Init()
 
 void PhysicsService::LateUpdate()
 {
+    PROFILE_MEM(Physics);
     Physics::FlushRequests();
 }
 
@@ -189,6 +202,7 @@ void Physics::SetBounceThresholdVelocity(const float value)
 
 void Physics::Simulate(float dt)
 {
+    PROFILE_MEM(Physics);
     for (PhysicsScene* scene : Scenes)
     {
         if (scene->GetAutoSimulation())
@@ -210,6 +224,16 @@ bool Physics::IsDuringSimulation()
     return DefaultScene && DefaultScene->IsDuringSimulation();
 }
 
+void Physics::LockRead()
+{
+    DefaultScene->LockRead();
+}
+
+void Physics::UnlockRead()
+{
+    DefaultScene->UnlockRead();
+}
+
 void Physics::FlushRequests()
 {
     PROFILE_CPU_NAMED("Physics.FlushRequests");
@@ -308,6 +332,21 @@ bool Physics::ConvexCastAll(const Vector3& center, const CollisionData* convexMe
     return DefaultScene->ConvexCastAll(center, convexMesh, scale, direction, results, rotation, maxDistance, layerMask, hitTriggers);
 }
 
+int32 Physics::RayCastBatch(const Span<Ray>& rays, Array<RayCastHit>& results, const float maxDistance, uint32 layerMask, bool hitTriggers)
+{
+    return DefaultScene->RayCastBatch(rays, results, maxDistance, layerMask, hitTriggers);
+}
+
+int32 Physics::SphereCastBatch(const Span<Ray>& rays, const float radius, Array<RayCastHit>& results, const float maxDistance, uint32 layerMask, bool hitTriggers)
+{
+    return DefaultScene->SphereCastBatch(rays, radius, results, maxDistance, layerMask, hitTriggers);
+}
+
+int32 Physics::BoxCastBatch(const Span<Ray>& rays, const Vector3& halfExtents, Array<RayCastHit>& results, const Quaternion& rotation, const float maxDistance, uint32 layerMask, bool hitTriggers)
+{
+    return DefaultScene->BoxCastBatch(rays, halfExtents, results, rotation, maxDistance, layerMask, hitTriggers);
+}
+
 bool Physics::CheckBox(const Vector3& center, const Vector3& halfExtents, const Quaternion& rotation, uint32 layerMask, bool hitTriggers)
 {
     return DefaultScene->CheckBox(center, halfExtents, rotation, layerMask, hitTriggers);
@@ -439,6 +478,7 @@ PhysicsStatistics PhysicsScene::GetStatistics() const
 {
     PhysicsStatistics result;
     PhysicsBackend::GetSceneStatistics(_scene, result);
+    result.SignificanceSleptBodies = _significanceSleptBodies;
     return result;
 }
 
@@ -455,9 +495,76 @@ bool PhysicsScene::Init(const StringView& name, const PhysicsSettings& settings)
     return _scene == nullptr;
 }
 
+void PhysicsScene::AddRigidBody(RigidBody* rigidBody)
+{
+    ASSERT(rigidBody->_sceneIndex == -1);
+    rigidBody->_sceneIndex = _rigidBodies.Count();
+    _rigidBodies.Add(rigidBody);
+}
+
+void PhysicsScene::RemoveRigidBody(RigidBody* rigidBody)
+{
+    const int32 index = rigidBody->_sceneIndex;
+    if (index == -1)
+        return;
+    ASSERT(_rigidBodies[index] == rigidBody);
+    _rigidBodies.RemoveAt(index);
+    if (index < _rigidBodies.Count())
+        _rigidBodies[index]->_sceneIndex = index;
+    rigidBody->_sceneIndex = -1;
+}
+
+void PhysicsScene::UpdateSignificance()
+{
+    _significanceSleptBodies = 0;
+    if ((SleepDistance <= 0.0f && MaxActiveBodies <= 0) || _rigidBodies.IsEmpty())
+        return;
+    PROFILE_CPU();
+
+    // Gather the awake dynamic bodies (sort key is the squared distance to the significance origin)
+    struct AwakeBody
+    {
+        Real DistanceSquared;
+        RigidBody* Body;
+
+        bool operator<(const AwakeBody& other) const
+        {
+            return DistanceSquared < other.DistanceSquared;
+        }
+    };
+    Array<AwakeBody> awakeBodies;
+    const Real sleepDistanceSquared = SleepDistance > 0.0f ? (Real)SleepDistance * SleepDistance : MAX_Real;
+    for (RigidBody* rigidBody : _rigidBodies)
+    {
+        void* actor = rigidBody->GetPhysicsActor();
+        if (!actor || rigidBody->GetIsKinematic() || !rigidBody->GetEnableSimulation() || PhysicsBackend::GetRigidDynamicActorIsSleeping(actor))
+            continue;
+        const Real distanceSquared = Vector3::DistanceSquared(rigidBody->GetPosition(), SignificanceOrigin);
+        if (distanceSquared > sleepDistanceSquared)
+        {
+            PhysicsBackend::RigidDynamicActorSleep(actor);
+            _significanceSleptBodies++;
+        }
+        else if (MaxActiveBodies > 0)
+        {
+            awakeBodies.Add({ distanceSquared, rigidBody });
+        }
+    }
+
+    // Put the least significant bodies above the budget to sleep
+    if (MaxActiveBodies > 0 && awakeBodies.Count() > MaxActiveBodies)
+    {
+        Sorting::QuickSort(awakeBodies.Get(), awakeBodies.Count());
+        for (int32 i = MaxActiveBodies; i < awakeBodies.Count(); i++)
+            PhysicsBackend::RigidDynamicActorSleep(awakeBodies.Get()[i].Body->GetPhysicsActor());
+        _significanceSleptBodies += awakeBodies.Count() - MaxActiveBodies;
+    }
+}
+
 void PhysicsScene::Simulate(float dt)
 {
     ASSERT(IsInMainThread() && !_isDuringSimulation);
+    UpdateSignificance();
     _isDuringSimulation = true;
     PhysicsBackend::StartSimulateScene(_scene, dt);
 }
@@ -476,6 +583,16 @@ void PhysicsScene::CollectResults()
     _isDuringSimulation = false;
 }
 
+void PhysicsScene::LockRead()
+{
+    PhysicsBackend::LockSceneRead(_scene);
+}
+
+void PhysicsScene::UnlockRead()
+{
+    PhysicsBackend::UnlockSceneRead(_scene);
+}
+
 bool PhysicsScene::LineCast(const Vector3& start, const Vector3& end, uint32 layerMask, bool hitTriggers)
 {
     Vector3 directionToEnd = end - start;
@@ -578,6 +695,57 @@ bool PhysicsScene::ConvexCastAll(const Vector3& center, const CollisionData* con
     return PhysicsBackend::ConvexCastAll(_scene, center, convexMesh, scale, direction, results, rotation, maxDistance, layerMask, hitTriggers);
 }
 
+namespace
+{
+    template<typename QueryType>
+    int32 ExecuteQueryBatch(const Span<Ray>& rays, Array<RayCastHit>& results, const QueryType& query)
+    {
+        PROFILE_CPU();
+        results.Resize(rays.Length(), false);
+        JobSystem::ParallelFor(rays.Length(), [&](int32 start, int32 end)
+        {
+            for (int32 i = start; i < end; i++)
+            {
+                RayCastHit& hit = results.Get()[i];
+                if (!query(rays[i], hit))
+                    Platform::MemoryClear(&hit, sizeof(hit));
+            }
+        }, PHYSICS_QUERY_BATCH_SIZE);
+
+        int32 hitsCount = 0;
+        for (const RayCastHit& hit : results)
+            hitsCount += hit.Collider ? 1 : 0;
+        return hitsCount;
+    }
+}
+
+int32 PhysicsScene::RayCastBatch(const Span<Ray>& rays, Array<RayCastHit>& results, const float maxDistance, uint32 layerMask, bool hitTriggers)
+{
+    PhysicsSceneReadLock lock(this);
+    return ExecuteQueryBatch(rays, results, [&](const Ray& ray, RayCastHit& hit)
+    {
+        return PhysicsBackend::RayCast(_scene, ray.Position, ray.Direction, hit, maxDistance, layerMask, hitTriggers);
+    });
+}
+
+int32 PhysicsScene::SphereCastBatch(const Span<Ray>& rays, const float radius, Array<RayCastHit>& results, const float maxDistance, uint32 layerMask, bool hitTriggers)
+{
+    PhysicsSceneReadLock lock(this);
+    return ExecuteQueryBatch(rays, results, [&](const Ray& ray, RayCastHit& hit)
+    {
+        return PhysicsBackend::SphereCast(_scene, ray.Position, radius, ray.Direction, hit, maxDistance, layerMask, hitTriggers);
+    });
+}
+
+int32 PhysicsScene::BoxCastBatch(const Span<Ray>& rays, const Vector3& halfExtents, Array<RayCastHit>& results, const Quaternion& rotation, const float maxDistance, uint32 layerMask, bool hitTriggers)
+{
+    PhysicsSceneReadLock lock(this);
+    return ExecuteQueryBatch(rays, results, [&](const Ray& ray, RayCastHit& hit)
+    {
+        return PhysicsBackend::BoxCast(_scene, ray.Position, halfExtents, ray.Direction, hit, rotation, maxDistance, layerMask, hitTriggers);
+    });
+}
+
 bool PhysicsScene::CheckBox(const Vector3& center, const Vector3& halfExtents, const Quaternion& rotation, uint32 layerMask, bool hitTriggers)
 {
     return PhysicsBackend::CheckBox(_scene, center, halfExtents, rotation, layerMask, hitTriggers);
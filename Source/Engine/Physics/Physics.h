@@ -3,8 +3,11 @@
 #pragma once
 
 #include "Engine/Core/Math/Quaternion.h"
+#include "Engine/Core/Types/Span.h"
 #include "Types.h"
 
+struct Ray;
+
 /// <summary>
 /// Physics simulation system.
 /// </summary>
@@ -22,6 +25,11 @@ API_CLASS(Static) class FLAXENGINE_API Physics
     /// </summary>
     API_FIELD(ReadOnly) static Array<PhysicsScene*, HeapAllocation> Scenes;
 
+    /// <summary>
+    /// If enabled, the physics simulation overlaps with the frame rendering and its results are collected before the next game update (see PhysicsSettings.AsyncSimulation).
+    /// </summary>
+    API_FIELD() static bool AsyncSimulation;
+
     /// <summary>
     /// Finds an existing <see cref="PhysicsScene"/> or creates it if it does not exist.
     /// </summary>
@@ -89,6 +97,16 @@ API_CLASS(Static) class FLAXENGINE_API Physics
     /// </summary>
     API_PROPERTY() static bool IsDuringSimulation();
 
+    /// <summary>
+    /// Locks the default scene for reading to allow performing scene queries from the other thread than main thread (see PhysicsScene.LockRead).
+    /// </summary>
+    API_FUNCTION() static void LockRead();
+
+    /// <summary>
+    /// Unlocks the default scene after reading (see PhysicsScene.LockRead).
+    /// </summary>
+    API_FUNCTION() static void UnlockRead();
+
     /// <summary>
     /// Flushes any latent physics actions (eg. object destroy, actor add/remove to the scene, etc.).
     /// </summary>
@@ -329,6 +347,42 @@ API_CLASS(Static) class FLAXENGINE_API Physics
     /// <returns>True if convex mesh hits an matching object, otherwise false.</returns>
     API_FUNCTION() static bool ConvexCastAll(const Vector3& center, const CollisionData* convexMesh, const Vector3& scale, const Vector3& direction, API_PARAM(Out) Array<RayCastHit, HeapAllocation>& results, const Quaternion& rotation = Quaternion::Identity, float maxDistance = MAX_float, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
 
+    /// <summary>
+    /// Performs a batch of raycasts against objects in the scene (eg. AI perception or bullet traces). Queries are executed in parallel on the job system and require a single scripting call for the whole batch.
+    /// </summary>
+    /// <param name="rays">The rays to cast (origin and normalized direction).</param>
+    /// <param name="results">The result hits (one per ray, in the same order). Rays that didn't hit anything have null Collider.</param>
+    /// <param name="maxDistance">The maximum distance the rays should check for collisions.</param>
+    /// <param name="layerMask">The layer mask used to filter the results.</param>
+    /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
+    /// <returns>The amount of rays that hit an matching object.</returns>
+    API_FUNCTION() static int32 RayCastBatch(const Span<Ray>& rays, API_PARAM(Out) Array<RayCastHit, HeapAllocation>& results, float maxDistance = MAX_float, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
+
+    /// <summary>
+    /// Performs a batch of sphere sweep tests against objects in the scene (eg. thick bullet traces or foot probes). Queries are executed in parallel on the job system and require a single scripting call for the whole batch.
+    /// </summary>
+    /// <param name="rays">The sweeps to perform (sphere center and normalized direction).</param>
+    /// <param name="radius">The radius of the spheres.</param>
+    /// <param name="results">The result hits (one per sweep, in the same order). Sweeps that didn't hit anything have null Collider.</param>
+    /// <param name="maxDistance">The maximum distance the sweeps should check for collisions.</param>
+    /// <param name="layerMask">The layer mask used to filter the results.</param>
+    /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
+    /// <returns>The amount of sweeps that hit an matching object.</returns>
+    API_FUNCTION() static int32 SphereCastBatch(const Span<Ray>& rays, float radius, API_PARAM(Out) Array<RayCastHit, HeapAllocation>& results, float maxDistance = MAX_float, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
+
+    /// <summary>
+    /// Performs a batch of box sweep tests against objects in the scene. Queries are executed in parallel on the job system and require a single scripting call for the whole batch.
+    /// </summary>
+    /// <param name="rays">The sweeps to perform (box center and normalized direction).</param>
+    /// <param name="halfExtents">The half size of the boxes in each direction.</param>
+    /// <param name="results">The result hits (one per sweep, in the same order). Sweeps that didn't hit anything have null Collider.</param>
+    /// <param name="rotation">The boxes rotation.</param>
+    /// <param name="maxDistance">The maximum distance the sweeps should check for collisions.</param>
+    /// <param name="layerMask">The layer mask used to filter the results.</param>
+    /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
+    /// <returns>The amount of sweeps that hit an matching object.</returns>
+    API_FUNCTION() static int32 BoxCastBatch(const Span<Ray>& rays, const Vector3& halfExtents, API_PARAM(Out) Array<RayCastHit, HeapAllocation>& results, const Quaternion& rotation = Quaternion::Identity, float maxDistance = MAX_float, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
+
     /// <summary>
     /// Checks whether the given box overlaps with other colliders or not.
     /// </summary>
@@ -105,6 +105,8 @@ class FLAXENGINE_API PhysicsBackend
     static void DestroyScene(void* scene);
     static void StartSimulateScene(void* scene, float dt);
     static void EndSimulateScene(void* scene);
+    static void LockSceneRead(void* scene);
+    static void UnlockSceneRead(void* scene);
     static Vector3 GetSceneGravity(void* scene);
     static void SetSceneGravity(void* scene, const Vector3& value);
     static bool GetSceneEnableCCD(void* scene);
@@ -80,6 +80,14 @@ void PhysicsBackend::EndSimulateScene(void* scene)
 {
 }
 
+void PhysicsBackend::LockSceneRead(void* scene)
+{
+}
+
+void PhysicsBackend::UnlockSceneRead(void* scene)
+{
+}
+
 Vector3 PhysicsBackend::GetSceneGravity(void* scene)
 {
     return Vector3::Zero;
@@ -4,16 +4,20 @@
 
 #include "Engine/Core/Math/Vector3.h"
 #include "Engine/Core/Math/Quaternion.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Types/Span.h"
 #include "Engine/Scripting/ScriptingObject.h"
 #include "Types.h"
 
 struct ActionData;
 struct RayCastHit;
+struct Ray;
 class PhysicsSettings;
 class PhysicsColliderActor;
 class Joint;
 class Collider;
 class CollisionData;
+class RigidBody;
 #if WITH_VEHICLE
 class WheeledVehicle;
 #endif
@@ -21,6 +25,9 @@ class WheeledVehicle;
 /// <summary>
 /// Physical simulation scene.
 /// </summary>
+/// <remarks>
+/// Threading model: simulation (Simulate, CollectResults) and scene modifications (adding, removing or moving physics actors) run on the main thread. Scene queries (raycasts, sweeps, overlaps and checks) can be called from any thread (eg. TaskGraph jobs) as long as the calling thread holds the scene read lock (see LockRead). Results collection and latent actions flush wait for the read locks to be released. Queries from the main thread don't need the lock.
+/// </remarks>
 API_CLASS() class FLAXENGINE_API PhysicsScene : public ScriptingObject
 {
     DECLARE_SCRIPTING_TYPE(PhysicsScene);
@@ -30,10 +37,20 @@ API_CLASS() class FLAXENGINE_API PhysicsScene : public ScriptingObject
     bool _isDuringSimulation = false;
     Vector3 _origin = Vector3::Zero;
     void* _scene = nullptr;
+    Array<RigidBody*> _rigidBodies;
+    uint32 _significanceSleptBodies = 0;
 
 public:
     ~PhysicsScene();
 
+    /// <summary>
+    /// Gets the rigidbodies registered in this scene.
+    /// </summary>
+    FORCE_INLINE const Array<RigidBody*>& GetRigidBodies() const
+    {
+        return _rigidBodies;
+    }
+
     /// <summary>
     /// Gets the name of the scene.
     /// </summary>
@@ -100,6 +117,22 @@ API_CLASS() class FLAXENGINE_API PhysicsScene : public ScriptingObject
     /// </summary>
     API_PROPERTY() void SetOrigin(const Vector3& value);
 
+public:
+    /// <summary>
+    /// The location used to evaluate the significance of the dynamic rigidbodies (eg. player or camera position). Used by SleepDistance and MaxActiveBodies.
+    /// </summary>
+    API_FIELD() Vector3 SignificanceOrigin = Vector3::Zero;
+
+    /// <summary>
+    /// The distance from the SignificanceOrigin above which the awake dynamic rigidbodies are forced to sleep before the simulation step. Distant bodies still wake up on contact with the simulated bodies. Use 0 to disable.
+    /// </summary>
+    API_FIELD() float SleepDistance = 0.0f;
+
+    /// <summary>
+    /// The maximum amount of the awake dynamic rigidbodies in the scene. Before the simulation step, the bodies above the budget (the farthest from the SignificanceOrigin) are forced to sleep to keep the simulation cost bounded (eg. when a large destruction wakes up everything at once). Use 0 to disable.
+    /// </summary>
+    API_FIELD() int32 MaxActiveBodies = 0;
+
 #if COMPILE_WITH_PROFILER
     /// <summary>
     /// Gets the physics simulation statistics for the scene.
@@ -116,6 +149,16 @@ API_CLASS() class FLAXENGINE_API PhysicsScene : public ScriptingObject
     /// <returns>True if failed, otherwise false.</returns>
     bool Init(const StringView& name, const PhysicsSettings& settings);
 
+    /// <summary>
+    /// Registers the rigidbody in the scene significance system. Called internally by the rigidbody.
+    /// </summary>
+    void AddRigidBody(RigidBody* rigidBody);
+
+    /// <summary>
+    /// Unregisters the rigidbody from the scene significance system. Called internally by the rigidbody.
+    /// </summary>
+    void RemoveRigidBody(RigidBody* rigidBody);
+
     /// <summary>
     /// Called during main engine loop to start physic simulation. Use CollectResults after.
     /// </summary>
@@ -132,6 +175,16 @@ API_CLASS() class FLAXENGINE_API PhysicsScene : public ScriptingObject
     /// </summary>
     API_FUNCTION() void CollectResults();
 
+    /// <summary>
+    /// Locks the scene for reading to allow performing scene queries from the other thread than main thread. Multiple threads can hold the read lock at once. Blocks the simulation results collection until all read locks get released so keep the lock only for the queries duration. Nested calls on the same thread are allowed.
+    /// </summary>
+    API_FUNCTION() void LockRead();
+
+    /// <summary>
+    /// Unlocks the scene after reading (see LockRead).
+    /// </summary>
+    API_FUNCTION() void UnlockRead();
+
 public:
     /// <summary>
     /// Performs a line between two points in the scene.
@@ -367,6 +420,42 @@ API_CLASS() class FLAXENGINE_API PhysicsScene : public ScriptingObject
     /// <returns>True if convex mesh hits an matching object, otherwise false.</returns>
     API_FUNCTION() bool ConvexCastAll(const Vector3& center, const CollisionData* convexMesh, const Vector3& scale, const Vector3& direction, API_PARAM(Out) Array<RayCastHit, HeapAllocation>& results, const Quaternion& rotation = Quaternion::Identity, float maxDistance = MAX_float, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
 
+    /// <summary>
+    /// Performs a batch of raycasts against objects in the scene (eg. AI perception or bullet traces). Queries are executed in parallel on the job system and require a single scripting call for the whole batch.
+    /// </summary>
+    /// <param name="rays">The rays to cast (origin and normalized direction).</param>
+    /// <param name="results">The result hits (one per ray, in the same order). Rays that didn't hit anything have null Collider.</param>
+    /// <param name="maxDistance">The maximum distance the rays should check for collisions.</param>
+    /// <param name="layerMask">The layer mask used to filter the results.</param>
+    /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
+    /// <returns>The amount of rays that hit an matching object.</returns>
+    API_FUNCTION() int32 RayCastBatch(const Span<Ray>& rays, API_PARAM(Out) Array<RayCastHit, HeapAllocation>& results, float maxDistance = MAX_float, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
+
+    /// <summary>
+    /// Performs a batch of sphere sweep tests against objects in the scene (eg. thick bullet traces or foot probes). Queries are executed in parallel on the job system and require a single scripting call for the whole batch.
+    /// </summary>
+    /// <param name="rays">The sweeps to perform (sphere center and normalized direction).</param>
+    /// <param name="radius">The radius of the spheres.</param>
+    /// <param name="results">The result hits (one per sweep, in the same order). Sweeps that didn't hit anything have null Collider.</param>
+    /// <param name="maxDistance">The maximum distance the sweeps should check for collisions.</param>
+    /// <param name="layerMask">The layer mask used to filter the results.</param>
+    /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
+    /// <returns>The amount of sweeps that hit an matching object.</returns>
+    API_FUNCTION() int32 SphereCastBatch(const Span<Ray>& rays, float radius, API_PARAM(Out) Array<RayCastHit, HeapAllocation>& results, float maxDistance = MAX_float, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
+
+    /// <summary>
+    /// Performs a batch of box sweep tests against objects in the scene. Queries are executed in parallel on the job system and require a single scripting call for the whole batch.
+    /// </summary>
+    /// <param name="rays">The sweeps to perform (box center and normalized direction).</param>
+    /// <param name="halfExtents">The half size of the boxes in each direction.</param>
+    /// <param name="results">The result hits (one per sweep, in the same order). Sweeps that didn't hit anything have null Collider.</param>
+    /// <param name="rotation">The boxes rotation.</param>
+    /// <param name="maxDistance">The maximum distance the sweeps should check for collisions.</param>
+    /// <param name="layerMask">The layer mask used to filter the results.</param>
+    /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
+    /// <returns>The amount of sweeps that hit an matching object.</returns>
+    API_FUNCTION() int32 BoxCastBatch(const Span<Ray>& rays, const Vector3& halfExtents, API_PARAM(Out) Array<RayCastHit, HeapAllocation>& results, const Quaternion& rotation = Quaternion::Identity, float maxDistance = MAX_float, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
+
     /// <summary>
     /// Checks whether the given box overlaps with other colliders or not.
     /// </summary>
@@ -509,4 +598,30 @@ API_CLASS() class FLAXENGINE_API PhysicsScene : public ScriptingObject
     /// <param name="hitTriggers">If set to <c>true</c> triggers will be hit, otherwise will skip them.</param>
     /// <returns>True if convex mesh overlaps any matching object, otherwise false.</returns>
     API_FUNCTION() bool OverlapConvex(const Vector3& center, const CollisionData* convexMesh, const Vector3& scale, API_PARAM(Out) Array<PhysicsColliderActor*, HeapAllocation>& results, const Quaternion& rotation = Quaternion::Identity, uint32 layerMask = MAX_uint32, bool hitTriggers = true);
+
+private:
+    void UpdateSignificance();
+};
+
+/// <summary>
+/// Scoped physics scene read lock (see PhysicsScene::LockRead). Use it to perform scene queries from the other thread than main thread.
+/// </summary>
+struct PhysicsSceneReadLock
+{
+private:
+    PhysicsScene* _scene;
+
+public:
+    NON_COPYABLE(PhysicsSceneReadLock);
+
+    PhysicsSceneReadLock(PhysicsScene* scene)
+        : _scene(scene)
+    {
+        _scene->LockRead();
+    }
+
+    ~PhysicsSceneReadLock()
+    {
+        _scene->UnlockRead();
+    }
 };
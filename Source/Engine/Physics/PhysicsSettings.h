@@ -100,6 +100,12 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class
     API_FIELD(Attributes="EditorOrder(72), EditorDisplay(\"Simulation\")")
     PhysicsSolverType SolverType = PhysicsSolverType::ProjectedGaussSeidelIterativeSolver;
 
+    /// <summary>
+    /// Enables the GPU rigid body dynamics and broad phase (uses CUDA). Falls back to the CPU simulation when the GPU simulation is not supported by the platform, the engine build or the device. Overrides the BroadPhaseType.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(73), EditorDisplay(\"Simulation\", \"Enable GPU Simulation\")")
+    bool EnableGPUSimulation = false;
+
     /// <summary>
     /// The maximum allowed delta time (in seconds) for the physics simulation step.
     /// </summary>
@@ -124,6 +130,12 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class
     API_FIELD(Attributes="EditorOrder(1020), EditorDisplay(\"Framerate\")")
     int32 MaxSubsteps = 5;
 
+    /// <summary>
+    /// If enabled, the physics simulation step runs on the job threads while the frame renders and its results are collected before the next game update. Removes the simulation from the frame critical path but the gameplay Update sees the simulation results one frame later (FixedUpdate and LateFixedUpdate run while the simulation is in progress).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1030), EditorDisplay(\"Framerate\")")
+    bool AsyncSimulation = false;
+
     /// <summary>
     /// Enables support for cooking physical collision shapes geometry at runtime. Use it to enable generating runtime terrain collision or convex mesh colliders.
     /// </summary>
@@ -32,6 +32,30 @@ API_STRUCT(NoDefault) struct FLAXENGINE_API PhysicsStatistics
     API_FIELD() uint32 NewTouches;
     // Number of lost touches during this frame.
     API_FIELD() uint32 LostTouches;
+    // Number of discrete contact pairs processed by the narrow phase during the last simulation step.
+    API_FIELD() uint32 ContactPairs;
+    // Number of discrete contact pairs that generated contacts during the last simulation step.
+    API_FIELD() uint32 ContactPairsWithContacts;
+    // Number of continuous collision detection (CCD) pairs processed during the last simulation step.
+    API_FIELD() uint32 CCDPairs;
+    // Number of broad phase volumes added during the last simulation step.
+    API_FIELD() uint32 BroadPhaseAdds;
+    // Number of broad phase volumes removed during the last simulation step.
+    API_FIELD() uint32 BroadPhaseRemoves;
+    // Number of raycast queries performed in the scene between the last two simulation steps.
+    API_FIELD() uint32 RayCastQueries;
+    // Number of sweep queries (box, sphere, capsule and convex casts) performed in the scene between the last two simulation steps.
+    API_FIELD() uint32 SweepQueries;
+    // Number of overlap queries (checks and overlaps) performed in the scene between the last two simulation steps.
+    API_FIELD() uint32 OverlapQueries;
+    // Total time (in milliseconds) spent on the raycast queries between the last two simulation steps (summed over all threads).
+    API_FIELD() float RayCastQueriesTime;
+    // Total time (in milliseconds) spent on the sweep queries between the last two simulation steps (summed over all threads).
+    API_FIELD() float SweepQueriesTime;
+    // Total time (in milliseconds) spent on the overlap queries between the last two simulation steps (summed over all threads).
+    API_FIELD() float OverlapQueriesTime;
+    // Number of dynamic bodies forced to sleep by the scene significance system (sleep distance or active bodies budget) before the last simulation step.
+    API_FIELD() uint32 SignificanceSleptBodies;
 
     PhysicsStatistics()
     {
@@ -832,6 +832,15 @@ bool AndroidPlatform::Init()
     if (sched_getaffinity(0, sizeof(cpus), &cpus) == 0)
     {
         AndroidCpu.ProcessorCoreCount = AndroidCpu.LogicalProcessorCount = CPU_COUNT(&cpus);
+
+        // Detect big.LITTLE cores
+        uint64 processorsMask = 0;
+        for (int32 cpuIdx = 0; cpuIdx < 64; cpuIdx++)
+        {
+            if (CPU_ISSET(cpuIdx, &cpus))
+                processorsMask |= 1ull << cpuIdx;
+        }
+        GetProcessorsTopology(processorsMask, AndroidCpu.PrimaryProcessorsMask, AndroidCpu.PerformanceProcessorsMask);
     }
     else
     {
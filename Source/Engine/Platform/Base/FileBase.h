@@ -129,6 +129,33 @@ class FLAXENGINE_API FileBase : public NonCopyable
     /// <returns>True if file is opened, otherwise false.</returns>
     virtual bool IsOpened() const = 0;
 
+    /// <summary>
+    /// Hints the system to asynchronously read the given file region into the memory (eg. page cache) so the following reads of it don't block on the storage device.
+    /// </summary>
+    /// <param name="offset">The region start offset (in bytes).</param>
+    /// <param name="size">The region size (in bytes).</param>
+    virtual void Prefetch(uint32 offset, uint32 size) const
+    {
+    }
+
+    /// <summary>
+    /// Maps the whole file contents into the process address space. Pages are loaded on access and writes are private to the process (copy-on-write), the file on disk is never modified.
+    /// </summary>
+    /// <returns>The pointer to the mapped file contents or null if failed or not supported by the platform.</returns>
+    virtual void* Map()
+    {
+        return nullptr;
+    }
+
+    /// <summary>
+    /// Unmaps the file memory view created with Map.
+    /// </summary>
+    /// <param name="view">The mapped memory view.</param>
+    /// <param name="size">The mapped memory size (file size at the time of mapping).</param>
+    virtual void Unmap(void* view, uint32 size)
+    {
+    }
+
 public:
     static bool ReadAllBytes(const StringView& path, byte* data, int32 length);
     static bool ReadAllBytes(const StringView& path, Array<byte, HeapAllocation>& data);
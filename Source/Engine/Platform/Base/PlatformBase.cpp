@@ -17,6 +17,7 @@
 #include "Engine/Core/Utilities.h"
 #if COMPILE_WITH_PROFILER
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #endif
 #include "Engine/Threading/Threading.h"
 #include "Engine/Engine/CommandLine.h"
@@ -205,11 +206,15 @@ void PlatformBase::OnMemoryAlloc(void* ptr, uint64 size)
     tracy::Profiler::MemAllocCallstack(ptr, (size_t)size, 12, false);
 #endif
 
+    // Track memory allocation per group
+    if (ProfilerMemory::Enabled)
+        ProfilerMemory::OnAlloc(ptr, size);
+
     // Register allocation during the current CPU event
     auto thread = ProfilerCPU::GetCurrentThread();
     if (thread != nullptr && thread->Buffer.GetCount() != 0)
     {
-        auto& activeEvent = thread->Buffer.Last().Event();
+        auto& activeEvent = thread->Buffer.Last();
         if (activeEvent.End < ZeroTolerance)
         {
             activeEvent.NativeMemoryAllocation += (int32)size;
@@ -226,6 +231,10 @@ void PlatformBase::OnMemoryFree(void* ptr)
     // Track memory allocation in Tracy
     tracy::Profiler::MemFree(ptr, false);
 #endif
+
+    // Track memory allocation per group
+    if (ProfilerMemory::Enabled)
+        ProfilerMemory::OnFree(ptr);
 }
 
 #endif
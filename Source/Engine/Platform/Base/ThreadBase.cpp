@@ -4,6 +4,9 @@
 #include "Engine/Threading/IRunnable.h"
 #include "Engine/Threading/ThreadRegistry.h"
 #include "Engine/Core/Log.h"
+#if USE_POOL_ALLOCATOR
+#include "Engine/Core/Memory/PoolAllocator.h"
+#endif
 #include "Engine/Scripting/ManagedCLR/MCore.h"
 #if TRACY_ENABLE
 #include "Engine/Core/Math/Math.h"
@@ -111,6 +114,9 @@ int32 ThreadBase::Run()
     _isRunning = false;
     ThreadExiting(thread, exitCode);
     ThreadRegistry::Remove(thread);
+#if USE_POOL_ALLOCATOR
+    PoolAllocator::FlushThreadCache();
+#endif
     MCore::Thread::Exit(); // TODO: use mono_thread_detach instead of ext and unlink mono runtime from thread in ThreadExiting delegate
     // mono terminates the native thread..
 
@@ -55,4 +55,14 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(CPUInfo);
     /// The CPU cache line size (in bytes).
     /// </summary>
     API_FIELD() uint32 CacheLineSize;
+
+    /// <summary>
+    /// The mask of the logical processors that are the first hardware thread of each physical core (excluding SMT/Hyper-Threading siblings). Zero if unknown.
+    /// </summary>
+    API_FIELD() uint64 PrimaryProcessorsMask;
+
+    /// <summary>
+    /// The mask of the logical processors located on the high-performance cores of the hybrid CPU (eg. P-cores on Intel hybrid or big cores on ARM big.LITTLE). Contains all processors if CPU is not hybrid. Zero if unknown.
+    /// </summary>
+    API_FIELD() uint64 PerformanceProcessorsMask;
 };
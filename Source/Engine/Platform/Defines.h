@@ -221,6 +221,9 @@ API_ENUM() enum class ArchitectureType
 #if defined(__SSE4_2__)
 #define PLATFORM_SIMD_SSE4_2 1
 #endif
+#if defined(__AVX2__)
+#define PLATFORM_SIMD_AVX2 1
+#endif
 #endif
 #if defined(_M_ARM) || defined(__ARM_NEON__) || defined(__ARM_NEON)
 #define PLATFORM_SIMD_NEON 1
@@ -2009,6 +2009,14 @@ bool LinuxPlatform::Init()
         UnixCpu.ProcessorPackageCount = packagesCount;
         UnixCpu.ProcessorCoreCount = Math::Max(numberOfCores, 1);
         UnixCpu.LogicalProcessorCount = CPU_COUNT(&cpus);
+
+        uint64 processorsMask = 0;
+        for (int32 cpuIdx = 0; cpuIdx < 64; cpuIdx++)
+        {
+            if (CPU_ISSET(cpuIdx, &cpus))
+                processorsMask |= 1ull << cpuIdx;
+        }
+        GetProcessorsTopology(processorsMask, UnixCpu.PrimaryProcessorsMask, UnixCpu.PerformanceProcessorsMask);
     }
     else
     {
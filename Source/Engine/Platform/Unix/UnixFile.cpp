@@ -15,6 +15,7 @@
 #endif
 #include <sys/file.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <cerrno>
@@ -157,4 +158,35 @@ bool UnixFile::IsOpened() const
     return _handle != -1;
 }
 
+void UnixFile::Prefetch(uint32 offset, uint32 size) const
+{
+#if PLATFORM_LINUX || PLATFORM_ANDROID
+    if (_handle != -1)
+        posix_fadvise(_handle, offset, size, POSIX_FADV_WILLNEED);
+#elif PLATFORM_MAC || PLATFORM_IOS
+    if (_handle != -1)
+    {
+        radvisory advisory;
+        advisory.ra_offset = offset;
+        advisory.ra_count = (int)size;
+        fcntl(_handle, F_RDADVISE, &advisory);
+    }
+#endif
+}
+
+void* UnixFile::Map()
+{
+    const uint32 size = _handle != -1 ? GetSize() : 0;
+    if (size == 0)
+        return nullptr;
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, _handle, 0);
+    return view != MAP_FAILED ? view : nullptr;
+}
+
+void UnixFile::Unmap(void* view, uint32 size)
+{
+    if (view)
+        munmap(view, size);
+}
+
 #endif
@@ -51,6 +51,9 @@ class FLAXENGINE_API UnixFile : public FileBase
     uint32 GetPosition() const override;
     void SetPosition(uint32 seek) override;
     bool IsOpened() const override;
+    void Prefetch(uint32 offset, uint32 size) const override;
+    void* Map() override;
+    void Unmap(void* view, uint32 size) override;
 };
 
 #endif
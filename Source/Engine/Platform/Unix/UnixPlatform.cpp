@@ -7,6 +7,7 @@
 #include <unistd.h>
 #include <cstdint>
 #include <stdlib.h>
+#include <stdio.h>
 
 typedef uint16_t offset_t;
 #define align_mem_up(num, align) (((num) + ((align) - 1)) & ~((align) - 1))
@@ -55,6 +56,54 @@ void UnixPlatform::Free(void* ptr)
     }
 }
 
+void UnixPlatform::GetProcessorsTopology(uint64 processorsMask, uint64& primaryMask, uint64& performanceMask)
+{
+    char fileNameBuffer[256];
+    uint64 maxFrequencies[64];
+    uint64 minFrequency = MAX_uint64;
+    primaryMask = 0;
+    performanceMask = 0;
+    for (int32 cpuIdx = 0; cpuIdx < 64; cpuIdx++)
+    {
+        maxFrequencies[cpuIdx] = 0;
+        if ((processorsMask & (1ull << cpuIdx)) == 0)
+            continue;
+
+        // Processor is primary if it's the first on the siblings list of its core (eg. '0,8' or '0-1')
+        int32 firstSibling = cpuIdx;
+        sprintf(fileNameBuffer, "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpuIdx);
+        if (FILE* file = fopen(fileNameBuffer, "r"))
+        {
+            if (fscanf(file, "%d", &firstSibling) != 1)
+                firstSibling = cpuIdx;
+            fclose(file);
+        }
+        if (firstSibling == cpuIdx || (processorsMask & (1ull << firstSibling)) == 0)
+            primaryMask |= 1ull << cpuIdx;
+
+        // Hybrid CPUs have cores with different max frequency
+        sprintf(fileNameBuffer, "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpuIdx);
+        if (FILE* file = fopen(fileNameBuffer, "r"))
+        {
+            unsigned long long frequency;
+            if (fscanf(file, "%llu", &frequency) == 1)
+                maxFrequencies[cpuIdx] = frequency;
+            fclose(file);
+        }
+        if (maxFrequencies[cpuIdx] < minFrequency)
+            minFrequency = maxFrequencies[cpuIdx];
+    }
+
+    // Cores slower than the others are considered efficiency cores
+    for (int32 cpuIdx = 0; cpuIdx < 64; cpuIdx++)
+    {
+        if (maxFrequencies[cpuIdx] > minFrequency)
+            performanceMask |= 1ull << cpuIdx;
+    }
+    if (performanceMask == 0)
+        performanceMask = processorsMask;
+}
+
 uint64 UnixPlatform::GetCurrentProcessId()
 {
     return getpid();
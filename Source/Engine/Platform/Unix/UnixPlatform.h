@@ -17,6 +17,10 @@ class FLAXENGINE_API UnixPlatform : public PlatformBase
     static void* Allocate(uint64 size, uint64 alignment);
     static void Free(void* ptr);
     static uint64 GetCurrentProcessId();
+
+protected:
+    // Detects SMT siblings and hybrid CPU cores classes using sysfs (processors above 64 are ignored).
+    static void GetProcessorsTopology(uint64 processorsMask, uint64& primaryMask, uint64& performanceMask);
 };
 
 #endif
@@ -5,6 +5,7 @@
 #include "Win32File.h"
 #include "Engine/Core/Types/String.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Math.h"
 #include "IncludeWindowsHeaders.h"
 
 Win32File::~Win32File()
@@ -108,4 +109,54 @@ bool Win32File::IsOpened() const
     return _handle != nullptr;
 }
 
+#if PLATFORM_WINDOWS
+
+void Win32File::Prefetch(uint32 offset, uint32 size) const
+{
+    // Only the mapped file view supports asynchronous read-ahead (PrefetchVirtualMemory is available since Windows 8)
+    if (!_view || offset >= _viewSize)
+        return;
+    struct MemoryRangeEntry
+    {
+        PVOID VirtualAddress;
+        SIZE_T NumberOfBytes;
+    };
+    typedef BOOL (WINAPI*PrefetchVirtualMemoryProc)(HANDLE, ULONG_PTR, MemoryRangeEntry*, ULONG);
+    static PrefetchVirtualMemoryProc prefetchVirtualMemory = (PrefetchVirtualMemoryProc)GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "PrefetchVirtualMemory");
+    if (!prefetchVirtualMemory)
+        return;
+    MemoryRangeEntry range;
+    range.VirtualAddress = (byte*)_view + offset;
+    range.NumberOfBytes = Math::Min(size, _viewSize - offset);
+    prefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+void* Win32File::Map()
+{
+    if (!_handle || _view)
+        return nullptr;
+    HANDLE mapping = CreateFileMappingW(_handle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (!mapping)
+        return nullptr;
+    _view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    _viewSize = _view ? GetSize() : 0;
+
+    // View keeps the mapping object alive
+    CloseHandle(mapping);
+    return _view;
+}
+
+void Win32File::Unmap(void* view, uint32 size)
+{
+    if (view)
+        UnmapViewOfFile(view);
+    if (view == _view)
+    {
+        _view = nullptr;
+        _viewSize = 0;
+    }
+}
+
+#endif
+
 #endif
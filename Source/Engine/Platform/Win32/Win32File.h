@@ -14,6 +14,10 @@ class FLAXENGINE_API Win32File : public FileBase
 private:
 
     void* _handle;
+#if PLATFORM_WINDOWS
+    void* _view = nullptr;
+    uint32 _viewSize = 0;
+#endif
 
 public:
 
@@ -54,6 +58,11 @@ class FLAXENGINE_API Win32File : public FileBase
     uint32 GetPosition() const override;
     void SetPosition(uint32 seek) override;
     bool IsOpened() const override;
+#if PLATFORM_WINDOWS
+    void Prefetch(uint32 offset, uint32 size) const override;
+    void* Map() override;
+    void Unmap(void* view, uint32 size) override;
+#endif
 };
 
 #endif
@@ -162,6 +162,36 @@ bool Win32Platform::Init()
         CpuInfo.CacheLineSize = args[2] & 0xFF;
         ASSERT(CpuInfo.CacheLineSize && Math::IsPowerOfTwo(CpuInfo.CacheLineSize));
     }
+#if PLATFORM_WINDOWS
+    {
+        // Detect SMT siblings and hybrid CPU cores (processors from the first group only)
+        DWORD length = 0;
+        GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+        byte* infoBuffer = length != 0 ? (byte*)malloc(length) : nullptr;
+        if (infoBuffer && GetLogicalProcessorInformationEx(RelationProcessorCore, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)infoBuffer, &length))
+        {
+            BYTE maxEfficiencyClass = 0;
+            for (DWORD offset = 0; offset < length;)
+            {
+                auto info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(infoBuffer + offset);
+                maxEfficiencyClass = Math::Max(maxEfficiencyClass, info->Processor.EfficiencyClass);
+                offset += info->Size;
+            }
+            for (DWORD offset = 0; offset < length;)
+            {
+                auto info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(infoBuffer + offset);
+                offset += info->Size;
+                if (info->Processor.GroupCount == 0 || info->Processor.GroupMask[0].Group != 0)
+                    continue;
+                const uint64 coreMask = (uint64)info->Processor.GroupMask[0].Mask;
+                CpuInfo.PrimaryProcessorsMask |= coreMask & (~coreMask + 1);
+                if (info->Processor.EfficiencyClass == maxEfficiencyClass)
+                    CpuInfo.PerformanceProcessorsMask |= coreMask;
+            }
+        }
+        free(infoBuffer);
+    }
+#endif
 
     // Setup unique device ID
     {
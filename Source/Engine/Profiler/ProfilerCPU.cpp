@@ -5,18 +5,84 @@
 #include "ProfilerCPU.h"
 #include "Engine/Engine/Globals.h"
 #include "Engine/Threading/ThreadRegistry.h"
+#include "Engine/Platform/CriticalSection.h"
+
+namespace
+{
+    CriticalSection NamesLocker;
+    Array<String> Names;
+    Dictionary<uint32, int32> NamesLookup;
+
+    template<typename CharType>
+    uint32 GetNameHash(const CharType* name)
+    {
+        // Match the events name length limit
+        uint32 hash = 0;
+        if (name)
+        {
+            for (int32 i = 0; name[i] && i < ARRAY_COUNT(ProfilerCPU::Event::Name) - 1; i++)
+                hash = ((hash << 5) + hash) + (uint32)name[i];
+        }
+        return hash;
+    }
+
+    template<typename CharType>
+    int32 InternName(uint32 hash, const CharType* name)
+    {
+        // Names with the same hash share the identifier (collisions are very unlikely and affect only the displayed name)
+        ScopeLock lock(NamesLocker);
+        int32 id;
+        if (!NamesLookup.TryGet(hash, id))
+        {
+            if (Names.IsEmpty())
+                Names.Add(String::Empty);
+            id = Names.Count();
+            String& str = Names.AddOne();
+            if (name)
+            {
+                int32 length = 0;
+                while (name[length] && length < ARRAY_COUNT(ProfilerCPU::Event::Name) - 1)
+                    length++;
+                str.Set(name, length);
+            }
+            NamesLookup.Add(hash, id);
+        }
+        return id;
+    }
+
+    ProfilerCPU::Thread* GetThread()
+    {
+        auto thread = ProfilerCPU::Thread::Current;
+        if (thread == nullptr)
+        {
+            const auto id = Platform::GetCurrentThreadID();
+            const auto t = ThreadRegistry::GetThread(id);
+            if (t)
+                thread = New<ProfilerCPU::Thread>(t->GetName());
+            else if (id == Globals::MainThreadID)
+                thread = New<ProfilerCPU::Thread>(TEXT("Main"));
+            else
+                thread = New<ProfilerCPU::Thread>(TEXT("Thread"));
+
+            ProfilerCPU::Thread::Current = thread;
+            ProfilerCPU::Threads.Add(thread);
+        }
+        return thread;
+    }
+}
 
 THREADLOCAL ProfilerCPU::Thread* ProfilerCPU::Thread::Current = nullptr;
 Array<ProfilerCPU::Thread*, InlinedAllocation<64>> ProfilerCPU::Threads;
 bool ProfilerCPU::Enabled = false;
+float ProfilerCPU::MinEventDuration = 0.0f;
 
 ProfilerCPU::EventBuffer::EventBuffer()
 {
     _capacity = 8192;
     _capacityMask = _capacity - 1;
-    _data = NewArray<Event>(_capacity);
+    _data = NewArray<EventData>(_capacity);
     _head = 0;
-    _count = 0;
+    _tail = 0;
 }
 
 ProfilerCPU::EventBuffer::~EventBuffer()
@@ -24,45 +90,45 @@ ProfilerCPU::EventBuffer::~EventBuffer()
     DeleteArray(_data, _capacity);
 }
 
+void ProfilerCPU::EventBuffer::EndLast(double time)
+{
+    const int64 first = Math::Max(_tail, _head - _capacity);
+    for (int64 i = _head - 1; i >= first; i--)
+    {
+        EventData& e = _data[(int32)i & _capacityMask];
+        if (e.End <= 0)
+        {
+            e.End = time;
+            break;
+        }
+    }
+}
+
 void ProfilerCPU::EventBuffer::Extract(Array<Event>& data, bool withRemoval)
 {
     data.Clear();
 
-    // Peek ring buffer state
-    int32 count = _count;
-    const int32 capacity = _capacity;
-
-    // Skip if empty
-    if (count == 0)
+    // Peek ring buffer state (skip events overwritten by the writer, keep a single slot margin for the event that is being written)
+    const int64 head = Platform::AtomicRead(&_head);
+    const int64 tail = Math::Max(_tail, head - _capacity + 1);
+    if (tail >= head)
         return;
 
-    // Fix iterators when buffer is full (begin == end)
-    if (count == capacity)
-    {
-        _count--;
-        count--;
-    }
-
     // Find the first item (skip non-root events)
-    Iterator firstEvent = Begin();
-    for (auto i = firstEvent; i.IsNotEnd(); ++i)
-    {
-        if (i.Event().Depth == 0)
-        {
-            firstEvent = i;
-            break;
-        }
-    }
+    int64 firstEvent = tail;
+    while (firstEvent < head && _data[(int32)firstEvent & _capacityMask].Depth != 0)
+        firstEvent++;
 
     // Skip if no root event found inside the buffer
-    if (firstEvent.IsEnd())
+    if (firstEvent == head)
         return;
 
     // Find the last item (last event in ended root event)
-    Iterator lastEndedRoot = End();
-    for (auto i = Last(); i != firstEvent; --i)
+    int64 lastEndedRoot = -1;
+    for (int64 i = head - 1; i >= firstEvent; i--)
     {
-        if (i.Event().Depth == 0 && i.Event().End > 0)
+        const EventData& e = _data[(int32)i & _capacityMask];
+        if (e.Depth == 0 && e.End > 0)
         {
             lastEndedRoot = i;
             break;
@@ -70,50 +136,61 @@ void ProfilerCPU::EventBuffer::Extract(Array<Event>& data, bool withRemoval)
     }
 
     // Skip if no finished root event found inside the buffer
-    if (lastEndedRoot.IsEnd())
+    if (lastEndedRoot == -1)
         return;
 
     // Find the last non-root event in last root event
-    Iterator lastEvent = lastEndedRoot;
-    const double lastRootEventEndTime = lastEndedRoot.Event().End;
-    for (auto i = --End(); i != lastEndedRoot; --i)
+    int64 lastEvent = lastEndedRoot;
+    const double lastRootEventEndTime = _data[(int32)lastEndedRoot & _capacityMask].End;
+    for (int64 i = head - 1; i > lastEndedRoot; i--)
     {
-        if (i.Event().End > 0 && i.Event().End <= lastRootEventEndTime)
+        const EventData& e = _data[(int32)i & _capacityMask];
+        if (e.End > 0 && e.End <= lastRootEventEndTime)
         {
             lastEvent = i;
             break;
         }
     }
 
-    if (withRemoval)
+    // Extract all the events between [firstEvent, lastEvent] and resolve their names
+    const int32 count = (int32)(lastEvent - firstEvent + 1);
+    data.Resize(count, false);
+    NamesLocker.Lock();
+    for (int32 i = 0; i < count; i++)
     {
-        // Remove all the events between [Begin(), lastEvent]
-        _count -= (lastEvent.Index() - Begin().Index()) & _capacityMask;
+        const EventData& src = _data[(int32)(firstEvent + i) & _capacityMask];
+        Event& dst = data.Get()[i];
+        dst.Start = src.Start;
+        dst.End = src.End;
+        dst.Depth = src.Depth;
+        dst.NativeMemoryAllocation = src.NativeMemoryAllocation;
+        dst.ManagedMemoryAllocation = src.ManagedMemoryAllocation;
+        const int32 nameLength = src.NameId > 0 && src.NameId < Names.Count() ? Names.Get()[src.NameId].Length() : 0;
+        if (nameLength != 0)
+            Platform::MemoryCopy(dst.Name, Names.Get()[src.NameId].Get(), nameLength * sizeof(Char));
+        dst.Name[nameLength] = 0;
     }
+    NamesLocker.Unlock();
 
-    // Extract all the events between [firstEvent, lastEvent]
-    const int32 head = (lastEvent.Index() + 1) & _capacityMask;
-    count = (lastEvent.Index() - firstEvent.Index() + 1) & _capacityMask;
-    data.Resize(count, false);
-    const int32 tail = (head - count) & _capacityMask;
-    const int32 spaceLeft = capacity - tail;
-    const int32 spaceLeftCount = Math::Min(spaceLeft, count);
-    const int32 overflow = count - spaceLeft;
-    Platform::MemoryCopy(data.Get(), &_data[tail], spaceLeftCount * sizeof(Event));
-    if (overflow > 0)
-        Platform::MemoryCopy(data.Get() + spaceLeftCount, &_data[0], overflow * sizeof(Event));
+    if (withRemoval)
+    {
+        // Remove all the events up to the lastEvent
+        Platform::AtomicStore(&_tail, lastEvent + 1);
+    }
 }
 
-int32 ProfilerCPU::Thread::BeginEvent()
+int32 ProfilerCPU::Thread::BeginEvent(int32 nameId)
 {
     const double time = Platform::GetTimeSeconds() * 1000.0;
-    const auto index = Buffer.Add();
-    Event& e = Buffer.Get(index);
+    int32 index;
+    EventData& e = Buffer.Next(index);
     e.Start = time;
     e.End = 0;
     e.Depth = _depth++;
+    e.NameId = nameId;
     e.NativeMemoryAllocation = 0;
     e.ManagedMemoryAllocation = 0;
+    Buffer.Push();
     return index;
 }
 
@@ -121,7 +198,9 @@ void ProfilerCPU::Thread::EndEvent(int32 index)
 {
     const double time = Platform::GetTimeSeconds() * 1000.0;
     _depth--;
-    Event& e = Buffer.Get(index);
+    EventData& e = Buffer.Get(index);
+    if (time - e.Start < MinEventDuration && Buffer.Pop(index))
+        return;
     e.End = time;
 }
 
@@ -129,15 +208,31 @@ void ProfilerCPU::Thread::EndEvent()
 {
     const double time = Platform::GetTimeSeconds() * 1000.0;
     _depth--;
-    for (auto i = Buffer.Last(); i != Buffer.Begin(); --i)
+    Buffer.EndLast(time);
+}
+
+int32 ProfilerCPU::Thread::GetNameId(const Char* name)
+{
+    const uint32 hash = GetNameHash(name);
+    int32 id;
+    if (!_namesCache.TryGet(hash, id))
     {
-        Event& e = i.Event();
-        if (e.End <= 0)
-        {
-            e.End = time;
-            break;
-        }
+        id = InternName(hash, name);
+        _namesCache.Add(hash, id);
     }
+    return id;
+}
+
+int32 ProfilerCPU::Thread::GetNameId(const char* name)
+{
+    const uint32 hash = GetNameHash(name);
+    int32 id;
+    if (!_namesCache.TryGet(hash, id))
+    {
+        id = InternName(hash, name);
+        _namesCache.Add(hash, id);
+    }
+    return id;
 }
 
 bool ProfilerCPU::IsProfilingCurrentThread()
@@ -154,60 +249,23 @@ int32 ProfilerCPU::BeginEvent()
 {
     if (!Enabled)
         return -1;
-    auto thread = Thread::Current;
-    if (thread == nullptr)
-    {
-        const auto id = Platform::GetCurrentThreadID();
-        const auto t = ThreadRegistry::GetThread(id);
-        if (t)
-            thread = New<Thread>(t->GetName());
-        else if (id == Globals::MainThreadID)
-            thread = New<Thread>(TEXT("Main"));
-        else
-            thread = New<Thread>(TEXT("Thread"));
-
-        Thread::Current = thread;
-        Threads.Add(thread);
-    }
-    return thread->BeginEvent();
+    return GetThread()->BeginEvent();
 }
 
 int32 ProfilerCPU::BeginEvent(const Char* name)
 {
     if (!Enabled)
         return -1;
-    const auto index = BeginEvent();
-    const auto thread = Thread::Current;
-    auto& e = thread->Buffer.Get(index);
-    auto dst = e.Name;
-    auto src = name;
-    if (src)
-    {
-        const auto end = dst + ARRAY_COUNT(e.Name) - 1;
-        while (*src && dst != end)
-            *dst++ = *src++;
-    }
-    *dst = 0;
-    return index;
+    auto thread = GetThread();
+    return thread->BeginEvent(thread->GetNameId(name));
 }
 
 int32 ProfilerCPU::BeginEvent(const char* name)
 {
     if (!Enabled)
         return -1;
-    const auto index = BeginEvent();
-    const auto thread = Thread::Current;
-    auto& e = thread->Buffer.Get(index);
-    auto dst = e.Name;
-    auto src = name;
-    if (src)
-    {
-        const auto end = dst + ARRAY_COUNT(e.Name) - 1;
-        while (*src && dst != end)
-            *dst++ = *src++;
-    }
-    *dst = 0;
-    return index;
+    auto thread = GetThread();
+    return thread->BeginEvent(thread->GetNameId(name));
 }
 
 void ProfilerCPU::EndEvent(int32 index)
@@ -222,10 +280,20 @@ void ProfilerCPU::EndEvent()
         Thread::Current->EndEvent();
 }
 
+String ProfilerCPU::GetEventName(int32 nameId)
+{
+    ScopeLock lock(NamesLocker);
+    return nameId > 0 && nameId < Names.Count() ? Names[nameId] : String::Empty;
+}
+
 void ProfilerCPU::Dispose()
 {
     Enabled = false;
     Threads.ClearDelete();
+    NamesLocker.Lock();
+    Names.Clear();
+    NamesLookup.Clear();
+    NamesLocker.Unlock();
 
     // Cleanup memory, note: calls to profiler after this point will end up with a crash (Thread::Current is invalid)
 }
@@ -7,6 +7,7 @@
 #include "Engine/Core/Types/String.h"
 #include "Engine/Core/Math/Math.h"
 #include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Scripting/ScriptingType.h"
 #include <ThirdParty/tracy/tracy/Tracy.hpp>
 
@@ -55,16 +56,52 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerCPU
     };
 
     /// <summary>
-    /// Implements simple profiling events ring-buffer.
+    /// Represents single CPU profiling event data recorded by the thread. Compact version of the Event that uses the interned name identifier.
+    /// </summary>
+    struct EventData
+    {
+        /// <summary>
+        /// The start time (in milliseconds).
+        /// </summary>
+        double Start;
+
+        /// <summary>
+        /// The end time (in milliseconds). Value 0 is used for the events that are still running.
+        /// </summary>
+        double End;
+
+        /// <summary>
+        /// The event depth. Value 0 is used for the root event.
+        /// </summary>
+        int32 Depth;
+
+        /// <summary>
+        /// The event name identifier (see GetEventName).
+        /// </summary>
+        int32 NameId;
+
+        /// <summary>
+        /// The native dynamic memory allocation size during this event (excluding the child events). Given value is in bytes.
+        /// </summary>
+        int32 NativeMemoryAllocation;
+
+        /// <summary>
+        /// The managed memory allocation size during this event (excluding the child events). Given value is in bytes.
+        /// </summary>
+        int32 ManagedMemoryAllocation;
+    };
+
+    /// <summary>
+    /// Implements profiling events ring-buffer with a single writer (the owning thread) and a single reader (the profiling tools). Doesn't use locking.
     /// </summary>
     class EventBuffer : public NonCopyable
     {
     private:
-        Event* _data;
+        EventData* _data;
         int32 _capacity;
         int32 _capacityMask;
-        int32 _head;
-        int32 _count;
+        int64 volatile _head; // Amount of events written (modified only by the writer)
+        int64 volatile _tail; // Amount of events consumed (modified only by the reader)
 
     public:
         EventBuffer();
@@ -76,7 +113,7 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerCPU
         /// </summary>
         FORCE_INLINE int32 GetCount() const
         {
-            return _count;
+            return (int32)Math::Min<int64>(_head - _tail, _capacity);
         }
 
         /// <summary>
@@ -84,151 +121,64 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerCPU
         /// </summary>
         /// <param name="index">The index.</param>
         /// <returns>The event</returns>
-        Event& Get(int32 index) const
+        FORCE_INLINE EventData& Get(int32 index) const
         {
             ASSERT_LOW_LAYER(index >= 0 && index < _capacity);
             return _data[index];
         }
 
         /// <summary>
-        /// Adds new event to the buffer.
+        /// Gets the last event added to the buffer. Valid only if buffer is not empty.
         /// </summary>
-        /// <returns>The event index.</returns>
-        int32 Add()
+        FORCE_INLINE EventData& Last() const
         {
-            const int32 index = _head;
-            _head = (_head + 1) & _capacityMask;
-            _count = Math::Min(_count + 1, _capacity);
-            return index;
+            return _data[(int32)(_head - 1) & _capacityMask];
         }
 
         /// <summary>
-        /// Extracts the buffer data (only ended events starting from the root level with depth=0).
+        /// Gets the next event slot to write. Call Push after filling the event data to publish it to the reader. Writer-only.
         /// </summary>
-        /// <param name="data">The output data.</param>
-        /// <param name="withRemoval">True if also remove extracted events to prevent double-gather, false if don't modify the buffer data.</param>
-        void Extract(Array<Event, HeapAllocation>& data, bool withRemoval);
+        /// <param name="index">The event index.</param>
+        /// <returns>The event to write.</returns>
+        FORCE_INLINE EventData& Next(int32& index) const
+        {
+            index = (int32)_head & _capacityMask;
+            return _data[index];
+        }
 
-    public:
         /// <summary>
-        /// Ring buffer iterator
+        /// Publishes the event written via Next. Writer-only.
         /// </summary>
-        struct Iterator
-        {
-            friend EventBuffer;
-
-        private:
-            EventBuffer* _buffer;
-            int32 _index;
-
-            FORCE_INLINE Iterator(EventBuffer* buffer, const int32 index)
-                : _buffer(buffer)
-                , _index(index)
-            {
-            }
-
-        public:
-            FORCE_INLINE Iterator(const Iterator& other)
-                : _buffer(other._buffer)
-                , _index(other._index)
-            {
-            }
-
-            FORCE_INLINE Iterator(Iterator&& other) noexcept
-                : _buffer(other._buffer)
-                , _index(other._index)
-            {
-            }
-
-            FORCE_INLINE Iterator& operator=(Iterator&& other)
-            {
-                _buffer = other._buffer;
-                _index = other._index;
-                return *this;
-            }
-
-            FORCE_INLINE Iterator& operator=(const Iterator& other)
-            {
-                _buffer = other._buffer;
-                _index = other._index;
-                return *this;
-            }
-
-            FORCE_INLINE int32 Index() const
-            {
-                return _index;
-            }
-
-            FORCE_INLINE Event& Event() const
-            {
-                ASSERT_LOW_LAYER(_buffer && _index >= 0 && _index < _buffer->_capacity);
-                return _buffer->Get(_index);
-            }
-
-            FORCE_INLINE bool IsEnd() const
-            {
-                return _index == _buffer->_head;
-            }
-
-            FORCE_INLINE bool IsNotEnd() const
-            {
-                return _index != _buffer->_head;
-            }
-
-            FORCE_INLINE bool operator==(const Iterator& v) const
-            {
-                return _buffer == v._buffer && _index == v._index;
-            }
-
-            FORCE_INLINE bool operator!=(const Iterator& v) const
-            {
-                return _buffer != v._buffer || _index != v._index;
-            }
-
-        public:
-            FORCE_INLINE Iterator& operator++()
-            {
-                _index = (_index + 1) & _buffer->_capacityMask;
-                return *this;
-            }
-
-            FORCE_INLINE Iterator operator++(int)
-            {
-                Iterator temp = *this;
-                _index = (_index + 1) & _buffer->_capacityMask;
-                return temp;
-            }
-
-            FORCE_INLINE Iterator& operator--()
-            {
-                _index = (_index - 1) & _buffer->_capacityMask;
-                return *this;
-            }
-
-            FORCE_INLINE Iterator operator--(int)
-            {
-                Iterator temp = *this;
-                _index = (_index - 1) & _buffer->_capacityMask;
-                return temp;
-            }
-        };
-
-    public:
-        FORCE_INLINE Iterator Begin()
+        FORCE_INLINE void Push()
         {
-            return Iterator(this, (_head - _count) & _capacityMask);
+            Platform::AtomicStore(&_head, _head + 1);
         }
 
-        FORCE_INLINE Iterator Last()
+        /// <summary>
+        /// Removes the event from the buffer if it's the last one added (eg. to discard too short leaf events). Writer-only.
+        /// </summary>
+        /// <param name="index">The event index.</param>
+        /// <returns>True if event has been removed, otherwise false.</returns>
+        FORCE_INLINE bool Pop(int32 index)
         {
-            ASSERT(_count > 0);
-            return Iterator(this, (_head - 1) & _capacityMask);
+            if (((int32)(_head - 1) & _capacityMask) != index || _head <= _tail)
+                return false;
+            Platform::AtomicStore(&_head, _head - 1);
+            return true;
         }
 
-        FORCE_INLINE Iterator End()
-        {
-            return Iterator(this, _head);
-        }
+        /// <summary>
+        /// Ends the last running event. Writer-only.
+        /// </summary>
+        /// <param name="time">The end time (in milliseconds).</param>
+        void EndLast(double time);
+
+        /// <summary>
+        /// Extracts the buffer data (only ended events starting from the root level with depth=0). Reader-only.
+        /// </summary>
+        /// <param name="data">The output data.</param>
+        /// <param name="withRemoval">True if also remove extracted events to prevent double-gather, false if don't modify the buffer data.</param>
+        void Extract(Array<Event, HeapAllocation>& data, bool withRemoval);
     };
 
     /// <summary>
@@ -239,6 +189,7 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerCPU
     private:
         String _name;
         int32 _depth = 0;
+        Dictionary<uint32, int32> _namesCache;
 
     public:
         Thread(const Char* name)
@@ -275,8 +226,9 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerCPU
         /// <summary>
         /// Begins the event running on a this thread. Call EndEvent with index parameter equal to the returned value by BeginEvent function.
         /// </summary>
+        /// <param name="nameId">The event name identifier.</param>
         /// <returns>The event token.</returns>
-        int32 BeginEvent();
+        int32 BeginEvent(int32 nameId = 0);
 
         /// <summary>
         /// Ends the event running on a this thread.
@@ -288,6 +240,20 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerCPU
         /// Ends the last event running on a this thread.
         /// </summary>
         void EndEvent();
+
+        /// <summary>
+        /// Gets the interned event name identifier. Uses the local cache for the names already used by this thread.
+        /// </summary>
+        /// <param name="name">The event name.</param>
+        /// <returns>The name identifier.</returns>
+        int32 GetNameId(const Char* name);
+
+        /// <summary>
+        /// Gets the interned event name identifier. Uses the local cache for the names already used by this thread.
+        /// </summary>
+        /// <param name="name">The event name.</param>
+        /// <returns>The name identifier.</returns>
+        int32 GetNameId(const char* name);
     };
 
 public:
@@ -301,6 +267,11 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerCPU
     /// </summary>
     static bool Enabled;
 
+    /// <summary>
+    /// The minimum duration of the leaf events to record (in milliseconds). Shorter events without child events are discarded when they end (including their memory allocations stats) to reduce the profiling overhead and the timeline noise. Value 0 records all events.
+    /// </summary>
+    static float MinEventDuration;
+
 public:
     /// <summary>
     /// Determines whether the current (calling) thread is being profiled by the service (it may has no active profile block but is registered).
@@ -343,6 +314,13 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerCPU
     /// </summary>
     static void EndEvent();
 
+    /// <summary>
+    /// Gets the event name for the given interned name identifier.
+    /// </summary>
+    /// <param name="nameId">The name identifier.</param>
+    /// <returns>The event name.</returns>
+    static String GetEventName(int32 nameId);
+
     /// <summary>
     /// Releases resources. Calls to the profiling API after Dispose are not valid.
     /// </summary>
@@ -366,9 +344,15 @@ struct ScopeProfileBlockCPU
         Index = ProfilerCPU::BeginEvent(name);
     }
 
+    FORCE_INLINE ScopeProfileBlockCPU(const char* name, bool active)
+    {
+        Index = active ? ProfilerCPU::BeginEvent(name) : -1;
+    }
+
     FORCE_INLINE ~ScopeProfileBlockCPU()
     {
-        ProfilerCPU::EndEvent(Index);
+        if (Index != -1)
+            ProfilerCPU::EndEvent(Index);
     }
 };
 
@@ -378,6 +362,12 @@ struct TIsPODType<ProfilerCPU::Event>
     enum { Value = true };
 };
 
+template<>
+struct TIsPODType<ProfilerCPU::EventData>
+{
+    enum { Value = true };
+};
+
 #include "ProfilerSrcLoc.h"
 
 // Shortcut macros for profiling a single code block execution on CPU
@@ -392,6 +382,30 @@ struct TIsPODType<ProfilerCPU::Event>
 #define PROFILE_CPU_NAMED(name) ZoneNamedN(___tracy_scoped_zone, name, true); ScopeProfileBlockCPU ProfileBlockCPU(name)
 #endif
 
+// Profiling events categories (bit flags) used to filter the events at compile-time (eg. to keep only the coarse events in QA builds)
+#define PROFILE_CPU_CATEGORY_ENGINE (1 << 0)
+#define PROFILE_CPU_CATEGORY_CONTENT (1 << 1)
+#define PROFILE_CPU_CATEGORY_RENDERING (1 << 2)
+#define PROFILE_CPU_CATEGORY_LEVEL (1 << 3)
+#define PROFILE_CPU_CATEGORY_SCRIPTING (1 << 4)
+#define PROFILE_CPU_CATEGORY_PARTICLES (1 << 5)
+#define PROFILE_CPU_CATEGORY_PHYSICS (1 << 6)
+#define PROFILE_CPU_CATEGORY_ANIMATIONS (1 << 7)
+#define PROFILE_CPU_CATEGORY_AUDIO (1 << 8)
+#define PROFILE_CPU_CATEGORY_UI (1 << 9)
+#define PROFILE_CPU_CATEGORY_NAVIGATION (1 << 10)
+#define PROFILE_CPU_CATEGORY_NETWORKING (1 << 11)
+
+// The mask of the enabled profiling events categories (can be overridden from the build scripts via the global definitions)
+#ifndef PROFILE_CPU_CATEGORIES
+#define PROFILE_CPU_CATEGORIES 0xffffffff
+#endif
+
+// Shortcut macros for profiling a single code block execution on CPU within the events category (compiled out if category is not enabled)
+#define PROFILE_CPU_CATEGORY_ACTIVE(category) ((PROFILE_CPU_CATEGORIES & PROFILE_CPU_CATEGORY_##category) != 0)
+#define PROFILE_CPU_CAT(category) ZoneNamed(___tracy_scoped_zone, PROFILE_CPU_CATEGORY_ACTIVE(category)); ScopeProfileBlockCPU ProfileBlockCPU(__FUNCTION__, PROFILE_CPU_CATEGORY_ACTIVE(category))
+#define PROFILE_CPU_CAT_NAMED(category, name) ZoneNamedN(___tracy_scoped_zone, name, PROFILE_CPU_CATEGORY_ACTIVE(category)); ScopeProfileBlockCPU ProfileBlockCPU(name, PROFILE_CPU_CATEGORY_ACTIVE(category))
+
 #ifdef TRACY_ENABLE
 #define PROFILE_CPU_SRC_LOC(srcLoc) tracy::ScopedZone ___tracy_scoped_zone( (tracy::SourceLocationData*)&(srcLoc) ); ScopeProfileBlockCPU ProfileBlockCPU((srcLoc).name)
 #define PROFILE_CPU_ASSET(asset) ZoneScoped; const StringView __tracy_asset_name((asset)->GetPath()); ZoneName(*__tracy_asset_name, __tracy_asset_name.Length())
@@ -410,5 +424,7 @@ struct TIsPODType<ProfilerCPU::Event>
 #define PROFILE_CPU_SRC_LOC(srcLoc)
 #define PROFILE_CPU_ASSET(asset)
 #define PROFILE_CPU_ACTOR(actor)
+#define PROFILE_CPU_CAT(category)
+#define PROFILE_CPU_CAT_NAMED(category, name)
 
 #endif
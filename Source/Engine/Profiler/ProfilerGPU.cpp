@@ -15,6 +15,7 @@ int32 ProfilerGPU::_depth = 0;
 Array<GPUTimerQuery*> ProfilerGPU::_timerQueriesPool;
 Array<GPUTimerQuery*> ProfilerGPU::_timerQueriesFree;
 bool ProfilerGPU::Enabled = false;
+bool ProfilerGPU::PipelineStatistics = false;
 int32 ProfilerGPU::CurrentBuffer = 0;
 ProfilerGPU::EventBuffer ProfilerGPU::Buffers[PROFILER_GPU_EVENTS_FRAMES];
 
@@ -48,6 +49,8 @@ void ProfilerGPU::EventBuffer::TryResolve()
     {
         auto& e = _data[i];
         e.Time = e.Timer->GetResult();
+        if (!e.Timer->CollectPipelineStatistics || !e.Timer->GetPipelineStatistics(e.PipelineStats))
+            Platform::MemoryClear(&e.PipelineStats, sizeof(e.PipelineStats));
         _timerQueriesFree.Add(e.Timer);
         e.Timer = nullptr;
     }
@@ -105,6 +108,7 @@ int32 ProfilerGPU::BeginEvent(const Char* name)
     e.Name = name;
     e.Stats = RenderStatsData::Counter;
     e.Timer = GetTimerQuery();
+    e.Timer->CollectPipelineStatistics = PipelineStatistics;
     e.Timer->Begin();
     e.Depth = _depth++;
 
@@ -131,8 +135,10 @@ void ProfilerGPU::EndEvent(int32 index)
 
 void ProfilerGPU::BeginFrame()
 {
-    // Clear stats
+    // Clear stats (keep the state values that are not per-frame counters)
+    const int64 particleBuffersPoolMemory = RenderStatsData::Counter.ParticleBuffersPoolMemory;
     RenderStatsData::Counter = RenderStatsData();
+    RenderStatsData::Counter.ParticleBuffersPoolMemory = particleBuffersPoolMemory;
     _depth = 0;
     auto& buffer = Buffers[CurrentBuffer];
     buffer.FrameIndex = Engine::FrameCount;
@@ -5,10 +5,9 @@
 #include "Engine/Core/NonCopyable.h"
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Scripting/ScriptingType.h"
+#include "Engine/Graphics/GPUTimerQuery.h"
 #include "RenderStats.h"
 
-class GPUTimerQuery;
-
 #if COMPILE_WITH_PROFILER
 
 // Profiler events buffers capacity (tweaked manually)
@@ -45,6 +44,11 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerGPU
         /// </summary>
         API_FIELD() RenderStatsData Stats;
 
+        /// <summary>
+        /// The GPU pipeline statistics for this event (processed vertices, primitives and shader invocations). Valid only if PipelineStatistics was enabled and supported by the graphics backend, otherwise zeros.
+        /// </summary>
+        API_FIELD() GPUPipelineStatistics PipelineStats;
+
         /// <summary>
         /// The event execution time on a GPU (in milliseconds).
         /// </summary>
@@ -134,6 +138,11 @@ API_CLASS(Static) class FLAXENGINE_API ProfilerGPU
     /// </summary>
     API_FIELD() static bool Enabled;
 
+    /// <summary>
+    /// True if GPU profiling events should collect the pipeline statistics (vertices, primitives and shader invocations per event). Has additional GPU overhead. Supported on DirectX 11 and DirectX 12 (other backends report zeros).
+    /// </summary>
+    API_FIELD() static bool PipelineStatistics;
+
     /// <summary>
     /// The current frame buffer to collect events.
     /// </summary>
@@ -0,0 +1,277 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#if COMPILE_WITH_PROFILER
+
+#include "ProfilerMemory.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Utilities.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Core/Types/StringBuilder.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Platform/CriticalSection.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPUResource.h"
+#include "Engine/Scripting/Enums.h"
+
+// The maximum depth of the sampled allocation callstacks
+#define PROFILER_MEMORY_CALLSTACK_DEPTH 16
+
+bool ProfilerMemory::Enabled = false;
+int32 ProfilerMemory::CallstacksSampleRate = 0;
+
+namespace
+{
+    struct Allocation
+    {
+        uint64 Size;
+        uint32 Callstack;
+        ProfilerMemory::Groups Group;
+    };
+
+    struct Callstack
+    {
+        String Trace;
+        uint64 Size = 0;
+        uint64 Count = 0;
+        uint64 TotalCount = 0;
+
+        bool operator<(const Callstack& other) const
+        {
+            // Sort from the largest live memory size
+            return Size > other.Size;
+        }
+    };
+
+    struct MemoryTracking
+    {
+        CriticalSection Locker;
+        Dictionary<void*, Allocation> Allocations;
+        Dictionary<uint32, Callstack> Callstacks;
+        ProfilerMemory::GroupStats Groups[(int32)ProfilerMemory::Groups::MAX] = {};
+    };
+
+    THREADLOCAL ProfilerMemory::Groups CurrentGroup = ProfilerMemory::Groups::Unknown;
+    THREADLOCAL bool IsInsideTracking = false; // Skips allocations made by the tracking itself
+    int64 SampleCounter = 0;
+
+    MemoryTracking& GetTracking()
+    {
+        // Never destroyed to support allocations made during static objects destruction
+        alignas(MemoryTracking) static byte storage[sizeof(MemoryTracking)];
+        static MemoryTracking* tracking = new(storage) MemoryTracking();
+        return *tracking;
+    }
+
+    uint32 CaptureCallstack(Array<PlatformBase::StackFrame, HeapAllocation>& frames)
+    {
+        frames = Platform::GetStackFrames(3, PROFILER_MEMORY_CALLSTACK_DEPTH);
+        uint32 hash = 0;
+        for (const auto& frame : frames)
+            CombineHash(hash, frame.ProgramCounter);
+        return frames.HasItems() && hash == 0 ? 1 : hash;
+    }
+}
+
+Array<ProfilerMemory::GroupStats> ProfilerMemory::GetGroups()
+{
+    auto& tracking = GetTracking();
+    GroupStats groups[(int32)Groups::MAX];
+    tracking.Locker.Lock();
+    Platform::MemoryCopy(groups, tracking.Groups, sizeof(groups));
+    tracking.Locker.Unlock();
+    Array<GroupStats> result;
+    result.Set(groups, ARRAY_COUNT(groups));
+    return result;
+}
+
+Array<uint64> ProfilerMemory::GetGPUGroups()
+{
+    Array<uint64> result;
+    result.Resize((int32)GPUResourceType::MAX);
+    Platform::MemoryClear(result.Get(), result.Count() * sizeof(uint64));
+    if (GPUDevice::Instance)
+    {
+        for (const GPUResource* resource : GPUDevice::Instance->GetResources())
+            result[(int32)resource->GetResourceType()] += resource->GetMemoryUsage();
+    }
+    return result;
+}
+
+ProfilerMemory::Groups ProfilerMemory::GetGroup()
+{
+    return CurrentGroup;
+}
+
+void ProfilerMemory::SetGroup(Groups group)
+{
+    CurrentGroup = group;
+}
+
+bool ProfilerMemory::Dump(const StringView& path)
+{
+    StringBuilder output;
+    const Array<GroupStats> groups = GetGroups();
+    output.AppendFormat(TEXT("Memory report. Tracking: {0}, callstacks sample rate: {1}"), Enabled, CallstacksSampleRate);
+    output.AppendLine();
+    output.AppendLine();
+
+    // Groups
+    uint64 totalSize = 0;
+    output.Append(TEXT("Native memory per group:"));
+    output.AppendLine();
+    for (int32 i = 0; i < groups.Count(); i++)
+    {
+        const GroupStats& group = groups[i];
+        totalSize += group.Size;
+        if (group.TotalCount == 0)
+            continue;
+        output.AppendFormat(TEXT("\t{0}: {1} (peak: {2}), allocations: {3} (total: {4})"), ScriptingEnum::ToString((Groups)i), Utilities::BytesToText(group.Size), Utilities::BytesToText(group.Peak), group.Count, group.TotalCount);
+        output.AppendLine();
+    }
+    output.AppendFormat(TEXT("Total tracked: {0}"), Utilities::BytesToText(totalSize));
+    output.AppendLine();
+    output.AppendLine();
+
+    // GPU resources
+    const Array<uint64> gpuGroups = GetGPUGroups();
+    uint64 totalGpuSize = 0;
+    output.Append(TEXT("GPU memory per resource type:"));
+    output.AppendLine();
+    for (int32 i = 0; i < gpuGroups.Count(); i++)
+    {
+        totalGpuSize += gpuGroups[i];
+        output.AppendFormat(TEXT("\t{0}: {1}"), ScriptingEnum::ToString((GPUResourceType)i), Utilities::BytesToText(gpuGroups[i]));
+        output.AppendLine();
+    }
+    output.AppendFormat(TEXT("Total GPU: {0}"), Utilities::BytesToText(totalGpuSize));
+    output.AppendLine();
+    output.AppendLine();
+
+    // Sampled callstacks (with the live allocations)
+    Array<Callstack> callstacks;
+    {
+        auto& tracking = GetTracking();
+        tracking.Locker.Lock();
+        IsInsideTracking = true;
+        for (const auto& e : tracking.Callstacks)
+        {
+            if (e.Value.Count != 0)
+                callstacks.Add(e.Value);
+        }
+        IsInsideTracking = false;
+        tracking.Locker.Unlock();
+    }
+    if (callstacks.HasItems())
+    {
+        Sorting::QuickSort(callstacks.Get(), callstacks.Count());
+        output.AppendFormat(TEXT("Top sampled callstacks ({0}):"), callstacks.Count());
+        output.AppendLine();
+        for (int32 i = 0; i < Math::Min(callstacks.Count(), 100); i++)
+        {
+            const Callstack& callstack = callstacks[i];
+            output.AppendFormat(TEXT("Size: {0}, allocations: {1} (total: {2})"), Utilities::BytesToText(callstack.Size), callstack.Count, callstack.TotalCount);
+            output.AppendLine();
+            output.Append(callstack.Trace);
+            output.AppendLine();
+        }
+    }
+
+    LOG(Info, "Saving memory report to {0}", path);
+    return File::WriteAllText(path, output, Encoding::ANSI);
+}
+
+void ProfilerMemory::OnAlloc(void* ptr, uint64 size)
+{
+    if (IsInsideTracking)
+        return;
+    IsInsideTracking = true;
+    auto& tracking = GetTracking();
+    const Groups group = CurrentGroup;
+
+    // Capture the callstack of every N-th allocation
+    uint32 callstackHash = 0;
+    Array<PlatformBase::StackFrame, HeapAllocation> frames;
+    const int32 sampleRate = CallstacksSampleRate;
+    if (sampleRate > 0 && Platform::InterlockedIncrement(&SampleCounter) % sampleRate == 0)
+        callstackHash = CaptureCallstack(frames);
+
+    tracking.Locker.Lock();
+    Allocation* allocation = tracking.Allocations.TryGet(ptr);
+    if (allocation)
+    {
+        // Missing free (eg. allocation made when tracking was disabled)
+        auto& prevStats = tracking.Groups[(int32)allocation->Group];
+        prevStats.Size -= allocation->Size;
+        prevStats.Count--;
+    }
+    else
+    {
+        allocation = &tracking.Allocations[ptr];
+    }
+    allocation->Size = size;
+    allocation->Group = group;
+    allocation->Callstack = callstackHash;
+    GroupStats& stats = tracking.Groups[(int32)group];
+    stats.Size += size;
+    stats.Peak = Math::Max(stats.Peak, stats.Size);
+    stats.Count++;
+    stats.TotalCount++;
+    if (callstackHash != 0)
+    {
+        Callstack& callstack = tracking.Callstacks[callstackHash];
+        if (callstack.Trace.IsEmpty())
+        {
+            StringBuilder trace;
+            for (const auto& frame : frames)
+            {
+                trace.Append(TEXT("\t"));
+                trace.Append(String(frame.FunctionName));
+                if (frame.FileName[0])
+                    trace.AppendFormat(TEXT(" ({0}:{1})"), String(frame.FileName), frame.LineNumber);
+                trace.AppendLine();
+            }
+            callstack.Trace = trace.ToString();
+        }
+        callstack.Size += size;
+        callstack.Count++;
+        callstack.TotalCount++;
+    }
+    tracking.Locker.Unlock();
+
+    IsInsideTracking = false;
+}
+
+void ProfilerMemory::OnFree(void* ptr)
+{
+    if (IsInsideTracking)
+        return;
+    IsInsideTracking = true;
+    auto& tracking = GetTracking();
+
+    tracking.Locker.Lock();
+    const Allocation* allocation = tracking.Allocations.TryGet(ptr);
+    if (allocation)
+    {
+        GroupStats& stats = tracking.Groups[(int32)allocation->Group];
+        stats.Size -= allocation->Size;
+        stats.Count--;
+        if (allocation->Callstack != 0)
+        {
+            Callstack* callstack = tracking.Callstacks.TryGet(allocation->Callstack);
+            if (callstack)
+            {
+                callstack->Size -= allocation->Size;
+                callstack->Count--;
+            }
+        }
+        tracking.Allocations.Remove(ptr);
+    }
+    tracking.Locker.Unlock();
+
+    IsInsideTracking = false;
+}
+
+#endif
@@ -0,0 +1,171 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Core/Types/String.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Scripting/ScriptingType.h"
+
+#if COMPILE_WITH_PROFILER
+
+/// <summary>
+/// Provides native memory allocations tracking per engine subsystem (memory groups) with optional sampled callstacks for the leaks hunting.
+/// </summary>
+API_CLASS(Static) class FLAXENGINE_API ProfilerMemory
+{
+    DECLARE_SCRIPTING_TYPE_NO_SPAWN(ProfilerMemory);
+    friend class PlatformBase;
+public:
+    /// <summary>
+    /// List of memory groups used to tag the native allocations made by the certain engine subsystems.
+    /// </summary>
+    API_ENUM() enum class Groups : uint8
+    {
+        // Not categorized memory.
+        Unknown,
+        // Core engine systems and services.
+        Engine,
+        // Content assets (not categorized below).
+        Content,
+        // Textures and sprite atlases assets.
+        ContentTextures,
+        // Models and skinned models assets.
+        ContentModels,
+        // Animations, skeleton masks and animation graphs assets.
+        ContentAnimations,
+        // Audio clips assets.
+        ContentAudio,
+        // Materials, material instances and shaders assets.
+        ContentMaterials,
+        // Particle systems and emitters assets.
+        ContentParticles,
+        // Scenes and prefabs assets.
+        ContentScenes,
+        // Graphics device and GPU resources.
+        Graphics,
+        // Scene rendering.
+        Rendering,
+        // Scene objects and actors.
+        Level,
+        // Scripting runtime and scripts.
+        Scripting,
+        // Particles simulation.
+        Particles,
+        // Physics simulation.
+        Physics,
+        // Animations playback.
+        Animations,
+        // Audio playback.
+        Audio,
+        // User interface and 2D rendering.
+        UI,
+        // Navigation meshes.
+        Navigation,
+        // Networking.
+        Networking,
+
+        MAX
+    };
+
+    /// <summary>
+    /// The memory group stats.
+    /// </summary>
+    API_STRUCT(NoDefault) struct GroupStats
+    {
+        DECLARE_SCRIPTING_TYPE_MINIMAL(GroupStats);
+
+        /// <summary>
+        /// The currently allocated memory size (in bytes).
+        /// </summary>
+        API_FIELD() uint64 Size;
+
+        /// <summary>
+        /// The peak allocated memory size (in bytes).
+        /// </summary>
+        API_FIELD() uint64 Peak;
+
+        /// <summary>
+        /// The amount of the live allocations.
+        /// </summary>
+        API_FIELD() uint64 Count;
+
+        /// <summary>
+        /// The total amount of allocations made (including freed ones).
+        /// </summary>
+        API_FIELD() uint64 TotalCount;
+    };
+
+public:
+    /// <summary>
+    /// Enables the native memory allocations tracking. Adds overhead to each allocation so it's disabled by default (use -memprofiler command line switch to enable it from the engine startup). Allocations made before enabling tracking are not reported.
+    /// </summary>
+    API_FIELD() static bool Enabled;
+
+    /// <summary>
+    /// The sampling rate of the allocation callstacks capture. Value N means that every N-th allocation has its callstack recorded (it's slow so use large values). Value 0 disables callstacks capture.
+    /// </summary>
+    API_FIELD() static int32 CallstacksSampleRate;
+
+public:
+    /// <summary>
+    /// Gets the current memory stats of all groups (indexed with Groups enum).
+    /// </summary>
+    API_FUNCTION() static Array<GroupStats> GetGroups();
+
+    /// <summary>
+    /// Gets the current GPU memory usage of all GPU resources (in bytes) per resource type (indexed with GPUResourceType enum).
+    /// </summary>
+    API_FUNCTION() static Array<uint64> GetGPUGroups();
+
+    /// <summary>
+    /// Gets the memory group assigned to the native allocations made on the current thread.
+    /// </summary>
+    static Groups GetGroup();
+
+    /// <summary>
+    /// Sets the memory group assigned to the native allocations made on the current thread.
+    /// </summary>
+    /// <param name="group">The group.</param>
+    static void SetGroup(Groups group);
+
+    /// <summary>
+    /// Saves the memory report (groups stats, GPU memory per resource type and the top sampled callstacks) to the text file.
+    /// </summary>
+    /// <param name="path">The output file path.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    API_FUNCTION() static bool Dump(const StringView& path);
+
+private:
+    static void OnAlloc(void* ptr, uint64 size);
+    static void OnFree(void* ptr);
+};
+
+/// <summary>
+/// Helper structure used to assign the memory group for the native allocations within the scope.
+/// </summary>
+struct ScopeMemoryGroup
+{
+    ProfilerMemory::Groups PrevGroup;
+
+    FORCE_INLINE ScopeMemoryGroup(ProfilerMemory::Groups group)
+    {
+        PrevGroup = ProfilerMemory::GetGroup();
+        ProfilerMemory::SetGroup(group);
+    }
+
+    FORCE_INLINE ~ScopeMemoryGroup()
+    {
+        ProfilerMemory::SetGroup(PrevGroup);
+    }
+};
+
+// Shortcut macro for tagging native memory allocations within the scope
+#define PROFILE_MEM(group) ScopeMemoryGroup ProfileMemGroup(ProfilerMemory::Groups::group)
+
+#else
+
+// Empty macros for disabled profiler
+#define PROFILE_MEM(group)
+
+#endif
@@ -0,0 +1,225 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#if COMPILE_WITH_PROFILER
+
+#include "ProfilerTelemetry.h"
+#include "ProfilingTools.h"
+#include "ProfilerMemory.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Engine/EngineService.h"
+#include "Engine/Engine/CommandLine.h"
+#include "Engine/Platform/CriticalSection.h"
+#include "Engine/Serialization/FileWriteStream.h"
+#include "Engine/Serialization/MemoryWriteStream.h"
+#include "Engine/Streaming/Streaming.h"
+#include "Engine/Threading/Threading.h"
+#include "FlaxEngine.Gen.h"
+
+#define TELEMETRY_MAGIC 0x4C455446 // 'FTEL'
+#define TELEMETRY_VERSION 1
+
+float ProfilerTelemetry::HitchThresholdMs = 50.0f;
+int32 ProfilerTelemetry::MaxHitchCaptures = 200;
+
+namespace
+{
+    enum class ChunkTypes : byte
+    {
+        Frame = 1,
+        Hitch = 2,
+        Marker = 3,
+    };
+
+    CriticalSection TelemetryLocker;
+    FileWriteStream* TelemetryFile = nullptr;
+    MemoryWriteStream TelemetryChunk(4 * 1024);
+    double TelemetryStartTime = 0.0;
+    double LastFrameTime = 0.0;
+    int32 HitchCaptures = 0;
+
+    void WriteChunk(ChunkTypes type)
+    {
+        TelemetryFile->WriteByte((byte)type);
+        TelemetryFile->WriteUint32(TelemetryChunk.GetPosition());
+        TelemetryFile->WriteBytes(TelemetryChunk.GetHandle(), TelemetryChunk.GetPosition());
+        TelemetryChunk.SetPosition(0);
+    }
+
+    void WriteRenderStats(const RenderStatsData& stats)
+    {
+        TelemetryChunk.WriteInt64(stats.DrawCalls);
+        TelemetryChunk.WriteInt64(stats.DispatchCalls);
+        TelemetryChunk.WriteInt64(stats.Vertices);
+        TelemetryChunk.WriteInt64(stats.Triangles);
+        TelemetryChunk.WriteInt64(stats.PipelineStateChanges);
+        TelemetryChunk.WriteInt64(stats.StateBinds);
+        TelemetryChunk.WriteInt64(stats.RedundantStateBinds);
+        TelemetryChunk.WriteInt64(stats.ParticleBuffersCreated);
+        TelemetryChunk.WriteInt64(stats.ParticleBuffersReused);
+        TelemetryChunk.WriteInt64(stats.ParticleBuffersPoolMemory);
+    }
+}
+
+class ProfilerTelemetryService : public EngineService
+{
+public:
+    ProfilerTelemetryService()
+        : EngineService(TEXT("Profiler Telemetry"), 10) // After Profiling Tools to use the extracted profiler events
+    {
+    }
+
+    bool Init() override;
+    void Update() override;
+    void Dispose() override;
+};
+
+ProfilerTelemetryService ProfilerTelemetryServiceInstance;
+
+bool ProfilerTelemetryService::Init()
+{
+    if (CommandLine::Options.Telemetry.HasValue())
+        ProfilerTelemetry::Start(CommandLine::Options.Telemetry.GetValue());
+    return false;
+}
+
+void ProfilerTelemetryService::Update()
+{
+    if (!TelemetryFile)
+        return;
+    PROFILE_CPU();
+    ScopeLock lock(TelemetryLocker);
+    if (!TelemetryFile)
+        return;
+
+    // Measure the whole frame duration (between the updates)
+    const double time = Platform::GetTimeSeconds();
+    const float frameTimeMs = LastFrameTime > 0.0 ? (float)((time - LastFrameTime) * 1000.0) : 0.0f;
+    LastFrameTime = time;
+    const bool isHitch = ProfilerTelemetry::HitchThresholdMs > 0.0f && frameTimeMs > ProfilerTelemetry::HitchThresholdMs;
+
+    // Frame stats
+    const auto& stats = ProfilingTools::Stats;
+    TelemetryChunk.WriteUint64(Engine::FrameCount);
+    TelemetryChunk.WriteDouble(time - TelemetryStartTime);
+    TelemetryChunk.WriteFloat(frameTimeMs);
+    TelemetryChunk.WriteFloat(stats.UpdateTimeMs);
+    TelemetryChunk.WriteFloat(stats.PhysicsTimeMs);
+    TelemetryChunk.WriteFloat(stats.DrawCPUTimeMs);
+    TelemetryChunk.WriteFloat(stats.DrawGPUTimeMs);
+    TelemetryChunk.WriteInt32(stats.FPS);
+    WriteRenderStats(stats.DrawStats);
+    const StreamingStats streaming = Streaming::GetStats();
+    TelemetryChunk.WriteInt32(streaming.InFlightTasksCount);
+    TelemetryChunk.WriteUint64(streaming.InFlightBytes);
+    TelemetryChunk.WriteUint64(streaming.FrameStreamedBytes);
+    TelemetryChunk.WriteUint64(streaming.GPUMemoryUsage);
+    TelemetryChunk.WriteUint64(stats.ProcessMemory.UsedPhysicalMemory);
+    TelemetryChunk.WriteUint64(stats.MemoryGPU.Used);
+    if (ProfilerMemory::Enabled)
+    {
+        for (const auto& group : ProfilerMemory::GetGroups())
+            TelemetryChunk.WriteUint64(group.Size);
+    }
+    else
+    {
+        for (int32 i = 0; i < (int32)ProfilerMemory::Groups::MAX; i++)
+            TelemetryChunk.WriteUint64(0);
+    }
+    TelemetryChunk.WriteByte(isHitch ? 1 : 0);
+    WriteChunk(ChunkTypes::Frame);
+
+    // Hitch capture with the full profiler events (GPU events come from the last resolved frame which is usually few frames behind)
+    if (isHitch && HitchCaptures < ProfilerTelemetry::MaxHitchCaptures)
+    {
+        HitchCaptures++;
+        TelemetryChunk.WriteUint64(Engine::FrameCount);
+        TelemetryChunk.WriteFloat(frameTimeMs);
+        TelemetryChunk.WriteInt32(ProfilingTools::EventsCPU.Count());
+        for (const auto& thread : ProfilingTools::EventsCPU)
+        {
+            TelemetryChunk.Write(StringView(thread.Name));
+            TelemetryChunk.WriteInt32(thread.Events.Count());
+            for (const auto& e : thread.Events)
+            {
+                TelemetryChunk.WriteDouble(e.Start);
+                TelemetryChunk.WriteDouble(e.End);
+                TelemetryChunk.WriteInt32(e.Depth);
+                TelemetryChunk.Write(StringView(e.Name));
+            }
+        }
+        TelemetryChunk.WriteInt32(ProfilingTools::EventsGPU.Count());
+        for (const auto& e : ProfilingTools::EventsGPU)
+        {
+            TelemetryChunk.WriteFloat(e.Time);
+            TelemetryChunk.WriteInt32(e.Depth);
+            TelemetryChunk.Write(StringView(e.Name));
+            TelemetryChunk.WriteInt64(e.Stats.DrawCalls);
+        }
+        WriteChunk(ChunkTypes::Hitch);
+        LOG(Warning, "Hitch captured at frame {0} ({1} ms)", Engine::FrameCount, frameTimeMs);
+    }
+}
+
+void ProfilerTelemetryService::Dispose()
+{
+    ProfilerTelemetry::Stop();
+    TelemetryChunk.Reset(0);
+}
+
+bool ProfilerTelemetry::IsRecording()
+{
+    return TelemetryFile != nullptr;
+}
+
+bool ProfilerTelemetry::Start(const StringView& path)
+{
+    ScopeLock lock(TelemetryLocker);
+    if (TelemetryFile)
+    {
+        LOG(Warning, "Telemetry recording is already active.");
+        return true;
+    }
+    TelemetryFile = FileWriteStream::Open(path);
+    if (!TelemetryFile)
+    {
+        LOG(Error, "Failed to open telemetry file {0}", path);
+        return true;
+    }
+    LOG(Info, "Recording telemetry to {0}", path);
+    TelemetryFile->WriteUint32(TELEMETRY_MAGIC);
+    TelemetryFile->WriteUint32(TELEMETRY_VERSION);
+    TelemetryFile->WriteInt32(FLAXENGINE_VERSION_BUILD);
+    TelemetryFile->WriteUint32((uint32)ProfilerMemory::Groups::MAX);
+    TelemetryStartTime = Platform::GetTimeSeconds();
+    LastFrameTime = 0.0;
+    HitchCaptures = 0;
+
+    // Hitch captures use the events collected by the profilers
+    if (HitchThresholdMs > 0.0f)
+        ProfilingTools::SetEnabled(true);
+    return false;
+}
+
+void ProfilerTelemetry::Stop()
+{
+    ScopeLock lock(TelemetryLocker);
+    if (!TelemetryFile)
+        return;
+    LOG(Info, "Telemetry recording ended ({0} hitches captured)", HitchCaptures);
+    TelemetryFile->Close();
+    Delete(TelemetryFile);
+    TelemetryFile = nullptr;
+}
+
+void ProfilerTelemetry::Marker(const StringView& name)
+{
+    ScopeLock lock(TelemetryLocker);
+    if (!TelemetryFile)
+        return;
+    TelemetryChunk.WriteUint64(Engine::FrameCount);
+    TelemetryChunk.Write(name);
+    WriteChunk(ChunkTypes::Marker);
+}
+
+#endif
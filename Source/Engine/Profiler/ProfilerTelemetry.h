@@ -0,0 +1,59 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#if COMPILE_WITH_PROFILER
+
+#include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Core/Types/String.h"
+#include "Engine/Scripting/ScriptingType.h"
+
+/// <summary>
+/// Long-session performance telemetry recorder. Captures the per-frame stats (CPU/GPU timings, rendering stats, streaming stats, memory groups and markers) into a compact binary file and saves the full CPU/GPU profiler events of the hitch frames (longer than threshold).
+/// </summary>
+/// <remarks>
+/// File format (little-endian): header (uint32 magic 'FTEL', uint32 version, int32 engine build, uint32 memory groups count) followed by chunks. Each chunk starts with byte type and uint32 data size.
+/// Frame chunk: uint64 frame index, double time (seconds since start), float frame/update/physics/draw CPU/draw GPU times (ms), int32 FPS, RenderStatsData (int64 fields), streaming stats (int32 in-flight tasks, uint64 in-flight bytes, uint64 streamed bytes, uint64 GPU memory usage), uint64 process physical memory, uint64 GPU memory, uint64 memory group sizes, byte flags (1 = hitch).
+/// Hitch chunk: uint64 frame index, float frame time (ms), int32 threads count, per thread: string name, int32 events count, events (double start, double end, int32 depth, string name). Then int32 GPU events count, events (float time, int32 depth, string name, int64 draw calls).
+/// Marker chunk: uint64 frame index, string name.
+/// </remarks>
+API_CLASS(Static) class FLAXENGINE_API ProfilerTelemetry
+{
+    DECLARE_SCRIPTING_TYPE_NO_SPAWN(ProfilerTelemetry);
+public:
+    /// <summary>
+    /// The frame duration threshold (in milliseconds) above which the frame is marked as a hitch and its full profiler events get saved. Use 0 to disable hitch captures.
+    /// </summary>
+    API_FIELD() static float HitchThresholdMs;
+
+    /// <summary>
+    /// The maximum amount of hitch frames with full profiler events saved per session (limits the file size when game runs with a constant low framerate).
+    /// </summary>
+    API_FIELD() static int32 MaxHitchCaptures;
+
+public:
+    /// <summary>
+    /// Checks if the telemetry recording is active.
+    /// </summary>
+    API_PROPERTY() static bool IsRecording();
+
+    /// <summary>
+    /// Starts the telemetry recording to the file. Enables the CPU and GPU profilers for the hitch captures. Can be started from the engine startup with -telemetry command line switch.
+    /// </summary>
+    /// <param name="path">The output file path.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    API_FUNCTION() static bool Start(const StringView& path);
+
+    /// <summary>
+    /// Stops the telemetry recording and closes the file.
+    /// </summary>
+    API_FUNCTION() static void Stop();
+
+    /// <summary>
+    /// Adds the named marker to the current frame (eg. level loaded, checkpoint reached) to help with correlating the recorded data with the gameplay.
+    /// </summary>
+    /// <param name="name">The marker name.</param>
+    API_FUNCTION() static void Marker(const StringView& name);
+};
+
+#endif
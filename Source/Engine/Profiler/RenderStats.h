@@ -38,6 +38,31 @@ API_STRUCT() struct RenderStatsData
     /// </summary>
     API_FIELD() int64 PipelineStateChanges;
 
+    /// <summary>
+    /// The pipeline state and resources binding calls count (pipeline states, vertex/index buffers, constant buffers, shader resources, unordered access views and samplers).
+    /// </summary>
+    API_FIELD() int64 StateBinds;
+
+    /// <summary>
+    /// The binding calls count that didn't modify the bound state (skipped as no-op). High values relative to <see cref="StateBinds"/> indicate state thrashing.
+    /// </summary>
+    API_FIELD() int64 RedundantStateBinds;
+
+    /// <summary>
+    /// The particle buffers created count (pool misses that allocate new GPU resources, which can cause hitches when spawning effects).
+    /// </summary>
+    API_FIELD() int64 ParticleBuffersCreated;
+
+    /// <summary>
+    /// The particle buffers reused from the pool count.
+    /// </summary>
+    API_FIELD() int64 ParticleBuffersReused;
+
+    /// <summary>
+    /// The memory used by the pooled (unused) particle buffers (in bytes). Limited by Particles.ParticleBufferPoolBudget. It's not a per-event counter but the current state.
+    /// </summary>
+    API_FIELD() int64 ParticleBuffersPoolMemory;
+
     /// <summary>
     /// Initializes a new instance of the <see cref="RenderStatsData"/> struct.
     /// </summary>
@@ -47,6 +72,11 @@ API_STRUCT() struct RenderStatsData
         , Vertices(0)
         , Triangles(0)
         , PipelineStateChanges(0)
+        , StateBinds(0)
+        , RedundantStateBinds(0)
+        , ParticleBuffersCreated(0)
+        , ParticleBuffersReused(0)
+        , ParticleBuffersPoolMemory(0)
     {
     }
 
@@ -67,21 +97,34 @@ API_STRUCT() struct RenderStatsData
         MIX(Vertices);
         MIX(Triangles);
         MIX(PipelineStateChanges);
+        MIX(StateBinds);
+        MIX(RedundantStateBinds);
+        MIX(ParticleBuffersCreated);
+        MIX(ParticleBuffersReused);
 #undef MIX
+        ParticleBuffersPoolMemory = currentState.ParticleBuffersPoolMemory;
     }
 };
 
 #define RENDER_STAT_DISPATCH_CALL() Platform::InterlockedIncrement(&RenderStatsData::Counter.DispatchCalls)
 #define RENDER_STAT_PS_STATE_CHANGE() Platform::InterlockedIncrement(&RenderStatsData::Counter.PipelineStateChanges)
+#define RENDER_STAT_STATE_BIND(redundant) \
+	Platform::InterlockedIncrement(&RenderStatsData::Counter.StateBinds); \
+	if (redundant) Platform::InterlockedIncrement(&RenderStatsData::Counter.RedundantStateBinds)
 #define RENDER_STAT_DRAW_CALL(vertices, triangles) \
 	Platform::InterlockedIncrement(&RenderStatsData::Counter.DrawCalls); \
 	Platform::InterlockedAdd(&RenderStatsData::Counter.Vertices, vertices); \
 	Platform::InterlockedAdd(&RenderStatsData::Counter.Triangles, triangles)
+#define RENDER_STAT_PARTICLE_BUFFER_ACQUIRE(reused) Platform::InterlockedIncrement(reused ? &RenderStatsData::Counter.ParticleBuffersReused : &RenderStatsData::Counter.ParticleBuffersCreated)
+#define RENDER_STAT_PARTICLE_BUFFERS_POOL_MEMORY(size) Platform::AtomicStore(&RenderStatsData::Counter.ParticleBuffersPoolMemory, size)
 
 #else
 
 #define RENDER_STAT_DISPATCH_CALL()
 #define RENDER_STAT_PS_STATE_CHANGE()
+#define RENDER_STAT_STATE_BIND(redundant)
 #define RENDER_STAT_DRAW_CALL(vertices, primitives)
+#define RENDER_STAT_PARTICLE_BUFFER_ACQUIRE(reused)
+#define RENDER_STAT_PARTICLE_BUFFERS_POOL_MEMORY(size)
 
 #endif
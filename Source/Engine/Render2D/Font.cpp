@@ -4,11 +4,41 @@
 #include "FontAsset.h"
 #include "FontManager.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Engine/Engine.h"
 #include "Engine/Threading/Threading.h"
 #include "IncludeFreeType.h"
 
+// Cached result of the text processing
+struct FontTextLayout
+{
+    String Text;
+    TextLayoutOptions Layout;
+    float FontScale;
+    uint64 LastFrameUsed;
+    Float2 Size;
+    Array<FontLineCache> Lines;
+    Array<float> Positions;
+};
+
 Array<AssetReference<FontAsset>, HeapAllocation> Font::FallbackFonts;
 
+namespace
+{
+    int32 LoadKerning(const Font* font, Char first, Char second)
+    {
+        const FT_Face face = font->GetAsset()->GetFTFace();
+        ASSERT(face);
+
+        font->FlushFaceSize();
+
+        FT_Vector vec;
+        const FT_UInt firstIndex = FT_Get_Char_Index(face, first);
+        const FT_UInt secondIndex = FT_Get_Char_Index(face, second);
+        FT_Get_Kerning(face, firstIndex, secondIndex, FT_KERNING_DEFAULT, &vec);
+        return vec.x >> 6;
+    }
+}
+
 Font::Font(FontAsset* parentAsset, float size)
     : ManagedScriptingObject(SpawnParams(Guid::New(), Font::TypeInitializer))
     , _asset(parentAsset)
@@ -16,6 +46,7 @@ Font::Font(FontAsset* parentAsset, float size)
     , _characters(512)
 {
     _asset->_fonts.Add(this);
+    Platform::MemoryClear(_charactersFlat, sizeof(_charactersFlat));
 
     // Cache data
     FlushFaceSize();
@@ -30,50 +61,115 @@ Font::Font(FontAsset* parentAsset, float size)
 
 Font::~Font()
 {
+    FontManager::CancelPendingGlyphs(this);
+    ClearTextLayouts();
+    if (_kerningFlat)
+        Allocator::Free(_kerningFlat);
     if (_asset)
+    {
         _asset->_fonts.Remove(this);
+        for (Font* font : _asset->_fonts)
+        {
+            if (font->_sdfBase == this)
+                font->_sdfBase = nullptr;
+        }
+    }
 }
 
 void Font::GetCharacter(Char c, FontCharacterEntry& result, bool enableFallback)
 {
-    // Try to get the character or cache it if cannot be found
-    if (!_characters.TryGet(c, result))
+    // Try to get the character (common characters use flat table) or cache it if cannot be found
+    if (c < FONT_FLAT_CHARACTERS && _charactersFlat[c].Font)
+    {
+        result = _charactersFlat[c];
+    }
+    else if (!_characters.TryGet(c, result))
     {
         // This thread race condition may happen in editor but in game we usually do all stuff with fonts on main thread (chars caching)
         ScopeLock lock(_asset->Locker);
 
         // Handle situation when more than one thread wants to get the same character
-        if (_characters.TryGet(c, result))
-            return;
-
-        // Try to use fallback font if character is missing
-        if (enableFallback && !_asset->ContainsChar(c))
+        if (!_characters.TryGet(c, result))
         {
-            for (int32 fallbackIndex = 0; fallbackIndex < FallbackFonts.Count(); fallbackIndex++)
+            // Try to use fallback font if character is missing
+            if (enableFallback && !_asset->ContainsChar(c))
             {
-                FontAsset* fallbackFont = FallbackFonts.Get()[fallbackIndex].Get();
-                if (fallbackFont && fallbackFont->ContainsChar(c))
+                for (int32 fallbackIndex = 0; fallbackIndex < FallbackFonts.Count(); fallbackIndex++)
                 {
-                    fallbackFont->CreateFont(GetSize())->GetCharacter(c, result, enableFallback);
-                    return;
+                    FontAsset* fallbackFont = FallbackFonts.Get()[fallbackIndex].Get();
+                    if (fallbackFont && fallbackFont->ContainsChar(c))
+                    {
+                        fallbackFont->CreateFont(GetSize())->GetCharacter(c, result, enableFallback);
+                        return;
+                    }
                 }
             }
+
+            // Create character cache
+            FontManager::AddNewEntry(this, c, result);
+            ASSERT(result.Font);
+
+            // Add to the dictionary
+            _characters.Add(c, result);
+            if (c < FONT_FLAT_CHARACTERS)
+                _charactersFlat[c] = result;
         }
+    }
 
-        // Create character cache
-        FontManager::AddNewEntry(this, c, result);
-        ASSERT(result.Font);
+    // Signed distance field glyph image is shared by all sizes of the font so get it from the base size font
+    if (result.IsSDF && result.Font == this && _size != FONT_SDF_BASE_SIZE)
+        GetCharacterSDF(c, result);
+}
 
-        // Add to the dictionary
-        _characters.Add(c, result);
+void Font::GetCharacterSDF(Char c, FontCharacterEntry& result)
+{
+    if (!_sdfBase)
+    {
+        _sdfBase = _asset->CreateFont(FONT_SDF_BASE_SIZE);
+        if (!_sdfBase)
+            return;
     }
+    FontCharacterEntry baseEntry;
+    _sdfBase->GetCharacter(c, baseEntry, false);
+
+    // Scale the glyph placement to match this font size (metrics are already calculated for this size)
+    const float scale = _size / FONT_SDF_BASE_SIZE;
+    result.TextureIndex = baseEntry.TextureIndex;
+    result.OffsetX = (int16)Math::RoundToInt(baseEntry.OffsetX * scale);
+    result.OffsetY = (int16)Math::RoundToInt(baseEntry.OffsetY * scale);
+    result.UV = baseEntry.UV;
+    result.UVSize = baseEntry.UVSize;
+    result.Size = baseEntry.UVSize * scale;
+    result.Slot = baseEntry.Slot;
 }
 
 int32 Font::GetKerning(Char first, Char second) const
 {
+    if (!_hasKerning)
+        return 0;
+
+    // Use flat table for pairs of the common characters
+    if (first < FONT_FLAT_CHARACTERS && second < FONT_FLAT_CHARACTERS)
+    {
+        const int32 index = first * FONT_FLAT_CHARACTERS + second;
+        if (_kerningFlat && _kerningFlat[index] != MIN_int16)
+            return _kerningFlat[index];
+        ScopeLock lock(_asset->Locker);
+        if (!_kerningFlat)
+        {
+            auto kerningFlat = (int16*)Allocator::Allocate(FONT_FLAT_CHARACTERS * FONT_FLAT_CHARACTERS * sizeof(int16));
+            for (int32 i = 0; i < FONT_FLAT_CHARACTERS * FONT_FLAT_CHARACTERS; i++)
+                kerningFlat[i] = MIN_int16;
+            _kerningFlat = kerningFlat;
+        }
+        if (_kerningFlat[index] == MIN_int16)
+            _kerningFlat[index] = (int16)Math::Clamp(LoadKerning(this, first, second), MIN_int16 + 1, (int32)MAX_int16);
+        return _kerningFlat[index];
+    }
+
     int32 kerning = 0;
     const uint32 key = (uint32)first << 16 | second;
-    if (_hasKerning && !_kerningTable.TryGet(key, kerning))
+    if (!_kerningTable.TryGet(key, kerning))
     {
         // This thread race condition may happen in editor but in game we usually do all stuff with fonts on main thread (chars caching)
         ScopeLock lock(_asset->Locker);
@@ -81,17 +177,7 @@ int32 Font::GetKerning(Char first, Char second) const
         // Handle situation when more than one thread wants to get the same character
         if (!_kerningTable.TryGet(key, kerning))
         {
-            const FT_Face face = _asset->GetFTFace();
-            ASSERT(face);
-
-            FlushFaceSize();
-
-            FT_Vector vec;
-            const FT_UInt firstIndex = FT_Get_Char_Index(face, first);
-            const FT_UInt secondIndex = FT_Get_Char_Index(face, second);
-            FT_Get_Kerning(face, firstIndex, secondIndex, FT_KERNING_DEFAULT, &vec);
-            kerning = vec.x >> 6;
-
+            kerning = LoadKerning(this, first, second);
             _kerningTable.Add(key, kerning);
         }
     }
@@ -111,15 +197,127 @@ void Font::CacheText(const StringView& text)
 void Font::Invalidate()
 {
     ScopeLock lock(_asset->Locker);
+    FontManager::CancelPendingGlyphs(this);
 
     for (auto i = _characters.Begin(); i.IsNotEnd(); ++i)
     {
         FontManager::Invalidate(i->Value);
     }
     _characters.Clear();
+    Platform::MemoryClear(_charactersFlat, sizeof(_charactersFlat));
+    ClearTextLayouts();
 }
 
 void Font::ProcessText(const StringView& text, Array<FontLineCache>& outputLines, const TextLayoutOptions& layout)
+{
+    ScopeLock lock(_asset->Locker);
+    const FontTextLayout* textLayout = GetTextLayout(text, layout);
+    if (textLayout)
+        outputLines.Add(textLayout->Lines);
+}
+
+void Font::ProcessText(const StringView& text, Array<FontLineCache>& outputLines, Array<float>& outputPositions, const TextLayoutOptions& layout)
+{
+    ScopeLock lock(_asset->Locker);
+    const FontTextLayout* textLayout = GetTextLayout(text, layout);
+    if (textLayout)
+    {
+        outputLines.Add(textLayout->Lines);
+        outputPositions.Add(textLayout->Positions);
+    }
+}
+
+const FontTextLayout* Font::GetTextLayout(const StringView& text, const TextLayoutOptions& layout)
+{
+    if (text.IsEmpty())
+        return nullptr;
+
+    // Layout doesn't depend on the bounds location so the cache can be reused for the moving text
+    TextLayoutOptions options = layout;
+    options.Bounds.Location = Float2::Zero;
+    uint32 key = GetHash(text);
+    CombineHash(key, GetHash(options.Bounds.Size.X));
+    CombineHash(key, GetHash(options.Bounds.Size.Y));
+    CombineHash(key, GetHash(options.HorizontalAlignment));
+    CombineHash(key, GetHash(options.VerticalAlignment));
+    CombineHash(key, GetHash(options.TextWrapping));
+    CombineHash(key, GetHash(options.Scale));
+    CombineHash(key, GetHash(options.BaseLinesGapScale));
+
+    // Try to reuse the cached layout
+    FontTextLayout* result;
+    if (_layouts.TryGet(key, result))
+    {
+        if (result->FontScale == FontManager::FontScale && result->Layout == options && text == result->Text)
+        {
+            result->LastFrameUsed = Engine::FrameCount;
+            return result;
+        }
+    }
+    else
+    {
+        if (_layouts.Count() >= FONT_LAYOUT_CACHE_SIZE)
+        {
+            // Release layouts not used recently
+            for (auto i = _layouts.Begin(); i.IsNotEnd(); ++i)
+            {
+                if (i->Value->LastFrameUsed + 1 < Engine::FrameCount)
+                {
+                    Delete(i->Value);
+                    _layouts.Remove(i);
+                }
+            }
+            if (_layouts.Count() >= FONT_LAYOUT_CACHE_SIZE)
+                ClearTextLayouts();
+        }
+        result = New<FontTextLayout>();
+        _layouts.Add(key, result);
+    }
+    result->Text = text;
+    result->Layout = options;
+    result->FontScale = FontManager::FontScale;
+    result->LastFrameUsed = Engine::FrameCount;
+    result->Lines.Clear();
+    ProcessTextLayout(text, result->Lines, options);
+
+    // Calculate characters placement within lines
+    const int32 textLength = text.Length();
+    const float scale = options.Scale / FontManager::FontScale;
+    FontCharacterEntry entry;
+    FontCharacterEntry previous;
+    result->Positions.Resize(textLength, false);
+    result->Size = Float2::Zero;
+    for (const FontLineCache& line : result->Lines)
+    {
+        float x = 0.0f;
+        for (int32 charIndex = line.FirstCharIndex; charIndex <= line.LastCharIndex && charIndex < textLength; charIndex++)
+        {
+            const Char currentChar = text[charIndex];
+            if (currentChar != '\n')
+            {
+                GetCharacter(currentChar, entry);
+                if (!StringUtils::IsWhitespace(currentChar) && previous.IsValid)
+                    x += (float)entry.Font->GetKerning(previous.Character, entry.Character) * scale;
+                previous = entry;
+            }
+            result->Positions[charIndex] = x;
+            if (currentChar != '\n')
+                x += entry.AdvanceX * scale;
+        }
+        result->Size = Float2::Max(result->Size, line.Location + line.Size);
+    }
+
+    return result;
+}
+
+void Font::ClearTextLayouts()
+{
+    for (auto i = _layouts.Begin(); i.IsNotEnd(); ++i)
+        Delete(i->Value);
+    _layouts.Clear();
+}
+
+void Font::ProcessTextLayout(const StringView& text, Array<FontLineCache>& outputLines, const TextLayoutOptions& layout)
 {
     int32 textLength = text.Length();
     if (textLength == 0)
@@ -309,19 +507,10 @@ Float2 Font::MeasureText(const StringView& text, const TextLayoutOptions& layout
     if (text.IsEmpty())
         return Float2::Zero;
 
-    // Process text
-    Array<FontLineCache> lines;
-    ProcessText(text, lines, layout);
-
-    // Calculate bounds
-    Float2 max = Float2::Zero;
-    for (int32 i = 0; i < lines.Count(); i++)
-    {
-        const FontLineCache& line = lines[i];
-        max = Float2::Max(max, line.Location + line.Size);
-    }
-
-    return max;
+    // Process text (bounds are cached with the layout)
+    ScopeLock lock(_asset->Locker);
+    const FontTextLayout* textLayout = GetTextLayout(text, layout);
+    return textLayout ? textLayout->Size : Float2::Zero;
 }
 
 int32 Font::HitTestText(const StringView& text, const Float2& location, const TextLayoutOptions& layout)
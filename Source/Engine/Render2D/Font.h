@@ -10,11 +10,22 @@
 #include "TextLayoutOptions.h"
 
 class FontAsset;
+class FontManager;
 struct FontTextureAtlasSlot;
+struct FontTextLayout;
 
 // The default DPI that engine is using
 #define DefaultDPI 96
 
+// The font size used to generate the signed distance field glyphs shared by all sizes of the font (see FontFlags::SDF)
+#define FONT_SDF_BASE_SIZE 32.0f
+
+// The amount of the first characters (and pairs of them for kerning) that use flat lookup tables instead of the dictionary
+#define FONT_FLAT_CHARACTERS 128
+
+// The maximum amount of the text layouts cached per font
+#define FONT_LAYOUT_CACHE_SIZE 256
+
 /// <summary>
 /// The text range.
 /// </summary>
@@ -166,6 +177,11 @@ API_STRUCT(NoDefault) struct FLAXENGINE_API FontCharacterEntry
     /// </summary>
     API_FIELD() bool IsValid = false;
 
+    /// <summary>
+    /// True if character uses signed distance field glyph image (see FontFlags.SDF), otherwise false.
+    /// </summary>
+    API_FIELD() bool IsSDF = false;
+
     /// <summary>
     /// The index to a specific texture in the font cache.
     /// </summary>
@@ -206,6 +222,11 @@ API_STRUCT(NoDefault) struct FLAXENGINE_API FontCharacterEntry
     /// </summary>
     API_FIELD() Float2 UVSize;
 
+    /// <summary>
+    /// The size of the character glyph (in pixels). Matches UVSize except for the signed distance field fonts that share glyph images between font sizes.
+    /// </summary>
+    API_FIELD() Float2 Size;
+
     /// <summary>
     /// The slot in texture atlas, containing the pixel data of the glyph.
     /// </summary>
@@ -230,6 +251,7 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API Font : public ManagedScriptingOb
 {
     DECLARE_SCRIPTING_TYPE_NO_SPAWN(Font);
     friend FontAsset;
+    friend FontManager;
 
 private:
     FontAsset* _asset;
@@ -240,7 +262,11 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API Font : public ManagedScriptingOb
     int32 _lineGap;
     bool _hasKerning;
     Dictionary<Char, FontCharacterEntry> _characters;
+    FontCharacterEntry _charactersFlat[FONT_FLAT_CHARACTERS];
+    Font* _sdfBase = nullptr;
     mutable Dictionary<uint32, int32> _kerningTable;
+    mutable int16* _kerningFlat = nullptr;
+    Dictionary<uint32, FontTextLayout*> _layouts;
 
 public:
     /// <summary>
@@ -346,6 +372,15 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API Font : public ManagedScriptingOb
     /// <param name="outputLines">The output lines list.</param>
     void ProcessText(const StringView& text, Array<FontLineCache>& outputLines, API_PARAM(Ref) const TextLayoutOptions& layout);
 
+    /// <summary>
+    /// Processes text to get cached lines and characters placement for rendering. Results are cached per text and layout properties so the following calls for the same text are much faster.
+    /// </summary>
+    /// <param name="text">The input text.</param>
+    /// <param name="outputLines">The output lines list.</param>
+    /// <param name="outputPositions">The output horizontal positions of the characters relative to their line location (including kerning). Indexed with the character index in the text.</param>
+    /// <param name="layout">The layout properties.</param>
+    void ProcessText(const StringView& text, Array<FontLineCache>& outputLines, Array<float>& outputPositions, const TextLayoutOptions& layout);
+
     /// <summary>
     /// Processes text to get cached lines for rendering.
     /// </summary>
@@ -530,6 +565,12 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API Font : public ManagedScriptingOb
     /// </summary>
     void FlushFaceSize() const;
 
+private:
+    void GetCharacterSDF(Char c, FontCharacterEntry& result);
+    void ProcessTextLayout(const StringView& text, Array<FontLineCache>& outputLines, const TextLayoutOptions& layout);
+    const FontTextLayout* GetTextLayout(const StringView& text, const TextLayoutOptions& layout);
+    void ClearTextLayouts();
+
 public:
     // [Object]
     String ToString() const override;
@@ -64,6 +64,16 @@ API_ENUM(Attributes="Flags") enum class FontFlags : byte
     /// Enables slant effect, emulating italic style.
     /// </summary>
     Italic = 4,
+
+    /// <summary>
+    /// Enables signed distance field rendering. Glyphs are generated once (at the base size) and shared by all sizes of the font which stay sharp at any scale (uses a dedicated shader to draw text). Hinting is not used.
+    /// </summary>
+    SDF = 8,
+
+    /// <summary>
+    /// Enables generating the signed distance field glyphs in the background so characters appear once ready instead of stalling the calling thread (eg. for the large CJK character sets). Used only with SDF.
+    /// </summary>
+    AsyncGlyphs = 16,
 };
 
 DECLARE_ENUM_OPERATORS(FontFlags);
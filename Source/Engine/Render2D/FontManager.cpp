@@ -9,17 +9,43 @@
 #include "Engine/Content/Content.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/JobSystem.h"
+#include "Engine/Profiler/ProfilerCPU.h"
 #include "IncludeFreeType.h"
 #include <ThirdParty/freetype/ftsynth.h>
 #include <ThirdParty/freetype/ftbitmap.h>
 #include <ThirdParty/freetype/internal/ftdrv.h>
 
+// The resolution multiplier of the glyph image used to generate the signed distance field
+#define FONT_SDF_SUPERSAMPLE 4
+
+// The maximum distance to the glyph edge stored in the signed distance field (in pixels of the base size glyph)
+#define FONT_SDF_SPREAD 4
+
 namespace FontManagerImpl
 {
+    // Signed distance field glyph generated in the background
+    struct PendingGlyph
+    {
+        const class Font* Font;
+        Char Character;
+        int32 CoverageWidth;
+        int32 CoverageHeight;
+        int32 PlaceX;
+        int32 PlaceY;
+        int32 Width;
+        int32 Height;
+        Array<byte> Coverage;
+        Array<byte> Data;
+        int64 Job;
+        int64 Done;
+    };
+
     FT_Library Library;
     CriticalSection Locker;
     Array<AssetReference<FontTextureAtlas>> Atlases;
     Array<byte> GlyphImageData;
+    Array<PendingGlyph*> PendingGlyphs;
 }
 
 using namespace FontManagerImpl;
@@ -39,6 +65,7 @@ class FontManagerService : public EngineService
 FontManagerService FontManagerServiceInstance;
 
 float FontManager::FontScale = 1.0f;
+uint32 FontManager::CharactersVersion = 0;
 
 FT_Library FontManager::GetLibrary()
 {
@@ -92,6 +119,14 @@ bool FontManagerService::Init()
 
 void FontManagerService::Dispose()
 {
+    // Wait for the background glyphs generation
+    for (PendingGlyph* glyph : PendingGlyphs)
+    {
+        JobSystem::Wait(glyph->Job);
+        Delete(glyph);
+    }
+    PendingGlyphs.Resize(0);
+
     // Release font atlases
     Atlases.Resize(0);
 
@@ -109,9 +144,228 @@ void FontManagerService::Dispose()
 
 FontTextureAtlas* FontManager::GetAtlas(int32 index)
 {
+    ScopeLock lock(Locker);
     return index >= 0 && index < Atlases.Count() ? Atlases.Get()[index].Get() : nullptr;
 }
 
+// Calculates the squared euclidean distance transform of the sampled function (see 'Distance Transforms of Sampled Functions' by Felzenszwalb and Huttenlocher)
+void DistanceTransform1D(float* values, int32 count, int32 stride, float* f, int32* v, float* z)
+{
+    for (int32 q = 0; q < count; q++)
+        f[q] = values[q * stride];
+    int32 k = 0;
+    v[0] = 0;
+    z[0] = -MAX_float;
+    z[1] = MAX_float;
+    for (int32 q = 1; q < count; q++)
+    {
+        float s = ((f[q] + (float)(q * q)) - (f[v[k]] + (float)(v[k] * v[k]))) / (float)(2 * q - 2 * v[k]);
+        while (s <= z[k])
+        {
+            k--;
+            s = ((f[q] + (float)(q * q)) - (f[v[k]] + (float)(v[k] * v[k]))) / (float)(2 * q - 2 * v[k]);
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = MAX_float;
+    }
+    k = 0;
+    for (int32 q = 0; q < count; q++)
+    {
+        while (z[k + 1] < (float)q)
+            k++;
+        const float d = (float)(q - v[k]);
+        values[q * stride] = d * d + f[v[k]];
+    }
+}
+
+void DistanceTransform2D(float* values, int32 width, int32 height, Array<byte>& tmp)
+{
+    const int32 count = Math::Max(width, height);
+    tmp.Resize(count * (sizeof(float) * 2 + sizeof(int32)) + sizeof(float), false);
+    float* f = (float*)tmp.Get();
+    float* z = f + count;
+    int32* v = (int32*)(z + count + 1);
+    for (int32 x = 0; x < width; x++)
+        DistanceTransform1D(values + x, height, width, f, v, z);
+    for (int32 y = 0; y < height; y++)
+        DistanceTransform1D(values + y * width, width, 1, f, v, z);
+}
+
+void GenerateSDF(PendingGlyph& glyph)
+{
+    PROFILE_CPU();
+
+    // Initialize the distance fields in the high resolution (squared distances to the closest pixel inside and outside the glyph)
+    const int32 width = glyph.Width * FONT_SDF_SUPERSAMPLE;
+    const int32 height = glyph.Height * FONT_SDF_SUPERSAMPLE;
+    const float maxDistance = (float)(width * width + height * height);
+    Array<float> outer, inner;
+    outer.Resize(width * height, false);
+    inner.Resize(width * height, false);
+    for (int32 y = 0; y < height; y++)
+    {
+        for (int32 x = 0; x < width; x++)
+        {
+            const int32 coverageX = x - glyph.PlaceX;
+            const int32 coverageY = y - glyph.PlaceY;
+            const bool inside = coverageX >= 0 && coverageY >= 0 && coverageX < glyph.CoverageWidth && coverageY < glyph.CoverageHeight && glyph.Coverage[coverageY * glyph.CoverageWidth + coverageX] >= 128;
+            outer[y * width + x] = inside ? 0.0f : maxDistance;
+            inner[y * width + x] = inside ? maxDistance : 0.0f;
+        }
+    }
+    Array<byte> tmp;
+    DistanceTransform2D(outer.Get(), width, height, tmp);
+    DistanceTransform2D(inner.Get(), width, height, tmp);
+
+    // Downsample into the base size glyph with distance mapped into 0-1 range (0.5 is at the glyph edge)
+    glyph.Data.Resize(glyph.Width * glyph.Height, false);
+    const float distanceScale = 1.0f / (FONT_SDF_SUPERSAMPLE * FONT_SDF_SPREAD * 2);
+    for (int32 y = 0; y < glyph.Height; y++)
+    {
+        for (int32 x = 0; x < glyph.Width; x++)
+        {
+            const int32 index = (y * FONT_SDF_SUPERSAMPLE + FONT_SDF_SUPERSAMPLE / 2) * width + x * FONT_SDF_SUPERSAMPLE + FONT_SDF_SUPERSAMPLE / 2;
+            const float distance = Math::Sqrt(outer[index]) - Math::Sqrt(inner[index]);
+            glyph.Data[y * glyph.Width + x] = (byte)Math::RoundToInt(Math::Saturate(0.5f - distance * distanceScale) * 255.0f);
+        }
+    }
+}
+
+bool AddToAtlas(FontCharacterEntry& entry, int32 glyphWidth, int32 glyphHeight, const Array<byte>& data)
+{
+    // Find atlas for the character texture
+    int32 atlasIndex = 0;
+    const FontTextureAtlasSlot* slot = nullptr;
+    for (; atlasIndex < Atlases.Count(); atlasIndex++)
+    {
+        // Add the character to the texture
+        slot = Atlases[atlasIndex]->AddEntry(glyphWidth, glyphHeight, data);
+
+        // Check result, if not null char has been added
+        if (slot)
+        {
+            break;
+        }
+    }
+
+    // Check if there is no atlas for this character
+    if (!slot)
+    {
+        // Create new atlas
+        auto atlas = Content::CreateVirtualAsset<FontTextureAtlas>();
+        atlas->Setup(PixelFormat::R8_UNorm, FontTextureAtlas::PaddingStyle::PadWithZero);
+        Atlases.Add(atlas);
+
+        // Init atlas
+        const int32 fontAtlasSize = 512; // TODO: make it a configuration variable
+        atlas->Init(fontAtlasSize, fontAtlasSize);
+
+        // Add the character to the texture
+        slot = atlas->AddEntry(glyphWidth, glyphHeight, data);
+    }
+    if (slot == nullptr)
+    {
+        const FT_Face face = entry.Font->GetAsset()->GetFTFace();
+        LOG(Error, "Cannot find free space in texture atlases for character '{0}' from font {1} {2}. Size: {3}x{4}", entry.Character, String(face->family_name), String(face->style_name), glyphWidth, glyphHeight);
+        return true;
+    }
+
+    // Fill with atlas dependant data
+    const uint32 padding = Atlases[atlasIndex]->GetPaddingAmount();
+    entry.TextureIndex = atlasIndex;
+    entry.UV.X = static_cast<float>(slot->X + padding);
+    entry.UV.Y = static_cast<float>(slot->Y + padding);
+    entry.UVSize.X = static_cast<float>(slot->Width - 2 * padding);
+    entry.UVSize.Y = static_cast<float>(slot->Height - 2 * padding);
+    entry.Size = entry.UVSize;
+    entry.Slot = slot;
+
+    return false;
+}
+
+bool AddNewEntrySDF(const Font* font, FontCharacterEntry& entry, FT_GlyphSlot glyph)
+{
+    // Render glyph to the bitmap (in higher resolution)
+    FT_Render_Glyph(glyph, FT_RENDER_MODE_NORMAL);
+    FT_Bitmap* bitmap = &glyph->bitmap;
+    FT_Bitmap tmpBitmap;
+    if (bitmap->pixel_mode != FT_PIXEL_MODE_GRAY)
+    {
+        // Convert the bitmap to 8bpp grayscale
+        FT_Bitmap_New(&tmpBitmap);
+        FT_Bitmap_Convert(Library, bitmap, &tmpBitmap, 4);
+        bitmap = &tmpBitmap;
+    }
+
+    // Fill the character data (metrics of the base size)
+    entry.AdvanceX = Convert26Dot6ToRoundedPixel<int16>(glyph->advance.x / FONT_SDF_SUPERSAMPLE);
+    entry.IsValid = true;
+    entry.BearingY = Convert26Dot6ToRoundedPixel<int16>(glyph->metrics.horiBearingY / FONT_SDF_SUPERSAMPLE);
+    entry.Height = Convert26Dot6ToRoundedPixel<int16>(glyph->metrics.height / FONT_SDF_SUPERSAMPLE);
+    entry.TextureIndex = MAX_uint8;
+
+    // End for empty glyphs
+    const int32 coverageWidth = bitmap->width;
+    const int32 coverageHeight = bitmap->rows;
+    if (coverageWidth == 0 || coverageHeight == 0)
+    {
+        if (bitmap == &tmpBitmap)
+            FT_Bitmap_Done(Library, bitmap);
+        return false;
+    }
+
+    // Place glyph within the distance field image (aligned to the base size pixels with the spread margin around)
+    auto glyphData = New<PendingGlyph>();
+    const int32 left = Math::FloorToInt((float)glyph->bitmap_left / FONT_SDF_SUPERSAMPLE);
+    const int32 top = Math::CeilToInt((float)glyph->bitmap_top / FONT_SDF_SUPERSAMPLE);
+    glyphData->Font = font;
+    glyphData->Character = entry.Character;
+    glyphData->CoverageWidth = coverageWidth;
+    glyphData->CoverageHeight = coverageHeight;
+    glyphData->PlaceX = glyph->bitmap_left - (left - FONT_SDF_SPREAD) * FONT_SDF_SUPERSAMPLE;
+    glyphData->PlaceY = (top + FONT_SDF_SPREAD) * FONT_SDF_SUPERSAMPLE - glyph->bitmap_top;
+    glyphData->Width = Math::DivideAndRoundUp(glyphData->PlaceX + coverageWidth, FONT_SDF_SUPERSAMPLE) + FONT_SDF_SPREAD;
+    glyphData->Height = Math::DivideAndRoundUp(glyphData->PlaceY + coverageHeight, FONT_SDF_SUPERSAMPLE) + FONT_SDF_SPREAD;
+    glyphData->Job = 0;
+    glyphData->Done = 0;
+    entry.OffsetX = (int16)(left - FONT_SDF_SPREAD);
+    entry.OffsetY = (int16)(top + FONT_SDF_SPREAD);
+
+    // Copy glyph data after rasterization (row by row)
+    glyphData->Coverage.Resize(coverageWidth * coverageHeight);
+    for (int32 row = 0; row < coverageHeight; row++)
+        Platform::MemoryCopy(&glyphData->Coverage[row * coverageWidth], &bitmap->buffer[row * bitmap->pitch], coverageWidth);
+    if (bitmap->num_grays != 256)
+    {
+        const int32 scale = 255 / (bitmap->num_grays - 1);
+        for (byte& pixel : glyphData->Coverage)
+            pixel *= scale;
+    }
+    if (bitmap == &tmpBitmap)
+        FT_Bitmap_Done(Library, bitmap);
+
+    // Generate distance field in the background (character will be added to the atlas on flush)
+    if (EnumHasAnyFlags(font->GetAsset()->GetOptions().Flags, FontFlags::AsyncGlyphs))
+    {
+        Function<void(int32)> job = [glyphData](int32)
+        {
+            GenerateSDF(*glyphData);
+            Platform::AtomicStore(&glyphData->Done, 1);
+        };
+        PendingGlyphs.Add(glyphData);
+        glyphData->Job = JobSystem::Dispatch(job, 1, JobPriority::Background);
+        return false;
+    }
+
+    // Generate distance field and add it to the texture atlas
+    GenerateSDF(*glyphData);
+    const bool result = AddToAtlas(entry, glyphData->Width, glyphData->Height, glyphData->Data);
+    Delete(glyphData);
+    return result;
+}
+
 bool FontManager::AddNewEntry(Font* font, Char c, FontCharacterEntry& entry)
 {
     ScopeLock lock(Locker);
@@ -124,8 +378,19 @@ bool FontManager::AddNewEntry(Font* font, Char c, FontCharacterEntry& entry)
 
     // Set load flags
     uint32 glyphFlags = FT_LOAD_NO_BITMAP;
+    const bool useSDF = EnumHasAnyFlags(options.Flags, FontFlags::SDF);
     const bool useAA = EnumHasAnyFlags(options.Flags, FontFlags::AntiAliasing);
-    if (useAA)
+    if (useSDF)
+    {
+        // Distance field is scaled to any size so hinting would distort it
+        glyphFlags |= FT_LOAD_NO_HINTING;
+        if (font->GetSize() == FONT_SDF_BASE_SIZE)
+        {
+            // Rasterize the glyph in higher resolution for more precise distance field
+            FT_Set_Char_Size(face, 0, ConvertPixelTo26Dot6<FT_F26Dot6>(font->GetSize() * FontManager::FontScale * FONT_SDF_SUPERSAMPLE), DefaultDPI, DefaultDPI);
+        }
+    }
+    else if (useAA)
     {
         switch (options.Hinting)
         {
@@ -185,8 +450,24 @@ bool FontManager::AddNewEntry(Font* font, Char c, FontCharacterEntry& entry)
         FT_GlyphSlot_Oblique(face->glyph);
     }
 
-    // Render glyph to the bitmap
+    // Signed distance field fonts use glyph images of the base size (other sizes need only metrics)
     FT_GlyphSlot glyph = face->glyph;
+    if (useSDF)
+    {
+        entry.IsSDF = true;
+        if (font->GetSize() != FONT_SDF_BASE_SIZE)
+        {
+            entry.AdvanceX = Convert26Dot6ToRoundedPixel<int16>(glyph->advance.x);
+            entry.IsValid = true;
+            entry.BearingY = Convert26Dot6ToRoundedPixel<int16>(glyph->metrics.horiBearingY);
+            entry.Height = Convert26Dot6ToRoundedPixel<int16>(glyph->metrics.height);
+            entry.TextureIndex = MAX_uint8;
+            return false;
+        }
+        return AddNewEntrySDF(font, entry, glyph);
+    }
+
+    // Render glyph to the bitmap
     FT_Render_Glyph(glyph, useAA ? FT_RENDER_MODE_NORMAL : FT_RENDER_MODE_MONO);
 
     FT_Bitmap* bitmap = &glyph->bitmap;
@@ -249,58 +530,15 @@ bool FontManager::AddNewEntry(Font* font, Char c, FontCharacterEntry& entry)
         bitmap = nullptr;
     }
 
-    // Find atlas for the character texture
-    int32 atlasIndex = 0;
-    const FontTextureAtlasSlot* slot = nullptr;
-    for (; atlasIndex < Atlases.Count(); atlasIndex++)
-    {
-        // Add the character to the texture
-        slot = Atlases[atlasIndex]->AddEntry(glyphWidth, glyphHeight, GlyphImageData);
-
-        // Check result, if not null char has been added
-        if (slot)
-        {
-            break;
-        }
-    }
-
-    // Check if there is no atlas for this character
-    if (!slot)
-    {
-        // Create new atlas
-        auto atlas = Content::CreateVirtualAsset<FontTextureAtlas>();
-        atlas->Setup(PixelFormat::R8_UNorm, FontTextureAtlas::PaddingStyle::PadWithZero);
-        Atlases.Add(atlas);
-
-        // Init atlas
-        const int32 fontAtlasSize = 512; // TODO: make it a configuration variable
-        atlas->Init(fontAtlasSize, fontAtlasSize);
-
-        // Add the character to the texture
-        slot = atlas->AddEntry(glyphWidth, glyphHeight, GlyphImageData);
-    }
-    if (slot == nullptr)
-    {
-        LOG(Error, "Cannot find free space in texture atlases for character '{0}' from font {1} {2}. Size: {3}x{4}", c, String(face->family_name), String(face->style_name), glyphWidth, glyphHeight);
-        return true;
-    }
-
-    // Fill with atlas dependant data
-    const uint32 padding = Atlases[atlasIndex]->GetPaddingAmount();
-    entry.TextureIndex = atlasIndex;
-    entry.UV.X = static_cast<float>(slot->X + padding);
-    entry.UV.Y = static_cast<float>(slot->Y + padding);
-    entry.UVSize.X = static_cast<float>(slot->Width - 2 * padding);
-    entry.UVSize.Y = static_cast<float>(slot->Height - 2 * padding);
-    entry.Slot = slot;
-
-    return false;
+    // Add the character to the texture atlas
+    return AddToAtlas(entry, glyphWidth, glyphHeight, GlyphImageData);
 }
 
 void FontManager::Invalidate(FontCharacterEntry& entry)
 {
     if (entry.TextureIndex == MAX_uint8)
         return;
+    CharactersVersion++;
     auto atlas = Atlases[entry.TextureIndex];
     const uint32 padding = atlas->GetPaddingAmount();
     const uint32 slotX = static_cast<uint32>(entry.UV.X - padding);
@@ -310,8 +548,39 @@ void FontManager::Invalidate(FontCharacterEntry& entry)
     atlas->Invalidate(slotX, slotY, slotSizeX, slotSizeY);
 }
 
+void FontManager::CancelPendingGlyphs(const Font* font)
+{
+    ScopeLock lock(Locker);
+    for (PendingGlyph* glyph : PendingGlyphs)
+    {
+        if (glyph->Font == font)
+            glyph->Font = nullptr;
+    }
+}
+
 void FontManager::Flush()
 {
+    // Add glyphs generated in the background to the atlases
+    if (PendingGlyphs.HasItems())
+    {
+        ScopeLock lock(Locker);
+        for (int32 i = 0; i < PendingGlyphs.Count(); i++)
+        {
+            PendingGlyph* glyph = PendingGlyphs[i];
+            if (Platform::AtomicRead(&glyph->Done) == 0)
+                continue;
+            FontCharacterEntry* entry = glyph->Font ? ((Font*)glyph->Font)->_characters.TryGet(glyph->Character) : nullptr;
+            if (entry && entry->TextureIndex == MAX_uint8)
+            {
+                if (AddToAtlas(*entry, glyph->Width, glyph->Height, glyph->Data))
+                    entry->TextureIndex = MAX_uint8;
+                CharactersVersion++;
+            }
+            Delete(glyph);
+            PendingGlyphs.RemoveAtKeepOrder(i--);
+        }
+    }
+
     for (const auto& atlas : Atlases)
     {
         atlas->Flush();
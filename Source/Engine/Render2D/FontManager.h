@@ -22,6 +22,11 @@ class FLAXENGINE_API FontManager
     /// </summary>
     static float FontScale;
 
+    /// <summary>
+    /// The counter incremented when any cached font character gets invalidated (eg. to detect outdated geometry cached by Render2D).
+    /// </summary>
+    static uint32 CharactersVersion;
+
     /// <summary>
     /// Gets the FreeType library.
     /// </summary>
@@ -50,6 +55,12 @@ class FLAXENGINE_API FontManager
     /// <param name="entry">The font character entry.</param>
     static void Invalidate(FontCharacterEntry& entry);
 
+    /// <summary>
+    /// Cancels the background generation of the font characters that are not yet ready (see FontFlags::AsyncGlyphs).
+    /// </summary>
+    /// <param name="font">The font.</param>
+    static void CancelPendingGlyphs(const Font* font);
+
     /// <summary>
     /// Flushes all font atlases.
     /// </summary>
@@ -1,6 +1,8 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
 #include "Render2D.h"
+#include "Render2DCache.h"
+#include "Render2DCommandList.h"
 #include "Font.h"
 #include "FontManager.h"
 #include "FontTextureAtlas.h"
@@ -46,6 +48,9 @@
 
 #define RENDER2D_BLUR_MAX_SAMPLES 64
 
+// The maximum amount of the previous batches checked when reordering the draw call to be merged with (see RenderingFeatures::DrawCallsReordering)
+#define RENDER2D_REORDER_MAX_SEARCH 16
+
 // The format for the blur effect temporary buffer
 #define PS_Blur_Format PixelFormat::R8G8B8A8_UNorm
 
@@ -78,6 +83,9 @@ enum class DrawCallType : byte
     Blur,
     ClipScissors,
     LineAA,
+    FillTextureBindless,
+    FillTexturePointBindless,
+    DrawCharSDF,
 
     MAX
 };
@@ -158,10 +166,14 @@ struct CachedPSO
 
     GPUPipelineState* PS_ImagePoint;
 
+    GPUPipelineState* PS_ImageBindless;
+    GPUPipelineState* PS_ImagePointBindless;
+
     GPUPipelineState* PS_Color;
     GPUPipelineState* PS_Color_NoAlpha;
 
     GPUPipelineState* PS_Font;
+    GPUPipelineState* PS_FontSDF;
 
     GPUPipelineState* PS_BlurH;
     GPUPipelineState* PS_BlurV;
@@ -182,21 +194,27 @@ struct ClipMask
 
 Render2D::RenderingFeatures Render2D::Features = RenderingFeatures::VertexSnapping | RenderingFeatures::FallbackFonts;
 
-namespace
+// Retained geometry recording
+struct CacheRecording
 {
-    // Private Stuff
-    GPUContext* Context = nullptr;
-    GPUTextureView* Output = nullptr;
-    GPUTextureView* DepthBuffer = nullptr;
-    Viewport View;
-    Matrix ViewProjection;
+    Render2DCache* Cache;
+    uint32 StartVB;
+    uint32 StartIB;
+    int32 StartDrawCall;
+};
+
+// Drawing state that is recorded by the Render2D (main state is used between Begin/End, command lists record into their own state from any thread)
+struct Render2DRecordingState
+{
+    Render2DRecordingState* Previous = nullptr;
+    bool IsRecording = false;
 
     // Drawing
     Array<Render2DDrawCall> DrawCalls;
     Array<FontLineCache> Lines;
+    Array<float> CharPositions;
     Array<Float2> Lines2;
-    bool IsScissorsRectEmpty;
-    bool IsScissorsRectEnabled;
+    bool IsScissorsRectEnabled = false;
 
     // Transform
     // Note: we use Matrix3x3 instead of Matrix because we use only 2D transformations on CPU side
@@ -211,37 +229,106 @@ namespace
     Array<ClipMask, InlinedAllocation<64>> ClipLayersStack;
     Array<Color, InlinedAllocation<64>> TintLayersStack;
 
+    // Geometry
+    DynamicVertexBuffer VB;
+    DynamicIndexBuffer IB;
+    uint32 VBIndex = 0;
+    uint32 IBIndex = 0;
+
+    Array<CacheRecording, InlinedAllocation<8>> CacheRecordings;
+
+    Render2DRecordingState(uint32 vbCapacity, uint32 ibCapacity)
+        : VB(vbCapacity, (uint32)sizeof(Render2DVertex), TEXT("Render2D.VB"))
+        , IB(ibCapacity, sizeof(uint32), TEXT("Render2D.IB"))
+    {
+    }
+
+    void Reset(const Rectangle& bounds)
+    {
+        DrawCalls.Clear();
+
+        // Initialize default transform
+        const Matrix3x3 defaultTransform = Matrix3x3::Identity;
+        TransformLayersStack.Clear();
+        TransformLayersStack.Push(defaultTransform);
+        TransformCached = defaultTransform;
+
+        // Initialize default clip mask
+        const RotatedRectangle defaultMask(bounds);
+        ClipLayersStack.Clear();
+        ClipLayersStack.Add({ defaultMask, bounds });
+
+        // Initialize default tint stack
+        TintLayersStack.Clear();
+        TintLayersStack.Add({ 1, 1, 1, 1 });
+
+        // Scissors can be enabled only for 2D orthographic projections
+        IsScissorsRectEnabled = false;
+
+        // Reset geometry buffer
+        VB.Clear();
+        IB.Clear();
+        VBIndex = 0;
+        IBIndex = 0;
+        CacheRecordings.Clear();
+    }
+};
+
+namespace
+{
+    // Private Stuff
+    GPUContext* Context = nullptr;
+    GPUTextureView* Output = nullptr;
+    GPUTextureView* DepthBuffer = nullptr;
+    Viewport View;
+    Matrix ViewProjection;
+    bool IsScissorsRectEmpty;
+
+    // Recording
+    Render2DRecordingState MainState(RENDER2D_INITIAL_VB_CAPACITY, RENDER2D_INITIAL_IB_CAPACITY);
+    THREADLOCAL Render2DRecordingState* State = nullptr;
+
     // Shader
     AssetReference<Shader> GUIShader;
     CachedPSO PsoDepth;
     CachedPSO PsoNoDepth;
     CachedPSO* CurrentPso = nullptr;
-    DynamicVertexBuffer VB(RENDER2D_INITIAL_VB_CAPACITY, (uint32)sizeof(Render2DVertex), TEXT("Render2D.VB"));
-    DynamicIndexBuffer IB(RENDER2D_INITIAL_IB_CAPACITY, sizeof(uint32), TEXT("Render2D.IB"));
-    uint32 VBIndex = 0;
-    uint32 IBIndex = 0;
+
+    // Draw calls reordering
+    struct ReorderBatch
+    {
+        int32 First;
+        int32 Last;
+        Rectangle Bounds;
+        bool IsBarrier;
+    };
+
+    Array<ReorderBatch> ReorderBatches;
+    Array<int32> ReorderNext;
+    Array<Render2DDrawCall> ReorderDrawCallsList;
+    Array<uint32> ReorderIndices;
 }
 
 #define RENDER2D_WRITE_IB_QUAD(indices) \
-    indices[0] = VBIndex + 0; \
-    indices[1] = VBIndex + 1; \
-    indices[2] = VBIndex + 2; \
-    indices[3] = VBIndex + 2; \
-    indices[4] = VBIndex + 3; \
-    indices[5] = VBIndex + 0; \
-    IB.Write(indices, sizeof(indices))
+    indices[0] = State->VBIndex + 0; \
+    indices[1] = State->VBIndex + 1; \
+    indices[2] = State->VBIndex + 2; \
+    indices[3] = State->VBIndex + 2; \
+    indices[4] = State->VBIndex + 3; \
+    indices[5] = State->VBIndex + 0; \
+    State->IB.Write(indices, sizeof(indices))
 
 FORCE_INLINE void ApplyTransform(const Float2& value, Float2& result)
 {
-    Matrix3x3::Transform2DPoint(value, TransformCached, result);
+    Matrix3x3::Transform2DPoint(value, State->TransformCached, result);
 }
 
 void ApplyTransform(const Rectangle& value, RotatedRectangle& result)
 {
     const RotatedRectangle rotated(value);
-    Matrix3x3::Transform2DPoint(rotated.TopLeft, TransformCached, result.TopLeft);
-    Matrix3x3::Transform2DVector(rotated.ExtentX, TransformCached, result.ExtentX);
-    Matrix3x3::Transform2DVector(rotated.ExtentY, TransformCached, result.ExtentY);
+    Matrix3x3::Transform2DPoint(rotated.TopLeft, State->TransformCached, result.TopLeft);
+    Matrix3x3::Transform2DVector(rotated.ExtentX, State->TransformCached, result.ExtentX);
+    Matrix3x3::Transform2DVector(rotated.ExtentY, State->TransformCached, result.ExtentY);
 }
 
 FORCE_INLINE Render2DVertex MakeVertex(const Float2& pos, const Float2& uv, const Color& color)
@@ -253,9 +340,9 @@ FORCE_INLINE Render2DVertex MakeVertex(const Float2& pos, const Float2& uv, cons
     {
         point,
         Half2(uv),
-        color * TintLayersStack.Peek(),
+        color * State->TintLayersStack.Peek(),
         { 0.0f, (float)Render2D::Features },
-        ClipLayersStack.Peek().Mask
+        State->ClipLayersStack.Peek().Mask
     };
 }
 
@@ -289,16 +376,16 @@ void WriteTri(const Float2& p0, const Float2& p1, const Float2& p2, const Float2
     tris[0] = MakeVertex(p0, uv0, color0);
     tris[1] = MakeVertex(p1, uv1, color1);
     tris[2] = MakeVertex(p2, uv2, color2);
-    VB.Write(tris, sizeof(tris));
+    State->VB.Write(tris, sizeof(tris));
 
     uint32 indices[3];
-    indices[0] = VBIndex + 0;
-    indices[1] = VBIndex + 1;
-    indices[2] = VBIndex + 2;
-    IB.Write(indices, sizeof(indices));
+    indices[0] = State->VBIndex + 0;
+    indices[1] = State->VBIndex + 1;
+    indices[2] = State->VBIndex + 2;
+    State->IB.Write(indices, sizeof(indices));
 
-    VBIndex += 3;
-    IBIndex += 3;
+    State->VBIndex += 3;
+    State->IBIndex += 3;
 }
 
 void WriteTri(const Float2& p0, const Float2& p1, const Float2& p2, const Color& color0, const Color& color1, const Color& color2)
@@ -321,13 +408,13 @@ void WriteRect(const Rectangle& rect, const Color& color1, const Color& color2,
     quad[1] = MakeVertex(rect.GetBottomLeft(), Float2(uvUpperLeft.X, uvBottomRight.Y), color4);
     quad[2] = MakeVertex(rect.GetUpperLeft(), uvUpperLeft, color1);
     quad[3] = MakeVertex(rect.GetUpperRight(), Float2(uvBottomRight.X, uvUpperLeft.Y), color2);
-    VB.Write(quad, sizeof(quad));
+    State->VB.Write(quad, sizeof(quad));
 
     uint32 indices[6];
     RENDER2D_WRITE_IB_QUAD(indices);
 
-    VBIndex += 4;
-    IBIndex += 6;
+    State->VBIndex += 4;
+    State->IBIndex += 6;
 }
 
 void WriteRect(const Rectangle& rect, const Color& color, const Float2& uvUpperLeft, const Float2& uvBottomRight)
@@ -337,13 +424,13 @@ void WriteRect(const Rectangle& rect, const Color& color, const Float2& uvUpperL
     quad[1] = MakeVertex(rect.GetBottomLeft(), Float2(uvUpperLeft.X, uvBottomRight.Y), color);
     quad[2] = MakeVertex(rect.GetUpperLeft(), uvUpperLeft, color);
     quad[3] = MakeVertex(rect.GetUpperRight(), Float2(uvBottomRight.X, uvUpperLeft.Y), color);
-    VB.Write(quad, sizeof(quad));
+    State->VB.Write(quad, sizeof(quad));
 
     uint32 indices[6];
     RENDER2D_WRITE_IB_QUAD(indices);
 
-    VBIndex += 4;
-    IBIndex += 6;
+    State->VBIndex += 4;
+    State->IBIndex += 6;
 }
 
 FORCE_INLINE void WriteRect(const Rectangle& rect, const Color& color)
@@ -459,6 +546,9 @@ CanDrawCallCallback CanDrawCallBatch[] =
     CanDrawCallCallbackFalse, // Blur,
     CanDrawCallCallbackFalse, // ClipScissors,
     CanDrawCallCallbackTrue, // LineAA,
+    CanDrawCallCallbackTrue, // FillTextureBindless,
+    CanDrawCallCallbackTrue, // FillTexturePointBindless,
+    CanDrawCallCallbackChar, // DrawCharSDF,
 };
 static_assert(ARRAY_COUNT(CanDrawCallBatch) == (int32)DrawCallType::MAX, "Invalid draw calls batching descriptor.");
 // @formatter:on
@@ -498,6 +588,16 @@ bool CachedPSO::Init(GPUShader* shader, bool useDepth)
     if (PS_ImagePoint->Init(desc))
         return true;
     //
+    desc.PS = shader->GetPS("PS_ImageBindless");
+    PS_ImageBindless = GPUDevice::Instance->CreatePipelineState();
+    if (PS_ImageBindless->Init(desc))
+        return true;
+    //
+    desc.PS = shader->GetPS("PS_ImagePointBindless");
+    PS_ImagePointBindless = GPUDevice::Instance->CreatePipelineState();
+    if (PS_ImagePointBindless->Init(desc))
+        return true;
+    //
     desc.BlendMode = BlendingMode::AlphaBlend;
     desc.PS = shader->GetPS("PS_Color");
     PS_Color = GPUDevice::Instance->CreatePipelineState();
@@ -515,6 +615,11 @@ bool CachedPSO::Init(GPUShader* shader, bool useDepth)
     if (PS_Font->Init(desc))
         return true;
     //
+    desc.PS = shader->GetPS("PS_FontSDF");
+    PS_FontSDF = GPUDevice::Instance->CreatePipelineState();
+    if (PS_FontSDF->Init(desc))
+        return true;
+    //
     desc.PS = shader->GetPS("PS_LineAA");
     PS_LineAA = GPUDevice::Instance->CreatePipelineState();
     if (PS_LineAA->Init(desc))
@@ -549,9 +654,12 @@ void CachedPSO::Dispose()
 
     SAFE_DELETE_GPU_RESOURCE(PS_Image);
     SAFE_DELETE_GPU_RESOURCE(PS_ImagePoint);
+    SAFE_DELETE_GPU_RESOURCE(PS_ImageBindless);
+    SAFE_DELETE_GPU_RESOURCE(PS_ImagePointBindless);
     SAFE_DELETE_GPU_RESOURCE(PS_Color);
     SAFE_DELETE_GPU_RESOURCE(PS_Color_NoAlpha);
     SAFE_DELETE_GPU_RESOURCE(PS_Font);
+    SAFE_DELETE_GPU_RESOURCE(PS_FontSDF);
     SAFE_DELETE_GPU_RESOURCE(PS_BlurH);
     SAFE_DELETE_GPU_RESOURCE(PS_BlurV);
     SAFE_DELETE_GPU_RESOURCE(PS_Downscale);
@@ -576,7 +684,7 @@ Render2DService Render2DServiceInstance;
 
 bool Render2D::IsRendering()
 {
-    return Context != nullptr;
+    return State != nullptr;
 }
 
 const Viewport& Render2D::GetViewport()
@@ -604,26 +712,27 @@ bool Render2DService::Init()
     GUIShader.Get()->OnReloading.Bind<OnGUIShaderReloading>();
 #endif
 
-    DrawCalls.EnsureCapacity(RENDER2D_INITIAL_DRAW_CALL_CAPACITY);
+    MainState.DrawCalls.EnsureCapacity(RENDER2D_INITIAL_DRAW_CALL_CAPACITY);
 
     return false;
 }
 
 void Render2DService::Dispose()
 {
-    TintLayersStack.Resize(0);
-    ClipLayersStack.Resize(0);
-    DrawCalls.Resize(0);
-    Lines.Resize(0);
-    Lines2.Resize(0);
+    MainState.TintLayersStack.Resize(0);
+    MainState.ClipLayersStack.Resize(0);
+    MainState.DrawCalls.Resize(0);
+    MainState.Lines.Resize(0);
+    MainState.CharPositions.Resize(0);
+    MainState.Lines2.Resize(0);
 
     GUIShader = nullptr;
 
     PsoDepth.Dispose();
     PsoNoDepth.Dispose();
 
-    VB.Dispose();
-    IB.Dispose();
+    MainState.VB.Dispose();
+    MainState.IB.Dispose();
 }
 
 void Render2D::BeginFrame()
@@ -656,7 +765,7 @@ void Render2D::Begin(GPUContext* context, GPUTextureView* output, GPUTextureView
 
     Begin(context, output, depthBuffer, viewport, viewProjection);
 
-    IsScissorsRectEnabled = true;
+    State->IsScissorsRectEnabled = true;
 }
 
 void Render2D::Begin(GPUContext* context, GPUTextureView* output, GPUTextureView* depthBuffer, const Viewport& viewport, const Matrix& viewProjection)
@@ -670,46 +779,132 @@ void Render2D::Begin(GPUContext* context, GPUTextureView* output, GPUTextureView
     DepthBuffer = depthBuffer;
     View = viewport;
     ViewProjection = viewProjection;
-    DrawCalls.Clear();
+    MainState.Previous = State;
+    MainState.Reset(Rectangle(viewport.Location, viewport.Size));
+    State = &MainState;
+}
 
-    // Initialize default transform
-    const Matrix3x3 defaultTransform = Matrix3x3::Identity;
-    TransformLayersStack.Clear();
-    TransformLayersStack.Push(defaultTransform);
-    TransformCached = defaultTransform;
+void UseBindlessTextures()
+{
+    Render2DVertex* vertices = (Render2DVertex*)State->VB.Data.Get();
+    const uint32* indices = (const uint32*)State->IB.Data.Get();
+    for (Render2DDrawCall& drawCall : State->DrawCalls)
+    {
+        if (drawCall.Type != DrawCallType::FillTexture && drawCall.Type != DrawCallType::FillTexturePoint)
+            continue;
+        GPUTexture* texture = drawCall.AsTexture.Ptr;
+        if (!texture || !texture->HasResidentMip() || texture->IsDepthStencil())
+            continue;
+        const int32 bindlessIndex = texture->View()->GetBindlessIndex();
+        if (bindlessIndex < 0)
+            continue;
+
+        // Pass texture index to the shader within the vertex data (unused by images) so draw calls with different textures can be batched together
+        const float customData = (float)bindlessIndex;
+        for (uint32 i = 0; i < drawCall.CountIB; i++)
+            vertices[indices[drawCall.StartIB + i]].CustomData.X = customData;
+        drawCall.Type = drawCall.Type == DrawCallType::FillTexture ? DrawCallType::FillTextureBindless : DrawCallType::FillTexturePointBindless;
+    }
+}
 
-    // Initialize default clip mask
-    const Rectangle defaultBounds(viewport.Location, viewport.Size);
-    const RotatedRectangle defaultMask(defaultBounds);
-    ClipLayersStack.Clear();
-    ClipLayersStack.Add({ defaultMask, defaultBounds });
+void ReorderDrawCalls()
+{
+    PROFILE_CPU();
+    const Render2DVertex* vertices = (const Render2DVertex*)State->VB.Data.Get();
+    const uint32* indices = (const uint32*)State->IB.Data.Get();
+    const int32 drawCallsCount = State->DrawCalls.Count();
+    ReorderBatches.Clear();
+    ReorderNext.Resize(drawCallsCount, false);
+    bool anyMoved = false;
+    for (int32 i = 0; i < drawCallsCount; i++)
+    {
+        const Render2DDrawCall& drawCall = State->DrawCalls[i];
+        ReorderNext[i] = -1;
 
-    // Initialize default tint stack
-    TintLayersStack.Clear();
-    TintLayersStack.Add({ 1, 1, 1, 1 });
+        // Scissors change and blur (reads the output) cannot be reordered
+        if (drawCall.Type == DrawCallType::ClipScissors || drawCall.Type == DrawCallType::Blur)
+        {
+            ReorderBatches.Add({ i, i, Rectangle::Empty, true });
+            continue;
+        }
 
-    // Scissors can be enabled only for 2D orthographic projections
-    IsScissorsRectEnabled = false;
+        // Calculate the draw call bounds (with a small margin for vertex snapping and antialiasing)
+        Float2 min = Float2::Maximum, max = Float2::Minimum;
+        for (uint32 j = 0; j < drawCall.CountIB; j++)
+        {
+            const Float2& position = vertices[indices[drawCall.StartIB + j]].Position;
+            Float2::Min(min, position, min);
+            Float2::Max(max, position, max);
+        }
+        const Rectangle bounds = Rectangle(min, max - min).MakeExpanded(1.0f);
 
-    // Reset geometry buffer
-    VB.Clear();
-    IB.Clear();
-    VBIndex = 0;
-    IBIndex = 0;
+        // Find the previous batch to merge into that is not obstructed by any of the later batches
+        int32 target = -1;
+        for (int32 j = ReorderBatches.Count() - 1; j >= 0 && j >= ReorderBatches.Count() - RENDER2D_REORDER_MAX_SEARCH; j--)
+        {
+            const ReorderBatch& batch = ReorderBatches[j];
+            if (batch.IsBarrier)
+                break;
+            if (CanBatchDrawCalls(State->DrawCalls[batch.First], drawCall))
+            {
+                target = j;
+                break;
+            }
+            if (batch.Bounds.Intersects(bounds))
+                break;
+        }
+        if (target == -1)
+        {
+            ReorderBatches.Add({ i, i, bounds, false });
+            continue;
+        }
+        ReorderBatch& batch = ReorderBatches[target];
+        ReorderNext[batch.Last] = i;
+        batch.Last = i;
+        batch.Bounds = Rectangle::Union(batch.Bounds, bounds);
+        anyMoved |= target != ReorderBatches.Count() - 1;
+    }
+    if (!anyMoved)
+        return;
+
+    // Rebuild draw calls and indices in the new order (batch has to use a continuous range of indices)
+    ReorderDrawCallsList.Clear();
+    ReorderDrawCallsList.EnsureCapacity(drawCallsCount);
+    ReorderIndices.Resize(State->IBIndex, false);
+    uint32 ibIndex = 0;
+    for (const ReorderBatch& batch : ReorderBatches)
+    {
+        for (int32 i = batch.First; i != -1; i = ReorderNext[i])
+        {
+            Render2DDrawCall& drawCall = ReorderDrawCallsList.AddOne();
+            drawCall = State->DrawCalls[i];
+            if (drawCall.Type == DrawCallType::ClipScissors)
+                continue;
+            Platform::MemoryCopy(ReorderIndices.Get() + ibIndex, indices + drawCall.StartIB, drawCall.CountIB * sizeof(uint32));
+            drawCall.StartIB = ibIndex;
+            ibIndex += drawCall.CountIB;
+        }
+    }
+    ASSERT(ibIndex == State->IBIndex);
+    Platform::MemoryCopy(State->IB.Data.Get(), ReorderIndices.Get(), State->IBIndex * sizeof(uint32));
+    State->DrawCalls.Swap(ReorderDrawCallsList);
 }
 
 void Render2D::End()
 {
     RENDER2D_CHECK_RENDERING_STATE;
+    PROFILE_MEM(UI);
     ASSERT(Context != nullptr && Output != nullptr);
     ASSERT(GUIShader != nullptr);
+    ASSERT(State == &MainState);
 
     // Skip if has nothing to draw
-    if (DrawCalls.IsEmpty())
+    if (State->DrawCalls.IsEmpty())
     {
         // End
         Context = nullptr;
         Output = nullptr;
+        State = MainState.Previous;
         return;
     }
 
@@ -721,17 +916,24 @@ void Render2D::End()
         if (!GUIShader->IsLoaded() && GUIShader->WaitForLoaded())
         {
             // End
-            DrawCalls.Clear();
+            State->DrawCalls.Clear();
             Context = nullptr;
             Output = nullptr;
+            State = MainState.Previous;
             return;
         }
         shader = GUIShader->GetShader();
     }
 
+    // Optimize draw calls batching
+    if (EnumHasAnyFlags(Features, RenderingFeatures::BindlessTextures) && GPUDevice::Instance->Limits.HasBindlessResources)
+        UseBindlessTextures();
+    if (EnumHasAnyFlags(Features, RenderingFeatures::DrawCallsReordering))
+        ReorderDrawCalls();
+
     // Flush geometry buffers
-    VB.Flush(Context);
-    IB.Flush(Context);
+    State->VB.Flush(Context);
+    State->IB.Flush(Context);
 
     // Set output
     Context->ResetSR();
@@ -757,13 +959,13 @@ void Render2D::End()
     // Flush draw calls
     int32 batchStart = 0, batchSize = 0;
     IsScissorsRectEmpty = false;
-    for (int32 i = 0; i < DrawCalls.Count(); i++)
+    for (int32 i = 0; i < State->DrawCalls.Count(); i++)
     {
         // Peek draw call
-        const auto& drawCall = DrawCalls[i];
+        const auto& drawCall = State->DrawCalls[i];
 
         // Check if cannot add element to the batching
-        if (batchSize != 0 && !CanBatchDrawCalls(DrawCalls[batchStart], drawCall))
+        if (batchSize != 0 && !CanBatchDrawCalls(State->DrawCalls[batchStart], drawCall))
         {
             // Flush batched elements
             DrawBatch(batchStart, batchSize);
@@ -782,9 +984,10 @@ void Render2D::End()
     }
 
     // End
-    DrawCalls.Clear();
+    State->DrawCalls.Clear();
     Context = nullptr;
     Output = nullptr;
+    State = MainState.Previous;
 }
 
 void Render2D::EndFrame()
@@ -801,35 +1004,35 @@ void Render2D::PushTransform(const Matrix3x3& transform)
 
     // Combine transformation
     Matrix3x3 finalTransform;
-    Matrix3x3::Multiply(transform, TransformCached, finalTransform);
+    Matrix3x3::Multiply(transform, State->TransformCached, finalTransform);
 
     // Push it
-    TransformLayersStack.Push(finalTransform);
-    TransformCached = TransformLayersStack.Peek();
+    State->TransformLayersStack.Push(finalTransform);
+    State->TransformCached = State->TransformLayersStack.Peek();
 }
 
 void Render2D::PeekTransform(Matrix3x3& transform)
 {
-    transform = TransformCached;
+    transform = State->TransformCached;
 }
 
 void Render2D::PopTransform()
 {
     RENDER2D_CHECK_RENDERING_STATE;
 
-    ASSERT(TransformLayersStack.HasItems());
-    TransformLayersStack.Pop();
-    TransformCached = TransformLayersStack.Peek();
+    ASSERT(State->TransformLayersStack.HasItems());
+    State->TransformLayersStack.Pop();
+    State->TransformCached = State->TransformLayersStack.Peek();
 }
 
 void OnClipScissors()
 {
-    if (!IsScissorsRectEnabled)
+    if (!State->IsScissorsRectEnabled)
         return;
 
-    const auto& mask = ClipLayersStack.Peek();
+    const auto& mask = State->ClipLayersStack.Peek();
 
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = DrawCallType::ClipScissors;
     drawCall.AsClipScissors.X = mask.Bounds.GetX();
     drawCall.AsClipScissors.Y = mask.Bounds.GetY();
@@ -843,22 +1046,22 @@ void Render2D::PushClip(const Rectangle& clipRect)
 
     RotatedRectangle clipRectTransformed;
     ApplyTransform(clipRect, clipRectTransformed);
-    const Rectangle bounds = Rectangle::Shared(clipRectTransformed.ToBoundingRect(), ClipLayersStack.Peek().Bounds);
-    ClipLayersStack.Push({ clipRectTransformed, bounds });
+    const Rectangle bounds = Rectangle::Shared(clipRectTransformed.ToBoundingRect(), State->ClipLayersStack.Peek().Bounds);
+    State->ClipLayersStack.Push({ clipRectTransformed, bounds });
 
     OnClipScissors();
 }
 
 void Render2D::PeekClip(Rectangle& clipRect)
 {
-    clipRect = ClipLayersStack.Peek().Bounds;
+    clipRect = State->ClipLayersStack.Peek().Bounds;
 }
 
 void Render2D::PopClip()
 {
     RENDER2D_CHECK_RENDERING_STATE;
 
-    ClipLayersStack.Pop();
+    State->ClipLayersStack.Pop();
 
     OnClipScissors();
 }
@@ -867,19 +1070,203 @@ void Render2D::PushTint(const Color& tint, bool inherit)
 {
     RENDER2D_CHECK_RENDERING_STATE;
 
-    TintLayersStack.Push(inherit ? tint * TintLayersStack.Peek() : tint);
+    State->TintLayersStack.Push(inherit ? tint * State->TintLayersStack.Peek() : tint);
 }
 
 void Render2D::PeekTint(Color& tint)
 {
-    tint = TintLayersStack.Peek();
+    tint = State->TintLayersStack.Peek();
 }
 
 void Render2D::PopTint()
 {
     RENDER2D_CHECK_RENDERING_STATE;
 
-    TintLayersStack.Pop();
+    State->TintLayersStack.Pop();
+}
+
+void AppendGeometry(const byte* vertices, int32 vertexCount, const uint32* indices, int32 indexCount, const Render2DDrawCall* drawCalls, int32 drawCallsCount)
+{
+    // Indices and draw calls are relative to the start of the geometry
+    State->VB.Write(vertices, vertexCount * (int32)sizeof(Render2DVertex));
+    uint32* dstIndices = (uint32*)State->IB.WriteReserve(indexCount * sizeof(uint32));
+    for (int32 i = 0; i < indexCount; i++)
+        dstIndices[i] = indices[i] + State->VBIndex;
+    const int32 drawCallsStart = State->DrawCalls.Count();
+    State->DrawCalls.Add(drawCalls, drawCallsCount);
+    for (int32 i = drawCallsStart; i < State->DrawCalls.Count(); i++)
+    {
+        if (State->DrawCalls[i].Type != DrawCallType::ClipScissors)
+            State->DrawCalls[i].StartIB += State->IBIndex;
+    }
+    State->VBIndex += vertexCount;
+    State->IBIndex += indexCount;
+}
+
+Render2DCache::Render2DCache(const SpawnParams& params)
+    : ScriptingObject(params)
+{
+}
+
+int32 Render2DCache::GetMemoryUsage() const
+{
+    return _vertices.Capacity() + _indices.Capacity() * sizeof(uint32) + _drawCalls.Capacity();
+}
+
+void Render2DCache::Invalidate()
+{
+    _isValid = false;
+}
+
+void Render2D::BeginCache(Render2DCache* cache)
+{
+    RENDER2D_CHECK_RENDERING_STATE;
+    CHECK(cache);
+
+    auto& recording = State->CacheRecordings.AddOne();
+    recording.Cache = cache;
+    recording.StartVB = State->VBIndex;
+    recording.StartIB = State->IBIndex;
+    recording.StartDrawCall = State->DrawCalls.Count();
+
+    // Cache the rendering state to validate it when drawing the cache later
+    cache->_isValid = false;
+    cache->_fontsVersion = FontManager::CharactersVersion;
+    cache->_fontScale = FontManager::FontScale;
+    cache->_features = (int32)Features;
+    cache->_scissors = State->IsScissorsRectEnabled;
+    cache->_transform = State->TransformCached;
+    cache->_clip = State->ClipLayersStack.Peek().Bounds;
+    cache->_tint = State->TintLayersStack.Peek();
+}
+
+void Render2D::EndCache()
+{
+    RENDER2D_CHECK_RENDERING_STATE;
+    if (State->CacheRecordings.IsEmpty())
+    {
+        LOG(Warning, "Missing Render2D.BeginCache call before EndCache.");
+        return;
+    }
+    const CacheRecording recording = State->CacheRecordings.Pop();
+    Render2DCache* cache = recording.Cache;
+
+    // Copy the geometry (indices and draw calls are stored relative to the recording start)
+    const int32 vertexCount = (int32)(State->VBIndex - recording.StartVB);
+    const int32 indexCount = (int32)(State->IBIndex - recording.StartIB);
+    const int32 drawCallsCount = State->DrawCalls.Count() - recording.StartDrawCall;
+    cache->_vertexCount = vertexCount;
+    cache->_vertices.Set(State->VB.Data.Get() + recording.StartVB * sizeof(Render2DVertex), vertexCount * sizeof(Render2DVertex));
+    cache->_indices.Resize(indexCount, false);
+    const uint32* indices = (const uint32*)State->IB.Data.Get() + recording.StartIB;
+    for (int32 i = 0; i < indexCount; i++)
+        cache->_indices.Get()[i] = indices[i] - recording.StartVB;
+    cache->_drawCalls.Set((const byte*)(State->DrawCalls.Get() + recording.StartDrawCall), drawCallsCount * sizeof(Render2DDrawCall));
+    auto drawCalls = (Render2DDrawCall*)cache->_drawCalls.Get();
+    for (int32 i = 0; i < drawCallsCount; i++)
+    {
+        if (drawCalls[i].Type != DrawCallType::ClipScissors)
+            drawCalls[i].StartIB -= recording.StartIB;
+    }
+    cache->_isValid = true;
+}
+
+bool Render2D::DrawCache(Render2DCache* cache)
+{
+#if USE_EDITOR
+    if (!IsRendering())
+    {
+        LOG(Error, "Calling Render2D is only valid during rendering.");
+        return true;
+    }
+#endif
+    if (!cache ||
+        !cache->_isValid ||
+        cache->_fontsVersion != FontManager::CharactersVersion ||
+        cache->_fontScale != FontManager::FontScale ||
+        cache->_features != (int32)Features ||
+        cache->_scissors != State->IsScissorsRectEnabled ||
+        cache->_transform != State->TransformCached ||
+        cache->_clip != State->ClipLayersStack.Peek().Bounds ||
+        cache->_tint != State->TintLayersStack.Peek())
+        return true;
+
+    // Append the cached geometry
+    const auto drawCalls = (const Render2DDrawCall*)cache->_drawCalls.Get();
+    const int32 drawCallsCount = cache->_drawCalls.Count() / (int32)sizeof(Render2DDrawCall);
+    AppendGeometry(cache->_vertices.Get(), cache->_vertexCount, cache->_indices.Get(), cache->_indices.Count(), drawCalls, drawCallsCount);
+    return false;
+}
+
+Render2DCommandList::Render2DCommandList(const SpawnParams& params)
+    : ScriptingObject(params)
+    , _state(New<Render2DRecordingState>(0, 0))
+{
+}
+
+Render2DCommandList::~Render2DCommandList()
+{
+    ASSERT(!_state->IsRecording);
+    Delete(_state);
+}
+
+bool Render2DCommandList::IsRecording() const
+{
+    return _state->IsRecording;
+}
+
+bool Render2DCommandList::IsEmpty() const
+{
+    return _state->DrawCalls.IsEmpty();
+}
+
+int32 Render2DCommandList::GetMemoryUsage() const
+{
+    return _state->VB.Data.Capacity() + _state->IB.Data.Capacity() + _state->DrawCalls.Capacity() * sizeof(Render2DDrawCall);
+}
+
+void Render2DCommandList::Clear()
+{
+    ASSERT(!_state->IsRecording);
+    _state->Reset(Rectangle::Empty);
+}
+
+void Render2D::BeginRecording(Render2DCommandList* list, const Rectangle& bounds)
+{
+    CHECK(list && !list->_state->IsRecording);
+    Render2DRecordingState* state = list->_state;
+    state->Reset(bounds);
+    state->IsRecording = true;
+    state->Previous = State;
+    State = state;
+}
+
+void Render2D::EndRecording()
+{
+    if (!State || !State->IsRecording)
+    {
+        LOG(Warning, "Missing Render2D.BeginRecording call before EndRecording.");
+        return;
+    }
+    if (State->CacheRecordings.HasItems())
+    {
+        LOG(Warning, "Missing Render2D.EndCache call before EndRecording.");
+        State->CacheRecordings.Clear();
+    }
+    Render2DRecordingState* state = State;
+    state->IsRecording = false;
+    State = state->Previous;
+    state->Previous = nullptr;
+}
+
+void Render2D::Submit(Render2DCommandList* list)
+{
+    RENDER2D_CHECK_RENDERING_STATE;
+    CHECK(list && !list->_state->IsRecording);
+    const Render2DRecordingState* state = list->_state;
+    if (state->DrawCalls.IsEmpty())
+        return;
+    AppendGeometry(state->VB.Data.Get(), (int32)state->VBIndex, (const uint32*)state->IB.Data.Get(), (int32)state->IBIndex, state->DrawCalls.Get(), state->DrawCalls.Count());
 }
 
 void CalculateKernelSize(float strength, int32& kernelSize, int32& downSample)
@@ -940,12 +1327,12 @@ static uint32 ComputeBlurWeights(int32 kernelSize, float sigma, Float4* outWeigh
 
 void DrawBatch(int32 startIndex, int32 count)
 {
-    const Render2DDrawCall& d = DrawCalls[startIndex];
-    GPUBuffer* vb = VB.GetBuffer();
-    GPUBuffer* ib = IB.GetBuffer();
+    const Render2DDrawCall& d = State->DrawCalls[startIndex];
+    GPUBuffer* vb = State->VB.GetBuffer();
+    GPUBuffer* ib = State->IB.GetBuffer();
     uint32 countIb = 0;
     for (int32 i = 0; i < count; i++)
-        countIb += DrawCalls[startIndex + i].CountIB;
+        countIb += State->DrawCalls[startIndex + i].CountIB;
 
     if (d.Type == DrawCallType::ClipScissors)
     {
@@ -981,6 +1368,10 @@ void DrawBatch(int32 startIndex, int32 count)
         Context->BindSR(0, d.AsChar.Tex);
         Context->SetState(CurrentPso->PS_Font);
         break;
+    case DrawCallType::DrawCharSDF:
+        Context->BindSR(0, d.AsChar.Tex);
+        Context->SetState(CurrentPso->PS_FontSDF);
+        break;
     case DrawCallType::DrawCharMaterial:
     {
         // Apply and bind material
@@ -993,7 +1384,7 @@ void DrawBatch(int32 startIndex, int32 count)
         material->Bind(bindParams);
 
         // Bind font atlas as a material parameter
-        static StringView FontParamName = TEXT("Font");
+        static StringName FontParamName(TEXT("Font"));
         auto param = material->Params.Get(FontParamName);
         if (param && param->GetParameterType() == MaterialParameterType::Texture)
         {
@@ -1130,6 +1521,23 @@ void DrawBatch(int32 startIndex, int32 count)
     case DrawCallType::LineAA:
         Context->SetState(CurrentPso->PS_LineAA);
         break;
+    case DrawCallType::FillTextureBindless:
+    case DrawCallType::FillTexturePointBindless:
+    {
+        // Textures are not bound to the slots so transition them manually to be readable by the shader
+        GPUTexture* prevTexture = nullptr;
+        for (int32 i = 0; i < count; i++)
+        {
+            GPUTexture* texture = State->DrawCalls[startIndex + i].AsTexture.Ptr;
+            if (texture != prevTexture)
+            {
+                prevTexture = texture;
+                Context->SetResourceShaderReadState(texture);
+            }
+        }
+        Context->SetState(d.Type == DrawCallType::FillTextureBindless ? CurrentPso->PS_ImageBindless : CurrentPso->PS_ImagePointBindless);
+        break;
+    }
 #if !BUILD_RELEASE
     default:
         CRASH;
@@ -1227,15 +1635,17 @@ void Render2D::DrawText(Font* font, const StringView& text, const Color& color,
                 const float x = pointer.X + entry.OffsetX * scale;
                 const float y = pointer.Y + (font->GetHeight() + font->GetDescender() - entry.OffsetY) * scale;
 
-                Rectangle charRect(x, y, entry.UVSize.X * scale, entry.UVSize.Y * scale);
+                Rectangle charRect(x, y, entry.Size.X * scale, entry.Size.Y * scale);
 
                 Float2 upperLeftUV = entry.UV * invAtlasSize;
                 Float2 rightBottomUV = (entry.UV + entry.UVSize) * invAtlasSize;
 
                 // Add draw call
-                drawCall.StartIB = IBIndex;
+                if (!customMaterial)
+                    drawCall.Type = entry.IsSDF ? DrawCallType::DrawCharSDF : DrawCallType::DrawChar;
+                drawCall.StartIB = State->IBIndex;
                 drawCall.CountIB = 6;
-                DrawCalls.Add(drawCall);
+                State->DrawCalls.Add(drawCall);
                 WriteRect(charRect, color, upperLeftUV, rightBottomUV);
             }
 
@@ -1271,14 +1681,13 @@ void Render2D::DrawText(Font* font, const StringView& text, const Color& color,
     uint32 fontAtlasIndex = 0;
     FontTextureAtlas* fontAtlas = nullptr;
     Float2 invAtlasSize = Float2::One;
-    FontCharacterEntry previous;
-    int32 kerning;
     float scale = layout.Scale / FontManager::FontScale;
     const bool enableFallbackFonts = EnumHasAllFlags(Features, RenderingFeatures::FallbackFonts);
 
-    // Process text to get lines
-    Lines.Clear();
-    font->ProcessText(text, Lines, layout);
+    // Process text to get lines and characters placement (cached by the font)
+    State->Lines.Clear();
+    State->CharPositions.Clear();
+    font->ProcessText(text, State->Lines, State->CharPositions, layout);
 
     // Render all lines
     FontCharacterEntry entry;
@@ -1293,10 +1702,9 @@ void Render2D::DrawText(Font* font, const StringView& text, const Color& color,
         drawCall.Type = DrawCallType::DrawChar;
         drawCall.AsChar.Mat = nullptr;
     }
-    for (int32 lineIndex = 0; lineIndex < Lines.Count(); lineIndex++)
+    for (int32 lineIndex = 0; lineIndex < State->Lines.Count(); lineIndex++)
     {
-        const FontLineCache& line = Lines[lineIndex];
-        Float2 pointer = line.Location;
+        const FontLineCache& line = State->Lines[lineIndex];
 
         // Render all characters from the line
         for (int32 charIndex = line.FirstCharIndex; charIndex <= line.LastCharIndex; charIndex++)
@@ -1329,41 +1737,27 @@ void Render2D::DrawText(Font* font, const StringView& text, const Color& color,
                     }
                 }
 
-                // Get kerning
-                const bool isWhitespace = StringUtils::IsWhitespace(currentChar);
-                if (!isWhitespace && previous.IsValid)
-                {
-                    kerning = entry.Font->GetKerning(previous.Character, entry.Character);
-                }
-                else
-                {
-                    kerning = 0;
-                }
-                pointer.X += (float)kerning * scale;
-                previous = entry;
-
                 // Omit whitespace characters
-                if (!isWhitespace)
+                if (!StringUtils::IsWhitespace(currentChar))
                 {
-                    // Calculate character size and atlas coordinates
-                    const float x = pointer.X + entry.OffsetX * scale;
-                    const float y = pointer.Y - entry.OffsetY * scale + Math::Ceil((font->GetHeight() + font->GetDescender()) * scale);
+                    // Calculate character size and atlas coordinates (position includes kerning)
+                    const float x = line.Location.X + State->CharPositions[charIndex] + entry.OffsetX * scale;
+                    const float y = line.Location.Y - entry.OffsetY * scale + Math::Ceil((font->GetHeight() + font->GetDescender()) * scale);
 
-                    Rectangle charRect(x, y, entry.UVSize.X * scale, entry.UVSize.Y * scale);
+                    Rectangle charRect(x, y, entry.Size.X * scale, entry.Size.Y * scale);
                     charRect.Offset(layout.Bounds.Location);
 
                     Float2 upperLeftUV = entry.UV * invAtlasSize;
                     Float2 rightBottomUV = (entry.UV + entry.UVSize) * invAtlasSize;
 
                     // Add draw call
-                    drawCall.StartIB = IBIndex;
+                    if (!customMaterial)
+                        drawCall.Type = entry.IsSDF ? DrawCallType::DrawCharSDF : DrawCallType::DrawChar;
+                    drawCall.StartIB = State->IBIndex;
                     drawCall.CountIB = 6;
-                    DrawCalls.Add(drawCall);
+                    State->DrawCalls.Add(drawCall);
                     WriteRect(charRect, color, upperLeftUV, rightBottomUV);
                 }
-
-                // Move
-                pointer.X += entry.AdvanceX * scale;
             }
         }
     }
@@ -1376,31 +1770,31 @@ void Render2D::DrawText(Font* font, const StringView& text, const TextRange& tex
 
 FORCE_INLINE bool NeedAlphaWithTint(const Color& color)
 {
-    return (color.A * TintLayersStack.Peek().A) < 1.0f;
+    return (color.A * State->TintLayersStack.Peek().A) < 1.0f;
 }
 
 FORCE_INLINE bool NeedAlphaWithTint(const Color& color1, const Color& color2)
 {
-    return (color1.A * TintLayersStack.Peek().A) < 1.0f || (color2.A * TintLayersStack.Peek().A) < 1.0f;
+    return (color1.A * State->TintLayersStack.Peek().A) < 1.0f || (color2.A * State->TintLayersStack.Peek().A) < 1.0f;
 }
 
 FORCE_INLINE bool NeedAlphaWithTint(const Color& color1, const Color& color2, const Color& color3)
 {
-    return (color1.A * TintLayersStack.Peek().A) < 1.0f || (color2.A * TintLayersStack.Peek().A) < 1.0f || (color3.A * TintLayersStack.Peek().A) < 1.0f;
+    return (color1.A * State->TintLayersStack.Peek().A) < 1.0f || (color2.A * State->TintLayersStack.Peek().A) < 1.0f || (color3.A * State->TintLayersStack.Peek().A) < 1.0f;
 }
 
 FORCE_INLINE bool NeedAlphaWithTint(const Color& color1, const Color& color2, const Color& color3, const Color& color4)
 {
-    return (color1.A * TintLayersStack.Peek().A) < 1.0f || (color2.A * TintLayersStack.Peek().A) < 1.0f || (color3.A * TintLayersStack.Peek().A) < 1.0f || (color4.A * TintLayersStack.Peek().A) < 1.0f;
+    return (color1.A * State->TintLayersStack.Peek().A) < 1.0f || (color2.A * State->TintLayersStack.Peek().A) < 1.0f || (color3.A * State->TintLayersStack.Peek().A) < 1.0f || (color4.A * State->TintLayersStack.Peek().A) < 1.0f;
 }
 
 void Render2D::FillRectangle(const Rectangle& rect, const Color& color)
 {
     RENDER2D_CHECK_RENDERING_STATE;
 
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = NeedAlphaWithTint(color) ? DrawCallType::FillRect : DrawCallType::FillRectNoAlpha;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 6;
     WriteRect(rect, color);
 }
@@ -1409,9 +1803,9 @@ void Render2D::FillRectangle(const Rectangle& rect, const Color& color1, const C
 {
     RENDER2D_CHECK_RENDERING_STATE;
 
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = NeedAlphaWithTint(color1, color2, color3, color4) ? DrawCallType::FillRect : DrawCallType::FillRectNoAlpha;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 6;
     WriteRect(rect, color1, color2, color3, color4);
 }
@@ -1420,8 +1814,8 @@ void Render2D::DrawRectangle(const Rectangle& rect, const Color& color1, const C
 {
     RENDER2D_CHECK_RENDERING_STATE;
 
-    const auto& mask = ClipLayersStack.Peek().Mask;
-    thickness *= (TransformCached.M11 + TransformCached.M22 + TransformCached.M33) * 0.3333333f;
+    const auto& mask = State->ClipLayersStack.Peek().Mask;
+    thickness *= (State->TransformCached.M11 + State->TransformCached.M22 + State->TransformCached.M33) * 0.3333333f;
 
     Float2 points[5];
     ApplyTransform(rect.GetUpperLeft(), points[0]);
@@ -1446,9 +1840,9 @@ void Render2D::DrawRectangle(const Rectangle& rect, const Color& color1, const C
     c1t = colors[0];
 
 #if RENDER2D_USE_LINE_AA
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = DrawCallType::LineAA;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 4 * (6 + 3);
 
     // This must be the same as in HLSL code
@@ -1470,18 +1864,18 @@ void Render2D::DrawRectangle(const Rectangle& rect, const Color& color1, const C
         v[1] = MakeVertex(p1t + up, Float2::UnitX, c1t, mask, { thickness, (float)Features });
         v[2] = MakeVertex(p1t - up, Float2::Zero, c1t, mask, { thickness, (float)Features });
         v[3] = MakeVertex(p2t - up, Float2::Zero, c2t, mask, { thickness, (float)Features });
-        VB.Write(v, sizeof(Render2DVertex) * 4);
+        State->VB.Write(v, sizeof(Render2DVertex) * 4);
 
-        indices[0] = VBIndex + 0;
-        indices[1] = VBIndex + 1;
-        indices[2] = VBIndex + 2;
-        indices[3] = VBIndex + 2;
-        indices[4] = VBIndex + 3;
-        indices[5] = VBIndex + 0;
-        IB.Write(indices, sizeof(uint32) * 6);
+        indices[0] = State->VBIndex + 0;
+        indices[1] = State->VBIndex + 1;
+        indices[2] = State->VBIndex + 2;
+        indices[3] = State->VBIndex + 2;
+        indices[4] = State->VBIndex + 3;
+        indices[5] = State->VBIndex + 0;
+        State->IB.Write(indices, sizeof(uint32) * 6);
 
-        VBIndex += 4;
-        IBIndex += 6;
+        State->VBIndex += 4;
+        State->IBIndex += 6;
 
         // Corner cap
 
@@ -1489,24 +1883,24 @@ void Render2D::DrawRectangle(const Rectangle& rect, const Color& color1, const C
         v[0] = MakeVertex(p2t - up, Float2::Zero, c2t, mask, { tmp, (float)Features });
         v[1] = MakeVertex(p2t + right, Float2::Zero, c2t, mask, { tmp, (float)Features });
         v[2] = MakeVertex(p2t, Float2(0.5f, 0.0f), c2t, mask, { tmp, (float)Features });
-        VB.Write(v, sizeof(Render2DVertex) * 4);
+        State->VB.Write(v, sizeof(Render2DVertex) * 4);
 
-        indices[0] = VBIndex + 1;
-        indices[1] = VBIndex + 2;
-        indices[2] = VBIndex + 0;
+        indices[0] = State->VBIndex + 1;
+        indices[1] = State->VBIndex + 2;
+        indices[2] = State->VBIndex + 0;
 
-        IB.Write(indices, sizeof(uint32) * 3);
+        State->IB.Write(indices, sizeof(uint32) * 3);
 
-        VBIndex += 4;
-        IBIndex += 3;
+        State->VBIndex += 4;
+        State->IBIndex += 3;
 
         p1t = p2t;
         c1t = c2t;
     }
 #else
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = NeedAlphaWithTint(color1, color2) ? DrawCallType::FillRect : DrawCallType::FillRectNoAlpha;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 4 * (6 + 3);
 
     const float thicknessHalf = thickness * 0.5f;
@@ -1526,34 +1920,34 @@ void Render2D::DrawRectangle(const Rectangle& rect, const Color& color1, const C
         v[1] = MakeVertex(p1t + up, Float2::UnitX, c1t, mask, { 0.0f, (float)Features });
         v[2] = MakeVertex(p1t - up, Float2::Zero, c1t, mask, { 0.0f, (float)Features });
         v[3] = MakeVertex(p2t - up, Float2::Zero, c2t, mask, { 0.0f, (float)Features });
-        VB.Write(v, sizeof(Render2DVertex) * 4);
+        State->VB.Write(v, sizeof(Render2DVertex) * 4);
 
-        indices[0] = VBIndex + 0;
-        indices[1] = VBIndex + 1;
-        indices[2] = VBIndex + 2;
-        indices[3] = VBIndex + 2;
-        indices[4] = VBIndex + 3;
-        indices[5] = VBIndex + 0;
-        IB.Write(indices, sizeof(uint32) * 6);
+        indices[0] = State->VBIndex + 0;
+        indices[1] = State->VBIndex + 1;
+        indices[2] = State->VBIndex + 2;
+        indices[3] = State->VBIndex + 2;
+        indices[4] = State->VBIndex + 3;
+        indices[5] = State->VBIndex + 0;
+        State->IB.Write(indices, sizeof(uint32) * 6);
 
-        VBIndex += 4;
-        IBIndex += 6;
+        State->VBIndex += 4;
+        State->IBIndex += 6;
 
         // Corner cap
 
         v[0] = MakeVertex(p2t - up, Float2::Zero, c2t, mask, { 0.0f, (float)Features });
         v[1] = MakeVertex(p2t + right, Float2::Zero, c2t, mask, { 0.0f, (float)Features });
         v[2] = MakeVertex(p2t, Float2(0.5f, 0.0f), c2t, mask, { 0.0f, (float)Features });
-        VB.Write(v, sizeof(Render2DVertex) * 4);
+        State->VB.Write(v, sizeof(Render2DVertex) * 4);
 
-        indices[0] = VBIndex + 1;
-        indices[1] = VBIndex + 2;
-        indices[2] = VBIndex + 0;
+        indices[0] = State->VBIndex + 1;
+        indices[1] = State->VBIndex + 2;
+        indices[2] = State->VBIndex + 0;
 
-        IB.Write(indices, sizeof(uint32) * 3);
+        State->IB.Write(indices, sizeof(uint32) * 3);
 
-        VBIndex += 4;
-        IBIndex += 3;
+        State->VBIndex += 4;
+        State->IBIndex += 3;
 
         p1t = p2t;
         c1t = c2t;
@@ -1565,9 +1959,9 @@ void Render2D::DrawTexture(GPUTextureView* rt, const Rectangle& rect, const Colo
 {
     RENDER2D_CHECK_RENDERING_STATE;
 
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = DrawCallType::FillRT;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 6;
     drawCall.AsRT.Ptr = rt;
     WriteRect(rect, color);
@@ -1579,10 +1973,10 @@ void Render2D::DrawTexture(GPUTexture* t, const Rectangle& rect, const Color& co
 
     Render2DDrawCall drawCall;
     drawCall.Type = DrawCallType::FillTexture;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 6;
     drawCall.AsTexture.Ptr = t;
-    DrawCalls.Add(drawCall);
+    State->DrawCalls.Add(drawCall);
     WriteRect(rect, color);
 }
 
@@ -1592,10 +1986,10 @@ void Render2D::DrawTexture(TextureBase* t, const Rectangle& rect, const Color& c
 
     Render2DDrawCall drawCall;
     drawCall.Type = DrawCallType::FillTexture;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 6;
     drawCall.AsTexture.Ptr = t ? t->GetTexture() : nullptr;
-    DrawCalls.Add(drawCall);
+    State->DrawCalls.Add(drawCall);
     WriteRect(rect, color);
 }
 
@@ -1606,9 +2000,9 @@ void Render2D::DrawSprite(const SpriteHandle& spriteHandle, const Rectangle& rec
         return;
 
     Sprite* sprite = &spriteHandle.Atlas->Sprites.At(spriteHandle.Index);
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = DrawCallType::FillTexture;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 6;
     drawCall.AsTexture.Ptr = spriteHandle.Atlas->GetTexture();
     WriteRect(rect, color, sprite->Area.GetUpperLeft(), sprite->Area.GetBottomRight());
@@ -1618,9 +2012,9 @@ void Render2D::DrawTexturePoint(GPUTexture* t, const Rectangle& rect, const Colo
 {
     RENDER2D_CHECK_RENDERING_STATE;
 
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = DrawCallType::FillTexturePoint;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 6;
     drawCall.AsTexture.Ptr = t;
     WriteRect(rect, color);
@@ -1633,9 +2027,9 @@ void Render2D::DrawSpritePoint(const SpriteHandle& spriteHandle, const Rectangle
         return;
 
     Sprite* sprite = &spriteHandle.Atlas->Sprites.At(spriteHandle.Index);
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = DrawCallType::FillTexturePoint;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 6;
     drawCall.AsTexture.Ptr = spriteHandle.Atlas->GetTexture();
     WriteRect(rect, color, sprite->Area.GetUpperLeft(), sprite->Area.GetBottomRight());
@@ -1647,10 +2041,10 @@ void Render2D::Draw9SlicingTexture(TextureBase* t, const Rectangle& rect, const
 
     Render2DDrawCall drawCall;
     drawCall.Type = DrawCallType::FillTexture;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 6 * 9;
     drawCall.AsTexture.Ptr = t ? t->GetTexture() : nullptr;
-    DrawCalls.Add(drawCall);
+    State->DrawCalls.Add(drawCall);
     Write9SlicingRect(rect, color, border, borderUVs);
 }
 
@@ -1660,10 +2054,10 @@ void Render2D::Draw9SlicingTexturePoint(TextureBase* t, const Rectangle& rect, c
 
     Render2DDrawCall drawCall;
     drawCall.Type = DrawCallType::FillTexturePoint;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 6 * 9;
     drawCall.AsTexture.Ptr = t ? t->GetTexture() : nullptr;
-    DrawCalls.Add(drawCall);
+    State->DrawCalls.Add(drawCall);
     Write9SlicingRect(rect, color, border, borderUVs);
 }
 
@@ -1674,9 +2068,9 @@ void Render2D::Draw9SlicingSprite(const SpriteHandle& spriteHandle, const Rectan
         return;
 
     Sprite* sprite = &spriteHandle.Atlas->Sprites.At(spriteHandle.Index);
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = DrawCallType::FillTexture;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 6 * 9;
     drawCall.AsTexture.Ptr = spriteHandle.Atlas->GetTexture();
     Write9SlicingRect(rect, color, border, borderUVs, sprite->Area.Location, sprite->Area.Size);
@@ -1689,9 +2083,9 @@ void Render2D::Draw9SlicingSpritePoint(const SpriteHandle& spriteHandle, const R
         return;
 
     Sprite* sprite = &spriteHandle.Atlas->Sprites.At(spriteHandle.Index);
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = DrawCallType::FillTexturePoint;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 6 * 9;
     drawCall.AsTexture.Ptr = spriteHandle.Atlas->GetTexture();
     Write9SlicingRect(rect, color, border, borderUVs, sprite->Area.Location, sprite->Area.Size);
@@ -1703,9 +2097,9 @@ void Render2D::DrawCustom(GPUTexture* t, const Rectangle& rect, GPUPipelineState
     if (ps == nullptr || !ps->IsValid())
         return;
 
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = DrawCallType::Custom;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 6;
     drawCall.AsCustom.Tex = t;
     drawCall.AsCustom.Pso = ps;
@@ -1716,7 +2110,7 @@ void Render2D::DrawCustom(GPUTexture* t, const Rectangle& rect, GPUPipelineState
 
 void DrawLineCap(const Float2& capOrigin, const Float2& capDirection, const Float2& up, const Color& color, float thickness)
 {
-    const auto& mask = ClipLayersStack.Peek().Mask;
+    const auto& mask = State->ClipLayersStack.Peek().Mask;
 
     Render2DVertex v[5];
     v[0] = MakeVertex(capOrigin, Float2(0.5f, 0.0f), color, mask, { thickness, (float)Render2D::Features });
@@ -1724,22 +2118,22 @@ void DrawLineCap(const Float2& capOrigin, const Float2& capDirection, const Floa
     v[2] = MakeVertex(capOrigin + capDirection - up, Float2::Zero, color, mask, { thickness, (float)Render2D::Features });
     v[3] = MakeVertex(capOrigin + up, Float2::Zero, color, mask, { thickness, (float)Render2D::Features });
     v[4] = MakeVertex(capOrigin - up, Float2::Zero, color, mask, { thickness, (float)Render2D::Features });
-    VB.Write(v, sizeof(v));
+    State->VB.Write(v, sizeof(v));
 
     uint32 indices[9];
-    indices[0] = VBIndex + 0;
-    indices[1] = VBIndex + 3;
-    indices[2] = VBIndex + 1;
-    indices[3] = VBIndex + 0;
-    indices[4] = VBIndex + 1;
-    indices[5] = VBIndex + 2;
-    indices[6] = VBIndex + 0;
-    indices[7] = VBIndex + 2;
-    indices[8] = VBIndex + 4;
-    IB.Write(indices, sizeof(indices));
+    indices[0] = State->VBIndex + 0;
+    indices[1] = State->VBIndex + 3;
+    indices[2] = State->VBIndex + 1;
+    indices[3] = State->VBIndex + 0;
+    indices[4] = State->VBIndex + 1;
+    indices[5] = State->VBIndex + 2;
+    indices[6] = State->VBIndex + 0;
+    indices[7] = State->VBIndex + 2;
+    indices[8] = State->VBIndex + 4;
+    State->IB.Write(indices, sizeof(indices));
 
-    VBIndex += 5;
-    IBIndex += 9;
+    State->VBIndex += 5;
+    State->IBIndex += 9;
 }
 
 #endif
@@ -1747,12 +2141,12 @@ void DrawLineCap(const Float2& capOrigin, const Float2& capDirection, const Floa
 void DrawLines(const Float2* points, int32 pointsCount, const Color& color1, const Color& color2, float thickness)
 {
     ASSERT(points && pointsCount >= 2);
-    const auto& mask = ClipLayersStack.Peek().Mask;
+    const auto& mask = State->ClipLayersStack.Peek().Mask;
 
-    thickness *= (TransformCached.M11 + TransformCached.M22 + TransformCached.M33) * 0.3333333f;
+    thickness *= (State->TransformCached.M11 + State->TransformCached.M22 + State->TransformCached.M33) * 0.3333333f;
 
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
-    drawCall.StartIB = IBIndex;
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
+    drawCall.StartIB = State->IBIndex;
 
     Render2DVertex v[4];
     uint32 indices[6];
@@ -1796,18 +2190,18 @@ void DrawLines(const Float2* points, int32 pointsCount, const Color& color1, con
         v[1] = MakeVertex(p1t + up, Float2::UnitX, color1, mask, { thickness, (float)Render2D::Features });
         v[2] = MakeVertex(p1t - up, Float2::Zero, color1, mask, { thickness, (float)Render2D::Features });
         v[3] = MakeVertex(p2t - up, Float2::Zero, color2, mask, { thickness, (float)Render2D::Features });
-        VB.Write(v, sizeof(Render2DVertex) * 4);
-
-        indices[0] = VBIndex + 0;
-        indices[1] = VBIndex + 1;
-        indices[2] = VBIndex + 2;
-        indices[3] = VBIndex + 2;
-        indices[4] = VBIndex + 3;
-        indices[5] = VBIndex + 0;
-        IB.Write(indices, sizeof(uint32) * 6);
-
-        VBIndex += 4;
-        IBIndex += 6;
+        State->VB.Write(v, sizeof(Render2DVertex) * 4);
+
+        indices[0] = State->VBIndex + 0;
+        indices[1] = State->VBIndex + 1;
+        indices[2] = State->VBIndex + 2;
+        indices[3] = State->VBIndex + 2;
+        indices[4] = State->VBIndex + 3;
+        indices[5] = State->VBIndex + 0;
+        State->IB.Write(indices, sizeof(uint32) * 6);
+
+        State->VBIndex += 4;
+        State->IBIndex += 6;
         drawCall.CountIB += 6;
 
         p1t = p2t;
@@ -1841,18 +2235,18 @@ void DrawLines(const Float2* points, int32 pointsCount, const Color& color1, con
         v[1] = MakeVertex(p1t + thicknessHalf * normal - direction, Float2::Zero, color1, mask, { 0.0f, (float)Render2D::Features });
         v[2] = MakeVertex(p1t - thicknessHalf * normal - direction, Float2::Zero, color1, mask, { 0.0f, (float)Render2D::Features });
         v[3] = MakeVertex(p2t - thicknessHalf * normal + direction, Float2::Zero, color2, mask, { 0.0f, (float)Render2D::Features });
-        VB.Write(v, sizeof(Render2DVertex) * 4);
-
-        indices[0] = VBIndex + 0;
-        indices[1] = VBIndex + 1;
-        indices[2] = VBIndex + 2;
-        indices[3] = VBIndex + 2;
-        indices[4] = VBIndex + 3;
-        indices[5] = VBIndex + 0;
-        IB.Write(indices, sizeof(uint32) * 6);
-
-        VBIndex += 4;
-        IBIndex += 6;
+        State->VB.Write(v, sizeof(Render2DVertex) * 4);
+
+        indices[0] = State->VBIndex + 0;
+        indices[1] = State->VBIndex + 1;
+        indices[2] = State->VBIndex + 2;
+        indices[3] = State->VBIndex + 2;
+        indices[4] = State->VBIndex + 3;
+        indices[5] = State->VBIndex + 0;
+        State->IB.Write(indices, sizeof(uint32) * 6);
+
+        State->VBIndex += 4;
+        State->IBIndex += 6;
         drawCall.CountIB += 6;
 
         p1t = p2t;
@@ -1886,15 +2280,15 @@ void Render2D::DrawBezier(const Float2& p1, const Float2& p2, const Float2& p3,
     // Draw segmented curve
     Float2 p;
     AnimationUtils::Bezier(p1, p2, p3, p4, 0, p);
-    Lines2.Clear();
-    Lines2.Add(p);
+    State->Lines2.Clear();
+    State->Lines2.Add(p);
     for (int32 i = 1; i <= segmentCount; i++)
     {
         const float t = i * segmentCountInv;
         AnimationUtils::Bezier(p1, p2, p3, p4, t, p);
-        Lines2.Add(p);
+        State->Lines2.Add(p);
     }
-    DrawLines(Lines2.Get(), Lines2.Count(), color, color, thickness);
+    DrawLines(State->Lines2.Get(), State->Lines2.Count(), color, color, thickness);
 }
 
 void Render2D::DrawMaterial(MaterialBase* material, const Rectangle& rect, const Color& color)
@@ -1903,9 +2297,9 @@ void Render2D::DrawMaterial(MaterialBase* material, const Rectangle& rect, const
     if (material == nullptr || !material->IsReady() || !material->IsGUI())
         return;
 
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = DrawCallType::Material;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 6;
     drawCall.AsMaterial.Mat = material;
     drawCall.AsMaterial.Width = rect.GetWidth();
@@ -1918,9 +2312,9 @@ void Render2D::DrawBlur(const Rectangle& rect, float blurStrength)
     RENDER2D_CHECK_RENDERING_STATE;
 
     Float2 p;
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = DrawCallType::Blur;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 6;
     drawCall.AsBlur.Strength = blurStrength;
     drawCall.AsBlur.Width = rect.GetWidth();
@@ -1939,9 +2333,9 @@ void Render2D::DrawTexturedTriangles(GPUTexture* t, const Span<Float2>& vertices
     RENDER2D_CHECK_RENDERING_STATE;
     CHECK(vertices.Length() == uvs.Length());
 
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = DrawCallType::FillTexture;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = vertices.Length();
     drawCall.AsTexture.Ptr = t;
 
@@ -1962,9 +2356,9 @@ void Render2D::DrawTexturedTriangles(GPUTexture* t, const Span<Float2>& vertices
     CHECK(vertices.Length() == uvs.Length());
     CHECK(vertices.Length() == colors.Length());
 
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = DrawCallType::FillTexture;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = vertices.Length();
     drawCall.AsTexture.Ptr = t;
 
@@ -1978,9 +2372,9 @@ void Render2D::DrawTexturedTriangles(GPUTexture* t, const Span<uint16>& indices,
     CHECK(vertices.Length() == uvs.Length());
     CHECK(vertices.Length() == colors.Length());
 
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = DrawCallType::FillTexture;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = indices.Length();
     drawCall.AsTexture.Ptr = t;
 
@@ -1998,9 +2392,9 @@ void Render2D::FillTriangles(const Span<Float2>& vertices, const Span<Color>& co
     CHECK(vertices.Length() == colors.Length());
     RENDER2D_CHECK_RENDERING_STATE;
 
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = useAlpha ? DrawCallType::FillRect : DrawCallType::FillRectNoAlpha;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = vertices.Length();
 
     for (int32 i = 0; i < vertices.Length(); i += 3)
@@ -2011,9 +2405,9 @@ void Render2D::FillTriangle(const Float2& p0, const Float2& p1, const Float2& p2
 {
     RENDER2D_CHECK_RENDERING_STATE;
 
-    Render2DDrawCall& drawCall = DrawCalls.AddOne();
+    Render2DDrawCall& drawCall = State->DrawCalls.AddOne();
     drawCall.Type = NeedAlphaWithTint(color) ? DrawCallType::FillRect : DrawCallType::FillRectNoAlpha;
-    drawCall.StartIB = IBIndex;
+    drawCall.StartIB = State->IBIndex;
     drawCall.CountIB = 3;
     WriteTri(p0, p1, p2, color, color, color);
 }
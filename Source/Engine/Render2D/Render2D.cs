@@ -205,5 +205,27 @@ public static void CallDrawing(IDrawable drawableElement, GPUContext context, GP
                 End();
             }
         }
+
+        /// <summary>
+        /// Calls drawing GUI into the command list that can be submitted later with <see cref="Submit"/>. Can be called from any thread (eg. to build independent UI in parallel jobs).
+        /// </summary>
+        /// <param name="drawableElement">The root container for Draw methods.</param>
+        /// <param name="list">The command list to record into.</param>
+        /// <param name="bounds">The default clipping bounds (eg. the viewport area of the destination).</param>
+        public static void CallRecording(IDrawable drawableElement, Render2DCommandList list, Rectangle bounds)
+        {
+            if (list == null || drawableElement == null)
+                throw new ArgumentNullException();
+
+            BeginRecording(list, ref bounds);
+            try
+            {
+                drawableElement.Draw();
+            }
+            finally
+            {
+                EndRecording();
+            }
+        }
     }
 }
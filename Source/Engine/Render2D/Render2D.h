@@ -22,6 +22,8 @@ class GPUContext;
 class RenderTask;
 class MaterialBase;
 class TextureBase;
+class Render2DCache;
+class Render2DCommandList;
 
 /// <summary>
 /// Rendering 2D shapes and text using Graphics Device.
@@ -49,6 +51,16 @@ API_CLASS(Static) class FLAXENGINE_API Render2D
         /// Enables automatic characters usage from fallback fonts.
         /// </summary>
         FallbackFonts = 2,
+
+        /// <summary>
+        /// Enables reordering of the non-overlapping draw calls to merge more of them into a single batch (eg. interleaved images and text of the list items). Disabled by default.
+        /// </summary>
+        DrawCallsReordering = 4,
+
+        /// <summary>
+        /// Enables batching of the images that use different textures (accessed by the index in shader). Used only if graphics device supports bindless resources (see GPULimits.HasBindlessResources). Disabled by default.
+        /// </summary>
+        BindlessTextures = 8,
     };
 
     struct CustomData
@@ -59,7 +71,7 @@ API_CLASS(Static) class FLAXENGINE_API Render2D
 
 public:
     /// <summary>
-    /// Checks if interface is during rendering phrase (Draw calls may be performed without failing).
+    /// Checks if interface is during rendering phrase or recording of the command list on the calling thread (Draw calls may be performed without failing).
     /// </summary>
     static bool IsRendering();
 
@@ -178,6 +190,43 @@ API_CLASS(Static) class FLAXENGINE_API Render2D
     API_FUNCTION() static void PopTint();
 
 public:
+    /// <summary>
+    /// Begins recording the geometry into the retained cache. All the drawing until EndCache is captured (and drawn as usual). Recordings can be nested.
+    /// </summary>
+    /// <param name="cache">The geometry cache to record into (previous contents are replaced).</param>
+    API_FUNCTION() static void BeginCache(Render2DCache* cache);
+
+    /// <summary>
+    /// Ends recording the geometry into the retained cache started with BeginCache.
+    /// </summary>
+    API_FUNCTION() static void EndCache();
+
+    /// <summary>
+    /// Draws the geometry recorded in the retained cache without generating it again.
+    /// </summary>
+    /// <param name="cache">The geometry cache.</param>
+    /// <returns>True if cache cannot be used (eg. it's invalid or was recorded with different transformation, clipping or tint) and the content has to be drawn (and recorded) again, otherwise false.</returns>
+    API_FUNCTION() static bool DrawCache(Render2DCache* cache);
+
+public:
+    /// <summary>
+    /// Begins recording the drawing commands into the command list on the calling thread (can be used from any thread, eg. to build UI in a job). All the drawing performed on this thread until EndRecording is captured into the list (without rendering it). Transformation, clipping and tint stacks start from the default state for the recording.
+    /// </summary>
+    /// <param name="list">The command list to record into (previous contents are replaced).</param>
+    /// <param name="bounds">The default clipping bounds (eg. the viewport area of the destination).</param>
+    API_FUNCTION() static void BeginRecording(Render2DCommandList* list, API_PARAM(Ref) const Rectangle& bounds);
+
+    /// <summary>
+    /// Ends recording the drawing commands into the command list started with BeginRecording on the calling thread.
+    /// </summary>
+    API_FUNCTION() static void EndRecording();
+
+    /// <summary>
+    /// Submits the commands recorded into the command list for drawing. Recorded geometry is used as-is (current transformation, clipping and tint don't apply). Can be called multiple times for the same list.
+    /// </summary>
+    /// <param name="list">The command list (recording has to be ended).</param>
+    API_FUNCTION() static void Submit(Render2DCommandList* list);
+
     /// <summary>
     /// Draws a text.
     /// </summary>
@@ -0,0 +1,51 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Math/Color.h"
+#include "Engine/Core/Math/Matrix3x3.h"
+#include "Engine/Core/Math/Rectangle.h"
+#include "Engine/Scripting/ScriptingObject.h"
+
+/// <summary>
+/// The retained 2D geometry recorded with Render2D.BeginCache/EndCache that can be drawn again with Render2D.DrawCache without generating it (eg. for static UI that doesn't change every frame). Cache is valid only for the same transformation, clipping and tint as during recording and it has to be invalidated by the owner when the drawn content changes (including the used textures and materials).
+/// </summary>
+API_CLASS(Sealed) class FLAXENGINE_API Render2DCache : public ScriptingObject
+{
+    DECLARE_SCRIPTING_TYPE(Render2DCache);
+    friend class Render2D;
+
+private:
+    bool _isValid = false;
+    int32 _vertexCount = 0;
+    uint32 _fontsVersion = 0;
+    float _fontScale = 1.0f;
+    int32 _features = 0;
+    bool _scissors = false;
+    Matrix3x3 _transform;
+    Rectangle _clip;
+    Color _tint;
+    Array<byte> _vertices;
+    Array<uint32> _indices;
+    Array<byte> _drawCalls;
+
+public:
+    /// <summary>
+    /// Gets a value indicating whether the cache contains the recorded geometry.
+    /// </summary>
+    API_PROPERTY() FORCE_INLINE bool IsValid() const
+    {
+        return _isValid;
+    }
+
+    /// <summary>
+    /// Gets the amount of memory used by the cached geometry (in bytes).
+    /// </summary>
+    API_PROPERTY() int32 GetMemoryUsage() const;
+
+    /// <summary>
+    /// Invalidates the cached geometry so it will be recorded again on the next draw.
+    /// </summary>
+    API_FUNCTION() void Invalidate();
+};
@@ -0,0 +1,46 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Scripting/ScriptingObject.h"
+
+struct Render2DRecordingState;
+
+/// <summary>
+/// The list of 2D drawing commands recorded with Render2D.BeginRecording/EndRecording and submitted later with Render2D.Submit during rendering. Recording can be performed on any thread (each thread records into its own list) which allows to build the independent UI (eg. multiple canvases) in parallel jobs and then draw them in order on the rendering thread.
+/// </summary>
+API_CLASS(Sealed) class FLAXENGINE_API Render2DCommandList : public ScriptingObject
+{
+    DECLARE_SCRIPTING_TYPE(Render2DCommandList);
+    friend class Render2D;
+
+private:
+    Render2DRecordingState* _state;
+
+public:
+    /// <summary>
+    /// Finalizes an instance of the <see cref="Render2DCommandList"/> class.
+    /// </summary>
+    ~Render2DCommandList();
+
+public:
+    /// <summary>
+    /// Gets a value indicating whether the list is during recording.
+    /// </summary>
+    API_PROPERTY() bool IsRecording() const;
+
+    /// <summary>
+    /// Gets a value indicating whether the list contains no recorded commands.
+    /// </summary>
+    API_PROPERTY() bool IsEmpty() const;
+
+    /// <summary>
+    /// Gets the amount of memory used by the recorded commands (in bytes).
+    /// </summary>
+    API_PROPERTY() int32 GetMemoryUsage() const;
+
+    /// <summary>
+    /// Clears the recorded commands.
+    /// </summary>
+    API_FUNCTION() void Clear();
+};
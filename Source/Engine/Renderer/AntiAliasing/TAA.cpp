@@ -19,6 +19,10 @@ PACK_STRUCT(struct Data
     float StationaryBlending;
     float MotionBlending;
     float Dummy0;
+    Float2 InputSize;
+    Float2 InputSizeInv;
+    Float2 JitterUV;
+    Float2 Dummy1;
     GBufferData GBuffer;
     });
 
@@ -45,6 +49,8 @@ bool TAA::setupResources()
     }
     if (!_psTAA)
         _psTAA = GPUDevice::Instance->CreatePipelineState();
+    if (!_psUpscale)
+        _psUpscale = GPUDevice::Instance->CreatePipelineState();
     GPUPipelineState::Description psDesc;
     if (!_psTAA->IsValid())
     {
@@ -53,6 +59,13 @@ bool TAA::setupResources()
         if (_psTAA->Init(psDesc))
             return true;
     }
+    if (!_psUpscale->IsValid())
+    {
+        psDesc = GPUPipelineState::Description::DefaultFullscreenTriangle;
+        psDesc.PS = shader->GetPS("PS_Upscale");
+        if (_psUpscale->Init(psDesc))
+            return true;
+    }
     return false;
 }
 
@@ -62,18 +75,22 @@ void TAA::Dispose()
     RendererPass::Dispose();
 
     SAFE_DELETE_GPU_RESOURCE(_psTAA);
+    SAFE_DELETE_GPU_RESOURCE(_psUpscale);
     _shader = nullptr;
 }
 
-void TAA::Render(const RenderContext& renderContext, GPUTexture* input, GPUTextureView* output)
+void TAA::Render(const RenderContext& renderContext, GPUTexture* input, GPUTexture* output)
 {
     auto context = GPUDevice::Instance->GetMainContext();
+    const bool upscale = output->Width() != input->Width() || output->Height() != input->Height();
 
     // Ensure to have valid data
     if (checkIfSkipPass())
     {
         // Resources are missing. Do not perform rendering, just copy source frame.
-        context->SetRenderTarget(output);
+        context->SetRenderTarget(output->View());
+        if (upscale)
+            context->SetViewportAndScissors((float)output->Width(), (float)output->Height());
         context->Draw(input);
         return;
     }
@@ -81,10 +98,10 @@ void TAA::Render(const RenderContext& renderContext, GPUTexture* input, GPUTextu
 
     PROFILE_GPU_CPU("Temporal Antialiasing");
 
-    // Get history buffers
+    // Get history buffers (at output resolution)
     bool resetHistory = renderContext.Task->IsCameraCut;
     renderContext.Buffers->LastFrameTemporalAA = Engine::FrameCount;
-    const auto tempDesc = GPUTextureDescription::New2D(input->Width(), input->Height(), input->Format());
+    const auto tempDesc = GPUTextureDescription::New2D(output->Width(), output->Height(), input->Format());
     if (renderContext.Buffers->TemporalAA == nullptr)
     {
         // Missing temporal buffer
@@ -112,6 +129,8 @@ void TAA::Render(const RenderContext& renderContext, GPUTexture* input, GPUTextu
         context->CopyTexture(inputHistory, 0, 0, 0, 0, input, 0);
 #else
         context->SetRenderTarget(inputHistory->View());
+        if (upscale)
+            context->SetViewportAndScissors((float)tempDesc.Width, (float)tempDesc.Height);
         context->Draw(input);
         context->ResetRenderTarget();
 #endif
@@ -122,11 +141,16 @@ void TAA::Render(const RenderContext& renderContext, GPUTexture* input, GPUTextu
     Data data;
     data.ScreenSizeInv.X = renderContext.View.ScreenSize.Z;
     data.ScreenSizeInv.Y = renderContext.View.ScreenSize.W;
-    data.JitterInv.X = renderContext.View.TemporalAAJitter.X / (float)tempDesc.Width;
-    data.JitterInv.Y = renderContext.View.TemporalAAJitter.Y / (float)tempDesc.Height;
+    data.JitterInv.X = renderContext.View.TemporalAAJitter.X / (float)input->Width();
+    data.JitterInv.Y = renderContext.View.TemporalAAJitter.Y / (float)input->Height();
     data.Sharpness = settings.TAA_Sharpness;
     data.StationaryBlending = settings.TAA_StationaryBlending * blendStrength;
     data.MotionBlending = settings.TAA_MotionBlending * blendStrength;
+    data.Dummy0 = 0.0f;
+    data.InputSize = Float2((float)input->Width(), (float)input->Height());
+    data.InputSizeInv = Float2::One / data.InputSize;
+    data.JitterUV = Float2(renderContext.View.TemporalAAJitter.X * 0.5f, renderContext.View.TemporalAAJitter.Y * -0.5f); // Jitter offset in the screen-space UVs (clip-space Y is flipped)
+    data.Dummy1 = Float2::Zero;
     GBufferPass::SetInputs(renderContext.View, data.GBuffer);
     const auto cb = _shader->GetShader()->GetCB(0);
     context->UpdateCB(cb, &data);
@@ -137,8 +161,10 @@ void TAA::Render(const RenderContext& renderContext, GPUTexture* input, GPUTextu
     context->BindSR(3, renderContext.Buffers->DepthBuffer);
 
     // Render
-    context->SetRenderTarget(output);
-    context->SetState(_psTAA);
+    context->SetRenderTarget(output->View());
+    if (upscale)
+        context->SetViewportAndScissors((float)output->Width(), (float)output->Height());
+    context->SetState(upscale ? _psUpscale : _psTAA);
     context->DrawFullscreenTriangle();
 
     // Update the history
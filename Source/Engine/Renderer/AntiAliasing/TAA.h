@@ -13,16 +13,17 @@ class TAA : public RendererPass<TAA>
 private:
 
     AssetReference<Shader> _shader;
-    GPUPipelineState* _psTAA;
+    GPUPipelineState* _psTAA = nullptr;
+    GPUPipelineState* _psUpscale = nullptr;
 
 public:
     /// <summary>
-    /// Performs AA pass rendering for the input task.
+    /// Performs AA pass rendering for the input task. If output is larger than input then the frame is temporally up-scaled (reconstructed from the jittered frames at rendering resolution accumulated in the history at output resolution).
     /// </summary>
     /// <param name="renderContext">The rendering context.</param>
     /// <param name="input">The input render target.</param>
     /// <param name="output">The output render target.</param>
-    void Render(const RenderContext& renderContext, GPUTexture* input, GPUTextureView* output);
+    void Render(const RenderContext& renderContext, GPUTexture* input, GPUTexture* output);
 
 private:
 
@@ -31,6 +32,8 @@ class TAA : public RendererPass<TAA>
     {
         if (_psTAA)
             _psTAA->ReleaseGPU();
+        if (_psUpscale)
+            _psUpscale->ReleaseGPU();
         invalidateResources();
     }
 #endif
@@ -204,6 +204,8 @@ struct DrawCall
             float CurrentLOD;
             float ChunkSizeNextLOD;
             float TerrainChunkSizeLOD0;
+            Float4 VirtualTextureUV; // xy-scale, zw-offset for chunk UVs into the terrain virtual texture atlas (zero if not used).
+            float VirtualTextureTexel; // Half-texel size of the virtual texture tile (in chunk UVs).
             const class TerrainPatch* Patch;
         } Terrain;
 
@@ -49,7 +49,7 @@ void LODPreviewMaterialShader::Bind(BindParameters& params)
     int32 lodIndex = 0;
     auto& drawCall = *params.FirstDrawCall;
     const ModelLOD* drawCallModelLod;
-    if (GBufferPass::IndexBufferToModelLOD.TryGet(drawCall.Geometry.IndexBuffer, drawCallModelLod))
+    if (GBufferPass::IndexBufferToModelLOD.TryGet(ToPair(drawCall.Geometry.IndexBuffer, drawCall.Draw.StartIndex), drawCallModelLod))
     {
         lodIndex = drawCallModelLod->GetLODIndex();
     }
@@ -166,7 +166,7 @@ void LightmapUVsDensityMaterialShader::Bind(BindParameters& params)
         data.LightmapSize = 1024.0f;
         data.LightmapArea = drawCall.Surface.LightmapUVsArea;
         const ModelLOD* drawCallModelLod;
-        if (GBufferPass::IndexBufferToModelLOD.TryGet(drawCall.Geometry.IndexBuffer, drawCallModelLod))
+        if (GBufferPass::IndexBufferToModelLOD.TryGet(ToPair(drawCall.Geometry.IndexBuffer, drawCall.Draw.StartIndex), drawCallModelLod))
         {
             // Calculate current lightmap slot size for the object (matches the ShadowsOfMordor calculations when baking the lighting)
             float globalObjectsScale = 1.0f;
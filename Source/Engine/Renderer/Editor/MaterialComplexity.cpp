@@ -17,6 +17,7 @@
 #include "Engine/Graphics/RenderBuffers.h"
 #include "Engine/Renderer/DrawCall.h"
 #include "Engine/Renderer/RenderList.h"
+#include "Engine/Renderer/GBufferPass.h"
 #include "Engine/Renderer/Lightmaps.h"
 
 const MaterialInfo& MaterialComplexityMaterialShader::WrapperShader::GetInfo() const
@@ -121,9 +122,9 @@ void MaterialComplexityMaterialShader::Draw(RenderContext& renderContext, GPUCon
 {
     // Draw decals into Light buffer to include them into complexity drawing
     auto& decals = renderContext.List->Decals;
-    auto boxModel = Content::LoadAsyncInternal<Model>(TEXT("Engine/Models/SimpleBox"));
     auto& decalsWrapper = _wrappers[4];
-    if (decals.HasItems() && boxModel && boxModel->CanBeRendered() && decalsWrapper.IsReady())
+    Array<Matrix, RendererAllocation> decalsWorlds;
+    if (decals.HasItems() && decalsWrapper.IsReady() && !GBufferPass::Instance()->PrepareDecals(renderContext, context, decalsWorlds))
     {
         PROFILE_GPU_CPU_NAMED("Decals");
         DrawCall drawCall;
@@ -134,15 +135,12 @@ void MaterialComplexityMaterialShader::Draw(RenderContext& renderContext, GPUCon
         for (int32 i = 0; i < decals.Count(); i++)
         {
             const auto decal = decals[i];
-            ASSERT(decal && decal->Material);
-            Transform transform = decal->GetTransform();
-            transform.Scale *= decal->GetSize();
-            renderContext.View.GetWorldMatrix(transform, drawCall.World);
+            drawCall.World = decalsWorlds[i];
             drawCall.ObjectPosition = drawCall.World.GetTranslation();
             drawCall.Material = decal->Material;
             drawCall.PerInstanceRandom = decal->GetPerInstanceRandom();
             decalsWrapper.Bind(bindParams);
-            boxModel->Render(context);
+            GBufferPass::Instance()->DrawDecalsInstances(context, i, 1);
         }
         context->ResetSR();
     }
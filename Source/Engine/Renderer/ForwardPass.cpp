@@ -2,6 +2,7 @@
 
 #include "ForwardPass.h"
 #include "RenderList.h"
+#include "VariableRateShadingPass.h"
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Content/Assets/Model.h"
 #include "Engine/Content/Assets/Shader.h"
@@ -138,6 +139,8 @@ void ForwardPass::Render(RenderContext& renderContext, GPUTexture* input, GPUTex
         // Run forward pass
         view.Pass = DrawPass::Forward;
         context->SetRenderTarget(depthBufferHandle, output->View());
+        context->SetShadingRate(VariableRateShadingPass::Instance()->Get(renderContext));
         mainCache->ExecuteDrawCalls(renderContext, forwardList, input->View());
+        context->SetShadingRate(nullptr);
     }
 }
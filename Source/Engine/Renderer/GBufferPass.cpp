@@ -2,6 +2,7 @@
 
 #include "GBufferPass.h"
 #include "RenderList.h"
+#include "VariableRateShadingPass.h"
 #if USE_EDITOR
 #include "Engine/Renderer/Editor/VertexColors.h"
 #include "Engine/Renderer/Editor/LightmapUVsDensity.h"
@@ -11,6 +12,7 @@
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/DynamicBuffer.h"
 #include "Engine/Graphics/Shaders/GPUShader.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/RenderBuffers.h"
@@ -18,6 +20,7 @@
 #include "Engine/Content/Assets/Shader.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Content/Assets/Model.h"
+#include "Engine/Core/Math/OrientedBoundingBox.h"
 #include "Engine/Level/Actors/Decal.h"
 #include "Engine/Engine/Engine.h"
 
@@ -27,8 +30,14 @@ PACK_STRUCT(struct GBufferPassData{
     int32 ViewMode;
     });
 
+PACK_STRUCT(struct DecalInstanceData {
+    Float4 World[3];
+    Float4 InvWorld[3];
+    float PerInstanceRandom;
+    });
+
 #if USE_EDITOR
-Dictionary<GPUBuffer*, const ModelLOD*> GBufferPass::IndexBufferToModelLOD;
+Dictionary<Pair<GPUBuffer*, int32>, const ModelLOD*> GBufferPass::IndexBufferToModelLOD;
 CriticalSection GBufferPass::Locker;
 #endif
 
@@ -97,6 +106,7 @@ void GBufferPass::Dispose()
     _gBufferShader = nullptr;
     _skyModel = nullptr;
     _boxModel = nullptr;
+    SAFE_DELETE(_decalsInstances);
 #if USE_EDITOR
     SAFE_DELETE(_lightmapUVsDensity);
     SAFE_DELETE(_vertexColors);
@@ -204,6 +214,7 @@ void GBufferPass::Fill(RenderContext& renderContext, GPUTexture* lightBuffer)
 #endif
 
     // Draw objects that can get decals
+    context->SetShadingRate(VariableRateShadingPass::Instance()->Get(renderContext));
     context->SetRenderTarget(*renderContext.Buffers->DepthBuffer, ToSpan(targetBuffers, ARRAY_COUNT(targetBuffers)));
     renderContext.List->ExecuteDrawCalls(renderContext, DrawCallsListType::GBuffer);
 
@@ -213,6 +224,7 @@ void GBufferPass::Fill(RenderContext& renderContext, GPUTexture* lightBuffer)
     // Draw objects that cannot get decals
     context->SetRenderTarget(*renderContext.Buffers->DepthBuffer, ToSpan(targetBuffers, ARRAY_COUNT(targetBuffers)));
     renderContext.List->ExecuteDrawCalls(renderContext, DrawCallsListType::GBufferNoDecals);
+    context->SetShadingRate(nullptr);
 
     GPUTexture* nullTexture = nullptr;
     renderContext.List->RunCustomPostFxPass(context, renderContext, PostProcessEffectLocation::AfterGBufferPass, lightBuffer, nullTexture);
@@ -230,7 +242,10 @@ void GBufferPass::Fill(RenderContext& renderContext, GPUTexture* lightBuffer)
 
 bool SortDecal(Decal* const& a, Decal* const& b)
 {
-    return a->SortOrder < b->SortOrder;
+    // Keep decals using the same material next to each other (within the same order) to batch them
+    if (a->SortOrder != b->SortOrder)
+        return a->SortOrder < b->SortOrder;
+    return a->Material.Get() < b->Material.Get();
 }
 
 void GBufferPass::RenderDebug(RenderContext& renderContext)
@@ -426,11 +441,63 @@ void GBufferPass::DrawSky(RenderContext& renderContext, GPUContext* context)
     model->Render(context);
 }
 
+bool GBufferPass::PrepareDecals(RenderContext& renderContext, GPUContext* context, Array<Matrix, RendererAllocation>& worlds)
+{
+    auto& decals = renderContext.List->Decals;
+    if (_boxModel == nullptr || !_boxModel->CanBeRendered())
+        return true;
+
+    // Sort decals from the lowest order to the highest order
+    Sorting::QuickSort(decals.Get(), (int32)decals.Count(), &SortDecal);
+
+    // Upload decals instances data
+    if (!_decalsInstances)
+        _decalsInstances = New<DynamicVertexBuffer>(0u, (uint32)sizeof(DecalInstanceData), TEXT("GBuffer.DecalsInstances"));
+    _decalsInstances->Clear();
+    auto instances = _decalsInstances->WriteReserve<DecalInstanceData>(decals.Count());
+    worlds.Resize(decals.Count());
+    for (int32 i = 0; i < decals.Count(); i++)
+    {
+        const auto decal = decals[i];
+        ASSERT(decal && decal->Material);
+        Transform transform = decal->GetTransform();
+        transform.Scale *= decal->GetSize();
+        Matrix& world = worlds[i];
+        renderContext.View.GetWorldMatrix(transform, world);
+        Matrix invWorld;
+        Matrix::Invert(world, invWorld);
+        auto& instance = instances[i];
+        instance.World[0] = Float4(world.M11, world.M21, world.M31, world.M41);
+        instance.World[1] = Float4(world.M12, world.M22, world.M32, world.M42);
+        instance.World[2] = Float4(world.M13, world.M23, world.M33, world.M43);
+        instance.InvWorld[0] = Float4(invWorld.M11, invWorld.M21, invWorld.M31, invWorld.M41);
+        instance.InvWorld[1] = Float4(invWorld.M12, invWorld.M22, invWorld.M32, invWorld.M42);
+        instance.InvWorld[2] = Float4(invWorld.M13, invWorld.M23, invWorld.M33, invWorld.M43);
+        instance.PerInstanceRandom = decal->GetPerInstanceRandom();
+    }
+    _decalsInstances->Flush(context);
+    return false;
+}
+
+void GBufferPass::DrawDecalsInstances(GPUContext* context, int32 startInstance, int32 instanceCount)
+{
+    DrawCall drawCall;
+    for (const Mesh& mesh : _boxModel->LODs[0].Meshes)
+    {
+        mesh.GetDrawCallGeometry(drawCall);
+        GPUBuffer* vb[4] = { drawCall.Geometry.VertexBuffers[0], drawCall.Geometry.VertexBuffers[1], drawCall.Geometry.VertexBuffers[2], _decalsInstances->GetBuffer() };
+        const uint32 vbOffsets[4] = { drawCall.Geometry.VertexBuffersOffsets[0], drawCall.Geometry.VertexBuffersOffsets[1], drawCall.Geometry.VertexBuffersOffsets[2], 0 };
+        context->BindVB(ToSpan(vb, 4), vbOffsets);
+        context->BindIB(drawCall.Geometry.IndexBuffer);
+        context->DrawIndexedInstanced(drawCall.Draw.IndicesCount, instanceCount, startInstance, 0, drawCall.Draw.StartIndex);
+    }
+}
+
 void GBufferPass::DrawDecals(RenderContext& renderContext, GPUTextureView* lightBuffer)
 {
     // Skip if no decals to render
     auto& decals = renderContext.List->Decals;
-    if (decals.IsEmpty() || _boxModel == nullptr || !_boxModel->CanBeRendered() || EnumHasNoneFlags(renderContext.View.Flags, ViewFlags::Decals))
+    if (decals.IsEmpty() || EnumHasNoneFlags(renderContext.View.Flags, ViewFlags::Decals))
         return;
 
     PROFILE_GPU_CPU("Decals");
@@ -438,16 +505,19 @@ void GBufferPass::DrawDecals(RenderContext& renderContext, GPUTextureView* light
     // Cache data
     auto device = GPUDevice::Instance;
     auto context = device->GetMainContext();
-    auto model = _boxModel.Get();
     auto buffers = renderContext.Buffers;
-
-    // Sort decals from the lowest order to the highest order
-    Sorting::QuickSort(decals.Get(), (int32)decals.Count(), &SortDecal);
-
-    // TODO: batch decals using the same material
+    Array<Matrix, RendererAllocation> worlds;
+    if (PrepareDecals(renderContext, context, worlds))
+        return;
 
     // TODO: sort decals by the blending mode within the same order
 
+    // Decals with the camera inside their volume use a different culling mode so they cannot be batched with the other ones
+    Array<bool, RendererAllocation> cameraInside;
+    cameraInside.Resize(decals.Count());
+    for (int32 i = 0; i < decals.Count(); i++)
+        cameraInside[i] = OrientedBoundingBox(Vector3::Half, worlds[i]).Contains(renderContext.View.Position) == ContainmentType::Contains;
+
     // Prepare
     DrawCall drawCall;
     MaterialBase::BindParameters bindParams(context, renderContext, drawCall);
@@ -455,21 +525,23 @@ void GBufferPass::DrawDecals(RenderContext& renderContext, GPUTextureView* light
     drawCall.Material = nullptr;
     drawCall.WorldDeterminantSign = 1.0f;
 
-    // Draw all decals
-    for (int32 i = 0; i < decals.Count(); i++)
+    // Draw all decals (consecutive decals with the same material and culling mode are drawn in a single instanced batch)
+    for (int32 i = 0; i < decals.Count();)
     {
         const auto decal = decals[i];
-        ASSERT(decal && decal->Material);
-        Transform transform = decal->GetTransform();
-        transform.Scale *= decal->GetSize();
-        renderContext.View.GetWorldMatrix(transform, drawCall.World);
+        MaterialBase* material = decal->Material.Get();
+        int32 batchSize = 1;
+        while (i + batchSize < decals.Count() && decals[i + batchSize]->Material.Get() == material && cameraInside[i + batchSize] == cameraInside[i])
+            batchSize++;
+        drawCall.World = worlds[i];
         drawCall.ObjectPosition = drawCall.World.GetTranslation();
         drawCall.ObjectRadius = decal->GetSphere().Radius;
+        drawCall.PerInstanceRandom = decal->GetPerInstanceRandom();
 
         context->ResetRenderTarget();
 
         // Bind output
-        const MaterialInfo& info = decal->Material->GetInfo();
+        const MaterialInfo& info = material->GetInfo();
         switch (info.DecalBlendingMode)
         {
         case MaterialDecalBlendingMode::Translucent:
@@ -514,10 +586,11 @@ void GBufferPass::DrawDecals(RenderContext& renderContext, GPUTextureView* light
         }
         }
 
-        // Draw decal
-        drawCall.PerInstanceRandom = decal->GetPerInstanceRandom();
-        decal->Material->Bind(bindParams);
-        model->Render(context);
+        // Draw decals batch
+        bindParams.DrawCallsCount = batchSize;
+        material->Bind(bindParams);
+        DrawDecalsInstances(context, i, batchSize);
+        i += batchSize;
     }
 
     context->ResetSR();
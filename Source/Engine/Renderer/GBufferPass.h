@@ -3,8 +3,10 @@
 #pragma once
 
 #include "RendererPass.h"
+#include "RendererAllocation.h"
 #if USE_EDITOR
 #include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Types/Pair.h"
 #endif
 
 /// <summary>
@@ -18,6 +20,7 @@ class GBufferPass : public RendererPass<GBufferPass>
     GPUPipelineState* _psDebug = nullptr;
     AssetReference<Model> _skyModel;
     AssetReference<Model> _boxModel;
+    class DynamicVertexBuffer* _decalsInstances = nullptr;
 #if USE_EDITOR
     class LightmapUVsDensityMaterialShader* _lightmapUVsDensity = nullptr;
     class VertexColorsMaterialShader* _vertexColors = nullptr;
@@ -50,13 +53,13 @@ class GBufferPass : public RendererPass<GBufferPass>
 
 #if USE_EDITOR
     // Temporary cache for faster debug previews drawing (used only during frame rendering).
-    static Dictionary<GPUBuffer*, const ModelLOD*> IndexBufferToModelLOD;
+    static Dictionary<Pair<GPUBuffer*, int32>, const ModelLOD*> IndexBufferToModelLOD;
     static CriticalSection Locker;
 
-    FORCE_INLINE static void AddIndexBufferToModelLOD(GPUBuffer* indexBuffer, const ModelLOD* modelLod)
+    FORCE_INLINE static void AddIndexBufferToModelLOD(GPUBuffer* indexBuffer, int32 startIndex, const ModelLOD* modelLod)
     {
         Locker.Lock();
-        IndexBufferToModelLOD[indexBuffer] = modelLod;
+        IndexBufferToModelLOD[ToPair(indexBuffer, startIndex)] = modelLod;
         Locker.Unlock();
     }
     void PreOverrideDrawCalls(RenderContext& renderContext);
@@ -75,6 +78,23 @@ class GBufferPass : public RendererPass<GBufferPass>
     /// <param name="gBuffer">GBuffer input to setup</param>
     static void SetInputs(const RenderView& view, GBufferData& gBuffer);
 
+    /// <summary>
+    /// Sorts the decals from the render list and uploads their per-instance data (transformation) used by the decal materials. Decal at the given index in the render list uses the instance with the same index.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="context">The GPU context.</param>
+    /// <param name="worlds">The output decals world matrices (in the render list order).</param>
+    /// <returns>True if decals cannot be rendered, otherwise false.</returns>
+    bool PrepareDecals(RenderContext& renderContext, GPUContext* context, Array<Matrix, RendererAllocation>& worlds);
+
+    /// <summary>
+    /// Draws the range of the decal instances prepared with PrepareDecals. Decal material has to be bound before.
+    /// </summary>
+    /// <param name="context">The GPU context.</param>
+    /// <param name="startInstance">The first decal instance index.</param>
+    /// <param name="instanceCount">The amount of decals to draw.</param>
+    void DrawDecalsInstances(GPUContext* context, int32 startInstance, int32 instanceCount);
+
 private:
 
     void DrawSky(RenderContext& renderContext, GPUContext* context);
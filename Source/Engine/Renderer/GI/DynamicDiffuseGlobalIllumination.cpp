@@ -57,7 +57,8 @@ PACK_STRUCT(struct Data0
 PACK_STRUCT(struct Data1
     {
     // TODO: use push constants on Vulkan or root signature data on DX12 to reduce overhead of changing single DWORD
-    Float2 Padding1;
+    uint32 FrameIndex;
+    float ProbesUpdateChance;
     uint32 CascadeIndex;
     uint32 ProbeIndexOffset;
     });
@@ -409,6 +410,17 @@ bool DynamicDiffuseGlobalIlluminationPass::RenderInner(RenderContext& renderCont
         cascadeSkipUpdate[cascadeIndex] = !clear && (ddgiData.LastFrameUsed % cascadeFrequencies[cascadeIndex]) != 0;
     }
 
+    // Calculate the probes update budget (split between cascades updated this frame, probes out of budget are randomly updated in the next frames)
+    float probesUpdateChance = 1.0f;
+    if (Graphics::GIRaysBudget > 0 && !clear)
+    {
+        int32 cascadesToUpdate = 0;
+        for (int32 cascadeIndex = 0; cascadeIndex < cascadesCount; cascadeIndex++)
+            cascadesToUpdate += cascadeSkipUpdate[cascadeIndex] ? 0 : 1;
+        const float probesBudget = (float)Graphics::GIRaysBudget / (float)(probeRaysCount * Math::Max(cascadesToUpdate, 1));
+        probesUpdateChance = Math::Saturate(probesBudget / (float)probesCountCascade);
+    }
+
     // Compute scrolling (probes are placed around camera but are scrolling to increase stability during movement)
     for (int32 cascadeIndex = 0; cascadeIndex < cascadesCount; cascadeIndex++)
     {
@@ -519,6 +531,8 @@ bool DynamicDiffuseGlobalIlluminationPass::RenderInner(RenderContext& renderCont
                 context->BindUA(0, ddgiData.Result.ProbesData);
                 context->BindUA(1, ddgiData.ActiveProbes->View());
                 Data1 data;
+                data.FrameIndex = (uint32)Engine::FrameCount;
+                data.ProbesUpdateChance = probesUpdateChance;
                 data.CascadeIndex = cascadeIndex;
                 context->UpdateCB(_cb1, &data);
                 context->BindCB(1, _cb1);
@@ -541,6 +555,8 @@ bool DynamicDiffuseGlobalIlluminationPass::RenderInner(RenderContext& renderCont
             for (int32 probesOffset = 0; probesOffset < probesCountCascade; probesOffset += DDGI_TRACE_RAYS_PROBES_COUNT_LIMIT)
             {
                 Data1 data;
+                data.FrameIndex = (uint32)Engine::FrameCount;
+                data.ProbesUpdateChance = probesUpdateChance;
                 data.CascadeIndex = cascadeIndex;
                 data.ProbeIndexOffset = probesOffset;
                 context->UpdateCB(_cb1, &data);
@@ -573,10 +589,12 @@ bool DynamicDiffuseGlobalIlluminationPass::RenderInner(RenderContext& renderCont
                     context->BindSR(0, ddgiData.Result.ProbesData);
                     context->BindSR(1, ddgiData.ProbesTrace->View());
                     context->BindSR(2, ddgiData.ActiveProbes->View());
+                    context->OverlapUA(false); // Irradiance and distance are updated independently
                     context->BindUA(0, ddgiData.Result.ProbesIrradiance);
                     context->DispatchIndirect(_csUpdateProbesIrradiance, ddgiData.UpdateProbesInitArgs, arg);
                     context->BindUA(0, ddgiData.Result.ProbesDistance);
                     context->DispatchIndirect(_csUpdateProbesDistance, ddgiData.UpdateProbesInitArgs, arg);
+                    context->OverlapUA(true);
                     context->ResetUA();
                     context->ResetSR();
                 }
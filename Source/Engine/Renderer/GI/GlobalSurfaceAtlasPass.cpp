@@ -34,6 +34,7 @@
 #define GLOBAL_SURFACE_ATLAS_TILE_SIZE_MIN 8 // The minimum size of the tile
 #define GLOBAL_SURFACE_ATLAS_TILE_SIZE_MAX 192 // The maximum size of the tile
 #define GLOBAL_SURFACE_ATLAS_TILE_PROJ_PLANE_OFFSET 0.1f // Small offset to prevent clipping with the closest triangles (shifts near and far planes)
+#define GLOBAL_SURFACE_ATLAS_CACHE_FRAMES 600 // The maximum amount of frames to keep tiles of the unused objects resident in the atlas (reused without redraw when object gets back into the view)
 #define GLOBAL_SURFACE_ATLAS_DEBUG_FORCE_REDRAW_TILES 0 // Forces to redraw all object tiles every frame
 #define GLOBAL_SURFACE_ATLAS_DEBUG_DRAW_OBJECTS 0 // Debug draws object bounds on redraw (and tile draw projection locations)
 #define GLOBAL_SURFACE_ATLAS_DEBUG_DRAW_CHUNKS 0 // Debug draws culled chunks bounds (non-empty)
@@ -93,6 +94,7 @@ struct GlobalSurfaceAtlasObject
     Actor* Actor;
     GlobalSurfaceAtlasTile* Tiles[6];
     float Radius;
+    float ScreenSize; // Object size on the screen (radius/distance to the view) used to prioritize the tiles residency in the atlas
     OrientedBoundingBox Bounds;
 
     GlobalSurfaceAtlasObject()
@@ -148,6 +150,7 @@ class GlobalSurfaceAtlasCustomBuffer : public RenderBuffers::CustomBuffer, publi
     GlobalSurfaceAtlasPass::BindingData Result;
     GlobalSurfaceAtlasTile* AtlasTiles = nullptr; // TODO: optimize with a single allocation for atlas tiles
     Dictionary<void*, GlobalSurfaceAtlasObject> Objects;
+    Dictionary<void*, GlobalSurfaceAtlasObject> CachedObjects; // Objects not used in the current frame but with tiles still resident in the atlas
     Dictionary<Guid, GlobalSurfaceAtlasLight> Lights;
     SamplesBuffer<uint32, 30> CulledObjectsUsageHistory;
 
@@ -172,9 +175,40 @@ class GlobalSurfaceAtlasCustomBuffer : public RenderBuffers::CustomBuffer, publi
         LastFrameAtlasDefragmentation = Engine::FrameCount;
         SAFE_DELETE(AtlasTiles);
         Objects.Clear();
+        CachedObjects.Clear();
         Lights.Clear();
     }
 
+    void FreeCachedObject(Dictionary<void*, GlobalSurfaceAtlasObject>::Iterator& it)
+    {
+        for (auto& tile : it->Value.Tiles)
+        {
+            if (tile)
+                tile->Free();
+        }
+        CachedObjects.Remove(it);
+    }
+
+    // Frees the tiles of the least important cached object (oldest and smallest on the screen). Returns false if cache is empty.
+    bool EvictCachedObject()
+    {
+        auto lowest = CachedObjects.End();
+        float lowestPriority = MAX_float;
+        for (auto it = CachedObjects.Begin(); it.IsNotEnd(); ++it)
+        {
+            const float priority = it->Value.ScreenSize / (float)(1 + CurrentFrame - it->Value.LastFrameUsed);
+            if (priority < lowestPriority)
+            {
+                lowestPriority = priority;
+                lowest = it;
+            }
+        }
+        if (lowest.IsEnd())
+            return false;
+        FreeCachedObject(lowest);
+        return true;
+    }
+
     FORCE_INLINE void Clear()
     {
         RenderTargetPool::Release(AtlasDepth);
@@ -209,6 +243,12 @@ class GlobalSurfaceAtlasCustomBuffer : public RenderBuffers::CustomBuffer, publi
                 // Dirty object to redraw
                 object->LastFrameUpdated = 0;
             }
+            object = CachedObjects.TryGet(a);
+            if (object)
+            {
+                // Dirty cached object to redraw once it gets used again
+                object->LastFrameUpdated = 0;
+            }
             GlobalSurfaceAtlasLight* light = Lights.TryGet(a->GetID());
             if (light)
             {
@@ -220,10 +260,18 @@ class GlobalSurfaceAtlasCustomBuffer : public RenderBuffers::CustomBuffer, publi
 
     void OnSceneRenderingRemoveActor(Actor* a) override
     {
+        // Release cached tiles of the removed actor (actor object key might get reused by a new object)
+        for (auto it = CachedObjects.Begin(); it.IsNotEnd(); ++it)
+        {
+            if (it->Value.Actor == a)
+                FreeCachedObject(it);
+        }
     }
 
     void OnSceneRenderingClear(SceneRendering* scene) override
     {
+        for (auto it = CachedObjects.Begin(); it.IsNotEnd(); ++it)
+            FreeCachedObject(it);
     }
 };
 
@@ -506,21 +554,22 @@ bool GlobalSurfaceAtlasPass::Render(RenderContext& renderContext, GPUContext* co
         ZoneValue(actorsDrawn);
     }
 
-    // Remove unused objects
+    // Move unused objects into the cache (keep their tiles resident in the atlas) and release the old ones
     {
         PROFILE_GPU_CPU_NAMED("Compact Objects");
         for (auto it = surfaceAtlasData.Objects.Begin(); it.IsNotEnd(); ++it)
         {
             if (it->Value.LastFrameUsed != currentFrame)
             {
-                for (auto& tile : it->Value.Tiles)
-                {
-                    if (tile)
-                        tile->Free();
-                }
+                surfaceAtlasData.CachedObjects.Add(it->Key, it->Value);
                 surfaceAtlasData.Objects.Remove(it);
             }
         }
+        for (auto it = surfaceAtlasData.CachedObjects.Begin(); it.IsNotEnd(); ++it)
+        {
+            if (currentFrame - it->Value.LastFrameUsed > GLOBAL_SURFACE_ATLAS_CACHE_FRAMES)
+                surfaceAtlasData.FreeCachedObject(it);
+        }
     }
 
     // Rasterize world geometry material properties into Global Surface Atlas
@@ -1202,6 +1251,18 @@ void GlobalSurfaceAtlasPass::RasterizeActor(Actor* actor, void* actorObject, con
     const float distanceScale = Math::Lerp(1.0f, surfaceAtlasData.DistanceScaling, Math::InverseLerp(surfaceAtlasData.DistanceScalingStart, surfaceAtlasData.DistanceScalingEnd, (float)CollisionsHelper::DistanceSpherePoint(actorObjectBounds, surfaceAtlasData.ViewPosition)));
     const float tilesScale = surfaceAtlasData.TileTexelsPerWorldUnit * distanceScale * qualityScale;
     GlobalSurfaceAtlasObject* object = surfaceAtlasData.Objects.TryGet(actorObject);
+    if (!object)
+    {
+        // Restore object from the cache (tiles contents are still valid)
+        auto it = surfaceAtlasData.CachedObjects.Find(actorObject);
+        if (it.IsNotEnd())
+        {
+            object = &surfaceAtlasData.Objects[actorObject];
+            *object = it->Value;
+            object->LightingUpdateFrame = surfaceAtlasData.CurrentFrame;
+            surfaceAtlasData.CachedObjects.Remove(it);
+        }
+    }
     bool anyTile = false, dirty = false;
     for (int32 tileIndex = 0; tileIndex < 6; tileIndex++)
     {
@@ -1245,6 +1306,11 @@ void GlobalSurfaceAtlasPass::RasterizeActor(Actor* actor, void* actorObject, con
 
         // Insert tile into atlas
         auto* tile = surfaceAtlasData.AtlasTiles->Insert(tileResolution, tileResolution, 0, &surfaceAtlasData, actorObject, tileIndex);
+        while (!tile && surfaceAtlasData.EvictCachedObject())
+        {
+            // Make space in the atlas by releasing the tiles of the cached objects
+            tile = surfaceAtlasData.AtlasTiles->Insert(tileResolution, tileResolution, 0, &surfaceAtlasData, actorObject, tileIndex);
+        }
         if (tile)
         {
             if (!object)
@@ -1274,6 +1340,7 @@ void GlobalSurfaceAtlasPass::RasterizeActor(Actor* actor, void* actorObject, con
     object->Bounds = OrientedBoundingBox(localBounds);
     object->Bounds.Transform(localToWorld);
     object->Radius = (float)actorObjectBounds.Radius;
+    object->ScreenSize = object->Radius / Math::Max((float)Float3::Distance(actorObjectBounds.Center, surfaceAtlasData.ViewPosition), object->Radius);
     if (dirty || GLOBAL_SURFACE_ATLAS_DEBUG_FORCE_REDRAW_TILES)
     {
         object->LastFrameUpdated = surfaceAtlasData.CurrentFrame;
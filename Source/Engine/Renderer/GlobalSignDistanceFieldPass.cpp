@@ -4,6 +4,7 @@
 #include "RenderList.h"
 #include "Engine/Core/Math/Vector3.h"
 #include "Engine/Core/Collections/HashSet.h"
+#include "Engine/Core/Math/Half.h"
 #include "Engine/Engine/Engine.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Graphics/GPUContext.h"
@@ -30,6 +31,8 @@
 #define GLOBAL_SDF_MIP_FLOODS 5 // Amount of flood fill passes for mip.
 #define GLOBAL_SDF_DEBUG_CHUNKS 0
 #define GLOBAL_SDF_DEBUG_FORCE_REDRAW 0 // Forces to redraw all SDF cascades every frame
+#define GLOBAL_SDF_CPU_READBACK_INTERVAL 10 // The frames interval between Global SDF readbacks for CPU queries.
+#define GLOBAL_SDF_CPU_READBACK_LATENCY 3 // The frames latency for GPU to finish the Global SDF readback copy before mapping it on CPU.
 #define GLOBAL_SDF_ACTOR_IS_STATIC(actor) EnumHasAllFlags(actor->GetStaticFlags(), StaticFlags::Lightmap | StaticFlags::Transform)
 
 static_assert(GLOBAL_SDF_RASTERIZE_MODEL_MAX_COUNT % 4 == 0, "Must be multiple of 4 due to data packing for GPU constant buffer.");
@@ -76,6 +79,12 @@ PACK_STRUCT(struct ModelsRasterizeData
     uint32 GenerateMipCoordScale;
     uint32 GenerateMipTexOffsetX;
     uint32 GenerateMipMipOffsetX;
+    Int3 GenerateMipCoordOffset;
+    uint32 GenerateMipPadding0;
+    Int3 GenerateMipTexMin;
+    uint32 GenerateMipPadding1;
+    Int3 GenerateMipTexMax;
+    uint32 GenerateMipPadding2;
     });
 
 struct RasterizeChunk
@@ -83,6 +92,7 @@ struct RasterizeChunk
     uint16 ModelsCount;
     uint16 HeightfieldsCount : 15;
     uint16 Dynamic : 1;
+    uint32 ObjectsHash; // Hash of all objects (including the next layers) rasterized into the chunk, used to detect changes of the dynamic chunks.
     uint16 Models[GLOBAL_SDF_RASTERIZE_MODEL_MAX_COUNT];
     uint16 Heightfields[GLOBAL_SDF_RASTERIZE_HEIGHTFIELD_MAX_COUNT];
 
@@ -91,6 +101,7 @@ struct RasterizeChunk
         ModelsCount = 0;
         HeightfieldsCount = 0;
         Dynamic = false;
+        ObjectsHash = 0;
     }
 };
 
@@ -129,6 +140,17 @@ uint32 GetHash(const RasterizeChunkKey& key)
     return key.Hash;
 }
 
+uint32 GetRasterizeObjectHash(const Actor* actor, const GPUTexture* texture, const Transform& localToWorld, int32 residentMipLevels)
+{
+    uint32 hash = GetHash(actor);
+    CombineHash(hash, GetHash(texture));
+    CombineHash(hash, (uint32)residentMipLevels);
+    const uint32* transformData = (const uint32*)&localToWorld;
+    for (int32 i = 0; i < (int32)(sizeof(Transform) / sizeof(uint32)); i++)
+        CombineHash(hash, transformData[i]);
+    return hash;
+}
+
 struct CascadeData
 {
     Float3 Position;
@@ -136,6 +158,13 @@ struct CascadeData
     BoundingBox Bounds;
     HashSet<RasterizeChunkKey> NonEmptyChunks;
     HashSet<RasterizeChunkKey> StaticChunks;
+    Dictionary<RasterizeChunkKey, uint32> DynamicChunks; // Objects hash of the dynamic chunks rasterized in the last update (skipped if nothing moves inside).
+
+    FORCE_INLINE void ClearCache()
+    {
+        StaticChunks.Clear();
+        DynamicChunks.Clear();
+    }
 
     FORCE_INLINE void OnSceneRenderingDirty(const BoundingBox& objectBounds)
     {
@@ -212,7 +241,7 @@ class GlobalSignDistanceFieldCustomBuffer : public RenderBuffers::CustomBuffer,
 
             // Clear static chunks cache
             for (auto& cascade : Cascades)
-                cascade.StaticChunks.Clear();
+                cascade.ClearCache();
         }
     }
 
@@ -251,7 +280,7 @@ class GlobalSignDistanceFieldCustomBuffer : public RenderBuffers::CustomBuffer,
     void OnSceneRenderingClear(SceneRendering* scene) override
     {
         for (auto& cascade : Cascades)
-            cascade.StaticChunks.Clear();
+            cascade.ClearCache();
     }
 };
 
@@ -307,6 +336,7 @@ bool GlobalSignDistanceFieldPass::setupResources()
     _csRasterizeHeightfield = shader->GetCS("CS_RasterizeHeightfield");
     _csClearChunk = shader->GetCS("CS_ClearChunk");
     _csGenerateMip = shader->GetCS("CS_GenerateMip");
+    _csReadback = shader->GetCS("CS_Readback");
 
     // Init buffer
     if (!_objectsBuffer)
@@ -335,6 +365,7 @@ void GlobalSignDistanceFieldPass::OnShaderReloading(Asset* obj)
     _csRasterizeHeightfield = nullptr;
     _csClearChunk = nullptr;
     _csGenerateMip = nullptr;
+    _csReadback = nullptr;
     _cb0 = nullptr;
     _cb1 = nullptr;
     invalidateResources();
@@ -350,6 +381,11 @@ void GlobalSignDistanceFieldPass::Dispose()
     SAFE_DELETE(_objectsBuffer);
     _objectsTextures.Resize(0);
     SAFE_DELETE_GPU_RESOURCE(_psDebug);
+    SAFE_DELETE_GPU_RESOURCE(_readbackBuffer);
+    SAFE_DELETE_GPU_RESOURCE(_readbackStagingBuffer);
+    _readbackPending = false;
+    _cpuData.Resolution = 0;
+    _cpuData.Distances.SetCapacity(0);
     _shader = nullptr;
     ChunksCache.SetCapacity(0);
     RasterizeObjectsCache.SetCapacity(0);
@@ -470,7 +506,7 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
         for (auto& cascade : sdfData.Cascades)
         {
             cascade.NonEmptyChunks.Clear();
-            cascade.StaticChunks.Clear();
+            cascade.ClearCache();
         }
         context->ClearUA(sdfData.Texture, Float4::One);
         context->ClearUA(sdfData.TextureMip, Float4::One);
@@ -533,7 +569,7 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
         if (!(useCache && Float3::NearEqual(cascade.Position, center, cascadeVoxelSize)))
         {
             // TODO: optimize for moving camera (copy sdf for cached chunks)
-            cascade.StaticChunks.Clear();
+            cascade.ClearCache();
         }
         cascade.Position = center;
         cascade.VoxelSize = cascadeVoxelSize;
@@ -592,6 +628,8 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
         context->BindCB(1, _cb1);
         const int32 chunkDispatchGroups = GLOBAL_SDF_RASTERIZE_CHUNK_SIZE / GLOBAL_SDF_RASTERIZE_GROUP_SIZE;
         bool anyChunkDispatch = false;
+        Int3 dirtyChunksMin(MAX_int32), dirtyChunksMax(MIN_int32);
+        context->OverlapUA(false); // Chunks are written independently
         {
             PROFILE_GPU_CPU_NAMED("Clear Chunks");
             for (auto it = cascade.NonEmptyChunks.Begin(); it.IsNotEnd(); ++it)
@@ -601,12 +639,14 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
                     continue;
 
                 // Clear empty chunk
-                cascade.NonEmptyChunks.Remove(it);
                 data.ChunkCoord = key.Coord * GLOBAL_SDF_RASTERIZE_CHUNK_SIZE;
+                dirtyChunksMin = Int3::Min(dirtyChunksMin, key.Coord);
+                dirtyChunksMax = Int3::Max(dirtyChunksMax, key.Coord);
+                cascade.DynamicChunks.Remove(key);
+                cascade.NonEmptyChunks.Remove(it);
                 context->UpdateCB(_cb1, &data);
                 context->Dispatch(_csClearChunk, chunkDispatchGroups, chunkDispatchGroups, chunkDispatchGroups);
                 anyChunkDispatch = true;
-                // TODO: don't stall with UAV barrier on D3D12/Vulkan if UAVs don't change between dispatches
             }
         }
         {
@@ -622,6 +662,19 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
                 {
                     // Remove static chunk with dynamic objects
                     cascade.StaticChunks.Remove(e.Key);
+
+                    uint32* prevObjectsHash = cascade.DynamicChunks.TryGet(e.Key);
+                    if (prevObjectsHash && *prevObjectsHash == e.Value.ObjectsHash)
+                    {
+                        // Skip updating dynamic chunk if nothing changed inside it
+                        auto key = e.Key;
+                        while (chunks.Remove(key))
+                            key.NextLayer();
+                    }
+                    else
+                    {
+                        cascade.DynamicChunks[e.Key] = e.Value.ObjectsHash;
+                    }
                 }
                 else if (cascade.StaticChunks.Contains(e.Key))
                 {
@@ -633,6 +686,7 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
                 else
                 {
                     // Add to cache (render now but skip next frame)
+                    cascade.DynamicChunks.Remove(e.Key);
                     cascade.StaticChunks.Add(e.Key);
                 }
             }
@@ -742,15 +796,17 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
                     context->UnBindSR(i + 1);
                 data.ChunkCoord = e.Key.Coord * GLOBAL_SDF_RASTERIZE_CHUNK_SIZE;
                 data.ObjectsCount = chunk.ModelsCount;
+                dirtyChunksMin = Int3::Min(dirtyChunksMin, e.Key.Coord);
+                dirtyChunksMax = Int3::Max(dirtyChunksMax, e.Key.Coord);
                 context->UpdateCB(_cb1, &data);
                 auto cs = data.ObjectsCount != 0 ? _csRasterizeModel0 : _csClearChunk; // Terrain-only chunk can be quickly cleared
                 context->Dispatch(cs, chunkDispatchGroups, chunkDispatchGroups, chunkDispatchGroups);
                 anyChunkDispatch = true;
-                // TODO: don't stall with UAV barrier on D3D12/Vulkan if UAVs don't change between dispatches (maybe cache per-shader write/read flags for all UAVs?)
 
                 if (chunk.HeightfieldsCount != 0)
                 {
-                    // Inject heightfield (additive)
+                    // Inject heightfield (additive, needs the chunk rasterized before)
+                    context->OverlapUA(true);
                     for (int32 i = 0; i < chunk.HeightfieldsCount; i++)
                     {
                         auto objectIndex = objectIndexToDataIndex.At(chunk.Heightfields[i]);
@@ -762,6 +818,7 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
                     data.ObjectsCount = chunk.HeightfieldsCount;
                     context->UpdateCB(_cb1, &data);
                     context->Dispatch(_csRasterizeHeightfield, chunkDispatchGroups, chunkDispatchGroups, chunkDispatchGroups);
+                    context->OverlapUA(false);
                 }
 
 #if GLOBAL_SDF_DEBUG_CHUNKS
@@ -784,6 +841,8 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
 #endif
             }
 
+            context->OverlapUA(true);
+
             // Rasterize non-empty chunks (additive layers so so need combine with existing chunk data)
             for (const auto& e : chunks)
             {
@@ -832,9 +891,20 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
         {
             PROFILE_GPU_CPU_NAMED("Generate Mip");
             context->ResetUA();
-            const int32 mipDispatchGroups = Math::DivideAndRoundUp(resolutionMip, GLOBAL_SDF_MIP_GROUP_SIZE);
             static_assert((GLOBAL_SDF_MIP_FLOODS % 2) == 1, "Invalid Global SDF mip flood iterations count.");
             int32 floodFillIterations = chunks.Count() == 0 ? 1 : GLOBAL_SDF_MIP_FLOODS;
+
+            // Update only the mip region affected by the modified chunks (flood fill spreads changes around by one voxel per iteration)
+            Int3 regionMin(0), regionMax(resolutionMip);
+            if (!updated)
+            {
+                constexpr int32 chunkSizeMip = GLOBAL_SDF_RASTERIZE_CHUNK_SIZE / GLOBAL_SDF_RASTERIZE_MIP_FACTOR;
+                regionMin = (dirtyChunksMin * chunkSizeMip - GLOBAL_SDF_MIP_FLOODS) / GLOBAL_SDF_MIP_GROUP_SIZE * GLOBAL_SDF_MIP_GROUP_SIZE;
+                regionMax = Int3::Min((dirtyChunksMax + 1) * chunkSizeMip + GLOBAL_SDF_MIP_FLOODS + GLOBAL_SDF_MIP_GROUP_SIZE - 1, Int3(resolutionMip)) / GLOBAL_SDF_MIP_GROUP_SIZE * GLOBAL_SDF_MIP_GROUP_SIZE;
+                regionMin = Int3::Max(regionMin, Int3::Zero);
+            }
+            const Int3 mipDispatchGroups = (regionMax - regionMin) / GLOBAL_SDF_MIP_GROUP_SIZE;
+            data.GenerateMipCoordOffset = regionMin;
             if (!tmpMip)
             {
                 // Use temporary texture to flood fill mip
@@ -852,13 +922,18 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
             data.GenerateMipCoordScale = data.CascadeMipFactor;
             data.GenerateMipTexOffsetX = data.CascadeIndex * data.CascadeResolution;
             data.GenerateMipMipOffsetX = data.CascadeIndex * data.CascadeMipResolution;
+            data.GenerateMipTexMin = regionMin * GLOBAL_SDF_RASTERIZE_MIP_FACTOR;
+            data.GenerateMipTexMax = Int3::Min(regionMax * GLOBAL_SDF_RASTERIZE_MIP_FACTOR, Int3(resolution)) - 1;
             context->UpdateCB(_cb1, &data);
             context->BindSR(0, textureView);
             context->BindUA(0, textureMipView);
-            context->Dispatch(_csGenerateMip, mipDispatchGroups, mipDispatchGroups, mipDispatchGroups);
+            context->Dispatch(_csGenerateMip, mipDispatchGroups.X, mipDispatchGroups.Y, mipDispatchGroups.Z);
 
+            // Flood fill reads only within the updated region (temporary texture outside it is undefined)
             data.GenerateMipTexResolution = data.CascadeMipResolution;
             data.GenerateMipCoordScale = 1;
+            data.GenerateMipTexMin = regionMin;
+            data.GenerateMipTexMax = regionMax - 1;
             for (int32 i = 1; i < floodFillIterations; i++)
             {
                 context->ResetUA();
@@ -879,7 +954,7 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
                     data.GenerateMipMipOffsetX = data.CascadeIndex * data.CascadeMipResolution;
                 }
                 context->UpdateCB(_cb1, &data);
-                context->Dispatch(_csGenerateMip, mipDispatchGroups, mipDispatchGroups, mipDispatchGroups);
+                context->Dispatch(_csGenerateMip, mipDispatchGroups.X, mipDispatchGroups.Y, mipDispatchGroups.Z);
             }
         }
     }
@@ -915,9 +990,153 @@ bool GlobalSignDistanceFieldPass::Render(RenderContext& renderContext, GPUContex
     result.Constants.Resolution = (float)resolution;
     result.Constants.CascadesCount = cascadesCount;
     sdfData.Result = result;
+
+    // Download the Global SDF for CPU queries (only from the main view)
+    if (_cpuDataRequested && renderContext.Task == MainRenderTask::Instance)
+        UpdateCPUData(context, sdfData.TextureMip, resolutionMip, result.Constants);
+
     return false;
 }
 
+void GlobalSignDistanceFieldPass::UpdateCPUData(GPUContext* context, GPUTexture* textureMip, int32 resolutionMip, const ConstantsData& constants)
+{
+    const uint64 currentFrame = Engine::FrameCount;
+    if (_readbackPending)
+    {
+        // Copy downloaded data once GPU finished the copy
+        if (currentFrame - _readbackFrame < GLOBAL_SDF_CPU_READBACK_LATENCY)
+            return;
+        PROFILE_CPU_NAMED("Global SDF Readback");
+        _readbackPending = false;
+        _cpuDataRequested = false;
+        const auto mapped = (const Half*)_readbackStagingBuffer->Map(GPUResourceMapMode::Read);
+        if (mapped)
+        {
+            const int32 count = resolutionMip * resolutionMip * resolutionMip * (int32)_readbackConstants.CascadesCount;
+            ScopeLock lock(_cpuDataLocker);
+            _cpuData.Constants = _readbackConstants;
+            _cpuData.Resolution = _readbackResolution;
+            _cpuData.Distances.Resize(count, false);
+            for (int32 i = 0; i < count; i++)
+                _cpuData.Distances.Get()[i] = Float16Compressor::Decompress(mapped[i]);
+            _readbackStagingBuffer->Unmap();
+        }
+    }
+    else if (currentFrame - _readbackFrame >= GLOBAL_SDF_CPU_READBACK_INTERVAL && _csReadback)
+    {
+        PROFILE_GPU_CPU_NAMED("Global SDF Readback");
+
+        // Prepare buffers
+        const int32 count = resolutionMip * resolutionMip * resolutionMip * (int32)constants.CascadesCount;
+        if (!_readbackBuffer)
+            _readbackBuffer = GPUDevice::Instance->CreateBuffer(TEXT("GlobalSDF.ReadbackBuffer"));
+        if (_readbackBuffer->GetElementsCount() != count)
+        {
+            SAFE_DELETE_GPU_RESOURCE(_readbackStagingBuffer);
+            if (_readbackBuffer->Init(GPUBufferDescription::Buffer(count * sizeof(Half), GPUBufferFlags::ShaderResource | GPUBufferFlags::UnorderedAccess, GLOBAL_SDF_FORMAT, nullptr, sizeof(Half))))
+                return;
+            _readbackStagingBuffer = _readbackBuffer->ToStagingReadback();
+            if (!_readbackStagingBuffer)
+                return;
+        }
+
+        // Copy the mip texture into the linear buffer and download it
+        context->BindSR(0, textureMip->ViewVolume());
+        context->BindUA(0, _readbackBuffer->View());
+        const int32 groups = Math::DivideAndRoundUp(resolutionMip, GLOBAL_SDF_MIP_GROUP_SIZE);
+        context->Dispatch(_csReadback, groups * (int32)constants.CascadesCount, groups, groups);
+        context->ResetUA();
+        context->ResetSR();
+        context->CopyBuffer(_readbackStagingBuffer, _readbackBuffer, count * sizeof(Half));
+        _readbackPending = true;
+        _readbackFrame = currentFrame;
+        _readbackResolution = resolutionMip;
+        _readbackConstants = constants;
+    }
+}
+
+const GlobalSignDistanceFieldPass::CPUData& GlobalSignDistanceFieldPass::LockCPUData()
+{
+    _cpuDataRequested = true;
+    _cpuDataLocker.Lock();
+    return _cpuData;
+}
+
+void GlobalSignDistanceFieldPass::UnlockCPUData()
+{
+    _cpuDataLocker.Unlock();
+}
+
+float GlobalSignDistanceFieldPass::CPUData::SampleCascade(int32 cascade, const Float3& cascadeUV) const
+{
+    // Trilinear sampling of the cascade volume (cascades are placed next to each other on X axis)
+    const int32 resolution = Resolution;
+    const int32 width = resolution * (int32)Constants.CascadesCount;
+    const Float3 coord = Float3::Clamp(cascadeUV * (float)resolution - 0.5f, Float3::Zero, Float3((float)(resolution - 1)));
+    const Int3 coord0((int32)coord.X, (int32)coord.Y, (int32)coord.Z);
+    const Int3 coord1 = Int3::Min(coord0 + 1, Int3(resolution - 1));
+    const Float3 t = coord - Float3((float)coord0.X, (float)coord0.Y, (float)coord0.Z);
+    const float* data = Distances.Get();
+    const int32 x0 = cascade * resolution + coord0.X, x1 = cascade * resolution + coord1.X;
+#define SAMPLE(x, y, z) data[(x) + ((y) + (z) * resolution) * width]
+    const float d00 = Math::Lerp(SAMPLE(x0, coord0.Y, coord0.Z), SAMPLE(x1, coord0.Y, coord0.Z), t.X);
+    const float d10 = Math::Lerp(SAMPLE(x0, coord1.Y, coord0.Z), SAMPLE(x1, coord1.Y, coord0.Z), t.X);
+    const float d01 = Math::Lerp(SAMPLE(x0, coord0.Y, coord1.Z), SAMPLE(x1, coord0.Y, coord1.Z), t.X);
+    const float d11 = Math::Lerp(SAMPLE(x0, coord1.Y, coord1.Z), SAMPLE(x1, coord1.Y, coord1.Z), t.X);
+#undef SAMPLE
+    return Math::Lerp(Math::Lerp(d00, d10, t.Y), Math::Lerp(d01, d11, t.Y), t.Z);
+}
+
+bool GlobalSignDistanceFieldPass::CPUData::Sample(const Float3& worldPosition, float& distance) const
+{
+    // Matches SampleGlobalSDF from GlobalSignDistanceField.hlsl
+    if (Resolution == 0)
+        return false;
+    for (int32 cascade = 0; cascade < (int32)Constants.CascadesCount; cascade++)
+    {
+        const Float4& cascadePosDistance = Constants.CascadePosDistance[cascade];
+        const float cascadeMaxDistance = cascadePosDistance.W * 2;
+        const Float3 cascadeUV = (worldPosition - Float3(cascadePosDistance)) / cascadeMaxDistance + 0.5f;
+        if (cascadeUV.X < 0 || cascadeUV.Y < 0 || cascadeUV.Z < 0 || cascadeUV.X > 1 || cascadeUV.Y > 1 || cascadeUV.Z > 1)
+            continue;
+        const float cascadeDistance = SampleCascade(cascade, cascadeUV);
+        if (cascadeDistance < 0.9f)
+        {
+            distance = cascadeDistance * cascadeMaxDistance;
+            return true;
+        }
+    }
+    return false;
+}
+
+Float3 GlobalSignDistanceFieldPass::CPUData::SampleGradient(const Float3& worldPosition) const
+{
+    // Central differences with a single voxel offset of the first cascade that contains the location
+    Float3 gradient(0, 0.00001f, 0);
+    if (Resolution == 0)
+        return gradient;
+    for (int32 cascade = 0; cascade < (int32)Constants.CascadesCount; cascade++)
+    {
+        const Float4& cascadePosDistance = Constants.CascadePosDistance[cascade];
+        const float cascadeMaxDistance = cascadePosDistance.W * 2;
+        const Float3 cascadeUV = (worldPosition - Float3(cascadePosDistance)) / cascadeMaxDistance + 0.5f;
+        if (cascadeUV.X < 0 || cascadeUV.Y < 0 || cascadeUV.Z < 0 || cascadeUV.X > 1 || cascadeUV.Y > 1 || cascadeUV.Z > 1)
+            continue;
+        if (SampleCascade(cascade, cascadeUV) >= 0.9f)
+            continue;
+        const float texelOffset = 1.0f / (float)Resolution;
+        const float xp = SampleCascade(cascade, cascadeUV + Float3(texelOffset, 0, 0));
+        const float xn = SampleCascade(cascade, cascadeUV - Float3(texelOffset, 0, 0));
+        const float yp = SampleCascade(cascade, cascadeUV + Float3(0, texelOffset, 0));
+        const float yn = SampleCascade(cascade, cascadeUV - Float3(0, texelOffset, 0));
+        const float zp = SampleCascade(cascade, cascadeUV + Float3(0, 0, texelOffset));
+        const float zn = SampleCascade(cascade, cascadeUV - Float3(0, 0, texelOffset));
+        gradient = Float3(xp - xn, yp - yn, zp - zn) * cascadeMaxDistance;
+        break;
+    }
+    return gradient;
+}
+
 void GlobalSignDistanceFieldPass::RenderDebug(RenderContext& renderContext, GPUContext* context, GPUTexture* output)
 {
     BindingData bindingData;
@@ -954,6 +1173,7 @@ void GlobalSignDistanceFieldPass::RasterizeModelSDF(Actor* actor, const ModelBas
         return;
     const bool dynamic = !GLOBAL_SDF_ACTOR_IS_STATIC(actor);
     const int32 residentMipLevels = sdf.Texture->ResidentMipLevels();
+    const uint32 objectHash = GetRasterizeObjectHash(actor, sdf.Texture, localToWorld, residentMipLevels);
     if (residentMipLevels != 0)
     {
         // Setup object data
@@ -986,6 +1206,7 @@ void GlobalSignDistanceFieldPass::RasterizeModelSDF(Actor* actor, const ModelBas
                     key.Hash = key.Coord.Z * (RasterizeChunkKeyHashResolution * RasterizeChunkKeyHashResolution) + key.Coord.Y * RasterizeChunkKeyHashResolution + key.Coord.X;
                     RasterizeChunk* chunk = &chunks[key];
                     chunk->Dynamic |= dynamic;
+                    CombineHash(chunk->ObjectsHash, objectHash);
 
                     // Move to the next layer if chunk has overflown
                     while (chunk->ModelsCount == GLOBAL_SDF_RASTERIZE_MODEL_MAX_COUNT)
@@ -1015,6 +1236,7 @@ void GlobalSignDistanceFieldPass::RasterizeHeightfield(Actor* actor, GPUTexture*
         return;
     const bool dynamic = !GLOBAL_SDF_ACTOR_IS_STATIC(actor);
     const int32 residentMipLevels = heightfield->ResidentMipLevels();
+    const uint32 objectHash = GetRasterizeObjectHash(actor, heightfield, localToWorld, residentMipLevels);
     if (residentMipLevels != 0)
     {
         // Setup object data
@@ -1048,6 +1270,7 @@ void GlobalSignDistanceFieldPass::RasterizeHeightfield(Actor* actor, GPUTexture*
                     key.Hash = key.Coord.Z * (RasterizeChunkKeyHashResolution * RasterizeChunkKeyHashResolution) + key.Coord.Y * RasterizeChunkKeyHashResolution + key.Coord.X;
                     RasterizeChunk* chunk = &chunks[key];
                     chunk->Dynamic |= dynamic;
+                    CombineHash(chunk->ObjectsHash, objectHash);
 
                     // Move to the next layer if chunk has overflown
                     while (chunk->HeightfieldsCount == GLOBAL_SDF_RASTERIZE_HEIGHTFIELD_MAX_COUNT)
@@ -4,6 +4,8 @@
 
 #include "RendererPass.h"
 #include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Platform/CriticalSection.h"
 
 /// <summary>
 /// Global Sign Distance Field (SDF) rendering pass. Composites scene geometry into series of 3D volume textures that cover the world around the camera for global distance field sampling.
@@ -29,6 +31,23 @@ class FLAXENGINE_API GlobalSignDistanceFieldPass : public RendererPass<GlobalSig
         ConstantsData Constants;
     };
 
+    // CPU-side copy of the Global SDF mip (low-resolution distance field) for the gameplay simulation queries (eg. CPU particles collisions).
+    struct FLAXENGINE_API CPUData
+    {
+        ConstantsData Constants;
+        int32 Resolution = 0;
+        Array<float> Distances;
+
+        // Samples the distance to the closest surface (in world units) at the given world location. Returns false if location is outside the Global SDF.
+        bool Sample(const Float3& worldPosition, float& distance) const;
+
+        // Samples the gradient vector (derivative) at the given world location. Normalize it to get normal vector.
+        Float3 SampleGradient(const Float3& worldPosition) const;
+
+    private:
+        float SampleCascade(int32 cascade, const Float3& cascadeUV) const;
+    };
+
 private:
     bool _supported = false;
     AssetReference<Shader> _shader;
@@ -38,6 +57,7 @@ class FLAXENGINE_API GlobalSignDistanceFieldPass : public RendererPass<GlobalSig
     GPUShaderProgramCS* _csRasterizeHeightfield = nullptr;
     GPUShaderProgramCS* _csClearChunk = nullptr;
     GPUShaderProgramCS* _csGenerateMip = nullptr;
+    GPUShaderProgramCS* _csReadback = nullptr;
     GPUConstantBuffer* _cb0 = nullptr;
     GPUConstantBuffer* _cb1 = nullptr;
 
@@ -53,6 +73,17 @@ class FLAXENGINE_API GlobalSignDistanceFieldPass : public RendererPass<GlobalSig
     Vector3 _sdfDataOriginMin;
     Vector3 _sdfDataOriginMax;
 
+    // CPU readback
+    CriticalSection _cpuDataLocker;
+    CPUData _cpuData;
+    bool _cpuDataRequested = false;
+    bool _readbackPending = false;
+    uint64 _readbackFrame = 0;
+    int32 _readbackResolution = 0;
+    ConstantsData _readbackConstants;
+    GPUBuffer* _readbackBuffer = nullptr;
+    GPUBuffer* _readbackStagingBuffer = nullptr;
+
 public:
     /// <summary>
     /// Gets the Global SDF (only if enabled in Graphics Settings).
@@ -79,6 +110,17 @@ class FLAXENGINE_API GlobalSignDistanceFieldPass : public RendererPass<GlobalSig
     /// <param name="output">The output buffer.</param>
     void RenderDebug(RenderContext& renderContext, GPUContext* context, GPUTexture* output);
 
+    /// <summary>
+    /// Locks and gets the CPU-side copy of the Global SDF mip (downloaded from the GPU every few frames with a latency). Requests the readback for the next frames. Valid only if Global SDF is enabled in Graphics Settings. Call UnlockCPUData after use.
+    /// </summary>
+    /// <returns>The Global SDF data (Resolution is 0 if data is not yet available).</returns>
+    const CPUData& LockCPUData();
+
+    /// <summary>
+    /// Unlocks the CPU-side copy of the Global SDF after LockCPUData.
+    /// </summary>
+    void UnlockCPUData();
+
     void GetCullingData(BoundingBox& bounds) const
     {
         bounds = _cascadeCullingBounds;
@@ -90,6 +132,7 @@ class FLAXENGINE_API GlobalSignDistanceFieldPass : public RendererPass<GlobalSig
     void RasterizeHeightfield(Actor* actor, GPUTexture* heightfield, const Transform& localToWorld, const BoundingBox& objectBounds, const Float4& localToUV);
 
 private:
+    void UpdateCPUData(GPUContext* context, GPUTexture* textureMip, int32 resolutionMip, const ConstantsData& constants);
 #if COMPILE_WITH_DEV_ENV
     void OnShaderReloading(Asset* obj);
 #endif
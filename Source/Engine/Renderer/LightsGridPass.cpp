@@ -0,0 +1,184 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "LightsGridPass.h"
+#include "RenderList.h"
+#include "Engine/Core/Math/Int3.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/RenderTask.h"
+
+namespace
+{
+    struct LightClusters
+    {
+        Int3 Min;
+        Int3 Max;
+    };
+
+    bool GetLightClusters(const RenderView& view, const Float3& position, float radius, float depthScale, float depthBias, LightClusters& result)
+    {
+        // Depth range
+        Float3 viewPos;
+        Float3::Transform(position, view.View, viewPos);
+        const float zMin = viewPos.Z - radius;
+        const float zMax = viewPos.Z + radius;
+        if (zMax < view.Near || zMin > view.Far)
+            return false;
+        const float nearPlane = Math::Max(view.Near, 1.0f);
+        result.Min.Z = Math::Clamp((int32)(Math::Log(Math::Max(zMin, nearPlane)) * depthScale + depthBias), 0, LIGHTS_GRID_SIZE_Z - 1);
+        result.Max.Z = Math::Clamp((int32)(Math::Log(Math::Max(zMax, nearPlane)) * depthScale + depthBias), 0, LIGHTS_GRID_SIZE_Z - 1);
+
+        // Screen range (projected light bounds box, light that crosses the near plane covers the whole screen)
+        if (view.IsPerspectiveProjection() && zMin <= view.Near)
+        {
+            result.Min.X = result.Min.Y = 0;
+            result.Max.X = LIGHTS_GRID_SIZE_X - 1;
+            result.Max.Y = LIGHTS_GRID_SIZE_Y - 1;
+            return true;
+        }
+        Float2 ndcMin(MAX_float), ndcMax(MIN_float);
+        for (int32 i = 0; i < 8; i++)
+        {
+            const Float3 corner(viewPos.X + (i & 1 ? radius : -radius), viewPos.Y + (i & 2 ? radius : -radius), i & 4 ? zMax : zMin);
+            Float4 clip;
+            Float3::Transform(corner, view.Projection, clip);
+            const Float2 ndc(clip.X / clip.W, clip.Y / clip.W);
+            ndcMin = Float2::Min(ndcMin, ndc);
+            ndcMax = Float2::Max(ndcMax, ndc);
+        }
+        if (ndcMax.X < -1.0f || ndcMin.X > 1.0f || ndcMax.Y < -1.0f || ndcMin.Y > 1.0f)
+            return false;
+        result.Min.X = Math::Clamp((int32)((ndcMin.X * 0.5f + 0.5f) * LIGHTS_GRID_SIZE_X), 0, LIGHTS_GRID_SIZE_X - 1);
+        result.Max.X = Math::Clamp((int32)((ndcMax.X * 0.5f + 0.5f) * LIGHTS_GRID_SIZE_X), 0, LIGHTS_GRID_SIZE_X - 1);
+        result.Min.Y = Math::Clamp((int32)((0.5f - ndcMax.Y * 0.5f) * LIGHTS_GRID_SIZE_Y), 0, LIGHTS_GRID_SIZE_Y - 1);
+        result.Max.Y = Math::Clamp((int32)((0.5f - ndcMin.Y * 0.5f) * LIGHTS_GRID_SIZE_Y), 0, LIGHTS_GRID_SIZE_Y - 1);
+        return true;
+    }
+}
+
+LightsGridPass::LightsGridPass()
+    : _lights(64 * sizeof(LightData), sizeof(LightData), false, TEXT("LightsGrid.Lights"))
+    , _clusters(LIGHTS_GRID_SIZE_X * LIGHTS_GRID_SIZE_Y * LIGHTS_GRID_SIZE_Z * sizeof(uint32) * 2, PixelFormat::R32G32_UInt, false, TEXT("LightsGrid.Clusters"))
+    , _indices(4096 * sizeof(uint32), PixelFormat::R32_UInt, false, TEXT("LightsGrid.Indices"))
+{
+    Platform::MemoryClear(&_data, sizeof(_data));
+}
+
+String LightsGridPass::ToString() const
+{
+    return TEXT("LightsGridPass");
+}
+
+void LightsGridPass::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    _list = nullptr;
+    _lights.Dispose();
+    _clusters.Dispose();
+    _indices.Dispose();
+}
+
+void LightsGridPass::Render(const RenderContext& renderContext, GPUContext* context)
+{
+    _list = nullptr;
+    const RenderList* list = renderContext.List;
+    const RenderView& view = renderContext.View;
+    const int32 lightsCount = Math::Min(list->PointLights.Count() + list->SpotLights.Count(), LIGHTS_GRID_MAX_LIGHTS);
+    if (lightsCount == 0 ||
+        list->DrawCallsLists[(int32)DrawCallsListType::Forward].IsEmpty() ||
+        GPUDevice::Instance->GetFeatureLevel() < FeatureLevel::SM5)
+        return;
+    PROFILE_CPU();
+    const float nearPlane = Math::Max(view.Near, 1.0f);
+    const float depthRangeLog = Math::Log(Math::Max(view.Far, nearPlane + 1.0f) / nearPlane);
+    const float depthScale = LIGHTS_GRID_SIZE_Z / depthRangeLog;
+    const float depthBias = -LIGHTS_GRID_SIZE_Z * Math::Log(nearPlane) / depthRangeLog;
+
+    // Find the clusters range of each light
+    Array<LightClusters, RendererAllocation> lightsClusters;
+    lightsClusters.Resize(lightsCount);
+    _lights.Clear();
+    LightData* lights = _lights.WriteReserve<LightData>(lightsCount);
+    int32 lightIndex = 0;
+    for (int32 i = 0; i < list->PointLights.Count() && lightIndex < lightsCount; i++)
+    {
+        const auto& light = list->PointLights.Get()[i];
+        if (GetLightClusters(view, light.Position, light.Radius, depthScale, depthBias, lightsClusters[lightIndex]))
+            light.SetupLightData(&lights[lightIndex++], false);
+    }
+    for (int32 i = 0; i < list->SpotLights.Count() && lightIndex < lightsCount; i++)
+    {
+        const auto& light = list->SpotLights.Get()[i];
+        if (GetLightClusters(view, light.Position, light.Radius, depthScale, depthBias, lightsClusters[lightIndex]))
+            light.SetupLightData(&lights[lightIndex++], false);
+    }
+    if (lightIndex == 0)
+        return;
+    _lights.Data.Resize(lightIndex * sizeof(LightData));
+
+    // Count lights per cluster
+    _clusters.Clear();
+    uint32* clusters = _clusters.WriteReserve<uint32>(LIGHTS_GRID_SIZE_X * LIGHTS_GRID_SIZE_Y * LIGHTS_GRID_SIZE_Z * 2);
+    Platform::MemoryClear(clusters, LIGHTS_GRID_SIZE_X * LIGHTS_GRID_SIZE_Y * LIGHTS_GRID_SIZE_Z * 2 * sizeof(uint32));
+#define CLUSTER_INDEX(x, y, z) (((z) * LIGHTS_GRID_SIZE_Y + (y)) * LIGHTS_GRID_SIZE_X + (x))
+#define FOR_EACH_LIGHT_CLUSTER(e) \
+    for (int32 z = e.Min.Z; z <= e.Max.Z; z++) \
+        for (int32 y = e.Min.Y; y <= e.Max.Y; y++) \
+            for (int32 x = e.Min.X; x <= e.Max.X; x++)
+    for (int32 i = 0; i < lightIndex; i++)
+    {
+        const LightClusters& e = lightsClusters.Get()[i];
+        FOR_EACH_LIGHT_CLUSTER(e)
+        {
+            uint32& count = clusters[CLUSTER_INDEX(x, y, z) * 2 + 1];
+            count = Math::Min<uint32>(count + 1, LIGHTS_GRID_MAX_CLUSTER_LIGHTS);
+        }
+    }
+
+    // Allocate clusters ranges within the indices buffer
+    uint32 indicesCount = 0;
+    for (int32 i = 0; i < LIGHTS_GRID_SIZE_X * LIGHTS_GRID_SIZE_Y * LIGHTS_GRID_SIZE_Z; i++)
+    {
+        clusters[i * 2] = indicesCount;
+        indicesCount += clusters[i * 2 + 1];
+        clusters[i * 2 + 1] = 0;
+    }
+
+    // Write lights indices
+    _indices.Clear();
+    uint32* indices = _indices.WriteReserve<uint32>(Math::Max<int32>(indicesCount, 1));
+    for (int32 i = 0; i < lightIndex; i++)
+    {
+        const LightClusters& e = lightsClusters.Get()[i];
+        FOR_EACH_LIGHT_CLUSTER(e)
+        {
+            uint32* cluster = &clusters[CLUSTER_INDEX(x, y, z) * 2];
+            if (cluster[1] < LIGHTS_GRID_MAX_CLUSTER_LIGHTS)
+                indices[cluster[0] + cluster[1]++] = i;
+        }
+    }
+#undef FOR_EACH_LIGHT_CLUSTER
+#undef CLUSTER_INDEX
+
+    // Upload grid
+    _lights.Flush(context);
+    _clusters.Flush(context);
+    _indices.Flush(context);
+    _data.Lights = _lights.GetBuffer();
+    _data.Clusters = _clusters.GetBuffer();
+    _data.Indices = _indices.GetBuffer();
+    _data.GridSize[0] = LIGHTS_GRID_SIZE_X;
+    _data.GridSize[1] = LIGHTS_GRID_SIZE_Y;
+    _data.GridSize[2] = LIGHTS_GRID_SIZE_Z;
+    _data.DepthScale = depthScale;
+    _data.DepthBias = depthBias;
+    _list = list;
+}
+
+void LightsGridPass::Reset()
+{
+    _list = nullptr;
+}
@@ -0,0 +1,85 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "RendererPass.h"
+#include "Engine/Graphics/DynamicBuffer.h"
+
+// The amount of the light grid tiles along the screen width
+#define LIGHTS_GRID_SIZE_X 16
+
+// The amount of the light grid tiles along the screen height
+#define LIGHTS_GRID_SIZE_Y 9
+
+// The amount of the light grid depth slices (distributed exponentially between the view near and far planes)
+#define LIGHTS_GRID_SIZE_Z 24
+
+// The maximum amount of the local lights binned into the grid
+#define LIGHTS_GRID_MAX_LIGHTS 1024
+
+// The maximum amount of the lights affecting a single grid cluster
+#define LIGHTS_GRID_MAX_CLUSTER_LIGHTS 64
+
+/// <summary>
+/// Clustered lights grid pass. Bins the view local lights (point and spot) into the froxels (screen tiles with exponential depth slices) so forward shading can iterate only the lights affecting the shaded pixel.
+/// </summary>
+class LightsGridPass : public RendererPass<LightsGridPass>
+{
+public:
+    /// <summary>
+    /// The grid data for the shaders.
+    /// </summary>
+    struct BindingData
+    {
+        // The lights data (LightData structures).
+        GPUBuffer* Lights;
+        // The grid clusters data (uint2 with lights offset and count) stored as [z][y][x] array.
+        GPUBuffer* Clusters;
+        // The lights indices within clusters.
+        GPUBuffer* Indices;
+        uint32 GridSize[3];
+        float DepthScale;
+        float DepthBias;
+    };
+
+private:
+    DynamicStructuredBuffer _lights;
+    DynamicTypedBuffer _clusters;
+    DynamicTypedBuffer _indices;
+    const class RenderList* _list = nullptr;
+    BindingData _data;
+
+public:
+    /// <summary>
+    /// Initializes a new instance of the <see cref="LightsGridPass"/> class.
+    /// </summary>
+    LightsGridPass();
+
+public:
+    /// <summary>
+    /// Builds the lights grid for the rendering view and uploads it to the GPU. Grid stays valid until Reset.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="context">The GPU context.</param>
+    void Render(const RenderContext& renderContext, GPUContext* context);
+
+    /// <summary>
+    /// Invalidates the lights grid built for the last view.
+    /// </summary>
+    void Reset();
+
+    /// <summary>
+    /// Gets the lights grid for the given render list.
+    /// </summary>
+    /// <param name="list">The render list to get the grid for.</param>
+    /// <returns>The grid binding data or null if grid is not built for the render list.</returns>
+    const BindingData* Get(const RenderList* list) const
+    {
+        return _list && _list == list ? &_data : nullptr;
+    }
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    void Dispose() override;
+};
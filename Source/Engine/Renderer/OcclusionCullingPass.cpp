@@ -0,0 +1,330 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "OcclusionCullingPass.h"
+#include "RenderList.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Graphics/GPUBuffer.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPULimits.h"
+#include "Engine/Graphics/Graphics.h"
+#include "Engine/Graphics/RenderTargetPool.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Graphics/RenderTools.h"
+#include "Engine/Graphics/Shaders/GPUShader.h"
+
+#define THREADGROUP_SIZE 64
+
+// The maximum amount of queries tested in a single frame (limited by the dispatch size)
+#define OCCLUSION_CULLING_MAX_QUERIES (65535 * THREADGROUP_SIZE)
+
+// The view movement limits between the queries and applying their results (results are dropped on larger camera changes, eg. camera cut)
+#define OCCLUSION_CULLING_MAX_MOVE_DISTANCE 200.0f
+#define OCCLUSION_CULLING_MIN_DIRECTION_DOT 0.95f
+
+PACK_STRUCT(struct Data {
+    Matrix ViewProjectionMatrix;
+    Float3 ViewPosition;
+    uint32 QueriesCount;
+    Float2 HZBSize;
+    Int2 InputSize;
+    Int2 HZBResolution;
+    uint32 HZBMips;
+    float Dummy0;
+    });
+
+OcclusionCullingData::~OcclusionCullingData()
+{
+    for (Readback& readback : _readbacks)
+        SAFE_DELETE_GPU_RESOURCE(readback.Buffer);
+    SAFE_DELETE_GPU_RESOURCE(_queriesBuffer);
+    SAFE_DELETE_GPU_RESOURCE(_resultsBuffer);
+    if (_hzb.Texture)
+        RenderTargetPool::Release(_hzb.Texture);
+}
+
+const OcclusionCullingData::HZB* OcclusionCullingData::GetHZB(const RenderView& view) const
+{
+    if (!_hzb.Texture ||
+        _hzb.Frame >= Engine::FrameCount ||
+        Vector3::Distance(_hzb.Origin + _hzb.ViewPosition, view.Origin + view.Position) > OCCLUSION_CULLING_MAX_MOVE_DISTANCE ||
+        Float3::Dot(_hzb.ViewDirection, view.Direction) < OCCLUSION_CULLING_MIN_DIRECTION_DOT)
+        return nullptr;
+    return &_hzb;
+}
+
+void OcclusionCullingData::Reset()
+{
+    _occluded.Clear();
+    _queries.Clear();
+    for (Readback& readback : _readbacks)
+    {
+        readback.Objects.Clear();
+        readback.Frame = 0;
+    }
+}
+
+String OcclusionCullingPass::ToString() const
+{
+    return TEXT("OcclusionCullingPass");
+}
+
+bool OcclusionCullingPass::Init()
+{
+    // Compute shaders support is required for this implementation
+    const auto device = GPUDevice::Instance;
+    if (!device->Limits.HasCompute || device->GetFeatureLevel() < FeatureLevel::SM5)
+        return false;
+
+    // Create pipeline state
+    _psHZB = device->CreatePipelineState();
+
+    // Load asset
+    _shader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/OcclusionCulling"));
+    if (_shader == nullptr)
+        return true;
+#if COMPILE_WITH_DEV_ENV
+    _shader.Get()->OnReloading.Bind<OcclusionCullingPass, &OcclusionCullingPass::OnShaderReloading>(this);
+#endif
+
+    return false;
+}
+
+bool OcclusionCullingPass::setupResources()
+{
+    // Skip if not supported (occlusion culling is not used)
+    if (!_shader)
+        return false;
+
+    // Check if shader has not been loaded
+    if (!_shader->IsLoaded())
+        return true;
+    const auto shader = _shader->GetShader();
+
+    // Validate shader constant buffer size
+    _cb = shader->GetCB(0);
+    if (_cb->GetSize() != sizeof(Data))
+    {
+        REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 0, Data);
+        return true;
+    }
+
+    // Create pipeline stages
+    if (!_psHZB->IsValid())
+    {
+        GPUPipelineState::Description psDesc = GPUPipelineState::Description::DefaultFullscreenTriangle;
+        psDesc.PS = shader->GetPS("PS_HZB");
+        if (_psHZB->Init(psDesc))
+            return true;
+    }
+    _testQueriesCS = shader->GetCS("CS_TestQueries");
+
+    return false;
+}
+
+void OcclusionCullingPass::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    SAFE_DELETE_GPU_RESOURCE(_psHZB);
+    _cb = nullptr;
+    _testQueriesCS = nullptr;
+    _shader = nullptr;
+}
+
+void OcclusionCullingPass::Prepare(RenderContext& renderContext)
+{
+    // Check if can use occlusion culling for this view (skip views that share the state with other tasks)
+    RenderView& view = renderContext.View;
+    if (!Graphics::OcclusionCulling ||
+        !_shader ||
+        view.IsOfflinePass ||
+        view.IsSingleFrame ||
+        renderContext.Buffers->LinkedCustomBuffers ||
+        !EnumHasAnyFlags(view.Pass, DrawPass::GBuffer) ||
+        checkIfSkipPass())
+        return;
+    auto& data = *renderContext.Buffers->GetCustomBuffer<OcclusionCullingData>(TEXT("OcclusionCulling"));
+    const uint64 currentFrame = Engine::FrameCount;
+    data.LastFrameUsed = currentFrame;
+    data._queries.Clear();
+    renderContext.List->Occlusion = &data;
+
+    // Apply the results from the previous frames (accept staging readback delay)
+    uint64 latestFrame = 0;
+    int32 latestIndex = -1;
+    for (int32 i = 0; i < ARRAY_COUNT(data._readbacks); i++)
+    {
+        const auto& readback = data._readbacks[i];
+        if (readback.Frame != 0 && currentFrame - readback.Frame > GPU_ASYNC_LATENCY && readback.Frame > latestFrame)
+        {
+            latestFrame = readback.Frame;
+            latestIndex = i;
+        }
+    }
+    if (latestIndex == -1)
+        return;
+    auto& readback = data._readbacks[latestIndex];
+    if (Vector3::Distance(readback.ViewPosition, view.Origin + view.Position) > OCCLUSION_CULLING_MAX_MOVE_DISTANCE ||
+        Float3::Dot(readback.ViewDirection, view.Direction) < OCCLUSION_CULLING_MIN_DIRECTION_DOT)
+    {
+        // Drop results on large camera changes to prevent culling the objects that has been disoccluded
+        data.Reset();
+        return;
+    }
+    const auto results = (const uint32*)readback.Buffer->Map(GPUResourceMapMode::Read);
+    if (results)
+    {
+        PROFILE_CPU_NAMED("Occlusion Culling Readback");
+        data._occluded.Clear();
+        const void* const* objects = readback.Objects.Get();
+        for (int32 i = 0; i < readback.Objects.Count(); i++)
+        {
+            if (results[i] == 0)
+                data._occluded.Add(objects[i]);
+        }
+        readback.Buffer->Unmap();
+    }
+
+    // Release older results too
+    for (auto& e : data._readbacks)
+    {
+        if (e.Frame != 0 && e.Frame <= latestFrame)
+            e.Frame = 0;
+    }
+}
+
+void OcclusionCullingPass::Render(RenderContext& renderContext, GPUContext* context)
+{
+    OcclusionCullingData* data = renderContext.List->Occlusion;
+    if (!data || (data->_queries.Count() == 0 && !data->_hzbRequested))
+        return;
+    int32 readbackIndex = -1;
+    for (int32 i = 0; i < ARRAY_COUNT(data->_readbacks) && readbackIndex == -1 && data->_queries.Count() != 0; i++)
+    {
+        if (data->_readbacks[i].Frame == 0)
+            readbackIndex = i;
+    }
+    if (readbackIndex == -1 && !data->_hzbRequested)
+        return;
+    data->_hzbRequested = false;
+    PROFILE_GPU_CPU("Occlusion Culling");
+    const RenderView& view = renderContext.View;
+
+    // Prepare queries
+    int32 queriesCount = 0;
+    Array<Float4, RendererAllocation> spheres;
+    if (readbackIndex != -1)
+    {
+        auto& readback = data->_readbacks[readbackIndex];
+        queriesCount = Math::Min(data->_queries.Count(), OCCLUSION_CULLING_MAX_QUERIES);
+        const OcclusionCullingData::Query* queries = data->_queries.Get();
+        readback.Objects.Resize(queriesCount, false);
+        spheres.Resize(queriesCount, false);
+        for (int32 i = 0; i < queriesCount; i++)
+        {
+            readback.Objects.Get()[i] = queries[i].Object;
+            spheres.Get()[i] = queries[i].Sphere;
+        }
+
+        // Setup resources
+        const uint32 resultsSize = queriesCount * sizeof(uint32);
+        if (!data->_queriesBuffer)
+        {
+            data->_queriesBuffer = GPUDevice::Instance->CreateBuffer(TEXT("OcclusionCulling.Queries"));
+            data->_resultsBuffer = GPUDevice::Instance->CreateBuffer(TEXT("OcclusionCulling.Results"));
+        }
+        if (data->_resultsBuffer->GetSize() < resultsSize)
+        {
+            const int32 capacity = Math::AlignUp<int32>(queriesCount + queriesCount / 4, 1024);
+            if (data->_queriesBuffer->Init(GPUBufferDescription::Structured(capacity, sizeof(Float4))) ||
+                data->_resultsBuffer->Init(GPUBufferDescription::Typed(capacity, PixelFormat::R32_UInt, true)))
+            {
+                LOG(Error, "Failed to setup occlusion culling resources.");
+                data->Reset();
+                return;
+            }
+        }
+        if (!readback.Buffer)
+            readback.Buffer = GPUDevice::Instance->CreateBuffer(TEXT("OcclusionCulling.Readback"));
+        if (readback.Buffer->GetSize() < resultsSize)
+        {
+            const int32 capacity = Math::AlignUp<int32>(queriesCount + queriesCount / 4, 1024);
+            if (readback.Buffer->Init(GPUBufferDescription::Buffer(capacity * sizeof(uint32), GPUBufferFlags::None, PixelFormat::R32_UInt, nullptr, sizeof(uint32), GPUResourceUsage::StagingReadback)))
+            {
+                LOG(Error, "Failed to setup occlusion culling resources.");
+                data->Reset();
+                return;
+            }
+        }
+    }
+    data->_queries.Clear();
+
+    // Build Hierarchical-Z buffer (first mip is half-res of the depth buffer)
+    GPUTexture* depthBuffer = renderContext.Buffers->DepthBuffer;
+    const int32 hzbWidth = Math::Max((depthBuffer->Width() + 1) / 2, 1);
+    const int32 hzbHeight = Math::Max((depthBuffer->Height() + 1) / 2, 1);
+    const int32 hzbMips = MipLevelsCount(hzbWidth, hzbHeight);
+    auto hzb = RenderTargetPool::Get(GPUTextureDescription::New2D(hzbWidth, hzbHeight, hzbMips, PixelFormat::R32_Float, GPUTextureFlags::ShaderResource | GPUTextureFlags::RenderTarget | GPUTextureFlags::PerMipViews));
+    RENDER_TARGET_POOL_SET_NAME(hzb, "OcclusionCulling.HZB");
+    Data cbData;
+    Matrix::Transpose(view.ViewProjection(), cbData.ViewProjectionMatrix);
+    cbData.ViewPosition = view.Position;
+    cbData.QueriesCount = queriesCount;
+    cbData.HZBSize = Float2((float)depthBuffer->Width() * 0.5f, (float)depthBuffer->Height() * 0.5f);
+    cbData.HZBResolution = Int2(hzbWidth, hzbHeight);
+    cbData.HZBMips = hzbMips;
+    cbData.Dummy0 = 0.0f;
+    context->ResetSR();
+    context->ResetRenderTarget();
+    context->SetState(_psHZB);
+    for (int32 mip = 0; mip < hzbMips; mip++)
+    {
+        const int32 mipWidth = Math::Max(hzbWidth >> mip, 1);
+        const int32 mipHeight = Math::Max(hzbHeight >> mip, 1);
+        GPUTextureView* input = mip == 0 ? depthBuffer->View() : hzb->View(0, mip - 1);
+        cbData.InputSize = mip == 0 ? Int2(depthBuffer->Width(), depthBuffer->Height()) : Int2(Math::Max(hzbWidth >> (mip - 1), 1), Math::Max(hzbHeight >> (mip - 1), 1));
+        context->UpdateCB(_cb, &cbData);
+        context->BindCB(0, _cb);
+        context->SetViewportAndScissors((float)mipWidth, (float)mipHeight);
+        context->SetRenderTarget(hzb->View(0, mip));
+        context->BindSR(0, input);
+        context->DrawFullscreenTriangle();
+        context->ResetRenderTarget();
+    }
+    context->UnBindSR(0);
+
+    // Test queries
+    if (queriesCount != 0)
+    {
+        auto& readback = data->_readbacks[readbackIndex];
+        context->UpdateBuffer(data->_queriesBuffer, spheres.Get(), queriesCount * sizeof(Float4));
+        context->BindSR(0, hzb);
+        context->BindSR(1, data->_queriesBuffer->View());
+        context->BindUA(0, data->_resultsBuffer->View());
+        context->Dispatch(_testQueriesCS, (queriesCount + THREADGROUP_SIZE - 1) / THREADGROUP_SIZE, 1, 1);
+        context->ResetUA();
+        context->ResetSR();
+
+        // Copy results for the CPU readback
+        readback.Frame = Engine::FrameCount;
+        readback.ViewPosition = view.Origin + view.Position;
+        readback.ViewDirection = view.Direction;
+        context->CopyBuffer(readback.Buffer, data->_resultsBuffer, queriesCount * sizeof(uint32));
+    }
+    context->SetViewportAndScissors((float)renderContext.Buffers->GetWidth(), (float)renderContext.Buffers->GetHeight());
+
+    // Keep the Hierarchical-Z buffer for the GPU-driven culling in the next frame
+    if (data->_hzb.Texture)
+        RenderTargetPool::Release(data->_hzb.Texture);
+    data->_hzb.Texture = hzb;
+    data->_hzb.ViewProjection = cbData.ViewProjectionMatrix;
+    data->_hzb.Origin = view.Origin;
+    data->_hzb.ViewPosition = view.Position;
+    data->_hzb.ViewDirection = view.Direction;
+    data->_hzb.Size = cbData.HZBSize;
+    data->_hzb.Frame = Engine::FrameCount;
+}
@@ -0,0 +1,145 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "RendererPass.h"
+#include "RenderListBuffer.h"
+#include "Engine/Core/Collections/HashSet.h"
+#include "Engine/Core/Math/BoundingSphere.h"
+#include "Engine/Graphics/RenderBuffers.h"
+#include "Engine/Graphics/Async/GPUSyncPoint.h"
+
+/// <summary>
+/// The per-view occlusion culling state. Collects the bounds of the objects drawn in the main view to test them against the Hierarchical-Z buffer and holds the visibility results read back from the previous frames.
+/// </summary>
+class FLAXENGINE_API OcclusionCullingData : public RenderBuffers::CustomBuffer
+{
+    friend class OcclusionCullingPass;
+
+public:
+    struct Query
+    {
+        const void* Object;
+        Float4 Sphere;
+    };
+
+    struct Readback
+    {
+        GPUBuffer* Buffer = nullptr;
+        Array<const void*> Objects;
+        uint64 Frame = 0;
+        Vector3 ViewPosition;
+        Float3 ViewDirection;
+    };
+
+    /// <summary>
+    /// The Hierarchical-Z buffer built from the scene depth of the previous frame. Can be used by the GPU-driven culling (eg. foliage instances) before the scene depth of the current frame is ready.
+    /// </summary>
+    struct HZB
+    {
+        GPUTexture* Texture = nullptr;
+        // The view-projection matrix (transposed for the shaders) of the view-relative world space (see RenderView::Origin).
+        Matrix ViewProjection;
+        Vector3 Origin;
+        Float3 ViewPosition;
+        Float3 ViewDirection;
+        Float2 Size;
+        uint64 Frame = 0;
+    };
+
+private:
+    HashSet<const void*> _occluded;
+    RenderListBuffer<Query> _queries;
+    Readback _readbacks[GPU_ASYNC_LATENCY + 1];
+    GPUBuffer* _queriesBuffer = nullptr;
+    GPUBuffer* _resultsBuffer = nullptr;
+    HZB _hzb;
+    bool _hzbRequested = false;
+
+public:
+    ~OcclusionCullingData();
+
+    /// <summary>
+    /// Checks if the object was occluded in the latest visibility results (objects not tested before are visible).
+    /// </summary>
+    /// <param name="object">The object (eg. actor or foliage cluster).</param>
+    /// <returns>True if object is occluded and can be skipped from drawing in this view, otherwise false.</returns>
+    FORCE_INLINE bool IsOccluded(const void* object) const
+    {
+        return _occluded.Contains(object);
+    }
+
+    /// <summary>
+    /// Adds the object to test its visibility against the depth buffer of the current frame. Results are used in the next frames (with a latency of the GPU readback). Thread-safe.
+    /// </summary>
+    /// <param name="object">The object (eg. actor or foliage cluster).</param>
+    /// <param name="bounds">The object bounds (in view-relative world space, see RenderView::Origin).</param>
+    FORCE_INLINE void AddQuery(const void* object, const BoundingSphere& bounds)
+    {
+        _queries.Add({ object, Float4((float)bounds.Center.X, (float)bounds.Center.Y, (float)bounds.Center.Z, (float)bounds.Radius) });
+    }
+
+    /// <summary>
+    /// Requests building the Hierarchical-Z buffer in the current frame even if there are no queries to test (eg. to be used by the GPU-driven culling in the next frames). Thread-safe.
+    /// </summary>
+    FORCE_INLINE void RequestHZB()
+    {
+        _hzbRequested = true;
+    }
+
+    /// <summary>
+    /// Gets the Hierarchical-Z buffer from the previous frame if it can be used for culling in the given view (it's dropped on large camera changes to prevent culling the objects that has been disoccluded).
+    /// </summary>
+    /// <param name="view">The current render view.</param>
+    /// <returns>The Hierarchical-Z buffer data or null if not available.</returns>
+    const HZB* GetHZB(const RenderView& view) const;
+
+    /// <summary>
+    /// Clears the visibility results.
+    /// </summary>
+    void Reset();
+};
+
+/// <summary>
+/// Hierarchical-Z occlusion culling pass. Builds the Hierarchical-Z buffer from the scene depth and tests the bounds of the objects drawn in the main view against it on a GPU. Results are read back (asynchronously) and used for culling objects in the next frames.
+/// </summary>
+class OcclusionCullingPass : public RendererPass<OcclusionCullingPass>
+{
+private:
+    AssetReference<Shader> _shader;
+    GPUPipelineState* _psHZB = nullptr;
+    GPUConstantBuffer* _cb = nullptr;
+    GPUShaderProgramCS* _testQueriesCS = nullptr;
+
+public:
+    /// <summary>
+    /// Prepares the occlusion culling for the view before drawing the scene. Applies the results from the previous frames and links the occlusion culling state with the render list.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    void Prepare(RenderContext& renderContext);
+
+    /// <summary>
+    /// Builds the Hierarchical-Z buffer and tests the collected queries against it. Must be called after the scene depth rendering.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="context">The GPU context.</param>
+    void Render(RenderContext& renderContext, GPUContext* context);
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    bool Init() override;
+    void Dispose() override;
+#if COMPILE_WITH_DEV_ENV
+    void OnShaderReloading(Asset* obj)
+    {
+        _psHZB->ReleaseGPU();
+        _testQueriesCS = nullptr;
+        invalidateResources();
+    }
+#endif
+
+protected:
+    // [RendererPass]
+    bool setupResources() override;
+};
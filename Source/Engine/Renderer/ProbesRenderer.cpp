@@ -92,11 +92,25 @@ namespace ProbesRendererImpl
     GPUTexture* _tmpFace = nullptr;
     GPUTexture* _skySHIrradianceMap = nullptr;
     uint64 _updateFrameNumber = 0;
+    int32 _updateStep = 0;
 
     FORCE_INLINE bool isUpdateSynced()
     {
         return _updateFrameNumber > 0 && _updateFrameNumber + PROBES_RENDERER_LATENCY_FRAMES <= Engine::FrameCount;
     }
+
+    void GetUpdatePriority(const ProbesRenderer::Entry& e, bool& isVisible, float& distance)
+    {
+        // Sky lights affect the whole scene so update them first, then probes visible by the main view (closest first)
+        isVisible = true;
+        distance = 0.0f;
+        if (e.Type != ProbesRenderer::EntryType::EnvProbe || !e.Actor || !MainRenderTask::Instance)
+            return;
+        const RenderView& view = MainRenderTask::Instance->View;
+        const BoundingSphere& sphere = e.Actor->GetSphere();
+        distance = Math::Max((float)(Vector3::Distance(view.Origin + view.Position, sphere.Center) - sphere.Radius), 0.0f);
+        isVisible = view.Frustum.Intersects(BoundingSphere(sphere.Center - view.Origin, sphere.Radius));
+    }
 }
 
 using namespace ProbesRendererImpl;
@@ -117,6 +131,7 @@ ProbesRendererService ProbesRendererServiceInstance;
 
 TimeSpan ProbesRenderer::ProbesUpdatedBreak(0, 0, 0, 0, 500);
 TimeSpan ProbesRenderer::ProbesReleaseDataTime(0, 0, 0, 60);
+int32 ProbesRenderer::UpdateStepsPerFrame = 1;
 Delegate<const ProbesRenderer::Entry&> ProbesRenderer::OnRegisterBake;
 Delegate<const ProbesRenderer::Entry&> ProbesRenderer::OnFinishBake;
 
@@ -311,6 +326,7 @@ void ProbesRenderer::Release()
     SAFE_DELETE_GPU_RESOURCE(_tmpFace);
     SAFE_DELETE_GPU_RESOURCE(_skySHIrradianceMap);
 
+    _updateStep = 0;
     _isReady = false;
 }
 
@@ -348,15 +364,25 @@ void ProbesRendererService::Update()
     }
     else if (_current.Type == ProbesRenderer::EntryType::Invalid)
     {
+        // Pick the most important probe to update
         int32 firstValidEntryIndex = -1;
+        bool bestIsVisible = false;
+        float bestDistance = MAX_float;
         auto dt = (float)Time::Update.UnscaledDeltaTime.GetTotalSeconds();
         for (int32 i = 0; i < _probesToBake.Count(); i++)
         {
-            _probesToBake[i].Timeout -= dt;
-            if (_probesToBake[i].Timeout <= 0)
+            auto& e = _probesToBake[i];
+            e.Timeout -= dt;
+            if (e.Timeout > 0)
+                continue;
+            bool isVisible;
+            float distance;
+            GetUpdatePriority(e, isVisible, distance);
+            if (firstValidEntryIndex == -1 || (isVisible && !bestIsVisible) || (isVisible == bestIsVisible && distance < bestDistance))
             {
                 firstValidEntryIndex = i;
-                break;
+                bestIsVisible = isVisible;
+                bestDistance = distance;
             }
         }
 
@@ -376,6 +402,7 @@ void ProbesRendererService::Update()
             _probesToBake.RemoveAtKeepOrder(firstValidEntryIndex);
             _task->Enabled = true;
             _updateFrameNumber = 0;
+            _updateStep = 0;
 
             // Store time of the last probe update
             _lastProbeUpdate = timeNow;
@@ -418,6 +445,9 @@ void ProbesRenderer::OnRender(RenderTask* task, GPUContext* context)
         if (_current.Actor == nullptr)
         {
             // Probe has been unlinked (or deleted)
+            _task->Enabled = false;
+            _current.Type = EntryType::Invalid;
+            _updateStep = 0;
             return;
         }
         break;
@@ -434,87 +464,102 @@ void ProbesRenderer::OnRender(RenderTask* task, GPUContext* context)
     float customCullingNear = -1;
     const int32 probeResolution = _current.GetResolution();
     const PixelFormat probeFormat = _current.GetFormat();
-    if (_current.Type == EntryType::EnvProbe)
+    if (_current.Type == EntryType::SkyLight)
+        customCullingNear = ((SkyLight*)_current.Actor.Get())->SkyDistanceThreshold;
+    if (_updateStep == 0)
     {
-        auto envProbe = (EnvironmentProbe*)_current.Actor.Get();
-        Vector3 position = envProbe->GetPosition();
-        float radius = envProbe->GetScaledRadius();
-        float nearPlane = Math::Max(0.1f, envProbe->CaptureNearPlane);
-
-        // Adjust far plane distance
-        float farPlane = Math::Max(radius, nearPlane + 100.0f);
-        farPlane *= farPlane < 10000 ? 10 : 4;
-        Function<bool(Actor*, const Vector3&, float&)> f(&fixFarPlaneTreeExecute);
-        SceneQuery::TreeExecute<const Vector3&, float&>(f, position, farPlane);
-
-        // Setup view
-        LargeWorlds::UpdateOrigin(_task->View.Origin, position);
-        _task->View.SetUpCube(nearPlane, farPlane, position - _task->View.Origin);
-    }
-    else if (_current.Type == EntryType::SkyLight)
-    {
-        auto skyLight = (SkyLight*)_current.Actor.Get();
-        Vector3 position = skyLight->GetPosition();
-        float nearPlane = 10.0f;
-        float farPlane = Math::Max(nearPlane + 1000.0f, skyLight->SkyDistanceThreshold * 2.0f);
-        customCullingNear = skyLight->SkyDistanceThreshold;
-
-        // Setup view
-        LargeWorlds::UpdateOrigin(_task->View.Origin, position);
-        _task->View.SetUpCube(nearPlane, farPlane, position - _task->View.Origin);
+        if (_current.Type == EntryType::EnvProbe)
+        {
+            auto envProbe = (EnvironmentProbe*)_current.Actor.Get();
+            Vector3 position = envProbe->GetPosition();
+            float radius = envProbe->GetScaledRadius();
+            float nearPlane = Math::Max(0.1f, envProbe->CaptureNearPlane);
+
+            // Adjust far plane distance
+            float farPlane = Math::Max(radius, nearPlane + 100.0f);
+            farPlane *= farPlane < 10000 ? 10 : 4;
+            Function<bool(Actor*, const Vector3&, float&)> f(&fixFarPlaneTreeExecute);
+            SceneQuery::TreeExecute<const Vector3&, float&>(f, position, farPlane);
+
+            // Setup view
+            LargeWorlds::UpdateOrigin(_task->View.Origin, position);
+            _task->View.SetUpCube(nearPlane, farPlane, position - _task->View.Origin);
+        }
+        else if (_current.Type == EntryType::SkyLight)
+        {
+            auto skyLight = (SkyLight*)_current.Actor.Get();
+            Vector3 position = skyLight->GetPosition();
+            float nearPlane = 10.0f;
+            float farPlane = Math::Max(nearPlane + 1000.0f, skyLight->SkyDistanceThreshold * 2.0f);
+
+            // Setup view
+            LargeWorlds::UpdateOrigin(_task->View.Origin, position);
+            _task->View.SetUpCube(nearPlane, farPlane, position - _task->View.Origin);
+        }
+
+        // Resize buffers
+        bool resizeFailed = _output->Resize(probeResolution, probeResolution, probeFormat);
+        resizeFailed |= _probe->Resize(probeResolution, probeResolution, probeFormat);
+        resizeFailed |= _tmpFace->Resize(probeResolution, probeResolution, probeFormat);
+        resizeFailed |= _task->Resize(probeResolution, probeResolution);
+        if (resizeFailed)
+            LOG(Error, "Failed to resize probe");
     }
-    _task->CameraCut();
-
-    // Resize buffers
-    bool resizeFailed = _output->Resize(probeResolution, probeResolution, probeFormat);
-    resizeFailed |= _probe->Resize(probeResolution, probeResolution, probeFormat);
-    resizeFailed |= _tmpFace->Resize(probeResolution, probeResolution, probeFormat);
-    resizeFailed |= _task->Resize(probeResolution, probeResolution);
-    if (resizeFailed)
-        LOG(Error, "Failed to resize probe");
-
-    // Disable actor during baking (it cannot influence own results)
-    const bool isActorActive = _current.Actor->GetIsActive();
-    _current.Actor->SetIsActive(false);
-
-    // Render scene for all faces
-    for (int32 faceIndex = 0; faceIndex < 6; faceIndex++)
+
+    // Update is split into steps: 6 cube faces rendering followed by the lower mip levels filtering
+    const int32 mipLevels = _probe->MipLevels();
+    const int32 stepsCount = 6 + mipLevels - 1;
+    int32 stepsLeft = UpdateStepsPerFrame > 0 ? UpdateStepsPerFrame : stepsCount;
+
+    // Render scene for the cube faces
+    if (_updateStep < 6)
     {
-        _task->View.SetFace(faceIndex);
+        _task->CameraCut();
 
-        // Handle custom frustum for the culling (used to skip objects near the camera)
-        if (customCullingNear > 0)
+        // Disable actor during baking (it cannot influence own results)
+        const bool isActorActive = _current.Actor->GetIsActive();
+        _current.Actor->SetIsActive(false);
+
+        for (; _updateStep < 6 && stepsLeft > 0; _updateStep++, stepsLeft--)
         {
-            Matrix p;
-            Matrix::PerspectiveFov(PI_OVER_2, 1.0f, customCullingNear, _task->View.Far, p);
-            _task->View.CullingFrustum.SetMatrix(_task->View.View, p);
-        }
+            const int32 faceIndex = _updateStep;
+            _task->View.SetFace(faceIndex);
 
-        // Render frame
-        Renderer::Render(_task);
-        context->ClearState();
+            // Handle custom frustum for the culling (used to skip objects near the camera)
+            if (customCullingNear > 0)
+            {
+                Matrix p;
+                Matrix::PerspectiveFov(PI_OVER_2, 1.0f, customCullingNear, _task->View.Far, p);
+                _task->View.CullingFrustum.SetMatrix(_task->View.View, p);
+            }
 
-        // Copy frame to cube face
-        {
-            PROFILE_GPU("Copy Face");
-            context->SetRenderTarget(_probe->View(faceIndex));
-            context->SetViewportAndScissors((float)probeResolution, (float)probeResolution);
-            context->Draw(_output->View());
-            context->ResetRenderTarget();
+            // Render frame
+            Renderer::Render(_task);
+            context->ClearState();
+
+            // Copy frame to cube face
+            {
+                PROFILE_GPU("Copy Face");
+                context->SetRenderTarget(_probe->View(faceIndex));
+                context->SetViewportAndScissors((float)probeResolution, (float)probeResolution);
+                context->Draw(_output->View());
+                context->ResetRenderTarget();
+            }
         }
-    }
 
-    // Enable actor back
-    _current.Actor->SetIsActive(isActorActive);
+        // Enable actor back
+        _current.Actor->SetIsActive(isActorActive);
+    }
 
-    // Filter all lower mip levels
+    // Filter lower mip levels
+    if (_updateStep >= 6 && _updateStep < stepsCount && stepsLeft > 0)
     {
         PROFILE_GPU("Filtering");
         Data data;
-        int32 mipLevels = _probe->MipLevels();
         auto cb = shader->GetCB(0);
-        for (int32 mipIndex = 1; mipIndex < mipLevels; mipIndex++)
+        for (; _updateStep < stepsCount && stepsLeft > 0; _updateStep++, stepsLeft--)
         {
+            const int32 mipIndex = _updateStep - 6 + 1;
             const int32 mipSize = 1 << (mipLevels - mipIndex - 1);
             data.SourceMipIndex = (float)mipIndex - 1.0f;
             context->SetViewportAndScissors((float)mipSize, (float)mipSize);
@@ -544,6 +589,11 @@ void ProbesRenderer::OnRender(RenderTask* task, GPUContext* context)
     // Cleanup
     context->ClearState();
 
+    // Continue in the next frame (probe keeps using the old data until the new one is fully updated)
+    if (_updateStep < stepsCount)
+        return;
+    _updateStep = 0;
+
     // Mark as rendered
     _updateFrameNumber = Engine::FrameCount;
     _task->Enabled = false;
@@ -60,6 +60,11 @@ class ProbesRenderer
     /// </summary>
     static TimeSpan ProbesReleaseDataTime;
 
+    /// <summary>
+    /// Maximum amount of probe update steps to perform per frame (each step renders a single cube face or filters a single mip level). Probe update is spread over multiple frames to reduce the frame time spikes (probe keeps using the previous data until the update is done). Use 0 to update the whole probe within a single frame.
+    /// </summary>
+    static int32 UpdateStepsPerFrame;
+
     int32 GetBakeQueueSize();
 
     static Delegate<const Entry&> OnRegisterBake;
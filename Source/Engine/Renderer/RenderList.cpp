@@ -14,20 +14,30 @@
 #include "Engine/Profiler/Profiler.h"
 #include "Engine/Content/Assets/CubeTexture.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Threading/JobSystem.h"
+#include "Engine/Threading/ThreadLocal.h"
 #include "Engine/Level/Scene/Lightmap.h"
 #include "Engine/Level/Actors/PostFxVolume.h"
+#include "Utils/InstanceCulling.h"
 
 static_assert(sizeof(DrawCall) <= 288, "Too big draw call data size.");
 static_assert(sizeof(DrawCall::Surface) >= sizeof(DrawCall::Terrain), "Wrong draw call data size.");
 static_assert(sizeof(DrawCall::Surface) >= sizeof(DrawCall::Particle), "Wrong draw call data size.");
 static_assert(sizeof(DrawCall::Surface) >= sizeof(DrawCall::Custom), "Wrong draw call data size.");
 
+// The minimum amount of instances to write the instance buffer using jobs
+#define RENDER_LIST_INSTANCES_JOB_MIN_COUNT 4096
+
 namespace
 {
-    // Cached data for the draw calls sorting
-    Array<uint64> SortingKeys[2];
-    Array<int32> SortingIndices;
-    Array<DrawBatch> SortingBatches;
+    // Cached data for the draw calls sorting (one per thread to sort multiple lists in parallel)
+    struct SortingCache
+    {
+        Array<uint64> Keys[2];
+        Array<int32> Indices;
+    };
+
+    ThreadLocal<SortingCache*> SortingCaches;
     Array<RenderList*> FreeRenderList;
 
     struct MemPoolEntry
@@ -163,9 +173,10 @@ void RenderList::CleanupCache()
     // Don't call it during rendering (data may be already in use)
     ASSERT(GPUDevice::Instance == nullptr || GPUDevice::Instance->CurrentTask == nullptr);
 
-    SortingKeys[0].Resize(0);
-    SortingKeys[1].Resize(0);
-    SortingIndices.Resize(0);
+    Array<SortingCache*> sortingCaches;
+    SortingCaches.GetValues(sortingCaches);
+    sortingCaches.ClearDelete();
+    SortingCaches.Clear();
     FreeRenderList.ClearDelete();
     for (auto& e : MemPool)
         Platform::Free(e.Ptr);
@@ -395,8 +406,12 @@ void RenderList::Init(RenderContext& renderContext)
 void RenderList::Clear()
 {
     Scenes.Clear();
+    Occlusion = nullptr;
+    StaticFlagsFilterMask = StaticFlags::None;
+    StaticFlagsFilterValue = StaticFlags::None;
     DrawCalls.Clear();
     BatchedDrawCalls.Clear();
+    InstanceCullingJobs.Clear();
     for (auto& list : DrawCallsLists)
         list.Clear();
     ShadowDepthDrawCallsList.Clear();
@@ -431,18 +446,85 @@ struct PackedSortKey
     };
 };
 
-FORCE_INLINE void CalculateSortKey(const RenderContext& renderContext, DrawCall& drawCall, int16 sortOrder)
+FORCE_INLINE void CalculateDistanceKey(const RenderContext& renderContext, DrawCall& drawCall)
 {
     const Float3 planeNormal = renderContext.View.Direction;
     const float planePoint = -Float3::Dot(planeNormal, renderContext.View.Position);
     const float distance = Float3::Dot(planeNormal, drawCall.ObjectPosition) - planePoint;
     PackedSortKey key;
+    key.Data = drawCall.SortKey;
     key.DistanceKey = RenderTools::ComputeDistanceSortKey(distance);
+    drawCall.SortKey = key.Data;
+}
+
+FORCE_INLINE void CalculateSortKey(const RenderContext& renderContext, DrawCall& drawCall, int16 sortOrder)
+{
+    RenderList::CalculateBatchKey(drawCall, sortOrder);
+    CalculateDistanceKey(renderContext, drawCall);
+}
+
+FORCE_INLINE void AddDrawCallToLists(RenderList* list, int32 index, DrawPass drawModes, StaticFlags staticFlags, bool receivesDecals)
+{
+    if ((staticFlags & list->StaticFlagsFilterMask) != list->StaticFlagsFilterValue)
+        return;
+    if ((drawModes & DrawPass::Depth) != DrawPass::None)
+    {
+        list->DrawCallsLists[(int32)DrawCallsListType::Depth].Indices.Add(index);
+    }
+    if ((drawModes & (DrawPass::GBuffer | DrawPass::GlobalSurfaceAtlas)) != DrawPass::None)
+    {
+        if (receivesDecals)
+            list->DrawCallsLists[(int32)DrawCallsListType::GBuffer].Indices.Add(index);
+        else
+            list->DrawCallsLists[(int32)DrawCallsListType::GBufferNoDecals].Indices.Add(index);
+    }
+    if ((drawModes & DrawPass::Forward) != DrawPass::None)
+    {
+        list->DrawCallsLists[(int32)DrawCallsListType::Forward].Indices.Add(index);
+    }
+    if ((drawModes & DrawPass::Distortion) != DrawPass::None)
+    {
+        list->DrawCallsLists[(int32)DrawCallsListType::Distortion].Indices.Add(index);
+    }
+    if ((drawModes & DrawPass::MotionVectors) != DrawPass::None && (staticFlags & StaticFlags::Transform) == StaticFlags::None)
+    {
+        list->DrawCallsLists[(int32)DrawCallsListType::MotionVectors].Indices.Add(index);
+    }
+}
+
+FORCE_INLINE void AddDrawCallToLists(RenderList* list, int32 index, const RenderContextBatch& renderContextBatch, DrawPass drawModes, StaticFlags staticFlags, ShadowsCastingMode shadowsMode, const BoundingSphere& bounds, bool receivesDecals)
+{
+    const RenderContext& mainRenderContext = renderContextBatch.Contexts.Get()[0];
+    DrawPass modes = drawModes & mainRenderContext.View.GetShadowsDrawPassMask(shadowsMode);
+    drawModes = modes & mainRenderContext.View.Pass;
+    if (drawModes != DrawPass::None && mainRenderContext.View.CullingFrustum.Intersects(bounds))
+    {
+        AddDrawCallToLists(list, index, drawModes, staticFlags, receivesDecals);
+    }
+    for (int32 i = 1; i < renderContextBatch.Contexts.Count(); i++)
+    {
+        const RenderContext& renderContext = renderContextBatch.Contexts.Get()[i];
+        ASSERT_LOW_LAYER(renderContext.View.Pass == DrawPass::Depth);
+        drawModes = modes & renderContext.View.Pass;
+        if (drawModes != DrawPass::None && (staticFlags & renderContext.List->StaticFlagsFilterMask) == renderContext.List->StaticFlagsFilterValue && renderContext.View.CullingFrustum.Intersects(bounds))
+        {
+            renderContext.List->ShadowDepthDrawCallsList.Indices.Add(index);
+        }
+    }
+}
+
+void RenderList::CalculateBatchKey(DrawCall& drawCall, int16 sortOrder)
+{
+    PackedSortKey key;
+    key.DistanceKey = 0;
     uint32 batchKey = GetHash(drawCall.Material);
     batchKey = (batchKey * 397) ^ GetHash(drawCall.Geometry.VertexBuffers[0]);
     batchKey = (batchKey * 397) ^ GetHash(drawCall.Geometry.VertexBuffers[1]);
     batchKey = (batchKey * 397) ^ GetHash(drawCall.Geometry.VertexBuffers[2]);
     batchKey = (batchKey * 397) ^ GetHash(drawCall.Geometry.IndexBuffer);
+    batchKey = (batchKey * 397) ^ drawCall.Geometry.VertexBuffersOffsets[0];
+    if (drawCall.InstanceCount != 0)
+        batchKey = (batchKey * 397) ^ drawCall.Draw.StartIndex; // Meshes within the shared geometry pool differ only by the offsets
     IMaterial::InstancingHandler handler;
     if (drawCall.Material->CanUseInstancing(handler))
         handler.GetHash(drawCall, batchKey);
@@ -465,29 +547,7 @@ void RenderList::AddDrawCall(const RenderContext& renderContext, DrawPass drawMo
     const int32 index = DrawCalls.Add(drawCall);
 
     // Add draw call to proper draw lists
-    if ((drawModes & DrawPass::Depth) != DrawPass::None)
-    {
-        DrawCallsLists[(int32)DrawCallsListType::Depth].Indices.Add(index);
-    }
-    if ((drawModes & (DrawPass::GBuffer | DrawPass::GlobalSurfaceAtlas)) != DrawPass::None)
-    {
-        if (receivesDecals)
-            DrawCallsLists[(int32)DrawCallsListType::GBuffer].Indices.Add(index);
-        else
-            DrawCallsLists[(int32)DrawCallsListType::GBufferNoDecals].Indices.Add(index);
-    }
-    if ((drawModes & DrawPass::Forward) != DrawPass::None)
-    {
-        DrawCallsLists[(int32)DrawCallsListType::Forward].Indices.Add(index);
-    }
-    if ((drawModes & DrawPass::Distortion) != DrawPass::None)
-    {
-        DrawCallsLists[(int32)DrawCallsListType::Distortion].Indices.Add(index);
-    }
-    if ((drawModes & DrawPass::MotionVectors) != DrawPass::None && (staticFlags & StaticFlags::Transform) == StaticFlags::None)
-    {
-        DrawCallsLists[(int32)DrawCallsListType::MotionVectors].Indices.Add(index);
-    }
+    AddDrawCallToLists(this, index, drawModes, staticFlags, receivesDecals);
 }
 
 void RenderList::AddDrawCall(const RenderContextBatch& renderContextBatch, DrawPass drawModes, StaticFlags staticFlags, ShadowsCastingMode shadowsMode, const BoundingSphere& bounds, DrawCall& drawCall, bool receivesDecals, int16 sortOrder)
@@ -497,53 +557,72 @@ void RenderList::AddDrawCall(const RenderContextBatch& renderContextBatch, DrawP
     auto materialDrawModes = drawCall.Material->GetDrawModes();
     ASSERT_LOW_LAYER(drawModes != DrawPass::None && ((uint32)drawModes & ~(uint32)materialDrawModes) == 0);
 #endif
+
+    // Append draw call data
+    CalculateSortKey(renderContextBatch.Contexts.Get()[0], drawCall, sortOrder);
+    const int32 index = DrawCalls.Add(drawCall);
+
+    // Add draw call to proper draw lists
+    AddDrawCallToLists(this, index, renderContextBatch, drawModes, staticFlags, shadowsMode, bounds, receivesDecals);
+}
+
+void RenderList::AddShadowsDrawCall(const RenderContextBatch& renderContextBatch, DrawPass drawModes, StaticFlags staticFlags, ShadowsCastingMode shadowsMode, const BoundingSphere& bounds, DrawCall& drawCall, int16 sortOrder)
+{
     const RenderContext& mainRenderContext = renderContextBatch.Contexts.Get()[0];
+    const DrawPass modes = drawModes & mainRenderContext.View.GetShadowsDrawPassMask(shadowsMode);
+    if ((modes & DrawPass::Depth) == DrawPass::None || renderContextBatch.Contexts.Count() < 2)
+        return;
 
     // Append draw call data
     CalculateSortKey(mainRenderContext, drawCall, sortOrder);
     const int32 index = DrawCalls.Add(drawCall);
 
-    // Add draw call to proper draw lists
-    DrawPass modes = drawModes & mainRenderContext.View.GetShadowsDrawPassMask(shadowsMode);
-    drawModes = modes & mainRenderContext.View.Pass;
-    if (drawModes != DrawPass::None && mainRenderContext.View.CullingFrustum.Intersects(bounds))
-    {
-        if ((drawModes & DrawPass::Depth) != DrawPass::None)
-        {
-            DrawCallsLists[(int32)DrawCallsListType::Depth].Indices.Add(index);
-        }
-        if ((drawModes & (DrawPass::GBuffer | DrawPass::GlobalSurfaceAtlas)) != DrawPass::None)
-        {
-            if (receivesDecals)
-                DrawCallsLists[(int32)DrawCallsListType::GBuffer].Indices.Add(index);
-            else
-                DrawCallsLists[(int32)DrawCallsListType::GBufferNoDecals].Indices.Add(index);
-        }
-        if ((drawModes & DrawPass::Forward) != DrawPass::None)
-        {
-            DrawCallsLists[(int32)DrawCallsListType::Forward].Indices.Add(index);
-        }
-        if ((drawModes & DrawPass::Distortion) != DrawPass::None)
-        {
-            DrawCallsLists[(int32)DrawCallsListType::Distortion].Indices.Add(index);
-        }
-        if ((drawModes & DrawPass::MotionVectors) != DrawPass::None && (staticFlags & StaticFlags::Transform) == StaticFlags::None)
-        {
-            DrawCallsLists[(int32)DrawCallsListType::MotionVectors].Indices.Add(index);
-        }
-    }
+    // Add draw call to shadow projections draw lists
     for (int32 i = 1; i < renderContextBatch.Contexts.Count(); i++)
     {
         const RenderContext& renderContext = renderContextBatch.Contexts.Get()[i];
         ASSERT_LOW_LAYER(renderContext.View.Pass == DrawPass::Depth);
-        drawModes = modes & renderContext.View.Pass;
-        if (drawModes != DrawPass::None && renderContext.View.CullingFrustum.Intersects(bounds))
+        if ((modes & renderContext.View.Pass) != DrawPass::None && (staticFlags & renderContext.List->StaticFlagsFilterMask) == renderContext.List->StaticFlagsFilterValue && renderContext.View.CullingFrustum.Intersects(bounds))
         {
             renderContext.List->ShadowDepthDrawCallsList.Indices.Add(index);
         }
     }
 }
 
+void RenderList::AddCachedDrawCall(const RenderContext& renderContext, DrawPass drawModes, StaticFlags staticFlags, const DrawCall& drawCall, bool receivesDecals)
+{
+#if ENABLE_ASSERTION_LOW_LAYERS
+    // Ensure that draw modes are non-empty and in conjunction with material draw modes
+    auto materialDrawModes = drawCall.Material->GetDrawModes();
+    ASSERT_LOW_LAYER(drawModes != DrawPass::None && ((uint32)drawModes & ~(uint32)materialDrawModes) == 0);
+#endif
+
+    // Append draw call data (batch key is already calculated)
+    DrawCall copy = drawCall;
+    CalculateDistanceKey(renderContext, copy);
+    const int32 index = DrawCalls.Add(copy);
+
+    // Add draw call to proper draw lists
+    AddDrawCallToLists(this, index, drawModes, staticFlags, receivesDecals);
+}
+
+void RenderList::AddCachedDrawCall(const RenderContextBatch& renderContextBatch, DrawPass drawModes, StaticFlags staticFlags, ShadowsCastingMode shadowsMode, const BoundingSphere& bounds, const DrawCall& drawCall, bool receivesDecals)
+{
+#if ENABLE_ASSERTION_LOW_LAYERS
+    // Ensure that draw modes are non-empty and in conjunction with material draw modes
+    auto materialDrawModes = drawCall.Material->GetDrawModes();
+    ASSERT_LOW_LAYER(drawModes != DrawPass::None && ((uint32)drawModes & ~(uint32)materialDrawModes) == 0);
+#endif
+
+    // Append draw call data (batch key is already calculated)
+    DrawCall copy = drawCall;
+    CalculateDistanceKey(renderContextBatch.Contexts.Get()[0], copy);
+    const int32 index = DrawCalls.Add(copy);
+
+    // Add draw call to proper draw lists
+    AddDrawCallToLists(this, index, renderContextBatch, drawModes, staticFlags, shadowsMode, bounds, receivesDecals);
+}
+
 namespace
 {
     /// <summary>
@@ -560,6 +639,8 @@ namespace
                 Platform::MemoryCompare(&a.Geometry, &b.Geometry, sizeof(a.Geometry)) == 0 &&
                 a.InstanceCount != 0 &&
                 b.InstanceCount != 0 &&
+                a.Draw.StartIndex == b.Draw.StartIndex &&
+                a.Draw.IndicesCount == b.Draw.IndicesCount &&
                 handler.CanBatch(a, b) &&
                 a.WorldDeterminantSign * b.WorldDeterminantSign > 0;
     }
@@ -573,13 +654,16 @@ void RenderList::SortDrawCalls(const RenderContext& renderContext, bool reverseD
     const int32 listSize = list.Indices.Count();
     ZoneValue(listSize);
 
-    // Peek shared memory
+    // Peek thread-local memory
+    SortingCache*& cache = SortingCaches.Get();
+    if (!cache)
+        cache = New<SortingCache>();
 #define PREPARE_CACHE(list) (list).Clear(); (list).Resize(listSize)
-    PREPARE_CACHE(SortingKeys[0]);
-    PREPARE_CACHE(SortingKeys[1]);
-    PREPARE_CACHE(SortingIndices);
+    PREPARE_CACHE(cache->Keys[0]);
+    PREPARE_CACHE(cache->Keys[1]);
+    PREPARE_CACHE(cache->Indices);
 #undef PREPARE_CACHE
-    uint64* sortedKeys = SortingKeys[0].Get();
+    uint64* sortedKeys = cache->Keys[0].Get();
 
     // Setup sort keys
     if (reverseDistance)
@@ -605,7 +689,7 @@ void RenderList::SortDrawCalls(const RenderContext& renderContext, bool reverseD
 
     // Sort draw calls indices
     int32* resultIndices = list.Indices.Get();
-    Sorting::RadixSort(sortedKeys, resultIndices, SortingKeys[1].Get(), SortingIndices.Get(), listSize);
+    Sorting::RadixSort(sortedKeys, resultIndices, cache->Keys[1].Get(), cache->Indices.Get(), listSize);
     if (resultIndices != list.Indices.Get())
         Platform::MemoryCopy(list.Indices.Get(), resultIndices, sizeof(int32) * listSize);
 
@@ -638,8 +722,7 @@ void RenderList::SortDrawCalls(const RenderContext& renderContext, bool reverseD
         i += batchSize;
     }
 
-    // Sort draw calls batches by depth
-    Sorting::MergeSort(list.Batches, &SortingBatches);
+    // Note: batches are already sorted by the key (created from the sorted draw calls)
 }
 
 FORCE_INLINE bool CanUseInstancing(DrawPass pass)
@@ -647,6 +730,16 @@ FORCE_INLINE bool CanUseInstancing(DrawPass pass)
     return pass == DrawPass::GBuffer || pass == DrawPass::Depth;
 }
 
+FORCE_INLINE void AddInstanceCullingDraw(Array<GPUDrawIndexedIndirectArgs>& drawArgs, const DrawCall& drawCall, int32 startInstance)
+{
+    auto& args = drawArgs.AddOne();
+    args.IndicesCount = drawCall.Draw.IndicesCount;
+    args.InstanceCount = 0; // Counter of the visible instances
+    args.StartIndex = drawCall.Draw.StartIndex;
+    args.StartVertex = 0;
+    args.StartInstance = startInstance;
+}
+
 void RenderList::ExecuteDrawCalls(const RenderContext& renderContext, DrawCallsList& list, const RenderListBuffer<DrawCall>& drawCalls, GPUTextureView* input)
 {
     if (list.IsEmpty())
@@ -657,6 +750,8 @@ void RenderList::ExecuteDrawCalls(const RenderContext& renderContext, DrawCallsL
     const auto* batchesData = list.Batches.Get();
     const auto context = GPUDevice::Instance->GetMainContext();
     bool useInstancing = list.CanUseInstancing && CanUseInstancing(renderContext.View.Pass) && GPUDevice::Instance->Limits.HasInstancing;
+    bool useInstancesCulling = false;
+    bool hasInstanceCullingJobs = false;
     TaaJitterRemoveContext taaJitterRemove(renderContext.View);
 
     // Clear SR slots to prevent any resources binding issues (leftovers from the previous passes)
@@ -676,51 +771,135 @@ void RenderList::ExecuteDrawCalls(const RenderContext& renderContext, DrawCallsL
         for (int32 i = 0; i < list.PreBatchedDrawCalls.Count(); i++)
         {
             auto& batch = BatchedDrawCalls.Get()[list.PreBatchedDrawCalls.Get()[i]];
-            if (batch.Instances.Count() > 1)
+            if (batch.InstanceCullingJob != -1)
+                hasInstanceCullingJobs = true;
+            else if (batch.Instances.Count() > 1)
                 instancedBatchesCount += batch.Instances.Count();
         }
         if (instancedBatchesCount == 0)
         {
-            // Faster path if none of the draw batches requires instancing
-            useInstancing = false;
+            // Faster path if none of the draw batches requires instancing (instances of the GPU-driven culling jobs are already on a GPU)
+            useInstancing = hasInstanceCullingJobs;
             goto DRAW;
         }
         _instanceBuffer.Clear();
         _instanceBuffer.Data.Resize(instancedBatchesCount * sizeof(InstanceData));
         auto instanceData = (InstanceData*)_instanceBuffer.Data.Get();
+        useInstancesCulling = Graphics::GPUInstancesCulling && InstanceCulling::Instance()->IsReady();
+        InstanceCullingData* cullingData = nullptr;
+        if (useInstancesCulling)
+        {
+            _instanceCullingData.Resize(instancedBatchesCount, false);
+            _instanceCullingDrawArgs.Clear();
+            cullingData = _instanceCullingData.Get();
+        }
 
-        // Write to instance buffer
+        // Setup instanced batches ranges in the instance buffer (culling draw index matches the instanced batch index)
+        struct InstancedBatch
+        {
+            int32 BatchIndex;
+            int32 InstanceOffset;
+        };
+        Array<InstancedBatch, RendererAllocation> instancedBatches;
+        int32 instancesCount = 0;
         for (int32 i = 0; i < list.Batches.Count(); i++)
         {
             auto& batch = batchesData[i];
             if (batch.BatchSize > 1)
             {
+                instancedBatches.Add({ i, instancesCount });
+                if (useInstancesCulling)
+                    AddInstanceCullingDraw(_instanceCullingDrawArgs, drawCallsData[listData[batch.StartIndex]], instancesCount);
+                instancesCount += batch.BatchSize;
+            }
+        }
+
+        // Write to instance buffer (large lists are split into jobs, each batch writes into its own range)
+        const int32 jobsCount = instancesCount >= RENDER_LIST_INSTANCES_JOB_MIN_COUNT ? Math::Min(JobSystem::GetThreadsCount(), instancedBatches.Count()) : 1;
+        const int32 batchesPerJob = jobsCount > 0 ? Math::DivideAndRoundUp(instancedBatches.Count(), jobsCount) : 0;
+        const auto writeInstancesJob = [&](int32 jobIndex)
+        {
+            const int32 start = jobIndex * batchesPerJob;
+            const int32 end = Math::Min(start + batchesPerJob, instancedBatches.Count());
+            for (int32 i = start; i < end; i++)
+            {
+                const InstancedBatch& e = instancedBatches.Get()[i];
+                auto& batch = batchesData[e.BatchIndex];
                 IMaterial::InstancingHandler handler;
                 drawCallsData[listData[batch.StartIndex]].Material->CanUseInstancing(handler);
+                InstanceData* batchInstanceData = instanceData + e.InstanceOffset;
                 for (int32 j = 0; j < batch.BatchSize; j++)
                 {
                     auto& drawCall = drawCallsData[listData[batch.StartIndex + j]];
-                    handler.WriteDrawCall(instanceData, drawCall);
-                    instanceData++;
+                    handler.WriteDrawCall(batchInstanceData + j, drawCall);
+                }
+                if (useInstancesCulling)
+                {
+                    InstanceCullingData* batchCullingData = cullingData + e.InstanceOffset;
+                    for (int32 j = 0; j < batch.BatchSize; j++)
+                    {
+                        auto& drawCall = drawCallsData[listData[batch.StartIndex + j]];
+                        batchCullingData[j].Center = drawCall.ObjectPosition;
+                        batchCullingData[j].Radius = drawCall.ObjectRadius > 0.0f ? drawCall.ObjectRadius : MAX_float;
+                        batchCullingData[j].DrawIndex = i;
+                    }
                 }
             }
-        }
+        };
+        if (jobsCount > 1)
+            JobSystem::Execute(writeInstancesJob, jobsCount);
+        else if (jobsCount == 1)
+            writeInstancesJob(0);
+        instanceData += instancesCount;
+        if (useInstancesCulling)
+            cullingData += instancesCount;
         for (int32 i = 0; i < list.PreBatchedDrawCalls.Count(); i++)
         {
             auto& batch = BatchedDrawCalls.Get()[list.PreBatchedDrawCalls.Get()[i]];
             if (batch.Instances.Count() > 1)
             {
+                if (useInstancesCulling)
+                {
+                    AddInstanceCullingDraw(_instanceCullingDrawArgs, batch.DrawCall, instanceData - (InstanceData*)_instanceBuffer.Data.Get());
+                    const Float3 localCenter = batch.Bounds.Center;
+                    const float localRadius = (float)batch.Bounds.Radius;
+                    for (const InstanceData& instance : batch.Instances)
+                    {
+                        cullingData->Center = instance.InstanceOrigin + instance.InstanceTransform1 * localCenter.X + instance.InstanceTransform2 * localCenter.Y + instance.InstanceTransform3 * localCenter.Z;
+                        const float scaleSqr = Math::Max(instance.InstanceTransform1.LengthSquared(), instance.InstanceTransform2.LengthSquared(), instance.InstanceTransform3.LengthSquared());
+                        cullingData->Radius = localRadius > 0.0f ? localRadius * Math::Sqrt(scaleSqr) : MAX_float;
+                        cullingData->DrawIndex = _instanceCullingDrawArgs.Count() - 1;
+                        cullingData++;
+                    }
+                }
                 Platform::MemoryCopy(instanceData, batch.Instances.Get(), batch.Instances.Count() * sizeof(InstanceData));
                 instanceData += batch.Instances.Count();
             }
         }
 
-        // Upload data
-        _instanceBuffer.Flush(context);
+        // Cull instances on GPU (visible instances are compacted and drawn with indirect arguments), otherwise upload data
+        if (useInstancesCulling)
+            useInstancesCulling = !InstanceCulling::Instance()->Cull(context, renderContext.View.CullingFrustum, (InstanceData*)_instanceBuffer.Data.Get(), _instanceCullingData.Get(), instancedBatchesCount, _instanceCullingDrawArgs.Get(), _instanceCullingDrawArgs.Count());
+        if (!useInstancesCulling)
+            _instanceBuffer.Flush(context);
     }
 
 DRAW:
 
+    // Execute the GPU-driven instances culling jobs used by this list (once per view, results are reused by the other passes)
+    if (useInstancing && hasInstanceCullingJobs)
+    {
+        for (int32 i = 0; i < list.PreBatchedDrawCalls.Count(); i++)
+        {
+            auto& batch = BatchedDrawCalls.Get()[list.PreBatchedDrawCalls.Get()[i]];
+            if (batch.InstanceCullingJob == -1)
+                continue;
+            InstanceCullingJob& job = InstanceCullingJobs[batch.InstanceCullingJob];
+            if (!job.CulledInstances)
+                InstanceCulling::Instance()->Execute(context, renderContext, job);
+        }
+    }
+
     // Execute draw calls
     MaterialBase::BindParameters bindParams(context, renderContext);
     bindParams.Input = input;
@@ -728,6 +907,7 @@ void RenderList::ExecuteDrawCalls(const RenderContext& renderContext, DrawCallsL
     if (useInstancing)
     {
         int32 instanceBufferOffset = 0;
+        uint32 instanceCullingDrawIndex = 0;
         GPUBuffer* vb[4];
         uint32 vbOffsets[4];
         for (int32 i = 0; i < list.Batches.Count(); i++)
@@ -769,6 +949,15 @@ void RenderList::ExecuteDrawCalls(const RenderContext& renderContext, DrawCallsL
                     context->BindVB(ToSpan(vb, vbCount), vbOffsets);
                     context->DrawIndexedInstanced(drawCall.Draw.IndicesCount, batch.InstanceCount, 0, 0, drawCall.Draw.StartIndex);
                 }
+                else if (useInstancesCulling)
+                {
+                    vbCount = 3;
+                    vb[vbCount] = InstanceCulling::Instance()->GetInstancesBuffer();
+                    vbOffsets[vbCount] = 0;
+                    vbCount++;
+                    context->BindVB(ToSpan(vb, vbCount), vbOffsets);
+                    context->DrawIndexedInstancedIndirect(InstanceCulling::Instance()->GetDrawArgsBuffer(), instanceCullingDrawIndex++ * sizeof(GPUDrawIndexedIndirectArgs));
+                }
                 else
                 {
                     vbCount = 3;
@@ -785,6 +974,9 @@ void RenderList::ExecuteDrawCalls(const RenderContext& renderContext, DrawCallsL
         {
             auto& batch = BatchedDrawCalls.Get()[list.PreBatchedDrawCalls.Get()[i]];
             auto& drawCall = batch.DrawCall;
+            const InstanceCullingJob* job = batch.InstanceCullingJob != -1 ? &InstanceCullingJobs[batch.InstanceCullingJob] : nullptr;
+            if (job && !job->CulledInstances)
+                continue;
 
             int32 vbCount = 0;
             while (vbCount < ARRAY_COUNT(drawCall.Geometry.VertexBuffers) && drawCall.Geometry.VertexBuffers[vbCount])
@@ -800,12 +992,21 @@ void RenderList::ExecuteDrawCalls(const RenderContext& renderContext, DrawCallsL
             }
 
             bindParams.FirstDrawCall = &drawCall;
-            bindParams.DrawCallsCount = batch.Instances.Count();
+            bindParams.DrawCallsCount = job ? Math::Max(job->Buffers->Instances.Count(), 2) : batch.Instances.Count(); // Visible instances count of the GPU-driven culling is unknown so use the instanced shader
             drawCall.Material->Bind(bindParams);
 
             context->BindIB(drawCall.Geometry.IndexBuffer);
 
-            if (drawCall.InstanceCount == 0)
+            if (job)
+            {
+                vbCount = 3;
+                vb[vbCount] = job->CulledInstances;
+                vbOffsets[vbCount] = 0;
+                vbCount++;
+                context->BindVB(ToSpan(vb, vbCount), vbOffsets);
+                context->DrawIndexedInstancedIndirect(job->DrawArgs, batch.InstanceCullingDraw * sizeof(GPUDrawIndexedIndirectArgs));
+            }
+            else if (drawCall.InstanceCount == 0)
             {
                 ASSERT_LOW_LAYER(batch.Instances.Count() == 1);
                 context->BindVB(ToSpan(vb, vbCount), vbOffsets);
@@ -818,6 +1019,15 @@ void RenderList::ExecuteDrawCalls(const RenderContext& renderContext, DrawCallsL
                     context->BindVB(ToSpan(vb, vbCount), vbOffsets);
                     context->DrawIndexedInstanced(drawCall.Draw.IndicesCount, batch.Instances.Count(), 0, 0, drawCall.Draw.StartIndex);
                 }
+                else if (useInstancesCulling)
+                {
+                    vbCount = 3;
+                    vb[vbCount] = InstanceCulling::Instance()->GetInstancesBuffer();
+                    vbOffsets[vbCount] = 0;
+                    vbCount++;
+                    context->BindVB(ToSpan(vb, vbCount), vbOffsets);
+                    context->DrawIndexedInstancedIndirect(InstanceCulling::Instance()->GetDrawArgsBuffer(), instanceCullingDrawIndex++ * sizeof(GPUDrawIndexedIndirectArgs));
+                }
                 else
                 {
                     vbCount = 3;
@@ -4,8 +4,11 @@
 
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Math/Half.h"
+#include "Engine/Core/Math/BoundingSphere.h"
 #include "Engine/Graphics/PostProcessSettings.h"
 #include "Engine/Graphics/DynamicBuffer.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/Models/Config.h"
 #include "Engine/Scripting/ScriptingObject.h"
 #include "DrawCall.h"
 #include "RenderListBuffer.h"
@@ -19,6 +22,7 @@ class SceneRendering;
 class LightWithShadow;
 class IPostFxSettingsProvider;
 class CubeTexture;
+class OcclusionCullingData;
 struct RenderContext;
 struct RenderContextBatch;
 
@@ -234,6 +238,67 @@ struct BatchedDrawCall
 {
     DrawCall DrawCall;
     Array<struct InstanceData, RendererAllocation> Instances;
+
+    /// <summary>
+    /// The local-space bounds of the batched geometry (transformed by each instance for the GPU instances culling). Instances are never culled if radius is zero.
+    /// </summary>
+    BoundingSphere Bounds = BoundingSphere::Empty;
+
+    /// <summary>
+    /// The index of the GPU-driven instances culling job (see RenderList::InstanceCullingJobs) that provides the instances of this batch (instead of the Instances array), or -1 if not used.
+    /// </summary>
+    int32 InstanceCullingJob = -1;
+
+    /// <summary>
+    /// The index of the draw within the indirect arguments of the GPU-driven instances culling job.
+    /// </summary>
+    int32 InstanceCullingDraw = 0;
+};
+
+/// <summary>
+/// The GPU-driven instances culling job. Culls the persistent instances (see InstanceCullingBuffers) against the view on a GPU, selects their LODs and compacts the visible ones for the indirect draws of the batches that use this job.
+/// </summary>
+struct InstanceCullingJob
+{
+    /// <summary>
+    /// The persistent instances (owned by the object that added the job).
+    /// </summary>
+    class InstanceCullingBuffers* Buffers;
+
+    /// <summary>
+    /// The squared half of the model minimum screen size (instances smaller on a screen are culled).
+    /// </summary>
+    float MinScreenSizeSq;
+
+    /// <summary>
+    /// The squared half of the models LODs screen sizes.
+    /// </summary>
+    float LODScreenSizesSq[MODEL_MAX_LODS];
+
+    /// <summary>
+    /// The amount of the model LODs.
+    /// </summary>
+    int32 LODsCount;
+
+    /// <summary>
+    /// The LOD index bias.
+    /// </summary>
+    int32 LODBias;
+
+    /// <summary>
+    /// The highest LOD index that can be used (eg. limited by the streaming).
+    /// </summary>
+    int32 MinLOD;
+
+    /// <summary>
+    /// The compacted visible instances (valid after the job execution).
+    /// </summary>
+    GPUBuffer* CulledInstances;
+
+    /// <summary>
+    /// The draw indirect arguments (valid after the job execution).
+    /// </summary>
+    GPUBuffer* DrawArgs;
 };
 
 /// <summary>
@@ -295,6 +360,21 @@ API_CLASS(Sealed) class FLAXENGINE_API RenderList : public ScriptingObject
     /// </summary>
     Array<SceneRendering*> Scenes;
 
+    /// <summary>
+    /// The occlusion culling state of the view (optional). Objects can be skipped from drawing if occluded and should add their bounds to be tested for the next frames.
+    /// </summary>
+    OcclusionCullingData* Occlusion = nullptr;
+
+    /// <summary>
+    /// The static flags filter of the draw calls added to this list (object is drawn if its flags masked with StaticFlagsFilterMask are equal to StaticFlagsFilterValue). Used by the cached shadow maps to split the static and dynamic shadow casters.
+    /// </summary>
+    StaticFlags StaticFlagsFilterMask = StaticFlags::None;
+
+    /// <summary>
+    /// The static flags filter value. See StaticFlagsFilterMask.
+    /// </summary>
+    StaticFlags StaticFlagsFilterValue = StaticFlags::None;
+
     /// <summary>
     /// Draw calls list (for all draw passes).
     /// </summary>
@@ -305,6 +385,11 @@ API_CLASS(Sealed) class FLAXENGINE_API RenderList : public ScriptingObject
     /// </summary>
     RenderListBuffer<BatchedDrawCall> BatchedDrawCalls;
 
+    /// <summary>
+    /// The GPU-driven instances culling jobs used by the pre-batched draw calls. Executed on the first draw of the batches that use them.
+    /// </summary>
+    RenderListBuffer<InstanceCullingJob> InstanceCullingJobs;
+
     /// <summary>
     /// The draw calls lists. Each for the separate draw pass.
     /// </summary>
@@ -409,6 +494,8 @@ API_CLASS(Sealed) class FLAXENGINE_API RenderList : public ScriptingObject
 
 private:
     DynamicVertexBuffer _instanceBuffer;
+    Array<struct InstanceCullingData> _instanceCullingData;
+    Array<GPUDrawIndexedIndirectArgs> _instanceCullingDrawArgs;
 
 public:
     /// <summary>
@@ -511,6 +598,47 @@ API_CLASS(Sealed) class FLAXENGINE_API RenderList : public ScriptingObject
     /// <param name="sortOrder">Object sorting key.</param>
     void AddDrawCall(const RenderContextBatch& renderContextBatch, DrawPass drawModes, StaticFlags staticFlags, ShadowsCastingMode shadowsMode, const BoundingSphere& bounds, DrawCall& drawCall, bool receivesDecals = true, int16 sortOrder = 0);
 
+    /// <summary>
+    /// Adds the draw call to the draw lists of the shadow projections only (render contexts other than the main one). Used by objects that submit separate geometry for the main view (eg. culled meshlets). Performs additional per-context frustum culling.
+    /// </summary>
+    /// <param name="renderContextBatch">The rendering context batch. This assumes that RenderContextBatch contains main context and shadow projections only.</param>
+    /// <param name="drawModes">The object draw modes.</param>
+    /// <param name="staticFlags">The object static flags.</param>
+    /// <param name="shadowsMode">The object shadows casting mode.</param>
+    /// <param name="bounds">The object bounds.</param>
+    /// <param name="drawCall">The draw call data.</param>
+    /// <param name="sortOrder">Object sorting key.</param>
+    void AddShadowsDrawCall(const RenderContextBatch& renderContextBatch, DrawPass drawModes, StaticFlags staticFlags, ShadowsCastingMode shadowsMode, const BoundingSphere& bounds, DrawCall& drawCall, int16 sortOrder = 0);
+
+    /// <summary>
+    /// Adds the draw call with the batch key already calculated (eg. draw call cached between frames for the static object) to the draw lists. Only the view distance part of the sort key is updated.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="drawModes">The object draw modes.</param>
+    /// <param name="staticFlags">The object static flags.</param>
+    /// <param name="drawCall">The draw call data with sort key setup via <see cref="CalculateBatchKey"/>.</param>
+    /// <param name="receivesDecals">True if the rendered mesh can receive decals.</param>
+    void AddCachedDrawCall(const RenderContext& renderContext, DrawPass drawModes, StaticFlags staticFlags, const DrawCall& drawCall, bool receivesDecals = true);
+
+    /// <summary>
+    /// Adds the draw call with the batch key already calculated (eg. draw call cached between frames for the static object) to the draw lists and references it in other render contexts. Performs additional per-context frustum culling.
+    /// </summary>
+    /// <param name="renderContextBatch">The rendering context batch. This assumes that RenderContextBatch contains main context and shadow projections only.</param>
+    /// <param name="drawModes">The object draw modes.</param>
+    /// <param name="staticFlags">The object static flags.</param>
+    /// <param name="shadowsMode">The object shadows casting mode.</param>
+    /// <param name="bounds">The object bounds.</param>
+    /// <param name="drawCall">The draw call data with sort key setup via <see cref="CalculateBatchKey"/>.</param>
+    /// <param name="receivesDecals">True if the rendered mesh can receive decals.</param>
+    void AddCachedDrawCall(const RenderContextBatch& renderContextBatch, DrawPass drawModes, StaticFlags staticFlags, ShadowsCastingMode shadowsMode, const BoundingSphere& bounds, const DrawCall& drawCall, bool receivesDecals = true);
+
+    /// <summary>
+    /// Calculates the view-independent part of the draw call sort key (batching key and sort order). Used to cache the draw calls between frames.
+    /// </summary>
+    /// <param name="drawCall">The draw call data.</param>
+    /// <param name="sortOrder">Object sorting key.</param>
+    static void CalculateBatchKey(DrawCall& drawCall, int16 sortOrder = 0);
+
     /// <summary>
     /// Sorts the collected draw calls list.
     /// </summary>
@@ -577,6 +705,26 @@ PACK_STRUCT(struct FLAXENGINE_API InstanceData
     Half4 InstanceLightmapArea;
     });
 
+/// <summary>
+/// Represents data per instance element used for the GPU instances culling.
+/// </summary>
+PACK_STRUCT(struct FLAXENGINE_API InstanceCullingData
+    {
+    Float3 Center;
+    float Radius;
+    uint32 DrawIndex;
+    });
+
+/// <summary>
+/// Represents data per persistent instance element used for the GPU-driven instances culling (see InstanceCullingBuffers).
+/// </summary>
+PACK_STRUCT(struct FLAXENGINE_API InstanceCullingBounds
+    {
+    Float3 Center;
+    float Radius;
+    float CullDistance;
+    });
+
 struct SurfaceDrawCallHandler
 {
     static void GetHash(const DrawCall& drawCall, uint32& batchKey);
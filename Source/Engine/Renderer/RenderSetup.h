@@ -12,4 +12,5 @@ struct FLAXENGINE_API RenderSetup
     RenderingUpscaleLocation UpscaleLocation = RenderingUpscaleLocation::AfterAntiAliasingPass;
     bool UseMotionVectors = false;
     bool UseTemporalAAJitter = false;
+    bool UseTemporalUpscaling = false;
 };
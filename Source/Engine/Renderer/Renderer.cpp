@@ -7,8 +7,10 @@
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/PostProcessEffect.h"
 #include "Engine/Engine/EngineService.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 #include "GBufferPass.h"
 #include "ForwardPass.h"
+#include "LightsGridPass.h"
 #include "ShadowsPass.h"
 #include "LightPass.h"
 #include "ReflectionsPass.h"
@@ -21,12 +23,20 @@
 #include "MotionBlurPass.h"
 #include "VolumetricFogPass.h"
 #include "HistogramPass.h"
+#include "TextureFeedbackPass.h"
+#include "TerrainVirtualTexturePass.h"
+#include "OcclusionCullingPass.h"
+#include "VariableRateShadingPass.h"
 #include "AtmospherePreCompute.h"
 #include "GlobalSignDistanceFieldPass.h"
 #include "GI/GlobalSurfaceAtlasPass.h"
 #include "GI/DynamicDiffuseGlobalIllumination.h"
 #include "Utils/MultiScaler.h"
 #include "Utils/BitonicSort.h"
+#include "Utils/RadixSort.h"
+#include "Utils/InstanceCulling.h"
+#include "Utils/ComputeSkinning.h"
+#include "Utils/SplineDeformation.h"
 #include "AntiAliasing/FXAA.h"
 #include "AntiAliasing/TAA.h"
 #include "AntiAliasing/SMAA.h"
@@ -72,6 +82,7 @@ bool RendererService::Init()
     PassList.Add(ShadowsPass::Instance());
     PassList.Add(LightPass::Instance());
     PassList.Add(ForwardPass::Instance());
+    PassList.Add(LightsGridPass::Instance());
     PassList.Add(ReflectionsPass::Instance());
     PassList.Add(ScreenSpaceReflectionsPass::Instance());
     PassList.Add(AmbientOcclusionPass::Instance());
@@ -83,10 +94,18 @@ bool RendererService::Init()
     PassList.Add(MotionBlurPass::Instance());
     PassList.Add(MultiScaler::Instance());
     PassList.Add(BitonicSort::Instance());
+    PassList.Add(RadixSort::Instance());
+    PassList.Add(InstanceCulling::Instance());
+    PassList.Add(ComputeSkinning::Instance());
+    PassList.Add(SplineDeformation::Instance());
+    PassList.Add(OcclusionCullingPass::Instance());
+    PassList.Add(VariableRateShadingPass::Instance());
     PassList.Add(FXAA::Instance());
     PassList.Add(TAA::Instance());
     PassList.Add(SMAA::Instance());
     PassList.Add(HistogramPass::Instance());
+    PassList.Add(TextureFeedbackPass::Instance());
+    PassList.Add(TerrainVirtualTexturePass::Instance());
     PassList.Add(GlobalSignDistanceFieldPass::Instance());
     PassList.Add(GlobalSurfaceAtlasPass::Instance());
     PassList.Add(DynamicDiffuseGlobalIlluminationPass::Instance());
@@ -166,6 +185,7 @@ bool Renderer::IsReady()
 void Renderer::Render(SceneRenderTask* task)
 {
     PROFILE_GPU_CPU_NAMED("Render Frame");
+    PROFILE_MEM(Rendering);
 
     // Prepare GPU context
     auto context = GPUDevice::Instance->GetMainContext();
@@ -333,6 +353,7 @@ void RenderInner(SceneRenderTask* task, RenderContext& renderContext, RenderCont
                     renderContext.List->Settings.AntiAliasing.Mode == AntialiasingMode::TemporalAntialiasing;
         }
         setup.UseTemporalAAJitter = aaMode == AntialiasingMode::TemporalAntialiasing;
+        setup.UseTemporalUpscaling = setup.UseTemporalAAJitter && renderContext.Task->RenderingPercentage < 1.0f && setup.UpscaleLocation == RenderingUpscaleLocation::BeforePostProcessingPass;
 
         // Customize setup (by postfx or custom gameplay effects)
         renderContext.Task->SetupRender(renderContext);
@@ -344,6 +365,7 @@ void RenderInner(SceneRenderTask* task, RenderContext& renderContext, RenderCont
     renderContext.View.Prepare(renderContext);
     renderContext.Buffers->Prepare();
     ShadowsPass::Instance()->Prepare();
+    OcclusionCullingPass::Instance()->Prepare(renderContext);
 
     // Build batch of render contexts (main view and shadow projections)
     {
@@ -382,6 +404,8 @@ void RenderInner(SceneRenderTask* task, RenderContext& renderContext, RenderCont
         for (const uint64 label : renderContextBatch.WaitLabels)
             JobSystem::Wait(label);
         renderContextBatch.WaitLabels.Clear();
+        if (drawShadows)
+            ShadowsPass::Instance()->CollectStaticShadows(task);
 
 #if USE_EDITOR
         GBufferPass::Instance()->OverrideDrawCalls(renderContext);
@@ -391,17 +415,44 @@ void RenderInner(SceneRenderTask* task, RenderContext& renderContext, RenderCont
     // Sort draw calls
     {
         PROFILE_CPU_NAMED("Sort Draw Calls");
-        renderContext.List->SortDrawCalls(renderContext, false, DrawCallsListType::GBuffer);
-        renderContext.List->SortDrawCalls(renderContext, false, DrawCallsListType::GBufferNoDecals);
-        renderContext.List->SortDrawCalls(renderContext, true, DrawCallsListType::Forward);
-        renderContext.List->SortDrawCalls(renderContext, false, DrawCallsListType::Distortion);
+
+        // Each list is sorted and batched independently so run them as jobs (main view lists and shadow projections lists)
+        struct SortTask
+        {
+            const RenderContext* Context;
+            DrawCallsList* List;
+            const RenderListBuffer<DrawCall>* DrawCalls;
+            bool ReverseDistance;
+        };
+        Array<SortTask, RendererAllocation> sortTasks;
+        const auto addSortTask = [&sortTasks](const RenderContext& context, bool reverseDistance, DrawCallsList& list, const RenderListBuffer<DrawCall>& drawCalls)
+        {
+            sortTasks.Add({ &context, &list, &drawCalls, reverseDistance });
+        };
+        auto& mainList = *renderContext.List;
+        addSortTask(renderContext, false, mainList.DrawCallsLists[(int32)DrawCallsListType::GBuffer], mainList.DrawCalls);
+        addSortTask(renderContext, false, mainList.DrawCallsLists[(int32)DrawCallsListType::GBufferNoDecals], mainList.DrawCalls);
+        addSortTask(renderContext, true, mainList.DrawCallsLists[(int32)DrawCallsListType::Forward], mainList.DrawCalls);
+        addSortTask(renderContext, false, mainList.DrawCallsLists[(int32)DrawCallsListType::Distortion], mainList.DrawCalls);
         if (setup.UseMotionVectors)
-            renderContext.List->SortDrawCalls(renderContext, false, DrawCallsListType::MotionVectors);
+            addSortTask(renderContext, false, mainList.DrawCallsLists[(int32)DrawCallsListType::MotionVectors], mainList.DrawCalls);
         for (int32 i = 1; i < renderContextBatch.Contexts.Count(); i++)
         {
             auto& shadowContext = renderContextBatch.Contexts[i];
-            shadowContext.List->SortDrawCalls(shadowContext, false, DrawCallsListType::Depth);
-            shadowContext.List->SortDrawCalls(shadowContext, false, shadowContext.List->ShadowDepthDrawCallsList, renderContext.List->DrawCalls);
+            addSortTask(shadowContext, false, shadowContext.List->DrawCallsLists[(int32)DrawCallsListType::Depth], shadowContext.List->DrawCalls);
+            addSortTask(shadowContext, false, shadowContext.List->ShadowDepthDrawCallsList, mainList.DrawCalls);
+        }
+        const auto sortJob = [&sortTasks](int32 index)
+        {
+            const SortTask& task = sortTasks[index];
+            task.Context->List->SortDrawCalls(*task.Context, task.ReverseDistance, *task.List, *task.DrawCalls);
+        };
+        if (sortTasks.Count() > 1 && renderContextBatch.EnableAsync)
+            JobSystem::Execute(sortJob, sortTasks.Count());
+        else
+        {
+            for (int32 i = 0; i < sortTasks.Count(); i++)
+                sortJob(i);
         }
     }
 
@@ -434,9 +485,18 @@ void RenderInner(SceneRenderTask* task, RenderContext& renderContext, RenderCont
         GlobalSignDistanceFieldPass::Instance()->Render(renderContext, context, bindingData);
     }
 
+    // Render terrain virtual texture tiles requested by the visible chunks
+    TerrainVirtualTexturePass::Instance()->Render(renderContext, context);
+
     // Fill GBuffer
     GBufferPass::Instance()->Fill(renderContext, lightBuffer);
 
+    // Test objects occlusion against the scene depth (results are used in the next frames)
+    OcclusionCullingPass::Instance()->Render(renderContext, context);
+
+    // Render texture streaming feedback
+    TextureFeedbackPass::Instance()->Render(renderContext, context);
+
     // Debug drawing
     if (renderContext.View.Mode == ViewMode::GlobalSDF)
         GlobalSignDistanceFieldPass::Instance()->RenderDebug(renderContext, context, lightBuffer);
@@ -540,14 +600,18 @@ void RenderInner(SceneRenderTask* task, RenderContext& renderContext, RenderCont
         VolumetricFogPass::Instance()->Render(renderContext);
 
         PROFILE_GPU_CPU("Fog");
+        context->SetShadingRate(VariableRateShadingPass::Instance()->Get(renderContext));
         renderContext.List->Fog->DrawFog(context, renderContext, *lightBuffer);
+        context->SetShadingRate(nullptr);
         context->ResetSR();
     }
 
     // Run forward pass
     auto frameBuffer = RenderTargetPool::Get(tempDesc);
     RENDER_TARGET_POOL_SET_NAME(frameBuffer, "FrameBuffer");
+    LightsGridPass::Instance()->Render(renderContext, context);
     ForwardPass::Instance()->Render(renderContext, lightBuffer, frameBuffer);
+    LightsGridPass::Instance()->Reset();
 
     // Material and Custom PostFx
     renderContext.List->RunMaterialPostFxPass(context, renderContext, MaterialPostFxLocation::AfterForwardPass, frameBuffer, lightBuffer);
@@ -576,15 +640,40 @@ void RenderInner(SceneRenderTask* task, RenderContext& renderContext, RenderCont
     renderContext.List->RunCustomPostFxPass(context, renderContext, PostProcessEffectLocation::BeforePostProcessingPass, frameBuffer, tempBuffer);
 
     // Temporal Anti-Aliasing (goes before post processing)
-    if (aaMode == AntialiasingMode::TemporalAntialiasing)
+    bool useUpscaling = task->RenderingPercentage < 1.0f;
+    const Viewport outputViewport = task->GetOutputViewport();
+    if (setup.UseTemporalUpscaling)
+    {
+        // Variable Rate Shading image generation for the next frame (from the frame at rendering resolution)
+        VariableRateShadingPass::Instance()->Render(renderContext, context, frameBuffer);
+
+        // Temporal Upscaling (accumulates jittered frames at the output resolution)
+        useUpscaling = false;
+        RenderTargetPool::Release(tempBuffer);
+        tempDesc.Width = (int32)outputViewport.Width;
+        tempDesc.Height = (int32)outputViewport.Height;
+        tempBuffer = RenderTargetPool::Get(tempDesc);
+        context->ResetSR();
+        if (renderContext.List->HasAnyPostFx(renderContext, PostProcessEffectLocation::CustomTemporalUpscale))
+            renderContext.List->RunCustomPostFxPass(context, renderContext, PostProcessEffectLocation::CustomTemporalUpscale, frameBuffer, tempBuffer);
+        else
+            TAA::Instance()->Render(renderContext, frameBuffer, tempBuffer);
+        if (tempBuffer->Width() == tempDesc.Width)
+            Swap(frameBuffer, tempBuffer);
+        RenderTargetPool::Release(tempBuffer);
+        tempBuffer = RenderTargetPool::Get(tempDesc);
+    }
+    else if (aaMode == AntialiasingMode::TemporalAntialiasing)
     {
-        TAA::Instance()->Render(renderContext, frameBuffer, tempBuffer->View());
+        TAA::Instance()->Render(renderContext, frameBuffer, tempBuffer);
         Swap(frameBuffer, tempBuffer);
     }
 
+    // Variable Rate Shading image generation for the next frame (from anti-aliased frame at rendering resolution)
+    if (!setup.UseTemporalUpscaling)
+        VariableRateShadingPass::Instance()->Render(renderContext, context, frameBuffer);
+
     // Upscaling after scene rendering but before post processing
-    bool useUpscaling = task->RenderingPercentage < 1.0f;
-    const Viewport outputViewport = task->GetOutputViewport();
     if (useUpscaling && setup.UpscaleLocation == RenderingUpscaleLocation::BeforePostProcessingPass)
     {
         useUpscaling = false;
@@ -8,8 +8,14 @@
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/RenderBuffers.h"
 #include "Engine/Graphics/PixelFormatExtensions.h"
+#include "Engine/Graphics/RenderTargetPool.h"
 #include "Engine/Content/Content.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Level/Actor.h"
+#include "Engine/Level/Scene/SceneRendering.h"
 #include "Engine/Scripting/Enums.h"
+#include "Engine/Threading/JobSystem.h"
 #if USE_EDITOR
 #include "Engine/Renderer/Lightmaps.h"
 #endif
@@ -18,6 +24,90 @@
 #define SpotLight_NearPlane 10.0f
 #define PointLight_NearPlane 10.0f
 
+// The maximum amount of the cached static shadow maps (per render buffers)
+#define SHADOWS_PASS_MAX_CACHED_LIGHTS 16
+
+// The size of the cells used to snap the cached directional light cascades (relative to the cascade radius)
+#define SHADOWS_PASS_CASCADE_CELL_SIZE 0.25f
+
+// The maximum amount of the cached static shadow maps to update at once (dirty lights above this limit render the full shadow map until updated)
+#define SHADOWS_PASS_MAX_STATIC_UPDATES 2
+
+class ShadowsCustomBuffer : public RenderBuffers::CustomBuffer, public ISceneRenderingListener
+{
+public:
+    struct LightCache
+    {
+        GPUTexture* ShadowMap = nullptr;
+        uint64 LastFrameUsed = 0;
+        Vector3 Origin;
+        int32 FacesCount = 0;
+        uint32 DirtyFaces = MAX_uint32;
+        Matrix FacesViewProjection[6];
+        BoundingFrustum FacesFrustum[6];
+    };
+
+    Dictionary<Guid, LightCache> Lights;
+
+    ~ShadowsCustomBuffer()
+    {
+        for (auto& e : Lights)
+            RenderTargetPool::Release(e.Value.ShadowMap);
+    }
+
+    void Evict(const Guid& id)
+    {
+        LightCache* light = Lights.TryGet(id);
+        if (light)
+        {
+            RenderTargetPool::Release(light->ShadowMap);
+            Lights.Remove(id);
+        }
+    }
+
+    FORCE_INLINE void OnSceneRenderingDirty(const BoundingSphere& objectBounds)
+    {
+        for (auto& e : Lights)
+        {
+            LightCache& light = e.Value;
+            const BoundingSphere bounds(objectBounds.Center - light.Origin, objectBounds.Radius);
+            for (int32 faceIndex = 0; faceIndex < light.FacesCount; faceIndex++)
+            {
+                if ((light.DirtyFaces & (1 << faceIndex)) == 0 && light.FacesFrustum[faceIndex].Intersects(bounds))
+                    light.DirtyFaces |= 1 << faceIndex;
+            }
+        }
+    }
+
+    // [ISceneRenderingListener]
+    void OnSceneRenderingAddActor(Actor* a) override
+    {
+        if (EnumHasAnyFlags(a->GetStaticFlags(), StaticFlags::Transform))
+            OnSceneRenderingDirty(a->GetSphere());
+    }
+
+    void OnSceneRenderingUpdateActor(Actor* a, const BoundingSphere& prevBounds) override
+    {
+        if (EnumHasAnyFlags(a->GetStaticFlags(), StaticFlags::Transform))
+        {
+            OnSceneRenderingDirty(prevBounds);
+            OnSceneRenderingDirty(a->GetSphere());
+        }
+    }
+
+    void OnSceneRenderingRemoveActor(Actor* a) override
+    {
+        if (EnumHasAnyFlags(a->GetStaticFlags(), StaticFlags::Transform))
+            OnSceneRenderingDirty(a->GetSphere());
+    }
+
+    void OnSceneRenderingClear(SceneRendering* scene) override
+    {
+        for (auto& e : Lights)
+            e.Value.DirtyFaces = MAX_uint32;
+    }
+};
+
 PACK_STRUCT(struct Data{
     GBufferData GBuffer;
     LightData Light;
@@ -322,6 +412,9 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
         }
     }
 
+    // Cached static casters depth requires a stable cascades placement
+    const bool useCache = CanCacheStaticShadowMap(renderContext, light.StaticFlags);
+
     // Temporary data
     Float3 frustumCorners[8];
     Matrix shadowView, shadowProjection, shadowVP;
@@ -377,7 +470,19 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
             cascadeMaxBoundLS = Float3(boundingVSRadius);
             cascadeMinBoundLS = -cascadeMaxBoundLS;
 
-            if (stabilization == ViewSnapping)
+            if (useCache)
+            {
+                // Snap the cascade to the coarse cells and extend it to cover the cell so the projection stays the same over many frames (static casters depth is reused until view leaves the cell)
+                const float cellSize = boundingVSRadius * SHADOWS_PASS_CASCADE_CELL_SIZE;
+                boundingVSRadius += cellSize;
+                cascadeMaxBoundLS = Float3(boundingVSRadius);
+                cascadeMinBoundLS = -cascadeMaxBoundLS;
+                const float x = Math::Round(Float3::Dot(target, upDirection) / cellSize) * cellSize;
+                const float y = Math::Round(Float3::Dot(target, side) / cellSize) * cellSize;
+                const float z = Math::Round(Float3::Dot(target, lightDirection) / cellSize) * cellSize;
+                target = upDirection * x + side * y + lightDirection * z;
+            }
+            else if (stabilization == ViewSnapping)
             {
                 // Snap the target to the texel units (reference: ShaderX7 - Practical Cascaded Shadows Maps)
                 float shadowMapHalfSize = shadowMapsSizeCSM * 0.5f;
@@ -441,6 +546,8 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
         shadowContext.View.CullingFrustum.SetMatrix(cullingVP);
         shadowContext.View.PrepareCache(shadowContext, shadowMapsSizeCSM, shadowMapsSizeCSM, Float2::Zero, &view);
     }
+    if (useCache)
+        SetupStaticShadowMap(renderContext, renderContextBatch, shadowData, light.ID, light.StaticFlags, _shadowMapCSM, true);
 
     // Setup constant buffer data
     shadowData.Constants.ShadowMapSize = shadowMapsSizeCSM;
@@ -481,6 +588,7 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
         shadowContext.View.PrepareCache(shadowContext, shadowMapsSizeCube, shadowMapsSizeCube, Float2::Zero, &view);
         Matrix::Transpose(shadowContext.View.ViewProjection(), shadowData.Constants.ShadowVP[faceIndex]);
     }
+    SetupStaticShadowMap(renderContext, renderContextBatch, shadowData, light.ID, light.StaticFlags, _shadowMapCube, false);
 
     // Setup constant buffer data
     shadowData.Constants.ShadowMapSize = shadowMapsSizeCube;
@@ -520,6 +628,7 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
         shadowContext.View.PrepareCache(shadowContext, shadowMapsSizeCube, shadowMapsSizeCube, Float2::Zero, &view);
         Matrix::Transpose(shadowContext.View.ViewProjection(), shadowData.Constants.ShadowVP[faceIndex]);
     }
+    SetupStaticShadowMap(renderContext, renderContextBatch, shadowData, light.ID, light.StaticFlags, _shadowMapCube, false);
 
     // Setup constant buffer data
     shadowData.Constants.ShadowMapSize = shadowMapsSizeCube;
@@ -532,6 +641,213 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
     shadowData.Constants.CascadeSplits = Float4::Zero;
 }
 
+bool ShadowsPass::CanCacheStaticShadowMap(const RenderContext& renderContext, StaticFlags lightFlags) const
+{
+    // Cache static casters only for the lights that don't move (dynamic lights would invalidate it every frame)
+    return Graphics::StaticShadowsCaching && EnumHasAnyFlags(lightFlags, StaticFlags::Transform) && !renderContext.View.IsOfflinePass && renderContext.Buffers;
+}
+
+void ShadowsPass::SetupStaticShadowMap(RenderContext& renderContext, RenderContextBatch& renderContextBatch, ShadowData& shadowData, const Guid& lightId, StaticFlags lightFlags, GPUTexture* shadowMap, bool useViewLOD)
+{
+    if (!CanCacheStaticShadowMap(renderContext, lightFlags))
+        return;
+    auto& shadowsData = *renderContext.Buffers->GetCustomBuffer<ShadowsCustomBuffer>(TEXT("Shadows"));
+    const uint64 currentFrame = Engine::FrameCount;
+    shadowsData.LastFrameUsed = currentFrame;
+    for (SceneRendering* scene : renderContext.List->Scenes)
+        shadowsData.ListenSceneRendering(scene);
+
+    // Get the light cache (evict the least recently used light when over the limit)
+    auto* light = shadowsData.Lights.TryGet(lightId);
+    if (!light)
+    {
+        if (shadowsData.Lights.Count() >= SHADOWS_PASS_MAX_CACHED_LIGHTS)
+        {
+            Guid oldestId;
+            uint64 oldestFrame = currentFrame;
+            for (const auto& e : shadowsData.Lights)
+            {
+                if (e.Value.LastFrameUsed < oldestFrame)
+                {
+                    oldestId = e.Key;
+                    oldestFrame = e.Value.LastFrameUsed;
+                }
+            }
+            if (oldestFrame == currentFrame)
+                return;
+            shadowsData.Evict(oldestId);
+        }
+        light = &shadowsData.Lights[lightId];
+        for (Matrix& e : light->FacesViewProjection)
+            e = Matrix::Zero;
+    }
+    light->LastFrameUsed = currentFrame;
+
+    // Allocate the static shadow map (matches the format and size of the shadow map used for the light rendering, one slice per face)
+    const int32 facesCount = shadowData.ContextCount;
+    const GPUTextureDescription& shadowMapDesc = shadowMap->GetDescription();
+    const GPUTextureDescription desc = facesCount == 6 && shadowMapDesc.IsCubeMap() ? shadowMapDesc : GPUTextureDescription::New2D(shadowMapDesc.Width, shadowMapDesc.Height, shadowMapDesc.Format, shadowMapDesc.Flags, 1, facesCount);
+    if (light->ShadowMap && light->ShadowMap->GetDescription() != desc)
+    {
+        RenderTargetPool::Release(light->ShadowMap);
+        light->ShadowMap = nullptr;
+    }
+    if (!light->ShadowMap)
+    {
+        light->ShadowMap = RenderTargetPool::Get(desc);
+        if (!light->ShadowMap)
+        {
+            shadowsData.Evict(lightId);
+            return;
+        }
+        RENDER_TARGET_POOL_SET_NAME(light->ShadowMap, "Shadows.StaticShadowMap");
+        light->DirtyFaces = MAX_uint32;
+    }
+
+    // Invalidate faces which projection has changed
+    const Vector3 origin = renderContext.View.Origin;
+    if (light->Origin != origin || light->FacesCount != facesCount)
+    {
+        light->Origin = origin;
+        light->FacesCount = facesCount;
+        light->DirtyFaces = MAX_uint32;
+    }
+    uint32 dirtyFaces = 0;
+    for (int32 faceIndex = 0; faceIndex < facesCount; faceIndex++)
+    {
+        const RenderView& faceView = renderContextBatch.Contexts[shadowData.ContextIndex + faceIndex].View;
+        if (light->FacesViewProjection[faceIndex] != faceView.ViewProjection())
+        {
+            light->FacesViewProjection[faceIndex] = faceView.ViewProjection();
+            light->FacesFrustum[faceIndex] = faceView.CullingFrustum;
+            light->DirtyFaces |= 1 << faceIndex;
+        }
+        if (light->DirtyFaces & (1 << faceIndex))
+            dirtyFaces |= 1 << faceIndex;
+    }
+
+    if (dirtyFaces)
+    {
+        // Limit the amount of the static shadow maps updates (render the whole shadow map as usual until the cache gets updated)
+        if (_staticBatches.Count() >= SHADOWS_PASS_MAX_STATIC_UPDATES)
+            return;
+
+        // Setup static objects projections for the dirty faces (local lights select LOD from the light view to not depend on the camera)
+        shadowData.StaticBatchIndex = _staticBatches.Count();
+        shadowData.StaticFaces = dirtyFaces;
+        auto& staticBatch = _staticBatches.AddOne();
+        staticBatch.Buffers = renderContext.Buffers;
+        staticBatch.Task = renderContext.Task;
+        staticBatch.EnableAsync = renderContextBatch.EnableAsync;
+        for (int32 faceIndex = 0; faceIndex < facesCount; faceIndex++)
+        {
+            if ((dirtyFaces & (1 << faceIndex)) == 0)
+                continue;
+            auto& staticContext = staticBatch.Contexts.AddOne();
+            SetupRenderContext(renderContext, staticContext);
+            if (!useViewLOD)
+                staticContext.LodProxyView = nullptr;
+            staticContext.List->Clear();
+            staticContext.List->StaticFlagsFilterMask = StaticFlags::Transform;
+            staticContext.List->StaticFlagsFilterValue = StaticFlags::Transform;
+            staticContext.View = renderContextBatch.Contexts[shadowData.ContextIndex + faceIndex].View;
+        }
+    }
+    shadowData.StaticShadowMap = light->ShadowMap;
+    shadowData.LightID = lightId;
+
+    // Draw only dynamic objects into the light projections
+    for (int32 faceIndex = 0; faceIndex < facesCount; faceIndex++)
+    {
+        auto& shadowContext = renderContextBatch.Contexts[shadowData.ContextIndex + faceIndex];
+        shadowContext.List->StaticFlagsFilterMask = StaticFlags::Transform;
+        shadowContext.List->StaticFlagsFilterValue = StaticFlags::None;
+    }
+}
+
+void ShadowsPass::CollectStaticShadows(SceneRenderTask* task)
+{
+    if (_staticBatches.IsEmpty())
+        return;
+    PROFILE_CPU();
+    for (auto& staticBatch : _staticBatches)
+    {
+        // Draw static objects (each batch is drawn separately as scene rendering uses a single batch at once)
+        JobSystem::SetJobStartingOnDispatch(false);
+        task->OnCollectDrawCalls(staticBatch, SceneRendering::DrawCategory::SceneDraw);
+        task->OnCollectDrawCalls(staticBatch, SceneRendering::DrawCategory::SceneDrawAsync);
+        JobSystem::SetJobStartingOnDispatch(true);
+        for (const uint64 label : staticBatch.WaitLabels)
+            JobSystem::Wait(label);
+        staticBatch.WaitLabels.Clear();
+
+        // Sort draw calls
+        RenderContext& mainContext = staticBatch.GetMainContext();
+        for (RenderContext& staticContext : staticBatch.Contexts)
+        {
+            staticContext.List->SortDrawCalls(staticContext, false, DrawCallsListType::Depth);
+            staticContext.List->SortDrawCalls(staticContext, false, staticContext.List->ShadowDepthDrawCallsList, mainContext.List->DrawCalls);
+        }
+    }
+}
+
+void ShadowsPass::RenderShadowMap(GPUContext* context, RenderContextBatch& renderContextBatch, ShadowData& shadowData, GPUTexture* shadowMap)
+{
+    RenderContext& renderContext = renderContextBatch.GetMainContext();
+    if (shadowData.StaticShadowMap)
+    {
+        if (shadowData.StaticBatchIndex != -1)
+        {
+            // Update the cached static objects depth of the dirty faces
+            auto& staticBatch = _staticBatches[shadowData.StaticBatchIndex];
+            const auto& staticDrawCalls = staticBatch.GetMainContext().List->DrawCalls;
+            int32 staticContextIndex = 0;
+            for (int32 faceIndex = 0; faceIndex < shadowData.ContextCount; faceIndex++)
+            {
+                if ((shadowData.StaticFaces & (1 << faceIndex)) == 0)
+                    continue;
+                auto rt = shadowData.StaticShadowMap->View(faceIndex);
+                context->ResetSR();
+                context->SetRenderTarget(rt, static_cast<GPUTextureView*>(nullptr));
+                context->ClearDepth(rt);
+                auto& staticContext = staticBatch.Contexts[staticContextIndex++];
+                staticContext.List->ExecuteDrawCalls(staticContext, DrawCallsListType::Depth);
+                staticContext.List->ExecuteDrawCalls(staticContext, staticContext.List->ShadowDepthDrawCallsList, staticDrawCalls, nullptr);
+            }
+            context->ResetRenderTarget();
+            if (auto* light = renderContext.Buffers->GetCustomBuffer<ShadowsCustomBuffer>(TEXT("Shadows"))->Lights.TryGet(shadowData.LightID))
+                light->DirtyFaces &= ~shadowData.StaticFaces;
+        }
+
+        // Start from the static objects depth
+        for (int32 faceIndex = 0; faceIndex < shadowData.ContextCount; faceIndex++)
+            context->CopySubresource(shadowMap, faceIndex, shadowData.StaticShadowMap, faceIndex);
+    }
+
+    // Render depth to all faces of the shadow map
+    for (int32 faceIndex = 0; faceIndex < shadowData.ContextCount; faceIndex++)
+    {
+        auto rt = shadowMap->View(faceIndex);
+        context->ResetSR();
+        context->SetRenderTarget(rt, static_cast<GPUTextureView*>(nullptr));
+        if (!shadowData.StaticShadowMap)
+            context->ClearDepth(rt);
+        auto& shadowContext = renderContextBatch.Contexts[shadowData.ContextIndex + faceIndex];
+        shadowContext.List->ExecuteDrawCalls(shadowContext, DrawCallsListType::Depth);
+        shadowContext.List->ExecuteDrawCalls(shadowContext, shadowContext.List->ShadowDepthDrawCallsList, renderContext.List->DrawCalls, nullptr);
+    }
+}
+
+void ShadowsPass::ReleaseStaticBatches()
+{
+    for (const auto& staticBatch : _staticBatches)
+    {
+        for (const auto& e : staticBatch.Contexts)
+            RenderList::ReturnToPool(e.List);
+    }
+    _staticBatches.Clear();
+}
+
 void ShadowsPass::Dispose()
 {
     // Base
@@ -543,6 +859,7 @@ void ShadowsPass::Dispose()
     _psShadowSpot.Delete();
     _shader = nullptr;
     _sphereModel = nullptr;
+    ReleaseStaticBatches();
     SAFE_DELETE_GPU_RESOURCE(_shadowMapCSM);
     SAFE_DELETE_GPU_RESOURCE(_shadowMapCube);
 }
@@ -551,6 +868,7 @@ void ShadowsPass::Prepare()
 {
     // Clear cached data
     _shadowData.Clear();
+    ReleaseStaticBatches();
     LastDirLightIndex = -1;
     LastDirLightShadowMap = nullptr;
 }
@@ -634,16 +952,7 @@ void ShadowsPass::RenderShadow(RenderContextBatch& renderContextBatch, RendererP
     context->SetViewportAndScissors(shadowMapsSizeCube, shadowMapsSizeCube);
 
     // Render depth to all 6 faces of the cube map
-    for (int32 faceIndex = 0; faceIndex < 6; faceIndex++)
-    {
-        auto rt = _shadowMapCube->View(faceIndex);
-        context->ResetSR();
-        context->SetRenderTarget(rt, static_cast<GPUTextureView*>(nullptr));
-        context->ClearDepth(rt);
-        auto& shadowContext = renderContextBatch.Contexts[shadowData.ContextIndex + faceIndex];
-        shadowContext.List->ExecuteDrawCalls(shadowContext, DrawCallsListType::Depth);
-        shadowContext.List->ExecuteDrawCalls(shadowContext, shadowContext.List->ShadowDepthDrawCallsList, renderContext.List->DrawCalls, nullptr);
-    }
+    RenderShadowMap(context, renderContextBatch, shadowData, _shadowMapCube);
 
     // Restore GPU context
     context->ResetSR();
@@ -713,15 +1022,7 @@ void ShadowsPass::RenderShadow(RenderContextBatch& renderContextBatch, RendererS
 
     // Render depth to all 1 face of the cube map
     constexpr int32 faceIndex = 0;
-    {
-        auto rt = _shadowMapCube->View(faceIndex);
-        context->ResetSR();
-        context->SetRenderTarget(rt, static_cast<GPUTextureView*>(nullptr));
-        context->ClearDepth(rt);
-        auto& shadowContext = renderContextBatch.Contexts[shadowData.ContextIndex + faceIndex];
-        shadowContext.List->ExecuteDrawCalls(shadowContext, DrawCallsListType::Depth);
-        shadowContext.List->ExecuteDrawCalls(shadowContext, shadowContext.List->ShadowDepthDrawCallsList, renderContext.List->DrawCalls, nullptr);
-    }
+    RenderShadowMap(context, renderContextBatch, shadowData, _shadowMapCube);
 
     // Restore GPU context
     context->ResetSR();
@@ -782,16 +1083,7 @@ void ShadowsPass::RenderShadow(RenderContextBatch& renderContextBatch, RendererD
     context->SetViewportAndScissors(shadowMapsSizeCSM, shadowMapsSizeCSM);
 
     // Render shadow map for each projection
-    for (int32 cascadeIndex = 0; cascadeIndex < shadowData.ContextCount; cascadeIndex++)
-    {
-        const auto rt = _shadowMapCSM->View(cascadeIndex);
-        context->ResetSR();
-        context->SetRenderTarget(rt, static_cast<GPUTextureView*>(nullptr));
-        context->ClearDepth(rt);
-        auto& shadowContext = renderContextBatch.Contexts[shadowData.ContextIndex + cascadeIndex];
-        shadowContext.List->ExecuteDrawCalls(shadowContext, DrawCallsListType::Depth);
-        shadowContext.List->ExecuteDrawCalls(shadowContext, shadowContext.List->ShadowDepthDrawCallsList, renderContext.List->DrawCalls, nullptr);
-    }
+    RenderShadowMap(context, renderContextBatch, shadowData, _shadowMapCSM);
 
     // Restore GPU context
     context->ResetSR();
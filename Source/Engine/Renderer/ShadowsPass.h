@@ -48,6 +48,14 @@ class ShadowsPass : public RendererPass<ShadowsPass>
         int32 ContextCount;
         bool BlendCSM;
         LightShadowData Constants;
+
+        // The cached static shadow casters depth (optional, then shadow projections contexts contain only dynamic objects)
+        GPUTexture* StaticShadowMap = nullptr;
+        // The index of the static shadow casters batch in _staticBatches to render into StaticShadowMap or -1 if it's up to date
+        int32 StaticBatchIndex = -1;
+        // The mask of the faces (projections) to update in the static shadow map with the static casters batch
+        uint32 StaticFaces = 0;
+        Guid LightID;
     };
 
     // Shader stuff
@@ -67,6 +75,7 @@ class ShadowsPass : public RendererPass<ShadowsPass>
     // Shadow map rendering stuff
     AssetReference<Model> _sphereModel;
     Array<ShadowData> _shadowData;
+    Array<RenderContextBatch> _staticBatches;
 
     // Cached state for the current frame rendering (setup via Prepare)
     int32 maxShadowsQuality;
@@ -101,6 +110,12 @@ class ShadowsPass : public RendererPass<ShadowsPass>
     /// </summary>
     void SetupShadows(RenderContext& renderContext, RenderContextBatch& renderContextBatch);
 
+    /// <summary>
+    /// Collects the draw calls for the cached static shadow maps that need to be updated. Called after scene drawing for the main batch.
+    /// </summary>
+    /// <param name="task">The scene rendering task.</param>
+    void CollectStaticShadows(SceneRenderTask* task);
+
     /// <summary>
     /// Determines whether can render shadow for the specified light.
     /// </summary>
@@ -157,6 +172,10 @@ class ShadowsPass : public RendererPass<ShadowsPass>
     void SetupLight(RenderContext& renderContext, RenderContextBatch& renderContextBatch, RendererDirectionalLightData& light);
     void SetupLight(RenderContext& renderContext, RenderContextBatch& renderContextBatch, RendererPointLightData& light);
     void SetupLight(RenderContext& renderContext, RenderContextBatch& renderContextBatch, RendererSpotLightData& light);
+    bool CanCacheStaticShadowMap(const RenderContext& renderContext, StaticFlags lightFlags) const;
+    void SetupStaticShadowMap(RenderContext& renderContext, RenderContextBatch& renderContextBatch, ShadowData& shadowData, const Guid& lightId, StaticFlags lightFlags, GPUTexture* shadowMap, bool useViewLOD);
+    void RenderShadowMap(GPUContext* context, RenderContextBatch& renderContextBatch, ShadowData& shadowData, GPUTexture* shadowMap);
+    void ReleaseStaticBatches();
 
 #if COMPILE_WITH_DEV_ENV
     void OnShaderReloading(Asset* obj)
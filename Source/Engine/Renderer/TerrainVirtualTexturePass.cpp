@@ -0,0 +1,370 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "TerrainVirtualTexturePass.h"
+#include "RenderList.h"
+#include "GBufferPass.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Core/Math/BoundingSphere.h"
+#include "Engine/Core/Math/Matrix.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/RenderBuffers.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Graphics/RenderTools.h"
+#include "Engine/Graphics/Textures/GPUTexture.h"
+#include "Engine/Content/Assets/MaterialBase.h"
+#include "Engine/Profiler/Profiler.h"
+#include "Engine/Terrain/Terrain.h"
+#include "Engine/Terrain/TerrainPatch.h"
+#include "Engine/Terrain/TerrainChunk.h"
+#include "Engine/Threading/Threading.h"
+
+// Extra space above the chunk bounds for the top-down projection (in world units)
+#define TERRAIN_VIRTUAL_TEXTURE_PROJ_PLANE_OFFSET 10.0f
+
+// Padding around the tile (in pixels) to prevent bleeding of the neighbor tiles when using bilinear filtering
+#define TERRAIN_VIRTUAL_TEXTURE_TILE_PADDING 1
+
+bool TerrainVirtualTexturePass::GetTile(const RenderContext& renderContext, const TerrainChunk* chunk, const BoundingSphere& sphere, MaterialBase* material, Float4& uvScaleBias, float& uvClamp)
+{
+    // Pick the tile resolution based on the chunk size on the screen
+    const float screenRadius = Math::Sqrt(RenderTools::ComputeBoundsScreenRadiusSquared(sphere.Center - renderContext.View.Origin, (float)sphere.Radius, renderContext.View)) * renderContext.View.ScreenSize.Y;
+    const int32 desiredSize = Math::Clamp(Math::RoundUpToPowerOf2((int32)(screenRadius * 1.41f)), TERRAIN_VIRTUAL_TEXTURE_MIN_TILE_SIZE, TERRAIN_VIRTUAL_TEXTURE_MAX_TILE_SIZE);
+    const int32 materialVersion = material->Params.GetVersionHash();
+    const uint64 frame = Engine::FrameCount;
+
+    ScopeLock lock(_locker);
+    Tile& tile = _tiles[chunk];
+    if (tile.LastFrameUsed != frame)
+    {
+        tile.LastFrameUsed = frame;
+        tile.DesiredSize = desiredSize;
+    }
+    else
+    {
+        // Use the highest resolution when chunk is visible in multiple views
+        tile.DesiredSize = Math::Max(tile.DesiredSize, desiredSize);
+    }
+    if (tile.Material != material || tile.MaterialVersion != materialVersion)
+    {
+        tile.Material = material;
+        tile.MaterialVersion = materialVersion;
+        tile.IsReady = false;
+    }
+    if (!tile.IsReady || !_atlas[0])
+        return false;
+
+    // Convert chunk UVs into the atlas space (skip padding)
+    const float atlasSizeInv = 1.0f / TERRAIN_VIRTUAL_TEXTURE_ATLAS_SIZE;
+    const float innerSize = (float)(tile.Size - 2 * TERRAIN_VIRTUAL_TEXTURE_TILE_PADDING);
+    uvScaleBias.X = innerSize * atlasSizeInv;
+    uvScaleBias.Y = innerSize * atlasSizeInv;
+    uvScaleBias.Z = (float)(tile.Position.X + TERRAIN_VIRTUAL_TEXTURE_TILE_PADDING) * atlasSizeInv;
+    uvScaleBias.W = (float)(tile.Position.Y + TERRAIN_VIRTUAL_TEXTURE_TILE_PADDING) * atlasSizeInv;
+    uvClamp = 0.5f / innerSize;
+    return true;
+}
+
+void TerrainVirtualTexturePass::Invalidate(const TerrainPatch* patch, bool release)
+{
+    ScopeLock lock(_locker);
+    for (auto it = _tiles.Begin(); it.IsNotEnd(); ++it)
+    {
+        if (it->Key->GetPatch() != patch)
+            continue;
+        Tile& tile = it->Value;
+        if (release)
+        {
+            if (tile.Size != 0)
+                _pendingFreeBlocks.Add(Int3(tile.Position, GetLevel(tile.Size)));
+            _tiles.Remove(it);
+        }
+        else
+        {
+            tile.IsReady = false;
+        }
+    }
+}
+
+void TerrainVirtualTexturePass::Render(RenderContext& renderContext, GPUContext* context)
+{
+    ScopeLock lock(_locker);
+    if (_tiles.IsEmpty())
+        return;
+    const uint64 frame = Engine::FrameCount;
+
+    // Release blocks of the tiles moved or removed in the previous frames (rendering of those happens before this point)
+    for (const Int3& e : _pendingFreeBlocks)
+        FreeBlock(e.Z, Int2(e.X, e.Y));
+    _pendingFreeBlocks.Clear();
+
+    // Collect tiles to render (missing ones go first, then resized ones)
+    _bakeList.Clear();
+    for (auto it = _tiles.Begin(); it.IsNotEnd(); ++it)
+    {
+        Tile& tile = it->Value;
+        if (tile.LastFrameUsed + TERRAIN_VIRTUAL_TEXTURE_CACHE_FRAMES < frame)
+        {
+            // Release unused tile
+            if (tile.Size != 0)
+                FreeBlock(GetLevel(tile.Size), tile.Position);
+            _tiles.Remove(it);
+            continue;
+        }
+        if (tile.LastFrameUsed != frame)
+            continue;
+        if (tile.IsReady && tile.Residency != GetResidency(it->Key->GetPatch()))
+        {
+            // Re-render tile after terrain textures streaming
+            tile.IsReady = false;
+        }
+        if (!tile.IsReady)
+            _bakeList.Add(it->Key);
+    }
+    for (auto it = _tiles.Begin(); it.IsNotEnd() && _bakeList.Count() < TERRAIN_VIRTUAL_TEXTURE_MAX_TILES_PER_FRAME; ++it)
+    {
+        const Tile& tile = it->Value;
+        if (tile.LastFrameUsed == frame && tile.IsReady && (tile.DesiredSize > tile.Size || tile.DesiredSize * 4 <= tile.Size))
+            _bakeList.Add(it->Key);
+    }
+    if (_bakeList.IsEmpty())
+        return;
+    if (_bakeList.Count() > TERRAIN_VIRTUAL_TEXTURE_MAX_TILES_PER_FRAME)
+        _bakeList.Resize(TERRAIN_VIRTUAL_TEXTURE_MAX_TILES_PER_FRAME);
+    PROFILE_GPU_CPU("Terrain Virtual Texture");
+
+    // Initialize atlas
+    if (!_atlas[0])
+    {
+        auto desc = GPUTextureDescription::New2D(TERRAIN_VIRTUAL_TEXTURE_ATLAS_SIZE, TERRAIN_VIRTUAL_TEXTURE_ATLAS_SIZE, PixelFormat::Unknown);
+#define INIT_ATLAS_TEXTURE(texture, format, name) desc.Format = format; texture = GPUDevice::Instance->CreateTexture(TEXT(name)); if (texture->Init(desc)) { LOG(Error, "Failed to create terrain virtual texture atlas."); Dispose(); return; }
+        INIT_ATLAS_TEXTURE(_atlas[0], PixelFormat::R11G11B10_Float, "TerrainVirtualTexture.Emissive");
+        INIT_ATLAS_TEXTURE(_atlas[1], GBUFFER0_FORMAT, "TerrainVirtualTexture.GBuffer0");
+        INIT_ATLAS_TEXTURE(_atlas[2], GBUFFER1_FORMAT, "TerrainVirtualTexture.GBuffer1");
+        INIT_ATLAS_TEXTURE(_atlas[3], GBUFFER2_FORMAT, "TerrainVirtualTexture.GBuffer2");
+        desc.Flags = GPUTextureFlags::DepthStencil;
+        INIT_ATLAS_TEXTURE(_atlasDepth, PixelFormat::D16_UNorm, "TerrainVirtualTexture.Depth");
+#undef INIT_ATLAS_TEXTURE
+        for (int32 level = 0; level < TERRAIN_VIRTUAL_TEXTURE_TILE_LEVELS; level++)
+            _freeBlocks[level].Clear();
+        const int32 blocksPerEdge = TERRAIN_VIRTUAL_TEXTURE_ATLAS_SIZE / TERRAIN_VIRTUAL_TEXTURE_MAX_TILE_SIZE;
+        for (int32 y = blocksPerEdge - 1; y >= 0; y--)
+        {
+            for (int32 x = blocksPerEdge - 1; x >= 0; x--)
+                _freeBlocks[0].Add(Int2(x, y) * TERRAIN_VIRTUAL_TEXTURE_MAX_TILE_SIZE);
+        }
+    }
+
+    // Setup rendering
+    RenderContext renderContextTiles = renderContext;
+    renderContextTiles.List = RenderList::GetFromPool();
+    renderContextTiles.View.Pass = DrawPass::GBuffer;
+    renderContextTiles.View.Mode = ViewMode::Default;
+    renderContextTiles.View.IsSingleFrame = true;
+    renderContextTiles.View.IsCullingDisabled = true;
+    renderContextTiles.View.Near = 0.0f;
+    renderContextTiles.View.Prepare(renderContextTiles);
+    auto& drawCallsListGBuffer = renderContextTiles.List->DrawCallsLists[(int32)DrawCallsListType::GBuffer];
+    auto& drawCallsListGBufferNoDecals = renderContextTiles.List->DrawCallsLists[(int32)DrawCallsListType::GBufferNoDecals];
+    drawCallsListGBuffer.CanUseInstancing = false;
+    drawCallsListGBufferNoDecals.CanUseInstancing = false;
+    GPUTextureView* depthBuffer = _atlasDepth->View();
+    GPUTextureView* targetBuffers[4] =
+    {
+        _atlas[0]->View(),
+        _atlas[1]->View(),
+        _atlas[2]->View(),
+        _atlas[3]->View(),
+    };
+    context->ClearDepth(depthBuffer);
+    context->SetRenderTarget(depthBuffer, ToSpan(targetBuffers, ARRAY_COUNT(targetBuffers)));
+
+    int32 tilesDrawn = 0;
+    for (const TerrainChunk* chunk : _bakeList)
+    {
+        Tile& tile = _tiles[chunk];
+
+        // Allocate tile (reuse existing block if size matches)
+        if (tile.Size != tile.DesiredSize)
+        {
+            const int32 level = GetLevel(tile.DesiredSize);
+            Int2 position;
+            bool failed;
+            while ((failed = AllocateBlock(level, position)) && FreeUnusedTile(frame))
+            {
+            }
+            if (failed)
+            {
+                // Atlas is full
+                continue;
+            }
+            if (tile.Size != 0)
+                _pendingFreeBlocks.Add(Int3(tile.Position, GetLevel(tile.Size)));
+            tile.Position = position;
+            tile.Size = tile.DesiredSize;
+        }
+
+        // Clear draw calls list
+        renderContextTiles.List->DrawCalls.Clear();
+        renderContextTiles.List->BatchedDrawCalls.Clear();
+        drawCallsListGBuffer.Indices.Clear();
+        drawCallsListGBuffer.PreBatchedDrawCalls.Clear();
+        drawCallsListGBufferNoDecals.Indices.Clear();
+        drawCallsListGBufferNoDecals.PreBatchedDrawCalls.Clear();
+
+        // Collect draw calls for the chunk (use the highest streamed-in LOD)
+        const TerrainPatch* patch = chunk->GetPatch();
+        const int32 lod = patch->Heightmap->StreamingTexture()->TotalMipLevels() - patch->Heightmap->GetTexture()->ResidentMipLevels();
+        chunk->Draw(renderContextTiles, tile.Material, lod);
+        for (int32 i = 0; i < renderContextTiles.List->DrawCalls.Count(); i++)
+        {
+            // Lighting is applied in the main view
+            renderContextTiles.List->DrawCalls[i].Terrain.Lightmap = nullptr;
+        }
+
+        // Setup projection to capture the chunk from the top
+        const BoundingBox& bounds = chunk->GetBounds();
+        const Transform& transform = chunk->GetTransform();
+        const Float3 up = transform.GetUp();
+        const float radius = (float)bounds.GetSize().Length() * 0.5f;
+        const Float3 viewPosition = (Float3)(bounds.GetCenter() - renderContext.View.Origin) + up * (radius + TERRAIN_VIRTUAL_TEXTURE_PROJ_PLANE_OFFSET);
+        const float chunkSize = TERRAIN_UNITS_PER_VERTEX * (float)patch->GetTerrain()->GetChunkSize();
+        renderContextTiles.View.Position = viewPosition;
+        renderContextTiles.View.Direction = -up;
+        renderContextTiles.View.Near = 0.0f;
+        renderContextTiles.View.Far = 2.0f * (radius + TERRAIN_VIRTUAL_TEXTURE_PROJ_PLANE_OFFSET);
+        Matrix viewMatrix, projectionMatrix;
+        Matrix::LookAt(viewPosition, viewPosition - up, transform.GetForward(), viewMatrix);
+        Matrix::Ortho(chunkSize * transform.Scale.X, chunkSize * transform.Scale.Z, renderContextTiles.View.Near, renderContextTiles.View.Far, projectionMatrix);
+        renderContextTiles.View.SetUp(viewMatrix, projectionMatrix);
+
+        // Draw
+        const float innerSize = (float)(tile.Size - 2 * TERRAIN_VIRTUAL_TEXTURE_TILE_PADDING);
+        context->SetViewportAndScissors(Viewport((float)(tile.Position.X + TERRAIN_VIRTUAL_TEXTURE_TILE_PADDING), (float)(tile.Position.Y + TERRAIN_VIRTUAL_TEXTURE_TILE_PADDING), innerSize, innerSize));
+        renderContextTiles.List->ExecuteDrawCalls(renderContextTiles, drawCallsListGBuffer);
+        renderContextTiles.List->ExecuteDrawCalls(renderContextTiles, drawCallsListGBufferNoDecals);
+        tile.Residency = GetResidency(patch);
+        tile.IsReady = true;
+        tilesDrawn++;
+    }
+    ZoneValue(tilesDrawn);
+
+    context->ResetRenderTarget();
+    context->SetViewportAndScissors(renderContext.Task->GetViewport());
+    RenderList::ReturnToPool(renderContextTiles.List);
+}
+
+bool TerrainVirtualTexturePass::AllocateBlock(int32 level, Int2& result)
+{
+    auto& freeBlocks = _freeBlocks[level];
+    if (freeBlocks.HasItems())
+    {
+        result = freeBlocks.Last();
+        freeBlocks.RemoveLast();
+        return false;
+    }
+    if (level == 0)
+        return true;
+
+    // Split the bigger block into 4
+    Int2 parent;
+    if (AllocateBlock(level - 1, parent))
+        return true;
+    const int32 size = TERRAIN_VIRTUAL_TEXTURE_MAX_TILE_SIZE >> level;
+    freeBlocks.Add(parent + Int2(size, size));
+    freeBlocks.Add(parent + Int2(0, size));
+    freeBlocks.Add(parent + Int2(size, 0));
+    result = parent;
+    return false;
+}
+
+void TerrainVirtualTexturePass::FreeBlock(int32 level, Int2 block)
+{
+    auto& freeBlocks = _freeBlocks[level];
+    if (level != 0)
+    {
+        // Merge with the buddies back into the bigger block if all of them are free
+        const int32 size = TERRAIN_VIRTUAL_TEXTURE_MAX_TILE_SIZE >> level;
+        const int32 parentSize = size * 2;
+        const Int2 parent((block.X / parentSize) * parentSize, (block.Y / parentSize) * parentSize);
+        int32 buddies[3];
+        int32 buddiesCount = 0;
+        for (int32 i = 0; i < 4; i++)
+        {
+            const Int2 buddy = parent + Int2(i & 1 ? size : 0, i & 2 ? size : 0);
+            if (buddy == block)
+                continue;
+            const int32 index = freeBlocks.Find(buddy);
+            if (index == -1)
+                break;
+            buddies[buddiesCount++] = index;
+        }
+        if (buddiesCount == 3)
+        {
+            Sorting::QuickSort(buddies, 3);
+            for (int32 i = 2; i >= 0; i--)
+                freeBlocks.RemoveAt(buddies[i]);
+            FreeBlock(level - 1, parent);
+            return;
+        }
+    }
+    freeBlocks.Add(block);
+}
+
+bool TerrainVirtualTexturePass::FreeUnusedTile(uint64 currentFrame)
+{
+    // Evict the least recently used tile
+    auto oldest = _tiles.End();
+    for (auto it = _tiles.Begin(); it.IsNotEnd(); ++it)
+    {
+        const Tile& tile = it->Value;
+        if (tile.Size != 0 && tile.LastFrameUsed < currentFrame && (oldest.IsEnd() || tile.LastFrameUsed < oldest->Value.LastFrameUsed))
+            oldest = it;
+    }
+    if (oldest.IsEnd())
+        return false;
+    FreeBlock(GetLevel(oldest->Value.Size), oldest->Value.Position);
+    _tiles.Remove(oldest);
+    return true;
+}
+
+int32 TerrainVirtualTexturePass::GetResidency(const TerrainPatch* patch)
+{
+    int32 result = patch->Heightmap ? patch->Heightmap->GetTexture()->ResidentMipLevels() : 0;
+    for (int32 i = 0; i < TERRAIN_MAX_SPLATMAPS_COUNT; i++)
+    {
+        if (patch->Splatmap[i])
+            result = result * 16 + patch->Splatmap[i]->GetTexture()->ResidentMipLevels();
+    }
+    return result;
+}
+
+int32 TerrainVirtualTexturePass::GetLevel(int32 size)
+{
+    int32 level = 0;
+    while ((TERRAIN_VIRTUAL_TEXTURE_MAX_TILE_SIZE >> level) > size && level < TERRAIN_VIRTUAL_TEXTURE_TILE_LEVELS - 1)
+        level++;
+    return level;
+}
+
+String TerrainVirtualTexturePass::ToString() const
+{
+    return TEXT("TerrainVirtualTexturePass");
+}
+
+void TerrainVirtualTexturePass::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    ScopeLock lock(_locker);
+    SAFE_DELETE_GPU_RESOURCES(_atlas);
+    SAFE_DELETE_GPU_RESOURCE(_atlasDepth);
+    _tiles.Clear();
+    _bakeList.Clear();
+    _pendingFreeBlocks.Clear();
+    for (int32 level = 0; level < TERRAIN_VIRTUAL_TEXTURE_TILE_LEVELS; level++)
+        _freeBlocks[level].Clear();
+}
@@ -0,0 +1,107 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "RendererPass.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Math/Vector2.h"
+#include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Math/Vector4.h"
+#include "Engine/Platform/CriticalSection.h"
+
+class TerrainChunk;
+class TerrainPatch;
+class MaterialBase;
+struct BoundingSphere;
+
+// Resolution of the terrain virtual texture atlas (in pixels)
+#define TERRAIN_VIRTUAL_TEXTURE_ATLAS_SIZE 2048
+
+// Resolution of the biggest terrain virtual texture tile (in pixels), tiles are power-of-two sized
+#define TERRAIN_VIRTUAL_TEXTURE_MAX_TILE_SIZE 512
+
+// Resolution of the smallest terrain virtual texture tile (in pixels)
+#define TERRAIN_VIRTUAL_TEXTURE_MIN_TILE_SIZE 32
+
+// Amount of the tile sizes (between max and min)
+#define TERRAIN_VIRTUAL_TEXTURE_TILE_LEVELS 5
+
+// Maximum amount of terrain virtual texture tiles rendered during a single frame
+#define TERRAIN_VIRTUAL_TEXTURE_MAX_TILES_PER_FRAME 16
+
+// Amount of frames after which unused tile gets released from the atlas
+#define TERRAIN_VIRTUAL_TEXTURE_CACHE_FRAMES 600
+
+/// <summary>
+/// Terrain virtual texturing pass. Pre-composites the terrain material (all layers blended) into the atlas tiles cached per-chunk at the screen-driven resolution which are then sampled by the terrain material shader at a constant cost (when drawing chunks with virtual texture).
+/// </summary>
+class TerrainVirtualTexturePass : public RendererPass<TerrainVirtualTexturePass>
+{
+private:
+    struct Tile
+    {
+        Int2 Position = Int2::Zero;
+        int32 Size = 0;
+        int32 DesiredSize = 0;
+        uint64 LastFrameUsed = 0;
+        MaterialBase* Material = nullptr;
+        int32 MaterialVersion = 0;
+        int32 Residency = 0;
+        bool IsReady = false;
+    };
+
+    CriticalSection _locker;
+    Dictionary<const TerrainChunk*, Tile> _tiles;
+    Array<Int2> _freeBlocks[TERRAIN_VIRTUAL_TEXTURE_TILE_LEVELS];
+    Array<Int3> _pendingFreeBlocks; // xy-position, z-level
+    Array<const TerrainChunk*> _bakeList;
+    GPUTexture* _atlasDepth = nullptr;
+    GPUTexture* _atlas[4] = {};
+
+public:
+    /// <summary>
+    /// Gets the virtual texture tile for the terrain chunk to draw. Requests the tile rendering (or resizing) for the current frame. Thread-safe.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="chunk">The terrain chunk.</param>
+    /// <param name="sphere">The terrain chunk world-space bounds.</param>
+    /// <param name="material">The terrain chunk material.</param>
+    /// <param name="uvScaleBias">The result tile coordinates in the atlas (xy-scale, zw-offset for chunk UVs into atlas UVs).</param>
+    /// <param name="uvClamp">The result half-texel margin (in chunk UVs) to clamp sampling within the tile.</param>
+    /// <returns>True if tile is ready to use, otherwise false (chunk has to be drawn with the regular material).</returns>
+    bool GetTile(const RenderContext& renderContext, const TerrainChunk* chunk, const BoundingSphere& sphere, MaterialBase* material, Float4& uvScaleBias, float& uvClamp);
+
+    /// <summary>
+    /// Invalidates the cached tiles of the terrain patch chunks (eg. after terrain modification).
+    /// </summary>
+    /// <param name="patch">The terrain patch.</param>
+    /// <param name="release">True if release the tiles from the atlas (eg. when patch gets deleted), otherwise tiles will be re-rendered when used.</param>
+    void Invalidate(const TerrainPatch* patch, bool release = false);
+
+    /// <summary>
+    /// Gets the atlas texture (0 - emissive, 1-3 - GBuffer0-2) or null if not created.
+    /// </summary>
+    GPUTexture* GetAtlas(int32 index) const
+    {
+        return _atlas[index];
+    }
+
+    /// <summary>
+    /// Renders the requested virtual texture tiles into the atlas. Called before rendering GBuffer.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="context">The GPU context.</param>
+    void Render(RenderContext& renderContext, GPUContext* context);
+
+private:
+    bool AllocateBlock(int32 level, Int2& result);
+    void FreeBlock(int32 level, Int2 block);
+    bool FreeUnusedTile(uint64 currentFrame);
+    static int32 GetResidency(const TerrainPatch* patch);
+    static int32 GetLevel(int32 size);
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    void Dispose() override;
+};
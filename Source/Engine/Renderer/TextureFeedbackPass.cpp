@@ -0,0 +1,166 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "TextureFeedbackPass.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPULimits.h"
+#include "Engine/Graphics/RenderBuffers.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Graphics/Shaders/GPUConstantBuffer.h"
+#include "Engine/Graphics/Textures/StreamingTexture.h"
+#include "Engine/Streaming/Streaming.h"
+
+PACK_STRUCT(struct TextureFeedbackData {
+    uint32 Slots[GPU_MAX_SR_BINDED];
+    float MipBias;
+    Float3 Padding;
+    });
+
+void TextureFeedbackPass::Render(RenderContext& renderContext, GPUContext* context)
+{
+    const uint64 currentFrame = Engine::FrameCount;
+
+    // Apply the results from the previous passes (accept staging readback delay)
+    for (int32 i = 0; i < ARRAY_COUNT(_readbackBuffers); i++)
+    {
+        if (_readbackFrames[i] == 0 || currentFrame - _readbackFrames[i] <= GPU_ASYNC_LATENCY)
+            continue;
+        const auto data = (const uint32*)_readbackBuffers[i]->Map(GPUResourceMapMode::Read);
+        if (data)
+        {
+            PROFILE_CPU_NAMED("Texture Feedback Readback");
+            StreamingTexture::ApplyFeedback(data, STREAMING_TEXTURE_FEEDBACK_SLOTS, _readbackTimes[i]);
+            _readbackBuffers[i]->Unmap();
+        }
+        _readbackFrames[i] = 0;
+    }
+
+    // Check if can render the feedback for this view
+    if (!Streaming::TextureFeedback ||
+        renderContext.View.IsOfflinePass ||
+        GPUDevice::Instance->GetFeatureLevel() < FeatureLevel::SM5 ||
+        currentFrame - _lastFrame < (uint64)Math::Max(Streaming::TextureFeedbackInterval, 1))
+        return;
+    int32 readbackIndex = -1;
+    for (int32 i = 0; i < ARRAY_COUNT(_readbackBuffers) && readbackIndex == -1; i++)
+    {
+        if (_readbackFrames[i] == 0)
+            readbackIndex = i;
+    }
+    if (readbackIndex == -1)
+        return;
+    PROFILE_GPU_CPU("Texture Feedback");
+    _lastFrame = currentFrame;
+
+    // Setup resources
+    if (!_feedbackBuffer)
+    {
+        bool failed = false;
+        _feedbackBuffer = GPUDevice::Instance->CreateBuffer(TEXT("TextureFeedback"));
+        failed |= _feedbackBuffer->Init(GPUBufferDescription::Typed(STREAMING_TEXTURE_FEEDBACK_SLOTS, PixelFormat::R32_UInt, true));
+        const GPUBufferDescription readbackDesc = GPUBufferDescription::Buffer(STREAMING_TEXTURE_FEEDBACK_SLOTS * sizeof(uint32), GPUBufferFlags::None, PixelFormat::R32_UInt, nullptr, sizeof(uint32), GPUResourceUsage::StagingReadback);
+        for (int32 i = 0; i < ARRAY_COUNT(_readbackBuffers); i++)
+        {
+            _readbackBuffers[i] = GPUDevice::Instance->CreateBuffer(TEXT("TextureFeedback.Readback"));
+            failed |= _readbackBuffers[i]->Init(readbackDesc);
+        }
+        _cb = GPUDevice::Instance->CreateConstantBuffer(sizeof(TextureFeedbackData), TEXT("TextureFeedback.Data"));
+        if (failed || !_cb)
+        {
+            LOG(Error, "Failed to setup texture feedback pass resources.");
+            Dispose();
+            Streaming::TextureFeedback = false;
+            return;
+        }
+    }
+
+    // Draw scene at low resolution (use half-res depth to skip occluded geometry)
+    GPUTexture* depthBuffer = renderContext.Buffers->RequestHalfResDepth(context);
+    _mipBias = -Math::Log2((float)renderContext.Buffers->GetWidth() / (float)Math::Max(depthBuffer->Width(), 1));
+    uint32 clearValue[4] = { MAX_uint32, MAX_uint32, MAX_uint32, MAX_uint32 };
+    context->ClearUA(_feedbackBuffer, clearValue);
+    context->ResetSR();
+    context->ResetRenderTarget();
+    context->SetRenderTarget(depthBuffer->View(), (GPUTextureView*)nullptr);
+    context->SetViewportAndScissors((float)depthBuffer->Width(), (float)depthBuffer->Height());
+    context->BindUA(0, _feedbackBuffer->View());
+    const DrawPass prevPass = renderContext.View.Pass;
+    renderContext.View.Pass = DrawPass::TextureFeedback;
+    CollectDrawCalls(renderContext.List, DrawCallsListType::GBuffer);
+    renderContext.List->ExecuteDrawCalls(renderContext, _drawCalls);
+    CollectDrawCalls(renderContext.List, DrawCallsListType::GBufferNoDecals);
+    renderContext.List->ExecuteDrawCalls(renderContext, _drawCalls);
+    renderContext.View.Pass = prevPass;
+    _drawCalls.Clear();
+    context->ResetUA();
+    context->ResetRenderTarget();
+    context->UnBindCB(3);
+    context->SetViewportAndScissors((float)renderContext.Buffers->GetWidth(), (float)renderContext.Buffers->GetHeight());
+
+    // Copy results for the CPU readback
+    _readbackFrames[readbackIndex] = currentFrame;
+    _readbackTimes[readbackIndex] = Platform::GetTimeSeconds();
+    context->CopyBuffer(_readbackBuffers[readbackIndex], _feedbackBuffer, STREAMING_TEXTURE_FEEDBACK_SLOTS * sizeof(uint32));
+}
+
+void TextureFeedbackPass::BindMaterial(GPUContext* context, const uint32* slots)
+{
+    TextureFeedbackData data;
+    for (int32 i = 0; i < GPU_MAX_SR_BINDED; i++)
+        data.Slots[i] = slots[i] != MAX_uint32 ? slots[i] : 0xffffff; // Mip offset is not used for invalid slots
+    data.MipBias = _mipBias;
+    data.Padding = Float3::Zero;
+    context->UpdateCB(_cb, &data);
+    context->BindCB(3, _cb);
+}
+
+void TextureFeedbackPass::CollectDrawCalls(RenderList* list, DrawCallsListType listType)
+{
+    // Include only draw calls with materials that support the texture feedback pass (all drawn without batching)
+    _drawCalls.Clear();
+    _drawCalls.CanUseInstancing = false;
+    const DrawCallsList& src = list->DrawCallsLists[(int32)listType];
+    const DrawCall* drawCalls = list->DrawCalls.Get();
+    const int32* indices = src.Indices.Get();
+    for (const DrawBatch& batch : src.Batches)
+    {
+        for (int32 i = 0; i < batch.BatchSize; i++)
+        {
+            const int32 index = indices[batch.StartIndex + i];
+            const DrawCall& drawCall = drawCalls[index];
+            if (!EnumHasAnyFlags(drawCall.Material->GetDrawModes(), DrawPass::TextureFeedback))
+                continue;
+            DrawBatch& dst = _drawCalls.Batches.AddOne();
+            dst.SortKey = batch.SortKey;
+            dst.StartIndex = (uint16)_drawCalls.Indices.Count();
+            dst.BatchSize = 1;
+            dst.InstanceCount = drawCall.InstanceCount;
+            _drawCalls.Indices.Add(index);
+        }
+    }
+    const BatchedDrawCall* batchedDrawCalls = list->BatchedDrawCalls.Get();
+    for (const int32 index : src.PreBatchedDrawCalls)
+    {
+        if (EnumHasAnyFlags(batchedDrawCalls[index].DrawCall.Material->GetDrawModes(), DrawPass::TextureFeedback))
+            _drawCalls.PreBatchedDrawCalls.Add(index);
+    }
+}
+
+String TextureFeedbackPass::ToString() const
+{
+    return TEXT("TextureFeedbackPass");
+}
+
+void TextureFeedbackPass::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    SAFE_DELETE_GPU_RESOURCE(_feedbackBuffer);
+    SAFE_DELETE_GPU_RESOURCES(_readbackBuffers);
+    SAFE_DELETE_GPU_RESOURCE(_cb);
+    Platform::MemoryClear(_readbackFrames, sizeof(_readbackFrames));
+    _drawCalls.Clear();
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "RendererPass.h"
+#include "RenderList.h"
+#include "Engine/Graphics/Async/GPUSyncPoint.h"
+
+/// <summary>
+/// Texture streaming feedback pass. Periodically draws the scene geometry at low resolution to record the mip levels of the streamed textures sampled by the materials and reads them back (asynchronously) for the textures streaming.
+/// </summary>
+class TextureFeedbackPass : public RendererPass<TextureFeedbackPass>
+{
+private:
+
+    GPUBuffer* _feedbackBuffer = nullptr;
+    GPUBuffer* _readbackBuffers[GPU_ASYNC_LATENCY + 1] = {};
+    uint64 _readbackFrames[GPU_ASYNC_LATENCY + 1] = {};
+    double _readbackTimes[GPU_ASYNC_LATENCY + 1] = {};
+    GPUConstantBuffer* _cb = nullptr;
+    DrawCallsList _drawCalls;
+    uint64 _lastFrame = 0;
+    float _mipBias = 0.0f;
+
+public:
+
+    /// <summary>
+    /// Renders the texture feedback for the current view (if enabled in streaming settings and it's time to update it). Reads back the results of the previous passes.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="context">The GPU context.</param>
+    void Render(RenderContext& renderContext, GPUContext* context);
+
+    /// <summary>
+    /// Binds the texture feedback data for the material. Called by the material shaders during texture feedback pass.
+    /// </summary>
+    /// <param name="context">The GPU context.</param>
+    /// <param name="slots">The texture feedback data for each shader resource register (GPU_MAX_SR_BINDED items).</param>
+    void BindMaterial(GPUContext* context, const uint32* slots);
+
+private:
+
+    void CollectDrawCalls(RenderList* list, DrawCallsListType listType);
+
+public:
+
+    // [RendererPass]
+    String ToString() const override;
+    void Dispose() override;
+};
@@ -0,0 +1,191 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "ComputeSkinning.h"
+#include "../DrawCall.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Graphics/GPUBuffer.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPULimits.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Graphics/Models/SkinnedMesh.h"
+#include "Engine/Graphics/Models/SkinnedMeshDrawData.h"
+#include "Engine/Graphics/Shaders/GPUShader.h"
+
+#define THREADGROUP_SIZE 64
+#define INITIAL_CAPACITY (64 * 1024)
+
+PACK_STRUCT(struct Data {
+    uint32 VerticesCount;
+    Float3 Dummy0;
+    });
+
+static_assert(sizeof(VB0SkinnedElementType) == 36, "Invalid skinned vertex size. Has to match the shader.");
+static_assert(sizeof(VB0ElementType) == 12, "Invalid vertex size. Has to match the shader.");
+static_assert(sizeof(VB1ElementType) == 16, "Invalid vertex size. Has to match the shader.");
+
+namespace
+{
+    bool InitBuffer(GPUBuffer*& buffer, const Char* name, const GPUBufferDescription& desc)
+    {
+        if (buffer == nullptr)
+            buffer = GPUDevice::Instance->CreateBuffer(name);
+        return buffer->Init(desc);
+    }
+}
+
+String ComputeSkinning::ToString() const
+{
+    return TEXT("ComputeSkinning");
+}
+
+bool ComputeSkinning::Init()
+{
+    // Compute shaders support is required for this implementation
+    if (!GPUDevice::Instance->Limits.HasCompute)
+        return false;
+
+    // Load asset
+    _shader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/ComputeSkinning"));
+    if (_shader == nullptr)
+        return true;
+#if COMPILE_WITH_DEV_ENV
+    _shader.Get()->OnReloading.Bind<ComputeSkinning, &ComputeSkinning::OnShaderReloading>(this);
+#endif
+
+    return false;
+}
+
+bool ComputeSkinning::setupResources()
+{
+    // Skip if not supported (skinned meshes fallback to the vertex shader skinning)
+    if (!_shader)
+        return true;
+
+    // Check if shader has not been loaded
+    if (!_shader->IsLoaded())
+        return true;
+    const auto shader = _shader->GetShader();
+
+    // Validate shader constant buffer size
+    _cb = shader->GetCB(0);
+    if (_cb->GetSize() != sizeof(Data))
+    {
+        REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 0, Data);
+        return true;
+    }
+
+    // Cache compute shaders
+    _skinCS = shader->GetCS("CS_Skin");
+
+    return false;
+}
+
+void ComputeSkinning::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    SAFE_DELETE_GPU_RESOURCE(_inputBuffer);
+    SAFE_DELETE_GPU_RESOURCE(_outputBuffer);
+    SAFE_DELETE_GPU_RESOURCE(_positionsBuffer);
+    SAFE_DELETE_GPU_RESOURCE(_attributesBuffer);
+    _cache.Clear();
+    _capacity = 0;
+    _cb = nullptr;
+    _skinCS = nullptr;
+    _shader = nullptr;
+}
+
+bool ComputeSkinning::Skin(const SkinnedMesh* mesh, const SkinnedMeshDrawData* skinning, GPUBuffer* vertexBuffer, uint32 vertexBufferOffset, DrawCall& drawCall)
+{
+    ASSERT(mesh && skinning && vertexBuffer);
+    const uint32 verticesCount = mesh->GetVertexCount();
+    if (verticesCount == 0 || !skinning->IsReady())
+        return true;
+    ScopeLock lock(RenderContext::GPULocker);
+    if (checkIfSkipPass() || !_skinCS)
+        return true;
+
+    // Reset the shared vertex buffers every frame (grow them if the previous frame run out of the space)
+    if (_frame != Engine::FrameCount)
+    {
+        _frame = Engine::FrameCount;
+        _cache.Clear();
+        _usedVertices = 0;
+        if (_capacity < _requiredVertices || _capacity == 0)
+        {
+            const uint32 capacity = Math::AlignUp<uint32>(Math::Max<uint32>(_requiredVertices + _requiredVertices / 4, INITIAL_CAPACITY), 1024);
+            if (InitBuffer(_positionsBuffer, TEXT("ComputeSkinning.Positions"), GPUBufferDescription::Vertex(sizeof(VB0ElementType), capacity)) ||
+                InitBuffer(_attributesBuffer, TEXT("ComputeSkinning.Attributes"), GPUBufferDescription::Vertex(sizeof(VB1ElementType), capacity)))
+            {
+                LOG(Error, "Failed to create compute skinning buffers.");
+                _capacity = 0;
+                return true;
+            }
+            _capacity = capacity;
+        }
+        _requiredVertices = 0;
+    }
+
+    // Skin mesh only once per frame
+    const auto key = ToPair(skinning, mesh);
+    uint32 vertexOffset;
+    if (!_cache.TryGet(key, vertexOffset))
+    {
+        _requiredVertices += verticesCount;
+        if (_usedVertices + verticesCount > _capacity)
+            return true;
+        PROFILE_GPU_CPU("Compute Skinning");
+        auto context = GPUDevice::Instance->GetMainContext();
+
+        // Resize buffers (with a slack to reduce reallocations)
+        const uint32 inputSize = verticesCount * sizeof(VB0SkinnedElementType);
+        if (!_inputBuffer || _inputBuffer->GetSize() < inputSize)
+        {
+            const uint32 capacity = Math::AlignUp<uint32>(verticesCount + verticesCount / 4, 1024);
+            if (InitBuffer(_inputBuffer, TEXT("ComputeSkinning.Input"), GPUBufferDescription::Raw(capacity * sizeof(VB0SkinnedElementType), GPUBufferFlags::ShaderResource)) ||
+                InitBuffer(_outputBuffer, TEXT("ComputeSkinning.Output"), GPUBufferDescription::Raw(capacity * (sizeof(VB0ElementType) + sizeof(VB1ElementType)), GPUBufferFlags::UnorderedAccess)))
+            {
+                LOG(Error, "Failed to create compute skinning buffers.");
+                return true;
+            }
+        }
+
+        // Raw views use 4-byte elements so mesh vertices are copied into the separate buffer to be read by the compute shader
+        context->CopyBuffer(_inputBuffer, vertexBuffer, inputSize, 0, vertexBufferOffset);
+
+        // Setup constants buffer
+        Data data;
+        data.VerticesCount = verticesCount;
+        data.Dummy0 = Float3::Zero;
+        context->UpdateCB(_cb, &data);
+        context->BindCB(0, _cb);
+
+        // Skin vertices
+        context->BindSR(0, skinning->BoneMatrices->View());
+        context->BindSR(1, _inputBuffer->View());
+        context->BindUA(0, _outputBuffer->View());
+        context->Dispatch(_skinCS, (verticesCount + THREADGROUP_SIZE - 1) / THREADGROUP_SIZE, 1, 1);
+        context->ResetUA();
+        context->ResetSR();
+
+        // Copy skinned vertices into the shared vertex buffers (output contains positions followed by the other attributes)
+        vertexOffset = _usedVertices;
+        _usedVertices += verticesCount;
+        context->CopyBuffer(_positionsBuffer, _outputBuffer, verticesCount * sizeof(VB0ElementType), vertexOffset * sizeof(VB0ElementType), 0);
+        context->CopyBuffer(_attributesBuffer, _outputBuffer, verticesCount * sizeof(VB1ElementType), vertexOffset * sizeof(VB1ElementType), verticesCount * sizeof(VB0ElementType));
+        _cache.Add(key, vertexOffset);
+    }
+
+    // Draw skinned vertices as a static mesh
+    drawCall.Geometry.VertexBuffers[0] = _positionsBuffer;
+    drawCall.Geometry.VertexBuffers[1] = _attributesBuffer;
+    drawCall.Geometry.VertexBuffers[2] = nullptr;
+    drawCall.Geometry.VertexBuffersOffsets[0] = vertexOffset * sizeof(VB0ElementType);
+    drawCall.Geometry.VertexBuffersOffsets[1] = vertexOffset * sizeof(VB1ElementType);
+    drawCall.Geometry.VertexBuffersOffsets[2] = 0;
+    return false;
+}
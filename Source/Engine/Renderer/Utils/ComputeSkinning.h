@@ -0,0 +1,60 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "../RendererPass.h"
+#include "Engine/Core/Types/Pair.h"
+#include "Engine/Core/Collections/Dictionary.h"
+
+struct DrawCall;
+class SkinnedMesh;
+class SkinnedMeshDrawData;
+
+/// <summary>
+/// Skinned meshes skinning implementation using compute shaders. Skins the mesh vertices once per frame into the shared vertex buffers so all the rendering passes (GBuffer, shadow projections, etc.) draw the skinned mesh as a static geometry instead of redoing the skinning in the vertex shader of every pass.
+/// </summary>
+class ComputeSkinning : public RendererPass<ComputeSkinning>
+{
+private:
+    AssetReference<Shader> _shader;
+    GPUConstantBuffer* _cb = nullptr;
+    GPUShaderProgramCS* _skinCS = nullptr;
+    GPUBuffer* _inputBuffer = nullptr;
+    GPUBuffer* _outputBuffer = nullptr;
+    GPUBuffer* _positionsBuffer = nullptr;
+    GPUBuffer* _attributesBuffer = nullptr;
+    uint64 _frame = 0;
+    uint32 _capacity = 0;
+    uint32 _usedVertices = 0;
+    uint32 _requiredVertices = 0;
+    Dictionary<Pair<const SkinnedMeshDrawData*, const SkinnedMesh*>, uint32> _cache;
+
+public:
+    /// <summary>
+    /// Skins the mesh vertices (once per frame for every skinning data and mesh pair) and setups the draw call geometry to use the skinned vertices (as a static mesh).
+    /// </summary>
+    /// <param name="mesh">The skinned mesh.</param>
+    /// <param name="skinning">The skinning data with the bone matrices (already flushed to the GPU).</param>
+    /// <param name="vertexBuffer">The mesh vertex buffer to skin (eg. deformed by the blend shapes).</param>
+    /// <param name="vertexBufferOffset">The mesh vertices location within the vertex buffer (in bytes).</param>
+    /// <param name="drawCall">The draw call to setup the vertex buffers for.</param>
+    /// <returns>True if failed (eg. shader is not ready or the shared vertex buffers are full), otherwise false.</returns>
+    bool Skin(const SkinnedMesh* mesh, const SkinnedMeshDrawData* skinning, GPUBuffer* vertexBuffer, uint32 vertexBufferOffset, DrawCall& drawCall);
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    bool Init() override;
+    void Dispose() override;
+#if COMPILE_WITH_DEV_ENV
+    void OnShaderReloading(Asset* obj)
+    {
+        _skinCS = nullptr;
+        invalidateResources();
+    }
+#endif
+
+protected:
+    // [RendererPass]
+    bool setupResources() override;
+};
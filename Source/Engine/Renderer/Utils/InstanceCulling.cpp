@@ -0,0 +1,359 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "InstanceCulling.h"
+#include "../OcclusionCullingPass.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Core/Math/BoundingFrustum.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Graphics/GPUBuffer.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPULimits.h"
+#include "Engine/Graphics/Shaders/GPUShader.h"
+
+#define THREADGROUP_SIZE 64
+
+PACK_STRUCT(struct Data {
+    Float4 FrustumPlanes[6];
+    uint32 InstancesCount;
+    Float3 Dummy0;
+    });
+
+PACK_STRUCT(struct PersistentData {
+    Matrix HZBViewProjectionMatrix;
+    Float3 InstancesOffset;
+    uint32 DrawsCount;
+    Float3 CullViewPosition;
+    float LODDistanceFactor;
+    Float3 LODViewPosition;
+    float ScreenMultiple;
+    Float3 HZBOffset;
+    float ProjectionW;
+    Float3 HZBViewPosition;
+    uint32 HZBMips;
+    Float2 HZBSize;
+    Int2 HZBResolution;
+    float LODScreenSizesSq[8];
+    float MinScreenSizeSq;
+    uint32 LODsCount;
+    int32 LODBias;
+    int32 MinLOD;
+    uint32 UseHZB;
+    Float3 Dummy1;
+    });
+
+static_assert(sizeof(InstanceData) == 64, "Invalid instance data size. Has to match the shader.");
+static_assert(sizeof(InstanceCullingData) == 20, "Invalid instance culling data size. Has to match the shader.");
+static_assert(sizeof(GPUDrawIndexedIndirectArgs) == 20, "Invalid draw indirect arguments size. Has to match the shader.");
+static_assert(sizeof(InstanceCullingBounds) == 20, "Invalid instance culling bounds size. Has to match the shader.");
+static_assert(MODEL_MAX_LODS <= 6, "Invalid max LODs count. Has to match the shader.");
+
+namespace
+{
+    bool InitBuffer(GPUBuffer*& buffer, const Char* name, const GPUBufferDescription& desc)
+    {
+        if (buffer == nullptr)
+            buffer = GPUDevice::Instance->CreateBuffer(name);
+        return buffer->Init(desc);
+    }
+}
+
+InstanceCullingBuffers::~InstanceCullingBuffers()
+{
+    SAFE_DELETE_GPU_RESOURCE(InstancesBuffer);
+    SAFE_DELETE_GPU_RESOURCE(BoundsBuffer);
+}
+
+String InstanceCulling::ToString() const
+{
+    return TEXT("InstanceCulling");
+}
+
+bool InstanceCulling::Init()
+{
+    // Draw indirect and compute shaders support is required for this implementation
+    const auto& limits = GPUDevice::Instance->Limits;
+    if (!limits.HasDrawIndirect || !limits.HasCompute)
+        return false;
+
+    // Load asset
+    _shader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/InstanceCulling"));
+    if (_shader == nullptr)
+        return true;
+#if COMPILE_WITH_DEV_ENV
+    _shader.Get()->OnReloading.Bind<InstanceCulling, &InstanceCulling::OnShaderReloading>(this);
+#endif
+
+    return false;
+}
+
+bool InstanceCulling::setupResources()
+{
+    // Skip if not supported (culling will fail and draws fallback to the CPU instance buffer)
+    if (!_shader)
+        return false;
+
+    // Check if shader has not been loaded
+    if (!_shader->IsLoaded())
+        return true;
+    const auto shader = _shader->GetShader();
+
+    // Validate shader constant buffer size
+    _cb = shader->GetCB(0);
+    if (_cb->GetSize() != sizeof(Data))
+    {
+        REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 0, Data);
+        return true;
+    }
+
+    _cbPersistent = shader->GetCB(1);
+    if (_cbPersistent->GetSize() != sizeof(PersistentData))
+    {
+        REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 1, PersistentData);
+        return true;
+    }
+
+    // Cache compute shaders
+    _cullInstancesCS = shader->GetCS("CS_CullInstances");
+    _cullPersistentCS = shader->GetCS("CS_CullPersistent");
+    _setupDrawArgsCS = shader->GetCS("CS_SetupDrawArgs");
+
+    return false;
+}
+
+void InstanceCulling::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    SAFE_DELETE_GPU_RESOURCE(_instancesBuffer);
+    SAFE_DELETE_GPU_RESOURCE(_boundsBuffer);
+    SAFE_DELETE_GPU_RESOURCE(_culledInstancesBuffer);
+    SAFE_DELETE_GPU_RESOURCE(_vertexBuffer);
+    SAFE_DELETE_GPU_RESOURCE(_drawArgsBuffer);
+    for (JobResources& e : _jobResources)
+    {
+        SAFE_DELETE_GPU_RESOURCE(e.CulledInstances);
+        SAFE_DELETE_GPU_RESOURCE(e.VertexBuffer);
+        SAFE_DELETE_GPU_RESOURCE(e.DrawArgs);
+        SAFE_DELETE_GPU_RESOURCE(e.Counters);
+    }
+    _jobResources.Clear();
+    _cb = nullptr;
+    _cbPersistent = nullptr;
+    _cullInstancesCS = nullptr;
+    _cullPersistentCS = nullptr;
+    _setupDrawArgsCS = nullptr;
+    _shader = nullptr;
+}
+
+bool InstanceCulling::Cull(GPUContext* context, const BoundingFrustum& frustum, const InstanceData* instances, const InstanceCullingData* bounds, int32 instancesCount, const GPUDrawIndexedIndirectArgs* drawArgs, int32 drawsCount)
+{
+    ASSERT(context && instances && bounds && drawArgs);
+    if (checkIfSkipPass() || !_cullInstancesCS || instancesCount == 0)
+        return true;
+    PROFILE_GPU_CPU("Instance Culling");
+
+    // Resize buffers (with a slack to reduce reallocations)
+    const uint32 instancesSize = instancesCount * sizeof(InstanceData);
+    const uint32 drawArgsSize = drawsCount * sizeof(GPUDrawIndexedIndirectArgs);
+    if (!_instancesBuffer || _instancesBuffer->GetSize() < instancesSize)
+    {
+        const int32 capacity = Math::AlignUp<int32>(instancesCount + instancesCount / 4, 1024);
+        if (InitBuffer(_instancesBuffer, TEXT("InstanceCulling.Instances"), GPUBufferDescription::Raw(capacity * sizeof(InstanceData), GPUBufferFlags::ShaderResource)) ||
+            InitBuffer(_boundsBuffer, TEXT("InstanceCulling.Bounds"), GPUBufferDescription::Structured(capacity, sizeof(InstanceCullingData))) ||
+            InitBuffer(_culledInstancesBuffer, TEXT("InstanceCulling.CulledInstances"), GPUBufferDescription::Raw(capacity * sizeof(InstanceData), GPUBufferFlags::UnorderedAccess)) ||
+            InitBuffer(_vertexBuffer, TEXT("InstanceCulling.VertexBuffer"), GPUBufferDescription::Vertex(sizeof(InstanceData), capacity)))
+        {
+            LOG(Error, "Failed to create instance culling buffers.");
+            return true;
+        }
+    }
+    if (!_drawArgsBuffer || _drawArgsBuffer->GetSize() < drawArgsSize)
+    {
+        const int32 capacity = Math::AlignUp<int32>(drawsCount + drawsCount / 4, 256);
+        if (InitBuffer(_drawArgsBuffer, TEXT("InstanceCulling.DrawArgs"), GPUBufferDescription::Raw(capacity * sizeof(GPUDrawIndexedIndirectArgs), GPUBufferFlags::Argument | GPUBufferFlags::UnorderedAccess)))
+        {
+            LOG(Error, "Failed to create instance culling buffers.");
+            return true;
+        }
+    }
+
+    // Upload data
+    context->UpdateBuffer(_instancesBuffer, instances, instancesSize);
+    context->UpdateBuffer(_boundsBuffer, bounds, instancesCount * sizeof(InstanceCullingData));
+    context->UpdateBuffer(_drawArgsBuffer, drawArgs, drawArgsSize);
+
+    // Setup constants buffer
+    Data data;
+    for (int32 i = 0; i < 6; i++)
+    {
+        const Plane plane = frustum.GetPlane(i);
+        data.FrustumPlanes[i] = Float4((float)plane.Normal.X, (float)plane.Normal.Y, (float)plane.Normal.Z, (float)plane.D);
+    }
+    data.InstancesCount = instancesCount;
+    data.Dummy0 = Float3::Zero;
+    context->UpdateCB(_cb, &data);
+    context->BindCB(0, _cb);
+
+    // Cull and compact instances
+    context->BindSR(0, _boundsBuffer->View());
+    context->BindSR(1, _instancesBuffer->View());
+    context->BindUA(0, _culledInstancesBuffer->View());
+    context->BindUA(1, _drawArgsBuffer->View());
+    context->Dispatch(_cullInstancesCS, (instancesCount + THREADGROUP_SIZE - 1) / THREADGROUP_SIZE, 1, 1);
+    context->ResetUA();
+    context->ResetSR();
+
+    // Raw views use 4-byte elements so culled instances are copied into the separate buffer to be bound as a vertex buffer with the instance data stride
+    context->CopyBuffer(_vertexBuffer, _culledInstancesBuffer, instancesSize);
+
+    return false;
+}
+
+bool InstanceCulling::Execute(GPUContext* context, const RenderContext& renderContext, InstanceCullingJob& job)
+{
+    ASSERT(context && job.Buffers);
+    InstanceCullingBuffers& buffers = *job.Buffers;
+    const int32 instancesCount = buffers.Instances.Count();
+    const int32 drawsCount = buffers.DrawArgs.Count();
+    if (checkIfSkipPass() || !_cullPersistentCS || instancesCount == 0 || drawsCount == 0 || job.LODsCount <= 0)
+        return true;
+    PROFILE_GPU_CPU("Instance Culling");
+
+    // Upload the persistent instances only when modified
+    if (buffers.IsDirty || !buffers.InstancesBuffer)
+    {
+        const uint32 instancesSize = instancesCount * sizeof(InstanceData);
+        if (!buffers.InstancesBuffer || buffers.InstancesBuffer->GetSize() < instancesSize)
+        {
+            const int32 capacity = Math::AlignUp<int32>(instancesCount + instancesCount / 4, 1024);
+            if (InitBuffer(buffers.InstancesBuffer, TEXT("InstanceCulling.PersistentInstances"), GPUBufferDescription::Raw(capacity * sizeof(InstanceData), GPUBufferFlags::ShaderResource)) ||
+                InitBuffer(buffers.BoundsBuffer, TEXT("InstanceCulling.PersistentBounds"), GPUBufferDescription::Structured(capacity, sizeof(InstanceCullingBounds))))
+            {
+                LOG(Error, "Failed to create instance culling buffers.");
+                return true;
+            }
+        }
+        context->UpdateBuffer(buffers.InstancesBuffer, buffers.Instances.Get(), instancesSize);
+        context->UpdateBuffer(buffers.BoundsBuffer, buffers.Bounds.Get(), instancesCount * sizeof(InstanceCullingBounds));
+        buffers.IsDirty = false;
+    }
+
+    // Pick the resources not used by the other jobs in this frame (results have to stay valid for all passes of the view)
+    const uint64 frame = Engine::FrameCount;
+    JobResources* resources = nullptr;
+    for (JobResources& e : _jobResources)
+    {
+        if (e.LastFrameUsed != frame)
+        {
+            resources = &e;
+            break;
+        }
+    }
+    if (!resources)
+        resources = &_jobResources.AddOne();
+    resources->LastFrameUsed = frame;
+    const int32 culledCount = instancesCount * job.LODsCount;
+    const uint32 culledSize = culledCount * sizeof(InstanceData);
+    const uint32 drawArgsSize = drawsCount * sizeof(GPUDrawIndexedIndirectArgs);
+    if (!resources->CulledInstances || resources->CulledInstances->GetSize() < culledSize)
+    {
+        const int32 capacity = Math::AlignUp<int32>(culledCount + culledCount / 4, 1024);
+        if (InitBuffer(resources->CulledInstances, TEXT("InstanceCulling.PersistentCulledInstances"), GPUBufferDescription::Raw(capacity * sizeof(InstanceData), GPUBufferFlags::UnorderedAccess)) ||
+            InitBuffer(resources->VertexBuffer, TEXT("InstanceCulling.PersistentVertexBuffer"), GPUBufferDescription::Vertex(sizeof(InstanceData), capacity)) ||
+            (!resources->Counters && InitBuffer(resources->Counters, TEXT("InstanceCulling.PersistentCounters"), GPUBufferDescription::Typed(MODEL_MAX_LODS, PixelFormat::R32_UInt, true))))
+        {
+            LOG(Error, "Failed to create instance culling buffers.");
+            return true;
+        }
+    }
+    if (!resources->DrawArgs || resources->DrawArgs->GetSize() < drawArgsSize)
+    {
+        const int32 capacity = Math::AlignUp<int32>(drawsCount + drawsCount / 4, 64);
+        if (InitBuffer(resources->DrawArgs, TEXT("InstanceCulling.PersistentDrawArgs"), GPUBufferDescription::Raw(capacity * sizeof(GPUDrawIndexedIndirectArgs), GPUBufferFlags::Argument | GPUBufferFlags::UnorderedAccess)))
+        {
+            LOG(Error, "Failed to create instance culling buffers.");
+            return true;
+        }
+    }
+    const uint32 counters[MODEL_MAX_LODS] = {};
+    context->UpdateBuffer(resources->Counters, counters, sizeof(counters));
+    context->UpdateBuffer(resources->DrawArgs, buffers.DrawArgs.Get(), drawArgsSize);
+
+    // Setup constants buffers
+    const RenderView& view = renderContext.View;
+    const RenderView& lodView = renderContext.LodProxyView ? *renderContext.LodProxyView : view;
+    Data data;
+    for (int32 i = 0; i < 6; i++)
+    {
+        const Plane plane = view.CullingFrustum.GetPlane(i);
+        data.FrustumPlanes[i] = Float4((float)plane.Normal.X, (float)plane.Normal.Y, (float)plane.Normal.Z, (float)plane.D);
+    }
+    data.InstancesCount = instancesCount;
+    data.Dummy0 = Float3::Zero;
+    PersistentData persistentData;
+    persistentData.InstancesOffset = buffers.Origin - view.Origin;
+    persistentData.DrawsCount = drawsCount;
+    persistentData.CullViewPosition = view.Position;
+    persistentData.LODDistanceFactor = view.ModelLODDistanceFactorSqrt;
+    persistentData.LODViewPosition = lodView.Position;
+    persistentData.ScreenMultiple = 0.5f * Math::Max(lodView.Projection.Values[0][0], lodView.Projection.Values[1][1]);
+    persistentData.ProjectionW = lodView.Projection.Values[2][3];
+    for (int32 i = 0; i < ARRAY_COUNT(persistentData.LODScreenSizesSq); i++)
+        persistentData.LODScreenSizesSq[i] = i < job.LODsCount ? job.LODScreenSizesSq[i] : 0.0f;
+    persistentData.MinScreenSizeSq = job.MinScreenSizeSq;
+    persistentData.LODsCount = job.LODsCount;
+    persistentData.LODBias = job.LODBias;
+    persistentData.MinLOD = Math::Min(job.MinLOD, job.LODsCount - 1);
+    persistentData.Dummy1 = Float3::Zero;
+    const OcclusionCullingData::HZB* hzb = renderContext.List->Occlusion ? renderContext.List->Occlusion->GetHZB(view) : nullptr;
+    persistentData.UseHZB = hzb ? 1 : 0;
+    if (hzb)
+    {
+        persistentData.HZBViewProjectionMatrix = hzb->ViewProjection;
+        persistentData.HZBOffset = view.Origin - hzb->Origin;
+        persistentData.HZBViewPosition = hzb->ViewPosition;
+        persistentData.HZBMips = hzb->Texture->MipLevels();
+        persistentData.HZBSize = hzb->Size;
+        persistentData.HZBResolution = Int2(hzb->Texture->Width(), hzb->Texture->Height());
+    }
+    else
+    {
+        persistentData.HZBViewProjectionMatrix = Matrix::Identity;
+        persistentData.HZBOffset = Float3::Zero;
+        persistentData.HZBViewPosition = Float3::Zero;
+        persistentData.HZBMips = 0;
+        persistentData.HZBSize = Float2::Zero;
+        persistentData.HZBResolution = Int2::Zero;
+    }
+    context->UpdateCB(_cb, &data);
+    context->BindCB(0, _cb);
+    context->UpdateCB(_cbPersistent, &persistentData);
+    context->BindCB(1, _cbPersistent);
+
+    // Cull and compact instances per LOD
+    context->BindSR(0, buffers.BoundsBuffer->View());
+    context->BindSR(1, buffers.InstancesBuffer->View());
+    if (hzb)
+        context->BindSR(2, hzb->Texture);
+    context->BindUA(0, resources->CulledInstances->View());
+    context->BindUA(1, resources->Counters->View());
+    context->Dispatch(_cullPersistentCS, (instancesCount + THREADGROUP_SIZE - 1) / THREADGROUP_SIZE, 1, 1);
+    context->ResetUA();
+    context->ResetSR();
+
+    // Write the visible instances counts into the draw indirect arguments
+    context->BindUA(0, resources->DrawArgs->View());
+    context->BindUA(1, resources->Counters->View());
+    context->Dispatch(_setupDrawArgsCS, (drawsCount + THREADGROUP_SIZE - 1) / THREADGROUP_SIZE, 1, 1);
+    context->ResetUA();
+
+    // Raw views use 4-byte elements so culled instances are copied into the separate buffer to be bound as a vertex buffer with the instance data stride
+    context->CopyBuffer(resources->VertexBuffer, resources->CulledInstances, culledSize);
+
+    job.CulledInstances = resources->VertexBuffer;
+    job.DrawArgs = resources->DrawArgs;
+    return false;
+}
@@ -0,0 +1,134 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "../RendererPass.h"
+#include "../RenderList.h"
+
+class BoundingFrustum;
+
+/// <summary>
+/// The persistent instances data for the GPU-driven instances culling. Kept by the object (eg. foliage type), uploaded to the GPU only when modified and culled on a GPU for every view (see InstanceCullingJob).
+/// </summary>
+class FLAXENGINE_API InstanceCullingBuffers
+{
+public:
+    /// <summary>
+    /// The instances data (relative to the Origin). Level of detail dithering factor is not used.
+    /// </summary>
+    Array<InstanceData> Instances;
+
+    /// <summary>
+    /// The instances bounds (relative to the Origin) with the per-instance cull distance.
+    /// </summary>
+    Array<InstanceCullingBounds> Bounds;
+
+    /// <summary>
+    /// The draw indirect arguments for every drawn geometry of every LOD. Start instance has to be set to the LOD index multiplied by the instances count (instance count is set by the culling).
+    /// </summary>
+    Array<GPUDrawIndexedIndirectArgs> DrawArgs;
+
+    /// <summary>
+    /// The world-space origin of the instances data.
+    /// </summary>
+    Vector3 Origin = Vector3::Zero;
+
+    /// <summary>
+    /// True if the data has been modified and needs to be uploaded to the GPU.
+    /// </summary>
+    bool IsDirty = true;
+
+    GPUBuffer* InstancesBuffer = nullptr;
+    GPUBuffer* BoundsBuffer = nullptr;
+
+public:
+    ~InstanceCullingBuffers();
+};
+
+/// <summary>
+/// GPU instances culling implementation using compute shaders. Culls the instances of the instanced draws against the view frustum and compacts the visible ones into the instance buffer used with indirect draws (instance counts of the draws never go back to the CPU).
+/// </summary>
+class InstanceCulling : public RendererPass<InstanceCulling>
+{
+private:
+    AssetReference<Shader> _shader;
+    GPUConstantBuffer* _cb = nullptr;
+    GPUShaderProgramCS* _cullInstancesCS = nullptr;
+    GPUConstantBuffer* _cbPersistent = nullptr;
+    GPUShaderProgramCS* _cullPersistentCS = nullptr;
+    GPUShaderProgramCS* _setupDrawArgsCS = nullptr;
+    GPUBuffer* _instancesBuffer = nullptr;
+    GPUBuffer* _boundsBuffer = nullptr;
+    GPUBuffer* _culledInstancesBuffer = nullptr;
+    GPUBuffer* _vertexBuffer = nullptr;
+    GPUBuffer* _drawArgsBuffer = nullptr;
+
+    struct JobResources
+    {
+        GPUBuffer* CulledInstances = nullptr;
+        GPUBuffer* VertexBuffer = nullptr;
+        GPUBuffer* DrawArgs = nullptr;
+        GPUBuffer* Counters = nullptr;
+        uint64 LastFrameUsed = 0;
+    };
+
+    Array<JobResources> _jobResources;
+
+public:
+    /// <summary>
+    /// Gets the vertex buffer with the culled instances (valid after culling). Instances of each draw are placed at the start instance of its indirect arguments.
+    /// </summary>
+    FORCE_INLINE GPUBuffer* GetInstancesBuffer() const
+    {
+        return _vertexBuffer;
+    }
+
+    /// <summary>
+    /// Gets the buffer with the draw indirect arguments of the draws (valid after culling). Used as an array of GPUDrawIndexedIndirectArgs.
+    /// </summary>
+    FORCE_INLINE GPUBuffer* GetDrawArgsBuffer() const
+    {
+        return _drawArgsBuffer;
+    }
+
+    /// <summary>
+    /// Culls the instances on a GPU.
+    /// </summary>
+    /// <param name="context">The GPU context.</param>
+    /// <param name="frustum">The culling frustum.</param>
+    /// <param name="instances">The instances data.</param>
+    /// <param name="bounds">The instances bounds (with the index of the draw that contains the instance).</param>
+    /// <param name="instancesCount">The amount of instances.</param>
+    /// <param name="drawArgs">The draw indirect arguments of the draws. Instance count has to be zero as it's used as a counter of visible instances.</param>
+    /// <param name="drawsCount">The amount of draws.</param>
+    /// <returns>True if failed (eg. shader is not ready), otherwise false.</returns>
+    bool Cull(GPUContext* context, const BoundingFrustum& frustum, const InstanceData* instances, const InstanceCullingData* bounds, int32 instancesCount, const GPUDrawIndexedIndirectArgs* drawArgs, int32 drawsCount);
+
+    /// <summary>
+    /// Executes the GPU-driven instances culling job for the view. Uploads the persistent instances if modified, culls them against the view frustum, cull distance and the Hierarchical-Z buffer of the previous frame (if available), selects their LODs and compacts the visible ones per LOD.
+    /// </summary>
+    /// <param name="context">The GPU context.</param>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="job">The job to execute. Its culled instances and draw arguments buffers are set on success.</param>
+    /// <returns>True if failed (eg. shader is not ready), otherwise false.</returns>
+    bool Execute(GPUContext* context, const RenderContext& renderContext, InstanceCullingJob& job);
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    bool Init() override;
+    void Dispose() override;
+#if COMPILE_WITH_DEV_ENV
+    void OnShaderReloading(Asset* obj)
+    {
+        _cullInstancesCS = nullptr;
+        _cullPersistentCS = nullptr;
+        _setupDrawArgsCS = nullptr;
+        invalidateResources();
+    }
+#endif
+
+protected:
+    // [RendererPass]
+    bool setupResources() override;
+};
@@ -0,0 +1,182 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "RadixSort.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Graphics/GPUBuffer.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPULimits.h"
+#include "Engine/Graphics/Shaders/GPUShader.h"
+
+// The amount of items processed by a single thread group. Matches the shader define.
+#define RADIX_SORT_BLOCK_SIZE 256
+
+// The amount of key bits sorted in a single pass. Matches the shader define.
+#define RADIX_SORT_BITS 4
+
+// The sorting keys buffer item structure template. Matches the shader type.
+struct Item
+{
+    float Key;
+    uint32 Value;
+};
+
+PACK_STRUCT(struct Data {
+    uint32 CounterOffset;
+    uint32 MaxCount;
+    uint32 BitShift;
+    uint32 Descending;
+    });
+
+String RadixSort::ToString() const
+{
+    return TEXT("RadixSort");
+}
+
+bool RadixSort::Init()
+{
+    // Draw indirect and compute shaders support is required for this implementation
+    const auto& limits = GPUDevice::Instance->Limits;
+    if (!limits.HasDrawIndirect || !limits.HasCompute)
+        return false;
+
+    // Create buffers (temporary buffers are resized on the first use)
+    _dispatchArgsBuffer = GPUDevice::Instance->CreateBuffer(TEXT("RadixSortDispatchArgs"));
+    if (_dispatchArgsBuffer->Init(GPUBufferDescription::Raw(sizeof(GPUDispatchIndirectArgs), GPUBufferFlags::Argument | GPUBufferFlags::UnorderedAccess)))
+        return true;
+    _tempKeysBuffer = GPUDevice::Instance->CreateBuffer(TEXT("RadixSortTempKeys"));
+    _histogramsBuffer = GPUDevice::Instance->CreateBuffer(TEXT("RadixSortHistograms"));
+
+    // Load asset
+    _shader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/RadixSort"));
+    if (_shader == nullptr)
+        return true;
+#if COMPILE_WITH_DEV_ENV
+    _shader.Get()->OnReloading.Bind<RadixSort, &RadixSort::OnShaderReloading>(this);
+#endif
+
+    return false;
+}
+
+bool RadixSort::setupResources()
+{
+    // Check if shader has not been loaded
+    if (!_shader->IsLoaded())
+        return true;
+    const auto shader = _shader->GetShader();
+
+    // Validate shader constant buffer size
+    _cb = shader->GetCB(0);
+    if (_cb->GetSize() != sizeof(Data))
+    {
+        REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 0, Data);
+        return true;
+    }
+
+    // Cache compute shaders
+    _indirectArgsCS = shader->GetCS("CS_IndirectArgs");
+    _countCS = shader->GetCS("CS_Count");
+    _scanCS = shader->GetCS("CS_Scan");
+    _scatterCS = shader->GetCS("CS_Scatter");
+    _copyIndicesCS = shader->GetCS("CS_CopyIndices");
+
+    return false;
+}
+
+void RadixSort::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    SAFE_DELETE_GPU_RESOURCE(_dispatchArgsBuffer);
+    SAFE_DELETE_GPU_RESOURCE(_tempKeysBuffer);
+    SAFE_DELETE_GPU_RESOURCE(_histogramsBuffer);
+    _cb = nullptr;
+    _indirectArgsCS = nullptr;
+    _countCS = nullptr;
+    _scanCS = nullptr;
+    _scatterCS = nullptr;
+    _copyIndicesCS = nullptr;
+    _shader = nullptr;
+}
+
+void RadixSort::Sort(GPUContext* context, GPUBuffer* sortingKeysBuffer, GPUBuffer* countBuffer, uint32 counterOffset, bool sortAscending, GPUBuffer* sortedIndicesBuffer)
+{
+    ASSERT(context && sortingKeysBuffer && countBuffer);
+
+    PROFILE_GPU_CPU("Radix Sort");
+
+    // Check if has missing resources
+    if (checkIfSkipPass())
+    {
+        return;
+    }
+
+    // Prepare temporary buffers
+    const uint32 maxNumElements = sortingKeysBuffer->GetSize() / sizeof(Item);
+    const uint32 maxNumBlocks = Math::DivideAndRoundUp<uint32>(maxNumElements, RADIX_SORT_BLOCK_SIZE);
+    if (_tempKeysBuffer->GetSize() < maxNumElements * sizeof(Item))
+    {
+        if (_tempKeysBuffer->Init(GPUBufferDescription::Structured(maxNumElements, sizeof(Item), true)))
+            return;
+    }
+    if (_histogramsBuffer->GetSize() < maxNumBlocks * (1 << RADIX_SORT_BITS) * sizeof(uint32))
+    {
+        if (_histogramsBuffer->Init(GPUBufferDescription::Structured(maxNumBlocks * (1 << RADIX_SORT_BITS), sizeof(uint32), true)))
+            return;
+    }
+
+    // Setup constants buffer
+    Data data;
+    data.CounterOffset = counterOffset;
+    data.MaxCount = maxNumElements;
+    data.BitShift = 0;
+    data.Descending = sortAscending ? 0 : 1;
+    context->UpdateCB(_cb, &data);
+    context->BindCB(0, _cb);
+
+    // Generate execute indirect arguments
+    context->BindSR(0, countBuffer->View());
+    context->BindUA(0, _dispatchArgsBuffer->View());
+    context->Dispatch(_indirectArgsCS, 1, 1, 1);
+    context->ResetUA();
+
+    // Sort keys in passes (even amount of passes so the sorted result ends up in the input buffer)
+    GPUBuffer* src = sortingKeysBuffer;
+    GPUBuffer* dst = _tempKeysBuffer;
+    for (uint32 shift = 0; shift < 32; shift += RADIX_SORT_BITS)
+    {
+        data.BitShift = shift;
+        context->UpdateCB(_cb, &data);
+        context->BindCB(0, _cb);
+
+        // Count digits in each block and convert counts into the global offsets
+        context->BindSR(1, src->View());
+        context->BindUA(0, _histogramsBuffer->View());
+        context->DispatchIndirect(_countCS, _dispatchArgsBuffer, 0);
+        context->Dispatch(_scanCS, 1, 1, 1);
+        context->ResetUA();
+
+        // Scatter items into the sorted locations
+        context->BindSR(2, _histogramsBuffer->View());
+        context->BindUA(0, dst->View());
+        context->DispatchIndirect(_scatterCS, _dispatchArgsBuffer, 0);
+        context->ResetUA();
+        context->ResetSR();
+        context->BindSR(0, countBuffer->View());
+
+        Swap(src, dst);
+    }
+
+    if (sortedIndicesBuffer)
+    {
+        // Copy indices to another buffer
+        context->BindSR(1, sortingKeysBuffer->View());
+        context->BindUA(0, sortedIndicesBuffer->View());
+        context->DispatchIndirect(_copyIndicesCS, _dispatchArgsBuffer, 0);
+    }
+
+    context->ResetUA();
+    context->ResetSR();
+}
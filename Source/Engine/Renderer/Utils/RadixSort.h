@@ -0,0 +1,57 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "../RendererPass.h"
+
+/// <summary>
+/// Radix Sort implementation using GPU compute shaders.
+/// Sorts the keys in multiple passes (4 bits per pass) using per-block histograms, global prefix sum and stable scatter. It has a linear complexity which makes it faster than Bitonic Sort for large lists.
+/// All passes are dispatched indirectly based on the items counter stored in the GPU buffer, so the cost scales with the actual amount of items instead of the buffer capacity.
+/// </summary>
+class RadixSort : public RendererPass<RadixSort>
+{
+private:
+    AssetReference<Shader> _shader;
+    GPUBuffer* _dispatchArgsBuffer = nullptr;
+    GPUBuffer* _tempKeysBuffer = nullptr;
+    GPUBuffer* _histogramsBuffer = nullptr;
+    GPUConstantBuffer* _cb;
+    GPUShaderProgramCS* _indirectArgsCS;
+    GPUShaderProgramCS* _countCS;
+    GPUShaderProgramCS* _scanCS;
+    GPUShaderProgramCS* _scatterCS;
+    GPUShaderProgramCS* _copyIndicesCS;
+
+public:
+    /// <summary>
+    /// Sorts the specified buffer of index-key pairs.
+    /// </summary>
+    /// <param name="context">The GPU context.</param>
+    /// <param name="sortingKeysBuffer">The sorting keys buffer. Used as a structured buffer of type Item (float key and uint value).</param>
+    /// <param name="countBuffer">The buffer that contains a items counter value.</param>
+    /// <param name="counterOffset">The offset into counter buffer to find count for this list. Must be a multiple of 4 bytes.</param>
+    /// <param name="sortAscending">True to sort in ascending order (smallest to largest), otherwise false to sort in descending order.</param>
+    /// <param name="sortedIndicesBuffer">The output buffer for sorted values extracted from the sorted sortingKeysBuffer after algorithm run. Valid for uint value types - used as RWBuffer.</param>
+    void Sort(GPUContext* context, GPUBuffer* sortingKeysBuffer, GPUBuffer* countBuffer, uint32 counterOffset, bool sortAscending, GPUBuffer* sortedIndicesBuffer);
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    bool Init() override;
+    void Dispose() override;
+
+#if COMPILE_WITH_DEV_ENV
+    void OnShaderReloading(Asset* obj)
+    {
+        _countCS = nullptr;
+        _scanCS = nullptr;
+        _scatterCS = nullptr;
+        invalidateResources();
+    }
+#endif
+
+protected:
+    // [RendererPass]
+    bool setupResources() override;
+};
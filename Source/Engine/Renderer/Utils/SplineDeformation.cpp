@@ -0,0 +1,127 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "SplineDeformation.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Graphics/GPUBuffer.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPULimits.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Graphics/Shaders/GPUShader.h"
+
+#define THREADGROUP_SIZE 64
+
+PACK_STRUCT(struct Data {
+    uint32 ChunksPerSegment;
+    uint32 SegmentsCount;
+    float ChunksPerSegmentInv;
+    float Dummy0;
+    });
+
+String SplineDeformation::ToString() const
+{
+    return TEXT("SplineDeformation");
+}
+
+bool SplineDeformation::Init()
+{
+    // Compute shaders support is required for this implementation
+    if (!GPUDevice::Instance->Limits.HasCompute)
+        return false;
+
+    // Load asset
+    _shader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/SplineDeformation"));
+    if (_shader == nullptr)
+        return true;
+#if COMPILE_WITH_DEV_ENV
+    _shader.Get()->OnReloading.Bind<SplineDeformation, &SplineDeformation::OnShaderReloading>(this);
+#endif
+
+    return false;
+}
+
+bool SplineDeformation::setupResources()
+{
+    // Skip if not supported (spline models fallback to the CPU evaluation)
+    if (!_shader)
+        return true;
+
+    // Check if shader has not been loaded
+    if (!_shader->IsLoaded())
+        return true;
+    const auto shader = _shader->GetShader();
+
+    // Validate shader constant buffer size
+    _cb = shader->GetCB(0);
+    if (_cb->GetSize() != sizeof(Data))
+    {
+        REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 0, Data);
+        return true;
+    }
+
+    // Cache compute shaders
+    _deformCS = shader->GetCS("CS_Deform");
+
+    return false;
+}
+
+void SplineDeformation::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    SAFE_DELETE_GPU_RESOURCE(_segmentsBuffer);
+    _cb = nullptr;
+    _deformCS = nullptr;
+    _shader = nullptr;
+}
+
+bool SplineDeformation::CanDeform()
+{
+    ScopeLock lock(RenderContext::GPULocker);
+    return !checkIfSkipPass() && _deformCS;
+}
+
+bool SplineDeformation::Deform(GPUContext* context, GPUBuffer* deformation, const Float4* segments, int32 segmentsCount, int32 chunksPerSegment, int32 splineSegments)
+{
+    ASSERT(context && deformation && segments);
+    if (segmentsCount <= 0)
+        return false;
+    ScopeLock lock(RenderContext::GPULocker);
+    if (checkIfSkipPass() || !_deformCS)
+        return true;
+    PROFILE_GPU_CPU("Spline Deformation");
+
+    // Upload segments control points (grow buffer with a slack to reduce reallocations)
+    const uint32 count = segmentsCount * SegmentStride;
+    if (!_segmentsBuffer)
+        _segmentsBuffer = GPUDevice::Instance->CreateBuffer(TEXT("SplineDeformation.Segments"));
+    if (_segmentsBuffer->GetElementsCount() < count)
+    {
+        const uint32 capacity = Math::AlignUp<uint32>(count + count / 4, 256);
+        if (_segmentsBuffer->Init(GPUBufferDescription::Typed(capacity, PixelFormat::R32G32B32A32_Float, false, GPUResourceUsage::Dynamic)))
+        {
+            LOG(Error, "Failed to create spline deformation buffer.");
+            return true;
+        }
+    }
+    context->UpdateBuffer(_segmentsBuffer, segments, count * sizeof(Float4));
+
+    // Setup constants buffer
+    Data data;
+    data.ChunksPerSegment = chunksPerSegment;
+    data.SegmentsCount = splineSegments;
+    data.ChunksPerSegmentInv = 1.0f / (float)chunksPerSegment;
+    data.Dummy0 = 0.0f;
+    context->UpdateCB(_cb, &data);
+    context->BindCB(0, _cb);
+
+    // Evaluate chunks (with an additional chunk at the end of the spline)
+    context->BindSR(0, _segmentsBuffer->View());
+    context->BindUA(0, deformation->View());
+    context->Dispatch(_deformCS, (chunksPerSegment + THREADGROUP_SIZE) / THREADGROUP_SIZE, segmentsCount, 1);
+    context->ResetUA();
+    context->ResetSR();
+    return false;
+}
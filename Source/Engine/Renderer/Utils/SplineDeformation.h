@@ -0,0 +1,58 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "../RendererPass.h"
+
+/// <summary>
+/// Spline models deformation implementation using compute shaders. Evaluates the spline chunk matrices of the dirty segments directly into the deformation buffer, so only the segment control points are uploaded to the GPU when spline gets modified.
+/// </summary>
+class SplineDeformation : public RendererPass<SplineDeformation>
+{
+public:
+    /// <summary>
+    /// The amount of float4 elements used by a single segment control data (4 control points, each with translation and segment index, orientation, scale).
+    /// </summary>
+    static constexpr int32 SegmentStride = 12;
+
+private:
+    AssetReference<Shader> _shader;
+    GPUConstantBuffer* _cb = nullptr;
+    GPUShaderProgramCS* _deformCS = nullptr;
+    GPUBuffer* _segmentsBuffer = nullptr;
+
+public:
+    /// <summary>
+    /// Determines whether compute shader deformation can be used (eg. shader is loaded and device supports compute).
+    /// </summary>
+    bool CanDeform();
+
+    /// <summary>
+    /// Evaluates the spline chunk matrices for the given segments into the deformation buffer.
+    /// </summary>
+    /// <param name="context">The GPU context.</param>
+    /// <param name="deformation">The deformation buffer (typed R32G32B32A32 with unordered access).</param>
+    /// <param name="segments">The dirty segments control data (SegmentStride float4 elements per segment).</param>
+    /// <param name="segmentsCount">The amount of the dirty segments to evaluate.</param>
+    /// <param name="chunksPerSegment">The amount of chunks per spline segment.</param>
+    /// <param name="splineSegments">The total amount of the spline segments.</param>
+    /// <returns>True if failed (eg. shader is not ready), otherwise false.</returns>
+    bool Deform(GPUContext* context, GPUBuffer* deformation, const Float4* segments, int32 segmentsCount, int32 chunksPerSegment, int32 splineSegments);
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    bool Init() override;
+    void Dispose() override;
+#if COMPILE_WITH_DEV_ENV
+    void OnShaderReloading(Asset* obj)
+    {
+        _deformCS = nullptr;
+        invalidateResources();
+    }
+#endif
+
+protected:
+    // [RendererPass]
+    bool setupResources() override;
+};
@@ -0,0 +1,153 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "VariableRateShadingPass.h"
+#include "RenderList.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPULimits.h"
+#include "Engine/Graphics/Graphics.h"
+#include "Engine/Graphics/RenderBuffers.h"
+#include "Engine/Graphics/RenderTargetPool.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Graphics/Shaders/GPUShader.h"
+
+#define THREADGROUP_SIZE_X 8
+#define THREADGROUP_SIZE_Y 8
+
+// The maximum luminance difference between the neighbor pixels (averaged over the tile) to shade the tile at half rate in that direction
+#define VARIABLE_RATE_SHADING_THRESHOLD 0.015f
+
+// The threshold scale per pixel of the tile motion (fast-moving tiles get blurred by TAA and motion blur anyway)
+#define VARIABLE_RATE_SHADING_MOTION_SCALE 0.1f
+
+PACK_STRUCT(struct Data {
+    Int2 InputSize;
+    Int2 OutputSize;
+    uint32 TileSize;
+    float Threshold;
+    float MotionScale;
+    float Dummy0;
+    });
+
+String VariableRateShadingPass::ToString() const
+{
+    return TEXT("VariableRateShadingPass");
+}
+
+bool VariableRateShadingPass::Init()
+{
+    // Image-based shading rate and compute shaders support is required for this implementation
+    const auto device = GPUDevice::Instance;
+    if (!device->Limits.HasVariableRateShading || !device->Limits.HasCompute || device->GetFeatureLevel() < FeatureLevel::SM5)
+        return false;
+
+    // Load asset
+    _shader = Content::LoadAsyncInternal<Shader>(TEXT("Shaders/VariableRateShading"));
+    if (_shader == nullptr)
+        return true;
+#if COMPILE_WITH_DEV_ENV
+    _shader.Get()->OnReloading.Bind<VariableRateShadingPass, &VariableRateShadingPass::OnShaderReloading>(this);
+#endif
+
+    return false;
+}
+
+bool VariableRateShadingPass::setupResources()
+{
+    // Skip if not supported (variable rate shading is not used)
+    if (!_shader)
+        return false;
+
+    // Check if shader has not been loaded
+    if (!_shader->IsLoaded())
+        return true;
+    const auto shader = _shader->GetShader();
+
+    // Validate shader constant buffer size
+    _cb = shader->GetCB(0);
+    if (_cb->GetSize() != sizeof(Data))
+    {
+        REPORT_INVALID_SHADER_PASS_CB_SIZE(shader, 0, Data);
+        return true;
+    }
+    _csShadingRate = shader->GetCS("CS_ShadingRate");
+
+    return false;
+}
+
+void VariableRateShadingPass::Dispose()
+{
+    // Base
+    RendererPass::Dispose();
+
+    // Cleanup
+    _cb = nullptr;
+    _csShadingRate = nullptr;
+    _shader = nullptr;
+}
+
+void VariableRateShadingPass::Render(RenderContext& renderContext, GPUContext* context, GPUTexture* frame)
+{
+    RenderBuffers* buffers = renderContext.Buffers;
+    if (!Graphics::VariableRateShading ||
+        !_shader ||
+        renderContext.View.IsOfflinePass ||
+        renderContext.View.IsSingleFrame ||
+        checkIfSkipPass())
+        return;
+    PROFILE_GPU_CPU("Variable Rate Shading");
+
+    // Ensure to have valid shading rate image (one texel per tile)
+    const int32 tileSize = GPUDevice::Instance->Limits.VariableRateShadingTileSize;
+    const int32 width = (buffers->GetWidth() + tileSize - 1) / tileSize;
+    const int32 height = (buffers->GetHeight() + tileSize - 1) / tileSize;
+    buffers->LastFrameShadingRate = Engine::FrameCount;
+    if (buffers->ShadingRate && (buffers->ShadingRate->Width() != width || buffers->ShadingRate->Height() != height))
+    {
+        RenderTargetPool::Release(buffers->ShadingRate);
+        buffers->ShadingRate = nullptr;
+    }
+    if (!buffers->ShadingRate)
+    {
+        const auto desc = GPUTextureDescription::New2D(width, height, PixelFormat::R8_UInt, GPUTextureFlags::ShaderResource | GPUTextureFlags::UnorderedAccess);
+        buffers->ShadingRate = RenderTargetPool::Get(desc);
+        if (!buffers->ShadingRate)
+            return;
+        RENDER_TARGET_POOL_SET_NAME(buffers->ShadingRate, "ShadingRate");
+    }
+
+    // Generate shading rate per tile
+    Data data;
+    data.InputSize = Int2(frame->Width(), frame->Height());
+    data.OutputSize = Int2(width, height);
+    data.TileSize = (uint32)tileSize;
+    data.Threshold = VARIABLE_RATE_SHADING_THRESHOLD;
+    data.MotionScale = VARIABLE_RATE_SHADING_MOTION_SCALE;
+    data.Dummy0 = 0.0f;
+    context->UpdateCB(_cb, &data);
+    context->BindCB(0, _cb);
+    context->BindSR(0, frame->View());
+    context->BindSR(1, buffers->MotionVectors && buffers->MotionVectors->IsAllocated() ? buffers->MotionVectors->View() : nullptr);
+    context->BindUA(0, buffers->ShadingRate->View());
+    context->Dispatch(_csShadingRate, width, height, 1);
+    context->ResetUA();
+    context->ResetSR();
+}
+
+GPUTexture* VariableRateShadingPass::Get(const RenderContext& renderContext) const
+{
+    // Use the shading rate image generated by the previous frame (skip it after resize or when it's outdated)
+    const RenderBuffers* buffers = renderContext.Buffers;
+    GPUTexture* shadingRate = buffers->ShadingRate;
+    if (!Graphics::VariableRateShading ||
+        !shadingRate ||
+        Engine::FrameCount - buffers->LastFrameShadingRate > 1 ||
+        renderContext.View.IsOfflinePass)
+        return nullptr;
+    const int32 tileSize = GPUDevice::Instance->Limits.VariableRateShadingTileSize;
+    if (shadingRate->Width() != (buffers->GetWidth() + tileSize - 1) / tileSize || shadingRate->Height() != (buffers->GetHeight() + tileSize - 1) / tileSize)
+        return nullptr;
+    return shadingRate;
+}
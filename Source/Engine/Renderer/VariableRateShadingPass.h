@@ -0,0 +1,49 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "RendererPass.h"
+
+/// <summary>
+/// Variable Rate Shading pass. Generates the shading rate image from the rendered frame (luminance contrast and motion per screen tile) that is used by the next frame to lower the pixel shading rate of the low-detail or fast-moving screen parts (eg. in GBuffer, forward and fog passes).
+/// </summary>
+class VariableRateShadingPass : public RendererPass<VariableRateShadingPass>
+{
+private:
+    AssetReference<Shader> _shader;
+    GPUConstantBuffer* _cb = nullptr;
+    GPUShaderProgramCS* _csShadingRate = nullptr;
+
+public:
+    /// <summary>
+    /// Generates the shading rate image for the next frame from the rendered frame.
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <param name="context">The GPU context.</param>
+    /// <param name="frame">The rendered frame (at rendering resolution, before post processing).</param>
+    void Render(RenderContext& renderContext, GPUContext* context, GPUTexture* frame);
+
+    /// <summary>
+    /// Gets the shading rate image to use for the view rendering (see GPUContext::SetShadingRate).
+    /// </summary>
+    /// <param name="renderContext">The rendering context.</param>
+    /// <returns>The shading rate image or null if variable rate shading is not used.</returns>
+    GPUTexture* Get(const RenderContext& renderContext) const;
+
+public:
+    // [RendererPass]
+    String ToString() const override;
+    bool Init() override;
+    void Dispose() override;
+#if COMPILE_WITH_DEV_ENV
+    void OnShaderReloading(Asset* obj)
+    {
+        _csShadingRate = nullptr;
+        invalidateResources();
+    }
+#endif
+
+protected:
+    // [RendererPass]
+    bool setupResources() override;
+};
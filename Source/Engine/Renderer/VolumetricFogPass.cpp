@@ -195,7 +195,10 @@ bool VolumetricFogPass::Init(RenderContext& renderContext, GPUContext* context,
     _cache.Data.GridSizeIntX = (uint32)_cache.GridSize.X;
     _cache.Data.GridSizeIntY = (uint32)_cache.GridSize.Y;
     _cache.Data.GridSizeIntZ = (uint32)_cache.GridSize.Z;
-    _cache.Data.HistoryWeight = _cache.HistoryWeight;
+    const bool temporalHistoryIsValid = renderContext.Buffers->VolumetricFogHistory && !renderContext.Task->IsCameraCut && Float3::NearEqual(renderContext.Buffers->VolumetricFogHistory->Size3(), _cache.GridSize);
+    _cache.Data.HistoryWeight = temporalHistoryIsValid ? _cache.HistoryWeight : 0.0f;
+    _cache.Data.Checkerboard = Graphics::VolumetricFogCheckerboard && temporalHistoryIsValid ? 1 : 0;
+    _cache.Data.CheckerboardParity = (uint32)(renderContext.Task->LastUsedFrame & 1);
     _cache.Data.FogParameters = options.FogParameters;
     _cache.Data.InverseSquaredLightDistanceBiasScale = _cache.InverseSquaredLightDistanceBiasScale;
     _cache.Data.PhaseG = options.ScatteringDistribution;
@@ -658,7 +661,7 @@ void VolumetricFogPass::Render(RenderContext& renderContext)
     {
         PROFILE_GPU("Light Scattering");
 
-        const bool temporalHistoryIsValid = renderContext.Buffers->VolumetricFogHistory && !renderContext.Task->IsCameraCut && Float3::NearEqual(renderContext.Buffers->VolumetricFogHistory->Size3(), cache.GridSize);
+        const bool temporalHistoryIsValid = cache.Data.HistoryWeight > 0.0f;
         const auto lightScatteringHistory = temporalHistoryIsValid ? renderContext.Buffers->VolumetricFogHistory : nullptr;
 
         context->BindUA(0, lightScattering->ViewVolume());
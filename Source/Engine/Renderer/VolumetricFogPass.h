@@ -52,7 +52,8 @@ class VolumetricFogPass : public RendererPass<VolumetricFogPass>
         uint32 GridSizeIntZ;
         float PhaseG;
 
-        Float2 Dummy0;
+        uint32 Checkerboard;
+        uint32 CheckerboardParity;
         float VolumetricFogMaxDistance;
         float InverseSquaredLightDistanceBiasScale;
 
@@ -10,5 +10,9 @@ namespace FlaxEngine
     [AttributeUsage(AttributeTargets.Field | AttributeTargets.Property)]
     public sealed class NetworkReplicatedAttribute : Attribute
     {
+        /// <summary>
+        /// The quantization precision used to replicate the value (eg. 0.01 to keep 2 decimal places). Supported by float, Float3, Vector3 and Quaternion values. Use 0 to replicate the full value.
+        /// </summary>
+        public float Precision;
     }
 }
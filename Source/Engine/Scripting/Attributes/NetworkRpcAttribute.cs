@@ -26,6 +26,11 @@ public sealed class NetworkRpcAttribute : Attribute
         /// </summary>
         public NetworkChannelType Channel;
 
+        /// <summary>
+        /// True if RPC should be sent right away when invoked (eg. latency-critical events), otherwise it's queued and batched with other RPCs at the end of the network update.
+        /// </summary>
+        public bool Immediate;
+
         /// <summary>
         /// Initializes a new instance of the <see cref="NetworkRpcAttribute"/> class.
         /// </summary>
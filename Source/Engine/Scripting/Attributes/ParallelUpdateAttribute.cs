@@ -0,0 +1,20 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+using System;
+
+namespace FlaxEngine
+{
+    /// <summary>
+    /// Marks the script OnUpdate as thread-safe so it can be called in parallel with other such scripts using Job System. Use <see cref="Scripting.InvokeOnUpdate"/> to perform structural changes to the scene (eg. spawning, destroying or reparenting objects) from the script update.
+    /// </summary>
+    [AttributeUsage(AttributeTargets.Class)]
+    public sealed class ParallelUpdateAttribute : Attribute
+    {
+        /// <summary>
+        /// Initializes a new instance of the <see cref="ParallelUpdateAttribute"/> class.
+        /// </summary>
+        public ParallelUpdateAttribute()
+        {
+        }
+    }
+}
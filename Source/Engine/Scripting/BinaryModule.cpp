@@ -937,9 +937,8 @@ void ManagedBinaryModule::OnLoaded(MAssembly* assembly)
         ScriptingType& type = Types[typeIndex];
         ASSERT(type.ManagedClass == nullptr);
 
-        // Cache class
-        const StringAnsi typeName(type.Fullname.Get(), type.Fullname.Length());
-        classes.TryGet(typeName, type.ManagedClass);
+        // Cache class (lookup by name view to skip allocating the name string for every native type)
+        classes.TryGet(type.Fullname, type.ManagedClass);
         if (type.ManagedClass == nullptr)
         {
             LOG(Error, "Missing class {0} from assembly {1}.", type.ToString(), assembly->ToString());
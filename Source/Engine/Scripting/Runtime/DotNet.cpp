@@ -1114,7 +1114,12 @@ const Array<MClass*>& MClass::GetInterfaces() const
 
 bool MClass::HasAttribute(const MClass* monoClass) const
 {
-    return GetCustomAttribute(this, monoClass) != nullptr;
+    if (_hasCachedAttributes || !monoClass)
+        return GetCustomAttribute(this, monoClass) != nullptr;
+
+    // Check type metadata without creating all attribute objects (eg. when searching for module initializers in all classes of the loaded assembly)
+    static void* TypeHasCustomAttributePtr = GetStaticMethodPointer(TEXT("TypeHasCustomAttribute"));
+    return CallStaticMethod<bool, void*, void*>(TypeHasCustomAttributePtr, _handle, monoClass->_handle);
 }
 
 bool MClass::HasAttribute() const
@@ -317,7 +317,7 @@ void OnGCAllocation(MonoProfiler* profiler, MonoObject* obj)
     auto thread = ProfilerCPU::GetCurrentThread();
     if (thread != nullptr && thread->Buffer.GetCount() != 0)
     {
-        auto& activeEvent = thread->Buffer.Last().Event();
+        auto& activeEvent = thread->Buffer.Last();
         if (activeEvent.End < ZeroTolerance)
         {
             activeEvent.ManagedMemoryAllocation += size;
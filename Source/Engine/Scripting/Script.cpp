@@ -2,9 +2,11 @@
 
 #include "Script.h"
 #include "Engine/Core/Log.h"
-#if USE_EDITOR
+#if USE_CSHARP
 #include "Internal/StdTypesContainer.h"
 #include "ManagedCLR/MClass.h"
+#endif
+#if USE_EDITOR
 #include "Editor/Editor.h"
 #endif
 #include "Scripting.h"
@@ -20,6 +22,8 @@
 #define CHECK_EXECUTE_IN_EDITOR
 #endif
 
+bool Script::BatchManagedUpdate = false;
+
 Script::Script(const SpawnParams& params)
     : SceneObject(params)
     , _enabled(true)
@@ -30,7 +34,14 @@ Script::Script(const SpawnParams& params)
     , _wasAwakeCalled(false)
     , _wasStartCalled(false)
     , _wasEnableCalled(false)
+    , _managedTick(false)
 {
+#if USE_CSHARP
+    const MClass* klass = GetClass();
+    _parallelUpdate = klass && klass->HasAttribute(StdTypesContainer::Instance()->ParallelUpdateAttribute);
+#else
+    _parallelUpdate = false;
+#endif
 #if USE_EDITOR
     _executeInEditor = GetClass()->HasAttribute(StdTypesContainer::Instance()->ExecuteInEditModeAttribute);
 #endif
@@ -174,6 +185,7 @@ void Script::SetOrderInParent(int32 index)
 void Script::SetupType()
 {
     // Enable tick functions based on the method overriden in C# or Visual Script
+    _managedTick = EnumHasAnyFlags(Flags, ObjectFlags::IsManagedType);
     ScriptingTypeHandle typeHandle = GetTypeHandle();
     while (typeHandle != Script::TypeInitializer)
     {
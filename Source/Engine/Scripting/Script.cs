@@ -1,5 +1,10 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
+using System;
+#if USE_NETCORE
+using FlaxEngine.Interop;
+#endif
+
 namespace FlaxEngine
 {
     partial class Script
@@ -36,5 +41,39 @@ public Transform LocalTransform
             get => Actor.LocalTransform;
             set => Actor.LocalTransform = value;
         }
+
+#if USE_NETCORE
+        internal static unsafe void Internal_TickScripts(IntPtr scripts, int count, int phase)
+        {
+            // Called from the native scene ticking when using batched managed update (see BatchManagedUpdate)
+            var handles = (IntPtr*)scripts;
+            for (int i = 0; i < count; i++)
+            {
+                try
+                {
+                    var script = (Script)ManagedHandle.FromIntPtr(handles[i]).Target;
+                    switch (phase)
+                    {
+                    case 0:
+                        script.OnUpdate();
+                        break;
+                    case 1:
+                        script.OnLateUpdate();
+                        break;
+                    case 2:
+                        script.OnFixedUpdate();
+                        break;
+                    case 3:
+                        script.OnLateFixedUpdate();
+                        break;
+                    }
+                }
+                catch (Exception ex)
+                {
+                    Debug.LogException(ex);
+                }
+            }
+        }
+#endif
     }
 }
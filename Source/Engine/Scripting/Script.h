@@ -23,10 +23,18 @@ API_CLASS(Abstract) class FLAXENGINE_API Script : public SceneObject
     uint16 _wasAwakeCalled : 1;
     uint16 _wasStartCalled : 1;
     uint16 _wasEnableCalled : 1;
+    uint16 _parallelUpdate : 1; // Can be set in the script constructor to tick OnUpdate in parallel (see GetParallelUpdate)
+    uint16 _managedTick : 1; // Script type is implemented in C# and can be ticked from a managed batch (see BatchManagedUpdate)
 #if USE_EDITOR
     uint16 _executeInEditor : 1;
 #endif
 
+public:
+    /// <summary>
+    /// If checked, C# scripts are ticked in batches with a single native to managed call per update phase (instead of a separate call per script) which reduces the interop overhead for scenes with a large amount of scripts. Script update overrides must not call the base method in that mode (it's empty anyway) as it would invoke the override again. Supported only on .NET runtime.
+    /// </summary>
+    API_FIELD() static bool BatchManagedUpdate;
+
 public:
     /// <summary>
     /// Gets value indicating if script is active.
@@ -42,6 +50,15 @@ API_CLASS(Abstract) class FLAXENGINE_API Script : public SceneObject
     /// </summary>
     API_PROPERTY() void SetEnabled(bool value);
 
+    /// <summary>
+    /// Gets value indicating if script has thread-safe OnUpdate that is called in parallel with other such scripts (using Job System). Use ParallelUpdate attribute on a script class to enable it. Structural changes to the scene (eg. spawning, destroying or reparenting objects) have to be deferred to the main thread (SceneTicking::Defer in C++ or Scripting.InvokeOnUpdate in C#).
+    /// </summary>
+    API_PROPERTY(Attributes="HideInEditor")
+    FORCE_INLINE bool GetParallelUpdate() const
+    {
+        return _parallelUpdate != 0;
+    }
+
     /// <summary>
     /// Gets the actor owning that script.
     /// </summary>
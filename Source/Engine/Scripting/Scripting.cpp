@@ -22,6 +22,7 @@
 #include "ManagedCLR/MException.h"
 #include "Internal/StdTypesContainer.h"
 #include "Engine/Core/ObjectsRemovalService.h"
+#include "Engine/Core/Collections/FlatDictionary.h"
 #include "Engine/Core/Types/TimeSpan.h"
 #include "Engine/Core/Types/Stopwatch.h"
 #include "Engine/Content/Asset.h"
@@ -32,6 +33,7 @@
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Serialization/JsonTools.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Profiler/ProfilerMemory.h"
 
 extern void registerFlaxEngineInternalCalls();
 
@@ -57,7 +59,6 @@ namespace
 {
     MDomain* _rootDomain = nullptr;
     MDomain* _scriptsDomain = nullptr;
-    CriticalSection _objectsLocker;
 #define USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING 0
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
     struct ScriptingObjectData
@@ -93,10 +94,30 @@ namespace
         }
     };
 
-    Dictionary<Guid, ScriptingObjectData> _objectsDictionary(1024 * 16);
+    typedef ScriptingObjectData ScriptingObjectEntry;
 #else
-    Dictionary<Guid, ScriptingObject*> _objectsDictionary(1024 * 16);
+    typedef ScriptingObject* ScriptingObjectEntry;
 #endif
+
+    // Objects registry is split into shards (each with its own lock) to reduce threads contention on objects lookups (eg. objects references resolving in jobs)
+#define SCRIPTING_OBJECTS_SHARDS 64
+    struct ObjectsShard
+    {
+        CriticalSection Locker;
+        FlatDictionary<Guid, ScriptingObjectEntry> Objects;
+
+        ObjectsShard()
+            : Objects(1024 * 16 / SCRIPTING_OBJECTS_SHARDS)
+        {
+        }
+    };
+
+    ObjectsShard _objectsShards[SCRIPTING_OBJECTS_SHARDS];
+
+    FORCE_INLINE ObjectsShard& GetObjectsShard(const Guid& id)
+    {
+        return _objectsShards[GetHash(id) % SCRIPTING_OBJECTS_SHARDS];
+    }
     bool _isEngineAssemblyLoaded = false;
     bool _hasGameModulesLoaded = false;
     MMethod* _method_Update = nullptr;
@@ -192,6 +213,7 @@ bool ScriptingService::Init()
 void ScriptingService::Update()
 {
     PROFILE_CPU_NAMED("Scripting::Update");
+    PROFILE_MEM(Scripting);
     INVOKE_EVENT(Update);
 
 #ifdef USE_NETCORE
@@ -574,18 +596,22 @@ void Scripting::Release()
     MCore::GC::WaitForPendingFinalizers();
 
     // Release managed objects instances for persistent objects (assets etc.)
-    _objectsLocker.Lock();
+    Array<ScriptingObjectEntry> objects;
+    for (ObjectsShard& shard : _objectsShards)
     {
-        for (auto i = _objectsDictionary.Begin(); i.IsNotEnd(); ++i)
+        ScopeLock lock(shard.Locker);
+
+        // Objects can unregister during dispose which moves the other items in the registry so iterate over a copy
+        objects.Clear();
+        shard.Objects.GetValues(objects);
+        for (auto& obj : objects)
         {
-            auto obj = i->Value;
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
             LOG(Info, "[OnScriptingDispose] obj = 0x{0:x}, {1}", (uint64)obj.Ptr, String(obj.TypeName));
 #endif
             obj->OnScriptingDispose();
         }
     }
-    _objectsLocker.Unlock();
 
     // Release assets sourced from game assemblies
     const auto flaxModule = GetBinaryModuleFlaxEngine();
@@ -682,11 +708,14 @@ void Scripting::Reload(bool canTriggerSceneReload)
 
     // Destroy objects from game assemblies (eg. not released objects that might crash if persist in memory after reload)
     const auto flaxModule = GetBinaryModuleFlaxEngine();
-    _objectsLocker.Lock();
+    Array<ScriptingObjectEntry> objects;
+    for (ObjectsShard& shard : _objectsShards)
     {
-        for (auto i = _objectsDictionary.Begin(); i.IsNotEnd(); ++i)
+        ScopeLock lock(shard.Locker);
+        objects.Clear();
+        shard.Objects.GetValues(objects);
+        for (auto& obj : objects)
         {
-            auto obj = i->Value;
             if (obj->GetTypeHandle().Module == flaxModule)
                 continue;
 
@@ -696,7 +725,6 @@ void Scripting::Reload(bool canTriggerSceneReload)
             obj->OnScriptingDispose();
         }
     }
-    _objectsLocker.Unlock();
 
     // Release assets sourced from game assemblies
     for (auto asset : Content::GetAssets())
@@ -874,17 +902,18 @@ ScriptingObject* Scripting::FindObject(Guid id, MClass* type)
     }
 
     // Try to find it
+    ObjectsShard& shard = GetObjectsShard(id);
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
     ScriptingObjectData data;
-    _objectsLocker.Lock();
-    _objectsDictionary.TryGet(id, data);
-    _objectsLocker.Unlock();
+    shard.Locker.Lock();
+    shard.Objects.TryGet(id, data);
+    shard.Locker.Unlock();
     auto result = data.Ptr;
 #else
     ScriptingObject* result = nullptr;
-    _objectsLocker.Lock();
-    _objectsDictionary.TryGet(id, result);
-    _objectsLocker.Unlock();
+    shard.Locker.Lock();
+    shard.Objects.TryGet(id, result);
+    shard.Locker.Unlock();
 #endif
     if (result)
     {
@@ -928,17 +957,18 @@ ScriptingObject* Scripting::TryFindObject(Guid id, MClass* type)
     }
 
     // Try to find it
+    ObjectsShard& shard = GetObjectsShard(id);
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
     ScriptingObjectData data;
-    _objectsLocker.Lock();
-    _objectsDictionary.TryGet(id, data);
-    _objectsLocker.Unlock();
+    shard.Locker.Lock();
+    shard.Objects.TryGet(id, data);
+    shard.Locker.Unlock();
     auto result = data.Ptr;
 #else
     ScriptingObject* result = nullptr;
-    _objectsLocker.Lock();
-    _objectsDictionary.TryGet(id, result);
-    _objectsLocker.Unlock();
+    shard.Locker.Lock();
+    shard.Objects.TryGet(id, result);
+    shard.Locker.Unlock();
 #endif
 
     // Check type
@@ -954,12 +984,15 @@ ScriptingObject* Scripting::TryFindObject(MClass* type)
 {
     if (type == nullptr)
         return nullptr;
-    ScopeLock lock(_objectsLocker);
-    for (auto i = _objectsDictionary.Begin(); i.IsNotEnd(); ++i)
+    for (ObjectsShard& shard : _objectsShards)
     {
-        const auto obj = i->Value;
-        if (obj->GetClass() == type)
-            return obj;
+        ScopeLock lock(shard.Locker);
+        for (auto i = shard.Objects.Begin(); i.IsNotEnd(); ++i)
+        {
+            const auto obj = i->Value;
+            if (obj->GetClass() == type)
+                return obj;
+        }
     }
     return nullptr;
 }
@@ -972,13 +1005,15 @@ ScriptingObject* Scripting::FindObject(const MObject* managedInstance)
 
     // TODO: optimize it by reading the unmanagedPtr or _internalId from managed Object property
 
-    ScopeLock lock(_objectsLocker);
-
-    for (auto i = _objectsDictionary.Begin(); i.IsNotEnd(); ++i)
+    for (ObjectsShard& shard : _objectsShards)
     {
-        const auto obj = i->Value;
-        if (obj->GetManagedInstance() == managedInstance)
-            return obj;
+        ScopeLock lock(shard.Locker);
+        for (auto i = shard.Objects.Begin(); i.IsNotEnd(); ++i)
+        {
+            const auto obj = i->Value;
+            if (obj->GetManagedInstance() == managedInstance)
+                return obj;
+        }
     }
     return nullptr;
 }
@@ -988,20 +1023,20 @@ void Scripting::OnManagedInstanceDeleted(ScriptingObject* obj)
     PROFILE_CPU();
     ASSERT(obj);
 
-    // Validate if object still exists
-    _objectsLocker.Lock();
-    if (_objectsDictionary.ContainsValue(obj))
+    // Validate if object still exists (object memory might be already freed so search all shards by value)
+    for (ObjectsShard& shard : _objectsShards)
     {
+        ScopeLock lock(shard.Locker);
+        if (shard.Objects.ContainsValue(obj))
+        {
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
-        LOG(Info, "[OnManagedInstanceDeleted] obj = 0x{0:x}, {1}", (uint64)obj, String(ScriptingObjectData(obj).TypeName));
+            LOG(Info, "[OnManagedInstanceDeleted] obj = 0x{0:x}, {1}", (uint64)obj, String(ScriptingObjectData(obj).TypeName));
 #endif
-        obj->OnManagedInstanceDeleted();
-    }
-    else
-    {
-        //LOG(Warning, "Object finalization called for already removed object (address={0:x})", (uint64)obj);
+            obj->OnManagedInstanceDeleted();
+            return;
+        }
     }
-    _objectsLocker.Unlock();
+    //LOG(Warning, "Object finalization called for already removed object (address={0:x})", (uint64)obj);
 }
 
 bool Scripting::HasGameModulesLoaded()
@@ -1029,17 +1064,13 @@ bool Scripting::IsTypeFromGameScripts(MClass* type)
 void Scripting::RegisterObject(ScriptingObject* obj)
 {
     const Guid id = obj->GetID();
-    ScopeLock lock(_objectsLocker);
+    ObjectsShard& shard = GetObjectsShard(id);
+    ScopeLock lock(shard.Locker);
 
-    //ASSERT(!_objectsDictionary.ContainsValue(obj));
+    //ASSERT(!shard.Objects.ContainsValue(obj));
 #if ENABLE_ASSERTION
-#if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
-    ScriptingObjectData other;
-    if (_objectsDictionary.TryGet(id, other))
-#else
-    ScriptingObject* other;
-    if (_objectsDictionary.TryGet(id, other))
-#endif
+    ScriptingObjectEntry other;
+    if (shard.Objects.TryGet(id, other))
     {
         // Something went wrong...
         LOG(Error, "Objects registry already contains object with ID={0} (type '{3}')! Trying to register object {1} (type '{2}').", id, obj->ToString(), String(obj->GetClass()->GetFullName()), String(other->GetClass()->GetFullName()));
@@ -1049,33 +1080,42 @@ void Scripting::RegisterObject(ScriptingObject* obj)
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
     LOG(Info, "[RegisterObject] obj = 0x{0:x}, {1}", (uint64)obj, String(ScriptingObjectData(obj).TypeName));
 #endif
-    _objectsDictionary[id] = obj;
+    shard.Objects[id] = obj;
 }
 
 void Scripting::UnregisterObject(ScriptingObject* obj)
 {
-    ScopeLock lock(_objectsLocker);
+    const Guid id = obj->GetID();
+    ObjectsShard& shard = GetObjectsShard(id);
+    ScopeLock lock(shard.Locker);
 
-    //ASSERT(!obj->_id.IsValid() || _objectsDictionary.ContainsValue(obj));
+    //ASSERT(!obj->_id.IsValid() || shard.Objects.ContainsValue(obj));
 
 #if USE_OBJECTS_DISPOSE_CRASHES_DEBUGGING
     LOG(Info, "[UnregisterObject] obj = 0x{0:x}, {1}", (uint64)obj, String(ScriptingObjectData(obj).TypeName));
 #endif
-    _objectsDictionary.Remove(obj->GetID());
+    shard.Objects.Remove(id);
 }
 
 void Scripting::OnObjectIdChanged(ScriptingObject* obj, const Guid& oldId)
 {
-    ScopeLock lock(_objectsLocker);
-
     ASSERT(obj && oldId.IsValid());
     ASSERT(obj->GetID() != oldId);
-    ASSERT(_objectsDictionary.ContainsKey(oldId));
-    //ASSERT(_objectsDictionary.ContainsValue(obj));
-    ASSERT(!_objectsDictionary.ContainsKey(obj->GetID()));
+    ObjectsShard& oldShard = GetObjectsShard(oldId);
+    ObjectsShard& newShard = GetObjectsShard(obj->GetID());
+
+    // Lock shards in a fixed order to prevent deadlocks
+    ObjectsShard* firstShard = &oldShard < &newShard ? &oldShard : &newShard;
+    ObjectsShard* secondShard = &oldShard < &newShard ? &newShard : &oldShard;
+    ScopeLock lock1(firstShard->Locker);
+    ScopeLock lock2(secondShard->Locker);
+
+    ASSERT(oldShard.Objects.ContainsKey(oldId));
+    //ASSERT(oldShard.Objects.ContainsValue(obj));
+    ASSERT(!newShard.Objects.ContainsKey(obj->GetID()));
 
-    _objectsDictionary.Remove(oldId);
-    _objectsDictionary.Add(obj->GetID(), obj);
+    oldShard.Objects.Remove(oldId);
+    newShard.Objects.Add(obj->GetID(), obj);
 }
 
 bool initFlaxEngine()
@@ -5,12 +5,17 @@
 #include "Engine/Core/Types/String.h"
 #include "Engine/Core/Types/StringView.h"
 
-// TODO: config RAPIDJSON_SSE2 for rapidjson
+// Use SIMD for whitespace skipping in the parser (used by null-terminated and in-situ string streams)
+#if PLATFORM_SIMD_SSE4_2
+#define RAPIDJSON_SSE42
+#elif PLATFORM_SIMD_SSE2
+#define RAPIDJSON_SSE2
+#endif
 #define RAPIDJSON_ERROR_CHARTYPE Char
 #define RAPIDJSON_ERROR_STRING(x) TEXT(x)
 #define RAPIDJSON_ASSERT(x) ASSERT(x)
 #define RAPIDJSON_NEW(x) New<x>()
-#define RAPIDJSON_DELETE(x) Delete(x)
+#define RAPIDJSON_DELETE(x) do { if (x) Delete(x); } while (0)
 #define RAPIDJSON_NOMEMBERITERATORCLASS
 #include <ThirdParty/rapidjson/rapidjson.h>
 #include <ThirdParty/rapidjson/writer.h>
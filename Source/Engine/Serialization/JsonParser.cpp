@@ -0,0 +1,627 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "JsonParser.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Platform/StringUtils.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Serialization/MemoryReadStream.h"
+#include "Engine/Serialization/MemoryWriteStream.h"
+#include "Engine/Threading/JobSystem.h"
+
+// The minimum amount of items in the array to parse it in parallel
+#define JSON_PARSER_PARALLEL_MIN_ITEMS 256
+
+// The minimum amount of items in the array to parse by a single job
+#define JSON_PARSER_JOB_MIN_ITEMS 64
+
+// The binary Json document format header
+#define JSON_BINARY_MAGIC 0x42534A46 // 'FJSB'
+#define JSON_BINARY_VERSION 1
+
+namespace
+{
+    struct JobError
+    {
+        rapidjson::ParseErrorCode Code;
+        size_t Offset;
+    };
+
+    FORCE_INLINE int32 SkipWhitespace(const char* text, int32 pos, int32 length)
+    {
+        while (pos < length && (text[pos] == ' ' || text[pos] == '\n' || text[pos] == '\r' || text[pos] == '\t'))
+            pos++;
+        return pos;
+    }
+
+    int32 SkipString(const char* text, int32 pos, int32 length)
+    {
+        // Skip opening quote
+        pos++;
+        while (pos < length)
+        {
+            const char c = text[pos++];
+            if (c == '\\')
+                pos++;
+            else if (c == '"')
+                return pos;
+        }
+        return -1;
+    }
+
+    int32 SkipValue(const char* text, int32 pos, int32 length)
+    {
+        char c = text[pos];
+        if (c == '"')
+            return SkipString(text, pos, length);
+        if (c == '{' || c == '[')
+        {
+            int32 depth = 0;
+            while (pos < length)
+            {
+                c = text[pos];
+                if (c == '"')
+                {
+                    pos = SkipString(text, pos, length);
+                    if (pos == -1)
+                        return -1;
+                    continue;
+                }
+                if (c == '{' || c == '[')
+                {
+                    depth++;
+                }
+                else if (c == '}' || c == ']')
+                {
+                    if (--depth == 0)
+                        return pos + 1;
+                }
+                pos++;
+            }
+            return -1;
+        }
+        while (pos < length)
+        {
+            c = text[pos];
+            if (c == ',' || c == ']' || c == '}' || c == ' ' || c == '\n' || c == '\r' || c == '\t')
+                break;
+            pos++;
+        }
+        return pos;
+    }
+
+    // Finds the array of the root object member and gathers the offsets of its items. Validates only the structure (parser reports any syntax errors).
+    bool FindArrayItems(const char* text, int32 length, const char* member, int32& arrayStart, int32& arrayEnd, Array<int32>& items)
+    {
+        const int32 memberLength = StringUtils::Length(member);
+        int32 pos = SkipWhitespace(text, 0, length);
+        if (pos >= length || text[pos] != '{')
+            return true;
+        pos++;
+        while (true)
+        {
+            pos = SkipWhitespace(text, pos, length);
+            if (pos >= length || text[pos] != '"')
+                return true;
+            const int32 keyStart = pos + 1;
+            pos = SkipString(text, pos, length);
+            if (pos == -1)
+                return true;
+            const bool isMember = pos - keyStart - 1 == memberLength && StringUtils::Compare(text + keyStart, member, memberLength) == 0;
+            pos = SkipWhitespace(text, pos, length);
+            if (pos >= length || text[pos] != ':')
+                return true;
+            pos = SkipWhitespace(text, pos + 1, length);
+            if (pos >= length)
+                return true;
+            if (isMember)
+            {
+                if (text[pos] != '[')
+                    return true;
+                break;
+            }
+            pos = SkipValue(text, pos, length);
+            if (pos == -1)
+                return true;
+            pos = SkipWhitespace(text, pos, length);
+            if (pos >= length || text[pos] != ',')
+                return true;
+            pos++;
+        }
+        arrayStart = pos++;
+        bool afterComma = false;
+        while (true)
+        {
+            pos = SkipWhitespace(text, pos, length);
+            if (pos >= length || (afterComma && text[pos] == ']'))
+                return true;
+            if (text[pos] == ']')
+                break;
+            items.Add(pos);
+            pos = SkipValue(text, pos, length);
+            if (pos == -1)
+                return true;
+            pos = SkipWhitespace(text, pos, length);
+            if (pos >= length)
+                return true;
+            afterComma = text[pos] == ',';
+            if (afterComma)
+                pos++;
+            else if (text[pos] != ']')
+                return true;
+        }
+        arrayEnd = pos;
+        return false;
+    }
+}
+
+namespace
+{
+    enum class BinaryType : byte
+    {
+        Null,
+        False,
+        True,
+        Int,
+        Uint,
+        Int64,
+        Uint64,
+        Double,
+        String,
+        Array,
+        Object,
+        // Array with the offsets table of its items (for parallel loading)
+        IndexedArray,
+    };
+
+    struct IndexedArray
+    {
+        const char* Name;
+        uint32 NameLength;
+        uint32 Count;
+        const uint32* Offsets;
+        const byte* Items;
+        uint32 ItemsSize;
+    };
+
+    void WriteString(MemoryWriteStream& stream, const char* str, uint32 length)
+    {
+        stream.WriteUint32(length);
+        stream.WriteBytes(str, length);
+    }
+
+    void WriteValue(MemoryWriteStream& stream, const rapidjson_flax::Value& value, const char* indexedMember)
+    {
+        switch (value.GetType())
+        {
+        case rapidjson::kNullType:
+            stream.WriteByte((byte)BinaryType::Null);
+            break;
+        case rapidjson::kFalseType:
+            stream.WriteByte((byte)BinaryType::False);
+            break;
+        case rapidjson::kTrueType:
+            stream.WriteByte((byte)BinaryType::True);
+            break;
+        case rapidjson::kNumberType:
+            if (value.IsInt())
+            {
+                stream.WriteByte((byte)BinaryType::Int);
+                stream.WriteInt32(value.GetInt());
+            }
+            else if (value.IsUint())
+            {
+                stream.WriteByte((byte)BinaryType::Uint);
+                stream.WriteUint32(value.GetUint());
+            }
+            else if (value.IsInt64())
+            {
+                stream.WriteByte((byte)BinaryType::Int64);
+                stream.WriteInt64(value.GetInt64());
+            }
+            else if (value.IsUint64())
+            {
+                stream.WriteByte((byte)BinaryType::Uint64);
+                stream.WriteUint64(value.GetUint64());
+            }
+            else
+            {
+                stream.WriteByte((byte)BinaryType::Double);
+                stream.WriteDouble(value.GetDouble());
+            }
+            break;
+        case rapidjson::kStringType:
+            stream.WriteByte((byte)BinaryType::String);
+            WriteString(stream, value.GetString(), value.GetStringLength());
+            break;
+        case rapidjson::kArrayType:
+            stream.WriteByte((byte)BinaryType::Array);
+            stream.WriteUint32(value.Size());
+            for (uint32 i = 0; i < value.Size(); i++)
+                WriteValue(stream, value[i], nullptr);
+            break;
+        case rapidjson::kObjectType:
+            stream.WriteByte((byte)BinaryType::Object);
+            stream.WriteUint32(value.MemberCount());
+            for (auto i = value.MemberBegin(); i != value.MemberEnd(); ++i)
+            {
+                WriteString(stream, i->name.GetString(), i->name.GetStringLength());
+                if (indexedMember && i->value.IsArray() && StringUtils::Compare(i->name.GetString(), indexedMember) == 0)
+                {
+                    // Write items separately to build the offsets table
+                    MemoryWriteStream items(Math::Max<uint32>(i->value.Size() * 256, 1024));
+                    Array<uint32> offsets;
+                    offsets.Resize(i->value.Size());
+                    for (uint32 j = 0; j < i->value.Size(); j++)
+                    {
+                        offsets[j] = items.GetPosition();
+                        WriteValue(items, i->value[j], nullptr);
+                    }
+                    stream.WriteByte((byte)BinaryType::IndexedArray);
+                    stream.WriteUint32(offsets.Count());
+                    stream.WriteUint32(items.GetPosition());
+                    stream.WriteBytes(offsets.Get(), offsets.Count() * sizeof(uint32));
+                    stream.WriteBytes(items.GetHandle(), items.GetPosition());
+                }
+                else
+                {
+                    WriteValue(stream, i->value, nullptr);
+                }
+            }
+            break;
+        }
+    }
+
+    template<typename T>
+    FORCE_INLINE const T* ReadData(MemoryReadStream& stream, uint32 count = 1)
+    {
+        if (stream.GetLength() - stream.GetPosition() < sizeof(T) * count)
+            return nullptr;
+        return stream.Move<T>(count);
+    }
+
+    bool ReadValue(MemoryReadStream& stream, rapidjson_flax::Value& value, JsonParser::PoolAllocator& allocator, Array<IndexedArray>* indexedArrays, const char* name = nullptr, uint32 nameLength = 0)
+    {
+        const byte* type = ReadData<byte>(stream);
+        if (!type)
+            return true;
+        switch ((BinaryType)*type)
+        {
+        case BinaryType::Null:
+            value.SetNull();
+            break;
+        case BinaryType::False:
+            value.SetBool(false);
+            break;
+        case BinaryType::True:
+            value.SetBool(true);
+            break;
+#define READ_NUMBER(type, setter) \
+    { \
+        const type* v = ReadData<type>(stream); \
+        if (!v) \
+            return true; \
+        value.setter(*v); \
+        break; \
+    }
+        case BinaryType::Int:
+            READ_NUMBER(int32, SetInt);
+        case BinaryType::Uint:
+            READ_NUMBER(uint32, SetUint);
+        case BinaryType::Int64:
+            READ_NUMBER(int64, SetInt64);
+        case BinaryType::Uint64:
+            READ_NUMBER(uint64, SetUint64);
+        case BinaryType::Double:
+            READ_NUMBER(double, SetDouble);
+#undef READ_NUMBER
+        case BinaryType::String:
+        {
+            const uint32* length = ReadData<uint32>(stream);
+            const char* str = length ? ReadData<char>(stream, *length) : nullptr;
+            if (!str)
+                return true;
+            value.SetString(str, *length, allocator);
+            break;
+        }
+        case BinaryType::Array:
+        {
+            const uint32* count = ReadData<uint32>(stream);
+            if (!count)
+                return true;
+            value.SetArray();
+            value.Reserve(*count, allocator);
+            for (uint32 i = 0; i < *count; i++)
+            {
+                rapidjson_flax::Value item;
+                if (ReadValue(stream, item, allocator, nullptr))
+                    return true;
+                value.PushBack(item, allocator);
+            }
+            break;
+        }
+        case BinaryType::Object:
+        {
+            const uint32* count = ReadData<uint32>(stream);
+            if (!count)
+                return true;
+            value.SetObject();
+            for (uint32 i = 0; i < *count; i++)
+            {
+                const uint32* length = ReadData<uint32>(stream);
+                const char* str = length ? ReadData<char>(stream, *length) : nullptr;
+                if (!str)
+                    return true;
+                rapidjson_flax::Value memberName(str, *length, allocator);
+                rapidjson_flax::Value memberValue;
+                if (ReadValue(stream, memberValue, allocator, name ? nullptr : indexedArrays, str, *length))
+                    return true;
+                value.AddMember(memberName, memberValue, allocator);
+            }
+            break;
+        }
+        case BinaryType::IndexedArray:
+        {
+            // Indexed arrays are supported only as root object members (items are loaded later)
+            IndexedArray indexed;
+            const uint32* count = ReadData<uint32>(stream);
+            const uint32* itemsSize = count ? ReadData<uint32>(stream) : nullptr;
+            indexed.Offsets = itemsSize ? ReadData<uint32>(stream, *count) : nullptr;
+            indexed.Items = indexed.Offsets ? ReadData<byte>(stream, *itemsSize) : nullptr;
+            if (!indexedArrays || !name || !indexed.Items)
+                return true;
+            indexed.Name = name;
+            indexed.NameLength = nameLength;
+            indexed.Count = *count;
+            indexed.ItemsSize = *itemsSize;
+            for (uint32 i = 0; i < indexed.Count; i++)
+            {
+                if (indexed.Offsets[i] >= indexed.ItemsSize)
+                    return true;
+            }
+            indexedArrays->Add(indexed);
+            value.SetArray();
+            value.Reserve(indexed.Count, allocator);
+            for (uint32 i = 0; i < indexed.Count; i++)
+            {
+                rapidjson_flax::Value item;
+                value.PushBack(item, allocator);
+            }
+            break;
+        }
+        default:
+            return true;
+        }
+        return false;
+    }
+}
+
+JsonParser::~JsonParser()
+{
+    Clear();
+}
+
+uint64 JsonParser::GetMemoryUsage() const
+{
+    uint64 result = _buffer.Capacity() + _rootBuffer.Capacity() + _allocators.Capacity() * sizeof(PoolAllocator*);
+    for (const PoolAllocator* allocator : _allocators)
+        result += allocator->Capacity();
+    return result;
+}
+
+void JsonParser::Reset()
+{
+    for (PoolAllocator* allocator : _allocators)
+        Delete(allocator);
+    _allocators.Clear();
+    _rootBuffer.Clear();
+    _buffer.Clear();
+    _error = rapidjson::kParseErrorNone;
+    _errorOffset = 0;
+}
+
+bool JsonParser::Parse(Document& document, const char* json, int32 length, const char* arrayMember, bool inSitu)
+{
+    PROFILE_CPU();
+    Reset();
+    const char* text = json;
+    if (inSitu)
+    {
+        _buffer.Resize(length + 1, false);
+        Platform::MemoryCopy(_buffer.Get(), json, length);
+        _buffer[length] = 0;
+        text = _buffer.Get();
+    }
+
+    // Find the items of the array to parse in parallel
+    Array<int32> items;
+    int32 arrayStart = 0, arrayEnd = 0;
+    if (arrayMember && length >= JSON_PARSER_PARALLEL_MIN_ITEMS * 4 && JobSystem::GetThreadsCount() > 1)
+    {
+        PROFILE_CPU_NAMED("Scan");
+        if (FindArrayItems(text, length, arrayMember, arrayStart, arrayEnd, items))
+            items.Clear();
+    }
+    if (items.Count() < JSON_PARSER_PARALLEL_MIN_ITEMS)
+    {
+        // Parse the whole text at once
+        if (inSitu)
+            document.ParseInsitu(_buffer.Get());
+        else
+            document.Parse(json, length);
+        if (document.HasParseError())
+        {
+            _error = document.GetParseError();
+            _errorOffset = document.GetErrorOffset();
+            return true;
+        }
+        return false;
+    }
+
+    // Parse the rest of the document with an empty array
+    const int32 suffixLength = length - arrayEnd;
+    _rootBuffer.Resize(arrayStart + 1 + suffixLength + 1, false);
+    Platform::MemoryCopy(_rootBuffer.Get(), text, arrayStart + 1);
+    Platform::MemoryCopy(_rootBuffer.Get() + arrayStart + 1, text + arrayEnd, suffixLength);
+    _rootBuffer.Last() = 0;
+    if (inSitu)
+        document.ParseInsitu(_rootBuffer.Get());
+    else
+        document.Parse(_rootBuffer.Get());
+    if (document.HasParseError())
+    {
+        _error = document.GetParseError();
+        _errorOffset = document.GetErrorOffset();
+        if (_errorOffset > (size_t)arrayStart)
+            _errorOffset += arrayEnd - arrayStart - 1;
+        return true;
+    }
+    auto member = document.FindMember(arrayMember);
+    if (member == document.MemberEnd() || !member->value.IsArray())
+    {
+        _error = rapidjson::kParseErrorUnspecificSyntaxError;
+        _errorOffset = arrayStart;
+        return true;
+    }
+
+    // Allocate the array items upfront so jobs can move the parsed values directly into them
+    const int32 itemsCount = items.Count();
+    auto& array = member->value;
+    auto& allocator = document.GetAllocator();
+    array.Reserve(itemsCount, allocator);
+    for (int32 i = 0; i < itemsCount; i++)
+    {
+        rapidjson_flax::Value value;
+        array.PushBack(value, allocator);
+    }
+
+    // Parse the array items in parallel (each job uses a separate allocator for its batch of items)
+    const int32 jobCount = Math::Min(JobSystem::GetThreadsCount() * 4, Math::DivideAndRoundUp(itemsCount, JSON_PARSER_JOB_MIN_ITEMS));
+    const int32 itemsPerJob = Math::DivideAndRoundUp(itemsCount, jobCount);
+    Array<JobError> errors;
+    errors.Resize(jobCount);
+    _allocators.Resize(jobCount);
+    for (int32 i = 0; i < jobCount; i++)
+    {
+        _allocators[i] = New<PoolAllocator>();
+        errors[i].Code = rapidjson::kParseErrorNone;
+    }
+    JobSystem::Execute([&](int32 jobIndex)
+    {
+        PROFILE_CPU_NAMED("Json.ParseItems");
+        Document item(_allocators[jobIndex]);
+        const int32 end = Math::Min((jobIndex + 1) * itemsPerJob, itemsCount);
+        for (int32 i = jobIndex * itemsPerJob; i < end; i++)
+        {
+            const int32 offset = items[i];
+            if (inSitu)
+                item.ParseInsitu<rapidjson::kParseStopWhenDoneFlag>(_buffer.Get() + offset);
+            else
+                item.Parse<rapidjson::kParseStopWhenDoneFlag>(json + offset);
+            if (item.HasParseError())
+            {
+                errors[jobIndex].Code = item.GetParseError();
+                errors[jobIndex].Offset = offset + item.GetErrorOffset();
+                break;
+            }
+            array[i] = static_cast<rapidjson_flax::Value&>(item);
+        }
+    }, jobCount);
+    for (const JobError& error : errors)
+    {
+        if (error.Code != rapidjson::kParseErrorNone)
+        {
+            _error = error.Code;
+            _errorOffset = error.Offset;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JsonParser::ParseBinary(Document& document, const byte* data, int32 length)
+{
+    PROFILE_CPU();
+    Reset();
+    document.SetNull();
+    if (!IsBinary(data, length))
+    {
+        _error = rapidjson::kParseErrorUnspecificSyntaxError;
+        return true;
+    }
+    MemoryReadStream stream(data + sizeof(uint32) * 2, length - sizeof(uint32) * 2);
+
+    // Load the document (skips the items of indexed arrays)
+    Array<IndexedArray> indexedArrays;
+    if (ReadValue(stream, document, document.GetAllocator(), &indexedArrays))
+    {
+        _error = rapidjson::kParseErrorUnspecificSyntaxError;
+        _errorOffset = stream.GetPosition();
+        return true;
+    }
+
+    // Load the items of indexed arrays in parallel (each job uses a separate allocator for its batch of items)
+    for (const IndexedArray& indexed : indexedArrays)
+    {
+        auto member = document.FindMember(rapidjson_flax::Value(rapidjson::StringRef(indexed.Name, indexed.NameLength)));
+        if (member == document.MemberEnd() || indexed.Count == 0)
+            continue;
+        auto& array = member->value;
+        const int32 itemsCount = (int32)indexed.Count;
+        const int32 jobCount = JobSystem::GetThreadsCount() > 1 ? Math::Min(JobSystem::GetThreadsCount() * 4, Math::DivideAndRoundUp(itemsCount, JSON_PARSER_JOB_MIN_ITEMS)) : 1;
+        const int32 itemsPerJob = Math::DivideAndRoundUp(itemsCount, jobCount);
+        const int32 allocatorsStart = _allocators.Count();
+        for (int32 i = 0; i < jobCount; i++)
+            _allocators.Add(New<PoolAllocator>());
+        Array<int32> errors;
+        errors.Resize(jobCount);
+        JobSystem::Execute([&](int32 jobIndex)
+        {
+            PROFILE_CPU_NAMED("Json.LoadItems");
+            PoolAllocator& allocator = *_allocators[allocatorsStart + jobIndex];
+            errors[jobIndex] = -1;
+            const int32 end = Math::Min((jobIndex + 1) * itemsPerJob, itemsCount);
+            for (int32 i = jobIndex * itemsPerJob; i < end; i++)
+            {
+                const uint32 offset = indexed.Offsets[i];
+                MemoryReadStream itemStream(indexed.Items + offset, indexed.ItemsSize - offset);
+                if (ReadValue(itemStream, array[i], allocator, nullptr))
+                {
+                    errors[jobIndex] = (int32)(indexed.Items - data) + (int32)(offset + itemStream.GetPosition());
+                    break;
+                }
+            }
+        }, jobCount);
+        for (const int32 error : errors)
+        {
+            if (error != -1)
+            {
+                _error = rapidjson::kParseErrorUnspecificSyntaxError;
+                _errorOffset = error;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void JsonParser::WriteBinary(const rapidjson_flax::Value& document, MemoryWriteStream& stream, const char* arrayMember)
+{
+    PROFILE_CPU();
+    stream.WriteUint32(JSON_BINARY_MAGIC);
+    stream.WriteUint32(JSON_BINARY_VERSION);
+    WriteValue(stream, document, arrayMember);
+}
+
+bool JsonParser::IsBinary(const byte* data, int32 length)
+{
+    return length >= (int32)sizeof(uint32) * 2 && ((const uint32*)data)[0] == JSON_BINARY_MAGIC && ((const uint32*)data)[1] == JSON_BINARY_VERSION;
+}
+
+void JsonParser::Clear()
+{
+    for (PoolAllocator* allocator : _allocators)
+        Delete(allocator);
+    _allocators.SetCapacity(0, false);
+    _rootBuffer.SetCapacity(0, false);
+    _buffer.SetCapacity(0, false);
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Json.h"
+#include "Engine/Core/Collections/Array.h"
+
+class MemoryWriteStream;
+
+/// <summary>
+/// Json document parser that can parse the items of a large root array member (eg. scene objects list) in parallel on the job system threads. Supports loading documents from the compact binary format too.
+/// </summary>
+/// <remarks>
+/// The parsed array items are allocated from the parser memory, thus parser has to be kept alive as long as the parsed document is in use.
+/// In-situ mode decodes strings within the parser-owned copy of the text which avoids strings allocation and copy but then all string values (and any values copied from them without an allocator) reference the parser memory.
+/// </remarks>
+class FLAXENGINE_API JsonParser
+{
+public:
+    typedef rapidjson_flax::Document Document;
+    typedef rapidjson::MemoryPoolAllocator<rapidjson_flax::FlaxAllocator> PoolAllocator;
+
+private:
+    Array<char> _buffer;
+    Array<char> _rootBuffer;
+    Array<PoolAllocator*> _allocators;
+    rapidjson::ParseErrorCode _error = rapidjson::kParseErrorNone;
+    size_t _errorOffset = 0;
+
+    void Reset();
+
+public:
+    JsonParser() = default;
+    JsonParser(const JsonParser&) = delete;
+    JsonParser& operator=(const JsonParser&) = delete;
+    ~JsonParser();
+
+public:
+    /// <summary>
+    /// Gets the last parsing error code.
+    /// </summary>
+    FORCE_INLINE rapidjson::ParseErrorCode GetParseError() const
+    {
+        return _error;
+    }
+
+    /// <summary>
+    /// Gets the last parsing error offset (in bytes, from the start of the text).
+    /// </summary>
+    FORCE_INLINE size_t GetErrorOffset() const
+    {
+        return _errorOffset;
+    }
+
+    /// <summary>
+    /// Gets the amount of memory allocated by the parser (excluding the document allocator).
+    /// </summary>
+    uint64 GetMemoryUsage() const;
+
+public:
+    /// <summary>
+    /// Parses the Json text into the document. Reuses the parser memory from the previous parsing.
+    /// </summary>
+    /// <param name="document">The output document.</param>
+    /// <param name="json">The Json text. Doesn't need to be null-terminated.</param>
+    /// <param name="length">The Json text length (in bytes).</param>
+    /// <param name="arrayMember">The name of the root object member with an array to parse its items in parallel (eg. Data). Use null to parse the whole text at once.</param>
+    /// <param name="inSitu">True if use in-situ parsing of the text copy owned by the parser (strings are not allocated but reference the parser memory), otherwise strings are copied into the document.</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    bool Parse(Document& document, const char* json, int32 length, const char* arrayMember = nullptr, bool inSitu = false);
+
+    /// <summary>
+    /// Loads the document from the binary format (see <see cref="WriteBinary"/>) without any text parsing. Indexed arrays are loaded in parallel on the job system threads. Reuses the parser memory from the previous parsing.
+    /// </summary>
+    /// <param name="document">The output document.</param>
+    /// <param name="data">The binary data.</param>
+    /// <param name="length">The binary data length (in bytes).</param>
+    /// <returns>True if failed, otherwise false.</returns>
+    bool ParseBinary(Document& document, const byte* data, int32 length);
+
+    /// <summary>
+    /// Writes the Json document into the compact binary format that can be loaded without text parsing (used by cooked assets).
+    /// </summary>
+    /// <param name="document">The document to write.</param>
+    /// <param name="stream">The output stream.</param>
+    /// <param name="arrayMember">The name of the root object member with an array to index its items for parallel loading (eg. Data). Use null to skip it.</param>
+    static void WriteBinary(const rapidjson_flax::Value& document, MemoryWriteStream& stream, const char* arrayMember = nullptr);
+
+    /// <summary>
+    /// Checks if the data is in the binary format (see <see cref="WriteBinary"/>).
+    /// </summary>
+    /// <param name="data">The data.</param>
+    /// <param name="length">The data length (in bytes).</param>
+    /// <returns>True if data is binary Json document, otherwise false.</returns>
+    static bool IsBinary(const byte* data, int32 length);
+
+    /// <summary>
+    /// Releases the parser memory. Values parsed before become invalid.
+    /// </summary>
+    void Clear();
+};
@@ -5,6 +5,7 @@
 #include "Engine/Core/Types/String.h"
 #include "Engine/Core/Types/Guid.h"
 #include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/HashSet.h"
 #include "Engine/Graphics/Shaders/Config.h"
 
 class MemoryWriteStream;
@@ -63,6 +64,11 @@ struct FLAXENGINE_API ShaderCompilationOptions
     /// </summary>
     Array<ShaderMacro> Macros;
 
+    /// <summary>
+    /// Optional set of the used shader function permutations (formatted as 'FunctionName:PermutationIndex'). Other permutations of graphics shaders (except the first one of each function) are stripped from the output. Null to compile all permutations.
+    /// </summary>
+    const HashSet<StringAnsi>* UsedPermutations = nullptr;
+
 public:
 
     /// <summary>
@@ -223,6 +223,13 @@ bool ShaderCompilerD3D::CompileShader(ShaderFunctionMeta& meta, WritePermutation
     // Compile all shader function permutations
     for (int32 permutationIndex = 0; permutationIndex < meta.Permutations.Count(); permutationIndex++)
     {
+        if (IsPermutationStripped(meta, permutationIndex))
+        {
+            // Write an empty placeholder for the unused permutation
+            if (WriteShaderFunctionPermutation(_context, meta, permutationIndex, ShaderBindings(), nullptr, 0))
+                return true;
+            continue;
+        }
         _macros.Clear();
 
         // Get function permutation macros
@@ -187,6 +187,13 @@ bool ShaderCompilerDX::CompileShader(ShaderFunctionMeta& meta, WritePermutationD
     // Compile all shader function permutations
     for (int32 permutationIndex = 0; permutationIndex < meta.Permutations.Count(); permutationIndex++)
     {
+        if (IsPermutationStripped(meta, permutationIndex))
+        {
+            // Write an empty placeholder for the unused permutation
+            if (WriteShaderFunctionPermutation(_context, meta, permutationIndex, ShaderBindings(), nullptr, 0))
+                return true;
+            continue;
+        }
         _macros.Clear();
 
         // Get function permutation macros
@@ -368,6 +375,8 @@ bool ShaderCompilerDX::CompileShader(ShaderFunctionMeta& meta, WritePermutationD
         {
             D3D12_SHADER_INPUT_BIND_DESC resDesc;
             shaderReflection->GetResourceBindingDesc(i, &resDesc);
+            if (resDesc.Space != 0)
+                continue; // Skip bindless resources (global descriptors table)
             switch (resDesc.Type)
             {
                 // Sampler
@@ -428,6 +437,7 @@ bool ShaderCompilerDX::OnCompileBegin()
         return true;
 
     _globalMacros.Add({ "DIRECTX", "1" });
+    _globalMacros.Add({ "CAN_USE_BINDLESS", "1" });
 
     return false;
 }
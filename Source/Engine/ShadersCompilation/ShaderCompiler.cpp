@@ -252,6 +252,15 @@ bool ShaderCompiler::CompileShaders()
     return false;
 }
 
+bool ShaderCompiler::IsPermutationStripped(const ShaderFunctionMeta& meta, int32 permutationIndex) const
+{
+    const auto usedPermutations = _context->Options->UsedPermutations;
+    if (!usedPermutations || permutationIndex == 0 || meta.GetStage() == ShaderStage::Compute)
+        return false;
+    const StringAnsi key = StringAnsi::Format("{}:{}", meta.Name, permutationIndex);
+    return !usedPermutations->Contains(key);
+}
+
 bool ShaderCompiler::OnCompileBegin()
 {
     // Setup global macros
@@ -92,6 +92,11 @@ class ShaderCompiler
 
     bool CompileShaders();
 
+    /// <summary>
+    /// Checks if the given shader function permutation is unused and should be stripped from the output (written as an empty placeholder).
+    /// </summary>
+    bool IsPermutationStripped(const ShaderFunctionMeta& meta, int32 permutationIndex) const;
+
     virtual bool OnCompileBegin();
     virtual bool OnCompileEnd();
 
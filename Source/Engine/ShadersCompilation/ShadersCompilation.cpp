@@ -18,6 +18,10 @@
 #include "Engine/Graphics/Shaders/GPUShader.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Serialization/MemoryReadStream.h"
+#include "Engine/Serialization/MemoryWriteStream.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Platform/FileSystem.h"
+#include "Engine/Utilities/Crc.h"
 #include "Engine/Content/Asset.h"
 #include "Engine/Content/Content.h"
 #include "Engine/Content/Assets/Shader.h"
@@ -27,12 +31,12 @@
 #define COMPILE_WITH_ASSETS_IMPORTER 1 // Hack to use shaders importing in this module
 #include "Engine/ContentImporters/AssetsImportingManager.h"
 #include "Engine/Platform/FileSystemWatcher.h"
-#include "Engine/Platform/FileSystem.h"
-#include "Engine/Platform/File.h"
 #include "Engine/Engine/Globals.h"
+#include "Engine/Engine/CommandLine.h"
 #include "Editor/Editor.h"
 #include "Editor/ProjectInfo.h"
 #endif
+#include "FlaxEngine.Gen.h"
 #if COMPILE_WITH_D3D_SHADER_COMPILER
 #include "DirectX/ShaderCompilerD3D.h"
 #endif
@@ -49,12 +53,154 @@
 #include "Platforms/PS5/Engine/ShaderCompilerPS5/ShaderCompilerPS5.h"
 #endif
 
+// Version of the shared shaders cache entries format (increment to invalidate all entries)
+#define SHADERS_SHARED_CACHE_VERSION 1
+
 namespace ShadersCompilationImpl
 {
     CriticalSection Locker;
     Array<ShaderCompiler*> Compilers;
     Array<ShaderCompiler*> ReadyCompilers;
 
+    uint64 HashBytes(const void* data, int32 length, uint64 hash)
+    {
+        // FNV-1a
+        const byte* bytes = (const byte*)data;
+        for (int32 i = 0; i < length; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    uint64 HashString(const char* str, uint64 hash)
+    {
+        if (str)
+            hash = HashBytes(str, StringUtils::Length(str), hash);
+        return HashBytes("", 1, hash);
+    }
+
+    uint64 GetSharedCacheKey(const ShaderCompilationOptions& options)
+    {
+        // Everything that affects the compiled shader except the included files (these are validated on cache entry load)
+        const int32 versions[] = { SHADERS_SHARED_CACHE_VERSION, GPU_SHADER_CACHE_VERSION, FLAXENGINE_VERSION_BUILD, (int32)options.Profile };
+        uint64 hash = HashBytes(versions, sizeof(versions), 14695981039346656037ull);
+        const bool flags[] = { options.NoOptimize, options.GenerateDebugData, options.TreatWarningsAsErrors };
+        hash = HashBytes(flags, sizeof(flags), hash);
+        for (const ShaderMacro& macro : options.Macros)
+        {
+            hash = HashString(macro.Name, hash);
+            hash = HashString(macro.Definition, hash);
+        }
+        return HashBytes(options.Source, (int32)options.SourceLength, hash);
+    }
+
+    String GetSharedCachePath(const ShaderCompilationOptions& options, uint64 key)
+    {
+        return ShadersCompilation::SharedCacheFolder / ::ToString(options.Profile) / String::Format(TEXT("{0:016x}.cache"), key);
+    }
+
+    bool GetIncludeHash(const String& compactPath, uint32& hash)
+    {
+        Array<byte> data;
+        if (File::ReadAllBytes(ShadersCompilation::ResolveShaderPath(compactPath), data))
+            return true;
+        hash = Crc::MemCrc32(data.Get(), data.Count());
+        return false;
+    }
+
+    bool LoadFromSharedCache(const ShaderCompilationOptions& options, uint64 key)
+    {
+        PROFILE_CPU();
+        const String path = GetSharedCachePath(options, key);
+        Array<byte> data;
+        if (!FileSystem::FileExists(path) || File::ReadAllBytes(path, data))
+            return true;
+        MemoryReadStream stream(data.Get(), data.Count());
+        int32 version;
+        stream.ReadInt32(&version);
+        if (version != SHADERS_SHARED_CACHE_VERSION)
+            return true;
+
+        // Validate included files contents
+        int32 includesCount;
+        stream.ReadInt32(&includesCount);
+        Array<String> includes;
+        includes.Resize(includesCount);
+        for (int32 i = 0; i < includesCount; i++)
+        {
+            uint32 entryHash, hash;
+            stream.ReadString(&includes[i], 11);
+            stream.ReadUint32(&entryHash);
+            if (GetIncludeHash(includes[i], hash) || hash != entryHash)
+                return true;
+        }
+
+        // Copy compiled shader data
+        int32 dataSize;
+        stream.ReadInt32(&dataSize);
+        if (dataSize <= 0 || dataSize > (int32)(stream.GetLength() - stream.GetPosition()))
+            return true;
+        auto output = options.Output;
+        output->WriteBytes(stream.GetPositionHandle(), dataSize);
+
+        // Write included files with local modification dates (see ShaderCompiler::Compile)
+        output->WriteInt32(includesCount);
+        for (const String& include : includes)
+        {
+            output->WriteString(include, 11);
+            output->Write(FileSystem::GetFileLastEditTime(ShadersCompilation::ResolveShaderPath(include)));
+        }
+        return false;
+    }
+
+    void SaveToSharedCache(const ShaderCompilationOptions& options, uint64 key)
+    {
+        PROFILE_CPU();
+        auto output = options.Output;
+        MemoryReadStream stream(output->GetHandle(), output->GetPosition());
+        int32 version, additionalDataStart;
+        stream.ReadInt32(&version);
+        stream.ReadInt32(&additionalDataStart);
+        if (version != GPU_SHADER_CACHE_VERSION)
+            return;
+        stream.SetPosition(additionalDataStart);
+
+        // Compiled shader data (includes get stored with contents hashes instead of local modification dates)
+        MemoryWriteStream entry(output->GetPosition());
+        entry.WriteInt32(SHADERS_SHARED_CACHE_VERSION);
+        int32 includesCount;
+        stream.ReadInt32(&includesCount);
+        entry.WriteInt32(includesCount);
+        for (int32 i = 0; i < includesCount; i++)
+        {
+            String include;
+            DateTime lastEditTime;
+            uint32 hash;
+            stream.ReadString(&include, 11);
+            stream.Read(lastEditTime);
+            if (GetIncludeHash(include, hash))
+                return;
+            entry.WriteString(include, 11);
+            entry.WriteUint32(hash);
+        }
+        entry.WriteInt32(additionalDataStart);
+        entry.WriteBytes(output->GetHandle(), additionalDataStart);
+
+        // Write to the temporary file first to prevent other machines from reading incomplete data
+        const String path = GetSharedCachePath(options, key);
+        const String tmpPath = path + TEXT(".") + Guid::New().ToString(Guid::FormatType::N);
+        const String folder = StringUtils::GetDirectoryName(path);
+        if ((!FileSystem::DirectoryExists(folder) && FileSystem::CreateDirectory(folder)) ||
+            File::WriteAllBytes(tmpPath, entry.GetHandle(), entry.GetPosition()) ||
+            FileSystem::MoveFile(path, tmpPath, true))
+        {
+            LOG(Warning, "Failed to save shader '{0}' to shared cache '{1}'", options.TargetName, path);
+            FileSystem::DeleteFile(tmpPath);
+        }
+    }
+
 #if USE_EDITOR
     const ProjectInfo* FindProjectByName(const ProjectInfo* project, HashSet<const ProjectInfo*>& projects, const StringView& projectName)
     {
@@ -115,6 +261,8 @@ class ShadersCompilationService : public EngineService
 
 ShadersCompilationService ShadersCompilationServiceInstance;
 
+String ShadersCompilation::SharedCacheFolder;
+
 bool ShadersCompilation::Compile(ShaderCompilationOptions& options)
 {
     PROFILE_CPU_NAMED("Shader.Compile");
@@ -148,6 +296,15 @@ bool ShadersCompilation::Compile(ShaderCompilationOptions& options)
     const DateTime startTime = DateTime::NowUTC();
     const FeatureLevel featureLevel = RenderTools::GetFeatureLevel(options.Profile);
 
+    // Try to reuse shader compiled by other machine (or earlier by this one)
+    const bool useSharedCache = SharedCacheFolder.HasChars() && !options.GenerateDebugData && options.Output->GetPosition() == 0;
+    const uint64 sharedCacheKey = useSharedCache ? GetSharedCacheKey(options) : 0;
+    if (useSharedCache && !LoadFromSharedCache(options, sharedCacheKey))
+    {
+        LOG(Info, "Shader compilation '{0}' loaded from shared cache (profile: {1})", options.TargetName, ::ToString(options.Profile));
+        return false;
+    }
+
     // Process shader source to collect metadata
     ShaderMeta meta;
     if (ShaderProcessing::Parser::Process(options.TargetName, options.Source, options.SourceLength, options.Macros, featureLevel, &meta))
@@ -203,6 +360,8 @@ bool ShadersCompilation::Compile(ShaderCompilationOptions& options)
     else
     {
         // Success
+        if (useSharedCache)
+            SaveToSharedCache(options, sharedCacheKey);
         const DateTime endTime = DateTime::NowUTC();
         LOG(Info, "Shader compilation '{0}' succeed in {1} ms (profile: {2})", options.TargetName, Math::CeilToInt(static_cast<float>((endTime - startTime).GetTotalMilliseconds())), ::ToString(options.Profile));
     }
@@ -572,6 +731,11 @@ namespace
 
 bool ShadersCompilationService::Init()
 {
+#if USE_EDITOR
+    if (CommandLine::Options.ShaderCache.HasValue())
+        ShadersCompilation::SharedCacheFolder = CommandLine::Options.ShaderCache.GetValue();
+#endif
+
 #if USE_EDITOR
     // Initialize automatic shaders importing and reloading for all loaded projects (game, engine, plugins)
     HashSet<const ProjectInfo*> projects;
@@ -13,6 +13,12 @@ class Asset;
 /// </summary>
 class FLAXENGINE_API ShadersCompilation
 {
+public:
+    /// <summary>
+    /// The shared shaders cache folder (eg. network directory). Compiled shaders are stored in it using the content hash of the source code, macros and compilation options so other machines don't compile the same shader twice. Empty if unused (default). Can be specified with -shadercache command line argument.
+    /// </summary>
+    static String SharedCacheFolder;
+
 public:
     /// <summary>
     /// Compiles the shader.
@@ -505,6 +505,13 @@ bool ShaderCompilerVulkan::CompileShader(ShaderFunctionMeta& meta, WritePermutat
     // Compile all shader function permutations
     for (int32 permutationIndex = 0; permutationIndex < meta.Permutations.Count(); permutationIndex++)
     {
+        if (IsPermutationStripped(meta, permutationIndex))
+        {
+            // Write an empty placeholder for the unused permutation
+            if (WriteShaderFunctionPermutation(_context, meta, permutationIndex, ShaderBindings(), nullptr, 0))
+                return true;
+            continue;
+        }
 #if PRINT_DESCRIPTORS
         LOG(Warning, "VULKAN SHADER {0}: {1}[{2}]", _context->Options->TargetName, String(meta.Name), permutationIndex);
 #endif
@@ -66,6 +66,9 @@ void ShadowsOfMordor::Builder::generateHemispheres()
     float normalSimilarityMin = Math::Lerp(0.8f, 0.95f, normalizedQuality);
     int32 maxTexelsDistance = static_cast<int32>(Math::Lerp(2.0f, 1.0f, normalizedQuality));
     int32 atlasSize = static_cast<int32>(settings.AtlasSize);
+    const int32 coarseBlocksPerRow = (atlasSize + HEMISPHERES_COARSE_BLOCK_SIZE - 1) / HEMISPHERES_COARSE_BLOCK_SIZE;
+    Array<bool> coarseBlocks;
+    Array<HemisphereData> fineHemispheres;
 
     // Process every lightmap
     for (_workerStagePosition0 = 0; _workerStagePosition0 < lightmapsCount; _workerStagePosition0++)
@@ -74,6 +77,10 @@ void ShadowsOfMordor::Builder::generateHemispheres()
         auto& lightmapEntry = scene->Lightmaps[_workerStagePosition0];
         lightmapEntry.Hemispheres.Clear();
         lightmapEntry.Hemispheres.EnsureCapacity(Math::Square(atlasSize / 2));
+        lightmapEntry.CoarseHemispheresCount = 0;
+        coarseBlocks.Resize(coarseBlocksPerRow * coarseBlocksPerRow, false);
+        Platform::MemoryClear(coarseBlocks.Get(), coarseBlocks.Count() * sizeof(bool));
+        fineHemispheres.Clear();
         Float3 position, normal;
 
         // Fill cache
@@ -166,10 +173,21 @@ void ShadowsOfMordor::Builder::generateHemispheres()
                 data.Normal = normal;
                 data.TexelX = texelX;
                 data.TexelY = texelY;
-                lightmapEntry.Hemispheres.Add(data);
                 hemispheresCount++;
+
+                // The first hemisphere in each texels block goes into the coarse set (rendered at the list start), the other ones refine it
+                bool& coarseBlock = coarseBlocks[(texelY / HEMISPHERES_COARSE_BLOCK_SIZE) * coarseBlocksPerRow + texelX / HEMISPHERES_COARSE_BLOCK_SIZE];
+                if (coarseBlock)
+                {
+                    fineHemispheres.Add(data);
+                    continue;
+                }
+                coarseBlock = true;
+                lightmapEntry.Hemispheres.Add(data);
             }
         }
+        lightmapEntry.CoarseHemispheresCount = lightmapEntry.Hemispheres.Count();
+        lightmapEntry.Hemispheres.Add(fineHemispheres);
 
         // Progress Point
         reportProgress(BuildProgressStep::GenerateHemispheresCache, (float)_workerStagePosition0 / lightmapsCount);
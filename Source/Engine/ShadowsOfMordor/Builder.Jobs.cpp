@@ -336,6 +336,12 @@ void ShadowsOfMordor::Builder::onJobRender(GPUContext* context)
         }
 
         // Prepare
+#if HEMISPHERES_PROGRESSIVE_BOUNCES
+        // Intermediate bounces provide only the low-frequency indirect lighting for the next bounce so render them at the coarse resolution (post-process blur fills the gaps)
+        const int32 hemispheresCount = _giBounceRunningIndex + 1 < _bounceCount ? lightmapEntry.CoarseHemispheresCount : lightmapEntry.Hemispheres.Count();
+#else
+        const int32 hemispheresCount = lightmapEntry.Hemispheres.Count();
+#endif
         int32 hemispheresToRenderLeft = _hemispheresPerJob;
         int32 hemispheresToRenderBeforeSyncLeft = hemispheresToRenderLeft > 10 ? HEMISPHERES_PER_GPU_FLUSH : HEMISPHERES_PER_JOB_MAX;
         Matrix view, projection;
@@ -347,7 +353,7 @@ void ShadowsOfMordor::Builder::onJobRender(GPUContext* context)
 #endif
 
         // Render hemispheres
-        for (; _workerStagePosition1 < lightmapEntry.Hemispheres.Count(); _workerStagePosition1++)
+        for (; _workerStagePosition1 < hemispheresCount; _workerStagePosition1++)
         {
             if (hemispheresToRenderLeft == 0)
                 break;
@@ -435,7 +441,7 @@ void ShadowsOfMordor::Builder::onJobRender(GPUContext* context)
 #endif
 
         // Report progress
-        float hemispheresProgress = static_cast<float>(_workerStagePosition1) / Math::Max(lightmapEntry.Hemispheres.Count(), 1);
+        float hemispheresProgress = static_cast<float>(_workerStagePosition1) / Math::Max(hemispheresCount, 1);
         float lightmapsProgress = static_cast<float>(_workerStagePosition0 + hemispheresProgress) / scene->Lightmaps.Count();
         float bouncesProgress = static_cast<float>(_giBounceRunningIndex) / _bounceCount;
         reportProgress(BuildProgressStep::RenderHemispheres, lightmapsProgress / _bounceCount + bouncesProgress);
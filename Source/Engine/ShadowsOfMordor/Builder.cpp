@@ -190,7 +190,7 @@ bool ShadowsOfMordor::Builder::RestoreState()
     auto stream = FileReadStream::Open(path);
     int32 version;
     stream->ReadInt32(&version);
-    if (version != 1)
+    if (version != 2)
     {
         LOG(Error, "Invalid version.");
         Delete(stream);
@@ -233,7 +233,7 @@ void ShadowsOfMordor::Builder::saveState()
     }
 
     // Format version
-    stream->WriteInt32(1);
+    stream->WriteInt32(2);
 
     // Scenes ids
     stream->WriteInt32(_scenes.Count());
@@ -265,6 +265,7 @@ void ShadowsOfMordor::Builder::saveState()
 
             // Hemispheres
             stream->WriteInt32(lightmap.Hemispheres.Count());
+            stream->WriteInt32(lightmap.CoarseHemispheresCount);
             stream->WriteBytes(lightmap.Hemispheres.Get(), lightmap.Hemispheres.Count() * sizeof(HemisphereData));
 
             // Lightmap Data
@@ -308,7 +309,7 @@ bool ShadowsOfMordor::Builder::loadState()
     auto stream = FileReadStream::Open(path);
     int32 version;
     stream->ReadInt32(&version);
-    if (version != 1)
+    if (version != 2)
     {
         LOG(Error, "Invalid version.");
         Delete(stream);
@@ -366,6 +367,7 @@ bool ShadowsOfMordor::Builder::loadState()
             // Hemispheres
             int32 hemispheresCount;
             stream->ReadInt32(&hemispheresCount);
+            stream->ReadInt32(&lightmap.CoarseHemispheresCount);
             lightmap.Hemispheres.Resize(hemispheresCount);
             stream->ReadBytes(lightmap.Hemispheres.Get(), lightmap.Hemispheres.Count() * sizeof(HemisphereData));
 
@@ -120,6 +120,8 @@ namespace ShadowsOfMordor
 
             Array<int32> Entries;
             Array<HemisphereData> Hemispheres;
+            // Amount of the hemispheres (from the list start) that cover the lightmap at the coarse resolution (one per block of HEMISPHERES_COARSE_BLOCK_SIZE texels), used by the intermediate GI bounces
+            int32 CoarseHemispheresCount = 0;
             GPUBuffer* LightmapData = nullptr;
 #if HEMISPHERES_BAKE_STATE_SAVE
             // Restored data for the lightmap from the loaded state (copied to the LightmapData on first hemispheres render job)
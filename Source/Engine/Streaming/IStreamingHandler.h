@@ -50,4 +50,15 @@ class FLAXENGINE_API IStreamingHandler
     {
         return currentResidency != targetResidency;
     }
+
+    /// <summary>
+    /// Calculates the resource eviction priority used when the GPU memory usage exceeds the device memory budget. Resources with the lowest priority get their residency lowered first.
+    /// </summary>
+    /// <param name="resource">The resource.</param>
+    /// <param name="currentTime">The current platform time (seconds).</param>
+    /// <returns>The eviction priority (0-1, higher values are more important), or negative value if resource cannot be evicted.</returns>
+    virtual float CalculateEvictionPriority(StreamableResource* resource, double currentTime)
+    {
+        return -1.0f;
+    }
 };
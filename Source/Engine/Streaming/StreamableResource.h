@@ -18,6 +18,8 @@ class FLAXENGINE_API StreamableResource
     StreamingGroup* _group;
     bool _isDynamic, _isStreaming;
     float _streamingQuality;
+    mutable float _lastUsedScreenSize;
+    mutable double _lastUsedTime;
 
     StreamableResource(StreamingGroup* group);
     ~StreamableResource();
@@ -56,6 +58,48 @@ class FLAXENGINE_API StreamableResource
         return Streaming.TargetResidency;
     }
 
+    /// <summary>
+    /// Gets resource streaming priority (normalized to range 0-1, higher values are more important). Based on how far the current residency is from the target one, resources without any data loaded have the highest priority.
+    /// </summary>
+    FORCE_INLINE float GetStreamingPriority() const
+    {
+        return Streaming.Priority;
+    }
+
+    /// <summary>
+    /// Gets the last time (platform time in seconds) when the resource was marked as used for rendering. Negative if not used at all.
+    /// </summary>
+    FORCE_INLINE double GetLastUsedTime() const
+    {
+        return _lastUsedTime;
+    }
+
+    /// <summary>
+    /// Gets the largest squared screen radius (normalized screen units) of the object that used the resource during the last frame it was used.
+    /// </summary>
+    FORCE_INLINE float GetLastUsedScreenSize() const
+    {
+        return _lastUsedScreenSize;
+    }
+
+    /// <summary>
+    /// Marks the resource as used for rendering. Used to pick the eviction candidates when running out of the GPU memory budget.
+    /// </summary>
+    /// <param name="screenRadiusSquared">The squared screen radius of the object using this resource (normalized screen units).</param>
+    /// <param name="time">The current frame time (platform time in seconds).</param>
+    FORCE_INLINE void MarkUsed(float screenRadiusSquared, double time) const
+    {
+        if (_lastUsedTime != time)
+        {
+            _lastUsedTime = time;
+            _lastUsedScreenSize = screenRadiusSquared;
+        }
+        else if (screenRadiusSquared > _lastUsedScreenSize)
+        {
+            _lastUsedScreenSize = screenRadiusSquared;
+        }
+    }
+
     /// <summary>
     /// Gets a value indicating whether this resource has been allocated. 
     /// </summary>
@@ -106,6 +150,16 @@ class FLAXENGINE_API StreamableResource
     /// </summary>
     virtual void CancelStreamingTasks() = 0;
 
+    /// <summary>
+    /// Gets the estimated size of the resource data (in bytes) at the given residency level. Used by the streaming service to throttle the IO and upload bandwidth and to fit into the GPU memory budget.
+    /// </summary>
+    /// <param name="residency">The residency level.</param>
+    /// <returns>The amount of bytes (0 if unknown).</returns>
+    virtual uint64 GetResidencySize(int32 residency) const
+    {
+        return 0;
+    }
+
 public:
 
     struct StreamingCache
@@ -113,6 +167,8 @@ class FLAXENGINE_API StreamableResource
         double LastUpdateTime = 0.0;
         double TargetResidencyChangeTime = 0;
         int32 TargetResidency = 0;
+        float Priority = 0.25f;
+        int32 ResidencyLimit = MAX_int32;
         bool Error = false;
         SamplesBuffer<float, 5> QualitySamples;
     };
@@ -12,7 +12,9 @@
 #include "Engine/Threading/Task.h"
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Graphics/Textures/GPUSampler.h"
+#include "Engine/Graphics/Textures/StreamingTexture.h"
 #include "Engine/Serialization/Serialization.h"
+#include "Engine/Core/Collections/Sorting.h"
 
 namespace StreamingManagerImpl
 {
@@ -21,6 +23,165 @@ namespace StreamingManagerImpl
     Array<StreamableResource*> Resources;
     Array<GPUSampler*, InlinedAllocation<32>> TextureGroupSamplers;
     GPUSampler* FallbackSampler = nullptr;
+
+    struct InFlightTask
+    {
+        StreamableResource* Resource;
+        StreamingGroup* Group;
+        uint64 Size;
+        int32 Residency;
+    };
+
+    // Streaming tasks started by the service (used for IO budgets, guarded by ResourcesLock)
+    Array<InFlightTask> InFlight;
+    uint64 InFlightBytes = 0;
+    uint64 FrameStreamedBytes = 0;
+    int32 ThrottledResourcesCount = 0;
+
+    struct EvictionCandidate
+    {
+        StreamableResource* Resource;
+        float Priority;
+
+        bool operator<(const EvictionCandidate& other) const
+        {
+            return Priority < other.Priority;
+        }
+    };
+
+    // GPU memory budget state (guarded by ResourcesLock)
+    double LastMemoryBudgetUpdateTime = 0.0;
+    uint64 GPUMemoryUsage = 0;
+    uint64 GPUMemoryBudget = 0;
+    int32 EvictedResourcesCount = 0;
+    Array<EvictionCandidate> EvictionCandidates;
+
+    void ReleaseInFlight(int32 index)
+    {
+        InFlightBytes -= InFlight[index].Size;
+        InFlight.RemoveAtKeepOrder(index);
+    }
+
+    bool CanStartStreaming(StreamingGroup* group, uint64 size)
+    {
+        // Check group tasks limit
+        if (Streaming::MaxTasksPerGroup > 0)
+        {
+            int32 groupTasks = 0;
+            for (const InFlightTask& e : InFlight)
+            {
+                if (e.Group == group)
+                    groupTasks++;
+            }
+            if (groupTasks >= Streaming::MaxTasksPerGroup)
+                return false;
+        }
+
+        // Check bandwidth limits (always allow a single request to prevent starving resources larger than the budget)
+        const uint64 maxInFlight = (uint64)Streaming::MaxInFlightMB * 1024 * 1024;
+        if (maxInFlight != 0 && InFlightBytes != 0 && InFlightBytes + size > maxInFlight)
+            return false;
+        const uint64 maxPerFrame = (uint64)(Math::Max(Streaming::MaxUploadPerFrameMB, 0.0f) * (1024 * 1024));
+        if (maxPerFrame != 0 && FrameStreamedBytes != 0 && FrameStreamedBytes + size > maxPerFrame)
+            return false;
+        return true;
+    }
+
+    void UpdateMemoryBudget(double currentTime)
+    {
+        const double MemoryBudgetUpdateInterval = 0.5;
+        const int32 MaxEvictionsPerUpdate = 32;
+        const float MinQuality = 0.01f;
+        if (currentTime - LastMemoryBudgetUpdateTime < MemoryBudgetUpdateInterval)
+            return;
+        LastMemoryBudgetUpdateTime = currentTime;
+        PROFILE_CPU_NAMED("Streaming.MemoryBudget");
+
+        // Release textures that stayed unused in the reallocation pool for too long
+        StreamingTexture::FlushPool();
+
+        GPUMemoryUsage = GPUDevice::Instance->GetMemoryUsage();
+        GPUMemoryBudget = (uint64)((double)GPUDevice::Instance->GetMemoryBudget() * Math::Saturate(Streaming::GPUMemoryBudgetUsage));
+        bool overBudget = GPUMemoryBudget != 0 && GPUMemoryUsage > GPUMemoryBudget;
+        if (overBudget)
+        {
+            // Free the whole pool before evicting any resources
+            StreamingTexture::FlushPool(true);
+            GPUMemoryUsage = GPUDevice::Instance->GetMemoryUsage();
+            overBudget = GPUMemoryUsage > GPUMemoryBudget;
+        }
+        const uint64 relaxThreshold = GPUMemoryBudget - GPUMemoryBudget / 10; // Small hysteresis to prevent evict-load cycles
+
+        // Collect resources to evict (lower residency) or restore (after memory got released)
+        EvictedResourcesCount = 0;
+        EvictionCandidates.Clear();
+        for (auto resource : Resources)
+        {
+            auto& streaming = resource->Streaming;
+            const bool isEvicted = streaming.ResidencyLimit != MAX_int32;
+            if (isEvicted && GPUMemoryBudget == 0)
+            {
+                // Eviction has been disabled
+                streaming.ResidencyLimit = MAX_int32;
+                resource->RequestStreamingUpdate();
+                continue;
+            }
+            EvictedResourcesCount += isEvicted ? 1 : 0;
+            if (!resource->CanBeUpdated() || !resource->IsDynamic() || (!overBudget && !isEvicted))
+                continue;
+            auto handler = resource->GetGroup()->GetHandler();
+            const float priority = handler->CalculateEvictionPriority(resource, currentTime);
+            if (priority < 0.0f)
+                continue;
+            if (overBudget && resource->GetCurrentResidency() <= handler->CalculateResidency(resource, MinQuality))
+                continue;
+            EvictionCandidates.Add({ resource, priority });
+        }
+        if (EvictionCandidates.IsEmpty())
+            return;
+        Sorting::QuickSort(EvictionCandidates);
+
+        if (overBudget)
+        {
+            // Lower residency of the least important resources until the overflow gets covered
+            int64 overflow = (int64)(GPUMemoryUsage - GPUMemoryBudget);
+            for (int32 i = 0; i < EvictionCandidates.Count() && i < MaxEvictionsPerUpdate && overflow > 0; i++)
+            {
+                auto resource = EvictionCandidates[i].Resource;
+                const int32 residency = resource->GetCurrentResidency();
+                overflow -= (int64)(resource->GetResidencySize(residency) - resource->GetResidencySize(residency - 1));
+                if (resource->Streaming.ResidencyLimit == MAX_int32)
+                    EvictedResourcesCount++;
+                resource->Streaming.ResidencyLimit = residency - 1;
+                resource->RequestStreamingUpdate();
+            }
+        }
+        else if (GPUMemoryUsage < relaxThreshold)
+        {
+            // Restore residency of the most important resources that fit into the budget
+            int64 available = (int64)(relaxThreshold - GPUMemoryUsage);
+            for (int32 i = EvictionCandidates.Count() - 1, j = 0; i >= 0 && j < MaxEvictionsPerUpdate && available > 0; i--)
+            {
+                auto resource = EvictionCandidates[i].Resource;
+                const int32 limit = resource->Streaming.ResidencyLimit;
+                const int64 growth = (int64)(resource->GetResidencySize(limit + 1) - resource->GetResidencySize(limit));
+                if (growth > available)
+                    continue;
+                available -= growth;
+                j++;
+                if (limit + 1 >= resource->GetMaxResidency())
+                {
+                    resource->Streaming.ResidencyLimit = MAX_int32;
+                    EvictedResourcesCount--;
+                }
+                else
+                {
+                    resource->Streaming.ResidencyLimit = limit + 1;
+                }
+                resource->RequestStreamingUpdate();
+            }
+        }
+    }
 }
 
 using namespace StreamingManagerImpl;
@@ -52,10 +213,26 @@ namespace
 StreamingService StreamingServiceInstance;
 
 Array<TextureGroup, InlinedAllocation<32>> Streaming::TextureGroups;
+int32 Streaming::MaxInFlightMB = 256;
+float Streaming::MaxUploadPerFrameMB = 32.0f;
+int32 Streaming::MaxTasksPerGroup = 32;
+float Streaming::GPUMemoryBudgetUsage = 0.9f;
+bool Streaming::TextureFeedback = false;
+int32 Streaming::TextureFeedbackInterval = 8;
+bool Streaming::SparseTextures = false;
+int32 Streaming::TexturePoolSizeMB = 0;
 
 void StreamingSettings::Apply()
 {
     Streaming::TextureGroups = TextureGroups;
+    Streaming::MaxInFlightMB = MaxInFlightMB;
+    Streaming::MaxUploadPerFrameMB = MaxUploadPerFrameMB;
+    Streaming::MaxTasksPerGroup = MaxTasksPerGroup;
+    Streaming::GPUMemoryBudgetUsage = GPUMemoryBudgetUsage;
+    Streaming::TextureFeedback = TextureFeedback;
+    Streaming::TextureFeedbackInterval = TextureFeedbackInterval;
+    Streaming::SparseTextures = SparseTextures;
+    Streaming::TexturePoolSizeMB = TexturePoolSizeMB;
     SAFE_DELETE_GPU_RESOURCES(TextureGroupSamplers);
     TextureGroupSamplers.Resize(TextureGroups.Count(), false);
 }
@@ -63,6 +240,14 @@ void StreamingSettings::Apply()
 void StreamingSettings::Deserialize(DeserializeStream& stream, ISerializeModifier* modifier)
 {
     DESERIALIZE(TextureGroups);
+    DESERIALIZE(MaxInFlightMB);
+    DESERIALIZE(MaxUploadPerFrameMB);
+    DESERIALIZE(MaxTasksPerGroup);
+    DESERIALIZE(GPUMemoryBudgetUsage);
+    DESERIALIZE(TextureFeedback);
+    DESERIALIZE(TextureFeedbackInterval);
+    DESERIALIZE(SparseTextures);
+    DESERIALIZE(TexturePoolSizeMB);
 }
 
 StreamableResource::StreamableResource(StreamingGroup* group)
@@ -70,6 +255,8 @@ StreamableResource::StreamableResource(StreamingGroup* group)
     , _isDynamic(true)
     , _isStreaming(false)
     , _streamingQuality(1.0f)
+    , _lastUsedScreenSize(0.0f)
+    , _lastUsedTime(-1.0)
 {
     ASSERT(_group != nullptr);
 }
@@ -109,6 +296,11 @@ void StreamableResource::StopStreaming()
     {
         ResourcesLock.Lock();
         Resources.Remove(this);
+        for (int32 i = InFlight.Count() - 1; i >= 0; i--)
+        {
+            if (InFlight[i].Resource == this)
+                ReleaseInFlight(i);
+        }
         ResourcesLock.Unlock();
         Streaming = StreamingCache();
         _isStreaming = false;
@@ -141,6 +333,7 @@ void UpdateResource(StreamableResource* resource, double currentTime)
     auto currentResidency = resource->GetCurrentResidency();
     auto allocatedResidency = resource->GetAllocatedResidency();
     auto targetResidency = handler->CalculateResidency(resource, targetQuality);
+    targetResidency = Math::Min(targetResidency, resource->Streaming.ResidencyLimit);
     ASSERT(allocatedResidency >= currentResidency && allocatedResidency >= 0);
     resource->Streaming.LastUpdateTime = currentTime;
 
@@ -152,6 +345,14 @@ void UpdateResource(StreamableResource* resource, double currentTime)
         resource->Streaming.TargetResidencyChangeTime = currentTime;
     }
 
+    // Calculate streaming priority (used by loading tasks)
+    if (currentResidency == 0)
+        resource->Streaming.Priority = 1.0f;
+    else if (targetResidency > currentResidency)
+        resource->Streaming.Priority = Math::Saturate((float)(targetResidency - currentResidency) / (float)Math::Max(maxResidency, 1) * 2.0f);
+    else
+        resource->Streaming.Priority = 0.0f;
+
     // Check if need to change resource current residency
     if (handler->RequiresStreaming(resource, currentResidency, targetResidency))
     {
@@ -178,10 +379,29 @@ void UpdateResource(StreamableResource* resource, double currentTime)
         // Calculate residency level to stream in (resources may want to increase/decrease it's quality in steps rather than at once)
         int32 requestedResidency = handler->CalculateRequestedResidency(resource, targetResidency);
 
+        // Check the IO budget when streaming data in (delay the request to the next update if exceeded)
+        const bool streamingIn = requestedResidency > currentResidency;
+        uint64 streamingSize = 0;
+        if (streamingIn)
+        {
+            streamingSize = resource->GetResidencySize(requestedResidency) - resource->GetResidencySize(currentResidency);
+            if (!CanStartStreaming(group, streamingSize))
+            {
+                ThrottledResourcesCount++;
+                return;
+            }
+        }
+
         // Create streaming task (resource type specific)
         Task* streamingTask = resource->CreateStreamingTask(requestedResidency);
         if (streamingTask != nullptr)
         {
+            if (streamingIn)
+            {
+                InFlight.Add({ resource, group, streamingSize, requestedResidency });
+                InFlightBytes += streamingSize;
+                FrameStreamedBytes += streamingSize;
+            }
             streamingTask->Start();
         }
     }
@@ -191,17 +411,6 @@ void UpdateResource(StreamableResource* resource, double currentTime)
 
         // TODO: deallocate or decrease memory usage after timeout? (timeout should be smaller on low mem)
     }
-
-    // low memory case:
-    // if we are on budget and cannot load everything we have to:
-    // decrease global resources quality scale (per resources group)
-    // decrease asset deallocate timeout
-
-    // low mem detecting:
-    // for low mem we have to get whole memory budget for a group and then
-    // subtract immutable resources mem usage (like render targets or non dynamic resources)
-    // so we get amount of memory we can distribute and we can detect if we are out of the limit
-    // low mem should be updated once per a few frames
 }
 
 bool StreamingService::Init()
@@ -214,6 +423,7 @@ bool StreamingService::Init()
 void StreamingService::BeforeExit()
 {
     SAFE_DELETE_GPU_RESOURCE(FallbackSampler);
+    StreamingTexture::FlushPool(true);
     SAFE_DELETE_GPU_RESOURCES(TextureGroupSamplers);
     TextureGroupSamplers.Resize(0);
     SAFE_DELETE(System);
@@ -233,6 +443,19 @@ void StreamingSystem::Job(int32 index)
     int32 resourcesUpdates = Math::Min(MaxResourcesPerUpdate, resourcesCount);
     const double currentTime = Platform::GetTimeSeconds();
 
+    // Release budget of the finished streaming tasks
+    FrameStreamedBytes = 0;
+    ThrottledResourcesCount = 0;
+    for (int32 i = InFlight.Count() - 1; i >= 0; i--)
+    {
+        const InFlightTask& e = InFlight[i];
+        if (e.Resource->CanBeUpdated() || e.Resource->GetCurrentResidency() >= e.Residency)
+            ReleaseInFlight(i);
+    }
+
+    // Fit into the GPU memory budget
+    UpdateMemoryBudget(currentTime);
+
     // Update high priority queue and then rest of the resources
     // Note: resources in the update queue are updated always, while others only between specified intervals
     int32 resourcesChecks = resourcesCount;
@@ -273,6 +496,13 @@ StreamingStats Streaming::GetStats()
     StreamingStats stats;
     ResourcesLock.Lock();
     stats.ResourcesCount = Resources.Count();
+    stats.InFlightTasksCount = InFlight.Count();
+    stats.InFlightBytes = InFlightBytes;
+    stats.FrameStreamedBytes = FrameStreamedBytes;
+    stats.ThrottledResourcesCount = ThrottledResourcesCount;
+    stats.GPUMemoryUsage = GPUMemoryUsage;
+    stats.GPUMemoryBudget = GPUMemoryBudget;
+    stats.EvictedResourcesCount = EvictedResourcesCount;
     for (auto e : Resources)
     {
         if (e->Streaming.TargetResidency > e->GetCurrentResidency())
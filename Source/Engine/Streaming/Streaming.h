@@ -16,6 +16,20 @@ DECLARE_SCRIPTING_TYPE_MINIMAL(StreamingStats);
     API_FIELD() int32 ResourcesCount = 0;
     // Amount of resources that are during streaming in (target residency is higher that the current). Zero if all resources are streamed in.
     API_FIELD() int32 StreamingResourcesCount = 0;
+    // Amount of active streaming tasks (started by the streaming service and not yet finished).
+    API_FIELD() int32 InFlightTasksCount = 0;
+    // Amount of resources data (in bytes) that is being streamed in by the active streaming tasks.
+    API_FIELD() uint64 InFlightBytes = 0;
+    // Amount of resources data (in bytes) that was started to stream in during the last streaming update.
+    API_FIELD() uint64 FrameStreamedBytes = 0;
+    // Amount of resources which streaming was delayed during the last streaming update due to the IO budget limits.
+    API_FIELD() int32 ThrottledResourcesCount = 0;
+    // Amount of GPU memory (in bytes) used by all the GPU resources.
+    API_FIELD() uint64 GPUMemoryUsage = 0;
+    // Amount of GPU memory (in bytes) that can be used by the application (reported by the graphics device, scaled by the budget usage setting).
+    API_FIELD() uint64 GPUMemoryBudget = 0;
+    // Amount of resources which residency is limited due to exceeded GPU memory budget.
+    API_FIELD() int32 EvictedResourcesCount = 0;
 };
 
 /// <summary>
@@ -30,6 +44,46 @@ DECLARE_SCRIPTING_TYPE_NO_SPAWN(Streaming);
     /// </summary>
     API_FIELD() static Array<TextureGroup, InlinedAllocation<32>> TextureGroups;
 
+    /// <summary>
+    /// The maximum amount of resources data (in megabytes) that can be streamed in at once by all the active streaming tasks. Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD() static int32 MaxInFlightMB;
+
+    /// <summary>
+    /// The maximum amount of resources data (in megabytes) that can be started to stream in (and upload to GPU) during a single frame. Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD() static float MaxUploadPerFrameMB;
+
+    /// <summary>
+    /// The maximum amount of streaming tasks that can be active at once within a single streaming group. Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD() static int32 MaxTasksPerGroup;
+
+    /// <summary>
+    /// The fraction of the GPU memory budget (reported by the graphics device) that can be used before streaming starts to evict the least important texture mips and model LODs. Use 0 to disable eviction.
+    /// </summary>
+    API_FIELD() static float GPUMemoryBudgetUsage;
+
+    /// <summary>
+    /// True if use the GPU texture feedback pass (mip levels sampled by materials on screen) to select the streamed textures quality.
+    /// </summary>
+    API_FIELD() static bool TextureFeedback;
+
+    /// <summary>
+    /// The interval (in frames) between texture feedback passes.
+    /// </summary>
+    API_FIELD() static int32 TextureFeedbackInterval;
+
+    /// <summary>
+    /// True if allocate large streamed textures as sparse textures (GPU memory committed per mip map on demand). Used only if the graphics device supports it.
+    /// </summary>
+    API_FIELD() static bool SparseTextures;
+
+    /// <summary>
+    /// The maximum size (in megabytes) of the pool with textures released by the streaming reallocations (reused by other streaming textures of the same description). Use 0 to disable pooling.
+    /// </summary>
+    API_FIELD() static int32 TexturePoolSizeMB;
+
     /// <summary>
     /// Gets streaming statistics.
     /// </summary>
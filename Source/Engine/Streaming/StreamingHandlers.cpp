@@ -11,18 +11,65 @@
 #include "Engine/Audio/Audio.h"
 #include "Engine/Audio/AudioSource.h"
 
+namespace
+{
+    float CalculateModelEvictionPriority(const StreamableResource* resource, double currentTime)
+    {
+        // Evict models that were not drawn recently or drawn only at a small screen size first
+        const double lastUsedTime = resource->GetLastUsedTime();
+        if (lastUsedTime < 0)
+            return 0.0f;
+        const float recency = 1.0f / (1.0f + (float)(currentTime - lastUsedTime));
+        const float screenSize = Math::Saturate(Math::Sqrt(resource->GetLastUsedScreenSize()) * 2.0f);
+        return recency * (0.1f + 0.9f * screenSize);
+    }
+}
+
 float TexturesStreamingHandler::CalculateTargetQuality(StreamableResource* resource, double currentTime)
 {
     ASSERT(resource);
     auto& texture = *(StreamingTexture*)resource;
     const TextureHeader& header = *texture.GetHeader();
     float result = 1.0f;
+
+    // Use the mip level requested on a CPU (eg. terrain based on the chunks LOD)
+    const double requestTime = texture.GetRequestedMipTime();
+    if (requestTime >= 0 && texture.GetRequestedMip() >= 0)
+    {
+        float timeToInvisible = STREAMING_TEXTURE_REQUEST_TIME_TO_INVISIBLE;
+        if (header.TextureGroup >= 0 && header.TextureGroup < Streaming::TextureGroups.Count())
+        {
+            const TextureGroup& group = Streaming::TextureGroups[header.TextureGroup];
+            result = group.Quality;
+            timeToInvisible = group.TimeToInvisible;
+        }
+        const int32 totalMipLevels = texture.TotalMipLevels();
+        if (timeToInvisible <= (float)(currentTime - requestTime))
+        {
+            // Keep only the lowest mip when not used for a longer time
+            return Math::Min(result, 1.0f / (float)totalMipLevels);
+        }
+        const float requestedQuality = (float)(totalMipLevels - texture.GetRequestedMip()) / (float)totalMipLevels;
+        return Math::Min(result, requestedQuality);
+    }
+
     if (header.TextureGroup >= 0 && header.TextureGroup < Streaming::TextureGroups.Count())
     {
         // Quality based on texture group settings
         const TextureGroup& group = Streaming::TextureGroups[header.TextureGroup];
         result = group.Quality;
 
+        // Use the mip levels requested by the materials on screen (if texture was seen by the GPU feedback pass)
+        const double feedbackTime = texture.GetFeedbackTime();
+        if (Streaming::TextureFeedback && feedbackTime >= 0 && texture.GetFeedbackMip() >= 0)
+        {
+            if (group.TimeToInvisible <= (float)(currentTime - feedbackTime))
+                return result * group.QualityIfInvisible;
+            const int32 totalMipLevels = texture.TotalMipLevels();
+            const float feedbackQuality = (float)(totalMipLevels - texture.GetFeedbackMip()) / (float)totalMipLevels;
+            return Math::Min(result, feedbackQuality);
+        }
+
         // Drop quality if invisible
         const double lastRenderTime = texture.GetTexture()->LastRenderTime;
         if (lastRenderTime < 0 || group.TimeToInvisible <= (float)(currentTime - lastRenderTime))
@@ -93,6 +140,18 @@ int32 TexturesStreamingHandler::CalculateRequestedResidency(StreamableResource*
     return residency;
 }
 
+float TexturesStreamingHandler::CalculateEvictionPriority(StreamableResource* resource, double currentTime)
+{
+    ASSERT(resource);
+    auto& texture = *(StreamingTexture*)resource;
+
+    // Evict textures that were not used for rendering recently first
+    const double lastRenderTime = texture.GetTexture()->LastRenderTime;
+    if (lastRenderTime < 0)
+        return 0.0f;
+    return 1.0f / (1.0f + (float)(currentTime - lastRenderTime));
+}
+
 float ModelsStreamingHandler::CalculateTargetQuality(StreamableResource* resource, double currentTime)
 {
     // TODO: calculate a proper quality levels for models based on render time and streaming enable/disable options
@@ -132,6 +191,11 @@ int32 ModelsStreamingHandler::CalculateRequestedResidency(StreamableResource* re
     return residency;
 }
 
+float ModelsStreamingHandler::CalculateEvictionPriority(StreamableResource* resource, double currentTime)
+{
+    return CalculateModelEvictionPriority(resource, currentTime);
+}
+
 float SkinnedModelsStreamingHandler::CalculateTargetQuality(StreamableResource* resource, double currentTime)
 {
     // TODO: calculate a proper quality levels for models based on render time and streaming enable/disable options
@@ -171,6 +235,11 @@ int32 SkinnedModelsStreamingHandler::CalculateRequestedResidency(StreamableResou
     return residency;
 }
 
+float SkinnedModelsStreamingHandler::CalculateEvictionPriority(StreamableResource* resource, double currentTime)
+{
+    return CalculateModelEvictionPriority(resource, currentTime);
+}
+
 float AudioStreamingHandler::CalculateTargetQuality(StreamableResource* resource, double currentTime)
 {
     // Audio clips don't use quality but only residency
@@ -14,6 +14,7 @@ class FLAXENGINE_API TexturesStreamingHandler : public IStreamingHandler
     float CalculateTargetQuality(StreamableResource* resource, double currentTime) override;
     int32 CalculateResidency(StreamableResource* resource, float quality) override;
     int32 CalculateRequestedResidency(StreamableResource* resource, int32 targetResidency) override;
+    float CalculateEvictionPriority(StreamableResource* resource, double currentTime) override;
 };
 
 /// <summary>
@@ -26,6 +27,7 @@ class FLAXENGINE_API ModelsStreamingHandler : public IStreamingHandler
     float CalculateTargetQuality(StreamableResource* resource, double currentTime) override;
     int32 CalculateResidency(StreamableResource* resource, float quality) override;
     int32 CalculateRequestedResidency(StreamableResource* resource, int32 targetResidency) override;
+    float CalculateEvictionPriority(StreamableResource* resource, double currentTime) override;
 };
 
 /// <summary>
@@ -38,6 +40,7 @@ class FLAXENGINE_API SkinnedModelsStreamingHandler : public IStreamingHandler
     float CalculateTargetQuality(StreamableResource* resource, double currentTime) override;
     int32 CalculateResidency(StreamableResource* resource, float quality) override;
     int32 CalculateRequestedResidency(StreamableResource* resource, int32 targetResidency) override;
+    float CalculateEvictionPriority(StreamableResource* resource, double currentTime) override;
 };
 
 /// <summary>
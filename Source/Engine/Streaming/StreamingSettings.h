@@ -11,6 +11,56 @@
 API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class FLAXENGINE_API StreamingSettings : public SettingsBase
 {
 DECLARE_SCRIPTING_TYPE_MINIMAL(StreamingSettings);
+public:
+
+    /// <summary>
+    /// The maximum amount of resources data (in megabytes) that can be streamed in at once by all the active streaming tasks. New streaming requests are delayed when the budget is exceeded. Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(10), Limit(0), EditorDisplay(\"General\", \"Max In Flight (MB)\")")
+    int32 MaxInFlightMB = 256;
+
+    /// <summary>
+    /// The maximum amount of resources data (in megabytes) that can be started to stream in (and upload to GPU) during a single frame. Prevents upload spikes on camera cuts. Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(20), Limit(0), EditorDisplay(\"General\", \"Max Upload Per Frame (MB)\")")
+    float MaxUploadPerFrameMB = 32.0f;
+
+    /// <summary>
+    /// The maximum amount of streaming tasks that can be active at once within a single streaming group (eg. textures or models). Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(30), Limit(0), EditorDisplay(\"General\")")
+    int32 MaxTasksPerGroup = 32;
+
+    /// <summary>
+    /// The fraction of the GPU memory budget (reported by the graphics device) that can be used before streaming starts to evict the least important texture mips and model LODs. Use 0 to disable eviction.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(40), Limit(0, 1, 0.01f), EditorDisplay(\"General\", \"GPU Memory Budget Usage\")")
+    float GPUMemoryBudgetUsage = 0.9f;
+
+    /// <summary>
+    /// If checked, the renderer periodically draws a low-resolution texture feedback pass that records the mip levels actually sampled by materials on screen and textures streaming uses it to select the texture quality (instead of only the last render time). Requires Shader Model 5 GPU.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(50), EditorDisplay(\"Textures\", \"Use GPU Feedback\")")
+    bool TextureFeedback = false;
+
+    /// <summary>
+    /// The interval (in frames) between texture feedback passes. Lower values make streaming react faster to the camera changes at the cost of higher rendering overhead.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(60), Limit(1, 120), EditorDisplay(\"Textures\", \"GPU Feedback Interval\"), VisibleIf(nameof(TextureFeedback))")
+    int32 TextureFeedbackInterval = 8;
+
+    /// <summary>
+    /// If checked, large 2D textures are allocated as sparse (partially resident) textures that commit GPU memory per mip map on demand, instead of reallocating and copying the whole texture on every quality change. Used only if the graphics device supports it (eg. DirectX 12 or Vulkan).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(70), EditorDisplay(\"Textures\", \"Use Sparse Textures\")")
+    bool SparseTextures = false;
+
+    /// <summary>
+    /// The maximum size (in megabytes) of the pool with textures released by the streaming reallocations. Pooled textures are reused by other streaming textures of the same size and format which reduces GPU memory allocations when changing textures quality. Use 0 to disable pooling.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(80), Limit(0, 4096), EditorDisplay(\"Textures\", \"Texture Pool Size (MB)\")")
+    int32 TexturePoolSizeMB = 0;
+
 public:
 
     /// <summary>
@@ -4,17 +4,22 @@
 #include "TerrainPatch.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Math/Ray.h"
+#include "Engine/Level/Scene/Scene.h"
 #include "Engine/Level/Scene/SceneRendering.h"
+#include "Engine/Level/Actors/Camera.h"
 #include "Engine/Serialization/Serialization.h"
 #include "Engine/Physics/Physics.h"
 #include "Engine/Physics/PhysicalMaterial.h"
 #include "Engine/Physics/PhysicsBackend.h"
+#include "Engine/Physics/PhysicsScene.h"
+#include "Engine/Physics/Actors/RigidBody.h"
 #include "Engine/Graphics/RenderView.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/Textures/GPUTexture.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Renderer/GlobalSignDistanceFieldPass.h"
 #include "Engine/Renderer/GI/GlobalSurfaceAtlasPass.h"
+#include "Engine/Renderer/TerrainVirtualTexturePass.h"
 
 Terrain::Terrain(const SpawnParams& params)
     : PhysicsColliderActor(params)
@@ -88,6 +93,55 @@ void Terrain::UpdateLayerBits()
     }
 }
 
+void Terrain::UpdateCollisionStreaming()
+{
+    if (CollisionStreamingDistance <= 0.0f || _patches.IsEmpty())
+        return;
+    PROFILE_CPU();
+
+    // Gather the physics-relevant locations
+    Array<Vector3, InlinedAllocation<64>> sources;
+    for (const auto& source : CollisionStreamingSources)
+    {
+        if (source && source->IsActiveInHierarchy())
+            sources.Add(source->GetPosition());
+    }
+    const Camera* camera = Camera::GetMainCamera();
+    if (camera)
+        sources.Add(camera->GetPosition());
+    for (const RigidBody* rigidBody : GetPhysicsScene()->GetRigidBodies())
+    {
+        if (!rigidBody->GetIsKinematic() && rigidBody->GetEnableSimulation() && rigidBody->IsActiveInHierarchy())
+            sources.Add(rigidBody->GetPosition());
+    }
+    if (sources.IsEmpty())
+        return;
+
+    // Create collision for the patches in range and release it for the far ones (with the hysteresis to prevent rebuilding on range border)
+    const Real createDistance = CollisionStreamingDistance;
+    const Real destroyDistance = CollisionStreamingDistance * 1.2f;
+    bool anyCreated = false;
+    for (int32 pathIndex = 0; pathIndex < _patches.Count(); pathIndex++)
+    {
+        const auto patch = _patches[pathIndex];
+        Real distance = MAX_Real;
+        for (const Vector3& source : sources)
+            distance = Math::Min(distance, CollisionsHelper::DistanceBoxPoint(patch->_bounds, source));
+        if (patch->HasCollision())
+        {
+            if (distance > destroyDistance)
+                patch->DestroyCollision();
+        }
+        else if (distance <= createDistance && patch->_heightfield)
+        {
+            patch->CreateCollision();
+            anyCreated |= patch->HasCollision();
+        }
+    }
+    if (anyCreated)
+        UpdateLayerBits();
+}
+
 void Terrain::RemoveLightmap()
 {
     for (int32 pathIndex = 0; pathIndex < _patches.Count(); pathIndex++)
@@ -674,6 +728,11 @@ void Terrain::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE_MEMBER(PhysicalMaterials, _physicalMaterials);
     SERIALIZE(Material);
     SERIALIZE(DrawModes);
+    SERIALIZE(UseVirtualTexture);
+    SERIALIZE(VirtualTextureDistance);
+    SERIALIZE(UseStreaming);
+    SERIALIZE(CollisionStreamingDistance);
+    SERIALIZE(CollisionStreamingSources);
 
     SERIALIZE_MEMBER(LODCount, _lodCount);
     SERIALIZE_MEMBER(ChunkSize, _chunkSize);
@@ -721,6 +780,11 @@ void Terrain::Deserialize(DeserializeStream& stream, ISerializeModifier* modifie
     DESERIALIZE_MEMBER(PhysicalMaterials, _physicalMaterials);
     DESERIALIZE(Material);
     DESERIALIZE(DrawModes);
+    DESERIALIZE(UseVirtualTexture);
+    DESERIALIZE(VirtualTextureDistance);
+    DESERIALIZE(UseStreaming);
+    DESERIALIZE(CollisionStreamingDistance);
+    DESERIALIZE(CollisionStreamingSources);
 
     member = stream.FindMember("LODCount");
     if (member != stream.MemberEnd() && member->value.IsInt())
@@ -807,6 +871,7 @@ void Terrain::OnEnable()
 #if TERRAIN_USE_PHYSICS_DEBUG
     GetSceneRendering()->AddPhysicsDebug<Terrain, &Terrain::DrawPhysicsDebug>(this);
 #endif
+    GetScene()->Ticking.Update.AddTick<Terrain, &Terrain::UpdateCollisionStreaming>(this);
 
     // Base
     Actor::OnEnable();
@@ -818,6 +883,7 @@ void Terrain::OnDisable()
 #if TERRAIN_USE_PHYSICS_DEBUG
     GetSceneRendering()->RemovePhysicsDebug<Terrain, &Terrain::DrawPhysicsDebug>(this);
 #endif
+    GetScene()->Ticking.Update.RemoveTick(this);
 
     // Base
     Actor::OnDisable();
@@ -832,6 +898,7 @@ void Terrain::OnTransformChanged()
     {
         auto patch = _patches[i];
         patch->UpdateTransform();
+        TerrainVirtualTexturePass::Instance()->Invalidate(patch);
     }
     if (!Float3::NearEqual(_cachedScale, _transform.Scale))
     {
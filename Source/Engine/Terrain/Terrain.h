@@ -5,6 +5,7 @@
 #include "Engine/Content/JsonAssetReference.h"
 #include "Engine/Content/Assets/MaterialBase.h"
 #include "Engine/Physics/Actors/PhysicsColliderActor.h"
+#include "Engine/Scripting/ScriptingObjectReference.h"
 
 class Terrain;
 class TerrainChunk;
@@ -94,6 +95,36 @@ API_CLASS(Sealed) class FLAXENGINE_API Terrain : public PhysicsColliderActor
     API_FIELD(Attributes="EditorOrder(115), DefaultValue(DrawPass.Default), EditorDisplay(\"Terrain\")")
     DrawPass DrawModes = DrawPass::Default;
 
+    /// <summary>
+    /// If checked, terrain chunks are rendered using the virtual texture - the terrain material is pre-composited into the cached tiles (at screen-driven resolution) that are sampled at once so the shading cost doesn't scale with the amount of terrain layers. Time-based or view-dependent material effects are not reflected in the cached tiles.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(130), DefaultValue(false), EditorDisplay(\"Terrain\")")
+    bool UseVirtualTexture = false;
+
+    /// <summary>
+    /// The distance from the view at which terrain chunks start to use the virtual texture. Closer chunks evaluate the terrain material per-pixel to preserve the details.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(140), DefaultValue(0.0f), Limit(0), VisibleIf(nameof(UseVirtualTexture)), EditorDisplay(\"Terrain\")")
+    float VirtualTextureDistance = 0.0f;
+
+    /// <summary>
+    /// If checked, the heightmap and splatmaps textures are streamed per-patch based on the chunks LOD (far patches use lower resolution mips) and the patches that were not rendered for some time are streamed-out to the lowest mip. Patches modified at runtime need to be fully streamed-in.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(150), DefaultValue(false), EditorDisplay(\"Terrain\")")
+    bool UseStreaming = false;
+
+    /// <summary>
+    /// The distance from the physics-relevant actors (main camera, simulated rigidbodies and collision streaming sources) within which terrain patches have the collision created. Collision of the further patches gets released (scene queries against those patches will miss). Value 0 disables collision streaming so all patches have the collision. Used only during gameplay.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(530), DefaultValue(0.0f), Limit(0), EditorDisplay(\"Collision\")")
+    float CollisionStreamingDistance = 0.0f;
+
+    /// <summary>
+    /// The additional actors to create the terrain collision around when using collision streaming (eg. character controllers or AI agents).
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(540), EditorDisplay(\"Collision\")")
+    Array<ScriptingObjectReference<Actor>> CollisionStreamingSources;
+
 public:
     /// <summary>
     /// Gets the terrain Level Of Detail bias value. Allows to increase or decrease rendered terrain quality.
@@ -424,6 +455,7 @@ API_CLASS(Sealed) class FLAXENGINE_API Terrain : public PhysicsColliderActor
 #if TERRAIN_USE_PHYSICS_DEBUG
     void DrawPhysicsDebug(RenderView& view);
 #endif
+    void UpdateCollisionStreaming();
 
 public:
     // [PhysicsColliderActor]
@@ -9,10 +9,13 @@
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/Textures/GPUTexture.h"
 #include "Engine/Renderer/RenderList.h"
+#include "Engine/Renderer/TerrainVirtualTexturePass.h"
 #include "Engine/Core/Math/OrientedBoundingBox.h"
 #include "Engine/Level/Scene/Scene.h"
+#include "Engine/Engine/Time.h"
 #if USE_EDITOR
 #include "Engine/Level/Prefabs/PrefabManager.h"
+#include "Editor/Editor.h"
 #endif
 
 TerrainChunk::TerrainChunk(const SpawnParams& params)
@@ -62,6 +65,25 @@ bool TerrainChunk::PrepareDraw(const RenderContext& renderContext)
         //lod = (int32)Vector2::Distance(Vector2(2, 2), Vector2(_patch->_x, _patch->_z) * Terrain::ChunksCountEdge + Vector2(_x, _z));
         //lod = (int32)(Vector3::Distance(_bounds.GetCenter(), view.Position) / 10000.0f);
     }
+    if (_patch->_terrain->UseStreaming)
+    {
+        // Request the heightmap and splatmaps mips for the chunk LOD (patches edited in Editor or at runtime are fully streamed-in)
+        int32 requestedMip = Math::Clamp(lod, 0, lodCount - 1);
+#if USE_EDITOR
+        if (!Editor::IsPlayMode)
+            requestedMip = 0;
+#endif
+        if (_patch->_cachedHeightMap.HasItems())
+            requestedMip = 0;
+        const double time = Time::Draw.LastBegin;
+        _patch->Heightmap.Get()->StreamingTexture()->RequestMip(requestedMip, time);
+        for (int32 i = 0; i < TERRAIN_MAX_SPLATMAPS_COUNT; i++)
+        {
+            const Texture* splatmap = _patch->Splatmap[i].Get();
+            if (splatmap && splatmap->IsLoaded())
+                splatmap->StreamingTexture()->RequestMip(Math::Min(requestedMip, splatmap->StreamingTexture()->TotalMipLevels() - 1), time);
+        }
+    }
     lod = Math::Clamp(lod, minStreamedLod, lodCount - 1);
 
     // Pick a material
@@ -124,6 +146,15 @@ void TerrainChunk::Draw(const RenderContext& renderContext) const
     drawCall.WorldDeterminantSign = Math::FloatSelect(drawCall.World.RotDeterminant(), 1, -1);
     drawCall.PerInstanceRandom = _perInstanceRandom;
 
+    // Use the material pre-composited into the virtual texture for distant chunks
+    const Terrain* terrain = _patch->_terrain;
+    if (terrain->UseVirtualTexture && EnumHasAnyFlags(renderContext.View.Pass, DrawPass::GBuffer) && !EnumHasAnyFlags(renderContext.View.Pass, DrawPass::GlobalSurfaceAtlas))
+    {
+        const float distance = Float3::Distance(_sphere.Center - renderContext.View.Origin, renderContext.View.Position);
+        if (distance >= terrain->VirtualTextureDistance)
+            TerrainVirtualTexturePass::Instance()->GetTile(renderContext, this, _sphere, _cachedDrawMaterial, drawCall.Terrain.VirtualTextureUV, drawCall.Terrain.VirtualTextureTexel);
+    }
+
     // Add half-texel offset for heightmap sampling in vertex shader
     //const float lodHeightmapSize = Math::Max(1, drawCall.TerrainData.Heightmap->Width() >> lod);
     //const float halfTexelOffset = 0.5f / lodHeightmapSize;
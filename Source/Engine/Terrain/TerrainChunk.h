@@ -36,7 +36,7 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API TerrainChunk : public ScriptingO
 
     TerrainChunk* _neighbors[4];
     byte _cachedDrawLOD;
-    IMaterial* _cachedDrawMaterial;
+    MaterialBase* _cachedDrawMaterial;
 
     void Init(TerrainPatch* patch, uint16 x, uint16 z);
 
@@ -14,6 +14,7 @@
 #include "Engine/Level/Level.h"
 #include "Engine/Graphics/Async/GPUTask.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/JobSystem.h"
 #if TERRAIN_EDITING
 #include "Engine/Core/Math/Packed.h"
 #include "Engine/Graphics/PixelFormatExtensions.h"
@@ -21,6 +22,7 @@
 #include "Engine/Graphics/RenderView.h"
 #include "Engine/Graphics/Textures/GPUTexture.h"
 #include "Engine/Graphics/Textures/TextureData.h"
+#include "Engine/Renderer/TerrainVirtualTexturePass.h"
 #include "Engine/Serialization/MemoryWriteStream.h"
 #if USE_EDITOR
 #include "Editor/Editor.h"
@@ -104,6 +106,7 @@ void TerrainPatch::Init(Terrain* terrain, int16 x, int16 z)
 
 TerrainPatch::~TerrainPatch()
 {
+    TerrainVirtualTexturePass::Instance()->Invalidate(this, true);
 #if TERRAIN_UPDATING
     SAFE_DELETE(_dataHeightmap);
     for (int32 i = 0; i < TERRAIN_MAX_SPLATMAPS_COUNT; i++)
@@ -252,10 +255,9 @@ void CalculateHeightmapRange(Terrain* terrain, TerrainDataUpdateInfo& info, cons
 
     // Note: terrain heightmap doesn't store raw height values but normalized into per-patch dimensions (height = normHeight * chunkPatch + patchOffset)
 
-    float minPatchHeight = MAX_float;
-    float maxPatchHeight = MIN_float;
-
-    for (int32 chunkIndex = 0; chunkIndex < Terrain::ChunksCount; chunkIndex++)
+    // Find the height range of each chunk (each job processes a single chunk)
+    float chunkMaxHeights[Terrain::ChunksCount];
+    JobSystem::Execute([&](int32 chunkIndex)
     {
         const int32 chunkX = (chunkIndex % Terrain::ChunksCountEdge) * info.ChunkSize;
         const int32 chunkZ = (chunkIndex / Terrain::ChunksCountEdge) * info.ChunkSize;
@@ -278,9 +280,15 @@ void CalculateHeightmapRange(Terrain* terrain, TerrainDataUpdateInfo& info, cons
 
         chunkOffsets[chunkIndex] = minHeight;
         chunkHeights[chunkIndex] = Math::Max(maxHeight - minHeight, 1.0f);
+        chunkMaxHeights[chunkIndex] = maxHeight;
+    }, Terrain::ChunksCount);
 
-        minPatchHeight = Math::Min(minPatchHeight, minHeight);
-        maxPatchHeight = Math::Max(maxPatchHeight, maxHeight);
+    float minPatchHeight = MAX_float;
+    float maxPatchHeight = MIN_float;
+    for (int32 chunkIndex = 0; chunkIndex < Terrain::ChunksCount; chunkIndex++)
+    {
+        minPatchHeight = Math::Min(minPatchHeight, chunkOffsets[chunkIndex]);
+        maxPatchHeight = Math::Max(maxPatchHeight, chunkMaxHeights[chunkIndex]);
     }
 
     // Align the patch heightmap range error to reduce artifacts on patch edges (each patch has own height range)
@@ -296,12 +304,12 @@ void UpdateHeightMap(const TerrainDataUpdateInfo& info, const float* heightmap,
 {
     PROFILE_CPU_NAMED("Terrain.UpdateHeightMap");
 
-    // TODO: use offset and size to improve performance of the data updating
-
     const auto heightmapPtr = heightmap;
     const auto ptr = (Color32*)data;
+    const Int2 modifiedEnd = modifiedOffset + modifiedSize;
 
-    for (int32 chunkIndex = 0; chunkIndex < Terrain::ChunksCount; chunkIndex++)
+    // Each job processes a single chunk (chunks have separate texels in the texture so they can be written in parallel)
+    JobSystem::Execute([&](int32 chunkIndex)
     {
         const int32 chunkX = (chunkIndex % Terrain::ChunksCountEdge);
         const int32 chunkZ = (chunkIndex / Terrain::ChunksCountEdge);
@@ -312,12 +320,18 @@ void UpdateHeightMap(const TerrainDataUpdateInfo& info, const float* heightmap,
         const int32 chunkHeightmapX = chunkX * info.ChunkSize;
         const int32 chunkHeightmapZ = chunkZ * info.ChunkSize;
 
-        for (int32 z = 0; z < info.VertexCountEdge; z++)
+        // Iterate only over the samples within the modified region
+        const int32 zStart = Math::Max(modifiedOffset.Y - chunkHeightmapZ, 0);
+        const int32 zEnd = Math::Min(modifiedEnd.Y - chunkHeightmapZ, info.VertexCountEdge);
+        const int32 xStart = Math::Max(modifiedOffset.X - chunkHeightmapX, 0);
+        const int32 xEnd = Math::Min(modifiedEnd.X - chunkHeightmapX, info.VertexCountEdge);
+
+        for (int32 z = zStart; z < zEnd; z++)
         {
             const int32 tz = (chunkTextureZ + z) * info.TextureSize;
             const int32 sz = (chunkHeightmapZ + z) * info.HeightmapSize;
 
-            for (int32 x = 0; x < info.VertexCountEdge; x++)
+            for (int32 x = xStart; x < xEnd; x++)
             {
                 const int32 tx = chunkTextureX + x;
                 const int32 sx = chunkHeightmapX + x;
@@ -327,7 +341,7 @@ void UpdateHeightMap(const TerrainDataUpdateInfo& info, const float* heightmap,
                 WriteHeight(info, ptr[textureIndex], heightmapPtr[heightmapIndex]);
             }
         }
-    }
+    }, Terrain::ChunksCount);
 }
 
 void UpdateHeightMap(const TerrainDataUpdateInfo& info, const float* heightmap, const byte* data)
@@ -339,11 +353,12 @@ void UpdateSplatMap(const TerrainDataUpdateInfo& info, const Color32* splatMap,
 {
     PROFILE_CPU_NAMED("Terrain.UpdateSplatMap");
 
-    // TODO: use offset and size to improve performance of the data updating
-
     const auto splatPtr = splatMap;
     const auto ptr = (Color32*)data;
-    for (int32 chunkIndex = 0; chunkIndex < Terrain::ChunksCount; chunkIndex++)
+    const Int2 modifiedEnd = modifiedOffset + modifiedSize;
+
+    // Each job processes a single chunk (chunks have separate texels in the texture so they can be written in parallel)
+    JobSystem::Execute([&](int32 chunkIndex)
     {
         const int32 chunkX = (chunkIndex % Terrain::ChunksCountEdge);
         const int32 chunkZ = (chunkIndex / Terrain::ChunksCountEdge);
@@ -354,12 +369,18 @@ void UpdateSplatMap(const TerrainDataUpdateInfo& info, const Color32* splatMap,
         const int32 chunkHeightmapX = chunkX * info.ChunkSize;
         const int32 chunkHeightmapZ = chunkZ * info.ChunkSize;
 
-        for (int32 z = 0; z < info.VertexCountEdge; z++)
+        // Iterate only over the samples within the modified region
+        const int32 zStart = Math::Max(modifiedOffset.Y - chunkHeightmapZ, 0);
+        const int32 zEnd = Math::Min(modifiedEnd.Y - chunkHeightmapZ, info.VertexCountEdge);
+        const int32 xStart = Math::Max(modifiedOffset.X - chunkHeightmapX, 0);
+        const int32 xEnd = Math::Min(modifiedEnd.X - chunkHeightmapX, info.VertexCountEdge);
+
+        for (int32 z = zStart; z < zEnd; z++)
         {
             const int32 tz = (chunkTextureZ + z) * info.TextureSize;
             const int32 sz = (chunkHeightmapZ + z) * info.HeightmapSize;
 
-            for (int32 x = 0; x < info.VertexCountEdge; x++)
+            for (int32 x = xStart; x < xEnd; x++)
             {
                 const int32 tx = chunkTextureX + x;
                 const int32 sx = chunkHeightmapX + x;
@@ -369,7 +390,7 @@ void UpdateSplatMap(const TerrainDataUpdateInfo& info, const Color32* splatMap,
                 ptr[textureIndex] = splatPtr[heightmapIndex];
             }
         }
-    }
+    }, Terrain::ChunksCount);
 }
 
 void UpdateSplatMap(const TerrainDataUpdateInfo& info, const Color32* splatMap, const byte* data)
@@ -387,55 +408,63 @@ void UpdateNormalsAndHoles(const TerrainDataUpdateInfo& info, const float* heigh
     const Int2 normalsEnd = Int2::Min(info.HeightmapSize, modifiedEnd + 1);
     const Int2 normalsSize = normalsEnd - normalsStart;
 
-    // Prepare memory
+    // Prepare memory (accumulated normals and the smoothed normals)
     const int32 normalsLength = normalsSize.X * normalsSize.Y;
-    GET_TERRAIN_SCRATCH_BUFFER(normalsPerVertex, normalsLength, Float3);
+    GET_TERRAIN_SCRATCH_BUFFER(normalsAccumulated, normalsLength * 2, Float3);
+    Float3* normalsPerVertex = normalsAccumulated + normalsLength;
 
     // Clear normals (for accumulation pass)
-    Platform::MemoryClear(normalsPerVertex, normalsLength * sizeof(Float3));
+    Platform::MemoryClear(normalsAccumulated, normalsLength * sizeof(Float3));
 
-    // Calculate per-quad normals and apply them to nearby vertices
-    for (int32 z = normalsStart.Y; z < normalsEnd.Y - 1; z++)
+    // Calculate per-quad normals and apply them to nearby vertices (each quads row writes to two vertex rows so process even and odd rows separately to run jobs without overlapping)
+    const int32 quadRows = normalsSize.Y - 1;
+    for (int32 rowParity = 0; rowParity < 2; rowParity++)
     {
-        for (int32 x = normalsStart.X; x < normalsEnd.X - 1; x++)
+        JobSystem::Execute([&](int32 jobIndex)
         {
-            // Get four vertices from the quad
+            const int32 z = normalsStart.Y + jobIndex * 2 + rowParity;
+            for (int32 x = normalsStart.X; x < normalsEnd.X - 1; x++)
+            {
+                // Get four vertices from the quad
 #define GET_VERTEX(a, b) \
 	int32 i##a##b = (z + (b) - normalsStart.Y) * normalsSize.X + (x + (a) - normalsStart.X); \
 	int32 h##a##b = (z + (b)) * info.HeightmapSize + (x + (a)); \
 	Float3 v##a##b; v##a##b.X = (x + (a)) * TERRAIN_UNITS_PER_VERTEX; \
 	v##a##b.Y = heightmap[h##a##b]; \
 	v##a##b.Z = (z + (b)) * TERRAIN_UNITS_PER_VERTEX
-            GET_VERTEX(0, 0);
-            GET_VERTEX(1, 0);
-            GET_VERTEX(0, 1);
-            GET_VERTEX(1, 1);
+                GET_VERTEX(0, 0);
+                GET_VERTEX(1, 0);
+                GET_VERTEX(0, 1);
+                GET_VERTEX(1, 1);
 #undef GET_VERTEX
 
-            // TODO: use SIMD for those calculations
+                // TODO: use SIMD for those calculations
 
-            // Calculate normals for quad two vertices
-            Float3 n0 = Float3::Normalize((v00 - v01) ^ (v01 - v10));
-            Float3 n1 = Float3::Normalize((v11 - v10) ^ (v10 - v01));
-            Float3 n2 = n0 + n1;
+                // Calculate normals for quad two vertices
+                Float3 n0 = Float3::Normalize((v00 - v01) ^ (v01 - v10));
+                Float3 n1 = Float3::Normalize((v11 - v10) ^ (v10 - v01));
+                Float3 n2 = n0 + n1;
 
-            // Apply normal to each vertex using it
-            normalsPerVertex[i00] += n1;
-            normalsPerVertex[i01] += n2;
-            normalsPerVertex[i10] += n2;
-            normalsPerVertex[i11] += n0;
-        }
+                // Apply normal to each vertex using it
+                normalsAccumulated[i00] += n1;
+                normalsAccumulated[i01] += n2;
+                normalsAccumulated[i10] += n2;
+                normalsAccumulated[i11] += n0;
+            }
+        }, (quadRows - rowParity + 1) / 2);
     }
 
-    // Smooth normals
-    for (int32 z = 1; z < normalsSize.Y - 1; z++)
+    // Smooth normals (reads the accumulated normals and writes to a separate buffer so rows can be processed in parallel)
+    Platform::MemoryCopy(normalsPerVertex, normalsAccumulated, normalsLength * sizeof(Float3));
+    JobSystem::Execute([&](int32 jobIndex)
     {
+        const int32 z = jobIndex + 1;
         for (int32 x = 1; x < normalsSize.X - 1; x++)
         {
             // Get four normals for the nearby quads
 #define GET_NORMAL(a, b) \
 	int32 i##a##b = (z + (b - 1)) * normalsSize.X + (x + (a - 1)); \
-	Float3 n##a##b = Float3::NormalizeFast(normalsPerVertex[i##a##b])
+	Float3 n##a##b = Float3::NormalizeFast(normalsAccumulated[i##a##b])
             GET_NORMAL(0, 0);
             GET_NORMAL(1, 0);
             GET_NORMAL(0, 1);
@@ -445,7 +474,7 @@ void UpdateNormalsAndHoles(const TerrainDataUpdateInfo& info, const float* heigh
             GET_NORMAL(0, 2);
             GET_NORMAL(1, 2);
             GET_NORMAL(2, 2);
-#undef GET_VERTEX
+#undef GET_NORMAL
 
             // TODO: use SIMD for those calculations
 
@@ -461,11 +490,11 @@ void UpdateNormalsAndHoles(const TerrainDataUpdateInfo& info, const float* heigh
             // Smooth normals by performing interpolation to average for nearby quads
             normalsPerVertex[i11] = Float3::Lerp(n11, avg, 0.6f);
         }
-    }
+    }, Math::Max(normalsSize.Y - 2, 0));
 
-    // Write back to the data container
+    // Write back to the data container (each job processes a single chunk)
     const auto ptr = (Color32*)data;
-    for (int32 chunkIndex = 0; chunkIndex < Terrain::ChunksCount; chunkIndex++)
+    JobSystem::Execute([&](int32 chunkIndex)
     {
         const int32 chunkX = (chunkIndex % Terrain::ChunksCountEdge);
         const int32 chunkZ = (chunkIndex / Terrain::ChunksCountEdge);
@@ -479,7 +508,7 @@ void UpdateNormalsAndHoles(const TerrainDataUpdateInfo& info, const float* heigh
         // Skip unmodified chunks
         if (chunkHeightmapX >= modifiedEnd.X || chunkHeightmapX + info.ChunkSize < modifiedOffset.X ||
             chunkHeightmapZ >= modifiedEnd.Y || chunkHeightmapZ + info.ChunkSize < modifiedOffset.Y)
-            continue;
+            return;
 
         // TODO: adjust loop range to reduce iterations count for edge cases (skip checking unmodified samples)
         for (int32 z = 0; z < info.VertexCountEdge; z++)
@@ -518,7 +547,7 @@ void UpdateNormalsAndHoles(const TerrainDataUpdateInfo& info, const float* heigh
                 ptr[textureIndex].A = (uint8)(normal.Z * MAX_uint8);
             }
         }
-    }
+    }, Terrain::ChunksCount);
 }
 
 void UpdateNormalsAndHoles(const TerrainDataUpdateInfo& info, const float* heightmap, const byte* holesMask, const byte* data)
@@ -657,40 +686,41 @@ bool CookCollision(TerrainDataUpdateInfo& info, TextureBase::InitData* initData,
     const int32 heightFieldSize = heightFieldChunkSize * Terrain::ChunksCountEdge + 1;
     const int32 heightFieldLength = heightFieldSize * heightFieldSize;
     GET_TERRAIN_SCRATCH_BUFFER(heightFieldData, heightFieldLength, PhysicsBackend::HeightFieldSample);
-    PhysicsBackend::HeightFieldSample sample;
-    Platform::MemoryClear(&sample, sizeof(PhysicsBackend::HeightFieldSample));
+    PhysicsBackend::HeightFieldSample emptySample;
+    Platform::MemoryClear(&emptySample, sizeof(PhysicsBackend::HeightFieldSample));
     Platform::MemoryClear(heightFieldData, sizeof(PhysicsBackend::HeightFieldSample) * heightFieldLength);
 
     // Setup terrain collision information
     const auto& mip = initData->Mips[collisionLOD];
     const int32 vertexCountEdgeMip = info.VertexCountEdge >> collisionLOD;
     const int32 textureSizeMip = info.TextureSize >> collisionLOD;
-    for (int32 chunkX = 0; chunkX < Terrain::ChunksCountEdge; chunkX++)
+    JobSystem::Execute([&](int32 chunkIndex)
     {
+        // Each job processes a single chunk (chunks write to the separate samples ranges)
+        const int32 chunkX = chunkIndex / Terrain::ChunksCountEdge;
+        const int32 chunkZ = chunkIndex % Terrain::ChunksCountEdge;
         const int32 chunkTextureX = chunkX * vertexCountEdgeMip;
         const int32 chunkStartX = chunkX * heightFieldChunkSize;
-        for (int32 chunkZ = 0; chunkZ < Terrain::ChunksCountEdge; chunkZ++)
+        const int32 chunkTextureZ = chunkZ * vertexCountEdgeMip;
+        const int32 chunkStartZ = chunkZ * heightFieldChunkSize;
+        PhysicsBackend::HeightFieldSample sample = emptySample;
+        for (int32 z = 0; z < vertexCountEdgeMip; z++)
         {
-            const int32 chunkTextureZ = chunkZ * vertexCountEdgeMip;
-            const int32 chunkStartZ = chunkZ * heightFieldChunkSize;
-            for (int32 z = 0; z < vertexCountEdgeMip; z++)
+            const int32 heightmapZ = chunkStartZ + z;
+            for (int32 x = 0; x < vertexCountEdgeMip; x++)
             {
-                const int32 heightmapZ = chunkStartZ + z;
-                for (int32 x = 0; x < vertexCountEdgeMip; x++)
-                {
-                    const int32 heightmapX = chunkStartX + x;
+                const int32 heightmapX = chunkStartX + x;
 
-                    const int32 textureIndex = (chunkTextureZ + z) * textureSizeMip + chunkTextureX + x;
-                    const Color32 raw = mip.Data.Get<Color32>()[textureIndex];
-                    sample.Height = int16(TERRAIN_PATCH_COLLISION_QUANTIZATION * ReadNormalizedHeight(raw));
-                    sample.MaterialIndex0 = sample.MaterialIndex1 = GetPhysicalMaterial(raw, info, chunkZ, chunkX, z * collisionLODInv, x * collisionLODInv);
+                const int32 textureIndex = (chunkTextureZ + z) * textureSizeMip + chunkTextureX + x;
+                const Color32 raw = mip.Data.Get<Color32>()[textureIndex];
+                sample.Height = int16(TERRAIN_PATCH_COLLISION_QUANTIZATION * ReadNormalizedHeight(raw));
+                sample.MaterialIndex0 = sample.MaterialIndex1 = GetPhysicalMaterial(raw, info, chunkZ, chunkX, z * collisionLODInv, x * collisionLODInv);
 
-                    const int32 dstIndex = (heightmapX * heightFieldSize) + heightmapZ;
-                    heightFieldData[dstIndex] = sample;
-                }
+                const int32 dstIndex = (heightmapX * heightFieldSize) + heightmapZ;
+                heightFieldData[dstIndex] = sample;
             }
         }
-    }
+    }, Terrain::ChunksCount);
 
     // Cook height field
     MemoryWriteStream outputStream;
@@ -737,55 +767,63 @@ bool ModifyCollision(TerrainDataUpdateInfo& info, TextureBase::InitData* initDat
     // Allocate data
     const int32 heightFieldDataLength = samplesSize.X * samplesSize.Y;
     GET_TERRAIN_SCRATCH_BUFFER(heightFieldData, info.HeightmapLength, PhysicsBackend::HeightFieldSample);
-    PhysicsBackend::HeightFieldSample sample;
-    Platform::MemoryClear(&sample, sizeof(PhysicsBackend::HeightFieldSample));
+    PhysicsBackend::HeightFieldSample emptySample;
+    Platform::MemoryClear(&emptySample, sizeof(PhysicsBackend::HeightFieldSample));
     Platform::MemoryClear(heightFieldData, sizeof(PhysicsBackend::HeightFieldSample) * heightFieldDataLength);
 
-    // Setup terrain collision information
-    const auto& mip = initData->Mips[collisionLOD];
+    // Find the chunks that intersect with the modified region
     const int32 vertexCountEdgeMip = info.VertexCountEdge >> collisionLOD;
-    const int32 textureSizeMip = info.TextureSize >> collisionLOD;
+    Array<int32, FixedAllocation<Terrain::ChunksCount>> modifiedChunks;
     for (int32 chunkX = 0; chunkX < Terrain::ChunksCountEdge; chunkX++)
     {
-        const int32 chunkTextureX = chunkX * vertexCountEdgeMip;
         const int32 chunkStartX = chunkX * heightFieldChunkSize;
         if (chunkStartX >= samplesEnd.X || chunkStartX + vertexCountEdgeMip < samplesOffset.X)
             continue; // Skip unmodified chunks
-
         for (int32 chunkZ = 0; chunkZ < Terrain::ChunksCountEdge; chunkZ++)
         {
-            const int32 chunkTextureZ = chunkZ * vertexCountEdgeMip;
             const int32 chunkStartZ = chunkZ * heightFieldChunkSize;
             if (chunkStartZ >= samplesEnd.Y || chunkStartZ + vertexCountEdgeMip < samplesOffset.Y)
                 continue; // Skip unmodified chunks
+            modifiedChunks.Add(chunkX * Terrain::ChunksCountEdge + chunkZ);
+        }
+    }
 
-            // TODO: adjust loop range to reduce iterations count for edge cases (skip checking unmodified samples)
-            for (int32 z = 0; z < vertexCountEdgeMip; z++)
+    // Setup terrain collision information (each job processes a single modified chunk)
+    const auto& mip = initData->Mips[collisionLOD];
+    const int32 textureSizeMip = info.TextureSize >> collisionLOD;
+    JobSystem::Execute([&](int32 jobIndex)
+    {
+        const int32 chunkIndex = modifiedChunks[jobIndex];
+        const int32 chunkX = chunkIndex / Terrain::ChunksCountEdge;
+        const int32 chunkZ = chunkIndex % Terrain::ChunksCountEdge;
+        const int32 chunkTextureX = chunkX * vertexCountEdgeMip;
+        const int32 chunkStartX = chunkX * heightFieldChunkSize;
+        const int32 chunkTextureZ = chunkZ * vertexCountEdgeMip;
+        const int32 chunkStartZ = chunkZ * heightFieldChunkSize;
+
+        // Iterate only over the samples within the modified region
+        const int32 zStart = Math::Max(samplesOffset.Y - chunkStartZ, 0);
+        const int32 zEnd = Math::Min(samplesOffset.Y + samplesSize.Y - chunkStartZ, vertexCountEdgeMip);
+        const int32 xStart = Math::Max(samplesOffset.X - chunkStartX, 0);
+        const int32 xEnd = Math::Min(samplesOffset.X + samplesSize.X - chunkStartX, vertexCountEdgeMip);
+        PhysicsBackend::HeightFieldSample sample = emptySample;
+        for (int32 z = zStart; z < zEnd; z++)
+        {
+            const int32 heightmapLocalZ = chunkStartZ + z - samplesOffset.Y;
+            for (int32 x = xStart; x < xEnd; x++)
             {
-                const int32 heightmapZ = chunkStartZ + z;
-                const int32 heightmapLocalZ = heightmapZ - samplesOffset.Y;
-                if (heightmapLocalZ < 0 || heightmapLocalZ >= samplesSize.Y)
-                    continue; // Skip unmodified columns
+                const int32 heightmapLocalX = chunkStartX + x - samplesOffset.X;
 
-                // TODO: adjust loop range to reduce iterations count for edge cases (skip checking unmodified samples)
-                for (int32 x = 0; x < vertexCountEdgeMip; x++)
-                {
-                    const int32 heightmapX = chunkStartX + x;
-                    const int32 heightmapLocalX = heightmapX - samplesOffset.X;
-                    if (heightmapLocalX < 0 || heightmapLocalX >= samplesSize.X)
-                        continue; // Skip unmodified rows
-
-                    const int32 textureIndex = (chunkTextureZ + z) * textureSizeMip + chunkTextureX + x;
-                    const Color32 raw = mip.Data.Get<Color32>()[textureIndex];
-                    sample.Height = int16(TERRAIN_PATCH_COLLISION_QUANTIZATION * ReadNormalizedHeight(raw));
-                    sample.MaterialIndex0 = sample.MaterialIndex1 = GetPhysicalMaterial(raw, info, chunkZ, chunkX, z * collisionLODInv, x * collisionLODInv);
-
-                    const int32 dstIndex = (heightmapLocalX * samplesSize.Y) + heightmapLocalZ;
-                    heightFieldData[dstIndex] = sample;
-                }
+                const int32 textureIndex = (chunkTextureZ + z) * textureSizeMip + chunkTextureX + x;
+                const Color32 raw = mip.Data.Get<Color32>()[textureIndex];
+                sample.Height = int16(TERRAIN_PATCH_COLLISION_QUANTIZATION * ReadNormalizedHeight(raw));
+                sample.MaterialIndex0 = sample.MaterialIndex1 = GetPhysicalMaterial(raw, info, chunkZ, chunkX, z * collisionLODInv, x * collisionLODInv);
+
+                const int32 dstIndex = (heightmapLocalX * samplesSize.Y) + heightmapLocalZ;
+                heightFieldData[dstIndex] = sample;
             }
         }
-    }
+    }, modifiedChunks.Count());
 
     // Update height field range
     if (PhysicsBackend::ModifyHeightField(heightField, samplesOffset.Y, samplesOffset.X, samplesSize.Y, samplesSize.X, heightFieldData))
@@ -1547,6 +1585,13 @@ bool TerrainPatch::ModifySplatMap(int32 index, const Color32* samples, const Int
         return true;
     }
     PROFILE_CPU_NAMED("Terrain.ModifySplatMap");
+    const Texture* currentSplatmap = Splatmap[index].Get();
+    if (_terrain->UseStreaming && currentSplatmap && currentSplatmap->IsLoaded() && currentSplatmap->GetTexture()->MipLevels() != currentSplatmap->StreamingTexture()->TotalMipLevels())
+    {
+        LOG(Warning, "Cannot modify terrain {0} patch {1}x{2} splatmap that is not fully streamed-in.", _terrain->ToString(), _x, _z);
+        return true;
+    }
+    TerrainVirtualTexturePass::Instance()->Invalidate(this);
 
     // Get the current data to modify it
     Color32* splatMap = GetSplatMapData(index);
@@ -1718,6 +1763,12 @@ bool TerrainPatch::ModifySplatMap(int32 index, const Color32* samples, const Int
 bool TerrainPatch::UpdateHeightData(TerrainDataUpdateInfo& info, const Int2& modifiedOffset, const Int2& modifiedSize, bool wasHeightRangeChanged, bool wasHeightChanged)
 {
     PROFILE_CPU();
+    if (_terrain->UseStreaming && Heightmap && Heightmap->GetTexture()->MipLevels() != Heightmap->StreamingTexture()->TotalMipLevels())
+    {
+        LOG(Warning, "Cannot modify terrain {0} patch {1}x{2} heightmap that is not fully streamed-in.", _terrain->ToString(), _x, _z);
+        return true;
+    }
+    TerrainVirtualTexturePass::Instance()->Invalidate(this);
     float* heightMap = GetHeightmapData();
     byte* holesMask = GetHolesMaskData();
     ASSERT(heightMap && holesMask);
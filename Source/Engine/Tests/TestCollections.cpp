@@ -1,10 +1,15 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
 #include "Engine/Core/RandomStream.h"
+#include "Engine/Core/Math/Vector2.h"
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Collections/BitArray.h"
 #include "Engine/Core/Collections/HashSet.h"
 #include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Collections/FlatDictionary.h"
+#include "Engine/Core/Collections/FlatHashSet.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "Engine/Threading/ParallelSort.h"
 #include <ThirdParty/catch2/catch.hpp>
 
 TEST_CASE("Array")
@@ -291,3 +296,391 @@ TEST_CASE("Dictionary")
         CHECK(a1.Capacity() <= DICTIONARY_DEFAULT_CAPACITY);
     }
 }
+
+namespace
+{
+    // Finds the keys which home slot is one of the last slots in the table of the given capacity (their probing chain wraps around the table end)
+    void GetWrappingKeys(Array<int32>& keys, int32 capacity, int32 count)
+    {
+        for (int32 key = 0; keys.Count() < count; key++)
+        {
+            const int32 home = (int32)(FlatHash::H1(FlatHash::Mix(GetHash(key))) & (capacity - 1));
+            if (home >= capacity - 2)
+                keys.Add(key);
+        }
+    }
+
+    struct DeleteCounter
+    {
+        static int32 Deleted;
+
+        ~DeleteCounter()
+        {
+            Deleted++;
+        }
+    };
+
+    int32 DeleteCounter::Deleted = 0;
+}
+
+TEST_CASE("FlatDictionary")
+{
+    SECTION("Test Allocators")
+    {
+        FlatDictionary<int32, int32> a1;
+        FlatDictionary<int32, int32, InlinedAllocation<FLAT_HASH_DEFAULT_CAPACITY>> a2;
+        for (int32 i = 0; i < 7; i++)
+        {
+            a1.Add(i, i);
+            a2.Add(i, i);
+        }
+        CHECK(a1.Count() == 7);
+        CHECK(a2.Count() == 7);
+        for (int32 i = 0; i < 7; i++)
+        {
+            CHECK(a1.ContainsKey(i));
+            CHECK(a2.ContainsKey(i));
+            CHECK(a1.ContainsValue(i));
+            CHECK(a2.ContainsValue(i));
+        }
+    }
+
+    SECTION("Test Resizing")
+    {
+        FlatDictionary<int32, int32> a1;
+        int32 capacity = a1.Capacity();
+        bool valid = true;
+        for (int32 i = 0; i < 4000; i++)
+        {
+            a1.Add(i, i * 2);
+            if (a1.Capacity() != capacity)
+            {
+                // Rehash has to keep all the items
+                capacity = a1.Capacity();
+                valid &= (capacity & (capacity - 1)) == 0 && a1.Count() <= FlatHash::GetMaxLoad(capacity);
+                for (int32 j = 0; j <= i; j++)
+                    valid &= a1.ContainsKey(j) && a1[j] == j * 2;
+            }
+        }
+        CHECK(valid);
+        CHECK(a1.Count() == 4000);
+        a1.Clear();
+        CHECK(a1.Count() == 0);
+        CHECK(a1.Capacity() == capacity);
+        for (int32 i = 0; i < 4000; i++)
+            a1.Add(i, i);
+        CHECK(a1.Count() == 4000);
+        CHECK(a1.Capacity() == capacity);
+        a1.SetCapacity(0);
+        CHECK(a1.Count() == 4000);
+        CHECK(a1.Capacity() >= 4000);
+        CHECK(a1.ContainsKey(3999));
+    }
+
+    SECTION("Test Default Capacity")
+    {
+        FlatDictionary<int32, int32> a1;
+        a1.Add(1, 1);
+        CHECK(a1.Capacity() <= FLAT_HASH_DEFAULT_CAPACITY);
+    }
+
+    SECTION("Test Add/Remove")
+    {
+        FlatDictionary<int32, int32> a1;
+        for (int32 i = 0; i < 4000; i++)
+        {
+            a1.Add(i, i);
+            a1.Remove(i);
+        }
+        CHECK(a1.Count() == 0);
+        CHECK(a1.Capacity() <= FLAT_HASH_DEFAULT_CAPACITY);
+
+        // Random churn compared against Dictionary
+        Dictionary<int32, int32> expected;
+        RandomStream rand(101);
+        bool valid = true;
+        for (int32 i = 0; i < 20000; i++)
+        {
+            const int32 key = rand.RandRange(0, 500);
+            if (rand.GetFraction() < 0.6f)
+            {
+                if (!expected.ContainsKey(key))
+                {
+                    expected.Add(key, i);
+                    a1.Add(key, i);
+                }
+            }
+            else
+            {
+                valid &= expected.Remove(key) == a1.Remove(key);
+            }
+        }
+        valid &= expected.Count() == a1.Count();
+        for (const auto& e : expected)
+            valid &= a1.ContainsKey(e.Key) && a1[e.Key] == e.Value;
+        int32 count = 0;
+        for (const auto& e : a1)
+        {
+            valid &= expected.ContainsKey(e.Key);
+            count++;
+        }
+        valid &= count == a1.Count();
+        CHECK(valid);
+    }
+
+    SECTION("Test Wrapping Probing Chain")
+    {
+        const int32 capacity = 64;
+        Array<int32> keys;
+        GetWrappingKeys(keys, capacity, 12);
+        FlatDictionary<int32, int32> a1;
+        a1.SetCapacity(capacity);
+        for (int32 key : keys)
+            a1.Add(key, key);
+        CHECK(a1.Capacity() == capacity);
+        bool valid = true;
+        for (int32 key : keys)
+            valid &= a1.ContainsKey(key);
+        CHECK(valid);
+
+        // Remove from the chain start to shift back the items that wrapped around the table end
+        for (int32 i = 0; i < keys.Count(); i += 3)
+        {
+            CHECK(a1.Remove(keys[i]));
+            for (int32 j = 0; j < keys.Count(); j++)
+                valid &= a1.ContainsKey(keys[j]) == (j > i || j % 3 != 0);
+        }
+        CHECK(valid);
+        CHECK(a1.Count() == keys.Count() - 4);
+    }
+
+    SECTION("Test Remove During Iteration")
+    {
+        for (int32 pass = 0; pass < 2; pass++)
+        {
+            // Mix the keys with the probing chain around the table end and random keys
+            const int32 capacity = 64;
+            Array<int32> keys;
+            GetWrappingKeys(keys, capacity, 10);
+            RandomStream rand(101 + pass);
+            while (keys.Count() < 40)
+            {
+                const int32 key = rand.RandRange(10000, 20000);
+                if (!keys.Contains(key))
+                    keys.Add(key);
+            }
+            FlatDictionary<int32, int32> a1;
+            a1.SetCapacity(capacity);
+            for (int32 key : keys)
+                a1.Add(key, 0);
+            CHECK(a1.Capacity() == capacity);
+
+            // Every item has to be visited exactly once (removing all items in the first pass and every second item in the other)
+            Dictionary<int32, int32> visits;
+            for (auto i = a1.Begin(); i.IsNotEnd();)
+            {
+                const int32 key = i->Key;
+                if (int32* visitsCount = visits.TryGet(key))
+                    (*visitsCount)++;
+                else
+                    visits.Add(key, 1);
+                if (pass == 0 || key % 2 == 0)
+                    a1.Remove(i);
+                else
+                    ++i;
+            }
+            bool valid = visits.Count() == keys.Count();
+            for (int32 key : keys)
+            {
+                valid &= visits.ContainsKey(key) && visits[key] == 1;
+                valid &= a1.ContainsKey(key) == (pass != 0 && key % 2 != 0);
+            }
+            CHECK(valid);
+        }
+    }
+
+    SECTION("Test Clone/Move")
+    {
+        FlatDictionary<int32, int32> a1;
+        for (int32 i = 0; i < 100; i++)
+            a1.Add(i, -i);
+        FlatDictionary<int32, int32> a2;
+        a2.Add(1000, 1000);
+        a2.Clone(a1);
+        CHECK(a2.Count() == 100);
+        CHECK(!a2.ContainsKey(1000));
+        FlatDictionary<int32, int32> a3(a1);
+        FlatDictionary<int32, int32> a4(MoveTemp(a3));
+        CHECK(a3.Count() == 0);
+        FlatDictionary<int32, int32> a5;
+        a5 = MoveTemp(a4);
+        CHECK(a4.Count() == 0);
+        bool valid = a5.Count() == 100;
+        for (int32 i = 0; i < 100; i++)
+            valid &= a2[i] == -i && a5[i] == -i;
+        CHECK(valid);
+        a1.Clear();
+        CHECK(a2.Count() == 100);
+        CHECK(a5.Count() == 100);
+
+        FlatDictionary<int32, int32, InlinedAllocation<FLAT_HASH_DEFAULT_CAPACITY>> a6;
+        for (int32 i = 0; i < 10; i++)
+            a6.Add(i, i);
+        FlatDictionary<int32, int32, InlinedAllocation<FLAT_HASH_DEFAULT_CAPACITY>> a7(MoveTemp(a6));
+        CHECK(a7.Count() == 10);
+        CHECK(a7.ContainsKey(9));
+    }
+
+    SECTION("Test Clear Delete")
+    {
+        FlatDictionary<int32, DeleteCounter*> a1;
+        for (int32 i = 0; i < 50; i++)
+            a1.Add(i, New<DeleteCounter>());
+        a1.Add(50, nullptr);
+        DeleteCounter::Deleted = 0;
+        a1.ClearDelete();
+        CHECK(DeleteCounter::Deleted == 50);
+        CHECK(a1.Count() == 0);
+    }
+}
+
+TEST_CASE("FlatHashSet")
+{
+    SECTION("Test Add/Remove")
+    {
+        FlatHashSet<int32> a1;
+        HashSet<int32> expected;
+        RandomStream rand(101);
+        bool valid = true;
+        for (int32 i = 0; i < 20000; i++)
+        {
+            const int32 item = rand.RandRange(0, 500);
+            if (rand.GetFraction() < 0.6f)
+                valid &= expected.Add(item) == a1.Add(item);
+            else
+                valid &= expected.Remove(item) == a1.Remove(item);
+        }
+        valid &= expected.Count() == a1.Count();
+        for (const auto& e : expected)
+            valid &= a1.Contains(e.Item);
+        CHECK(valid);
+    }
+
+    SECTION("Test Remove During Iteration")
+    {
+        const int32 capacity = 64;
+        Array<int32> items;
+        GetWrappingKeys(items, capacity, 10);
+        for (int32 i = 0; i < 30; i++)
+            items.Add(10000 + i * 7);
+        FlatHashSet<int32> a1;
+        a1.SetCapacity(capacity);
+        for (int32 item : items)
+            a1.Add(item);
+        CHECK(a1.Capacity() == capacity);
+        Dictionary<int32, int32> visits;
+        for (auto i = a1.Begin(); i.IsNotEnd();)
+        {
+            if (int32* visitsCount = visits.TryGet(i->Item))
+                (*visitsCount)++;
+            else
+                visits.Add(i->Item, 1);
+            a1.Remove(i);
+        }
+        bool valid = visits.Count() == items.Count() && a1.Count() == 0;
+        for (int32 item : items)
+            valid &= visits.ContainsKey(item) && visits[item] == 1;
+        CHECK(valid);
+    }
+
+    SECTION("Test Clone/Move")
+    {
+        FlatHashSet<int32> a1;
+        for (int32 i = 0; i < 100; i++)
+            a1.Add(i);
+        FlatHashSet<int32> a2;
+        a2.Clone(a1);
+        FlatHashSet<int32> a3(MoveTemp(a1));
+        CHECK(a1.Count() == 0);
+        bool valid = a2.Count() == 100 && a3.Count() == 100;
+        for (int32 i = 0; i < 100; i++)
+            valid &= a2.Contains(i) && a3.Contains(i);
+        CHECK(valid);
+    }
+}
+
+bool SortByX(const Int2& a, const Int2& b)
+{
+    return a.X < b.X;
+}
+
+TEST_CASE("Sorting")
+{
+    SECTION("Test Radix Sort")
+    {
+        RandomStream rand(101);
+        for (int32 count : { 0, 1, 100, 1000, 50000 })
+        {
+            Array<uint64> keys, tmpKeys;
+            Array<int32> values, tmpValues;
+            keys.Resize(count);
+            values.Resize(count);
+            tmpKeys.Resize(count);
+            tmpValues.Resize(count);
+            for (int32 i = 0; i < count; i++)
+            {
+                // Use keys with the common digits to test skipping of the sorting passes
+                keys[i] = ((uint64)rand.GetUnsignedInt() << 40) | (uint64)(rand.RandRange(0, 100));
+                values[i] = i;
+            }
+            Array<uint64> expected = keys;
+            uint64* resultKeys = keys.Get();
+            int32* resultValues = values.Get();
+            Sorting::RadixSort(resultKeys, resultValues, tmpKeys.Get(), tmpValues.Get(), count);
+            Sorting::QuickSort(expected.Get(), expected.Count());
+            bool valid = true;
+            for (int32 i = 0; i < count; i++)
+            {
+                valid &= resultKeys[i] == expected[i];
+                valid &= i == 0 || resultKeys[i - 1] != resultKeys[i] || resultValues[i - 1] < resultValues[i];
+            }
+            CHECK(valid);
+        }
+    }
+
+    SECTION("Test Parallel Sort")
+    {
+        RandomStream rand(101);
+        for (int32 count : { 0, 1, 100, 5000, 100000 })
+        {
+            // Sort pairs by the key only to test the sorting stability
+            Array<Int2> data;
+            data.Resize(count);
+            for (int32 i = 0; i < count; i++)
+                data[i] = Int2(rand.RandRange(0, 1000), i);
+            ParallelSort::Sort(data.Get(), data.Count(), &SortByX);
+            bool valid = true;
+            for (int32 i = 1; i < count; i++)
+                valid &= data[i - 1].X < data[i].X || (data[i - 1].X == data[i].X && data[i - 1].Y < data[i].Y);
+            CHECK(valid);
+
+            // Prefix sum of the keys
+            Array<int32> offsets;
+            offsets.Resize(count);
+            for (int32 i = 0; i < count; i++)
+                offsets[i] = data[i].X;
+            const int32 total = JobSystem::ParallelScan(offsets.Get(), offsets.Get(), count, 0, [](int32 a, int32 b) { return a + b; });
+            const int32 sum = JobSystem::ParallelReduce(count, 0, [&](int32 start, int32 end)
+            {
+                int32 result = 0;
+                for (int32 i = start; i < end; i++)
+                    result += data[i].X;
+                return result;
+            }, [](int32 a, int32 b) { return a + b; });
+            valid = total == sum;
+            for (int32 i = 1; i < count; i++)
+                valid &= offsets[i] == offsets[i - 1] + data[i - 1].X;
+            CHECK(valid);
+        }
+    }
+}
@@ -0,0 +1,51 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/RandomStream.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Utilities/Compression.h"
+#include <ThirdParty/LZ4/lz4.h>
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    bool TestLZ4HC(const Array<byte>& data, int32 level = 9)
+    {
+        Array<byte> compressed, decompressed;
+        compressed.Resize(LZ4_compressBound(data.Count()));
+        const int32 compressedSize = Compression::CompressLZ4HC(data.Get(), data.Count(), compressed.Get(), compressed.Count(), level);
+        if (compressedSize <= 0)
+            return false;
+        decompressed.Resize(data.Count() + 1);
+        const int32 size = LZ4_decompress_safe((const char*)compressed.Get(), (char*)decompressed.Get(), compressedSize, decompressed.Count());
+        return size == data.Count() && Platform::MemoryCompare(data.Get(), decompressed.Get(), size) == 0;
+    }
+}
+
+TEST_CASE("Compression")
+{
+    SECTION("Test LZ4 HC")
+    {
+        RandomStream rand(100);
+        for (int32 size : { 0, 1, 5, 12, 13, 100, 4096, 70000, 200000 })
+        {
+            Array<byte> data;
+            data.Resize(size);
+
+            // Low-entropy data
+            for (int32 i = 0; i < size; i++)
+                data[i] = (byte)rand.RandRange(0, 3);
+            CHECK(TestLZ4HC(data));
+            CHECK(TestLZ4HC(data, 1));
+
+            // Random data
+            for (int32 i = 0; i < size; i++)
+                data[i] = (byte)rand.RandRange(0, 255);
+            CHECK(TestLZ4HC(data));
+
+            // Repeated data
+            for (int32 i = 0; i < size; i++)
+                data[i] = (byte)(i % 7);
+            CHECK(TestLZ4HC(data));
+        }
+    }
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/Types/StringBuilder.h"
+#include "Engine/Serialization/JsonParser.h"
+#include "Engine/Serialization/MemoryWriteStream.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    StringAnsi GetSceneJson(int32 objectsCount)
+    {
+        StringBuilder str;
+        str.Append(TEXT("{\"ID\": \"a1b2\", \"Data\": [\n"));
+        for (int32 i = 0; i < objectsCount; i++)
+        {
+            if (i != 0)
+                str.Append(TEXT(",\n"));
+            str.AppendFormat(TEXT("{{\"ID\": \"{0}\", \"Name\": \"Actor [{0}] \\\"x\\\"\", \"Values\": [{0}, {1}, true, null], \"Child\": {{\"Tag\": \"]}}\"}}}}"), i, i * 0.5f);
+        }
+        str.Append(TEXT("\n], \"EngineBuild\": 6600}"));
+        return str.ToStringView().ToStringAnsi();
+    }
+}
+
+TEST_CASE("JsonParser")
+{
+    SECTION("Test Parallel Parsing")
+    {
+        for (int32 objectsCount : { 0, 10, 1000, 5000 })
+        {
+            const StringAnsi json = GetSceneJson(objectsCount);
+            rapidjson_flax::Document expected;
+            expected.Parse(json.Get(), json.Length());
+            REQUIRE(!expected.HasParseError());
+            for (bool inSitu : { false, true })
+            {
+                JsonParser parser;
+                rapidjson_flax::Document document;
+                CHECK(!parser.Parse(document, json.Get(), json.Length(), "Data", inSitu));
+                CHECK(document == expected);
+                CHECK(document["Data"].Size() == objectsCount);
+            }
+        }
+    }
+
+    SECTION("Test Binary Format")
+    {
+        for (int32 objectsCount : { 0, 10, 1000, 5000 })
+        {
+            const StringAnsi json = GetSceneJson(objectsCount);
+            rapidjson_flax::Document expected;
+            expected.Parse(json.Get(), json.Length());
+            REQUIRE(!expected.HasParseError());
+            rapidjson_flax::Value big;
+            big.SetInt64((int64)MAX_uint32 * 4);
+            expected.AddMember("Big", big, expected.GetAllocator());
+            MemoryWriteStream stream;
+            JsonParser::WriteBinary(expected, stream, "Data");
+            CHECK(JsonParser::IsBinary(stream.GetHandle(), stream.GetPosition()));
+            CHECK(!JsonParser::IsBinary((const byte*)json.Get(), json.Length()));
+            JsonParser parser;
+            rapidjson_flax::Document document;
+            CHECK(!parser.ParseBinary(document, stream.GetHandle(), stream.GetPosition()));
+            CHECK(document == expected);
+            CHECK(parser.ParseBinary(document, stream.GetHandle(), stream.GetPosition() / 2));
+        }
+    }
+
+    SECTION("Test Parsing Errors")
+    {
+        StringAnsi json = GetSceneJson(1000);
+        const int32 errorPos = json.Find("\"Name\"", StringSearchCase::CaseSensitive, json.Length() / 2);
+        json[errorPos] = '#';
+        rapidjson_flax::Document expected;
+        expected.Parse(json.Get(), json.Length());
+        REQUIRE(expected.HasParseError());
+        JsonParser parser;
+        rapidjson_flax::Document document;
+        CHECK(parser.Parse(document, json.Get(), json.Length(), "Data"));
+        CHECK(parser.GetParseError() == expected.GetParseError());
+        CHECK(parser.GetErrorOffset() == expected.GetErrorOffset());
+    }
+}
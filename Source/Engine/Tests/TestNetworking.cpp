@@ -0,0 +1,164 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/Math/Quaternion.h"
+#include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/RandomStream.h"
+#include "Engine/Networking/NetworkStream.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    // Starts reading the data that has been written into the stream
+    void BeginRead(NetworkStream* writer, NetworkStream* reader)
+    {
+        reader->Initialize(writer->GetBuffer(), writer->GetPosition());
+    }
+}
+
+TEST_CASE("NetworkStream")
+{
+    NetworkStream* writer = New<NetworkStream>();
+    NetworkStream* reader = New<NetworkStream>();
+    writer->Initialize(16);
+
+    SECTION("Bits")
+    {
+        // Consecutive bits are packed, bytes always start at the next full byte
+        writer->WriteBits(5, 3);
+        writer->WriteBits(0x1abc, 13);
+        CHECK(writer->GetPosition() == 2);
+        writer->WriteInt32(-123456);
+        CHECK(writer->GetPosition() == 6);
+        writer->WriteBits(1, 1);
+        writer->WriteBits(MAX_uint32, 32);
+        CHECK(writer->GetPosition() == 11);
+        writer->WriteVarUInt32(300);
+        writer->WriteBits(0, 0);
+        writer->WriteBits(0x55, 7);
+        writer->WriteByte(0xff);
+        writer->WriteBits(0x12345678, 32);
+        const uint32 length = writer->GetPosition();
+        CHECK(length == 19);
+
+        BeginRead(writer, reader);
+        CHECK(reader->ReadBits(3) == 5);
+        CHECK(reader->ReadBits(13) == 0x1abc);
+        int32 valueInt32;
+        reader->ReadInt32(&valueInt32);
+        CHECK(valueInt32 == -123456);
+        CHECK(reader->ReadBits(1) == 1);
+        CHECK(reader->ReadBits(32) == MAX_uint32);
+        CHECK(reader->ReadVarUInt32() == 300);
+        CHECK(reader->ReadBits(0) == 0);
+        CHECK(reader->ReadBits(7) == 0x55);
+        byte valueByte;
+        reader->ReadByte(&valueByte);
+        CHECK(valueByte == 0xff);
+        CHECK(reader->ReadBits(32) == 0x12345678);
+        CHECK(reader->GetPosition() == length);
+    }
+
+    SECTION("Variable-Length Integers")
+    {
+        const int32 values32[] = { 0, 1, -1, 63, -64, 64, -65, 1000000, MAX_int32, MIN_int32 };
+        const int64 values64[] = { 0, 1, -1, MAX_int32, MIN_int32, (int64)MAX_int32 + 1, MAX_int64, MIN_int64 };
+        for (const int32 value : values32)
+            writer->WriteVarInt32(value);
+        for (const int64 value : values64)
+            writer->WriteVarInt64(value);
+        writer->WriteVarUInt32(MAX_uint32);
+        writer->WriteVarUInt64(MAX_uint64);
+        BeginRead(writer, reader);
+        for (const int32 value : values32)
+            CHECK(reader->ReadVarInt32() == value);
+        for (const int64 value : values64)
+            CHECK(reader->ReadVarInt64() == value);
+        CHECK(reader->ReadVarUInt32() == MAX_uint32);
+        CHECK(reader->ReadVarUInt64() == MAX_uint64);
+        CHECK(reader->GetPosition() == writer->GetPosition());
+
+        // Encoded size depends on the magnitude
+        writer->Initialize(16);
+        writer->WriteVarInt32(-64);
+        CHECK(writer->GetPosition() == 1);
+        writer->WriteVarInt32(MIN_int32);
+        CHECK(writer->GetPosition() == 6);
+        writer->WriteVarInt64(MAX_int64);
+        CHECK(writer->GetPosition() == 16);
+    }
+
+    SECTION("Float Quantization")
+    {
+        RandomStream rand(100);
+        const int32 bitsList[] = { 4, 8, 12, 16, 24 };
+        for (const int32 bits : bitsList)
+        {
+            writer->Initialize(16);
+            float values[64];
+            for (float& value : values)
+            {
+                value = rand.RandRange(-10.0f, 10.0f);
+                writer->WriteFloatQuantized(value, -10.0f, 10.0f, bits);
+            }
+            writer->WriteFloatQuantized(-100.0f, -10.0f, 10.0f, bits);
+            writer->WriteFloatQuantized(100.0f, -10.0f, 10.0f, bits);
+            BeginRead(writer, reader);
+            const float maxError = 20.0f / (float)((1u << bits) - 1) * 0.5f + 1e-5f;
+            for (const float value : values)
+                CHECK(Math::Abs(reader->ReadFloatQuantized(-10.0f, 10.0f, bits) - value) <= maxError);
+            CHECK(reader->ReadFloatQuantized(-10.0f, 10.0f, bits) == -10.0f);
+            CHECK(reader->ReadFloatQuantized(-10.0f, 10.0f, bits) == 10.0f);
+        }
+
+        // Precision-based quantization
+        const float precisions[] = { 0.001f, 0.01f, 0.5f };
+        for (const float precision : precisions)
+        {
+            writer->Initialize(16);
+            const float values[] = { 0.0f, 0.0004f, -0.0006f, 1.2345f, -98.765f, 1234.5678f };
+            const Vector3 vector(12345.678f, -0.1234f, 0.0f);
+            for (const float value : values)
+                writer->WriteFloatPrecision(value, precision);
+            writer->WriteVector3Precision(vector, precision);
+            BeginRead(writer, reader);
+            for (const float value : values)
+                CHECK(Math::Abs(reader->ReadFloatPrecision(precision) - value) <= precision * 0.5f + Math::Abs(value) * 1e-6f);
+            const Vector3 result = reader->ReadVector3Precision(precision);
+            for (int32 i = 0; i < 3; i++)
+                CHECK(Math::Abs(result.Raw[i] - vector.Raw[i]) <= precision * 0.5f + Math::Abs(vector.Raw[i]) * 1e-6f);
+        }
+    }
+
+    SECTION("Quaternion Quantization")
+    {
+        RandomStream rand(200);
+        const int32 bitsList[] = { 6, 10, 16 };
+        for (const int32 bits : bitsList)
+        {
+            writer->Initialize(16);
+            Quaternion values[64];
+            values[0] = Quaternion::Identity;
+            values[1] = Quaternion(0.0f, 0.0f, 0.0f, -1.0f);
+            values[2] = Quaternion(0.5f, 0.5f, 0.5f, 0.5f);
+            for (int32 i = 3; i < ARRAY_COUNT(values); i++)
+                values[i] = Quaternion::Euler(rand.RandRange(0.0f, 360.0f), rand.RandRange(0.0f, 360.0f), rand.RandRange(0.0f, 360.0f));
+            for (const Quaternion& value : values)
+                writer->WriteQuaternionQuantized(value, bits);
+            BeginRead(writer, reader);
+
+            // Each of the smallest three components has up to half a step error (largest component is reconstructed from them)
+            const float step = 1.41421356f / (float)((1u << bits) - 1);
+            for (const Quaternion& value : values)
+            {
+                const Quaternion result = reader->ReadQuaternionQuantized(bits);
+                CHECK(Math::Abs(result.Length() - 1.0f) <= 3.0f * step);
+                const float sign = Quaternion::Dot(result, value) < 0.0f ? -1.0f : 1.0f;
+                for (int32 i = 0; i < 4; i++)
+                    CHECK(Math::Abs(result.Raw[i] - value.Raw[i] * sign) <= 3.0f * step);
+            }
+        }
+    }
+
+    writer->DeleteObjectNow();
+    reader->DeleteObjectNow();
+}
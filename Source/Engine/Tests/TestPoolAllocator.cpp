@@ -0,0 +1,175 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/Memory/PoolAllocator.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Platform/Thread.h"
+#include "Engine/Threading/ThreadSpawner.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    struct TestBlock
+    {
+        byte* Ptr;
+        uint64 Size;
+        byte Pattern;
+    };
+
+    void FillBlock(TestBlock& block)
+    {
+        Platform::MemorySet(block.Ptr, block.Size, block.Pattern);
+    }
+
+    bool CheckBlock(const TestBlock& block)
+    {
+        for (uint64 i = 0; i < block.Size; i++)
+        {
+            if (block.Ptr[i] != block.Pattern)
+                return false;
+        }
+        return true;
+    }
+
+    void AddSizes(Array<uint64>& sizes, uint64 size)
+    {
+        sizes.Add(size - 1);
+        sizes.Add(size);
+        sizes.Add(size + 1);
+    }
+
+    // Gets the sizes around the limits of every pool size class (16 bytes step up to 256 bytes, then 4 classes per power of two up to 32kB)
+    void GetSizes(Array<uint64>& sizes)
+    {
+        sizes.Add(1);
+        for (uint64 size = 16; size <= 256; size += 16)
+            AddSizes(sizes, size);
+        for (uint64 base = 256; base < 32 * 1024; base *= 2)
+        {
+            for (uint64 sub = 1; sub <= 4; sub++)
+                AddSizes(sizes, base + base / 4 * sub);
+        }
+    }
+
+    void AllocateBlocks(Array<TestBlock>& blocks, const Array<uint64>& sizes, byte patternOffset)
+    {
+        for (int32 i = 0; i < sizes.Count(); i++)
+        {
+            TestBlock& block = blocks.AddOne();
+            block.Size = sizes[i];
+            block.Ptr = (byte*)PoolAllocator::Allocate(block.Size);
+            block.Pattern = (byte)(i + patternOffset);
+            FillBlock(block);
+        }
+    }
+
+    bool CheckAndFreeBlocks(Array<TestBlock>& blocks)
+    {
+        bool valid = true;
+        for (const TestBlock& block : blocks)
+        {
+            if (!CheckBlock(block))
+                valid = false;
+            PoolAllocator::Free(block.Ptr);
+        }
+        blocks.Clear();
+        return valid;
+    }
+}
+
+TEST_CASE("PoolAllocator")
+{
+    SECTION("Size Classes")
+    {
+        Array<uint64> sizes;
+        GetSizes(sizes);
+        Array<TestBlock> blocks;
+        for (int32 pass = 0; pass < 4; pass++)
+        {
+            AllocateBlocks(blocks, sizes, (byte)pass);
+            for (const TestBlock& block : blocks)
+                CHECK(((uintptr)block.Ptr & 15) == 0);
+            CHECK(CheckAndFreeBlocks(blocks));
+        }
+        CHECK(PoolAllocator::Allocate(0) == nullptr);
+        PoolAllocator::Free(nullptr);
+    }
+
+    SECTION("Add/Remove")
+    {
+        // Many small blocks to go over the thread cache limits (moving blocks between thread cache and shared pools)
+        Array<TestBlock> blocks;
+        for (int32 i = 0; i < 10000; i++)
+        {
+            TestBlock& block = blocks.AddOne();
+            block.Size = 1 + (i * 37) % 700;
+            block.Ptr = (byte*)PoolAllocator::Allocate(block.Size);
+            block.Pattern = (byte)i;
+            FillBlock(block);
+            if (i % 3 == 0)
+            {
+                CHECK(CheckBlock(blocks[i / 2]));
+                PoolAllocator::Free(blocks[i / 2].Ptr);
+                blocks[i / 2].Ptr = (byte*)PoolAllocator::Allocate(blocks[i / 2].Size);
+                FillBlock(blocks[i / 2]);
+            }
+        }
+        CHECK(CheckAndFreeBlocks(blocks));
+        PoolAllocator::FlushThreadCache();
+        AllocateBlocks(blocks, Array<uint64>({ 8, 512, 4096 }), 0);
+        CHECK(CheckAndFreeBlocks(blocks));
+    }
+
+    SECTION("Large Allocations")
+    {
+        const uint64 sizes[] = { 32 * 1024 + 1, 100 * 1024, 4 * 1024 * 1024 };
+        for (const uint64 size : sizes)
+        {
+            TestBlock block = { (byte*)PoolAllocator::Allocate(size), size, 0xCD };
+            CHECK(((uintptr)block.Ptr & 15) == 0);
+            FillBlock(block);
+            CHECK(CheckBlock(block));
+            PoolAllocator::Free(block.Ptr);
+        }
+
+        // Alignment larger than pools block alignment uses the platform allocator too
+        const uint64 alignments[] = { 32, 64, 256, 4096 };
+        for (const uint64 alignment : alignments)
+        {
+            TestBlock block = { (byte*)PoolAllocator::Allocate(100, alignment), 100, 0xEF };
+            CHECK(((uintptr)block.Ptr & (alignment - 1)) == 0);
+            FillBlock(block);
+            CHECK(CheckBlock(block));
+            PoolAllocator::Free(block.Ptr);
+        }
+    }
+
+    SECTION("Cross-Thread Free")
+    {
+        Array<uint64> sizes;
+        GetSizes(sizes);
+        sizes.Add(64 * 1024);
+        Array<TestBlock> mainBlocks, threadBlocks;
+        AllocateBlocks(mainBlocks, sizes, 0);
+        bool threadValid = false;
+        Thread* thread = ThreadSpawner::Start([&]
+        {
+            // Free blocks allocated by the main thread and allocate the ones to be freed by the main thread
+            threadValid = CheckAndFreeBlocks(mainBlocks);
+            AllocateBlocks(threadBlocks, sizes, 100);
+            Array<TestBlock> tmp;
+            AllocateBlocks(tmp, sizes, 50);
+            threadValid &= CheckAndFreeBlocks(tmp);
+            return 0;
+        }, TEXT("PoolAllocator Test"));
+        REQUIRE(thread);
+        thread->Join();
+        Delete(thread);
+        CHECK(threadValid);
+        CHECK(mainBlocks.IsEmpty());
+        CHECK(CheckAndFreeBlocks(threadBlocks));
+
+        // Reuse memory released by the exited thread
+        AllocateBlocks(mainBlocks, sizes, 200);
+        CHECK(CheckAndFreeBlocks(mainBlocks));
+    }
+}
@@ -2,6 +2,7 @@
 
 #include "Engine/Core/Types/String.h"
 #include "Engine/Core/Types/StringView.h"
+#include "Engine/Core/Types/StringName.h"
 #include <ThirdParty/catch2/catch.hpp>
 
 TEST_CASE("String Replace")
@@ -380,3 +381,22 @@ TEST_CASE("String Compare")
         }
     }
 }
+
+TEST_CASE("StringName")
+{
+    SECTION("Interning")
+    {
+        const StringName a(TEXT("TestStringName"));
+        const StringName b(String(TEXT("TestStringName")));
+        const StringName c(TEXT("testStringName"));
+        CHECK(a == b);
+        CHECK(a != c);
+        CHECK(a.GetText() == b.GetText());
+        CHECK(a == StringView(TEXT("TestStringName")));
+        CHECK(a.GetHashCode() == GetHash(StringView(TEXT("TestStringName"))));
+        CHECK(StringName::Find(TEXT("TestStringName")) == a);
+        CHECK(StringName::Find(TEXT("TestStringNameMissing")).IsEmpty());
+        CHECK(StringName(StringView::Empty) == StringName::Empty);
+        CHECK(StringName::Empty.ToStringView().Length() == 0);
+    }
+}
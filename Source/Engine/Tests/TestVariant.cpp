@@ -0,0 +1,185 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/Types/Variant.h"
+#include "Engine/Core/Math/Double4.h"
+#include "Engine/Core/Math/Matrix.h"
+#include "Engine/Core/Math/Transform.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Platform/Thread.h"
+#include "Engine/Threading/ThreadSpawner.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    // Boxed values use pooled memory blocks (more values than the single thread cache holds)
+    constexpr int32 BoxedValuesCount = 1000;
+
+    Transform GetTransform(int32 i)
+    {
+        return Transform(Vector3((Real)i, 2.0f, 3.0f), Quaternion::Euler(0.0f, (float)(i % 360), 0.0f), Float3(1.0f, 2.0f, (float)i));
+    }
+
+    Matrix GetMatrix(int32 i)
+    {
+        return Matrix::Translation(Float3((float)i, 1.0f, -(float)i));
+    }
+
+    Double4 GetDouble4(int32 i)
+    {
+        return Double4((double)i, 1e20, -(double)i, 0.5);
+    }
+
+    void CreateBoxedValues(Array<Variant>& values, int32 offset)
+    {
+        values.Resize(BoxedValuesCount);
+        for (int32 i = 0; i < BoxedValuesCount; i++)
+        {
+            switch (i % 3)
+            {
+            case 0:
+                values[i] = Variant(GetTransform(i + offset));
+                break;
+            case 1:
+                values[i] = Variant(GetMatrix(i + offset));
+                break;
+            default:
+                values[i] = Variant(GetDouble4(i + offset));
+                break;
+            }
+        }
+    }
+
+    bool CheckBoxedValues(const Array<Variant>& values, int32 offset)
+    {
+        if (values.Count() != BoxedValuesCount)
+            return false;
+        for (int32 i = 0; i < BoxedValuesCount; i++)
+        {
+            bool valid;
+            switch (i % 3)
+            {
+            case 0:
+                valid = values[i].Type.Type == VariantType::Transform && values[i].AsTransform() == GetTransform(i + offset);
+                break;
+            case 1:
+                valid = values[i].Type.Type == VariantType::Matrix && values[i].AsMatrix() == GetMatrix(i + offset);
+                break;
+            default:
+                valid = values[i].Type.Type == VariantType::Double4 && values[i].AsDouble4() == GetDouble4(i + offset);
+                break;
+            }
+            if (!valid)
+                return false;
+        }
+        return true;
+    }
+}
+
+TEST_CASE("Variant")
+{
+    SECTION("Boxed Values")
+    {
+        const Transform transform = GetTransform(1);
+        const Matrix matrix = GetMatrix(2);
+        const Double4 double4 = GetDouble4(3);
+        Variant a(transform), b(matrix), c(double4);
+        CHECK(a.Type.Type == VariantType::Transform);
+        CHECK(a.AsTransform() == transform);
+        CHECK(b.Type.Type == VariantType::Matrix);
+        CHECK(b.AsMatrix() == matrix);
+        CHECK(c.Type.Type == VariantType::Double4);
+        CHECK(c.AsDouble4() == double4);
+
+        // Copy
+        Variant d(a);
+        CHECK(d.AsTransform() == transform);
+        d = Variant(GetTransform(10));
+        CHECK(d.AsTransform() == GetTransform(10));
+        CHECK(a.AsTransform() == transform);
+        d = b;
+        CHECK(d.Type.Type == VariantType::Matrix);
+        CHECK(d.AsMatrix() == matrix);
+        d = c;
+        CHECK(d.Type.Type == VariantType::Double4);
+        CHECK(d.AsDouble4() == double4);
+        d = a;
+        CHECK(d.Type.Type == VariantType::Transform);
+        CHECK(d.AsTransform() == transform);
+        d = Variant(5);
+        CHECK(d.Type.Type == VariantType::Int);
+        d = b;
+        CHECK(d.AsMatrix() == matrix);
+
+        // Move
+        Variant e(MoveTemp(d));
+        CHECK(e.Type.Type == VariantType::Matrix);
+        CHECK(e.AsMatrix() == matrix);
+        Variant f;
+        f = MoveTemp(e);
+        CHECK(f.Type.Type == VariantType::Matrix);
+        CHECK(f.AsMatrix() == matrix);
+        f = MoveTemp(c);
+        CHECK(f.Type.Type == VariantType::Double4);
+        CHECK(f.AsDouble4() == double4);
+        CHECK(a.AsTransform() == transform);
+        CHECK(b.AsMatrix() == matrix);
+
+        // Set Type
+        Variant g;
+        g.SetType(VariantType(VariantType::Transform));
+        CHECK(g.Type.Type == VariantType::Transform);
+        g.AsTransform() = transform;
+        CHECK(g.AsTransform() == transform);
+        g.SetType(VariantType(VariantType::Matrix));
+        CHECK(g.Type.Type == VariantType::Matrix);
+        g.SetType(VariantType(VariantType::Double4));
+        CHECK(g.Type.Type == VariantType::Double4);
+        g.SetType(VariantType(VariantType::Float));
+        CHECK(g.Type.Type == VariantType::Float);
+        g.SetType(VariantType(VariantType::Transform));
+        g.AsTransform() = transform;
+        CHECK(g.AsTransform() == transform);
+        g.SetType(VariantType(VariantType::Null));
+        CHECK(g.Type.Type == VariantType::Null);
+    }
+
+    SECTION("Boxed Values Pool")
+    {
+        Array<Variant> values, copies;
+        for (int32 pass = 0; pass < 3; pass++)
+        {
+            CreateBoxedValues(values, pass);
+            CHECK(CheckBoxedValues(values, pass));
+            copies = values;
+            values.Clear();
+            CHECK(CheckBoxedValues(copies, pass));
+            copies.Clear();
+        }
+    }
+
+    SECTION("Boxed Values Cross-Thread")
+    {
+        // Values created on one thread and destroyed on another
+        Array<Variant> mainValues, threadValues;
+        CreateBoxedValues(mainValues, 0);
+        bool threadValid = false;
+        Thread* thread = ThreadSpawner::Start([&]
+        {
+            threadValid = CheckBoxedValues(mainValues, 0);
+            mainValues.Clear();
+            CreateBoxedValues(threadValues, 100);
+            return 0;
+        }, TEXT("Variant Test"));
+        REQUIRE(thread);
+        thread->Join();
+        Delete(thread);
+        CHECK(threadValid);
+        CHECK(mainValues.IsEmpty());
+        CHECK(CheckBoxedValues(threadValues, 100));
+        threadValues.Clear();
+
+        // Reuse blocks returned by the other thread
+        CreateBoxedValues(mainValues, 200);
+        CHECK(CheckBoxedValues(mainValues, 200));
+    }
+}
@@ -5,8 +5,8 @@
 #include "Engine/Platform/CPUInfo.h"
 #include "Engine/Platform/Thread.h"
 #include "Engine/Platform/ConditionVariable.h"
-#include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Engine/EngineService.h"
+#include "Engine/Engine/CommandLine.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #if USE_CSHARP
 #include "Engine/Scripting/ManagedCLR/MCore.h"
@@ -21,6 +21,32 @@
 #define JOB_SYSTEM_ENABLED 1
 #define JOB_SYSTEM_USE_MUTEX 1
 #define JOB_SYSTEM_USE_STATS 0
+// Capacity of the per-worker jobs deque (must be power of two). Jobs over the limit go into the shared queue.
+#define JOB_SYSTEM_WORKER_QUEUE_SIZE 4096
+// Amount of random victims to try stealing from before looking into the shared queue again.
+#define JOB_SYSTEM_STEAL_ATTEMPTS 4
+// Size of the dispatch contexts pool (must be power of two). Limits the amount of dispatches that can be in-flight at once.
+#define JOB_SYSTEM_CONTEXTS_COUNT 1024
+// Maximum amount of dispatches that can wait for a single dispatch to end. Dispatching with dependency over the limit waits for it synchronously.
+#define JOB_SYSTEM_MAX_CONTINUATIONS 6
+
+// Per-platform defaults for the worker threads placement (can be overriden via command line)
+#ifndef JOB_SYSTEM_DEFAULT_USE_SMT
+// Use SMT/Hyper-Threading siblings (after all physical cores got a worker)
+#define JOB_SYSTEM_DEFAULT_USE_SMT 1
+#endif
+#ifndef JOB_SYSTEM_DEFAULT_USE_EFFICIENCY_CORES
+// Use efficiency cores of hybrid CPUs (ignored if there are too few performance cores)
+#define JOB_SYSTEM_DEFAULT_USE_EFFICIENCY_CORES 0
+#endif
+#ifndef JOB_SYSTEM_DEFAULT_USE_AFFINITY
+// Pin each worker thread to a single logical processor
+#define JOB_SYSTEM_DEFAULT_USE_AFFINITY 1
+#endif
+// Minimum amount of processors to use for workers before falling back to efficiency cores
+#define JOB_SYSTEM_MIN_PROCESSORS 4
+// Amount of chunks per job thread used by the parallel loops (more chunks balance uneven work better but add the scheduling overhead)
+#define JOB_SYSTEM_PARALLEL_CHUNKS_PER_THREAD 4
 
 #if JOB_SYSTEM_USE_STATS
 #include "Engine/Core/Log.h"
@@ -46,23 +72,120 @@ class JobSystemService : public EngineService
     void Dispose() override;
 };
 
-struct JobData
+/// <summary>
+/// Pooled dispatch context. Reference-counted by the amount of jobs left to execute - the last finished job releases it back to the pool.
+/// </summary>
+ALIGN_BEGIN(PLATFORM_CACHE_LINE_SIZE) struct JobContext
 {
+    // Label of the dispatch that uses this context.
+    volatile int64 Label;
+    // Amount of jobs that are not yet finished (including temporary references from threads registering continuations).
+    volatile int64 JobsLeft;
+    // Amount of threads waiting for this dispatch to end.
+    volatile int64 Waiters;
+    // Non-zero if context is in use.
+    volatile int64 Used;
+    // Amount of dependencies that are not yet finished. Jobs are queued once it reaches zero.
+    volatile int64 DependenciesLeft;
+    // Amount of dispatches to resolve once this one ends.
+    volatile int64 ContinuationsCount;
+    JobContext* Continuations[JOB_SYSTEM_MAX_CONTINUATIONS];
     Function<void(int32)> Job;
+    int32 JobCount;
+    JobPriority Priority;
+
+    bool IsPending(int64 label) const
+    {
+        // Label is written before jobs counter when reusing context so check it again
+        return Platform::AtomicRead(&Label) == label && Platform::AtomicRead(&JobsLeft) > 0 && Platform::AtomicRead(&Label) == label;
+    }
+} ALIGN_END(PLATFORM_CACHE_LINE_SIZE);
+
+struct JobData
+{
+    JobContext* Context;
     int32 Index;
-    int64 JobKey;
 };
 
 template<>
 struct TIsPODType<JobData>
 {
-    enum { Value = false };
+    enum { Value = true };
+};
+
+/// <summary>
+/// Fixed-size Chase-Lev work-stealing deque. Owner thread pushes and pops jobs at the bottom (LIFO) while other threads steal from the top (FIFO).
+/// </summary>
+class JobWorkerQueue
+{
+private:
+    volatile int64 _top = 0;
+    byte _padding1[PLATFORM_CACHE_LINE_SIZE - sizeof(int64)];
+    volatile int64 _bottom = 0;
+    byte _padding2[PLATFORM_CACHE_LINE_SIZE - sizeof(int64)];
+    JobData _items[JOB_SYSTEM_WORKER_QUEUE_SIZE];
+
+public:
+    int64 Count() const
+    {
+        const int64 count = Platform::AtomicRead(&_bottom) - Platform::AtomicRead(&_top);
+        return count > 0 ? count : 0;
+    }
+
+    // Called only by the owner thread. Returns false if queue is full.
+    bool Push(const JobData& data)
+    {
+        const int64 bottom = Platform::AtomicRead(&_bottom);
+        const int64 top = Platform::AtomicRead(&_top);
+        if (bottom - top >= JOB_SYSTEM_WORKER_QUEUE_SIZE)
+            return false;
+        _items[bottom & (JOB_SYSTEM_WORKER_QUEUE_SIZE - 1)] = data;
+        Platform::AtomicStore(&_bottom, bottom + 1);
+        return true;
+    }
+
+    // Called only by the owner thread.
+    bool Pop(JobData& data)
+    {
+        const int64 bottom = Platform::AtomicRead(&_bottom) - 1;
+        Platform::AtomicStore(&_bottom, bottom);
+        const int64 top = Platform::AtomicRead(&_top);
+        if (top > bottom)
+        {
+            // Empty
+            Platform::AtomicStore(&_bottom, bottom + 1);
+            return false;
+        }
+        data = _items[bottom & (JOB_SYSTEM_WORKER_QUEUE_SIZE - 1)];
+        if (top == bottom)
+        {
+            // Last item so race against thieves
+            const bool won = Platform::InterlockedCompareExchange(&_top, top + 1, top) == top;
+            Platform::AtomicStore(&_bottom, bottom + 1);
+            return won;
+        }
+        return true;
+    }
+
+    // Can be called from any thread.
+    bool Steal(JobData& data)
+    {
+        const int64 top = Platform::AtomicRead(&_top);
+        const int64 bottom = Platform::AtomicRead(&_bottom);
+        if (top >= bottom)
+            return false;
+        data = _items[top & (JOB_SYSTEM_WORKER_QUEUE_SIZE - 1)];
+        return Platform::InterlockedCompareExchange(&_top, top + 1, top) == top;
+    }
 };
 
 class JobSystemThread : public IRunnable
 {
 public:
     uint64 Index;
+    uint64 AffinityMask;
+    uint32 RandomState;
+    JobWorkerQueue Queue;
 
 public:
     // [IRunnable]
@@ -79,35 +202,32 @@ class JobSystemThread : public IRunnable
     }
 };
 
-struct JobContext
-{
-    volatile int64 JobsLeft;
-};
-
-template<>
-struct TIsPODType<JobContext>
-{
-    enum { Value = true };
-};
-
 namespace
 {
     JobSystemService JobSystemInstance;
     Thread* Threads[PLATFORM_THREADS_LIMIT / 2] = {};
+    JobSystemThread* Workers[PLATFORM_THREADS_LIMIT / 2] = {};
+    THREADLOCAL JobSystemThread* CurrentWorker = nullptr;
+    THREADLOCAL uint32 HelperRandomState = 0;
     int32 ThreadsCount = 0;
+    int32 MaxBackgroundThreads = 1;
     bool JobStartingOnDispatch = true;
     volatile int64 ExitFlag = 0;
     volatile int64 JobLabel = 0;
-    Dictionary<int64, JobContext> JobContexts;
+    volatile int64 ActiveDispatches = 0;
+    volatile int64 WaitAllWaiters = 0;
+    volatile int64 BackgroundJobsRunning = 0;
+    volatile int64 QueuedJobs[(int32)JobPriority::MAX] = {};
+    JobContext JobContexts[JOB_SYSTEM_CONTEXTS_COUNT] = {};
     ConditionVariable JobsSignal;
     CriticalSection JobsMutex;
     ConditionVariable WaitSignal;
     CriticalSection WaitMutex;
     CriticalSection JobsLocker;
 #if JOB_SYSTEM_USE_MUTEX
-    RingBuffer<JobData> Jobs;
+    RingBuffer<JobData> Jobs[(int32)JobPriority::MAX];
 #else
-    ConcurrentQueue<JobData> Jobs;
+    ConcurrentQueue<JobData> Jobs[(int32)JobPriority::MAX];
 #endif
 #if JOB_SYSTEM_USE_STATS
     int64 DequeueCount = 0;
@@ -117,11 +237,47 @@ namespace
 
 bool JobSystemService::Init()
 {
-    ThreadsCount = Math::Min<int32>(Platform::GetCPUInfo().LogicalProcessorCount, ARRAY_COUNT(Threads));
+    // Pick logical processors to run workers on (fast cores first, SMT siblings after all physical cores)
+    const CPUInfo cpuInfo = Platform::GetCPUInfo();
+    const int32 logicalProcessorCount = Math::Clamp<int32>(cpuInfo.LogicalProcessorCount, 1, 64);
+    const uint64 allMask = logicalProcessorCount == 64 ? MAX_uint64 : (1ull << logicalProcessorCount) - 1;
+    const uint64 primaryMask = cpuInfo.PrimaryProcessorsMask & allMask ? cpuInfo.PrimaryProcessorsMask & allMask : allMask;
+    const uint64 performanceMask = cpuInfo.PerformanceProcessorsMask & allMask ? cpuInfo.PerformanceProcessorsMask & allMask : allMask;
+    const auto& options = CommandLine::Options;
+    const bool useSMT = options.JobSMT.IsTrue() || (JOB_SYSTEM_DEFAULT_USE_SMT && !options.NoJobSMT.IsTrue());
+    const bool useEfficiencyCores = options.JobEfficiencyCores.IsTrue() || JOB_SYSTEM_DEFAULT_USE_EFFICIENCY_CORES;
+    const bool useAffinity = JOB_SYSTEM_DEFAULT_USE_AFFINITY && !options.NoJobAffinity.IsTrue();
+    int32 processors[64];
+    int32 processorsCount = 0;
+    const uint64 passes[4] = { performanceMask & primaryMask, performanceMask & ~primaryMask, ~performanceMask & primaryMask, ~performanceMask & ~primaryMask };
+    for (int32 pass = 0; pass < ARRAY_COUNT(passes); pass++)
+    {
+        const bool isSMT = pass % 2 == 1;
+        const bool isEfficiency = pass >= 2;
+        if ((isSMT && !useSMT) || (isEfficiency && !useEfficiencyCores && processorsCount >= JOB_SYSTEM_MIN_PROCESSORS))
+            continue;
+        for (int32 i = 0; i < logicalProcessorCount; i++)
+        {
+            if (passes[pass] & allMask & (1ull << i))
+                processors[processorsCount++] = i;
+        }
+    }
+    if (processorsCount == 0)
+        processors[processorsCount++] = 0;
+
+    // Main thread helps with jobs execution when waiting so use one worker less to not oversubscribe the CPU
+    ThreadsCount = processorsCount - 1;
+    if (options.JobThreads.HasValue())
+        StringUtils::Parse(options.JobThreads.GetValue().Get(), &ThreadsCount);
+    ThreadsCount = Math::Clamp<int32>(ThreadsCount, 1, ARRAY_COUNT(Threads));
+    MaxBackgroundThreads = Math::Max(ThreadsCount / 2, 1);
     for (int32 i = 0; i < ThreadsCount; i++)
     {
         auto runnable = New<JobSystemThread>();
         runnable->Index = (uint64)i;
+        runnable->AffinityMask = useAffinity ? 1ull << processors[i % processorsCount] : 0;
+        runnable->RandomState = 0x9E3779B9u * (uint32)(i + 1);
+        Workers[i] = runnable;
         auto thread = Thread::Create(runnable, String::Format(TEXT("Job System {0}"), i), ThreadPriority::AboveNormal);
         if (thread == nullptr)
             return true;
@@ -150,42 +306,283 @@ void JobSystemService::Dispose()
             Delete(Threads[i]);
             Threads[i] = nullptr;
         }
+        Workers[i] = nullptr;
+    }
+}
+
+JobContext* ClaimContext(const Function<void(int32)>& job, int32 jobCount, JobPriority priority, int64& label)
+{
+    // Pick a free context from the pool (label encodes the context index)
+    JobContext* context;
+    while (true)
+    {
+        label = Platform::InterlockedIncrement(&JobLabel);
+        context = &JobContexts[label & (JOB_SYSTEM_CONTEXTS_COUNT - 1)];
+        if (Platform::InterlockedCompareExchange(&context->Used, 1, 0) == 0)
+            break;
+        if ((label & (JOB_SYSTEM_CONTEXTS_COUNT - 1)) == 0)
+        {
+            // Whole pool is in use so wait for any dispatch to end
+            Platform::Sleep(0);
+        }
+    }
+    Platform::InterlockedIncrement(&ActiveDispatches);
+    context->Job = job;
+    context->JobCount = jobCount;
+    context->Priority = priority;
+    context->DependenciesLeft = 1;
+    Platform::AtomicStore(&context->Label, label);
+    Platform::AtomicStore(&context->JobsLeft, jobCount);
+    return context;
+}
+
+void EnqueueJobs(JobContext* context)
+{
+    const int32 jobCount = context->JobCount;
+    const int32 priority = (int32)context->Priority;
+    JobData data;
+    data.Context = context;
+    data.Index = 0;
+
+    // Jobs dispatched from the worker thread stay on its local queue (other workers can steal them), background jobs are always shared
+    JobSystemThread* worker = CurrentWorker;
+    if (worker && context->Priority != JobPriority::Background)
+    {
+        for (; data.Index < jobCount; data.Index++)
+        {
+            if (!worker->Queue.Push(data))
+                break;
+        }
+    }
+
+    // Remaining jobs go to the shared queue
+    if (data.Index < jobCount)
+    {
+        Platform::InterlockedAdd(&QueuedJobs[priority], jobCount - data.Index);
+#if JOB_SYSTEM_USE_MUTEX
+        JobsLocker.Lock();
+        for (; data.Index < jobCount; data.Index++)
+            Jobs[priority].PushBack(data);
+        JobsLocker.Unlock();
+#else
+        for (; data.Index < jobCount; data.Index++)
+            Jobs[priority].enqueue(data);
+#endif
+    }
+
+    if (JobStartingOnDispatch)
+    {
+        if (jobCount == 1)
+            JobsSignal.NotifyOne();
+        else
+            JobsSignal.NotifyAll();
+    }
+}
+
+void ResolveDependency(JobContext* context)
+{
+    // Queue jobs once all dependencies ended
+    if (Platform::InterlockedDecrement(&context->DependenciesLeft) == 0)
+        EnqueueJobs(context);
+}
+
+void ReleaseContext(JobContext* context)
+{
+    // Only the last reference of the dispatch touches shared state
+    if (Platform::InterlockedDecrement(&context->JobsLeft) > 0)
+        return;
+    const bool notify = Platform::AtomicRead(&context->Waiters) != 0 || Platform::AtomicRead(&WaitAllWaiters) != 0;
+
+    // Nothing can register new continuation at this point (counter is zero)
+    JobContext* continuations[JOB_SYSTEM_MAX_CONTINUATIONS];
+    const int32 continuationsCount = (int32)Platform::AtomicRead(&context->ContinuationsCount);
+    for (int32 i = 0; i < continuationsCount; i++)
+        continuations[i] = context->Continuations[i];
+    Platform::AtomicStore(&context->ContinuationsCount, 0);
+
+    context->Job.Unbind();
+    Platform::InterlockedDecrement(&ActiveDispatches);
+    Platform::AtomicStore(&context->Used, 0);
+    if (notify)
+    {
+        // Sync with waiter that might be just about to start waiting
+        WaitMutex.Lock();
+        WaitMutex.Unlock();
+        WaitSignal.NotifyAll();
+    }
+
+    for (int32 i = 0; i < continuationsCount; i++)
+        ResolveDependency(continuations[i]);
+}
+
+// Registers the dispatch to be resolved once the dependency ends. Returns false if dependency has been already finished.
+bool AddContinuation(int64 dependency, JobContext* continuation)
+{
+    JobContext* context = &JobContexts[dependency & (JOB_SYSTEM_CONTEXTS_COUNT - 1)];
+
+    // Add reference so the dependency cannot end while registering continuation
+    int64 refs = Platform::AtomicRead(&context->JobsLeft);
+    while (true)
+    {
+        if (refs <= 0)
+            return false;
+        const int64 prev = Platform::InterlockedCompareExchange(&context->JobsLeft, refs + 1, refs);
+        if (prev == refs)
+            break;
+        refs = prev;
+    }
+    if (Platform::AtomicRead(&context->Label) != dependency)
+    {
+        // Context has been reused so dependency has already finished
+        ReleaseContext(context);
+        return false;
+    }
+
+    const int64 index = Platform::InterlockedIncrement(&context->ContinuationsCount) - 1;
+    const bool added = index < JOB_SYSTEM_MAX_CONTINUATIONS;
+    if (added)
+        context->Continuations[index] = continuation;
+    else
+        Platform::InterlockedDecrement(&context->ContinuationsCount);
+    ReleaseContext(context);
+    if (!added)
+    {
+        // Too many continuations so wait (while helping with jobs)
+        JobSystem::Wait(dependency);
+    }
+    return added;
+}
+
+bool TryGetSharedJob(JobPriority priority, JobData& data)
+{
+    const int32 index = (int32)priority;
+    if (Platform::AtomicRead(&QueuedJobs[index]) <= 0)
+        return false;
+#if JOB_SYSTEM_USE_MUTEX
+    JobsLocker.Lock();
+    if (Jobs[index].Count() != 0)
+    {
+        data = Jobs[index].PeekFront();
+        Jobs[index].PopFront();
+        JobsLocker.Unlock();
+        Platform::InterlockedDecrement(&QueuedJobs[index]);
+        return true;
+    }
+    JobsLocker.Unlock();
+#else
+    if (Jobs[index].try_dequeue(data))
+    {
+        Platform::InterlockedDecrement(&QueuedJobs[index]);
+        return true;
+    }
+#endif
+    return false;
+}
+
+// Gets a job to execute by the calling thread (self is null for non-job threads that help with the execution while waiting).
+bool TryGetJob(JobSystemThread* self, uint32& randomState, JobData& data)
+{
+    // Frame-critical jobs dispatched from non-worker threads
+    if (TryGetSharedJob(JobPriority::Critical, data))
+        return true;
+
+    // Own jobs (most recently pushed are hot in cache)
+    if (self && self->Queue.Pop(data))
+        return true;
+
+    // Jobs dispatched from non-worker threads
+    if (TryGetSharedJob(JobPriority::Normal, data))
+        return true;
+
+    // Steal from other workers
+    const int32 threadsCount = ThreadsCount;
+    if (threadsCount > 1)
+    {
+        for (int32 attempt = 0; attempt < JOB_SYSTEM_STEAL_ATTEMPTS; attempt++)
+        {
+            // Xorshift to pick a random victim
+            randomState ^= randomState << 13;
+            randomState ^= randomState >> 17;
+            randomState ^= randomState << 5;
+            const int32 victim = (int32)(randomState % (uint32)threadsCount);
+            JobSystemThread* worker = Workers[victim];
+            if (worker && worker != self && worker->Queue.Steal(data))
+                return true;
+        }
+        for (int32 i = 0; i < threadsCount; i++)
+        {
+            JobSystemThread* worker = Workers[i];
+            if (worker && worker != self && worker->Queue.Steal(data))
+                return true;
+        }
+    }
+
+    // Background jobs run only on job threads when there is no other work (limited to leave free threads for frame jobs)
+    if (self && Platform::AtomicRead(&QueuedJobs[(int32)JobPriority::Background]) > 0)
+    {
+        if (Platform::InterlockedIncrement(&BackgroundJobsRunning) <= MaxBackgroundThreads && TryGetSharedJob(JobPriority::Background, data))
+            return true;
+        Platform::InterlockedDecrement(&BackgroundJobsRunning);
+    }
+    return false;
+}
+
+void ExecuteJob(const JobData& data)
+{
+    // Run job
+    JobContext* context = data.Context;
+    const bool isBackground = context->Priority == JobPriority::Background;
+    context->Job(data.Index);
+
+    // Move forward with the job queue
+    ReleaseContext(context);
+    if (isBackground)
+        Platform::InterlockedDecrement(&BackgroundJobsRunning);
+}
+
+// Tries to execute a single pending job on the calling thread. Returns true if any job was executed.
+bool HelpWithJob()
+{
+    JobSystemThread* worker = CurrentWorker;
+    uint32* randomState;
+    if (worker)
+    {
+        randomState = &worker->RandomState;
     }
+    else
+    {
+        if (HelperRandomState == 0)
+            HelperRandomState = (uint32)Platform::GetCurrentThreadID() | 1;
+        randomState = &HelperRandomState;
+    }
+    JobData data;
+    if (!TryGetJob(worker, *randomState, data))
+        return false;
+    ExecuteJob(data);
+    return true;
 }
 
 int32 JobSystemThread::Run()
 {
-    Platform::SetThreadAffinityMask(1ull << Index);
+    if (AffinityMask)
+        Platform::SetThreadAffinityMask(AffinityMask);
+    CurrentWorker = this;
 
     JobData data;
     bool attachCSharpThread = true;
-#if !JOB_SYSTEM_USE_MUTEX
-    moodycamel::ConsumerToken consumerToken(Jobs);
-#endif
     while (Platform::AtomicRead(&ExitFlag) == 0)
     {
         // Try to get a job
 #if JOB_SYSTEM_USE_STATS
         const auto start = Platform::GetTimeCycles();
 #endif
-#if JOB_SYSTEM_USE_MUTEX
-        JobsLocker.Lock();
-        if (Jobs.Count() != 0)
-        {
-            data = Jobs.PeekFront();
-            Jobs.PopFront();
-        }
-        JobsLocker.Unlock();
-#else
-        if (!Jobs.try_dequeue(consumerToken, data))
-            data.Job.Unbind();
-#endif
+        const bool hasJob = TryGetJob(this, RandomState, data);
 #if JOB_SYSTEM_USE_STATS
         Platform::InterlockedIncrement(&DequeueCount);
         Platform::InterlockedAdd(&DequeueSum, Platform::GetTimeCycles() - start);
 #endif
 
-        if (data.Job.IsBinded())
+        if (hasJob)
         {
 #if USE_CSHARP
             // Ensure to have C# thread attached to this thead (late init due to MCore being initialized after Job System)
@@ -196,22 +593,7 @@ int32 JobSystemThread::Run()
             }
 #endif
 
-            // Run job
-            data.Job(data.Index);
-
-            // Move forward with the job queue
-            JobsLocker.Lock();
-            JobContext& context = JobContexts.At(data.JobKey);
-            if (Platform::InterlockedDecrement(&context.JobsLeft) <= 0)
-            {
-                ASSERT_LOW_LAYER(context.JobsLeft <= 0);
-                JobContexts.Remove(data.JobKey);
-            }
-            JobsLocker.Unlock();
-
-            WaitSignal.NotifyAll();
-
-            data.Job.Unbind();
+            ExecuteJob(data);
         }
         else
         {
@@ -221,6 +603,7 @@ int32 JobSystemThread::Run()
             JobsMutex.Unlock();
         }
     }
+    CurrentWorker = nullptr;
     return 0;
 }
 
@@ -229,7 +612,7 @@ int32 JobSystemThread::Run()
 void JobSystem::Execute(const Function<void(int32)>& job, int32 jobCount)
 {
 #if JOB_SYSTEM_ENABLED
-    // TODO: disable async if called on job thread? or maybe Wait should handle waiting in job thread to do the processing?
+    // Waiting thread helps with jobs execution so it's safe to call it from within the job
     if (jobCount > 1)
     {
         // Async
@@ -246,6 +629,11 @@ void JobSystem::Execute(const Function<void(int32)>& job, int32 jobCount)
 }
 
 int64 JobSystem::Dispatch(const Function<void(int32)>& job, int32 jobCount)
+{
+    return Dispatch(job, jobCount, JobPriority::Normal);
+}
+
+int64 JobSystem::Dispatch(const Function<void(int32)>& job, int32 jobCount, JobPriority priority)
 {
     PROFILE_CPU();
     if (jobCount <= 0)
@@ -254,40 +642,42 @@ int64 JobSystem::Dispatch(const Function<void(int32)>& job, int32 jobCount)
 #if JOB_SYSTEM_USE_STATS
     const auto start = Platform::GetTimeCycles();
 #endif
-    const auto label = Platform::InterlockedAdd(&JobLabel, (int64)jobCount) + jobCount;
-
-    JobData data;
-    data.Job = job;
-    data.JobKey = label;
+    int64 label;
+    JobContext* context = ClaimContext(job, jobCount, priority, label);
+    ResolveDependency(context);
 
-    JobContext context;
-    context.JobsLeft = jobCount;
+#if JOB_SYSTEM_USE_STATS
+    LOG(Info, "Job enqueue time: {0} cycles", (int64)(Platform::GetTimeCycles() - start));
+#endif
 
-#if JOB_SYSTEM_USE_MUTEX
-    JobsLocker.Lock();
-    JobContexts.Add(label, context);
-    for (data.Index = 0; data.Index < jobCount; data.Index++)
-        Jobs.PushBack(data);
-    JobsLocker.Unlock();
+    return label;
 #else
-    JobsLocker.Lock();
-    JobContexts.Add(label, context);
-    JobsLocker.Unlock();
-    for (data.Index = 0; data.Index < jobCount; data.Index++)
-        Jobs.enqueue(data);
+    for (int32 i = 0; i < jobCount; i++)
+        job(i);
+    return 0;
 #endif
+}
 
-#if JOB_SYSTEM_USE_STATS
-    LOG(Info, "Job enqueue time: {0} cycles", (int64)(Platform::GetTimeCycles() - start));
-#endif
+int64 JobSystem::Dispatch(const Function<void(int32)>& job, const Span<int64>& dependencies, int32 jobCount, JobPriority priority)
+{
+    PROFILE_CPU();
+    if (jobCount <= 0)
+        return 0;
+#if JOB_SYSTEM_ENABLED
+    int64 label;
+    JobContext* context = ClaimContext(job, jobCount, priority, label);
 
-    if (JobStartingOnDispatch)
+    // Link with dependencies (context holds an additional dependency until all are registered)
+    for (int32 i = 0; i < dependencies.Length(); i++)
     {
-        if (jobCount == 1)
-            JobsSignal.NotifyOne();
-        else
-            JobsSignal.NotifyAll();
+        const int64 dependency = dependencies[i];
+        if (dependency == 0)
+            continue;
+        Platform::InterlockedIncrement(&context->DependenciesLeft);
+        if (!AddContinuation(dependency, context))
+            Platform::InterlockedDecrement(&context->DependenciesLeft);
     }
+    ResolveDependency(context);
 
     return label;
 #else
@@ -297,23 +687,27 @@ int64 JobSystem::Dispatch(const Function<void(int32)>& job, int32 jobCount)
 #endif
 }
 
+int64 JobSystem::Dispatch(const Function<void(int32)>& job, int64 dependency, int32 jobCount, JobPriority priority)
+{
+    return Dispatch(job, Span<int64>(&dependency, 1), jobCount, priority);
+}
+
 void JobSystem::Wait()
 {
 #if JOB_SYSTEM_ENABLED
-    JobsLocker.Lock();
-    int32 numJobs = JobContexts.Count();
-    JobsLocker.Unlock();
-
-    while (numJobs > 0)
+    Platform::InterlockedIncrement(&WaitAllWaiters);
+    while (Platform::AtomicRead(&ActiveDispatches) > 0 && Platform::AtomicRead(&ExitFlag) == 0)
     {
+        // Execute pending jobs instead of sleeping
+        if (HelpWithJob())
+            continue;
+
         WaitMutex.Lock();
-        WaitSignal.Wait(WaitMutex, 1);
+        if (Platform::AtomicRead(&ActiveDispatches) > 0)
+            WaitSignal.Wait(WaitMutex, 1);
         WaitMutex.Unlock();
-
-        JobsLocker.Lock();
-        numJobs = JobContexts.Count();
-        JobsLocker.Unlock();
     }
+    Platform::InterlockedDecrement(&WaitAllWaiters);
 #endif
 }
 
@@ -322,24 +716,28 @@ void JobSystem::Wait(int64 label)
 #if JOB_SYSTEM_ENABLED
     PROFILE_CPU();
 
+    JobContext& context = JobContexts[label & (JOB_SYSTEM_CONTEXTS_COUNT - 1)];
+    Platform::InterlockedIncrement(&context.Waiters);
     while (Platform::AtomicRead(&ExitFlag) == 0)
     {
-        JobsLocker.Lock();
-        const JobContext* context = JobContexts.TryGet(label);
-        JobsLocker.Unlock();
-
-        // Skip if context has been already executed (last job removes it)
-        if (!context)
+        // Skip if context has been already executed (last job releases it)
+        if (!context.IsPending(label))
             break;
 
-        // Wait on signal until input label is not yet done
+        // Execute pending jobs (of any dispatch) instead of sleeping
+        if (HelpWithJob())
+            continue;
+
+        // Wait on signal until input label is not yet done (woken up by the last job of the dispatch)
         WaitMutex.Lock();
-        WaitSignal.Wait(WaitMutex, 1);
+        if (context.IsPending(label))
+            WaitSignal.Wait(WaitMutex, 1);
         WaitMutex.Unlock();
 
         // Wake up any thread to prevent stalling in highly multi-threaded environment
         JobsSignal.NotifyOne();
     }
+    Platform::InterlockedDecrement(&context.Waiters);
 
 #if JOB_SYSTEM_USE_STATS
     LOG(Info, "Job average dequeue time: {0} cycles", DequeueSum / DequeueCount);
@@ -355,13 +753,14 @@ void JobSystem::SetJobStartingOnDispatch(bool value)
 
     if (value)
     {
-#if JOB_SYSTEM_USE_MUTEX
-        JobsLocker.Lock();
-        const int32 count = Jobs.Count();
-        JobsLocker.Unlock();
-#else
-        const int32 count = Jobs.Count();
-#endif
+        int64 count = 0;
+        for (int32 i = 0; i < (int32)JobPriority::MAX; i++)
+            count += Platform::AtomicRead(&QueuedJobs[i]);
+        for (int32 i = 0; i < ThreadsCount; i++)
+        {
+            if (Workers[i])
+                count += Workers[i]->Queue.Count();
+        }
         if (count == 1)
             JobsSignal.NotifyOne();
         else if (count != 0)
@@ -378,3 +777,32 @@ int32 JobSystem::GetThreadsCount()
     return 0;
 #endif
 }
+
+int32 JobSystem::GetParallelChunks(int32 count, int32 grainSize, int32& chunkSize)
+{
+    if (count <= 0)
+    {
+        chunkSize = 0;
+        return 0;
+    }
+    const int32 maxChunks = Math::Max(GetThreadsCount(), 1) * JOB_SYSTEM_PARALLEL_CHUNKS_PER_THREAD;
+    chunkSize = Math::Max(Math::Max(grainSize, 1), Math::DivideAndRoundUp(count, maxChunks));
+    return Math::DivideAndRoundUp(count, chunkSize);
+}
+
+void JobSystem::ParallelFor(int32 count, const Function<void(int32, int32)>& body, int32 grainSize)
+{
+    int32 chunkSize;
+    const int32 chunks = GetParallelChunks(count, grainSize, chunkSize);
+    if (chunks <= 1)
+    {
+        if (chunks == 1)
+            body(0, count);
+        return;
+    }
+    Execute([&](int32 chunk)
+    {
+        const int32 start = chunk * chunkSize;
+        body(start, Math::Min(start + chunkSize, count));
+    }, chunks);
+}
@@ -3,9 +3,36 @@
 #pragma once
 
 #include "Engine/Core/Delegate.h"
+#include "Engine/Core/Types/Span.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Math/Math.h"
 
 /// <summary>
-/// Lightweight multi-threaded jobs execution scheduler. Uses a pool of threads and supports work-stealing concept.
+/// The priority of the jobs dispatched to the Job System.
+/// </summary>
+API_ENUM() enum class JobPriority
+{
+    /// <summary>
+    /// Frame-critical work that is waited on during the current frame (eg. rendering or animation). Executed before any other jobs.
+    /// </summary>
+    Critical,
+
+    /// <summary>
+    /// The default priority.
+    /// </summary>
+    Normal,
+
+    /// <summary>
+    /// Background work that can span multiple frames (eg. streaming or content building). Executed only on job threads when there is no frame work, and limited to a part of the job threads.
+    /// </summary>
+    Background,
+
+    API_ENUM(Attributes="HideInEditor")
+    MAX,
+};
+
+/// <summary>
+/// Lightweight multi-threaded jobs execution scheduler. Uses a pool of threads with per-thread job queues and work-stealing (jobs dispatched from a job thread stay on that thread unless other threads run out of work).
 /// </summary>
 API_CLASS(Static) class FLAXENGINE_API JobSystem
 {
@@ -27,12 +54,41 @@ API_CLASS(Static) class FLAXENGINE_API JobSystem
     API_FUNCTION() static int64 Dispatch(const Function<void(int32)>& job, int32 jobCount = 1);
 
     /// <summary>
-    /// Waits for all dispatched jobs to finish.
+    /// Dispatches the job for the execution with a given priority.
+    /// </summary>
+    /// <param name="job">The job. Argument is an index of the job execution.</param>
+    /// <param name="jobCount">The job executions count.</param>
+    /// <param name="priority">The jobs priority.</param>
+    /// <returns>The label identifying this dispatch. Can be used to wait for the execution end.</returns>
+    API_FUNCTION() static int64 Dispatch(const Function<void(int32)>& job, int32 jobCount, JobPriority priority);
+
+    /// <summary>
+    /// Dispatches the job for the execution after all the dependencies end (continuation). Can be used to build jobs pipelines without waiting for them on the calling thread.
+    /// </summary>
+    /// <param name="job">The job. Argument is an index of the job execution.</param>
+    /// <param name="dependencies">The labels of the dispatches (returned by Dispatch) that need to end before this job can start. Invalid (zero) or already finished labels are ignored.</param>
+    /// <param name="jobCount">The job executions count.</param>
+    /// <param name="priority">The jobs priority.</param>
+    /// <returns>The label identifying this dispatch. Can be used to wait for the execution end or as a dependency of other dispatch.</returns>
+    API_FUNCTION() static int64 Dispatch(const Function<void(int32)>& job, const Span<int64>& dependencies, int32 jobCount = 1, JobPriority priority = JobPriority::Normal);
+
+    /// <summary>
+    /// Dispatches the job for the execution after the dependency ends (continuation).
+    /// </summary>
+    /// <param name="job">The job. Argument is an index of the job execution.</param>
+    /// <param name="dependency">The label of the dispatch (returned by Dispatch) that needs to end before this job can start.</param>
+    /// <param name="jobCount">The job executions count.</param>
+    /// <param name="priority">The jobs priority.</param>
+    /// <returns>The label identifying this dispatch. Can be used to wait for the execution end or as a dependency of other dispatch.</returns>
+    static int64 Dispatch(const Function<void(int32)>& job, int64 dependency, int32 jobCount, JobPriority priority = JobPriority::Normal);
+
+    /// <summary>
+    /// Waits for all dispatched jobs to finish. Calling thread helps with executing pending jobs while waiting.
     /// </summary>
     API_FUNCTION() static void Wait();
 
     /// <summary>
-    /// Waits for all dispatched jobs until a given label to finish (i.e. waits for a Dispatch that returned that label).
+    /// Waits for all dispatched jobs until a given label to finish (i.e. waits for a Dispatch that returned that label). Calling thread helps with executing pending jobs while waiting, thus it's safe to wait from within the job.
     /// </summary>
     /// <param name="label">The label.</param>
     API_FUNCTION() static void Wait(int64 label);
@@ -46,4 +102,102 @@ API_CLASS(Static) class FLAXENGINE_API JobSystem
     /// Gets the amount of job system threads.
     /// </summary>
     API_PROPERTY() static int32 GetThreadsCount();
+
+public:
+    /// <summary>
+    /// Splits the range of items into chunks for the parallel execution (a few chunks per job thread for load balancing).
+    /// </summary>
+    /// <param name="count">The items count.</param>
+    /// <param name="grainSize">The minimum amount of items per chunk. Use 0 to pick it automatically.</param>
+    /// <param name="chunkSize">The output amount of items per chunk (the last chunk can be smaller).</param>
+    /// <returns>The amount of chunks.</returns>
+    static int32 GetParallelChunks(int32 count, int32 grainSize, int32& chunkSize);
+
+    /// <summary>
+    /// Executes the loop over the range of items in parallel. Items are split into chunks, each executed as a single job, to reduce the scheduling overhead of the small per-item work. Runs on the calling thread if there is only a single chunk.
+    /// </summary>
+    /// <param name="count">The items count.</param>
+    /// <param name="body">The loop body. Arguments are the start (inclusive) and the end (exclusive) index of the chunk items.</param>
+    /// <param name="grainSize">The minimum amount of items per chunk. Use 0 to pick it automatically (use larger values for cheap loop bodies).</param>
+    static void ParallelFor(int32 count, const Function<void(int32, int32)>& body, int32 grainSize = 0);
+
+    /// <summary>
+    /// Reduces the range of items in parallel. Each chunk is reduced into a partial result which are then combined on the calling thread in the order of chunks (deterministic result for the same chunking).
+    /// </summary>
+    /// <param name="count">The items count.</param>
+    /// <param name="identity">The identity value of the reduction (eg. 0 for sum).</param>
+    /// <param name="map">The chunk reduction function: T(int32 start, int32 end). Computes the partial result of the chunk items.</param>
+    /// <param name="reduce">The combine function: T(const T& a, const T& b). Has to be associative.</param>
+    /// <param name="grainSize">The minimum amount of items per chunk. Use 0 to pick it automatically.</param>
+    /// <returns>The reduced value.</returns>
+    template<typename T, typename MapFunc, typename ReduceFunc>
+    static T ParallelReduce(int32 count, const T& identity, const MapFunc& map, const ReduceFunc& reduce, int32 grainSize = 0)
+    {
+        int32 chunkSize;
+        const int32 chunks = GetParallelChunks(count, grainSize, chunkSize);
+        if (chunks <= 1)
+            return chunks == 1 ? reduce(identity, map(0, count)) : identity;
+        Array<T> partials;
+        partials.Resize(chunks);
+        Execute([&](int32 chunk)
+        {
+            const int32 start = chunk * chunkSize;
+            partials[chunk] = map(start, Math::Min(start + chunkSize, count));
+        }, chunks);
+        T result = identity;
+        for (int32 i = 0; i < chunks; i++)
+            result = reduce(result, partials[i]);
+        return result;
+    }
+
+    /// <summary>
+    /// Calculates the exclusive prefix scan of the items in parallel (output[i] is a reduction of input[0..i-1] and output[0] is identity). Eg. converts counts into the offsets. Input and output can be the same buffer.
+    /// </summary>
+    /// <param name="input">The input items.</param>
+    /// <param name="output">The output items.</param>
+    /// <param name="count">The items count.</param>
+    /// <param name="identity">The identity value of the reduction (eg. 0 for sum).</param>
+    /// <param name="reduce">The combine function: T(const T& a, const T& b). Has to be associative.</param>
+    /// <param name="grainSize">The minimum amount of items per chunk. Use 0 to pick it automatically.</param>
+    /// <returns>The reduction of all items.</returns>
+    template<typename T, typename ReduceFunc>
+    static T ParallelScan(const T* input, T* output, int32 count, const T& identity, const ReduceFunc& reduce, int32 grainSize = 0)
+    {
+        int32 chunkSize;
+        const int32 chunks = GetParallelChunks(count, grainSize, chunkSize);
+        const auto scanChunk = [&](int32 start, int32 end, T sum)
+        {
+            for (int32 i = start; i < end; i++)
+            {
+                const T item = input[i];
+                output[i] = sum;
+                sum = reduce(sum, item);
+            }
+            return sum;
+        };
+        if (chunks <= 1)
+            return scanChunk(0, count, identity);
+
+        // Reduce chunks, scan chunk sums and then scan chunks with the offsets
+        Array<T> offsets;
+        offsets.Resize(chunks + 1);
+        Execute([&](int32 chunk)
+        {
+            const int32 start = chunk * chunkSize;
+            const int32 end = Math::Min(start + chunkSize, count);
+            T sum = identity;
+            for (int32 i = start; i < end; i++)
+                sum = reduce(sum, input[i]);
+            offsets[chunk + 1] = sum;
+        }, chunks);
+        offsets[0] = identity;
+        for (int32 i = 1; i <= chunks; i++)
+            offsets[i] = reduce(offsets[i - 1], offsets[i]);
+        Execute([&](int32 chunk)
+        {
+            const int32 start = chunk * chunkSize;
+            scanChunk(start, Math::Min(start + chunkSize, count), offsets[chunk]);
+        }, chunks);
+        return offsets[chunks];
+    }
 };
@@ -0,0 +1,152 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "JobSystem.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Platform/Platform.h"
+
+// The minimum amount of elements per job chunk for the parallel sort
+#ifndef PARALLEL_SORT_MIN_CHUNK
+#define PARALLEL_SORT_MIN_CHUNK 4096
+#endif
+
+// The size of the runs sorted with insertion sort before merging in the stable merge sort
+#define PARALLEL_SORT_INSERTION_RUN 32
+
+/// <summary>
+/// Helper utility used for sorting data collections in parallel using Job System (chunks are sorted with stable merge sort on job threads and then merged in parallel passes). The sort is stable. Small arrays are sorted on the calling thread.
+/// </summary>
+class ParallelSort
+{
+private:
+    template<typename T, typename LessFunc>
+    static void InsertionSort(T* data, int32 start, int32 end, const LessFunc& less)
+    {
+        for (int32 i = start + 1; i < end; i++)
+        {
+            T item = data[i];
+            int32 j = i;
+            while (j > start && less(item, data[j - 1]))
+            {
+                data[j] = data[j - 1];
+                j--;
+            }
+            data[j] = item;
+        }
+    }
+
+    template<typename T, typename LessFunc>
+    static void MergeRuns(const T* src, T* dst, int32 start, int32 mid, int32 end, const LessFunc& less)
+    {
+        // Stable merge (takes the item from the right run only if it's strictly less)
+        int32 i = start;
+        int32 j = mid;
+        int32 k = start;
+        while (i < mid && j < end)
+            dst[k++] = less(src[j], src[i]) ? src[j++] : src[i++];
+        while (i < mid)
+            dst[k++] = src[i++];
+        while (j < end)
+            dst[k++] = src[j++];
+    }
+
+    template<typename T, typename LessFunc>
+    static void StableSort(T* data, T* tmp, int32 start, int32 end, const LessFunc& less)
+    {
+        // Bottom-up merge sort of the range (result is copied back into the data if it ended in the temporary buffer)
+        for (int32 i = start; i < end; i += PARALLEL_SORT_INSERTION_RUN)
+            InsertionSort(data, i, Math::Min(i + PARALLEL_SORT_INSERTION_RUN, end), less);
+        T* src = data;
+        T* dst = tmp;
+        for (int32 runSize = PARALLEL_SORT_INSERTION_RUN; runSize < end - start; runSize *= 2)
+        {
+            for (int32 i = start; i < end; i += runSize * 2)
+                MergeRuns(src, dst, i, Math::Min(i + runSize, end), Math::Min(i + runSize * 2, end), less);
+            Swap(src, dst);
+        }
+        if (src != data)
+        {
+            for (int32 i = start; i < end; i++)
+                data[i] = src[i];
+        }
+    }
+
+    template<typename T, typename LessFunc>
+    static void SortImpl(T* data, int32 count, T* tmp, const LessFunc& less)
+    {
+        if (count < 2)
+            return;
+        const bool alloc = tmp == nullptr;
+        if (alloc)
+            tmp = (T*)Platform::Allocate(sizeof(T) * count, 16);
+
+        // Sort chunks on job threads
+        int32 chunkSize;
+        const int32 chunks = JobSystem::GetParallelChunks(count, PARALLEL_SORT_MIN_CHUNK, chunkSize);
+        JobSystem::Execute([&](int32 chunk)
+        {
+            const int32 start = chunk * chunkSize;
+            StableSort(data, tmp, start, Math::Min(start + chunkSize, count), less);
+        }, chunks);
+
+        // Merge pairs of the sorted runs until there is a single run left (each merge in a separate job)
+        T* src = data;
+        T* dst = tmp;
+        for (int32 runSize = chunkSize; runSize < count; runSize *= 2)
+        {
+            JobSystem::Execute([&](int32 pair)
+            {
+                const int32 start = pair * runSize * 2;
+                const int32 mid = Math::Min(start + runSize, count);
+                MergeRuns(src, dst, start, mid, Math::Min(mid + runSize, count), less);
+            }, Math::DivideAndRoundUp(count, runSize * 2));
+            Swap(src, dst);
+        }
+        if (src != data)
+        {
+            JobSystem::ParallelFor(count, [&](int32 start, int32 end)
+            {
+                for (int32 i = start; i < end; i++)
+                    data[i] = src[i];
+            }, PARALLEL_SORT_MIN_CHUNK);
+        }
+
+        if (alloc)
+            Platform::Free(tmp);
+    }
+
+public:
+    /// <summary>
+    /// Sorts the linear data array in parallel using Job System.
+    /// </summary>
+    /// <param name="data">The data pointer.</param>
+    /// <param name="count">The elements count.</param>
+    /// <param name="tmp">The additional temporary memory buffer for sorting data (of the same size as data). If null then will be automatically allocated within this function call.</param>
+    template<typename T>
+    static void Sort(T* data, int32 count, T* tmp = nullptr)
+    {
+        SortImpl(data, count, tmp, [](const T& a, const T& b) { return a < b; });
+    }
+
+    /// <summary>
+    /// Sorts the linear data array in parallel using Job System.
+    /// </summary>
+    /// <param name="data">The data pointer.</param>
+    /// <param name="count">The elements count.</param>
+    /// <param name="compare">The custom comparision callback (returns true if a is less than b). Called from multiple threads at once.</param>
+    /// <param name="tmp">The additional temporary memory buffer for sorting data (of the same size as data). If null then will be automatically allocated within this function call.</param>
+    template<typename T>
+    static void Sort(T* data, int32 count, bool (*compare)(const T& a, const T& b), T* tmp = nullptr)
+    {
+        SortImpl(data, count, tmp, compare);
+    }
+
+    template<typename T, typename AllocationType = HeapAllocation>
+    FORCE_INLINE static void Sort(Array<T, AllocationType>& data, Array<T, AllocationType>* tmp = nullptr)
+    {
+        if (tmp)
+            tmp->Resize(data.Count());
+        Sort(data.Get(), data.Count(), tmp ? tmp->Get() : nullptr);
+    }
+};
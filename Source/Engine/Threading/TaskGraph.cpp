@@ -85,6 +85,9 @@ void TaskGraph::Execute()
     _queue.Clear();
     _remaining.Clear();
     _remaining.Add(_systems);
+    _labels.Clear();
+    for (auto system : _systems)
+        system->_labelsStart = system->_labelsEnd = 0;
 
     while (_remaining.HasItems())
     {
@@ -112,24 +115,25 @@ void TaskGraph::Execute()
         if (_queue.IsEmpty())
             break;
 
-        // Execute in order
+        // Execute in order (jobs are chained with dependencies jobs so there is no need to wait for them here)
         Sorting::QuickSort(_queue.Get(), _queue.Count(), &SortTaskGraphSystem);
         JobSystem::SetJobStartingOnDispatch(false);
-        _labels.Clear();
         for (int32 i = 0; i < _queue.Count(); i++)
         {
             _currentSystem = _queue[i];
+            _currentSystem->_labelsStart = _labels.Count();
             _currentSystem->Execute(this);
+            _currentSystem->_labelsEnd = _labels.Count();
         }
         _currentSystem = nullptr;
         _queue.Clear();
-
-        // Wait for async jobs to finish
         JobSystem::SetJobStartingOnDispatch(true);
-        for (const int64 label : _labels)
-            JobSystem::Wait(label);
     }
 
+    // Wait for async jobs to finish
+    for (const int64 label : _labels)
+        JobSystem::Wait(label);
+
     for (auto system : _systems)
         system->PostExecute(this);
 }
@@ -137,6 +141,18 @@ void TaskGraph::Execute()
 void TaskGraph::DispatchJob(const Function<void(int32)>& job, int32 jobCount)
 {
     ASSERT(_currentSystem);
-    const int64 label = JobSystem::Dispatch(job, jobCount);
+
+    // Start job after all jobs of the dependencies
+    Array<int64, InlinedAllocation<64>> dependencies;
+    for (const TaskGraphSystem* d : _currentSystem->_dependencies)
+    {
+        for (int32 i = d->_labelsStart; i < d->_labelsEnd; i++)
+            dependencies.Add(_labels[i]);
+    }
+    int64 label;
+    if (dependencies.HasItems())
+        label = JobSystem::Dispatch(job, ToSpan(dependencies), jobCount);
+    else
+        label = JobSystem::Dispatch(job, jobCount);
     _labels.Add(label);
 }
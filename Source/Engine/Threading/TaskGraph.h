@@ -17,6 +17,8 @@ DECLARE_SCRIPTING_TYPE(TaskGraphSystem);
 private:
     Array<TaskGraphSystem*, InlinedAllocation<16>> _dependencies;
     Array<TaskGraphSystem*, InlinedAllocation<16>> _reverseDependencies;
+    int32 _labelsStart = 0;
+    int32 _labelsEnd = 0;
 
 public:
     /// <summary>
@@ -28,7 +30,7 @@ DECLARE_SCRIPTING_TYPE(TaskGraphSystem);
     ~TaskGraphSystem();
 
     /// <summary>
-    /// Adds the dependency on the system execution. Before this system can be executed the given dependant system has to be executed first.
+    /// Adds the dependency on the system execution. Before this system can be executed the given dependant system has to be executed first. Jobs dispatched by this system (via TaskGraph::DispatchJob) start after all jobs of the dependant system end.
     /// </summary>
     /// <param name="system">The system to depend on.</param>
     API_FUNCTION() void AddDependency(TaskGraphSystem* system);
@@ -48,6 +50,7 @@ DECLARE_SCRIPTING_TYPE(TaskGraphSystem);
     /// <summary>
     /// Executes the system logic and schedules the asynchronous work.
     /// </summary>
+    /// <remarks>Jobs of dependant systems might be still in progress when this is called (graph doesn't wait for them on the main thread). Access their results only from within the dispatched jobs.</remarks>
     /// <param name="graph">The graph executing the system.</param>
     API_FUNCTION() virtual void Execute(TaskGraph* graph);
 
@@ -97,7 +100,7 @@ DECLARE_SCRIPTING_TYPE(TaskGraph);
     /// <summary>
     /// Dispatches the job for the execution.
     /// </summary>
-    /// <remarks>Call only from system's Execute method to properly schedule job.</remarks>
+    /// <remarks>Call only from system's Execute method to properly schedule job. Job starts once all jobs of the systems that the current system depends on end.</remarks>
     /// <param name="job">The job. Argument is an index of the job execution.</param>
     /// <param name="jobCount">The job executions count.</param>
     API_FUNCTION() void DispatchJob(const Function<void(int32)>& job, int32 jobCount = 1);
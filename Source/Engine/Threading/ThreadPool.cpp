@@ -62,10 +62,10 @@ bool ThreadPoolService::Init()
     LOG(Info, "Spawning {0} Thread Pool workers", numThreads);
     for (int32 i = ThreadPoolImpl::Threads.Count(); i < numThreads; i++)
     {
-        // Create tread
+        // Create tread (below normal priority to not compete with frame-critical work on job system threads)
         auto runnable = New<SimpleRunnable>(true);
         runnable->OnWork.Bind(ThreadPool::ThreadProc);
-        auto thread = Thread::Create(runnable, String::Format(TEXT("Thread Pool {0}"), i));
+        auto thread = Thread::Create(runnable, String::Format(TEXT("Thread Pool {0}"), i), ThreadPriority::BelowNormal);
         if (thread == nullptr)
         {
             LOG(Error, "Failed to spawn {0} thread in the Thread Pool", i + 1);
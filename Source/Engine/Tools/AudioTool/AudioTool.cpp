@@ -5,15 +5,14 @@
 #include "AudioTool.h"
 #include "Engine/Core/Core.h"
 #include "Engine/Core/Memory/Allocation.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Audio/Config.h"
 #if USE_EDITOR
 #include "Engine/Serialization/Serialization.h"
 #include "Engine/Scripting/Enums.h"
 #endif
 
 #define CONVERT_TO_MONO_AVG 1
-#if !CONVERT_TO_MONO_AVG
-#include "Engine/Core/Math/Math.h"
-#endif
 
 #if USE_EDITOR
 
@@ -313,4 +312,180 @@ void AudioTool::ConvertFromFloat(const float* input, int32* output, uint32 numSa
     }
 }
 
+namespace
+{
+    const int32 ADPCMIndexTable[16] =
+    {
+        -1, -1, -1, -1, 2, 4, 6, 8,
+        -1, -1, -1, -1, 2, 4, 6, 8,
+    };
+
+    const int32 ADPCMStepTable[89] =
+    {
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+        19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+        50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+        130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+        337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+        876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+        2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+        5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+        15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+    };
+
+    struct ADPCMState
+    {
+        int32 Predictor = 0;
+        int32 Index = 0;
+
+        FORCE_INLINE void Update(int32 nibble)
+        {
+            const int32 step = ADPCMStepTable[Index];
+            int32 delta = step >> 3;
+            if (nibble & 4)
+                delta += step;
+            if (nibble & 2)
+                delta += step >> 1;
+            if (nibble & 1)
+                delta += step >> 2;
+            Predictor = Math::Clamp(nibble & 8 ? Predictor - delta : Predictor + delta, -32768, 32767);
+            Index = Math::Clamp(Index + ADPCMIndexTable[nibble], 0, 88);
+        }
+
+        FORCE_INLINE int32 Encode(int32 sample)
+        {
+            int32 diff = sample - Predictor;
+            int32 nibble = 0;
+            if (diff < 0)
+            {
+                nibble = 8;
+                diff = -diff;
+            }
+            int32 step = ADPCMStepTable[Index];
+            if (diff >= step)
+            {
+                nibble |= 4;
+                diff -= step;
+            }
+            step >>= 1;
+            if (diff >= step)
+            {
+                nibble |= 2;
+                diff -= step;
+            }
+            step >>= 1;
+            if (diff >= step)
+                nibble |= 1;
+            Update(nibble);
+            return nibble;
+        }
+    };
+}
+
+uint32 AudioTool::GetADPCMSize(uint32 numSamples, uint32 numChannels)
+{
+    const uint32 numBlocks = (numSamples + AUDIO_ADPCM_BLOCK_SAMPLES - 1) / AUDIO_ADPCM_BLOCK_SAMPLES;
+    return numBlocks * AUDIO_ADPCM_BLOCK_SIZE * numChannels;
+}
+
+void AudioTool::ConvertToADPCM(const int16* input, byte* output, uint32 numSamples, uint32 numChannels)
+{
+    // Uses Microsoft IMA ADPCM layout: per-channel headers (first sample and step index) followed by interleaved groups of 8 samples per channel
+    ADPCMState states[8];
+    ASSERT(numChannels <= ARRAY_COUNT(states));
+    int16 block[AUDIO_ADPCM_BLOCK_SAMPLES * ARRAY_COUNT(states)];
+    for (uint32 start = 0; start < numSamples; start += AUDIO_ADPCM_BLOCK_SAMPLES)
+    {
+        // Copy block samples (last block is padded with the last sample)
+        const uint32 count = Math::Min<uint32>(numSamples - start, AUDIO_ADPCM_BLOCK_SAMPLES);
+        for (uint32 i = 0; i < AUDIO_ADPCM_BLOCK_SAMPLES; i++)
+        {
+            const int16* src = input + (start + Math::Min(i, count - 1)) * numChannels;
+            for (uint32 c = 0; c < numChannels; c++)
+                block[i * numChannels + c] = src[c];
+        }
+
+        // Header
+        for (uint32 c = 0; c < numChannels; c++)
+        {
+            ADPCMState& state = states[c];
+            state.Predictor = block[c];
+            output[0] = (byte)(state.Predictor & 0xff);
+            output[1] = (byte)((state.Predictor >> 8) & 0xff);
+            output[2] = (byte)state.Index;
+            output[3] = 0;
+            output += 4;
+        }
+
+        // Samples
+        for (uint32 group = 0; group < (AUDIO_ADPCM_BLOCK_SAMPLES - 1) / 8; group++)
+        {
+            for (uint32 c = 0; c < numChannels; c++)
+            {
+                ADPCMState& state = states[c];
+                const int16* src = block + (1 + group * 8) * numChannels + c;
+                for (uint32 i = 0; i < 8; i += 2)
+                {
+                    const int32 low = state.Encode(src[i * numChannels]);
+                    const int32 high = state.Encode(src[(i + 1) * numChannels]);
+                    *output++ = (byte)(low | (high << 4));
+                }
+            }
+        }
+    }
+}
+
+void AudioTool::ConvertFromADPCM(const byte* input, int16* output, uint32 numSamples, uint32 numChannels)
+{
+    int16 block[AUDIO_ADPCM_BLOCK_SAMPLES * 8];
+    ASSERT(numChannels <= 8);
+    const uint32 blockSize = AUDIO_ADPCM_BLOCK_SIZE * numChannels;
+    for (uint32 start = 0; start < numSamples; start += AUDIO_ADPCM_BLOCK_SAMPLES)
+    {
+        const uint32 count = Math::Min<uint32>(numSamples - start, AUDIO_ADPCM_BLOCK_SAMPLES);
+        if (count == AUDIO_ADPCM_BLOCK_SAMPLES)
+        {
+            DecodeADPCMBlock(input, output, numChannels);
+        }
+        else
+        {
+            // Skip padding in the last block
+            DecodeADPCMBlock(input, block, numChannels);
+            Platform::MemoryCopy(output, block, count * numChannels * sizeof(int16));
+        }
+        input += blockSize;
+        output += count * numChannels;
+    }
+}
+
+void AudioTool::DecodeADPCMBlock(const byte* input, int16* output, uint32 numChannels)
+{
+    ASSERT(numChannels <= 8);
+    ADPCMState states[8];
+    for (uint32 c = 0; c < numChannels; c++)
+    {
+        ADPCMState& state = states[c];
+        state.Predictor = (int16)(input[0] | (input[1] << 8));
+        state.Index = Math::Min<int32>(input[2], 88);
+        output[c] = (int16)state.Predictor;
+        input += 4;
+    }
+    for (uint32 group = 0; group < (AUDIO_ADPCM_BLOCK_SAMPLES - 1) / 8; group++)
+    {
+        for (uint32 c = 0; c < numChannels; c++)
+        {
+            ADPCMState& state = states[c];
+            int16* dst = output + (1 + group * 8) * numChannels + c;
+            for (uint32 i = 0; i < 8; i += 2)
+            {
+                const byte data = *input++;
+                state.Update(data & 0xf);
+                dst[i * numChannels] = (int16)state.Predictor;
+                state.Update(data >> 4);
+                dst[(i + 1) * numChannels] = (int16)state.Predictor;
+            }
+        }
+    }
+}
+
 #endif
@@ -119,6 +119,40 @@ API_CLASS(Namespace="FlaxEngine.Tools", Static) class FLAXENGINE_API AudioTool
     /// <param name="numSamples">The total number of samples to process.</param>
     static void ConvertFromFloat(const float* input, int32* output, uint32 numSamples);
 
+    /// <summary>
+    /// Calculates the size of the IMA ADPCM data (in bytes) that stores the given amount of samples. Data is stored in blocks of AUDIO_ADPCM_BLOCK_SAMPLES samples per channel (the last block is padded).
+    /// </summary>
+    /// <param name="numSamples">The number of samples per a single channel.</param>
+    /// <param name="numChannels">The number of channels.</param>
+    /// <returns>The compressed data size (in bytes).</returns>
+    static uint32 GetADPCMSize(uint32 numSamples, uint32 numChannels);
+
+    /// <summary>
+    /// Compresses a set of 16-bit PCM audio samples into IMA ADPCM data.
+    /// </summary>
+    /// <param name="input">A set of input samples. Per-channels samples should be interleaved. Total size of the buffer should be (numSamples * numChannels * sizeof(int16)).</param>
+    /// <param name="output">The pre-allocated buffer to store the compressed data. Should be of GetADPCMSize(numSamples, numChannels) size.</param>
+    /// <param name="numSamples">The number of samples per a single channel.</param>
+    /// <param name="numChannels">The number of channels in the input data.</param>
+    static void ConvertToADPCM(const int16* input, byte* output, uint32 numSamples, uint32 numChannels);
+
+    /// <summary>
+    /// Decompresses IMA ADPCM data into a set of 16-bit PCM audio samples.
+    /// </summary>
+    /// <param name="input">The compressed data. Total size of the buffer should be GetADPCMSize(numSamples, numChannels).</param>
+    /// <param name="output">The pre-allocated buffer to store the interleaved samples. Total size of the buffer should be (numSamples * numChannels * sizeof(int16)).</param>
+    /// <param name="numSamples">The number of samples per a single channel.</param>
+    /// <param name="numChannels">The number of channels in the data.</param>
+    static void ConvertFromADPCM(const byte* input, int16* output, uint32 numSamples, uint32 numChannels);
+
+    /// <summary>
+    /// Decompresses a single IMA ADPCM block into a set of 16-bit PCM audio samples. Can be used to decode the compressed data on the fly during playback.
+    /// </summary>
+    /// <param name="input">The compressed block data. Total size of the buffer should be (AUDIO_ADPCM_BLOCK_SIZE * numChannels).</param>
+    /// <param name="output">The pre-allocated buffer to store the interleaved samples. Total size of the buffer should be (AUDIO_ADPCM_BLOCK_SAMPLES * numChannels * sizeof(int16)).</param>
+    /// <param name="numChannels">The number of channels in the data.</param>
+    static void DecodeADPCMBlock(const byte* input, int16* output, uint32 numChannels);
+
     /// <summary>
     /// Converts a 24-bit signed integer into a 32-bit signed integer.
     /// </summary>
@@ -74,11 +74,12 @@ MaterialValue* MaterialGenerator::sampleTextureRaw(Node* caller, Value& value, B
         // Sample texture
         if (isNormalMap)
         {
-            const Char* format = canUseSample ? TEXT("{0}.Sample({1}, {2}).xyz") : TEXT("{0}.SampleLevel({1}, {2}, 0).xyz");
+            const Char* format = canUseSample ? TEXT("{0}.SampleBias({1}, {2}, MATERIAL_MIP_BIAS).xyz") : TEXT("{0}.SampleLevel({1}, {2}, 0).xyz");
 
             // Sample encoded normal map
             const String sampledValue = String::Format(format, texture->ShaderName, sampler, uv);
             const auto normalVector = writeLocal(VariantType::Float3, sampledValue, parent);
+            writeTextureFeedback(texture, sampler, uv);
 
             // Decode normal vector
             _writer.Write(TEXT("\t{0}.xy = {0}.xy * 2.0 - 1.0;\n"), normalVector.Value);
@@ -103,19 +104,27 @@ MaterialValue* MaterialGenerator::sampleTextureRaw(Node* caller, Value& value, B
                 }
                 else*/
                 {
-                    format = canUseSample ? TEXT("{0}.Sample({1}, {2})") : TEXT("{0}.SampleLevel({1}, {2}, 0)");
+                    format = canUseSample ? TEXT("{0}.SampleBias({1}, {2}, MATERIAL_MIP_BIAS)") : TEXT("{0}.SampleLevel({1}, {2}, 0)");
                 }
             }
 
             // Sample texture
             String sampledValue = String::Format(format, texture->ShaderName, sampler, uv, _ddx.Value, _ddy.Value);
             valueBox->Cache = writeLocal(VariantType::Float4, sampledValue, parent);
+            writeTextureFeedback(texture, sampler, uv);
         }
     }
 
     return &valueBox->Cache;
 }
 
+void MaterialGenerator::writeTextureFeedback(const SerializedMaterialParam* texture, const Char* sampler, const String& uv)
+{
+    // Record the sampled mip level of the streamed textures (used only by the texture feedback pass, see TextureFeedback.hlsl)
+    if ((texture->Type == MaterialParameterType::Texture || texture->Type == MaterialParameterType::NormalMap) && CanUseSample(_treeType))
+        _writer.Write(TEXT("\tTEXTURE_FEEDBACK({0}, {1}, {2}, {3});\n"), (int32)texture->RegisterIndex, texture->ShaderName, sampler, uv);
+}
+
 void MaterialGenerator::sampleTexture(Node* caller, Value& value, Box* box, SerializedMaterialParam* texture)
 {
     const auto sample = sampleTextureRaw(caller, value, box, texture);
@@ -573,12 +582,14 @@ void MaterialGenerator::ProcessGroupTextures(Box* box, Node* node, Value& value)
             else
             {
                 if (useOffset)
-                    format = TEXT("{0}.Sample({1}, {2}, {4})");
+                    format = TEXT("{0}.SampleBias({1}, {2}, MATERIAL_MIP_BIAS, {4})");
                 else
-                    format = TEXT("{0}.Sample({1}, {2})");
+                    format = TEXT("{0}.SampleBias({1}, {2}, MATERIAL_MIP_BIAS)");
             }
             const String sampledValue = String::Format(format, texture.Value, samplerName, uvs.Value, level.Value, offset.Value);
             textureBox->Cache = writeLocal(VariantType::Float4, sampledValue, node);
+            if (!useLevel)
+                writeTextureFeedback(textureParam, samplerName, uvs.Value);
         }
         else
         {
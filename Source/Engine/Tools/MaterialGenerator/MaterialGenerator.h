@@ -182,6 +182,7 @@ class MaterialGenerator : public ShaderGenerator
 
     MaterialValue* sampleTextureRaw(Node* caller, Value& value, Box* box, SerializedMaterialParam* texture);
     void sampleTexture(Node* caller, Value& value, Box* box, SerializedMaterialParam* texture);
+    void writeTextureFeedback(const SerializedMaterialParam* texture, const Char* sampler, const String& uv);
     void sampleSceneDepth(Node* caller, Value& value, Box* box);
     void linearizeSceneDepth(Node* caller, const Value& depth, Value& value);
 
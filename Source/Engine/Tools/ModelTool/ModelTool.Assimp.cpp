@@ -766,7 +766,7 @@ bool ModelTool::ImportDataAssimp(const char* path, ModelData& data, Options& opt
         if (options.CalculateTangents)
             flags |= aiProcess_CalcTangentSpace;
         if (options.OptimizeMeshes)
-            flags |= aiProcess_OptimizeMeshes | aiProcess_SplitLargeMeshes | aiProcess_ImproveCacheLocality;
+            flags |= aiProcess_OptimizeMeshes | aiProcess_SplitLargeMeshes;
         if (options.MergeMeshes)
             flags |= aiProcess_RemoveRedundantMaterials;
     }
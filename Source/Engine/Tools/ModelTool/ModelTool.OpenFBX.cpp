@@ -10,6 +10,7 @@
 #include "Engine/Platform/FileSystem.h"
 #include "Engine/Tools/TextureTool/TextureTool.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Platform/File.h"
 
 #define OPEN_FBX_CONVERT_SPACE 1
@@ -524,7 +525,20 @@ bool ImportBones(OpenFbxImporterData& data, String& errorMsg)
     return false;
 }
 
-bool ProcessMesh(ModelData& result, OpenFbxImporterData& data, const ofbx::Mesh* aMesh, MeshData& mesh, String& errorMsg, int32 triangleStart, int32 triangleEnd)
+// Mesh geometry to import (processed in parallel on the job system)
+struct MeshImportJob
+{
+    const ofbx::Mesh* Mesh;
+    int32 TriangleStart;
+    int32 TriangleEnd;
+    int32 NodeIndex;
+    int32 MaterialSlotIndex;
+    MeshData* Data;
+    String ErrorMsg;
+    bool Failed;
+};
+
+bool ProcessMesh(OpenFbxImporterData& data, const ofbx::Mesh* aMesh, MeshData& mesh, String& errorMsg, int32 triangleStart, int32 triangleEnd)
 {
     PROFILE_CPU();
     mesh.Name = aMesh->name;
@@ -542,17 +556,6 @@ bool ProcessMesh(ModelData& result, OpenFbxImporterData& data, const ofbx::Mesh*
     const ofbx::Skin* skin = aGeometry->getSkin();
     const ofbx::BlendShape* blendShape = aGeometry->getBlendShape();
 
-    // Properties
-    const ofbx::Material* aMaterial = nullptr;
-    if (aMesh->getMaterialCount() > 0)
-    {
-        if (aGeometry->getMaterials())
-            aMaterial = aMesh->getMaterial(aGeometry->getMaterials()[triangleStart]);
-        else
-            aMaterial = aMesh->getMaterial(0);
-    }
-    mesh.MaterialSlotIndex = data.AddMaterial(result, aMaterial);
-
     // Vertex positions
     mesh.Positions.Resize(vertexCount, false);
     for (int i = 0; i < vertexCount; i++)
@@ -827,11 +830,6 @@ bool ProcessMesh(ModelData& result, OpenFbxImporterData& data, const ofbx::Mesh*
         }
     }
 
-    if (data.Options.OptimizeMeshes)
-    {
-        mesh.ImproveCacheLocality();
-    }
-
     // Apply FBX Mesh geometry transformation
     /*const Matrix geometryTransform = ToMatrix(aMesh->getGeometricMatrix());
     if (!geometryTransform.IsIdentity())
@@ -856,9 +854,8 @@ bool ProcessMesh(ModelData& result, OpenFbxImporterData& data, const ofbx::Mesh*
     return false;
 }
 
-bool ImportMesh(ModelData& result, OpenFbxImporterData& data, const ofbx::Mesh* aMesh, String& errorMsg, int32 triangleStart, int32 triangleEnd)
+void PrepareMesh(ModelData& result, OpenFbxImporterData& data, const ofbx::Mesh* aMesh, int32 triangleStart, int32 triangleEnd, Array<MeshImportJob>& jobs)
 {
-    PROFILE_CPU();
 
     // Find the parent node
     int32 nodeIndex = data.FindNode(aMesh);
@@ -892,38 +889,43 @@ bool ImportMesh(ModelData& result, OpenFbxImporterData& data, const ofbx::Mesh*
     if (nodeIndex == -1)
     {
         LOG(Warning, "Invalid mesh linkage. Mesh: {0}. Skipping...", String(aMesh->name));
-        return false;
+        return;
     }
 
-    // Import mesh data
-    MeshData* meshData = New<MeshData>();
-    if (ProcessMesh(result, data, aMesh, *meshData, errorMsg, triangleStart, triangleEnd))
-        return true;
-
-    // Link mesh
-    auto& node = data.Nodes[nodeIndex];
-    const int32 lodIndex = node.LodIndex;
-    meshData->NodeIndex = nodeIndex;
-    if (result.LODs.Count() <= lodIndex)
-        result.LODs.Resize(lodIndex + 1);
-    result.LODs[lodIndex].Meshes.Add(meshData);
+    // Properties
+    const ofbx::Geometry* aGeometry = aMesh->getGeometry();
+    const ofbx::Material* aMaterial = nullptr;
+    if (aMesh->getMaterialCount() > 0)
+    {
+        if (aGeometry->getMaterials())
+            aMaterial = aMesh->getMaterial(aGeometry->getMaterials()[triangleStart]);
+        else
+            aMaterial = aMesh->getMaterial(0);
+    }
 
-    return false;
+    // Register mesh for import (node and materials setup is done upfront, geometry is processed later)
+    auto& job = jobs.AddOne();
+    job.Mesh = aMesh;
+    job.TriangleStart = triangleStart;
+    job.TriangleEnd = triangleEnd;
+    job.NodeIndex = nodeIndex;
+    job.MaterialSlotIndex = data.AddMaterial(result, aMaterial);
+    job.Data = nullptr;
+    job.Failed = false;
 }
 
-bool ImportMesh(int32 index, ModelData& result, OpenFbxImporterData& data, String& errorMsg)
+void PrepareMeshes(int32 index, ModelData& result, OpenFbxImporterData& data, Array<MeshImportJob>& jobs)
 {
     const auto aMesh = data.Scene->getMesh(index);
     const auto aGeometry = aMesh->getGeometry();
     const auto trianglesCount = aGeometry->getVertexCount() / 3;
     if (IsMeshInvalid(aMesh))
-        return false;
+        return;
 
     if (aMesh->getMaterialCount() < 2 || !aGeometry->getMaterials())
     {
         // Fast path if mesh is using single material for all triangles
-        if (ImportMesh(result, data, aMesh, errorMsg, 0, trianglesCount - 1))
-            return true;
+        PrepareMesh(result, data, aMesh, 0, trianglesCount - 1, jobs);
     }
     else
     {
@@ -935,16 +937,56 @@ bool ImportMesh(int32 index, ModelData& result, OpenFbxImporterData& data, Strin
         {
             if (rangeStartVal != materials[triangleIndex])
             {
-                if (ImportMesh(result, data, aMesh, errorMsg, rangeStart, triangleIndex - 1))
-                    return true;
+                PrepareMesh(result, data, aMesh, rangeStart, triangleIndex - 1, jobs);
 
                 // Start a new range
                 rangeStart = triangleIndex;
                 rangeStartVal = materials[triangleIndex];
             }
         }
-        if (ImportMesh(result, data, aMesh, errorMsg, rangeStart, trianglesCount - 1))
+        PrepareMesh(result, data, aMesh, rangeStart, trianglesCount - 1, jobs);
+    }
+}
+
+bool ImportMeshes(ModelData& result, OpenFbxImporterData& data, String& errorMsg)
+{
+    PROFILE_CPU();
+    Array<MeshImportJob> jobs;
+    const int meshCount = data.Scene->getMeshCount();
+    for (int32 meshIndex = 0; meshIndex < meshCount; meshIndex++)
+        PrepareMeshes(meshIndex, result, data, jobs);
+
+    // Process meshes geometry in parallel (normals, tangents, lightmap UVs and index buffer generation)
+    JobSystem::ParallelFor(jobs.Count(), [&jobs, &data](int32 start, int32 end)
+    {
+        for (int32 i = start; i < end; i++)
+        {
+            auto& job = jobs[i];
+            job.Data = New<MeshData>();
+            job.Data->MaterialSlotIndex = job.MaterialSlotIndex;
+            job.Failed = ProcessMesh(data, job.Mesh, *job.Data, job.ErrorMsg, job.TriangleStart, job.TriangleEnd);
+        }
+    }, 1);
+    for (auto& job : jobs)
+    {
+        if (job.Failed)
+        {
+            errorMsg = job.ErrorMsg;
+            for (auto& e : jobs)
+                Delete(e.Data);
             return true;
+        }
+    }
+
+    // Link meshes (in the import order)
+    for (auto& job : jobs)
+    {
+        auto& node = data.Nodes[job.NodeIndex];
+        const int32 lodIndex = node.LodIndex;
+        job.Data->NodeIndex = job.NodeIndex;
+        if (result.LODs.Count() <= lodIndex)
+            result.LODs.Resize(lodIndex + 1);
+        result.LODs[lodIndex].Meshes.Add(job.Data);
     }
     return false;
 }
@@ -1255,12 +1297,8 @@ bool ModelTool::ImportDataOpenFBX(const char* path, ModelData& data, Options& op
     // Import geometry (meshes and materials)
     if (EnumHasAnyFlags(options.ImportTypes, ImportDataTypes::Geometry) && context.Scene->getMeshCount() > 0)
     {
-        const int meshCount = context.Scene->getMeshCount();
-        for (int32 meshIndex = 0; meshIndex < meshCount; meshIndex++)
-        {
-            if (ImportMesh(meshIndex, data, context, errorMsg))
-                return true;
-        }
+        if (ImportMeshes(data, context, errorMsg))
+            return true;
     }
 
     // Import skeleton
@@ -361,6 +361,7 @@ void ModelTool::Options::Serialize(SerializeStream& stream, const void* otherObj
     SERIALIZE(SamplingRate);
     SERIALIZE(SkipEmptyCurves);
     SERIALIZE(OptimizeKeyframes);
+    SERIALIZE(KeyframesReductionError);
     SERIALIZE(ImportScaleTracks);
     SERIALIZE(RootMotion);
     SERIALIZE(RootMotionFlags);
@@ -411,6 +412,7 @@ void ModelTool::Options::Deserialize(DeserializeStream& stream, ISerializeModifi
     DESERIALIZE(SamplingRate);
     DESERIALIZE(SkipEmptyCurves);
     DESERIALIZE(OptimizeKeyframes);
+    DESERIALIZE(KeyframesReductionError);
     DESERIALIZE(ImportScaleTracks);
     DESERIALIZE(RootMotion);
     DESERIALIZE(RootMotionFlags);
@@ -690,8 +692,52 @@ void CreateLinearListFromTree(Array<SkeletonNode>& nodes, Array<int32>& mapping)
 
 #endif
 
+FORCE_INLINE float GetKeyframeError(const Float3& a, const Float3& b)
+{
+    return Float3::Distance(a, b);
+}
+
+FORCE_INLINE float GetKeyframeError(const Quaternion& a, const Quaternion& b)
+{
+    return Quaternion::AngleBetween(a, b);
+}
+
 template<typename T>
-void OptimizeCurve(LinearCurve<T>& curve)
+void ReduceCurve(typename LinearCurve<T>::KeyFrameCollection& keyframes, float maxError)
+{
+    // Remove keyframes that can be reconstructed by interpolating the neighbour keyframes within the error threshold
+    const int32 keyCount = keyframes.Count();
+    if (keyCount < 3)
+        return;
+    typename LinearCurve<T>::KeyFrameCollection newKeyframes(keyCount);
+    newKeyframes.Add(keyframes[0]);
+    int32 start = 0;
+    for (int32 end = 2; end < keyCount; end++)
+    {
+        // Check if all keys between start and end can be removed
+        const auto& startKey = keyframes[start];
+        const auto& endKey = keyframes[end];
+        const float length = endKey.Time - startKey.Time;
+        bool canRemove = length > ZeroTolerance;
+        for (int32 i = start + 1; i < end && canRemove; i++)
+        {
+            T value;
+            AnimationUtils::Interpolate(startKey.Value, endKey.Value, (keyframes[i].Time - startKey.Time) / length, value);
+            canRemove = GetKeyframeError(value, keyframes[i].Value) <= maxError;
+        }
+        if (!canRemove)
+        {
+            start = end - 1;
+            newKeyframes.Add(keyframes[start]);
+        }
+    }
+    newKeyframes.Add(keyframes.Last());
+    if (newKeyframes.Count() != keyCount)
+        keyframes.Swap(newKeyframes);
+}
+
+template<typename T>
+void OptimizeCurve(LinearCurve<T>& curve, float maxError)
 {
     auto& oldKeyframes = curve.GetKeyframes();
     const int32 keyCount = oldKeyframes.Count();
@@ -719,6 +765,8 @@ void OptimizeCurve(LinearCurve<T>& curve)
         newKeyframes.Add(curKey);
         lastWasEqual = isEqual;
     }
+    if (maxError > 0.0f)
+        ReduceCurve<T>(newKeyframes, maxError);
 
     // Special case if animation has only two the same keyframes after cleaning
     if (newKeyframes.Count() == 2 && Math::NearEqual(newKeyframes[0].Value, newKeyframes[1].Value))
@@ -1555,9 +1603,9 @@ bool ModelTool::ImportModel(const String& path, ModelData& data, Options& option
                     auto& anim = animation.Channels[i];
 
                     // Optimize keyframes
-                    OptimizeCurve(anim.Position);
-                    OptimizeCurve(anim.Rotation);
-                    OptimizeCurve(anim.Scale);
+                    OptimizeCurve(anim.Position, options.KeyframesReductionError);
+                    OptimizeCurve(anim.Rotation, options.KeyframesReductionError);
+                    OptimizeCurve(anim.Scale, options.KeyframesReductionError);
 
                     // Remove empty channels
                     if (anim.GetKeyframesCount() == 0)
@@ -1647,6 +1695,20 @@ bool ModelTool::ImportModel(const String& path, ModelData& data, Options& option
             LOG(Info, "Merged {0} meshes", meshesMerged);
     }
 
+    // Optimize meshes for the GPU (vertex cache, overdraw and vertex fetch)
+    if (options.OptimizeMeshes && EnumHasAnyFlags(options.ImportTypes, ImportDataTypes::Geometry))
+    {
+        PROFILE_CPU_NAMED("OptimizeMeshes");
+        Array<MeshData*> meshes;
+        for (auto& lod : data.LODs)
+            meshes.Add(lod.Meshes);
+        JobSystem::ParallelFor(meshes.Count(), [&meshes](int32 start, int32 end)
+        {
+            for (int32 i = start; i < end; i++)
+                OptimizeMesh(*meshes[i]);
+        }, 1);
+    }
+
     // Automatic LOD generation
     if (options.GenerateLODs && options.LODCount > 1 && data.LODs.HasItems() && options.TriangleReduction < 1.0f - ZeroTolerance)
     {
@@ -1662,107 +1724,32 @@ bool ModelTool::ImportModel(const String& path, ModelData& data, Options& option
             baseLodTriangleCount += mesh->Indices.Count() / 3;
             baseLodVertexCount += mesh->Positions.Count();
         }
-        Array<unsigned int> indices;
         for (int32 lodIndex = Math::Clamp(baseLOD + 1, 1, lodCount - 1); lodIndex < lodCount; lodIndex++)
         {
             auto& dstLod = data.LODs[lodIndex];
             const auto& srcLod = data.LODs[lodIndex - 1];
 
-            int32 lodTriangleCount = 0, lodVertexCount = 0;
+            // Simplify meshes in parallel (each LOD is generated from the previous one)
             dstLod.Meshes.Resize(srcLod.Meshes.Count());
-            for (int32 meshIndex = 0; meshIndex < dstLod.Meshes.Count(); meshIndex++)
+            JobSystem::ParallelFor(dstLod.Meshes.Count(), [&dstLod, &srcLod, &options, triangleReduction](int32 start, int32 end)
             {
-                auto& dstMesh = dstLod.Meshes[meshIndex] = New<MeshData>();
-                const auto& srcMesh = srcLod.Meshes[meshIndex];
-
-                // Setup mesh
-                dstMesh->MaterialSlotIndex = srcMesh->MaterialSlotIndex;
-                dstMesh->NodeIndex = srcMesh->NodeIndex;
-                dstMesh->Name = srcMesh->Name;
-
-                // Simplify mesh using meshoptimizer
-                int32 srcMeshIndexCount = srcMesh->Indices.Count();
-                int32 srcMeshVertexCount = srcMesh->Positions.Count();
-                int32 dstMeshIndexCountTarget = int32(srcMeshIndexCount * triangleReduction) / 3 * 3;
-                if (dstMeshIndexCountTarget < 3 || dstMeshIndexCountTarget >= srcMeshIndexCount)
-                    continue;
-                indices.Clear();
-                indices.Resize(srcMeshIndexCount);
-                int32 dstMeshIndexCount = {};
-                if (options.SloppyOptimization)
-                    dstMeshIndexCount = (int32)meshopt_simplifySloppy(indices.Get(), srcMesh->Indices.Get(), srcMeshIndexCount, (const float*)srcMesh->Positions.Get(), srcMeshVertexCount, sizeof(Float3), dstMeshIndexCountTarget, options.LODTargetError);
-                else
-                    dstMeshIndexCount = (int32)meshopt_simplify(indices.Get(), srcMesh->Indices.Get(), srcMeshIndexCount, (const float*)srcMesh->Positions.Get(), srcMeshVertexCount, sizeof(Float3), dstMeshIndexCountTarget, options.LODTargetError);
-                if (dstMeshIndexCount <= 0 || dstMeshIndexCount > indices.Count())
-                    continue;
-                indices.Resize(dstMeshIndexCount);
-
-                // Generate simplified vertex buffer remapping table (use only vertices from LOD index buffer)
-                Array<unsigned int> remap;
-                remap.Resize(srcMeshVertexCount);
-                int32 dstMeshVertexCount = (int32)meshopt_optimizeVertexFetchRemap(remap.Get(), indices.Get(), dstMeshIndexCount, srcMeshVertexCount);
-
-                // Remap index buffer
-                dstMesh->Indices.Resize(dstMeshIndexCount);
-                meshopt_remapIndexBuffer(dstMesh->Indices.Get(), indices.Get(), dstMeshIndexCount, remap.Get());
-
-                // Remap vertex buffer
-#define REMAP_VERTEX_BUFFER(name, type) \
-    if (srcMesh->name.HasItems()) \
-    { \
-        ASSERT(srcMesh->name.Count() == srcMeshVertexCount); \
-        dstMesh->name.Resize(dstMeshVertexCount); \
-        meshopt_remapVertexBuffer(dstMesh->name.Get(), srcMesh->name.Get(), srcMeshVertexCount, sizeof(type), remap.Get()); \
-    }
-                REMAP_VERTEX_BUFFER(Positions, Float3);
-                REMAP_VERTEX_BUFFER(UVs, Float2);
-                REMAP_VERTEX_BUFFER(Normals, Float3);
-                REMAP_VERTEX_BUFFER(Tangents, Float3);
-                REMAP_VERTEX_BUFFER(Tangents, Float3);
-                REMAP_VERTEX_BUFFER(LightmapUVs, Float2);
-                REMAP_VERTEX_BUFFER(Colors, Color);
-                REMAP_VERTEX_BUFFER(BlendIndices, Int4);
-                REMAP_VERTEX_BUFFER(BlendWeights, Float4);
-#undef REMAP_VERTEX_BUFFER
-
-                // Remap blend shapes
-                dstMesh->BlendShapes.Resize(srcMesh->BlendShapes.Count());
-                for (int32 blendShapeIndex = 0; blendShapeIndex < srcMesh->BlendShapes.Count(); blendShapeIndex++)
+                for (int32 meshIndex = start; meshIndex < end; meshIndex++)
                 {
-                    const auto& srcBlendShape = srcMesh->BlendShapes[blendShapeIndex];
-                    auto& dstBlendShape = dstMesh->BlendShapes[blendShapeIndex];
+                    auto& dstMesh = dstLod.Meshes[meshIndex] = New<MeshData>();
+                    const auto& srcMesh = srcLod.Meshes[meshIndex];
 
-                    dstBlendShape.Name = srcBlendShape.Name;
-                    dstBlendShape.Weight = srcBlendShape.Weight;
-                    dstBlendShape.Vertices.EnsureCapacity(srcBlendShape.Vertices.Count());
-                    for (int32 i = 0; i < srcBlendShape.Vertices.Count(); i++)
-                    {
-                        auto v = srcBlendShape.Vertices[i];
-                        v.VertexIndex = remap[v.VertexIndex];
-                        if (v.VertexIndex != ~0u)
-                        {
-                            dstBlendShape.Vertices.Add(v);
-                        }
-                    }
-                }
+                    // Setup mesh
+                    dstMesh->MaterialSlotIndex = srcMesh->MaterialSlotIndex;
+                    dstMesh->NodeIndex = srcMesh->NodeIndex;
+                    dstMesh->Name = srcMesh->Name;
 
-                // Remove empty blend shapes
-                for (int32 blendShapeIndex = dstMesh->BlendShapes.Count() - 1; blendShapeIndex >= 0; blendShapeIndex--)
-                {
-                    if (dstMesh->BlendShapes[blendShapeIndex].Vertices.IsEmpty())
-                        dstMesh->BlendShapes.RemoveAt(blendShapeIndex);
+                    // Simplify mesh using meshoptimizer (mesh is left empty on failure)
+                    SimplifyMesh(*srcMesh, *dstMesh, triangleReduction, options.LODTargetError, options.SloppyOptimization);
                 }
-
-                // Optimize generated LOD
-                meshopt_optimizeVertexCache(dstMesh->Indices.Get(), dstMesh->Indices.Get(), dstMeshIndexCount, dstMeshVertexCount);
-                meshopt_optimizeOverdraw(dstMesh->Indices.Get(), dstMesh->Indices.Get(), dstMeshIndexCount, (const float*)dstMesh->Positions.Get(), dstMeshVertexCount, sizeof(Float3), 1.05f);
-
-                lodTriangleCount += dstMeshIndexCount / 3;
-                lodVertexCount += dstMeshVertexCount;
-                generatedLod++;
-            }
+            }, 1);
 
             // Remove empty meshes (no LOD was generated for them)
+            int32 lodTriangleCount = 0, lodVertexCount = 0;
             for (int32 i = dstLod.Meshes.Count() - 1; i >= 0; i--)
             {
                 MeshData* mesh = dstLod.Meshes[i];
@@ -1770,7 +1757,11 @@ bool ModelTool::ImportModel(const String& path, ModelData& data, Options& option
                 {
                     Delete(mesh);
                     dstLod.Meshes.RemoveAtKeepOrder(i);
+                    continue;
                 }
+                lodTriangleCount += mesh->Indices.Count() / 3;
+                lodVertexCount += mesh->Positions.Count();
+                generatedLod++;
             }
 
             LOG(Info, "Generated LOD{0}: triangles: {1} ({2}% of base LOD), verticies: {3} ({4}% of base LOD)",
@@ -1823,6 +1814,212 @@ bool ModelTool::ImportModel(const String& path, ModelData& data, Options& option
     return false;
 }
 
+bool ModelTool::SimplifyMesh(const MeshData& srcMesh, MeshData& dstMesh, float triangleReduction, float targetError, bool sloppy)
+{
+    PROFILE_CPU();
+    meshopt_setAllocator(MeshOptAllocate, MeshOptDeallocate);
+
+    int32 srcMeshIndexCount = srcMesh.Indices.Count();
+    int32 srcMeshVertexCount = srcMesh.Positions.Count();
+    int32 dstMeshIndexCountTarget = int32(srcMeshIndexCount * Math::Saturate(triangleReduction)) / 3 * 3;
+    if (dstMeshIndexCountTarget < 3 || dstMeshIndexCountTarget >= srcMeshIndexCount)
+        return true;
+    Array<unsigned int> indices;
+    indices.Resize(srcMeshIndexCount);
+    int32 dstMeshIndexCount = {};
+    if (sloppy)
+        dstMeshIndexCount = (int32)meshopt_simplifySloppy(indices.Get(), srcMesh.Indices.Get(), srcMeshIndexCount, (const float*)srcMesh.Positions.Get(), srcMeshVertexCount, sizeof(Float3), dstMeshIndexCountTarget, targetError);
+    else
+        dstMeshIndexCount = (int32)meshopt_simplify(indices.Get(), srcMesh.Indices.Get(), srcMeshIndexCount, (const float*)srcMesh.Positions.Get(), srcMeshVertexCount, sizeof(Float3), dstMeshIndexCountTarget, targetError);
+    if (dstMeshIndexCount <= 0 || dstMeshIndexCount > indices.Count())
+        return true;
+    indices.Resize(dstMeshIndexCount);
+
+    // Generate simplified vertex buffer remapping table (use only vertices from LOD index buffer)
+    Array<unsigned int> remap;
+    remap.Resize(srcMeshVertexCount);
+    int32 dstMeshVertexCount = (int32)meshopt_optimizeVertexFetchRemap(remap.Get(), indices.Get(), dstMeshIndexCount, srcMeshVertexCount);
+
+    // Remap index buffer
+    dstMesh.Indices.Resize(dstMeshIndexCount);
+    meshopt_remapIndexBuffer(dstMesh.Indices.Get(), indices.Get(), dstMeshIndexCount, remap.Get());
+
+    // Remap vertex buffer
+#define REMAP_VERTEX_BUFFER(name, type) \
+    if (srcMesh.name.HasItems()) \
+    { \
+        ASSERT(srcMesh.name.Count() == srcMeshVertexCount); \
+        dstMesh.name.Resize(dstMeshVertexCount); \
+        meshopt_remapVertexBuffer(dstMesh.name.Get(), srcMesh.name.Get(), srcMeshVertexCount, sizeof(type), remap.Get()); \
+    }
+    REMAP_VERTEX_BUFFER(Positions, Float3);
+    REMAP_VERTEX_BUFFER(UVs, Float2);
+    REMAP_VERTEX_BUFFER(Normals, Float3);
+    REMAP_VERTEX_BUFFER(Tangents, Float3);
+    REMAP_VERTEX_BUFFER(Tangents, Float3);
+    REMAP_VERTEX_BUFFER(LightmapUVs, Float2);
+    REMAP_VERTEX_BUFFER(Colors, Color);
+    REMAP_VERTEX_BUFFER(BlendIndices, Int4);
+    REMAP_VERTEX_BUFFER(BlendWeights, Float4);
+#undef REMAP_VERTEX_BUFFER
+
+    // Remap blend shapes
+    dstMesh.BlendShapes.Resize(srcMesh.BlendShapes.Count());
+    for (int32 blendShapeIndex = 0; blendShapeIndex < srcMesh.BlendShapes.Count(); blendShapeIndex++)
+    {
+        const auto& srcBlendShape = srcMesh.BlendShapes[blendShapeIndex];
+        auto& dstBlendShape = dstMesh.BlendShapes[blendShapeIndex];
+
+        dstBlendShape.Name = srcBlendShape.Name;
+        dstBlendShape.Weight = srcBlendShape.Weight;
+        dstBlendShape.Vertices.EnsureCapacity(srcBlendShape.Vertices.Count());
+        for (int32 i = 0; i < srcBlendShape.Vertices.Count(); i++)
+        {
+            auto v = srcBlendShape.Vertices[i];
+            v.VertexIndex = remap[v.VertexIndex];
+            if (v.VertexIndex != ~0u)
+            {
+                dstBlendShape.Vertices.Add(v);
+            }
+        }
+    }
+
+    // Remove empty blend shapes
+    for (int32 blendShapeIndex = dstMesh.BlendShapes.Count() - 1; blendShapeIndex >= 0; blendShapeIndex--)
+    {
+        if (dstMesh.BlendShapes[blendShapeIndex].Vertices.IsEmpty())
+            dstMesh.BlendShapes.RemoveAt(blendShapeIndex);
+    }
+
+    // Optimize generated LOD
+    meshopt_optimizeVertexCache(dstMesh.Indices.Get(), dstMesh.Indices.Get(), dstMeshIndexCount, dstMeshVertexCount);
+    meshopt_optimizeOverdraw(dstMesh.Indices.Get(), dstMesh.Indices.Get(), dstMeshIndexCount, (const float*)dstMesh.Positions.Get(), dstMeshVertexCount, sizeof(Float3), 1.05f);
+
+    return false;
+}
+
+void ModelTool::OptimizeMesh(MeshData& mesh)
+{
+    const int32 indexCount = mesh.Indices.Count();
+    const int32 vertexCount = mesh.Positions.Count();
+    if (indexCount < 3 || vertexCount == 0)
+        return;
+    PROFILE_CPU();
+    meshopt_setAllocator(MeshOptAllocate, MeshOptDeallocate);
+
+    // Reorder triangles for the vertex cache and then for the overdraw (threshold allows to slightly degrade the cache efficiency)
+    meshopt_optimizeVertexCache(mesh.Indices.Get(), mesh.Indices.Get(), indexCount, vertexCount);
+    meshopt_optimizeOverdraw(mesh.Indices.Get(), mesh.Indices.Get(), indexCount, (const float*)mesh.Positions.Get(), vertexCount, sizeof(Float3), 1.05f);
+
+    // Reorder vertices in the order of use by the index buffer (unused vertices are removed)
+    Array<unsigned int> remap;
+    remap.Resize(vertexCount);
+    const int32 dstVertexCount = (int32)meshopt_optimizeVertexFetchRemap(remap.Get(), mesh.Indices.Get(), indexCount, vertexCount);
+    meshopt_remapIndexBuffer(mesh.Indices.Get(), mesh.Indices.Get(), indexCount, remap.Get());
+#define REMAP_VERTEX_BUFFER(name, type) \
+    if (mesh.name.Count() == vertexCount) \
+    { \
+        meshopt_remapVertexBuffer(mesh.name.Get(), mesh.name.Get(), vertexCount, sizeof(type), remap.Get()); \
+        mesh.name.Resize(dstVertexCount); \
+    }
+    REMAP_VERTEX_BUFFER(Positions, Float3);
+    REMAP_VERTEX_BUFFER(UVs, Float2);
+    REMAP_VERTEX_BUFFER(Normals, Float3);
+    REMAP_VERTEX_BUFFER(Tangents, Float3);
+    REMAP_VERTEX_BUFFER(BitangentSigns, float);
+    REMAP_VERTEX_BUFFER(LightmapUVs, Float2);
+    REMAP_VERTEX_BUFFER(Colors, Color);
+    REMAP_VERTEX_BUFFER(BlendIndices, Int4);
+    REMAP_VERTEX_BUFFER(BlendWeights, Float4);
+#undef REMAP_VERTEX_BUFFER
+
+    // Remap blend shapes
+    for (int32 blendShapeIndex = mesh.BlendShapes.Count() - 1; blendShapeIndex >= 0; blendShapeIndex--)
+    {
+        auto& blendShape = mesh.BlendShapes[blendShapeIndex];
+        for (int32 i = blendShape.Vertices.Count() - 1; i >= 0; i--)
+        {
+            auto& v = blendShape.Vertices[i];
+            v.VertexIndex = v.VertexIndex < (uint32)vertexCount ? remap[v.VertexIndex] : ~0u;
+            if (v.VertexIndex == ~0u)
+                blendShape.Vertices.RemoveAt(i);
+        }
+        if (blendShape.Vertices.IsEmpty())
+            mesh.BlendShapes.RemoveAt(blendShapeIndex);
+    }
+}
+
+bool ModelTool::BuildMeshlets(const Float3* positions, uint32 verticesCount, void* indices, uint32 indicesCount, bool use16BitIndices, Array<ModelMeshlet>& meshlets)
+{
+    PROFILE_CPU();
+    if (!positions || !indices || indicesCount < 3 || indicesCount % 3 != 0)
+        return true;
+    meshopt_setAllocator(MeshOptAllocate, MeshOptDeallocate);
+
+    // Build clusters
+    Array<uint32> srcIndices;
+    srcIndices.Resize(indicesCount);
+    if (use16BitIndices)
+    {
+        for (uint32 i = 0; i < indicesCount; i++)
+            srcIndices.Get()[i] = ((const uint16*)indices)[i];
+    }
+    else
+    {
+        Platform::MemoryCopy(srcIndices.Get(), indices, indicesCount * sizeof(uint32));
+    }
+    const int32 maxClusters = (int32)meshopt_buildMeshletsBound(indicesCount, MODEL_MESHLET_MAX_VERTICES, MODEL_MESHLET_MAX_TRIANGLES);
+    Array<meshopt_Meshlet> clusters;
+    Array<uint32> clusterVertices;
+    Array<byte> clusterTriangles;
+    clusters.Resize(maxClusters);
+    clusterVertices.Resize(maxClusters * MODEL_MESHLET_MAX_VERTICES);
+    clusterTriangles.Resize(maxClusters * MODEL_MESHLET_MAX_TRIANGLES * 3);
+    const int32 clustersCount = (int32)meshopt_buildMeshlets(clusters.Get(), clusterVertices.Get(), clusterTriangles.Get(), srcIndices.Get(), indicesCount, (const float*)positions, verticesCount, sizeof(Float3), MODEL_MESHLET_MAX_VERTICES, MODEL_MESHLET_MAX_TRIANGLES, 0.25f);
+
+    // Compute culling bounds and place the meshlets triangles in a contiguous index ranges (triangles winding is preserved)
+    Array<uint32> dstIndices;
+    dstIndices.Resize(indicesCount);
+    meshlets.Resize(clustersCount);
+    uint32 index = 0;
+    for (int32 i = 0; i < clustersCount; i++)
+    {
+        const meshopt_Meshlet& cluster = clusters.Get()[i];
+        const uint32 clusterIndicesCount = cluster.triangle_count * 3;
+        if (index + clusterIndicesCount > indicesCount)
+            return true;
+        const meshopt_Bounds bounds = meshopt_computeMeshletBounds(&clusterVertices[cluster.vertex_offset], &clusterTriangles[cluster.triangle_offset], cluster.triangle_count, (const float*)positions, verticesCount, sizeof(Float3));
+        ModelMeshlet& meshlet = meshlets.Get()[i];
+        meshlet.Center = Float3(bounds.center[0], bounds.center[1], bounds.center[2]);
+        meshlet.Radius = bounds.radius;
+        meshlet.ConeApex = Float3(bounds.cone_apex[0], bounds.cone_apex[1], bounds.cone_apex[2]);
+        meshlet.ConeCutoff = bounds.cone_cutoff;
+        meshlet.ConeAxis = Float3(bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2]);
+        meshlet.StartIndex = index;
+        meshlet.IndicesCount = clusterIndicesCount;
+        for (uint32 j = 0; j < clusterIndicesCount; j++)
+            dstIndices.Get()[index++] = clusterVertices[cluster.vertex_offset + clusterTriangles[cluster.triangle_offset + j]];
+    }
+    if (index != indicesCount)
+    {
+        // Some triangles were not included (eg. degenerated ones)
+        meshlets.Clear();
+        return true;
+    }
+
+    // Write the reordered indices
+    if (use16BitIndices)
+    {
+        for (uint32 i = 0; i < indicesCount; i++)
+            ((uint16*)indices)[i] = (uint16)dstIndices.Get()[i];
+    }
+    else
+    {
+        Platform::MemoryCopy(indices, dstIndices.Get(), indicesCount * sizeof(uint32));
+    }
+    return false;
+}
+
 int32 ModelTool::DetectLodIndex(const String& nodeName)
 {
     int32 index = nodeName.FindLast(TEXT("LOD"), StringSearchCase::IgnoreCase);
@@ -170,7 +170,7 @@ API_CLASS(Namespace="FlaxEngine.Tools", Static) class FLAXENGINE_API ModelTool
         // Specifies the maximum angle (in degrees) that may be between two vertex tangents before their tangents and bi-tangents are smoothed. The default value is 45.
         API_FIELD(Attributes="EditorOrder(45), EditorDisplay(\"Geometry\"), VisibleIf(nameof(ShowSmoothingTangentsAngle)), Limit(0, 45, 0.1f)")
         float SmoothingTangentsAngle = 45.0f;
-        // Enable/disable meshes geometry optimization.
+        // Enable/disable meshes geometry optimization (vertex cache, overdraw and vertex fetch order of the imported and generated meshes).
         API_FIELD(Attributes="EditorOrder(50), EditorDisplay(\"Geometry\"), VisibleIf(nameof(ShowGeometry))")
         bool OptimizeMeshes = true;
         // Enable/disable geometry merge for meshes with the same materials. Index buffer will be reordered to improve performance and other modifications will be applied. However, importing time will be increased.
@@ -236,6 +236,9 @@ API_CLASS(Namespace="FlaxEngine.Tools", Static) class FLAXENGINE_API ModelTool
         // The imported animation channels will be optimized to remove redundant keyframes.
         API_FIELD(Attributes="EditorOrder(1050), EditorDisplay(\"Animation\"), VisibleIf(nameof(ShowAnimation))")
         bool OptimizeKeyframes = true;
+        // The maximum error allowed when removing the keyframes that can be interpolated from the neighbour keyframes during animation keyframes optimization (in units for position and scale, in degrees for rotation). Use 0 to remove only the duplicated keyframes.
+        API_FIELD(Attributes="EditorOrder(1051), EditorDisplay(\"Animation\"), VisibleIf(nameof(ShowAnimation)), Limit(0, 10, 0.0001f)")
+        float KeyframesReductionError = 0.001f;
         // If checked, the importer will import scale animation tracks (otherwise scale animation will be ignored).
         API_FIELD(Attributes="EditorOrder(1055), EditorDisplay(\"Animation\"), VisibleIf(nameof(ShowAnimation))")
         bool ImportScaleTracks = false;
@@ -356,6 +359,35 @@ API_CLASS(Namespace="FlaxEngine.Tools", Static) class FLAXENGINE_API ModelTool
     /// <returns>True if fails, otherwise false.</returns>
     static bool ImportModel(const String& path, ModelData& data, Options& options, String& errorMsg, const String& autoImportOutput = String::Empty);
 
+    /// <summary>
+    /// Builds the meshlets (small clusters of triangles with culling bounds) for the mesh and reorders its index buffer so each meshlet uses a contiguous range of indices.
+    /// </summary>
+    /// <param name="positions">The vertex positions.</param>
+    /// <param name="verticesCount">The vertices count.</param>
+    /// <param name="indices">The index buffer data (modified in-place).</param>
+    /// <param name="indicesCount">The indices count.</param>
+    /// <param name="use16BitIndices">True if index buffer uses 16-bit indices, otherwise 32-bit.</param>
+    /// <param name="meshlets">The output meshlets.</param>
+    /// <returns>True if fails, otherwise false.</returns>
+    static bool BuildMeshlets(const Float3* positions, uint32 verticesCount, void* indices, uint32 indicesCount, bool use16BitIndices, Array<ModelMeshlet>& meshlets);
+
+    /// <summary>
+    /// Generates the simplified version of the mesh (eg. for LODs or proxy meshes).
+    /// </summary>
+    /// <param name="srcMesh">The source mesh.</param>
+    /// <param name="dstMesh">The output mesh (vertex and index buffers are overriden).</param>
+    /// <param name="triangleReduction">The target amount of triangles (normalized to range 0-1 of the source mesh triangles count).</param>
+    /// <param name="targetError">The maximum allowed error of the simplification (relative to the mesh size).</param>
+    /// <param name="sloppy">True if use faster simplification that doesn't preserve the mesh topology.</param>
+    /// <returns>True if fails (eg. mesh cannot be simplified), otherwise false.</returns>
+    static bool SimplifyMesh(const MeshData& srcMesh, MeshData& dstMesh, float triangleReduction, float targetError, bool sloppy = false);
+
+    /// <summary>
+    /// Optimizes the mesh for the GPU rendering: reorders triangles for the post-transform vertex cache and to reduce overdraw, then reorders vertices (and removes unused ones) for the vertex fetch locality.
+    /// </summary>
+    /// <param name="mesh">The mesh to optimize (modified in-place).</param>
+    static void OptimizeMesh(MeshData& mesh);
+
 public:
     static int32 DetectLodIndex(const String& nodeName);
     static bool FindTexture(const String& sourcePath, const String& file, String& path);
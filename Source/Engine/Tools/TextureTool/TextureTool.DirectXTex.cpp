@@ -36,10 +36,11 @@ namespace
         return static_cast<DXGI_FORMAT>(format);
     }
 
-    HRESULT Compress(const DirectX::Image* srcImages, size_t nimages, const DirectX::TexMetadata& metadata, DXGI_FORMAT format, DWORD compress, float threshold, DirectX::ScratchImage& cImages)
+    HRESULT CompressGPU(const DirectX::Image* srcImages, size_t nimages, const DirectX::TexMetadata& metadata, DXGI_FORMAT format, DWORD compress, DirectX::ScratchImage& cImages)
     {
 #if USE_EDITOR
         if ((format == DXGI_FORMAT_BC7_UNORM || format == DXGI_FORMAT_BC7_UNORM_SRGB || format == DXGI_FORMAT_BC6H_UF16 || format == DXGI_FORMAT_BC6H_SF16) &&
+            TextureTool::CompressionUseGPU &&
             GPUDevice::Instance &&
             GPUDevice::Instance->GetState() == GPUDevice::DeviceState::Ready &&
             GPUDevice::Instance->GetRendererType() == RendererType::DirectX11)
@@ -111,6 +112,32 @@ namespace
             return task->CompressResult;
         }
 #endif
+        return E_NOTIMPL;
+    }
+
+    HRESULT Compress(const DirectX::Image* srcImages, size_t nimages, const DirectX::TexMetadata& metadata, DXGI_FORMAT format, DWORD compress, float threshold, DirectX::ScratchImage& cImages)
+    {
+        // Map compression quality into the encoder options
+        switch (TextureTool::CompressionQuality)
+        {
+        case TextureCompressionQuality::Fast:
+            compress |= DirectX::TEX_COMPRESS_BC7_QUICK;
+            break;
+        case TextureCompressionQuality::High:
+            compress |= DirectX::TEX_COMPRESS_BC7_USE_3SUBSETS;
+            break;
+        default: ;
+        }
+
+        // Try GPU compression (if supported) with a fallback to CPU
+        HRESULT result = CompressGPU(srcImages, nimages, metadata, format, compress, cImages);
+        if (result == S_OK)
+            return result;
+        if (result != E_NOTIMPL)
+        {
+            LOG(Warning, "GPU texture compression failed (result: {0}). Using CPU encoder.", (int32)result);
+            cImages.Release();
+        }
         return DirectX::Compress(srcImages, nimages, metadata, format, compress, threshold, cImages);
     }
 }
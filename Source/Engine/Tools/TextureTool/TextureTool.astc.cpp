@@ -9,8 +9,14 @@
 #include "Engine/Graphics/PixelFormatExtensions.h"
 #include "Engine/Graphics/RenderTools.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/JobSystem.h"
 #include <ThirdParty/astc/astcenc.h>
 
+// Minimum amount of rows of blocks compressed by a single job (large mips are split into the horizontal strips compressed in parallel)
+#define TEXTURE_TOOL_ASTC_PARALLEL_MIN_ROWS 16
+// Maximum amount of strips (and compressor contexts) used to compress a single mip
+#define TEXTURE_TOOL_ASTC_MAX_STRIPS 32
+
 bool TextureTool::ConvertAstc(TextureData& dst, const TextureData& src, const PixelFormat dstFormat)
 {
     PROFILE_CPU();
@@ -22,7 +28,19 @@ bool TextureTool::ConvertAstc(TextureData& dst, const TextureData& src, const Pi
     const bool isSRGB = PixelFormatExtensions::IsSRGB(dstFormat);
     const bool isHDR = PixelFormatExtensions::IsHDR(src.Format);
     astcenc_profile astcProfile = isHDR ? ASTCENC_PRF_HDR_RGB_LDR_A : (isSRGB ? ASTCENC_PRF_LDR_SRGB : ASTCENC_PRF_LDR);
-    float astcQuality = ASTCENC_PRE_MEDIUM;
+    float astcQuality;
+    switch (CompressionQuality)
+    {
+    case TextureCompressionQuality::Fast:
+        astcQuality = ASTCENC_PRE_FAST;
+        break;
+    case TextureCompressionQuality::High:
+        astcQuality = ASTCENC_PRE_THOROUGH;
+        break;
+    default:
+        astcQuality = ASTCENC_PRE_MEDIUM;
+        break;
+    }
     unsigned int astcFlags = 0; // TODO: add custom flags support for converter to handle ASTCENC_FLG_MAP_NORMAL
     astcenc_config astcConfig;
 	astcenc_error astcError = astcenc_config_init(astcProfile, blockSize, blockSize, 1, astcQuality, astcFlags, &astcConfig);
@@ -38,9 +56,11 @@ bool TextureTool::ConvertAstc(TextureData& dst, const TextureData& src, const Pi
         astcSwizzle.a = ASTCENC_SWZ_1;
     }
 
-    // Allocate working state given config and thread_count
-    astcenc_context* astcContext;
-    astcError = astcenc_context_alloc(&astcConfig, 1, &astcContext);
+    // Allocate working state given config and thread_count (other contexts for the parallel strips are allocated on use)
+    astcenc_context* astcContexts[TEXTURE_TOOL_ASTC_MAX_STRIPS] = {};
+    astcenc_error astcErrors[TEXTURE_TOOL_ASTC_MAX_STRIPS] = {};
+    const int32 maxStrips = Math::Clamp(JobSystem::GetThreadsCount(), 1, TEXTURE_TOOL_ASTC_MAX_STRIPS);
+    astcError = astcenc_context_alloc(&astcConfig, 1, &astcContexts[0]);
     if (astcError != ASTCENC_SUCCESS)
     {
         LOG(Warning, "Cannot compress image. ASTC failed with error: {}", String(astcenc_get_error_string(astcError)));
@@ -110,28 +130,57 @@ bool TextureTool::ConvertAstc(TextureData& dst, const TextureData& src, const Pi
             dstMip.Lines = blocksHeight;
             dstMip.Data.Allocate(dstMip.DepthPitch);
 
-            // Compress image
-            astcenc_image astcInput;
-            astcInput.dim_x = mipWidth;
-            astcInput.dim_y = mipHeight;
-            astcInput.dim_z = 1;
-            astcInput.data_type = isHDR ? ASTCENC_TYPE_F16 : ASTCENC_TYPE_U8;
-            void* srcData = (void*)srcMip.Data.Get();
-            astcInput.data = &srcData;
-            astcError = astcenc_compress_image(astcContext, &astcInput, &astcSwizzle, dstMip.Data.Get(), dstMip.Data.Length(), 0);
-            if (astcError == ASTCENC_SUCCESS)
-                astcError = astcenc_compress_reset(astcContext);
+            // Compress image (blocks are independent so the image is split into the horizontal strips of blocks compressed in parallel, the output is the same as from a single run over the whole image)
+            const int32 strips = Math::Clamp(blocksHeight / TEXTURE_TOOL_ASTC_PARALLEL_MIN_ROWS, 1, maxStrips);
+            const int32 stripRows = Math::DivideAndRoundUp(blocksHeight, strips);
+            Function<void(int32)> compressStrip = [&](int32 strip)
+            {
+                const int32 rowStart = strip * stripRows;
+                const int32 rowEnd = Math::Min(rowStart + stripRows, blocksHeight);
+                astcErrors[strip] = ASTCENC_SUCCESS;
+                if (rowStart >= rowEnd)
+                    return;
+                astcenc_context*& astcContext = astcContexts[strip];
+                if (!astcContext)
+                {
+                    astcErrors[strip] = astcenc_context_alloc(&astcConfig, 1, &astcContext);
+                    if (astcErrors[strip] != ASTCENC_SUCCESS)
+                        return;
+                }
+                const int32 pixelStart = rowStart * blockSize;
+                astcenc_image astcInput;
+                astcInput.dim_x = mipWidth;
+                astcInput.dim_y = Math::Min(rowEnd * blockSize, mipHeight) - pixelStart;
+                astcInput.dim_z = 1;
+                astcInput.data_type = isHDR ? ASTCENC_TYPE_F16 : ASTCENC_TYPE_U8;
+                void* srcData = (void*)(srcMip.Data.Get() + pixelStart * srcMip.RowPitch);
+                astcInput.data = &srcData;
+                byte* dstData = dstMip.Data.Get() + rowStart * dstMip.RowPitch;
+                astcErrors[strip] = astcenc_compress_image(astcContext, &astcInput, &astcSwizzle, dstData, (rowEnd - rowStart) * dstMip.RowPitch, 0);
+                if (astcErrors[strip] == ASTCENC_SUCCESS)
+                    astcErrors[strip] = astcenc_compress_reset(astcContext);
+            };
+            if (strips > 1)
+                JobSystem::Execute(compressStrip, strips);
+            else
+                compressStrip(0);
+            for (int32 strip = 0; strip < strips && astcError == ASTCENC_SUCCESS; strip++)
+                astcError = astcErrors[strip];
         }
     }
 
     // Clean up
+    for (astcenc_context* astcContext : astcContexts)
+    {
+        if (astcContext)
+            astcenc_context_free(astcContext);
+    }
     if (astcError != ASTCENC_SUCCESS)
     {
         LOG(Warning, "Cannot compress image. ASTC failed with error: {}", String(astcenc_get_error_string(astcError)));
         return true;
     }
-    astcenc_context_free(astcContext);
-    return astcError != ASTCENC_SUCCESS;
+    return false;
 }
 
 #endif
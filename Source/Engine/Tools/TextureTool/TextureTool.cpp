@@ -25,6 +25,9 @@ namespace
 }
 #endif
 
+TextureCompressionQuality TextureTool::CompressionQuality = TextureCompressionQuality::Normal;
+bool TextureTool::CompressionUseGPU = true;
+
 String TextureTool::Options::ToString() const
 {
     return String::Format(TEXT("Type: {}, IsAtlas: {}, NeverStream: {}, IndependentChannels: {}, sRGB: {}, GenerateMipMaps: {}, FlipY: {}, InvertGreen: {} Scale: {}, MaxSize: {}, Resize: {}, PreserveAlphaCoverage: {}, PreserveAlphaCoverageReference: {}, SizeX: {}, SizeY: {}"),
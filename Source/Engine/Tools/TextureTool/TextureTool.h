@@ -240,6 +240,17 @@ API_CLASS(Namespace="FlaxEngine.Tools", Static) class FLAXENGINE_API TextureTool
 
     static PixelFormat ToPixelFormat(TextureFormatType format, int32 width, int32 height, bool canCompress);
 
+public:
+    /// <summary>
+    /// The quality of the compression used when converting textures into block-compressed formats (eg. set by the game cooker).
+    /// </summary>
+    static TextureCompressionQuality CompressionQuality;
+
+    /// <summary>
+    /// True if compress textures on the GPU when supported by the graphics device, otherwise the CPU encoder is used. The CPU encoder is used as a fallback if the GPU compression fails.
+    /// </summary>
+    static bool CompressionUseGPU;
+
 private:
     enum class ImageType
     {
@@ -11,6 +11,10 @@
 #include "Engine/Graphics/Textures/TextureData.h"
 #include "Engine/Graphics/PixelFormatExtensions.h"
 #include "Engine/Platform/File.h"
+#include "Engine/Threading/JobSystem.h"
+
+// Minimum amount of rows (of texels or blocks) processed by a single job when converting texture in parallel
+#define TEXTURE_TOOL_PARALLEL_MIN_ROWS 4
 
 #define STBI_ASSERT(x) ASSERT(x)
 #define STBI_MALLOC(sz) Allocator::Allocate(sz)
@@ -577,11 +581,41 @@ bool TextureTool::ConvertStb(TextureData& dst, const TextureData& src, const Pix
         }
         bool isDstSRGB = PixelFormatExtensions::IsSRGB(dstFormat);
 
+        switch (dstFormat)
+        {
+        case PixelFormat::BC1_UNorm:
+        case PixelFormat::BC1_UNorm_sRGB:
+        case PixelFormat::BC3_UNorm:
+        case PixelFormat::BC3_UNorm_sRGB:
+        {
+            // stb_dxt initializes its tables on the first use so do it before compressing blocks on many threads
+            byte dummyDst[16];
+            Color32 dummySrc[16] = {};
+            stb_compress_dxt_block(dummyDst, (byte*)&dummySrc, 0, STB_DXT_NORMAL);
+            break;
+        }
+        case PixelFormat::BC4_UNorm:
+        case PixelFormat::BC5_UNorm:
+        case PixelFormat::BC7_UNorm:
+        case PixelFormat::BC7_UNorm_sRGB:
+            break;
+        default:
+            LOG(Warning, "Cannot compress image. Unsupported format {0}", static_cast<int32>(dstFormat));
+            return true;
+        }
+
+        // Map compression quality into the encoder options
+        const int32 dxtMode = CompressionQuality == TextureCompressionQuality::Fast ? STB_DXT_NORMAL : STB_DXT_HIGHQUAL;
+
         // bc7enc init
         bc7enc16_compress_block_params params;
         if (dstFormat == PixelFormat::BC7_UNorm || dstFormat == PixelFormat::BC7_UNorm_sRGB)
         {
             bc7enc16_compress_block_params_init(&params);
+            if (CompressionQuality == TextureCompressionQuality::Fast)
+                params.m_max_partitions_mode1 = 16;
+            else if (CompressionQuality == TextureCompressionQuality::High)
+                params.m_uber_level = BC7ENC16_MAX_UBER_LEVEL;
             bc7enc16_compress_block_init();
         }
 
@@ -609,56 +643,58 @@ bool TextureTool::ConvertStb(TextureData& dst, const TextureData& src, const Pix
                 dstMip.Lines = blocksHeight;
                 dstMip.Data.Allocate(dstMip.DepthPitch);
 
-                // Compress texture
-                for (int32 yBlock = 0; yBlock < blocksHeight; yBlock++)
+                // Compress texture (blocks are independent so rows of blocks are compressed in parallel, the output is the same as from the serial loop)
+                Function<void(int32, int32)> compressRows = [&](int32 rowStart, int32 rowEnd)
                 {
-                    for (int32 xBlock = 0; xBlock < blocksWidth; xBlock++)
+                    for (int32 yBlock = rowStart; yBlock < rowEnd; yBlock++)
                     {
-                        // Sample source texture 4x4 block
-                        Color32 srcBlock[16];
-                        for (int32 y = 0; y < 4; y++)
+                        for (int32 xBlock = 0; xBlock < blocksWidth; xBlock++)
                         {
-                            for (int32 x = 0; x < 4; x++)
+                            // Sample source texture 4x4 block
+                            Color32 srcBlock[16];
+                            for (int32 y = 0; y < 4; y++)
                             {
-                                Color color = TextureTool::SamplePoint(sampler, xBlock * 4 + x, yBlock * 4 + y, srcMip.Data.Get(), srcMip.RowPitch);
-                                if (isDstSRGB)
-                                    color = Color::LinearToSrgb(color);
-                                srcBlock[y * 4 + x] = Color32(color);
+                                for (int32 x = 0; x < 4; x++)
+                                {
+                                    Color color = TextureTool::SamplePoint(sampler, xBlock * 4 + x, yBlock * 4 + y, srcMip.Data.Get(), srcMip.RowPitch);
+                                    if (isDstSRGB)
+                                        color = Color::LinearToSrgb(color);
+                                    srcBlock[y * 4 + x] = Color32(color);
+                                }
                             }
-                        }
 
-                        // Compress block
-                        byte* dstBlock = dstMip.Data.Get() + (yBlock * blocksWidth + xBlock) * bytesPerBlock;
-                        switch (dstFormat)
-                        {
-                        case PixelFormat::BC1_UNorm:
-                        case PixelFormat::BC1_UNorm_sRGB:
-                            stb_compress_dxt_block(dstBlock, (byte*)&srcBlock, 0, STB_DXT_HIGHQUAL);
-                            break;
-                        case PixelFormat::BC3_UNorm:
-                        case PixelFormat::BC3_UNorm_sRGB:
-                            stb_compress_dxt_block(dstBlock, (byte*)&srcBlock, 1, STB_DXT_HIGHQUAL);
-                            break;
-                        case PixelFormat::BC4_UNorm:
-                            for (int32 i = 1; i < 16; i++)
-                                ((byte*)&srcBlock)[i] = srcBlock[i].R;
-                            stb_compress_bc4_block(dstBlock, (byte*)&srcBlock);
-                            break;
-                        case PixelFormat::BC5_UNorm:
-                            for (int32 i = 0; i < 16; i++)
-                                ((uint16*)&srcBlock)[i] = srcBlock[i].R << 8 | srcBlock[i].G;
-                            stb_compress_bc5_block(dstBlock, (byte*)&srcBlock);
-                            break;
-                        case PixelFormat::BC7_UNorm:
-                        case PixelFormat::BC7_UNorm_sRGB:
-                            bc7enc16_compress_block(dstBlock, &srcBlock, &params);
-                            break;
-                        default:
-                            LOG(Warning, "Cannot compress image. Unsupported format {0}", static_cast<int32>(dstFormat));
-                            return true;
+                            // Compress block
+                            byte* dstBlock = dstMip.Data.Get() + (yBlock * blocksWidth + xBlock) * bytesPerBlock;
+                            switch (dstFormat)
+                            {
+                            case PixelFormat::BC1_UNorm:
+                            case PixelFormat::BC1_UNorm_sRGB:
+                                stb_compress_dxt_block(dstBlock, (byte*)&srcBlock, 0, dxtMode);
+                                break;
+                            case PixelFormat::BC3_UNorm:
+                            case PixelFormat::BC3_UNorm_sRGB:
+                                stb_compress_dxt_block(dstBlock, (byte*)&srcBlock, 1, dxtMode);
+                                break;
+                            case PixelFormat::BC4_UNorm:
+                                for (int32 i = 1; i < 16; i++)
+                                    ((byte*)&srcBlock)[i] = srcBlock[i].R;
+                                stb_compress_bc4_block(dstBlock, (byte*)&srcBlock);
+                                break;
+                            case PixelFormat::BC5_UNorm:
+                                for (int32 i = 0; i < 16; i++)
+                                    ((uint16*)&srcBlock)[i] = srcBlock[i].R << 8 | srcBlock[i].G;
+                                stb_compress_bc5_block(dstBlock, (byte*)&srcBlock);
+                                break;
+                            case PixelFormat::BC7_UNorm:
+                            case PixelFormat::BC7_UNorm_sRGB:
+                                bc7enc16_compress_block(dstBlock, &srcBlock, &params);
+                                break;
+                            default: ;
+                            }
                         }
                     }
-                }
+                };
+                JobSystem::ParallelFor(blocksHeight, compressRows, TEXTURE_TOOL_PARALLEL_MIN_ROWS);
             }
         }
     }
@@ -706,18 +742,22 @@ bool TextureTool::ConvertStb(TextureData& dst, const TextureData& src, const Pix
                 dstMip.Lines = mipHeight;
                 dstMip.Data.Allocate(dstMip.DepthPitch);
 
-                // Convert texture
-                for (int32 y = 0; y < mipHeight; y++)
+                // Convert texture (rows are converted in parallel)
+                Function<void(int32, int32)> convertRows = [&](int32 rowStart, int32 rowEnd)
                 {
-                    for (int32 x = 0; x < mipWidth; x++)
+                    for (int32 y = rowStart; y < rowEnd; y++)
                     {
-                        // Sample source texture
-                        Color color = TextureTool::SamplePoint(sampler, x, y, srcMip.Data.Get(), srcMip.RowPitch);
+                        for (int32 x = 0; x < mipWidth; x++)
+                        {
+                            // Sample source texture
+                            Color color = TextureTool::SamplePoint(sampler, x, y, srcMip.Data.Get(), srcMip.RowPitch);
 
-                        // Store destination texture
-                        TextureTool::Store(dstSampler, x, y, dstMip.Data.Get(), dstMip.RowPitch, color);
+                            // Store destination texture
+                            TextureTool::Store(dstSampler, x, y, dstMip.Data.Get(), dstMip.RowPitch, color);
+                        }
                     }
-                }
+                };
+                JobSystem::ParallelFor(mipHeight, convertRows, TEXTURE_TOOL_PARALLEL_MIN_ROWS * 4);
             }
         }
     }
@@ -0,0 +1,92 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+namespace FlaxEngine.GUI
+{
+    /// <summary>
+    /// UI container control that records children drawing into the retained geometry cache and reuses it instead of drawing children every frame (as long as control doesn't move and nothing changes). Unlike <see cref="RenderToTextureControl"/> it doesn't use any texture and keeps the full quality. Can be used to reduce CPU cost of the complex static UI such as HUDs or inventory screens.
+    /// </summary>
+    public class GeometryCacheControl : ContainerControl
+    {
+        private bool _invalid = true;
+        private Render2DCache _cache;
+
+        /// <summary>
+        /// Gets the cache with the recorded children geometry.
+        /// </summary>
+        public Render2DCache Cache => _cache;
+
+        /// <summary>
+        /// Gets or sets the value whether cached geometry should be invalidated automatically (eg. when child control changes or when mouse is over the control to keep hover states updated). Changes of the children properties that don't affect the layout (eg. text of the label or color of the image) require manual <see cref="Invalidate"/> call.
+        /// </summary>
+        public bool AutomaticInvalidate { get; set; } = true;
+
+        /// <summary>
+        /// Invalidates the cached geometry of children controls and records it again on the next draw.
+        /// </summary>
+        [Tooltip("Invalidates the cached geometry of children controls and records it again on the next draw.")]
+        public void Invalidate()
+        {
+            _invalid = true;
+        }
+
+        /// <inheritdoc />
+        public override void Draw()
+        {
+            // Draw directly when user interacts with the children
+            if (AutomaticInvalidate && (IsMouseOver || ContainsFocus))
+            {
+                _invalid = true;
+                base.Draw();
+                return;
+            }
+
+            // Draw cached geometry (fails if it was recorded with a different transformation, clipping or tint)
+            if (!_invalid && _cache && !Render2D.DrawCache(_cache))
+                return;
+
+            // Draw and record UI
+            _invalid = false;
+            if (!_cache)
+                _cache = new Render2DCache();
+            Render2D.BeginCache(_cache);
+            base.Draw();
+            Render2D.EndCache();
+        }
+
+        /// <inheritdoc />
+        public override void OnChildResized(Control control)
+        {
+            base.OnChildResized(control);
+
+            if (AutomaticInvalidate)
+                Invalidate();
+        }
+
+        /// <inheritdoc />
+        public override void OnChildrenChanged()
+        {
+            base.OnChildrenChanged();
+
+            if (AutomaticInvalidate)
+                Invalidate();
+        }
+
+        /// <inheritdoc />
+        protected override void PerformLayoutBeforeChildren()
+        {
+            base.PerformLayoutBeforeChildren();
+
+            if (AutomaticInvalidate)
+                Invalidate();
+        }
+
+        /// <inheritdoc />
+        public override void OnDestroy()
+        {
+            _invalid = true;
+            Object.Destroy(ref _cache);
+
+            base.OnDestroy();
+        }
+    }
+}
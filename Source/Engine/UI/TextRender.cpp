@@ -226,7 +226,7 @@ void TextRender::UpdateLayout()
                         param.SetIsOverride(false);
 
                     // Set the font parameter
-                    static StringView FontParamName = TEXT("Font");
+                    static StringName FontParamName(TEXT("Font"));
                     const auto param = drawChunk.Material->Params.Get(FontParamName);
                     if (param && param->GetParameterType() == MaterialParameterType::Texture)
                     {
@@ -255,7 +255,7 @@ void TextRender::UpdateLayout()
                     const float x = pointer.X + (float)entry.OffsetX * scale;
                     const float y = pointer.Y + (float)(font->GetHeight() + font->GetDescender() - entry.OffsetY) * scale;
 
-                    Rectangle charRect(x, y, entry.UVSize.X * scale, entry.UVSize.Y * scale);
+                    Rectangle charRect(x, y, entry.Size.X * scale, entry.Size.Y * scale);
                     charRect.Offset(_layoutOptions.Bounds.Location);
 
                     Float2 upperLeftUV = entry.UV * invAtlasSize;
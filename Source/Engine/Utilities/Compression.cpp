@@ -0,0 +1,203 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Compression.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Platform/Platform.h"
+
+// LZ4 block format constraints
+#define LZ4_MIN_MATCH 4
+#define LZ4_LAST_LITERALS 5
+#define LZ4_MF_LIMIT 12
+#define LZ4_MAX_OFFSET 65535
+#define LZ4_ML_BITS 4
+#define LZ4_ML_MASK ((1 << LZ4_ML_BITS) - 1)
+#define LZ4_RUN_MASK ((1 << (8 - LZ4_ML_BITS)) - 1)
+
+// Match finder settings
+#define LZ4HC_HASH_LOG 15
+#define LZ4HC_HASH_SIZE (1 << LZ4HC_HASH_LOG)
+#define LZ4HC_CHAIN_SIZE (LZ4_MAX_OFFSET + 1)
+
+namespace
+{
+    struct LZ4HCState
+    {
+        int32 Hash[LZ4HC_HASH_SIZE];
+        uint16 Chain[LZ4HC_CHAIN_SIZE];
+        int32 Next;
+    };
+
+    FORCE_INLINE uint32 Read32(const byte* ptr)
+    {
+        uint32 value;
+        Platform::MemoryCopy(&value, ptr, sizeof(value));
+        return value;
+    }
+
+    FORCE_INLINE uint32 HashPosition(const byte* ptr)
+    {
+        return (Read32(ptr) * 2654435761U) >> (32 - LZ4HC_HASH_LOG);
+    }
+
+    FORCE_INLINE int32 CountMatch(const byte* a, const byte* b, const byte* limit)
+    {
+        const byte* start = a;
+        while (a < limit && *a == *b)
+        {
+            a++;
+            b++;
+        }
+        return (int32)(a - start);
+    }
+
+    // Inserts all positions in range [Next, target) into the hash chains
+    void InsertPositions(LZ4HCState& state, const byte* src, int32 target)
+    {
+        for (int32 pos = state.Next; pos < target; pos++)
+        {
+            const uint32 h = HashPosition(src + pos);
+            const int32 delta = pos - state.Hash[h];
+            state.Chain[pos & LZ4_MAX_OFFSET] = (uint16)Math::Min(delta, LZ4_MAX_OFFSET);
+            state.Hash[h] = pos;
+        }
+        if (target > state.Next)
+            state.Next = target;
+    }
+
+    int32 FindLongestMatch(LZ4HCState& state, const byte* src, int32 pos, int32 matchLimit, int32 maxAttempts, int32& matchPos)
+    {
+        InsertPositions(state, src, pos);
+        const byte* ip = src + pos;
+        const uint32 value = Read32(ip);
+        int32 bestLength = 0;
+        int32 candidate = state.Hash[HashPosition(ip)];
+        while (candidate >= 0 && pos - candidate <= LZ4_MAX_OFFSET && maxAttempts-- > 0)
+        {
+            const byte* match = src + candidate;
+            if (match[bestLength] == ip[bestLength] && Read32(match) == value)
+            {
+                const int32 length = LZ4_MIN_MATCH + CountMatch(ip + LZ4_MIN_MATCH, match + LZ4_MIN_MATCH, src + matchLimit);
+                if (length > bestLength)
+                {
+                    bestLength = length;
+                    matchPos = candidate;
+                    if (pos + length >= matchLimit)
+                        break;
+                }
+            }
+            const uint16 delta = state.Chain[candidate & LZ4_MAX_OFFSET];
+            if (delta == 0)
+                break;
+            candidate -= delta;
+        }
+        return bestLength;
+    }
+
+    FORCE_INLINE bool WriteLength(byte*& op, const byte* opEnd, int32 length)
+    {
+        while (length >= 255)
+        {
+            if (op >= opEnd)
+                return true;
+            *op++ = 255;
+            length -= 255;
+        }
+        if (op >= opEnd)
+            return true;
+        *op++ = (byte)length;
+        return false;
+    }
+
+    bool WriteSequence(byte*& op, const byte* opEnd, const byte* literals, int32 literalsLength, int32 offset, int32 matchLength)
+    {
+        if (op + 1 + literalsLength / 255 + 1 + literalsLength + 2 > opEnd)
+            return true;
+        byte* token = op++;
+        if (literalsLength >= LZ4_RUN_MASK)
+        {
+            *token = LZ4_RUN_MASK << LZ4_ML_BITS;
+            if (WriteLength(op, opEnd, literalsLength - LZ4_RUN_MASK))
+                return true;
+        }
+        else
+        {
+            *token = (byte)(literalsLength << LZ4_ML_BITS);
+        }
+        Platform::MemoryCopy(op, literals, literalsLength);
+        op += literalsLength;
+        if (matchLength == 0)
+            return false; // Last literals run
+        *op++ = (byte)offset;
+        *op++ = (byte)(offset >> 8);
+        matchLength -= LZ4_MIN_MATCH;
+        if (matchLength >= LZ4_ML_MASK)
+        {
+            *token |= LZ4_ML_MASK;
+            if (WriteLength(op, opEnd, matchLength - LZ4_ML_MASK))
+                return true;
+        }
+        else
+        {
+            *token |= (byte)matchLength;
+        }
+        return false;
+    }
+}
+
+int32 Compression::CompressLZ4HC(const byte* src, int32 srcSize, byte* dst, int32 dstCapacity, int32 level)
+{
+    if ((!src && srcSize != 0) || srcSize < 0 || !dst || dstCapacity <= 0)
+        return 0;
+    const int32 maxAttempts = 1 << (Math::Clamp(level, 1, 12) - 1);
+    byte* op = dst;
+    const byte* opEnd = dst + dstCapacity;
+    int32 anchor = 0;
+    if (srcSize > LZ4_MF_LIMIT)
+    {
+        Array<byte> stateData;
+        stateData.Resize(sizeof(LZ4HCState));
+        LZ4HCState& state = *(LZ4HCState*)stateData.Get();
+        for (int32 i = 0; i < LZ4HC_HASH_SIZE; i++)
+            state.Hash[i] = -LZ4HC_CHAIN_SIZE;
+        Platform::MemoryClear(state.Chain, sizeof(state.Chain));
+        state.Next = 0;
+
+        // Matches cannot start within the last MF_LIMIT bytes and have to end before the last literals
+        const int32 mfLimit = srcSize - LZ4_MF_LIMIT;
+        const int32 matchLimit = srcSize - LZ4_LAST_LITERALS;
+        int32 pos = 0;
+        while (pos < mfLimit)
+        {
+            int32 matchPos;
+            int32 matchLength = FindLongestMatch(state, src, pos, matchLimit, maxAttempts, matchPos);
+            if (matchLength < LZ4_MIN_MATCH)
+            {
+                pos++;
+                continue;
+            }
+
+            // Lazy matching: prefer a longer match starting at the next byte
+            while (pos + 1 < mfLimit)
+            {
+                int32 nextMatchPos;
+                const int32 nextMatchLength = FindLongestMatch(state, src, pos + 1, matchLimit, maxAttempts, nextMatchPos);
+                if (nextMatchLength <= matchLength)
+                    break;
+                pos++;
+                matchLength = nextMatchLength;
+                matchPos = nextMatchPos;
+            }
+
+            if (WriteSequence(op, opEnd, src + anchor, pos - anchor, pos - matchPos, matchLength))
+                return 0;
+            pos += matchLength;
+            anchor = pos;
+        }
+    }
+
+    // Last literals
+    if (WriteSequence(op, opEnd, src + anchor, srcSize - anchor, 0, 0))
+        return 0;
+    return (int32)(op - dst);
+}
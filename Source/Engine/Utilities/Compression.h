@@ -0,0 +1,23 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Core/Types/BaseTypes.h"
+
+/// <summary>
+/// Contains algorithms for data compression.
+/// </summary>
+class FLAXENGINE_API Compression
+{
+public:
+    /// <summary>
+    /// Compresses data into LZ4 block format using the high-ratio encoder (hash chains match finder with lazy matching). Much slower than regular LZ4 compression but produces smaller output which is decompressed with LZ4_decompress_safe at the same speed.
+    /// </summary>
+    /// <param name="src">The source data.</param>
+    /// <param name="srcSize">The source data size (in bytes).</param>
+    /// <param name="dst">The destination buffer.</param>
+    /// <param name="dstCapacity">The destination buffer size (in bytes). Use LZ4_compressBound to ensure compression always succeeds.</param>
+    /// <param name="level">The compression level (in range 1-12). Higher values search for more matches.</param>
+    /// <returns>The size of the compressed data or 0 if failed (eg. destination buffer is too small).</returns>
+    static int32 CompressLZ4HC(const byte* src, int32 srcSize, byte* dst, int32 dstCapacity, int32 level = 9);
+};
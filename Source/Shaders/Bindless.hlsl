@@ -0,0 +1,23 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#ifndef __BINDLESS__
+#define __BINDLESS__
+
+// Bindless resources access the global descriptors table by the index (see GPUResourceView::GetBindlessIndex in C++) instead of binding resources to the shader slots
+// Resources table is aliased in the separate register spaces for the different resource types (must match the root signature)
+#if CAN_USE_BINDLESS
+
+Texture2D<float4> BindlessTextures2D[] : register(t0, space1);
+Texture3D<float4> BindlessTextures3D[] : register(t0, space2);
+TextureCube<float4> BindlessTexturesCube[] : register(t0, space3);
+Buffer<float4> BindlessBuffers[] : register(t0, space4);
+
+// Index can vary within the draw/dispatch (eg. per-instance material data)
+#define BINDLESS_TEXTURE_2D(index) BindlessTextures2D[NonUniformResourceIndex(index)]
+#define BINDLESS_TEXTURE_3D(index) BindlessTextures3D[NonUniformResourceIndex(index)]
+#define BINDLESS_TEXTURE_CUBE(index) BindlessTexturesCube[NonUniformResourceIndex(index)]
+#define BINDLESS_BUFFER(index) BindlessBuffers[NonUniformResourceIndex(index)]
+
+#endif
+
+#endif
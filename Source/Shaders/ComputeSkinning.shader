@@ -0,0 +1,78 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "./Flax/Common.hlsl"
+
+// Those defines must match the C++
+#define THREADGROUP_SIZE 64
+#define SKINNED_VERTEX_SIZE 36
+#define POSITION_SIZE 12
+#define ATTRIBUTES_SIZE 16
+
+META_CB_BEGIN(0, Data)
+uint VerticesCount;
+float3 Dummy0;
+META_CB_END
+
+#ifdef _CS_Skin
+
+// The skeletal bones matrix buffer (stored as 4x3, 3 float4 behind each other)
+Buffer<float4> BoneMatrices : register(t0);
+
+// The skinned mesh vertices (VB0SkinnedElementType: Position, TexCoord, Normal, Tangent, BlendIndices, BlendWeights)
+ByteAddressBuffer InputVertices : register(t1);
+
+// The skinned vertices positions (VB0ElementType) followed by the other attributes (VB1ElementType: TexCoord, Normal, Tangent, LightmapUVs)
+RWByteAddressBuffer OutputVertices : register(u0);
+
+float3x4 GetBoneMatrix(uint index)
+{
+	float4 a = BoneMatrices[index * 3];
+	float4 b = BoneMatrices[index * 3 + 1];
+	float4 c = BoneMatrices[index * 3 + 2];
+	return float3x4(a, b, c);
+}
+
+float3 UnpackVector(uint packed)
+{
+	return float3(packed & 0x3ff, (packed >> 10) & 0x3ff, (packed >> 20) & 0x3ff) / 1023.0f * 2.0f - 1.0f;
+}
+
+uint PackVector(float3 value, uint packedW)
+{
+	uint3 v = (uint3)round(saturate(normalize(value) * 0.5f + 0.5f) * 1023.0f);
+	return v.x | (v.y << 10) | (v.z << 20) | (packedW & 0xc0000000);
+}
+
+// Skins the mesh vertices with the bone matrices (matches the vertex shader skinning of the materials)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(THREADGROUP_SIZE, 1, 1)]
+void CS_Skin(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	uint index = dispatchThreadId.x;
+	if (index >= VerticesCount)
+		return;
+
+	// Load vertex
+	uint address = index * SKINNED_VERTEX_SIZE;
+	float3 position = asfloat(InputVertices.Load3(address));
+	uint4 packed = InputVertices.Load4(address + 12); // TexCoord, Normal, Tangent, BlendIndices
+	uint2 packedWeights = InputVertices.Load2(address + 28);
+	uint4 blendIndices = uint4(packed.w & 0xff, (packed.w >> 8) & 0xff, (packed.w >> 16) & 0xff, packed.w >> 24);
+	float4 blendWeights = float4(f16tof32(packedWeights.x), f16tof32(packedWeights.x >> 16), f16tof32(packedWeights.y), f16tof32(packedWeights.y >> 16));
+
+	// Perform skinning
+	float3x4 boneMatrix = blendWeights.x * GetBoneMatrix(blendIndices.x);
+	boneMatrix += blendWeights.y * GetBoneMatrix(blendIndices.y);
+	boneMatrix += blendWeights.z * GetBoneMatrix(blendIndices.z);
+	boneMatrix += blendWeights.w * GetBoneMatrix(blendIndices.w);
+	position = mul(boneMatrix, float4(position, 1));
+	float3 normal = mul(boneMatrix, float4(UnpackVector(packed.y), 0));
+	float3 tangent = mul(boneMatrix, float4(UnpackVector(packed.z), 0));
+
+	// Store vertex
+	OutputVertices.Store3(index * POSITION_SIZE, asuint(position));
+	address = VerticesCount * POSITION_SIZE + index * ATTRIBUTES_SIZE;
+	OutputVertices.Store4(address, uint4(packed.x, PackVector(normal, packed.y), PackVector(tangent, packed.z), 0)); // Lightmap UVs are not used
+}
+
+#endif
@@ -4,7 +4,8 @@
 
 META_CB_BEGIN(0, Data)
 float4x4 ViewProjection;
-float2 Padding;
+float Time;
+float Padding;
 float ClipPosZBias;
 bool EnableDepthTest;
 META_CB_END
@@ -29,6 +30,48 @@ VS2PS VS(float3 Position : POSITION, float4 Color : COLOR)
 	return output;
 }
 
+// Moves the expired primitive outside the clip space (persistent shapes are removed from the buffer on the next upload)
+void CullExpired(inout VS2PS output, float expireTime)
+{
+	if (Time >= expireTime)
+		output.Position = float4(2, 2, 2, 1);
+}
+
+META_VS(true, FEATURE_LEVEL_ES2)
+META_VS_IN_ELEMENT(POSITION, 0, R32G32B32_FLOAT, 0, ALIGN, PER_VERTEX, 0, true)
+META_VS_IN_ELEMENT(COLOR,    0, R8G8B8A8_UNORM,  0, ALIGN, PER_VERTEX, 0, true)
+META_VS_IN_ELEMENT(TEXCOORD, 0, R32_FLOAT,       0, ALIGN, PER_VERTEX, 0, true)
+VS2PS VS_Retained(float3 Position : POSITION, float4 Color : COLOR, float ExpireTime : TEXCOORD0)
+{
+	VS2PS output;
+	output.Position = mul(float4(Position, 1), ViewProjection);
+	output.Position.z += ClipPosZBias;
+	output.Color = Color;
+	CullExpired(output, ExpireTime);
+	return output;
+}
+
+META_VS(true, FEATURE_LEVEL_ES2)
+META_VS_IN_ELEMENT(POSITION,  0, R32G32B32_FLOAT,    0, 0,     PER_VERTEX,   0, true)
+META_VS_IN_ELEMENT(ATTRIBUTE, 0, R32G32B32A32_FLOAT, 1, 0,     PER_INSTANCE, 1, true)
+META_VS_IN_ELEMENT(ATTRIBUTE, 1, R32G32B32A32_FLOAT, 1, ALIGN, PER_INSTANCE, 1, true)
+META_VS_IN_ELEMENT(ATTRIBUTE, 2, R32G32B32A32_FLOAT, 1, ALIGN, PER_INSTANCE, 1, true)
+META_VS_IN_ELEMENT(COLOR,     0, R8G8B8A8_UNORM,     1, ALIGN, PER_INSTANCE, 1, true)
+META_VS_IN_ELEMENT(TEXCOORD,  0, R32_FLOAT,          1, ALIGN, PER_INSTANCE, 1, true)
+VS2PS VS_Instanced(float3 Position : POSITION, float4 World0 : ATTRIBUTE0, float4 World1 : ATTRIBUTE1, float4 World2 : ATTRIBUTE2, float4 Color : COLOR, float ExpireTime : TEXCOORD0)
+{
+	// Transform the unit shape mesh by the per-instance world matrix (3 rows of the transposed matrix)
+	float4 localPosition = float4(Position, 1);
+	float3 worldPosition = float3(dot(World0, localPosition), dot(World1, localPosition), dot(World2, localPosition));
+
+	VS2PS output;
+	output.Position = mul(float4(worldPosition, 1), ViewProjection);
+	output.Position.z += ClipPosZBias;
+	output.Color = Color;
+	CullExpired(output, ExpireTime);
+	return output;
+}
+
 META_PS(true, FEATURE_LEVEL_ES2)
 META_PERMUTATION_2(USE_DEPTH_TEST=0,USE_FAKE_LIGHTING=0)
 META_PERMUTATION_2(USE_DEPTH_TEST=0,USE_FAKE_LIGHTING=1)
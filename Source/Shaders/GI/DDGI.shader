@@ -35,7 +35,8 @@ int4 ProbeScrollClears[4];
 META_CB_END
 
 META_CB_BEGIN(1, Data1)
-float2 Padding1;
+uint FrameIndex;
+float ProbesUpdateChance;
 uint CascadeIndex;
 uint ProbeIndexOffset;
 META_CB_END
@@ -67,6 +68,8 @@ uint GetProbeRaysCount(DDGIData data, uint probeState)
 
 #ifdef _CS_Classify
 
+#include "./Flax/Random.hlsl"
+
 #define DDGI_PROBE_RELOCATE_ITERATIVE 0 // If true, probes relocation algorithm tries to move them in additive way, otherwise all nearby locations are checked to find the best position
 
 RWTexture2D<snorm float4> RWProbesData : register(u0);
@@ -205,8 +208,14 @@ void CS_Classify(uint3 DispatchThreadId : SV_DispatchThreadID)
     probeOffset /= probesSpacing; // Move offset back to [-1;1] space
     RWProbesData[probeDataCoords] = EncodeDDGIProbeData(probeOffset, probeState);
 
-    // Collect active probes
-    if (probeState != DDGI_PROBE_STATE_INACTIVE)
+    // Collect active probes (within update budget, prioritize newly activated probes and the ones near the camera)
+    bool update = probeState == DDGI_PROBE_STATE_ACTIVATED || ProbesUpdateChance >= 1.0f;
+    if (probeState == DDGI_PROBE_STATE_ACTIVE && !update)
+    {
+        float viewDistance = distance(probeBasePosition, DDGI.ViewPos);
+        update = viewDistance < probesSpacing * 3.0f || RandN2(float2(DispatchThreadId.x, FrameIndex % 1024)).x < ProbesUpdateChance;
+    }
+    if (update)
     {
         uint activeProbeIndex;
         RWActiveProbes.InterlockedAdd(0, 1, activeProbeIndex); // Counter at 0
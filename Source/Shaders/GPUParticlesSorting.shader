@@ -14,12 +14,34 @@ uint ParticleStride;
 uint ParticleCapacity;
 uint PositionOffset;
 uint CustomOffset;
+uint IndirectArgsAddCount;
+uint IndirectArgsThreadGroupSize;
+uint IndirectArgsOffset;
+uint Dummy0;
 float4x4 PositionTransform;
 META_CB_END
 
 // Particles data buffer
 ByteAddressBuffer ParticlesData : register(t0);
 
+#ifdef _CS_IndirectArgs
+
+RWByteAddressBuffer IndirectArgsBuffer : register(u0);
+
+// Indirect dispatch arguments generation shader (based on the particles counter)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(1, 1, 1)]
+void CS_IndirectArgs()
+{
+	uint particlesCount = min(ParticlesData.Load(ParticleCounterOffset), ParticleCapacity) + IndirectArgsAddCount;
+	uint threadGroups = min((particlesCount + IndirectArgsThreadGroupSize - 1) / IndirectArgsThreadGroupSize, 65535);
+	IndirectArgsBuffer.Store3(IndirectArgsOffset, uint3(threadGroups, 1, 1));
+}
+
+#endif
+
+#ifdef _CS_Sort
+
 // Output sorting keys buffer (index + key)
 struct Item
 {
@@ -85,3 +107,5 @@ void CS_Sort(uint3 dispatchThreadId : SV_DispatchThreadID)
 	item.Value = index;
 	SortingKeys[index] = item;
 }
+
+#endif
@@ -1,6 +1,7 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
 #include "./Flax/GUICommon.hlsl"
+#include "./Flax/Bindless.hlsl"
 
 #ifndef BLUR_V
 #define BLUR_V 0
@@ -62,6 +63,32 @@ float4 PS_ImagePoint(VS2PS input) : SV_Target0
 	return Image.Sample(SamplerPointClamp, input.TexCoord) * input.Color;
 }
 
+// Render2D::RenderingFeatures::BindlessTextures (texture index is passed in the vertex custom data to batch images using different textures)
+float4 SampleImageBindless(VS2PS input, SamplerState s)
+{
+#if CAN_USE_BINDLESS
+	return BINDLESS_TEXTURE_2D((uint)(input.CustomData.x + 0.5f)).Sample(s, input.TexCoord);
+#else
+	return Image.Sample(s, input.TexCoord);
+#endif
+}
+
+META_PS(true, FEATURE_LEVEL_ES2)
+float4 PS_ImageBindless(VS2PS input) : SV_Target0
+{
+	PerformClipping(input);
+
+	return SampleImageBindless(input, SamplerLinearClamp) * input.Color;
+}
+
+META_PS(true, FEATURE_LEVEL_ES2)
+float4 PS_ImagePointBindless(VS2PS input) : SV_Target0
+{
+	PerformClipping(input);
+
+	return SampleImageBindless(input, SamplerPointClamp) * input.Color;
+}
+
 META_PS(true, FEATURE_LEVEL_ES2)
 float4 PS_Color(VS2PS input) : SV_Target0
 {
@@ -101,6 +128,19 @@ float4 PS_Font(VS2PS input) : SV_Target0
 	return color;
 }
 
+META_PS(true, FEATURE_LEVEL_ES2)
+float4 PS_FontSDF(VS2PS input) : SV_Target0
+{
+	PerformClipping(input);
+
+	// Signed distance field glyph (0.5 is at the edge) with antialiasing width matching the screen-space size of the pixel
+	float4 color = input.Color;
+	float distance = Image.Sample(SamplerLinearClamp, input.TexCoord).r;
+	float width = max(length(float2(ddx(distance), ddy(distance))) * 0.70710678f, 0.0001f);
+	color.a *= smoothstep(0.5f - width, 0.5f + width, distance);
+	return color;
+}
+
 float4 GetSample(float weight, float offset, float2 uv)
 {
 #if BLUR_V
@@ -46,6 +46,12 @@ uint GenerateMipTexResolution;
 uint GenerateMipCoordScale;
 uint GenerateMipTexOffsetX;
 uint GenerateMipMipOffsetX;
+int3 GenerateMipCoordOffset;
+uint GenerateMipPadding0;
+int3 GenerateMipTexMin;
+uint GenerateMipPadding1;
+int3 GenerateMipTexMax;
+uint GenerateMipPadding2;
 META_CB_END
 
 float CombineDistanceToSDF(float sdf, float distanceToSDF)
@@ -206,7 +212,7 @@ Texture3D<float> GlobalSDFTex : register(t0);
 float SampleSDF(uint3 voxelCoordMip, int3 offset)
 {
 	// Sample SDF
-	voxelCoordMip = (uint3)clamp((int3)(voxelCoordMip * GenerateMipCoordScale) + offset, int3(0, 0, 0), (int3)(GenerateMipTexResolution - 1));
+	voxelCoordMip = (uint3)clamp((int3)(voxelCoordMip * GenerateMipCoordScale) + offset, GenerateMipTexMin, GenerateMipTexMax);
 	voxelCoordMip.x += GenerateMipTexOffsetX;
 	float result = GlobalSDFTex[voxelCoordMip].r;
 
@@ -223,7 +229,7 @@ META_CS(true, FEATURE_LEVEL_SM5)
 [numthreads(GLOBAL_SDF_MIP_GROUP_SIZE, GLOBAL_SDF_MIP_GROUP_SIZE, GLOBAL_SDF_MIP_GROUP_SIZE)]
 void CS_GenerateMip(uint3 DispatchThreadId : SV_DispatchThreadID)
 {
-	uint3 voxelCoordMip = DispatchThreadId;
+	uint3 voxelCoordMip = DispatchThreadId + (uint3)GenerateMipCoordOffset;
 	float minDistance = SampleSDF(voxelCoordMip, int3(0, 0, 0));
 
 	// Find the distance to the closest surface by sampling the nearby area (flood fill)
@@ -240,6 +246,25 @@ void CS_GenerateMip(uint3 DispatchThreadId : SV_DispatchThreadID)
 
 #endif
 
+#if defined(_CS_Readback)
+
+Texture3D<float> GlobalSDFMip : register(t0);
+RWBuffer<float> ReadbackBuffer : register(u0);
+
+// Compute shader for copying Global SDF mip into the linear buffer for CPU readback
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(GLOBAL_SDF_MIP_GROUP_SIZE, GLOBAL_SDF_MIP_GROUP_SIZE, GLOBAL_SDF_MIP_GROUP_SIZE)]
+void CS_Readback(uint3 DispatchThreadId : SV_DispatchThreadID)
+{
+	uint3 size;
+	GlobalSDFMip.GetDimensions(size.x, size.y, size.z);
+	if (any(DispatchThreadId >= size))
+		return;
+	ReadbackBuffer[DispatchThreadId.x + (DispatchThreadId.y + DispatchThreadId.z * size.y) * size.x] = GlobalSDFMip[DispatchThreadId];
+}
+
+#endif
+
 #ifdef _PS_Debug
 
 Texture3D<float> GlobalSDFTex : register(t0);
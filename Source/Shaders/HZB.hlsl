@@ -0,0 +1,47 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#ifndef __HZB__
+#define __HZB__
+
+// Tests the bounding sphere (in view-relative world space) against the Hierarchical-Z buffer (each texel stores the farthest depth, first mip is half-res of the depth buffer). Conservative: it's never occluded if is off-screen or intersects with the near plane.
+bool IsOccludedHZB(Texture2D<float> hzb, float4 sphere, float3 viewPosition, float4x4 viewProjectionMatrix, float2 hzbSize, uint2 hzbResolution, uint hzbMips)
+{
+	if (sphere.w <= 0.0f || length(sphere.xyz - viewPosition) <= sphere.w)
+		return false;
+
+	// Project the sphere bounding box into the screen rectangle with the nearest depth
+	float2 rectMin = 1.0f;
+	float2 rectMax = -1.0f;
+	float minDepth = 1.0f;
+	UNROLL
+	for (uint i = 0; i < 8; i++)
+	{
+		float3 corner = sphere.xyz + float3(i & 1 ? sphere.w : -sphere.w, i & 2 ? sphere.w : -sphere.w, i & 4 ? sphere.w : -sphere.w);
+		float4 position = mul(float4(corner, 1), viewProjectionMatrix);
+		if (position.w <= 0.0f)
+			return false;
+		position.xyz /= position.w;
+		rectMin = min(rectMin, position.xy);
+		rectMax = max(rectMax, position.xy);
+		minDepth = min(minDepth, position.z);
+	}
+	if (any(rectMax < -1.0f) || any(rectMin > 1.0f) || minDepth <= 0.0f)
+		return false;
+
+	// Pick the mip where the rectangle covers at most 2x2 texels
+	float2 pixelMin = saturate(float2(rectMin.x, -rectMax.y) * 0.5f + 0.5f) * hzbSize;
+	float2 pixelMax = saturate(float2(rectMax.x, -rectMin.y) * 0.5f + 0.5f) * hzbSize;
+	float2 size = pixelMax - pixelMin;
+	uint mip = min((uint)ceil(log2(max(max(size.x, size.y), 1.0f))), hzbMips - 1);
+	int2 maxTexel = max(int2(hzbResolution >> mip) - 1, 0);
+	int2 texelMin = min(int2(pixelMin) >> mip, maxTexel);
+	int2 texelMax = min(int2(pixelMax) >> mip, maxTexel);
+	float depth0 = hzb.Load(int3(texelMin.x, texelMin.y, mip));
+	float depth1 = hzb.Load(int3(texelMax.x, texelMin.y, mip));
+	float depth2 = hzb.Load(int3(texelMin.x, texelMax.y, mip));
+	float depth3 = hzb.Load(int3(texelMax.x, texelMax.y, mip));
+	float maxDepth = max(max(depth0, depth1), max(depth2, depth3));
+	return minDepth > maxDepth;
+}
+
+#endif
@@ -0,0 +1,188 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "./Flax/Common.hlsl"
+#include "./Flax/Math.hlsl"
+#include "./Flax/HZB.hlsl"
+
+// Those defines must match the C++
+#define THREADGROUP_SIZE 64
+#define INSTANCE_DATA_SIZE 64
+#define DRAW_ARGS_SIZE 20
+#define MAX_LODS 6
+
+META_CB_BEGIN(0, Data)
+float4 FrustumPlanes[6];
+uint InstancesCount;
+float3 Dummy0;
+META_CB_END
+
+META_CB_BEGIN(1, PersistentData)
+float4x4 HZBViewProjectionMatrix;
+float3 InstancesOffset;
+uint DrawsCount;
+float3 CullViewPosition;
+float LODDistanceFactor;
+float3 LODViewPosition;
+float ScreenMultiple;
+float3 HZBOffset;
+float ProjectionW;
+float3 HZBViewPosition;
+uint HZBMips;
+float2 HZBSize;
+uint2 HZBResolution;
+float4 LODScreenSizesSq[2];
+float MinScreenSizeSq;
+uint LODsCount;
+int LODBias;
+int MinLOD;
+uint UseHZB;
+float3 Dummy1;
+META_CB_END
+
+// Matches InstanceCullingData in C++
+struct InstanceBounds
+{
+	float3 Center;
+	float Radius;
+	uint DrawIndex;
+};
+
+// Matches InstanceCullingBounds in C++
+struct PersistentInstanceBounds
+{
+	float3 Center;
+	float Radius;
+	float CullDistance;
+};
+
+#ifdef _CS_CullInstances
+
+StructuredBuffer<InstanceBounds> BoundsBuffer : register(t0);
+ByteAddressBuffer InstancesBuffer : register(t1);
+
+RWByteAddressBuffer CulledInstancesBuffer : register(u0);
+RWByteAddressBuffer DrawArgsBuffer : register(u1);
+
+// Culls the instances against the view frustum and compacts the visible ones into the ranges of their draws (instance count of the draw indirect arguments is used as a counter)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(THREADGROUP_SIZE, 1, 1)]
+void CS_CullInstances(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	uint index = dispatchThreadId.x;
+	if (index >= InstancesCount)
+		return;
+
+	// Frustum culling
+	InstanceBounds bounds = BoundsBuffer[index];
+	UNROLL
+	for (uint i = 0; i < 6; i++)
+	{
+		if (dot(FrustumPlanes[i].xyz, bounds.Center) + FrustumPlanes[i].w < -bounds.Radius)
+			return;
+	}
+
+	// Allocate the instance slot within the draw (GPUDrawIndexedIndirectArgs: IndicesCount, InstanceCount, StartIndex, StartVertex, StartInstance)
+	uint argsAddress = bounds.DrawIndex * DRAW_ARGS_SIZE;
+	uint slot;
+	DrawArgsBuffer.InterlockedAdd(argsAddress + 4, 1, slot);
+	slot += DrawArgsBuffer.Load(argsAddress + 16);
+
+	// Copy instance data
+	uint srcAddress = index * INSTANCE_DATA_SIZE;
+	uint dstAddress = slot * INSTANCE_DATA_SIZE;
+	UNROLL
+	for (uint j = 0; j < INSTANCE_DATA_SIZE; j += 16)
+		CulledInstancesBuffer.Store4(dstAddress + j, InstancesBuffer.Load4(srcAddress + j));
+}
+
+#endif
+
+#ifdef _CS_CullPersistent
+
+StructuredBuffer<PersistentInstanceBounds> BoundsBuffer : register(t0);
+ByteAddressBuffer InstancesBuffer : register(t1);
+Texture2D<float> HZB : register(t2);
+
+RWByteAddressBuffer CulledInstancesBuffer : register(u0);
+RWBuffer<uint> CountersBuffer : register(u1);
+
+// Culls the persistent instances against the view frustum, cull distance and the Hierarchical-Z buffer, selects the LOD and compacts the visible ones into the range of their LOD (counter per LOD)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(THREADGROUP_SIZE, 1, 1)]
+void CS_CullPersistent(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	uint index = dispatchThreadId.x;
+	if (index >= InstancesCount)
+		return;
+	PersistentInstanceBounds bounds = BoundsBuffer[index];
+	float3 center = bounds.Center + InstancesOffset;
+
+	// Frustum culling
+	UNROLL
+	for (uint i = 0; i < 6; i++)
+	{
+		if (dot(FrustumPlanes[i].xyz, center) + FrustumPlanes[i].w < -bounds.Radius)
+			return;
+	}
+
+	// Distance culling
+	if (distance(CullViewPosition, center) - bounds.Radius >= bounds.CullDistance)
+		return;
+
+	// Select LOD based on the screen size (matches RenderTools::ComputeModelLOD)
+	float3 lodToCenter = center - LODViewPosition;
+	float screenRadiusSquared = Square(ScreenMultiple * bounds.Radius) / max(1.0f, dot(lodToCenter, lodToCenter) * ProjectionW) * LODDistanceFactor;
+	if (MinScreenSizeSq > screenRadiusSquared)
+		return;
+	int lod = 0;
+	for (int lodIndex = (int)LODsCount - 1; lodIndex >= 0; lodIndex--)
+	{
+		if (LODScreenSizesSq[lodIndex / 4][lodIndex % 4] >= screenRadiusSquared)
+		{
+			lod = lodIndex;
+			break;
+		}
+	}
+	lod = clamp(lod + LODBias, MinLOD, (int)LODsCount - 1);
+
+	// Occlusion culling (against the previous frame depth)
+	if (UseHZB && IsOccludedHZB(HZB, float4(center + HZBOffset, bounds.Radius), HZBViewPosition, HZBViewProjectionMatrix, HZBSize, HZBResolution, HZBMips))
+		return;
+
+	// Allocate the instance slot within the LOD range
+	uint slot;
+	InterlockedAdd(CountersBuffer[lod], 1, slot);
+	slot += (uint)lod * InstancesCount;
+
+	// Copy instance data (moved into the view-relative world space)
+	uint srcAddress = index * INSTANCE_DATA_SIZE;
+	uint dstAddress = slot * INSTANCE_DATA_SIZE;
+	uint4 data = InstancesBuffer.Load4(srcAddress);
+	data.xyz = asuint(asfloat(data.xyz) + InstancesOffset);
+	CulledInstancesBuffer.Store4(dstAddress, data);
+	UNROLL
+	for (uint j = 16; j < INSTANCE_DATA_SIZE; j += 16)
+		CulledInstancesBuffer.Store4(dstAddress + j, InstancesBuffer.Load4(srcAddress + j));
+}
+
+#endif
+
+#ifdef _CS_SetupDrawArgs
+
+RWByteAddressBuffer DrawArgsBuffer : register(u0);
+RWBuffer<uint> CountersBuffer : register(u1);
+
+// Sets the instance count of the draw indirect arguments to the amount of the visible instances of the LOD of the draw (start instance points to the LOD range)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(THREADGROUP_SIZE, 1, 1)]
+void CS_SetupDrawArgs(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	uint index = dispatchThreadId.x;
+	if (index >= DrawsCount)
+		return;
+	uint argsAddress = index * DRAW_ARGS_SIZE;
+	uint lod = min(DrawArgsBuffer.Load(argsAddress + 16) / max(InstancesCount, 1), MAX_LODS - 1);
+	DrawArgsBuffer.Store(argsAddress + 4, CountersBuffer[lod]);
+}
+
+#endif
@@ -107,9 +107,24 @@ cbuffer ViewData : register(b1)
     float4 ViewInfo;
     float4 ScreenSize;
     float4 TemporalAAJitter;
+    float TexturesMipBias;
+    float3 ViewDummy0;
 };
 #endif
 
+// Mip-map level bias for the material textures sampling (negative when using temporal upscaling)
+#if USE_PER_VIEW_CONSTANTS
+#define MATERIAL_MIP_BIAS TexturesMipBias
+#else
+#define MATERIAL_MIP_BIAS 0
+#endif
+
+// Texture streaming feedback (used by TEXTURE_FEEDBACK macro in the material code)
+#include "./Flax/TextureFeedback.hlsl"
+
+// Bindless resources (custom material code can access textures by the indices passed via material parameters)
+#include "./Flax/Bindless.hlsl"
+
 struct ModelInput
 {
     float3 Position : POSITION;
@@ -0,0 +1,61 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "./Flax/Common.hlsl"
+#include "./Flax/HZB.hlsl"
+
+// Those defines must match the C++
+#define THREADGROUP_SIZE 64
+
+META_CB_BEGIN(0, Data)
+float4x4 ViewProjectionMatrix;
+float3 ViewPosition;
+uint QueriesCount;
+float2 HZBSize;
+uint2 InputSize;
+uint2 HZBResolution;
+uint HZBMips;
+float Dummy0;
+META_CB_END
+
+#ifdef _PS_HZB
+
+Texture2D<float> Input : register(t0);
+
+// Pixel Shader for the Hierarchical-Z buffer mip downscale (each texel stores the farthest depth of the texels it covers in the higher mip, footprint is extended by one texel to cover odd mip sizes)
+META_PS(true, FEATURE_LEVEL_SM5)
+float PS_HZB(Quad_VS2PS input) : SV_Target
+{
+	int2 pixel = int2(input.Position.xy) * 2;
+	int2 maxPixel = int2(InputSize) - 1;
+	float depth = 0.0f;
+	UNROLL
+	for (int y = 0; y < 3; y++)
+	{
+		UNROLL
+		for (int x = 0; x < 3; x++)
+			depth = max(depth, Input.Load(int3(min(pixel + int2(x, y), maxPixel), 0)));
+	}
+	return depth;
+}
+
+#endif
+
+#ifdef _CS_TestQueries
+
+Texture2D<float> HZB : register(t0);
+StructuredBuffer<float4> QueriesBuffer : register(t1);
+
+RWBuffer<uint> ResultsBuffer : register(u0);
+
+// Tests the occlusion queries against the Hierarchical-Z buffer (1 if visible, 0 if occluded)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(THREADGROUP_SIZE, 1, 1)]
+void CS_TestQueries(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	uint index = dispatchThreadId.x;
+	if (index >= QueriesCount)
+		return;
+	ResultsBuffer[index] = IsOccludedHZB(HZB, QueriesBuffer[index], ViewPosition, ViewProjectionMatrix, HZBSize, HZBResolution, HZBMips) ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,136 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "./Flax/Common.hlsl"
+
+#define THREAD_GROUP_SIZE 1024
+
+// The minimum distance between ribbon particles to generate a segment (closer particles are skipped)
+#define RIBBON_MIN_SEGMENT_LENGTH 0.002f
+
+META_CB_BEGIN(0, Data)
+uint ParticlesCount;
+uint ParticleStride;
+uint PositionOffset;
+uint RibbonOrderOffset;
+uint VertexOffset;
+uint IndexOffset;
+uint IndirectArgsOffset;
+uint Dummy0;
+META_CB_END
+
+ByteAddressBuffer ParticlesData : register(t0);
+Buffer<uint> RibbonOrder : register(t1);
+
+// Ribbon vertex: order, particle index, previous particle index, distance (2 vertices per ribbon particle)
+RWBuffer<uint4> VertexBuffer : register(u0);
+RWBuffer<uint> IndexBuffer : register(u1);
+RWByteAddressBuffer IndirectArgsBuffer : register(u2);
+
+groupshared uint ScanPrev[THREAD_GROUP_SIZE];
+groupshared uint ScanCount[THREAD_GROUP_SIZE];
+groupshared float ScanDistance[THREAD_GROUP_SIZE];
+groupshared uint SecondParticleIndex;
+
+float3 GetParticlePosition(uint particleIndex)
+{
+	return asfloat(ParticlesData.Load3(particleIndex * ParticleStride + PositionOffset));
+}
+
+uint GetRibbonParticle(uint order)
+{
+	return RibbonOrder[RibbonOrderOffset + order];
+}
+
+// Compute shader for generating the ribbon geometry from the particles in the ribbon order (single thread group processes the particles in chunks)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void CS_GenerateRibbon(uint groupIndex : SV_GroupIndex)
+{
+	uint carryPrev = 0;
+	uint carryCount = 0;
+	float carryDistance = 0;
+	if (groupIndex == 0)
+		SecondParticleIndex = ParticlesCount != 0 ? GetRibbonParticle(0) : 0;
+	for (uint chunk = 0; chunk < ParticlesCount; chunk += THREAD_GROUP_SIZE)
+	{
+		// Skip particles that are too close to the previous one
+		const uint order = chunk + groupIndex;
+		bool kept = false;
+		uint particleIndex = 0;
+		float3 position = 0;
+		if (order < ParticlesCount)
+		{
+			particleIndex = GetRibbonParticle(order);
+			position = GetParticlePosition(particleIndex);
+			kept = order == 0 || length(position - GetParticlePosition(GetRibbonParticle(order - 1))) > RIBBON_MIN_SEGMENT_LENGTH;
+		}
+
+		// Find the previous kept particle (prefix max of the kept particles order)
+		ScanPrev[groupIndex] = kept ? order : carryPrev;
+		GroupMemoryBarrierWithGroupSync();
+		for (uint maxOffset = 1; maxOffset < THREAD_GROUP_SIZE; maxOffset <<= 1)
+		{
+			uint value = groupIndex >= maxOffset ? ScanPrev[groupIndex - maxOffset] : 0;
+			GroupMemoryBarrierWithGroupSync();
+			ScanPrev[groupIndex] = max(ScanPrev[groupIndex], value);
+			GroupMemoryBarrierWithGroupSync();
+		}
+		const uint prevOrder = groupIndex > 0 ? ScanPrev[groupIndex - 1] : carryPrev;
+		const uint prevParticleIndex = kept && order > 0 ? GetRibbonParticle(prevOrder) : particleIndex;
+
+		// Calculate segments index and ribbon distance (prefix sum)
+		ScanCount[groupIndex] = kept ? 1 : 0;
+		ScanDistance[groupIndex] = kept && order > 0 ? length(position - GetParticlePosition(prevParticleIndex)) : 0.0f;
+		GroupMemoryBarrierWithGroupSync();
+		for (uint sumOffset = 1; sumOffset < THREAD_GROUP_SIZE; sumOffset <<= 1)
+		{
+			uint count = groupIndex >= sumOffset ? ScanCount[groupIndex - sumOffset] : 0;
+			float distance = groupIndex >= sumOffset ? ScanDistance[groupIndex - sumOffset] : 0.0f;
+			GroupMemoryBarrierWithGroupSync();
+			ScanCount[groupIndex] += count;
+			ScanDistance[groupIndex] += distance;
+			GroupMemoryBarrierWithGroupSync();
+		}
+
+		// Write 2 vertices and 2 triangles (connected with the previous particle)
+		if (kept && order > 0)
+		{
+			const uint k = carryCount + ScanCount[groupIndex] - 1;
+			if (k == 1)
+				SecondParticleIndex = particleIndex;
+			const uint vertex = VertexOffset + k * 2;
+			const uint4 data = uint4(order, particleIndex, prevParticleIndex, asuint(carryDistance + ScanDistance[groupIndex]));
+			VertexBuffer[vertex] = data;
+			VertexBuffer[vertex + 1] = data;
+			const uint index = IndexOffset + (k - 1) * 6;
+			const uint i0 = vertex - 2;
+			IndexBuffer[index + 0] = i0;
+			IndexBuffer[index + 1] = i0 + 1;
+			IndexBuffer[index + 2] = vertex;
+			IndexBuffer[index + 3] = i0 + 1;
+			IndexBuffer[index + 4] = vertex + 1;
+			IndexBuffer[index + 5] = vertex;
+		}
+
+		carryPrev = ScanPrev[THREAD_GROUP_SIZE - 1];
+		carryCount += ScanCount[THREAD_GROUP_SIZE - 1];
+		carryDistance += ScanDistance[THREAD_GROUP_SIZE - 1];
+		GroupMemoryBarrierWithGroupSync();
+	}
+
+	if (groupIndex == 0)
+	{
+		// Write the first particle vertices (uses the direction towards the next particle)
+		if (ParticlesCount != 0)
+		{
+			const uint4 data = uint4(0, GetRibbonParticle(0), SecondParticleIndex, 0);
+			VertexBuffer[VertexOffset] = data;
+			VertexBuffer[VertexOffset + 1] = data;
+		}
+
+		// Write draw arguments
+		const uint indicesCount = carryCount > 1 ? (carryCount - 1) * 6 : 0;
+		IndirectArgsBuffer.Store4(IndirectArgsOffset, uint4(indicesCount, 1, IndexOffset, 0));
+		IndirectArgsBuffer.Store(IndirectArgsOffset + 16, 0);
+	}
+}
@@ -0,0 +1,228 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "./Flax/Common.hlsl"
+
+// The amount of items processed by a single thread group
+#define BLOCK_SIZE 256
+
+// The amount of key bits sorted in a single pass
+#define RADIX_BITS 4
+#define RADIX (1 << RADIX_BITS)
+
+struct Item
+{
+	float Key;
+	uint Value;
+};
+
+META_CB_BEGIN(0, Data)
+uint CounterOffset;
+uint MaxCount;
+uint BitShift;
+uint Descending;
+META_CB_END
+
+// Buffer with counter of items to sort (accessed via uint load at CounterOffset address)
+ByteAddressBuffer CounterBuffer : register(t0);
+
+uint GetCount()
+{
+	return min(CounterBuffer.Load(CounterOffset), MaxCount);
+}
+
+uint GetBlocksCount(uint count)
+{
+	return (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+}
+
+// Converts the float key into the uint that preserves the sorting order (flips the sign bit for positive values and all bits for negative values)
+uint GetSortKey(float key)
+{
+	uint value = asuint(key);
+	value ^= (value & 0x80000000) ? 0xffffffff : 0x80000000;
+	return Descending ? ~value : value;
+}
+
+uint GetDigit(float key)
+{
+	return (GetSortKey(key) >> BitShift) & (RADIX - 1);
+}
+
+#ifdef _CS_IndirectArgs
+
+RWByteAddressBuffer IndirectArgsBuffer : register(u0);
+
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(1, 1, 1)]
+void CS_IndirectArgs()
+{
+	IndirectArgsBuffer.Store3(0, uint3(GetBlocksCount(GetCount()), 1, 1));
+}
+
+#endif
+
+#if defined(_CS_Count) || defined(_CS_Scan)
+
+// Digits counts of all blocks (digit-major order so the prefix sum gives the global output offsets for each block and digit)
+RWStructuredBuffer<uint> Histograms : register(u0);
+
+#endif
+
+#ifdef _CS_Count
+
+StructuredBuffer<Item> SrcKeys : register(t1);
+
+groupshared uint BlockHistogram[RADIX];
+
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(BLOCK_SIZE, 1, 1)]
+void CS_Count(uint3 groupID : SV_GroupID, uint groupIndex : SV_GroupIndex)
+{
+	if (groupIndex < RADIX)
+		BlockHistogram[groupIndex] = 0;
+	GroupMemoryBarrierWithGroupSync();
+
+	const uint count = GetCount();
+	const uint index = groupID.x * BLOCK_SIZE + groupIndex;
+	if (index < count)
+	{
+		uint unused;
+		InterlockedAdd(BlockHistogram[GetDigit(SrcKeys[index].Key)], 1, unused);
+	}
+	GroupMemoryBarrierWithGroupSync();
+
+	if (groupIndex < RADIX)
+		Histograms[groupIndex * GetBlocksCount(count) + groupID.x] = BlockHistogram[groupIndex];
+}
+
+#endif
+
+#ifdef _CS_Scan
+
+#define SCAN_THREADS 1024
+
+groupshared uint ScanData[SCAN_THREADS];
+
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(SCAN_THREADS, 1, 1)]
+void CS_Scan(uint groupIndex : SV_GroupIndex)
+{
+	// Each thread sums a contiguous range of the histograms
+	const uint total = GetBlocksCount(GetCount()) * RADIX;
+	const uint chunk = (total + SCAN_THREADS - 1) / SCAN_THREADS;
+	const uint start = groupIndex * chunk;
+	const uint end = min(start + chunk, total);
+	uint sum = 0;
+	for (uint i = start; i < end; i++)
+		sum += Histograms[i];
+	ScanData[groupIndex] = sum;
+	GroupMemoryBarrierWithGroupSync();
+
+	// Inclusive prefix sum of the ranges
+	for (uint offset = 1; offset < SCAN_THREADS; offset <<= 1)
+	{
+		uint value = groupIndex >= offset ? ScanData[groupIndex - offset] : 0;
+		GroupMemoryBarrierWithGroupSync();
+		ScanData[groupIndex] += value;
+		GroupMemoryBarrierWithGroupSync();
+	}
+
+	// Write exclusive prefix sum
+	uint prefix = ScanData[groupIndex] - sum;
+	for (uint j = start; j < end; j++)
+	{
+		uint value = Histograms[j];
+		Histograms[j] = prefix;
+		prefix += value;
+	}
+}
+
+#endif
+
+#ifdef _CS_Scatter
+
+StructuredBuffer<Item> SrcKeys : register(t1);
+StructuredBuffer<uint> Histograms : register(t2);
+RWStructuredBuffer<Item> DstKeys : register(u0);
+
+groupshared uint LocalDigits[BLOCK_SIZE];
+groupshared Item LocalItems[BLOCK_SIZE];
+groupshared uint ScanData[BLOCK_SIZE];
+groupshared uint DigitStart[RADIX];
+groupshared uint DigitOffset[RADIX];
+
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(BLOCK_SIZE, 1, 1)]
+void CS_Scatter(uint3 groupID : SV_GroupID, uint groupIndex : SV_GroupIndex)
+{
+	const uint count = GetCount();
+	const uint index = groupID.x * BLOCK_SIZE + groupIndex;
+	const uint blockCount = min(count - groupID.x * BLOCK_SIZE, BLOCK_SIZE);
+
+	// Load items (unused elements use the last digit to be placed after all valid items)
+	Item item = (Item)0;
+	uint digit = RADIX - 1;
+	if (index < count)
+	{
+		item = SrcKeys[index];
+		digit = GetDigit(item.Key);
+	}
+	if (groupIndex < RADIX)
+		DigitOffset[groupIndex] = Histograms[groupIndex * GetBlocksCount(count) + groupID.x];
+
+	// Locally sort the block by digit with stable binary split for each digit bit
+	UNROLL
+	for (uint bit = 0; bit < RADIX_BITS; bit++)
+	{
+		const uint isOne = (digit >> bit) & 1;
+		ScanData[groupIndex] = 1 - isOne;
+		GroupMemoryBarrierWithGroupSync();
+		for (uint offset = 1; offset < BLOCK_SIZE; offset <<= 1)
+		{
+			uint value = groupIndex >= offset ? ScanData[groupIndex - offset] : 0;
+			GroupMemoryBarrierWithGroupSync();
+			ScanData[groupIndex] += value;
+			GroupMemoryBarrierWithGroupSync();
+		}
+		const uint zerosBefore = ScanData[groupIndex] - (1 - isOne);
+		const uint zerosTotal = ScanData[BLOCK_SIZE - 1];
+		const uint position = isOne ? zerosTotal + groupIndex - zerosBefore : zerosBefore;
+		LocalDigits[position] = digit;
+		LocalItems[position] = item;
+		GroupMemoryBarrierWithGroupSync();
+		digit = LocalDigits[groupIndex];
+		item = LocalItems[groupIndex];
+		GroupMemoryBarrierWithGroupSync();
+	}
+
+	// Find the local start of each digit range
+	LocalDigits[groupIndex] = digit;
+	GroupMemoryBarrierWithGroupSync();
+	if (groupIndex == 0 || LocalDigits[groupIndex - 1] != digit)
+		DigitStart[digit] = groupIndex;
+	GroupMemoryBarrierWithGroupSync();
+
+	// Write item to the global location
+	if (groupIndex < blockCount)
+		DstKeys[DigitOffset[digit] + groupIndex - DigitStart[digit]] = item;
+}
+
+#endif
+
+#ifdef _CS_CopyIndices
+
+StructuredBuffer<Item> SortBuffer : register(t1);
+RWBuffer<uint> SortedIndices : register(u0);
+
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(BLOCK_SIZE, 1, 1)]
+void CS_CopyIndices(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	const uint count = GetCount();
+	const uint index = dispatchThreadId.x;
+	if (index >= count)
+		return;
+	SortedIndices[index] = SortBuffer[index].Value;
+}
+
+#endif
@@ -0,0 +1,172 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "./Flax/Common.hlsl"
+#include "./Flax/Quaternion.hlsl"
+
+// Those defines must match the C++
+#define THREADGROUP_SIZE 64
+#define SEGMENT_STRIDE 12
+
+META_CB_BEGIN(0, Data)
+uint ChunksPerSegment;
+uint SegmentsCount;
+float ChunksPerSegmentInv;
+float Dummy0;
+META_CB_END
+
+#ifdef _CS_Deform
+
+// The dirty spline segments control points (start, left tangent, right tangent, end), each stored as 3 float4 (translation with segment index in w, orientation, scale)
+Buffer<float4> Segments : register(t0);
+
+// The spline deformation buffer with the chunk matrices (stored as transposed 3x4, 3 float4 behind each other)
+RWBuffer<float4> SplineDeformation : register(u0);
+
+struct SplineTransform
+{
+	float3 Translation;
+	float4 Orientation;
+	float3 Scale;
+};
+
+SplineTransform LoadTransform(uint index)
+{
+	SplineTransform result;
+	result.Translation = Segments[index].xyz;
+	result.Orientation = Segments[index + 1];
+	result.Scale = Segments[index + 2].xyz;
+	return result;
+}
+
+// Matches Quaternion::Slerp
+float4 QuaternionSlerp(float4 start, float4 end, float amount)
+{
+	float opposite, inverse;
+	float d = dot(start, end);
+	if (abs(d) > 1.0f - 1e-6f)
+	{
+		inverse = 1.0f - amount;
+		opposite = amount * sign(d);
+	}
+	else
+	{
+		float acos1 = acos(abs(d));
+		float invSin = 1.0f / sin(acos1);
+		inverse = sin((1.0f - amount) * acos1) * invSin;
+		opposite = sin(amount * acos1) * invSin * sign(d);
+	}
+	return inverse * start + opposite * end;
+}
+
+// Matches Quaternion::LookRotation
+float4 QuaternionLookRotation(float3 forward, float3 up)
+{
+	float3 f = normalize(forward);
+	float3 r = normalize(cross(up, f));
+	float3 u = cross(f, r);
+	float sum = r.x + u.y + f.z;
+	if (sum > 0)
+	{
+		float num = sqrt(sum + 1);
+		float invNumHalf = 0.5f / num;
+		return float4((u.z - f.y) * invNumHalf, (f.x - r.z) * invNumHalf, (r.y - u.x) * invNumHalf, num * 0.5f);
+	}
+	if (r.x >= u.y && r.x >= f.z)
+	{
+		float num = sqrt(1 + r.x - u.y - f.z);
+		float invNumHalf = 0.5f / num;
+		return float4(0.5f * num, (r.y + u.x) * invNumHalf, (r.z + f.x) * invNumHalf, (u.z - f.y) * invNumHalf);
+	}
+	if (u.y > f.z)
+	{
+		float num = sqrt(1 + u.y - r.x - f.z);
+		float invNumHalf = 0.5f / num;
+		return float4((u.x + r.y) * invNumHalf, 0.5f * num, (f.y + u.z) * invNumHalf, (f.x - r.z) * invNumHalf);
+	}
+	float num = sqrt(1 + f.z - r.x - u.y);
+	float invNumHalf = 0.5f / num;
+	return float4((f.x + r.z) * invNumHalf, (f.y + u.z) * invNumHalf, 0.5f * num, (r.y - u.x) * invNumHalf);
+}
+
+float3 Bezier(float3 p0, float3 p1, float3 p2, float3 p3, float t)
+{
+	float u = 1.0f - t;
+	float tt = t * t;
+	float uu = u * u;
+	return (uu * u) * p0 + (3 * uu * t) * p1 + (3 * u * tt) * p2 + (tt * t) * p3;
+}
+
+float3 BezierFirstDerivative(float3 p0, float3 p1, float3 p2, float3 p3, float t)
+{
+	float u = 1.0f - t;
+	return (3.0f * u * u) * (p1 - p0) + (6.0f * u * t) * (p2 - p1) + (3.0f * t * t) * (p3 - p2);
+}
+
+float4 Bezier(float4 p0, float4 p1, float4 p2, float4 p3, float t)
+{
+	float4 p01 = QuaternionSlerp(p0, p1, t);
+	float4 p12 = QuaternionSlerp(p1, p2, t);
+	float4 p23 = QuaternionSlerp(p2, p3, t);
+	float4 p012 = QuaternionSlerp(p01, p12, t);
+	float4 p123 = QuaternionSlerp(p12, p23, t);
+	return QuaternionSlerp(p012, p123, t);
+}
+
+// Evaluates the spline chunk transformations (matches the SplineModel deformation buffer evaluated on a CPU)
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(THREADGROUP_SIZE, 1, 1)]
+void CS_Deform(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	uint chunk = dispatchThreadId.x;
+	uint segmentAddress = dispatchThreadId.y * SEGMENT_STRIDE;
+	uint segment = (uint)Segments[segmentAddress].w;
+
+	// The last segment contains an additional chunk to prevent issues when sampling spline deformation buffer with alpha=1
+	if (chunk > ChunksPerSegment || (chunk == ChunksPerSegment && segment + 1 != SegmentsCount))
+		return;
+	float alpha = chunk >= ChunksPerSegment - 1 ? 1.0f : (float)chunk * ChunksPerSegmentInv;
+	if (chunk == ChunksPerSegment)
+		alpha = 1.0f - 1e-6f; // Offset to prevent zero derivative at the end of the curve
+
+	// Evaluate transformation at the curve
+	SplineTransform p0 = LoadTransform(segmentAddress);
+	SplineTransform p1 = LoadTransform(segmentAddress + 3);
+	SplineTransform p2 = LoadTransform(segmentAddress + 6);
+	SplineTransform p3 = LoadTransform(segmentAddress + 9);
+	float3 translation = Bezier(p0.Translation, p1.Translation, p2.Translation, p3.Translation, alpha);
+	float4 orientation = Bezier(p0.Orientation, p1.Orientation, p2.Orientation, p3.Orientation, alpha);
+	float3 scale = Bezier(p0.Scale, p1.Scale, p2.Scale, p3.Scale, alpha);
+
+	// Apply spline direction (from position 1st derivative)
+	float3 direction = BezierFirstDerivative(p0.Translation, p1.Translation, p2.Translation, p3.Translation, alpha);
+	float directionLength = length(direction);
+	float4 rotation;
+	if (directionLength <= 1e-6f)
+	{
+		rotation = float4(0, 0, 0, 1);
+	}
+	else
+	{
+		direction /= directionLength;
+		if (dot(direction, float3(0, 1, 0)) >= 0.999f)
+			rotation = float4(-0.70710678f, 0, 0, 0.70710678f); // Rotation around Left axis by half PI
+		else
+			rotation = QuaternionLookRotation(direction, cross(cross(direction, float3(0, 1, 0)), direction));
+	}
+	orientation = QuaternionMultiply(rotation, orientation);
+
+	// Build transposed 3x4 matrix (matches Matrix::Transformation)
+	float4 q = orientation;
+	float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+	float xy = q.x * q.y, zw = q.z * q.w, zx = q.z * q.x;
+	float yw = q.y * q.w, yz = q.y * q.z, xw = q.x * q.w;
+	float3 row1 = float3(1.0f - 2.0f * (yy + zz), 2.0f * (xy + zw), 2.0f * (zx - yw)) * scale.x;
+	float3 row2 = float3(2.0f * (xy - zw), 1.0f - 2.0f * (zz + xx), 2.0f * (yz + xw)) * scale.y;
+	float3 row3 = float3(2.0f * (zx + yw), 2.0f * (yz - xw), 1.0f - 2.0f * (yy + xx)) * scale.z;
+	uint address = (segment * ChunksPerSegment + chunk) * 3;
+	SplineDeformation[address] = float4(row1.x, row2.x, row3.x, translation.x);
+	SplineDeformation[address + 1] = float4(row1.y, row2.y, row3.y, translation.y);
+	SplineDeformation[address + 2] = float4(row1.z, row2.z, row3.z, translation.z);
+}
+
+#endif
@@ -13,6 +13,10 @@ float Sharpness;
 float StationaryBlending;
 float MotionBlending;
 float Dummy0;
+float2 InputSize;
+float2 InputSizeInv;
+float2 JitterUV;
+float2 Dummy1;
 GBufferData GBuffer;
 META_CB_END
 
@@ -106,3 +110,77 @@ float4 PS(Quad_VS2PS input) : SV_Target0
 	color = clamp(color, 0, HDR_CLAMP_MAX);
 	return color;
 }
+
+// Pixel Shader for Temporal Upscaling (output and history are at higher resolution than the jittered input)
+META_PS(true, FEATURE_LEVEL_ES2)
+float4 PS_Upscale(Quad_VS2PS input) : SV_Target0
+{
+	float2 tanHalfFOV = float2(GBuffer.InvProjectionMatrix[0][0], GBuffer.InvProjectionMatrix[1][1]);
+
+	// Calculate previous frame UVs based on per-pixel velocity
+	float2 velocity = SAMPLE_RT_LINEAR(MotionVectors, input.TexCoord).xy;
+	float velocityLength = length(velocity);
+	float2 prevUV = input.TexCoord - velocity;
+	float prevDepth = LinearizeZ(GBuffer, SAMPLE_RT(Depth, prevUV).r);
+
+	// Reconstruct the current color from the jittered input samples around the output pixel (Gaussian fit of Blackman-Harris filter)
+	float2 samplePos = (input.TexCoord + JitterUV) * InputSize;
+	float2 samplePixel = floor(samplePos) + 0.5f;
+	float4 neighborhoodMin = 100000;
+	float4 neighborhoodMax = -10000;
+	float4 currentSum = 0;
+	float weightSum = 0;
+	float maxWeight = 0;
+	float currentDepth = 1;
+	float minDepthDiff = 100000;
+	for (int x = -1; x <= 1; ++x)
+	{
+		for (int y = -1; y <= 1; ++y)
+		{
+			float2 samplePixelPos = samplePixel + float2(x, y);
+			float2 sampleUV = samplePixelPos * InputSizeInv;
+			float4 neighbor = SAMPLE_RT(Input, sampleUV);
+			neighborhoodMin = min(neighborhoodMin, neighbor);
+			neighborhoodMax = max(neighborhoodMax, neighbor);
+			float2 sampleOffset = samplePixelPos - samplePos;
+			float weight = exp(-2.29f * dot(sampleOffset, sampleOffset));
+			currentSum += neighbor * weight;
+			weightSum += weight;
+			maxWeight = max(maxWeight, weight);
+
+			float neighborDepth = LinearizeZ(GBuffer, SAMPLE_RT(Depth, sampleUV).r);
+			float depthDiff = abs(max(neighborDepth - prevDepth, 0));
+			minDepthDiff = min(minDepthDiff, depthDiff);
+			if (x == 0 && y == 0)
+				currentDepth = neighborDepth;
+		}
+	}
+	float4 current = currentSum / max(weightSum, 0.0001f);
+
+	// Sample history by clamp it to the nearby colors range to reduce artifacts
+	float4 history = SAMPLE_RT_LINEAR(InputHistory, prevUV);
+	float aabbMargin = lerp(0.1f, 0.0f, saturate(velocityLength * 100.0)) * abs(Luminance(neighborhoodMax.rgb) - Luminance(neighborhoodMin.rgb));
+	history = ClipToAABB(history, neighborhoodMin - aabbMargin, neighborhoodMax + aabbMargin);
+
+	// Calculate history blending factor (current frame contributes less when its samples are far from the output pixel)
+	float motion = saturate(velocityLength * 1000.0f);
+	float blendfactor = lerp(StationaryBlending, MotionBlending, motion);
+	float currentWeight = (1.0f - blendfactor) * maxWeight;
+
+	// Perform linear accumulation of the previous samples with a current one
+	float4 color = lerp(history, current, currentWeight);
+
+	// Use the reconstructed current color when sample has no valid prevous frame data
+	float miss = any(abs(prevUV * 2 - 1) >= 1.0f) ? 1 : 0;
+	float currentDepthWorld = currentDepth * GBuffer.ViewFar;
+	float minDepthDiffWorld = minDepthDiff * GBuffer.ViewFar;
+	float depthError = tanHalfFOV.x * ScreenSizeInv.x * 200.0f * (currentDepthWorld + 10.0f);
+	miss += minDepthDiffWorld > depthError ? 1 : 0;
+#if DEBUG_HISTORY_REJECTION
+	current = float4(1, 0, 0, 1);
+#endif
+	color = lerp(color, current, saturate(miss));
+
+	color = clamp(color, 0, HDR_CLAMP_MAX);
+	return color;
+}
@@ -0,0 +1,41 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#ifndef __TEXTURE_FEEDBACK__
+#define __TEXTURE_FEEDBACK__
+
+// Texture feedback pass records the most detailed mip level sampled by the materials for each streamed texture (read back by the textures streaming)
+#if defined(_PS_TextureFeedback)
+
+#define TEXTURE_FEEDBACK_REGISTERS 32
+
+cbuffer TextureFeedbackData : register(b3)
+{
+    // Per shader resource register: feedback slot index (low 24 bits, 0xffffff if unused) and the amount of not allocated texture mips (high 8 bits)
+    uint4 TextureFeedbackSlots[TEXTURE_FEEDBACK_REGISTERS / 4];
+    float TextureFeedbackMipBias;
+    float3 TextureFeedbackPadding;
+};
+
+RWBuffer<uint> TextureFeedback : register(u0);
+
+void WriteTextureFeedback(uint registerIndex, float lod)
+{
+    uint data = TextureFeedbackSlots[registerIndex / 4][registerIndex % 4];
+    uint slot = data & 0xffffff;
+    if (slot != 0xffffff)
+    {
+        // Convert into the absolute mip index (texture might be not fully streamed in)
+        uint mip = (uint)max(lod + (float)(data >> 24) + TextureFeedbackMipBias, 0.0f);
+        InterlockedMin(TextureFeedback[slot], mip);
+    }
+}
+
+#define TEXTURE_FEEDBACK(registerIndex, texture, sampler, uv) WriteTextureFeedback(registerIndex, texture.CalculateLevelOfDetailUnclamped(sampler, uv))
+
+#else
+
+#define TEXTURE_FEEDBACK(registerIndex, texture, sampler, uv)
+
+#endif
+
+#endif
@@ -0,0 +1,78 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "./Flax/Common.hlsl"
+
+// Those defines must match the C++
+#define THREADGROUP_SIZE_X 8
+#define THREADGROUP_SIZE_Y 8
+
+META_CB_BEGIN(0, Data)
+uint2 InputSize;
+uint2 OutputSize;
+uint TileSize;
+float Threshold;
+float MotionScale;
+float Dummy0;
+META_CB_END
+
+#ifdef _CS_ShadingRate
+
+Texture2D Input : register(t0);
+Texture2D MotionVectors : register(t1);
+
+RWTexture2D<uint> Output : register(u0);
+
+groupshared float3 TileData[THREADGROUP_SIZE_X * THREADGROUP_SIZE_Y];
+
+float GetLuminance(uint2 pixel)
+{
+	// Compress HDR to the perceptual range
+	float luminance = Luminance(Input.Load(int3(min(pixel, InputSize - 1), 0)).rgb);
+	return luminance / (1.0f + luminance);
+}
+
+// Compute shader for the shading rate image generation. Each thread group processes a single tile and estimates the error of shading it at lower rate (luminance differences between the neighbor pixels in each direction). Fast-moving tiles tolerate larger error.
+META_CS(true, FEATURE_LEVEL_SM5)
+[numthreads(THREADGROUP_SIZE_X, THREADGROUP_SIZE_Y, 1)]
+void CS_ShadingRate(uint3 GroupId : SV_GroupID, uint3 GroupThreadId : SV_GroupThreadID, uint GroupIndex : SV_GroupIndex)
+{
+	// Accumulate the neighbor pixels differences (and motion) within the tile part of the thread
+	uint2 tileStart = GroupId.xy * TileSize;
+	uint pixelsPerThread = max(TileSize / THREADGROUP_SIZE_X, 1);
+	float3 data = 0;
+	for (uint y = 0; y < pixelsPerThread; y++)
+	{
+		for (uint x = 0; x < pixelsPerThread; x++)
+		{
+			uint2 pixel = tileStart + (GroupThreadId.xy * pixelsPerThread + uint2(x, y));
+			float luminance = GetLuminance(pixel);
+			data.x += abs(luminance - GetLuminance(pixel + uint2(1, 0)));
+			data.y += abs(luminance - GetLuminance(pixel + uint2(0, 1)));
+			float2 uv = (float2(min(pixel, InputSize - 1)) + 0.5f) / float2(InputSize);
+			data.z += length(MotionVectors.SampleLevel(SamplerLinearClamp, uv, 0).xy * float2(InputSize));
+		}
+	}
+	TileData[GroupIndex] = data / float(pixelsPerThread * pixelsPerThread);
+	GroupMemoryBarrierWithGroupSync();
+
+	// Reduce tile data
+	UNROLL
+	for (uint i = THREADGROUP_SIZE_X * THREADGROUP_SIZE_Y / 2; i > 0; i >>= 1)
+	{
+		if (GroupIndex < i)
+			TileData[GroupIndex] += TileData[GroupIndex + i];
+		GroupMemoryBarrierWithGroupSync();
+	}
+
+	// Pick the shading rate (encoded as (log2(width) << 2) | log2(height))
+	if (GroupIndex == 0 && all(GroupId.xy < OutputSize))
+	{
+		float3 tile = TileData[0] / float(THREADGROUP_SIZE_X * THREADGROUP_SIZE_Y);
+		float threshold = Threshold * (1.0f + tile.z * MotionScale);
+		uint rateX = tile.x < threshold ? 1 : 0;
+		uint rateY = tile.y < threshold ? 1 : 0;
+		Output[GroupId.xy] = (rateX << 2) | rateY;
+	}
+}
+
+#endif
@@ -43,7 +43,8 @@ uint MissedHistorySamplesCount;
 uint3 GridSizeInt;
 float PhaseG;
 
-float2 Dummy0;
+uint Checkerboard;
+uint CheckerboardParity;
 float VolumetricFogMaxDistance;
 float InverseSquaredLightDistanceBiasScale;
 
@@ -112,6 +113,12 @@ float3 GetVolumeUV(float3 worldPosition, float4x4 worldToClip)
 	return float3(ndcPosition.xy * float2(0.5f, -0.5f) + 0.5f, ndcPosition.w / VolumetricFogMaxDistance);
 }
 
+// Checks if cell lighting is skipped in this frame (checkerboard update reuses the reprojected history for every second cell)
+bool IsCellSkipped(uint3 gridCoordinate, float historyAlpha)
+{
+	return Checkerboard != 0 && historyAlpha > 0 && ((gridCoordinate.x + gridCoordinate.y + gridCoordinate.z) & 1) != CheckerboardParity;
+}
+
 // Vertex shader that writes to a range of slices of a volume texture
 META_VS(true, FEATURE_LEVEL_SM5)
 META_FLAG(VertexToGeometryShader)
@@ -202,6 +209,8 @@ float4 PS_InjectLight(Quad_GS2PS input) : SV_Target0
 	FLATTEN
 	if (any(historyUV < 0) || any(historyUV > 1))
 		historyAlpha = 0;
+	if (IsCellSkipped(gridCoordinate, historyAlpha))
+		return 0;
 	uint samplesCount = historyAlpha < 0.001f ? MissedHistorySamplesCount : 1;
 
 	float NoL = 0;
@@ -305,6 +314,16 @@ void CS_LightScattering(uint3 GroupId : SV_GroupID, uint3 DispatchThreadId : SV_
 	FLATTEN
 	if (any(historyUV < 0) || any(historyUV > 1))
 		historyAlpha = 0;
+
+	// Reuse the reprojected history for the cells skipped in this frame
+	BRANCH
+	if (IsCellSkipped(gridCoordinate, historyAlpha))
+	{
+		if (all(gridCoordinate < GridSizeInt))
+			RWLightScattering[gridCoordinate] = max(LightScatteringHistory.SampleLevel(SamplerLinearClamp, historyUV, 0), 0);
+		return;
+	}
+
 	samplesCount = historyAlpha < 0.001f && all(gridCoordinate < GridSizeInt) ? MissedHistorySamplesCount : 1;
 
 	for (uint sampleIndex = 0; sampleIndex < samplesCount; sampleIndex++)
@@ -38,6 +38,7 @@ public override void Setup(BuildOptions options)
 
         bool useDynamicLinking = false;
         bool usePVD = false;
+        bool useGPU = false; // Requires PhysX SDK built with CUDA support and PhysXGpu library deployed next to the game
         bool useVehicle = Physics.WithVehicle;
         bool usePhysicsCooking = Physics.WithCooking;
 
@@ -45,6 +46,8 @@ public override void Setup(BuildOptions options)
 
         if (usePVD)
             options.PublicDefinitions.Add("WITH_PVD");
+        if (useGPU)
+            options.PublicDefinitions.Add("WITH_PHYSX_GPU");
         if (useVehicle)
             options.PublicDefinitions.Add("WITH_VEHICLE");
 
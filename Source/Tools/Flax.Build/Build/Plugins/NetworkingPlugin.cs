@@ -2,6 +2,7 @@
 
 using System;
 using System.Text;
+using System.Globalization;
 using System.Linq;
 using System.IO;
 using System.Collections.Generic;
@@ -44,6 +45,7 @@ private struct MethodRPC
             public bool IsServer;
             public bool IsClient;
             public int Channel;
+            public bool IsImmediate;
             public MethodDefinition Execute;
         }
 
@@ -63,6 +65,7 @@ private struct DotnetContext
         internal const string NetworkReplicated = "NetworkReplicated";
         internal const string NetworkReplicatedAttribute = "FlaxEngine.NetworkReplicatedAttribute";
         internal const string NetworkRpc = "NetworkRpc";
+        internal const string NetworkPrecision = "NetworkPrecision";
         private const string Thunk1 = "INetworkSerializable_Serialize";
         private const string Thunk2 = "INetworkSerializable_Deserialize";
 
@@ -91,6 +94,14 @@ private struct DotnetContext
             { "FlaxEngine.Ray", new InBuildSerializer("WriteRay", "ReadRay") },
         };
 
+        private static readonly Dictionary<string, InBuildSerializer> _quantizedSerializers = new Dictionary<string, InBuildSerializer>()
+        {
+            { "System.Single", new InBuildSerializer("WriteFloatPrecision", "ReadFloatPrecision") },
+            { "FlaxEngine.Float3", new InBuildSerializer("WriteFloat3Precision", "ReadFloat3Precision") },
+            { "FlaxEngine.Vector3", new InBuildSerializer("WriteVector3Precision", "ReadVector3Precision") },
+            { "FlaxEngine.Quaternion", new InBuildSerializer("WriteQuaternionQuantized", "ReadQuaternionQuantized") },
+        };
+
         /// <inheritdoc />
         public override void Init()
         {
@@ -117,6 +128,19 @@ private void OnParseMemberTag(ref bool valid, BindingsGenerator.TagParameter tag
                 valid = true;
                 memberInfo.SetTag(NetworkRpc, tag.Value);
             }
+            else if (string.Equals(tag.Tag, NetworkPrecision, StringComparison.OrdinalIgnoreCase))
+            {
+                // Replicated member quantization
+                valid = true;
+                memberInfo.SetTag(NetworkPrecision, tag.Value);
+            }
+        }
+
+        private static int GetQuaternionBits(float precision)
+        {
+            // Smallest-three encoding uses components within [-1/sqrt(2), 1/sqrt(2)] range
+            var bits = (int)Math.Ceiling(Math.Log(1.41421356 / precision + 1.0, 2.0));
+            return Math.Clamp(bits, 2, 16);
         }
 
         private void OnGenerateCppTypeInternals(Builder.BuildData buildData, ApiTypeInfo typeInfo, StringBuilder contents)
@@ -220,6 +244,7 @@ private void OnGenerateCppTypeInternals(Builder.BuildData buildData, ApiTypeInfo
                         channelType = "Unreliable";
                     else if (tag.IndexOf("Reliable", StringComparison.OrdinalIgnoreCase) != -1)
                         channelType = "Reliable";
+                    bool isImmediate = tag.IndexOf("Immediate", StringComparison.OrdinalIgnoreCase) != -1;
 
                     // Generated method thunk to execute RPC from network
                     {
@@ -289,6 +314,7 @@ private void OnGenerateCppTypeInternals(Builder.BuildData buildData, ApiTypeInfo
                         contents.AppendLine($"        info.Execute = {functionInfo.Name}_Execute;");
                         contents.AppendLine($"        info.Invoke = {functionInfo.Name}_Invoke;");
                         contents.AppendLine($"        info.Channel = (uint8)NetworkChannelType::{channelType};");
+                        contents.AppendLine($"        info.Immediate = {(isImmediate ? "1" : "0")};");
                         contents.AppendLine($"        info.Tag = nullptr;");
                         contents.AppendLine("        return info;");
                         contents.AppendLine("    }");
@@ -323,7 +349,8 @@ private void OnGenerateCppTypeSerialize(Builder.BuildData buildData, ApiTypeInfo
                     {
                         if (fieldInfo.GetTag(NetworkReplicated) == null)
                             continue;
-                        OnGenerateCppTypeSerializeData(buildData, typeInfo, contents, fieldInfo.Type, $"obj.{fieldInfo.Name}", serialize);
+                        if (!OnGenerateCppWriteQuantized(typeInfo, contents, fieldInfo, fieldInfo.Type, $"obj.{fieldInfo.Name}", serialize))
+                            OnGenerateCppTypeSerializeData(buildData, typeInfo, contents, fieldInfo.Type, $"obj.{fieldInfo.Name}", serialize);
                     }
                 }
 
@@ -336,7 +363,8 @@ private void OnGenerateCppTypeSerialize(Builder.BuildData buildData, ApiTypeInfo
                         if (!serialize)
                             contents.AppendLine($"        {{{propertyInfo.Setter.Parameters[0].Type} value{propertyInfo.Name};");
                         var name = serialize ? $"obj.{propertyInfo.Getter.Name}()" : $"value{propertyInfo.Name}";
-                        OnGenerateCppTypeSerializeData(buildData, typeInfo, contents, propertyInfo.Type, name, serialize);
+                        if (!OnGenerateCppWriteQuantized(typeInfo, contents, propertyInfo, propertyInfo.Type, name, serialize))
+                            OnGenerateCppTypeSerializeData(buildData, typeInfo, contents, propertyInfo.Type, name, serialize);
                         if (!serialize)
                             contents.AppendLine($"        obj.{propertyInfo.Setter.Name}(value{propertyInfo.Name});}}");
                     }
@@ -349,8 +377,9 @@ private void OnGenerateCppTypeSerialize(Builder.BuildData buildData, ApiTypeInfo
 
         private static bool IsRawPOD(Builder.BuildData buildData, ApiTypeInfo type)
         {
-            // TODO: what if type fields have custom replication settings (eg. compression)?
             type.EnsureInited(buildData);
+            if (type is StructureInfo structureInfo && structureInfo.Fields.Any(x => x.GetTag(NetworkReplicated) != null && x.GetTag(NetworkPrecision) != null))
+                return false; // Quantized fields need to use generated serializer
             return type.IsPod;
         }
 
@@ -434,6 +463,41 @@ private void OnGenerateCppTypeSerializeData(Builder.BuildData buildData, ApiType
             }
         }
 
+        private static bool OnGenerateCppWriteQuantized(ApiTypeInfo caller, StringBuilder contents, MemberInfo memberInfo, TypeInfo type, string name, bool serialize)
+        {
+            var precisionTag = memberInfo.GetTag(NetworkPrecision);
+            if (precisionTag == null)
+                return false;
+            if (!float.TryParse(precisionTag.TrimEnd('f', 'F'), NumberStyles.Float, CultureInfo.InvariantCulture, out var precision) || precision <= 0.0f)
+                throw new Exception($"Invalid network precision '{precisionTag}' on {memberInfo.Name} in {caller.Name}.");
+            if (type.IsPtr || type.GenericArgs != null)
+                throw new Exception($"Not supported type '{type}' for network precision on {memberInfo.Name} in {caller.Name}.");
+            var args = precision.ToString(CultureInfo.InvariantCulture) + "f";
+            string method;
+            switch (type.Type)
+            {
+            case "float":
+                method = "FloatPrecision";
+                break;
+            case "Float3":
+                method = "Float3Precision";
+                break;
+            case "Vector3":
+                method = "Vector3Precision";
+                break;
+            case "Quaternion":
+                method = "QuaternionQuantized";
+                args = GetQuaternionBits(precision).ToString();
+                break;
+            default: throw new Exception($"Not supported type '{type}' for network precision on {memberInfo.Name} in {caller.Name}. Supported types: float, Float3, Vector3, Quaternion.");
+            }
+            if (serialize)
+                contents.AppendLine($"        stream->Write{method}({name}, {args});");
+            else
+                contents.AppendLine($"        {name} = stream->Read{method}({args});");
+            return true;
+        }
+
         private void OnGenerateCppWriteRaw(StringBuilder contents, string data, bool serialize)
         {
             var method = serialize ? "Write" : "Read";
@@ -620,7 +684,7 @@ private void OnPatchDotNetAssembly(Builder.BuildData buildData, NativeCpp.BuildO
                     module.ImportReference(addSerializer);
                     var serializeFuncType = addSerializer.Parameters[1].ParameterType;
                     var serializeFuncCtor = serializeFuncType.Resolve().GetMethod(".ctor");
-                    var addRPC = networkReplicatorType.Resolve().GetMethod("AddRPC", 6);
+                    var addRPC = networkReplicatorType.Resolve().GetMethod("AddRPC", 7);
                     module.ImportReference(addRPC);
                     var executeRPCFuncType = addRPC.Parameters[2].ParameterType;
                     var executeRPCFuncCtor = executeRPCFuncType.Resolve().GetMethod(".ctor");
@@ -640,7 +704,7 @@ private void OnPatchDotNetAssembly(Builder.BuildData buildData, NativeCpp.BuildO
 
                     foreach (var e in context.MethodRPCs)
                     {
-                        // NetworkReplicator.AddRPC(typeof(<type>), "<name>", <name>_Execute, <isServer>, <isClient>, <channel>);
+                        // NetworkReplicator.AddRPC(typeof(<type>), "<name>", <name>_Execute, <isServer>, <isClient>, <channel>, <isImmediate>);
                         il.Emit(OpCodes.Ldtoken, e.Type);
                         il.Emit(OpCodes.Call, module.ImportReference(getTypeFromHandle));
                         il.Emit(OpCodes.Ldstr, e.Method.Name);
@@ -650,6 +714,7 @@ private void OnPatchDotNetAssembly(Builder.BuildData buildData, NativeCpp.BuildO
                         il.Emit(OpCodes.Ldc_I4, e.IsServer ? 1 : 0);
                         il.Emit(OpCodes.Ldc_I4, e.IsClient ? 1 : 0);
                         il.Emit(OpCodes.Ldc_I4, e.Channel);
+                        il.Emit(OpCodes.Ldc_I4, e.IsImmediate ? 1 : 0);
                         il.Emit(OpCodes.Call, module.ImportReference(addRPC));
                     }
 
@@ -1084,6 +1149,15 @@ public DotnetValueContext(TypeReference type, int localVarIndex, TypeReference v
                 ArgIndex = -1;
             }
 
+            public float GetPrecision()
+            {
+                ICustomAttributeProvider member = Property;
+                if (member == null && Field != null)
+                    member = Field.Resolve();
+                var attribute = member?.CustomAttributes.FirstOrDefault(x => x.AttributeType.FullName == NetworkReplicatedAttribute);
+                return attribute != null ? (float)attribute.GetFieldValue("Precision", 0.0f) : 0.0f;
+            }
+
             public bool Validate()
             {
                 if (Property != null)
@@ -1436,6 +1510,43 @@ private static void GenerateDotnetSerialization(ref DotnetContext context, bool
                     valueContext.SetProperty(ref il);
                 }
             }
+            else if (valueContext.GetPrecision() > 0.0f && _quantizedSerializers.TryGetValue(valueContext.ValueType.FullName, out var quantizedSerializer))
+            {
+                // Call NetworkStream method to write/read quantized data
+                var precision = valueContext.GetPrecision();
+                if (serialize)
+                {
+                    if (il.IsRPC)
+                        il.Emit(OpCodes.Ldloc, il.StreamLocalIndex);
+                    else
+                        il.Emit(OpCodes.Ldarg_1);
+                    valueContext.Load(ref il);
+                }
+                else
+                {
+                    if (il.IsRPC)
+                    {
+                        il.Emit(OpCodes.Ldloc_1);
+                    }
+                    else
+                    {
+                        il.Emit(OpCodes.Ldarg_0);
+                        il.Emit(OpCodes.Ldarg_1);
+                    }
+                }
+                if (valueContext.ValueType.FullName == "FlaxEngine.Quaternion")
+                    il.Emit(OpCodes.Ldc_I4, GetQuaternionBits(precision));
+                else
+                    il.Emit(OpCodes.Ldc_R4, precision);
+                il.Emit(OpCodes.Callvirt, module.ImportReference(networkStreamType.GetMethod(serialize ? quantizedSerializer.WriteMethod : quantizedSerializer.ReadMethod)));
+                if (!serialize)
+                    valueContext.Store(ref il);
+            }
+            else if (valueContext.GetPrecision() > 0.0f)
+            {
+                MonoCecil.CompilationError($"Not supported type '{valueContext.ValueType.FullName}' for network precision in {valueContext.Type.FullName}. Supported types: float, Float3, Vector3, Quaternion.");
+                context.Failed = true;
+            }
             else if (_inBuildSerializers.TryGetValue(valueContext.ValueType.FullName, out var serializer))
             {
                 // Call NetworkStream method to write/read data
@@ -1628,6 +1739,7 @@ private static void GenerateDotNetRPCBody(ref DotnetContext context, TypeDefinit
             methodRPC.IsServer = (bool)attribute.GetFieldValue("Server", methodRPC.IsServer);
             methodRPC.IsClient = (bool)attribute.GetFieldValue("Client", methodRPC.IsClient);
             methodRPC.Channel = (int)attribute.GetFieldValue("Channel", methodRPC.Channel);
+            methodRPC.IsImmediate = (bool)attribute.GetFieldValue("Immediate", false);
             if (methodRPC.IsServer && methodRPC.IsClient)
             {
                 MonoCecil.CompilationError($"Network RPC {method.Name} in {type.FullName} cannot be both Server and Client.", method);
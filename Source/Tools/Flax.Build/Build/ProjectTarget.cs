@@ -79,6 +79,10 @@ public override void SetupTargetEnvironment(BuildOptions options)
                 options.CompileEnv.PreprocessorDefinitions.Add("USE_LARGE_WORLDS");
                 options.ScriptingAPI.Defines.Add("USE_LARGE_WORLDS");
             }
+            if (EngineConfiguration.WithPoolAllocator(options))
+            {
+                options.CompileEnv.PreprocessorDefinitions.Add("USE_POOL_ALLOCATOR");
+            }
 
             // Add include paths for this and all referenced projects sources
             foreach (var project in Project.GetAllProjects())
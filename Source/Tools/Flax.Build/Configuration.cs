@@ -264,6 +264,12 @@ public static partial class EngineConfiguration
         [CommandLine("useLargeWorlds", "1 to enable large worlds with 64-bit coordinates precision support in build (USE_LARGE_WORLDS=1)")]
         public static bool UseLargeWorlds = false;
 
+        /// <summary>
+        /// 1 to use the pool allocator with thread-local caches as a default engine memory allocator (USE_POOL_ALLOCATOR=1). Recommended for dedicated server builds on multi-socket machines.
+        /// </summary>
+        [CommandLine("usePoolAllocator", "1 to use the pool allocator with thread-local caches as a default engine memory allocator (USE_POOL_ALLOCATOR=1)")]
+        public static bool UsePoolAllocator = false;
+
         /// <summary>
         /// True if managed C# scripting should be enabled, otherwise false. Engine without C# is partially supported and can be used when porting to a new platform before implementing C# runtime on it.
         /// </summary>
@@ -287,6 +293,12 @@ public static bool WithLargeWorlds(NativeCpp.BuildOptions options)
             return UseLargeWorlds;
         }
 
+        public static bool WithPoolAllocator(NativeCpp.BuildOptions options)
+        {
+            // This can be used to selectively control the memory allocator per-platform or build configuration
+            return UsePoolAllocator;
+        }
+
         public static bool WithDotNet(NativeCpp.BuildOptions options)
         {
             return UseDotNet;